@@ -0,0 +1,212 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "rpcServer.hpp"
+
+#include "avdecc/controllerManager.hpp"
+#include "avdecc/channelConnectionManager.hpp"
+#include "avdecc/mcDomainManager.hpp"
+#include "avdecc/helper.hpp"
+#include "avdecc/hiveLogItems.hpp"
+#include "settingsManager/settings.hpp"
+#include "internals/config.hpp"
+
+#include <la/avdecc/avdecc.hpp>
+#include <la/avdecc/logger.hpp>
+#include <la/avdecc/controller/avdeccController.hpp>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTimer>
+
+#include <atomic>
+#include <csignal>
+#include <iostream>
+#include <optional>
+
+#define PROG_ID 0x0005 // Hive uses 0x0003 (and 0x0004 in debug), so the daemon can run on the same host
+#define VENDOR_ID 0x001B92
+#define DEVICE_ID 0x80
+#define MODEL_ID 0x00000001
+
+/** Default port of the JSON-RPC WebSocket server */
+static auto constexpr DefaultPort = std::uint16_t{ 9781 };
+
+static std::atomic_bool s_stopRequested{ false };
+
+/** Prints the log entries on the standard error */
+class ConsoleLogger final : public la::avdecc::logger::Logger::Observer
+{
+public:
+	ConsoleLogger() noexcept
+	{
+		la::avdecc::logger::Logger::getInstance().registerObserver(this);
+	}
+
+	~ConsoleLogger() noexcept
+	{
+		la::avdecc::logger::Logger::getInstance().unregisterObserver(this);
+	}
+
+private:
+	virtual void onLogItem(la::avdecc::logger::Level const level, la::avdecc::logger::LogItem const* const item) noexcept override
+	{
+		std::cerr << "[" << avdecc::helper::loggerLevelToString(level).toStdString() << "] " << item->getMessage() << std::endl;
+	}
+};
+
+static std::optional<la::avdecc::protocol::ProtocolInterface::Type> toProtocolInterfaceType(QString const& name) noexcept
+{
+	if (name == "pcap")
+	{
+		return la::avdecc::protocol::ProtocolInterface::Type::PCap;
+	}
+	if (name == "macos")
+	{
+		return la::avdecc::protocol::ProtocolInterface::Type::MacOSNative;
+	}
+	if (name == "virtual")
+	{
+		return la::avdecc::protocol::ProtocolInterface::Type::Virtual;
+	}
+	return std::nullopt;
+}
+
+int main(int argc, char* argv[])
+{
+	QCoreApplication::setOrganizationDomain(hive::internals::organizationDomain);
+	QCoreApplication::setOrganizationName(hive::internals::organizationName);
+	QCoreApplication::setApplicationName(hive::internals::applicationShortName + "Daemon"); // Own settings, not shared with Hive
+	QCoreApplication::setApplicationVersion(hive::internals::versionString);
+
+	QCoreApplication app(argc, argv);
+
+	auto parser = QCommandLineParser{};
+	parser.setApplicationDescription("Headless Hive controller, exposing the connection management over a local JSON-RPC WebSocket API.");
+	parser.addHelpOption();
+	parser.addVersionOption();
+	auto const interfaceOption = QCommandLineOption{ { "i", "interface" }, "Network interface ID the controller is created on.", "id" };
+	auto const secondaryInterfacesOption = QCommandLineOption{ "secondary-interfaces", "Comma separated list of additional network interface IDs.", "ids" };
+	auto const protocolOption = QCommandLineOption{ "protocol", "Protocol interface type: pcap, macos or virtual (default: pcap).", "type", "pcap" };
+	auto const portOption = QCommandLineOption{ { "p", "port" }, QString("Port of the WebSocket server, only bound on the loopback interface (default: %1).").arg(DefaultPort), "port", QString::number(DefaultPort) };
+	auto const aemCacheOption = QCommandLineOption{ "aem-cache", "Enable the AEM cache." };
+	auto const tokenOption = QCommandLineOption{ "token", "Shared secret the clients must send in their first request (\"authenticate\" method).", "secret" };
+	auto const tokenFileOption = QCommandLineOption{ "token-file", "File whose first line is the shared secret, instead of passing it on the command line.", "path" };
+	auto const allowedOriginsOption = QCommandLineOption{ "allowed-origins", "Comma separated list of the web origins allowed to connect (default: none, only clients not sending an Origin header).", "origins" };
+	parser.addOptions({ interfaceOption, secondaryInterfacesOption, protocolOption, portOption, aemCacheOption, tokenOption, tokenFileOption, allowedOriginsOption });
+	parser.process(app);
+
+	auto const protocolType = toProtocolInterfaceType(parser.value(protocolOption));
+	auto portOk = false;
+	auto const port = parser.value(portOption).toUShort(&portOk);
+	if (!parser.isSet(interfaceOption) || !protocolType || !portOk)
+	{
+		std::cerr << parser.helpText().toStdString() << std::endl;
+		return 1;
+	}
+
+	auto token = parser.value(tokenOption);
+	if (parser.isSet(tokenFileOption))
+	{
+		auto tokenFile = QFile{ parser.value(tokenFileOption) };
+		if (!tokenFile.open(QIODevice::ReadOnly | QIODevice::Text))
+		{
+			std::cerr << "Cannot read token file: " << tokenFile.errorString().toStdString() << std::endl;
+			return 1;
+		}
+		token = QString::fromUtf8(tokenFile.readLine()).trimmed();
+	}
+	if (token.isEmpty())
+	{
+		std::cerr << "A non-empty shared secret is required (--token or --token-file)" << std::endl;
+		return 1;
+	}
+
+	// Runtime sanity check on Avdecc Library compilation options
+	if (!la::avdecc::getCompileOptions().test(la::avdecc::CompileOption::EnableRedundancy) || !la::avdecc::controller::getCompileOptions().test(la::avdecc::controller::CompileOption::EnableRedundancy))
+	{
+		std::cerr << "Avdecc Libraries were not compiled with Redundancy feature, which is required by " << hive::internals::applicationShortName.toStdString() << std::endl;
+		return 1;
+	}
+
+	auto const logger = ConsoleLogger{};
+
+	// Register the settings used by the controller
+	auto& settings = settings::SettingsManager::getInstance();
+	settings.registerSetting(settings::Controller_AemCacheEnabled);
+	settings.registerSetting(settings::Controller_FullStaticModelEnabled);
+	settings.registerSetting(settings::Controller_OfflineGracePeriod);
+	settings.registerSetting(settings::Controller_VisibilityDrivenNotifications);
+	settings.registerSetting(settings::Controller_WatchedEntities);
+	settings.setValue(settings::Controller_AemCacheEnabled.name, parser.isSet(aemCacheOption));
+
+	// Instantiate the managers before the controller, so they see all the entities
+	avdecc::ChannelConnectionManager::getInstance();
+	avdecc::mediaClock::MCDomainManager::getInstance();
+
+	auto server = RpcServer{ token, parser.value(allowedOriginsOption).split(',', QString::SkipEmptyParts) };
+	if (!server.listen(port))
+	{
+		std::cerr << "Cannot listen on port " << port << ": " << server.errorString().toStdString() << std::endl;
+		return 1;
+	}
+
+	auto& manager = avdecc::ControllerManager::getInstance();
+	try
+	{
+		auto const secondaryInterfaceIDs = parser.value(secondaryInterfacesOption).split(',', QString::SkipEmptyParts);
+		manager.createController(*protocolType, parser.value(interfaceOption), PROG_ID, la::avdecc::entity::model::makeEntityModelID(VENDOR_ID, DEVICE_ID, MODEL_ID), "en", secondaryInterfaceIDs);
+	}
+	catch (la::avdecc::controller::Controller::Exception const& e)
+	{
+		std::cerr << "Cannot create controller: " << e.what() << std::endl;
+		return 1;
+	}
+
+	LOG_HIVE_INFO(QString("%1 daemon listening on ws://127.0.0.1:%2 (Controller %3)").arg(hive::internals::applicationShortName).arg(port).arg(avdecc::helper::uniqueIdentifierToString(manager.getControllerEID())));
+
+	// Quit the event loop on SIGINT/SIGTERM (only an atomic flag is touched from the signal handler)
+	std::signal(SIGINT,
+		[](int)
+		{
+			s_stopRequested = true;
+		});
+	std::signal(SIGTERM,
+		[](int)
+		{
+			s_stopRequested = true;
+		});
+	auto stopTimer = QTimer{};
+	QObject::connect(&stopTimer, &QTimer::timeout, &app,
+		[]()
+		{
+			if (s_stopRequested)
+			{
+				QCoreApplication::quit();
+			}
+		});
+	stopTimer.start(200);
+
+	auto const retValue = app.exec();
+
+	// Destroy the controller before leaving main (so it's properly cleaned before all static variables are destroyed in a random order)
+	manager.destroyController();
+
+	return retValue;
+}
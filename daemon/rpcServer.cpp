@@ -0,0 +1,1063 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "rpcServer.hpp"
+
+#include "avdecc/controllerManager.hpp"
+#include "avdecc/channelConnectionManager.hpp"
+#include "avdecc/mcDomainManager.hpp"
+#include "avdecc/commandChain.hpp"
+#include "avdecc/helper.hpp"
+#include "avdecc/hiveLogItems.hpp"
+
+#include <la/avdecc/controller/avdeccController.hpp>
+#include <la/avdecc/utils.hpp>
+
+#include <QWebSocketServer>
+#include <QWebSocket>
+#include <QWebSocketCorsAuthenticator>
+#include <QCryptographicHash>
+#include <QHostAddress>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QPointer>
+#include <QHash>
+#include <QTimer>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/** Period at which the pending events are sent to the clients */
+static auto constexpr EventsFlushPeriod = std::chrono::milliseconds{ 20 };
+/** Events are not sent to a client having more than this amount of data still waiting to be written (it did not read the previous ones) */
+static auto constexpr MaxPendingBytesPerClient = qint64{ 4 * 1024 * 1024 };
+
+/** JSON-RPC 2.0 error codes */
+static auto constexpr ParseError = -32700;
+static auto constexpr InvalidRequest = -32600;
+static auto constexpr MethodNotFound = -32601;
+static auto constexpr InvalidParams = -32602;
+static auto constexpr ControllerError = -32000; // Implementation defined server error
+static auto constexpr Unauthorized = -32001; // Implementation defined server error
+
+enum class EventCategory : std::uint32_t
+{
+	None = 0u,
+	Entities = 1u << 0, // Controller and entities online/offline
+	Connections = 1u << 1, // Stream and channel connections
+	MediaClock = 1u << 2, // Media clock domains
+	Names = 1u << 3, // Entity and group names
+	Streams = 1u << 4, // Stream formats and running state
+	Access = 1u << 5, // Acquire and lock states
+	Statistics = 1u << 6, // Controller statistics and stream input error counters
+	All = (1u << 7) - 1u,
+};
+
+using EventCategories = std::uint32_t; // Mask of EventCategory
+
+static std::vector<std::pair<QString, EventCategory>> const s_eventCategories = {
+	{ "entities", EventCategory::Entities },
+	{ "connections", EventCategory::Connections },
+	{ "mediaClock", EventCategory::MediaClock },
+	{ "names", EventCategory::Names },
+	{ "streams", EventCategory::Streams },
+	{ "access", EventCategory::Access },
+	{ "statistics", EventCategory::Statistics },
+};
+
+/** Thrown by the parameters parsing helpers, answered with an InvalidParams error */
+class InvalidParamsException final : public std::invalid_argument
+{
+public:
+	using std::invalid_argument::invalid_argument;
+};
+
+static QString toString(la::avdecc::UniqueIdentifier const& identifier) noexcept
+{
+	return avdecc::helper::uniqueIdentifierToString(identifier);
+}
+
+static la::avdecc::UniqueIdentifier toUniqueIdentifier(QString text)
+{
+	if (text.startsWith("0x", Qt::CaseInsensitive))
+	{
+		text.remove(0, 2);
+	}
+	auto ok = false;
+	auto const value = text.toULongLong(&ok, 16);
+	if (!ok)
+	{
+		throw InvalidParamsException{ QString("'%1' is not an EntityID hexadecimal string").arg(text).toStdString() };
+	}
+	return la::avdecc::UniqueIdentifier{ value };
+}
+
+static la::avdecc::UniqueIdentifier toUniqueIdentifier(QJsonObject const& params, QString const& key)
+{
+	auto const value = params.value(key);
+	if (!value.isString())
+	{
+		throw InvalidParamsException{ QString("'%1' must be an EntityID hexadecimal string").arg(key).toStdString() };
+	}
+	return toUniqueIdentifier(value.toString());
+}
+
+static std::uint16_t toIndex(QJsonObject const& params, QString const& key)
+{
+	auto const value = params.value(key);
+	auto const index = value.toInt(-1);
+	if (!value.isDouble() || index < 0 || index > 0xFFFF)
+	{
+		throw InvalidParamsException{ QString("'%1' must be a descriptor index").arg(key).toStdString() };
+	}
+	return static_cast<std::uint16_t>(index);
+}
+
+static QJsonObject toObject(QJsonObject const& params, QString const& key)
+{
+	auto const value = params.value(key);
+	if (!value.isObject())
+	{
+		throw InvalidParamsException{ QString("'%1' must be an object").arg(key).toStdString() };
+	}
+	return value.toObject();
+}
+
+static QJsonArray toArray(QJsonObject const& params, QString const& key)
+{
+	auto const value = params.value(key);
+	if (!value.isArray())
+	{
+		throw InvalidParamsException{ QString("'%1' must be an array").arg(key).toStdString() };
+	}
+	return value.toArray();
+}
+
+/** { "configuration", "audioUnit", "streamPort", "cluster", "baseCluster", "channel" } */
+static avdecc::ChannelIdentification toChannelIdentification(QJsonObject const& channel, avdecc::ChannelConnectionDirection const direction)
+{
+	return avdecc::ChannelIdentification{ toIndex(channel, "configuration"), toIndex(channel, "cluster"), toIndex(channel, "channel"), direction, toIndex(channel, "audioUnit"), toIndex(channel, "streamPort"), toIndex(channel, "baseCluster") };
+}
+
+static QString toString(la::avdecc::entity::model::StreamConnectionState::State const state) noexcept
+{
+	switch (state)
+	{
+		case la::avdecc::entity::model::StreamConnectionState::State::NotConnected:
+			return "notConnected";
+		case la::avdecc::entity::model::StreamConnectionState::State::FastConnecting:
+			return "fastConnecting";
+		case la::avdecc::entity::model::StreamConnectionState::State::Connected:
+			return "connected";
+		default:
+			AVDECC_ASSERT(false, "Unhandled state");
+			return "unknown";
+	}
+}
+
+static QString toString(avdecc::ChannelConnectionManager::ChannelConnectResult const result) noexcept
+{
+	switch (result)
+	{
+		case avdecc::ChannelConnectionManager::ChannelConnectResult::NoError:
+			return "noError";
+		case avdecc::ChannelConnectionManager::ChannelConnectResult::RemovalOfListenerDynamicMappingsNecessary:
+			return "removalOfListenerDynamicMappingsNecessary";
+		case avdecc::ChannelConnectionManager::ChannelConnectResult::Impossible:
+			return "impossible";
+		case avdecc::ChannelConnectionManager::ChannelConnectResult::Error:
+			return "error";
+		case avdecc::ChannelConnectionManager::ChannelConnectResult::Unsupported:
+			return "unsupported";
+		case avdecc::ChannelConnectionManager::ChannelConnectResult::NeedsTalkerMappingAdjustment:
+			return "needsTalkerMappingAdjustment";
+		default:
+			AVDECC_ASSERT(false, "Unhandled result");
+			return "unknown";
+	}
+}
+
+static QString toString(avdecc::ChannelConnectionManager::ChannelDisconnectResult const result) noexcept
+{
+	switch (result)
+	{
+		case avdecc::ChannelConnectionManager::ChannelDisconnectResult::NoError:
+			return "noError";
+		case avdecc::ChannelConnectionManager::ChannelDisconnectResult::NonExistent:
+			return "nonExistent";
+		case avdecc::ChannelConnectionManager::ChannelDisconnectResult::Error:
+			return "error";
+		case avdecc::ChannelConnectionManager::ChannelDisconnectResult::Unsupported:
+			return "unsupported";
+		default:
+			AVDECC_ASSERT(false, "Unhandled result");
+			return "unknown";
+	}
+}
+
+static QString toString(avdecc::mediaClock::McDeterminationError const error) noexcept
+{
+	switch (error)
+	{
+		case avdecc::mediaClock::McDeterminationError::NoError:
+			return "noError";
+		case avdecc::mediaClock::McDeterminationError::NotSupportedNoAem:
+			return "notSupportedNoAem";
+		case avdecc::mediaClock::McDeterminationError::NotSupportedMultipleClockDomains:
+			return "notSupportedMultipleClockDomains";
+		case avdecc::mediaClock::McDeterminationError::NotSupportedNoClockDomains:
+			return "notSupportedNoClockDomains";
+		case avdecc::mediaClock::McDeterminationError::NotSupportedClockSourceType:
+			return "notSupportedClockSourceType";
+		case avdecc::mediaClock::McDeterminationError::Recursive:
+			return "recursive";
+		case avdecc::mediaClock::McDeterminationError::StreamNotConnected:
+			return "streamNotConnected";
+		case avdecc::mediaClock::McDeterminationError::ParentStreamNotConnected:
+			return "parentStreamNotConnected";
+		case avdecc::mediaClock::McDeterminationError::ExternalClockSource:
+			return "externalClockSource";
+		case avdecc::mediaClock::McDeterminationError::AnyEntityInChainOffline:
+			return "anyEntityInChainOffline";
+		case avdecc::mediaClock::McDeterminationError::UnknownEntity:
+			return "unknownEntity";
+		default:
+			AVDECC_ASSERT(false, "Unhandled error");
+			return "unknown";
+	}
+}
+
+static QString toString(avdecc::commandChain::CommandExecutionError const error) noexcept
+{
+	switch (error)
+	{
+		case avdecc::commandChain::CommandExecutionError::NoError:
+			return "noError";
+		case avdecc::commandChain::CommandExecutionError::LockedByOther:
+			return "lockedByOther";
+		case avdecc::commandChain::CommandExecutionError::AcquiredByOther:
+			return "acquiredByOther";
+		case avdecc::commandChain::CommandExecutionError::EntityError:
+			return "entityError";
+		case avdecc::commandChain::CommandExecutionError::CommandFailure:
+			return "commandFailure";
+		case avdecc::commandChain::CommandExecutionError::NetworkIssue:
+			return "networkIssue";
+		case avdecc::commandChain::CommandExecutionError::Timeout:
+			return "timeout";
+		case avdecc::commandChain::CommandExecutionError::NotSupported:
+			return "notSupported";
+		case avdecc::commandChain::CommandExecutionError::NoMediaClockOutputAvailable:
+			return "noMediaClockOutputAvailable";
+		case avdecc::commandChain::CommandExecutionError::NoMediaClockInputAvailable:
+			return "noMediaClockInputAvailable";
+		default:
+			AVDECC_ASSERT(false, "Unhandled error");
+			return "unknown";
+	}
+}
+
+static QJsonArray toJson(avdecc::commandChain::CommandExecutionErrors const& errors) noexcept
+{
+	auto result = QJsonArray{};
+	for (auto const& [entityID, errorInfo] : errors)
+	{
+		auto error = QJsonObject{ { "entityID", toString(entityID) }, { "error", toString(errorInfo.errorType) } };
+		if (errorInfo.commandTypeAcmp)
+		{
+			error.insert("command", avdecc::ControllerManager::typeToString(*errorInfo.commandTypeAcmp));
+		}
+		if (errorInfo.commandTypeAecp)
+		{
+			error.insert("command", avdecc::ControllerManager::typeToString(*errorInfo.commandTypeAecp));
+		}
+		result.append(error);
+	}
+	return result;
+}
+
+/** { "domains": [ { "index", "master", "samplingRate" } ], "mappings": { EntityID: [ index ] }, "errors": { EntityID: error } } */
+static QJsonObject toJson(avdecc::mediaClock::MCEntityDomainMapping& model) noexcept
+{
+	auto domains = QJsonArray{};
+	for (auto const& [domainIndex, domain] : model.getMediaClockDomains())
+	{
+		domains.append(QJsonObject{ { "index", static_cast<qint64>(domainIndex) }, { "name", domain.getDisplayName() }, { "master", toString(domain.getMediaClockDomainMaster()) }, { "samplingRate", static_cast<qint64>(domain.getDomainSamplingRate().getValue()) } });
+	}
+
+	auto mappings = QJsonObject{};
+	for (auto const& [entityID, domainIndexes] : model.getEntityMediaClockMasterMappings())
+	{
+		auto indexes = QJsonArray{};
+		for (auto const domainIndex : domainIndexes)
+		{
+			indexes.append(static_cast<qint64>(domainIndex));
+		}
+		mappings.insert(toString(entityID), indexes);
+	}
+
+	auto errors = QJsonObject{};
+	for (auto const& [entityID, error] : model.getEntityMcErrors())
+	{
+		errors.insert(toString(entityID), toString(error));
+	}
+
+	return QJsonObject{ { "domains", domains }, { "mappings", mappings }, { "errors", errors } };
+}
+
+static avdecc::mediaClock::MCEntityDomainMapping toMediaClockDomainModel(QJsonObject const& params)
+{
+	auto domains = avdecc::mediaClock::MCEntityDomainMapping::Domains{};
+	for (auto const& value : toArray(params, "domains"))
+	{
+		auto const domain = value.toObject();
+		auto const domainIndex = static_cast<avdecc::mediaClock::DomainIndex>(toIndex(domain, "index"));
+		domains.emplace(domainIndex, avdecc::mediaClock::MCDomain{ domainIndex, toUniqueIdentifier(domain, "master"), la::avdecc::entity::model::SamplingRate(static_cast<std::uint32_t>(domain.value("samplingRate").toDouble())) });
+	}
+
+	auto mappings = avdecc::mediaClock::MCEntityDomainMapping::Mappings{};
+	auto const jsonMappings = toObject(params, "mappings");
+	for (auto it = jsonMappings.begin(); it != jsonMappings.end(); ++it)
+	{
+		auto domainIndexes = std::vector<avdecc::mediaClock::DomainIndex>{};
+		for (auto const& index : it.value().toArray())
+		{
+			auto const domainIndex = index.toInt(-1);
+			if (domainIndex < 0 || domains.count(static_cast<avdecc::mediaClock::DomainIndex>(domainIndex)) == 0)
+			{
+				throw InvalidParamsException{ QString("Unknown domain index for entity %1").arg(it.key()).toStdString() };
+			}
+			domainIndexes.push_back(static_cast<avdecc::mediaClock::DomainIndex>(domainIndex));
+		}
+		mappings.emplace(toUniqueIdentifier(it.key()), std::move(domainIndexes));
+	}
+
+	return avdecc::mediaClock::MCEntityDomainMapping{ std::move(mappings), std::move(domains), {} };
+}
+
+class RpcServer::RpcServerImpl final : public QObject
+{
+public:
+	RpcServerImpl(QString const& token, QStringList const& allowedOrigins)
+		: _tokenHash{ hashToken(token) }
+		, _allowedOrigins{ allowedOrigins }
+	{
+		connect(&_server, &QWebSocketServer::newConnection, this, &RpcServerImpl::onNewConnection);
+
+		// Any web page can open a WebSocket to the loopback interface, browsers always send their Origin (other clients usually do not)
+		connect(&_server, &QWebSocketServer::originAuthenticationRequired, this,
+			[this](QWebSocketCorsAuthenticator* const authenticator)
+			{
+				auto const& origin = authenticator->origin();
+				auto const isAllowed = origin.isEmpty() || _allowedOrigins.contains(origin, Qt::CaseInsensitive);
+				if (!isAllowed)
+				{
+					LOG_HIVE_WARN(QString("RPC connection refused from origin %1").arg(origin));
+				}
+				authenticator->setAllowed(isAllowed);
+			});
+
+		// Events are sent in batches, at most once per flush period
+		_flushTimer.setSingleShot(true);
+		_flushTimer.setInterval(EventsFlushPeriod);
+		connect(&_flushTimer, &QTimer::timeout, this, &RpcServerImpl::flushEvents);
+
+		connectControllerEvents();
+		connectManagersEvents();
+
+		// Models may also be applied by another client, only answer the request that started this apply
+		connect(&avdecc::mediaClock::MCDomainManager::getInstance(), &avdecc::mediaClock::MCDomainManager::applyMediaClockDomainModelFinished, this,
+			[this](avdecc::mediaClock::ApplyInfo const applyInfo)
+			{
+				auto const replyIt = _pendingMediaClockReplies.find(applyInfo.applyId);
+				if (replyIt != _pendingMediaClockReplies.end())
+				{
+					replyIt->second.result(QJsonObject{ { "errors", toJson(applyInfo.entityApplyErrors) } });
+					_pendingMediaClockReplies.erase(replyIt);
+				}
+			});
+	}
+
+	~RpcServerImpl() noexcept
+	{
+		_server.close();
+	}
+
+	bool listen(std::uint16_t const port) noexcept
+	{
+		return _server.listen(QHostAddress::LocalHost, port);
+	}
+
+	QString errorString() const noexcept
+	{
+		return _server.errorString();
+	}
+
+private:
+	/** Tokens are compared through their hash, so the comparison time does not depend on how many leading characters match */
+	static QByteArray hashToken(QString const& token) noexcept
+	{
+		return QCryptographicHash::hash(token.toUtf8(), QCryptographicHash::Sha256);
+	}
+
+	/** Answer to a request, copyable so it can be given to the command completion handlers */
+	class Reply
+	{
+	public:
+		Reply(QWebSocket* const socket, QJsonValue const& id) noexcept
+			: _socket{ socket }
+			, _id{ id }
+		{
+		}
+
+		QWebSocket* socket() const noexcept
+		{
+			return _socket;
+		}
+
+		void result(QJsonValue const& value) const noexcept
+		{
+			send(QJsonObject{ { "jsonrpc", "2.0" }, { "id", _id }, { "result", value } });
+		}
+
+		void error(int const code, QString const& message) const noexcept
+		{
+			send(QJsonObject{ { "jsonrpc", "2.0" }, { "id", _id }, { "error", QJsonObject{ { "code", code }, { "message", message } } } });
+		}
+
+	private:
+		void send(QJsonObject const& object) const noexcept
+		{
+			// Notifications are never answered, and the client may have left while the command was in flight
+			if (_id.isUndefined() || !_socket)
+			{
+				return;
+			}
+			_socket->sendTextMessage(QString::fromUtf8(QJsonDocument{ object }.toJson(QJsonDocument::Compact)));
+		}
+
+		QPointer<QWebSocket> _socket{};
+		QJsonValue _id{};
+	};
+
+	using Method = void (RpcServerImpl::*)(Reply const& reply, QJsonObject const& params);
+
+	struct Client
+	{
+		bool isAuthenticated{ false };
+		EventCategories subscriptions{ la::avdecc::utils::to_integral(EventCategory::None) };
+		std::uint64_t droppedEventsCount{ 0u }; // Events not sent since the last delivered batch
+	};
+
+	struct PendingEvent
+	{
+		EventCategory category{ EventCategory::None };
+		QByteArray json{}; // Serialized once, whatever the number of clients
+	};
+
+	void onNewConnection() noexcept
+	{
+		while (auto* const socket = _server.nextPendingConnection())
+		{
+			_clients.emplace(socket, Client{});
+
+			connect(socket, &QWebSocket::textMessageReceived, this,
+				[this, socket](QString const& message)
+				{
+					handleRequest(socket, message.toUtf8());
+				});
+			connect(socket, &QWebSocket::disconnected, this,
+				[this, socket]()
+				{
+					_clients.erase(socket);
+					updateSubscribedCategories();
+					socket->deleteLater();
+				});
+
+			LOG_HIVE_INFO(QString("RPC client connected from %1:%2").arg(socket->peerAddress().toString()).arg(socket->peerPort()));
+		}
+	}
+
+	static QHash<QString, Method> const& methods() noexcept
+	{
+		static auto const s_methods = QHash<QString, Method>{
+			{ "getControllerEID", &RpcServerImpl::getControllerEID },
+			{ "listEntities", &RpcServerImpl::listEntities },
+			{ "connectStream", &RpcServerImpl::connectStream },
+			{ "disconnectStream", &RpcServerImpl::disconnectStream },
+			{ "checkChannelConnections", &RpcServerImpl::checkChannelConnections },
+			{ "createChannelConnections", &RpcServerImpl::createChannelConnections },
+			{ "removeChannelConnection", &RpcServerImpl::removeChannelConnection },
+			{ "getMediaClockMaster", &RpcServerImpl::getMediaClockMaster },
+			{ "createMediaClockDomainModel", &RpcServerImpl::createMediaClockDomainModel },
+			{ "applyMediaClockDomainModel", &RpcServerImpl::applyMediaClockDomainModel },
+			{ "subscribe", &RpcServerImpl::subscribe },
+			{ "unsubscribe", &RpcServerImpl::unsubscribe },
+		};
+		return s_methods;
+	}
+
+	void handleRequest(QWebSocket* const socket, QByteArray const& message) noexcept
+	{
+		auto parseError = QJsonParseError{};
+		auto const document = QJsonDocument::fromJson(message, &parseError);
+		if (parseError.error != QJsonParseError::NoError)
+		{
+			Reply{ socket, QJsonValue::Null }.error(ParseError, parseError.errorString());
+			return;
+		}
+		if (!document.isObject())
+		{
+			Reply{ socket, QJsonValue::Null }.error(InvalidRequest, "Batch requests are not supported");
+			return;
+		}
+
+		auto const request = document.object();
+		auto const reply = Reply{ socket, request.value("id") };
+		auto const method = request.value("method").toString();
+		if (request.value("jsonrpc").toString() != "2.0" || method.isEmpty())
+		{
+			reply.error(InvalidRequest, "Not a JSON-RPC 2.0 request");
+			return;
+		}
+
+		// The first request must carry the token, any other one closes the connection
+		auto const clientIt = _clients.find(socket);
+		if (clientIt == _clients.end())
+		{
+			return;
+		}
+		if (!clientIt->second.isAuthenticated)
+		{
+			if (method == "authenticate" && hashToken(request.value("params").toObject().value("token").toString()) == _tokenHash)
+			{
+				clientIt->second.isAuthenticated = true;
+				reply.result(true);
+				return;
+			}
+			LOG_HIVE_WARN(QString("RPC client %1:%2 failed to authenticate").arg(socket->peerAddress().toString()).arg(socket->peerPort()));
+			reply.error(Unauthorized, "Not authenticated");
+			socket->close(QWebSocketProtocol::CloseCodePolicyViolated, "Not authenticated");
+			return;
+		}
+
+		auto const it = methods().constFind(method);
+		if (it == methods().constEnd())
+		{
+			reply.error(MethodNotFound, QString("Unknown method '%1'").arg(method));
+			return;
+		}
+
+		try
+		{
+			(this->*(it.value()))(reply, request.value("params").toObject());
+		}
+		catch (InvalidParamsException const& e)
+		{
+			reply.error(InvalidParams, e.what());
+		}
+		catch (std::exception const& e)
+		{
+			reply.error(ControllerError, e.what());
+		}
+	}
+
+	bool isKnownEntity(la::avdecc::UniqueIdentifier const entityID) const noexcept
+	{
+		return static_cast<bool>(avdecc::ControllerManager::getInstance().getControlledEntity(entityID));
+	}
+
+	/* ************************************************************ */
+	/* Methods                                                      */
+	/* ************************************************************ */
+	void getControllerEID(Reply const& reply, QJsonObject const& /*params*/)
+	{
+		reply.result(toString(avdecc::ControllerManager::getInstance().getControllerEID()));
+	}
+
+	void listEntities(Reply const& reply, QJsonObject const& /*params*/)
+	{
+		auto entities = QJsonArray{};
+		avdecc::ControllerManager::getInstance().foreachEntity(
+			[&entities](la::avdecc::UniqueIdentifier const& entityID, la::avdecc::controller::ControlledEntity const& entity)
+			{
+				entities.append(QJsonObject{ { "entityID", toString(entityID) }, { "entityModelID", toString(entity.getEntity().getEntityModelID()) }, { "name", avdecc::helper::entityName(entity) }, { "groupName", avdecc::helper::groupName(entity) }, { "hasAem", entity.getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported) } });
+			});
+		reply.result(entities);
+	}
+
+	void connectStream(Reply const& reply, QJsonObject const& params)
+	{
+		streamCommand(reply, params, false);
+	}
+
+	void disconnectStream(Reply const& reply, QJsonObject const& params)
+	{
+		streamCommand(reply, params, true);
+	}
+
+	void streamCommand(Reply const& reply, QJsonObject const& params, bool const disconnect)
+	{
+		auto const talkerID = toUniqueIdentifier(params, "talker");
+		auto const talkerStreamIndex = toIndex(params, "talkerStream");
+		auto const listenerID = toUniqueIdentifier(params, "listener");
+		auto const listenerStreamIndex = toIndex(params, "listenerStream");
+
+		// The result handler is called from the controller thread, the answer is sent from the Qt Main Thread
+		auto const handler = [this, reply](la::avdecc::UniqueIdentifier const /*talkerEntityID*/, la::avdecc::entity::model::StreamIndex const /*talkerStreamIndex*/, la::avdecc::UniqueIdentifier const /*listenerEntityID*/, la::avdecc::entity::model::StreamIndex const /*listenerStreamIndex*/, la::avdecc::entity::ControllerEntity::ControlStatus const status)
+		{
+			QMetaObject::invokeMethod(this,
+				[reply, status]()
+				{
+					if (status == la::avdecc::entity::ControllerEntity::ControlStatus::Success)
+					{
+						reply.result(QJsonObject{ { "status", QString::fromStdString(la::avdecc::entity::ControllerEntity::statusToString(status)) } });
+					}
+					else
+					{
+						reply.error(ControllerError, QString::fromStdString(la::avdecc::entity::ControllerEntity::statusToString(status)));
+					}
+				});
+		};
+
+		auto& manager = avdecc::ControllerManager::getInstance();
+		if (disconnect)
+		{
+			manager.disconnectStream(talkerID, talkerStreamIndex, listenerID, listenerStreamIndex, handler);
+		}
+		else
+		{
+			manager.connectStream(talkerID, talkerStreamIndex, listenerID, listenerStreamIndex, handler);
+		}
+	}
+
+	/** { "talker", "listener", "connections": [ { "talker": channel, "listener": channel } ], "allowTalkerMappingChanges", "allowRemovalOfUnusedAudioMappings" } */
+	struct ChannelConnectionsParams
+	{
+		la::avdecc::UniqueIdentifier talkerID{};
+		la::avdecc::UniqueIdentifier listenerID{};
+		std::vector<std::pair<avdecc::ChannelIdentification, avdecc::ChannelIdentification>> connections{};
+		bool allowTalkerMappingChanges{ false };
+		bool allowRemovalOfUnusedAudioMappings{ false };
+	};
+
+	ChannelConnectionsParams toChannelConnectionsParams(QJsonObject const& params) const
+	{
+		auto result = ChannelConnectionsParams{ toUniqueIdentifier(params, "talker"), toUniqueIdentifier(params, "listener") };
+		if (!isKnownEntity(result.talkerID) || !isKnownEntity(result.listenerID))
+		{
+			throw InvalidParamsException{ "Unknown talker or listener entity" };
+		}
+		for (auto const& value : toArray(params, "connections"))
+		{
+			auto const connection = value.toObject();
+			result.connections.emplace_back(toChannelIdentification(toObject(connection, "talker"), avdecc::ChannelConnectionDirection::OutputToInput), toChannelIdentification(toObject(connection, "listener"), avdecc::ChannelConnectionDirection::InputToOutput));
+		}
+		result.allowTalkerMappingChanges = params.value("allowTalkerMappingChanges").toBool(false);
+		result.allowRemovalOfUnusedAudioMappings = params.value("allowRemovalOfUnusedAudioMappings").toBool(false);
+		return result;
+	}
+
+	void checkChannelConnections(Reply const& reply, QJsonObject const& params)
+	{
+		auto const p = toChannelConnectionsParams(params);
+		auto const result = avdecc::ChannelConnectionManager::getInstance().checkChannelConnections(p.talkerID, p.listenerID, p.connections, p.allowTalkerMappingChanges, p.allowRemovalOfUnusedAudioMappings);
+		reply.result(toString(result));
+	}
+
+	/** Answers once the commands are sent, their completion is reported by the "channelConnectionsCreated" event */
+	void createChannelConnections(Reply const& reply, QJsonObject const& params)
+	{
+		auto const p = toChannelConnectionsParams(params);
+		auto const result = avdecc::ChannelConnectionManager::getInstance().createChannelConnections(p.talkerID, p.listenerID, p.connections, p.allowTalkerMappingChanges, p.allowRemovalOfUnusedAudioMappings);
+		reply.result(toString(result));
+	}
+
+	/** { "talker", "talkerChannel": channel, "listener", "listenerChannel": channel } */
+	void removeChannelConnection(Reply const& reply, QJsonObject const& params)
+	{
+		auto const talkerID = toUniqueIdentifier(params, "talker");
+		auto const listenerID = toUniqueIdentifier(params, "listener");
+		auto const talker = toObject(params, "talkerChannel");
+		auto const listener = toObject(params, "listenerChannel");
+		auto const result = avdecc::ChannelConnectionManager::getInstance().removeChannelConnection(talkerID, toIndex(talker, "audioUnit"), toIndex(talker, "streamPort"), toIndex(talker, "cluster"), toIndex(talker, "baseCluster"), toIndex(talker, "channel"), listenerID, toIndex(listener, "audioUnit"), toIndex(listener, "streamPort"), toIndex(listener, "cluster"), toIndex(listener, "baseCluster"), toIndex(listener, "channel"));
+		reply.result(toString(result));
+	}
+
+	void getMediaClockMaster(Reply const& reply, QJsonObject const& params)
+	{
+		auto const [masterID, error] = avdecc::mediaClock::MCDomainManager::getInstance().getMediaClockMaster(toUniqueIdentifier(params, "entityID"));
+		reply.result(QJsonObject{ { "master", toString(masterID) }, { "error", toString(error) } });
+	}
+
+	void createMediaClockDomainModel(Reply const& reply, QJsonObject const& /*params*/)
+	{
+		auto model = avdecc::mediaClock::MCDomainManager::getInstance().createMediaClockDomainModel();
+		reply.result(toJson(model));
+	}
+
+	/** Same format as the createMediaClockDomainModel result, entities not listed in the mappings are left untouched. Answered once all the commands completed */
+	void applyMediaClockDomainModel(Reply const& reply, QJsonObject const& params)
+	{
+		auto const model = toMediaClockDomainModel(params);
+		auto const applyId = avdecc::mediaClock::MCDomainManager::getInstance().applyMediaClockDomainModel(model);
+		_pendingMediaClockReplies.emplace(applyId, reply);
+	}
+
+	/** { "categories": [ name ] }, all categories if not specified. Returns the categories the client is now subscribed to */
+	void subscribe(Reply const& reply, QJsonObject const& params)
+	{
+		auto& client = _clients.at(reply.socket());
+		client.subscriptions |= toEventCategories(params);
+		updateSubscribedCategories();
+		reply.result(eventCategoriesToJson(client.subscriptions));
+	}
+
+	void unsubscribe(Reply const& reply, QJsonObject const& params)
+	{
+		auto& client = _clients.at(reply.socket());
+		client.subscriptions &= ~toEventCategories(params);
+		updateSubscribedCategories();
+		reply.result(eventCategoriesToJson(client.subscriptions));
+	}
+
+	static EventCategories toEventCategories(QJsonObject const& params)
+	{
+		if (!params.contains("categories"))
+		{
+			return la::avdecc::utils::to_integral(EventCategory::All);
+		}
+		auto categories = EventCategories{ 0u };
+		for (auto const& value : toArray(params, "categories"))
+		{
+			auto const name = value.toString();
+			auto const it = std::find_if(s_eventCategories.begin(), s_eventCategories.end(),
+				[&name](auto const& category)
+				{
+					return category.first == name;
+				});
+			if (it == s_eventCategories.end())
+			{
+				throw InvalidParamsException{ QString("Unknown event category '%1'").arg(name).toStdString() };
+			}
+			categories |= la::avdecc::utils::to_integral(it->second);
+		}
+		return categories;
+	}
+
+	static QJsonArray eventCategoriesToJson(EventCategories const categories) noexcept
+	{
+		auto result = QJsonArray{};
+		for (auto const& [name, category] : s_eventCategories)
+		{
+			if ((categories & la::avdecc::utils::to_integral(category)) != 0u)
+			{
+				result.append(name);
+			}
+		}
+		return result;
+	}
+
+	void updateSubscribedCategories() noexcept
+	{
+		_subscribedCategories = 0u;
+		for (auto const& [socket, client] : _clients)
+		{
+			_subscribedCategories |= client.subscriptions;
+		}
+	}
+
+	/* ************************************************************ */
+	/* Events                                                       */
+	/* ************************************************************ */
+	bool isSubscribed(EventCategory const category) const noexcept
+	{
+		return (_subscribedCategories & la::avdecc::utils::to_integral(category)) != 0u;
+	}
+
+	/** Queues an event delivered in order. It seals the pending coalesced events, so none of them can be merged with a later one and delivered before it */
+	void postEvent(EventCategory const category, QString const& name, QJsonObject&& event) noexcept
+	{
+		if (!isSubscribed(category))
+		{
+			return;
+		}
+		event.insert("event", name);
+		queueEvent(PendingEvent{ category, QJsonDocument{ event }.toJson(QJsonDocument::Compact) });
+		_pendingSlots.clear();
+	}
+
+	/** Queues an event replacing the pending one with the same key (last value wins) while keeping its position in the batch */
+	void postCoalescedEvent(EventCategory const category, QString const& key, QString const& name, QJsonObject&& event) noexcept
+	{
+		if (!isSubscribed(category))
+		{
+			return;
+		}
+		event.insert("event", name);
+		auto pendingEvent = PendingEvent{ category, QJsonDocument{ event }.toJson(QJsonDocument::Compact) };
+
+		auto const it = _pendingSlots.constFind(key);
+		if (it != _pendingSlots.constEnd())
+		{
+			_pendingEvents[it.value()] = std::move(pendingEvent);
+			return;
+		}
+		_pendingSlots.insert(key, _pendingEvents.size());
+		queueEvent(std::move(pendingEvent));
+	}
+
+	void queueEvent(PendingEvent&& event) noexcept
+	{
+		_pendingEvents.push_back(std::move(event));
+		if (!_flushTimer.isActive())
+		{
+			_flushTimer.start();
+		}
+	}
+
+	/** Sends one "events" notification per client. Clients with the same subscriptions share the same message */
+	void flushEvents() noexcept
+	{
+		auto messages = std::unordered_map<EventCategories, std::pair<QString, std::uint64_t>>{}; // Message and events count, per subscriptions mask
+
+		for (auto& [socket, client] : _clients)
+		{
+			if (client.subscriptions == 0u)
+			{
+				continue;
+			}
+
+			auto messageIt = messages.find(client.subscriptions);
+			if (messageIt == messages.end())
+			{
+				auto json = QByteArray{ R"({"jsonrpc":"2.0","method":"events","params":[)" };
+				auto count = std::uint64_t{ 0u };
+				for (auto const& event : _pendingEvents)
+				{
+					if ((client.subscriptions & la::avdecc::utils::to_integral(event.category)) != 0u)
+					{
+						if (count != 0u)
+						{
+							json.append(',');
+						}
+						json.append(event.json);
+						++count;
+					}
+				}
+				json.append("]}");
+				messageIt = messages.emplace(client.subscriptions, std::make_pair(QString::fromUtf8(json), count)).first;
+			}
+
+			auto const& [message, count] = messageIt->second;
+			if (count == 0u)
+			{
+				continue;
+			}
+
+			// The client did not read what we already sent, don't queue more data: it is told how many events it missed once it catches up
+			if (socket->bytesToWrite() > MaxPendingBytesPerClient)
+			{
+				client.droppedEventsCount += count;
+				continue;
+			}
+
+			if (client.droppedEventsCount != 0u)
+			{
+				socket->sendTextMessage(QString::fromUtf8(QJsonDocument{ QJsonObject{ { "jsonrpc", "2.0" }, { "method", "eventsDropped" }, { "params", QJsonObject{ { "count", static_cast<qint64>(client.droppedEventsCount) } } } } }.toJson(QJsonDocument::Compact)));
+				client.droppedEventsCount = 0u;
+			}
+			socket->sendTextMessage(message);
+		}
+
+		_pendingEvents.clear();
+		_pendingSlots.clear();
+	}
+
+	static QString makeKey(QString const& name, la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType = la::avdecc::entity::model::DescriptorType::Entity, la::avdecc::entity::model::DescriptorIndex const descriptorIndex = 0u) noexcept
+	{
+		return QString("%1/%2/%3/%4").arg(name).arg(entityID.getValue()).arg(la::avdecc::utils::to_integral(descriptorType)).arg(descriptorIndex);
+	}
+
+	void connectControllerEvents() noexcept
+	{
+		auto& manager = avdecc::ControllerManager::getInstance();
+
+		// Entities
+		connect(&manager, &avdecc::ControllerManager::controllerOnline, this,
+			[this]()
+			{
+				postEvent(EventCategory::Entities, "controllerOnline", QJsonObject{ { "controllerID", toString(avdecc::ControllerManager::getInstance().getControllerEID()) } });
+			});
+		connect(&manager, &avdecc::ControllerManager::controllerOffline, this,
+			[this]()
+			{
+				postEvent(EventCategory::Entities, "controllerOffline", QJsonObject{});
+			});
+		connect(&manager, &avdecc::ControllerManager::entityOnline, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, std::chrono::milliseconds const enumerationTime)
+			{
+				postEvent(EventCategory::Entities, "entityOnline", QJsonObject{ { "entityID", toString(entityID) }, { "enumerationTime", static_cast<qint64>(enumerationTime.count()) } });
+			});
+		connect(&manager, &avdecc::ControllerManager::entityOffline, this,
+			[this](la::avdecc::UniqueIdentifier const entityID)
+			{
+				postEvent(EventCategory::Entities, "entityOffline", QJsonObject{ { "entityID", toString(entityID) } });
+			});
+
+		// Connections
+		connect(&manager, &avdecc::ControllerManager::streamConnectionChanged, this,
+			[this](la::avdecc::entity::model::StreamConnectionState const& state)
+			{
+				postCoalescedEvent(EventCategory::Connections, makeKey("streamConnection", state.listenerStream.entityID, la::avdecc::entity::model::DescriptorType::StreamInput, state.listenerStream.streamIndex), "streamConnectionChanged",
+					QJsonObject{ { "listener", toString(state.listenerStream.entityID) }, { "listenerStream", state.listenerStream.streamIndex }, { "talker", toString(state.talkerStream.entityID) }, { "talkerStream", state.talkerStream.streamIndex }, { "state", toString(state.state) } });
+			});
+
+		// Names
+		connect(&manager, &avdecc::ControllerManager::entityNameChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, QString const& entityName)
+			{
+				postCoalescedEvent(EventCategory::Names, makeKey("entityName", entityID), "entityNameChanged", QJsonObject{ { "entityID", toString(entityID) }, { "name", entityName } });
+			});
+		connect(&manager, &avdecc::ControllerManager::entityGroupNameChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, QString const& entityGroupName)
+			{
+				postCoalescedEvent(EventCategory::Names, makeKey("entityGroupName", entityID), "entityGroupNameChanged", QJsonObject{ { "entityID", toString(entityID) }, { "groupName", entityGroupName } });
+			});
+
+		// Streams
+		connect(&manager, &avdecc::ControllerManager::streamFormatChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat)
+			{
+				postCoalescedEvent(EventCategory::Streams, makeKey("streamFormat", entityID, descriptorType, streamIndex), "streamFormatChanged",
+					QJsonObject{ { "entityID", toString(entityID) }, { "descriptorType", avdecc::helper::descriptorTypeToString(descriptorType) }, { "streamIndex", streamIndex }, { "streamFormat", avdecc::helper::toHexQString(streamFormat.getValue(), true, true) } });
+			});
+		connect(&manager, &avdecc::ControllerManager::streamRunningChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, bool const isRunning)
+			{
+				postCoalescedEvent(EventCategory::Streams, makeKey("streamRunning", entityID, descriptorType, streamIndex), "streamRunningChanged", QJsonObject{ { "entityID", toString(entityID) }, { "descriptorType", avdecc::helper::descriptorTypeToString(descriptorType) }, { "streamIndex", streamIndex }, { "isRunning", isRunning } });
+			});
+
+		// Access
+		connect(&manager, &avdecc::ControllerManager::acquireStateChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::controller::model::AcquireState const acquireState, la::avdecc::UniqueIdentifier const owningEntity)
+			{
+				postCoalescedEvent(EventCategory::Access, makeKey("acquireState", entityID), "acquireStateChanged", QJsonObject{ { "entityID", toString(entityID) }, { "state", avdecc::helper::acquireStateToString(acquireState, owningEntity) }, { "owner", toString(owningEntity) } });
+			});
+		connect(&manager, &avdecc::ControllerManager::lockStateChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::controller::model::LockState const lockState, la::avdecc::UniqueIdentifier const lockingEntity)
+			{
+				postCoalescedEvent(EventCategory::Access, makeKey("lockState", entityID), "lockStateChanged", QJsonObject{ { "entityID", toString(entityID) }, { "state", avdecc::helper::lockStateToString(lockState, lockingEntity) }, { "owner", toString(lockingEntity) } });
+			});
+
+		// Statistics
+		auto const connectStatistic = [this, &manager](auto const signal, QString const& name)
+		{
+			connect(&manager, signal, this,
+				[this, name](la::avdecc::UniqueIdentifier const entityID, std::uint64_t const value)
+				{
+					postCoalescedEvent(EventCategory::Statistics, makeKey(name, entityID), "statisticChanged", QJsonObject{ { "entityID", toString(entityID) }, { "statistic", name }, { "value", static_cast<qint64>(value) } });
+				});
+		};
+		connectStatistic(&avdecc::ControllerManager::aecpRetryCounterChanged, "aecpRetries");
+		connectStatistic(&avdecc::ControllerManager::aecpTimeoutCounterChanged, "aecpTimeouts");
+		connectStatistic(&avdecc::ControllerManager::aecpUnexpectedResponseCounterChanged, "aecpUnexpectedResponses");
+		connectStatistic(&avdecc::ControllerManager::aemAecpUnsolicitedCounterChanged, "aemAecpUnsolicited");
+		connect(&manager, &avdecc::ControllerManager::streamInputErrorCounterChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, avdecc::ControllerManager::StreamInputErrorCounters const& errorCounters)
+			{
+				auto counters = QJsonObject{};
+				for (auto const& [flag, counter] : errorCounters)
+				{
+					counters.insert(QString::number(la::avdecc::utils::to_integral(flag)), static_cast<qint64>(counter));
+				}
+				postCoalescedEvent(EventCategory::Statistics, makeKey("streamInputErrorCounters", entityID, la::avdecc::entity::model::DescriptorType::StreamInput, descriptorIndex), "streamInputErrorCountersChanged", QJsonObject{ { "entityID", toString(entityID) }, { "streamIndex", descriptorIndex }, { "counters", counters } });
+			});
+	}
+
+	void connectManagersEvents() noexcept
+	{
+		auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
+		connect(&channelConnectionManager, &avdecc::ChannelConnectionManager::listenerChannelConnectionsUpdate, this,
+			[this](std::set<std::pair<la::avdecc::UniqueIdentifier, avdecc::ChannelIdentification>> const& channels)
+			{
+				auto listeners = QJsonArray{};
+				for (auto const& [listenerID, channel] : channels)
+				{
+					listeners.append(QJsonObject{ { "entityID", toString(listenerID) }, { "configuration", channel.configurationIndex }, { "cluster", channel.clusterIndex }, { "channel", channel.clusterChannel } });
+				}
+				postEvent(EventCategory::Connections, "listenerChannelConnectionsChanged", QJsonObject{ { "channels", listeners } });
+			});
+		connect(&channelConnectionManager, &avdecc::ChannelConnectionManager::createChannelConnectionsFinished, this,
+			[this](avdecc::CreateConnectionsInfo const& info)
+			{
+				postEvent(EventCategory::Connections, "channelConnectionsCreated", QJsonObject{ { "errors", toJson(info.connectionCreationErrors) } });
+			});
+
+		auto& mcDomainManager = avdecc::mediaClock::MCDomainManager::getInstance();
+		connect(&mcDomainManager, &avdecc::mediaClock::MCDomainManager::mediaClockConnectionsUpdate, this,
+			[this](std::vector<la::avdecc::UniqueIdentifier> const& entityIds)
+			{
+				auto entities = QJsonArray{};
+				for (auto const& entityID : entityIds)
+				{
+					entities.append(toString(entityID));
+				}
+				postEvent(EventCategory::MediaClock, "mediaClockConnectionsChanged", QJsonObject{ { "entityIDs", entities } });
+			});
+	}
+
+	QWebSocketServer _server{ "Hive Daemon", QWebSocketServer::NonSecureMode };
+	QTimer _flushTimer{};
+	std::unordered_map<QWebSocket*, Client> _clients{};
+	EventCategories _subscribedCategories{ 0u }; // Union of the clients subscriptions, events nobody subscribed to are not even serialized
+	std::vector<PendingEvent> _pendingEvents{};
+	QHash<QString, std::size_t> _pendingSlots{}; // Index in _pendingEvents of each pending coalesced event
+	QByteArray const _tokenHash{};
+	QStringList const _allowedOrigins{};
+	std::unordered_map<avdecc::mediaClock::ApplyID, Reply> _pendingMediaClockReplies{};
+};
+
+RpcServer::RpcServer(QString const& token, QStringList const& allowedOrigins, QObject* parent)
+	: QObject(parent)
+	, _pImpl(new RpcServerImpl(token, allowedOrigins))
+{
+}
+
+RpcServer::~RpcServer() noexcept
+{
+	delete _pImpl;
+}
+
+bool RpcServer::listen(std::uint16_t const port) noexcept
+{
+	return _pImpl->listen(port);
+}
+
+QString RpcServer::errorString() const noexcept
+{
+	return _pImpl->errorString();
+}
@@ -0,0 +1,55 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include <cstdint>
+
+/**
+* @brief    JSON-RPC 2.0 server over a local WebSocket, exposing the controller and the connection managers.
+* @details  Requests are handled in the Qt Main Thread. Being reachable from any web page opened on the host (the loopback interface is not a protection
+*           against browsers), the server rejects the handshake of disallowed origins and only answers clients that authenticated with the shared token. Controller events are serialized once, coalesced per (entity, descriptor, event) and
+*           delivered to subscribed clients in a single "events" notification per flush period. Clients not reading fast enough are skipped
+*           (and told how many events they missed) instead of having an unbounded send queue.
+*/
+class RpcServer : public QObject
+{
+	Q_OBJECT
+public:
+	/** Clients must send an "authenticate" request with the token first. Connections from a browser (non-empty Origin header) are only accepted from the allowed origins */
+	RpcServer(QString const& token, QStringList const& allowedOrigins, QObject* parent = nullptr);
+	~RpcServer() noexcept;
+
+	/** Starts listening on the loopback interface. Returns false (and errorString() is set) if the port cannot be bound */
+	bool listen(std::uint16_t const port) noexcept;
+	QString errorString() const noexcept;
+
+	// Deleted compiler auto-generated methods
+	RpcServer(RpcServer&&) = delete;
+	RpcServer(RpcServer const&) = delete;
+	RpcServer& operator=(RpcServer const&) = delete;
+	RpcServer& operator=(RpcServer&&) = delete;
+
+private:
+	class RpcServerImpl;
+	RpcServerImpl* _pImpl{ nullptr };
+};
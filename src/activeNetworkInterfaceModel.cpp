@@ -79,6 +79,7 @@ ActiveNetworkInterfaceModel::ActiveNetworkInterfaceModel(QObject* parent)
 	settings.registerSettingObserver(settings::Network_InterfaceTypeWiFi.name, d_ptr.get());
 
 	setSourceModel(&d_ptr->_model);
+	connect(&d_ptr->_model, &NetworkInterfaceModel::enumerationCompleted, this, &ActiveNetworkInterfaceModel::enumerationCompleted);
 
 	setSortRole(Qt::WhatsThisRole);
 	sort(0, Qt::AscendingOrder);
@@ -98,6 +99,12 @@ bool ActiveNetworkInterfaceModel::isEnabled(QString const& id) const noexcept
 	return d->_model.isEnabled(id);
 }
 
+bool ActiveNetworkInterfaceModel::isEnumerationCompleted() const noexcept
+{
+	Q_D(const ActiveNetworkInterfaceModel);
+	return d->_model.isEnumerationCompleted();
+}
+
 bool ActiveNetworkInterfaceModel::filterAcceptsRow(int sourceRow, QModelIndex const& /*sourceParent*/) const
 {
 	Q_D(const ActiveNetworkInterfaceModel);
@@ -26,6 +26,7 @@
 class ActiveNetworkInterfaceModelPrivate;
 class ActiveNetworkInterfaceModel : public QSortFilterProxyModel
 {
+	Q_OBJECT
 	using QSortFilterProxyModel::setSourceModel;
 
 public:
@@ -34,6 +35,11 @@ public:
 
 	bool isEnabled(QString const& id) const noexcept;
 
+	// Returns true once the initial list of interfaces is known (enumerated asynchronously)
+	bool isEnumerationCompleted() const noexcept;
+
+	Q_SIGNAL void enumerationCompleted();
+
 private:
 	virtual bool filterAcceptsRow(int sourceRow, QModelIndex const& sourceParent) const override;
 
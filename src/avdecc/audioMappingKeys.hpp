@@ -0,0 +1,162 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+/**
+* Audio mappings packed in 64-bit keys, stored in sorted arrays.
+* Keys sort by stream index, then stream channel, cluster offset and cluster channel, so the mappings of a stream are contiguous,
+* lookups are binary searches and union/difference of two arrays are linear merges.
+*/
+
+#include <la/avdecc/internals/entityModelTypes.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace avdecc
+{
+namespace audioMappingKeys
+{
+using Key = std::uint64_t;
+using Keys = std::vector<Key>; // Sorted, without duplicates
+
+constexpr Key pack(la::avdecc::entity::model::StreamIndex const streamIndex, std::uint16_t const streamChannel, la::avdecc::entity::model::ClusterIndex const clusterOffset, std::uint16_t const clusterChannel) noexcept
+{
+	return (static_cast<Key>(streamIndex) << 48) | (static_cast<Key>(streamChannel) << 32) | (static_cast<Key>(clusterOffset) << 16) | static_cast<Key>(clusterChannel);
+}
+
+constexpr Key pack(la::avdecc::entity::model::AudioMapping const& mapping) noexcept
+{
+	return pack(mapping.streamIndex, mapping.streamChannel, mapping.clusterOffset, mapping.clusterChannel);
+}
+
+constexpr la::avdecc::entity::model::StreamIndex streamIndex(Key const key) noexcept
+{
+	return static_cast<la::avdecc::entity::model::StreamIndex>(key >> 48);
+}
+
+constexpr std::uint16_t streamChannel(Key const key) noexcept
+{
+	return static_cast<std::uint16_t>(key >> 32);
+}
+
+constexpr la::avdecc::entity::model::ClusterIndex clusterOffset(Key const key) noexcept
+{
+	return static_cast<la::avdecc::entity::model::ClusterIndex>(key >> 16);
+}
+
+constexpr std::uint16_t clusterChannel(Key const key) noexcept
+{
+	return static_cast<std::uint16_t>(key);
+}
+
+inline la::avdecc::entity::model::AudioMapping unpack(Key const key) noexcept
+{
+	auto mapping = la::avdecc::entity::model::AudioMapping{};
+	mapping.streamIndex = streamIndex(key);
+	mapping.streamChannel = streamChannel(key);
+	mapping.clusterOffset = clusterOffset(key);
+	mapping.clusterChannel = clusterChannel(key);
+	return mapping;
+}
+
+/** Sorts the keys and removes the duplicates */
+inline void normalize(Keys& keys) noexcept
+{
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+}
+
+/** Appends mappings to sorted keys, keeping them sorted */
+inline void insert(Keys& keys, la::avdecc::entity::model::AudioMappings const& mappings) noexcept
+{
+	auto const previousCount = keys.size();
+	keys.reserve(previousCount + mappings.size());
+	for (auto const& mapping : mappings)
+	{
+		keys.push_back(pack(mapping));
+	}
+	auto const middle = keys.begin() + static_cast<std::ptrdiff_t>(previousCount);
+	std::sort(middle, keys.end());
+	std::inplace_merge(keys.begin(), middle, keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+}
+
+inline Keys fromMappings(la::avdecc::entity::model::AudioMappings const& mappings) noexcept
+{
+	auto keys = Keys{};
+	insert(keys, mappings);
+	return keys;
+}
+
+inline la::avdecc::entity::model::AudioMappings toMappings(Keys const& keys) noexcept
+{
+	auto mappings = la::avdecc::entity::model::AudioMappings{};
+	mappings.reserve(keys.size());
+	for (auto const key : keys)
+	{
+		mappings.push_back(unpack(key));
+	}
+	return mappings;
+}
+
+inline bool contains(Keys const& keys, Key const key) noexcept
+{
+	return std::binary_search(keys.begin(), keys.end(), key);
+}
+
+/** Range of the keys of the mappings of a stream */
+inline std::pair<Keys::const_iterator, Keys::const_iterator> streamRange(Keys const& keys, la::avdecc::entity::model::StreamIndex const stream) noexcept
+{
+	auto const first = std::lower_bound(keys.begin(), keys.end(), pack(stream, 0u, 0u, 0u));
+	auto const last = stream == std::numeric_limits<la::avdecc::entity::model::StreamIndex>::max() ? keys.end() : std::lower_bound(first, keys.end(), pack(static_cast<la::avdecc::entity::model::StreamIndex>(stream + 1u), 0u, 0u, 0u));
+	return { first, last };
+}
+
+inline Keys unite(Keys const& lhs, Keys const& rhs) noexcept
+{
+	auto result = Keys{};
+	result.reserve(lhs.size() + rhs.size());
+	std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(result));
+	return result;
+}
+
+/** Keys of lhs that are not in rhs */
+inline Keys subtract(Keys const& lhs, Keys const& rhs) noexcept
+{
+	auto result = Keys{};
+	std::set_difference(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(result));
+	return result;
+}
+
+/** Keys that are only in one of lhs and rhs (added or removed ones) */
+inline Keys symmetricDifference(Keys const& lhs, Keys const& rhs) noexcept
+{
+	auto result = Keys{};
+	std::set_symmetric_difference(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(result));
+	return result;
+}
+
+} // namespace audioMappingKeys
+} // namespace avdecc
@@ -0,0 +1,663 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "bandwidthAccounting.hpp"
+#include "controllerManager.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace avdecc
+{
+namespace bandwidth
+{
+static constexpr BitsPerSecond ClassAPacketsPerSecond = 8000u; // Class A observation interval is 125us
+static constexpr BitsPerSecond EthernetOverheadBytes = 42u; // Preamble and SFD (8), MAC header with VLAN tag (18), FCS (4), inter frame gap (12)
+static constexpr BitsPerSecond AafHeaderBytes = 24u;
+static constexpr BitsPerSecond Iec61883HeaderBytes = 32u; // AVTP (24) and CIP (8) headers
+static constexpr BitsPerSecond Am824SampleBytes = 4u;
+static constexpr BitsPerSecond CrfHeaderBytes = 20u;
+static constexpr BitsPerSecond CrfTimestampBytes = 8u;
+
+static BitsPerSecond samplingRateToHz(la::avdecc::entity::model::StreamFormatInfo::SamplingRate const samplingRate) noexcept
+{
+	switch (samplingRate)
+	{
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::Hz_500:
+			return 500u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_8:
+			return 8000u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_16:
+			return 16000u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_24:
+			return 24000u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_32:
+			return 32000u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_44_1:
+			return 44100u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_48:
+			return 48000u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_88_2:
+			return 88200u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_96:
+			return 96000u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_176_4:
+			return 176400u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_192:
+			return 192000u;
+		default:
+			return 0u;
+	}
+}
+
+static BitsPerSecond sampleFormatToBytes(la::avdecc::entity::model::StreamFormatInfo::SampleFormat const sampleFormat) noexcept
+{
+	switch (sampleFormat)
+	{
+		case la::avdecc::entity::model::StreamFormatInfo::SampleFormat::Int8:
+			return 1u;
+		case la::avdecc::entity::model::StreamFormatInfo::SampleFormat::Int16:
+			return 2u;
+		case la::avdecc::entity::model::StreamFormatInfo::SampleFormat::Int24:
+			return 3u;
+		case la::avdecc::entity::model::StreamFormatInfo::SampleFormat::Int32:
+		case la::avdecc::entity::model::StreamFormatInfo::SampleFormat::FixedPoint32:
+		case la::avdecc::entity::model::StreamFormatInfo::SampleFormat::FloatingPoint32:
+			return 4u;
+		case la::avdecc::entity::model::StreamFormatInfo::SampleFormat::Int64:
+			return 8u;
+		default:
+			return 0u;
+	}
+}
+
+BitsPerSecond computeStreamBandwidth(la::avdecc::entity::model::StreamFormat const streamFormat) noexcept
+{
+	auto const formatInfo = la::avdecc::entity::model::StreamFormatInfo::create(streamFormat);
+	auto const samplingRate = samplingRateToHz(formatInfo->getSamplingRate());
+	if (samplingRate == 0u)
+	{
+		return 0u;
+	}
+
+	// Payload bytes of a single packet, and packets per second
+	auto payloadBytes = BitsPerSecond{ 0u };
+	auto packetsPerSecond = ClassAPacketsPerSecond;
+
+	switch (formatInfo->getType())
+	{
+		case la::avdecc::entity::model::StreamFormatInfo::Type::AAF:
+		case la::avdecc::entity::model::StreamFormatInfo::Type::IEC_61883_6:
+		{
+			// "Up to" formats are accounted with their maximum channels count, that's what a listener may require
+			auto const channels = BitsPerSecond{ formatInfo->getChannelsCount() };
+			auto const samplesPerPacket = (samplingRate + ClassAPacketsPerSecond - 1u) / ClassAPacketsPerSecond;
+			if (formatInfo->getType() == la::avdecc::entity::model::StreamFormatInfo::Type::AAF)
+			{
+				payloadBytes = AafHeaderBytes + channels * samplesPerPacket * sampleFormatToBytes(formatInfo->getSampleFormat());
+			}
+			else
+			{
+				payloadBytes = Iec61883HeaderBytes + channels * samplesPerPacket * Am824SampleBytes;
+			}
+			break;
+		}
+		case la::avdecc::entity::model::StreamFormatInfo::Type::ClockReference:
+		{
+			auto const& crfFormat = static_cast<la::avdecc::entity::model::StreamFormatInfoCRF const&>(*formatInfo);
+			auto const timestampsPerPdu = BitsPerSecond{ crfFormat.getTimestampsPerPdu() };
+			auto const samplesPerPdu = BitsPerSecond{ crfFormat.getTimestampInterval() } * timestampsPerPdu;
+			if (samplesPerPdu == 0u)
+			{
+				return 0u;
+			}
+			payloadBytes = CrfHeaderBytes + timestampsPerPdu * CrfTimestampBytes;
+			packetsPerSecond = (samplingRate + samplesPerPdu - 1u) / samplesPerPdu;
+			break;
+		}
+		default:
+			return 0u;
+	}
+
+	return (payloadBytes + EthernetOverheadBytes) * 8u * packetsPerSecond;
+}
+
+QString bandwidthToString(BitsPerSecond const bandwidth) noexcept
+{
+	if (bandwidth >= 1'000'000'000u)
+	{
+		return QString{ "%1 Gbps" }.arg(static_cast<double>(bandwidth) / 1'000'000'000.0, 0, 'f', 2);
+	}
+	if (bandwidth >= 1'000'000u)
+	{
+		return QString{ "%1 Mbps" }.arg(static_cast<double>(bandwidth) / 1'000'000.0, 0, 'f', 2);
+	}
+	return QString{ "%1 kbps" }.arg(static_cast<double>(bandwidth) / 1'000.0, 0, 'f', 2);
+}
+
+// **************************************************************
+// class BandwidthAccountingManagerImpl
+// **************************************************************
+class BandwidthAccountingManagerImpl final : public BandwidthAccountingManager
+{
+public:
+	BandwidthAccountingManagerImpl() noexcept
+	{
+		auto& manager = ControllerManager::getInstance();
+		connect(&manager, &ControllerManager::controllerOffline, this, &BandwidthAccountingManagerImpl::handleControllerOffline);
+		connect(&manager, &ControllerManager::entityOnline, this, &BandwidthAccountingManagerImpl::handleEntityOnline);
+		connect(&manager, &ControllerManager::entityOffline, this, &BandwidthAccountingManagerImpl::handleEntityOffline);
+		connect(&manager, &ControllerManager::streamFormatChanged, this, &BandwidthAccountingManagerImpl::handleStreamFormatChanged);
+		connect(&manager, &ControllerManager::streamConnectionChanged, this, &BandwidthAccountingManagerImpl::handleStreamConnectionChanged);
+		connect(&manager, &ControllerManager::asPathChanged, this, &BandwidthAccountingManagerImpl::handleAsPathChanged);
+	}
+
+	// Deleted compiler auto-generated methods
+	BandwidthAccountingManagerImpl(BandwidthAccountingManagerImpl const&) = delete;
+	BandwidthAccountingManagerImpl(BandwidthAccountingManagerImpl&&) = delete;
+	BandwidthAccountingManagerImpl& operator=(BandwidthAccountingManagerImpl const&) = delete;
+	BandwidthAccountingManagerImpl& operator=(BandwidthAccountingManagerImpl&&) = delete;
+
+private:
+	using StreamKey = std::pair<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::StreamIndex>;
+	using InterfaceKey = std::pair<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::AvbInterfaceIndex>;
+
+	struct TalkerStream
+	{
+		BitsPerSecond bandwidth{ 0u }; // 0 while the talker is offline or its format cannot be computed
+		la::avdecc::entity::model::AvbInterfaceIndex avbInterfaceIndex{ 0u };
+		std::map<StreamKey, la::avdecc::entity::model::AvbInterfaceIndex> listeners{}; // Connected listener streams, with the AVB interface they are received on
+
+		// What is currently added to the totals, so it can be removed exactly whatever changed since
+		BitsPerSecond accountedBandwidth{ 0u };
+		std::optional<InterfaceKey> accountedInterface{};
+		std::set<Hop> accountedHops{};
+	};
+
+	/** Collects what changed during an update, to notify once at the end */
+	struct Changes
+	{
+		std::set<la::avdecc::UniqueIdentifier> talkers{};
+		bool oversubscription{ false };
+	};
+
+	// BandwidthAccountingManager overrides
+	virtual BitsPerSecond getTalkerBandwidth(la::avdecc::UniqueIdentifier const entityID) const noexcept override
+	{
+		auto const it = _talkerTotals.find(entityID);
+		return it != _talkerTotals.end() ? it->second : 0u;
+	}
+
+	virtual std::map<la::avdecc::entity::model::AvbInterfaceIndex, BitsPerSecond> getInterfacesBandwidth(la::avdecc::UniqueIdentifier const entityID) const noexcept override
+	{
+		auto interfaces = std::map<la::avdecc::entity::model::AvbInterfaceIndex, BitsPerSecond>{};
+		for (auto it = _interfaceTotals.lower_bound(InterfaceKey{ entityID, 0u }); it != _interfaceTotals.end() && it->first.first == entityID; ++it)
+		{
+			interfaces.emplace(it->first.second, it->second);
+		}
+		return interfaces;
+	}
+
+	virtual BitsPerSecond getHopBandwidth(Hop const& hop) const noexcept override
+	{
+		auto const it = _hopTotals.find(hop);
+		return it != _hopTotals.end() ? it->second : 0u;
+	}
+
+	virtual bool hasOversubscription() const noexcept override
+	{
+		return !_oversubscribedInterfaces.empty() || !_oversubscribedHops.empty();
+	}
+
+	virtual bool isTalkerOversubscribed(la::avdecc::UniqueIdentifier const entityID) const noexcept override
+	{
+		if (!hasOversubscription())
+		{
+			return false;
+		}
+		for (auto it = _talkerStreams.lower_bound(StreamKey{ entityID, 0u }); it != _talkerStreams.end() && it->first.first == entityID; ++it)
+		{
+			if (isOversubscribed(it->second))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	virtual bool isStreamOversubscribed(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex) const noexcept override
+	{
+		if (!hasOversubscription())
+		{
+			return false;
+		}
+		auto const it = _talkerStreams.find(StreamKey{ entityID, streamIndex });
+		return it != _talkerStreams.end() && isOversubscribed(it->second);
+	}
+
+	// Private methods
+	bool isOversubscribed(TalkerStream const& stream) const noexcept
+	{
+		if (stream.accountedInterface && _oversubscribedInterfaces.count(*stream.accountedInterface) > 0)
+		{
+			return true;
+		}
+		return std::any_of(stream.accountedHops.begin(), stream.accountedHops.end(),
+			[this](auto const& hop)
+			{
+				return _oversubscribedHops.count(hop) > 0;
+			});
+	}
+
+	/** Adds (or removes if isAdding is false) a bandwidth to a total, keeping the set of oversubscribed keys in sync */
+	template<typename Key>
+	static void adjustTotal(std::map<Key, BitsPerSecond>& totals, std::set<Key>* const oversubscribed, Key const& key, BitsPerSecond const bandwidth, bool const isAdding, Changes& changes) noexcept
+	{
+		auto& total = totals[key];
+		total = isAdding ? total + bandwidth : total - std::min(total, bandwidth);
+
+		if (oversubscribed)
+		{
+			auto const isOver = total > MaxReservableBandwidth;
+			auto const wasOver = oversubscribed->count(key) > 0;
+			if (isOver != wasOver)
+			{
+				if (isOver)
+				{
+					oversubscribed->insert(key);
+				}
+				else
+				{
+					oversubscribed->erase(key);
+				}
+				changes.oversubscription = true;
+			}
+		}
+
+		if (total == 0u)
+		{
+			totals.erase(key);
+		}
+	}
+
+	std::vector<la::avdecc::UniqueIdentifier> const* asPath(InterfaceKey const& key) const noexcept
+	{
+		auto const it = _asPaths.find(key);
+		return (it != _asPaths.end() && !it->second.empty()) ? &it->second : nullptr;
+	}
+
+	/** Hops from the talker interface to each listener, deduced from the AS paths (listeners without a known path don't contribute any hop) */
+	std::set<Hop> computeHops(la::avdecc::UniqueIdentifier const talkerEntityID, TalkerStream const& stream) const noexcept
+	{
+		auto hops = std::set<Hop>{};
+
+		auto const* const talkerPath = asPath(InterfaceKey{ talkerEntityID, stream.avbInterfaceIndex });
+		if (!talkerPath)
+		{
+			return hops;
+		}
+
+		for (auto const& [listenerStream, listenerInterfaceIndex] : stream.listeners)
+		{
+			auto const* const listenerPath = asPath(InterfaceKey{ listenerStream.first, listenerInterfaceIndex });
+			if (!listenerPath)
+			{
+				continue;
+			}
+
+			// Both paths start from the grandmaster, the route goes up the talker path to the last common system then down the listener path
+			auto const mismatch = std::mismatch(talkerPath->begin(), talkerPath->end(), listenerPath->begin(), listenerPath->end());
+			auto route = std::vector<la::avdecc::UniqueIdentifier>{ talkerEntityID };
+			std::copy(std::make_reverse_iterator(talkerPath->end()), std::make_reverse_iterator(mismatch.first), std::back_inserter(route));
+			if (mismatch.first != talkerPath->begin())
+			{
+				route.push_back(*std::prev(mismatch.first));
+			}
+			std::copy(mismatch.second, listenerPath->end(), std::back_inserter(route));
+			route.push_back(listenerStream.first);
+
+			for (auto index = size_t{ 1u }; index < route.size(); ++index)
+			{
+				// Entities usually appear in their own AS path
+				if (route[index - 1] != route[index])
+				{
+					hops.emplace(route[index - 1], route[index]);
+				}
+			}
+		}
+
+		return hops;
+	}
+
+	/** Removes the contribution of a stream from all the totals */
+	void retract(la::avdecc::UniqueIdentifier const talkerEntityID, TalkerStream& stream, Changes& changes) noexcept
+	{
+		if (stream.accountedBandwidth == 0u)
+		{
+			return;
+		}
+
+		adjustTotal<la::avdecc::UniqueIdentifier>(_talkerTotals, nullptr, talkerEntityID, stream.accountedBandwidth, false, changes);
+		if (stream.accountedInterface)
+		{
+			adjustTotal(_interfaceTotals, &_oversubscribedInterfaces, *stream.accountedInterface, stream.accountedBandwidth, false, changes);
+		}
+		for (auto const& hop : stream.accountedHops)
+		{
+			adjustTotal(_hopTotals, &_oversubscribedHops, hop, stream.accountedBandwidth, false, changes);
+		}
+
+		stream.accountedBandwidth = 0u;
+		stream.accountedInterface.reset();
+		stream.accountedHops.clear();
+		changes.talkers.insert(talkerEntityID);
+	}
+
+	/** Adds the contribution of a stream to all the totals, streams only reserve bandwidth once they have a listener */
+	void account(la::avdecc::UniqueIdentifier const talkerEntityID, TalkerStream& stream, Changes& changes) noexcept
+	{
+		if (stream.bandwidth == 0u || stream.listeners.empty())
+		{
+			return;
+		}
+
+		stream.accountedBandwidth = stream.bandwidth;
+		stream.accountedInterface = InterfaceKey{ talkerEntityID, stream.avbInterfaceIndex };
+		stream.accountedHops = computeHops(talkerEntityID, stream);
+
+		adjustTotal<la::avdecc::UniqueIdentifier>(_talkerTotals, nullptr, talkerEntityID, stream.accountedBandwidth, true, changes);
+		adjustTotal(_interfaceTotals, &_oversubscribedInterfaces, *stream.accountedInterface, stream.accountedBandwidth, true, changes);
+		for (auto const& hop : stream.accountedHops)
+		{
+			adjustTotal(_hopTotals, &_oversubscribedHops, hop, stream.accountedBandwidth, true, changes);
+		}
+		changes.talkers.insert(talkerEntityID);
+	}
+
+	/** Runs a modification of a talker stream between the removal and the addition of its contribution */
+	template<typename Modifier>
+	void updateTalkerStream(StreamKey const& talkerStream, Changes& changes, Modifier&& modifier) noexcept
+	{
+		auto& stream = _talkerStreams[talkerStream];
+		retract(talkerStream.first, stream, changes);
+		modifier(stream);
+		account(talkerStream.first, stream, changes);
+	}
+
+	void connectListener(StreamKey const& listenerStream, StreamKey const& talkerStream, la::avdecc::entity::model::AvbInterfaceIndex const listenerInterfaceIndex, Changes& changes) noexcept
+	{
+		disconnectListener(listenerStream, changes);
+
+		_listenerConnections[listenerStream] = talkerStream;
+		updateTalkerStream(talkerStream, changes,
+			[&listenerStream, listenerInterfaceIndex](TalkerStream& stream)
+			{
+				stream.listeners[listenerStream] = listenerInterfaceIndex;
+			});
+	}
+
+	void disconnectListener(StreamKey const& listenerStream, Changes& changes) noexcept
+	{
+		auto const it = _listenerConnections.find(listenerStream);
+		if (it == _listenerConnections.end())
+		{
+			return;
+		}
+
+		auto const talkerStream = it->second;
+		_listenerConnections.erase(it);
+		updateTalkerStream(talkerStream, changes,
+			[&listenerStream](TalkerStream& stream)
+			{
+				stream.listeners.erase(listenerStream);
+			});
+	}
+
+	void notifyChanges(Changes const& changes) noexcept
+	{
+		for (auto const& entityID : changes.talkers)
+		{
+			emit talkerBandwidthChanged(entityID);
+		}
+		if (changes.oversubscription)
+		{
+			emit oversubscriptionChanged();
+		}
+	}
+
+	static std::optional<la::avdecc::entity::model::AvbInterfaceIndex> listenerInterfaceIndex(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex) noexcept
+	{
+		auto controlledEntity = ControllerManager::getInstance().getControlledEntity(entityID);
+		if (controlledEntity && controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+		{
+			try
+			{
+				auto const& configurationNode = controlledEntity->getCurrentConfigurationNode();
+				return controlledEntity->getStreamInputNode(configurationNode.descriptorIndex, streamIndex).staticModel->avbInterfaceIndex;
+			}
+			catch (la::avdecc::controller::ControlledEntity::Exception const&)
+			{
+			}
+		}
+		return std::nullopt;
+	}
+
+	// Slots
+	void handleControllerOffline() noexcept
+	{
+		auto const hadOversubscription = hasOversubscription();
+		auto talkers = std::set<la::avdecc::UniqueIdentifier>{};
+		for (auto const& talkerKV : _talkerTotals)
+		{
+			talkers.insert(talkerKV.first);
+		}
+
+		_talkerStreams.clear();
+		_listenerConnections.clear();
+		_asPaths.clear();
+		_talkerTotals.clear();
+		_interfaceTotals.clear();
+		_hopTotals.clear();
+		_oversubscribedInterfaces.clear();
+		_oversubscribedHops.clear();
+
+		notifyChanges(Changes{ std::move(talkers), hadOversubscription });
+	}
+
+	void handleEntityOnline(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		auto controlledEntity = ControllerManager::getInstance().getControlledEntity(entityID);
+		if (!controlledEntity || !controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+		{
+			return;
+		}
+
+		auto changes = Changes{};
+		try
+		{
+			auto const& configurationNode = controlledEntity->getCurrentConfigurationNode();
+
+			for (auto const& [avbInterfaceIndex, avbInterfaceNode] : configurationNode.avbInterfaces)
+			{
+				if (avbInterfaceNode.dynamicModel && avbInterfaceNode.dynamicModel->asPath)
+				{
+					_asPaths[InterfaceKey{ entityID, avbInterfaceIndex }] = avbInterfaceNode.dynamicModel->asPath->sequence;
+				}
+			}
+
+			for (auto const& [streamIndex, streamOutputNode] : configurationNode.streamOutputs)
+			{
+				auto const bandwidth = streamOutputNode.dynamicModel ? computeStreamBandwidth(streamOutputNode.dynamicModel->streamFormat) : BitsPerSecond{ 0u };
+				auto const avbInterfaceIndex = streamOutputNode.staticModel->avbInterfaceIndex;
+				updateTalkerStream(StreamKey{ entityID, streamIndex }, changes,
+					[bandwidth, avbInterfaceIndex](TalkerStream& stream)
+					{
+						stream.bandwidth = bandwidth;
+						stream.avbInterfaceIndex = avbInterfaceIndex;
+					});
+			}
+
+			for (auto const& [streamIndex, streamInputNode] : configurationNode.streamInputs)
+			{
+				if (streamInputNode.dynamicModel && streamInputNode.dynamicModel->connectionState.state == la::avdecc::entity::model::StreamConnectionState::State::Connected)
+				{
+					auto const& talkerStream = streamInputNode.dynamicModel->connectionState.talkerStream;
+					connectListener(StreamKey{ entityID, streamIndex }, StreamKey{ talkerStream.entityID, talkerStream.streamIndex }, streamInputNode.staticModel->avbInterfaceIndex, changes);
+				}
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+
+		notifyChanges(changes);
+	}
+
+	void handleEntityOffline(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		auto changes = Changes{};
+
+		// Its listener streams no longer reserve anything
+		auto listenerStreams = std::vector<StreamKey>{};
+		for (auto it = _listenerConnections.lower_bound(StreamKey{ entityID, 0u }); it != _listenerConnections.end() && it->first.first == entityID; ++it)
+		{
+			listenerStreams.push_back(it->first);
+		}
+		for (auto const& listenerStream : listenerStreams)
+		{
+			disconnectListener(listenerStream, changes);
+		}
+
+		// Its talker streams are kept with their listeners (they are still connected as far as the listeners know), without bandwidth until the talker is back
+		auto talkerStreams = std::vector<StreamKey>{};
+		for (auto it = _talkerStreams.lower_bound(StreamKey{ entityID, 0u }); it != _talkerStreams.end() && it->first.first == entityID; ++it)
+		{
+			talkerStreams.push_back(it->first);
+		}
+		for (auto const& talkerStream : talkerStreams)
+		{
+			updateTalkerStream(talkerStream, changes,
+				[](TalkerStream& stream)
+				{
+					stream.bandwidth = 0u;
+				});
+			if (_talkerStreams[talkerStream].listeners.empty())
+			{
+				_talkerStreams.erase(talkerStream);
+			}
+		}
+
+		for (auto it = _asPaths.lower_bound(InterfaceKey{ entityID, 0u }); it != _asPaths.end() && it->first.first == entityID;)
+		{
+			it = _asPaths.erase(it);
+		}
+
+		notifyChanges(changes);
+	}
+
+	void handleStreamFormatChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat) noexcept
+	{
+		if (descriptorType != la::avdecc::entity::model::DescriptorType::StreamOutput)
+		{
+			return;
+		}
+
+		auto const it = _talkerStreams.find(StreamKey{ entityID, streamIndex });
+		if (it == _talkerStreams.end())
+		{
+			return;
+		}
+
+		auto changes = Changes{};
+		auto const bandwidth = computeStreamBandwidth(streamFormat);
+		updateTalkerStream(it->first, changes,
+			[bandwidth](TalkerStream& stream)
+			{
+				stream.bandwidth = bandwidth;
+			});
+		notifyChanges(changes);
+	}
+
+	void handleStreamConnectionChanged(la::avdecc::entity::model::StreamConnectionState const& state) noexcept
+	{
+		auto changes = Changes{};
+		auto const listenerStream = StreamKey{ state.listenerStream.entityID, state.listenerStream.streamIndex };
+
+		// Fast connecting streams don't have any reservation yet
+		if (state.state == la::avdecc::entity::model::StreamConnectionState::State::Connected)
+		{
+			if (auto const avbInterfaceIndex = listenerInterfaceIndex(state.listenerStream.entityID, state.listenerStream.streamIndex))
+			{
+				connectListener(listenerStream, StreamKey{ state.talkerStream.entityID, state.talkerStream.streamIndex }, *avbInterfaceIndex, changes);
+			}
+		}
+		else
+		{
+			disconnectListener(listenerStream, changes);
+		}
+
+		notifyChanges(changes);
+	}
+
+	void handleAsPathChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AsPath const& asPath) noexcept
+	{
+		_asPaths[InterfaceKey{ entityID, avbInterfaceIndex }] = asPath.sequence;
+
+		// Only the hops of the streams going through that interface change (AS path changes are rare, a full scan is fine)
+		auto changes = Changes{};
+		for (auto& [talkerStream, stream] : _talkerStreams)
+		{
+			auto const isTalker = talkerStream.first == entityID && stream.avbInterfaceIndex == avbInterfaceIndex;
+			auto const isListener = std::any_of(stream.listeners.begin(), stream.listeners.end(),
+				[entityID, avbInterfaceIndex](auto const& listenerKV)
+				{
+					return listenerKV.first.first == entityID && listenerKV.second == avbInterfaceIndex;
+				});
+			if (isTalker || isListener)
+			{
+				retract(talkerStream.first, stream, changes);
+				account(talkerStream.first, stream, changes);
+			}
+		}
+		notifyChanges(changes);
+	}
+
+	// Private members
+	std::map<StreamKey, TalkerStream> _talkerStreams{};
+	std::map<StreamKey, StreamKey> _listenerConnections{}; // Talker stream of each connected listener stream
+	std::map<InterfaceKey, std::vector<la::avdecc::UniqueIdentifier>> _asPaths{};
+	std::map<la::avdecc::UniqueIdentifier, BitsPerSecond> _talkerTotals{};
+	std::map<InterfaceKey, BitsPerSecond> _interfaceTotals{};
+	std::map<Hop, BitsPerSecond> _hopTotals{};
+	std::set<InterfaceKey> _oversubscribedInterfaces{};
+	std::set<Hop> _oversubscribedHops{};
+};
+
+BandwidthAccountingManager& BandwidthAccountingManager::getInstance() noexcept
+{
+	static BandwidthAccountingManagerImpl s_manager{};
+
+	return s_manager;
+}
+
+} // namespace bandwidth
+} // namespace avdecc
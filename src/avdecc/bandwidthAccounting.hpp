@@ -0,0 +1,72 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/controller/avdeccController.hpp>
+#include <QObject>
+#include <QString>
+
+#include <cstdint>
+#include <map>
+#include <utility>
+
+namespace avdecc
+{
+namespace bandwidth
+{
+using BitsPerSecond = std::uint64_t;
+
+/** A link between two time-aware systems of the AS path (clock identities), oriented from the talker to the listener */
+using Hop = std::pair<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier>;
+
+/** Bandwidth reserved on the wire by a Class A stream of the specified format (including the ethernet framing), 0 if the format cannot be computed */
+BitsPerSecond computeStreamBandwidth(la::avdecc::entity::model::StreamFormat const streamFormat) noexcept;
+
+/** Human readable bandwidth ("12.29 Mbps") */
+QString bandwidthToString(BitsPerSecond const bandwidth) noexcept;
+
+/**
+* @brief Accounts for the bandwidth reserved by the connected talker streams, per talker, per AVB interface and per hop of the AS path.
+*		 Totals are updated by difference each time a stream format, a connection or an AS path changes, a stream only reserving bandwidth once it has at least one listener.
+*		 Hops are deduced from the AS paths of the talker and listener interfaces (the part after their common prefix), a multicast stream being counted once per hop.
+*		 An interface or a hop exceeding MaxReservableBandwidth is oversubscribed, and so are all the streams reserving bandwidth on it.
+*/
+class BandwidthAccountingManager : public QObject
+{
+	Q_OBJECT
+public:
+	static constexpr BitsPerSecond MaxReservableBandwidth = 750'000'000u; // 75% of a gigabit link, the default maximum for SR classes
+
+	static BandwidthAccountingManager& getInstance() noexcept;
+
+	virtual BitsPerSecond getTalkerBandwidth(la::avdecc::UniqueIdentifier const entityID) const noexcept = 0;
+	virtual std::map<la::avdecc::entity::model::AvbInterfaceIndex, BitsPerSecond> getInterfacesBandwidth(la::avdecc::UniqueIdentifier const entityID) const noexcept = 0;
+	virtual BitsPerSecond getHopBandwidth(Hop const& hop) const noexcept = 0;
+
+	virtual bool hasOversubscription() const noexcept = 0;
+	virtual bool isTalkerOversubscribed(la::avdecc::UniqueIdentifier const entityID) const noexcept = 0;
+	virtual bool isStreamOversubscribed(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex) const noexcept = 0;
+
+	Q_SIGNAL void talkerBandwidthChanged(la::avdecc::UniqueIdentifier const entityID);
+	Q_SIGNAL void oversubscriptionChanged();
+};
+
+} // namespace bandwidth
+} // namespace avdecc
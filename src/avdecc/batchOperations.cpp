@@ -0,0 +1,588 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "batchOperations.hpp"
+#include "helper.hpp"
+
+#include <QRegExp>
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <set>
+
+namespace avdecc
+{
+namespace batchOperations
+{
+using AsyncCommand = commandChain::AsyncParallelCommandSet::AsyncCommand;
+using AsyncCommands = std::vector<AsyncCommand>;
+
+static la::avdecc::UniqueIdentifier toUniqueIdentifier(QString text, bool& ok) noexcept
+{
+	if (text.startsWith("0x", Qt::CaseInsensitive))
+	{
+		text.remove(0, 2);
+	}
+	return la::avdecc::UniqueIdentifier{ text.toULongLong(&ok, 16) };
+}
+
+static bool parseStreamsSelection(QStringList const& arguments, StreamsSelection& streams) noexcept
+{
+	if (arguments.isEmpty())
+	{
+		streams = StreamsSelection::All;
+		return true;
+	}
+	if (arguments.size() == 1)
+	{
+		if (arguments[0].compare("inputs", Qt::CaseInsensitive) == 0)
+		{
+			streams = StreamsSelection::Inputs;
+			return true;
+		}
+		if (arguments[0].compare("outputs", Qt::CaseInsensitive) == 0)
+		{
+			streams = StreamsSelection::Outputs;
+			return true;
+		}
+	}
+	return false;
+}
+
+QString parseScript(QString const& text, Script& script) noexcept
+{
+	script = Script{};
+
+	auto const lines = text.split('\n');
+	for (auto lineIndex = 0; lineIndex < lines.size(); ++lineIndex)
+	{
+		auto line = lines[lineIndex];
+		if (auto const commentPos = line.indexOf('#'); commentPos != -1)
+		{
+			line.truncate(commentPos);
+		}
+		line = line.trimmed();
+		if (line.isEmpty())
+		{
+			continue;
+		}
+
+		auto const error = [lineIndex](QString const& message)
+		{
+			return QString("Line %1: %2").arg(lineIndex + 1).arg(message);
+		};
+
+		// Names and wildcards are the whole remaining of the line, so they may contain spaces
+		auto arguments = line.split(QRegExp("\\s+"), QString::SkipEmptyParts);
+		auto const keyword = arguments.takeFirst();
+		auto const remaining = line.mid(keyword.size()).trimmed();
+
+		auto const isKeyword = [&keyword](char const* const name)
+		{
+			return keyword.compare(name, Qt::CaseInsensitive) == 0;
+		};
+
+		if (isKeyword("select"))
+		{
+			if (arguments.isEmpty())
+			{
+				return error("Missing selection (all, name, group or id)");
+			}
+			auto const criterion = arguments.takeFirst();
+			auto const value = remaining.mid(criterion.size()).trimmed();
+			if (criterion.compare("all", Qt::CaseInsensitive) == 0 && arguments.isEmpty())
+			{
+				script.selection.allEntities = true;
+			}
+			else if (criterion.compare("name", Qt::CaseInsensitive) == 0 && !value.isEmpty())
+			{
+				script.selection.namePatterns.append(value);
+			}
+			else if (criterion.compare("group", Qt::CaseInsensitive) == 0 && !value.isEmpty())
+			{
+				script.selection.groupNamePatterns.append(value);
+			}
+			else if (criterion.compare("id", Qt::CaseInsensitive) == 0 && !arguments.isEmpty())
+			{
+				for (auto const& argument : arguments)
+				{
+					auto ok = false;
+					auto const entityID = toUniqueIdentifier(argument, ok);
+					if (!ok)
+					{
+						return error(QString("'%1' is not a valid EntityID").arg(argument));
+					}
+					script.selection.entityIDs.push_back(entityID);
+				}
+			}
+			else
+			{
+				return error(QString("Invalid selection '%1'").arg(remaining));
+			}
+			continue;
+		}
+
+		auto step = Step{};
+		if (isKeyword("acquire") || isKeyword("release") || isKeyword("lock") || isKeyword("unlock"))
+		{
+			if (!arguments.isEmpty())
+			{
+				return error(QString("'%1' takes no argument").arg(keyword));
+			}
+			step.type = isKeyword("acquire") ? Step::Type::Acquire : isKeyword("release") ? Step::Type::Release : isKeyword("lock") ? Step::Type::Lock : Step::Type::Unlock;
+		}
+		else if (isKeyword("startStreams") || isKeyword("stopStreams"))
+		{
+			if (!parseStreamsSelection(arguments, step.streams))
+			{
+				return error(QString("'%1' only accepts 'inputs' or 'outputs'").arg(keyword));
+			}
+			step.type = isKeyword("startStreams") ? Step::Type::StartStreams : Step::Type::StopStreams;
+		}
+		else if (isKeyword("setName") || isKeyword("setGroupName"))
+		{
+			if (remaining.isEmpty())
+			{
+				return error(QString("Missing name pattern for '%1'").arg(keyword));
+			}
+			step.type = isKeyword("setName") ? Step::Type::SetEntityName : Step::Type::SetEntityGroupName;
+			step.namePattern = remaining;
+		}
+		else if (isKeyword("setSamplingRate"))
+		{
+			auto ok = false;
+			step.samplingRate = arguments.size() == 1 ? arguments[0].toUInt(&ok) : 0u;
+			if (!ok || step.samplingRate == 0u)
+			{
+				return error("'setSamplingRate' requires a sampling rate in Hz");
+			}
+			step.type = Step::Type::SetSamplingRate;
+		}
+		else
+		{
+			return error(QString("Unknown statement '%1'").arg(keyword));
+		}
+		script.steps.push_back(std::move(step));
+	}
+
+	if (!script.selection.allEntities && script.selection.entityIDs.empty() && script.selection.namePatterns.isEmpty() && script.selection.groupNamePatterns.isEmpty())
+	{
+		return "No entity selected (missing 'select' statement)";
+	}
+	if (script.steps.empty())
+	{
+		return "No operation to run";
+	}
+	return {};
+}
+
+// **************************************************************
+// class BatchOperationsManagerImpl
+// **************************************************************
+class BatchOperationsManagerImpl final : public BatchOperationsManager
+{
+public:
+	BatchOperationsManagerImpl() noexcept
+	{
+		auto& manager = avdecc::ControllerManager::getInstance();
+		connect(&manager, &ControllerManager::controllerOffline, this,
+			[this]()
+			{
+				_entities.clear();
+			});
+		connect(&manager, &ControllerManager::entityOnline, this,
+			[this](la::avdecc::UniqueIdentifier const entityID)
+			{
+				_entities.insert(entityID);
+			});
+		connect(&manager, &ControllerManager::entityOffline, this,
+			[this](la::avdecc::UniqueIdentifier const entityID)
+			{
+				_entities.erase(entityID);
+			});
+
+		connect(&_executer, &commandChain::AsyncCommandGraphExecuter::progressUpdate, this, &BatchOperationsManager::progressUpdate);
+		connect(&_executer, &commandChain::AsyncCommandGraphExecuter::completed, this,
+			[this](commandChain::CommandExecutionErrors const errors)
+			{
+				_isRunning = false;
+				emit finished(errors);
+			});
+	}
+
+	// Deleted compiler auto-generated methods
+	BatchOperationsManagerImpl(BatchOperationsManagerImpl const&) = delete;
+	BatchOperationsManagerImpl(BatchOperationsManagerImpl&&) = delete;
+	BatchOperationsManagerImpl& operator=(BatchOperationsManagerImpl const&) = delete;
+	BatchOperationsManagerImpl& operator=(BatchOperationsManagerImpl&&) = delete;
+
+private:
+	/** Response handler completing the command, whatever the extra parameters of the AEM command result */
+	static auto makeResponseHandler(commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex, ControllerManager::AecpCommandType const commandType) noexcept
+	{
+		return [parentCommandSet, commandIndex, commandType](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, auto const&...)
+		{
+			auto const error = commandChain::AsyncParallelCommandSet::aemCommandStatusToCommandError(status);
+			parentCommandSet->completeCommand(commandIndex, entityID, error, commandType);
+		};
+	}
+
+	static bool isAemSupported(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept
+	{
+		return controlledEntity.getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported);
+	}
+
+	static QString expandNamePattern(QString pattern, size_t const position, QString const& currentName) noexcept
+	{
+		pattern.replace("{n}", QString::number(position + 1));
+		pattern.replace("{name}", currentName);
+		return pattern;
+	}
+
+	/** Commands of a single step for an entity, evaluated against its current state when launched so previous steps are taken into account */
+	AsyncCommands buildCommands(la::avdecc::UniqueIdentifier const entityID, size_t const position, Step const& step) const noexcept
+	{
+		auto commands = AsyncCommands{};
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto controlledEntity = manager.getControlledEntity(entityID);
+		if (!controlledEntity || !isAemSupported(*controlledEntity))
+		{
+			return commands;
+		}
+
+		try
+		{
+			switch (step.type)
+			{
+				case Step::Type::Acquire:
+					commands.push_back(
+						[entityID](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+						{
+							avdecc::ControllerManager::getInstance().acquireEntity(entityID, false, makeResponseHandler(parentCommandSet, commandIndex, ControllerManager::AecpCommandType::AcquireEntity));
+							return true;
+						});
+					break;
+				case Step::Type::Release:
+					commands.push_back(
+						[entityID](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+						{
+							avdecc::ControllerManager::getInstance().releaseEntity(entityID, makeResponseHandler(parentCommandSet, commandIndex, ControllerManager::AecpCommandType::ReleaseEntity));
+							return true;
+						});
+					break;
+				case Step::Type::Lock:
+					commands.push_back(
+						[entityID](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+						{
+							avdecc::ControllerManager::getInstance().lockEntity(entityID, makeResponseHandler(parentCommandSet, commandIndex, ControllerManager::AecpCommandType::LockEntity));
+							return true;
+						});
+					break;
+				case Step::Type::Unlock:
+					commands.push_back(
+						[entityID](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+						{
+							avdecc::ControllerManager::getInstance().unlockEntity(entityID, makeResponseHandler(parentCommandSet, commandIndex, ControllerManager::AecpCommandType::UnlockEntity));
+							return true;
+						});
+					break;
+				case Step::Type::StartStreams:
+				case Step::Type::StopStreams:
+				{
+					auto const& configurationNode = controlledEntity->getCurrentConfigurationNode();
+					auto const configurationIndex = configurationNode.descriptorIndex;
+					auto const start = step.type == Step::Type::StartStreams;
+					auto const commandType = start ? ControllerManager::AecpCommandType::StartStream : ControllerManager::AecpCommandType::StopStream;
+					if (step.streams != StreamsSelection::Outputs)
+					{
+						for (auto const& streamKV : configurationNode.streamInputs)
+						{
+							auto const streamIndex = streamKV.first;
+							commands.push_back(
+								[entityID, configurationIndex, streamIndex, start, commandType](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+								{
+									auto& manager = avdecc::ControllerManager::getInstance();
+									if (isStreamRunning(entityID, configurationIndex, streamIndex, true) == start)
+									{
+										return false;
+									}
+									if (start)
+									{
+										manager.startStreamInput(entityID, streamIndex, makeResponseHandler(parentCommandSet, commandIndex, commandType));
+									}
+									else
+									{
+										manager.stopStreamInput(entityID, streamIndex, makeResponseHandler(parentCommandSet, commandIndex, commandType));
+									}
+									return true;
+								});
+						}
+					}
+					if (step.streams != StreamsSelection::Inputs)
+					{
+						for (auto const& streamKV : configurationNode.streamOutputs)
+						{
+							auto const streamIndex = streamKV.first;
+							commands.push_back(
+								[entityID, configurationIndex, streamIndex, start, commandType](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+								{
+									auto& manager = avdecc::ControllerManager::getInstance();
+									if (isStreamRunning(entityID, configurationIndex, streamIndex, false) == start)
+									{
+										return false;
+									}
+									if (start)
+									{
+										manager.startStreamOutput(entityID, streamIndex, makeResponseHandler(parentCommandSet, commandIndex, commandType));
+									}
+									else
+									{
+										manager.stopStreamOutput(entityID, streamIndex, makeResponseHandler(parentCommandSet, commandIndex, commandType));
+									}
+									return true;
+								});
+						}
+					}
+					break;
+				}
+				case Step::Type::SetEntityName:
+				case Step::Type::SetEntityGroupName:
+				{
+					auto const isGroupName = step.type == Step::Type::SetEntityGroupName;
+					auto const currentName = isGroupName ? avdecc::helper::groupName(*controlledEntity) : avdecc::helper::entityName(*controlledEntity);
+					auto const name = expandNamePattern(step.namePattern, position, currentName);
+					if (name == currentName)
+					{
+						break;
+					}
+					commands.push_back(
+						[entityID, name, isGroupName](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+						{
+							auto& manager = avdecc::ControllerManager::getInstance();
+							if (isGroupName)
+							{
+								manager.setEntityGroupName(entityID, name, makeResponseHandler(parentCommandSet, commandIndex, ControllerManager::AecpCommandType::SetEntityGroupName));
+							}
+							else
+							{
+								manager.setEntityName(entityID, name, makeResponseHandler(parentCommandSet, commandIndex, ControllerManager::AecpCommandType::SetEntityName));
+							}
+							return true;
+						});
+					break;
+				}
+				case Step::Type::SetSamplingRate:
+				{
+					for (auto const& audioUnitKV : controlledEntity->getCurrentConfigurationNode().audioUnits)
+					{
+						auto const audioUnitIndex = audioUnitKV.first;
+						auto const& audioUnitNode = audioUnitKV.second;
+						if (!audioUnitNode.staticModel || !audioUnitNode.dynamicModel)
+						{
+							continue;
+						}
+
+						// Match the requested nominal rate against the ones supported by the audio unit (pull factors included)
+						auto const& samplingRates = audioUnitNode.staticModel->samplingRates;
+						auto const rateIt = std::find_if(samplingRates.begin(), samplingRates.end(),
+							[&step](la::avdecc::entity::model::SamplingRate const& samplingRate)
+							{
+								return static_cast<std::uint32_t>(std::lround(samplingRate.getNominalSampleRate())) == step.samplingRate;
+							});
+						if (rateIt == samplingRates.end())
+						{
+							commands.push_back(
+								[entityID](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const /*commandIndex*/) -> bool
+								{
+									parentCommandSet->addErrorInfo(entityID, commandChain::CommandExecutionError::NotSupported, ControllerManager::AecpCommandType::SetSamplingRate);
+									return false;
+								});
+							continue;
+						}
+
+						auto const samplingRate = *rateIt;
+						auto const configurationIndex = controlledEntity->getCurrentConfigurationNode().descriptorIndex;
+						commands.push_back(
+							[entityID, configurationIndex, audioUnitIndex, samplingRate](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+							{
+								auto& manager = avdecc::ControllerManager::getInstance();
+								if (currentSamplingRate(entityID, configurationIndex, audioUnitIndex) == samplingRate)
+								{
+									return false;
+								}
+								manager.setAudioUnitSamplingRate(entityID, audioUnitIndex, samplingRate, makeResponseHandler(parentCommandSet, commandIndex, ControllerManager::AecpCommandType::SetSamplingRate));
+								return true;
+							});
+					}
+					break;
+				}
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+		return commands;
+	}
+
+	static std::optional<bool> isStreamRunning(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::StreamIndex const streamIndex, bool const isInput) noexcept
+	{
+		try
+		{
+			if (auto controlledEntity = avdecc::ControllerManager::getInstance().getControlledEntity(entityID))
+			{
+				if (isInput)
+				{
+					if (auto const* const dynamicModel = controlledEntity->getStreamInputNode(configurationIndex, streamIndex).dynamicModel)
+					{
+						return dynamicModel->isStreamRunning;
+					}
+				}
+				else if (auto const* const dynamicModel = controlledEntity->getStreamOutputNode(configurationIndex, streamIndex).dynamicModel)
+				{
+					return dynamicModel->isStreamRunning;
+				}
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+		return std::nullopt;
+	}
+
+	static std::optional<la::avdecc::entity::model::SamplingRate> currentSamplingRate(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex) noexcept
+	{
+		try
+		{
+			if (auto controlledEntity = avdecc::ControllerManager::getInstance().getControlledEntity(entityID))
+			{
+				if (auto const* const dynamicModel = controlledEntity->getAudioUnitNode(configurationIndex, audioUnitIndex).dynamicModel)
+				{
+					return dynamicModel->currentSamplingRate;
+				}
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+		return std::nullopt;
+	}
+
+	// BatchOperationsManager overrides
+	virtual ControllerManager::EntityIDs resolveSelection(Selection const& selection) const noexcept override
+	{
+		auto const toRegExps = [](QStringList const& patterns)
+		{
+			auto regExps = std::vector<QRegExp>{};
+			for (auto const& pattern : patterns)
+			{
+				regExps.emplace_back(pattern, Qt::CaseInsensitive, QRegExp::Wildcard);
+			}
+			return regExps;
+		};
+		auto const nameRegExps = toRegExps(selection.namePatterns);
+		auto const groupNameRegExps = toRegExps(selection.groupNamePatterns);
+		auto const explicitEntityIDs = std::set<la::avdecc::UniqueIdentifier>{ selection.entityIDs.begin(), selection.entityIDs.end() };
+
+		auto const matchesAny = [](std::vector<QRegExp> const& regExps, QString const& text)
+		{
+			return std::any_of(regExps.begin(), regExps.end(),
+				[&text](QRegExp const& regExp)
+				{
+					return regExp.exactMatch(text);
+				});
+		};
+
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto namedEntities = std::vector<std::pair<QString, la::avdecc::UniqueIdentifier>>{};
+		for (auto const entityID : _entities)
+		{
+			if (auto controlledEntity = manager.getControlledEntity(entityID))
+			{
+				auto const name = avdecc::helper::smartEntityName(*controlledEntity);
+				if (selection.allEntities || explicitEntityIDs.count(entityID) != 0 || matchesAny(nameRegExps, avdecc::helper::entityName(*controlledEntity)) || matchesAny(groupNameRegExps, avdecc::helper::groupName(*controlledEntity)))
+				{
+					namedEntities.emplace_back(name, entityID);
+				}
+			}
+		}
+
+		// Sorted by name so '{n}' in name patterns follows the order the user sees
+		std::sort(namedEntities.begin(), namedEntities.end());
+
+		auto entityIDs = ControllerManager::EntityIDs{};
+		entityIDs.reserve(namedEntities.size());
+		for (auto const& namedEntity : namedEntities)
+		{
+			entityIDs.push_back(namedEntity.second);
+		}
+		return entityIDs;
+	}
+
+	virtual bool run(ControllerManager::EntityIDs const& entityIDs, Steps const& steps, size_t const maxConcurrentEntities) noexcept override
+	{
+		if (_isRunning)
+		{
+			return false;
+		}
+
+		_executer.clear();
+		_executer.setMaxRunningCommandSets(maxConcurrentEntities);
+
+		// Each step of an entity waits for its previous step (same resource), entities do not wait for each other
+		for (auto position = size_t{ 0u }; position < entityIDs.size(); ++position)
+		{
+			auto const entityID = entityIDs[position];
+			for (auto const& step : steps)
+			{
+				auto commands = buildCommands(entityID, position, step);
+				if (commands.empty())
+				{
+					continue;
+				}
+				auto* const commandSet = new commandChain::AsyncParallelCommandSet;
+				commandSet->append(entityID, commands);
+				_executer.addCommandSet(commandSet, commandChain::AsyncCommandGraphExecuter::Resources{ entityID });
+			}
+		}
+
+		_isRunning = true;
+		_executer.start();
+		return true;
+	}
+
+	virtual bool isRunning() const noexcept override
+	{
+		return _isRunning;
+	}
+
+	// Private members
+	std::set<la::avdecc::UniqueIdentifier> _entities{}; // Online entities, only read/write in the UI thread
+	commandChain::AsyncCommandGraphExecuter _executer{};
+	bool _isRunning{ false };
+};
+
+BatchOperationsManager& BatchOperationsManager::getInstance() noexcept
+{
+	static BatchOperationsManagerImpl s_manager{};
+
+	return s_manager;
+}
+
+} // namespace batchOperations
+} // namespace avdecc
@@ -0,0 +1,119 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <la/avdecc/controller/avdeccController.hpp>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include "avdecc/controllerManager.hpp"
+#include "avdecc/commandChain.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace avdecc
+{
+namespace batchOperations
+{
+enum class StreamsSelection
+{
+	All,
+	Inputs,
+	Outputs,
+};
+
+/** One operation applied to each entity of a batch */
+struct Step
+{
+	enum class Type
+	{
+		Acquire,
+		Release,
+		Lock,
+		Unlock,
+		StartStreams,
+		StopStreams,
+		SetEntityName,
+		SetEntityGroupName,
+		SetSamplingRate,
+	};
+
+	Type type{ Type::Acquire };
+	StreamsSelection streams{ StreamsSelection::All }; // StartStreams and StopStreams only
+	QString namePattern{}; // SetEntityName and SetEntityGroupName only, "{n}" is replaced by the 1-based position of the entity in the batch and "{name}" by its current name
+	std::uint32_t samplingRate{ 0u }; // SetSamplingRate only, nominal sampling rate in Hz
+};
+using Steps = std::vector<Step>;
+
+/** Entities a batch applies to, the union of all criteria */
+struct Selection
+{
+	bool allEntities{ false };
+	std::vector<la::avdecc::UniqueIdentifier> entityIDs{};
+	QStringList namePatterns{}; // Wildcard patterns matched against the entity name
+	QStringList groupNamePatterns{}; // Wildcard patterns matched against the entity group name
+};
+
+struct Script
+{
+	Selection selection{};
+	Steps steps{};
+};
+
+/**
+* @brief Parses a batch script, one statement per line ('#' starts a comment):
+*			select all | name <wildcard> | group <wildcard> | id <EntityID> [<EntityID>...]
+*			acquire | release | lock | unlock
+*			startStreams [inputs|outputs] | stopStreams [inputs|outputs]
+*			setName <pattern> | setGroupName <pattern>
+*			setSamplingRate <Hz>
+* @return An empty string on success, the error (prefixed with its line number) otherwise.
+*/
+QString parseScript(QString const& text, Script& script) noexcept;
+
+/**
+* @brief Runs batches of operations on many entities as a single command graph.
+*		 The steps of an entity are executed one after the other (each step waiting for the previous one),
+*		 while entities are processed in parallel with a bounded count of entities in progress.
+*		 Commands with nothing to do (stream already in the requested state, unchanged name, ...) are skipped.
+*		 All errors are reported at once in the finished signal, no individual command result is notified.
+*/
+class BatchOperationsManager : public QObject
+{
+	Q_OBJECT
+public:
+	static constexpr size_t DefaultMaxConcurrentEntities = 16;
+
+	static BatchOperationsManager& getInstance() noexcept;
+
+	/** Returns the online entities matching the selection, sorted by name */
+	virtual ControllerManager::EntityIDs resolveSelection(Selection const& selection) const noexcept = 0;
+
+	/** Starts a batch, returns false if one is already running (or if there is nothing to do, in which case finished is not emitted) */
+	virtual bool run(ControllerManager::EntityIDs const& entityIDs, Steps const& steps, size_t const maxConcurrentEntities = DefaultMaxConcurrentEntities) noexcept = 0;
+	virtual bool isRunning() const noexcept = 0;
+
+	Q_SIGNAL void progressUpdate(uint32_t const completedCommands, uint32_t const totalCommands);
+	Q_SIGNAL void finished(avdecc::commandChain::CommandExecutionErrors const& errors);
+};
+
+} // namespace batchOperations
+} // namespace avdecc
@@ -18,23 +18,68 @@
 */
 
 #include "channelConnectionManager.hpp"
+#include "avdecc/spanTrace.hpp"
 
 #include <set>
+#include <map>
+#include <unordered_map>
 #include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <chrono>
 #include <la/avdecc/avdecc.hpp>
 #include <la/avdecc/controller/avdeccController.hpp>
+#include <QTimer>
+#include <QElapsedTimer>
 
 #include "helper.hpp"
 #include "controllerManager.hpp"
+#include "audioMappingKeys.hpp"
+#include "memoryAccounting.hpp"
 
 namespace avdecc
 {
 class ChannelConnectionManagerImpl final : public ChannelConnectionManager
 {
 private:
+	using ListenerStreamKey = std::pair<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::StreamIndex>;
+	using ListenerStreamConnections = std::map<ListenerStreamKey, la::avdecc::entity::model::StreamConnectionState>;
+	using TalkerStreamConnectionsIndex = std::unordered_map<la::avdecc::UniqueIdentifier, ListenerStreamConnections, la::avdecc::UniqueIdentifier::hash>;
+	using ListenerStreamTalkersIndex = std::map<ListenerStreamKey, la::avdecc::UniqueIdentifier>;
+	using TalkerChannelConnectionsCache = std::unordered_map<la::avdecc::UniqueIdentifier, ChannelConnectionsMap, la::avdecc::UniqueIdentifier::hash>;
+	using AudioMappingKeys = audioMappingKeys::Keys;
+	using StreamPortKey = std::tuple<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::DescriptorType, la::avdecc::entity::model::StreamPortIndex>;
+	using StreamPortAudioMappingsSnapshots = std::map<StreamPortKey, std::optional<AudioMappingKeys>>;
+	using RedundantStreamNodes = std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::controller::model::StreamNode const*>;
+	/** Redundant streams of one direction of an entity, as flat arrays */
+	struct RedundantStreamsTable
+	{
+		std::vector<std::optional<la::avdecc::controller::model::VirtualIndex>> virtualIndexes{}; // StreamIndex -> virtual index of the redundant stream it belongs to
+		std::vector<std::optional<la::avdecc::entity::model::StreamIndex>> primaryStreamIndexes{}; // Virtual index -> primary StreamIndex
+		std::vector<RedundantStreamNodes> redundantStreams{}; // Virtual index -> all its streams (primary included)
+	};
+	struct RedundancyTables
+	{
+		RedundantStreamsTable inputs{};
+		RedundantStreamsTable outputs{};
+	};
+	using RedundancyTablesPerEntity = std::unordered_map<la::avdecc::UniqueIdentifier, RedundancyTables, la::avdecc::UniqueIdentifier::hash>;
+	using ListenerChannels = std::set<std::pair<la::avdecc::UniqueIdentifier, ChannelIdentification>>;
+
+	// Maximum time spent recomputing pending listener channels before yielding back to the event loop
+	static constexpr auto PendingListenerChannelsSliceBudget = std::chrono::milliseconds{ 8 };
+
 	// Private members
 	std::set<la::avdecc::UniqueIdentifier> _entities{}; // No lock required, only read/write in the UI thread
 	std::map<la::avdecc::UniqueIdentifier, std::shared_ptr<SourceChannelConnections>> _listenerChannelMappings;
+	TalkerStreamConnectionsIndex _talkerStreamConnections{}; // Talker entity -> connection state of every listener stream it feeds
+	ListenerStreamTalkersIndex _listenerStreamTalkers{}; // Listener stream -> talker entity it is indexed under in _talkerStreamConnections
+	mutable TalkerChannelConnectionsCache _talkerChannelMappings{}; // Forward counterpart of _listenerChannelMappings, filled on demand by getChannelConnections
+	StreamPortAudioMappingsSnapshots _streamPortAudioMappingsSnapshots{}; // Last known mappings of each stream port, to only refresh the channels a mappings change actually affects
+	mutable RedundancyTablesPerEntity _redundancyTables{}; // Redundant streams of the current configuration of each entity, built when it goes online (or on first use)
+	ListenerChannels _pendingListenerChannels{}; // Listener channels waiting to be recomputed after a mappings change
+	ListenerChannels _pendingListenerChannelsNotifications{}; // Listener channels refreshed on demand, not notified yet
+	QTimer _pendingListenerChannelsTimer{}; // Drives the time-sliced recomputation of _pendingListenerChannels
 
 public:
 	/**
@@ -42,6 +87,10 @@ public:
 	*/
 	ChannelConnectionManagerImpl() noexcept
 	{
+		_pendingListenerChannelsTimer.setSingleShot(true);
+		_pendingListenerChannelsTimer.setInterval(0);
+		connect(&_pendingListenerChannelsTimer, &QTimer::timeout, this, &ChannelConnectionManagerImpl::processPendingListenerChannels);
+
 		auto& manager = avdecc::ControllerManager::getInstance();
 		connect(&manager, &ControllerManager::controllerOffline, this, &ChannelConnectionManagerImpl::onControllerOffline);
 		connect(&manager, &ControllerManager::entityOnline, this, &ChannelConnectionManagerImpl::onEntityOnline);
@@ -49,6 +98,30 @@ public:
 
 		connect(&manager, &ControllerManager::streamConnectionChanged, this, &ChannelConnectionManagerImpl::onStreamConnectionChanged);
 		connect(&manager, &ControllerManager::streamPortAudioMappingsChanged, this, &ChannelConnectionManagerImpl::onStreamPortAudioMappingsChanged);
+
+		MemoryAccounting::getInstance().registerProbe("ChannelConnectionManager",
+			[this](MemoryAccounting::Counters& counters)
+			{
+				auto listenerChannels = std::uint64_t{ 0u };
+				for (auto const& [entityID, connections] : _listenerChannelMappings)
+				{
+					listenerChannels += connections ? connections->channelMappings.size() : 0u;
+				}
+				auto talkerChannels = std::uint64_t{ 0u };
+				for (auto const& [entityID, connections] : _talkerChannelMappings)
+				{
+					talkerChannels += connections.size();
+				}
+				counters.push_back({ "Entities", _entities.size() });
+				counters.push_back({ "ListenerEntities", _listenerChannelMappings.size() });
+				counters.push_back({ "ListenerChannelMappings", listenerChannels });
+				counters.push_back({ "TalkerChannelMappings", talkerChannels });
+				counters.push_back({ "TalkerStreamConnections", _talkerStreamConnections.size() });
+				counters.push_back({ "ListenerStreamTalkers", _listenerStreamTalkers.size() });
+				counters.push_back({ "AudioMappingsSnapshots", _streamPortAudioMappingsSnapshots.size() });
+				counters.push_back({ "RedundancyTables", _redundancyTables.size() });
+				counters.push_back({ "PendingListenerChannels", _pendingListenerChannels.size() });
+			});
 	}
 
 	/**
@@ -177,6 +250,21 @@ private:
 		}
 	};
 
+	/**
+	* Stream channel availability of a talker/listener pair, built once per createChannelConnections call
+	* so every requested channel pair is planned from the same tables instead of rescanning the entity models.
+	*/
+	struct StreamChannelPlanningTables
+	{
+		StreamConnections connectedPrimaryStreamConnections{}; // Existing stream connections between the devices, converted to their primary streams
+		StreamConnections possibleStreamConnections{}; // Stream pairs that are not connected yet but could be used
+		std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::AudioMappings> talkerStreamMappings{}; // Dynamic and static mappings of each talker stream
+		std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::AudioMappings> listenerStreamMappings{}; // Dynamic mappings of each listener stream
+		std::map<la::avdecc::entity::model::StreamIndex, std::set<uint16_t>> unassignedTalkerStreamChannels{};
+		std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::StreamFormat> talkerStreamFormats{};
+		std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::StreamFormat> listenerStreamFormats{};
+	};
+
 	/**
 	* Checks if the given stream is the primary of a redundant stream pair or a non redundant stream.
 	* Assumes the that the given StreamIdentification is valid.
@@ -242,39 +330,7 @@ private:
 	*/
 	std::optional<la::avdecc::controller::model::VirtualIndex> getRedundantVirtualIndexFromInputStreamIndex(la::avdecc::entity::model::StreamIdentification const& streamIdentification) const noexcept
 	{
-		auto& manager = avdecc::ControllerManager::getInstance();
-		auto controlledEntity = manager.getControlledEntity(streamIdentification.entityID);
-		if (controlledEntity)
-		{
-			try
-			{
-				auto const& configNode = controlledEntity->getConfigurationNode(controlledEntity->getCurrentConfigurationNode().descriptorIndex);
-				auto const& streamInputNode = configNode.streamInputs.at(streamIdentification.streamIndex);
-				if (!streamInputNode.isRedundant)
-				{
-					return std::nullopt;
-				}
-				else
-				{
-					for (auto const& [virtualIndex, redundantStreamNode] : configNode.redundantStreamInputs)
-					{
-						for (auto const& [streamIndex, streamNode] : redundantStreamNode.redundantStreams)
-						{
-							if (streamIndex == streamIdentification.streamIndex)
-							{
-								return virtualIndex;
-							}
-						}
-					}
-				}
-			}
-			catch (la::avdecc::controller::ControlledEntity::Exception const&)
-			{
-				return std::nullopt;
-			}
-		}
-
-		return std::nullopt;
+		return getRedundantVirtualIndex(getRedundancyTables(streamIdentification.entityID).inputs, streamIdentification.streamIndex);
 	}
 
 	/**
@@ -282,73 +338,17 @@ private:
 	*/
 	std::optional<la::avdecc::controller::model::VirtualIndex> getRedundantVirtualIndexFromOutputStreamIndex(la::avdecc::entity::model::StreamIdentification const& streamIdentification) const noexcept
 	{
-		auto& manager = avdecc::ControllerManager::getInstance();
-		auto controlledEntity = manager.getControlledEntity(streamIdentification.entityID);
-		if (controlledEntity)
-		{
-			try
-			{
-				auto const& configNode = controlledEntity->getConfigurationNode(controlledEntity->getCurrentConfigurationNode().descriptorIndex);
-				auto const& streamOutputNode = configNode.streamOutputs.at(streamIdentification.streamIndex);
-				if (!streamOutputNode.isRedundant)
-				{
-					return std::nullopt;
-				}
-				else
-				{
-					for (auto const& [virtualIndex, redundantStreamNode] : configNode.redundantStreamOutputs)
-					{
-						for (auto const& [streamIndex, streamNode] : redundantStreamNode.redundantStreams)
-						{
-							if (streamIndex == streamIdentification.streamIndex)
-							{
-								return virtualIndex;
-							}
-						}
-					}
-				}
-			}
-			catch (la::avdecc::controller::ControlledEntity::Exception const&)
-			{
-				return std::nullopt;
-			}
-		}
-
-		return std::nullopt;
+		return getRedundantVirtualIndex(getRedundancyTables(streamIdentification.entityID).outputs, streamIdentification.streamIndex);
 	}
 
 	std::optional<la::avdecc::entity::model::StreamIndex> getPrimaryOutputStreamIndexFromVirtualIndex(la::avdecc::UniqueIdentifier const entityID, la::avdecc::controller::model::VirtualIndex const virtualIndex) const noexcept
 	{
-		auto& manager = avdecc::ControllerManager::getInstance();
-		auto controlledEntity = manager.getControlledEntity(entityID);
-		if (controlledEntity)
-		{
-			try
-			{
-				return controlledEntity->getRedundantStreamOutputNode(controlledEntity->getCurrentConfigurationNode().descriptorIndex, virtualIndex).primaryStream->descriptorIndex;
-			}
-			catch (la::avdecc::controller::ControlledEntity::Exception const&)
-			{
-			}
-		}
-		return std::nullopt;
+		return getPrimaryStreamIndex(getRedundancyTables(entityID).outputs, virtualIndex);
 	}
 
 	std::optional<la::avdecc::entity::model::StreamIndex> getPrimaryInputStreamIndexFromVirtualIndex(la::avdecc::UniqueIdentifier const entityID, la::avdecc::controller::model::VirtualIndex const virtualIndex) const noexcept
 	{
-		auto& manager = avdecc::ControllerManager::getInstance();
-		auto controlledEntity = manager.getControlledEntity(entityID);
-		if (controlledEntity)
-		{
-			try
-			{
-				return controlledEntity->getRedundantStreamInputNode(controlledEntity->getCurrentConfigurationNode().descriptorIndex, virtualIndex).primaryStream->descriptorIndex;
-			}
-			catch (la::avdecc::controller::ControlledEntity::Exception const&)
-			{
-			}
-		}
-		return std::nullopt;
+		return getPrimaryStreamIndex(getRedundancyTables(entityID).inputs, virtualIndex);
 	}
 
 	std::vector<std::pair<la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::StreamIndex>> getRedundantStreamIndexPairs(la::avdecc::UniqueIdentifier const talkerEntityId, la::avdecc::controller::model::VirtualIndex const talkerStreamVirtualIndex, la::avdecc::UniqueIdentifier const listenerEntityId, la::avdecc::controller::model::VirtualIndex const listenerStreamVirtualIndex) const noexcept
@@ -387,36 +387,11 @@ private:
 	}
 
 	/**
-	* Iterates over the list of known entities and returns all connections that originate from the given talker.
+	* Returns all connections that originate from the given talker (lookup in the stream connections index).
 	*/
 	std::vector<la::avdecc::entity::model::StreamConnectionState> getAllStreamOutputConnections(la::avdecc::UniqueIdentifier const talkerEntityId)
 	{
-		std::vector<la::avdecc::entity::model::StreamConnectionState> disconnectedStreams;
-		auto const& manager = avdecc::ControllerManager::getInstance();
-		for (auto const& potentialListenerEntityId : _entities)
-		{
-			auto const controlledEntity = manager.getControlledEntity(potentialListenerEntityId);
-			if (controlledEntity)
-			{
-				if (!controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
-				{
-					continue;
-				}
-				auto const& configNode = controlledEntity->getCurrentConfigurationNode();
-				for (auto const& streamInput : configNode.streamInputs)
-				{
-					auto* streamInputDynamicModel = streamInput.second.dynamicModel;
-					if (streamInputDynamicModel)
-					{
-						if (streamInputDynamicModel->connectionState.talkerStream.entityID == talkerEntityId)
-						{
-							disconnectedStreams.push_back(streamInputDynamicModel->connectionState);
-						}
-					}
-				}
-			}
-		}
-		return disconnectedStreams;
+		return getIndexedStreamOutputConnections(talkerEntityId);
 	}
 
 	/**
@@ -431,6 +406,29 @@ private:
 	* @return The results stored in a struct.
 	*/
 	virtual std::shared_ptr<TargetConnectionInformations> getChannelConnections(la::avdecc::UniqueIdentifier const& entityId, ChannelIdentification const sourceChannelIdentification) const noexcept
+	{
+		// Only cache online entities, the cache is invalidated through entity and stream notifications
+		if (_entities.count(entityId) == 0)
+		{
+			return determineChannelConnections(entityId, sourceChannelIdentification);
+		}
+
+		auto& talkerChannelMappings = _talkerChannelMappings[entityId];
+		auto const channelMappingIt = talkerChannelMappings.find(sourceChannelIdentification);
+		if (channelMappingIt != talkerChannelMappings.end())
+		{
+			return channelMappingIt->second;
+		}
+
+		auto targetConnectionInfo = determineChannelConnections(entityId, sourceChannelIdentification);
+		talkerChannelMappings.emplace(sourceChannelIdentification, targetConnectionInfo);
+		return targetConnectionInfo;
+	}
+
+	/**
+	* Gets all connections of an output, without using the cache. (Tracing is done from output to input)
+	*/
+	std::shared_ptr<TargetConnectionInformations> determineChannelConnections(la::avdecc::UniqueIdentifier const& entityId, ChannelIdentification const& sourceChannelIdentification) const noexcept
 	{
 		auto result = std::make_shared<TargetConnectionInformations>();
 		result->sourceClusterChannelInfo = sourceChannelIdentification;
@@ -574,10 +572,10 @@ private:
 										// the source stream channel is connected to the corresponding target stream channel.
 										if (mapping.streamIndex == streamConnection.listenerStream.streamIndex && mapping.streamChannel == sourceStreamChannel)
 										{
-											auto connectionInformation = std::make_shared<TargetConnectionInformation>();
+											auto connectionInformation = TargetConnectionInformation{};
 
-											connectionInformation->sourceVirtualIndex = getRedundantVirtualIndexFromOutputStreamIndex(streamConnection.talkerStream);
-											connectionInformation->targetVirtualIndex = getRedundantVirtualIndexFromInputStreamIndex(streamConnection.listenerStream);
+											connectionInformation.sourceVirtualIndex = getRedundantVirtualIndexFromOutputStreamIndex(streamConnection.talkerStream);
+											connectionInformation.targetVirtualIndex = getRedundantVirtualIndexFromInputStreamIndex(streamConnection.listenerStream);
 
 											auto primaryListenerStreamIndex{ 0u };
 											auto primaryTalkerStreamIndex{ 0u };
@@ -594,39 +592,39 @@ private:
 												{
 													// if we land in here the primary is not connected, but a secundary is.
 													primaryListenerStreamIndex = streamIndex->second;
-													primaryTalkerStreamIndex = controlledEntity->getRedundantStreamOutputNode(controlledEntity->getCurrentConfigurationNode().descriptorIndex, *connectionInformation->sourceVirtualIndex).primaryStream->descriptorIndex;
+													primaryTalkerStreamIndex = controlledEntity->getRedundantStreamOutputNode(controlledEntity->getCurrentConfigurationNode().descriptorIndex, *connectionInformation.sourceVirtualIndex).primaryStream->descriptorIndex;
 												}
 											}
 
-											connectionInformation->targetEntityId = streamConnection.listenerStream.entityID;
-											connectionInformation->streamChannel = sourceStreamChannel;
-											connectionInformation->sourceStreamIndex = primaryTalkerStreamIndex;
-											connectionInformation->targetStreamIndex = primaryListenerStreamIndex;
-											if (connectionInformation->sourceVirtualIndex && connectionInformation->targetVirtualIndex)
+											connectionInformation.targetEntityId = streamConnection.listenerStream.entityID;
+											connectionInformation.streamChannel = sourceStreamChannel;
+											connectionInformation.sourceStreamIndex = primaryTalkerStreamIndex;
+											connectionInformation.targetStreamIndex = primaryListenerStreamIndex;
+											if (connectionInformation.sourceVirtualIndex && connectionInformation.targetVirtualIndex)
 											{
 												// both redundant
-												connectionInformation->streamPairs = getRedundantStreamIndexPairs(streamConnection.listenerStream.entityID, *connectionInformation->sourceVirtualIndex, connectionInformation->targetEntityId, *connectionInformation->targetVirtualIndex);
+												connectionInformation.streamPairs = getRedundantStreamIndexPairs(streamConnection.listenerStream.entityID, *connectionInformation.sourceVirtualIndex, connectionInformation.targetEntityId, *connectionInformation.targetVirtualIndex);
 											}
 											else
 											{
-												connectionInformation->streamPairs = { std::make_pair(connectionInformation->sourceStreamIndex, connectionInformation->targetStreamIndex) };
+												connectionInformation.streamPairs = { std::make_pair(connectionInformation.sourceStreamIndex, connectionInformation.targetStreamIndex) };
 											}
 
-											connectionInformation->targetClusterChannels.push_back(std::make_pair(mapping.clusterOffset, mapping.clusterChannel));
-											connectionInformation->targetAudioUnitIndex = audioUnitKV.first;
+											connectionInformation.targetClusterChannels.push_back(std::make_pair(mapping.clusterOffset, mapping.clusterChannel));
+											connectionInformation.targetAudioUnitIndex = audioUnitKV.first;
 											if (streamPortInputKV.second.staticModel)
 											{
-												connectionInformation->targetBaseCluster = streamPortInputKV.second.staticModel->baseCluster;
+												connectionInformation.targetBaseCluster = streamPortInputKV.second.staticModel->baseCluster;
 											}
-											connectionInformation->targetStreamPortIndex = streamPortInputKV.first;
-											connectionInformation->isSourceRedundant = controlledEntity->getStreamOutputNode(configurationNode.descriptorIndex, stream.first).isRedundant;
-											connectionInformation->isTargetRedundant = targetControlledEntity->getStreamInputNode(targetConfigurationNode.descriptorIndex, mapping.streamIndex).isRedundant;
+											connectionInformation.targetStreamPortIndex = streamPortInputKV.first;
+											connectionInformation.isSourceRedundant = controlledEntity->getStreamOutputNode(configurationNode.descriptorIndex, stream.first).isRedundant;
+											connectionInformation.isTargetRedundant = targetControlledEntity->getStreamInputNode(targetConfigurationNode.descriptorIndex, mapping.streamIndex).isRedundant;
 
 											// prevent doubled entries for redundant connected streams
 											processedListenerChannels.insert(listenerClusterChannel);
 
 											// add connection to the result data
-											result->targets.push_back(connectionInformation);
+											result->targets.push_back(std::move(connectionInformation));
 										}
 									}
 								}
@@ -652,6 +650,11 @@ private:
 			auto const& entityChannelMappingsIt = entityChannelMappings.find(sourceChannelIdentification);
 			if (entityChannelMappingsIt != entityChannelMappings.end())
 			{
+				// a mappings change is still pending for this channel, don't wait for its slice to answer
+				if (_pendingListenerChannels.erase(std::make_pair(entityId, sourceChannelIdentification)) != 0)
+				{
+					refreshListenerChannel(entityId, sourceChannelIdentification, _pendingListenerChannelsNotifications);
+				}
 				return entityChannelMappingsIt->second;
 			}
 		}
@@ -833,9 +836,9 @@ private:
 										la::avdecc::entity::model::StreamIdentification sourceStreamIdentification{ entityId, stream.first };
 										la::avdecc::entity::model::StreamIdentification targetStreamIdentification{ connectedTalker, connectedTalkerStreamIndex };
 
-										auto connectionInformation = std::make_shared<TargetConnectionInformation>();
-										connectionInformation->sourceVirtualIndex = getRedundantVirtualIndexFromInputStreamIndex(sourceStreamIdentification);
-										connectionInformation->targetVirtualIndex = getRedundantVirtualIndexFromOutputStreamIndex(targetStreamIdentification);
+										auto connectionInformation = TargetConnectionInformation{};
+										connectionInformation.sourceVirtualIndex = getRedundantVirtualIndexFromInputStreamIndex(sourceStreamIdentification);
+										connectionInformation.targetVirtualIndex = getRedundantVirtualIndexFromOutputStreamIndex(targetStreamIdentification);
 
 										auto primaryListenerStreamIndex{ 0u };
 										auto primaryTalkerStreamIndex{ 0u };
@@ -852,34 +855,34 @@ private:
 											{
 												// if we land in here the primary is not connected, but a secundary is.
 												primaryTalkerStreamIndex = streamIndex->second;
-												primaryListenerStreamIndex = controlledEntity->getRedundantStreamInputNode(controlledEntity->getCurrentConfigurationNode().descriptorIndex, *connectionInformation->sourceVirtualIndex).primaryStream->descriptorIndex;
+												primaryListenerStreamIndex = controlledEntity->getRedundantStreamInputNode(controlledEntity->getCurrentConfigurationNode().descriptorIndex, *connectionInformation.sourceVirtualIndex).primaryStream->descriptorIndex;
 											}
 										}
 
-										connectionInformation->targetEntityId = connectedTalker;
-										connectionInformation->sourceStreamIndex = primaryListenerStreamIndex;
-										connectionInformation->targetStreamIndex = primaryTalkerStreamIndex;
-										if (connectionInformation->sourceVirtualIndex && connectionInformation->targetVirtualIndex)
+										connectionInformation.targetEntityId = connectedTalker;
+										connectionInformation.sourceStreamIndex = primaryListenerStreamIndex;
+										connectionInformation.targetStreamIndex = primaryTalkerStreamIndex;
+										if (connectionInformation.sourceVirtualIndex && connectionInformation.targetVirtualIndex)
 										{
 											// both redundant
-											connectionInformation->streamPairs = getRedundantStreamIndexPairs(connectionInformation->targetEntityId, *connectionInformation->targetVirtualIndex, entityId, *connectionInformation->sourceVirtualIndex);
+											connectionInformation.streamPairs = getRedundantStreamIndexPairs(connectionInformation.targetEntityId, *connectionInformation.targetVirtualIndex, entityId, *connectionInformation.sourceVirtualIndex);
 										}
 										else
 										{
-											connectionInformation->streamPairs = { std::make_pair(connectionInformation->targetStreamIndex, connectionInformation->sourceStreamIndex) };
+											connectionInformation.streamPairs = { std::make_pair(connectionInformation.targetStreamIndex, connectionInformation.sourceStreamIndex) };
 										}
-										connectionInformation->streamChannel = sourceStreamChannel;
-										connectionInformation->targetClusterChannels.push_back(std::make_pair(mapping.clusterOffset, mapping.clusterChannel));
-										connectionInformation->targetAudioUnitIndex = audioUnitKV.first;
+										connectionInformation.streamChannel = sourceStreamChannel;
+										connectionInformation.targetClusterChannels.push_back(std::make_pair(mapping.clusterOffset, mapping.clusterChannel));
+										connectionInformation.targetAudioUnitIndex = audioUnitKV.first;
 										if (streamPortOutputKV.second.staticModel)
 										{
-											connectionInformation->targetBaseCluster = streamPortOutputKV.second.staticModel->baseCluster;
+											connectionInformation.targetBaseCluster = streamPortOutputKV.second.staticModel->baseCluster;
 										}
-										connectionInformation->targetStreamPortIndex = streamPortOutputKV.first;
-										connectionInformation->isSourceRedundant = streamInput.isRedundant;
-										connectionInformation->isTargetRedundant = connectionInformation->targetVirtualIndex != std::nullopt;
+										connectionInformation.targetStreamPortIndex = streamPortOutputKV.first;
+										connectionInformation.isSourceRedundant = streamInput.isRedundant;
+										connectionInformation.isTargetRedundant = connectionInformation.targetVirtualIndex != std::nullopt;
 
-										result->targets.push_back(connectionInformation);
+										result->targets.push_back(std::move(connectionInformation));
 										return result; // there can only ever be one channel connected on the listener side
 									}
 								}
@@ -893,36 +896,32 @@ private:
 	}
 
 	/**
-	* Iterates over the list of known entities and returns all connections that originate from the given talker.
+	* Returns all connections that originate from the given talker (lookup in the stream connections index).
 	*/
 	std::vector<la::avdecc::entity::model::StreamConnectionState> getAllStreamOutputConnections(la::avdecc::UniqueIdentifier const& talkerEntityId) const noexcept
 	{
-		auto disconnectedStreams = std::vector<la::avdecc::entity::model::StreamConnectionState>{};
-		auto const& manager = avdecc::ControllerManager::getInstance();
-		for (auto const& potentialListenerEntityId : _entities)
+		return getIndexedStreamOutputConnections(talkerEntityId);
+	}
+
+	/**
+	* Returns the connections of the index that originate from the given talker, optionally restricted to one of its output streams.
+	*/
+	std::vector<la::avdecc::entity::model::StreamConnectionState> getIndexedStreamOutputConnections(la::avdecc::UniqueIdentifier const& talkerEntityId, std::optional<la::avdecc::entity::model::StreamIndex> const outputStreamIndex = std::nullopt) const noexcept
+	{
+		auto connections = std::vector<la::avdecc::entity::model::StreamConnectionState>{};
+		auto const talkerIt = _talkerStreamConnections.find(talkerEntityId);
+		if (talkerIt != _talkerStreamConnections.end())
 		{
-			auto const controlledEntity = manager.getControlledEntity(potentialListenerEntityId);
-			if (controlledEntity)
+			connections.reserve(talkerIt->second.size());
+			for (auto const& [listenerStream, connectionState] : talkerIt->second)
 			{
-				if (!controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+				if (!outputStreamIndex || connectionState.talkerStream.streamIndex == *outputStreamIndex)
 				{
-					continue;
-				}
-				auto const& configNode = controlledEntity->getCurrentConfigurationNode();
-				for (auto const& streamInput : configNode.streamInputs)
-				{
-					auto* streamInputDynamicModel = streamInput.second.dynamicModel;
-					if (streamInputDynamicModel)
-					{
-						if (streamInputDynamicModel->connectionState.talkerStream.entityID == talkerEntityId)
-						{
-							disconnectedStreams.push_back(streamInputDynamicModel->connectionState);
-						}
-					}
+					connections.push_back(connectionState);
 				}
 			}
 		}
-		return disconnectedStreams;
+		return connections;
 	}
 
 
@@ -931,36 +930,7 @@ private:
 	*/
 	virtual std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::controller::model::StreamNode const*> getRedundantStreamOutputsForPrimary(la::avdecc::UniqueIdentifier const& entityId, la::avdecc::entity::model::StreamIndex const primaryStreamIndex) const noexcept
 	{
-		auto& manager = avdecc::ControllerManager::getInstance();
-		auto controlledEntity = manager.getControlledEntity(entityId);
-
-		if (!controlledEntity)
-		{
-			return std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::controller::model::StreamNode const*>();
-		}
-		if (!controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
-		{
-			return std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::controller::model::StreamNode const*>();
-		}
-
-		la::avdecc::controller::model::ConfigurationNode configurationNode;
-		try
-		{
-			configurationNode = controlledEntity->getCurrentConfigurationNode();
-		}
-		catch (la::avdecc::controller::ControlledEntity::Exception const&)
-		{
-			return std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::controller::model::StreamNode const*>();
-		}
-
-		for (auto const& redundantStreamOutput : configurationNode.redundantStreamOutputs)
-		{
-			if (redundantStreamOutput.second.primaryStream->descriptorIndex == primaryStreamIndex)
-			{
-				return redundantStreamOutput.second.redundantStreams;
-			}
-		}
-		return std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::controller::model::StreamNode const*>();
+		return getRedundantStreamsForPrimary(getRedundancyTables(entityId).outputs, primaryStreamIndex);
 	}
 
 	/**
@@ -968,36 +938,7 @@ private:
 	*/
 	virtual std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::controller::model::StreamNode const*> getRedundantStreamInputsForPrimary(la::avdecc::UniqueIdentifier const& entityId, la::avdecc::entity::model::StreamIndex const primaryStreamIndex) const noexcept
 	{
-		auto& manager = avdecc::ControllerManager::getInstance();
-		auto controlledEntity = manager.getControlledEntity(entityId);
-
-		if (!controlledEntity)
-		{
-			return std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::controller::model::StreamNode const*>();
-		}
-		if (!controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
-		{
-			return std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::controller::model::StreamNode const*>();
-		}
-
-		la::avdecc::controller::model::ConfigurationNode configurationNode;
-		try
-		{
-			configurationNode = controlledEntity->getCurrentConfigurationNode();
-		}
-		catch (la::avdecc::controller::ControlledEntity::Exception const&)
-		{
-			return std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::controller::model::StreamNode const*>();
-		}
-
-		for (auto const& redundantStreamInput : configurationNode.redundantStreamInputs)
-		{
-			if (redundantStreamInput.second.primaryStream->descriptorIndex == primaryStreamIndex)
-			{
-				return redundantStreamInput.second.redundantStreams;
-			}
-		}
-		return std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::controller::model::StreamNode const*>();
+		return getRedundantStreamsForPrimary(getRedundancyTables(entityId).inputs, primaryStreamIndex);
 	}
 
 
@@ -1130,23 +1071,23 @@ private:
 											// the source stream channel is connected to the corresponding target stream channel.
 											if (mapping.streamIndex == streamConnection.listenerStream.streamIndex && mapping.streamChannel == sourceStreamChannel)
 											{
-												auto connectionInformation = std::make_shared<TargetConnectionInformation>();
+												auto connectionInformation = TargetConnectionInformation{};
 
-												connectionInformation->targetEntityId = streamConnection.listenerStream.entityID;
-												connectionInformation->sourceStreamIndex = streamConnection.talkerStream.streamIndex;
-												connectionInformation->targetStreamIndex = streamConnection.listenerStream.streamIndex;
-												connectionInformation->isSourceRedundant = controlledEntity->getStreamOutputNode(controlledEntity->getCurrentConfigurationNode().descriptorIndex, stream.first).isRedundant;
-												connectionInformation->streamChannel = sourceStreamChannel;
-												connectionInformation->targetClusterChannels.push_back(std::make_pair(mapping.clusterOffset, mapping.clusterChannel));
-												connectionInformation->targetAudioUnitIndex = audioUnitKV.first;
+												connectionInformation.targetEntityId = streamConnection.listenerStream.entityID;
+												connectionInformation.sourceStreamIndex = streamConnection.talkerStream.streamIndex;
+												connectionInformation.targetStreamIndex = streamConnection.listenerStream.streamIndex;
+												connectionInformation.isSourceRedundant = controlledEntity->getStreamOutputNode(controlledEntity->getCurrentConfigurationNode().descriptorIndex, stream.first).isRedundant;
+												connectionInformation.streamChannel = sourceStreamChannel;
+												connectionInformation.targetClusterChannels.push_back(std::make_pair(mapping.clusterOffset, mapping.clusterChannel));
+												connectionInformation.targetAudioUnitIndex = audioUnitKV.first;
 
 												if (streamPortInputKV.second.staticModel)
 												{
-													connectionInformation->targetBaseCluster = streamPortInputKV.second.staticModel->baseCluster;
+													connectionInformation.targetBaseCluster = streamPortInputKV.second.staticModel->baseCluster;
 												}
-												connectionInformation->targetStreamPortIndex = streamPortInputKV.first;
-												connectionInformation->isTargetRedundant = targetControlledEntity->getStreamInputNode(targetConfigurationNode.descriptorIndex, mapping.streamIndex).isRedundant;
-												result->targets.push_back(connectionInformation);
+												connectionInformation.targetStreamPortIndex = streamPortInputKV.first;
+												connectionInformation.isTargetRedundant = targetControlledEntity->getStreamInputNode(targetConfigurationNode.descriptorIndex, mapping.streamIndex).isRedundant;
+												result->targets.push_back(std::move(connectionInformation));
 											}
 										}
 									}
@@ -1166,107 +1107,261 @@ private:
 	}
 
 	/**
-	* Iterates over the list of known entities and returns all connections that originate from the given talker.
+	* Returns all connections that originate from the given talker stream (lookup in the stream connections index).
 	*/
 	std::vector<la::avdecc::entity::model::StreamConnectionState> getStreamOutputConnections(la::avdecc::UniqueIdentifier const& talkerEntityId, la::avdecc::entity::model::StreamIndex const outputStreamIndex) const noexcept
 	{
-		std::vector<la::avdecc::entity::model::StreamConnectionState> disconnectedStreams;
-		auto const& manager = avdecc::ControllerManager::getInstance();
-		for (auto const& potentialListenerEntityId : _entities)
-		{
-			auto const controlledEntity = manager.getControlledEntity(potentialListenerEntityId);
-			if (controlledEntity)
-			{
-				if (controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
-				{
-					auto const& configNode = controlledEntity->getCurrentConfigurationNode();
-					for (auto const& streamInput : configNode.streamInputs)
-					{
-						auto* streamInputDynamicModel = streamInput.second.dynamicModel;
-						if (streamInputDynamicModel)
-						{
-							if (streamInputDynamicModel->connectionState.talkerStream.entityID == talkerEntityId && streamInputDynamicModel->connectionState.talkerStream.streamIndex == outputStreamIndex)
-							{
-								disconnectedStreams.push_back(streamInputDynamicModel->connectionState);
-							}
-						}
-					}
-				}
-			}
-		}
-		return disconnectedStreams;
+		return getIndexedStreamOutputConnections(talkerEntityId, outputStreamIndex);
 	}
 
 	/**
-	* Checks if the given connections could be created on the current setup (allowing format changes)
-	* could alse be used for normal channel connections in the matrix.
-	*
-	* algorithm:
-	* FOR EVERY CHANNEL CONNECTION PAIR GIVEN:
-	* find all potiential connections and mappings that could be used.
-	* sort by best fit (less changes are preferred)
-	* use the first (best) entry and store needed stream and mapping adjustments
-	*
-	* If any mapping changes on the talker is needed, ChannelConnectResult::NeedsTalkerMappingAdjustment is returned.
-	* If any mappings on the listener need to be removed, ChannelConnectResult::RemovalOfListenerDynamicMappingsNecessary is returned.
-	* The algorithm stops in both cases. However there won't be an error if a talker that currently has no stream connections needs mapping changes.
-	*
-	* To enable removal of mappings the 'allowTalkerMappingChanges' and 'allowRemovalOfUnusedAudioMappings' have to be set to true for the respective side.
-	*
-	* @param talkerEntityId The id of the talker entity.
-	* @param listenerEntityId The id of the listener entity.
-	* @param std::vector<std::pair<avdecc::ChannelIdentification>>
-	* @param talkerToListenerChannelConnections The desired channel connection to be checked
-	* @param allowTalkerMappingChanges Flag parameter to indicate if talker mappings can be added or removed. (Talker mapping changes require stream disconnection which might lead to audio dropouts)
-	* @param allowRemovalOfUnusedAudioMappings Flag parameter to indicate if existing mappings can be overridden
-	* @param channelUsageHint
+	* Builds the stream channel availability tables of a talker/listener pair.
 	*/
-	CheckChannelCreationsPossibleResult checkChannelCreationsPossible(la::avdecc::UniqueIdentifier const& talkerEntityId, la::avdecc::UniqueIdentifier const& listenerEntityId, std::vector<std::pair<avdecc::ChannelIdentification, avdecc::ChannelIdentification>> const& talkerToListenerChannelConnections, bool const allowTalkerMappingChanges, bool const allowRemovalOfUnusedAudioMappings, uint16_t const channelUsageHint) const noexcept
+	StreamChannelPlanningTables buildStreamChannelPlanningTables(la::avdecc::UniqueIdentifier const& talkerEntityId, la::avdecc::UniqueIdentifier const& listenerEntityId) const noexcept
 	{
-		auto insertAudioMapping = [](StreamChannelMappings& streamChannelMappings, la::avdecc::entity::model::AudioMapping const& audioMapping, la::avdecc::entity::model::StreamPortIndex const streamPortIndex)
+		auto tables = StreamChannelPlanningTables{};
+
+		// existing stream connections, secondary connected streams are converted to primary connections
+		for (auto const& streamConnection : getStreamConnectionsBetweenDevices(talkerEntityId, listenerEntityId))
 		{
-			auto const& streamChannelMappingsIt = streamChannelMappings.find(audioMapping.streamIndex);
-			if (streamChannelMappingsIt != streamChannelMappings.end())
+			auto const virtualTalkerIndex = getRedundantVirtualIndexFromOutputStreamIndex(la::avdecc::entity::model::StreamIdentification{ talkerEntityId, streamConnection.first });
+			auto const virtualListenerIndex = getRedundantVirtualIndexFromInputStreamIndex(la::avdecc::entity::model::StreamIdentification{ listenerEntityId, streamConnection.second });
+
+			if (virtualTalkerIndex && virtualListenerIndex)
 			{
-				auto& streamPortAudioMappings = streamChannelMappingsIt->second;
-				auto const& streamPortAudioMappingsIt = streamPortAudioMappings.find(streamPortIndex);
-				if (streamPortAudioMappingsIt != streamPortAudioMappings.end())
-				{
-					auto& audioMappings = streamPortAudioMappingsIt->second;
-					audioMappings.push_back(audioMapping);
-				}
-				else
+				auto const talkerPimaryStreamIndex = getPrimaryOutputStreamIndexFromVirtualIndex(talkerEntityId, *virtualTalkerIndex);
+				auto const listenerPimaryStreamIndex = getPrimaryInputStreamIndexFromVirtualIndex(listenerEntityId, *virtualListenerIndex);
+
+				if (talkerPimaryStreamIndex && listenerPimaryStreamIndex)
 				{
-					la::avdecc::entity::model::AudioMappings mappings;
-					mappings.push_back(audioMapping);
-					streamPortAudioMappings.emplace(streamPortIndex, mappings);
+					auto const connection = std::make_pair(*talkerPimaryStreamIndex, *listenerPimaryStreamIndex);
+					if (std::find(tables.connectedPrimaryStreamConnections.begin(), tables.connectedPrimaryStreamConnections.end(), connection) == tables.connectedPrimaryStreamConnections.end())
+					{
+						tables.connectedPrimaryStreamConnections.push_back(connection);
+					}
 				}
 			}
 			else
 			{
-				StreamPortAudioMappings streamPortAudioMappings;
-				la::avdecc::entity::model::AudioMappings mappings;
-				mappings.push_back(audioMapping);
-				streamPortAudioMappings.emplace(streamPortIndex, mappings);
-				streamChannelMappings.emplace(audioMapping.streamIndex, streamPortAudioMappings);
+				// non redundant connection
+				tables.connectedPrimaryStreamConnections.push_back(streamConnection);
 			}
-		};
+		}
+
+		tables.possibleStreamConnections = getPossibleAudioStreamConnectionsBetweenDevices(talkerEntityId, listenerEntityId);
 
 		auto& manager = avdecc::ControllerManager::getInstance();
 		auto controlledTalkerEntity = manager.getControlledEntity(talkerEntityId);
-		auto controlledListenerEntity = manager.getControlledEntity(listenerEntityId);
-
-		if (!controlledTalkerEntity || !controlledListenerEntity)
-		{
-			return {};
-		}
-		if (!controlledTalkerEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+		if (controlledTalkerEntity && controlledTalkerEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
 		{
-			return {};
-		}
-
-
-		// store all connection, format and mapping changes, that will be applied as batch command chain
+			try
+			{
+				auto const& configurationNode = controlledTalkerEntity->getCurrentConfigurationNode();
+				for (auto const& audioUnitKV : configurationNode.audioUnits)
+				{
+					for (auto const& streamPortOutputKV : audioUnitKV.second.streamPortOutputs)
+					{
+						if (streamPortOutputKV.second.dynamicModel)
+						{
+							for (auto const& mapping : streamPortOutputKV.second.dynamicModel->dynamicAudioMap)
+							{
+								tables.talkerStreamMappings[mapping.streamIndex].push_back(mapping);
+							}
+						}
+						for (auto const& audioMapKV : streamPortOutputKV.second.audioMaps)
+						{
+							for (auto const& mapping : audioMapKV.second.staticModel->mappings)
+							{
+								tables.talkerStreamMappings[mapping.streamIndex].push_back(mapping);
+							}
+						}
+					}
+				}
+
+				for (auto const& streamOutputKV : configurationNode.streamOutputs)
+				{
+					auto const* const streamOutputDynamicModel = streamOutputKV.second.dynamicModel;
+					if (!streamOutputDynamicModel)
+					{
+						continue;
+					}
+					tables.talkerStreamFormats.emplace(streamOutputKV.first, streamOutputDynamicModel->streamFormat);
+
+					auto const channelCount = la::avdecc::entity::model::StreamFormatInfo::create(streamOutputDynamicModel->streamFormat)->getChannelsCount();
+					auto occupiedStreamChannels = std::set<uint16_t>{};
+					auto const mappingsIt = tables.talkerStreamMappings.find(streamOutputKV.first);
+					if (mappingsIt != tables.talkerStreamMappings.end())
+					{
+						for (auto const& mapping : mappingsIt->second)
+						{
+							occupiedStreamChannels.insert(mapping.streamChannel);
+						}
+					}
+					auto& unassignedStreamChannels = tables.unassignedTalkerStreamChannels[streamOutputKV.first];
+					for (auto i = uint16_t{ 0 }; i < channelCount; i++)
+					{
+						if (occupiedStreamChannels.find(i) == occupiedStreamChannels.end())
+						{
+							unassignedStreamChannels.insert(unassignedStreamChannels.end(), i);
+						}
+					}
+				}
+			}
+			catch (la::avdecc::controller::ControlledEntity::Exception const&)
+			{
+			}
+		}
+
+		auto controlledListenerEntity = manager.getControlledEntity(listenerEntityId);
+		if (controlledListenerEntity && controlledListenerEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+		{
+			try
+			{
+				auto const& configurationNode = controlledListenerEntity->getCurrentConfigurationNode();
+				for (auto const& audioUnitKV : configurationNode.audioUnits)
+				{
+					for (auto const& streamPortInputKV : audioUnitKV.second.streamPortInputs)
+					{
+						if (streamPortInputKV.second.dynamicModel)
+						{
+							for (auto const& mapping : streamPortInputKV.second.dynamicModel->dynamicAudioMap)
+							{
+								tables.listenerStreamMappings[mapping.streamIndex].push_back(mapping);
+							}
+						}
+					}
+				}
+
+				for (auto const& streamInputKV : configurationNode.streamInputs)
+				{
+					if (streamInputKV.second.dynamicModel)
+					{
+						tables.listenerStreamFormats.emplace(streamInputKV.first, streamInputKV.second.dynamicModel->streamFormat);
+					}
+				}
+			}
+			catch (la::avdecc::controller::ControlledEntity::Exception const&)
+			{
+			}
+		}
+
+		return tables;
+	}
+
+	/**
+	* Gets the stream channels of the given mappings table entry, optionally only the ones assigned to a cluster channel.
+	*/
+	static std::set<uint16_t> getAssignedStreamChannels(std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::AudioMappings> const& streamMappings, la::avdecc::entity::model::StreamIndex const streamIndex, std::optional<la::avdecc::entity::model::ClusterIndex> const clusterOffset = std::nullopt, std::optional<uint16_t> const clusterChannel = std::nullopt) noexcept
+	{
+		auto result = std::set<uint16_t>{};
+		auto const mappingsIt = streamMappings.find(streamIndex);
+		if (mappingsIt != streamMappings.end())
+		{
+			for (auto const& mapping : mappingsIt->second)
+			{
+				if (!clusterOffset || !clusterChannel || (mapping.clusterOffset == *clusterOffset && mapping.clusterChannel == *clusterChannel))
+				{
+					result.emplace(mapping.streamChannel);
+				}
+			}
+		}
+		return result;
+	}
+
+	/**
+	* Gets the mappings of the given mappings table entry that use a stream channel.
+	*/
+	static la::avdecc::entity::model::AudioMappings getStreamChannelMappings(std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::AudioMappings> const& streamMappings, la::avdecc::entity::model::StreamIndex const streamIndex, uint16_t const streamChannel) noexcept
+	{
+		auto result = la::avdecc::entity::model::AudioMappings{};
+		auto const mappingsIt = streamMappings.find(streamIndex);
+		if (mappingsIt != streamMappings.end())
+		{
+			for (auto const& mapping : mappingsIt->second)
+			{
+				if (mapping.streamChannel == streamChannel)
+				{
+					result.push_back(mapping);
+				}
+			}
+		}
+		return result;
+	}
+
+	/**
+	* Checks if the given connections could be created on the current setup (allowing format changes)
+	* could alse be used for normal channel connections in the matrix.
+	*
+	* algorithm:
+	* FOR EVERY CHANNEL CONNECTION PAIR GIVEN:
+	* find all potiential connections and mappings that could be used.
+	* sort by best fit (less changes are preferred)
+	* use the first (best) entry and store needed stream and mapping adjustments
+	*
+	* If any mapping changes on the talker is needed, ChannelConnectResult::NeedsTalkerMappingAdjustment is returned.
+	* If any mappings on the listener need to be removed, ChannelConnectResult::RemovalOfListenerDynamicMappingsNecessary is returned.
+	* The algorithm stops in both cases. However there won't be an error if a talker that currently has no stream connections needs mapping changes.
+	*
+	* To enable removal of mappings the 'allowTalkerMappingChanges' and 'allowRemovalOfUnusedAudioMappings' have to be set to true for the respective side.
+	*
+	* @param talkerEntityId The id of the talker entity.
+	* @param listenerEntityId The id of the listener entity.
+	* @param std::vector<std::pair<avdecc::ChannelIdentification>>
+	* @param talkerToListenerChannelConnections The desired channel connection to be checked
+	* @param allowTalkerMappingChanges Flag parameter to indicate if talker mappings can be added or removed. (Talker mapping changes require stream disconnection which might lead to audio dropouts)
+	* @param allowRemovalOfUnusedAudioMappings Flag parameter to indicate if existing mappings can be overridden
+	* @param channelUsageHint
+	*/
+	CheckChannelCreationsPossibleResult checkChannelCreationsPossible(la::avdecc::UniqueIdentifier const& talkerEntityId, la::avdecc::UniqueIdentifier const& listenerEntityId, std::vector<std::pair<avdecc::ChannelIdentification, avdecc::ChannelIdentification>> const& talkerToListenerChannelConnections, bool const allowTalkerMappingChanges, bool const allowRemovalOfUnusedAudioMappings, uint16_t const channelUsageHint) const noexcept
+	{
+		auto insertAudioMapping = [](StreamChannelMappings& streamChannelMappings, la::avdecc::entity::model::AudioMapping const& audioMapping, la::avdecc::entity::model::StreamPortIndex const streamPortIndex)
+		{
+			auto const& streamChannelMappingsIt = streamChannelMappings.find(audioMapping.streamIndex);
+			if (streamChannelMappingsIt != streamChannelMappings.end())
+			{
+				auto& streamPortAudioMappings = streamChannelMappingsIt->second;
+				auto const& streamPortAudioMappingsIt = streamPortAudioMappings.find(streamPortIndex);
+				if (streamPortAudioMappingsIt != streamPortAudioMappings.end())
+				{
+					auto& audioMappings = streamPortAudioMappingsIt->second;
+					audioMappings.push_back(audioMapping);
+				}
+				else
+				{
+					la::avdecc::entity::model::AudioMappings mappings;
+					mappings.push_back(audioMapping);
+					streamPortAudioMappings.emplace(streamPortIndex, mappings);
+				}
+			}
+			else
+			{
+				StreamPortAudioMappings streamPortAudioMappings;
+				la::avdecc::entity::model::AudioMappings mappings;
+				mappings.push_back(audioMapping);
+				streamPortAudioMappings.emplace(streamPortIndex, mappings);
+				streamChannelMappings.emplace(audioMapping.streamIndex, streamPortAudioMappings);
+			}
+		};
+
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto controlledTalkerEntity = manager.getControlledEntity(talkerEntityId);
+		auto controlledListenerEntity = manager.getControlledEntity(listenerEntityId);
+
+		if (!controlledTalkerEntity || !controlledListenerEntity)
+		{
+			return {};
+		}
+		if (!controlledTalkerEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+		{
+			return {};
+		}
+
+
+		// build the stream channel availability once, all channel pairs are planned from it
+		auto const planningTables = buildStreamChannelPlanningTables(talkerEntityId, listenerEntityId);
+		auto compatibleStreamPairFormats = std::map<StreamConnection, std::pair<std::optional<la::avdecc::entity::model::StreamFormat>, std::optional<la::avdecc::entity::model::StreamFormat>>>{};
+
+		// store all connection, format and mapping changes, that will be applied as batch command chain
 		StreamChannelMappings overriddenMappingsListener;
 		StreamChannelMappings newMappingsTalker;
 		StreamChannelMappings newMappingsListener;
@@ -1281,15 +1376,14 @@ private:
 
 			try
 			{
-				std::vector<StreamChannelInfo> streamChannelInfos = findAllUsableStreamChannels(talkerEntityId, listenerEntityId, talkerChannelIdentification, listenerChannelIdentification, newStreamConnections, newMappingsTalker, newMappingsListener);
+				std::vector<StreamChannelInfo> streamChannelInfos = findAllUsableStreamChannels(planningTables, talkerChannelIdentification, listenerChannelIdentification, newStreamConnections, newMappingsTalker, newMappingsListener);
 				if (streamChannelInfos.empty())
 				{
 					return CheckChannelCreationsPossibleResult{ ChannelConnectResult::Impossible };
 				}
-				std::sort(streamChannelInfos.begin(), streamChannelInfos.end(), StreamChannelInfoPriority());
 
-				// take the first entry of the streamChannelInfos after they were sorted as the channel to use
-				auto streamChannelInfoToUse = streamChannelInfos.begin();
+				// take the highest priority entry of the streamChannelInfos as the channel to use
+				auto streamChannelInfoToUse = std::min_element(streamChannelInfos.begin(), streamChannelInfos.end(), StreamChannelInfoPriority());
 
 				// the user has to agree that talker mappings are changed (can lead to audio interruptions)
 				if (!allowTalkerMappingChanges && !streamChannelInfoToUse->reusesTalkerMapping)
@@ -1305,8 +1399,8 @@ private:
 				// IF A NEW STREAM CONNECTION WILL BE CREATED: remove listener mappings that have to be removed before the new connection can be created, but only after user confirmation
 				if (!streamChannelInfoToUse->streamAlreadyConnected)
 				{
-					auto assignedChannelsTalker = getAssignedChannelsOnTalkerStream(talkerEntityId, streamChannelInfoToUse->talkerPrimaryStreamIndex);
-					auto assignedChannelsListener = getAssignedChannelsOnListenerStream(listenerEntityId, streamChannelInfoToUse->listenerPrimaryStreamIndex);
+					auto assignedChannelsTalker = getAssignedStreamChannels(planningTables.talkerStreamMappings, streamChannelInfoToUse->talkerPrimaryStreamIndex);
+					auto assignedChannelsListener = getAssignedStreamChannels(planningTables.listenerStreamMappings, streamChannelInfoToUse->listenerPrimaryStreamIndex);
 
 					std::vector<uint16_t> unwantedConnectionsAfterStreamConnect;
 					set_intersection(assignedChannelsTalker.begin(), assignedChannelsTalker.end(), assignedChannelsListener.begin(), assignedChannelsListener.end(), back_inserter(unwantedConnectionsAfterStreamConnect));
@@ -1319,7 +1413,7 @@ private:
 					// remove all listener mappings that would be created by the new stream connection
 					for (auto const unwantedStreamConnectionChannel : unwantedConnectionsAfterStreamConnect)
 					{
-						auto unwantedMappings = getMappingsFromStreamInputChannel(listenerEntityId, streamChannelInfoToUse->listenerPrimaryStreamIndex, unwantedStreamConnectionChannel);
+						auto unwantedMappings = getStreamChannelMappings(planningTables.listenerStreamMappings, streamChannelInfoToUse->listenerPrimaryStreamIndex, unwantedStreamConnectionChannel);
 						for (auto const& unwantedMapping : unwantedMappings)
 						{
 							if (unwantedMapping.clusterOffset == listenerChannelIdentification.clusterIndex + *listenerChannelIdentification.baseCluster)
@@ -1336,7 +1430,7 @@ private:
 				// IF NEW TALKER MAPPINGS ARE CREATED: remove listener mappings that would be created, except for the one that we actually want if it is reused, but only after user confirmation
 				if (!streamChannelInfoToUse->reusesTalkerMapping)
 				{
-					auto unwantedMappings = getMappingsFromStreamInputChannel(listenerEntityId, streamChannelInfoToUse->listenerPrimaryStreamIndex, streamChannelInfoToUse->streamChannel);
+					auto unwantedMappings = getStreamChannelMappings(planningTables.listenerStreamMappings, streamChannelInfoToUse->listenerPrimaryStreamIndex, streamChannelInfoToUse->streamChannel);
 					if (!unwantedMappings.empty() && !allowRemovalOfUnusedAudioMappings)
 					{
 						return CheckChannelCreationsPossibleResult{ ChannelConnectResult::RemovalOfListenerDynamicMappingsNecessary };
@@ -1404,7 +1498,14 @@ private:
 					insertAudioMapping(newMappingsListener, listenerMapping, *listenerChannelIdentification.streamPortIndex);
 				}
 
-				auto const& compatibleFormats = findCompatibleStreamPairFormat(talkerEntityId, streamChannelInfoToUse->talkerPrimaryStreamIndex, listenerEntityId, streamChannelInfoToUse->listenerPrimaryStreamIndex, la::avdecc::entity::model::StreamFormatInfo::Type::AAF, channelUsageHint);
+				// the compatible formats only depend on the stream pair, compute them once per pair
+				auto const streamPair = StreamConnection{ streamChannelInfoToUse->talkerPrimaryStreamIndex, streamChannelInfoToUse->listenerPrimaryStreamIndex };
+				auto compatibleFormatsIt = compatibleStreamPairFormats.find(streamPair);
+				if (compatibleFormatsIt == compatibleStreamPairFormats.end())
+				{
+					compatibleFormatsIt = compatibleStreamPairFormats.emplace(streamPair, findCompatibleStreamPairFormat(talkerEntityId, streamPair.first, listenerEntityId, streamPair.second, la::avdecc::entity::model::StreamFormatInfo::Type::AAF, channelUsageHint)).first;
+				}
+				auto const& compatibleFormats = compatibleFormatsIt->second;
 				if (compatibleFormats.first)
 				{
 					streamFormatChangesTalker.emplace(streamChannelInfoToUse->talkerPrimaryStreamIndex, *compatibleFormats.first);
@@ -1425,71 +1526,36 @@ private:
 	/**
 	* Finds all possible stream & channel combinations that allow to connect the two cluster channels.
 	*/
-	std::vector<StreamChannelInfo> findAllUsableStreamChannels(la::avdecc::UniqueIdentifier const talkerEntityId, la::avdecc::UniqueIdentifier const listenerEntityId, avdecc::ChannelIdentification const& talkerChannelIdentification, avdecc::ChannelIdentification const& listenerChannelIdentification, StreamConnections const& newStreamConnections, StreamChannelMappings const& newMappingsTalker, StreamChannelMappings const& newMappingsListener) const noexcept
+	std::vector<StreamChannelInfo> findAllUsableStreamChannels(StreamChannelPlanningTables const& planningTables, avdecc::ChannelIdentification const& talkerChannelIdentification, avdecc::ChannelIdentification const& listenerChannelIdentification, StreamConnections const& newStreamConnections, StreamChannelMappings const& newMappingsTalker, StreamChannelMappings const& newMappingsListener) const noexcept
 	{
 		std::vector<StreamChannelInfo> result;
 
-		// find all (existing and possible) stream connections between the devices
-		// check all listenerChannelConnections on it
-		auto streamConnections = getStreamConnectionsBetweenDevices(talkerEntityId, listenerEntityId);
-
-		// filter out streamConnections that are redundant
-		auto primaryStreamConnections = StreamConnections{};
-		for (auto const& streamConnection : streamConnections)
-		{
-			la::avdecc::entity::model::StreamIdentification talkerStreamIdentification{ talkerEntityId, streamConnection.first };
-			la::avdecc::entity::model::StreamIdentification listenerStreamIdentification{ listenerEntityId, streamConnection.second };
-
-			auto virtualTalkerIndex = getRedundantVirtualIndexFromOutputStreamIndex(talkerStreamIdentification);
-			auto virtualListenerIndex = getRedundantVirtualIndexFromInputStreamIndex(listenerStreamIdentification);
-
-			if (virtualTalkerIndex && virtualListenerIndex)
-			{
-				// convert secundary connected streams to primary connections:
-				auto talkerPimaryStreamIndex = getPrimaryOutputStreamIndexFromVirtualIndex(talkerEntityId, *virtualTalkerIndex);
-				auto listenerPimaryStreamIndex = getPrimaryInputStreamIndexFromVirtualIndex(listenerEntityId, *virtualListenerIndex);
-
-				if (talkerPimaryStreamIndex && listenerPimaryStreamIndex)
-				{
-					auto const connection = std::make_pair(*talkerPimaryStreamIndex, *listenerPimaryStreamIndex);
-					if (std::find(primaryStreamConnections.begin(), primaryStreamConnections.end(), connection) == primaryStreamConnections.end())
-					{
-						primaryStreamConnections.push_back(connection);
-					}
-				}
-			}
-			else
-			{
-				// non redundant connection
-				primaryStreamConnections.push_back(streamConnection);
-			}
-		}
+		auto const talkerClusterOffset = static_cast<la::avdecc::entity::model::ClusterIndex>(talkerChannelIdentification.clusterIndex - *talkerChannelIdentification.baseCluster);
+		auto const listenerClusterOffset = static_cast<la::avdecc::entity::model::ClusterIndex>(listenerChannelIdentification.clusterIndex - *listenerChannelIdentification.baseCluster);
 
-		// also take into account stream connections, that will be batch created with this one:
+		// existing stream connections (already converted to primary connections) and the ones that will be batch created with this one
+		auto primaryStreamConnections = planningTables.connectedPrimaryStreamConnections;
 		primaryStreamConnections.insert(primaryStreamConnections.end(), newStreamConnections.begin(), newStreamConnections.end());
 
 		// iterate over existing stream connections
 		for (auto const& streamConnection : primaryStreamConnections)
 		{
 			// get all stream channels that could be used for the connection
-			auto const usableChannels = findAllUsableStreamChannelsOnStreamConnection(talkerEntityId, listenerEntityId, streamConnection, true, talkerChannelIdentification.clusterIndex - *talkerChannelIdentification.baseCluster, talkerChannelIdentification.clusterChannel, listenerChannelIdentification.clusterIndex - *listenerChannelIdentification.baseCluster, listenerChannelIdentification.clusterChannel, newMappingsTalker, newMappingsListener);
+			auto const usableChannels = findAllUsableStreamChannelsOnStreamConnection(planningTables, streamConnection, true, talkerClusterOffset, talkerChannelIdentification.clusterChannel, listenerClusterOffset, listenerChannelIdentification.clusterChannel, newMappingsTalker, newMappingsListener);
 			result.insert(result.end(), usableChannels.begin(), usableChannels.end());
 		}
 
 		// check the stream connections that have not been created yet
-		auto possibleStreamConnections = getPossibleAudioStreamConnectionsBetweenDevices(talkerEntityId, listenerEntityId);
-
-		// filter out stream connections that are already being created
-		for (auto const& newStreamConnection : newStreamConnections)
+		for (auto const& streamConnection : planningTables.possibleStreamConnections)
 		{
-			auto connectionToRemoveIt = std::find(possibleStreamConnections.begin(), possibleStreamConnections.end(), newStreamConnection);
-			possibleStreamConnections.erase(connectionToRemoveIt);
-		}
+			// filter out stream connections that are already being created
+			if (std::find(newStreamConnections.begin(), newStreamConnections.end(), streamConnection) != newStreamConnections.end())
+			{
+				continue;
+			}
 
-		for (auto const& streamConnection : possibleStreamConnections)
-		{
 			// get all stream channels that could be used for the connection
-			auto const usableChannels = findAllUsableStreamChannelsOnStreamConnection(talkerEntityId, listenerEntityId, streamConnection, false, talkerChannelIdentification.clusterIndex - *talkerChannelIdentification.baseCluster, talkerChannelIdentification.clusterChannel, listenerChannelIdentification.clusterIndex - *listenerChannelIdentification.baseCluster, listenerChannelIdentification.clusterChannel, newMappingsTalker, newMappingsListener);
+			auto const usableChannels = findAllUsableStreamChannelsOnStreamConnection(planningTables, streamConnection, false, talkerClusterOffset, talkerChannelIdentification.clusterChannel, listenerClusterOffset, listenerChannelIdentification.clusterChannel, newMappingsTalker, newMappingsListener);
 			result.insert(result.end(), usableChannels.begin(), usableChannels.end());
 		}
 
@@ -1501,42 +1567,21 @@ private:
 	* @param newMappingsListener Contains mappings that will be created with createChannelConnections method, but are not created yet.
 	* @return Gets all connection
 	*/
-	std::vector<StreamChannelInfo> findAllUsableStreamChannelsOnStreamConnection(la::avdecc::UniqueIdentifier const talkerEntityId, la::avdecc::UniqueIdentifier const listenerEntityId, StreamConnection const streamConnection, bool const isStreamAlreadyConnected, la::avdecc::entity::model::ClusterIndex const talkerClusterOffset, uint16_t const talkerClusterChannel, la::avdecc::entity::model::ClusterIndex const listenerClusterOffset, uint16_t const listenerClusterChannel, StreamChannelMappings const& newMappingsTalker, StreamChannelMappings const& newMappingsListener) const noexcept
+	std::vector<StreamChannelInfo> findAllUsableStreamChannelsOnStreamConnection(StreamChannelPlanningTables const& planningTables, StreamConnection const streamConnection, bool const isStreamAlreadyConnected, la::avdecc::entity::model::ClusterIndex const talkerClusterOffset, uint16_t const talkerClusterChannel, la::avdecc::entity::model::ClusterIndex const listenerClusterOffset, uint16_t const listenerClusterChannel, StreamChannelMappings const& newMappingsTalker, StreamChannelMappings const& newMappingsListener) const noexcept
 	{
 		// convenience function to create StreamChannelInfo
-		auto buildStreamChannelInfo = [talkerEntityId, listenerEntityId, streamConnection, isStreamAlreadyConnected, talkerClusterOffset, listenerClusterOffset](uint16_t streamChannel, bool reusesTalkerMapping, bool reusesListenerMapping) -> std::optional<StreamChannelInfo>
+		auto buildStreamChannelInfo = [&planningTables, streamConnection, isStreamAlreadyConnected, talkerClusterOffset](uint16_t streamChannel, bool reusesTalkerMapping, bool reusesListenerMapping) -> std::optional<StreamChannelInfo>
 		{
-			auto const& manager = avdecc::ControllerManager::getInstance();
-			auto const talkerEntity = manager.getControlledEntity(talkerEntityId);
-			auto const listenerEntity = manager.getControlledEntity(listenerEntityId);
-			if (!talkerEntity || !listenerEntity)
+			auto const talkerStreamIndex = streamConnection.first;
+			auto const listenerStreamIndex = streamConnection.second;
+			auto const talkerStreamFormatIt = planningTables.talkerStreamFormats.find(talkerStreamIndex);
+			auto const listenerStreamFormatIt = planningTables.listenerStreamFormats.find(listenerStreamIndex);
+			if (talkerStreamFormatIt == planningTables.talkerStreamFormats.end() || listenerStreamFormatIt == planningTables.listenerStreamFormats.end())
 			{
 				return std::nullopt;
 			}
 
-			try
-			{
-				auto talkerStreamIndex = streamConnection.first;
-				auto listenerStreamIndex = streamConnection.second;
-				auto const* const streamOutputDynamicModel = talkerEntity->getStreamOutputNode(talkerEntity->getCurrentConfigurationNode().descriptorIndex, talkerStreamIndex).dynamicModel;
-				if (!streamOutputDynamicModel)
-				{
-					return std::nullopt;
-				}
-				auto const* const streamInputDynamicModel = listenerEntity->getStreamInputNode(listenerEntity->getCurrentConfigurationNode().descriptorIndex, listenerStreamIndex).dynamicModel;
-				if (!streamInputDynamicModel)
-				{
-					return std::nullopt;
-				}
-				auto talkerStreamFormat = streamOutputDynamicModel->streamFormat;
-				auto listenerStreamFormat = streamInputDynamicModel->streamFormat;
-
-				return StreamChannelInfo{ talkerStreamIndex, listenerStreamIndex, streamChannel, isStreamAlreadyConnected, reusesTalkerMapping, reusesListenerMapping, streamChannel == talkerClusterOffset, talkerStreamFormat, listenerStreamFormat };
-			}
-			catch (la::avdecc::controller::ControlledEntity::Exception const&)
-			{
-			}
-			return std::nullopt;
+			return StreamChannelInfo{ talkerStreamIndex, listenerStreamIndex, streamChannel, isStreamAlreadyConnected, reusesTalkerMapping, reusesListenerMapping, streamChannel == talkerClusterOffset, talkerStreamFormatIt->second, listenerStreamFormatIt->second };
 		};
 
 		std::vector<StreamChannelInfo> result;
@@ -1544,7 +1589,7 @@ private:
 		auto const listenerStreamIndex = streamConnection.second;
 
 		// get the mappings for the cluster channel that are currently existant on the talker
-		auto existingFittingTalkerMappings = getAssignedChannelsOnTalkerStream(talkerEntityId, talkerStreamIndex, talkerClusterOffset, talkerClusterChannel);
+		auto existingFittingTalkerMappings = getAssignedStreamChannels(planningTables.talkerStreamMappings, talkerStreamIndex, talkerClusterOffset, talkerClusterChannel);
 
 		// add the mappings that will be created
 		auto const& newMappingsTalkerIt = newMappingsTalker.find(talkerStreamIndex);
@@ -1563,7 +1608,7 @@ private:
 		}
 
 		// get the mappings for the cluster channel that are currently existant on the listener
-		auto existingFittingListenerMappings = getAssignedChannelsOnListenerStream(listenerEntityId, listenerStreamIndex, listenerClusterOffset, listenerClusterChannel);
+		auto existingFittingListenerMappings = getAssignedStreamChannels(planningTables.listenerStreamMappings, listenerStreamIndex, listenerClusterOffset, listenerClusterChannel);
 
 		// add the mappings that will be created
 		auto const& newMappingsListenerIt = newMappingsListener.find(listenerStreamIndex);
@@ -1604,7 +1649,12 @@ private:
 		}
 
 		// get all stream channels that are unassigned on the talker side
-		auto freeStreamSlotsSource = getUnassignedChannelsOnTalkerStream(talkerEntityId, talkerStreamIndex);
+		auto freeStreamSlotsSource = std::set<uint16_t>{};
+		auto const unassignedChannelsIt = planningTables.unassignedTalkerStreamChannels.find(talkerStreamIndex);
+		if (unassignedChannelsIt != planningTables.unassignedTalkerStreamChannels.end())
+		{
+			freeStreamSlotsSource = unassignedChannelsIt->second;
+		}
 		// remove the channels that will be created
 		if (newMappingsTalkerIt != newMappingsTalker.end())
 		{
@@ -1755,17 +1805,10 @@ private:
 	}
 
 	/**
-	* Tries to establish the channel connections between two audio channels of different devices.
-	*
-	* @param talkerEntityId The id of the talker entity.
-	* @param listenerEntityId The id of the listener entity.
-	* @param talkerChannelIdentification The identification for the output channel.
-	* @param listenerChannelIdentification The identification for the input channel.
-	* @return ChannelConnectResult::NoError if it is theoretically possbile to create the connection. However errors can occur while executing the commands. The errors can be catched from the createChannelConnectionsFinished signal.
+	* Counts the number of channel connections needed (filter doubled talker connections).
 	*/
-	virtual ChannelConnectResult createChannelConnections(la::avdecc::UniqueIdentifier const& talkerEntityId, la::avdecc::UniqueIdentifier const& listenerEntityId, std::vector<std::pair<avdecc::ChannelIdentification, avdecc::ChannelIdentification>> const& talkerToListenerChannelConnections, bool const allowTalkerMappingChanges, bool const allowRemovalOfUnusedAudioMappings) noexcept
+	static uint16_t countTalkerChannels(std::vector<std::pair<avdecc::ChannelIdentification, avdecc::ChannelIdentification>> const& talkerToListenerChannelConnections) noexcept
 	{
-		// count the number of channel connections needed (filter doubled talker connections)
 		uint16_t channelUsage = 0;
 		std::set<avdecc::ChannelIdentification> uniqueTalkers;
 		for (auto const& connection : talkerToListenerChannelConnections)
@@ -1777,14 +1820,37 @@ private:
 				uniqueTalkers.insert(connection.first);
 			}
 		}
+		return channelUsage;
+	}
+
+	/**
+	* Plans the channel connections exactly like createChannelConnections does, without sending any command.
+	*/
+	virtual ChannelConnectResult checkChannelConnections(la::avdecc::UniqueIdentifier const& talkerEntityId, la::avdecc::UniqueIdentifier const& listenerEntityId, std::vector<std::pair<avdecc::ChannelIdentification, avdecc::ChannelIdentification>> const& talkerToListenerChannelConnections, bool const allowTalkerMappingChanges, bool const allowRemovalOfUnusedAudioMappings) const noexcept
+	{
+		auto const channelUsage = countTalkerChannels(talkerToListenerChannelConnections);
+		return checkChannelCreationsPossible(talkerEntityId, listenerEntityId, talkerToListenerChannelConnections, allowTalkerMappingChanges, allowRemovalOfUnusedAudioMappings, channelUsage).connectionCheckResult;
+	}
 
+	/**
+	* Tries to establish the channel connections between two audio channels of different devices.
+	*
+	* @param talkerEntityId The id of the talker entity.
+	* @param listenerEntityId The id of the listener entity.
+	* @param talkerChannelIdentification The identification for the output channel.
+	* @param listenerChannelIdentification The identification for the input channel.
+	* @return ChannelConnectResult::NoError if it is theoretically possbile to create the connection. However errors can occur while executing the commands. The errors can be catched from the createChannelConnectionsFinished signal.
+	*/
+	virtual ChannelConnectResult createChannelConnections(la::avdecc::UniqueIdentifier const& talkerEntityId, la::avdecc::UniqueIdentifier const& listenerEntityId, std::vector<std::pair<avdecc::ChannelIdentification, avdecc::ChannelIdentification>> const& talkerToListenerChannelConnections, bool const allowTalkerMappingChanges, bool const allowRemovalOfUnusedAudioMappings) noexcept
+	{
+		auto const channelUsage = countTalkerChannels(talkerToListenerChannelConnections);
 		auto const& result = checkChannelCreationsPossible(talkerEntityId, listenerEntityId, talkerToListenerChannelConnections, allowTalkerMappingChanges, allowRemovalOfUnusedAudioMappings, channelUsage);
 		if (result.connectionCheckResult == ChannelConnectResult::NoError)
 		{
 			std::vector<commandChain::AsyncParallelCommandSet*> commands;
 
-			std::vector<commandChain::AsyncParallelCommandSet::AsyncCommand> commandsChangeStreamFormat;
-			std::vector<commandChain::AsyncParallelCommandSet::AsyncCommand> commandsCreateStreamConnections;
+			auto* commandSetChangeStreamFormat = new commandChain::AsyncParallelCommandSet;
+			auto* commandSetCreateStreamConnections = new commandChain::AsyncParallelCommandSet;
 			for (auto const& newStreamConnection : result.newStreamConnections)
 			{
 				// change the stream format if necessary
@@ -1793,7 +1859,7 @@ private:
 				auto const talkerStreamIndex = newStreamConnection.first;
 				if (compatibleStreamFormats.first)
 				{
-					commandsChangeStreamFormat.push_back(
+					commandSetChangeStreamFormat->append(talkerEntityId,
 						[=](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
 						{
 							auto& manager = avdecc::ControllerManager::getInstance();
@@ -1813,7 +1879,7 @@ private:
 				}
 				if (compatibleStreamFormats.second)
 				{
-					commandsChangeStreamFormat.push_back(
+					commandSetChangeStreamFormat->append(listenerEntityId,
 						[=](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
 						{
 							auto& manager = avdecc::ControllerManager::getInstance();
@@ -1850,7 +1916,7 @@ private:
 				}
 
 				// connect primary
-				commandsCreateStreamConnections.push_back(
+				commandSetCreateStreamConnections->append(listenerEntityId,
 					[=](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
 					{
 						auto& manager = avdecc::ControllerManager::getInstance();
@@ -1893,7 +1959,7 @@ private:
 					{
 						auto const talkerSecStreamIndex = redundantOutputStreamsIterator->first;
 						auto const listenerSecStreamIndex = redundantInputStreamsIterator->first;
-						commandsCreateStreamConnections.push_back(
+						commandSetCreateStreamConnections->append(listenerEntityId,
 							[=](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
 							{
 								auto& manager = avdecc::ControllerManager::getInstance();
@@ -1934,10 +2000,6 @@ private:
 				}
 			}
 
-			auto* commandSetChangeStreamFormat = new commandChain::AsyncParallelCommandSet(commandsChangeStreamFormat);
-			auto* commandSetCreateStreamConnections = new commandChain::AsyncParallelCommandSet(commandsCreateStreamConnections);
-
-
 			// create the set of streams to disconnect and later connect again
 			// find all stream connections by looking through the connections of each talker stream
 			std::vector<la::avdecc::entity::model::StreamConnectionState> streamsToDisconnect;
@@ -1967,10 +2029,10 @@ private:
 			}
 
 			// create commands to stop the streams
-			std::vector<commandChain::AsyncParallelCommandSet::AsyncCommand> commandsTempDisconnectStreams;
+			auto* commandSetTempDisconnectStreams = new commandChain::AsyncParallelCommandSet;
 			for (auto const& streamConnection : streamsToDisconnect)
 			{
-				commandsTempDisconnectStreams.push_back(
+				commandSetTempDisconnectStreams->append(streamConnection.listenerStream.entityID,
 					[=](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
 					{
 						auto& manager = avdecc::ControllerManager::getInstance();
@@ -2007,12 +2069,11 @@ private:
 						return true;
 					});
 			}
-			auto* commandSetTempDisconnectStreams = new commandChain::AsyncParallelCommandSet(commandsTempDisconnectStreams);
 
-			std::vector<commandChain::AsyncParallelCommandSet::AsyncCommand> commandsReconnectStreams;
+			auto* commandSetReconnectStreams = new commandChain::AsyncParallelCommandSet;
 			for (auto const& streamConnection : streamsToDisconnect)
 			{
-				commandsReconnectStreams.push_back(
+				commandSetReconnectStreams->append(streamConnection.listenerStream.entityID,
 					[=](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
 					{
 						auto& manager = avdecc::ControllerManager::getInstance();
@@ -2049,14 +2110,13 @@ private:
 						return true;
 					});
 			}
-			auto* commandSetReconnectStreams = new commandChain::AsyncParallelCommandSet(commandsReconnectStreams);
 
-			std::vector<commandChain::AsyncParallelCommandSet::AsyncCommand> commandsRemoveMappings;
+			auto* commandSetRemoveMappings = new commandChain::AsyncParallelCommandSet;
 			for (auto const& mappingsListener : result.overriddenMappingsListener)
 			{
 				for (auto const& mapping : mappingsListener.second)
 				{
-					commandsRemoveMappings.push_back(
+					commandSetRemoveMappings->append(listenerEntityId,
 						[=](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
 						{
 							auto& manager = avdecc::ControllerManager::getInstance();
@@ -2075,14 +2135,13 @@ private:
 						});
 				}
 			}
-			auto* commandSetRemoveMappings = new commandChain::AsyncParallelCommandSet(commandsRemoveMappings);
 
-			std::vector<commandChain::AsyncParallelCommandSet::AsyncCommand> commandsCreateMappings;
+			auto* commandSetCreateMappings = new commandChain::AsyncParallelCommandSet;
 			for (auto const& mappingsTalker : result.newMappingsTalker)
 			{
 				for (auto const& mapping : mappingsTalker.second)
 				{
-					commandsCreateMappings.push_back(
+					commandSetCreateMappings->append(talkerEntityId,
 						[=](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
 						{
 							auto& manager = avdecc::ControllerManager::getInstance();
@@ -2106,7 +2165,7 @@ private:
 			{
 				for (auto const& mapping : mappingsListener.second)
 				{
-					commandsCreateMappings.push_back(
+					commandSetCreateMappings->append(listenerEntityId,
 						[=](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
 						{
 							auto& manager = avdecc::ControllerManager::getInstance();
@@ -2125,7 +2184,6 @@ private:
 						});
 				}
 			}
-			auto* commandSetCreateMappings = new commandChain::AsyncParallelCommandSet(commandsCreateMappings);
 
 			// create chain
 			commands.push_back(commandSetTempDisconnectStreams);
@@ -2135,18 +2193,41 @@ private:
 			commands.push_back(commandSetCreateStreamConnections);
 			commands.push_back(commandSetReconnectStreams);
 
-			// execute the command chain
 			auto* sequentialAcmpCommandExecuter = new commandChain::SequentialAsyncCommandExecuter(this);
-			connect(sequentialAcmpCommandExecuter, &commandChain::SequentialAsyncCommandExecuter::completed, this,
-				[this](commandChain::CommandExecutionErrors const errors)
+			sequentialAcmpCommandExecuter->setCommandChain(commands);
+
+			// execute the command chain while both entities are locked, so other controllers cannot change their mappings halfway
+			ControllerManager::getInstance().requestExclusiveAccesses({ talkerEntityId, listenerEntityId }, la::avdecc::controller::Controller::ExclusiveAccessToken::AccessType::Lock,
+				[this, sequentialAcmpCommandExecuter](ControllerManager::ExclusiveAccessGroupPointer const& group, ControllerManager::ExclusiveAccessFailures const& failures)
 				{
-					CreateConnectionsInfo info;
-					info.connectionCreationErrors = errors;
-					emit createChannelConnectionsFinished(info);
+					QMetaObject::invokeMethod(this,
+						[this, sequentialAcmpCommandExecuter, group, failures]()
+						{
+							if (!group)
+							{
+								CreateConnectionsInfo info;
+								for (auto const& [entityId, status] : failures)
+								{
+									info.connectionCreationErrors.emplace(entityId, commandChain::CommandErrorInfo{ commandChain::AsyncParallelCommandSet::aemCommandStatusToCommandError(status), std::nullopt, ControllerManager::AecpCommandType::LockEntity });
+								}
+								emit createChannelConnectionsFinished(info);
+								sequentialAcmpCommandExecuter->deleteLater();
+								return;
+							}
+
+							connect(sequentialAcmpCommandExecuter, &commandChain::SequentialAsyncCommandExecuter::completed, this,
+								[this, group](commandChain::CommandExecutionErrors const errors)
+								{
+									group->release();
+
+									CreateConnectionsInfo info;
+									info.connectionCreationErrors = errors;
+									emit createChannelConnectionsFinished(info);
+								});
+							connect(sequentialAcmpCommandExecuter, &commandChain::SequentialAsyncCommandExecuter::completed, sequentialAcmpCommandExecuter, &commandChain::SequentialAsyncCommandExecuter::deleteLater);
+							sequentialAcmpCommandExecuter->start();
+						});
 				});
-			connect(sequentialAcmpCommandExecuter, &commandChain::SequentialAsyncCommandExecuter::completed, sequentialAcmpCommandExecuter, &commandChain::SequentialAsyncCommandExecuter::deleteLater);
-			sequentialAcmpCommandExecuter->setCommandChain(commands);
-			sequentialAcmpCommandExecuter->start();
 		}
 
 		return result.connectionCheckResult;
@@ -2208,20 +2289,20 @@ private:
 		auto connectionStreamTargetIndex = std::optional<la::avdecc::entity::model::StreamIndex>{ std::nullopt };
 		auto connectionStreamChannel = std::optional<uint16_t>{ std::nullopt };
 
-		for (auto deviceConnection : channelConnectionOfListenerChannel->targets)
+		for (auto const& deviceConnection : channelConnectionOfListenerChannel->targets)
 		{
-			if (deviceConnection->targetEntityId == talkerEntityId)
+			if (deviceConnection.targetEntityId == talkerEntityId)
 			{
-				if (deviceConnection->targetAudioUnitIndex == talkerAudioUnitIndex && deviceConnection->targetStreamPortIndex == talkerStreamPortIndex)
+				if (deviceConnection.targetAudioUnitIndex == talkerAudioUnitIndex && deviceConnection.targetStreamPortIndex == talkerStreamPortIndex)
 				{
-					for (auto const& clusterIdentificationPair : deviceConnection->targetClusterChannels)
+					for (auto const& clusterIdentificationPair : deviceConnection.targetClusterChannels)
 					{
 						if (clusterIdentificationPair.first == talkerClusterIndex - talkerBaseCluster && clusterIdentificationPair.second == talkerClusterChannel)
 						{
 							// flip because we are going into the opposite direction. (talker->listener)
-							connectionStreamSourceIndex = deviceConnection->targetStreamIndex;
-							connectionStreamTargetIndex = deviceConnection->sourceStreamIndex;
-							connectionStreamChannel = deviceConnection->streamChannel;
+							connectionStreamSourceIndex = deviceConnection.targetStreamIndex;
+							connectionStreamTargetIndex = deviceConnection.sourceStreamIndex;
+							connectionStreamChannel = deviceConnection.streamChannel;
 
 							break;
 						}
@@ -2243,8 +2324,8 @@ private:
 			for (auto const& deviceConnection : channelConnectionsOfTalker->targets)
 			{
 				// if this is a redundant connection, we convert the index to the primary:
-				la::avdecc::entity::model::StreamIdentification talkerStreamIdentification{ talkerEntityId, deviceConnection->sourceStreamIndex };
-				la::avdecc::entity::model::StreamIdentification listenerStreamIdentification{ listenerEntityId, deviceConnection->targetStreamIndex };
+				la::avdecc::entity::model::StreamIdentification talkerStreamIdentification{ talkerEntityId, deviceConnection.sourceStreamIndex };
+				la::avdecc::entity::model::StreamIdentification listenerStreamIdentification{ listenerEntityId, deviceConnection.targetStreamIndex };
 
 				auto virtualTalkerIndex = getRedundantVirtualIndexFromOutputStreamIndex(talkerStreamIdentification);
 				auto virtualListenerIndex = getRedundantVirtualIndexFromInputStreamIndex(listenerStreamIdentification);
@@ -2265,7 +2346,7 @@ private:
 					if (listenerPimaryStreamIndex)
 					{
 						bool alreadyHandledConnection = false;
-						for (auto const& [clusterIndex, channel] : deviceConnection->targetClusterChannels)
+						for (auto const& [clusterIndex, channel] : deviceConnection.targetClusterChannels)
 						{
 							auto const listenerClusterChannel = std::make_tuple(*listenerPimaryStreamIndex, clusterIndex, channel);
 							if (listenerClusterChannels.find(listenerClusterChannel) == listenerClusterChannels.end())
@@ -2288,11 +2369,11 @@ private:
 				}
 
 
-				if (deviceConnection->targetEntityId == listenerEntityId && listenerStreamIdentification.streamIndex == *connectionStreamTargetIndex && talkerStreamIdentification.streamIndex == *connectionStreamSourceIndex)
+				if (deviceConnection.targetEntityId == listenerEntityId && listenerStreamIdentification.streamIndex == *connectionStreamTargetIndex && talkerStreamIdentification.streamIndex == *connectionStreamSourceIndex)
 				{
-					if (!deviceConnection->targetClusterChannels.empty())
+					if (!deviceConnection.targetClusterChannels.empty())
 					{
-						streamConnectionUsages += static_cast<int>(deviceConnection->targetClusterChannels.size());
+						streamConnectionUsages += static_cast<int>(deviceConnection.targetClusterChannels.size());
 						if (streamConnectionUsages > 1)
 						{
 							streamConnectionStillNeeded = true;
@@ -2308,11 +2389,11 @@ private:
 			auto talkerChannelReceivers = uint32_t{ 0 };
 			auto const channelConnectionsOfTalkerChannel = getChannelConnections(talkerEntityId, talkerChannelIdentification);
 
-			for (auto deviceConnection : channelConnectionsOfTalkerChannel->targets)
+			for (auto const& deviceConnection : channelConnectionsOfTalkerChannel->targets)
 			{
-				if (deviceConnection->sourceStreamIndex == *connectionStreamSourceIndex && deviceConnection->streamChannel == connectionStreamChannel)
+				if (deviceConnection.sourceStreamIndex == *connectionStreamSourceIndex && deviceConnection.streamChannel == connectionStreamChannel)
 				{
-					talkerChannelReceivers += deviceConnection->targetClusterChannels.size();
+					talkerChannelReceivers += deviceConnection.targetClusterChannels.size();
 				}
 			}
 
@@ -2380,39 +2461,7 @@ private:
 
 	std::vector<la::avdecc::entity::model::StreamConnectionState> getAllStreamOutputConnections(la::avdecc::UniqueIdentifier const talkerEntityId, la::avdecc::entity::model::StreamIndex const streamIndex)
 	{
-		std::vector<la::avdecc::entity::model::StreamConnectionState> disconnectedStreams;
-		auto const& manager = avdecc::ControllerManager::getInstance();
-		for (auto const& potentialListenerEntityId : _entities)
-		{
-			auto const controlledEntity = manager.getControlledEntity(potentialListenerEntityId);
-			if (controlledEntity)
-			{
-				if (!controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
-				{
-					continue;
-				}
-				try
-				{
-					auto const& configNode = controlledEntity->getCurrentConfigurationNode();
-					for (auto const& streamInput : configNode.streamInputs)
-					{
-						auto* streamInputDynamicModel = streamInput.second.dynamicModel;
-						if (streamInputDynamicModel)
-						{
-							auto const& talkerStream = streamInputDynamicModel->connectionState.talkerStream;
-							if (talkerStream.entityID == talkerEntityId && talkerStream.streamIndex == streamIndex)
-							{
-								disconnectedStreams.push_back(streamInputDynamicModel->connectionState);
-							}
-						}
-					}
-				}
-				catch (la::avdecc::controller::ControlledEntity::Exception const&)
-				{
-				}
-			}
-		}
-		return disconnectedStreams;
+		return getIndexedStreamOutputConnections(talkerEntityId, streamIndex);
 	}
 
 	/**
@@ -2423,14 +2472,14 @@ private:
 		auto connections = getChannelConnectionsReverse(listenerEntityId, listenerChannelIdentification);
 		for (auto const& deviceConnection : connections->targets)
 		{
-			if (deviceConnection->targetEntityId == talkerEntityId)
+			if (deviceConnection.targetEntityId == talkerEntityId)
 			{
-				for (auto const& targetClusterKV : deviceConnection->targetClusterChannels)
+				for (auto const& targetClusterKV : deviceConnection.targetClusterChannels)
 				{
-					if (deviceConnection->targetAudioUnitIndex == *listenerChannelIdentification.audioUnitIndex && deviceConnection->targetStreamPortIndex == *talkerChannelIdentification.streamPortIndex && targetClusterKV.first == talkerChannelIdentification.clusterIndex - *talkerChannelIdentification.baseCluster && targetClusterKV.second == talkerChannelIdentification.clusterChannel)
+					if (deviceConnection.targetAudioUnitIndex == *listenerChannelIdentification.audioUnitIndex && deviceConnection.targetStreamPortIndex == *talkerChannelIdentification.streamPortIndex && targetClusterKV.first == talkerChannelIdentification.clusterIndex - *talkerChannelIdentification.baseCluster && targetClusterKV.second == talkerChannelIdentification.clusterChannel)
 					{
 						std::vector<StreamIdentificationPair> result;
-						for (auto const [talkerStreamIndex, listenerStreamIndex] : deviceConnection->streamPairs)
+						for (auto const [talkerStreamIndex, listenerStreamIndex] : deviceConnection.streamPairs)
 						{
 							la::avdecc::entity::model::StreamIdentification streamTalker{ talkerEntityId, talkerStreamIndex };
 							la::avdecc::entity::model::StreamIdentification streamListener{ listenerEntityId, listenerStreamIndex };
@@ -3270,13 +3319,454 @@ private:
 	}
 
 
-	// Slots
+	// Redundancy tables
 	/**
-	* Removes all entities from the internal list.
+	* Builds the flat redundancy table of one direction from the redundant stream nodes of a configuration.
 	*/
-	void onControllerOffline()
+	template<typename RedundantStreamNodesMap>
+	static RedundantStreamsTable buildRedundantStreamsTable(RedundantStreamNodesMap const& redundantStreamNodes) noexcept
+	{
+		auto table = RedundantStreamsTable{};
+		for (auto const& [virtualIndex, redundantStreamNode] : redundantStreamNodes)
+		{
+			auto const tableIndex = static_cast<size_t>(virtualIndex);
+			if (tableIndex >= table.redundantStreams.size())
+			{
+				table.primaryStreamIndexes.resize(tableIndex + 1u);
+				table.redundantStreams.resize(tableIndex + 1u);
+			}
+			if (redundantStreamNode.primaryStream)
+			{
+				table.primaryStreamIndexes[tableIndex] = redundantStreamNode.primaryStream->descriptorIndex;
+			}
+			table.redundantStreams[tableIndex] = redundantStreamNode.redundantStreams;
+
+			for (auto const& redundantStreamKV : redundantStreamNode.redundantStreams)
+			{
+				auto const streamIndex = static_cast<size_t>(redundantStreamKV.first);
+				if (streamIndex >= table.virtualIndexes.size())
+				{
+					table.virtualIndexes.resize(streamIndex + 1u);
+				}
+				table.virtualIndexes[streamIndex] = virtualIndex;
+			}
+		}
+		return table;
+	}
+
+	/**
+	* Builds the redundancy tables of the current configuration of an entity (empty for entities without AEM or redundant streams).
+	*/
+	static RedundancyTables buildRedundancyTables(la::avdecc::UniqueIdentifier const& entityId) noexcept
+	{
+		auto tables = RedundancyTables{};
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto controlledEntity = manager.getControlledEntity(entityId);
+		if (!controlledEntity || !controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+		{
+			return tables;
+		}
+
+		try
+		{
+			auto const& configNode = controlledEntity->getCurrentConfigurationNode();
+			tables.inputs = buildRedundantStreamsTable(configNode.redundantStreamInputs);
+			tables.outputs = buildRedundantStreamsTable(configNode.redundantStreamOutputs);
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+		return tables;
+	}
+
+	/**
+	* Gets the redundancy tables of an entity, building them the first time.
+	*/
+	RedundancyTables const& getRedundancyTables(la::avdecc::UniqueIdentifier const& entityId) const noexcept
+	{
+		auto tablesIt = _redundancyTables.find(entityId);
+		if (tablesIt == _redundancyTables.end())
+		{
+			tablesIt = _redundancyTables.emplace(entityId, buildRedundancyTables(entityId)).first;
+		}
+		return tablesIt->second;
+	}
+
+	static std::optional<la::avdecc::controller::model::VirtualIndex> getRedundantVirtualIndex(RedundantStreamsTable const& table, la::avdecc::entity::model::StreamIndex const streamIndex) noexcept
+	{
+		auto const tableIndex = static_cast<size_t>(streamIndex);
+		return tableIndex < table.virtualIndexes.size() ? table.virtualIndexes[tableIndex] : std::nullopt;
+	}
+
+	static std::optional<la::avdecc::entity::model::StreamIndex> getPrimaryStreamIndex(RedundantStreamsTable const& table, la::avdecc::controller::model::VirtualIndex const virtualIndex) noexcept
+	{
+		auto const tableIndex = static_cast<size_t>(virtualIndex);
+		return tableIndex < table.primaryStreamIndexes.size() ? table.primaryStreamIndexes[tableIndex] : std::nullopt;
+	}
+
+	static RedundantStreamNodes getRedundantStreamsForPrimary(RedundantStreamsTable const& table, la::avdecc::entity::model::StreamIndex const primaryStreamIndex) noexcept
+	{
+		auto const virtualIndex = getRedundantVirtualIndex(table, primaryStreamIndex);
+		if (!virtualIndex || getPrimaryStreamIndex(table, *virtualIndex) != primaryStreamIndex)
+		{
+			return {};
+		}
+		return table.redundantStreams[static_cast<size_t>(*virtualIndex)];
+	}
+
+	// Stream connections index
+	/**
+	* Drops the cached forward channel connections of a talker.
+	*/
+	void invalidateTalkerChannelConnections(la::avdecc::UniqueIdentifier const& talkerEntityId) noexcept
+	{
+		_talkerChannelMappings.erase(talkerEntityId);
+	}
+
+	/**
+	* Drops the cached forward channel connections of all talkers currently feeding the given listener.
+	*/
+	void invalidateTalkerChannelConnectionsOfListener(la::avdecc::UniqueIdentifier const& listenerEntityId) noexcept
+	{
+		for (auto it = _listenerStreamTalkers.lower_bound({ listenerEntityId, la::avdecc::entity::model::StreamIndex{ 0u } }); it != _listenerStreamTalkers.end() && it->first.first == listenerEntityId; ++it)
+		{
+			invalidateTalkerChannelConnections(it->second);
+		}
+	}
+
+	/**
+	* Removes the index entry of a listener stream, if any.
+	*/
+	void removeIndexedStreamConnection(ListenerStreamKey const& listenerStream) noexcept
+	{
+		auto const listenerStreamIt = _listenerStreamTalkers.find(listenerStream);
+		if (listenerStreamIt == _listenerStreamTalkers.end())
+		{
+			return;
+		}
+
+		auto const talkerEntityId = listenerStreamIt->second;
+		invalidateTalkerChannelConnections(talkerEntityId);
+
+		auto const talkerIt = _talkerStreamConnections.find(talkerEntityId);
+		if (talkerIt != _talkerStreamConnections.end())
+		{
+			talkerIt->second.erase(listenerStream);
+			if (talkerIt->second.empty())
+			{
+				_talkerStreamConnections.erase(talkerIt);
+			}
+		}
+		_listenerStreamTalkers.erase(listenerStreamIt);
+	}
+
+	/**
+	* Updates the index entry of a listener stream with its new connection state.
+	*/
+	void updateIndexedStreamConnection(la::avdecc::entity::model::StreamConnectionState const& streamConnectionState) noexcept
+	{
+		auto const listenerStream = ListenerStreamKey{ streamConnectionState.listenerStream.entityID, streamConnectionState.listenerStream.streamIndex };
+		auto const& talkerEntityId = streamConnectionState.talkerStream.entityID;
+
+		removeIndexedStreamConnection(listenerStream);
+
+		_talkerStreamConnections[talkerEntityId][listenerStream] = streamConnectionState;
+		_listenerStreamTalkers.emplace(listenerStream, talkerEntityId);
+		invalidateTalkerChannelConnections(talkerEntityId);
+	}
+
+	/**
+	* Indexes the current connection state of all stream inputs of an entity.
+	*/
+	void indexEntityStreamInputs(la::avdecc::UniqueIdentifier const& entityId) noexcept
+	{
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto controlledEntity = manager.getControlledEntity(entityId);
+		if (!controlledEntity || !controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+		{
+			return;
+		}
+
+		try
+		{
+			auto const& configNode = controlledEntity->getCurrentConfigurationNode();
+			for (auto const& streamInput : configNode.streamInputs)
+			{
+				auto const* const streamInputDynamicModel = streamInput.second.dynamicModel;
+				if (streamInputDynamicModel)
+				{
+					updateIndexedStreamConnection(streamInputDynamicModel->connectionState);
+				}
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+	}
+
+	/**
+	* Removes all index entries of the stream inputs of an entity.
+	*/
+	void unindexEntityStreamInputs(la::avdecc::UniqueIdentifier const& entityId) noexcept
+	{
+		auto listenerStreams = std::vector<ListenerStreamKey>{};
+		for (auto it = _listenerStreamTalkers.lower_bound({ entityId, la::avdecc::entity::model::StreamIndex{ 0u } }); it != _listenerStreamTalkers.end() && it->first.first == entityId; ++it)
+		{
+			listenerStreams.push_back(it->first);
+		}
+		for (auto const& listenerStream : listenerStreams)
+		{
+			removeIndexedStreamConnection(listenerStream);
+		}
+	}
+
+	// Audio mappings snapshots
+	/**
+	* Gets the mappings of a stream port the channel connections are traced with (dynamic mappings for inputs, dynamic and static mappings for outputs).
+	*/
+	la::avdecc::entity::model::AudioMappings getStreamPortAudioMappings(la::avdecc::UniqueIdentifier const& entityId, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamPortIndex const streamPortIndex) const noexcept
+	{
+		auto mappings = la::avdecc::entity::model::AudioMappings{};
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto controlledEntity = manager.getControlledEntity(entityId);
+		if (!controlledEntity || !controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+		{
+			return mappings;
+		}
+
+		try
+		{
+			auto const configurationIndex = controlledEntity->getCurrentConfigurationNode().descriptorIndex;
+			if (descriptorType == la::avdecc::entity::model::DescriptorType::StreamPortInput)
+			{
+				auto const& streamPortInputNode = controlledEntity->getStreamPortInputNode(configurationIndex, streamPortIndex);
+				if (streamPortInputNode.dynamicModel)
+				{
+					mappings = streamPortInputNode.dynamicModel->dynamicAudioMap;
+				}
+			}
+			else if (descriptorType == la::avdecc::entity::model::DescriptorType::StreamPortOutput)
+			{
+				auto const& streamPortOutputNode = controlledEntity->getStreamPortOutputNode(configurationIndex, streamPortIndex);
+				if (streamPortOutputNode.dynamicModel)
+				{
+					mappings = streamPortOutputNode.dynamicModel->dynamicAudioMap;
+				}
+				for (auto const& audioMap : streamPortOutputNode.audioMaps)
+				{
+					mappings.insert(mappings.end(), audioMap.second.staticModel->mappings.begin(), audioMap.second.staticModel->mappings.end());
+				}
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+		return mappings;
+	}
+
+	/**
+	* Stores the current mappings of a stream port and returns the ones that were added or removed since the previous snapshot (std::nullopt if there was none).
+	*/
+	std::optional<AudioMappingKeys> updateStreamPortAudioMappingsSnapshot(la::avdecc::UniqueIdentifier const& entityId, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamPortIndex const streamPortIndex) noexcept
+	{
+		auto currentMappings = audioMappingKeys::fromMappings(getStreamPortAudioMappings(entityId, descriptorType, streamPortIndex));
+
+		auto& snapshot = _streamPortAudioMappingsSnapshots[StreamPortKey{ entityId, descriptorType, streamPortIndex }];
+		auto changedMappings = std::optional<AudioMappingKeys>{};
+		if (snapshot)
+		{
+			changedMappings = audioMappingKeys::symmetricDifference(*snapshot, currentMappings);
+		}
+		snapshot = std::move(currentMappings);
+		return changedMappings;
+	}
+
+	/**
+	* Takes the initial mappings snapshot of all the stream ports of an entity.
+	*/
+	void snapshotEntityAudioMappings(la::avdecc::UniqueIdentifier const& entityId) noexcept
+	{
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto controlledEntity = manager.getControlledEntity(entityId);
+		if (!controlledEntity || !controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+		{
+			return;
+		}
+
+		try
+		{
+			for (auto const& audioUnitKV : controlledEntity->getCurrentConfigurationNode().audioUnits)
+			{
+				for (auto const& streamPortInputKV : audioUnitKV.second.streamPortInputs)
+				{
+					updateStreamPortAudioMappingsSnapshot(entityId, la::avdecc::entity::model::DescriptorType::StreamPortInput, streamPortInputKV.first);
+				}
+				for (auto const& streamPortOutputKV : audioUnitKV.second.streamPortOutputs)
+				{
+					updateStreamPortAudioMappingsSnapshot(entityId, la::avdecc::entity::model::DescriptorType::StreamPortOutput, streamPortOutputKV.first);
+				}
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+	}
+
+	/**
+	* Removes the mappings snapshots of an entity.
+	*/
+	void removeEntityAudioMappingsSnapshots(la::avdecc::UniqueIdentifier const& entityId) noexcept
+	{
+		for (auto it = _streamPortAudioMappingsSnapshots.begin(); it != _streamPortAudioMappingsSnapshots.end();)
+		{
+			if (std::get<0>(it->first) == entityId)
+			{
+				it = _streamPortAudioMappingsSnapshots.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	// Notifications
+	/**
+	* Merges updated listener channels into ranges of consecutive clusters, the channels of a cluster only counting once.
+	*/
+	static ListenerClusterSpans makeListenerClusterSpans(std::set<std::pair<la::avdecc::UniqueIdentifier, ChannelIdentification>> const& channels) noexcept
+	{
+		auto spans = ListenerClusterSpans{};
+		for (auto const& [entityID, channelIdentification] : channels)
+		{
+			auto const clusterIndex = channelIdentification.clusterIndex;
+			if (!spans.empty())
+			{
+				auto& span = spans.back();
+				if (span.entityID == entityID && clusterIndex >= span.firstCluster && clusterIndex <= span.lastCluster + 1u)
+				{
+					span.lastCluster = std::max(span.lastCluster, clusterIndex);
+					continue;
+				}
+			}
+			spans.push_back(ListenerClusterSpan{ entityID, clusterIndex, clusterIndex });
+		}
+		return spans;
+	}
+
+	void notifyListenerChannelConnectionsUpdate(std::set<std::pair<la::avdecc::UniqueIdentifier, ChannelIdentification>> const& channels) noexcept
+	{
+		emit listenerChannelConnectionsUpdate(channels);
+		emit listenerClusterSpansUpdate(makeListenerClusterSpans(channels));
+	}
+
+	/**
+	* Recomputes the cached connections of a listener channel, adding it to updatedChannels if they changed.
+	*/
+	void refreshListenerChannel(la::avdecc::UniqueIdentifier const& entityId, ChannelIdentification const& sourceChannelIdentification, ListenerChannels& updatedChannels) noexcept
+	{
+		auto const listenerChannelMappingsIt = _listenerChannelMappings.find(entityId);
+		if (listenerChannelMappingsIt == _listenerChannelMappings.end())
+		{
+			return;
+		}
+		auto& channelMappings = listenerChannelMappingsIt->second->channelMappings;
+		auto const channelMappingsIt = channelMappings.find(sourceChannelIdentification);
+		if (channelMappingsIt == channelMappings.end())
+		{
+			return;
+		}
+
+		auto newListenerChannelConnections = determineChannelConnectionsReverse(entityId, sourceChannelIdentification);
+		if (!newListenerChannelConnections->isEqualTo(*channelMappingsIt->second))
+		{
+			channelMappings[sourceChannelIdentification] = newListenerChannelConnections;
+			updatedChannels.insert(std::make_pair(entityId, sourceChannelIdentification));
+		}
+	}
+
+	/**
+	* Queues listener channels for recomputation. They are processed in time slices so a storm of mappings changes doesn't freeze the UI.
+	*/
+	void queuePendingListenerChannels(ListenerChannels const& channels) noexcept
+	{
+		if (channels.empty())
+		{
+			return;
+		}
+		_pendingListenerChannels.insert(channels.begin(), channels.end());
+		if (!_pendingListenerChannelsTimer.isActive())
+		{
+			_pendingListenerChannelsTimer.start();
+		}
+	}
+
+	/**
+	* Recomputes pending listener channels until the slice budget is spent, notifies the ones that changed and reschedules itself if some are left.
+	*/
+	void processPendingListenerChannels() noexcept
+	{
+		auto updatedListenerChannels = ListenerChannels{};
+		std::swap(updatedListenerChannels, _pendingListenerChannelsNotifications);
+
+		auto elapsed = QElapsedTimer{};
+		elapsed.start();
+		while (!_pendingListenerChannels.empty() && elapsed.elapsed() < PendingListenerChannelsSliceBudget.count())
+		{
+			auto const channel = *_pendingListenerChannels.begin();
+			_pendingListenerChannels.erase(_pendingListenerChannels.begin());
+			refreshListenerChannel(channel.first, channel.second, updatedListenerChannels);
+		}
+
+		if (!updatedListenerChannels.empty())
+		{
+			notifyListenerChannelConnectionsUpdate(updatedListenerChannels);
+		}
+		if (!_pendingListenerChannels.empty())
+		{
+			_pendingListenerChannelsTimer.start();
+		}
+	}
+
+	/**
+	* Drops the pending listener channels of an entity.
+	*/
+	void removePendingListenerChannels(la::avdecc::UniqueIdentifier const& entityId) noexcept
+	{
+		auto const removeEntityChannels = [&entityId](ListenerChannels& channels)
+		{
+			for (auto it = channels.begin(); it != channels.end();)
+			{
+				if (it->first == entityId)
+				{
+					it = channels.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+		};
+		removeEntityChannels(_pendingListenerChannels);
+		removeEntityChannels(_pendingListenerChannelsNotifications);
+	}
+
+	// Slots
+	/**
+	* Removes all entities from the internal list.
+	*/
+	void onControllerOffline()
 	{
 		_entities.clear();
+		_listenerChannelMappings.clear();
+		_talkerStreamConnections.clear();
+		_listenerStreamTalkers.clear();
+		_talkerChannelMappings.clear();
+		_streamPortAudioMappingsSnapshots.clear();
+		_redundancyTables.clear();
+		_pendingListenerChannels.clear();
+		_pendingListenerChannelsNotifications.clear();
+		_pendingListenerChannelsTimer.stop();
 	}
 
 	/**
@@ -3286,6 +3776,11 @@ private:
 	{
 		// add entity to the set
 		_entities.insert(entityId);
+		// precompute its redundant streams, then index the stream connections of its inputs
+		_redundancyTables[entityId] = buildRedundancyTables(entityId);
+		invalidateTalkerChannelConnections(entityId);
+		indexEntityStreamInputs(entityId);
+		snapshotEntityAudioMappings(entityId);
 	}
 
 	/**
@@ -3297,13 +3792,29 @@ private:
 		_entities.erase(entityId);
 		// also remove the cached connections for this entity
 		_listenerChannelMappings.erase(entityId);
+		invalidateTalkerChannelConnections(entityId);
+		unindexEntityStreamInputs(entityId);
+		removeEntityAudioMappingsSnapshots(entityId);
+		_redundancyTables.erase(entityId);
+		removePendingListenerChannels(entityId);
 	}
 
 	/**
-	* Update the cached connection info if it's already in the map.
+	* Update the stream connections index and the cached connection info if it's already in the map.
 	*/
 	void onStreamConnectionChanged(la::avdecc::entity::model::StreamConnectionState const& streamConnectionState)
 	{
+		HIVE_TRACE_SPAN("ChannelConnectionManager::onStreamConnectionChanged");
+		if (_entities.count(streamConnectionState.listenerStream.entityID) != 0)
+		{
+			auto& manager = avdecc::ControllerManager::getInstance();
+			auto controlledEntity = manager.getControlledEntity(streamConnectionState.listenerStream.entityID);
+			if (controlledEntity && controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+			{
+				updateIndexedStreamConnection(streamConnectionState);
+			}
+		}
+
 		auto listenerChannelMappingIt = _listenerChannelMappings.find(streamConnectionState.listenerStream.entityID);
 
 		if (listenerChannelMappingIt != _listenerChannelMappings.end())
@@ -3326,7 +3837,7 @@ private:
 						// special handling for redundant connections, as the channel connection still exists if only one of the connections is active.
 						if (virtualListenerIndex)
 						{
-							if (*virtualListenerIndex == *target->sourceVirtualIndex)
+							if (*virtualListenerIndex == *target.sourceVirtualIndex)
 							{
 								auto& manager = avdecc::ControllerManager::getInstance();
 								auto controlledEntity = manager.getControlledEntity(streamConnectionState.listenerStream.entityID);
@@ -3350,7 +3861,7 @@ private:
 								}
 							}
 						}
-						else if (target->sourceStreamIndex == streamConnectionState.listenerStream.streamIndex && target->targetStreamIndex == streamConnectionState.talkerStream.streamIndex)
+						else if (target.sourceStreamIndex == streamConnectionState.listenerStream.streamIndex && target.targetStreamIndex == streamConnectionState.talkerStream.streamIndex)
 						{
 							// this needs a refresh
 							auto channel = std::make_pair(streamConnectionState.listenerStream.entityID, mappingKV.first);
@@ -3368,7 +3879,7 @@ private:
 					for (auto const& target : mappingKV.second->targets)
 					{
 						// check if the source (listener) is the same but the target (talker) changed
-						if ((target->targetStreamIndex != streamConnectionState.talkerStream.streamIndex || target->targetEntityId != streamConnectionState.talkerStream.entityID) && target->sourceStreamIndex == streamConnectionState.listenerStream.streamIndex)
+						if ((target.targetStreamIndex != streamConnectionState.talkerStream.streamIndex || target.targetEntityId != streamConnectionState.talkerStream.entityID) && target.sourceStreamIndex == streamConnectionState.listenerStream.streamIndex)
 						{
 							// this needs a refresh
 							auto channel = std::make_pair(streamConnectionState.listenerStream.entityID, mappingKV.first);
@@ -3465,7 +3976,7 @@ private:
 
 			if (!updatedListenerChannels.empty())
 			{
-				emit listenerChannelConnectionsUpdate(updatedListenerChannels);
+				notifyListenerChannelConnectionsUpdate(updatedListenerChannels);
 			}
 		}
 	}
@@ -3475,22 +3986,49 @@ private:
 	*/
 	void onStreamPortAudioMappingsChanged(la::avdecc::UniqueIdentifier const& entityId, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamPortIndex const streamPortIndex)
 	{
-		auto listenerChannelsToUpdate = std::set<std::pair<la::avdecc::UniqueIdentifier, ChannelIdentification>>{};
-		auto updatedListenerChannels = std::set<std::pair<la::avdecc::UniqueIdentifier, ChannelIdentification>>{};
+		// forward channel connections depend on the talker output mappings and on the input mappings of its listeners
+		if (descriptorType == la::avdecc::entity::model::DescriptorType::StreamPortOutput)
+		{
+			invalidateTalkerChannelConnections(entityId);
+		}
+		else if (descriptorType == la::avdecc::entity::model::DescriptorType::StreamPortInput)
+		{
+			invalidateTalkerChannelConnectionsOfListener(entityId);
+		}
+
+		auto listenerChannelsToUpdate = ListenerChannels{};
+
+		// only the mappings that were added or removed since the last notification can change a channel connection
+		auto const changedMappings = updateStreamPortAudioMappingsSnapshot(entityId, descriptorType, streamPortIndex);
 
 		if (descriptorType == la::avdecc::entity::model::DescriptorType::StreamPortInput)
 		{
-			if (_listenerChannelMappings.find(entityId) != _listenerChannelMappings.end())
+			auto const listenerChannelMappingsIt = _listenerChannelMappings.find(entityId);
+			if (listenerChannelMappingsIt != _listenerChannelMappings.end())
 			{
-				auto const& listenerMappings = _listenerChannelMappings.at(entityId)->channelMappings;
-				for (auto const& mappingKV : listenerMappings)
+				// clusters referenced by the changed mappings
+				auto changedClusterChannels = std::set<std::pair<la::avdecc::entity::model::ClusterIndex, uint16_t>>{};
+				if (changedMappings)
+				{
+					for (auto const key : *changedMappings)
+					{
+						changedClusterChannels.emplace(audioMappingKeys::clusterOffset(key), audioMappingKeys::clusterChannel(key));
+					}
+				}
+
+				for (auto const& mappingKV : listenerChannelMappingsIt->second->channelMappings)
 				{
-					if (mappingKV.first.streamPortIndex == streamPortIndex)
+					auto const& channelIdentification = mappingKV.first;
+					if (channelIdentification.streamPortIndex != streamPortIndex)
+					{
+						continue;
+					}
+					if (changedMappings && (!channelIdentification.baseCluster || changedClusterChannels.count({ static_cast<la::avdecc::entity::model::ClusterIndex>(channelIdentification.clusterIndex - *channelIdentification.baseCluster), channelIdentification.clusterChannel }) == 0))
 					{
-						// this needs a refresh
-						auto channel = std::make_pair(entityId, mappingKV.first);
-						listenerChannelsToUpdate.insert(channel);
+						continue;
 					}
+					// this needs a refresh
+					listenerChannelsToUpdate.insert(std::make_pair(entityId, channelIdentification));
 				}
 			}
 		}
@@ -3498,35 +4036,92 @@ private:
 		{
 			try
 			{
-				auto& manager = avdecc::ControllerManager::getInstance();
+				// talker streams (including their redundant siblings) whose channels were remapped
+				auto changedTalkerStreamChannels = std::set<std::pair<la::avdecc::entity::model::StreamIndex, uint16_t>>{};
+				if (changedMappings)
+				{
+					for (auto const key : *changedMappings)
+					{
+						auto const streamIndex = audioMappingKeys::streamIndex(key);
+						auto const streamChannel = audioMappingKeys::streamChannel(key);
+						changedTalkerStreamChannels.emplace(streamIndex, streamChannel);
+						for (auto const& redundantStreamKV : getRedundantStreamOutputsForPrimary(entityId, streamIndex))
+						{
+							changedTalkerStreamChannels.emplace(redundantStreamKV.first, streamChannel);
+						}
+					}
+				}
 
-				// search for talker changes that affect a listener in the cached map.
-				for (auto const& deviceMappingsKV : _listenerChannelMappings)
+				// listener stream channels fed by the remapped talker stream channels
+				auto affectedListenerStreamChannels = std::map<la::avdecc::UniqueIdentifier, std::set<std::pair<la::avdecc::entity::model::StreamIndex, uint16_t>>>{};
+				auto fullyAffectedListeners = std::set<la::avdecc::UniqueIdentifier>{};
+				for (auto const& connection : getIndexedStreamOutputConnections(entityId))
 				{
-					auto controlledEntityListener = manager.getControlledEntity(deviceMappingsKV.first);
-					if (controlledEntityListener)
+					if (connection.state != la::avdecc::entity::model::StreamConnectionState::State::Connected)
 					{
-						if (!controlledEntityListener->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+						continue;
+					}
+					auto const& listenerEntityId = connection.listenerStream.entityID;
+					if (_listenerChannelMappings.count(listenerEntityId) == 0)
+					{
+						continue;
+					}
+					if (!changedMappings)
+					{
+						fullyAffectedListeners.insert(listenerEntityId);
+						continue;
+					}
+
+					// listener mappings are expressed on the primary stream of a redundant pair
+					auto listenerStreamIndexes = std::set<la::avdecc::entity::model::StreamIndex>{ connection.listenerStream.streamIndex };
+					if (auto const virtualIndex = getRedundantVirtualIndexFromInputStreamIndex(connection.listenerStream))
+					{
+						if (auto const primaryStreamIndex = getPrimaryInputStreamIndexFromVirtualIndex(listenerEntityId, *virtualIndex))
 						{
-							continue;
+							for (auto const& redundantStreamKV : getRedundantStreamInputsForPrimary(listenerEntityId, *primaryStreamIndex))
+							{
+								listenerStreamIndexes.insert(redundantStreamKV.first);
+							}
 						}
-						auto const& configuration = controlledEntityListener->getCurrentConfigurationNode();
-						auto currentlyConnectedEntities = std::unordered_set<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash>{};
-						for (auto const& streamInput : configuration.streamInputs)
+					}
+
+					for (auto const& [talkerStreamIndex, streamChannel] : changedTalkerStreamChannels)
+					{
+						if (talkerStreamIndex == connection.talkerStream.streamIndex)
 						{
-							auto* streamInputDynamicModel = streamInput.second.dynamicModel;
-							if (streamInputDynamicModel && streamInputDynamicModel->connectionState.state == la::avdecc::entity::model::StreamConnectionState::State::Connected)
+							for (auto const listenerStreamIndex : listenerStreamIndexes)
 							{
-								currentlyConnectedEntities.emplace(streamInputDynamicModel->connectionState.talkerStream.entityID);
+								affectedListenerStreamChannels[listenerEntityId].emplace(listenerStreamIndex, streamChannel);
 							}
 						}
+					}
+				}
 
-						if (currentlyConnectedEntities.find(entityId) != currentlyConnectedEntities.end())
+				// search for talker changes that affect a listener in the cached map.
+				for (auto const& listenerEntityId : fullyAffectedListeners)
+				{
+					for (auto const& mappingKV : _listenerChannelMappings.at(listenerEntityId)->channelMappings)
+					{
+						listenerChannelsToUpdate.insert(std::make_pair(listenerEntityId, mappingKV.first));
+					}
+				}
+				for (auto const& [listenerEntityId, listenerStreamChannels] : affectedListenerStreamChannels)
+				{
+					for (auto const& mappingKV : _listenerChannelMappings.at(listenerEntityId)->channelMappings)
+					{
+						auto const& channelIdentification = mappingKV.first;
+						if (!channelIdentification.streamPortIndex || !channelIdentification.baseCluster)
+						{
+							continue;
+						}
+						auto const clusterOffset = static_cast<la::avdecc::entity::model::ClusterIndex>(channelIdentification.clusterIndex - *channelIdentification.baseCluster);
+						for (auto const& mapping : getStreamPortAudioMappings(listenerEntityId, la::avdecc::entity::model::DescriptorType::StreamPortInput, *channelIdentification.streamPortIndex))
 						{
-							for (auto const& mappingKV : deviceMappingsKV.second->channelMappings)
+							if (mapping.clusterOffset == clusterOffset && mapping.clusterChannel == channelIdentification.clusterChannel && listenerStreamChannels.count({ mapping.streamIndex, mapping.streamChannel }) != 0)
 							{
-								auto channel = std::make_pair(deviceMappingsKV.first, mappingKV.first);
-								listenerChannelsToUpdate.insert(channel);
+								// this needs a refresh
+								listenerChannelsToUpdate.insert(std::make_pair(listenerEntityId, channelIdentification));
+								break;
 							}
 						}
 					}
@@ -3537,26 +4132,8 @@ private:
 			}
 		}
 
-		for (auto const& listenerChannelToUpdateKV : listenerChannelsToUpdate)
-		{
-			auto const& sourceInfo = listenerChannelToUpdateKV.second;
-
-			auto connectionInfo = _listenerChannelMappings.at(listenerChannelToUpdateKV.first);
-
-			auto newListenerChannelConnections = determineChannelConnectionsReverse(listenerChannelToUpdateKV.first, sourceInfo);
-			auto oldListenerChannelConnections = connectionInfo->channelMappings.at(sourceInfo);
-
-			if (!newListenerChannelConnections->isEqualTo(*oldListenerChannelConnections))
-			{
-				connectionInfo->channelMappings[sourceInfo] = newListenerChannelConnections;
-				updatedListenerChannels.insert(listenerChannelToUpdateKV);
-			}
-		}
-
-		if (!updatedListenerChannels.empty())
-		{
-			emit listenerChannelConnectionsUpdate(updatedListenerChannels);
-		}
+		// mappings changes come in bursts (configuration change, reboot of a big device), recompute the affected channels in time slices
+		queuePendingListenerChannels(listenerChannelsToUpdate);
 	}
 };
 
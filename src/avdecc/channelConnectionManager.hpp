@@ -23,6 +23,11 @@
 #include <memory>
 #include <unordered_set>
 #include <optional>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
 #include <QObject>
 
 #include "mcDomainManager.hpp"
@@ -92,6 +97,27 @@ constexpr bool operator==(ChannelIdentification const& lhs, ChannelIdentificatio
 	return lhs.configurationIndex == rhs.configurationIndex && lhs.clusterIndex == rhs.clusterIndex && lhs.clusterChannel == rhs.clusterChannel && lhs.direction == rhs.direction && *lhs.audioUnitIndex == *rhs.audioUnitIndex && *lhs.streamPortIndex == *rhs.streamPortIndex && *lhs.baseCluster == *rhs.baseCluster;
 }
 
+/**
+* Packed identification of a channel (configuration, cluster, channel), ordered and compared like ChannelIdentification's operator< (the direction is not part of the key).
+*/
+using ChannelKey = std::uint64_t;
+
+constexpr ChannelKey makeChannelKey(ChannelIdentification const& channelIdentification) noexcept
+{
+	return (static_cast<ChannelKey>(channelIdentification.configurationIndex) << 32) | (static_cast<ChannelKey>(channelIdentification.clusterIndex) << 16) | static_cast<ChannelKey>(channelIdentification.clusterChannel);
+}
+
+/**
+* Range of consecutive clusters of a listener entity whose channel connections changed.
+*/
+struct ListenerClusterSpan
+{
+	la::avdecc::UniqueIdentifier entityID{};
+	la::avdecc::entity::model::ClusterIndex firstCluster{ 0u };
+	la::avdecc::entity::model::ClusterIndex lastCluster{ 0u }; // Included
+};
+using ListenerClusterSpans = std::vector<ListenerClusterSpan>; // Ordered by entity then cluster, not overlapping
+
 struct TargetConnectionInformation
 {
 	la::avdecc::UniqueIdentifier targetEntityId{ la::avdecc::UniqueIdentifier::getUninitializedUniqueIdentifier() };
@@ -108,7 +134,7 @@ struct TargetConnectionInformation
 	bool isTargetRedundant{ false }; // could be removed and only use virtual index != nullopt instead.
 	bool isSourceRedundant{ false };
 
-	inline bool isEqualTo(TargetConnectionInformation const& other)
+	inline bool isEqualTo(TargetConnectionInformation const& other) const
 	{
 		if (isSourceRedundant == other.isSourceRedundant && isTargetRedundant == other.isTargetRedundant && sourceStreamIndex == other.sourceStreamIndex && streamChannel == other.streamChannel && targetAudioUnitIndex == other.targetAudioUnitIndex && targetBaseCluster == other.targetBaseCluster && targetEntityId == other.targetEntityId && targetStreamIndex == other.targetStreamIndex && targetStreamPortIndex == other.targetStreamPortIndex && targetClusterChannels == other.targetClusterChannels)
 		{
@@ -122,9 +148,9 @@ struct TargetConnectionInformations
 {
 	la::avdecc::UniqueIdentifier sourceEntityId{ la::avdecc::UniqueIdentifier::getUninitializedUniqueIdentifier() };
 	std::optional<avdecc::ChannelIdentification> sourceClusterChannelInfo{ std::nullopt };
-	std::vector<std::shared_ptr<TargetConnectionInformation>> targets;
+	std::vector<TargetConnectionInformation> targets; // Stored contiguously, a TargetConnectionInformations is always shared as a whole
 
-	inline bool isEqualTo(TargetConnectionInformations const& other)
+	inline bool isEqualTo(TargetConnectionInformations const& other) const
 	{
 		if (sourceEntityId == other.sourceEntityId && sourceClusterChannelInfo == other.sourceClusterChannelInfo && targets.size() == other.targets.size())
 		{
@@ -133,7 +159,7 @@ struct TargetConnectionInformations
 			auto rhsIterator = other.targets.begin();
 			while (lhsIterator != targets.end() && rhsIterator != other.targets.end())
 			{
-				if (!(*lhsIterator)->isEqualTo(**rhsIterator))
+				if (!lhsIterator->isEqualTo(*rhsIterator))
 				{
 					return false;
 				}
@@ -146,9 +172,90 @@ struct TargetConnectionInformations
 	}
 };
 
+/**
+* Flat map of channel connections, sorted by ChannelKey.
+* Keys are kept in their own contiguous vector so lookups only touch packed integers.
+*/
+class ChannelConnectionsMap
+{
+public:
+	using value_type = std::pair<ChannelIdentification, std::shared_ptr<TargetConnectionInformations>>;
+	using const_iterator = std::vector<value_type>::const_iterator;
+
+	const_iterator begin() const noexcept
+	{
+		return _values.begin();
+	}
+
+	const_iterator end() const noexcept
+	{
+		return _values.end();
+	}
+
+	std::size_t size() const noexcept
+	{
+		return _values.size();
+	}
+
+	bool empty() const noexcept
+	{
+		return _values.empty();
+	}
+
+	const_iterator find(ChannelIdentification const& channelIdentification) const noexcept
+	{
+		auto const key = makeChannelKey(channelIdentification);
+		auto const keyIt = std::lower_bound(_keys.begin(), _keys.end(), key);
+		if (keyIt == _keys.end() || *keyIt != key)
+		{
+			return _values.end();
+		}
+		return _values.begin() + std::distance(_keys.begin(), keyIt);
+	}
+
+	std::shared_ptr<TargetConnectionInformations> const& at(ChannelIdentification const& channelIdentification) const
+	{
+		auto const it = find(channelIdentification);
+		if (it == end())
+		{
+			throw std::out_of_range("ChannelConnectionsMap::at");
+		}
+		return it->second;
+	}
+
+	// Inserts the value if the channel is not in the map yet, returns the (new or existing) entry
+	std::shared_ptr<TargetConnectionInformations>& emplace(ChannelIdentification const& channelIdentification, std::shared_ptr<TargetConnectionInformations> const& connections)
+	{
+		auto const key = makeChannelKey(channelIdentification);
+		auto const keyIt = std::lower_bound(_keys.begin(), _keys.end(), key);
+		auto const offset = std::distance(_keys.begin(), keyIt);
+		if (keyIt != _keys.end() && *keyIt == key)
+		{
+			return _values[offset].second;
+		}
+		_keys.insert(keyIt, key);
+		return _values.insert(_values.begin() + offset, value_type{ channelIdentification, connections })->second;
+	}
+
+	std::shared_ptr<TargetConnectionInformations>& operator[](ChannelIdentification const& channelIdentification)
+	{
+		return emplace(channelIdentification, {});
+	}
+
+	void clear() noexcept
+	{
+		_keys.clear();
+		_values.clear();
+	}
+
+private:
+	std::vector<ChannelKey> _keys{};
+	std::vector<value_type> _values{};
+};
+
 struct SourceChannelConnections
 {
-	std::map<ChannelIdentification, std::shared_ptr<TargetConnectionInformations>> channelMappings;
+	ChannelConnectionsMap channelMappings;
 };
 
 struct CreateConnectionsInfo
@@ -204,6 +311,9 @@ public:
 
 	virtual ChannelConnectResult createChannelConnections(la::avdecc::UniqueIdentifier const& talkerEntityId, la::avdecc::UniqueIdentifier const& listenerEntityId, std::vector<std::pair<avdecc::ChannelIdentification, avdecc::ChannelIdentification>> const& talkerToListenerChannelConnections, bool const allowTalkerMappingChanges = false, bool const allowRemovalOfUnusedAudioMappings = false) noexcept = 0;
 
+	/** Plans the channel connections exactly like createChannelConnections does, without sending any command. Returns the result createChannelConnections would return */
+	virtual ChannelConnectResult checkChannelConnections(la::avdecc::UniqueIdentifier const& talkerEntityId, la::avdecc::UniqueIdentifier const& listenerEntityId, std::vector<std::pair<avdecc::ChannelIdentification, avdecc::ChannelIdentification>> const& talkerToListenerChannelConnections, bool const allowTalkerMappingChanges = false, bool const allowRemovalOfUnusedAudioMappings = false) const noexcept = 0;
+
 	virtual ChannelDisconnectResult removeChannelConnection(
 		la::avdecc::UniqueIdentifier const& talkerEntityId, la::avdecc::entity::model::AudioUnitIndex const talkerAudioUnitIndex, la::avdecc::entity::model::StreamPortIndex const talkerStreamPortIndex, la::avdecc::entity::model::ClusterIndex const talkerClusterIndex, la::avdecc::entity::model::ClusterIndex const talkerBaseCluster, std::uint16_t const talkerClusterChannel, la::avdecc::UniqueIdentifier const& listenerEntityId, la::avdecc::entity::model::AudioUnitIndex const listenerAudioUnitIndex, la::avdecc::entity::model::StreamPortIndex const listenerStreamPortIndex, la::avdecc::entity::model::ClusterIndex const listenerClusterIndex, la::avdecc::entity::model::ClusterIndex const listenerBaseCluster, std::uint16_t const listenerClusterChannel) noexcept = 0;
 
@@ -213,6 +323,8 @@ public:
 
 	// SIGNALS:
 	Q_SIGNAL void listenerChannelConnectionsUpdate(std::set<std::pair<la::avdecc::UniqueIdentifier, ChannelIdentification>> const& channels);
+	/* Same update as listenerChannelConnectionsUpdate (emitted right after it), the channels being merged into ranges of consecutive clusters */
+	Q_SIGNAL void listenerClusterSpansUpdate(avdecc::ListenerClusterSpans const& spans);
 
 	/* Invoked after createChannelConnection or createChannelConnections are completed */
 	Q_SIGNAL void createChannelConnectionsFinished(CreateConnectionsInfo const& info);
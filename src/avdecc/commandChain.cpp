@@ -21,15 +21,49 @@
 #include "controllerManager.hpp"
 #include "helper.hpp"
 #include <la/avdecc/internals/streamFormatInfo.hpp>
+#include <algorithm>
 #include <atomic>
 #include <optional>
 #include <unordered_set>
 #include <math.h>
 
+#include <QThread>
+#include <QTimer>
+
 namespace avdecc
 {
 namespace commandChain
 {
+/** Minimum count of latency samples for the adaptive in flight limit of an entity to start from them */
+static constexpr std::uint64_t MinLatencySamples = 8u;
+
+/**
+		* Initial in flight limit of an entity, from the response time of 90% of its AECP commands.
+		*/
+static size_t initialInFlightLimit(la::avdecc::UniqueIdentifier const entityId, size_t const maxLimit) noexcept
+{
+	auto const latencies = ControllerManager::getInstance().getAecpCommandLatencies(entityId).allCommands;
+	if (latencies.count() < MinLatencySamples)
+	{
+		return std::min(AsyncParallelCommandSet::InitialInFlightCommandsPerEntity, maxLimit);
+	}
+
+	auto const responseTime = std::chrono::duration_cast<std::chrono::milliseconds>(latencies.percentile(0.9));
+	if (responseTime <= std::chrono::milliseconds{ 20 })
+	{
+		return maxLimit;
+	}
+	if (responseTime <= std::chrono::milliseconds{ 100 })
+	{
+		return std::max(maxLimit / 2u, size_t{ 1u });
+	}
+	if (responseTime <= std::chrono::milliseconds{ 500 })
+	{
+		return std::max(maxLimit / 4u, size_t{ 1u });
+	}
+	return 1u;
+}
+
 CommandExecutionError AsyncParallelCommandSet::controlStatusToCommandError(la::avdecc::entity::ControllerEntity::ControlStatus const status) noexcept
 {
 	switch (status)
@@ -68,8 +102,43 @@ CommandExecutionError AsyncParallelCommandSet::controlStatusToCommandError(la::a
 	}
 }
 
+QString AsyncParallelCommandSet::errorToString(CommandExecutionError const error) noexcept
+{
+	switch (error)
+	{
+		case CommandExecutionError::NoError:
+			return "No error.";
+		case CommandExecutionError::LockedByOther:
+			return "Entity is locked.";
+		case CommandExecutionError::AcquiredByOther:
+			return "Entity is acquired by another controller.";
+		case CommandExecutionError::EntityError:
+			return "Entity error. Operation might not be supported.";
+		case CommandExecutionError::CommandFailure:
+			return "Command failure.";
+		case CommandExecutionError::NetworkIssue:
+			return "Network error.";
+		case CommandExecutionError::Timeout:
+			return "Command timed out. Entity might be offline.";
+		case CommandExecutionError::NotSupported:
+			return "The command is not supported by this device.";
+		case CommandExecutionError::NoMediaClockOutputAvailable:
+			return "Device does not have any compatible media clock outputs.";
+		case CommandExecutionError::NoMediaClockInputAvailable:
+			return "Device does not have any compatible media clock inputs.";
+		default:
+			return "Unknown error.";
+	}
+}
+
 CommandExecutionError AsyncParallelCommandSet::aemCommandStatusToCommandError(la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
 {
+	// A newer value was submitted for the same descriptor, which is not a failure of this command set
+	if (status == avdecc::ControllerManager::AemCommandStatusSuperseded)
+	{
+		return CommandExecutionError::NoError;
+	}
+
 	switch (status)
 	{
 		case la::avdecc::entity::LocalEntity::AemCommandStatus::Success:
@@ -113,7 +182,7 @@ AsyncParallelCommandSet::AsyncParallelCommandSet() noexcept {}
 		*/
 AsyncParallelCommandSet::AsyncParallelCommandSet(AsyncCommand const& command) noexcept
 {
-	_commands.push_back(command);
+	append(command);
 }
 
 /**
@@ -121,7 +190,7 @@ AsyncParallelCommandSet::AsyncParallelCommandSet(AsyncCommand const& command) no
 		*/
 AsyncParallelCommandSet::AsyncParallelCommandSet(std::vector<AsyncCommand> const& commands) noexcept
 {
-	_commands.insert(std::end(_commands), std::begin(commands), std::end(commands));
+	append(commands);
 }
 
 /**
@@ -129,15 +198,42 @@ AsyncParallelCommandSet::AsyncParallelCommandSet(std::vector<AsyncCommand> const
 		*/
 void AsyncParallelCommandSet::append(AsyncCommand const& command) noexcept
 {
-	_commands.push_back(command);
+	append(la::avdecc::UniqueIdentifier{}, command);
 }
 
 /**
 		* Appends a command function to the internal list.
 		*/
 void AsyncParallelCommandSet::append(std::vector<AsyncCommand> const& commands) noexcept
+{
+	append(la::avdecc::UniqueIdentifier{}, commands);
+}
+
+/**
+		* Appends a command function addressed to the given entity to the internal list.
+		*/
+void AsyncParallelCommandSet::append(la::avdecc::UniqueIdentifier const targetEntityId, AsyncCommand const& command) noexcept
+{
+	_commands.push_back(command);
+	_commandTargets.push_back(targetEntityId);
+}
+
+/**
+		* Appends command functions addressed to the given entity to the internal list.
+		*/
+void AsyncParallelCommandSet::append(la::avdecc::UniqueIdentifier const targetEntityId, std::vector<AsyncCommand> const& commands) noexcept
 {
 	_commands.insert(std::end(_commands), std::begin(commands), std::end(commands));
+	_commandTargets.insert(std::end(_commandTargets), commands.size(), targetEntityId);
+}
+
+/**
+		* Sets the maximum count of commands in flight, globally and per target entity (0 means unbounded).
+		*/
+void AsyncParallelCommandSet::setMaxInFlightCommands(size_t const maxInFlightCommands, size_t const maxInFlightCommandsPerEntity) noexcept
+{
+	_maxInFlightCommands = maxInFlightCommands;
+	_maxInFlightCommandsPerEntity = maxInFlightCommandsPerEntity;
 }
 
 /**
@@ -145,6 +241,15 @@ void AsyncParallelCommandSet::append(std::vector<AsyncCommand> const& commands)
 		*/
 void AsyncParallelCommandSet::addErrorInfo(la::avdecc::UniqueIdentifier const entityId, CommandExecutionError const error, avdecc::ControllerManager::AcmpCommandType const commandType) noexcept
 {
+	if (queueToOwnerThread(
+				[this, entityId, error, commandType]()
+				{
+					addErrorInfo(entityId, error, commandType);
+				}))
+	{
+		return;
+	}
+
 	CommandErrorInfo info{ error };
 	info.commandTypeAcmp = commandType;
 	_errors.emplace(entityId, info);
@@ -155,6 +260,15 @@ void AsyncParallelCommandSet::addErrorInfo(la::avdecc::UniqueIdentifier const en
 		*/
 void AsyncParallelCommandSet::addErrorInfo(la::avdecc::UniqueIdentifier const entityId, CommandExecutionError const error, avdecc::ControllerManager::AecpCommandType const commandType) noexcept
 {
+	if (queueToOwnerThread(
+				[this, entityId, error, commandType]()
+				{
+					addErrorInfo(entityId, error, commandType);
+				}))
+	{
+		return;
+	}
+
 	CommandErrorInfo info{ error };
 	info.commandTypeAecp = commandType;
 	_errors.emplace(entityId, info);
@@ -165,10 +279,33 @@ void AsyncParallelCommandSet::addErrorInfo(la::avdecc::UniqueIdentifier const en
 		*/
 void AsyncParallelCommandSet::addErrorInfo(la::avdecc::UniqueIdentifier const entityId, CommandExecutionError const error) noexcept
 {
+	if (queueToOwnerThread(
+				[this, entityId, error]()
+				{
+					addErrorInfo(entityId, error);
+				}))
+	{
+		return;
+	}
+
 	CommandErrorInfo info{ error };
 	_errors.emplace(entityId, info);
 }
 
+/**
+		* Queues the function to the thread of the command set when called from another one (responses are received from the avdecc thread), so the state of the command set is only ever accessed from its own thread.
+		* Returns true if the function was queued.
+		*/
+bool AsyncParallelCommandSet::queueToOwnerThread(std::function<void()>&& function) noexcept
+{
+	if (QThread::currentThread() == thread())
+	{
+		return false;
+	}
+	QMetaObject::invokeMethod(this, std::move(function), Qt::QueuedConnection);
+	return true;
+}
+
 /**
 		* Gets the count of commands.
 		*/
@@ -178,43 +315,255 @@ size_t AsyncParallelCommandSet::parallelCommandCount() const noexcept
 }
 
 /**
-		* Executes all commands. Eventually emits commandSetCompleted if none of the commands has anything to do.
+		* Executes all commands, as many at once as the in flight limits allow. Eventually emits commandSetCompleted if none of the commands has anything to do.
 		*/
 void AsyncParallelCommandSet::exec() noexcept
 {
 	if (_commands.empty())
 	{
-		invokeCommandCompleted(0, false);
+		emit commandSetCompleted(_errors);
 		return;
 	}
-	auto index = uint32_t{ 0 };
-	for (auto const& command : _commands)
+
+	_completedCommands.assign(_commands.size(), false);
+	_commandRetries.assign(_commands.size(), 0u);
+	_pendingCommands.clear();
+	for (auto index = uint32_t{ 0 }; index < static_cast<uint32_t>(_commands.size()); ++index)
 	{
-		if (!command(this, index))
-		{
-			invokeCommandCompleted(index, false);
-		}
-		index++;
+		_pendingCommands.push_back(index);
 	}
+
+	launchPendingCommands();
 }
 
 /**
 		* After a command was executed, this is called.
 		*/
-void AsyncParallelCommandSet::invokeCommandCompleted(uint32_t const /*commandIndex*/, bool const error) noexcept
+void AsyncParallelCommandSet::invokeCommandCompleted(uint32_t const commandIndex, bool const error) noexcept
 {
+	if (queueToOwnerThread(
+				[this, commandIndex, error]()
+				{
+					invokeCommandCompleted(commandIndex, error);
+				}))
+	{
+		return;
+	}
+
+	if (commandIndex >= _completedCommands.size() || _completedCommands[commandIndex])
+	{
+		return;
+	}
+	_completedCommands[commandIndex] = true;
+
 	if (error)
 	{
 		_errorOccured = true;
-		_commandCompletionCounter++;
 	}
-	else
+	_commandCompletionCounter++;
+
+	releaseInFlightSlots(commandIndex);
+
+	// a full window of successful commands allows one more for the entity
+	auto const& targetEntityId = _commandTargets[commandIndex];
+	if (!error && targetEntityId.isValid() && _maxInFlightCommandsPerEntity != 0u)
 	{
-		_commandCompletionCounter++;
+		auto& flowControl = entityFlowControl(targetEntityId);
+		if (++flowControl.successesSinceIncrease >= flowControl.limit && flowControl.limit < _maxInFlightCommandsPerEntity)
+		{
+			++flowControl.limit;
+			flowControl.successesSinceIncrease = 0u;
+		}
 	}
 
+	emit commandCompleted(commandIndex, error);
+
 	if (_commandCompletionCounter >= static_cast<decltype(_commandCompletionCounter)>(_commands.size()))
 	{
+		// do not notify while still launching, the receiver could destroy this command set
+		if (_isLaunching)
+		{
+			_completionPending = true;
+		}
+		else
+		{
+			emit commandSetCompleted(_errors);
+		}
+		return;
+	}
+
+	launchPendingCommands();
+}
+
+/**
+		* Completes an acmp command from the error of its response, launching it again if it timed out.
+		*/
+void AsyncParallelCommandSet::completeCommand(uint32_t const commandIndex, la::avdecc::UniqueIdentifier const entityId, CommandExecutionError const error, avdecc::ControllerManager::AcmpCommandType const commandType) noexcept
+{
+	// the flow control and retry state belong to the thread of the command set
+	if (queueToOwnerThread(
+				[this, commandIndex, entityId, error, commandType]()
+				{
+					completeCommand(commandIndex, entityId, error, commandType);
+				}))
+	{
+		return;
+	}
+
+	if (retryAfterTimeout(commandIndex, error))
+	{
+		return;
+	}
+
+	if (error != CommandExecutionError::NoError)
+	{
+		addErrorInfo(entityId, error, commandType);
+	}
+	invokeCommandCompleted(commandIndex, error != CommandExecutionError::NoError);
+}
+
+/**
+		* Completes an aecp command from the error of its response, launching it again if it timed out.
+		*/
+void AsyncParallelCommandSet::completeCommand(uint32_t const commandIndex, la::avdecc::UniqueIdentifier const entityId, CommandExecutionError const error, avdecc::ControllerManager::AecpCommandType const commandType) noexcept
+{
+	// the flow control and retry state belong to the thread of the command set
+	if (queueToOwnerThread(
+				[this, commandIndex, entityId, error, commandType]()
+				{
+					completeCommand(commandIndex, entityId, error, commandType);
+				}))
+	{
+		return;
+	}
+
+	if (retryAfterTimeout(commandIndex, error))
+	{
+		return;
+	}
+
+	if (error != CommandExecutionError::NoError)
+	{
+		addErrorInfo(entityId, error, commandType);
+	}
+	invokeCommandCompleted(commandIndex, error != CommandExecutionError::NoError);
+}
+
+/**
+		* Halves the in flight limit of the target entity of a timed out command, and schedules the command to be launched again if it has retries left.
+		* Returns true if the command will be launched again.
+		*/
+bool AsyncParallelCommandSet::retryAfterTimeout(uint32_t const commandIndex, CommandExecutionError const error) noexcept
+{
+	if (error != CommandExecutionError::Timeout || commandIndex >= _completedCommands.size() || _completedCommands[commandIndex])
+	{
+		return false;
+	}
+
+	auto const& targetEntityId = _commandTargets[commandIndex];
+	if (targetEntityId.isValid() && _maxInFlightCommandsPerEntity != 0u)
+	{
+		auto& flowControl = entityFlowControl(targetEntityId);
+		flowControl.limit = std::max(flowControl.limit / 2u, size_t{ 1u });
+		flowControl.successesSinceIncrease = 0u;
+	}
+
+	if (_commandRetries[commandIndex] >= MaxCommandRetries)
+	{
+		return false;
+	}
+
+	auto const delay = RetryBaseDelay * (1 << _commandRetries[commandIndex]);
+	++_commandRetries[commandIndex];
+	releaseInFlightSlots(commandIndex);
+
+	QTimer::singleShot(delay, this,
+		[this, commandIndex]()
+		{
+			_pendingCommands.push_front(commandIndex);
+			launchPendingCommands();
+		});
+
+	return true;
+}
+
+/**
+		* Releases the global and entity in flight slots taken by a command.
+		*/
+void AsyncParallelCommandSet::releaseInFlightSlots(uint32_t const commandIndex) noexcept
+{
+	--_inFlightCommandCount;
+	auto const& targetEntityId = _commandTargets[commandIndex];
+	if (targetEntityId.isValid())
+	{
+		auto const entityIt = _inFlightCommandsPerEntity.find(targetEntityId);
+		if (entityIt != _inFlightCommandsPerEntity.end() && --entityIt->second == 0u)
+		{
+			_inFlightCommandsPerEntity.erase(entityIt);
+		}
+	}
+}
+
+/**
+		* Gets the adaptive in flight limit state of an entity, initialized from its measured latencies the first time.
+		*/
+AsyncParallelCommandSet::EntityFlowControl& AsyncParallelCommandSet::entityFlowControl(la::avdecc::UniqueIdentifier const entityId) noexcept
+{
+	auto const it = _entityFlowControls.find(entityId);
+	if (it != _entityFlowControls.end())
+	{
+		return it->second;
+	}
+
+	return _entityFlowControls.emplace(entityId, EntityFlowControl{ initialInFlightLimit(entityId, _maxInFlightCommandsPerEntity), 0u }).first->second;
+}
+
+/**
+		* Launches the pending commands, in order, while the in flight limits allow it.
+		* A command that cannot be launched because its target entity is busy does not prevent the following ones from being launched.
+		*/
+void AsyncParallelCommandSet::launchPendingCommands() noexcept
+{
+	// called again by a command completing synchronously, let the current loop pick the freed slots
+	if (_isLaunching)
+	{
+		_launchRequested = true;
+		return;
+	}
+
+	_isLaunching = true;
+	do
+	{
+		_launchRequested = false;
+		auto commandIt = _pendingCommands.begin();
+		while (commandIt != _pendingCommands.end() && (_maxInFlightCommands == 0u || _inFlightCommandCount < _maxInFlightCommands))
+		{
+			auto const commandIndex = *commandIt;
+			auto const& targetEntityId = _commandTargets[commandIndex];
+			if (targetEntityId.isValid())
+			{
+				auto& entityInFlightCommands = _inFlightCommandsPerEntity[targetEntityId];
+				if (_maxInFlightCommandsPerEntity != 0u && entityInFlightCommands >= entityFlowControl(targetEntityId).limit)
+				{
+					++commandIt;
+					continue;
+				}
+				++entityInFlightCommands;
+			}
+			++_inFlightCommandCount;
+			commandIt = _pendingCommands.erase(commandIt);
+
+			if (!_commands[commandIndex](this, commandIndex))
+			{
+				invokeCommandCompleted(commandIndex, false);
+			}
+		}
+	} while (_launchRequested);
+	_isLaunching = false;
+
+	if (_completionPending)
+	{
+		_completionPending = false;
 		emit commandSetCompleted(_errors);
 	}
 }
@@ -224,7 +573,7 @@ void AsyncParallelCommandSet::invokeCommandCompleted(uint32_t const /*commandInd
 /**
 		* Constructor.
 		*/
-SequentialAsyncCommandExecuter::SequentialAsyncCommandExecuter(QObject* parent) noexcept
+AsyncCommandGraphExecuter::AsyncCommandGraphExecuter(QObject* parent) noexcept
 	: QObject(parent)
 {
 }
@@ -233,54 +582,163 @@ SequentialAsyncCommandExecuter::SequentialAsyncCommandExecuter(QObject* parent)
 		* Destructor.
 		* Destroy child pointers.
 		*/
-SequentialAsyncCommandExecuter::~SequentialAsyncCommandExecuter()
+AsyncCommandGraphExecuter::~AsyncCommandGraphExecuter()
 {
-	qDeleteAll(_commands);
+	clear();
 }
 
 /**
-		* Sets the commands to be executed.
+		* Adds a command set to the graph, depending on the previously added command sets working on one of the given entities.
+		* A command set without entities depends on all previously added command sets.
 		*/
-void SequentialAsyncCommandExecuter::setCommandChain(std::vector<AsyncParallelCommandSet*> const& commands) noexcept
+AsyncCommandGraphExecuter::NodeIndex AsyncCommandGraphExecuter::addCommandSet(AsyncParallelCommandSet* const commandSet, Resources const& resources) noexcept
+{
+	auto const nodeIndex = _nodes.size();
+	_nodes.push_back(Node{ commandSet });
+	commandSet->setParent(this);
+	_totalCommandCount += static_cast<uint32_t>(commandSet->parallelCommandCount());
+
+	if (resources.empty())
+	{
+		// barrier
+		if (_lastBarrier)
+		{
+			addDependency(*_lastBarrier, nodeIndex);
+		}
+		for (auto const dependency : _nodesSinceLastBarrier)
+		{
+			addDependency(dependency, nodeIndex);
+		}
+		_nodesSinceLastBarrier.clear();
+		_lastNodePerResource.clear();
+		_lastBarrier = nodeIndex;
+	}
+	else
+	{
+		if (_lastBarrier)
+		{
+			addDependency(*_lastBarrier, nodeIndex);
+		}
+		for (auto const& resource : resources)
+		{
+			auto const lastNodeIt = _lastNodePerResource.find(resource);
+			if (lastNodeIt != _lastNodePerResource.end())
+			{
+				addDependency(lastNodeIt->second, nodeIndex);
+				lastNodeIt->second = nodeIndex;
+			}
+			else
+			{
+				_lastNodePerResource.emplace(resource, nodeIndex);
+			}
+		}
+		_nodesSinceLastBarrier.push_back(nodeIndex);
+	}
+
+	return nodeIndex;
+}
+
+/**
+		* Removes all command sets from the graph.
+		*/
+void AsyncCommandGraphExecuter::clear() noexcept
 {
-	auto totalCommandCount = std::uint32_t{ 0 };
-	_commands = commands;
-	for (auto* command : _commands)
+	for (auto const& node : _nodes)
 	{
-		command->setParent(this);
-		totalCommandCount += command->parallelCommandCount();
+		delete node.commandSet;
 	}
-	_totalCommandCount = totalCommandCount;
+	_nodes.clear();
+	_lastNodePerResource.clear();
+	_nodesSinceLastBarrier.clear();
+	_lastBarrier = std::nullopt;
+	_readyNodes.clear();
+	_runningNodeCount = 0u;
+	_completedNodeCount = 0u;
+	_totalCommandCount = 0;
 	_completedCommandCount = 0;
-	_currentCommandSet = 0;
 }
 
 /**
-		* Starts or continues the sequence of commands that was set via setCommandChain.
+		* Sets the maximum count of command sets running at the same time (0 means unbounded).
+		*/
+void AsyncCommandGraphExecuter::setMaxRunningCommandSets(size_t const maxRunningCommandSets) noexcept
+{
+	_maxRunningNodes = maxRunningCommandSets;
+}
+
+/**
+		* Starts the command sets that do not depend on any other.
 		*/
-void SequentialAsyncCommandExecuter::start() noexcept
+void AsyncCommandGraphExecuter::start() noexcept
 {
-	if (_currentCommandSet < _commands.size())
+	if (_nodes.empty())
 	{
-		connect(_commands.at(_currentCommandSet), &AsyncParallelCommandSet::commandSetCompleted, this,
-			[this](CommandExecutionErrors errors)
-			{
-				_errors.insert(errors.begin(), errors.end());
-				_completedCommandCount += _commands.at(_currentCommandSet)->parallelCommandCount();
-				emit progressUpdate(_completedCommandCount, _totalCommandCount);
+		emit completed(_errors);
+		_errors.clear();
+		return;
+	}
 
-				// start next set
-				_currentCommandSet++;
-				start();
+	for (auto nodeIndex = NodeIndex{ 0u }; nodeIndex < _nodes.size(); ++nodeIndex)
+	{
+		auto* const commandSet = _nodes[nodeIndex].commandSet;
+		connect(commandSet, &AsyncParallelCommandSet::commandSetCompleted, this,
+			[this, nodeIndex](CommandExecutionErrors errors)
+			{
+				onNodeCompleted(nodeIndex, errors);
 			});
 
-		_commands.at(_currentCommandSet)->exec();
+		if (_nodes[nodeIndex].remainingDependencies == 0u)
+		{
+			_readyNodes.push_back(nodeIndex);
+		}
 	}
-	else
+
+	dispatchReadyNodes();
+}
+
+/**
+		* Records that a node has to wait for another one to complete, unless already recorded.
+		*/
+void AsyncCommandGraphExecuter::addDependency(NodeIndex const dependency, NodeIndex const dependent) noexcept
+{
+	auto& dependents = _nodes[dependency].dependents;
+	if (std::find(dependents.begin(), dependents.end(), dependent) == dependents.end())
+	{
+		dependents.push_back(dependent);
+		++_nodes[dependent].remainingDependencies;
+	}
+}
+
+/**
+		* Starts the ready command sets, as many as the running limit allows.
+		*/
+void AsyncCommandGraphExecuter::dispatchReadyNodes() noexcept
+{
+	// called again by a command set completing synchronously, the current loop will start the new ready nodes
+	if (_isDispatching)
+	{
+		return;
+	}
+
+	_isDispatching = true;
+	while (!_readyNodes.empty() && (_maxRunningNodes == 0u || _runningNodeCount < _maxRunningNodes))
 	{
-		// clear the command list once completed.
-		qDeleteAll(_commands);
-		_commands.clear();
+		auto const nodeIndex = _readyNodes.front();
+		_readyNodes.pop_front();
+		++_runningNodeCount;
+		_nodes[nodeIndex].commandSet->exec();
+	}
+	_isDispatching = false;
+
+	if (!_nodes.empty() && _completedNodeCount == _nodes.size())
+	{
+		// clear the command graph once completed (the last command set is still notifying us, do not delete it right away)
+		for (auto const& node : _nodes)
+		{
+			node.commandSet->deleteLater();
+		}
+		_nodes.clear();
+		clear();
 
 		emit completed(_errors);
 
@@ -288,5 +746,51 @@ void SequentialAsyncCommandExecuter::start() noexcept
 	}
 }
 
+/**
+		* Called when a command set of the graph completed, starts the command sets that were waiting for it.
+		*/
+void AsyncCommandGraphExecuter::onNodeCompleted(NodeIndex const nodeIndex, CommandExecutionErrors const& errors) noexcept
+{
+	auto const& node = _nodes[nodeIndex];
+	_errors.insert(errors.begin(), errors.end());
+	_completedCommandCount += static_cast<uint32_t>(node.commandSet->parallelCommandCount());
+	--_runningNodeCount;
+	++_completedNodeCount;
+	emit progressUpdate(_completedCommandCount, _totalCommandCount);
+
+	for (auto const dependent : node.dependents)
+	{
+		if (--_nodes[dependent].remainingDependencies == 0u)
+		{
+			_readyNodes.push_back(dependent);
+		}
+	}
+
+	dispatchReadyNodes();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+		* Constructor.
+		*/
+SequentialAsyncCommandExecuter::SequentialAsyncCommandExecuter(QObject* parent) noexcept
+	: AsyncCommandGraphExecuter(parent)
+{
+}
+
+/**
+		* Sets the commands to be executed.
+		*/
+void SequentialAsyncCommandExecuter::setCommandChain(std::vector<AsyncParallelCommandSet*> const& commands) noexcept
+{
+	clear();
+	for (auto* command : commands)
+	{
+		// each command set is a barrier, which makes the graph a sequence
+		addCommandSet(command);
+	}
+}
+
 } // namespace commandChain
 } // namespace avdecc
@@ -20,8 +20,14 @@
 #pragma once
 
 #include <la/avdecc/controller/avdeccController.hpp>
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <optional>
+#include <list>
+#include <set>
+#include <unordered_map>
+#include <vector>
 #include <QObject>
 #include <QMap>
 
@@ -60,6 +66,14 @@ using CommandExecutionErrors = std::unordered_multimap<la::avdecc::UniqueIdentif
 /**
 * @brief    Holds n function pointers of the form std::function<bool(void)> that can be executed
 			using the exec() method.
+*			The number of commands in flight is bounded, globally and per target entity (when the
+*			command was appended with one), the next pending command being launched as each one completes.
+*			The limit of each entity adapts to its responsiveness: it starts from the AECP latencies already
+*			measured for the entity, grows by one each time a full window of commands succeeded and is halved
+*			on a timeout. Commands completed with completeCommand() are launched again after a timeout, with
+*			a doubling delay, so slow devices get fewer concurrent commands instead of failing the whole batch.
+*			Completions and errors reported from another thread are queued to the thread of the command set,
+*			which is the only one accessing its state.
 * [@author  Marius Erlen]
 * [@date    2018-11-22]
 */
@@ -72,6 +86,13 @@ public:
 
 	static CommandExecutionError controlStatusToCommandError(la::avdecc::entity::ControllerEntity::ControlStatus const status) noexcept;
 	static CommandExecutionError aemCommandStatusToCommandError(la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept;
+	static QString errorToString(CommandExecutionError const error) noexcept;
+
+	static constexpr size_t DefaultMaxInFlightCommands = 32; // 0 means unbounded
+	static constexpr size_t DefaultMaxInFlightCommandsPerEntity = 8; // 0 means unbounded, otherwise the upper bound of the adaptive limit of each entity
+	static constexpr size_t InitialInFlightCommandsPerEntity = 4; // Adaptive limit of an entity without enough latency samples
+	static constexpr size_t MaxCommandRetries = 2; // Timed out commands completed with completeCommand() are launched again, up to this count
+	static constexpr std::chrono::milliseconds RetryBaseDelay{ 250 }; // Delay before the first retry, doubled for each following one
 
 public:
 	AsyncParallelCommandSet() noexcept;
@@ -80,6 +101,10 @@ public:
 
 	void append(AsyncCommand const& command) noexcept;
 	void append(std::vector<AsyncCommand> const& commands) noexcept;
+	void append(la::avdecc::UniqueIdentifier const targetEntityId, AsyncCommand const& command) noexcept;
+	void append(la::avdecc::UniqueIdentifier const targetEntityId, std::vector<AsyncCommand> const& commands) noexcept;
+
+	void setMaxInFlightCommands(size_t const maxInFlightCommands, size_t const maxInFlightCommandsPerEntity) noexcept;
 
 	void addErrorInfo(la::avdecc::UniqueIdentifier const entityId, CommandExecutionError const error, avdecc::ControllerManager::AcmpCommandType const commandType) noexcept;
 	void addErrorInfo(la::avdecc::UniqueIdentifier const entityId, CommandExecutionError const error, avdecc::ControllerManager::AecpCommandType const commandType) noexcept;
@@ -90,16 +115,106 @@ public:
 
 	void invokeCommandCompleted(uint32_t const commandIndex, bool const error) noexcept;
 
+	/** Completes a command from the error of its response: a timed out command is launched again after a delay (up to MaxCommandRetries times), the other errors (and the last timeout) being recorded for entityId */
+	void completeCommand(uint32_t const commandIndex, la::avdecc::UniqueIdentifier const entityId, CommandExecutionError const error, avdecc::ControllerManager::AcmpCommandType const commandType) noexcept;
+	void completeCommand(uint32_t const commandIndex, la::avdecc::UniqueIdentifier const entityId, CommandExecutionError const error, avdecc::ControllerManager::AecpCommandType const commandType) noexcept;
+
 	// Signals
 	Q_SIGNAL void commandSetCompleted(CommandExecutionErrors errors); // emitted after all commands in this command set were executed.
+	Q_SIGNAL void commandCompleted(uint32_t const commandIndex, bool const error); // emitted each time one of the commands completed, from the thread of the command set.
 
 private:
+	struct EntityFlowControl
+	{
+		size_t limit{ 0u }; // Current in flight limit of the entity
+		size_t successesSinceIncrease{ 0u };
+	};
+
+	bool queueToOwnerThread(std::function<void()>&& function) noexcept;
+	void launchPendingCommands() noexcept;
+	bool retryAfterTimeout(uint32_t const commandIndex, CommandExecutionError const error) noexcept;
+	void releaseInFlightSlots(uint32_t const commandIndex) noexcept;
+	EntityFlowControl& entityFlowControl(la::avdecc::UniqueIdentifier const entityId) noexcept;
+
 	CommandExecutionErrors _errors;
 	std::vector<AsyncCommand> _commands;
+	std::vector<la::avdecc::UniqueIdentifier> _commandTargets; // Target entity of each command (invalid if not specified)
+	std::vector<bool> _completedCommands;
+	std::list<uint32_t> _pendingCommands; // Indexes of the commands not launched yet, in launch order
+	std::vector<uint8_t> _commandRetries; // Count of retries of each command
+	std::unordered_map<la::avdecc::UniqueIdentifier, size_t, la::avdecc::UniqueIdentifier::hash> _inFlightCommandsPerEntity;
+	std::unordered_map<la::avdecc::UniqueIdentifier, EntityFlowControl, la::avdecc::UniqueIdentifier::hash> _entityFlowControls;
+	size_t _inFlightCommandCount{ 0u };
+	size_t _maxInFlightCommands{ DefaultMaxInFlightCommands };
+	size_t _maxInFlightCommandsPerEntity{ DefaultMaxInFlightCommandsPerEntity };
+	bool _isLaunching{ false }; // Commands may complete synchronously while being launched
+	bool _launchRequested{ false };
+	bool _completionPending{ false };
 	uint32_t _commandCompletionCounter{ 0 };
 	bool _errorOccured{ false };
 };
 
+// **************************************************************
+// class AsyncCommandGraphExecuter
+// **************************************************************
+/**
+* @brief    Executes a dependency graph of AsyncParallelCommandSet, built by calling addCommandSet().
+*			The graph can be started with the start() method.
+*			Each command set declares the entities it works on, and waits for the previously added
+*			command sets working on one of these entities. A command set declaring no entity acts as
+*			a barrier: it waits for all previously added command sets and all following ones wait for it.
+*			Command sets are started as soon as all the command sets they depend on completed, in the
+*			order they became ready, and at most setMaxRunningCommandSets() at the same time.
+*			Once all command sets were executed the completed signal is invoked.
+*/
+class AsyncCommandGraphExecuter : public QObject
+{
+	Q_OBJECT
+public:
+	using NodeIndex = size_t;
+	using Resources = std::set<la::avdecc::UniqueIdentifier>;
+
+	AsyncCommandGraphExecuter(QObject* parent = nullptr) noexcept;
+	~AsyncCommandGraphExecuter();
+
+	NodeIndex addCommandSet(AsyncParallelCommandSet* const commandSet, Resources const& resources = {}) noexcept;
+	void clear() noexcept;
+
+	/** Sets the maximum count of command sets running at the same time (0 means unbounded, the default) */
+	void setMaxRunningCommandSets(size_t const maxRunningCommandSets) noexcept;
+
+	void start() noexcept;
+
+	// Signals
+	Q_SIGNAL void progressUpdate(uint32_t const completedCommands, uint32_t const totalCommands);
+	Q_SIGNAL void completed(CommandExecutionErrors const errors);
+
+private:
+	struct Node
+	{
+		AsyncParallelCommandSet* commandSet{ nullptr };
+		std::vector<NodeIndex> dependents{};
+		size_t remainingDependencies{ 0u };
+	};
+
+	void addDependency(NodeIndex const dependency, NodeIndex const dependent) noexcept;
+	void dispatchReadyNodes() noexcept;
+	void onNodeCompleted(NodeIndex const nodeIndex, CommandExecutionErrors const& errors) noexcept;
+
+	CommandExecutionErrors _errors;
+	std::vector<Node> _nodes;
+	std::unordered_map<la::avdecc::UniqueIdentifier, NodeIndex, la::avdecc::UniqueIdentifier::hash> _lastNodePerResource; // Last added node working on each entity, since the last barrier
+	std::vector<NodeIndex> _nodesSinceLastBarrier;
+	std::optional<NodeIndex> _lastBarrier{ std::nullopt };
+	std::list<NodeIndex> _readyNodes;
+	bool _isDispatching{ false }; // Command sets may complete synchronously while being started
+	size_t _runningNodeCount{ 0u };
+	size_t _maxRunningNodes{ 0u };
+	size_t _completedNodeCount{ 0u };
+	uint32_t _totalCommandCount{ 0 }; // includes parallel sub commands
+	uint32_t _completedCommandCount{ 0 }; // includes parallel sub commands
+};
+
 // **************************************************************
 // class SequentialAsyncCommandExecuter
 // **************************************************************
@@ -111,31 +226,17 @@ private:
 *			Once all commands were executed the completed signal is invoked.
 *			The error parameter is true if at least one of the commands in the chain failed to be executed.
 *
-*			!!! This solution will be replaced by a more general and extensive state machine implementation in the future. !!!
+*			This is an AsyncCommandGraphExecuter where each command set is a barrier.
 * [@author  Marius Erlen]
 * [@date    2018-11-22]
 */
-class SequentialAsyncCommandExecuter : public QObject
+class SequentialAsyncCommandExecuter : public AsyncCommandGraphExecuter
 {
 	Q_OBJECT
 public:
 	SequentialAsyncCommandExecuter(QObject* parent = nullptr) noexcept;
-	~SequentialAsyncCommandExecuter();
 
 	void setCommandChain(std::vector<AsyncParallelCommandSet*> const& commands) noexcept;
-
-	void start() noexcept;
-
-	// Signals
-	Q_SIGNAL void progressUpdate(uint32_t const completedCommands, uint32_t const totalCommands);
-	Q_SIGNAL void completed(CommandExecutionErrors const errors);
-
-private:
-	CommandExecutionErrors _errors;
-	std::vector<AsyncParallelCommandSet*> _commands;
-	uint32_t _currentCommandSet{ 0 };
-	uint32_t _totalCommandCount{ 0 }; // includes parallel sub commands
-	uint32_t _completedCommandCount{ 0 }; // includes parallel sub commands
 };
 
 } // namespace commandChain
@@ -0,0 +1,438 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "connectionAudit.hpp"
+#include "controllerManager.hpp"
+#include "helper.hpp"
+#include "hiveLogItems.hpp"
+#include "idleScheduler.hpp"
+
+#include <QTimer>
+
+#include <chrono>
+#include <map>
+#include <set>
+#include <utility>
+
+namespace avdecc
+{
+// **************************************************************
+// class ConnectionAuditorImpl
+// **************************************************************
+class ConnectionAuditorImpl final : public ConnectionAuditor
+{
+public:
+	ConnectionAuditorImpl() noexcept
+	{
+		_settleTimer.setSingleShot(true);
+		_settleTimer.setInterval(SettleDelay);
+		connect(&_settleTimer, &QTimer::timeout, this, &ConnectionAuditorImpl::scheduleAudit);
+
+		auto& manager = ControllerManager::getInstance();
+		connect(&manager, &ControllerManager::controllerOffline, this, &ConnectionAuditorImpl::handleControllerOffline);
+		connect(&manager, &ControllerManager::entityOnline, this, &ConnectionAuditorImpl::handleEntityOnline);
+		connect(&manager, &ControllerManager::entityOffline, this, &ConnectionAuditorImpl::handleEntityOffline);
+		connect(&manager, &ControllerManager::streamConnectionChanged, this, &ConnectionAuditorImpl::handleStreamConnectionChanged);
+		connect(&manager, &ControllerManager::streamConnectionsChanged, this, &ConnectionAuditorImpl::handleStreamConnectionsChanged);
+	}
+
+	// Deleted compiler auto-generated methods
+	ConnectionAuditorImpl(ConnectionAuditorImpl const&) = delete;
+	ConnectionAuditorImpl(ConnectionAuditorImpl&&) = delete;
+	ConnectionAuditorImpl& operator=(ConnectionAuditorImpl const&) = delete;
+	ConnectionAuditorImpl& operator=(ConnectionAuditorImpl&&) = delete;
+
+private:
+	using StreamIdentification = la::avdecc::entity::model::StreamIdentification;
+	using ListenerFindings = std::map<StreamIdentification, FindingType>;
+
+	static constexpr auto SettleDelay = std::chrono::milliseconds{ 2000 }; // Connections are transiently inconsistent while a command is in progress
+	static constexpr auto TalkerStreamsPerStep = size_t{ 32u };
+
+	// ConnectionAuditor overrides
+	virtual Findings getFindings() const noexcept override
+	{
+		auto findings = Findings{};
+		for (auto const& [talkerStream, listenerFindings] : _findings)
+		{
+			for (auto const& [listenerStream, type] : listenerFindings)
+			{
+				findings.push_back(Finding{ type, talkerStream, listenerStream });
+			}
+		}
+		return findings;
+	}
+
+	virtual std::optional<Finding> getFinding(StreamIdentification const& talkerStream, StreamIdentification const& listenerStream) const noexcept override
+	{
+		auto const talkerIt = _findings.find(talkerStream);
+		if (talkerIt != _findings.end())
+		{
+			auto const listenerIt = talkerIt->second.find(listenerStream);
+			if (listenerIt != talkerIt->second.end())
+			{
+				return Finding{ listenerIt->second, talkerStream, listenerStream };
+			}
+		}
+		return std::nullopt;
+	}
+
+	virtual void repair(Findings const& findings, QObject* const context, RepairHandler const& handler) noexcept override
+	{
+		// ACMP commands are addressed to the listener, which bounds the count of commands in flight
+		auto commandsPerListener = std::map<la::avdecc::UniqueIdentifier, std::vector<commandChain::AsyncParallelCommandSet::AsyncCommand>>{};
+		for (auto const& finding : findings)
+		{
+			commandsPerListener[finding.listenerStream.entityID].push_back(
+				[finding](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+				{
+					// A listener not in the talker list connects again, so the talker adds it. A ghost connection is removed from the talker only
+					auto const commandType = finding.type == FindingType::ListenerNotInTalkerList ? ControllerManager::AcmpCommandType::ConnectStream : ControllerManager::AcmpCommandType::DisconnectTalkerStream;
+					auto const responseHandler = [parentCommandSet, commandIndex, commandType](la::avdecc::UniqueIdentifier const /*talkerEntityID*/, la::avdecc::entity::model::StreamIndex const /*talkerStreamIndex*/, la::avdecc::UniqueIdentifier const listenerEntityID, la::avdecc::entity::model::StreamIndex const /*listenerStreamIndex*/, la::avdecc::entity::ControllerEntity::ControlStatus const status)
+					{
+						auto const error = commandChain::AsyncParallelCommandSet::controlStatusToCommandError(status);
+						parentCommandSet->completeCommand(commandIndex, listenerEntityID, error, commandType);
+					};
+
+					auto& manager = ControllerManager::getInstance();
+					if (commandType == ControllerManager::AcmpCommandType::ConnectStream)
+					{
+						manager.connectStream(finding.talkerStream.entityID, finding.talkerStream.streamIndex, finding.listenerStream.entityID, finding.listenerStream.streamIndex, responseHandler);
+					}
+					else
+					{
+						manager.disconnectTalkerStream(finding.talkerStream.entityID, finding.talkerStream.streamIndex, finding.listenerStream.entityID, finding.listenerStream.streamIndex, responseHandler);
+					}
+					return true;
+				});
+		}
+
+		auto* const executer = new commandChain::AsyncCommandGraphExecuter{ context };
+		executer->setMaxRunningCommandSets(16u);
+		for (auto const& [listenerID, commands] : commandsPerListener)
+		{
+			auto* const commandSet = new commandChain::AsyncParallelCommandSet;
+			commandSet->append(listenerID, commands);
+			executer->addCommandSet(commandSet, commandChain::AsyncCommandGraphExecuter::Resources{ listenerID });
+		}
+
+		auto talkerStreams = std::set<StreamIdentification>{};
+		for (auto const& finding : findings)
+		{
+			talkerStreams.insert(finding.talkerStream);
+		}
+
+		QObject::connect(executer, &commandChain::AsyncCommandGraphExecuter::completed, context,
+			[this, executer, handler, talkerStreams = std::move(talkerStreams)](commandChain::CommandExecutionErrors const errors)
+			{
+				// Whatever the outcome, what the entities now report is audited again
+				for (auto const& talkerStream : talkerStreams)
+				{
+					markDirty(talkerStream);
+				}
+				if (handler)
+				{
+					handler(errors);
+				}
+				executer->deleteLater();
+			});
+		executer->start();
+	}
+
+	// Private methods
+	void markDirty(StreamIdentification const& talkerStream) noexcept
+	{
+		_dirtyTalkerStreams.insert(talkerStream);
+		_settleTimer.start();
+	}
+
+	void scheduleAudit() noexcept
+	{
+		IdleScheduler::getInstance().scheduleStep("Connection audit",
+			[this]()
+			{
+				auto changed = false;
+				for (auto count = size_t{ 0u }; count < TalkerStreamsPerStep && !_dirtyTalkerStreams.empty(); ++count)
+				{
+					auto const talkerStream = *_dirtyTalkerStreams.begin();
+					_dirtyTalkerStreams.erase(_dirtyTalkerStreams.begin());
+					changed |= auditTalkerStream(talkerStream);
+				}
+				if (changed)
+				{
+					emit findingsChanged();
+				}
+				return _dirtyTalkerStreams.empty();
+			});
+	}
+
+	/** Computes the findings of a talker stream again, returns true if they changed */
+	bool auditTalkerStream(StreamIdentification const& talkerStream) noexcept
+	{
+		auto listenerFindings = ListenerFindings{};
+
+		// Talkers which never reported their connection list cannot be audited
+		auto const listedIt = _talkerConnections.find(talkerStream);
+		if (listedIt != _talkerConnections.end() && _onlineEntities.count(talkerStream.entityID) != 0)
+		{
+			auto const& listedListeners = listedIt->second;
+
+			auto const claimedIt = _claimedListeners.find(talkerStream);
+			if (claimedIt != _claimedListeners.end())
+			{
+				for (auto const& listenerStream : claimedIt->second)
+				{
+					if (listedListeners.count(listenerStream) == 0)
+					{
+						listenerFindings[listenerStream] = FindingType::ListenerNotInTalkerList;
+					}
+				}
+			}
+
+			for (auto const& listenerStream : listedListeners)
+			{
+				// Only listeners which state is known can contradict the talker
+				auto const stateIt = _listenerStates.find(listenerStream);
+				if (stateIt != _listenerStates.end() && !helper::isConnectedToTalker(talkerStream, stateIt->second) && !helper::isFastConnectingToTalker(talkerStream, stateIt->second))
+				{
+					listenerFindings[listenerStream] = FindingType::TalkerListsDisconnectedListener;
+				}
+			}
+		}
+
+		auto const previousIt = _findings.find(talkerStream);
+		auto const& previousFindings = previousIt != _findings.end() ? previousIt->second : ListenerFindings{};
+		if (listenerFindings == previousFindings)
+		{
+			return false;
+		}
+
+		for (auto const& [listenerStream, type] : listenerFindings)
+		{
+			if (previousFindings.count(listenerStream) == 0)
+			{
+				LOG_HIVE_WARN(QString("Connection audit: %1 (talker %2:%3, listener %4:%5)").arg(findingTypeToString(type)).arg(helper::uniqueIdentifierToString(talkerStream.entityID)).arg(talkerStream.streamIndex).arg(helper::uniqueIdentifierToString(listenerStream.entityID)).arg(listenerStream.streamIndex));
+			}
+		}
+
+		if (listenerFindings.empty())
+		{
+			_findings.erase(previousIt);
+		}
+		else
+		{
+			_findings[talkerStream] = std::move(listenerFindings);
+		}
+		return true;
+	}
+
+	void setListenerState(la::avdecc::entity::model::StreamConnectionState const& state) noexcept
+	{
+		auto const& listenerStream = state.listenerStream;
+
+		// Remove the previous claim
+		auto const previousIt = _listenerStates.find(listenerStream);
+		auto const wasKnown = previousIt != _listenerStates.end();
+		if (wasKnown && previousIt->second.state == la::avdecc::entity::model::StreamConnectionState::State::Connected)
+		{
+			auto const& previousTalkerStream = previousIt->second.talkerStream;
+			auto const claimedIt = _claimedListeners.find(previousTalkerStream);
+			if (claimedIt != _claimedListeners.end())
+			{
+				claimedIt->second.erase(listenerStream);
+				if (claimedIt->second.empty())
+				{
+					_claimedListeners.erase(claimedIt);
+				}
+			}
+			markDirty(previousTalkerStream);
+		}
+
+		_listenerStates[listenerStream] = state;
+		if (state.state == la::avdecc::entity::model::StreamConnectionState::State::Connected)
+		{
+			_claimedListeners[state.talkerStream].insert(listenerStream);
+			markDirty(state.talkerStream);
+		}
+
+		// A listener which state was unknown may be listed by any talker (otherwise only the talkers it claimed before and now can change)
+		if (!wasKnown)
+		{
+			for (auto const& [talkerStream, listedListeners] : _talkerConnections)
+			{
+				if (listedListeners.count(listenerStream) != 0)
+				{
+					markDirty(talkerStream);
+				}
+			}
+		}
+	}
+
+	// Slots
+	void handleControllerOffline() noexcept
+	{
+		_settleTimer.stop();
+		_onlineEntities.clear();
+		_talkerConnections.clear();
+		_listenerStates.clear();
+		_claimedListeners.clear();
+		_dirtyTalkerStreams.clear();
+
+		if (!_findings.empty())
+		{
+			_findings.clear();
+			emit findingsChanged();
+		}
+	}
+
+	void handleEntityOnline(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		auto controlledEntity = ControllerManager::getInstance().getControlledEntity(entityID);
+		if (!controlledEntity || !controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+		{
+			return;
+		}
+
+		_onlineEntities.insert(entityID);
+
+		try
+		{
+			auto const& configurationNode = controlledEntity->getCurrentConfigurationNode();
+
+			// Only known if the entity supports GET_TX_CONNECTION, updates come through streamConnectionsChanged
+			for (auto const& [streamIndex, streamOutputNode] : configurationNode.streamOutputs)
+			{
+				if (streamOutputNode.dynamicModel)
+				{
+					auto const talkerStream = StreamIdentification{ entityID, streamIndex };
+					_talkerConnections[talkerStream] = streamOutputNode.dynamicModel->connections;
+					markDirty(talkerStream);
+				}
+			}
+
+			for (auto const& [streamIndex, streamInputNode] : configurationNode.streamInputs)
+			{
+				if (streamInputNode.dynamicModel)
+				{
+					setListenerState(streamInputNode.dynamicModel->connectionState);
+				}
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+	}
+
+	void handleEntityOffline(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		_onlineEntities.erase(entityID);
+
+		// Its talker streams are no longer audited
+		for (auto it = _talkerConnections.begin(); it != _talkerConnections.end();)
+		{
+			if (it->first.entityID == entityID)
+			{
+				markDirty(it->first);
+				it = _talkerConnections.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		// Its listener streams no longer claim nor contradict anything
+		for (auto it = _listenerStates.begin(); it != _listenerStates.end();)
+		{
+			if (it->first.entityID == entityID)
+			{
+				auto state = it->second;
+				state.state = la::avdecc::entity::model::StreamConnectionState::State::NotConnected;
+				setListenerState(state);
+				it = _listenerStates.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		// Including the ghost connections found on them
+		for (auto const& [talkerStream, listenerFindings] : _findings)
+		{
+			for (auto const& listenerFindingKV : listenerFindings)
+			{
+				if (listenerFindingKV.first.entityID == entityID)
+				{
+					markDirty(talkerStream);
+					break;
+				}
+			}
+		}
+	}
+
+	void handleStreamConnectionChanged(la::avdecc::entity::model::StreamConnectionState const& state) noexcept
+	{
+		if (_onlineEntities.count(state.listenerStream.entityID) != 0)
+		{
+			setListenerState(state);
+		}
+	}
+
+	void handleStreamConnectionsChanged(StreamIdentification const& stream, la::avdecc::entity::model::StreamConnections const& connections) noexcept
+	{
+		if (_onlineEntities.count(stream.entityID) != 0)
+		{
+			_talkerConnections[stream] = connections;
+			markDirty(stream);
+		}
+	}
+
+	// Private members
+	QTimer _settleTimer{};
+	std::set<la::avdecc::UniqueIdentifier> _onlineEntities{};
+	std::map<StreamIdentification, la::avdecc::entity::model::StreamConnections> _talkerConnections{}; // Listener streams listed by each talker stream
+	std::map<StreamIdentification, la::avdecc::entity::model::StreamConnectionState> _listenerStates{}; // Connection state of each listener stream
+	std::map<StreamIdentification, std::set<StreamIdentification>> _claimedListeners{}; // Listener streams claiming to be connected to each talker stream
+	std::map<StreamIdentification, ListenerFindings> _findings{};
+	std::set<StreamIdentification> _dirtyTalkerStreams{};
+};
+
+QString ConnectionAuditor::findingTypeToString(FindingType const type) noexcept
+{
+	switch (type)
+	{
+		case FindingType::ListenerNotInTalkerList:
+			return "Listener connected but not listed by the talker";
+		case FindingType::TalkerListsDisconnectedListener:
+			return "Talker lists a listener which is not connected";
+		default:
+			AVDECC_ASSERT(false, "Not handled!");
+			return {};
+	}
+}
+
+ConnectionAuditor& ConnectionAuditor::getInstance() noexcept
+{
+	static ConnectionAuditorImpl s_auditor{};
+
+	return s_auditor;
+}
+
+} // namespace avdecc
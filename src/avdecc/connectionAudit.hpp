@@ -0,0 +1,78 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "avdecc/commandChain.hpp"
+
+#include <la/avdecc/internals/entityModelTypes.hpp>
+#include <QObject>
+
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace avdecc
+{
+/**
+* @brief Background audit of the ACMP connections: cross-checks the connection list of each talker stream (streamConnectionsChanged) against the connection state of the listener streams (streamConnectionChanged).
+*		 The auditor keeps a reverse index of the listener streams claiming to be connected to each talker stream. Only the talker streams whose list or claiming listeners changed are verified again,
+*		 once the changes settled, in idle time. Talker streams whose connection list was never received, and listeners which are offline, are not audited (Qt Main Thread only).
+*/
+class ConnectionAuditor : public QObject
+{
+	Q_OBJECT
+public:
+	enum class FindingType
+	{
+		ListenerNotInTalkerList, /**< The listener is connected to the talker stream, which doesn't list it (mismatch connection) */
+		TalkerListsDisconnectedListener, /**< The talker stream lists the listener, which is not connected to it (ghost connection) */
+	};
+
+	struct Finding
+	{
+		FindingType type{ FindingType::ListenerNotInTalkerList };
+		la::avdecc::entity::model::StreamIdentification talkerStream{};
+		la::avdecc::entity::model::StreamIdentification listenerStream{};
+	};
+	using Findings = std::vector<Finding>;
+
+	using RepairHandler = std::function<void(commandChain::CommandExecutionErrors const& errors)>;
+
+	static ConnectionAuditor& getInstance() noexcept;
+
+	/** Current findings, sorted by talker stream */
+	virtual Findings getFindings() const noexcept = 0;
+	virtual std::optional<Finding> getFinding(la::avdecc::entity::model::StreamIdentification const& talkerStream, la::avdecc::entity::model::StreamIdentification const& listenerStream) const noexcept = 0;
+
+	/**
+	* @brief Repairs the findings as one batch: the listener not in the talker list is connected again (so the talker adds it), the ghost connection is removed from the talker.
+	* @details The handler is called once all the commands completed, in the thread of the context object. Repaired talker streams are audited again.
+	*/
+	virtual void repair(Findings const& findings, QObject* const context, RepairHandler const& handler) noexcept = 0;
+
+	static QString findingTypeToString(FindingType const type) noexcept;
+
+	Q_SIGNAL void findingsChanged();
+
+protected:
+	ConnectionAuditor() = default;
+};
+
+} // namespace avdecc
@@ -19,12 +19,37 @@
 
 #include "controllerManager.hpp"
 #include "avdecc/helper.hpp"
+#include "avdecc/observerTrace.hpp"
+#include "avdecc/spanTrace.hpp"
+#include "avdecc/namePool.hpp"
+#include "avdecc/memoryAccounting.hpp"
 #include "settingsManager/settings.hpp"
 
 #include <la/avdecc/logger.hpp>
+#include <la/avdecc/internals/protocolAaAecpdu.hpp>
 
+#include <QTimer>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QFileInfo>
+
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+#include <functional>
 
 #if __cpp_lib_experimental_atomic_smart_pointers
 #	define HAVE_ATOMIC_SMART_POINTERS
@@ -32,55 +57,68 @@
 
 namespace avdecc
 {
+static constexpr auto EventBusFramePeriod = std::chrono::milliseconds{ 33 }; // Maximum rate at which the avdecc events are delivered to the Qt Main Thread (~30 Hz)
+static constexpr auto BackgroundEventBusPeriod = std::chrono::seconds{ 5 }; // Rate at which the high rate events of the entities without interest are delivered (visibility-driven notifications)
+
+static constexpr auto ObserverTraceReplayAbortCheckDelay = std::chrono::milliseconds{ 100 }; // Maximum time to notice a replay abort while waiting for the next event
+static constexpr auto SoftReloadGracePeriod = std::chrono::seconds{ 10 }; // Minimum time for the entities to come back after a soft reload, before they are actually removed
+static constexpr auto VirtualEntityLoaderMaxThreadCount = 4; // Parsing is CPU bound, but the controller serializes the final injection of the entities
+
+/** Runs a function on a QThreadPool */
+class PoolTask final : public QRunnable
+{
+public:
+	using Work = std::function<void()>;
+
+	PoolTask(Work&& work) noexcept
+		: _work{ std::move(work) }
+	{
+	}
+
+	virtual void run() override
+	{
+		_work();
+	}
+
+private:
+	Work _work{};
+};
+
 class ControllerManagerImpl final : public ControllerManager, private la::avdecc::controller::Controller::Observer, public settings::SettingsManager::Observer
 {
 public:
 	using SharedController = std::shared_ptr<la::avdecc::controller::Controller>;
 	using SharedConstController = std::shared_ptr<la::avdecc::controller::Controller const>;
+	using StreamStates = std::unordered_map<la::avdecc::UniqueIdentifier, std::unordered_map<la::avdecc::entity::model::StreamIndex, bool>, la::avdecc::UniqueIdentifier::hash>;
 
+	/**
+	* @brief Error state of the counters of an entity, compared to their value when the entity came online (or was last cleared).
+	*		 Created cheaply when the entity comes online: the values are read directly from the entity and stored in fixed arrays indexed by flag bit.
+	*		 The counters histories (the largest part) are only created when a first sample is added or queried, seeded with the online values.
+	*/
 	class ErrorCounterTracker
 	{
-		class InitCounterVisitor : public la::avdecc::controller::model::EntityModelVisitor
-		{
-		public:
-			InitCounterVisitor(ErrorCounterTracker& errorCounterTracker)
-				: _errorCounterTracker{ errorCounterTracker }
-			{
-			}
+		static constexpr std::size_t StreamInputFlagsCount = StreamInputErrorCounters::FlagsCount;
+		static constexpr std::size_t StatisticsFlagsCount = 3u;
 
-		protected:
-			// la::avdecc::controller::model::EntityModelVisitor overrides
-			virtual void visit(la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::controller::model::EntityNode const& /*node*/) noexcept override
-			{
-				// Initialize internal counter value, always setting lastClearCount to 0 (Statistics counters always start at 0 in the Controller, contrary to endpoint Counters) so that we directly see any error during enumeration
-				{
-					auto const counter = entity->getAecpRetryCounter();
-					_errorCounterTracker._statisticsCounters[StatisticsErrorCounterFlag::AecpRetries] = StatisticsCounterInfo{ counter, 0u };
-				}
-				{
-					auto const counter = entity->getAecpTimeoutCounter();
-					_errorCounterTracker._statisticsCounters[StatisticsErrorCounterFlag::AecpTimeouts] = StatisticsCounterInfo{ counter, 0u };
-				}
-				{
-					auto const counter = entity->getAecpUnexpectedResponseCounter();
-					_errorCounterTracker._statisticsCounters[StatisticsErrorCounterFlag::AecpUnexpectedResponses] = StatisticsCounterInfo{ counter, 0u };
-				}
-			}
-			virtual void visit(la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::controller::model::ConfigurationNode const* const /*parent*/, la::avdecc::controller::model::StreamInputNode const& node) noexcept override
+		template<typename Flag>
+		static constexpr std::size_t flagIndex(Flag const flag) noexcept
+		{
+			auto value = static_cast<std::uint32_t>(la::avdecc::utils::to_integral(flag));
+			auto index = std::size_t{ 0u };
+			while (value > 1u)
 			{
-				if (node.dynamicModel->counters)
-				{
-					for (auto const [flag, counter] : *node.dynamicModel->counters)
-					{
-						// Initialize internal counter value
-						_errorCounterTracker._streamInputCounters[node.descriptorIndex][flag] = ErrorCounterInfo{ counter, counter };
-					}
-				}
+				value >>= 1;
+				++index;
 			}
+			return index;
+		}
 
-		private:
-			ErrorCounterTracker& _errorCounterTracker;
-		};
+		template<typename Flag>
+		static constexpr Flag flagFromIndex(std::size_t const index) noexcept
+		{
+			return static_cast<Flag>(std::uint32_t{ 1u } << index);
+		}
 
 		class ClearCounterVisitor : public la::avdecc::controller::model::EntityModelVisitor
 		{
@@ -95,26 +133,20 @@ public:
 			// la::avdecc::controller::model::EntityModelVisitor overrides
 			virtual void visit(la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::controller::model::EntityNode const& /*node*/) noexcept override
 			{
+				for (auto& counterInfo : _errorCounterTracker._statisticsCounters)
 				{
-					auto& counterInfo = _errorCounterTracker._statisticsCounters[StatisticsErrorCounterFlag::AecpRetries];
-					counterInfo.lastClearCount = counterInfo.currentCount;
-				}
-				{
-					auto& counterInfo = _errorCounterTracker._statisticsCounters[StatisticsErrorCounterFlag::AecpTimeouts];
-					counterInfo.lastClearCount = counterInfo.currentCount;
-				}
-				{
-					auto& counterInfo = _errorCounterTracker._statisticsCounters[StatisticsErrorCounterFlag::AecpUnexpectedResponses];
 					counterInfo.lastClearCount = counterInfo.currentCount;
 				}
 				emit _manager.statisticsErrorCounterChanged(entity->getEntity().getEntityID(), {});
 			}
 			virtual void visit(la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::controller::model::ConfigurationNode const* const /*parent*/, la::avdecc::controller::model::StreamInputNode const& node) noexcept override
 			{
-				for (auto& counterInfoKV : _errorCounterTracker._streamInputCounters[node.descriptorIndex])
+				if (auto* const streamCounters = _errorCounterTracker.findStreamInputCounters(node.descriptorIndex))
 				{
-					auto& counterInfo = counterInfoKV.second;
-					counterInfo.lastClearCount = counterInfo.currentCount;
+					for (auto& counterInfo : streamCounters->counters)
+					{
+						counterInfo.lastClearCount = counterInfo.currentCount;
+					}
 				}
 				emit _manager.streamInputErrorCounterChanged(entity->getEntity().getEntityID(), node.descriptorIndex, {});
 			}
@@ -133,10 +165,38 @@ public:
 		ErrorCounterTracker(la::avdecc::UniqueIdentifier const& entityID)
 			: _entityID{ entityID }
 		{
-			InitCounterVisitor visitor{ *this };
 			if (auto entity = ControllerManager::getInstance().getControlledEntity(_entityID))
 			{
-				entity->accept(&visitor, false);
+				// Initialize internal counter value, always setting lastClearCount to 0 (Statistics counters always start at 0 in the Controller, contrary to endpoint Counters) so that we directly see any error during enumeration
+				_initialStatisticsCounts[flagIndex(StatisticsErrorCounterFlag::AecpRetries)] = entity->getAecpRetryCounter();
+				_initialStatisticsCounts[flagIndex(StatisticsErrorCounterFlag::AecpTimeouts)] = entity->getAecpTimeoutCounter();
+				_initialStatisticsCounts[flagIndex(StatisticsErrorCounterFlag::AecpUnexpectedResponses)] = entity->getAecpUnexpectedResponseCounter();
+				for (auto index = std::size_t{ 0u }; index < StatisticsFlagsCount; ++index)
+				{
+					_statisticsCounters[index] = StatisticsCounterInfo{ _initialStatisticsCounts[index], 0u };
+				}
+
+				// The StreamInput baseline cannot be deferred: once a counters event is received, the model already contains the new values
+				try
+				{
+					for (auto const& [streamIndex, streamNode] : entity->getCurrentConfigurationNode().streamInputs)
+					{
+						if (streamNode.dynamicModel->counters)
+						{
+							auto& streamCounters = streamInputCounters(streamIndex);
+							for (auto const [flag, counter] : *streamNode.dynamicModel->counters)
+							{
+								auto const index = flagIndex(flag);
+								streamCounters.counters[index] = ErrorCounterInfo{ counter, counter };
+								streamCounters.initialCounts[index] = counter;
+								streamCounters.initialFlags |= std::uint32_t{ 1u } << index;
+							}
+						}
+					}
+				}
+				catch (...)
+				{
+				}
 			}
 		}
 
@@ -147,14 +207,14 @@ public:
 		{
 			auto counters = StreamInputErrorCounters{};
 
-			auto const streamIt = _streamInputCounters.find(streamIndex);
-			if (streamIt != std::end(_streamInputCounters))
+			if (auto const* const streamCounters = findStreamInputCounters(streamIndex))
 			{
-				for (auto const& [flag, errorCounter] : streamIt->second)
+				for (auto index = std::size_t{ 0u }; index < StreamInputFlagsCount; ++index)
 				{
+					auto const& errorCounter = streamCounters->counters[index];
 					if (errorCounter.currentCount != errorCounter.lastClearCount)
 					{
-						counters[flag] = errorCounter.currentCount - errorCounter.lastClearCount;
+						counters.setErrorCount(index, errorCounter.currentCount - errorCounter.lastClearCount);
 					}
 				}
 			}
@@ -165,8 +225,7 @@ public:
 		// Set the new counter value, returns true if the counter has changed, false otherwise
 		bool setStreamInputCounter(la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::StreamInputCounterValidFlag const flag, la::avdecc::entity::model::DescriptorCounter const counter)
 		{
-			// Get or create ErrorCounterInfo
-			auto& errorCounter = _streamInputCounters[streamIndex][flag];
+			auto& errorCounter = streamInputCounters(streamIndex).counters[flagIndex(flag)];
 
 			auto shouldNotify = false;
 
@@ -192,8 +251,12 @@ public:
 		// Clear the error for a given flag, returns true if the flag has changed, false otherwise
 		bool clearStreamInputCounter(la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::StreamInputCounterValidFlag const flag)
 		{
-			AVDECC_ASSERT(_streamInputCounters[streamIndex].count(flag) != 0, "Should not be possible to clear an error flag that does not exist");
-			auto& errorCounter = _streamInputCounters[streamIndex][flag];
+			auto* const streamCounters = findStreamInputCounters(streamIndex);
+			if (!AVDECC_ASSERT_WITH_RET(streamCounters != nullptr, "Should not be possible to clear an error flag that does not exist"))
+			{
+				return false;
+			}
+			auto& errorCounter = streamCounters->counters[flagIndex(flag)];
 
 			if (errorCounter.lastClearCount != errorCounter.currentCount)
 			{
@@ -222,11 +285,12 @@ public:
 		{
 			auto counters = StatisticsErrorCounters{};
 
-			for (auto const& [flag, errorCounter] : _statisticsCounters)
+			for (auto index = std::size_t{ 0u }; index < StatisticsFlagsCount; ++index)
 			{
+				auto const& errorCounter = _statisticsCounters[index];
 				if (errorCounter.currentCount != errorCounter.lastClearCount)
 				{
-					counters[flag] = errorCounter.currentCount - errorCounter.lastClearCount;
+					counters[flagFromIndex<StatisticsErrorCounterFlag>(index)] = errorCounter.currentCount - errorCounter.lastClearCount;
 				}
 			}
 
@@ -236,8 +300,7 @@ public:
 		// Set the new counter value, returns true if the counter has changed, false otherwise
 		bool setStatisticsCounter(StatisticsErrorCounterFlag const flag, std::uint64_t const counter)
 		{
-			// Get or create StatisticsCounterInfo
-			auto& errorCounter = _statisticsCounters[flag];
+			auto& errorCounter = _statisticsCounters[flagIndex(flag)];
 
 			auto shouldNotify = false;
 
@@ -263,8 +326,7 @@ public:
 		// Clear the error for a given flag, returns true if the flag has changed, false otherwise
 		bool clearStatisticsCounter(StatisticsErrorCounterFlag const flag)
 		{
-			AVDECC_ASSERT(_statisticsCounters.count(flag) != 0, "Should not be possible to clear an error flag that does not exist");
-			auto& errorCounter = _statisticsCounters[flag];
+			auto& errorCounter = _statisticsCounters[flagIndex(flag)];
 
 			if (errorCounter.lastClearCount != errorCounter.currentCount)
 			{
@@ -286,6 +348,52 @@ public:
 			}
 		}
 
+		/* ************************************************************ */
+		/* Counters History                                             */
+		/* ************************************************************ */
+		StreamInputCountersHistory getStreamInputCountersHistory(la::avdecc::entity::model::StreamIndex const streamIndex) const
+		{
+			auto const streamIt = _streamInputHistories.find(streamIndex);
+			if (streamIt != std::end(_streamInputHistories))
+			{
+				return streamIt->second;
+			}
+			return makeInitialStreamInputHistory(streamIndex);
+		}
+
+		void addStreamInputCountersSample(la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamInputCounters const& counters, CounterHistory::Clock::time_point const& now)
+		{
+			auto historiesIt = _streamInputHistories.find(streamIndex);
+			if (historiesIt == std::end(_streamInputHistories))
+			{
+				historiesIt = _streamInputHistories.emplace(streamIndex, makeInitialStreamInputHistory(streamIndex)).first;
+			}
+
+			auto& histories = historiesIt->second;
+			for (auto const [flag, counter] : counters)
+			{
+				histories[flag].push(now, counter);
+			}
+		}
+
+		StatisticsCountersHistory getStatisticsCountersHistory() const
+		{
+			if (_statisticsHistories)
+			{
+				return *_statisticsHistories;
+			}
+			return makeInitialStatisticsHistory();
+		}
+
+		void addStatisticsCounterSample(StatisticsErrorCounterFlag const flag, std::uint64_t const counter, CounterHistory::Clock::time_point const& now)
+		{
+			if (!_statisticsHistories)
+			{
+				_statisticsHistories = makeInitialStatisticsHistory();
+			}
+			(*_statisticsHistories)[flag].push(now, counter);
+		}
+
 	private:
 		struct ErrorCounterInfo
 		{
@@ -297,1448 +405,4847 @@ public:
 			std::uint64_t currentCount{ 0u }; // Current Counter Value
 			std::uint64_t lastClearCount{ 0u }; // Value when last Cleared
 		};
+		struct StreamInputCounterInfos
+		{
+			std::array<ErrorCounterInfo, StreamInputFlagsCount> counters{}; // Indexed by flag bit
+			std::array<la::avdecc::entity::model::DescriptorCounter, StreamInputFlagsCount> initialCounts{}; // Values when the entity came online, seeding the history
+			std::uint32_t initialFlags{ 0u }; // Counters known when the entity came online
+		};
 
-		la::avdecc::UniqueIdentifier _entityID{ la::avdecc::UniqueIdentifier::getNullUniqueIdentifier() };
-		std::unordered_map<la::avdecc::entity::model::StreamIndex, std::unordered_map<la::avdecc::entity::StreamInputCounterValidFlag, ErrorCounterInfo>> _streamInputCounters{};
-		std::unordered_map<StatisticsErrorCounterFlag, StatisticsCounterInfo> _statisticsCounters{};
-	};
-
-	ControllerManagerImpl() noexcept
-	{
-		qRegisterMetaType<std::uint8_t>("std::uint8_t");
-		qRegisterMetaType<std::uint16_t>("std::uint16_t");
-		qRegisterMetaType<std::uint64_t>("std::uint64_t");
-		qRegisterMetaType<std::chrono::milliseconds>("std::chrono::milliseconds");
-		qRegisterMetaType<AecpCommandType>("avdecc::ControllerManager::AecpCommandType");
-		qRegisterMetaType<AcmpCommandType>("avdecc::ControllerManager::AcmpCommandType");
-		qRegisterMetaType<StreamInputErrorCounters>("avdecc::ControllerManager::StreamInputErrorCounters");
-		qRegisterMetaType<StatisticsErrorCounters>("avdecc::ControllerManager::StatisticsErrorCounters");
-		qRegisterMetaType<la::avdecc::UniqueIdentifier>("la::avdecc::UniqueIdentifier");
-		qRegisterMetaType<la::avdecc::entity::ControllerEntity::AemCommandStatus>("la::avdecc::entity::ControllerEntity::AemCommandStatus");
-		qRegisterMetaType<la::avdecc::entity::ControllerEntity::ControlStatus>("la::avdecc::entity::ControllerEntity::ControlStatus");
-		qRegisterMetaType<la::avdecc::entity::StreamInputCounterValidFlags>("la::avdecc::entity::StreamInputCounterValidFlags");
-		qRegisterMetaType<la::avdecc::entity::model::AvdeccFixedString>("la::avdecc::entity::model::AvdeccFixedString");
-		qRegisterMetaType<la::avdecc::entity::model::ConfigurationIndex>("la::avdecc::entity::model::ConfigurationIndex");
-		qRegisterMetaType<la::avdecc::entity::model::DescriptorType>("la::avdecc::entity::model::DescriptorType");
-		qRegisterMetaType<la::avdecc::entity::model::DescriptorIndex>("la::avdecc::entity::model::DescriptorIndex");
-		qRegisterMetaType<la::avdecc::entity::model::AudioUnitIndex>("la::avdecc::entity::model::AudioUnitIndex");
-		qRegisterMetaType<la::avdecc::entity::model::StreamIndex>("la::avdecc::entity::model::StreamIndex");
-		qRegisterMetaType<la::avdecc::entity::model::JackIndex>("la::avdecc::entity::model::JackIndex");
-		qRegisterMetaType<la::avdecc::entity::model::AvbInterfaceIndex>("la::avdecc::entity::model::AvbInterfaceIndex");
-		qRegisterMetaType<la::avdecc::entity::model::ClockSourceIndex>("la::avdecc::entity::model::ClockSourceIndex");
-		qRegisterMetaType<la::avdecc::entity::model::MemoryObjectIndex>("la::avdecc::entity::model::MemoryObjectIndex");
-		qRegisterMetaType<la::avdecc::entity::model::LocaleIndex>("la::avdecc::entity::model::LocaleIndex");
-		qRegisterMetaType<la::avdecc::entity::model::StringsIndex>("la::avdecc::entity::model::StringsIndex");
-		qRegisterMetaType<la::avdecc::entity::model::StreamPortIndex>("la::avdecc::entity::model::StreamPortIndex");
-		qRegisterMetaType<la::avdecc::entity::model::ExternalPortIndex>("la::avdecc::entity::model::ExternalPortIndex");
-		qRegisterMetaType<la::avdecc::entity::model::InternalPortIndex>("la::avdecc::entity::model::InternalPortIndex");
-		qRegisterMetaType<la::avdecc::entity::model::ClusterIndex>("la::avdecc::entity::model::ClusterIndex");
-		qRegisterMetaType<la::avdecc::entity::model::MapIndex>("la::avdecc::entity::model::MapIndex");
-		qRegisterMetaType<la::avdecc::entity::model::ControlIndex>("la::avdecc::entity::model::ControlIndex");
-		qRegisterMetaType<la::avdecc::entity::model::SignalSelectorIndex>("la::avdecc::entity::model::SignalSelectorIndex");
-		qRegisterMetaType<la::avdecc::entity::model::MixerIndex>("la::avdecc::entity::model::MixerIndex");
-		qRegisterMetaType<la::avdecc::entity::model::MatrixIndex>("la::avdecc::entity::model::MatrixIndex");
-		qRegisterMetaType<la::avdecc::entity::model::SignalSplitterIndex>("la::avdecc::entity::model::SignalSplitterIndex");
-		qRegisterMetaType<la::avdecc::entity::model::SignalCombinerIndex>("la::avdecc::entity::model::SignalCombinerIndex");
-		qRegisterMetaType<la::avdecc::entity::model::SignalDemultiplexerIndex>("la::avdecc::entity::model::SignalDemultiplexerIndex");
-		qRegisterMetaType<la::avdecc::entity::model::SignalMultiplexerIndex>("la::avdecc::entity::model::SignalMultiplexerIndex");
-		qRegisterMetaType<la::avdecc::entity::model::SignalTranscoderIndex>("la::avdecc::entity::model::SignalTranscoderIndex");
-		qRegisterMetaType<la::avdecc::entity::model::ClockDomainIndex>("la::avdecc::entity::model::ClockDomainIndex");
-		qRegisterMetaType<la::avdecc::entity::model::ControlBlockIndex>("la::avdecc::entity::model::ControlBlockIndex");
-		qRegisterMetaType<la::avdecc::entity::model::SamplingRate>("la::avdecc::entity::model::SamplingRate");
-		qRegisterMetaType<la::avdecc::entity::model::StreamFormat>("la::avdecc::entity::model::StreamFormat");
-		qRegisterMetaType<la::avdecc::entity::model::OperationID>("la::avdecc::entity::model::OperationID");
-		qRegisterMetaType<la::avdecc::entity::model::StreamDynamicInfo>("la::avdecc::entity::model::StreamDynamicInfo");
-		qRegisterMetaType<la::avdecc::entity::model::AvbInterfaceInfo>("la::avdecc::entity::model::AvbInterfaceInfo");
-		qRegisterMetaType<la::avdecc::entity::model::AsPath>("la::avdecc::entity::model::AsPath");
-		qRegisterMetaType<la::avdecc::entity::model::StreamIdentification>("la::avdecc::entity::model::StreamIdentification");
-		qRegisterMetaType<la::avdecc::entity::model::StreamConnectionState>("la::avdecc::entity::model::StreamConnectionState");
-		qRegisterMetaType<la::avdecc::entity::model::StreamConnections>("la::avdecc::entity::model::StreamConnections");
-		qRegisterMetaType<la::avdecc::entity::model::EntityCounters>("la::avdecc::entity::model::EntityCounters");
-		qRegisterMetaType<la::avdecc::entity::model::AvbInterfaceCounters>("la::avdecc::entity::model::AvbInterfaceCounters");
-		qRegisterMetaType<la::avdecc::entity::model::ClockDomainCounters>("la::avdecc::entity::model::ClockDomainCounters");
-		qRegisterMetaType<la::avdecc::entity::model::StreamInputCounters>("la::avdecc::entity::model::StreamInputCounters");
-		qRegisterMetaType<la::avdecc::entity::model::StreamOutputCounters>("la::avdecc::entity::model::StreamOutputCounters");
-		qRegisterMetaType<la::avdecc::controller::Controller::QueryCommandError>("la::avdecc::controller::Controller::QueryCommandError");
-		qRegisterMetaType<la::avdecc::controller::ControlledEntity::InterfaceLinkStatus>("la::avdecc::controller::ControlledEntity::InterfaceLinkStatus");
-		qRegisterMetaType<la::avdecc::controller::ControlledEntity::CompatibilityFlags>("la::avdecc::controller::ControlledEntity::CompatibilityFlags");
-		qRegisterMetaType<la::avdecc::controller::model::AcquireState>("la::avdecc::controller::model::AcquireState");
-		qRegisterMetaType<la::avdecc::controller::model::LockState>("la::avdecc::controller::model::LockState");
-
-		// Configure settings observers
-		auto& settings = settings::SettingsManager::getInstance();
-		settings.registerSettingObserver(settings::Controller_AemCacheEnabled.name, this);
-		settings.registerSettingObserver(settings::Controller_FullStaticModelEnabled.name, this);
-	}
+		StreamInputCounterInfos& streamInputCounters(la::avdecc::entity::model::StreamIndex const streamIndex)
+		{
+			if (streamIndex >= _streamInputCounters.size())
+			{
+				_streamInputCounters.resize(streamIndex + 1u);
+			}
+			return _streamInputCounters[streamIndex];
+		}
 
-	~ControllerManagerImpl() noexcept
-	{
-		// The controller should already have been destroyed by now, but just in case, clean it we don't want further notifications
-		if (!AVDECC_ASSERT_WITH_RET(!_controller, "Controller should have been destroyed before the singleton destructor is called"))
+		StreamInputCounterInfos* findStreamInputCounters(la::avdecc::entity::model::StreamIndex const streamIndex) noexcept
 		{
-			destroyController();
+			return streamIndex < _streamInputCounters.size() ? &_streamInputCounters[streamIndex] : nullptr;
 		}
 
-		// Remove settings observers
-		auto& settings = settings::SettingsManager::getInstance();
-		settings.unregisterSettingObserver(settings::Controller_AemCacheEnabled.name, this);
-		settings.unregisterSettingObserver(settings::Controller_FullStaticModelEnabled.name, this);
-	}
+		StreamInputCounterInfos const* findStreamInputCounters(la::avdecc::entity::model::StreamIndex const streamIndex) const noexcept
+		{
+			return streamIndex < _streamInputCounters.size() ? &_streamInputCounters[streamIndex] : nullptr;
+		}
 
-private:
-	// settings::SettingsManager::Observer overrides
-	virtual void onSettingChanged(settings::SettingsManager::Setting const& name, QVariant const& value) noexcept override
-	{
-		if (name == settings::Controller_AemCacheEnabled.name)
+		StreamInputCountersHistory makeInitialStreamInputHistory(la::avdecc::entity::model::StreamIndex const streamIndex) const
 		{
-			_enableAemCache = value.toBool();
+			auto histories = StreamInputCountersHistory{};
+			if (auto const* const streamCounters = findStreamInputCounters(streamIndex))
+			{
+				for (auto index = std::size_t{ 0u }; index < StreamInputFlagsCount; ++index)
+				{
+					if (streamCounters->initialFlags & (std::uint32_t{ 1u } << index))
+					{
+						histories[flagFromIndex<la::avdecc::entity::StreamInputCounterValidFlag>(index)].push(_createdAt, streamCounters->initialCounts[index]);
+					}
+				}
+			}
+			return histories;
 		}
-		else if (name == settings::Controller_FullStaticModelEnabled.name)
+
+		StatisticsCountersHistory makeInitialStatisticsHistory() const
 		{
-			_fullAemEnumeration = value.toBool();
+			auto histories = StatisticsCountersHistory{};
+			for (auto index = std::size_t{ 0u }; index < StatisticsFlagsCount; ++index)
+			{
+				histories[flagFromIndex<StatisticsErrorCounterFlag>(index)].push(_createdAt, _initialStatisticsCounts[index]);
+			}
+			return histories;
 		}
-	}
 
-	// la::avdecc::controller::Controller::Observer overrides
-	// Global controller notifications
-	virtual void onTransportError(la::avdecc::controller::Controller const* const /*controller*/) noexcept override
-	{
-		emit transportError();
-	}
-	virtual void onEntityQueryError(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::controller::Controller::QueryCommandError const error) noexcept override
-	{
-		emit entityQueryError(entity->getEntity().getEntityID(), error);
-	}
-	// Discovery notifications (ADP)
-	virtual void onEntityOnline(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity) noexcept override
+		la::avdecc::UniqueIdentifier _entityID{ la::avdecc::UniqueIdentifier::getNullUniqueIdentifier() };
+		CounterHistory::Clock::time_point _createdAt{ CounterHistory::Clock::now() };
+		std::vector<StreamInputCounterInfos> _streamInputCounters{}; // Indexed by StreamIndex
+		std::array<StatisticsCounterInfo, StatisticsFlagsCount> _statisticsCounters{}; // Indexed by flag bit
+		std::array<std::uint64_t, StatisticsFlagsCount> _initialStatisticsCounts{};
+		std::unordered_map<la::avdecc::entity::model::StreamIndex, StreamInputCountersHistory> _streamInputHistories{}; // Created on first use, bounded memory per stream: one CounterHistory per counter
+		std::optional<StatisticsCountersHistory> _statisticsHistories{}; // Created on first use
+	};
+
+	/** Identifies the value changed by a coalesced AECP command */
+	struct CoalescedAecpCommandKey
 	{
-		auto const entityID{ entity->getEntity().getEntityID() };
+		la::avdecc::UniqueIdentifier entityID{};
+		AecpCommandType commandType{ AecpCommandType::None };
+		la::avdecc::entity::model::DescriptorType descriptorType{ la::avdecc::entity::model::DescriptorType::Invalid };
+		la::avdecc::entity::model::ConfigurationIndex configurationIndex{ 0u };
+		la::avdecc::entity::model::DescriptorIndex descriptorIndex{ 0u };
 
+		bool operator==(CoalescedAecpCommandKey const& other) const noexcept
 		{
-			auto const lg = std::lock_guard{ _lock };
-			_entities.insert(entityID);
-			_entityErrorCounterTrackers[entityID] = ErrorCounterTracker{ entityID };
+			return entityID == other.entityID && commandType == other.commandType && descriptorType == other.descriptorType && configurationIndex == other.configurationIndex && descriptorIndex == other.descriptorIndex;
 		}
 
-		emit entityOnline(entityID, entity->getEnumerationTime());
-	}
-	virtual void onEntityOffline(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity) noexcept override
-	{
-		// We absolutely want Entity Removal to be processed in the main thread, so that _entities and _entityErrorCounterTrackers still contain this entity
-		QMetaObject::invokeMethod(this,
-			[this, entityID = entity->getEntity().getEntityID()]()
+		struct hash
+		{
+			std::size_t operator()(CoalescedAecpCommandKey const& key) const noexcept
 			{
-				ASSERT_QT_MAIN_THREAD;
-				{
-					auto const lg = std::lock_guard{ _lock };
-					_entities.erase(entityID);
-					_entityErrorCounterTrackers.erase(entityID);
-				}
-
-				emit entityOffline(entityID);
-			});
-	}
-	virtual void onEntityCapabilitiesChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const /*entity*/) noexcept override
-	{
-#pragma message("TODO: Add new signal and listen to it")
-	}
-	virtual void onEntityAssociationChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const /*entity*/) noexcept override
-	{
-#pragma message("TODO: Add new signal and listen to it")
-	}
-	virtual void onGptpChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::UniqueIdentifier const grandMasterID, std::uint8_t const grandMasterDomain) noexcept override
-	{
-		auto const& e = entity->getEntity();
-		emit gptpChanged(e.getEntityID(), avbInterfaceIndex, grandMasterID, grandMasterDomain);
-	}
-	// Global entity notifications
-	virtual void onUnsolicitedRegistrationChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, bool const /*isSubscribed*/) noexcept override
-	{
-#pragma message("TODO: Listen to the Qt signal somewhere and act accordingly")
-		emit unsolicitedRegistrationChanged(entity->getEntity().getEntityID());
-	}
-	virtual void onCompatibilityFlagsChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::controller::ControlledEntity::CompatibilityFlags const compatibilityFlags) noexcept override
-	{
-		emit compatibilityFlagsChanged(entity->getEntity().getEntityID(), compatibilityFlags);
-	}
-	virtual void onIdentificationStarted(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity) noexcept override
-	{
-		emit identificationStarted(entity->getEntity().getEntityID());
-	}
-	virtual void onIdentificationStopped(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity) noexcept override
-	{
-		emit identificationStopped(entity->getEntity().getEntityID());
-	}
-	// Connection notifications (sniffed ACMP)
-	virtual void onStreamConnectionChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::entity::model::StreamConnectionState const& state, bool const /*changedByOther*/) noexcept override
-	{
-		emit streamConnectionChanged(state);
-	}
-	virtual void onStreamConnectionsChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamConnections const& connections) noexcept override
+				auto const descriptor = (static_cast<std::uint64_t>(la::avdecc::utils::to_integral(key.commandType)) << 48) | (static_cast<std::uint64_t>(la::avdecc::utils::to_integral(key.descriptorType)) << 32) | (static_cast<std::uint64_t>(key.configurationIndex) << 16) | static_cast<std::uint64_t>(key.descriptorIndex);
+				return la::avdecc::UniqueIdentifier::hash{}(key.entityID) ^ (std::hash<std::uint64_t>{}(descriptor) << 1);
+			}
+		};
+	};
+	using CoalescedAecpCommandHandler = std::function<void(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status)>;
+	using CoalescedAecpCommandCompletionHandler = std::function<void()>;
+	using CoalescedAecpCommandSender = std::function<bool(CoalescedAecpCommandCompletionHandler const& completionHandler)>; // Sends the command (calling completionHandler once its result is processed), returns false if it could not be sent
+
+	/**
+	* @brief Lock-free handoff of the small notifications (fixed size arguments only) from the avdecc threads to the Qt Main Thread.
+	* @details Each notifying thread gets its own single-producer/single-consumer ring of tagged records, the Qt Main Thread being the only consumer.
+	*          A single queued call is posted per drain (by the first push after the previous drain started), the signals then being emitted from the Qt Main Thread.
+	*          A full ring never blocks the producer on the consumer: records are appended to an overflow list until the next drain, preserving their order.
+	*/
+	class ObserverHandoff
 	{
-		emit streamConnectionsChanged({ entity->getEntity().getEntityID(), streamIndex }, connections);
-	}
-	// Entity model notifications (unsolicited AECP or changes this controller sent)
-	virtual void onAcquireStateChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::controller::model::AcquireState const acquireState, la::avdecc::UniqueIdentifier const owningEntity) noexcept override
-	{
-		emit acquireStateChanged(entity->getEntity().getEntityID(), acquireState, owningEntity);
-	}
-	virtual void onLockStateChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::controller::model::LockState const lockState, la::avdecc::UniqueIdentifier const lockingEntity) noexcept override
-	{
-		emit lockStateChanged(entity->getEntity().getEntityID(), lockState, lockingEntity);
-	}
-	virtual void onStreamInputFormatChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat) noexcept override
-	{
-		emit streamFormatChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, streamFormat);
-	}
-	virtual void onStreamOutputFormatChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat) noexcept override
-	{
-		emit streamFormatChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, streamFormat);
-	}
-	virtual void onStreamInputDynamicInfoChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamDynamicInfo const& info) noexcept override
-	{
-		emit streamDynamicInfoChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, info);
-	}
-	virtual void onStreamOutputDynamicInfoChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamDynamicInfo const& info) noexcept override
-	{
-		emit streamDynamicInfoChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, info);
-	}
-	virtual void onEntityNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvdeccFixedString const& entityName) noexcept override
-	{
-		emit entityNameChanged(entity->getEntity().getEntityID(), QString::fromStdString(entityName));
-	}
-	virtual void onEntityGroupNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvdeccFixedString const& entityGroupName) noexcept override
-	{
-		emit entityGroupNameChanged(entity->getEntity().getEntityID(), QString::fromStdString(entityGroupName));
-	}
-	virtual void onConfigurationNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AvdeccFixedString const& configurationName) noexcept override
-	{
-		emit configurationNameChanged(entity->getEntity().getEntityID(), configurationIndex, QString::fromStdString(configurationName));
-	}
-	virtual void onAudioUnitNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, la::avdecc::entity::model::AvdeccFixedString const& audioUnitName) noexcept override
-	{
-		emit audioUnitNameChanged(entity->getEntity().getEntityID(), configurationIndex, audioUnitIndex, QString::fromStdString(audioUnitName));
-	}
-	virtual void onStreamInputNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::AvdeccFixedString const& streamName) noexcept override
-	{
-		emit streamNameChanged(entity->getEntity().getEntityID(), configurationIndex, la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, QString::fromStdString(streamName));
-	}
-	virtual void onStreamOutputNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::AvdeccFixedString const& streamName) noexcept override
-	{
-		emit streamNameChanged(entity->getEntity().getEntityID(), configurationIndex, la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, QString::fromStdString(streamName));
-	}
-	virtual void onAvbInterfaceNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AvdeccFixedString const& avbInterfaceName) noexcept override
-	{
-		emit avbInterfaceNameChanged(entity->getEntity().getEntityID(), configurationIndex, avbInterfaceIndex, QString::fromStdString(avbInterfaceName));
-	}
-	virtual void onClockSourceNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex, la::avdecc::entity::model::AvdeccFixedString const& clockSourceName) noexcept override
-	{
-		emit clockSourceNameChanged(entity->getEntity().getEntityID(), configurationIndex, clockSourceIndex, QString::fromStdString(clockSourceName));
-	}
-	virtual void onMemoryObjectNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, la::avdecc::entity::model::AvdeccFixedString const& memoryObjectName) noexcept override
-	{
-		emit memoryObjectNameChanged(entity->getEntity().getEntityID(), configurationIndex, memoryObjectIndex, QString::fromStdString(memoryObjectName));
-	}
-	virtual void onAudioClusterNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClusterIndex const audioClusterIndex, la::avdecc::entity::model::AvdeccFixedString const& audioClusterName) noexcept override
-	{
-		emit audioClusterNameChanged(entity->getEntity().getEntityID(), configurationIndex, audioClusterIndex, QString::fromStdString(audioClusterName));
-	}
-	virtual void onClockDomainNameChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::AvdeccFixedString const& clockDomainName) noexcept override
-	{
-		emit clockDomainNameChanged(entity->getEntity().getEntityID(), configurationIndex, clockDomainIndex, QString::fromStdString(clockDomainName));
-	}
-	virtual void onAudioUnitSamplingRateChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, la::avdecc::entity::model::SamplingRate const samplingRate) noexcept override
-	{
-		emit audioUnitSamplingRateChanged(entity->getEntity().getEntityID(), audioUnitIndex, samplingRate);
-	}
-	virtual void onClockSourceChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex) noexcept override
-	{
-		emit clockSourceChanged(entity->getEntity().getEntityID(), clockDomainIndex, clockSourceIndex);
-	}
-	virtual void onStreamInputStarted(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex) noexcept override
-	{
-		emit streamRunningChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, true);
-	}
-	virtual void onStreamOutputStarted(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex) noexcept override
-	{
-		emit streamRunningChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, true);
-	}
-	virtual void onStreamInputStopped(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex) noexcept override
-	{
-		emit streamRunningChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, false);
-	}
-	virtual void onStreamOutputStopped(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex) noexcept override
-	{
-		emit streamRunningChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, false);
-	}
-	virtual void onAvbInterfaceInfoChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AvbInterfaceInfo const& info) noexcept override
-	{
-		emit avbInterfaceInfoChanged(entity->getEntity().getEntityID(), avbInterfaceIndex, info);
-	}
-	virtual void onAsPathChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AsPath const& asPath) noexcept override
-	{
-		emit asPathChanged(entity->getEntity().getEntityID(), avbInterfaceIndex, asPath);
-	}
-	virtual void onAvbInterfaceLinkStatusChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::controller::ControlledEntity::InterfaceLinkStatus const linkStatus) noexcept override
-	{
-		emit avbInterfaceLinkStatusChanged(entity->getEntity().getEntityID(), avbInterfaceIndex, linkStatus);
-	}
-	virtual void onEntityCountersChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::EntityCounters const& counters) noexcept override
-	{
-		emit entityCountersChanged(entity->getEntity().getEntityID(), counters);
-	}
-	virtual void onAvbInterfaceCountersChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AvbInterfaceCounters const& counters) noexcept override
-	{
-		emit avbInterfaceCountersChanged(entity->getEntity().getEntityID(), avbInterfaceIndex, counters);
-	}
-	virtual void onClockDomainCountersChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockDomainCounters const& counters) noexcept override
-	{
-		emit clockDomainCountersChanged(entity->getEntity().getEntityID(), clockDomainIndex, counters);
-	}
-	virtual void onStreamInputCountersChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamInputCounters const& counters) noexcept override
-	{
-		auto const entityID = entity->getEntity().getEntityID();
+	public:
+		struct TransportError
+		{
+		};
+		struct EntityQueryError
+		{
+			la::avdecc::controller::Controller::QueryCommandError error{};
+		};
+		struct GptpChanged
+		{
+			la::avdecc::entity::model::AvbInterfaceIndex avbInterfaceIndex{ 0u };
+			la::avdecc::UniqueIdentifier grandMasterID{};
+			std::uint8_t grandMasterDomain{ 0u };
+		};
+		struct UnsolicitedRegistrationChanged
+		{
+		};
+		struct CompatibilityFlagsChanged
+		{
+			la::avdecc::controller::ControlledEntity::CompatibilityFlags compatibilityFlags{};
+		};
+		struct IdentificationChanged
+		{
+			bool isStarted{ false };
+		};
+		struct AcquireStateChanged
+		{
+			la::avdecc::controller::model::AcquireState acquireState{};
+			la::avdecc::UniqueIdentifier owningEntity{};
+		};
+		struct LockStateChanged
+		{
+			la::avdecc::controller::model::LockState lockState{};
+			la::avdecc::UniqueIdentifier lockingEntity{};
+		};
+		struct StreamFormatChanged
+		{
+			la::avdecc::entity::model::DescriptorType descriptorType{ la::avdecc::entity::model::DescriptorType::Invalid };
+			la::avdecc::entity::model::StreamIndex streamIndex{ 0u };
+			la::avdecc::entity::model::StreamFormat streamFormat{};
+		};
+		struct AudioUnitSamplingRateChanged
+		{
+			la::avdecc::entity::model::AudioUnitIndex audioUnitIndex{ 0u };
+			la::avdecc::entity::model::SamplingRate samplingRate{};
+		};
+		struct ClockSourceChanged
+		{
+			la::avdecc::entity::model::ClockDomainIndex clockDomainIndex{ 0u };
+			la::avdecc::entity::model::ClockSourceIndex clockSourceIndex{ 0u };
+		};
+		struct StreamRunningChanged
+		{
+			la::avdecc::entity::model::DescriptorType descriptorType{ la::avdecc::entity::model::DescriptorType::Invalid };
+			la::avdecc::entity::model::StreamIndex streamIndex{ 0u };
+			bool isRunning{ false };
+		};
+		struct AvbInterfaceLinkStatusChanged
+		{
+			la::avdecc::entity::model::AvbInterfaceIndex avbInterfaceIndex{ 0u };
+			la::avdecc::controller::ControlledEntity::InterfaceLinkStatus linkStatus{ la::avdecc::controller::ControlledEntity::InterfaceLinkStatus::Unknown };
+		};
+		struct MemoryObjectLengthChanged
+		{
+			la::avdecc::entity::model::ConfigurationIndex configurationIndex{ 0u };
+			la::avdecc::entity::model::MemoryObjectIndex memoryObjectIndex{ 0u };
+			std::uint64_t length{ 0u };
+		};
+		struct StreamPortAudioMappingsChanged
+		{
+			la::avdecc::entity::model::DescriptorType descriptorType{ la::avdecc::entity::model::DescriptorType::Invalid };
+			la::avdecc::entity::model::StreamPortIndex streamPortIndex{ 0u };
+		};
+		struct OperationProgress
+		{
+			la::avdecc::entity::model::DescriptorType descriptorType{ la::avdecc::entity::model::DescriptorType::Invalid };
+			la::avdecc::entity::model::DescriptorIndex descriptorIndex{ 0u };
+			la::avdecc::entity::model::OperationID operationID{ 0u };
+			float percentComplete{ 0.f };
+		};
+		struct OperationCompleted
+		{
+			la::avdecc::entity::model::DescriptorType descriptorType{ la::avdecc::entity::model::DescriptorType::Invalid };
+			la::avdecc::entity::model::DescriptorIndex descriptorIndex{ 0u };
+			la::avdecc::entity::model::OperationID operationID{ 0u };
+			bool failed{ false };
+		};
 
-		if (auto* errorCounterFlags = entityErrorCounterTracker(entityID))
+		using Payload = std::variant<TransportError, EntityQueryError, GptpChanged, UnsolicitedRegistrationChanged, CompatibilityFlagsChanged, IdentificationChanged, AcquireStateChanged, LockStateChanged, StreamFormatChanged, AudioUnitSamplingRateChanged, ClockSourceChanged, StreamRunningChanged, AvbInterfaceLinkStatusChanged, MemoryObjectLengthChanged, StreamPortAudioMappingsChanged, OperationProgress, OperationCompleted>;
+		struct Record
 		{
-			auto changed = false;
+			la::avdecc::UniqueIdentifier entityID{};
+			Payload payload{};
+		};
 
-			for (auto const [flag, counter] : counters)
+		static constexpr auto RingCapacity = std::size_t{ 4096u }; // Must be a power of 2
+
+		// Pushes a record from the calling thread. Returns true if a drain has to be posted
+		bool push(Record&& record) noexcept
+		{
+			auto& ring = producerRing();
+
+			// Once overflowing, keep appending to the overflow list until the consumer emptied it (so the order is preserved)
+			if (ring.isOverflowing.load(std::memory_order_relaxed))
 			{
-				switch (flag)
+				auto const lg = std::lock_guard{ ring.overflowLock };
+				if (ring.isOverflowing.load(std::memory_order_relaxed))
 				{
-					case la::avdecc::entity::StreamInputCounterValidFlag::MediaUnlocked:
-					{
-						try
-						{
-							auto const& entityNode = entity->getEntityNode();
-							auto const& streamNode = entity->getStreamInputNode(entityNode.dynamicModel->currentConfiguration, streamIndex);
-							if (streamNode.dynamicModel->connectionState.state != la::avdecc::entity::model::StreamConnectionState::State::Connected)
-							{
-								// Only consider MediaUnlocked as an error if the stream is connected, otherwise juste ignore this
-								break;
-							}
-						}
-						catch (la::avdecc::controller::ControlledEntity::Exception const&)
-						{
-							// Ignore exception
-							break;
-						}
-						catch (...)
-						{
-							// Uncaught exception
-							AVDECC_ASSERT(false, "Uncaught exception");
-							break;
-						}
-						[[fallthrough]];
-					}
-					case la::avdecc::entity::StreamInputCounterValidFlag::StreamInterrupted:
-					case la::avdecc::entity::StreamInputCounterValidFlag::SeqNumMismatch:
-					case la::avdecc::entity::StreamInputCounterValidFlag::LateTimestamp:
-					case la::avdecc::entity::StreamInputCounterValidFlag::EarlyTimestamp:
-					case la::avdecc::entity::StreamInputCounterValidFlag::UnsupportedFormat:
-						changed |= errorCounterFlags->setStreamInputCounter(streamIndex, flag, counter);
-						break;
-					default:
-						break;
+					ring.overflow.push_back(std::move(record));
+					return requestDrain();
 				}
 			}
 
-			if (changed)
+			auto const tail = ring.tail.load(std::memory_order_relaxed);
+			if (tail - ring.head.load(std::memory_order_acquire) == RingCapacity)
 			{
-				emit streamInputErrorCounterChanged(entityID, streamIndex, errorCounterFlags->getStreamInputErrorCounters(streamIndex));
+				auto const lg = std::lock_guard{ ring.overflowLock };
+				ring.overflow.push_back(std::move(record));
+				ring.isOverflowing.store(true, std::memory_order_release);
+				return requestDrain();
 			}
-		}
 
-		emit streamInputCountersChanged(entityID, streamIndex, counters);
-	}
-	virtual void onStreamOutputCountersChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamOutputCounters const& counters) noexcept override
-	{
-		emit streamOutputCountersChanged(entity->getEntity().getEntityID(), streamIndex, counters);
-	}
-	virtual void onMemoryObjectLengthChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, std::uint64_t const length) noexcept override
-	{
-		emit memoryObjectLengthChanged(entity->getEntity().getEntityID(), configurationIndex, memoryObjectIndex, length);
-	}
-	virtual void onStreamPortInputAudioMappingsChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamPortIndex const streamPortIndex) noexcept override
-	{
-		emit streamPortAudioMappingsChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamPortInput, streamPortIndex);
-	}
-	virtual void onStreamPortOutputAudioMappingsChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamPortIndex const streamPortIndex) noexcept override
-	{
-		emit streamPortAudioMappingsChanged(entity->getEntity().getEntityID(), la::avdecc::entity::model::DescriptorType::StreamPortOutput, streamPortIndex);
-	}
-	virtual void onOperationProgress(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, la::avdecc::entity::model::OperationID const operationID, float const percentComplete) noexcept override
-	{
-		emit operationProgress(entity->getEntity().getEntityID(), descriptorType, descriptorIndex, operationID, percentComplete);
-	}
-	virtual void onOperationCompleted(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, la::avdecc::entity::model::OperationID const operationID, bool const failed) noexcept override
-	{
-		emit operationCompleted(entity->getEntity().getEntityID(), descriptorType, descriptorIndex, operationID, failed);
-	}
-	// Statistics
-	virtual void onAecpRetryCounterChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, std::uint64_t const value) noexcept override
-	{
-		auto const entityID = entity->getEntity().getEntityID();
+			ring.records[tail & (RingCapacity - 1u)] = std::move(record);
+			ring.tail.store(tail + 1u, std::memory_order_release);
+			return requestDrain();
+		}
 
-		if (auto* errorCounterFlags = entityErrorCounterTracker(entityID))
+		// Pops all the pushed records (Qt Main Thread only), in push order for each producer thread
+		template<typename Handler>
+		void drain(Handler const& handler) noexcept
 		{
-			if (errorCounterFlags->setStatisticsCounter(StatisticsErrorCounterFlag::AecpRetries, value))
+			// Reset first, so a record pushed during the drain posts another one
+			_isDrainPosted.store(false);
+
+			auto rings = std::vector<Ring*>{};
+			{
+				auto const lg = std::lock_guard{ _ringsLock };
+				rings.reserve(_rings.size());
+				for (auto const& ring : _rings)
+				{
+					rings.push_back(ring.get());
+				}
+			}
+
+			for (auto* const ring : rings)
 			{
-				emit statisticsErrorCounterChanged(entityID, errorCounterFlags->getStatisticsErrorCounters());
+				auto head = ring->head.load(std::memory_order_relaxed);
+				auto const tail = ring->tail.load(std::memory_order_acquire);
+				for (; head != tail; ++head)
+				{
+					handler(ring->records[head & (RingCapacity - 1u)]);
+				}
+				ring->head.store(tail, std::memory_order_release);
+
+				// The producer doesn't push to the ring while overflowing: take what remains in the ring, then the overflow list
+				if (ring->isOverflowing.load(std::memory_order_acquire))
+				{
+					auto records = std::vector<Record>{};
+					{
+						auto const lg = std::lock_guard{ ring->overflowLock };
+						auto const overflowTail = ring->tail.load(std::memory_order_acquire);
+						for (head = ring->head.load(std::memory_order_relaxed); head != overflowTail; ++head)
+						{
+							records.push_back(std::move(ring->records[head & (RingCapacity - 1u)]));
+						}
+						ring->head.store(overflowTail, std::memory_order_release);
+						std::move(ring->overflow.begin(), ring->overflow.end(), std::back_inserter(records));
+						ring->overflow.clear();
+						ring->isOverflowing.store(false, std::memory_order_release);
+					}
+					for (auto const& record : records)
+					{
+						handler(record);
+					}
+				}
 			}
 		}
 
-		emit aecpRetryCounterChanged(entityID, value);
-	}
-	virtual void onAecpTimeoutCounterChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, std::uint64_t const value) noexcept override
-	{
-		auto const entityID = entity->getEntity().getEntityID();
+	private:
+		struct Ring
+		{
+			std::vector<Record> records = std::vector<Record>(RingCapacity);
+			alignas(64) std::atomic<std::size_t> head{ 0u }; // Next record to pop, only written by the consumer
+			alignas(64) std::atomic<std::size_t> tail{ 0u }; // Next record to push, only written by the producer
+			std::atomic_bool isOverflowing{ false };
+			std::mutex overflowLock{}; // Only taken while the ring is full
+			std::vector<Record> overflow{};
+			std::atomic_bool isAttached{ true }; // Still used by its producer thread
+		};
 
-		if (auto* errorCounterFlags = entityErrorCounterTracker(entityID))
+		/** Detaches the ring from its producer when the thread exits, so it can be reused by another thread */
+		struct ProducerSlot
 		{
-			if (errorCounterFlags->setStatisticsCounter(StatisticsErrorCounterFlag::AecpTimeouts, value))
+			ObserverHandoff const* owner{ nullptr };
+			Ring* ring{ nullptr };
+
+			~ProducerSlot() noexcept
 			{
-				emit statisticsErrorCounterChanged(entityID, errorCounterFlags->getStatisticsErrorCounters());
+				if (ring)
+				{
+					ring->isAttached = false;
+				}
 			}
-		}
+		};
 
-		emit aecpTimeoutCounterChanged(entity->getEntity().getEntityID(), value);
-	}
-	virtual void onAecpUnexpectedResponseCounterChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, std::uint64_t const value) noexcept override
-	{
-		auto const entityID = entity->getEntity().getEntityID();
+		Ring& producerRing() noexcept
+		{
+			thread_local auto s_slot = ProducerSlot{};
+			if (s_slot.owner != this)
+			{
+				s_slot.owner = this;
+				s_slot.ring = attachRing();
+			}
+			return *s_slot.ring;
+		}
 
-		if (auto* errorCounterFlags = entityErrorCounterTracker(entityID))
+		Ring* attachRing() noexcept
 		{
-			if (errorCounterFlags->setStatisticsCounter(StatisticsErrorCounterFlag::AecpUnexpectedResponses, value))
+			auto const lg = std::lock_guard{ _ringsLock };
+
+			// Reuse the ring of an exited thread, once it has been emptied by the consumer
+			for (auto const& ring : _rings)
 			{
-				emit statisticsErrorCounterChanged(entityID, errorCounterFlags->getStatisticsErrorCounters());
+				if (!ring->isAttached && ring->head == ring->tail && !ring->isOverflowing)
+				{
+					ring->isAttached = true;
+					return ring.get();
+				}
 			}
+			return _rings.emplace_back(std::make_unique<Ring>()).get();
 		}
 
-		emit aecpUnexpectedResponseCounterChanged(entity->getEntity().getEntityID(), value);
-	}
-	virtual void onAecpResponseAverageTimeChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, std::chrono::milliseconds const& value) noexcept override
-	{
-		emit aecpResponseAverageTimeChanged(entity->getEntity().getEntityID(), value);
-	}
-	virtual void onAemAecpUnsolicitedCounterChanged(la::avdecc::controller::Controller const* const /*controller*/, la::avdecc::controller::ControlledEntity const* const entity, std::uint64_t const value) noexcept override
-	{
-		emit aemAecpUnsolicitedCounterChanged(entity->getEntity().getEntityID(), value);
-	}
+		bool requestDrain() noexcept
+		{
+			return !_isDrainPosted.exchange(true);
+		}
 
-	// ControllerManager overrides
-	virtual void createController(la::avdecc::protocol::ProtocolInterface::Type const protocolInterfaceType, QString const& interfaceName, std::uint16_t const progID, la::avdecc::UniqueIdentifier const entityModelID, QString const& preferedLocale) override
+		std::mutex _ringsLock{}; // Only taken by the first push of a thread, and once per drain
+		std::vector<std::unique_ptr<Ring>> _rings{};
+		std::atomic_bool _isDrainPosted{ false };
+	};
+
+	/**
+	* @brief Event queue between the avdecc threads and the Qt Main Thread.
+	* @details Coalesced events are stored in a slot table keyed by (entity, descriptor, event kind), a newer event replacing the pending one (last value wins) while keeping its position in the queue.
+	*          Ordered events are always appended and never merged. An ordered event seals all pending slots of its entity, so a later coalesced event cannot be delivered before it.
+	*          Ordered events can be tagged with a Batch kind, consecutive events of the same kind being reported together when the bus is drained.
+	*          Notifications delivered by other routes (observer handoff, names) are posted after the pending ordered events of their entity, so they cannot overtake its online/offline notification.
+	*/
+	class CoalescingEventBus
 	{
-		// If we have a previous controller, remove it
-		if (_controller)
+	public:
+		enum class EventKind : std::uint8_t
 		{
-			destroyController();
-		}
+			StreamDynamicInfo,
+			AvbInterfaceInfo,
+			AsPath,
+			EntityCounters,
+			AvbInterfaceCounters,
+			ClockDomainCounters,
+			StreamInputCounters,
+			StreamOutputCounters,
+			StreamInputErrorCounters,
+			StreamInputMediaLocked,
+			StreamOutputStarted,
+			AecpRetryCounter,
+			AecpTimeoutCounter,
+			AecpUnexpectedResponseCounter,
+			AecpResponseAverageTime,
+			AemAecpUnsolicitedCounter,
+			StatisticsErrorCounters,
+		};
 
-		// Create a new controller and store it
-		SharedController controller = la::avdecc::controller::Controller::create(protocolInterfaceType, interfaceName.toStdString(), progID, entityModelID, preferedLocale.toStdString());
-#if HAVE_ATOMIC_SMART_POINTERS
-		_controller = std::move(controller);
-#else // !HAVE_ATOMIC_SMART_POINTERS
-		std::atomic_store(&_controller, std::move(controller));
-#endif // HAVE_ATOMIC_SMART_POINTERS
+		enum class Batch : std::uint8_t
+		{
+			None, /**< Not part of a batch */
+			EntityOnline, /**< Consecutive events are grouped into a single entitiesOnline signal */
+			EntityOffline, /**< Consecutive events are grouped into a single entitiesOffline signal */
+		};
 
-		// Re-get the controller, just in case another thread changed the controller at the same moment
-		auto ctrl = getController();
-		if (ctrl)
+		using Event = std::function<void()>;
+		struct PendingEvent
 		{
-			emit controllerOnline();
-			ctrl->registerObserver(this);
-			//ctrl->enableEntityAdvertising(10);
+			Batch batch{ Batch::None };
+			la::avdecc::UniqueIdentifier entityID{};
+			Event event{};
+		};
+		using Events = std::vector<PendingEvent>;
 
-			if (_enableAemCache)
-			{
-				ctrl->enableEntityModelCache();
-			}
-			else
-			{
-				ctrl->disableEntityModelCache();
-			}
+		// Posts an event merged with the pending one sharing the same key. Returns true if the bus was empty (a drain has to be scheduled)
+		bool postCoalesced(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, EventKind const kind, Event&& event) noexcept
+		{
+			auto const lg = std::lock_guard{ _lock };
+			auto const wasEmpty = _events.empty();
 
-			if (_fullAemEnumeration)
+			auto const key = SlotKey{ entityID, descriptorType, descriptorIndex, kind };
+			auto const slotIt = _slots.find(key);
+			if (slotIt != std::end(_slots))
 			{
-				ctrl->enableFullStaticEntityModelEnumeration();
+				_events[slotIt->second].event = std::move(event);
 			}
 			else
 			{
-				ctrl->disableFullStaticEntityModelEnumeration();
+				_slots.emplace(key, _events.size());
+				_events.push_back(PendingEvent{ Batch::None, entityID, std::move(event) });
 			}
+
+			return wasEmpty;
 		}
-	}
 
-	virtual void destroyController() noexcept override
-	{
-		if (_controller)
+		// Posts an event that is never merged. Returns true if the bus was empty (a drain has to be scheduled)
+		bool postOrdered(la::avdecc::UniqueIdentifier const entityID, Batch const batch, Event&& event) noexcept
 		{
-			// First remove the observer so we don't get any new notifications
-			_controller->unregisterObserver(this);
+			auto const lg = std::lock_guard{ _lock };
+			auto const wasEmpty = _events.empty();
 
-			// And destroy the controller itself
-#if HAVE_ATOMIC_SMART_POINTERS
-			_controller = Controller{ nullptr };
-#else // !HAVE_ATOMIC_SMART_POINTERS
-			std::atomic_store(&_controller, SharedController{ nullptr });
-#endif // HAVE_ATOMIC_SMART_POINTERS
+			appendOrdered(entityID, batch, std::move(event));
 
-			// Wipe all entities
+			return wasEmpty;
+		}
+
+		// Posts an event after the pending ordered events of the entity, only if it has some. Returns false (the event being left untouched) otherwise
+		bool postAfterOrdered(la::avdecc::UniqueIdentifier const entityID, Event&& event) noexcept
+		{
+			auto const lg = std::lock_guard{ _lock };
+			if (_orderedEntities.count(entityID) == 0u)
 			{
-				auto const lg = std::lock_guard{ _lock };
-				_entities.clear();
-				_entityErrorCounterTrackers.clear();
+				return false;
 			}
 
-			// Notify
-			emit controllerOffline();
+			appendOrdered(entityID, Batch::None, std::move(event));
+
+			return true;
 		}
-	}
 
-	virtual la::avdecc::UniqueIdentifier getControllerEID() const noexcept override
-	{
-		auto controller = getController();
-		if (controller)
+		// Takes all pending events, in delivery order
+		Events takePending() noexcept
 		{
-			return controller->getControllerEID();
+			auto const lg = std::lock_guard{ _lock };
+			auto events = Events{};
+			std::swap(events, _events);
+			_slots.clear();
+			_orderedEntities.clear();
+			return events;
 		}
-		return la::avdecc::UniqueIdentifier{};
-	}
 
-	virtual la::avdecc::controller::ControlledEntityGuard getControlledEntity(la::avdecc::UniqueIdentifier const entityID) const noexcept override
-	{
-		auto controller = getController();
-		if (controller)
+		void clear() noexcept
 		{
-			return controller->getControlledEntityGuard(entityID);
+			auto const lg = std::lock_guard{ _lock };
+			_events.clear();
+			_slots.clear();
+			_orderedEntities.clear();
 		}
-		return {};
-	}
 
-	virtual std::tuple<la::avdecc::jsonSerializer::SerializationError, std::string> serializeAllControlledEntitiesAsJson(QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags, QString const& dumpSource) const noexcept override
-	{
-		auto controller = getController();
-		if (controller)
+		// Discards all pending events of an entity, keeping the delivery order of the other ones
+		void discardEntity(la::avdecc::UniqueIdentifier const entityID) noexcept
 		{
-			return controller->serializeAllControlledEntitiesAsJson(filePath.toStdString(), flags, dumpSource.toStdString(), true);
+			auto const lg = std::lock_guard{ _lock };
+			auto events = Events{};
+			auto newIndexes = std::vector<std::size_t>(_events.size(), 0u);
+			for (auto index = std::size_t{ 0u }; index < _events.size(); ++index)
+			{
+				if (_events[index].entityID != entityID)
+				{
+					newIndexes[index] = events.size();
+					events.push_back(std::move(_events[index]));
+				}
+			}
+			for (auto slotIt = std::begin(_slots); slotIt != std::end(_slots);)
+			{
+				if (slotIt->first.entityID == entityID)
+				{
+					slotIt = _slots.erase(slotIt);
+				}
+				else
+				{
+					slotIt->second = newIndexes[slotIt->second];
+					++slotIt;
+				}
+			}
+			_events = std::move(events);
+			_orderedEntities.erase(entityID);
 		}
-		return { la::avdecc::jsonSerializer::SerializationError::InternalError, "Controller offline" };
-	}
 
-	virtual std::tuple<la::avdecc::jsonSerializer::SerializationError, std::string> serializeControlledEntityAsJson(la::avdecc::UniqueIdentifier const entityID, QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags, QString const& dumpSource) const noexcept override
-	{
-		auto controller = getController();
-		if (controller)
+	private:
+		// Appends an ordered event, sealing the pending slots of its entity (_lock must be held)
+		void appendOrdered(la::avdecc::UniqueIdentifier const entityID, Batch const batch, Event&& event) noexcept
 		{
-			return controller->serializeControlledEntityAsJson(entityID, filePath.toStdString(), flags, dumpSource.toStdString());
+			if (entityID)
+			{
+				for (auto slotIt = std::begin(_slots); slotIt != std::end(_slots);)
+				{
+					if (slotIt->first.entityID == entityID)
+					{
+						slotIt = _slots.erase(slotIt);
+					}
+					else
+					{
+						++slotIt;
+					}
+				}
+				_orderedEntities.insert(entityID);
+			}
+			_events.push_back(PendingEvent{ batch, entityID, std::move(event) });
 		}
-		return { la::avdecc::jsonSerializer::SerializationError::InternalError, "Controller offline" };
-	}
 
-	virtual std::tuple<la::avdecc::jsonSerializer::DeserializationError, std::string> loadVirtualEntityFromJson(QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags) noexcept override
-	{
-		auto controller = getController();
-		if (controller)
+		struct SlotKey
 		{
-			return controller->loadVirtualEntityFromJson(filePath.toStdString(), flags);
-		}
-		return { la::avdecc::jsonSerializer::DeserializationError::InternalError, "Controller offline" };
-	}
+			la::avdecc::UniqueIdentifier entityID{};
+			la::avdecc::entity::model::DescriptorType descriptorType{ la::avdecc::entity::model::DescriptorType::Invalid };
+			la::avdecc::entity::model::DescriptorIndex descriptorIndex{ 0u };
+			EventKind kind{ EventKind::StreamDynamicInfo };
 
-	ErrorCounterTracker const* entityErrorCounterTracker(la::avdecc::UniqueIdentifier const entityID) const noexcept
-	{
-		auto const lg = std::lock_guard{ _lock };
+			bool operator==(SlotKey const& other) const noexcept
+			{
+				return entityID == other.entityID && descriptorType == other.descriptorType && descriptorIndex == other.descriptorIndex && kind == other.kind;
+			}
 
-		auto const it = _entityErrorCounterTrackers.find(entityID);
-		if (it != std::end(_entityErrorCounterTrackers))
-		{
-			return &it->second;
-		}
+			struct hash
+			{
+				std::size_t operator()(SlotKey const& key) const noexcept
+				{
+					auto const descriptor = (static_cast<std::uint32_t>(la::avdecc::utils::to_integral(key.descriptorType)) << 16) | static_cast<std::uint32_t>(key.descriptorIndex);
+					return la::avdecc::UniqueIdentifier::hash{}(key.entityID) ^ (std::hash<std::uint32_t>{}(descriptor) << 1) ^ (static_cast<std::size_t>(la::avdecc::utils::to_integral(key.kind)) * 31u);
+				}
+			};
+		};
 
-		return nullptr;
-	}
+		std::mutex _lock{};
+		Events _events{};
+		std::unordered_map<SlotKey, std::size_t, SlotKey::hash> _slots{}; // Index in _events of each pending coalesced event
+		std::unordered_set<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash> _orderedEntities{}; // Entities having a pending ordered event
+	};
 
-	ErrorCounterTracker* entityErrorCounterTracker(la::avdecc::UniqueIdentifier const entityID) noexcept
+	ControllerManagerImpl() noexcept
 	{
-		return const_cast<ErrorCounterTracker*>(static_cast<ControllerManagerImpl const*>(this)->entityErrorCounterTracker(entityID));
+		qRegisterMetaType<std::uint8_t>("std::uint8_t");
+		qRegisterMetaType<std::uint16_t>("std::uint16_t");
+		qRegisterMetaType<std::uint64_t>("std::uint64_t");
+		qRegisterMetaType<std::chrono::milliseconds>("std::chrono::milliseconds");
+		qRegisterMetaType<AecpCommandType>("avdecc::ControllerManager::AecpCommandType");
+		qRegisterMetaType<AcmpCommandType>("avdecc::ControllerManager::AcmpCommandType");
+		qRegisterMetaType<StreamInputErrorCounters>("avdecc::ControllerManager::StreamInputErrorCounters");
+		qRegisterMetaType<StatisticsErrorCounters>("avdecc::ControllerManager::StatisticsErrorCounters");
+		qRegisterMetaType<EntityIDs>("avdecc::ControllerManager::EntityIDs");
+		qRegisterMetaType<la::avdecc::UniqueIdentifier>("la::avdecc::UniqueIdentifier");
+		qRegisterMetaType<la::avdecc::entity::ControllerEntity::AemCommandStatus>("la::avdecc::entity::ControllerEntity::AemCommandStatus");
+		qRegisterMetaType<la::avdecc::entity::ControllerEntity::ControlStatus>("la::avdecc::entity::ControllerEntity::ControlStatus");
+		qRegisterMetaType<la::avdecc::entity::StreamInputCounterValidFlags>("la::avdecc::entity::StreamInputCounterValidFlags");
+		qRegisterMetaType<la::avdecc::entity::model::AvdeccFixedString>("la::avdecc::entity::model::AvdeccFixedString");
+		qRegisterMetaType<la::avdecc::entity::model::ConfigurationIndex>("la::avdecc::entity::model::ConfigurationIndex");
+		qRegisterMetaType<la::avdecc::entity::model::DescriptorType>("la::avdecc::entity::model::DescriptorType");
+		qRegisterMetaType<la::avdecc::entity::model::DescriptorIndex>("la::avdecc::entity::model::DescriptorIndex");
+		qRegisterMetaType<la::avdecc::entity::model::AudioUnitIndex>("la::avdecc::entity::model::AudioUnitIndex");
+		qRegisterMetaType<la::avdecc::entity::model::StreamIndex>("la::avdecc::entity::model::StreamIndex");
+		qRegisterMetaType<la::avdecc::entity::model::JackIndex>("la::avdecc::entity::model::JackIndex");
+		qRegisterMetaType<la::avdecc::entity::model::AvbInterfaceIndex>("la::avdecc::entity::model::AvbInterfaceIndex");
+		qRegisterMetaType<la::avdecc::entity::model::ClockSourceIndex>("la::avdecc::entity::model::ClockSourceIndex");
+		qRegisterMetaType<la::avdecc::entity::model::MemoryObjectIndex>("la::avdecc::entity::model::MemoryObjectIndex");
+		qRegisterMetaType<la::avdecc::entity::model::LocaleIndex>("la::avdecc::entity::model::LocaleIndex");
+		qRegisterMetaType<la::avdecc::entity::model::StringsIndex>("la::avdecc::entity::model::StringsIndex");
+		qRegisterMetaType<la::avdecc::entity::model::StreamPortIndex>("la::avdecc::entity::model::StreamPortIndex");
+		qRegisterMetaType<la::avdecc::entity::model::ExternalPortIndex>("la::avdecc::entity::model::ExternalPortIndex");
+		qRegisterMetaType<la::avdecc::entity::model::InternalPortIndex>("la::avdecc::entity::model::InternalPortIndex");
+		qRegisterMetaType<la::avdecc::entity::model::ClusterIndex>("la::avdecc::entity::model::ClusterIndex");
+		qRegisterMetaType<la::avdecc::entity::model::MapIndex>("la::avdecc::entity::model::MapIndex");
+		qRegisterMetaType<la::avdecc::entity::model::ControlIndex>("la::avdecc::entity::model::ControlIndex");
+		qRegisterMetaType<la::avdecc::entity::model::SignalSelectorIndex>("la::avdecc::entity::model::SignalSelectorIndex");
+		qRegisterMetaType<la::avdecc::entity::model::MixerIndex>("la::avdecc::entity::model::MixerIndex");
+		qRegisterMetaType<la::avdecc::entity::model::MatrixIndex>("la::avdecc::entity::model::MatrixIndex");
+		qRegisterMetaType<la::avdecc::entity::model::SignalSplitterIndex>("la::avdecc::entity::model::SignalSplitterIndex");
+		qRegisterMetaType<la::avdecc::entity::model::SignalCombinerIndex>("la::avdecc::entity::model::SignalCombinerIndex");
+		qRegisterMetaType<la::avdecc::entity::model::SignalDemultiplexerIndex>("la::avdecc::entity::model::SignalDemultiplexerIndex");
+		qRegisterMetaType<la::avdecc::entity::model::SignalMultiplexerIndex>("la::avdecc::entity::model::SignalMultiplexerIndex");
+		qRegisterMetaType<la::avdecc::entity::model::SignalTranscoderIndex>("la::avdecc::entity::model::SignalTranscoderIndex");
+		qRegisterMetaType<la::avdecc::entity::model::ClockDomainIndex>("la::avdecc::entity::model::ClockDomainIndex");
+		qRegisterMetaType<la::avdecc::entity::model::ControlBlockIndex>("la::avdecc::entity::model::ControlBlockIndex");
+		qRegisterMetaType<la::avdecc::entity::model::SamplingRate>("la::avdecc::entity::model::SamplingRate");
+		qRegisterMetaType<la::avdecc::entity::model::StreamFormat>("la::avdecc::entity::model::StreamFormat");
+		qRegisterMetaType<la::avdecc::entity::model::OperationID>("la::avdecc::entity::model::OperationID");
+		qRegisterMetaType<la::avdecc::entity::model::StreamDynamicInfo>("la::avdecc::entity::model::StreamDynamicInfo");
+		qRegisterMetaType<la::avdecc::entity::model::AvbInterfaceInfo>("la::avdecc::entity::model::AvbInterfaceInfo");
+		qRegisterMetaType<la::avdecc::entity::model::AsPath>("la::avdecc::entity::model::AsPath");
+		qRegisterMetaType<la::avdecc::entity::model::StreamIdentification>("la::avdecc::entity::model::StreamIdentification");
+		qRegisterMetaType<la::avdecc::entity::model::StreamConnectionState>("la::avdecc::entity::model::StreamConnectionState");
+		qRegisterMetaType<la::avdecc::entity::model::StreamConnections>("la::avdecc::entity::model::StreamConnections");
+		qRegisterMetaType<la::avdecc::entity::model::EntityCounters>("la::avdecc::entity::model::EntityCounters");
+		qRegisterMetaType<la::avdecc::entity::model::AvbInterfaceCounters>("la::avdecc::entity::model::AvbInterfaceCounters");
+		qRegisterMetaType<la::avdecc::entity::model::ClockDomainCounters>("la::avdecc::entity::model::ClockDomainCounters");
+		qRegisterMetaType<la::avdecc::entity::model::StreamInputCounters>("la::avdecc::entity::model::StreamInputCounters");
+		qRegisterMetaType<la::avdecc::entity::model::StreamOutputCounters>("la::avdecc::entity::model::StreamOutputCounters");
+		qRegisterMetaType<la::avdecc::controller::Controller::QueryCommandError>("la::avdecc::controller::Controller::QueryCommandError");
+		qRegisterMetaType<la::avdecc::controller::ControlledEntity::InterfaceLinkStatus>("la::avdecc::controller::ControlledEntity::InterfaceLinkStatus");
+		qRegisterMetaType<la::avdecc::controller::ControlledEntity::CompatibilityFlags>("la::avdecc::controller::ControlledEntity::CompatibilityFlags");
+		qRegisterMetaType<la::avdecc::controller::model::AcquireState>("la::avdecc::controller::model::AcquireState");
+		qRegisterMetaType<la::avdecc::controller::model::LockState>("la::avdecc::controller::model::LockState");
+
+		// Configure the event bus drain timer, delivering pending events at a bounded rate
+		_eventBusTimer.setSingleShot(true);
+		_eventBusTimer.setInterval(EventBusFramePeriod);
+		connect(&_eventBusTimer, &QTimer::timeout, this, &ControllerManagerImpl::drainEventBus);
+
+		// Configure the background event bus drain timer, only running with visibility-driven notifications
+		_backgroundEventBusTimer.setInterval(BackgroundEventBusPeriod);
+		connect(&_backgroundEventBusTimer, &QTimer::timeout, this, &ControllerManagerImpl::drainBackgroundEventBus);
+
+		// Configure the offline grace period timer, armed for the first rebooting entity to expire
+		_gracePeriodTimer.setSingleShot(true);
+		connect(&_gracePeriodTimer, &QTimer::timeout, this, &ControllerManagerImpl::expireRebootingEntities);
+
+		// Configure the virtual entities loader
+		_virtualEntityLoaderPool.setMaxThreadCount(VirtualEntityLoaderMaxThreadCount);
+
+		// Configure the parallel entities visitor
+		_entityVisitorPool.setMaxThreadCount(std::max(0, QThread::idealThreadCount() - 1));
+
+		// Configure settings observers
+		auto& settings = settings::SettingsManager::getInstance();
+		settings.registerSettingObserver(settings::Controller_AemCacheEnabled.name, this);
+		settings.registerSettingObserver(settings::Controller_FullStaticModelEnabled.name, this);
+		settings.registerSettingObserver(settings::Controller_OfflineGracePeriod.name, this);
+		settings.registerSettingObserver(settings::Controller_VisibilityDrivenNotifications.name, this);
+		settings.registerSettingObserver(settings::Controller_WatchedEntities.name, this);
+
+		MemoryAccounting::getInstance().registerProbe("ControllerManager",
+			[this](MemoryAccounting::Counters& counters)
+			{
+				{
+					auto const lg = std::lock_guard{ _lock };
+					counters.push_back({ "Entities", _entities.size() });
+					counters.push_back({ "ErrorCounterTrackers", _entityErrorCounterTrackers.size() });
+					counters.push_back({ "AecpCommandLatencies", _entityAecpCommandLatencies.size() });
+					counters.push_back({ "EnumerationTimelines", _entityEnumerationTimelines.size() });
+				}
+				{
+					auto const lg = std::lock_guard{ _entitySummariesLock };
+					counters.push_back({ "EntitySummaries", _entitySummaries.size() });
+				}
+				counters.push_back({ "MediaLockedStates", _streamInputMediaLockedStates.size() });
+				counters.push_back({ "StartedStates", _streamOutputStartedStates.size() });
+				counters.push_back({ "RebootingEntities", _rebootingEntities.size() });
+			});
 	}
 
-	virtual StreamInputErrorCounters getStreamInputErrorCounters(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex) const noexcept override
+	~ControllerManagerImpl() noexcept
 	{
-		if (auto* errorCounterTracker = entityErrorCounterTracker(entityID))
+		// The controller should already have been destroyed by now, but just in case, clean it we don't want further notifications
+		if (!AVDECC_ASSERT_WITH_RET(!_controller, "Controller should have been destroyed before the singleton destructor is called"))
 		{
-			return errorCounterTracker->getStreamInputErrorCounters(streamIndex);
+			destroyController();
 		}
-		return {};
+
+		// Remove settings observers
+		auto& settings = settings::SettingsManager::getInstance();
+		settings.unregisterSettingObserver(settings::Controller_AemCacheEnabled.name, this);
+		settings.unregisterSettingObserver(settings::Controller_FullStaticModelEnabled.name, this);
+		settings.unregisterSettingObserver(settings::Controller_OfflineGracePeriod.name, this);
+		settings.unregisterSettingObserver(settings::Controller_VisibilityDrivenNotifications.name, this);
+		settings.unregisterSettingObserver(settings::Controller_WatchedEntities.name, this);
 	}
 
-	virtual void clearStreamInputCounterValidFlags(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::StreamInputCounterValidFlag const flag) noexcept override
+private:
+	// settings::SettingsManager::Observer overrides
+	virtual void onSettingChanged(settings::SettingsManager::Setting const& name, QVariant const& value) noexcept override
 	{
-		if (auto* errorCounterTracker = entityErrorCounterTracker(entityID))
+		if (name == settings::Controller_AemCacheEnabled.name)
 		{
-			if (errorCounterTracker->clearStreamInputCounter(streamIndex, flag))
+			_enableAemCache = value.toBool();
+		}
+		else if (name == settings::Controller_FullStaticModelEnabled.name)
+		{
+			_fullAemEnumeration = value.toBool();
+		}
+		else if (name == settings::Controller_OfflineGracePeriod.name)
+		{
+			auto const wasEntityModelCacheEnabled = isEntityModelCacheEnabled();
+			_offlineGracePeriod = std::chrono::seconds{ std::max(0, value.toInt()) };
+
+			// Returning entities are re-enumerated from the entity model cache, which can be changed on the running controllers
+			if (isEntityModelCacheEnabled() != wasEntityModelCacheEnabled)
 			{
-				emit streamInputErrorCounterChanged(entityID, streamIndex, errorCounterTracker->getStreamInputErrorCounters(streamIndex));
+				reconfigureControllers();
+			}
+		}
+		else if (name == settings::Controller_VisibilityDrivenNotifications.name)
+		{
+			_visibilityDrivenNotifications = value.toBool();
+			if (_visibilityDrivenNotifications)
+			{
+				_backgroundEventBusTimer.start();
+			}
+			else
+			{
+				_backgroundEventBusTimer.stop();
+				drainBackgroundEventBus();
+			}
+		}
+		else if (name == settings::Controller_WatchedEntities.name)
+		{
+			auto watchedEntities = EntitySet{};
+			for (auto text : value.toStringList())
+			{
+				if (text.startsWith("0x", Qt::CaseInsensitive))
+				{
+					text.remove(0, 2);
+				}
+				if (auto const entityID = la::avdecc::UniqueIdentifier{ text.toULongLong(nullptr, 16) })
+				{
+					watchedEntities.insert(entityID);
+				}
+			}
+			{
+				auto const lg = std::lock_guard{ _interestLock };
+				_watchedEntities = std::move(watchedEntities);
 			}
+			drainBackgroundEventBus();
 		}
 	}
 
-	virtual void clearAllStreamInputCounterValidFlags(la::avdecc::UniqueIdentifier const entityID) noexcept override
+	// la::avdecc::controller::Controller::Observer overrides
+	// Global controller notifications
+	virtual void onTransportError(la::avdecc::controller::Controller const* const /*controller*/) noexcept override
 	{
-		if (auto* errorCounterTracker = entityErrorCounterTracker(entityID))
+		HIVE_TRACE_SPAN("ControllerManager::onTransportError");
+		_traceRecorder.record(observerTrace::EventType::TransportError, la::avdecc::UniqueIdentifier::getNullUniqueIdentifier());
+
+		postObserverHandoff(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), ObserverHandoff::TransportError{});
+	}
+	virtual void onEntityQueryError(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::controller::Controller::QueryCommandError const error) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onEntityQueryError");
+		if (!forwardEvent(controller, observerTrace::EventType::EntityQueryError, entity, error))
 		{
-			errorCounterTracker->clearAllStreamInputCounters();
+			return;
 		}
-	}
 
-	virtual StatisticsErrorCounters getStatisticsCounters(la::avdecc::UniqueIdentifier const entityID) const noexcept override
-	{
-		if (auto* errorCounterTracker = entityErrorCounterTracker(entityID))
 		{
-			return errorCounterTracker->getStatisticsErrorCounters();
+			auto const lg = std::lock_guard{ _lock };
+			++_entityEnumerationQueryErrors[entity->getEntity().getEntityID()];
 		}
-		return {};
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::EntityQueryError{ error });
 	}
-
-	virtual void clearStatisticsCounterValidFlags(la::avdecc::UniqueIdentifier const entityID, StatisticsErrorCounterFlag const flag) noexcept override
+	// Discovery notifications (ADP)
+	virtual void onEntityOnline(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity) noexcept override
 	{
-		if (auto* errorCounterTracker = entityErrorCounterTracker(entityID))
+		HIVE_TRACE_SPAN("ControllerManager::onEntityOnline");
+		auto const entityID{ entity->getEntity().getEntityID() };
+
+		// Already online through another interface
+		if (!addEntityController(controller, entityID))
 		{
-			if (errorCounterTracker->clearStatisticsCounter(flag))
+			return;
+		}
+		recordEvent(observerTrace::EventType::EntityOnline, entity);
+
+		{
+			auto const onlineAt = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _controllerCreationTime);
+			auto const enumerationTime = entity->getEnumerationTime();
+
+			auto timeline = EnumerationTimeline{};
+			timeline.entityModelID = entity->getEntity().getEntityModelID();
+			timeline.discoveredAt = std::max(std::chrono::milliseconds{ 0 }, onlineAt - enumerationTime);
+			timeline.onlineAt = onlineAt;
+			timeline.enumerationTime = enumerationTime;
+			timeline.aecpRetries = entity->getAecpRetryCounter();
+			timeline.aecpTimeouts = entity->getAecpTimeoutCounter();
+			timeline.aecpUnexpectedResponses = entity->getAecpUnexpectedResponseCounter();
+			timeline.aecpResponseAverageTime = entity->getAecpResponseAverageTime();
+			timeline.aemCacheEnabled = isEntityModelCacheEnabled();
+			timeline.fullStaticModelEnabled = _fullAemEnumeration;
+
+			auto const lg = std::lock_guard{ _lock };
+			_entities.insert(entityID);
+			_entityErrorCounterTrackers[entityID] = ErrorCounterTracker{ entityID };
+
+			// Query errors were counted since the previous enumeration of this entity
+			if (auto const it = _entityEnumerationQueryErrors.find(entityID); it != _entityEnumerationQueryErrors.end())
 			{
-				emit statisticsErrorCounterChanged(entityID, errorCounterTracker->getStatisticsErrorCounters());
+				timeline.queryErrors = it->second;
+				_entityEnumerationQueryErrors.erase(it);
 			}
+			_entityEnumerationTimelines[entityID] = timeline;
 		}
-	}
+		publishEntitySummary(*entity);
 
-	virtual void clearAllStatisticsCounterValidFlags(la::avdecc::UniqueIdentifier const entityID) noexcept override
+		postOrderedEvent(entityID,
+			[this, entityID, enumerationTime = entity->getEnumerationTime()]()
+			{
+				emit entityOnline(entityID, enumerationTime);
+			},
+			CoalescingEventBus::Batch::EntityOnline);
+	}
+	virtual void onEntityOffline(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity) noexcept override
 	{
-		if (auto* errorCounterTracker = entityErrorCounterTracker(entityID))
+		HIVE_TRACE_SPAN("ControllerManager::onEntityOffline");
+		auto const entityID = entity->getEntity().getEntityID();
+
+		// Still online through another interface, which now forwards the notifications of the entity
+		if (!removeEntityController(controller, entityID))
 		{
-			errorCounterTracker->clearAllStatisticsCounters();
+			return;
 		}
-	}
+		recordEvent(observerTrace::EventType::EntityOffline, entity);
 
-	/* Enumeration and Control Protocol (AECP) */
-	virtual void acquireEntity(la::avdecc::UniqueIdentifier const targetEntityID, bool const isPersistent, AcquireEntityHandler const& handler) noexcept override
-	{
-		auto controller = getController();
-		if (controller)
+		// Removed right away (and not from the Qt Main Thread), so it cannot remove the summary of the next online notification of this entity
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::AcquireEntity);
-			controller->acquireEntity(targetEntityID, isPersistent,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, la::avdecc::UniqueIdentifier const owningEntity) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status, owningEntity);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::AcquireEntity, status);
-					}
-				});
+			auto const lg = std::lock_guard{ _entitySummariesLock };
+			_entitySummaries.erase(entityID);
 		}
-	}
 
-	virtual void releaseEntity(la::avdecc::UniqueIdentifier const targetEntityID, ReleaseEntityHandler const& handler) noexcept override
+		// We absolutely want Entity Removal to be processed in the main thread, so that _entities and _entityErrorCounterTrackers still contain this entity
+		postOrderedEvent(entityID,
+			[this, entityID, entityModelID = entity->getEntity().getEntityModelID()]()
+			{
+				ASSERT_QT_MAIN_THREAD;
+				// Kept as rebooting by the batch listeners until the grace period expires
+				if (_offlineGracePeriod.count() > 0)
+				{
+					_rebootingEntities[entityID] = RebootingEntity{ entityModelID, std::chrono::steady_clock::now() + _offlineGracePeriod };
+				}
+				{
+					auto const lg = std::lock_guard{ _lock };
+					_entities.erase(entityID);
+					_entityErrorCounterTrackers.erase(entityID);
+					_entityAecpCommandLatencies.erase(entityID);
+				}
+				_streamInputMediaLockedStates.erase(entityID);
+				_streamOutputStartedStates.erase(entityID);
+				_backgroundEventBus.discardEntity(entityID);
+				NamePool::getInstance().removeEntity(entityID);
+
+				emit entityOffline(entityID);
+			},
+			CoalescingEventBus::Batch::EntityOffline);
+	}
+	virtual void onEntityCapabilitiesChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onEntityCapabilitiesChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::EntityCapabilitiesChanged, entity))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::ReleaseEntity);
-			controller->releaseEntity(targetEntityID,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, la::avdecc::UniqueIdentifier const /*owningEntity*/) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::ReleaseEntity, status);
-					}
-				});
+			return;
 		}
-	}
+		publishEntitySummary(*entity);
 
-	virtual void lockEntity(la::avdecc::UniqueIdentifier const targetEntityID, LockEntityHandler const& handler) noexcept override
+#pragma message("TODO: Add new signal and listen to it")
+	}
+	virtual void onEntityAssociationChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onEntityAssociationChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::EntityAssociationChanged, entity))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::LockEntity);
-			controller->lockEntity(targetEntityID,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, la::avdecc::UniqueIdentifier const lockingEntity) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status, lockingEntity);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::LockEntity, status);
-					}
-				});
+			return;
 		}
-	}
 
-	virtual void unlockEntity(la::avdecc::UniqueIdentifier const targetEntityID, UnlockEntityHandler const& handler) noexcept override
+#pragma message("TODO: Add new signal and listen to it")
+	}
+	virtual void onGptpChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::UniqueIdentifier const grandMasterID, std::uint8_t const grandMasterDomain) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onGptpChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::GptpChanged, entity, avbInterfaceIndex, grandMasterID, grandMasterDomain))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::UnlockEntity);
-			controller->unlockEntity(targetEntityID,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, la::avdecc::UniqueIdentifier const /*lockingEntity*/) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::UnlockEntity, status);
-					}
-				});
+			return;
 		}
-	}
+		publishEntitySummary(*entity);
 
-	virtual void setConfiguration(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex) noexcept override
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::GptpChanged{ avbInterfaceIndex, grandMasterID, grandMasterDomain });
+	}
+	// Global entity notifications
+	virtual void onUnsolicitedRegistrationChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, bool const isSubscribed) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onUnsolicitedRegistrationChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::UnsolicitedRegistrationChanged, entity, isSubscribed))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::SetConfiguration);
-			controller->setConfiguration(targetEntityID, configurationIndex,
-				[this, targetEntityID](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					emit endAecpCommand(targetEntityID, AecpCommandType::SetConfiguration, status);
-				});
+			return;
 		}
-	}
 
-	virtual void setStreamInputFormat(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat, SetStreamInputFormatHandler const& handler) noexcept override
+#pragma message("TODO: Listen to the Qt signal somewhere and act accordingly")
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::UnsolicitedRegistrationChanged{});
+	}
+	virtual void onCompatibilityFlagsChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::controller::ControlledEntity::CompatibilityFlags const compatibilityFlags) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onCompatibilityFlagsChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::CompatibilityFlagsChanged, entity, compatibilityFlags))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::SetStreamFormat);
-			controller->setStreamInputFormat(targetEntityID, streamIndex, streamFormat,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::SetStreamFormat, status);
-					}
-				});
+			return;
 		}
-	}
 
-	virtual void setStreamOutputFormat(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat, SetStreamOutputFormatHandler const& handler) noexcept override
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::CompatibilityFlagsChanged{ compatibilityFlags });
+	}
+	virtual void onIdentificationStarted(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onIdentificationStarted");
+		if (!forwardEvent(controller, observerTrace::EventType::IdentificationStarted, entity))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::SetStreamFormat);
-			controller->setStreamOutputFormat(targetEntityID, streamIndex, streamFormat,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::SetStreamFormat, status);
-					}
-				});
+			return;
 		}
-	}
 
-	virtual void setStreamOutputInfo(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamInfo const& streamInfo, SetStreamOutputInfoHandler const& handler) noexcept override
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::IdentificationChanged{ true });
+	}
+	virtual void onIdentificationStopped(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onIdentificationStopped");
+		if (!forwardEvent(controller, observerTrace::EventType::IdentificationStopped, entity))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::SetStreamInfo);
-			controller->setStreamOutputInfo(targetEntityID, streamIndex, streamInfo,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::SetStreamInfo, status);
-					}
-				});
+			return;
 		}
-	}
 
-	virtual void setEntityName(la::avdecc::UniqueIdentifier const targetEntityID, QString const& name, SetEntityNameHandler const& handler) noexcept override
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::IdentificationChanged{ false });
+	}
+	// Connection notifications (sniffed ACMP)
+	virtual void onStreamConnectionChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::entity::model::StreamConnectionState const& state, bool const changedByOther) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onStreamConnectionChanged");
+		// Sniffed by all the controllers on the same network, only forward the one from the controller of the listener
+		if (!isForwardingController(controller, state.listenerStream.entityID))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::SetEntityName);
-			controller->setEntityName(targetEntityID, name.toStdString(),
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::SetEntityName, status);
-					}
-				});
+			return;
 		}
-	}
+		_traceRecorder.record(observerTrace::EventType::StreamConnectionChanged, state.listenerStream.entityID, state, changedByOther);
 
-	virtual void setEntityGroupName(la::avdecc::UniqueIdentifier const targetEntityID, QString const& name, SetEntityGroupNameHandler const& handler) noexcept override
+		postOrderedEvent({},
+			[this, state]()
+			{
+				emit streamConnectionChanged(state);
+			});
+	}
+	virtual void onStreamConnectionsChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamConnections const& connections) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onStreamConnectionsChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::StreamConnectionsChanged, entity, streamIndex, connections))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::SetEntityGroupName);
-			controller->setEntityGroupName(targetEntityID, name.toStdString(),
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::SetEntityGroupName, status);
-					}
-				});
+			return;
 		}
-	}
 
-	virtual void setConfigurationName(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, QString const& name, SetConfigurationNameHandler const& handler) noexcept override
+		postOrderedEvent({},
+			[this, stream = la::avdecc::entity::model::StreamIdentification{ entity->getEntity().getEntityID(), streamIndex }, connections]()
+			{
+				emit streamConnectionsChanged(stream, connections);
+			});
+	}
+	// Entity model notifications (unsolicited AECP or changes this controller sent)
+	virtual void onAcquireStateChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::controller::model::AcquireState const acquireState, la::avdecc::UniqueIdentifier const owningEntity) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onAcquireStateChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::AcquireStateChanged, entity, acquireState, owningEntity))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::SetConfigurationName);
-			controller->setConfigurationName(targetEntityID, configurationIndex, name.toStdString(),
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::SetConfigurationName, status);
-					}
-				});
+			return;
 		}
-	}
 
-	virtual void setAudioUnitName(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, QString const& name, SetAudioUnitNameHandler const& handler) noexcept override
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::AcquireStateChanged{ acquireState, owningEntity });
+	}
+	virtual void onLockStateChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::controller::model::LockState const lockState, la::avdecc::UniqueIdentifier const lockingEntity) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onLockStateChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::LockStateChanged, entity, lockState, lockingEntity))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::SetAudioUnitName);
-			controller->setAudioUnitName(targetEntityID, configurationIndex, audioUnitIndex, name.toStdString(),
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::SetAudioUnitName, status);
-					}
-				});
+			return;
 		}
-	}
 
-	virtual void setStreamInputName(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::StreamIndex const streamIndex, QString const& name, SetStreamInputNameHandler const& handler) noexcept override
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::LockStateChanged{ lockState, lockingEntity });
+	}
+	virtual void onStreamInputFormatChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onStreamInputFormatChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::StreamInputFormatChanged, entity, streamIndex, streamFormat))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::SetStreamName);
-			controller->setStreamInputName(targetEntityID, configurationIndex, streamIndex, name.toStdString(),
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::SetStreamName, status);
-					}
-				});
+			return;
 		}
-	}
+		publishEntitySummary(*entity);
 
-	virtual void setStreamOutputName(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::StreamIndex const streamIndex, QString const& name, SetStreamOutputNameHandler const& handler) noexcept override
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::StreamFormatChanged{ la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, streamFormat });
+	}
+	virtual void onStreamOutputFormatChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onStreamOutputFormatChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::StreamOutputFormatChanged, entity, streamIndex, streamFormat))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::SetStreamName);
-			controller->setStreamOutputName(targetEntityID, configurationIndex, streamIndex, name.toStdString(),
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::SetStreamName, status);
-					}
-				});
+			return;
 		}
-	}
+		publishEntitySummary(*entity);
 
-	virtual void setAvbInterfaceName(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, QString const& name, SetAvbInterfaceNameHandler const& handler) noexcept override
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::StreamFormatChanged{ la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, streamFormat });
+	}
+	virtual void onStreamInputDynamicInfoChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamDynamicInfo const& info) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onStreamInputDynamicInfoChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::StreamInputDynamicInfoChanged, entity, streamIndex, info))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::SetAvbInterfaceName);
-			controller->setAvbInterfaceName(targetEntityID, configurationIndex, avbInterfaceIndex, name.toStdString(),
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::SetAvbInterfaceName, status);
-					}
-				});
+			return;
 		}
-	}
 
-	virtual void setClockSourceName(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex, QString const& name, SetClockSourceNameHandler const& handler) noexcept override
+		auto const entityID = entity->getEntity().getEntityID();
+		postCoalescedEvent(entityID, la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, CoalescingEventBus::EventKind::StreamDynamicInfo,
+			[this, entityID, streamIndex, info]()
+			{
+				emit streamDynamicInfoChanged(entityID, la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, info);
+			});
+	}
+	virtual void onStreamOutputDynamicInfoChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamDynamicInfo const& info) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onStreamOutputDynamicInfoChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::StreamOutputDynamicInfoChanged, entity, streamIndex, info))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::SetClockSourceName);
-			controller->setClockSourceName(targetEntityID, configurationIndex, clockSourceIndex, name.toStdString(),
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::SetClockSourceName, status);
-					}
-				});
+			return;
 		}
-	}
 
-	virtual void setMemoryObjectName(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, QString const& name, SetMemoryObjectNameHandler const& handler) noexcept override
+		auto const entityID = entity->getEntity().getEntityID();
+		postCoalescedEvent(entityID, la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, CoalescingEventBus::EventKind::StreamDynamicInfo,
+			[this, entityID, streamIndex, info]()
+			{
+				emit streamDynamicInfoChanged(entityID, la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, info);
+			});
+	}
+	virtual void onEntityNameChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvdeccFixedString const& entityName) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onEntityNameChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::EntityNameChanged, entity, entityName))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::SetMemoryObjectName);
-			controller->setMemoryObjectName(targetEntityID, configurationIndex, memoryObjectIndex, name.toStdString(),
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::SetMemoryObjectName, status);
-					}
-				});
+			return;
 		}
+		publishEntitySummary(*entity);
+
+		auto const entityID = entity->getEntity().getEntityID();
+		auto name = NamePool::getInstance().intern(NamePool::entityNameKey(entityID), QString::fromStdString(entityName)).name;
+		runAfterPendingOrderedEvents(entityID,
+			[this, entityID, name = std::move(name)]()
+			{
+				emit entityNameChanged(entityID, name);
+			});
 	}
+	virtual void onEntityGroupNameChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvdeccFixedString const& entityGroupName) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onEntityGroupNameChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::EntityGroupNameChanged, entity, entityGroupName))
+		{
+			return;
+		}
+		publishEntitySummary(*entity);
 
-	virtual void setAudioClusterName(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClusterIndex const audioClusterIndex, QString const& name, SetAudioClusterNameHandler const& handler) noexcept override
+		auto const entityID = entity->getEntity().getEntityID();
+		auto name = NamePool::getInstance().intern(NamePool::entityGroupNameKey(entityID), QString::fromStdString(entityGroupName)).name;
+		runAfterPendingOrderedEvents(entityID,
+			[this, entityID, name = std::move(name)]()
+			{
+				emit entityGroupNameChanged(entityID, name);
+			});
+	}
+	virtual void onConfigurationNameChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AvdeccFixedString const& configurationName) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onConfigurationNameChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::ConfigurationNameChanged, entity, configurationIndex, configurationName))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::SetAudioClusterName);
-			controller->setAudioClusterName(targetEntityID, configurationIndex, audioClusterIndex, name.toStdString(),
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::SetAudioClusterName, status);
-					}
-				});
+			return;
 		}
+
+		auto const entityID = entity->getEntity().getEntityID();
+		auto name = NamePool::getInstance().intern(NamePool::descriptorNameKey(entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::Configuration, configurationIndex), QString::fromStdString(configurationName)).name;
+		runAfterPendingOrderedEvents(entityID,
+			[this, entityID, configurationIndex, name = std::move(name)]()
+			{
+				emit configurationNameChanged(entityID, configurationIndex, name);
+			});
 	}
+	virtual void onAudioUnitNameChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, la::avdecc::entity::model::AvdeccFixedString const& audioUnitName) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onAudioUnitNameChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::AudioUnitNameChanged, entity, configurationIndex, audioUnitIndex, audioUnitName))
+		{
+			return;
+		}
 
-	virtual void setClockDomainName(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, QString const& name, SetClockDomainNameHandler const& handler) noexcept override
+		auto const entityID = entity->getEntity().getEntityID();
+		auto name = NamePool::getInstance().intern(NamePool::descriptorNameKey(entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::AudioUnit, audioUnitIndex), QString::fromStdString(audioUnitName)).name;
+		runAfterPendingOrderedEvents(entityID,
+			[this, entityID, configurationIndex, audioUnitIndex, name = std::move(name)]()
+			{
+				emit audioUnitNameChanged(entityID, configurationIndex, audioUnitIndex, name);
+			});
+	}
+	virtual void onStreamInputNameChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::AvdeccFixedString const& streamName) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onStreamInputNameChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::StreamInputNameChanged, entity, configurationIndex, streamIndex, streamName))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::SetClockDomainName);
-			controller->setClockDomainName(targetEntityID, configurationIndex, clockDomainIndex, name.toStdString(),
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::SetClockDomainName, status);
-					}
-				});
+			return;
 		}
+
+		auto const entityID = entity->getEntity().getEntityID();
+		auto name = NamePool::getInstance().intern(NamePool::descriptorNameKey(entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex), QString::fromStdString(streamName)).name;
+		runAfterPendingOrderedEvents(entityID,
+			[this, entityID, configurationIndex, streamIndex, name = std::move(name)]()
+			{
+				emit streamNameChanged(entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, name);
+			});
 	}
+	virtual void onStreamOutputNameChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::AvdeccFixedString const& streamName) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onStreamOutputNameChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::StreamOutputNameChanged, entity, configurationIndex, streamIndex, streamName))
+		{
+			return;
+		}
 
-	virtual void setAudioUnitSamplingRate(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, la::avdecc::entity::model::SamplingRate const samplingRate, SetAudioUnitSamplingRateHandler const& handler) noexcept override
+		auto const entityID = entity->getEntity().getEntityID();
+		auto name = NamePool::getInstance().intern(NamePool::descriptorNameKey(entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex), QString::fromStdString(streamName)).name;
+		runAfterPendingOrderedEvents(entityID,
+			[this, entityID, configurationIndex, streamIndex, name = std::move(name)]()
+			{
+				emit streamNameChanged(entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, name);
+			});
+	}
+	virtual void onAvbInterfaceNameChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AvdeccFixedString const& avbInterfaceName) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onAvbInterfaceNameChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::AvbInterfaceNameChanged, entity, configurationIndex, avbInterfaceIndex, avbInterfaceName))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::SetSamplingRate);
-			controller->setAudioUnitSamplingRate(targetEntityID, audioUnitIndex, samplingRate,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::SetSamplingRate, status);
-					}
-				});
+			return;
 		}
+
+		auto const entityID = entity->getEntity().getEntityID();
+		auto name = NamePool::getInstance().intern(NamePool::descriptorNameKey(entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::AvbInterface, avbInterfaceIndex), QString::fromStdString(avbInterfaceName)).name;
+		runAfterPendingOrderedEvents(entityID,
+			[this, entityID, configurationIndex, avbInterfaceIndex, name = std::move(name)]()
+			{
+				emit avbInterfaceNameChanged(entityID, configurationIndex, avbInterfaceIndex, name);
+			});
 	}
+	virtual void onClockSourceNameChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex, la::avdecc::entity::model::AvdeccFixedString const& clockSourceName) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onClockSourceNameChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::ClockSourceNameChanged, entity, configurationIndex, clockSourceIndex, clockSourceName))
+		{
+			return;
+		}
 
-	virtual void setClockSource(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex, SetClockSourceHandler const& handler) noexcept override
+		auto const entityID = entity->getEntity().getEntityID();
+		auto name = NamePool::getInstance().intern(NamePool::descriptorNameKey(entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::ClockSource, clockSourceIndex), QString::fromStdString(clockSourceName)).name;
+		runAfterPendingOrderedEvents(entityID,
+			[this, entityID, configurationIndex, clockSourceIndex, name = std::move(name)]()
+			{
+				emit clockSourceNameChanged(entityID, configurationIndex, clockSourceIndex, name);
+			});
+	}
+	virtual void onMemoryObjectNameChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, la::avdecc::entity::model::AvdeccFixedString const& memoryObjectName) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onMemoryObjectNameChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::MemoryObjectNameChanged, entity, configurationIndex, memoryObjectIndex, memoryObjectName))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::SetClockSource);
-			controller->setClockSource(targetEntityID, clockDomainIndex, clockSourceIndex,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::SetClockSource, status);
-					}
-				});
+			return;
 		}
+
+		auto const entityID = entity->getEntity().getEntityID();
+		auto name = NamePool::getInstance().intern(NamePool::descriptorNameKey(entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::MemoryObject, memoryObjectIndex), QString::fromStdString(memoryObjectName)).name;
+		runAfterPendingOrderedEvents(entityID,
+			[this, entityID, configurationIndex, memoryObjectIndex, name = std::move(name)]()
+			{
+				emit memoryObjectNameChanged(entityID, configurationIndex, memoryObjectIndex, name);
+			});
 	}
+	virtual void onAudioClusterNameChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClusterIndex const audioClusterIndex, la::avdecc::entity::model::AvdeccFixedString const& audioClusterName) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onAudioClusterNameChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::AudioClusterNameChanged, entity, configurationIndex, audioClusterIndex, audioClusterName))
+		{
+			return;
+		}
 
-	virtual void startStreamInput(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamIndex const streamIndex, StartStreamInputHandler const& handler) noexcept override
+		auto const entityID = entity->getEntity().getEntityID();
+		auto name = NamePool::getInstance().intern(NamePool::descriptorNameKey(entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::AudioCluster, audioClusterIndex), QString::fromStdString(audioClusterName)).name;
+		runAfterPendingOrderedEvents(entityID,
+			[this, entityID, configurationIndex, audioClusterIndex, name = std::move(name)]()
+			{
+				emit audioClusterNameChanged(entityID, configurationIndex, audioClusterIndex, name);
+			});
+	}
+	virtual void onClockDomainNameChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::AvdeccFixedString const& clockDomainName) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onClockDomainNameChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::ClockDomainNameChanged, entity, configurationIndex, clockDomainIndex, clockDomainName))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::StartStream);
-			controller->startStreamInput(targetEntityID, streamIndex,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::StartStream, status);
-					}
-				});
+			return;
 		}
+
+		auto const entityID = entity->getEntity().getEntityID();
+		auto name = NamePool::getInstance().intern(NamePool::descriptorNameKey(entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::ClockDomain, clockDomainIndex), QString::fromStdString(clockDomainName)).name;
+		runAfterPendingOrderedEvents(entityID,
+			[this, entityID, configurationIndex, clockDomainIndex, name = std::move(name)]()
+			{
+				emit clockDomainNameChanged(entityID, configurationIndex, clockDomainIndex, name);
+			});
 	}
+	virtual void onAudioUnitSamplingRateChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, la::avdecc::entity::model::SamplingRate const samplingRate) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onAudioUnitSamplingRateChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::AudioUnitSamplingRateChanged, entity, audioUnitIndex, samplingRate))
+		{
+			return;
+		}
 
-	virtual void stopStreamInput(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamIndex const streamIndex, StopStreamInputHandler const& handler) noexcept override
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::AudioUnitSamplingRateChanged{ audioUnitIndex, samplingRate });
+	}
+	virtual void onClockSourceChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onClockSourceChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::ClockSourceChanged, entity, clockDomainIndex, clockSourceIndex))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::StopStream);
-			controller->stopStreamInput(targetEntityID, streamIndex,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::StopStream, status);
-					}
-				});
+			return;
 		}
+
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::ClockSourceChanged{ clockDomainIndex, clockSourceIndex });
 	}
+	virtual void onStreamInputStarted(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onStreamInputStarted");
+		if (!forwardEvent(controller, observerTrace::EventType::StreamInputStarted, entity, streamIndex))
+		{
+			return;
+		}
 
-	virtual void startStreamOutput(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamIndex const streamIndex, StartStreamOutputHandler const& handler) noexcept override
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::StreamRunningChanged{ la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, true });
+	}
+	virtual void onStreamOutputStarted(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onStreamOutputStarted");
+		if (!forwardEvent(controller, observerTrace::EventType::StreamOutputStarted, entity, streamIndex))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::StartStream);
-			controller->startStreamOutput(targetEntityID, streamIndex,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::StartStream, status);
-					}
-				});
+			return;
 		}
+
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::StreamRunningChanged{ la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, true });
 	}
+	virtual void onStreamInputStopped(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onStreamInputStopped");
+		if (!forwardEvent(controller, observerTrace::EventType::StreamInputStopped, entity, streamIndex))
+		{
+			return;
+		}
 
-	virtual void stopStreamOutput(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamIndex const streamIndex, StopStreamOutputHandler const& handler) noexcept override
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::StreamRunningChanged{ la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, false });
+	}
+	virtual void onStreamOutputStopped(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onStreamOutputStopped");
+		if (!forwardEvent(controller, observerTrace::EventType::StreamOutputStopped, entity, streamIndex))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::StopStream);
-			controller->stopStreamOutput(targetEntityID, streamIndex,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::StopStream, status);
-					}
-				});
+			return;
 		}
+
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::StreamRunningChanged{ la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, false });
 	}
+	virtual void onAvbInterfaceInfoChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AvbInterfaceInfo const& info) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onAvbInterfaceInfoChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::AvbInterfaceInfoChanged, entity, avbInterfaceIndex, info))
+		{
+			return;
+		}
 
-	virtual void addStreamPortInputAudioMappings(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamPortIndex const streamPortIndex, la::avdecc::entity::model::AudioMappings const& mappings, AddStreamPortInputAudioMappingsHandler const& handler) noexcept override
+		auto const entityID = entity->getEntity().getEntityID();
+		postCoalescedEvent(entityID, la::avdecc::entity::model::DescriptorType::AvbInterface, avbInterfaceIndex, CoalescingEventBus::EventKind::AvbInterfaceInfo,
+			[this, entityID, avbInterfaceIndex, info]()
+			{
+				emit avbInterfaceInfoChanged(entityID, avbInterfaceIndex, info);
+			});
+	}
+	virtual void onAsPathChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AsPath const& asPath) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onAsPathChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::AsPathChanged, entity, avbInterfaceIndex, asPath))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::AddStreamPortAudioMappings);
-			controller->addStreamPortInputAudioMappings(targetEntityID, streamPortIndex, mappings,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::AddStreamPortAudioMappings, status);
-					}
-				});
+			return;
 		}
+
+		auto const entityID = entity->getEntity().getEntityID();
+		postCoalescedEvent(entityID, la::avdecc::entity::model::DescriptorType::AvbInterface, avbInterfaceIndex, CoalescingEventBus::EventKind::AsPath,
+			[this, entityID, avbInterfaceIndex, asPath]()
+			{
+				emit asPathChanged(entityID, avbInterfaceIndex, asPath);
+			});
 	}
+	virtual void onAvbInterfaceLinkStatusChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::controller::ControlledEntity::InterfaceLinkStatus const linkStatus) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onAvbInterfaceLinkStatusChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::AvbInterfaceLinkStatusChanged, entity, avbInterfaceIndex, linkStatus))
+		{
+			return;
+		}
+		publishEntitySummary(*entity);
 
-	virtual void addStreamPortOutputAudioMappings(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamPortIndex const streamPortIndex, la::avdecc::entity::model::AudioMappings const& mappings, AddStreamPortOutputAudioMappingsHandler const& handler) noexcept override
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::AvbInterfaceLinkStatusChanged{ avbInterfaceIndex, linkStatus });
+	}
+	virtual void onEntityCountersChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::EntityCounters const& counters) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onEntityCountersChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::EntityCountersChanged, entity, counters))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::AddStreamPortAudioMappings);
-			controller->addStreamPortOutputAudioMappings(targetEntityID, streamPortIndex, mappings,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::AddStreamPortAudioMappings, status);
-					}
-				});
+			return;
 		}
+
+		auto const entityID = entity->getEntity().getEntityID();
+		postCoalescedEvent(entityID, la::avdecc::entity::model::DescriptorType::Entity, 0u, CoalescingEventBus::EventKind::EntityCounters,
+			[this, entityID, counters]()
+			{
+				emit entityCountersChanged(entityID, counters);
+			});
 	}
+	virtual void onAvbInterfaceCountersChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AvbInterfaceCounters const& counters) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onAvbInterfaceCountersChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::AvbInterfaceCountersChanged, entity, avbInterfaceIndex, counters))
+		{
+			return;
+		}
 
-	virtual void removeStreamPortInputAudioMappings(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamPortIndex const streamPortIndex, la::avdecc::entity::model::AudioMappings const& mappings, RemoveStreamPortInputAudioMappingsHandler const& handler) noexcept override
+		auto const entityID = entity->getEntity().getEntityID();
+		postCoalescedEvent(entityID, la::avdecc::entity::model::DescriptorType::AvbInterface, avbInterfaceIndex, CoalescingEventBus::EventKind::AvbInterfaceCounters,
+			[this, entityID, avbInterfaceIndex, counters]()
+			{
+				emit avbInterfaceCountersChanged(entityID, avbInterfaceIndex, counters);
+			});
+	}
+	virtual void onClockDomainCountersChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockDomainCounters const& counters) noexcept override
 	{
-		auto controller = getController();
-		if (controller)
+		HIVE_TRACE_SPAN("ControllerManager::onClockDomainCountersChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::ClockDomainCountersChanged, entity, clockDomainIndex, counters))
 		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::RemoveStreamPortAudioMappings);
-			controller->removeStreamPortInputAudioMappings(targetEntityID, streamPortIndex, mappings,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+			return;
+		}
+
+		auto const entityID = entity->getEntity().getEntityID();
+		postCoalescedEvent(entityID, la::avdecc::entity::model::DescriptorType::ClockDomain, clockDomainIndex, CoalescingEventBus::EventKind::ClockDomainCounters,
+			[this, entityID, clockDomainIndex, counters]()
+			{
+				emit clockDomainCountersChanged(entityID, clockDomainIndex, counters);
+			});
+	}
+	virtual void onStreamInputCountersChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamInputCounters const& counters) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onStreamInputCountersChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::StreamInputCountersChanged, entity, streamIndex, counters))
+		{
+			return;
+		}
+
+		auto const entityID = entity->getEntity().getEntityID();
+
+		addStreamInputCountersSample(entityID, streamIndex, counters);
+
+		if (auto* errorCounterFlags = entityErrorCounterTracker(entityID))
+		{
+			auto changed = false;
+
+			for (auto const [flag, counter] : counters)
+			{
+				switch (flag)
+				{
+					case la::avdecc::entity::StreamInputCounterValidFlag::MediaUnlocked:
+					{
+						try
+						{
+							auto const& entityNode = entity->getEntityNode();
+							auto const& streamNode = entity->getStreamInputNode(entityNode.dynamicModel->currentConfiguration, streamIndex);
+							if (streamNode.dynamicModel->connectionState.state != la::avdecc::entity::model::StreamConnectionState::State::Connected)
+							{
+								// Only consider MediaUnlocked as an error if the stream is connected, otherwise juste ignore this
+								break;
+							}
+						}
+						catch (la::avdecc::controller::ControlledEntity::Exception const&)
+						{
+							// Ignore exception
+							break;
+						}
+						catch (...)
+						{
+							// Uncaught exception
+							AVDECC_ASSERT(false, "Uncaught exception");
+							break;
+						}
+						[[fallthrough]];
 					}
-					else
+					case la::avdecc::entity::StreamInputCounterValidFlag::StreamInterrupted:
+					case la::avdecc::entity::StreamInputCounterValidFlag::SeqNumMismatch:
+					case la::avdecc::entity::StreamInputCounterValidFlag::LateTimestamp:
+					case la::avdecc::entity::StreamInputCounterValidFlag::EarlyTimestamp:
+					case la::avdecc::entity::StreamInputCounterValidFlag::UnsupportedFormat:
+						changed |= errorCounterFlags->setStreamInputCounter(streamIndex, flag, counter);
+						break;
+					default:
+						break;
+				}
+			}
+
+			if (changed)
+			{
+				// Error counters are computed when the event is delivered, so a clear done in the meantime is not overridden by a stale value
+				postCoalescedEvent(entityID, la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, CoalescingEventBus::EventKind::StreamInputErrorCounters,
+					[this, entityID, streamIndex]()
 					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::RemoveStreamPortAudioMappings, status);
+						emit streamInputErrorCounterChanged(entityID, streamIndex, getStreamInputErrorCounters(entityID, streamIndex));
+					});
+			}
+		}
+
+		// Lock state transitions are detected when delivered, most counters updates don't change it
+		if (auto const isLocked = isMediaLocked(counters))
+		{
+			postCoalescedEvent(entityID, la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, CoalescingEventBus::EventKind::StreamInputMediaLocked,
+				[this, entityID, streamIndex, isLocked = *isLocked]()
+				{
+					if (updateStreamState(_streamInputMediaLockedStates, entityID, streamIndex, isLocked))
+					{
+						emit streamInputMediaLockedChanged(entityID, streamIndex, isLocked);
+					}
+				});
+		}
+
+		postCoalescedEvent(entityID, la::avdecc::entity::model::DescriptorType::StreamInput, streamIndex, CoalescingEventBus::EventKind::StreamInputCounters,
+			[this, entityID, streamIndex, counters]()
+			{
+				emit streamInputCountersChanged(entityID, streamIndex, counters);
+			});
+	}
+	virtual void onStreamOutputCountersChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamOutputCounters const& counters) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onStreamOutputCountersChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::StreamOutputCountersChanged, entity, streamIndex, counters))
+		{
+			return;
+		}
+
+		auto const entityID = entity->getEntity().getEntityID();
+
+		// Streaming state transitions are detected when delivered, most counters updates don't change it
+		if (auto const isStarted = isStreamStarted(counters))
+		{
+			postCoalescedEvent(entityID, la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, CoalescingEventBus::EventKind::StreamOutputStarted,
+				[this, entityID, streamIndex, isStarted = *isStarted]()
+				{
+					if (updateStreamState(_streamOutputStartedStates, entityID, streamIndex, isStarted))
+					{
+						emit streamOutputStartedChanged(entityID, streamIndex, isStarted);
 					}
 				});
 		}
+
+		postCoalescedEvent(entityID, la::avdecc::entity::model::DescriptorType::StreamOutput, streamIndex, CoalescingEventBus::EventKind::StreamOutputCounters,
+			[this, entityID, streamIndex, counters]()
+			{
+				emit streamOutputCountersChanged(entityID, streamIndex, counters);
+			});
+	}
+	virtual void onMemoryObjectLengthChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, std::uint64_t const length) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onMemoryObjectLengthChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::MemoryObjectLengthChanged, entity, configurationIndex, memoryObjectIndex, length))
+		{
+			return;
+		}
+
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::MemoryObjectLengthChanged{ configurationIndex, memoryObjectIndex, length });
+	}
+	virtual void onStreamPortInputAudioMappingsChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamPortIndex const streamPortIndex) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onStreamPortInputAudioMappingsChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::StreamPortInputAudioMappingsChanged, entity, streamPortIndex))
+		{
+			return;
+		}
+
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::StreamPortAudioMappingsChanged{ la::avdecc::entity::model::DescriptorType::StreamPortInput, streamPortIndex });
+	}
+	virtual void onStreamPortOutputAudioMappingsChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::StreamPortIndex const streamPortIndex) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onStreamPortOutputAudioMappingsChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::StreamPortOutputAudioMappingsChanged, entity, streamPortIndex))
+		{
+			return;
+		}
+
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::StreamPortAudioMappingsChanged{ la::avdecc::entity::model::DescriptorType::StreamPortOutput, streamPortIndex });
+	}
+	virtual void onOperationProgress(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, la::avdecc::entity::model::OperationID const operationID, float const percentComplete) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onOperationProgress");
+		if (!forwardEvent(controller, observerTrace::EventType::OperationProgress, entity, descriptorType, descriptorIndex, operationID, percentComplete))
+		{
+			return;
+		}
+
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::OperationProgress{ descriptorType, descriptorIndex, operationID, percentComplete });
+	}
+	virtual void onOperationCompleted(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, la::avdecc::entity::model::OperationID const operationID, bool const failed) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onOperationCompleted");
+		if (!forwardEvent(controller, observerTrace::EventType::OperationCompleted, entity, descriptorType, descriptorIndex, operationID, failed))
+		{
+			return;
+		}
+
+		postObserverHandoff(entity->getEntity().getEntityID(), ObserverHandoff::OperationCompleted{ descriptorType, descriptorIndex, operationID, failed });
+	}
+	// Statistics
+	virtual void onAecpRetryCounterChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, std::uint64_t const value) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onAecpRetryCounterChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::AecpRetryCounterChanged, entity, value))
+		{
+			return;
+		}
+
+		auto const entityID = entity->getEntity().getEntityID();
+
+		addStatisticsCounterSample(entityID, StatisticsErrorCounterFlag::AecpRetries, value);
+
+		if (auto* errorCounterFlags = entityErrorCounterTracker(entityID))
+		{
+			if (errorCounterFlags->setStatisticsCounter(StatisticsErrorCounterFlag::AecpRetries, value))
+			{
+				postStatisticsErrorCounterChanged(entityID);
+			}
+		}
+
+		postCoalescedEvent(entityID, la::avdecc::entity::model::DescriptorType::Entity, 0u, CoalescingEventBus::EventKind::AecpRetryCounter,
+			[this, entityID, value]()
+			{
+				emit aecpRetryCounterChanged(entityID, value);
+			});
+	}
+	virtual void onAecpTimeoutCounterChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, std::uint64_t const value) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onAecpTimeoutCounterChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::AecpTimeoutCounterChanged, entity, value))
+		{
+			return;
+		}
+
+		auto const entityID = entity->getEntity().getEntityID();
+
+		addStatisticsCounterSample(entityID, StatisticsErrorCounterFlag::AecpTimeouts, value);
+
+		if (auto* errorCounterFlags = entityErrorCounterTracker(entityID))
+		{
+			if (errorCounterFlags->setStatisticsCounter(StatisticsErrorCounterFlag::AecpTimeouts, value))
+			{
+				postStatisticsErrorCounterChanged(entityID);
+			}
+		}
+
+		postCoalescedEvent(entityID, la::avdecc::entity::model::DescriptorType::Entity, 0u, CoalescingEventBus::EventKind::AecpTimeoutCounter,
+			[this, entityID, value]()
+			{
+				emit aecpTimeoutCounterChanged(entityID, value);
+			});
+	}
+	virtual void onAecpUnexpectedResponseCounterChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, std::uint64_t const value) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onAecpUnexpectedResponseCounterChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::AecpUnexpectedResponseCounterChanged, entity, value))
+		{
+			return;
+		}
+
+		auto const entityID = entity->getEntity().getEntityID();
+
+		addStatisticsCounterSample(entityID, StatisticsErrorCounterFlag::AecpUnexpectedResponses, value);
+
+		if (auto* errorCounterFlags = entityErrorCounterTracker(entityID))
+		{
+			if (errorCounterFlags->setStatisticsCounter(StatisticsErrorCounterFlag::AecpUnexpectedResponses, value))
+			{
+				postStatisticsErrorCounterChanged(entityID);
+			}
+		}
+
+		postCoalescedEvent(entityID, la::avdecc::entity::model::DescriptorType::Entity, 0u, CoalescingEventBus::EventKind::AecpUnexpectedResponseCounter,
+			[this, entityID, value]()
+			{
+				emit aecpUnexpectedResponseCounterChanged(entityID, value);
+			});
+	}
+	virtual void onAecpResponseAverageTimeChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, std::chrono::milliseconds const& value) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onAecpResponseAverageTimeChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::AecpResponseAverageTimeChanged, entity, value))
+		{
+			return;
+		}
+
+		auto const entityID = entity->getEntity().getEntityID();
+		postCoalescedEvent(entityID, la::avdecc::entity::model::DescriptorType::Entity, 0u, CoalescingEventBus::EventKind::AecpResponseAverageTime,
+			[this, entityID, value]()
+			{
+				emit aecpResponseAverageTimeChanged(entityID, value);
+			});
+	}
+	virtual void onAemAecpUnsolicitedCounterChanged(la::avdecc::controller::Controller const* const controller, la::avdecc::controller::ControlledEntity const* const entity, std::uint64_t const value) noexcept override
+	{
+		HIVE_TRACE_SPAN("ControllerManager::onAemAecpUnsolicitedCounterChanged");
+		if (!forwardEvent(controller, observerTrace::EventType::AemAecpUnsolicitedCounterChanged, entity, value))
+		{
+			return;
+		}
+
+		auto const entityID = entity->getEntity().getEntityID();
+		postCoalescedEvent(entityID, la::avdecc::entity::model::DescriptorType::Entity, 0u, CoalescingEventBus::EventKind::AemAecpUnsolicitedCounter,
+			[this, entityID, value]()
+			{
+				emit aemAecpUnsolicitedCounterChanged(entityID, value);
+			});
+	}
+
+	// ControllerManager overrides
+	virtual void createController(la::avdecc::protocol::ProtocolInterface::Type const protocolInterfaceType, QString const& interfaceName, std::uint16_t const progID, la::avdecc::UniqueIdentifier const entityModelID, QString const& preferedLocale, QStringList const& secondaryInterfaceNames) override
+	{
+		// If we have a previous controller, remove it
+		if (_controller)
+		{
+			destroyController();
+		}
+
+		instantiateControllers(ControllerConfiguration{ protocolInterfaceType, interfaceName, progID, entityModelID, preferedLocale, secondaryInterfaceNames });
+	}
+
+	virtual void destroyController() noexcept override
+	{
+		if (_controller)
+		{
+			releaseControllers();
+
+			// Wipe all entities
+			{
+				auto const lg = std::lock_guard{ _lock };
+				_entities.clear();
+				_entityErrorCounterTrackers.clear();
+				_entityAecpCommandLatencies.clear();
+				_entityEnumerationTimelines.clear();
+				_entityEnumerationQueryErrors.clear();
+			}
+			{
+				auto const lg = std::lock_guard{ _entitySummariesLock };
+				_entitySummaries.clear();
+			}
+			_streamInputMediaLockedStates.clear();
+			_streamOutputStartedStates.clear();
+			_rebootingEntities.clear();
+			_gracePeriodTimer.stop();
+			_controllerConfiguration.reset();
+
+			// Notify
+			emit controllerOffline();
+		}
+		else
+		{
+			// A replay feeds notifications of the controller, stop it first
+			stopObserverTraceReplay();
+		}
+	}
+
+	virtual void reloadController() override
+	{
+		ASSERT_QT_MAIN_THREAD;
+
+		if (!_controller || !_controllerConfiguration)
+		{
+			return;
+		}
+		auto const configuration = *_controllerConfiguration;
+
+		// The entities are expected back: handle them as rebooting ones (their entity model being kept in the enumeration timelines), so the models keep them
+		auto entityIDs = EntityIDs{};
+		{
+			auto const expiresAt = std::chrono::steady_clock::now() + std::max(_offlineGracePeriod, std::chrono::seconds{ SoftReloadGracePeriod });
+			auto const lg = std::lock_guard{ _lock };
+			entityIDs.reserve(_entities.size());
+			for (auto const entityID : _entities)
+			{
+				auto entityModelID = la::avdecc::UniqueIdentifier{};
+				if (auto const it = _entityEnumerationTimelines.find(entityID); it != _entityEnumerationTimelines.end())
+				{
+					entityModelID = it->second.entityModelID;
+				}
+				_rebootingEntities[entityID] = RebootingEntity{ entityModelID, expiresAt };
+				entityIDs.push_back(entityID);
+			}
+		}
+
+		releaseControllers();
+
+		// Same cleanup than an entity going offline, the controllers being gone they will not notify it
+		{
+			auto const lg = std::lock_guard{ _lock };
+			_entities.clear();
+			_entityErrorCounterTrackers.clear();
+			_entityAecpCommandLatencies.clear();
+		}
+		{
+			auto const lg = std::lock_guard{ _entitySummariesLock };
+			_entitySummaries.clear();
+		}
+		_streamInputMediaLockedStates.clear();
+		_streamOutputStartedStates.clear();
+		for (auto const entityID : entityIDs)
+		{
+			NamePool::getInstance().removeEntity(entityID);
+			emit entityOffline(entityID);
+		}
+		if (!entityIDs.empty())
+		{
+			emitEntitiesOffline(entityIDs);
+		}
+
+		instantiateControllers(configuration);
+	}
+
+	virtual la::avdecc::UniqueIdentifier getControllerEID() const noexcept override
+	{
+		auto controller = getController();
+		if (controller)
+		{
+			return controller->getControllerEID();
+		}
+		return la::avdecc::UniqueIdentifier{};
+	}
+
+	virtual la::avdecc::controller::ControlledEntityGuard getControlledEntity(la::avdecc::UniqueIdentifier const entityID) const noexcept override
+	{
+		auto controller = getController(entityID);
+		if (controller)
+		{
+			return controller->getControlledEntityGuard(entityID);
+		}
+		return {};
+	}
+
+	virtual SharedEntitySummary getEntitySummary(la::avdecc::UniqueIdentifier const entityID) const noexcept override
+	{
+		auto const lg = std::lock_guard{ _entitySummariesLock };
+		if (auto const it = _entitySummaries.find(entityID); it != _entitySummaries.end())
+		{
+			return it->second;
+		}
+		return {};
+	}
+
+	virtual std::tuple<la::avdecc::jsonSerializer::SerializationError, std::string> serializeAllControlledEntitiesAsJson(QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags, QString const& dumpSource) const noexcept override
+	{
+		auto controller = getController();
+		if (controller)
+		{
+			return controller->serializeAllControlledEntitiesAsJson(filePath.toStdString(), flags, dumpSource.toStdString(), true);
+		}
+		return { la::avdecc::jsonSerializer::SerializationError::InternalError, "Controller offline" };
+	}
+
+	virtual std::tuple<la::avdecc::jsonSerializer::SerializationError, std::string> serializeControlledEntityAsJson(la::avdecc::UniqueIdentifier const entityID, QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags, QString const& dumpSource) const noexcept override
+	{
+		auto controller = getController(entityID);
+		if (controller)
+		{
+			return controller->serializeControlledEntityAsJson(entityID, filePath.toStdString(), flags, dumpSource.toStdString());
+		}
+		return { la::avdecc::jsonSerializer::SerializationError::InternalError, "Controller offline" };
+	}
+
+	virtual std::tuple<la::avdecc::jsonSerializer::DeserializationError, std::string> loadEntityModelFile(QString const& filePath) noexcept override
+	{
+		auto controller = getController();
+		if (controller)
+		{
+			return controller->loadEntityModelFile(filePath.toStdString());
+		}
+		return { la::avdecc::jsonSerializer::DeserializationError::InternalError, "Controller offline" };
+	}
+
+	virtual std::tuple<la::avdecc::jsonSerializer::DeserializationError, std::string> loadVirtualEntityFromJson(QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags) noexcept override
+	{
+		auto controller = getController();
+		if (controller)
+		{
+			return controller->loadVirtualEntityFromJson(filePath.toStdString(), flags);
+		}
+		return { la::avdecc::jsonSerializer::DeserializationError::InternalError, "Controller offline" };
+	}
+
+	virtual void loadVirtualEntitiesFromFiles(QStringList const& filePaths, la::avdecc::entity::model::jsonSerializer::Flags const flags, LoadVirtualEntitiesHandler const& handler) noexcept override
+	{
+		struct LoadState
+		{
+			std::vector<LoadVirtualEntityResult> results{};
+			std::atomic<size_t> remaining{ 0u };
+		};
+
+		auto const state = std::make_shared<LoadState>();
+		state->results.resize(static_cast<size_t>(filePaths.size()));
+		state->remaining = state->results.size();
+
+		if (filePaths.isEmpty())
+		{
+			QMetaObject::invokeMethod(this,
+				[handler, state]()
+				{
+					la::avdecc::utils::invokeProtectedHandler(handler, state->results);
+				},
+				Qt::QueuedConnection);
+			return;
+		}
+
+		// Each task only writes its own result slot, the last one to complete notifies the handler. The ControllerManager's entityOnline notifications are batched by the event bus
+		for (auto index = 0; index < filePaths.size(); ++index)
+		{
+			auto const& filePath = filePaths[index];
+			auto fileFlags = flags;
+			if (QFileInfo{ filePath }.suffix().compare("json", Qt::CaseInsensitive) == 0)
+			{
+				fileFlags.reset(la::avdecc::entity::model::jsonSerializer::Flag::BinaryFormat);
+			}
+			else
+			{
+				fileFlags.set(la::avdecc::entity::model::jsonSerializer::Flag::BinaryFormat);
+			}
+
+			_virtualEntityLoaderPool.start(new PoolTask{
+				[this, handler, state, index, filePath, fileFlags]()
+				{
+					auto const [error, message] = loadVirtualEntityFromJson(filePath, fileFlags);
+					state->results[static_cast<size_t>(index)] = LoadVirtualEntityResult{ filePath, error, message };
+
+					if (--state->remaining == 0u)
+					{
+						QMetaObject::invokeMethod(this,
+							[handler, state]()
+							{
+								la::avdecc::utils::invokeProtectedHandler(handler, state->results);
+							});
+					}
+				} });
+		}
+	}
+
+	virtual bool startObserverTraceRecording(QString const& filePath) noexcept override
+	{
+		return _traceRecorder.start(filePath);
+	}
+
+	virtual void stopObserverTraceRecording() noexcept override
+	{
+		_traceRecorder.stop();
+	}
+
+	virtual bool isRecordingObserverTrace() const noexcept override
+	{
+		return _traceRecorder.isRecording();
+	}
+
+	virtual bool startObserverTraceReplay(QString const& filePath, bool const originalTiming) noexcept override
+	{
+		stopObserverTraceReplay();
+
+		auto reader = observerTrace::Reader{};
+		if (!getController() || !reader.open(filePath))
+		{
+			return false;
+		}
+
+		// Notifications are replayed from a dedicated thread, like the avdecc library does
+		_observerTraceReplayAborted = false;
+		try
+		{
+			_observerTraceReplayThread = std::thread{
+				[this, reader = std::move(reader), originalTiming]() mutable
+				{
+					replayObserverTrace(std::move(reader), originalTiming);
+				}
+			};
+		}
+		catch (...)
+		{
+			return false;
+		}
+		return true;
+	}
+
+	virtual void stopObserverTraceReplay() noexcept override
+	{
+		if (_observerTraceReplayThread.joinable())
+		{
+			_observerTraceReplayAborted = true;
+			_observerTraceReplayThread.join();
+		}
+	}
+
+	virtual bool startStressLoad(stressLoad::Parameters const& parameters) noexcept override
+	{
+		stopObserverTraceReplay();
+
+		if (!getController())
+		{
+			return false;
+		}
+
+		// Captured once, the generator then only works on its own copy of the network
+		auto entities = stressLoad::EntityInfos{};
+		mapReduceEntities(
+			[](la::avdecc::UniqueIdentifier const&, la::avdecc::controller::ControlledEntity const& controlledEntity)
+			{
+				return stressLoad::makeEntityInfo(controlledEntity);
+			},
+			[&entities](la::avdecc::UniqueIdentifier const&, std::optional<stressLoad::EntityInfo>&& info)
+			{
+				if (info)
+				{
+					entities.push_back(std::move(*info));
+				}
+			});
+		if (entities.empty())
+		{
+			return false;
+		}
+
+		// Events are fed from a dedicated thread, like the avdecc library does
+		_observerTraceReplayAborted = false;
+		try
+		{
+			auto generator = std::make_unique<stressLoad::Generator>(parameters, std::move(entities));
+			_isStressLoadRunning = true;
+			_observerTraceReplayThread = std::thread{
+				[this, generator = std::move(generator)]()
+				{
+					runStressLoad(*generator);
+				}
+			};
+		}
+		catch (...)
+		{
+			_isStressLoadRunning = false;
+			return false;
+		}
+		return true;
+	}
+
+	virtual void stopStressLoad() noexcept override
+	{
+		stopObserverTraceReplay();
+	}
+
+	virtual bool isStressLoadRunning() const noexcept override
+	{
+		return _isStressLoadRunning;
+	}
+
+	ErrorCounterTracker const* entityErrorCounterTracker(la::avdecc::UniqueIdentifier const entityID) const noexcept
+	{
+		auto const lg = std::lock_guard{ _lock };
+
+		auto const it = _entityErrorCounterTrackers.find(entityID);
+		if (it != std::end(_entityErrorCounterTrackers))
+		{
+			return &it->second;
+		}
+
+		return nullptr;
+	}
+
+	ErrorCounterTracker* entityErrorCounterTracker(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		return const_cast<ErrorCounterTracker*>(static_cast<ControllerManagerImpl const*>(this)->entityErrorCounterTracker(entityID));
+	}
+
+	// Counters history is written from the avdecc threads and read from the Qt Main Thread, always access it with the lock held
+	void addStreamInputCountersSample(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamInputCounters const& counters) noexcept
+	{
+		auto const now = CounterHistory::Clock::now();
+		auto const lg = std::lock_guard{ _lock };
+
+		if (auto const it = _entityErrorCounterTrackers.find(entityID); it != std::end(_entityErrorCounterTrackers))
+		{
+			it->second.addStreamInputCountersSample(streamIndex, counters, now);
+		}
+	}
+
+	void addStatisticsCounterSample(la::avdecc::UniqueIdentifier const entityID, StatisticsErrorCounterFlag const flag, std::uint64_t const value) noexcept
+	{
+		auto const now = CounterHistory::Clock::now();
+		auto const lg = std::lock_guard{ _lock };
+
+		if (auto const it = _entityErrorCounterTrackers.find(entityID); it != std::end(_entityErrorCounterTrackers))
+		{
+			it->second.addStatisticsCounterSample(flag, value, now);
+		}
+	}
+
+	// AECP commands latency is recorded from the avdecc threads and read from the Qt Main Thread, always access it with the lock held
+	void addAecpCommandLatency(la::avdecc::UniqueIdentifier const entityID, AecpCommandType const commandType, std::chrono::steady_clock::time_point const& commandStartTime) noexcept
+	{
+		auto const latency = std::chrono::duration_cast<LatencyHistogram::Duration>(std::chrono::steady_clock::now() - commandStartTime);
+		auto const lg = std::lock_guard{ _lock };
+
+		// Only track online entities (an entity going offline discards its latencies)
+		if (_entities.count(entityID) == 0)
+		{
+			return;
+		}
+
+		auto& latencies = _entityAecpCommandLatencies[entityID];
+		latencies.allCommands.add(latency);
+		latencies.perCommandType[commandType].add(latency);
+	}
+
+	virtual std::optional<EnumerationTimeline> getEnumerationTimeline(la::avdecc::UniqueIdentifier const entityID) const noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+
+		if (auto const it = _entityEnumerationTimelines.find(entityID); it != std::end(_entityEnumerationTimelines))
+		{
+			return it->second;
+		}
+
+		return std::nullopt;
+	}
+
+	virtual EnumerationTimelines getEnumerationTimelines() const noexcept override
+	{
+		auto timelines = EnumerationTimelines{};
+		{
+			auto const lg = std::lock_guard{ _lock };
+			timelines.assign(_entityEnumerationTimelines.begin(), _entityEnumerationTimelines.end());
+		}
+
+		std::sort(timelines.begin(), timelines.end(),
+			[](auto const& lhs, auto const& rhs)
+			{
+				return lhs.second.discoveredAt < rhs.second.discoveredAt;
+			});
+
+		return timelines;
+	}
+
+	virtual void setVisibleEntities(EntityIDs const& entityIDs) noexcept override
+	{
+		ASSERT_QT_MAIN_THREAD;
+
+		{
+			auto const lg = std::lock_guard{ _interestLock };
+			_visibleEntities = EntitySet{ entityIDs.begin(), entityIDs.end() };
+		}
+
+		// Entities which just became visible get their pending values right away
+		drainBackgroundEventBus();
+	}
+
+	virtual void setSelectedEntity(la::avdecc::UniqueIdentifier const entityID) noexcept override
+	{
+		ASSERT_QT_MAIN_THREAD;
+
+		{
+			auto const lg = std::lock_guard{ _interestLock };
+			if (_selectedEntity == entityID)
+			{
+				return;
+			}
+			_selectedEntity = entityID;
+		}
+
+		drainBackgroundEventBus();
+	}
+
+	virtual bool isEntityOfInterest(la::avdecc::UniqueIdentifier const entityID) const noexcept override
+	{
+		if (!_visibilityDrivenNotifications)
+		{
+			return true;
+		}
+
+		auto const lg = std::lock_guard{ _interestLock };
+		return entityID == _selectedEntity || _visibleEntities.count(entityID) != 0 || _watchedEntities.count(entityID) != 0;
+	}
+
+	virtual AecpCommandLatencies getAecpCommandLatencies(la::avdecc::UniqueIdentifier const entityID) const noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+
+		if (auto const it = _entityAecpCommandLatencies.find(entityID); it != std::end(_entityAecpCommandLatencies))
+		{
+			return it->second;
+		}
+		return {};
+	}
+
+	virtual StreamInputCountersHistory getStreamInputCountersHistory(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex) const noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+
+		if (auto const it = _entityErrorCounterTrackers.find(entityID); it != std::end(_entityErrorCounterTrackers))
+		{
+			return it->second.getStreamInputCountersHistory(streamIndex);
+		}
+		return {};
+	}
+
+	virtual StatisticsCountersHistory getStatisticsCountersHistory(la::avdecc::UniqueIdentifier const entityID) const noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+
+		if (auto const it = _entityErrorCounterTrackers.find(entityID); it != std::end(_entityErrorCounterTrackers))
+		{
+			return it->second.getStatisticsCountersHistory();
+		}
+		return {};
+	}
+
+	virtual StreamInputErrorCounters getStreamInputErrorCounters(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex) const noexcept override
+	{
+		if (auto* errorCounterTracker = entityErrorCounterTracker(entityID))
+		{
+			return errorCounterTracker->getStreamInputErrorCounters(streamIndex);
+		}
+		return {};
+	}
+
+	virtual void clearStreamInputCounterValidFlags(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::StreamInputCounterValidFlag const flag) noexcept override
+	{
+		if (auto* errorCounterTracker = entityErrorCounterTracker(entityID))
+		{
+			if (errorCounterTracker->clearStreamInputCounter(streamIndex, flag))
+			{
+				emit streamInputErrorCounterChanged(entityID, streamIndex, errorCounterTracker->getStreamInputErrorCounters(streamIndex));
+			}
+		}
+	}
+
+	virtual void clearAllStreamInputCounterValidFlags(la::avdecc::UniqueIdentifier const entityID) noexcept override
+	{
+		if (auto* errorCounterTracker = entityErrorCounterTracker(entityID))
+		{
+			errorCounterTracker->clearAllStreamInputCounters();
+		}
+	}
+
+	virtual StatisticsErrorCounters getStatisticsCounters(la::avdecc::UniqueIdentifier const entityID) const noexcept override
+	{
+		if (auto* errorCounterTracker = entityErrorCounterTracker(entityID))
+		{
+			return errorCounterTracker->getStatisticsErrorCounters();
+		}
+		return {};
+	}
+
+	virtual void clearStatisticsCounterValidFlags(la::avdecc::UniqueIdentifier const entityID, StatisticsErrorCounterFlag const flag) noexcept override
+	{
+		if (auto* errorCounterTracker = entityErrorCounterTracker(entityID))
+		{
+			if (errorCounterTracker->clearStatisticsCounter(flag))
+			{
+				emit statisticsErrorCounterChanged(entityID, errorCounterTracker->getStatisticsErrorCounters());
+			}
+		}
+	}
+
+	virtual void clearAllStatisticsCounterValidFlags(la::avdecc::UniqueIdentifier const entityID) noexcept override
+	{
+		if (auto* errorCounterTracker = entityErrorCounterTracker(entityID))
+		{
+			errorCounterTracker->clearAllStatisticsCounters();
+		}
+	}
+
+	/* Enumeration and Control Protocol (AECP) */
+	virtual void acquireEntity(la::avdecc::UniqueIdentifier const targetEntityID, bool const isPersistent, AcquireEntityHandler const& handler) noexcept override
+	{
+		auto controller = getController(targetEntityID);
+		if (controller)
+		{
+			emit beginAecpCommand(targetEntityID, AecpCommandType::AcquireEntity);
+			controller->acquireEntity(targetEntityID, isPersistent,
+				[this, targetEntityID, handler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, la::avdecc::UniqueIdentifier const owningEntity) noexcept
+				{
+					addAecpCommandLatency(targetEntityID, AecpCommandType::AcquireEntity, commandStartTime);
+
+					if (handler)
+					{
+						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status, owningEntity);
+					}
+					else
+					{
+						emit endAecpCommand(targetEntityID, AecpCommandType::AcquireEntity, status);
+					}
+				});
+		}
+	}
+
+	virtual void releaseEntity(la::avdecc::UniqueIdentifier const targetEntityID, ReleaseEntityHandler const& handler) noexcept override
+	{
+		auto controller = getController(targetEntityID);
+		if (controller)
+		{
+			emit beginAecpCommand(targetEntityID, AecpCommandType::ReleaseEntity);
+			controller->releaseEntity(targetEntityID,
+				[this, targetEntityID, handler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, la::avdecc::UniqueIdentifier const /*owningEntity*/) noexcept
+				{
+					addAecpCommandLatency(targetEntityID, AecpCommandType::ReleaseEntity, commandStartTime);
+
+					if (handler)
+					{
+						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+					}
+					else
+					{
+						emit endAecpCommand(targetEntityID, AecpCommandType::ReleaseEntity, status);
+					}
+				});
+		}
+	}
+
+	virtual void lockEntity(la::avdecc::UniqueIdentifier const targetEntityID, LockEntityHandler const& handler) noexcept override
+	{
+		auto controller = getController(targetEntityID);
+		if (controller)
+		{
+			emit beginAecpCommand(targetEntityID, AecpCommandType::LockEntity);
+			controller->lockEntity(targetEntityID,
+				[this, targetEntityID, handler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, la::avdecc::UniqueIdentifier const lockingEntity) noexcept
+				{
+					addAecpCommandLatency(targetEntityID, AecpCommandType::LockEntity, commandStartTime);
+
+					if (handler)
+					{
+						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status, lockingEntity);
+					}
+					else
+					{
+						emit endAecpCommand(targetEntityID, AecpCommandType::LockEntity, status);
+					}
+				});
+		}
+	}
+
+	virtual void unlockEntity(la::avdecc::UniqueIdentifier const targetEntityID, UnlockEntityHandler const& handler) noexcept override
+	{
+		auto controller = getController(targetEntityID);
+		if (controller)
+		{
+			emit beginAecpCommand(targetEntityID, AecpCommandType::UnlockEntity);
+			controller->unlockEntity(targetEntityID,
+				[this, targetEntityID, handler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, la::avdecc::UniqueIdentifier const /*lockingEntity*/) noexcept
+				{
+					addAecpCommandLatency(targetEntityID, AecpCommandType::UnlockEntity, commandStartTime);
+
+					if (handler)
+					{
+						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+					}
+					else
+					{
+						emit endAecpCommand(targetEntityID, AecpCommandType::UnlockEntity, status);
+					}
+				});
+		}
+	}
+
+	virtual void setConfiguration(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex) noexcept override
+	{
+		auto controller = getController(targetEntityID);
+		if (controller)
+		{
+			emit beginAecpCommand(targetEntityID, AecpCommandType::SetConfiguration);
+			controller->setConfiguration(targetEntityID, configurationIndex,
+				[this, targetEntityID, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+				{
+					addAecpCommandLatency(targetEntityID, AecpCommandType::SetConfiguration, commandStartTime);
+
+					emit endAecpCommand(targetEntityID, AecpCommandType::SetConfiguration, status);
+				});
+		}
+	}
+
+	virtual void setStreamInputFormat(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat, SetStreamInputFormatHandler const& handler) noexcept override
+	{
+		sendCoalescedAecpCommand(CoalescedAecpCommandKey{ targetEntityID, AecpCommandType::SetStreamFormat, la::avdecc::entity::model::DescriptorType::StreamInput, 0u, streamIndex }, handler,
+			[this, targetEntityID, streamIndex, streamFormat, handler](CoalescedAecpCommandCompletionHandler const& completionHandler)
+			{
+				auto controller = getController(targetEntityID);
+				if (!controller)
+				{
+					return false;
+				}
+
+				emit beginAecpCommand(targetEntityID, AecpCommandType::SetStreamFormat);
+				controller->setStreamInputFormat(targetEntityID, streamIndex, streamFormat,
+					[this, targetEntityID, handler, completionHandler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+					{
+						addAecpCommandLatency(targetEntityID, AecpCommandType::SetStreamFormat, commandStartTime);
+
+						if (handler)
+						{
+							la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+						}
+						else
+						{
+							emit endAecpCommand(targetEntityID, AecpCommandType::SetStreamFormat, status);
+						}
+						completionHandler();
+					});
+				return true;
+			});
+	}
+
+	virtual void setStreamOutputFormat(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat, SetStreamOutputFormatHandler const& handler) noexcept override
+	{
+		sendCoalescedAecpCommand(CoalescedAecpCommandKey{ targetEntityID, AecpCommandType::SetStreamFormat, la::avdecc::entity::model::DescriptorType::StreamOutput, 0u, streamIndex }, handler,
+			[this, targetEntityID, streamIndex, streamFormat, handler](CoalescedAecpCommandCompletionHandler const& completionHandler)
+			{
+				auto controller = getController(targetEntityID);
+				if (!controller)
+				{
+					return false;
+				}
+
+				emit beginAecpCommand(targetEntityID, AecpCommandType::SetStreamFormat);
+				controller->setStreamOutputFormat(targetEntityID, streamIndex, streamFormat,
+					[this, targetEntityID, handler, completionHandler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+					{
+						addAecpCommandLatency(targetEntityID, AecpCommandType::SetStreamFormat, commandStartTime);
+
+						if (handler)
+						{
+							la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+						}
+						else
+						{
+							emit endAecpCommand(targetEntityID, AecpCommandType::SetStreamFormat, status);
+						}
+						completionHandler();
+					});
+				return true;
+			});
+	}
+
+	virtual void setStreamOutputInfo(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamInfo const& streamInfo, SetStreamOutputInfoHandler const& handler) noexcept override
+	{
+		auto controller = getController(targetEntityID);
+		if (controller)
+		{
+			emit beginAecpCommand(targetEntityID, AecpCommandType::SetStreamInfo);
+			controller->setStreamOutputInfo(targetEntityID, streamIndex, streamInfo,
+				[this, targetEntityID, handler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+				{
+					addAecpCommandLatency(targetEntityID, AecpCommandType::SetStreamInfo, commandStartTime);
+
+					if (handler)
+					{
+						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+					}
+					else
+					{
+						emit endAecpCommand(targetEntityID, AecpCommandType::SetStreamInfo, status);
+					}
+				});
+		}
+	}
+
+	virtual void setEntityName(la::avdecc::UniqueIdentifier const targetEntityID, QString const& name, SetEntityNameHandler const& handler) noexcept override
+	{
+		sendCoalescedAecpCommand(CoalescedAecpCommandKey{ targetEntityID, AecpCommandType::SetEntityName, la::avdecc::entity::model::DescriptorType::Entity, 0u, 0u }, handler,
+			[this, targetEntityID, name, handler](CoalescedAecpCommandCompletionHandler const& completionHandler)
+			{
+				auto controller = getController(targetEntityID);
+				if (!controller)
+				{
+					return false;
+				}
+
+				emit beginAecpCommand(targetEntityID, AecpCommandType::SetEntityName);
+				controller->setEntityName(targetEntityID, name.toStdString(),
+					[this, targetEntityID, handler, completionHandler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+					{
+						addAecpCommandLatency(targetEntityID, AecpCommandType::SetEntityName, commandStartTime);
+
+						if (handler)
+						{
+							la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+						}
+						else
+						{
+							emit endAecpCommand(targetEntityID, AecpCommandType::SetEntityName, status);
+						}
+						completionHandler();
+					});
+				return true;
+			});
+	}
+
+	virtual void setEntityGroupName(la::avdecc::UniqueIdentifier const targetEntityID, QString const& name, SetEntityGroupNameHandler const& handler) noexcept override
+	{
+		sendCoalescedAecpCommand(CoalescedAecpCommandKey{ targetEntityID, AecpCommandType::SetEntityGroupName, la::avdecc::entity::model::DescriptorType::Entity, 0u, 0u }, handler,
+			[this, targetEntityID, name, handler](CoalescedAecpCommandCompletionHandler const& completionHandler)
+			{
+				auto controller = getController(targetEntityID);
+				if (!controller)
+				{
+					return false;
+				}
+
+				emit beginAecpCommand(targetEntityID, AecpCommandType::SetEntityGroupName);
+				controller->setEntityGroupName(targetEntityID, name.toStdString(),
+					[this, targetEntityID, handler, completionHandler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+					{
+						addAecpCommandLatency(targetEntityID, AecpCommandType::SetEntityGroupName, commandStartTime);
+
+						if (handler)
+						{
+							la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+						}
+						else
+						{
+							emit endAecpCommand(targetEntityID, AecpCommandType::SetEntityGroupName, status);
+						}
+						completionHandler();
+					});
+				return true;
+			});
+	}
+
+	virtual void setConfigurationName(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, QString const& name, SetConfigurationNameHandler const& handler) noexcept override
+	{
+		sendCoalescedAecpCommand(CoalescedAecpCommandKey{ targetEntityID, AecpCommandType::SetConfigurationName, la::avdecc::entity::model::DescriptorType::Configuration, configurationIndex, configurationIndex }, handler,
+			[this, targetEntityID, configurationIndex, name, handler](CoalescedAecpCommandCompletionHandler const& completionHandler)
+			{
+				auto controller = getController(targetEntityID);
+				if (!controller)
+				{
+					return false;
+				}
+
+				emit beginAecpCommand(targetEntityID, AecpCommandType::SetConfigurationName);
+				controller->setConfigurationName(targetEntityID, configurationIndex, name.toStdString(),
+					[this, targetEntityID, handler, completionHandler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+					{
+						addAecpCommandLatency(targetEntityID, AecpCommandType::SetConfigurationName, commandStartTime);
+
+						if (handler)
+						{
+							la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+						}
+						else
+						{
+							emit endAecpCommand(targetEntityID, AecpCommandType::SetConfigurationName, status);
+						}
+						completionHandler();
+					});
+				return true;
+			});
+	}
+
+	virtual void setAudioUnitName(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, QString const& name, SetAudioUnitNameHandler const& handler) noexcept override
+	{
+		sendCoalescedAecpCommand(CoalescedAecpCommandKey{ targetEntityID, AecpCommandType::SetAudioUnitName, la::avdecc::entity::model::DescriptorType::AudioUnit, configurationIndex, audioUnitIndex }, handler,
+			[this, targetEntityID, configurationIndex, audioUnitIndex, name, handler](CoalescedAecpCommandCompletionHandler const& completionHandler)
+			{
+				auto controller = getController(targetEntityID);
+				if (!controller)
+				{
+					return false;
+				}
+
+				emit beginAecpCommand(targetEntityID, AecpCommandType::SetAudioUnitName);
+				controller->setAudioUnitName(targetEntityID, configurationIndex, audioUnitIndex, name.toStdString(),
+					[this, targetEntityID, handler, completionHandler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+					{
+						addAecpCommandLatency(targetEntityID, AecpCommandType::SetAudioUnitName, commandStartTime);
+
+						if (handler)
+						{
+							la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+						}
+						else
+						{
+							emit endAecpCommand(targetEntityID, AecpCommandType::SetAudioUnitName, status);
+						}
+						completionHandler();
+					});
+				return true;
+			});
+	}
+
+	virtual void setStreamInputName(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::StreamIndex const streamIndex, QString const& name, SetStreamInputNameHandler const& handler) noexcept override
+	{
+		sendCoalescedAecpCommand(CoalescedAecpCommandKey{ targetEntityID, AecpCommandType::SetStreamName, la::avdecc::entity::model::DescriptorType::StreamInput, configurationIndex, streamIndex }, handler,
+			[this, targetEntityID, configurationIndex, streamIndex, name, handler](CoalescedAecpCommandCompletionHandler const& completionHandler)
+			{
+				auto controller = getController(targetEntityID);
+				if (!controller)
+				{
+					return false;
+				}
+
+				emit beginAecpCommand(targetEntityID, AecpCommandType::SetStreamName);
+				controller->setStreamInputName(targetEntityID, configurationIndex, streamIndex, name.toStdString(),
+					[this, targetEntityID, handler, completionHandler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+					{
+						addAecpCommandLatency(targetEntityID, AecpCommandType::SetStreamName, commandStartTime);
+
+						if (handler)
+						{
+							la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+						}
+						else
+						{
+							emit endAecpCommand(targetEntityID, AecpCommandType::SetStreamName, status);
+						}
+						completionHandler();
+					});
+				return true;
+			});
+	}
+
+	virtual void setStreamOutputName(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::StreamIndex const streamIndex, QString const& name, SetStreamOutputNameHandler const& handler) noexcept override
+	{
+		sendCoalescedAecpCommand(CoalescedAecpCommandKey{ targetEntityID, AecpCommandType::SetStreamName, la::avdecc::entity::model::DescriptorType::StreamOutput, configurationIndex, streamIndex }, handler,
+			[this, targetEntityID, configurationIndex, streamIndex, name, handler](CoalescedAecpCommandCompletionHandler const& completionHandler)
+			{
+				auto controller = getController(targetEntityID);
+				if (!controller)
+				{
+					return false;
+				}
+
+				emit beginAecpCommand(targetEntityID, AecpCommandType::SetStreamName);
+				controller->setStreamOutputName(targetEntityID, configurationIndex, streamIndex, name.toStdString(),
+					[this, targetEntityID, handler, completionHandler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+					{
+						addAecpCommandLatency(targetEntityID, AecpCommandType::SetStreamName, commandStartTime);
+
+						if (handler)
+						{
+							la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+						}
+						else
+						{
+							emit endAecpCommand(targetEntityID, AecpCommandType::SetStreamName, status);
+						}
+						completionHandler();
+					});
+				return true;
+			});
+	}
+
+	virtual void setAvbInterfaceName(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, QString const& name, SetAvbInterfaceNameHandler const& handler) noexcept override
+	{
+		sendCoalescedAecpCommand(CoalescedAecpCommandKey{ targetEntityID, AecpCommandType::SetAvbInterfaceName, la::avdecc::entity::model::DescriptorType::AvbInterface, configurationIndex, avbInterfaceIndex }, handler,
+			[this, targetEntityID, configurationIndex, avbInterfaceIndex, name, handler](CoalescedAecpCommandCompletionHandler const& completionHandler)
+			{
+				auto controller = getController(targetEntityID);
+				if (!controller)
+				{
+					return false;
+				}
+
+				emit beginAecpCommand(targetEntityID, AecpCommandType::SetAvbInterfaceName);
+				controller->setAvbInterfaceName(targetEntityID, configurationIndex, avbInterfaceIndex, name.toStdString(),
+					[this, targetEntityID, handler, completionHandler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+					{
+						addAecpCommandLatency(targetEntityID, AecpCommandType::SetAvbInterfaceName, commandStartTime);
+
+						if (handler)
+						{
+							la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+						}
+						else
+						{
+							emit endAecpCommand(targetEntityID, AecpCommandType::SetAvbInterfaceName, status);
+						}
+						completionHandler();
+					});
+				return true;
+			});
+	}
+
+	virtual void setClockSourceName(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex, QString const& name, SetClockSourceNameHandler const& handler) noexcept override
+	{
+		sendCoalescedAecpCommand(CoalescedAecpCommandKey{ targetEntityID, AecpCommandType::SetClockSourceName, la::avdecc::entity::model::DescriptorType::ClockSource, configurationIndex, clockSourceIndex }, handler,
+			[this, targetEntityID, configurationIndex, clockSourceIndex, name, handler](CoalescedAecpCommandCompletionHandler const& completionHandler)
+			{
+				auto controller = getController(targetEntityID);
+				if (!controller)
+				{
+					return false;
+				}
+
+				emit beginAecpCommand(targetEntityID, AecpCommandType::SetClockSourceName);
+				controller->setClockSourceName(targetEntityID, configurationIndex, clockSourceIndex, name.toStdString(),
+					[this, targetEntityID, handler, completionHandler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+					{
+						addAecpCommandLatency(targetEntityID, AecpCommandType::SetClockSourceName, commandStartTime);
+
+						if (handler)
+						{
+							la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+						}
+						else
+						{
+							emit endAecpCommand(targetEntityID, AecpCommandType::SetClockSourceName, status);
+						}
+						completionHandler();
+					});
+				return true;
+			});
+	}
+
+	virtual void setMemoryObjectName(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, QString const& name, SetMemoryObjectNameHandler const& handler) noexcept override
+	{
+		sendCoalescedAecpCommand(CoalescedAecpCommandKey{ targetEntityID, AecpCommandType::SetMemoryObjectName, la::avdecc::entity::model::DescriptorType::MemoryObject, configurationIndex, memoryObjectIndex }, handler,
+			[this, targetEntityID, configurationIndex, memoryObjectIndex, name, handler](CoalescedAecpCommandCompletionHandler const& completionHandler)
+			{
+				auto controller = getController(targetEntityID);
+				if (!controller)
+				{
+					return false;
+				}
+
+				emit beginAecpCommand(targetEntityID, AecpCommandType::SetMemoryObjectName);
+				controller->setMemoryObjectName(targetEntityID, configurationIndex, memoryObjectIndex, name.toStdString(),
+					[this, targetEntityID, handler, completionHandler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+					{
+						addAecpCommandLatency(targetEntityID, AecpCommandType::SetMemoryObjectName, commandStartTime);
+
+						if (handler)
+						{
+							la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+						}
+						else
+						{
+							emit endAecpCommand(targetEntityID, AecpCommandType::SetMemoryObjectName, status);
+						}
+						completionHandler();
+					});
+				return true;
+			});
+	}
+
+	virtual void setAudioClusterName(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClusterIndex const audioClusterIndex, QString const& name, SetAudioClusterNameHandler const& handler) noexcept override
+	{
+		sendCoalescedAecpCommand(CoalescedAecpCommandKey{ targetEntityID, AecpCommandType::SetAudioClusterName, la::avdecc::entity::model::DescriptorType::AudioCluster, configurationIndex, audioClusterIndex }, handler,
+			[this, targetEntityID, configurationIndex, audioClusterIndex, name, handler](CoalescedAecpCommandCompletionHandler const& completionHandler)
+			{
+				auto controller = getController(targetEntityID);
+				if (!controller)
+				{
+					return false;
+				}
+
+				emit beginAecpCommand(targetEntityID, AecpCommandType::SetAudioClusterName);
+				controller->setAudioClusterName(targetEntityID, configurationIndex, audioClusterIndex, name.toStdString(),
+					[this, targetEntityID, handler, completionHandler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+					{
+						addAecpCommandLatency(targetEntityID, AecpCommandType::SetAudioClusterName, commandStartTime);
+
+						if (handler)
+						{
+							la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+						}
+						else
+						{
+							emit endAecpCommand(targetEntityID, AecpCommandType::SetAudioClusterName, status);
+						}
+						completionHandler();
+					});
+				return true;
+			});
+	}
+
+	virtual void setClockDomainName(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, QString const& name, SetClockDomainNameHandler const& handler) noexcept override
+	{
+		sendCoalescedAecpCommand(CoalescedAecpCommandKey{ targetEntityID, AecpCommandType::SetClockDomainName, la::avdecc::entity::model::DescriptorType::ClockDomain, configurationIndex, clockDomainIndex }, handler,
+			[this, targetEntityID, configurationIndex, clockDomainIndex, name, handler](CoalescedAecpCommandCompletionHandler const& completionHandler)
+			{
+				auto controller = getController(targetEntityID);
+				if (!controller)
+				{
+					return false;
+				}
+
+				emit beginAecpCommand(targetEntityID, AecpCommandType::SetClockDomainName);
+				controller->setClockDomainName(targetEntityID, configurationIndex, clockDomainIndex, name.toStdString(),
+					[this, targetEntityID, handler, completionHandler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+					{
+						addAecpCommandLatency(targetEntityID, AecpCommandType::SetClockDomainName, commandStartTime);
+
+						if (handler)
+						{
+							la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+						}
+						else
+						{
+							emit endAecpCommand(targetEntityID, AecpCommandType::SetClockDomainName, status);
+						}
+						completionHandler();
+					});
+				return true;
+			});
+	}
+
+	virtual void setAudioUnitSamplingRate(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, la::avdecc::entity::model::SamplingRate const samplingRate, SetAudioUnitSamplingRateHandler const& handler) noexcept override
+	{
+		sendCoalescedAecpCommand(CoalescedAecpCommandKey{ targetEntityID, AecpCommandType::SetSamplingRate, la::avdecc::entity::model::DescriptorType::AudioUnit, 0u, audioUnitIndex }, handler,
+			[this, targetEntityID, audioUnitIndex, samplingRate, handler](CoalescedAecpCommandCompletionHandler const& completionHandler)
+			{
+				auto controller = getController(targetEntityID);
+				if (!controller)
+				{
+					return false;
+				}
+
+				emit beginAecpCommand(targetEntityID, AecpCommandType::SetSamplingRate);
+				controller->setAudioUnitSamplingRate(targetEntityID, audioUnitIndex, samplingRate,
+					[this, targetEntityID, handler, completionHandler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+					{
+						addAecpCommandLatency(targetEntityID, AecpCommandType::SetSamplingRate, commandStartTime);
+
+						if (handler)
+						{
+							la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+						}
+						else
+						{
+							emit endAecpCommand(targetEntityID, AecpCommandType::SetSamplingRate, status);
+						}
+						completionHandler();
+					});
+				return true;
+			});
+	}
+
+	virtual void setClockSource(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex, SetClockSourceHandler const& handler) noexcept override
+	{
+		sendCoalescedAecpCommand(CoalescedAecpCommandKey{ targetEntityID, AecpCommandType::SetClockSource, la::avdecc::entity::model::DescriptorType::ClockDomain, 0u, clockDomainIndex }, handler,
+			[this, targetEntityID, clockDomainIndex, clockSourceIndex, handler](CoalescedAecpCommandCompletionHandler const& completionHandler)
+			{
+				auto controller = getController(targetEntityID);
+				if (!controller)
+				{
+					return false;
+				}
+
+				emit beginAecpCommand(targetEntityID, AecpCommandType::SetClockSource);
+				controller->setClockSource(targetEntityID, clockDomainIndex, clockSourceIndex,
+					[this, targetEntityID, handler, completionHandler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+					{
+						addAecpCommandLatency(targetEntityID, AecpCommandType::SetClockSource, commandStartTime);
+
+						if (handler)
+						{
+							la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+						}
+						else
+						{
+							emit endAecpCommand(targetEntityID, AecpCommandType::SetClockSource, status);
+						}
+						completionHandler();
+					});
+				return true;
+			});
+	}
+
+	virtual void startStreamInput(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamIndex const streamIndex, StartStreamInputHandler const& handler) noexcept override
+	{
+		auto controller = getController(targetEntityID);
+		if (controller)
+		{
+			emit beginAecpCommand(targetEntityID, AecpCommandType::StartStream);
+			controller->startStreamInput(targetEntityID, streamIndex,
+				[this, targetEntityID, handler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+				{
+					addAecpCommandLatency(targetEntityID, AecpCommandType::StartStream, commandStartTime);
+
+					if (handler)
+					{
+						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+					}
+					else
+					{
+						emit endAecpCommand(targetEntityID, AecpCommandType::StartStream, status);
+					}
+				});
+		}
+	}
+
+	virtual void stopStreamInput(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamIndex const streamIndex, StopStreamInputHandler const& handler) noexcept override
+	{
+		auto controller = getController(targetEntityID);
+		if (controller)
+		{
+			emit beginAecpCommand(targetEntityID, AecpCommandType::StopStream);
+			controller->stopStreamInput(targetEntityID, streamIndex,
+				[this, targetEntityID, handler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+				{
+					addAecpCommandLatency(targetEntityID, AecpCommandType::StopStream, commandStartTime);
+
+					if (handler)
+					{
+						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+					}
+					else
+					{
+						emit endAecpCommand(targetEntityID, AecpCommandType::StopStream, status);
+					}
+				});
+		}
+	}
+
+	virtual void startStreamOutput(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamIndex const streamIndex, StartStreamOutputHandler const& handler) noexcept override
+	{
+		auto controller = getController(targetEntityID);
+		if (controller)
+		{
+			emit beginAecpCommand(targetEntityID, AecpCommandType::StartStream);
+			controller->startStreamOutput(targetEntityID, streamIndex,
+				[this, targetEntityID, handler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+				{
+					addAecpCommandLatency(targetEntityID, AecpCommandType::StartStream, commandStartTime);
+
+					if (handler)
+					{
+						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+					}
+					else
+					{
+						emit endAecpCommand(targetEntityID, AecpCommandType::StartStream, status);
+					}
+				});
+		}
+	}
+
+	virtual void stopStreamOutput(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamIndex const streamIndex, StopStreamOutputHandler const& handler) noexcept override
+	{
+		auto controller = getController(targetEntityID);
+		if (controller)
+		{
+			emit beginAecpCommand(targetEntityID, AecpCommandType::StopStream);
+			controller->stopStreamOutput(targetEntityID, streamIndex,
+				[this, targetEntityID, handler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+				{
+					addAecpCommandLatency(targetEntityID, AecpCommandType::StopStream, commandStartTime);
+
+					if (handler)
+					{
+						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+					}
+					else
+					{
+						emit endAecpCommand(targetEntityID, AecpCommandType::StopStream, status);
+					}
+				});
+		}
+	}
+
+	virtual void addStreamPortInputAudioMappings(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamPortIndex const streamPortIndex, la::avdecc::entity::model::AudioMappings const& mappings, AddStreamPortInputAudioMappingsHandler const& handler) noexcept override
+	{
+		auto controller = getController(targetEntityID);
+		if (controller)
+		{
+			emit beginAecpCommand(targetEntityID, AecpCommandType::AddStreamPortAudioMappings);
+			controller->addStreamPortInputAudioMappings(targetEntityID, streamPortIndex, mappings,
+				[this, targetEntityID, handler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+				{
+					addAecpCommandLatency(targetEntityID, AecpCommandType::AddStreamPortAudioMappings, commandStartTime);
+
+					if (handler)
+					{
+						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+					}
+					else
+					{
+						emit endAecpCommand(targetEntityID, AecpCommandType::AddStreamPortAudioMappings, status);
+					}
+				});
+		}
+	}
+
+	virtual void addStreamPortOutputAudioMappings(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamPortIndex const streamPortIndex, la::avdecc::entity::model::AudioMappings const& mappings, AddStreamPortOutputAudioMappingsHandler const& handler) noexcept override
+	{
+		auto controller = getController(targetEntityID);
+		if (controller)
+		{
+			emit beginAecpCommand(targetEntityID, AecpCommandType::AddStreamPortAudioMappings);
+			controller->addStreamPortOutputAudioMappings(targetEntityID, streamPortIndex, mappings,
+				[this, targetEntityID, handler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+				{
+					addAecpCommandLatency(targetEntityID, AecpCommandType::AddStreamPortAudioMappings, commandStartTime);
+
+					if (handler)
+					{
+						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+					}
+					else
+					{
+						emit endAecpCommand(targetEntityID, AecpCommandType::AddStreamPortAudioMappings, status);
+					}
+				});
+		}
+	}
+
+	virtual void removeStreamPortInputAudioMappings(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamPortIndex const streamPortIndex, la::avdecc::entity::model::AudioMappings const& mappings, RemoveStreamPortInputAudioMappingsHandler const& handler) noexcept override
+	{
+		auto controller = getController(targetEntityID);
+		if (controller)
+		{
+			emit beginAecpCommand(targetEntityID, AecpCommandType::RemoveStreamPortAudioMappings);
+			controller->removeStreamPortInputAudioMappings(targetEntityID, streamPortIndex, mappings,
+				[this, targetEntityID, handler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+				{
+					addAecpCommandLatency(targetEntityID, AecpCommandType::RemoveStreamPortAudioMappings, commandStartTime);
+
+					if (handler)
+					{
+						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+					}
+					else
+					{
+						emit endAecpCommand(targetEntityID, AecpCommandType::RemoveStreamPortAudioMappings, status);
+					}
+				});
+		}
+	}
+
+	virtual void removeStreamPortOutputAudioMappings(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamPortIndex const streamPortIndex, la::avdecc::entity::model::AudioMappings const& mappings, RemoveStreamPortOutputAudioMappingsHandler const& handler) noexcept override
+	{
+		auto controller = getController(targetEntityID);
+		if (controller)
+		{
+			emit beginAecpCommand(targetEntityID, AecpCommandType::RemoveStreamPortAudioMappings);
+			controller->removeStreamPortOutputAudioMappings(targetEntityID, streamPortIndex, mappings,
+				[this, targetEntityID, handler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+				{
+					addAecpCommandLatency(targetEntityID, AecpCommandType::RemoveStreamPortAudioMappings, commandStartTime);
+
+					if (handler)
+					{
+						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+					}
+					else
+					{
+						emit endAecpCommand(targetEntityID, AecpCommandType::RemoveStreamPortAudioMappings, status);
+					}
+				});
+		}
+	}
+
+	virtual void startStoreAndRebootMemoryObjectOperation(la::avdecc::UniqueIdentifier targetEntityID, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, StartStoreAndRebootMemoryObjectOperationHandler const& handler) noexcept override
+	{
+		auto controller = getController(targetEntityID);
+		if (controller)
+		{
+			if (!handler)
+			{
+				emit beginAecpCommand(targetEntityID, AecpCommandType::StartStoreAndRebootMemoryObjectOperation);
+			}
+			controller->startStoreAndRebootMemoryObjectOperation(targetEntityID, descriptorIndex,
+				[this, targetEntityID, handler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, la::avdecc::entity::model::OperationID const operationID) noexcept
+				{
+					addAecpCommandLatency(targetEntityID, AecpCommandType::StartStoreAndRebootMemoryObjectOperation, commandStartTime);
+
+					if (handler)
+					{
+						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status, operationID);
+					}
+					else
+					{
+						emit endAecpCommand(targetEntityID, AecpCommandType::StartStoreAndRebootMemoryObjectOperation, status);
+					}
+				});
+		}
+	}
+
+	virtual void startUploadMemoryObjectOperation(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, std::uint64_t const dataLength, StartUploadMemoryObjectOperationHandler const& handler) noexcept override
+	{
+		auto controller = getController(targetEntityID);
+		if (controller)
+		{
+			if (!handler)
+			{
+				emit beginAecpCommand(targetEntityID, AecpCommandType::StartUploadMemoryObjectOperation);
+			}
+			controller->startUploadMemoryObjectOperation(targetEntityID, descriptorIndex, dataLength,
+				[this, targetEntityID, handler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, la::avdecc::entity::model::OperationID const operationID) noexcept
+				{
+					addAecpCommandLatency(targetEntityID, AecpCommandType::StartUploadMemoryObjectOperation, commandStartTime);
+
+					if (handler)
+					{
+						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status, operationID);
+					}
+					else
+					{
+						emit endAecpCommand(targetEntityID, AecpCommandType::StartUploadMemoryObjectOperation, status);
+					}
+				});
+		}
+	}
+
+	virtual void abortOperation(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, la::avdecc::entity::model::OperationID const operationID, AbortOperationHandler const& handler) noexcept override
+	{
+		auto controller = getController(targetEntityID);
+		if (controller)
+		{
+			if (!handler)
+			{
+				emit beginAecpCommand(targetEntityID, AecpCommandType::AbortOperation);
+			}
+			controller->abortOperation(targetEntityID, descriptorType, descriptorIndex, operationID,
+				[this, targetEntityID, handler, commandStartTime = std::chrono::steady_clock::now()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+				{
+					addAecpCommandLatency(targetEntityID, AecpCommandType::AbortOperation, commandStartTime);
+
+					if (handler)
+					{
+						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
+					}
+					else
+					{
+						emit endAecpCommand(targetEntityID, AecpCommandType::AbortOperation, status);
+					}
+				});
+		}
+	}
+
+	/* Enumeration and Control Protocol (AECP) AA */
+	virtual void readDeviceMemory(la::avdecc::UniqueIdentifier const targetEntityID, std::uint64_t const address, std::uint64_t const length, la::avdecc::controller::Controller::ReadDeviceMemoryProgressHandler const& progressHandler, la::avdecc::controller::Controller::ReadDeviceMemoryCompletionHandler const& completionHandler) const noexcept override
+	{
+		auto controller = getController(targetEntityID);
+		if (controller)
+		{
+			controller->readDeviceMemory(targetEntityID, address, length, progressHandler, completionHandler);
+		}
+	}
+
+	virtual void writeDeviceMemory(la::avdecc::UniqueIdentifier const targetEntityID, std::uint64_t const address, la::avdecc::controller::Controller::DeviceMemoryBuffer memoryBuffer, la::avdecc::controller::Controller::WriteDeviceMemoryProgressHandler const& progressHandler, la::avdecc::controller::Controller::WriteDeviceMemoryCompletionHandler const& completionHandler) const noexcept override
+	{
+		auto controller = getController(targetEntityID);
+		if (controller)
+		{
+			controller->writeDeviceMemory(targetEntityID, address, std::move(memoryBuffer), progressHandler, completionHandler);
+		}
+	}
+
+	virtual void readDeviceMemoryChunked(la::avdecc::UniqueIdentifier const targetEntityID, std::uint64_t const address, std::uint64_t const length, std::size_t const windowSize, la::avdecc::controller::Controller::ReadDeviceMemoryProgressHandler const& progressHandler, la::avdecc::controller::Controller::ReadDeviceMemoryCompletionHandler const& completionHandler) const noexcept override
+	{
+		if (!getController(targetEntityID))
+		{
+			return;
+		}
+
+		if (length == 0u)
+		{
+			if (completionHandler)
+			{
+				la::avdecc::utils::invokeProtectedHandler(completionHandler, nullptr, la::avdecc::entity::ControllerEntity::AaCommandStatus::Success, la::avdecc::controller::Controller::DeviceMemoryBuffer{});
+			}
+			return;
+		}
+
+		auto read = std::make_shared<ChunkedMemoryRead>();
+		read->entityID = targetEntityID;
+		read->address = address;
+		read->length = length;
+		read->windowSize = std::max(windowSize, std::size_t{ 1u });
+		read->progressHandler = progressHandler;
+		read->completionHandler = completionHandler;
+		read->buffer.resize(static_cast<size_t>(length));
+
+		requestMemoryChunks(read);
+	}
+
+	virtual void writeDeviceMemoryChunked(la::avdecc::UniqueIdentifier const targetEntityID, std::uint64_t const address, SharedMemoryImage const& image, std::size_t const windowSize, la::avdecc::controller::Controller::WriteDeviceMemoryProgressHandler const& progressHandler, la::avdecc::controller::Controller::WriteDeviceMemoryCompletionHandler const& completionHandler) const noexcept override
+	{
+		if (!getController(targetEntityID))
+		{
+			return;
+		}
+
+		if (image.size == 0u)
+		{
+			if (completionHandler)
+			{
+				la::avdecc::utils::invokeProtectedHandler(completionHandler, nullptr, la::avdecc::entity::ControllerEntity::AaCommandStatus::Success);
+			}
+			return;
+		}
+
+		auto write = std::make_shared<ChunkedMemoryWrite>();
+		write->entityID = targetEntityID;
+		write->address = address;
+		write->image = image;
+		write->windowSize = std::max(windowSize, std::size_t{ 1u });
+		write->progressHandler = progressHandler;
+		write->completionHandler = completionHandler;
+
+		requestMemoryWriteChunks(write);
+	}
+
+	/* Connection Management Protocol (ACMP) */
+	virtual void connectStream(la::avdecc::UniqueIdentifier const talkerEntityID, la::avdecc::entity::model::StreamIndex const talkerStreamIndex, la::avdecc::UniqueIdentifier const listenerEntityID, la::avdecc::entity::model::StreamIndex const listenerStreamIndex, ConnectStreamHandler const& handler) noexcept override
+	{
+		auto controller = getController(listenerEntityID);
+		if (controller)
+		{
+			emit beginAcmpCommand(talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, AcmpCommandType::ConnectStream);
+			controller->connectStream({ talkerEntityID, talkerStreamIndex }, { listenerEntityID, listenerStreamIndex },
+				[this, talkerEntityID, listenerEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*talkerEntity*/, la::avdecc::controller::ControlledEntity const* const /*listenerEntity*/, la::avdecc::entity::model::StreamIndex const talkerStreamIndex, la::avdecc::entity::model::StreamIndex const listenerStreamIndex, la::avdecc::entity::ControllerEntity::ControlStatus const status) noexcept
+				{
+					if (handler)
+					{
+						la::avdecc::utils::invokeProtectedHandler(handler, talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, status);
+					}
+					else
+					{
+						emit endAcmpCommand(talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, AcmpCommandType::ConnectStream, status);
+					}
+				});
+		}
+	}
+
+	virtual void disconnectStream(la::avdecc::UniqueIdentifier const talkerEntityID, la::avdecc::entity::model::StreamIndex const talkerStreamIndex, la::avdecc::UniqueIdentifier const listenerEntityID, la::avdecc::entity::model::StreamIndex const listenerStreamIndex, DisconnectStreamHandler const& handler) noexcept override
+	{
+		auto controller = getController(listenerEntityID);
+		if (controller)
+		{
+			emit beginAcmpCommand(talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, AcmpCommandType::DisconnectStream);
+			controller->disconnectStream({ talkerEntityID, talkerStreamIndex }, { listenerEntityID, listenerStreamIndex },
+				[this, talkerEntityID, talkerStreamIndex, listenerEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*listenerEntity*/, la::avdecc::entity::model::StreamIndex const listenerStreamIndex, la::avdecc::entity::ControllerEntity::ControlStatus const status) noexcept
+				{
+					if (handler)
+					{
+						la::avdecc::utils::invokeProtectedHandler(handler, talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, status);
+					}
+					else
+					{
+						emit endAcmpCommand(talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, AcmpCommandType::DisconnectStream, status);
+					}
+				});
+		}
+	}
+
+	virtual void disconnectTalkerStream(la::avdecc::UniqueIdentifier const talkerEntityID, la::avdecc::entity::model::StreamIndex const talkerStreamIndex, la::avdecc::UniqueIdentifier const listenerEntityID, la::avdecc::entity::model::StreamIndex const listenerStreamIndex, DisconnectTalkerStreamHandler const& handler) noexcept override
+	{
+		auto controller = getController(talkerEntityID);
+		if (controller)
+		{
+			emit beginAcmpCommand(talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, AcmpCommandType::DisconnectTalkerStream);
+			controller->disconnectTalkerStream({ talkerEntityID, talkerStreamIndex }, { listenerEntityID, listenerStreamIndex },
+				[this, talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, handler](la::avdecc::entity::ControllerEntity::ControlStatus const status) noexcept
+				{
+					if (handler)
+					{
+						la::avdecc::utils::invokeProtectedHandler(handler, talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, status);
+					}
+					else
+					{
+						emit endAcmpCommand(talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, AcmpCommandType::DisconnectTalkerStream, status);
+					}
+				});
+		}
+	}
+
+	virtual void requestExclusiveAccess(la::avdecc::UniqueIdentifier const entityID, la::avdecc::controller::Controller::ExclusiveAccessToken::AccessType const type, RequestExclusiveAccessHandler const& handler) noexcept override
+	{
+		auto controller = getController(entityID);
+		if (controller)
+		{
+			controller->requestExclusiveAccess(entityID, type,
+				[this, entityID, handler](auto const* const /*entity*/, auto const status, auto&& token) noexcept
+				{
+					la::avdecc::utils::invokeProtectedHandler(handler, entityID, status, std::move(token));
+				});
+		}
+	}
+
+	virtual void requestExclusiveAccesses(EntityIDs const& entityIDs, la::avdecc::controller::Controller::ExclusiveAccessToken::AccessType const type, RequestExclusiveAccessesHandler const& handler) noexcept override
+	{
+		// Always request in the same order, so concurrent controllers contend on the lowest common EntityID first
+		auto const sortedEntityIDs = std::set<la::avdecc::UniqueIdentifier>{ entityIDs.begin(), entityIDs.end() };
+		if (sortedEntityIDs.empty())
+		{
+			la::avdecc::utils::invokeProtectedHandler(handler, std::make_shared<ExclusiveAccessGroup>(), ExclusiveAccessFailures{});
+			return;
+		}
+
+		struct PendingRequests
+		{
+			std::mutex lock{};
+			size_t remaining{ 0u };
+			ExclusiveAccessGroupPointer group{ std::make_shared<ExclusiveAccessGroup>() };
+			ExclusiveAccessFailures failures{};
+		};
+		auto const pending = std::make_shared<PendingRequests>();
+		pending->remaining = sortedEntityIDs.size();
+
+		auto const onResult = [pending, handler](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, ExclusiveAccessGroup::Token&& token)
+		{
+			auto isLast = false;
+			{
+				auto const lg = std::lock_guard{ pending->lock };
+				if (token)
+				{
+					pending->group->add(entityID, std::move(token));
+				}
+				else if (status != la::avdecc::entity::ControllerEntity::AemCommandStatus::NotImplemented && status != la::avdecc::entity::ControllerEntity::AemCommandStatus::NotSupported)
+				{
+					pending->failures[entityID] = !status ? status : la::avdecc::entity::ControllerEntity::AemCommandStatus::ProtocolError;
+				}
+				isLast = --pending->remaining == 0u;
+			}
+
+			if (isLast)
+			{
+				auto group = pending->group;
+				if (!pending->failures.empty())
+				{
+					// Do not keep part of the group, another controller may be requesting the entities we already got
+					group->release();
+					group.reset();
+				}
+				la::avdecc::utils::invokeProtectedHandler(handler, group, pending->failures);
+			}
+		};
+
+		for (auto const& entityID : sortedEntityIDs)
+		{
+			auto controller = getController(entityID);
+			if (!controller)
+			{
+				onResult(entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus::UnknownEntity, nullptr);
+				continue;
+			}
+			controller->requestExclusiveAccess(entityID, type,
+				[onResult, entityID](auto const* const /*entity*/, auto const status, auto&& token) noexcept
+				{
+					onResult(entityID, status, std::move(token));
+				});
+		}
+	}
+
+
+	virtual void foreachEntity(ControlledEntityCallback const& callback) noexcept override
+	{
+		auto controller = getController();
+		if (controller)
+		{
+			// Build a vector of all locked entities
+			auto controlledEntities = std::vector<la::avdecc::controller::ControlledEntityGuard>{};
+
+			{
+				auto const lg = std::lock_guard{ _lock };
+				for (auto& entityID : _entities)
+				{
+					auto ceg = getControlledEntity(entityID);
+					if (AVDECC_ASSERT_WITH_RET(!!ceg, "ControllerManager model not up-to-date with avdecc::controller"))
+					{
+						controlledEntities.push_back(std::move(ceg));
+					}
+				}
+			}
+
+			for (auto const& controlledEntity : controlledEntities)
+			{
+				callback(controlledEntity->getEntity().getEntityID(), *controlledEntity);
+			}
+		}
+	}
+
+	virtual EntityIDs getOnlineEntities() const noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+		return EntityIDs{ _entities.begin(), _entities.end() };
+	}
+
+	virtual void foreachEntityParallel(EntityIDs const& entityIDs, ParallelControlledEntityCallback const& callback) noexcept override
+	{
+		if (entityIDs.empty())
+		{
+			return;
+		}
+
+		// Workers pick the next entity to process, so a slow entity does not delay the others
+		auto nextIndex = std::atomic<std::size_t>{ 0u };
+		auto const worker = [this, &entityIDs, &callback, &nextIndex]()
+		{
+			for (auto index = nextIndex++; index < entityIDs.size(); index = nextIndex++)
+			{
+				auto const& entityID = entityIDs[index];
+				// Only lock the entity being processed
+				if (auto const controlledEntity = getControlledEntity(entityID))
+				{
+					try
+					{
+						callback(index, entityID, *controlledEntity);
+					}
+					catch (...)
+					{
+						AVDECC_ASSERT(false, "Uncaught exception in foreachEntityParallel callback");
+					}
+				}
+			}
+		};
+
+		// The calling thread is one of the workers. Only start the pool workers a thread is available for (never wait for one, the pool might be busy with another call)
+		auto const poolWorkersCount = entityIDs.size() - 1u;
+		auto runningWorkers = std::size_t{ 0u };
+		auto runningWorkersLock = std::mutex{};
+		auto runningWorkersCondition = std::condition_variable{};
+		for (auto i = std::size_t{ 0u }; i < poolWorkersCount; ++i)
+		{
+			auto* const task = new PoolTask{
+				[&worker, &runningWorkers, &runningWorkersLock, &runningWorkersCondition]()
+				{
+					worker();
+					auto const lg = std::lock_guard{ runningWorkersLock };
+					if (--runningWorkers == 0u)
+					{
+						runningWorkersCondition.notify_one();
+					}
+				}
+			};
+			{
+				auto const lg = std::lock_guard{ runningWorkersLock };
+				++runningWorkers;
+			}
+			if (!_entityVisitorPool.tryStart(task))
+			{
+				delete task;
+				auto const lg = std::lock_guard{ runningWorkersLock };
+				--runningWorkers;
+				break;
+			}
+		}
+		worker();
+
+		auto lock = std::unique_lock{ runningWorkersLock };
+		runningWorkersCondition.wait(lock,
+			[&runningWorkers]()
+			{
+				return runningWorkers == 0u;
+			});
+	}
+
+	// Private methods
+	// Stores the last delivered state of a stream, returns true if it changed (or was not known yet). Only used from the Qt Main Thread
+	static bool updateStreamState(StreamStates& states, la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, bool const state) noexcept
+	{
+		ASSERT_QT_MAIN_THREAD;
+		auto& entityStates = states[entityID];
+		auto const [it, inserted] = entityStates.emplace(streamIndex, state);
+		if (!inserted && it->second == state)
+		{
+			return false;
+		}
+		it->second = state;
+		return true;
+	}
+
+	/** Sends an AECP command changing the value of a descriptor, or queues it if a command with the same key is already in flight. A queued command replaces the previously queued one, whose handler is called with AemCommandStatusSuperseded (its beginAecpCommand was never emitted) */
+	void sendCoalescedAecpCommand(CoalescedAecpCommandKey const& key, CoalescedAecpCommandHandler const& handler, CoalescedAecpCommandSender&& sender) noexcept
+	{
+		auto supersededHandler = CoalescedAecpCommandHandler{};
+		auto isQueued = false;
+		auto generation = std::uint64_t{ 0u };
+		{
+			auto const lg = std::lock_guard{ _coalescedAecpCommandsLock };
+			auto& slot = _coalescedAecpCommands[key];
+			if (slot.inFlight)
+			{
+				supersededHandler = std::move(slot.pendingHandler);
+				slot.pendingSender = std::move(sender);
+				slot.pendingHandler = handler;
+				isQueued = true;
+			}
+			else
+			{
+				slot.inFlight = true;
+			}
+			generation = _coalescedAecpCommandsGeneration;
+		}
+
+		if (isQueued)
+		{
+			if (supersededHandler)
+			{
+				la::avdecc::utils::invokeProtectedHandler(supersededHandler, key.entityID, AemCommandStatusSuperseded);
+			}
+			return;
+		}
+		runCoalescedAecpCommand(key, generation, sender);
+	}
+
+	void runCoalescedAecpCommand(CoalescedAecpCommandKey const& key, std::uint64_t const generation, CoalescedAecpCommandSender const& sender) noexcept
+	{
+		// The next queued command is sent from the Qt Main Thread, not from the avdecc thread calling the result handler
+		auto const sent = sender(
+			[this, key, generation]()
+			{
+				QMetaObject::invokeMethod(this,
+					[this, key, generation]()
+					{
+						completeCoalescedAecpCommand(key, generation);
+					});
+			});
+		if (!sent)
+		{
+			completeCoalescedAecpCommand(key, generation);
+		}
+	}
+
+	void completeCoalescedAecpCommand(CoalescedAecpCommandKey const& key, std::uint64_t const generation) noexcept
+	{
+		auto sender = CoalescedAecpCommandSender{};
+		{
+			auto const lg = std::lock_guard{ _coalescedAecpCommandsLock };
+			// Command sent by a destroyed controller
+			if (generation != _coalescedAecpCommandsGeneration)
+			{
+				return;
+			}
+			auto const it = _coalescedAecpCommands.find(key);
+			if (it == _coalescedAecpCommands.end())
+			{
+				return;
+			}
+			auto& slot = it->second;
+			if (!slot.pendingSender)
+			{
+				_coalescedAecpCommands.erase(it);
+				return;
+			}
+			sender = std::move(slot.pendingSender);
+			slot.pendingSender = {};
+			slot.pendingHandler = {};
+		}
+		runCoalescedAecpCommand(key, generation, sender);
+	}
+
+	/** Returns true for the high rate events that can be delivered late (at BackgroundEventBusPeriod) for the entities without interest. State changes and error flags are always delivered right away */
+	static constexpr bool isBackgroundEventKind(CoalescingEventBus::EventKind const kind) noexcept
+	{
+		switch (kind)
+		{
+			case CoalescingEventBus::EventKind::EntityCounters:
+			case CoalescingEventBus::EventKind::AvbInterfaceCounters:
+			case CoalescingEventBus::EventKind::ClockDomainCounters:
+			case CoalescingEventBus::EventKind::StreamInputCounters:
+			case CoalescingEventBus::EventKind::StreamOutputCounters:
+			case CoalescingEventBus::EventKind::AecpRetryCounter:
+			case CoalescingEventBus::EventKind::AecpTimeoutCounter:
+			case CoalescingEventBus::EventKind::AecpUnexpectedResponseCounter:
+			case CoalescingEventBus::EventKind::AecpResponseAverageTime:
+			case CoalescingEventBus::EventKind::AemAecpUnsolicitedCounter:
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	void postObserverHandoff(la::avdecc::UniqueIdentifier const entityID, ObserverHandoff::Payload&& payload) noexcept
+	{
+		auto record = ObserverHandoff::Record{ entityID, std::move(payload) };
+
+		// A state change must not overtake the online/offline notification of its entity, still waiting in the event bus
+		if (entityID
+				&& _eventBus.postAfterOrdered(entityID,
+					[this, record]()
+					{
+						emitObserverHandoffRecord(record);
+					}))
+		{
+			return;
+		}
+
+		if (_observerHandoff.push(std::move(record)))
+		{
+			QMetaObject::invokeMethod(this,
+				[this]()
+				{
+					drainObserverHandoff();
+				},
+				Qt::QueuedConnection);
+		}
+	}
+
+	void drainObserverHandoff() noexcept
+	{
+		ASSERT_QT_MAIN_THREAD;
+
+		_observerHandoff.drain(
+			[this](ObserverHandoff::Record const& record)
+			{
+				emitObserverHandoffRecord(record);
+			});
+	}
+
+	void emitObserverHandoffRecord(ObserverHandoff::Record const& record) noexcept
+	{
+		ASSERT_QT_MAIN_THREAD;
+
+		auto const entityID = record.entityID;
+		std::visit(
+			[this, entityID](auto const& args)
+			{
+				using Args = std::decay_t<decltype(args)>;
+				if constexpr (std::is_same_v<Args, ObserverHandoff::TransportError>)
+				{
+					emit transportError();
+				}
+				else if constexpr (std::is_same_v<Args, ObserverHandoff::EntityQueryError>)
+				{
+					emit entityQueryError(entityID, args.error);
+				}
+				else if constexpr (std::is_same_v<Args, ObserverHandoff::GptpChanged>)
+				{
+					emit gptpChanged(entityID, args.avbInterfaceIndex, args.grandMasterID, args.grandMasterDomain);
+				}
+				else if constexpr (std::is_same_v<Args, ObserverHandoff::UnsolicitedRegistrationChanged>)
+				{
+					emit unsolicitedRegistrationChanged(entityID);
+				}
+				else if constexpr (std::is_same_v<Args, ObserverHandoff::CompatibilityFlagsChanged>)
+				{
+					emit compatibilityFlagsChanged(entityID, args.compatibilityFlags);
+				}
+				else if constexpr (std::is_same_v<Args, ObserverHandoff::IdentificationChanged>)
+				{
+					if (args.isStarted)
+					{
+						emit identificationStarted(entityID);
+					}
+					else
+					{
+						emit identificationStopped(entityID);
+					}
+				}
+				else if constexpr (std::is_same_v<Args, ObserverHandoff::AcquireStateChanged>)
+				{
+					emit acquireStateChanged(entityID, args.acquireState, args.owningEntity);
+				}
+				else if constexpr (std::is_same_v<Args, ObserverHandoff::LockStateChanged>)
+				{
+					emit lockStateChanged(entityID, args.lockState, args.lockingEntity);
+				}
+				else if constexpr (std::is_same_v<Args, ObserverHandoff::StreamFormatChanged>)
+				{
+					emit streamFormatChanged(entityID, args.descriptorType, args.streamIndex, args.streamFormat);
+				}
+				else if constexpr (std::is_same_v<Args, ObserverHandoff::AudioUnitSamplingRateChanged>)
+				{
+					emit audioUnitSamplingRateChanged(entityID, args.audioUnitIndex, args.samplingRate);
+				}
+				else if constexpr (std::is_same_v<Args, ObserverHandoff::ClockSourceChanged>)
+				{
+					emit clockSourceChanged(entityID, args.clockDomainIndex, args.clockSourceIndex);
+				}
+				else if constexpr (std::is_same_v<Args, ObserverHandoff::StreamRunningChanged>)
+				{
+					emit streamRunningChanged(entityID, args.descriptorType, args.streamIndex, args.isRunning);
+				}
+				else if constexpr (std::is_same_v<Args, ObserverHandoff::AvbInterfaceLinkStatusChanged>)
+				{
+					emit avbInterfaceLinkStatusChanged(entityID, args.avbInterfaceIndex, args.linkStatus);
+				}
+				else if constexpr (std::is_same_v<Args, ObserverHandoff::MemoryObjectLengthChanged>)
+				{
+					emit memoryObjectLengthChanged(entityID, args.configurationIndex, args.memoryObjectIndex, args.length);
+				}
+				else if constexpr (std::is_same_v<Args, ObserverHandoff::StreamPortAudioMappingsChanged>)
+				{
+					emit streamPortAudioMappingsChanged(entityID, args.descriptorType, args.streamPortIndex);
+				}
+				else if constexpr (std::is_same_v<Args, ObserverHandoff::OperationProgress>)
+				{
+					emit operationProgress(entityID, args.descriptorType, args.descriptorIndex, args.operationID, args.percentComplete);
+				}
+				else if constexpr (std::is_same_v<Args, ObserverHandoff::OperationCompleted>)
+				{
+					emit operationCompleted(entityID, args.descriptorType, args.descriptorIndex, args.operationID, args.failed);
+				}
+			},
+			record.payload);
+	}
+
+	void postCoalescedEvent(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, CoalescingEventBus::EventKind const kind, CoalescingEventBus::Event&& event) noexcept
+	{
+		// Entities nobody looks at only get the last value of their counters, at a low rate
+		if (isBackgroundEventKind(kind) && !isEntityOfInterest(entityID))
+		{
+			_backgroundEventBus.postCoalesced(entityID, descriptorType, descriptorIndex, kind, std::move(event));
+			return;
+		}
+
+		if (_eventBus.postCoalesced(entityID, descriptorType, descriptorIndex, kind, std::move(event)))
+		{
+			scheduleEventBusDrain();
+		}
+	}
+
+	void postOrderedEvent(la::avdecc::UniqueIdentifier const entityID, CoalescingEventBus::Event&& event, CoalescingEventBus::Batch const batch = CoalescingEventBus::Batch::None) noexcept
+	{
+		if (_eventBus.postOrdered(entityID, batch, std::move(event)))
+		{
+			scheduleEventBusDrain();
+		}
+	}
+
+	/** Runs the notification right away, unless an ordered event of the entity is still waiting in the event bus, the notification being then posted after it */
+	void runAfterPendingOrderedEvents(la::avdecc::UniqueIdentifier const entityID, CoalescingEventBus::Event&& event) noexcept
+	{
+		if (!_eventBus.postAfterOrdered(entityID, std::move(event)))
+		{
+			la::avdecc::utils::invokeProtectedHandler(event);
+		}
+	}
+
+	void postStatisticsErrorCounterChanged(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		// Error counters are computed when the event is delivered, so a clear done in the meantime is not overridden by a stale value
+		postCoalescedEvent(entityID, la::avdecc::entity::model::DescriptorType::Entity, 0u, CoalescingEventBus::EventKind::StatisticsErrorCounters,
+			[this, entityID]()
+			{
+				emit statisticsErrorCounterChanged(entityID, getStatisticsCounters(entityID));
+			});
+	}
+
+	void scheduleEventBusDrain() noexcept
+	{
+		// Can be called from any thread, the timer has to be started from the Qt Main Thread
+		QMetaObject::invokeMethod(this,
+			[this]()
+			{
+				if (!_eventBusTimer.isActive())
+				{
+					_eventBusTimer.start();
+				}
+			});
+	}
+
+	void drainEventBus() noexcept
+	{
+		ASSERT_QT_MAIN_THREAD;
+
+		// Records handed off before the pending events were posted are delivered first (the later ones are posted to the bus, see postObserverHandoff)
+		drainObserverHandoff();
+
+		auto const events = _eventBus.takePending();
+		auto const count = events.size();
+		auto index = std::size_t{ 0u };
+		while (index < count)
+		{
+			auto const batch = events[index].batch;
+			if (batch == CoalescingEventBus::Batch::None)
+			{
+				la::avdecc::utils::invokeProtectedHandler(events[index].event);
+				++index;
+				continue;
+			}
+
+			// Group consecutive events of the same batch kind
+			auto last = index;
+			auto entityIDs = EntityIDs{};
+			while (last < count && events[last].batch == batch)
+			{
+				entityIDs.push_back(events[last].entityID);
+				++last;
+			}
+
+			// Batched online notification is emitted first, so batch listeners already know the entities when the individual signals are emitted
+			if (batch == CoalescingEventBus::Batch::EntityOnline)
+			{
+				emitEntitiesOnline(entityIDs);
+			}
+
+			for (; index < last; ++index)
+			{
+				la::avdecc::utils::invokeProtectedHandler(events[index].event);
+			}
+
+			// Batched offline notification is emitted last, once the entities have been removed from the manager
+			if (batch == CoalescingEventBus::Batch::EntityOffline)
+			{
+				emitEntitiesOffline(entityIDs);
+			}
+		}
+	}
+
+	void drainBackgroundEventBus() noexcept
+	{
+		ASSERT_QT_MAIN_THREAD;
+
+		// Only coalesced events, of entities still online (discarded when the entity goes offline)
+		for (auto const& pendingEvent : _backgroundEventBus.takePending())
+		{
+			la::avdecc::utils::invokeProtectedHandler(pendingEvent.event);
+		}
+	}
+
+	void emitEntitiesOnline(EntityIDs const& entityIDs) noexcept
+	{
+		if (_rebootingEntities.empty())
+		{
+			emit entitiesOnline(entityIDs);
+			return;
+		}
+
+		// Rebooting entities back with the same entity model are only restored, the other ones are actually removed before being added again
+		auto onlineEntities = EntityIDs{};
+		auto restoredEntities = EntityIDs{};
+		auto removedEntities = EntityIDs{};
+		for (auto const entityID : entityIDs)
+		{
+			auto const it = _rebootingEntities.find(entityID);
+			if (it == _rebootingEntities.end())
+			{
+				onlineEntities.push_back(entityID);
+				continue;
+			}
+
+			auto const previousEntityModelID = it->second.entityModelID;
+			_rebootingEntities.erase(it);
+
+			auto entityModelID = la::avdecc::UniqueIdentifier{};
+			{
+				auto const lg = std::lock_guard{ _lock };
+				if (auto const timelineIt = _entityEnumerationTimelines.find(entityID); timelineIt != _entityEnumerationTimelines.end())
+				{
+					entityModelID = timelineIt->second.entityModelID;
+				}
+			}
+
+			if (entityModelID && entityModelID == previousEntityModelID)
+			{
+				restoredEntities.push_back(entityID);
+				auto const lg = std::lock_guard{ _lock };
+				if (auto const timelineIt = _entityEnumerationTimelines.find(entityID); timelineIt != _entityEnumerationTimelines.end())
+				{
+					timelineIt->second.restored = true;
+				}
+			}
+			else
+			{
+				removedEntities.push_back(entityID);
+				onlineEntities.push_back(entityID);
+			}
+		}
+
+		if (!removedEntities.empty())
+		{
+			emit entitiesOffline(removedEntities);
+		}
+		if (!restoredEntities.empty())
+		{
+			emit entitiesRestored(restoredEntities);
+		}
+		if (!onlineEntities.empty())
+		{
+			emit entitiesOnline(onlineEntities);
+		}
+		scheduleGracePeriodTimer();
+	}
+
+	void emitEntitiesOffline(EntityIDs const& entityIDs) noexcept
+	{
+		if (_rebootingEntities.empty())
+		{
+			emit entitiesOffline(entityIDs);
+			return;
+		}
+
+		auto offlineEntities = EntityIDs{};
+		auto rebootingEntities = EntityIDs{};
+		for (auto const entityID : entityIDs)
+		{
+			auto& entities = _rebootingEntities.count(entityID) != 0 ? rebootingEntities : offlineEntities;
+			entities.push_back(entityID);
+		}
+
+		if (!offlineEntities.empty())
+		{
+			emit entitiesOffline(offlineEntities);
+		}
+		if (!rebootingEntities.empty())
+		{
+			emit entitiesRebooting(rebootingEntities);
+		}
+		scheduleGracePeriodTimer();
+	}
+
+	struct ControllerConfiguration
+	{
+		la::avdecc::protocol::ProtocolInterface::Type protocolInterfaceType{ la::avdecc::protocol::ProtocolInterface::Type::None };
+		QString interfaceName{};
+		std::uint16_t progID{ 0u };
+		la::avdecc::UniqueIdentifier entityModelID{};
+		QString preferedLocale{};
+		QStringList secondaryInterfaceNames{};
+	};
+
+	/** Creates the controllers (primary and secondary ones) and registers to them */
+	void instantiateControllers(ControllerConfiguration const& configuration)
+	{
+		// Enumeration timelines are relative to the controller creation
+		_controllerCreationTime = std::chrono::steady_clock::now();
+
+		// Create a new controller and store it
+		SharedController controller = la::avdecc::controller::Controller::create(configuration.protocolInterfaceType, configuration.interfaceName.toStdString(), configuration.progID, configuration.entityModelID, configuration.preferedLocale.toStdString());
+#if HAVE_ATOMIC_SMART_POINTERS
+		_controller = std::move(controller);
+#else // !HAVE_ATOMIC_SMART_POINTERS
+		std::atomic_store(&_controller, std::move(controller));
+#endif // HAVE_ATOMIC_SMART_POINTERS
+		_controllerConfiguration = configuration;
+
+		// Create the secondary controllers, each one running on its own avdecc thread. All of them must exist before the first notification so entities are deduplicated
+		auto secondaryControllers = std::vector<SharedController>{};
+		for (auto const& name : configuration.secondaryInterfaceNames)
+		{
+			if (name != configuration.interfaceName && !name.isEmpty())
+			{
+				secondaryControllers.push_back(la::avdecc::controller::Controller::create(configuration.protocolInterfaceType, name.toStdString(), configuration.progID, configuration.entityModelID, configuration.preferedLocale.toStdString()));
+			}
+		}
+		{
+			auto const lg = std::lock_guard{ _controllersLock };
+			_secondaryControllers = secondaryControllers;
+		}
+		_hasSecondaryControllers = !secondaryControllers.empty();
+
+		// Re-get the controller, just in case another thread changed the controller at the same moment
+		auto ctrl = getController();
+		if (ctrl)
+		{
+			emit controllerOnline();
+			ctrl->registerObserver(this);
+			configureController(*ctrl);
+
+			for (auto const& secondaryController : secondaryControllers)
+			{
+				secondaryController->registerObserver(this);
+				configureController(*secondaryController);
+			}
+		}
+	}
+
+	/** Unregisters from the controllers and destroys them, discarding their pending events (what is known of the entities is left untouched) */
+	void releaseControllers() noexcept
+	{
+		// A replay feeds notifications of the controller, stop it first
+		stopObserverTraceReplay();
+
+		// First remove the observer so we don't get any new notifications
+		_controller->unregisterObserver(this);
+		auto secondaryControllers = std::vector<SharedController>{};
+		{
+			auto const lg = std::lock_guard{ _controllersLock };
+			secondaryControllers = std::move(_secondaryControllers);
+			_secondaryControllers.clear();
+		}
+		for (auto const& controller : secondaryControllers)
+		{
+			controller->unregisterObserver(this);
+		}
+		secondaryControllers.clear();
+
+		// And destroy the controller itself
+#if HAVE_ATOMIC_SMART_POINTERS
+		_controller = Controller{ nullptr };
+#else // !HAVE_ATOMIC_SMART_POINTERS
+		std::atomic_store(&_controller, SharedController{ nullptr });
+#endif // HAVE_ATOMIC_SMART_POINTERS
+
+		{
+			auto const lg = std::lock_guard{ _controllersLock };
+			_entityControllers.clear();
+		}
+		_hasSecondaryControllers = false;
+
+		// Discard pending events, they belong to the destroyed controllers
+		_eventBus.clear();
+		_eventBusTimer.stop();
+		_backgroundEventBus.clear();
+
+		// Result handlers of the commands in flight will never be called, forget the coalesced commands
+		{
+			auto const lg = std::lock_guard{ _coalescedAecpCommandsLock };
+			_coalescedAecpCommands.clear();
+			++_coalescedAecpCommandsGeneration;
+		}
+	}
+
+	void scheduleGracePeriodTimer() noexcept
+	{
+		if (_rebootingEntities.empty())
+		{
+			_gracePeriodTimer.stop();
+			return;
+		}
+
+		auto expiresAt = std::chrono::steady_clock::time_point::max();
+		for (auto const& [entityID, rebootingEntity] : _rebootingEntities)
+		{
+			expiresAt = std::min(expiresAt, rebootingEntity.expiresAt);
+		}
+		auto const remaining = std::chrono::duration_cast<std::chrono::milliseconds>(expiresAt - std::chrono::steady_clock::now());
+		_gracePeriodTimer.start(static_cast<int>(std::max(std::chrono::milliseconds{ 0 }, remaining).count()));
+	}
+
+	void expireRebootingEntities() noexcept
+	{
+		auto const now = std::chrono::steady_clock::now();
+		auto expiredEntities = EntityIDs{};
+		for (auto it = _rebootingEntities.begin(); it != _rebootingEntities.end();)
+		{
+			if (it->second.expiresAt <= now)
+			{
+				expiredEntities.push_back(it->first);
+				it = _rebootingEntities.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		if (!expiredEntities.empty())
+		{
+			emit entitiesOffline(expiredEntities);
+		}
+		scheduleGracePeriodTimer();
+	}
+
+	/** Returns true if the notifications of the entity coming from this controller should be forwarded (only the first controller which saw the entity online does, when there are several interfaces) */
+	bool isForwardingController(la::avdecc::controller::Controller const* const controller, la::avdecc::UniqueIdentifier const entityID) const noexcept
+	{
+		if (!_hasSecondaryControllers)
+		{
+			return true;
+		}
+
+		auto const lg = std::lock_guard{ _controllersLock };
+		auto const it = _entityControllers.find(entityID);
+		return it == _entityControllers.end() || it->second.front() == controller;
+	}
+
+	/** Adds a controller seeing the entity online. Returns true if it's the first one */
+	bool addEntityController(la::avdecc::controller::Controller const* const controller, la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		if (!_hasSecondaryControllers)
+		{
+			return true;
+		}
+
+		auto const lg = std::lock_guard{ _controllersLock };
+		auto& controllers = _entityControllers[entityID];
+		if (std::find(controllers.begin(), controllers.end(), controller) == controllers.end())
+		{
+			controllers.push_back(controller);
+		}
+		return controllers.front() == controller && controllers.size() == 1u;
+	}
+
+	/** Removes a controller which doesn't see the entity anymore. Returns true if it was the last one */
+	bool removeEntityController(la::avdecc::controller::Controller const* const controller, la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		if (!_hasSecondaryControllers)
+		{
+			return true;
+		}
+
+		auto const lg = std::lock_guard{ _controllersLock };
+		auto const it = _entityControllers.find(entityID);
+		if (it == _entityControllers.end())
+		{
+			return true;
+		}
+		auto& controllers = it->second;
+		controllers.erase(std::remove(controllers.begin(), controllers.end(), controller), controllers.end());
+		if (controllers.empty())
+		{
+			_entityControllers.erase(it);
+			return true;
+		}
+		return false;
+	}
+
+	/** Forwards an entity notification (see isForwardingController), recording it in the observer trace. Returns false if the notification should be ignored */
+	template<typename... Args>
+	bool forwardEvent(la::avdecc::controller::Controller const* const controller, observerTrace::EventType const type, la::avdecc::controller::ControlledEntity const* const entity, Args const&... args) noexcept
+	{
+		if (!isForwardingController(controller, entity->getEntity().getEntityID()))
+		{
+			return false;
+		}
+		recordEvent(type, entity, args...);
+		return true;
+	}
+
+	/** Records an entity notification in the observer trace, if recording */
+	template<typename... Args>
+	void recordEvent(observerTrace::EventType const type, la::avdecc::controller::ControlledEntity const* const entity, Args const&... args) noexcept
+	{
+		if (_traceRecorder.isRecording())
+		{
+			_traceRecorder.record(type, entity->getEntity().getEntityID(), args...);
+		}
+	}
+	/** Builds a new summary of the entity and publishes it in place of the previous one. Called from the notifying thread, before the matching signal is emitted */
+	void publishEntitySummary(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept
+	{
+		auto const& entity = controlledEntity.getEntity();
+		auto summary = std::make_shared<EntitySummary>();
+		summary->entityID = entity.getEntityID();
+		summary->entityModelID = entity.getEntityModelID();
+		summary->entityCapabilities = entity.getEntityCapabilities();
+		summary->name = helper::entityName(controlledEntity);
+		summary->smartName = helper::smartEntityName(controlledEntity);
+		summary->groupName = helper::groupName(controlledEntity);
+
+		if (summary->entityCapabilities.test(la::avdecc::entity::EntityCapability::AemSupported))
+		{
+			try
+			{
+				auto const& configurationNode = controlledEntity.getCurrentConfigurationNode();
+				summary->currentConfiguration = configurationNode.descriptorIndex;
+				for (auto const& [avbInterfaceIndex, avbInterfaceNode] : configurationNode.avbInterfaces)
+				{
+					auto& avbInterface = summary->avbInterfaces[avbInterfaceIndex];
+					avbInterface.grandMasterID = avbInterfaceNode.dynamicModel->gptpGrandmasterID;
+					avbInterface.grandMasterDomain = avbInterfaceNode.dynamicModel->gptpDomainNumber;
+					avbInterface.linkStatus = controlledEntity.getAvbInterfaceLinkStatus(avbInterfaceIndex);
+				}
+				for (auto const& [streamIndex, streamInputNode] : configurationNode.streamInputs)
+				{
+					summary->streamInputFormats[streamIndex] = streamInputNode.dynamicModel->streamFormat;
+				}
+				for (auto const& [streamIndex, streamOutputNode] : configurationNode.streamOutputs)
+				{
+					summary->streamOutputFormats[streamIndex] = streamOutputNode.dynamicModel->streamFormat;
+				}
+			}
+			catch (...)
+			{
+				// Partial summary, the configuration is not fully known yet
+			}
+		}
+
+		auto const lg = std::lock_guard{ _entitySummariesLock };
+		_entitySummaries[summary->entityID] = std::move(summary);
+	}
+
+	template<typename... Args, typename Function>
+	static bool dispatchObserverEvent(observerTrace::PayloadReader& reader, Function&& function)
+	{
+		// Braced initialization guarantees the arguments are read in order
+		auto const args = std::tuple<Args...>{ reader.template read<Args>()... };
+		if (!reader.isValid())
+		{
+			return false;
+		}
+		std::apply(std::forward<Function>(function), args);
+		return true;
+	}
+
+	/** Calls the observer method matching the event, as if it was received from the controller. Returns false if the event could not be replayed */
+	bool replayObserverEvent(la::avdecc::controller::Controller const& controller, observerTrace::Event const& event) noexcept
+	{
+		try
+		{
+			auto reader = observerTrace::PayloadReader{ event.payload };
+			auto const* const c = &controller;
+
+			// Global notifications
+			switch (event.type)
+			{
+				case observerTrace::EventType::TransportError:
+					onTransportError(c);
+					return true;
+				case observerTrace::EventType::StreamConnectionChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::StreamConnectionState, bool>(reader,
+						[this, c](auto const&... args)
+						{
+							onStreamConnectionChanged(c, args...);
+						});
+				default:
+					break;
+			}
+
+			// All other notifications are about an entity, which must be known by the controller (load the matching virtual entities before replaying)
+			auto const entityGuard = controller.getControlledEntityGuard(event.entityID);
+			if (!entityGuard)
+			{
+				return false;
+			}
+			auto const* const entity = entityGuard.get();
+
+			switch (event.type)
+			{
+				case observerTrace::EventType::EntityQueryError:
+					return dispatchObserverEvent<la::avdecc::controller::Controller::QueryCommandError>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onEntityQueryError(c, entity, args...);
+						});
+				case observerTrace::EventType::EntityOnline:
+					onEntityOnline(c, entity);
+					return true;
+				case observerTrace::EventType::EntityOffline:
+					onEntityOffline(c, entity);
+					return true;
+				case observerTrace::EventType::EntityCapabilitiesChanged:
+					onEntityCapabilitiesChanged(c, entity);
+					return true;
+				case observerTrace::EventType::EntityAssociationChanged:
+					onEntityAssociationChanged(c, entity);
+					return true;
+				case observerTrace::EventType::GptpChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::AvbInterfaceIndex, la::avdecc::UniqueIdentifier, std::uint8_t>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onGptpChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::UnsolicitedRegistrationChanged:
+					return dispatchObserverEvent<bool>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onUnsolicitedRegistrationChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::CompatibilityFlagsChanged:
+					return dispatchObserverEvent<la::avdecc::controller::ControlledEntity::CompatibilityFlags>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onCompatibilityFlagsChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::IdentificationStarted:
+					onIdentificationStarted(c, entity);
+					return true;
+				case observerTrace::EventType::IdentificationStopped:
+					onIdentificationStopped(c, entity);
+					return true;
+				case observerTrace::EventType::StreamConnectionsChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::StreamConnections>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onStreamConnectionsChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::AcquireStateChanged:
+					return dispatchObserverEvent<la::avdecc::controller::model::AcquireState, la::avdecc::UniqueIdentifier>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onAcquireStateChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::LockStateChanged:
+					return dispatchObserverEvent<la::avdecc::controller::model::LockState, la::avdecc::UniqueIdentifier>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onLockStateChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::StreamInputFormatChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::StreamFormat>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onStreamInputFormatChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::StreamOutputFormatChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::StreamFormat>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onStreamOutputFormatChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::StreamInputDynamicInfoChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::StreamDynamicInfo>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onStreamInputDynamicInfoChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::StreamOutputDynamicInfoChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::StreamDynamicInfo>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onStreamOutputDynamicInfoChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::EntityNameChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::AvdeccFixedString>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onEntityNameChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::EntityGroupNameChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::AvdeccFixedString>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onEntityGroupNameChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::ConfigurationNameChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::AvdeccFixedString>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onConfigurationNameChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::AudioUnitNameChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::AudioUnitIndex, la::avdecc::entity::model::AvdeccFixedString>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onAudioUnitNameChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::StreamInputNameChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::AvdeccFixedString>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onStreamInputNameChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::StreamOutputNameChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::AvdeccFixedString>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onStreamOutputNameChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::AvbInterfaceNameChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::AvbInterfaceIndex, la::avdecc::entity::model::AvdeccFixedString>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onAvbInterfaceNameChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::ClockSourceNameChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::ClockSourceIndex, la::avdecc::entity::model::AvdeccFixedString>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onClockSourceNameChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::MemoryObjectNameChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::MemoryObjectIndex, la::avdecc::entity::model::AvdeccFixedString>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onMemoryObjectNameChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::AudioClusterNameChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::ClusterIndex, la::avdecc::entity::model::AvdeccFixedString>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onAudioClusterNameChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::ClockDomainNameChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::ClockDomainIndex, la::avdecc::entity::model::AvdeccFixedString>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onClockDomainNameChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::AudioUnitSamplingRateChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::AudioUnitIndex, la::avdecc::entity::model::SamplingRate>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onAudioUnitSamplingRateChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::ClockSourceChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::ClockDomainIndex, la::avdecc::entity::model::ClockSourceIndex>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onClockSourceChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::StreamInputStarted:
+					return dispatchObserverEvent<la::avdecc::entity::model::StreamIndex>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onStreamInputStarted(c, entity, args...);
+						});
+				case observerTrace::EventType::StreamOutputStarted:
+					return dispatchObserverEvent<la::avdecc::entity::model::StreamIndex>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onStreamOutputStarted(c, entity, args...);
+						});
+				case observerTrace::EventType::StreamInputStopped:
+					return dispatchObserverEvent<la::avdecc::entity::model::StreamIndex>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onStreamInputStopped(c, entity, args...);
+						});
+				case observerTrace::EventType::StreamOutputStopped:
+					return dispatchObserverEvent<la::avdecc::entity::model::StreamIndex>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onStreamOutputStopped(c, entity, args...);
+						});
+				case observerTrace::EventType::AvbInterfaceInfoChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::AvbInterfaceIndex, la::avdecc::entity::model::AvbInterfaceInfo>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onAvbInterfaceInfoChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::AsPathChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::AvbInterfaceIndex, la::avdecc::entity::model::AsPath>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onAsPathChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::AvbInterfaceLinkStatusChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::AvbInterfaceIndex, la::avdecc::controller::ControlledEntity::InterfaceLinkStatus>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onAvbInterfaceLinkStatusChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::EntityCountersChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::EntityCounters>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onEntityCountersChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::AvbInterfaceCountersChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::AvbInterfaceIndex, la::avdecc::entity::model::AvbInterfaceCounters>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onAvbInterfaceCountersChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::ClockDomainCountersChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::ClockDomainIndex, la::avdecc::entity::model::ClockDomainCounters>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onClockDomainCountersChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::StreamInputCountersChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::StreamInputCounters>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onStreamInputCountersChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::StreamOutputCountersChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::StreamOutputCounters>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onStreamOutputCountersChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::MemoryObjectLengthChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::MemoryObjectIndex, std::uint64_t>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onMemoryObjectLengthChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::StreamPortInputAudioMappingsChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::StreamPortIndex>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onStreamPortInputAudioMappingsChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::StreamPortOutputAudioMappingsChanged:
+					return dispatchObserverEvent<la::avdecc::entity::model::StreamPortIndex>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onStreamPortOutputAudioMappingsChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::OperationProgress:
+					return dispatchObserverEvent<la::avdecc::entity::model::DescriptorType, la::avdecc::entity::model::DescriptorIndex, la::avdecc::entity::model::OperationID, float>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onOperationProgress(c, entity, args...);
+						});
+				case observerTrace::EventType::OperationCompleted:
+					return dispatchObserverEvent<la::avdecc::entity::model::DescriptorType, la::avdecc::entity::model::DescriptorIndex, la::avdecc::entity::model::OperationID, bool>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onOperationCompleted(c, entity, args...);
+						});
+				case observerTrace::EventType::AecpRetryCounterChanged:
+					return dispatchObserverEvent<std::uint64_t>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onAecpRetryCounterChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::AecpTimeoutCounterChanged:
+					return dispatchObserverEvent<std::uint64_t>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onAecpTimeoutCounterChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::AecpUnexpectedResponseCounterChanged:
+					return dispatchObserverEvent<std::uint64_t>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onAecpUnexpectedResponseCounterChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::AecpResponseAverageTimeChanged:
+					return dispatchObserverEvent<std::chrono::milliseconds>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onAecpResponseAverageTimeChanged(c, entity, args...);
+						});
+				case observerTrace::EventType::AemAecpUnsolicitedCounterChanged:
+					return dispatchObserverEvent<std::uint64_t>(reader,
+						[this, c, entity](auto const&... args)
+						{
+							onAemAecpUnsolicitedCounterChanged(c, entity, args...);
+						});
+				default:
+					break;
+			}
+		}
+		catch (...)
+		{
+		}
+		return false;
+	}
+
+	/** Source of the events to replay, returns std::nullopt once there is no more event */
+	using ObserverEventSource = std::function<std::optional<observerTrace::Event>()>;
+
+	/** Replays the events of the source until it is exhausted or the replay is aborted. Returns the replayed and skipped counts */
+	std::pair<int, int> replayObserverEvents(ObserverEventSource const& nextEvent, bool const originalTiming) noexcept
+	{
+		auto replayedCount = 0;
+		auto skippedCount = 0;
+		auto const startTime = std::chrono::steady_clock::now();
+
+		while (!_observerTraceReplayAborted)
+		{
+			auto const event = nextEvent();
+			if (!event)
+			{
+				break;
+			}
+
+			// Wait for the event time, still checking for abort regularly
+			if (originalTiming)
+			{
+				auto const eventTime = startTime + event->timestamp;
+				while (!_observerTraceReplayAborted && std::chrono::steady_clock::now() < eventTime)
+				{
+					std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(eventTime - std::chrono::steady_clock::now(), ObserverTraceReplayAbortCheckDelay));
+				}
+			}
+
+			auto const controller = getController();
+			if (!controller)
+			{
+				break;
+			}
+
+			if (replayObserverEvent(*controller, *event))
+			{
+				++replayedCount;
+			}
+			else
+			{
+				++skippedCount;
+			}
+		}
+
+		return { replayedCount, skippedCount };
+	}
+
+	void replayObserverTrace(observerTrace::Reader reader, bool const originalTiming) noexcept
+	{
+		auto const counts = replayObserverEvents(
+			[&reader]()
+			{
+				return reader.next();
+			},
+			originalTiming);
+
+		QMetaObject::invokeMethod(this,
+			[this, counts]()
+			{
+				emit observerTraceReplayFinished(counts.first, counts.second);
+			});
+	}
+
+	void runStressLoad(stressLoad::Generator& generator) noexcept
+	{
+		auto counts = replayObserverEvents(
+			[&generator]()
+			{
+				return generator.next();
+			},
+			true);
+
+		// Bring the network back to its initial state, even if the load was stopped
+		if (auto const controller = getController())
+		{
+			for (auto const& event : generator.restoringEvents())
+			{
+				auto& count = replayObserverEvent(*controller, event) ? counts.first : counts.second;
+				++count;
+			}
+		}
+
+		_isStressLoadRunning = false;
+
+		QMetaObject::invokeMethod(this,
+			[this, counts]()
+			{
+				emit stressLoadFinished(counts.first, counts.second);
+			});
+	}
+
+	SharedController getController() noexcept
+	{
+#if HAVE_ATOMIC_SMART_POINTERS
+		return _controller;
+#else // !HAVE_ATOMIC_SMART_POINTERS
+		return std::atomic_load(&_controller);
+#endif // HAVE_ATOMIC_SMART_POINTERS
 	}
 
-	virtual void removeStreamPortOutputAudioMappings(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::StreamPortIndex const streamPortIndex, la::avdecc::entity::model::AudioMappings const& mappings, RemoveStreamPortOutputAudioMappingsHandler const& handler) noexcept override
+	SharedConstController getController() const noexcept
 	{
-		auto controller = getController();
-		if (controller)
-		{
-			emit beginAecpCommand(targetEntityID, AecpCommandType::RemoveStreamPortAudioMappings);
-			controller->removeStreamPortOutputAudioMappings(targetEntityID, streamPortIndex, mappings,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::RemoveStreamPortAudioMappings, status);
-					}
-				});
-		}
+#if HAVE_ATOMIC_SMART_POINTERS
+		return _controller;
+#else // !HAVE_ATOMIC_SMART_POINTERS
+		return std::atomic_load(&_controller);
+#endif // HAVE_ATOMIC_SMART_POINTERS
 	}
 
-	virtual void startStoreAndRebootMemoryObjectOperation(la::avdecc::UniqueIdentifier targetEntityID, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, StartStoreAndRebootMemoryObjectOperationHandler const& handler) noexcept override
+	// State of a readDeviceMemoryChunked operation, shared by the handlers of its reads
+	struct ChunkedMemoryRead
 	{
-		auto controller = getController();
-		if (controller)
+		std::mutex lock{};
+		la::avdecc::UniqueIdentifier entityID{};
+		std::uint64_t address{ 0u };
+		std::uint64_t length{ 0u };
+		std::size_t windowSize{ 1u };
+		std::uint64_t nextOffset{ 0u }; // Offset of the next chunk to request
+		std::uint64_t receivedLength{ 0u };
+		std::size_t readsInFlight{ 0u };
+		bool isCompleted{ false }; // The completion handler has been (or is being) called
+		la::avdecc::entity::ControllerEntity::AaCommandStatus status{ la::avdecc::entity::ControllerEntity::AaCommandStatus::Success };
+		la::avdecc::controller::Controller::DeviceMemoryBuffer buffer{};
+		la::avdecc::controller::Controller::ReadDeviceMemoryProgressHandler progressHandler{};
+		la::avdecc::controller::Controller::ReadDeviceMemoryCompletionHandler completionHandler{};
+	};
+
+	// Requests chunks until the window is full (each one fitting a single AA TLV, so it's answered in one round-trip)
+	void requestMemoryChunks(std::shared_ptr<ChunkedMemoryRead> const& read) const noexcept
+	{
+		static constexpr auto ChunkSize = static_cast<std::uint64_t>(la::avdecc::protocol::AaAecpdu::MaximumSingleTlvMemoryDataLength);
+
+		auto chunks = std::vector<std::pair<std::uint64_t, std::uint64_t>>{};
 		{
-			if (!handler)
+			auto const lg = std::lock_guard{ read->lock };
+			while (!!read->status && read->readsInFlight < read->windowSize && read->nextOffset < read->length)
 			{
-				emit beginAecpCommand(targetEntityID, AecpCommandType::StartStoreAndRebootMemoryObjectOperation);
+				auto const chunkLength = std::min(ChunkSize, read->length - read->nextOffset);
+				chunks.emplace_back(read->nextOffset, chunkLength);
+				read->nextOffset += chunkLength;
+				++read->readsInFlight;
 			}
-			controller->startStoreAndRebootMemoryObjectOperation(targetEntityID, descriptorIndex,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, la::avdecc::entity::model::OperationID const operationID) noexcept
-				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status, operationID);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::StartStoreAndRebootMemoryObjectOperation, status);
-					}
-				});
 		}
-	}
 
-	virtual void startUploadMemoryObjectOperation(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, std::uint64_t const dataLength, StartUploadMemoryObjectOperationHandler const& handler) noexcept override
-	{
-		auto controller = getController();
-		if (controller)
+		auto controller = getController(read->entityID);
+		for (auto const& [offset, chunkLength] : chunks)
 		{
-			if (!handler)
+			if (!controller)
 			{
-				emit beginAecpCommand(targetEntityID, AecpCommandType::StartUploadMemoryObjectOperation);
+				// Entity went offline in the meantime
+				onMemoryChunkRead(read, nullptr, offset, la::avdecc::entity::ControllerEntity::AaCommandStatus::UnknownEntity, {});
+				continue;
 			}
-			controller->startUploadMemoryObjectOperation(targetEntityID, descriptorIndex, dataLength,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, la::avdecc::entity::model::OperationID const operationID) noexcept
+
+			controller->readDeviceMemory(read->entityID, read->address + offset, chunkLength, nullptr,
+				[this, read, offset = offset](la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::ControllerEntity::AaCommandStatus const status, la::avdecc::controller::Controller::DeviceMemoryBuffer const& memoryBuffer)
 				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status, operationID);
-					}
-					else
-					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::StartUploadMemoryObjectOperation, status);
-					}
+					onMemoryChunkRead(read, entity, offset, status, memoryBuffer);
 				});
 		}
 	}
 
-	virtual void abortOperation(la::avdecc::UniqueIdentifier const targetEntityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, la::avdecc::entity::model::OperationID const operationID, AbortOperationHandler const& handler) noexcept override
+	void onMemoryChunkRead(std::shared_ptr<ChunkedMemoryRead> const& read, la::avdecc::controller::ControlledEntity const* const entity, std::uint64_t const offset, la::avdecc::entity::ControllerEntity::AaCommandStatus const status, la::avdecc::controller::Controller::DeviceMemoryBuffer const& memoryBuffer) const noexcept
 	{
-		auto controller = getController();
-		if (controller)
+		auto isComplete = false;
+		auto percentComplete = 0.0f;
 		{
-			if (!handler)
+			auto const lg = std::lock_guard{ read->lock };
+			--read->readsInFlight;
+
+			if (!!read->status)
 			{
-				emit beginAecpCommand(targetEntityID, AecpCommandType::AbortOperation);
+				// Only the first failure is reported, the reads still in flight are just waited for
+				if (!status || offset + memoryBuffer.size() > read->length)
+				{
+					read->status = !status ? status : la::avdecc::entity::ControllerEntity::AaCommandStatus::DataInvalid;
+				}
+				else
+				{
+					std::memcpy(read->buffer.data() + offset, memoryBuffer.data(), memoryBuffer.size());
+					read->receivedLength += memoryBuffer.size();
+				}
 			}
-			controller->abortOperation(targetEntityID, descriptorType, descriptorIndex, operationID,
-				[this, targetEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status) noexcept
+
+			isComplete = !read->isCompleted && read->readsInFlight == 0u && (!read->status || read->nextOffset >= read->length);
+			read->isCompleted |= isComplete;
+			percentComplete = read->length != 0u ? static_cast<float>(static_cast<double>(read->receivedLength) * 100.0 / static_cast<double>(read->length)) : 100.0f;
+		}
+
+		if (isComplete)
+		{
+			completeMemoryRead(read, entity);
+			return;
+		}
+
+		// Returning true from the progress handler aborts the read
+		if (read->progressHandler)
+		{
+			auto shouldAbort = false;
+			try
+			{
+				shouldAbort = read->progressHandler(entity, percentComplete);
+			}
+			catch (...)
+			{
+				AVDECC_ASSERT(false, "Progress handler should not throw");
+			}
+
+			if (shouldAbort)
+			{
+				auto isAbortComplete = false;
 				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, targetEntityID, status);
-					}
-					else
+					auto const lg = std::lock_guard{ read->lock };
+					if (!!read->status && !read->isCompleted)
 					{
-						emit endAecpCommand(targetEntityID, AecpCommandType::AbortOperation, status);
+						read->status = la::avdecc::entity::ControllerEntity::AaCommandStatus::Aborted;
+						// No other read left to report the completion
+						isAbortComplete = read->readsInFlight == 0u;
+						read->isCompleted |= isAbortComplete;
 					}
-				});
+				}
+				if (isAbortComplete)
+				{
+					completeMemoryRead(read, entity);
+					return;
+				}
+			}
 		}
+
+		requestMemoryChunks(read);
 	}
 
-	/* Enumeration and Control Protocol (AECP) AA */
-	virtual void readDeviceMemory(la::avdecc::UniqueIdentifier const targetEntityID, std::uint64_t const address, std::uint64_t const length, la::avdecc::controller::Controller::ReadDeviceMemoryProgressHandler const& progressHandler, la::avdecc::controller::Controller::ReadDeviceMemoryCompletionHandler const& completionHandler) const noexcept override
+	void completeMemoryRead(std::shared_ptr<ChunkedMemoryRead> const& read, la::avdecc::controller::ControlledEntity const* const entity) const noexcept
 	{
-		auto controller = getController();
-		if (controller)
+		if (!read->status)
 		{
-			controller->readDeviceMemory(targetEntityID, address, length, progressHandler, completionHandler);
+			read->buffer.clear();
+		}
+		if (read->completionHandler)
+		{
+			la::avdecc::utils::invokeProtectedHandler(read->completionHandler, entity, read->status, read->buffer);
 		}
 	}
 
-	virtual void writeDeviceMemory(la::avdecc::UniqueIdentifier const targetEntityID, std::uint64_t const address, la::avdecc::controller::Controller::DeviceMemoryBuffer memoryBuffer, la::avdecc::controller::Controller::WriteDeviceMemoryProgressHandler const& progressHandler, la::avdecc::controller::Controller::WriteDeviceMemoryCompletionHandler const& completionHandler) const noexcept override
+	// State of a writeDeviceMemoryChunked operation, shared by the handlers of its writes
+	struct ChunkedMemoryWrite
 	{
-		auto controller = getController();
-		if (controller)
+		std::mutex lock{};
+		la::avdecc::UniqueIdentifier entityID{};
+		std::uint64_t address{ 0u };
+		SharedMemoryImage image{}; // Shared with the other writes of the same image, only read
+		std::size_t windowSize{ 1u };
+		std::uint64_t nextOffset{ 0u }; // Offset of the next chunk to send
+		std::uint64_t writtenLength{ 0u };
+		std::size_t writesInFlight{ 0u };
+		bool isCompleted{ false }; // The completion handler has been (or is being) called
+		la::avdecc::entity::ControllerEntity::AaCommandStatus status{ la::avdecc::entity::ControllerEntity::AaCommandStatus::Success };
+		la::avdecc::controller::Controller::WriteDeviceMemoryProgressHandler progressHandler{};
+		la::avdecc::controller::Controller::WriteDeviceMemoryCompletionHandler completionHandler{};
+	};
+
+	// Sends chunks until the window is full, only the chunk being sent being copied out of the image
+	void requestMemoryWriteChunks(std::shared_ptr<ChunkedMemoryWrite> const& write) const noexcept
+	{
+		static constexpr auto ChunkSize = static_cast<std::uint64_t>(la::avdecc::protocol::AaAecpdu::MaximumSingleTlvMemoryDataLength);
+
+		auto chunks = std::vector<std::pair<std::uint64_t, std::uint64_t>>{};
 		{
-			controller->writeDeviceMemory(targetEntityID, address, memoryBuffer, progressHandler, completionHandler);
+			auto const lg = std::lock_guard{ write->lock };
+			while (!!write->status && write->writesInFlight < write->windowSize && write->nextOffset < write->image.size)
+			{
+				auto const chunkLength = std::min(ChunkSize, write->image.size - write->nextOffset);
+				chunks.emplace_back(write->nextOffset, chunkLength);
+				write->nextOffset += chunkLength;
+				++write->writesInFlight;
+			}
 		}
-	}
 
-	/* Connection Management Protocol (ACMP) */
-	virtual void connectStream(la::avdecc::UniqueIdentifier const talkerEntityID, la::avdecc::entity::model::StreamIndex const talkerStreamIndex, la::avdecc::UniqueIdentifier const listenerEntityID, la::avdecc::entity::model::StreamIndex const listenerStreamIndex, ConnectStreamHandler const& handler) noexcept override
-	{
-		auto controller = getController();
-		if (controller)
+		auto controller = getController(write->entityID);
+		for (auto const& [offset, chunkLength] : chunks)
 		{
-			emit beginAcmpCommand(talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, AcmpCommandType::ConnectStream);
-			controller->connectStream({ talkerEntityID, talkerStreamIndex }, { listenerEntityID, listenerStreamIndex },
-				[this, talkerEntityID, listenerEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*talkerEntity*/, la::avdecc::controller::ControlledEntity const* const /*listenerEntity*/, la::avdecc::entity::model::StreamIndex const talkerStreamIndex, la::avdecc::entity::model::StreamIndex const listenerStreamIndex, la::avdecc::entity::ControllerEntity::ControlStatus const status) noexcept
+			if (!controller)
+			{
+				// Entity went offline in the meantime
+				onMemoryChunkWritten(write, nullptr, chunkLength, la::avdecc::entity::ControllerEntity::AaCommandStatus::UnknownEntity);
+				continue;
+			}
+
+			controller->writeDeviceMemory(write->entityID, write->address + offset, la::avdecc::controller::Controller::DeviceMemoryBuffer{ write->image.data + offset, static_cast<size_t>(chunkLength) }, nullptr,
+				[this, write, chunkLength = chunkLength](la::avdecc::controller::ControlledEntity const* const entity, la::avdecc::entity::ControllerEntity::AaCommandStatus const status)
 				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, status);
-					}
-					else
-					{
-						emit endAcmpCommand(talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, AcmpCommandType::ConnectStream, status);
-					}
+					onMemoryChunkWritten(write, entity, chunkLength, status);
 				});
 		}
 	}
 
-	virtual void disconnectStream(la::avdecc::UniqueIdentifier const talkerEntityID, la::avdecc::entity::model::StreamIndex const talkerStreamIndex, la::avdecc::UniqueIdentifier const listenerEntityID, la::avdecc::entity::model::StreamIndex const listenerStreamIndex, DisconnectStreamHandler const& handler) noexcept override
+	void onMemoryChunkWritten(std::shared_ptr<ChunkedMemoryWrite> const& write, la::avdecc::controller::ControlledEntity const* const entity, std::uint64_t const chunkLength, la::avdecc::entity::ControllerEntity::AaCommandStatus const status) const noexcept
 	{
-		auto controller = getController();
-		if (controller)
+		auto isComplete = false;
+		auto percentComplete = 0.0f;
 		{
-			emit beginAcmpCommand(talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, AcmpCommandType::DisconnectStream);
-			controller->disconnectStream({ talkerEntityID, talkerStreamIndex }, { listenerEntityID, listenerStreamIndex },
-				[this, talkerEntityID, talkerStreamIndex, listenerEntityID, handler](la::avdecc::controller::ControlledEntity const* const /*listenerEntity*/, la::avdecc::entity::model::StreamIndex const listenerStreamIndex, la::avdecc::entity::ControllerEntity::ControlStatus const status) noexcept
+			auto const lg = std::lock_guard{ write->lock };
+			--write->writesInFlight;
+
+			if (!!write->status)
+			{
+				// Only the first failure is reported, the writes still in flight are just waited for
+				if (!status)
 				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, status);
-					}
-					else
-					{
-						emit endAcmpCommand(talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, AcmpCommandType::DisconnectStream, status);
-					}
-				});
+					write->status = status;
+				}
+				else
+				{
+					write->writtenLength += chunkLength;
+				}
+			}
+
+			isComplete = !write->isCompleted && write->writesInFlight == 0u && (!write->status || write->nextOffset >= write->image.size);
+			write->isCompleted |= isComplete;
+			percentComplete = static_cast<float>(static_cast<double>(write->writtenLength) * 100.0 / static_cast<double>(write->image.size));
 		}
-	}
 
-	virtual void disconnectTalkerStream(la::avdecc::UniqueIdentifier const talkerEntityID, la::avdecc::entity::model::StreamIndex const talkerStreamIndex, la::avdecc::UniqueIdentifier const listenerEntityID, la::avdecc::entity::model::StreamIndex const listenerStreamIndex, DisconnectTalkerStreamHandler const& handler) noexcept override
-	{
-		auto controller = getController();
-		if (controller)
+		if (isComplete)
 		{
-			emit beginAcmpCommand(talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, AcmpCommandType::DisconnectTalkerStream);
-			controller->disconnectTalkerStream({ talkerEntityID, talkerStreamIndex }, { listenerEntityID, listenerStreamIndex },
-				[this, talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, handler](la::avdecc::entity::ControllerEntity::ControlStatus const status) noexcept
+			completeMemoryWrite(write, entity);
+			return;
+		}
+
+		// Returning true from the progress handler aborts the write
+		if (write->progressHandler)
+		{
+			auto shouldAbort = false;
+			try
+			{
+				shouldAbort = write->progressHandler(entity, percentComplete);
+			}
+			catch (...)
+			{
+				AVDECC_ASSERT(false, "Progress handler should not throw");
+			}
+
+			if (shouldAbort)
+			{
+				auto isAbortComplete = false;
 				{
-					if (handler)
-					{
-						la::avdecc::utils::invokeProtectedHandler(handler, talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, status);
-					}
-					else
+					auto const lg = std::lock_guard{ write->lock };
+					if (!!write->status && !write->isCompleted)
 					{
-						emit endAcmpCommand(talkerEntityID, talkerStreamIndex, listenerEntityID, listenerStreamIndex, AcmpCommandType::DisconnectTalkerStream, status);
+						write->status = la::avdecc::entity::ControllerEntity::AaCommandStatus::Aborted;
+						// No other write left to report the completion
+						isAbortComplete = write->writesInFlight == 0u;
+						write->isCompleted |= isAbortComplete;
 					}
-				});
+				}
+				if (isAbortComplete)
+				{
+					completeMemoryWrite(write, entity);
+					return;
+				}
+			}
 		}
+
+		requestMemoryWriteChunks(write);
 	}
 
-	virtual void requestExclusiveAccess(la::avdecc::UniqueIdentifier const entityID, la::avdecc::controller::Controller::ExclusiveAccessToken::AccessType const type, RequestExclusiveAccessHandler const& handler) noexcept override
+	void completeMemoryWrite(std::shared_ptr<ChunkedMemoryWrite> const& write, la::avdecc::controller::ControlledEntity const* const entity) const noexcept
 	{
-		auto controller = getController();
-		if (controller)
+		if (write->completionHandler)
 		{
-			controller->requestExclusiveAccess(entityID, type,
-				[this, entityID, handler](auto const* const /*entity*/, auto const status, auto&& token) noexcept
-				{
-					la::avdecc::utils::invokeProtectedHandler(handler, entityID, status, std::move(token));
-				});
+			la::avdecc::utils::invokeProtectedHandler(write->completionHandler, entity, write->status);
 		}
 	}
 
-
-	virtual void foreachEntity(ControlledEntityCallback const& callback) noexcept override
+	/** Gets the controller to use to address the entity: the one forwarding its notifications, or the main controller */
+	SharedConstController getController(la::avdecc::UniqueIdentifier const entityID) const noexcept
 	{
-		auto controller = getController();
-		if (controller)
+		if (_hasSecondaryControllers)
 		{
-			// Build a vector of all locked entities
-			auto controlledEntities = std::vector<la::avdecc::controller::ControlledEntityGuard>{};
-
+			auto const lg = std::lock_guard{ _controllersLock };
+			if (auto const it = _entityControllers.find(entityID); it != _entityControllers.end())
 			{
-				auto const lg = std::lock_guard{ _lock };
-				for (auto& entityID : _entities)
+				for (auto const& controller : _secondaryControllers)
 				{
-					auto ceg = getControlledEntity(entityID);
-					if (AVDECC_ASSERT_WITH_RET(!!ceg, "ControllerManager model not up-to-date with avdecc::controller"))
+					if (controller.get() == it->second.front())
 					{
-						controlledEntities.push_back(std::move(ceg));
+						return controller;
 					}
 				}
 			}
-
-			for (auto const& controlledEntity : controlledEntities)
-			{
-				callback(controlledEntity->getEntity().getEntityID(), *controlledEntity);
-			}
 		}
+		return getController();
 	}
 
-	// Private methods
-	SharedController getController() noexcept
+	SharedController getController(la::avdecc::UniqueIdentifier const entityID) noexcept
 	{
-#if HAVE_ATOMIC_SMART_POINTERS
-		return _controller;
-#else // !HAVE_ATOMIC_SMART_POINTERS
-		return std::atomic_load(&_controller);
-#endif // HAVE_ATOMIC_SMART_POINTERS
+		return std::const_pointer_cast<la::avdecc::controller::Controller>(std::as_const(*this).getController(entityID));
 	}
 
-	SharedConstController getController() const noexcept
+	/** Returns true if the static entity model of the entities is cached, either explicitly (setting) or so that entities coming back within the offline grace period with the same entity model ID only have their dynamic information queried */
+	bool isEntityModelCacheEnabled() const noexcept
 	{
-#if HAVE_ATOMIC_SMART_POINTERS
-		return _controller;
-#else // !HAVE_ATOMIC_SMART_POINTERS
-		return std::atomic_load(&_controller);
-#endif // HAVE_ATOMIC_SMART_POINTERS
+		return _enableAemCache || _offlineGracePeriod.count() > 0;
+	}
+
+	/** Applies the current settings to the running controllers */
+	void reconfigureControllers() noexcept
+	{
+		if (auto ctrl = getController())
+		{
+			configureController(*ctrl);
+		}
+		auto const lg = std::lock_guard{ _controllersLock };
+		for (auto const& secondaryController : _secondaryControllers)
+		{
+			configureController(*secondaryController);
+		}
+	}
+
+	/** Applies the current settings to a newly created controller */
+	void configureController(la::avdecc::controller::Controller& controller) noexcept
+	{
+		//controller.enableEntityAdvertising(10);
+
+		if (isEntityModelCacheEnabled())
+		{
+			controller.enableEntityModelCache();
+		}
+		else
+		{
+			controller.disableEntityModelCache();
+		}
+
+		if (_fullAemEnumeration)
+		{
+			controller.enableFullStaticEntityModelEnumeration();
+		}
+		else
+		{
+			controller.disableFullStaticEntityModelEnumeration();
+		}
 	}
 
 	// Private members
@@ -1748,11 +5255,58 @@ private:
 	SharedController _controller{ nullptr };
 #endif // HAVE_ATOMIC_SMART_POINTERS
 
+	std::vector<SharedController> _secondaryControllers{}; // One per additional interface, only changed from the Qt Main Thread
+	std::atomic_bool _hasSecondaryControllers{ false };
+	mutable std::mutex _controllersLock{}; // _secondaryControllers and _entityControllers exclusive access
+	std::unordered_map<la::avdecc::UniqueIdentifier, std::vector<la::avdecc::controller::Controller const*>, la::avdecc::UniqueIdentifier::hash> _entityControllers{}; // Controllers seeing each entity online, the first one forwarding its notifications (only with secondary controllers)
 	mutable std::mutex _lock{}; // Data members exclusive access
 	std::set<la::avdecc::UniqueIdentifier> _entities; // Online entities
-	std::unordered_map<la::avdecc::UniqueIdentifier, ErrorCounterTracker, la::avdecc::UniqueIdentifier::hash> _entityErrorCounterTrackers; // Entities error counter flags
+	std::unordered_map<la::avdecc::UniqueIdentifier, ErrorCounterTracker, la::avdecc::UniqueIdentifier::hash> _entityErrorCounterTrackers; // Entities error counter flags and counters history
+	std::unordered_map<la::avdecc::UniqueIdentifier, AecpCommandLatencies, la::avdecc::UniqueIdentifier::hash> _entityAecpCommandLatencies; // Entities AECP commands response time
+	std::unordered_map<la::avdecc::UniqueIdentifier, EnumerationTimeline, la::avdecc::UniqueIdentifier::hash> _entityEnumerationTimelines; // Entities enumeration timeline (including entities which went offline since)
+	std::unordered_map<la::avdecc::UniqueIdentifier, std::uint32_t, la::avdecc::UniqueIdentifier::hash> _entityEnumerationQueryErrors; // Query errors of the entities being enumerated
+	mutable std::mutex _entitySummariesLock{}; // Only held while swapping or copying a summary pointer, never while building one
+	std::unordered_map<la::avdecc::UniqueIdentifier, SharedEntitySummary, la::avdecc::UniqueIdentifier::hash> _entitySummaries{}; // Latest published summary of the online entities
+	StreamStates _streamInputMediaLockedStates{}; // Last delivered media locked state of the stream inputs (Qt Main Thread only)
+	StreamStates _streamOutputStartedStates{}; // Last delivered started state of the stream outputs (Qt Main Thread only)
+	std::chrono::steady_clock::time_point _controllerCreationTime{};
+	std::optional<ControllerConfiguration> _controllerConfiguration{}; // Configuration of the current controllers, used by a soft reload
 	bool _enableAemCache{ false };
 	bool _fullAemEnumeration{ false };
+	CoalescingEventBus _eventBus{}; // Events from the avdecc threads, waiting to be delivered to the Qt Main Thread
+	ObserverHandoff _observerHandoff{}; // Small notifications from the avdecc threads, delivered to the Qt Main Thread at the next event loop pass
+	QTimer _eventBusTimer{}; // Drain timer for _eventBus
+	using EntitySet = std::unordered_set<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash>;
+	std::atomic_bool _visibilityDrivenNotifications{ false };
+	mutable std::mutex _interestLock{}; // _visibleEntities, _selectedEntity and _watchedEntities exclusive access (read from the avdecc threads)
+	EntitySet _visibleEntities{};
+	la::avdecc::UniqueIdentifier _selectedEntity{};
+	EntitySet _watchedEntities{};
+	CoalescingEventBus _backgroundEventBus{}; // High rate events of the entities without interest, delivered at BackgroundEventBusPeriod
+	QTimer _backgroundEventBusTimer{}; // Drain timer for _backgroundEventBus
+	struct CoalescedAecpCommandSlot
+	{
+		bool inFlight{ false };
+		CoalescedAecpCommandSender pendingSender{}; // Latest value submitted while the command was in flight
+		CoalescedAecpCommandHandler pendingHandler{};
+	};
+	std::mutex _coalescedAecpCommandsLock{}; // _coalescedAecpCommands and _coalescedAecpCommandsGeneration exclusive access
+	std::unordered_map<CoalescedAecpCommandKey, CoalescedAecpCommandSlot, CoalescedAecpCommandKey::hash> _coalescedAecpCommands{}; // Only the commands in flight
+	std::uint64_t _coalescedAecpCommandsGeneration{ 0u }; // Incremented when the controller is destroyed
+	struct RebootingEntity
+	{
+		la::avdecc::UniqueIdentifier entityModelID{};
+		std::chrono::steady_clock::time_point expiresAt{};
+	};
+	std::unordered_map<la::avdecc::UniqueIdentifier, RebootingEntity, la::avdecc::UniqueIdentifier::hash> _rebootingEntities{}; // Offline entities within their grace period (batch listeners still display them), only accessed from the Qt Main Thread
+	std::chrono::seconds _offlineGracePeriod{ 0 };
+	QTimer _gracePeriodTimer{};
+	observerTrace::Recorder _traceRecorder{}; // Records the observer notifications, when enabled
+	std::thread _observerTraceReplayThread{};
+	std::atomic_bool _observerTraceReplayAborted{ false };
+	std::atomic_bool _isStressLoadRunning{ false }; // The replay thread is running a stress load
+	QThreadPool _entityVisitorPool{}; // foreachEntityParallel workers (one per core, the calling thread being the last one)
+	QThreadPool _virtualEntityLoaderPool{}; // Declared last so it is destroyed (waiting for its tasks) first
 };
 
 QString ControllerManager::typeToString(AecpCommandType const type) noexcept
@@ -1820,6 +5374,28 @@ QString ControllerManager::typeToString(AecpCommandType const type) noexcept
 	}
 }
 
+std::optional<bool> ControllerManager::isMediaLocked(la::avdecc::entity::model::StreamInputCounters const& counters) noexcept
+{
+	auto const lockedIt = counters.find(la::avdecc::entity::StreamInputCounterValidFlag::MediaLocked);
+	auto const unlockedIt = counters.find(la::avdecc::entity::StreamInputCounterValidFlag::MediaUnlocked);
+	if (lockedIt == counters.end() || unlockedIt == counters.end())
+	{
+		return std::nullopt;
+	}
+	return lockedIt->second == (unlockedIt->second + 1);
+}
+
+std::optional<bool> ControllerManager::isStreamStarted(la::avdecc::entity::model::StreamOutputCounters const& counters) noexcept
+{
+	auto const startIt = counters.find(la::avdecc::entity::StreamOutputCounterValidFlag::StreamStart);
+	auto const stopIt = counters.find(la::avdecc::entity::StreamOutputCounterValidFlag::StreamStop);
+	if (startIt == counters.end() || stopIt == counters.end())
+	{
+		return std::nullopt;
+	}
+	return startIt->second == (stopIt->second + 1);
+}
+
 QString ControllerManager::typeToString(AcmpCommandType const type) noexcept
 {
 	switch (type)
@@ -21,16 +21,27 @@
 
 #include <la/avdecc/controller/avdeccController.hpp>
 
+#include "counterHistory.hpp"
+#include "latencyHistogram.hpp"
+#include "stressLoad.hpp"
+
+#include <array>
 #include <memory>
 #include <chrono>
+#include <map>
+#include <optional>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
 #include <cstdint>
 
 #include <QObject>
-#include <QApplication>
+#include <QCoreApplication>
 #include <QThread>
+#include <QString>
+#include <QStringList>
 
-#define ASSERT_QT_MAIN_THREAD AVDECC_ASSERT(QApplication::instance()->thread() == QThread::currentThread(), "Should be in Qt Main Thread")
+#define ASSERT_QT_MAIN_THREAD AVDECC_ASSERT(QCoreApplication::instance()->thread() == QThread::currentThread(), "Should be in Qt Main Thread")
 
 namespace avdecc
 {
@@ -49,8 +60,103 @@ public:
 		AecpUnexpectedResponses = 1u << 2,
 	};
 
-	using StreamInputErrorCounters = std::unordered_map<la::avdecc::entity::StreamInputCounterValidFlag, la::avdecc::entity::model::DescriptorCounter>;
+	/** Errors (increment since the last clear) of the counters of a StreamInput, trivially copyable so it can be emitted without any allocation */
+	struct StreamInputErrorCounters
+	{
+		static constexpr std::size_t FlagsCount = 32u; // One per bit of the counters valid flags
+
+		/** Index of the flag in the counters array (its bit position) */
+		static constexpr std::size_t flagIndex(la::avdecc::entity::StreamInputCounterValidFlag const flag) noexcept
+		{
+			auto value = static_cast<std::uint32_t>(la::avdecc::utils::to_integral(flag));
+			auto index = std::size_t{ 0u };
+			while (value > 1u)
+			{
+				value >>= 1;
+				++index;
+			}
+			return index;
+		}
+
+		static constexpr la::avdecc::entity::StreamInputCounterValidFlag flagFromIndex(std::size_t const index) noexcept
+		{
+			return static_cast<la::avdecc::entity::StreamInputCounterValidFlag>(std::uint32_t{ 1u } << index);
+		}
+
+		/** True if no counter is in error */
+		constexpr bool empty() const noexcept
+		{
+			return errorFlags == 0u;
+		}
+
+		constexpr bool hasError(la::avdecc::entity::StreamInputCounterValidFlag const flag) const noexcept
+		{
+			return (errorFlags & static_cast<std::uint32_t>(la::avdecc::utils::to_integral(flag))) != 0u;
+		}
+
+		/** Increment of the counter since it was last cleared, 0 if not in error */
+		constexpr la::avdecc::entity::model::DescriptorCounter getErrorCount(la::avdecc::entity::StreamInputCounterValidFlag const flag) const noexcept
+		{
+			return hasError(flag) ? counters[flagIndex(flag)] : 0u;
+		}
+
+		constexpr void setErrorCount(std::size_t const index, la::avdecc::entity::model::DescriptorCounter const count) noexcept
+		{
+			counters[index] = count;
+			errorFlags |= std::uint32_t{ 1u } << index;
+		}
+
+		std::uint32_t errorFlags{ 0u }; // StreamInputCounterValidFlag bits of the counters in error
+		std::array<la::avdecc::entity::model::DescriptorCounter, FlagsCount> counters{}; // Indexed by flag bit, only meaningful for the flags in error
+	};
+	static_assert(std::is_trivially_copyable_v<StreamInputErrorCounters>, "StreamInputErrorCounters should be trivially copyable");
+
 	using StatisticsErrorCounters = std::unordered_map<StatisticsErrorCounterFlag, std::uint64_t>;
+	using StreamInputCountersHistory = std::unordered_map<la::avdecc::entity::StreamInputCounterValidFlag, CounterHistory>;
+	using StatisticsCountersHistory = std::unordered_map<StatisticsErrorCounterFlag, CounterHistory>;
+	using EntityIDs = std::vector<la::avdecc::UniqueIdentifier>;
+
+	/** ExclusiveAccessTokens of several entities, released together (in reverse EntityID order) when the group is destroyed or release() is called */
+	class ExclusiveAccessGroup final
+	{
+	public:
+		using Token = la::avdecc::controller::Controller::ExclusiveAccessToken::UniquePointer;
+
+		ExclusiveAccessGroup() noexcept = default;
+		~ExclusiveAccessGroup() noexcept
+		{
+			release();
+		}
+
+		void add(la::avdecc::UniqueIdentifier const entityID, Token&& token) noexcept
+		{
+			_tokens[entityID] = std::move(token);
+		}
+
+		void release() noexcept
+		{
+			while (!_tokens.empty())
+			{
+				_tokens.erase(std::prev(_tokens.end()));
+			}
+		}
+
+		bool hasToken(la::avdecc::UniqueIdentifier const entityID) const noexcept
+		{
+			return _tokens.count(entityID) != 0;
+		}
+
+		// Deleted compiler auto-generated methods
+		ExclusiveAccessGroup(ExclusiveAccessGroup const&) = delete;
+		ExclusiveAccessGroup(ExclusiveAccessGroup&&) = delete;
+		ExclusiveAccessGroup& operator=(ExclusiveAccessGroup const&) = delete;
+		ExclusiveAccessGroup& operator=(ExclusiveAccessGroup&&) = delete;
+
+	private:
+		std::map<la::avdecc::UniqueIdentifier, Token> _tokens{};
+	};
+	using ExclusiveAccessGroupPointer = std::shared_ptr<ExclusiveAccessGroup>;
+	using ExclusiveAccessFailures = std::map<la::avdecc::UniqueIdentifier, la::avdecc::entity::ControllerEntity::AemCommandStatus>;
 
 	enum class AecpCommandType
 	{
@@ -83,6 +189,54 @@ public:
 		AbortOperation,
 	};
 
+	/** AECP commands response time of an entity, for all commands and per command type (including commands that timed out) */
+	struct AecpCommandLatencies
+	{
+		LatencyHistogram allCommands{};
+		std::unordered_map<AecpCommandType, LatencyHistogram> perCommandType{};
+	};
+
+	/** Enumeration of an entity as observed by the controller. Times are relative to the controller creation */
+	struct EnumerationTimeline
+	{
+		la::avdecc::UniqueIdentifier entityModelID{};
+		std::chrono::milliseconds discoveredAt{}; // ADP discovery (start of the enumeration)
+		std::chrono::milliseconds onlineAt{}; // Enumeration completed (all descriptors and dynamic information retrieved, registered for unsolicited notifications)
+		std::chrono::milliseconds enumerationTime{}; // Between discovery and online
+		std::uint32_t queryErrors{ 0u }; // Enumeration queries that failed (and were retried or given up) during the enumeration
+		std::uint64_t aecpRetries{ 0u }; // At the end of the enumeration
+		std::uint64_t aecpTimeouts{ 0u }; // At the end of the enumeration
+		std::uint64_t aecpUnexpectedResponses{ 0u }; // At the end of the enumeration
+		std::chrono::milliseconds aecpResponseAverageTime{}; // At the end of the enumeration
+		bool aemCacheEnabled{ false };
+		bool fullStaticModelEnabled{ false };
+		bool restored{ false }; // Came back within the offline grace period with the same entity model, its static model being read from the entity model cache and its views only refreshed
+	};
+	using EnumerationTimelines = std::vector<std::pair<la::avdecc::UniqueIdentifier, EnumerationTimeline>>;
+
+	/** Immutable summary of the most displayed information of an online entity. A new instance is published each time one of its values changes, so it can be read without locking the entity */
+	struct EntitySummary
+	{
+		struct AvbInterface
+		{
+			la::avdecc::UniqueIdentifier grandMasterID{};
+			std::uint8_t grandMasterDomain{ 0u };
+			la::avdecc::controller::ControlledEntity::InterfaceLinkStatus linkStatus{ la::avdecc::controller::ControlledEntity::InterfaceLinkStatus::Unknown };
+		};
+
+		la::avdecc::UniqueIdentifier entityID{};
+		la::avdecc::UniqueIdentifier entityModelID{};
+		la::avdecc::entity::EntityCapabilities entityCapabilities{};
+		QString name{}; // Entity name, as set by the user (might be empty)
+		QString smartName{}; // Entity name, or a descriptive name if not set
+		QString groupName{};
+		std::optional<la::avdecc::entity::model::ConfigurationIndex> currentConfiguration{}; // Only for AEM entities
+		std::map<la::avdecc::entity::model::AvbInterfaceIndex, AvbInterface> avbInterfaces{};
+		std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::StreamFormat> streamInputFormats{};
+		std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::StreamFormat> streamOutputFormats{};
+	};
+	using SharedEntitySummary = std::shared_ptr<EntitySummary const>;
+
 	enum class AcmpCommandType
 	{
 		None = 0,
@@ -91,6 +245,27 @@ public:
 		DisconnectTalkerStream,
 	};
 
+	/**
+	* @brief Status given to the handler of a command superseded before being sent (not an AEM protocol status).
+	* @details Commands changing the value of a descriptor (names, stream formats, sampling rate, clock source) are coalesced: while one is in flight, only the last value submitted for the same entity, command type and descriptor is kept and sent once it completes.
+	*          The earlier queued values are dropped: neither beginAecpCommand nor endAecpCommand is emitted for them, and their handler (if any) is called with this status.
+	*/
+	static constexpr auto AemCommandStatusSuperseded = static_cast<la::avdecc::entity::ControllerEntity::AemCommandStatus>(0x7FFE);
+
+	/** Default number of AA reads in flight for readDeviceMemoryChunked */
+	static constexpr std::size_t DefaultDeviceMemoryReadWindow = 8u;
+
+	/** Default number of AA writes in flight for writeDeviceMemoryChunked (memory objects usually expect their data in order) */
+	static constexpr std::size_t DefaultDeviceMemoryWriteWindow = 1u;
+
+	/** Read-only memory image that can be written to several entities at once, owner keeping data alive as long as a write references it */
+	struct SharedMemoryImage
+	{
+		std::shared_ptr<void const> owner{};
+		std::uint8_t const* data{ nullptr };
+		std::uint64_t size{ 0u };
+	};
+
 	/* AECP handlers to override the global AECP result process. WARNING: Handler are always called from a non-gui thread. */
 	using AcquireEntityHandler = std::function<void(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, la::avdecc::UniqueIdentifier const owningEntity)>;
 	using ReleaseEntityHandler = std::function<void(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status)>;
@@ -117,6 +292,8 @@ public:
 	using StopStreamInputHandler = std::function<void(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status)>;
 	using StartStreamOutputHandler = std::function<void(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status)>;
 	using StopStreamOutputHandler = std::function<void(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status)>;
+	using LoadVirtualEntityResult = std::tuple<QString, la::avdecc::jsonSerializer::DeserializationError, std::string>; // "FilePath", "Error", "Message"
+	using LoadVirtualEntitiesHandler = std::function<void(std::vector<LoadVirtualEntityResult> const& results)>;
 	using AddStreamPortInputAudioMappingsHandler = std::function<void(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status)>;
 	using AddStreamPortOutputAudioMappingsHandler = std::function<void(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status)>;
 	using RemoveStreamPortInputAudioMappingsHandler = std::function<void(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status)>;
@@ -129,34 +306,69 @@ public:
 	using DisconnectStreamHandler = std::function<void(la::avdecc::UniqueIdentifier const talkerEntityID, la::avdecc::entity::model::StreamIndex const talkerStreamIndex, la::avdecc::UniqueIdentifier const listenerEntityID, la::avdecc::entity::model::StreamIndex const listenerStreamIndex, la::avdecc::entity::ControllerEntity::ControlStatus const status)>;
 	using DisconnectTalkerStreamHandler = std::function<void(la::avdecc::UniqueIdentifier const talkerEntityID, la::avdecc::entity::model::StreamIndex const talkerStreamIndex, la::avdecc::UniqueIdentifier const listenerEntityID, la::avdecc::entity::model::StreamIndex const listenerStreamIndex, la::avdecc::entity::ControllerEntity::ControlStatus const status)>;
 	using RequestExclusiveAccessHandler = std::function<void(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, la::avdecc::controller::Controller::ExclusiveAccessToken::UniquePointer&& token)>;
+	using RequestExclusiveAccessesHandler = std::function<void(ExclusiveAccessGroupPointer const& group, ExclusiveAccessFailures const& failures)>;
 
 	/**
 	* @brief Creates a new controller, replacing previous one if any.
 	* @details Creates a new controller, first removing the previous one if any.
 	*          If an error occurs during the setup of the new controller, the previous one is NOT restored.
+	*          An additional controller is created for each of the secondaryInterfaceNames (to enumerate both legs of a redundant network at the same time).
+	*          Entities seen by several controllers are merged by EntityID: their notifications are only forwarded from the first controller which saw them online, and commands are sent through it.
 	* @note Might throw la::avdecc::controller::Controller::Exception.
 	*       All observers should be removed from the previous controller before setting a new one.
 	*/
-	virtual void createController(la::avdecc::protocol::ProtocolInterface::Type const protocolInterfaceType, QString const& interfaceName, std::uint16_t const progID, la::avdecc::UniqueIdentifier const entityModelID, QString const& preferedLocale) = 0;
+	virtual void createController(la::avdecc::protocol::ProtocolInterface::Type const protocolInterfaceType, QString const& interfaceName, std::uint16_t const progID, la::avdecc::UniqueIdentifier const entityModelID, QString const& preferedLocale, QStringList const& secondaryInterfaceNames = {}) = 0;
 
-	/** Destroys the currently stored instance of the controller. */
+	/** Destroys the currently stored instance of the controller (and the secondary ones). */
 	virtual void destroyController() noexcept = 0;
 
-	/** Gets the controller's EID */
+	/**
+	* @brief Soft reload: re-creates the controllers with the same configuration, without tearing down what is known of the entities.
+	* @details The online entities are handled as rebooting ones (entitiesRebooting, for at least SoftReloadGracePeriod) so the models keep them,
+	*          and the ones coming back with the same entity model are reconciled in place (entitiesRestored). controllerOffline is not emitted.
+	*          Does nothing if there is no controller.
+	* @note Might throw la::avdecc::controller::Controller::Exception.
+	*/
+	virtual void reloadController() = 0;
+
+	/** Gets the controller's EID (of the controller on the main interface) */
 	virtual la::avdecc::UniqueIdentifier getControllerEID() const noexcept = 0;
 
 	/** Gets a ControlledEntity */
 	virtual la::avdecc::controller::ControlledEntityGuard getControlledEntity(la::avdecc::UniqueIdentifier const entityID) const noexcept = 0;
 
+	/** Gets the latest summary of an online entity, without locking it (nullptr if the entity is not online). The returned summary never changes, get it again when notified of a change */
+	virtual SharedEntitySummary getEntitySummary(la::avdecc::UniqueIdentifier const entityID) const noexcept = 0;
+
 	/** Serialize all known ControlledEntities */
 	virtual std::tuple<la::avdecc::jsonSerializer::SerializationError, std::string> serializeAllControlledEntitiesAsJson(QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags, QString const& dumpSource) const noexcept = 0;
 
 	/** Serialize a ControlledEntity */
 	virtual std::tuple<la::avdecc::jsonSerializer::SerializationError, std::string> serializeControlledEntityAsJson(la::avdecc::UniqueIdentifier const entityID, QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags, QString const& dumpSource) const noexcept = 0;
 
+	/** Deserializes a file representing the static model of an entity, and loads it in the entity model cache of the controller (used by the entities with the same entity model ID when the cache is enabled). */
+	virtual std::tuple<la::avdecc::jsonSerializer::DeserializationError, std::string> loadEntityModelFile(QString const& filePath) noexcept = 0;
+
 	/** Deserializes a JSON file representing an entity, and loads it as a virtual ControlledEntity. */
 	virtual std::tuple<la::avdecc::jsonSerializer::DeserializationError, std::string> loadVirtualEntityFromJson(QString const& filePath, la::avdecc::entity::model::jsonSerializer::Flags const flags) noexcept = 0;
 
+	/** Deserializes multiple files representing entities in parallel (MessagePack, or JSON for '.json' files), and loads them as virtual ControlledEntities. The handler is called in the Qt Main Thread once all files are processed, with the results in the same order as filePaths. */
+	virtual void loadVirtualEntitiesFromFiles(QStringList const& filePaths, la::avdecc::entity::model::jsonSerializer::Flags const flags, LoadVirtualEntitiesHandler const& handler) noexcept = 0;
+
+	/** Records all the Controller::Observer notifications received, with their timestamp, to a compact binary trace file (stops the previous recording) */
+	virtual bool startObserverTraceRecording(QString const& filePath) noexcept = 0;
+	virtual void stopObserverTraceRecording() noexcept = 0;
+	virtual bool isRecordingObserverTrace() const noexcept = 0;
+
+	/** Replays a trace recorded by startObserverTraceRecording on the current controller, from a dedicated thread, with the original timing or as fast as possible. Notifications about entities unknown to the controller are skipped (load the matching virtual entities first). observerTraceReplayFinished is emitted once done */
+	virtual bool startObserverTraceReplay(QString const& filePath, bool const originalTiming) noexcept = 0;
+	virtual void stopObserverTraceReplay() noexcept = 0;
+
+	/** Drives the online entities through a synthetic churn (see stressLoad), fed from a dedicated thread through the same path as a trace replay (stopping the replay in progress). Meant for soak tests on virtual entities. stressLoadFinished is emitted once the duration elapsed or the load was stopped, after the offline entities and changed names are restored */
+	virtual bool startStressLoad(stressLoad::Parameters const& parameters) noexcept = 0;
+	virtual void stopStressLoad() noexcept = 0;
+	virtual bool isStressLoadRunning() const noexcept = 0;
+
 	/** Counter error flags */
 	virtual StreamInputErrorCounters getStreamInputErrorCounters(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex) const noexcept = 0;
 	virtual void clearStreamInputCounterValidFlags(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::StreamInputCounterValidFlag const flag) noexcept = 0;
@@ -165,6 +377,27 @@ public:
 	virtual void clearStatisticsCounterValidFlags(la::avdecc::UniqueIdentifier const entityID, StatisticsErrorCounterFlag const flag) noexcept = 0;
 	virtual void clearAllStatisticsCounterValidFlags(la::avdecc::UniqueIdentifier const entityID) noexcept = 0;
 
+	/** Counters history (last CounterHistory::Capacity values received for each counter) */
+	virtual StreamInputCountersHistory getStreamInputCountersHistory(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex) const noexcept = 0;
+	virtual StatisticsCountersHistory getStatisticsCountersHistory(la::avdecc::UniqueIdentifier const entityID) const noexcept = 0;
+
+	/** AECP commands latency, measured between beginAecpCommand and endAecpCommand (or the result handler) */
+	virtual AecpCommandLatencies getAecpCommandLatencies(la::avdecc::UniqueIdentifier const entityID) const noexcept = 0;
+
+	/** Enumeration timeline of an entity (kept until the controller is destroyed, even if the entity goes offline) */
+	virtual std::optional<EnumerationTimeline> getEnumerationTimeline(la::avdecc::UniqueIdentifier const entityID) const noexcept = 0;
+	/** Enumeration timelines of all the entities enumerated since the controller was created, sorted by discovery time */
+	virtual EnumerationTimelines getEnumerationTimelines() const noexcept = 0;
+
+	/**
+	* @brief Entities of interest, for the visibility-driven notifications (Controller_VisibilityDrivenNotifications setting).
+	* @details When enabled, the high rate notifications (counters and AECP statistics) of the entities which are neither visible, selected nor watched (Controller_WatchedEntities setting) are only delivered every few seconds, with their latest value.
+	*          Pending values of an entity are delivered as soon as it becomes of interest. State changes and error flags are always delivered right away.
+	*/
+	virtual void setVisibleEntities(EntityIDs const& entityIDs) noexcept = 0;
+	virtual void setSelectedEntity(la::avdecc::UniqueIdentifier const entityID) noexcept = 0;
+	virtual bool isEntityOfInterest(la::avdecc::UniqueIdentifier const entityID) const noexcept = 0;
+
 	/* Enumeration and Control Protocol (AECP) */
 	virtual void acquireEntity(la::avdecc::UniqueIdentifier const targetEntityID, bool const isPersistent, AcquireEntityHandler const& handler = {}) noexcept = 0;
 	virtual void releaseEntity(la::avdecc::UniqueIdentifier const targetEntityID, ReleaseEntityHandler const& handler = {}) noexcept = 0;
@@ -203,6 +436,20 @@ public:
 	/* Enumeration and Control Protocol (AECP) AA */
 	virtual void readDeviceMemory(la::avdecc::UniqueIdentifier const targetEntityID, std::uint64_t const address, std::uint64_t const length, la::avdecc::controller::Controller::ReadDeviceMemoryProgressHandler const& progressHandler, la::avdecc::controller::Controller::ReadDeviceMemoryCompletionHandler const& completionHandler) const noexcept = 0;
 	virtual void writeDeviceMemory(la::avdecc::UniqueIdentifier const targetEntityID, std::uint64_t const address, la::avdecc::controller::Controller::DeviceMemoryBuffer memoryBuffer, la::avdecc::controller::Controller::WriteDeviceMemoryProgressHandler const& progressHandler, la::avdecc::controller::Controller::WriteDeviceMemoryCompletionHandler const& completionHandler) const noexcept = 0;
+	/**
+	* @brief Reads device memory by chunks fitting a single AA TLV, with up to windowSize reads in flight at once, assembled into a buffer allocated once.
+	* @details Throughput scales with the window instead of being bounded by the round-trip time of each read. The progress handler (which may return true to abort) is called each time a chunk is received.
+	*          The completion handler is called once all the reads in flight completed, with the first failure if any (no more chunk is requested after a failure or an abort, and the buffer is then empty).
+	*          Handlers are called from a non-gui thread.
+	*/
+	virtual void readDeviceMemoryChunked(la::avdecc::UniqueIdentifier const targetEntityID, std::uint64_t const address, std::uint64_t const length, std::size_t const windowSize, la::avdecc::controller::Controller::ReadDeviceMemoryProgressHandler const& progressHandler, la::avdecc::controller::Controller::ReadDeviceMemoryCompletionHandler const& completionHandler) const noexcept = 0;
+	/**
+	* @brief Writes a shared memory image by chunks fitting a single AA TLV, each chunk being read from the image at the offset of this write (the image itself is never copied).
+	* @details The same image can be written to several entities at once, each write keeping a reference on it until it completes. Up to windowSize writes are in flight at once.
+	*          The progress handler (which may return true to abort) is called each time a chunk is acknowledged, the completion handler once all the writes in flight completed, with the first failure if any.
+	*          Handlers are called from a non-gui thread.
+	*/
+	virtual void writeDeviceMemoryChunked(la::avdecc::UniqueIdentifier const targetEntityID, std::uint64_t const address, SharedMemoryImage const& image, std::size_t const windowSize, la::avdecc::controller::Controller::WriteDeviceMemoryProgressHandler const& progressHandler, la::avdecc::controller::Controller::WriteDeviceMemoryCompletionHandler const& completionHandler) const noexcept = 0;
 
 	/* Connection Management Protocol (ACMP) */
 	virtual void connectStream(la::avdecc::UniqueIdentifier const talkerEntityID, la::avdecc::entity::model::StreamIndex const talkerStreamIndex, la::avdecc::UniqueIdentifier const listenerEntityID, la::avdecc::entity::model::StreamIndex const listenerStreamIndex, ConnectStreamHandler const& handler = {}) noexcept = 0;
@@ -211,23 +458,84 @@ public:
 
 	/** Requests an ExclusiveAccessToken for the specified entityID. If the call succeeded (AemCommandStatus::Success), a valid token will be returned. */
 	virtual void requestExclusiveAccess(la::avdecc::UniqueIdentifier const entityID, la::avdecc::controller::Controller::ExclusiveAccessToken::AccessType const type, RequestExclusiveAccessHandler const& handler) noexcept = 0;
+	/**
+	* @brief Requests an ExclusiveAccessToken for each of the specified entities, all the requests being sent at once in ascending EntityID order.
+	* @details All or nothing: if any entity refuses the access (locked or acquired by another controller, timeout, ...), the tokens already obtained are released
+	*          immediately and the handler gets a null group along with the refusals. A controller never keeps part of a group while waiting for the rest, so two
+	*          controllers requesting overlapping groups cannot block each other. Entities not implementing the exclusive access are considered granted (without token).
+	*          The handler is called once, possibly from the avdecc thread.
+	*/
+	virtual void requestExclusiveAccesses(EntityIDs const& entityIDs, la::avdecc::controller::Controller::ExclusiveAccessToken::AccessType const type, RequestExclusiveAccessesHandler const& handler) noexcept = 0;
 
 	using ControlledEntityCallback = std::function<void(la::avdecc::UniqueIdentifier const&, la::avdecc::controller::ControlledEntity const&)>;
 	virtual void foreachEntity(ControlledEntityCallback const& callback) noexcept = 0;
 
+	/** Gets the EntityIDs of all the online entities, at the time of the call */
+	virtual EntityIDs getOnlineEntities() const noexcept = 0;
+
+	/**
+	* @brief Calls the callback for each of the specified entities, in parallel.
+	* @details The entities are processed on a thread pool (and the calling thread), each call only holding the guard of its own entity.
+	*          Entities which are no longer online are skipped. Returns once all the calls completed.
+	* @note The callback must be thread-safe, index is the position of the entity in entityIDs.
+	*/
+	using ParallelControlledEntityCallback = std::function<void(std::size_t const index, la::avdecc::UniqueIdentifier const& entityID, la::avdecc::controller::ControlledEntity const& controlledEntity)>;
+	virtual void foreachEntityParallel(EntityIDs const& entityIDs, ParallelControlledEntityCallback const& callback) noexcept = 0;
+
+	/**
+	* @brief Parallel map-reduce on all the online entities.
+	* @details map(entityID, controlledEntity) is called in parallel for each online entity (see foreachEntityParallel), then reduce(entityID, mapResult) is called
+	*          in the calling thread for each mapped entity, in a stable order. The map function must be thread-safe and must not access the UI.
+	*/
+	template<typename MapFunction, typename ReduceFunction>
+	void mapReduceEntities(MapFunction&& map, ReduceFunction&& reduce) noexcept
+	{
+		using MapResult = std::invoke_result_t<MapFunction, la::avdecc::UniqueIdentifier const&, la::avdecc::controller::ControlledEntity const&>;
+
+		auto const entityIDs = getOnlineEntities();
+		auto results = std::vector<std::optional<MapResult>>(entityIDs.size());
+		foreachEntityParallel(entityIDs,
+			[&map, &results](std::size_t const index, la::avdecc::UniqueIdentifier const& entityID, la::avdecc::controller::ControlledEntity const& controlledEntity)
+			{
+				// Each index is only written by a single call
+				results[index] = map(entityID, controlledEntity);
+			});
+
+		for (auto index = std::size_t{ 0u }; index < entityIDs.size(); ++index)
+		{
+			if (results[index])
+			{
+				reduce(entityIDs[index], std::move(*results[index]));
+			}
+		}
+	}
+
 	/* Static methods */
 	static QString typeToString(AecpCommandType const type) noexcept;
 	static QString typeToString(AcmpCommandType const type) noexcept;
+	static std::optional<bool> isMediaLocked(la::avdecc::entity::model::StreamInputCounters const& counters) noexcept; // From MediaLocked/MediaUnlocked counters, nothing if one is missing
+	static std::optional<bool> isStreamStarted(la::avdecc::entity::model::StreamOutputCounters const& counters) noexcept; // From StreamStart/StreamStop counters, nothing if one is missing
 
 	/* Controller signals */
 	Q_SIGNAL void controllerOnline();
 	Q_SIGNAL void controllerOffline();
+	Q_SIGNAL void observerTraceReplayFinished(int const replayedCount, int const skippedCount);
+	Q_SIGNAL void stressLoadFinished(int const generatedCount, int const skippedCount);
 
 	/* Entity changed signals */
+	/* Large payloads (dynamic info, AS path, connections, counters) are copied once from the avdecc thread and then emitted from the Qt Main Thread, connect them from the Qt Main Thread (and receive them by reference) so they are never copied again per receiver */
 	Q_SIGNAL void transportError();
 	Q_SIGNAL void entityQueryError(la::avdecc::UniqueIdentifier const entityID, la::avdecc::controller::Controller::QueryCommandError const error);
 	Q_SIGNAL void entityOnline(la::avdecc::UniqueIdentifier const entityID, std::chrono::milliseconds const enumerationTime);
 	Q_SIGNAL void entityOffline(la::avdecc::UniqueIdentifier const entityID);
+	/** @brief Batched version of entityOnline, emitted once for consecutive entities going online (before the individual entityOnline signals). */
+	Q_SIGNAL void entitiesOnline(avdecc::ControllerManager::EntityIDs const& entityIDs);
+	/** @brief Batched version of entityOffline, emitted once for consecutive entities going offline (after the individual entityOffline signals). */
+	Q_SIGNAL void entitiesOffline(avdecc::ControllerManager::EntityIDs const& entityIDs);
+	/** @brief Emitted instead of entitiesOffline when an offline grace period is configured, the entities being expected back (reboot). entitiesOffline is emitted if they are not back when the grace period expires. The individual entityOffline signals are not delayed. */
+	Q_SIGNAL void entitiesRebooting(avdecc::ControllerManager::EntityIDs const& entityIDs);
+	/** @brief Emitted instead of entitiesOnline for rebooting entities back with the same entity model before the grace period expired, only their dynamic state has to be refreshed. The individual entityOnline signals are still emitted. */
+	Q_SIGNAL void entitiesRestored(avdecc::ControllerManager::EntityIDs const& entityIDs);
 	Q_SIGNAL void unsolicitedRegistrationChanged(la::avdecc::UniqueIdentifier const entityID);
 	Q_SIGNAL void compatibilityFlagsChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::controller::ControlledEntity::CompatibilityFlags const compatibilityFlags);
 	Q_SIGNAL void identificationStarted(la::avdecc::UniqueIdentifier const entityID);
@@ -258,6 +566,8 @@ public:
 	Q_SIGNAL void clockDomainCountersChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockDomainCounters const& counters);
 	Q_SIGNAL void streamInputCountersChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamInputCounters const& counters);
 	Q_SIGNAL void streamOutputCountersChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamOutputCounters const& counters);
+	Q_SIGNAL void streamInputMediaLockedChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, bool const isMediaLocked); // Only emitted when the state derived from the counters changes
+	Q_SIGNAL void streamOutputStartedChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, bool const isStarted); // Only emitted when the state derived from the counters changes
 	Q_SIGNAL void memoryObjectLengthChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, std::uint64_t const length);
 	Q_SIGNAL void streamPortAudioMappingsChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamPortIndex const streamPortIndex);
 	Q_SIGNAL void operationProgress(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, la::avdecc::entity::model::OperationID const operationID, float const percentComplete); // A negative percentComplete value means the progress is unknown but still continuing
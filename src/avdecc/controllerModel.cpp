@@ -22,8 +22,13 @@
 #include "entityLogoCache.hpp"
 #include "imageItemDelegate.hpp"
 #include "errorItemDelegate.hpp"
+#include "frameScheduler.hpp"
 #include "avdecc/controllerManager.hpp"
 #include "avdecc/mcDomainManager.hpp"
+#include "avdecc/bandwidthAccounting.hpp"
+#include "avdecc/memoryAccounting.hpp"
+#include "avdecc/namePool.hpp"
+#include "avdecc/networkSnapshot.hpp"
 #include "settingsManager/settings.hpp"
 #include "toolkit/material/color.hpp"
 
@@ -31,18 +36,28 @@
 #include <la/avdecc/logger.hpp>
 
 #include <QFont>
+#include <QImage>
+#include <QPixmap>
+#include <QStringList>
 
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <optional>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 Q_DECLARE_METATYPE(la::avdecc::UniqueIdentifier)
 
 namespace avdecc
 {
-enum class ExclusiveAccessState
+enum class ExclusiveAccessState : std::uint8_t
 {
 	NoAccess = 0,
 	NotSupported = 1,
@@ -50,7 +65,7 @@ enum class ExclusiveAccessState
 	AccessSelf = 3,
 };
 
-enum class Compatibility
+enum class Compatibility : std::uint8_t
 {
 	NotCompliant,
 	IEEE,
@@ -61,6 +76,7 @@ enum class Compatibility
 
 struct MediaClockInfo
 {
+	la::avdecc::UniqueIdentifier masterEntityID{}; // Resolved remote media clock master (invalid if Self or on error)
 	QString masterID;
 	QString masterName;
 };
@@ -125,6 +141,18 @@ ExclusiveAccessState computeLockState(la::avdecc::controller::model::LockState c
 	}
 }
 
+QString computeMediaClockMasterName(la::avdecc::UniqueIdentifier const& masterEntityID)
+{
+	if (masterEntityID)
+	{
+		if (auto const summary = avdecc::ControllerManager::getInstance().getEntitySummary(masterEntityID))
+		{
+			return summary->name;
+		}
+	}
+	return {};
+}
+
 MediaClockInfo computeMediaClockInfo(la::avdecc::UniqueIdentifier const& entityID)
 {
 	MediaClockInfo info;
@@ -178,13 +206,9 @@ MediaClockInfo computeMediaClockInfo(la::avdecc::UniqueIdentifier const& entityI
 		{
 			if (mediaClockMasterID != entityID)
 			{
+				info.masterEntityID = mediaClockMasterID;
 				info.masterID = helper::uniqueIdentifierToString(mediaClockMasterID);
-
-				auto& manager = avdecc::ControllerManager::getInstance();
-				if (auto const clockMasterEntity = manager.getControlledEntity(mediaClockMasterID))
-				{
-					info.masterName = helper::entityName(*clockMasterEntity);
-				}
+				info.masterName = computeMediaClockMasterName(mediaClockMasterID);
 			}
 			else
 			{
@@ -239,11 +263,32 @@ public:
 	ControllerModelPrivate(ControllerModel* model)
 		: q_ptr{ model }
 	{
+		// Cell changes are notified to the views at most once per frame
+		_frameClientID = FrameScheduler::getInstance().registerClient(FrameScheduler::Order::ControllerModel,
+			[this](FrameScheduler::Clock::time_point const deadline)
+			{
+				// While inactive the cells stay dirty, they are flushed at once when activated again
+				return !_isActive || flushDirtyCells(deadline);
+			});
+
+		_memoryProbe = avdecc::MemoryAccounting::getInstance().registerProbe("ControllerModel",
+			[this](avdecc::MemoryAccounting::Counters& counters)
+			{
+				counters.push_back({ "Entities", _entities.size() });
+				counters.push_back({ "EntityDetails", _entityDetails.size() });
+				counters.push_back({ "FreeDetailsIndexes", _freeDetailsIndexes.size() });
+				counters.push_back({ "EntityRowMap", _entityRowMap.size() });
+				counters.push_back({ "EntitiesWithErrorCounter", _entitiesWithErrorCounter.size() });
+				counters.push_back({ "IdentifyingEntities", _identifingEntities.size() });
+			});
+
 		// Connect avdecc::ControllerManager signals
 		auto& controllerManager = avdecc::ControllerManager::getInstance();
 		connect(&controllerManager, &avdecc::ControllerManager::controllerOffline, this, &ControllerModelPrivate::handleControllerOffline);
-		connect(&controllerManager, &avdecc::ControllerManager::entityOnline, this, &ControllerModelPrivate::handleEntityOnline);
-		connect(&controllerManager, &avdecc::ControllerManager::entityOffline, this, &ControllerModelPrivate::handleEntityOffline);
+		connect(&controllerManager, &avdecc::ControllerManager::entitiesOnline, this, &ControllerModelPrivate::handleEntitiesOnline);
+		connect(&controllerManager, &avdecc::ControllerManager::entitiesOffline, this, &ControllerModelPrivate::handleEntitiesOffline);
+		connect(&controllerManager, &avdecc::ControllerManager::entitiesRebooting, this, &ControllerModelPrivate::handleEntitiesRebooting);
+		connect(&controllerManager, &avdecc::ControllerManager::entitiesRestored, this, &ControllerModelPrivate::handleEntitiesRestored);
 		connect(&controllerManager, &avdecc::ControllerManager::identificationStarted, this, &ControllerModelPrivate::handleIdentificationStarted);
 		connect(&controllerManager, &avdecc::ControllerManager::identificationStopped, this, &ControllerModelPrivate::handleIdentificationStopped);
 		connect(&controllerManager, &avdecc::ControllerManager::entityNameChanged, this, &ControllerModelPrivate::handleEntityNameChanged);
@@ -255,11 +300,21 @@ public:
 		connect(&controllerManager, &avdecc::ControllerManager::streamInputErrorCounterChanged, this, &ControllerModelPrivate::handleStreamInputErrorCounterChanged);
 		connect(&controllerManager, &avdecc::ControllerManager::statisticsErrorCounterChanged, this, &ControllerModelPrivate::handleStatisticsErrorCounterChanged);
 
+		// Connect avdecc::networkSnapshot::NetworkSnapshotStore signals
+		auto& snapshotStore = avdecc::networkSnapshot::NetworkSnapshotStore::getInstance();
+		connect(&snapshotStore, &avdecc::networkSnapshot::NetworkSnapshotStore::previewLoaded, this, &ControllerModelPrivate::handlePreviewLoaded);
+		connect(&snapshotStore, &avdecc::networkSnapshot::NetworkSnapshotStore::previewExpired, this, &ControllerModelPrivate::handlePreviewExpired);
+
 		// Connect avdecc::mediaClock::MCDomainManager signals
 		auto& mediaClockConnectionManager = avdecc::mediaClock::MCDomainManager::getInstance();
 		connect(&mediaClockConnectionManager, &avdecc::mediaClock::MCDomainManager::mediaClockConnectionsUpdate, this, &ControllerModelPrivate::handleMediaClockConnectionsUpdated);
 		connect(&mediaClockConnectionManager, &avdecc::mediaClock::MCDomainManager::mcMasterNameChanged, this, &ControllerModelPrivate::handleMcMasterNameChanged);
 
+		// Connect avdecc::bandwidth::BandwidthAccountingManager signals
+		auto& bandwidthManager = avdecc::bandwidth::BandwidthAccountingManager::getInstance();
+		connect(&bandwidthManager, &avdecc::bandwidth::BandwidthAccountingManager::talkerBandwidthChanged, this, &ControllerModelPrivate::handleTalkerBandwidthChanged);
+		connect(&bandwidthManager, &avdecc::bandwidth::BandwidthAccountingManager::oversubscriptionChanged, this, &ControllerModelPrivate::handleOversubscriptionChanged);
+
 		// Connect EntityLogoCache signals
 		auto& logoCache = EntityLogoCache::getInstance();
 		connect(&logoCache, &EntityLogoCache::imageChanged, this, &ControllerModelPrivate::handleImageChanged);
@@ -272,6 +327,9 @@ public:
 
 	virtual ~ControllerModelPrivate()
 	{
+		FrameScheduler::getInstance().unregisterClient(_frameClientID);
+		avdecc::MemoryAccounting::getInstance().unregisterProbe(_memoryProbe);
+
 		// Remove settings observers
 		auto& settings = settings::SettingsManager::getInstance();
 		settings.unregisterSettingObserver(settings::General_AutomaticPNGDownloadEnabled.name, this);
@@ -297,9 +355,30 @@ public:
 		}
 
 		auto const& data = _entities[row];
+		auto const& details = _entityDetails[data.detailsIndex];
 		auto const& entityID = data.entityID;
 		auto const column = static_cast<ControllerModel::Column>(index.column());
 
+		// Rebooting entities are greyed out until they are back, or removed when the offline grace period expires (same for the entities of the last session until they are enumerated again)
+		if (data.isRebooting || data.isStale)
+		{
+			if (role == Qt::ForegroundRole)
+			{
+				return QColor{ Qt::gray };
+			}
+			else if (role == Qt::FontRole)
+			{
+				auto font = QFont{};
+				font.setItalic(true);
+				return font;
+			}
+			else if (data.isStale && role == ImageItemDelegate::ImageRole)
+			{
+				// Nothing is known of the state of an entity that is not enumerated yet
+				return {};
+			}
+		}
+
 		if (role == Qt::DisplayRole)
 		{
 			switch (column)
@@ -307,21 +386,26 @@ public:
 				case ControllerModel::Column::EntityID:
 					return helper::uniqueIdentifierToString(entityID);
 				case ControllerModel::Column::Name:
-					return data.name;
+					return details.name.name;
 				case ControllerModel::Column::Group:
-					return data.groupName;
+					return details.groupName.name;
 				case ControllerModel::Column::GrandmasterID:
-					return data.gptpGrandmasterIDToString();
+					return details.gptpGrandmasterIDToString();
 				case ControllerModel::Column::GptpDomain:
-					return data.gptpDomainNumberToString();
+					return details.gptpDomainNumberToString();
 				case ControllerModel::Column::InterfaceIndex:
-					return data.avbInterfaceIndexToString();
+					return details.avbInterfaceIndexToString();
 				case ControllerModel::Column::AssociationID:
-					return data.associationIDToString();
+					return details.associationIDToString();
 				case ControllerModel::Column::MediaClockMasterID:
-					return data.mediaClockInfo.masterID;
+					return details.mediaClockInfo.masterID;
 				case ControllerModel::Column::MediaClockMasterName:
-					return data.mediaClockInfo.masterName;
+					return details.mediaClockInfo.masterName;
+				case ControllerModel::Column::ReservedBandwidth:
+				{
+					auto const reservedBandwidth = bandwidth::BandwidthAccountingManager::getInstance().getTalkerBandwidth(entityID);
+					return reservedBandwidth != 0u ? bandwidth::bandwidthToString(reservedBandwidth) : QString{};
+				}
 				default:
 					break;
 			}
@@ -361,6 +445,11 @@ public:
 				if (data.aemSupported)
 				{
 					auto& logoCache = EntityLogoCache::getInstance();
+					// Use a pre-scaled thumbnail if we know the size it will be painted at
+					if (_entityLogoSize.isValid())
+					{
+						return logoCache.getThumbnail(entityID, EntityLogoCache::Type::Entity, _entityLogoSize, _entityLogoDevicePixelRatio, _automaticEntityLogoDownload);
+					}
 					return logoCache.getImage(entityID, EntityLogoCache::Type::Entity, _automaticEntityLogoDownload);
 				}
 			}
@@ -371,15 +460,7 @@ public:
 			{
 				case ImageItemDelegate::ImageRole:
 				{
-					try
-					{
-						return _compatibilityImages.at(data.compatibility);
-					}
-					catch (std::out_of_range const&)
-					{
-						AVDECC_ASSERT(false, "Image missing");
-						return {};
-					}
+					return statusIcon(_compatibilityPixmaps, _compatibilityImages, data.compatibility);
 				}
 				case Qt::ToolTipRole:
 					switch (data.compatibility)
@@ -404,18 +485,10 @@ public:
 			{
 				case ImageItemDelegate::ImageRole:
 				{
-					try
-					{
-						return _excusiveAccessStateImages.at(data.acquireState);
-					}
-					catch (std::out_of_range const&)
-					{
-						AVDECC_ASSERT(false, "Image missing");
-						return {};
-					}
+					return statusIcon(_excusiveAccessStatePixmaps, _excusiveAccessStateImages, data.acquireState);
 				}
 				case Qt::ToolTipRole:
-					return data.acquireStateTooltip;
+					return details.acquireStateTooltip;
 				default:
 					break;
 			}
@@ -426,22 +499,38 @@ public:
 			{
 				case ImageItemDelegate::ImageRole:
 				{
-					try
-					{
-						return _excusiveAccessStateImages.at(data.lockState);
-					}
-					catch (std::out_of_range const&)
-					{
-						AVDECC_ASSERT(false, "Image missing");
-						return {};
-					}
+					return statusIcon(_excusiveAccessStatePixmaps, _excusiveAccessStateImages, data.lockState);
 				}
 				case Qt::ToolTipRole:
-					return data.lockStateTooltip;
+					return details.lockStateTooltip;
 				default:
 					break;
 			}
 		}
+		else if (column == ControllerModel::Column::ReservedBandwidth)
+		{
+			auto const& bandwidthManager = bandwidth::BandwidthAccountingManager::getInstance();
+			if (role == Qt::ForegroundRole)
+			{
+				if (bandwidthManager.isTalkerOversubscribed(entityID))
+				{
+					return _errorColorValue;
+				}
+			}
+			else if (role == Qt::ToolTipRole)
+			{
+				auto list = QStringList{};
+				for (auto const& [avbInterfaceIndex, interfaceBandwidth] : bandwidthManager.getInterfacesBandwidth(entityID))
+				{
+					list << QString{ "Reserved on interface %1: %2" }.arg(avbInterfaceIndex).arg(bandwidth::bandwidthToString(interfaceBandwidth));
+				}
+				if (bandwidthManager.isTalkerOversubscribed(entityID))
+				{
+					list << QString{ "Link oversubscribed (more than %1 reserved on an interface or along the path to a listener)" }.arg(bandwidth::bandwidthToString(bandwidth::BandwidthAccountingManager::MaxReservableBandwidth));
+				}
+				return list.join('\n');
+			}
+		}
 		else if (role == Qt::ToolTipRole)
 		{
 			switch (column)
@@ -449,7 +538,7 @@ public:
 				case ControllerModel::Column::GrandmasterID:
 				case ControllerModel::Column::GptpDomain:
 				case ControllerModel::Column::InterfaceIndex:
-					return data.gptpTooltip;
+					return details.gptpTooltip;
 				default:
 					break;
 			}
@@ -492,6 +581,8 @@ public:
 						return "Media Clock Master ID";
 					case ControllerModel::Column::MediaClockMasterName:
 						return "Media Clock Master Name";
+					case ControllerModel::Column::ReservedBandwidth:
+						return "Reserved Bandwidth";
 					default:
 						break;
 				}
@@ -501,6 +592,47 @@ public:
 		return {};
 	}
 
+	void setEntityLogoSize(QSize const& size, qreal const devicePixelRatio)
+	{
+		if (size != _entityLogoSize || devicePixelRatio != _entityLogoDevicePixelRatio)
+		{
+			_entityLogoSize = size;
+			_entityLogoDevicePixelRatio = devicePixelRatio;
+
+			Q_Q(ControllerModel);
+
+			auto constexpr column = la::avdecc::utils::to_integral(ControllerModel::Column::EntityLogo);
+
+			auto const topLeft = q->createIndex(0, column, nullptr);
+			auto const bottomRight = q->createIndex(rowCount(), column, nullptr);
+
+			emit q->dataChanged(topLeft, bottomRight, { ImageItemDelegate::ImageRole });
+		}
+	}
+
+	void setStatusIconSize(QSize const& size, qreal const devicePixelRatio)
+	{
+		if (size == _statusIconSize && devicePixelRatio == _statusIconDevicePixelRatio)
+		{
+			return;
+		}
+
+		_statusIconSize = size;
+		_statusIconDevicePixelRatio = devicePixelRatio;
+		_compatibilityPixmaps = scaleStatusIcons(_compatibilityImages);
+		_excusiveAccessStatePixmaps = scaleStatusIcons(_excusiveAccessStateImages);
+
+		Q_Q(ControllerModel);
+
+		for (auto const column : { ControllerModel::Column::Compatibility, ControllerModel::Column::AcquireState, ControllerModel::Column::LockState })
+		{
+			auto const topLeft = q->createIndex(0, la::avdecc::utils::to_integral(column), nullptr);
+			auto const bottomRight = q->createIndex(rowCount(), la::avdecc::utils::to_integral(column), nullptr);
+
+			emit q->dataChanged(topLeft, bottomRight, { ImageItemDelegate::ImageRole });
+		}
+	}
+
 	la::avdecc::UniqueIdentifier controlledEntityID(QModelIndex const& index) const
 	{
 		auto const row = index.row();
@@ -511,20 +643,164 @@ public:
 		return la::avdecc::UniqueIdentifier{};
 	}
 
+	QModelIndex controlledEntityIndex(la::avdecc::UniqueIdentifier const& entityID) const
+	{
+		Q_Q(const ControllerModel);
+		if (auto const row = entityRow(entityID))
+		{
+			return q->index(*row, 0);
+		}
+		return {};
+	}
+
+	ControllerModel::SortKey sortKey(int const row, ControllerModel::Column const column) const
+	{
+		auto key = ControllerModel::SortKey{};
+		if (row < 0 || row >= rowCount())
+		{
+			return key;
+		}
+
+		auto const& data = _entities[row];
+		auto const& details = _entityDetails[data.detailsIndex];
+		auto const gptpInfo = details.gptpInfoMap.empty() ? std::optional<std::pair<la::avdecc::entity::model::AvbInterfaceIndex, GptpInfo>>{} : *details.gptpInfoMap.begin();
+
+		// Values which are not set are sorted last
+		static constexpr auto NotSet = std::numeric_limits<std::uint64_t>::max();
+
+		switch (column)
+		{
+			case ControllerModel::Column::EntityLogo:
+				key.number = data.aemSupported ? 0u : 1u;
+				break;
+			case ControllerModel::Column::Compatibility:
+				key.number = static_cast<std::uint64_t>(data.compatibility);
+				break;
+			case ControllerModel::Column::EntityID:
+				key.number = data.entityID.getValue();
+				break;
+			case ControllerModel::Column::Name:
+				key.text = details.name.name.toCaseFolded();
+				break;
+			case ControllerModel::Column::Group:
+				key.text = details.groupName.name.toCaseFolded();
+				break;
+			case ControllerModel::Column::AcquireState:
+				key.number = static_cast<std::uint64_t>(data.acquireState);
+				break;
+			case ControllerModel::Column::LockState:
+				key.number = static_cast<std::uint64_t>(data.lockState);
+				break;
+			case ControllerModel::Column::GrandmasterID:
+				key.number = gptpInfo && gptpInfo->second.grandmasterID ? gptpInfo->second.grandmasterID->getValue() : NotSet;
+				break;
+			case ControllerModel::Column::GptpDomain:
+				key.number = gptpInfo && gptpInfo->second.domainNumber ? *gptpInfo->second.domainNumber : NotSet;
+				break;
+			case ControllerModel::Column::InterfaceIndex:
+				key.number = gptpInfo && gptpInfo->first != la::avdecc::entity::Entity::GlobalAvbInterfaceIndex ? gptpInfo->first : NotSet;
+				break;
+			case ControllerModel::Column::AssociationID:
+				key.number = details.associationID ? details.associationID->getValue() : NotSet;
+				break;
+			case ControllerModel::Column::MediaClockMasterID:
+				key.text = details.mediaClockInfo.masterID.toCaseFolded();
+				break;
+			case ControllerModel::Column::MediaClockMasterName:
+				key.text = details.mediaClockInfo.masterName.toCaseFolded();
+				break;
+			case ControllerModel::Column::ReservedBandwidth:
+				key.number = bandwidth::BandwidthAccountingManager::getInstance().getTalkerBandwidth(data.entityID);
+				break;
+			default:
+				break;
+		}
+
+		return key;
+	}
+
+	QString filterText(int const row) const
+	{
+		if (row < 0 || row >= rowCount())
+		{
+			return {};
+		}
+
+		auto const& data = _entities[row];
+		auto const& details = _entityDetails[data.detailsIndex];
+		auto text = QStringList{ helper::uniqueIdentifierToString(data.entityID), details.name.name, details.groupName.name };
+
+		switch (data.compatibility)
+		{
+			case Compatibility::Milan:
+				text << "Milan";
+				break;
+			case Compatibility::MilanRedundant:
+				text << "Milan Redundant";
+				break;
+			case Compatibility::IEEE:
+				text << "IEEE 1722.1";
+				break;
+			case Compatibility::Misbehaving:
+				text << "Misbehaving";
+				break;
+			default:
+				text << "Not Compliant";
+				break;
+		}
+
+		if (!details.gptpInfoMap.empty())
+		{
+			text << details.gptpGrandmasterIDToString() << details.gptpDomainNumberToString();
+		}
+
+		// Fields are separated so a filter cannot match across two of them
+		return text.join('\n').toCaseFolded();
+	}
+
 private:
-	class EntityData
+	// Per row data read by the sort, filter and paint passes of all the rows, kept small and contiguous
+	struct EntityData
 	{
-	public:
 		EntityData(la::avdecc::UniqueIdentifier const& entityID, la::avdecc::controller::ControlledEntity const& controlledEntity, la::avdecc::entity::Entity const& entity)
 			: entityID{ entityID }
-			, name{ helper::entityName(controlledEntity) }
-			, groupName{ helper::groupName(controlledEntity) }
 			, acquireState{ computeAcquireState(controlledEntity.getAcquireState()) }
-			, acquireStateTooltip{ helper::acquireStateToString(controlledEntity.getAcquireState(), controlledEntity.getOwningControllerID()) }
 			, lockState{ computeLockState(controlledEntity.getLockState()) }
-			, lockStateTooltip{ helper::lockStateToString(controlledEntity.getLockState(), controlledEntity.getLockingControllerID()) }
 			, compatibility{ computeCompatibility(controlledEntity.getMilanInfo(), controlledEntity.getCompatibilityFlags()) }
 			, aemSupported{ entity.getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported) }
+		{
+		}
+
+		// Entity of the last session, not enumerated yet
+		EntityData(networkSnapshot::EntityRow const& row)
+			: entityID{ row.entityID }
+			, isStale{ true }
+		{
+		}
+
+		la::avdecc::UniqueIdentifier entityID;
+		std::uint32_t detailsIndex{ 0u }; // Index of the EntityDetails of the entity in _entityDetails
+
+		ExclusiveAccessState acquireState{};
+		ExclusiveAccessState lockState{};
+		Compatibility compatibility{};
+
+		bool aemSupported{ false };
+		bool isRebooting{ false }; // Offline, but kept during the offline grace period
+		bool isStale{ false }; // Loaded from the snapshot of the last session, waiting to be enumerated again
+	};
+
+	// Per row data only read for the cells of a few columns, stored aside so they don't spread the hot data
+	class EntityDetails
+	{
+	public:
+		EntityDetails() = default;
+
+		EntityDetails(la::avdecc::UniqueIdentifier const& entityID, la::avdecc::controller::ControlledEntity const& controlledEntity, la::avdecc::entity::Entity const& entity)
+			: name{ NamePool::getInstance().intern(NamePool::entityNameKey(entityID), helper::entityName(controlledEntity)) }
+			, groupName{ NamePool::getInstance().intern(NamePool::entityGroupNameKey(entityID), helper::groupName(controlledEntity)) }
+			, acquireStateTooltip{ helper::acquireStateToString(controlledEntity.getAcquireState(), controlledEntity.getOwningControllerID()) }
+			, lockStateTooltip{ helper::lockStateToString(controlledEntity.getLockState(), controlledEntity.getLockingControllerID()) }
 			, gptpInfoMap{ buildGptpInfoMap(entity.getInterfacesInformation()) }
 			, gptpTooltip{ computeGptpTooltip(gptpInfoMap) }
 			, associationID{ entity.getAssociationID() }
@@ -532,22 +808,20 @@ private:
 		{
 		}
 
-	public:
-		la::avdecc::UniqueIdentifier entityID;
+		// Entity of the last session, not enumerated yet
+		EntityDetails(networkSnapshot::EntityRow const& row)
+			: name{ NamePool::getInstance().intern(NamePool::entityNameKey(row.entityID), row.name) }
+			, groupName{ NamePool::getInstance().intern(NamePool::entityGroupNameKey(row.entityID), row.groupName) }
+		{
+		}
 
-		QString name{};
-		QString groupName{};
+	public:
+		NamePool::Handle name{}; // Shared with the other models, through the NamePool
+		NamePool::Handle groupName{};
 
-		ExclusiveAccessState acquireState{};
 		QString acquireStateTooltip{};
-
-		ExclusiveAccessState lockState{};
 		QString lockStateTooltip{};
 
-		Compatibility compatibility{};
-
-		bool aemSupported{ false };
-
 		GptpInfoPerAvbInterfaceIndex gptpInfoMap{};
 		QString gptpTooltip{};
 
@@ -603,24 +877,143 @@ private:
 	};
 
 	using Entities = std::vector<EntityData>;
+	using EntityDetailsTable = std::vector<EntityDetails>;
 	using EntityRowMap = std::unordered_map<la::avdecc::UniqueIdentifier, int, la::avdecc::UniqueIdentifier::hash>;
 
+	// Store the details of an entity in a free slot of the side table, returning the row data referencing them
+	EntityData storeDetails(EntityData data, EntityDetails&& details)
+	{
+		if (!_freeDetailsIndexes.empty())
+		{
+			data.detailsIndex = _freeDetailsIndexes.back();
+			_freeDetailsIndexes.pop_back();
+			_entityDetails[data.detailsIndex] = std::move(details);
+		}
+		else
+		{
+			data.detailsIndex = static_cast<std::uint32_t>(_entityDetails.size());
+			_entityDetails.push_back(std::move(details));
+		}
+		return data;
+	}
+
+	// Replace the data of an existing row, its details slot being reused
+	void replaceEntity(int const row, EntityData data, EntityDetails&& details)
+	{
+		data.detailsIndex = _entities[row].detailsIndex;
+		_entityDetails[data.detailsIndex] = std::move(details);
+		_entities[row] = data;
+	}
+
+	// Release the details slots of the rows about to be removed
+	void releaseDetails(int const first, int const last)
+	{
+		for (auto row = first; row <= last; ++row)
+		{
+			auto const detailsIndex = _entities[row].detailsIndex;
+			_entityDetails[detailsIndex] = EntityDetails{};
+			_freeDetailsIndexes.push_back(detailsIndex);
+		}
+	}
+
 	QModelIndex createIndex(int const row, ControllerModel::Column const column) const
 	{
 		Q_Q(const ControllerModel);
 		return q->createIndex(row, la::avdecc::utils::to_integral(column));
 	}
 
-	void dataChanged(int const row, ControllerModel::Column const column, QVector<int> const& roles = { Qt::DisplayRole })
+	// Mark a cell as changed, the views being notified on the next frame (merged with the other changes of the same column)
+	void dataChanged(la::avdecc::UniqueIdentifier const& entityID, ControllerModel::Column const column, QVector<int> const& roles = { Qt::DisplayRole })
 	{
-		auto const index = createIndex(row, column);
-		if (index.isValid())
+		auto& dirtyColumn = _dirtyColumns[column];
+		dirtyColumn.entities.insert(entityID);
+		for (auto const role : roles)
 		{
-			Q_Q(ControllerModel);
-			emit q->dataChanged(index, index, roles);
+			if (!dirtyColumn.roles.contains(role))
+			{
+				dirtyColumn.roles.append(role);
+			}
+		}
+
+		if (_isActive)
+		{
+			FrameScheduler::getInstance().requestFlush(_frameClientID);
 		}
 	}
 
+	void setActive(bool const isActive)
+	{
+		if (isActive == _isActive)
+		{
+			return;
+		}
+
+		_isActive = isActive;
+
+		if (_isActive)
+		{
+			// Single consolidated refresh of all the cells changed while inactive
+			flushDirtyCells();
+		}
+	}
+
+	// Mark all the cells of an entity as changed
+	void rowChanged(la::avdecc::UniqueIdentifier const& entityID, QVector<int> const& roles)
+	{
+		for (auto column = 0; column < columnCount(); ++column)
+		{
+			dataChanged(entityID, static_cast<ControllerModel::Column>(column), roles);
+		}
+	}
+
+	// Notifies the dirty cells column by column until deadline is reached, the remaining columns being kept for the next frame. Returns true if all the columns were notified
+	bool flushDirtyCells(FrameScheduler::Clock::time_point const deadline = FrameScheduler::Clock::time_point::max())
+	{
+		Q_Q(ControllerModel);
+
+		while (!_dirtyColumns.empty())
+		{
+			if (FrameScheduler::Clock::now() >= deadline)
+			{
+				return false;
+			}
+
+			auto const columnIt = _dirtyColumns.begin();
+			auto const column = columnIt->first;
+			auto const dirtyColumn = std::move(columnIt->second);
+			_dirtyColumns.erase(columnIt);
+
+			// Rows are only resolved now, they might have moved since the cells were marked
+			auto rows = std::vector<int>{};
+			rows.reserve(dirtyColumn.entities.size());
+			for (auto const& entityID : dirtyColumn.entities)
+			{
+				if (auto const row = entityRow(entityID))
+				{
+					rows.push_back(*row);
+				}
+			}
+			std::sort(std::begin(rows), std::end(rows));
+
+			// Emit a single dataChanged for each range of contiguous rows
+			auto rowIt = std::begin(rows);
+			while (rowIt != std::end(rows))
+			{
+				auto const first = *rowIt;
+				auto last = first;
+				++rowIt;
+				while (rowIt != std::end(rows) && *rowIt == last + 1)
+				{
+					last = *rowIt;
+					++rowIt;
+				}
+
+				emit q->dataChanged(createIndex(first, column), createIndex(last, column), dirtyColumn.roles);
+			}
+		}
+		return true;
+	}
+
 	// avdecc::ControllerManager
 
 	void handleControllerOffline()
@@ -629,37 +1022,70 @@ private:
 
 		q->beginResetModel();
 		_entities.clear();
+		_entityDetails.clear();
+		_freeDetailsIndexes.clear();
 		_entityRowMap.clear();
 		_entitiesWithErrorCounter.clear();
 		_identifingEntities.clear();
+		_dirtyColumns.clear();
 		q->endResetModel();
 	}
 
-	void handleEntityOnline(la::avdecc::UniqueIdentifier const& entityID)
+	void handleEntitiesOnline(avdecc::ControllerManager::EntityIDs const& entityIDs)
 	{
 		try
 		{
 			auto& manager = avdecc::ControllerManager::getInstance();
-			auto controlledEntity = manager.getControlledEntity(entityID);
-			// Check if the entity is actually online (it might happen that the entity quickly switched from online to offline)
-			if (controlledEntity)
+
+			// Only keep entities that are actually online (it might happen that an entity quickly switched from online to offline)
+			auto newEntities = Entities{};
+			newEntities.reserve(entityIDs.size());
+			for (auto const& entityID : entityIDs)
 			{
-				Q_Q(ControllerModel);
+				if (auto const row = entityRow(entityID))
+				{
+					// Entities of the last session are confirmed in place, their row doesn't move
+					if (_entities[*row].isStale)
+					{
+						if (auto controlledEntity = manager.getControlledEntity(entityID))
+						{
+							replaceEntity(*row, EntityData{ entityID, *controlledEntity, controlledEntity->getEntity() }, EntityDetails{ entityID, *controlledEntity, controlledEntity->getEntity() });
+							_entitiesWithErrorCounter[entityID].statisticsError = !manager.getStatisticsCounters(entityID).empty();
+							rowChanged(entityID, { Qt::DisplayRole, Qt::ToolTipRole, Qt::ForegroundRole, Qt::FontRole, ImageItemDelegate::ImageRole, ErrorItemDelegate::ErrorRole });
+						}
+					}
+					continue;
+				}
+				if (auto controlledEntity = manager.getControlledEntity(entityID))
+				{
+					newEntities.push_back(storeDetails(EntityData{ entityID, *controlledEntity, controlledEntity->getEntity() }, EntityDetails{ entityID, *controlledEntity, controlledEntity->getEntity() }));
+				}
+			}
 
-				// Insert at the end
-				auto const row = rowCount();
-				emit q->beginInsertRows({}, row, row);
+			if (newEntities.empty())
+			{
+				return;
+			}
 
-				_entities.emplace_back(entityID, *controlledEntity, controlledEntity->getEntity());
+			Q_Q(ControllerModel);
 
-				// Update the cache
-				rebuildEntityRowMap();
+			// Insert all entities at the end, in a single operation
+			auto const first = rowCount();
+			auto const last = first + static_cast<int>(newEntities.size()) - 1;
+			emit q->beginInsertRows({}, first, last);
 
+			for (auto const& data : newEntities)
+			{
 				// Initialize EntityWithError (only need to initialize Statistics which might change during enumeration and not trigger an event, contrary to Counters)
-				_entitiesWithErrorCounter[entityID].statisticsError = !manager.getStatisticsCounters(entityID).empty();
+				_entitiesWithErrorCounter[data.entityID].statisticsError = !manager.getStatisticsCounters(data.entityID).empty();
 
-				emit q->endInsertRows();
+				_entities.push_back(data);
 			}
+
+			// Update the cache (only the new rows)
+			updateEntityRowMap(first);
+
+			emit q->endInsertRows();
 		}
 		catch (...)
 		{
@@ -668,61 +1094,200 @@ private:
 		}
 	}
 
-	void handleEntityOffline(la::avdecc::UniqueIdentifier const& entityID)
+	void handleEntitiesOffline(avdecc::ControllerManager::EntityIDs const& entityIDs)
 	{
-		if (auto const row = entityRow(entityID))
+		// Collect the rows to remove, from the last one so removing a range doesn't shift the remaining ones
+		auto rows = std::vector<int>{};
+		rows.reserve(entityIDs.size());
+		for (auto const& entityID : entityIDs)
 		{
-			Q_Q(ControllerModel);
-			emit q->beginRemoveRows({}, *row, *row);
+			if (auto const row = entityRow(entityID))
+			{
+				rows.push_back(*row);
+			}
+		}
+
+		if (rows.empty())
+		{
+			return;
+		}
 
-			// Remove the entity from the model
-			auto const it = std::next(std::begin(_entities), *row);
-			_entities.erase(it);
+		std::sort(std::begin(rows), std::end(rows), std::greater<int>{});
+		rows.erase(std::unique(std::begin(rows), std::end(rows)), std::end(rows));
 
-			// Update the cache
-			rebuildEntityRowMap();
+		Q_Q(ControllerModel);
+
+		// Remove contiguous rows in a single operation
+		auto rowIt = std::begin(rows);
+		while (rowIt != std::end(rows))
+		{
+			auto const last = *rowIt;
+			auto first = last;
+			++rowIt;
+			while (rowIt != std::end(rows) && *rowIt == first - 1)
+			{
+				first = *rowIt;
+				++rowIt;
+			}
+
+			emit q->beginRemoveRows({}, first, last);
+
+			// Remove the entities from the model (and the cache)
+			for (auto row = first; row <= last; ++row)
+			{
+				_entityRowMap.erase(_entities[row].entityID);
+			}
+			releaseDetails(first, last);
+			_entities.erase(std::next(std::begin(_entities), first), std::next(std::begin(_entities), last + 1));
 
 			emit q->endRemoveRows();
 		}
+
+		// Update the cache, only the rows after the first removed one have moved
+		updateEntityRowMap(rows.back());
+	}
+
+	// avdecc::networkSnapshot::NetworkSnapshotStore
+
+	void handlePreviewLoaded(avdecc::networkSnapshot::Snapshot const& snapshot)
+	{
+		auto previewEntities = Entities{};
+		previewEntities.reserve(snapshot.size());
+		for (auto const& row : snapshot)
+		{
+			if (_entityRowMap.count(row.entityID) == 0)
+			{
+				previewEntities.push_back(storeDetails(EntityData{ row }, EntityDetails{ row }));
+			}
+		}
+
+		// Most of the entities of the last session will be back, so the enumeration doesn't have to grow the containers
+		_entities.reserve(_entities.size() + previewEntities.size());
+		_entityDetails.reserve(_entityDetails.size() + previewEntities.size());
+		_entityRowMap.reserve(_entities.size() + previewEntities.size());
+
+		if (previewEntities.empty())
+		{
+			return;
+		}
+
+		Q_Q(ControllerModel);
+
+		auto const first = rowCount();
+		auto const last = first + static_cast<int>(previewEntities.size()) - 1;
+		emit q->beginInsertRows({}, first, last);
+
+		std::move(std::begin(previewEntities), std::end(previewEntities), std::back_inserter(_entities));
+		updateEntityRowMap(first);
+
+		emit q->endInsertRows();
+	}
+
+	void handlePreviewExpired()
+	{
+		// Entities of the last session that didn't come back are gone
+		auto staleEntities = avdecc::ControllerManager::EntityIDs{};
+		for (auto const& data : _entities)
+		{
+			if (data.isStale)
+			{
+				staleEntities.push_back(data.entityID);
+			}
+		}
+		handleEntitiesOffline(staleEntities);
+	}
+
+	void handleEntitiesRebooting(avdecc::ControllerManager::EntityIDs const& entityIDs)
+	{
+		for (auto const& entityID : entityIDs)
+		{
+			if (auto const row = entityRow(entityID))
+			{
+				_entities[*row].isRebooting = true;
+				rowChanged(entityID, { Qt::ForegroundRole, Qt::FontRole });
+			}
+		}
+	}
+
+	void handleEntitiesRestored(avdecc::ControllerManager::EntityIDs const& entityIDs)
+	{
+		try
+		{
+			auto& manager = avdecc::ControllerManager::getInstance();
+
+			// The rows are kept, only their data is read again from the new enumeration
+			for (auto const& entityID : entityIDs)
+			{
+				auto const row = entityRow(entityID);
+				if (!row)
+				{
+					continue;
+				}
+				if (auto controlledEntity = manager.getControlledEntity(entityID))
+				{
+					replaceEntity(*row, EntityData{ entityID, *controlledEntity, controlledEntity->getEntity() }, EntityDetails{ entityID, *controlledEntity, controlledEntity->getEntity() });
+					_entitiesWithErrorCounter[entityID].statisticsError = !manager.getStatisticsCounters(entityID).empty();
+					rowChanged(entityID, { Qt::DisplayRole, Qt::ToolTipRole, Qt::ForegroundRole, Qt::FontRole, ImageItemDelegate::ImageRole, ErrorItemDelegate::ErrorRole });
+				}
+			}
+		}
+		catch (...)
+		{
+			// Uncaught exception
+			AVDECC_ASSERT(false, "Uncaught exception");
+		}
 	}
 
 	void handleIdentificationStarted(la::avdecc::UniqueIdentifier const& entityID)
 	{
-		if (auto const row = entityRow(entityID))
+		if (entityRow(entityID))
 		{
-			_identifingEntities.insert(entityID);
-			dataChanged(*row, ControllerModel::Column::EntityID, { Qt::FontRole });
+			if (_identifingEntities.insert(entityID).second)
+			{
+				dataChanged(entityID, ControllerModel::Column::EntityID, { Qt::FontRole });
+			}
 		}
 	}
 
 	void handleIdentificationStopped(la::avdecc::UniqueIdentifier const& entityID)
 	{
-		if (auto const row = entityRow(entityID))
+		if (entityRow(entityID))
 		{
-			_identifingEntities.erase(entityID);
-			dataChanged(*row, ControllerModel::Column::EntityID, { Qt::FontRole });
+			if (_identifingEntities.erase(entityID) != 0)
+			{
+				dataChanged(entityID, ControllerModel::Column::EntityID, { Qt::FontRole });
+			}
 		}
 	}
 
-	void handleEntityNameChanged(la::avdecc::UniqueIdentifier const& entityID, QString const& entityName)
+	void handleEntityNameChanged(la::avdecc::UniqueIdentifier const& entityID, QString const& /*entityName*/)
 	{
 		if (auto const row = entityRow(entityID))
 		{
+			// the pool already holds the name carried by the signal (or a more recent one)
+			auto const handle = NamePool::getInstance().get(NamePool::entityNameKey(entityID));
 			auto& data = _entities[*row];
-			data.name = entityName;
-
-			dataChanged(*row, ControllerModel::Column::Name);
+			auto& details = _entityDetails[data.detailsIndex];
+			if (handle.generation != 0u && handle.generation != details.name.generation)
+			{
+				details.name = handle;
+				dataChanged(entityID, ControllerModel::Column::Name);
+			}
 		}
 	}
 
-	void handleEntityGroupNameChanged(la::avdecc::UniqueIdentifier const& entityID, QString const& entityGroupName)
+	void handleEntityGroupNameChanged(la::avdecc::UniqueIdentifier const& entityID, QString const& /*entityGroupName*/)
 	{
 		if (auto const row = entityRow(entityID))
 		{
+			auto const handle = NamePool::getInstance().get(NamePool::entityGroupNameKey(entityID));
 			auto& data = _entities[*row];
-			data.groupName = entityGroupName;
-
-			dataChanged(*row, ControllerModel::Column::Group);
+			auto& details = _entityDetails[data.detailsIndex];
+			if (handle.generation != 0u && handle.generation != details.groupName.generation)
+			{
+				details.groupName = handle;
+				dataChanged(entityID, ControllerModel::Column::Group);
+			}
 		}
 	}
 
@@ -731,11 +1296,16 @@ private:
 		if (auto const row = entityRow(entityID))
 		{
 			auto& data = _entities[*row];
+			auto& details = _entityDetails[data.detailsIndex];
 
-			data.acquireState = computeAcquireState(acquireState);
-			data.acquireStateTooltip = helper::acquireStateToString(acquireState, owningEntity);
-
-			dataChanged(*row, ControllerModel::Column::AcquireState, { ImageItemDelegate::ImageRole });
+			auto const state = computeAcquireState(acquireState);
+			auto tooltip = helper::acquireStateToString(acquireState, owningEntity);
+			if (state != data.acquireState || tooltip != details.acquireStateTooltip)
+			{
+				data.acquireState = state;
+				details.acquireStateTooltip = std::move(tooltip);
+				dataChanged(entityID, ControllerModel::Column::AcquireState, { ImageItemDelegate::ImageRole, Qt::ToolTipRole });
+			}
 		}
 	}
 
@@ -744,11 +1314,16 @@ private:
 		if (auto const row = entityRow(entityID))
 		{
 			auto& data = _entities[*row];
+			auto& details = _entityDetails[data.detailsIndex];
 
-			data.lockState = computeLockState(lockState);
-			data.lockStateTooltip = helper::lockStateToString(lockState, lockingEntity);
-
-			dataChanged(*row, ControllerModel::Column::LockState, { ImageItemDelegate::ImageRole });
+			auto const state = computeLockState(lockState);
+			auto tooltip = helper::lockStateToString(lockState, lockingEntity);
+			if (state != data.lockState || tooltip != details.lockStateTooltip)
+			{
+				data.lockState = state;
+				details.lockStateTooltip = std::move(tooltip);
+				dataChanged(entityID, ControllerModel::Column::LockState, { ImageItemDelegate::ImageRole, Qt::ToolTipRole });
+			}
 		}
 	}
 
@@ -763,8 +1338,12 @@ private:
 				auto& manager = avdecc::ControllerManager::getInstance();
 				if (auto controlledEntity = manager.getControlledEntity(entityID))
 				{
-					data.compatibility = computeCompatibility(controlledEntity->getMilanInfo(), compatibilityFlags);
-					dataChanged(*row, ControllerModel::Column::Compatibility);
+					auto const compatibility = computeCompatibility(controlledEntity->getMilanInfo(), compatibilityFlags);
+					if (compatibility != data.compatibility)
+					{
+						data.compatibility = compatibility;
+						dataChanged(entityID, ControllerModel::Column::Compatibility, { ImageItemDelegate::ImageRole, Qt::ToolTipRole });
+					}
 				}
 			}
 			catch (...)
@@ -779,43 +1358,76 @@ private:
 		if (auto const row = entityRow(entityID))
 		{
 			auto& data = _entities[*row];
+			auto& details = _entityDetails[data.detailsIndex];
 
-			auto& info = data.gptpInfoMap[avbInterfaceIndex];
+			auto const previousGrandmasterID = details.gptpGrandmasterIDToString();
+			auto const previousDomainNumber = details.gptpDomainNumberToString();
+			auto const previousInterfaceIndex = details.avbInterfaceIndexToString();
+
+			auto& info = details.gptpInfoMap[avbInterfaceIndex];
 
 			info.grandmasterID = grandMasterID;
 			info.domainNumber = grandMasterDomain;
 
-			data.gptpTooltip = computeGptpTooltip(data.gptpInfoMap);
+			auto tooltip = computeGptpTooltip(details.gptpInfoMap);
+			auto const tooltipChanged = tooltip != details.gptpTooltip;
+			details.gptpTooltip = std::move(tooltip);
 
-			dataChanged(*row, ControllerModel::Column::GrandmasterID);
-			dataChanged(*row, ControllerModel::Column::GptpDomain);
+			// Only notify the cells that actually changed
+			auto const tooltipRoles = tooltipChanged ? QVector<int>{ Qt::DisplayRole, Qt::ToolTipRole } : QVector<int>{ Qt::DisplayRole };
+			if (tooltipChanged || details.gptpGrandmasterIDToString() != previousGrandmasterID)
+			{
+				dataChanged(entityID, ControllerModel::Column::GrandmasterID, tooltipRoles);
+			}
+			if (tooltipChanged || details.gptpDomainNumberToString() != previousDomainNumber)
+			{
+				dataChanged(entityID, ControllerModel::Column::GptpDomain, tooltipRoles);
+			}
+			if (tooltipChanged || details.avbInterfaceIndexToString() != previousInterfaceIndex)
+			{
+				dataChanged(entityID, ControllerModel::Column::InterfaceIndex, tooltipRoles);
+			}
 		}
 	}
 
 	void handleStreamInputErrorCounterChanged(la::avdecc::UniqueIdentifier const& entityID, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, ControllerManager::StreamInputErrorCounters const& errorCounters)
 	{
-		if (auto const row = entityRow(entityID))
+		if (entityRow(entityID))
 		{
+			auto& entityWithErrorCounter = _entitiesWithErrorCounter[entityID];
+			auto const hadError = entityWithErrorCounter.hasError();
+
 			if (!errorCounters.empty())
 			{
-				_entitiesWithErrorCounter[entityID].streamsWithErrorCounter.insert(descriptorIndex);
+				entityWithErrorCounter.streamsWithErrorCounter.insert(descriptorIndex);
 			}
 			else
 			{
-				_entitiesWithErrorCounter[entityID].streamsWithErrorCounter.erase(descriptorIndex);
+				entityWithErrorCounter.streamsWithErrorCounter.erase(descriptorIndex);
 			}
 
-			dataChanged(*row, ControllerModel::Column::EntityID);
+			// The cell only displays if the entity has an error or not
+			if (entityWithErrorCounter.hasError() != hadError)
+			{
+				dataChanged(entityID, ControllerModel::Column::EntityID, { ErrorItemDelegate::ErrorRole, Qt::ForegroundRole });
+			}
 		}
 	}
 
 	void handleStatisticsErrorCounterChanged(la::avdecc::UniqueIdentifier const entityID, ControllerManager::StatisticsErrorCounters const& errorCounters)
 	{
-		if (auto const row = entityRow(entityID))
+		if (entityRow(entityID))
 		{
-			_entitiesWithErrorCounter[entityID].statisticsError = !errorCounters.empty();
+			auto& entityWithErrorCounter = _entitiesWithErrorCounter[entityID];
+			auto const hadError = entityWithErrorCounter.hasError();
+
+			entityWithErrorCounter.statisticsError = !errorCounters.empty();
 
-			dataChanged(*row, ControllerModel::Column::EntityID);
+			// The cell only displays if the entity has an error or not
+			if (entityWithErrorCounter.hasError() != hadError)
+			{
+				dataChanged(entityID, ControllerModel::Column::EntityID, { ErrorItemDelegate::ErrorRole, Qt::ForegroundRole });
+			}
 		}
 	}
 
@@ -828,39 +1440,78 @@ private:
 			if (auto const row = entityRow(entityID))
 			{
 				auto& data = _entities[*row];
+				auto& details = _entityDetails[data.detailsIndex];
 
-				data.mediaClockInfo = computeMediaClockInfo(entityID);
-
-				dataChanged(*row, ControllerModel::Column::MediaClockMasterID);
-				dataChanged(*row, ControllerModel::Column::MediaClockMasterName);
+				auto info = computeMediaClockInfo(entityID);
+				if (info.masterID != details.mediaClockInfo.masterID)
+				{
+					dataChanged(entityID, ControllerModel::Column::MediaClockMasterID);
+				}
+				if (info.masterName != details.mediaClockInfo.masterName)
+				{
+					dataChanged(entityID, ControllerModel::Column::MediaClockMasterName);
+				}
+				details.mediaClockInfo = std::move(info);
 			}
 		}
 	}
 
 	void handleMcMasterNameChanged(std::vector<la::avdecc::UniqueIdentifier> const& changedEntities)
 	{
+		// The clock chains did not change, only refresh the name of the already resolved masters (once per master)
+		auto masterNames = std::unordered_map<la::avdecc::UniqueIdentifier, QString, la::avdecc::UniqueIdentifier::hash>{};
+
 		for (auto const& entityID : changedEntities)
 		{
 			if (auto const row = entityRow(entityID))
 			{
 				auto& data = _entities[*row];
+				auto& details = _entityDetails[data.detailsIndex];
+				auto const& masterEntityID = details.mediaClockInfo.masterEntityID;
 
-				data.mediaClockInfo = computeMediaClockInfo(entityID);
+				auto nameIt = masterNames.find(masterEntityID);
+				if (nameIt == std::end(masterNames))
+				{
+					nameIt = masterNames.emplace(masterEntityID, computeMediaClockMasterName(masterEntityID)).first;
+				}
 
-				dataChanged(*row, ControllerModel::Column::MediaClockMasterName);
+				if (nameIt->second != details.mediaClockInfo.masterName)
+				{
+					details.mediaClockInfo.masterName = nameIt->second;
+					dataChanged(entityID, ControllerModel::Column::MediaClockMasterName);
+				}
 			}
 		}
 	}
 
+	// avdecc::bandwidth::BandwidthAccountingManager
+
+	void handleTalkerBandwidthChanged(la::avdecc::UniqueIdentifier const entityID)
+	{
+		if (entityRow(entityID))
+		{
+			dataChanged(entityID, ControllerModel::Column::ReservedBandwidth, { Qt::DisplayRole, Qt::ToolTipRole, Qt::ForegroundRole });
+		}
+	}
+
+	void handleOversubscriptionChanged()
+	{
+		// Oversubscription of a hop affects all the talkers going through it, refresh the whole column
+		for (auto const& data : _entities)
+		{
+			dataChanged(data.entityID, ControllerModel::Column::ReservedBandwidth, { Qt::ToolTipRole, Qt::ForegroundRole });
+		}
+	}
+
 	// EntityLogoCache
 
 	void handleImageChanged(la::avdecc::UniqueIdentifier const& entityID, EntityLogoCache::Type const type)
 	{
 		if (type == EntityLogoCache::Type::Entity)
 		{
-			if (auto const row = entityRow(entityID))
+			if (entityRow(entityID))
 			{
-				dataChanged(*row, ControllerModel::Column::EntityLogo, { ImageItemDelegate::ImageRole });
+				dataChanged(entityID, ControllerModel::Column::EntityLogo, { ImageItemDelegate::ImageRole });
 			}
 		}
 	}
@@ -900,15 +1551,13 @@ private:
 		}
 	}
 
-	// Build the entityID to row map
-	void rebuildEntityRowMap()
+	// Update the entityID to row map, starting at the specified row (rows before it didn't move)
+	void updateEntityRowMap(int const fromRow)
 	{
-		_entityRowMap.clear();
-
-		for (auto row = 0; row < rowCount(); ++row)
+		for (auto row = fromRow; row < rowCount(); ++row)
 		{
 			auto const& data = _entities[row];
-			_entityRowMap.emplace(std::make_pair(data.entityID, row));
+			_entityRowMap[data.entityID] = row;
 		}
 	}
 
@@ -924,14 +1573,65 @@ private:
 	}
 
 private:
+	// Scale the status icons to the size they are painted at, so the delegate draws them as is
+	template<typename Key>
+	std::unordered_map<Key, QPixmap> scaleStatusIcons(std::unordered_map<Key, QImage> const& images) const noexcept
+	{
+		auto pixmaps = std::unordered_map<Key, QPixmap>{};
+		if (!_statusIconSize.isValid())
+		{
+			return pixmaps;
+		}
+
+		auto const targetSize = (QSizeF{ _statusIconSize } * _statusIconDevicePixelRatio).toSize();
+		for (auto const& [key, image] : images)
+		{
+			auto pixmap = QPixmap::fromImage(image.scaled(targetSize, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+			pixmap.setDevicePixelRatio(_statusIconDevicePixelRatio);
+			pixmaps.emplace(key, std::move(pixmap));
+		}
+		return pixmaps;
+	}
+
+	// Pre-scaled pixmap of a status if known, full size image otherwise
+	template<typename Key>
+	static QVariant statusIcon(std::unordered_map<Key, QPixmap> const& pixmaps, std::unordered_map<Key, QImage> const& images, Key const key) noexcept
+	{
+		if (auto const it = pixmaps.find(key); it != std::end(pixmaps))
+		{
+			return it->second;
+		}
+		if (auto const it = images.find(key); it != std::end(images))
+		{
+			return it->second;
+		}
+		AVDECC_ASSERT(false, "Image missing");
+		return {};
+	}
+
 	ControllerModel* const q_ptr{ nullptr };
 	Q_DECLARE_PUBLIC(ControllerModel);
 
-	Entities _entities{};
+	Entities _entities{}; // Hot data of each row, in row order
+	EntityDetailsTable _entityDetails{}; // Cold data of the rows, referenced by EntityData::detailsIndex (slots of removed rows are reused)
+	std::vector<std::uint32_t> _freeDetailsIndexes{};
 	EntityRowMap _entityRowMap{};
 	bool _automaticEntityLogoDownload{ false };
+	QSize _entityLogoSize{}; // Size the logos are painted at, invalid if unknown
+	qreal _entityLogoDevicePixelRatio{ 1.0 };
 	QColor _errorColorValue{ Qt::red };
 
+	struct DirtyColumn
+	{
+		std::unordered_set<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash> entities{};
+		QVector<int> roles{};
+	};
+	using DirtyColumns = std::map<ControllerModel::Column, DirtyColumn>;
+	DirtyColumns _dirtyColumns{}; // Cells changed since the last frame (or since the model was set inactive)
+	FrameScheduler::ClientID _frameClientID{ 0u };
+	bool _isActive{ true };
+	avdecc::MemoryAccounting::ProbeID _memoryProbe{ 0u };
+
 	struct EntityWithErrorCounter
 	{
 		bool statisticsError{ false };
@@ -958,6 +1658,10 @@ private:
 		{ ExclusiveAccessState::AccessOther, QImage{ ":/locked_by_other.png" } },
 		{ ExclusiveAccessState::AccessSelf, QImage{ ":/locked.png" } },
 	};
+	QSize _statusIconSize{}; // Size the status icons are painted at, invalid if unknown
+	qreal _statusIconDevicePixelRatio{ 1.0 };
+	std::unordered_map<Compatibility, QPixmap> _compatibilityPixmaps{};
+	std::unordered_map<ExclusiveAccessState, QPixmap> _excusiveAccessStatePixmaps{};
 };
 
 ControllerModel::ControllerModel(QObject* parent)
@@ -992,12 +1696,48 @@ QVariant ControllerModel::headerData(int section, Qt::Orientation orientation, i
 	return d->headerData(section, orientation, role);
 }
 
+void ControllerModel::setEntityLogoSize(QSize const& size, qreal const devicePixelRatio)
+{
+	Q_D(ControllerModel);
+	d->setEntityLogoSize(size, devicePixelRatio);
+}
+
+void ControllerModel::setStatusIconSize(QSize const& size, qreal const devicePixelRatio)
+{
+	Q_D(ControllerModel);
+	d->setStatusIconSize(size, devicePixelRatio);
+}
+
+void ControllerModel::setActive(bool const isActive)
+{
+	Q_D(ControllerModel);
+	d->setActive(isActive);
+}
+
 la::avdecc::UniqueIdentifier ControllerModel::controlledEntityID(QModelIndex const& index) const
 {
 	Q_D(const ControllerModel);
 	return d->controlledEntityID(index);
 }
 
+QModelIndex ControllerModel::controlledEntityIndex(la::avdecc::UniqueIdentifier const& entityID) const
+{
+	Q_D(const ControllerModel);
+	return d->controlledEntityIndex(entityID);
+}
+
+ControllerModel::SortKey ControllerModel::sortKey(int const row, Column const column) const
+{
+	Q_D(const ControllerModel);
+	return d->sortKey(row, column);
+}
+
+QString ControllerModel::filterText(int const row) const
+{
+	Q_D(const ControllerModel);
+	return d->filterText(row);
+}
+
 } // namespace avdecc
 
 #include "controllerModel.moc"
@@ -20,8 +20,12 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QSize>
+#include <QString>
 #include <la/avdecc/controller/avdeccController.hpp>
 
+#include <cstdint>
+
 namespace avdecc
 {
 class ControllerModelPrivate;
@@ -44,10 +48,28 @@ public:
 		AssociationID,
 		MediaClockMasterID,
 		MediaClockMasterName,
+		ReservedBandwidth,
 
 		Count
 	};
 
+	// Raw value of a cell for sorting, nothing being formatted (numeric columns only set number, text columns only set the case folded text)
+	struct SortKey
+	{
+		std::uint64_t number{ 0u };
+		QString text{};
+
+		bool operator<(SortKey const& other) const noexcept
+		{
+			return number != other.number ? number < other.number : text < other.text;
+		}
+
+		bool operator==(SortKey const& other) const noexcept
+		{
+			return number == other.number && text == other.text;
+		}
+	};
+
 	ControllerModel(QObject* parent = nullptr);
 	virtual ~ControllerModel();
 
@@ -56,8 +78,20 @@ public:
 	virtual QVariant data(QModelIndex const& index, int role = Qt::DisplayRole) const override;
 	virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
 
+	// Set the size the entity logos are painted at, so pre-scaled thumbnails can be used
+	void setEntityLogoSize(QSize const& size, qreal const devicePixelRatio);
+
+	// Set the size the status icons (compatibility, acquire and lock states) are painted at, so they are scaled once instead of on each paint
+	void setStatusIconSize(QSize const& size, qreal const devicePixelRatio);
+
+	// Suspend or resume the notification of the changed cells (default true), the entities data being still updated so the cells changed in the meantime are all notified at once when activated again
+	void setActive(bool const isActive);
+
 	// Helpers
 	la::avdecc::UniqueIdentifier controlledEntityID(QModelIndex const& index) const;
+	QModelIndex controlledEntityIndex(la::avdecc::UniqueIdentifier const& entityID) const; // Index of the first column of the entity row, invalid if the entity is not in the model
+	SortKey sortKey(int const row, Column const column) const;
+	QString filterText(int const row) const; // Case folded entity ID, name, group, compatibility and gPTP information of the row, for the filters
 
 private:
 	QScopedPointer<ControllerModelPrivate> const d_ptr;
@@ -0,0 +1,153 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+/**
+* Fixed-size history of a counter, a circular buffer of (timestamp, value) samples.
+* Timestamps and values are stored in two separate arrays (struct of arrays), so the memory used by a counter is constant whatever the rate of its updates.
+* This file only depends on the standard library.
+*/
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace avdecc
+{
+class CounterHistory
+{
+public:
+	static constexpr std::size_t Capacity = 64; // Number of samples kept, older ones being overwritten
+	using Clock = std::chrono::steady_clock;
+	using Value = std::uint64_t;
+
+	/** Adds a sample, overwriting the oldest one if the history is full */
+	void push(Clock::time_point const& timestamp, Value const value) noexcept
+	{
+		_timestamps[_head] = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.time_since_epoch()).count();
+		_values[_head] = value;
+		_head = (_head + 1u) % Capacity;
+		if (_size < Capacity)
+		{
+			++_size;
+		}
+	}
+
+	/** Removes all samples */
+	void clear() noexcept
+	{
+		_head = 0u;
+		_size = 0u;
+	}
+
+	std::size_t size() const noexcept
+	{
+		return _size;
+	}
+
+	bool empty() const noexcept
+	{
+		return _size == 0u;
+	}
+
+	/** Timestamp of the sample at index (0 being the oldest sample) */
+	Clock::time_point timestamp(std::size_t const index) const noexcept
+	{
+		return Clock::time_point{ std::chrono::duration_cast<Clock::duration>(std::chrono::milliseconds{ _timestamps[position(index)] }) };
+	}
+
+	/** Value of the sample at index (0 being the oldest sample) */
+	Value value(std::size_t const index) const noexcept
+	{
+		return _values[position(index)];
+	}
+
+	/** Increment of the counter between the sample at index and the previous one (a counter reset or wrap counting as an increment of the new value). Returns 0 for the oldest sample */
+	Value increment(std::size_t const index) const noexcept
+	{
+		if (index == 0u)
+		{
+			return 0u;
+		}
+		auto const previous = value(index - 1u);
+		auto const current = value(index);
+		return current >= previous ? current - previous : current;
+	}
+
+	/** Rate (per second) of the counter over the window ending at now */
+	double ratePerSecond(Clock::time_point const& now, std::chrono::milliseconds const& window) const noexcept
+	{
+		if (window.count() <= 0)
+		{
+			return 0.0;
+		}
+
+		auto const windowStart = now - window;
+		auto total = Value{ 0u };
+		for (auto index = std::size_t{ 1u }; index < _size; ++index)
+		{
+			if (timestamp(index) > windowStart)
+			{
+				total += increment(index);
+			}
+		}
+		return static_cast<double>(total) * 1000.0 / static_cast<double>(window.count());
+	}
+
+	/** Increment of the counter during each of the bucketsCount periods of bucketDuration ending at now (oldest bucket first) */
+	std::vector<Value> incrementsPerBucket(Clock::time_point const& now, std::chrono::milliseconds const& bucketDuration, std::size_t const bucketsCount) const noexcept
+	{
+		auto buckets = std::vector<Value>(bucketsCount, Value{ 0u });
+		if (bucketDuration.count() <= 0 || bucketsCount == 0u)
+		{
+			return buckets;
+		}
+
+		for (auto index = std::size_t{ 1u }; index < _size; ++index)
+		{
+			auto const age = std::chrono::duration_cast<std::chrono::milliseconds>(now - timestamp(index));
+			if (age.count() < 0)
+			{
+				continue;
+			}
+			auto const bucketsAgo = static_cast<std::size_t>(age.count() / bucketDuration.count());
+			if (bucketsAgo < bucketsCount)
+			{
+				buckets[bucketsCount - 1u - bucketsAgo] += increment(index);
+			}
+		}
+		return buckets;
+	}
+
+private:
+	std::size_t position(std::size_t const index) const noexcept
+	{
+		return (_head + Capacity - _size + index) % Capacity;
+	}
+
+	std::array<std::int64_t, Capacity> _timestamps{}; // Milliseconds since Clock epoch
+	std::array<Value, Capacity> _values{};
+	std::size_t _head{ 0u }; // Next write position
+	std::size_t _size{ 0u }; // Number of valid samples
+};
+
+} // namespace avdecc
@@ -0,0 +1,433 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "entityModelStore.hpp"
+#include "controllerManager.hpp"
+#include "helper.hpp"
+#include "hiveLogItems.hpp"
+#include "settingsManager/settings.hpp"
+
+#include <QStandardPaths>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QThreadPool>
+#include <QRunnable>
+
+#include <functional>
+#include <mutex>
+#include <unordered_set>
+#include <cstring>
+
+namespace avdecc
+{
+/** Stored models are written and compared in the background, one at a time so they never compete with the UI */
+static constexpr auto StoreMaxThreadCount = 1;
+static constexpr auto StoredModelExtension = "aem";
+
+class StoreTask final : public QRunnable
+{
+public:
+	using Work = std::function<void()>;
+
+	StoreTask(Work&& work) noexcept
+		: _work{ std::move(work) }
+	{
+	}
+
+	virtual void run() override
+	{
+		_work();
+	}
+
+private:
+	Work _work{};
+};
+
+class EntityModelStoreImpl final : public EntityModelStore, public settings::SettingsManager::Observer
+{
+public:
+	EntityModelStoreImpl() noexcept
+	{
+		_pool.setMaxThreadCount(StoreMaxThreadCount);
+
+		QDir{}.mkpath(storePath());
+
+		// Validate what's already on disk in the background, it's not needed before entities come online
+		_pool.start(new StoreTask{
+			[this]()
+			{
+				validateStoredModels();
+			} });
+
+		auto& manager = ControllerManager::getInstance();
+		connect(&manager, &ControllerManager::controllerOnline, this, &EntityModelStoreImpl::handleControllerOnline);
+		connect(&manager, &ControllerManager::entityOnline, this, &EntityModelStoreImpl::handleEntityOnline);
+
+		auto& settings = settings::SettingsManager::getInstance();
+		settings.registerSettingObserver(settings::Controller_AemCacheEnabled.name, this);
+		settings.registerSettingObserver(settings::Controller_SharedAemCachePath.name, this);
+	}
+
+	~EntityModelStoreImpl() noexcept
+	{
+		auto& settings = settings::SettingsManager::getInstance();
+		settings.unregisterSettingObserver(settings::Controller_AemCacheEnabled.name, this);
+		settings.unregisterSettingObserver(settings::Controller_SharedAemCachePath.name, this);
+
+		// Pending tasks use the ControllerManager
+		_pool.clear();
+		_pool.waitForDone();
+	}
+
+private:
+	// EntityModelStore overrides
+	virtual QString storePath() const noexcept override
+	{
+		return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + '/' + QCoreApplication::applicationName() + "/EntityModels";
+	}
+
+	virtual bool isStored(la::avdecc::UniqueIdentifier const entityModelID) const noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+		return _storedModels.count(entityModelID) != 0;
+	}
+
+	virtual QStringList storedModelFiles() const noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+		auto files = QStringList{};
+		for (auto const entityModelID : _storedModels)
+		{
+			files << modelFilePath(entityModelID);
+		}
+		return files;
+	}
+
+	virtual void clear() noexcept override
+	{
+		_pool.clear();
+		_pool.waitForDone();
+
+		auto const lg = std::lock_guard{ _lock };
+		QDir{ storePath() }.removeRecursively();
+		QDir{}.mkpath(storePath());
+		_storedModels.clear();
+		_checkedModels.clear();
+	}
+
+	// settings::SettingsManager::Observer overrides
+	virtual void onSettingChanged(settings::SettingsManager::Setting const& name, QVariant const& value) noexcept override
+	{
+		if (name == settings::Controller_AemCacheEnabled.name)
+		{
+			_enabled = value.toBool();
+		}
+		else if (name == settings::Controller_SharedAemCachePath.name)
+		{
+			auto const lg = std::lock_guard{ _lock };
+			_sharedStorePath = value.toString();
+		}
+	}
+
+	// Private methods
+	QString modelFilePath(la::avdecc::UniqueIdentifier const entityModelID) const noexcept
+	{
+		return modelFilePath(storePath(), entityModelID);
+	}
+
+	static QString modelFilePath(QString const& directory, la::avdecc::UniqueIdentifier const entityModelID) noexcept
+	{
+		return QString{ "%1/%2.%3" }.arg(directory).arg(helper::uniqueIdentifierToString(entityModelID)).arg(StoredModelExtension);
+	}
+
+	QString sharedStorePath() const noexcept
+	{
+		auto const lg = std::lock_guard{ _lock };
+		return _sharedStorePath;
+	}
+
+	/** Copies a model file next to its destination first, then renames it, so other instances never read a partial model */
+	static bool copyModelFile(QString const& sourcePath, QString const& destinationPath) noexcept
+	{
+		auto const tempFilePath = destinationPath + ".tmp";
+		QFile::remove(tempFilePath);
+		if (!QFile::copy(sourcePath, tempFilePath))
+		{
+			return false;
+		}
+		QFile::remove(destinationPath);
+		if (!QFile::rename(tempFilePath, destinationPath))
+		{
+			QFile::remove(tempFilePath);
+			return false;
+		}
+		return true;
+	}
+
+	/** Structural check of a stored model: a complete MessagePack map, read through a memory mapping */
+	static bool isStructurallyValid(QString const& filePath) noexcept
+	{
+		auto file = QFile{ filePath };
+		if (!file.open(QIODevice::ReadOnly) || file.size() == 0)
+		{
+			return false;
+		}
+		auto const* const data = file.map(0, file.size());
+		if (!data)
+		{
+			return false;
+		}
+		auto const marker = data[0];
+		auto const isMap = (marker & 0xf0) == 0x80 || marker == 0xde || marker == 0xdf;
+		file.unmap(const_cast<uchar*>(data));
+		return isMap;
+	}
+
+	static bool haveSameContent(QString const& lhsPath, QString const& rhsPath) noexcept
+	{
+		auto lhs = QFile{ lhsPath };
+		auto rhs = QFile{ rhsPath };
+		if (!lhs.open(QIODevice::ReadOnly) || !rhs.open(QIODevice::ReadOnly) || lhs.size() != rhs.size())
+		{
+			return false;
+		}
+		if (lhs.size() == 0)
+		{
+			return true;
+		}
+		auto* const lhsData = lhs.map(0, lhs.size());
+		auto* const rhsData = rhs.map(0, rhs.size());
+		auto const same = lhsData && rhsData && std::memcmp(lhsData, rhsData, static_cast<size_t>(lhs.size())) == 0;
+		if (lhsData)
+		{
+			lhs.unmap(lhsData);
+		}
+		if (rhsData)
+		{
+			rhs.unmap(rhsData);
+		}
+		return same;
+	}
+
+	void validateStoredModels() noexcept
+	{
+		auto const entries = QDir{ storePath() }.entryInfoList({ QString{ "*.%1" }.arg(StoredModelExtension) }, QDir::Files);
+		auto valid = std::unordered_set<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash>{};
+		for (auto const& entry : entries)
+		{
+			auto const entityModelID = la::avdecc::UniqueIdentifier{ entry.completeBaseName().toULongLong(nullptr, 16) };
+			if (entityModelID && isStructurallyValid(entry.filePath()))
+			{
+				valid.insert(entityModelID);
+			}
+			else
+			{
+				// Truncated or foreign file, get rid of it
+				QFile::remove(entry.filePath());
+			}
+		}
+
+		{
+			auto const lg = std::lock_guard{ _lock };
+			_storedModels.insert(valid.begin(), valid.end());
+		}
+
+		LOG_HIVE_DEBUG(QString("EntityModel store: %1 model(s) in %2").arg(valid.size()).arg(storePath()));
+	}
+
+	void handleControllerOnline() noexcept
+	{
+		if (!_enabled)
+		{
+			return;
+		}
+
+		// Parsing the models takes a while, entities enumerated before a model is loaded read it from the device as usual
+		_pool.start(new StoreTask{
+			[this]()
+			{
+				importSharedModels();
+				preloadStoredModels();
+			} });
+	}
+
+	/** Copies the structurally valid models of the shared store which are not stored locally yet */
+	void importSharedModels() noexcept
+	{
+		auto const sharedPath = sharedStorePath();
+		if (sharedPath.isEmpty())
+		{
+			return;
+		}
+
+		auto imported = size_t{ 0u };
+		auto const entries = QDir{ sharedPath }.entryInfoList({ QString{ "*.%1" }.arg(StoredModelExtension) }, QDir::Files);
+		for (auto const& entry : entries)
+		{
+			auto const entityModelID = la::avdecc::UniqueIdentifier{ entry.completeBaseName().toULongLong(nullptr, 16) };
+			if (!entityModelID || isStored(entityModelID) || !isStructurallyValid(entry.filePath()))
+			{
+				continue;
+			}
+			if (copyModelFile(entry.filePath(), modelFilePath(entityModelID)))
+			{
+				auto const lg = std::lock_guard{ _lock };
+				_storedModels.insert(entityModelID);
+				++imported;
+			}
+		}
+
+		LOG_HIVE_DEBUG(QString("EntityModel store: %1 model(s) imported from %2").arg(imported).arg(sharedPath));
+	}
+
+	/** Loads all the stored models in the entity model cache of the controller */
+	void preloadStoredModels() noexcept
+	{
+		auto& manager = ControllerManager::getInstance();
+		auto loaded = 0;
+		for (auto const& filePath : storedModelFiles())
+		{
+			auto const [error, message] = manager.loadEntityModelFile(filePath);
+			if (!!error)
+			{
+				LOG_HIVE_DEBUG(QString("EntityModel store: cannot load %1: %2").arg(filePath).arg(QString::fromStdString(message)));
+				continue;
+			}
+			++loaded;
+		}
+
+		LOG_HIVE_DEBUG(QString("EntityModel store: %1 model(s) preloaded in the AEM cache").arg(loaded));
+	}
+
+	/** Makes a stored model available to the other instances using the shared store */
+	void exportModel(la::avdecc::UniqueIdentifier const entityModelID) noexcept
+	{
+		auto const sharedPath = sharedStorePath();
+		if (sharedPath.isEmpty())
+		{
+			return;
+		}
+
+		auto const sharedFilePath = modelFilePath(sharedPath, entityModelID);
+		if (QFileInfo::exists(sharedFilePath) || !QDir{}.mkpath(sharedPath))
+		{
+			return;
+		}
+		if (!copyModelFile(modelFilePath(entityModelID), sharedFilePath))
+		{
+			LOG_HIVE_DEBUG(QString("EntityModel store: cannot export model %1 to %2").arg(helper::uniqueIdentifierToString(entityModelID)).arg(sharedPath));
+		}
+	}
+
+	void handleEntityOnline(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		if (!_enabled)
+		{
+			return;
+		}
+
+		auto& manager = ControllerManager::getInstance();
+		auto const controlledEntity = manager.getControlledEntity(entityID);
+		if (!controlledEntity || !controlledEntity->isEntityModelValidForCaching())
+		{
+			return;
+		}
+
+		auto const entityModelID = controlledEntity->getEntity().getEntityModelID();
+
+		// Each model is only written (or checked against the stored one) once per session, by the first entity using it
+		{
+			auto const lg = std::lock_guard{ _lock };
+			if (!_checkedModels.insert(entityModelID).second)
+			{
+				return;
+			}
+		}
+
+		_pool.start(new StoreTask{
+			[this, entityID, entityModelID]()
+			{
+				storeModel(entityID, entityModelID);
+			} });
+	}
+
+	void storeModel(la::avdecc::UniqueIdentifier const entityID, la::avdecc::UniqueIdentifier const entityModelID) noexcept
+	{
+		auto const filePath = modelFilePath(entityModelID);
+		auto const tempFilePath = filePath + ".tmp";
+
+		auto& manager = ControllerManager::getInstance();
+		auto const flags = la::avdecc::entity::model::jsonSerializer::Flags{ la::avdecc::entity::model::jsonSerializer::Flag::ProcessStaticModel, la::avdecc::entity::model::jsonSerializer::Flag::BinaryFormat };
+		auto const [error, message] = manager.serializeControlledEntityAsJson(entityID, tempFilePath, flags, QCoreApplication::applicationName());
+		if (!!error)
+		{
+			LOG_HIVE_DEBUG(QString("EntityModel store: cannot serialize model %1: %2").arg(helper::uniqueIdentifierToString(entityModelID)).arg(QString::fromStdString(message)));
+			QFile::remove(tempFilePath);
+			return;
+		}
+
+		// Stored model is still accurate (lazy validation of what was loaded from disk)
+		if (QFileInfo::exists(filePath) && haveSameContent(filePath, tempFilePath))
+		{
+			QFile::remove(tempFilePath);
+			exportModel(entityModelID);
+			return;
+		}
+
+		// Replace atomically, so a crash never leaves a partial model
+		QFile::remove(filePath);
+		if (!QFile::rename(tempFilePath, filePath))
+		{
+			QFile::remove(tempFilePath);
+			return;
+		}
+
+		{
+			auto const lg = std::lock_guard{ _lock };
+			_storedModels.insert(entityModelID);
+		}
+
+		exportModel(entityModelID);
+
+		QMetaObject::invokeMethod(this,
+			[this, entityModelID]()
+			{
+				emit modelStored(entityModelID);
+			});
+	}
+
+	// Private members
+	mutable std::mutex _lock{};
+	std::unordered_set<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash> _storedModels{}; // Models available on disk
+	std::unordered_set<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash> _checkedModels{}; // Models already written or validated this session
+	QString _sharedStorePath{}; // Protected by _lock, empty if there is no shared store
+	bool _enabled{ false };
+	QThreadPool _pool{}; // Declared last so it's the first destroyed
+};
+
+EntityModelStore& EntityModelStore::getInstance() noexcept
+{
+	static EntityModelStoreImpl s_EntityModelStore{};
+
+	return s_EntityModelStore;
+}
+
+} // namespace avdecc
@@ -0,0 +1,54 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/controller/avdeccController.hpp>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+namespace avdecc
+{
+/** Persists the static model of the enumerated entities on disk (keyed by EntityModelID), when the AEM cache is enabled, so it survives restarts */
+class EntityModelStore : public QObject
+{
+	Q_OBJECT
+public:
+	static EntityModelStore& getInstance() noexcept;
+
+	/** Directory the models are stored in */
+	virtual QString storePath() const noexcept = 0;
+
+	/** Returns true if a (structurally valid) model is stored for this EntityModelID */
+	virtual bool isStored(la::avdecc::UniqueIdentifier const entityModelID) const noexcept = 0;
+
+	/** Files of all the structurally valid stored models */
+	virtual QStringList storedModelFiles() const noexcept = 0;
+
+	/** Removes all the stored models */
+	virtual void clear() noexcept = 0;
+
+	Q_SIGNAL void modelStored(la::avdecc::UniqueIdentifier const entityModelID);
+
+protected:
+	EntityModelStore() = default;
+};
+
+} // namespace avdecc
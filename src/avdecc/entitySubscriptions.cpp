@@ -0,0 +1,240 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "entitySubscriptions.hpp"
+
+namespace avdecc
+{
+class EntitySubscriptionsImpl final : public EntitySubscriptions
+{
+public:
+	EntitySubscriptionsImpl() noexcept
+	{
+		using DescriptorType = la::avdecc::entity::model::DescriptorType;
+
+		auto& manager = ControllerManager::getInstance();
+
+		// Connect each notification once, the slots run in our (main) thread
+		connect(&manager, &ControllerManager::entityNameChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, QString const& entityName)
+			{
+				_entityNameChanged.dispatch(makeKey(entityID), entityName);
+			});
+		connect(&manager, &ControllerManager::entityGroupNameChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, QString const& entityGroupName)
+			{
+				_entityGroupNameChanged.dispatch(makeKey(entityID), entityGroupName);
+			});
+		connect(&manager, &ControllerManager::entityCountersChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::EntityCounters const& counters)
+			{
+				_entityCountersChanged.dispatch(makeKey(entityID), counters);
+			});
+		connect(&manager, &ControllerManager::aecpRetryCounterChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, std::uint64_t const value)
+			{
+				_aecpRetryCounterChanged.dispatch(makeKey(entityID), value);
+			});
+		connect(&manager, &ControllerManager::aecpTimeoutCounterChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, std::uint64_t const value)
+			{
+				_aecpTimeoutCounterChanged.dispatch(makeKey(entityID), value);
+			});
+		connect(&manager, &ControllerManager::aecpUnexpectedResponseCounterChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, std::uint64_t const value)
+			{
+				_aecpUnexpectedResponseCounterChanged.dispatch(makeKey(entityID), value);
+			});
+		connect(&manager, &ControllerManager::aecpResponseAverageTimeChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, std::chrono::milliseconds const& value)
+			{
+				_aecpResponseAverageTimeChanged.dispatch(makeKey(entityID), value);
+			});
+		connect(&manager, &ControllerManager::aemAecpUnsolicitedCounterChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, std::uint64_t const value)
+			{
+				_aemAecpUnsolicitedCounterChanged.dispatch(makeKey(entityID), value);
+			});
+		connect(&manager, &ControllerManager::statisticsErrorCounterChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, ControllerManager::StatisticsErrorCounters const& errorCounters)
+			{
+				_statisticsErrorCounterChanged.dispatch(makeKey(entityID), errorCounters);
+			});
+
+		connect(&manager, &ControllerManager::streamFormatChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat)
+			{
+				_streamFormatChanged.dispatch(makeKey(entityID, descriptorType, streamIndex), streamFormat);
+			});
+		connect(&manager, &ControllerManager::streamRunningChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, bool const isRunning)
+			{
+				_streamRunningChanged.dispatch(makeKey(entityID, descriptorType, streamIndex), isRunning);
+			});
+		connect(&manager, &ControllerManager::streamDynamicInfoChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamDynamicInfo const& info)
+			{
+				_streamDynamicInfoChanged.dispatch(makeKey(entityID, descriptorType, streamIndex), info);
+			});
+		connect(&manager, &ControllerManager::streamConnectionsChanged, this,
+			[this](la::avdecc::entity::model::StreamIdentification const& stream, la::avdecc::entity::model::StreamConnections const& connections)
+			{
+				_streamConnectionsChanged.dispatch(makeKey(stream.entityID, DescriptorType::StreamOutput, stream.streamIndex), connections);
+			});
+		connect(&manager, &ControllerManager::streamPortAudioMappingsChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, DescriptorType const descriptorType, la::avdecc::entity::model::StreamPortIndex const streamPortIndex)
+			{
+				_streamPortAudioMappingsChanged.dispatch(makeKey(entityID, descriptorType, streamPortIndex));
+			});
+		connect(&manager, &ControllerManager::avbInterfaceCountersChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AvbInterfaceCounters const& counters)
+			{
+				_avbInterfaceCountersChanged.dispatch(makeKey(entityID, DescriptorType::AvbInterface, avbInterfaceIndex), counters);
+			});
+		connect(&manager, &ControllerManager::clockDomainCountersChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockDomainCounters const& counters)
+			{
+				_clockDomainCountersChanged.dispatch(makeKey(entityID, DescriptorType::ClockDomain, clockDomainIndex), counters);
+			});
+		connect(&manager, &ControllerManager::streamInputCountersChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamInputCounters const& counters)
+			{
+				_streamInputCountersChanged.dispatch(makeKey(entityID, DescriptorType::StreamInput, streamIndex), counters);
+			});
+		connect(&manager, &ControllerManager::streamOutputCountersChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamOutputCounters const& counters)
+			{
+				_streamOutputCountersChanged.dispatch(makeKey(entityID, DescriptorType::StreamOutput, streamIndex), counters);
+			});
+		connect(&manager, &ControllerManager::streamInputErrorCounterChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, ControllerManager::StreamInputErrorCounters const& errorCounters)
+			{
+				_streamInputErrorCounterChanged.dispatch(makeKey(entityID, DescriptorType::StreamInput, descriptorIndex), errorCounters);
+			});
+	}
+
+private:
+	// EntitySubscriptions overrides
+	virtual NameDispatcher& entityNameChanged() noexcept override
+	{
+		return _entityNameChanged;
+	}
+	virtual NameDispatcher& entityGroupNameChanged() noexcept override
+	{
+		return _entityGroupNameChanged;
+	}
+	virtual EntityCountersDispatcher& entityCountersChanged() noexcept override
+	{
+		return _entityCountersChanged;
+	}
+	virtual StatisticsCounterDispatcher& aecpRetryCounterChanged() noexcept override
+	{
+		return _aecpRetryCounterChanged;
+	}
+	virtual StatisticsCounterDispatcher& aecpTimeoutCounterChanged() noexcept override
+	{
+		return _aecpTimeoutCounterChanged;
+	}
+	virtual StatisticsCounterDispatcher& aecpUnexpectedResponseCounterChanged() noexcept override
+	{
+		return _aecpUnexpectedResponseCounterChanged;
+	}
+	virtual StatisticsAverageTimeDispatcher& aecpResponseAverageTimeChanged() noexcept override
+	{
+		return _aecpResponseAverageTimeChanged;
+	}
+	virtual StatisticsCounterDispatcher& aemAecpUnsolicitedCounterChanged() noexcept override
+	{
+		return _aemAecpUnsolicitedCounterChanged;
+	}
+	virtual StatisticsErrorCountersDispatcher& statisticsErrorCounterChanged() noexcept override
+	{
+		return _statisticsErrorCounterChanged;
+	}
+	virtual StreamFormatDispatcher& streamFormatChanged() noexcept override
+	{
+		return _streamFormatChanged;
+	}
+	virtual StreamRunningDispatcher& streamRunningChanged() noexcept override
+	{
+		return _streamRunningChanged;
+	}
+	virtual StreamDynamicInfoDispatcher& streamDynamicInfoChanged() noexcept override
+	{
+		return _streamDynamicInfoChanged;
+	}
+	virtual StreamConnectionsDispatcher& streamConnectionsChanged() noexcept override
+	{
+		return _streamConnectionsChanged;
+	}
+	virtual StreamPortAudioMappingsDispatcher& streamPortAudioMappingsChanged() noexcept override
+	{
+		return _streamPortAudioMappingsChanged;
+	}
+	virtual AvbInterfaceCountersDispatcher& avbInterfaceCountersChanged() noexcept override
+	{
+		return _avbInterfaceCountersChanged;
+	}
+	virtual ClockDomainCountersDispatcher& clockDomainCountersChanged() noexcept override
+	{
+		return _clockDomainCountersChanged;
+	}
+	virtual StreamInputCountersDispatcher& streamInputCountersChanged() noexcept override
+	{
+		return _streamInputCountersChanged;
+	}
+	virtual StreamOutputCountersDispatcher& streamOutputCountersChanged() noexcept override
+	{
+		return _streamOutputCountersChanged;
+	}
+	virtual StreamInputErrorCountersDispatcher& streamInputErrorCounterChanged() noexcept override
+	{
+		return _streamInputErrorCounterChanged;
+	}
+
+	// Private members
+	NameDispatcher _entityNameChanged{ this };
+	NameDispatcher _entityGroupNameChanged{ this };
+	EntityCountersDispatcher _entityCountersChanged{ this };
+	StatisticsCounterDispatcher _aecpRetryCounterChanged{ this };
+	StatisticsCounterDispatcher _aecpTimeoutCounterChanged{ this };
+	StatisticsCounterDispatcher _aecpUnexpectedResponseCounterChanged{ this };
+	StatisticsAverageTimeDispatcher _aecpResponseAverageTimeChanged{ this };
+	StatisticsCounterDispatcher _aemAecpUnsolicitedCounterChanged{ this };
+	StatisticsErrorCountersDispatcher _statisticsErrorCounterChanged{ this };
+	StreamFormatDispatcher _streamFormatChanged{ this };
+	StreamRunningDispatcher _streamRunningChanged{ this };
+	StreamDynamicInfoDispatcher _streamDynamicInfoChanged{ this };
+	StreamConnectionsDispatcher _streamConnectionsChanged{ this };
+	StreamPortAudioMappingsDispatcher _streamPortAudioMappingsChanged{ this };
+	AvbInterfaceCountersDispatcher _avbInterfaceCountersChanged{ this };
+	ClockDomainCountersDispatcher _clockDomainCountersChanged{ this };
+	StreamInputCountersDispatcher _streamInputCountersChanged{ this };
+	StreamOutputCountersDispatcher _streamOutputCountersChanged{ this };
+	StreamInputErrorCountersDispatcher _streamInputErrorCounterChanged{ this };
+};
+
+EntitySubscriptions& EntitySubscriptions::getInstance() noexcept
+{
+	static EntitySubscriptionsImpl s_subscriptions{};
+
+	return s_subscriptions;
+}
+
+} // namespace avdecc
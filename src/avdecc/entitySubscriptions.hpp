@@ -0,0 +1,205 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "controllerManager.hpp"
+
+#include <la/avdecc/controller/avdeccController.hpp>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace avdecc
+{
+/** What a subscriber is interested in: a whole entity (Entity descriptor, index 0) or one of its descriptors */
+struct SubscriptionKey
+{
+	la::avdecc::UniqueIdentifier entityID{};
+	la::avdecc::entity::model::DescriptorType descriptorType{ la::avdecc::entity::model::DescriptorType::Entity };
+	la::avdecc::entity::model::DescriptorIndex descriptorIndex{ 0u };
+
+	bool operator==(SubscriptionKey const& other) const noexcept
+	{
+		return entityID == other.entityID && descriptorType == other.descriptorType && descriptorIndex == other.descriptorIndex;
+	}
+};
+
+struct SubscriptionKeyHash
+{
+	std::size_t operator()(SubscriptionKey const& key) const noexcept
+	{
+		return la::avdecc::UniqueIdentifier::hash{}(key.entityID) ^ (std::hash<std::uint32_t>{}((static_cast<std::uint32_t>(la::avdecc::utils::to_integral(key.descriptorType)) << 16) | key.descriptorIndex) << 1);
+	}
+};
+
+/**
+* @brief Subscribers of a single notification, indexed by SubscriptionKey.
+*		 A subscription lasts as long as its receiver, handlers being called in the receiver's thread (the main thread) in subscription order.
+*/
+template<typename... Args>
+class KeyedDispatcher final
+{
+public:
+	using Handler = std::function<void(Args const&...)>;
+
+	explicit KeyedDispatcher(QObject* const owner) noexcept
+		: _owner{ owner }
+	{
+	}
+
+	void subscribe(QObject* const receiver, SubscriptionKey const& key, Handler&& handler) noexcept
+	{
+		_subscribers[key].push_back(Subscriber{ receiver, std::move(handler) });
+
+		// Automatically unsubscribe when the receiver is destroyed
+		QObject::connect(receiver, &QObject::destroyed, _owner,
+			[this, receiver, key]()
+			{
+				unsubscribe(receiver, key);
+			});
+	}
+
+	/** Calls the handlers subscribed for the key, and only them */
+	void dispatch(SubscriptionKey const& key, Args const&... args) const noexcept
+	{
+		auto const it = _subscribers.find(key);
+		if (it == _subscribers.end())
+		{
+			return;
+		}
+
+		// Copy the subscribers, a handler may subscribe or destroy a receiver
+		auto const subscribers = it->second;
+		for (auto const& subscriber : subscribers)
+		{
+			if (subscriber.receiver)
+			{
+				subscriber.handler(args...);
+			}
+		}
+	}
+
+private:
+	struct Subscriber
+	{
+		QPointer<QObject> receiver{};
+		Handler handler{};
+	};
+
+	void unsubscribe(QObject const* const receiver, SubscriptionKey const& key) noexcept
+	{
+		auto const it = _subscribers.find(key);
+		if (it == _subscribers.end())
+		{
+			return;
+		}
+
+		// The QPointer is already cleared when destroyed is emitted, also drop any other dead subscriber
+		auto& subscribers = it->second;
+		subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(),
+												[receiver](auto const& subscriber)
+												{
+													return subscriber.receiver.isNull() || subscriber.receiver.data() == receiver;
+												}),
+			subscribers.end());
+		if (subscribers.empty())
+		{
+			_subscribers.erase(it);
+		}
+	}
+
+	QObject* _owner{ nullptr };
+	std::unordered_map<SubscriptionKey, std::vector<Subscriber>, SubscriptionKeyHash> _subscribers{};
+};
+
+/**
+* @brief Per entity (and per descriptor) fan-out of the ControllerManager notifications.
+*		 Each notification is connected once to the ControllerManager and only delivered to the subscribers of its key,
+*		 instead of every item connecting to the global signal and filtering the entityID in its slot.
+*		 Keys of notifications with a descriptor type implied by the signal use it (StreamInput counters, StreamOutput connections, ...).
+*/
+class EntitySubscriptions : public QObject
+{
+	Q_OBJECT
+public:
+	using NameDispatcher = KeyedDispatcher<QString>;
+	using StreamFormatDispatcher = KeyedDispatcher<la::avdecc::entity::model::StreamFormat>;
+	using StreamRunningDispatcher = KeyedDispatcher<bool>;
+	using StreamDynamicInfoDispatcher = KeyedDispatcher<la::avdecc::entity::model::StreamDynamicInfo>;
+	using StreamConnectionsDispatcher = KeyedDispatcher<la::avdecc::entity::model::StreamConnections>;
+	using StreamPortAudioMappingsDispatcher = KeyedDispatcher<>;
+	using EntityCountersDispatcher = KeyedDispatcher<la::avdecc::entity::model::EntityCounters>;
+	using AvbInterfaceCountersDispatcher = KeyedDispatcher<la::avdecc::entity::model::AvbInterfaceCounters>;
+	using ClockDomainCountersDispatcher = KeyedDispatcher<la::avdecc::entity::model::ClockDomainCounters>;
+	using StreamInputCountersDispatcher = KeyedDispatcher<la::avdecc::entity::model::StreamInputCounters>;
+	using StreamOutputCountersDispatcher = KeyedDispatcher<la::avdecc::entity::model::StreamOutputCounters>;
+	using StreamInputErrorCountersDispatcher = KeyedDispatcher<ControllerManager::StreamInputErrorCounters>;
+	using StatisticsCounterDispatcher = KeyedDispatcher<std::uint64_t>;
+	using StatisticsAverageTimeDispatcher = KeyedDispatcher<std::chrono::milliseconds>;
+	using StatisticsErrorCountersDispatcher = KeyedDispatcher<ControllerManager::StatisticsErrorCounters>;
+
+	/** Must be first called from the main thread, after the ControllerManager is created */
+	static EntitySubscriptions& getInstance() noexcept;
+
+	/* Entity notifications (key: entityID) */
+	virtual NameDispatcher& entityNameChanged() noexcept = 0;
+	virtual NameDispatcher& entityGroupNameChanged() noexcept = 0;
+	virtual EntityCountersDispatcher& entityCountersChanged() noexcept = 0;
+	virtual StatisticsCounterDispatcher& aecpRetryCounterChanged() noexcept = 0;
+	virtual StatisticsCounterDispatcher& aecpTimeoutCounterChanged() noexcept = 0;
+	virtual StatisticsCounterDispatcher& aecpUnexpectedResponseCounterChanged() noexcept = 0;
+	virtual StatisticsAverageTimeDispatcher& aecpResponseAverageTimeChanged() noexcept = 0;
+	virtual StatisticsCounterDispatcher& aemAecpUnsolicitedCounterChanged() noexcept = 0;
+	virtual StatisticsErrorCountersDispatcher& statisticsErrorCounterChanged() noexcept = 0;
+
+	/* Descriptor notifications (key: entityID, descriptorType, descriptorIndex) */
+	virtual StreamFormatDispatcher& streamFormatChanged() noexcept = 0;
+	virtual StreamRunningDispatcher& streamRunningChanged() noexcept = 0;
+	virtual StreamDynamicInfoDispatcher& streamDynamicInfoChanged() noexcept = 0;
+	virtual StreamConnectionsDispatcher& streamConnectionsChanged() noexcept = 0; // StreamOutput
+	virtual StreamPortAudioMappingsDispatcher& streamPortAudioMappingsChanged() noexcept = 0;
+	virtual AvbInterfaceCountersDispatcher& avbInterfaceCountersChanged() noexcept = 0; // AvbInterface
+	virtual ClockDomainCountersDispatcher& clockDomainCountersChanged() noexcept = 0; // ClockDomain
+	virtual StreamInputCountersDispatcher& streamInputCountersChanged() noexcept = 0; // StreamInput
+	virtual StreamOutputCountersDispatcher& streamOutputCountersChanged() noexcept = 0; // StreamOutput
+	virtual StreamInputErrorCountersDispatcher& streamInputErrorCounterChanged() noexcept = 0; // StreamInput
+
+	static SubscriptionKey makeKey(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		return SubscriptionKey{ entityID };
+	}
+
+	static SubscriptionKey makeKey(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex) noexcept
+	{
+		return SubscriptionKey{ entityID, descriptorType, descriptorIndex };
+	}
+
+protected:
+	EntitySubscriptions() = default;
+};
+
+} // namespace avdecc
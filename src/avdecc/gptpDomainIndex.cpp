@@ -0,0 +1,219 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gptpDomainIndex.hpp"
+#include "controllerManager.hpp"
+
+
+namespace avdecc
+{
+namespace gptp
+{
+// **************************************************************
+// class GptpDomainIndexImpl
+// **************************************************************
+class GptpDomainIndexImpl final : public GptpDomainIndex
+{
+public:
+	GptpDomainIndexImpl() noexcept
+	{
+		auto& manager = ControllerManager::getInstance();
+		connect(&manager, &ControllerManager::controllerOffline, this, &GptpDomainIndexImpl::handleControllerOffline);
+		connect(&manager, &ControllerManager::entityOnline, this, &GptpDomainIndexImpl::handleEntityOnline);
+		connect(&manager, &ControllerManager::entityOffline, this, &GptpDomainIndexImpl::handleEntityOffline);
+		connect(&manager, &ControllerManager::gptpChanged, this, &GptpDomainIndexImpl::handleGptpChanged);
+	}
+
+	// Deleted compiler auto-generated methods
+	GptpDomainIndexImpl(GptpDomainIndexImpl const&) = delete;
+	GptpDomainIndexImpl(GptpDomainIndexImpl&&) = delete;
+	GptpDomainIndexImpl& operator=(GptpDomainIndexImpl const&) = delete;
+	GptpDomainIndexImpl& operator=(GptpDomainIndexImpl&&) = delete;
+
+private:
+	// GptpDomainIndex overrides
+	virtual std::vector<DomainKey> getDomains() const noexcept override
+	{
+		auto domains = std::vector<DomainKey>{};
+		domains.reserve(_domainInterfaces.size());
+		for (auto const& domainKV : _domainInterfaces)
+		{
+			domains.push_back(domainKV.first);
+		}
+		return domains;
+	}
+
+	virtual InterfaceKeys getInterfaces(DomainKey const& domain) const noexcept override
+	{
+		auto const it = _domainInterfaces.find(domain);
+		return it != _domainInterfaces.end() ? it->second : InterfaceKeys{};
+	}
+
+	virtual size_t getGrandmastersCount(std::uint8_t const domainNumber) const noexcept override
+	{
+		auto const it = _grandmastersCount.find(domainNumber);
+		return it != _grandmastersCount.end() ? it->second : 0u;
+	}
+
+	virtual bool isSplit(std::uint8_t const domainNumber) const noexcept override
+	{
+		return getGrandmastersCount(domainNumber) > 1u;
+	}
+
+	// Private methods
+	void removeInterface(InterfaceKey const& avbInterface) noexcept
+	{
+		auto const it = _interfaceDomains.find(avbInterface);
+		if (it == _interfaceDomains.end())
+		{
+			return;
+		}
+
+		auto const domain = it->second;
+		_interfaceDomains.erase(it);
+
+		auto const domainIt = _domainInterfaces.find(domain);
+		if (domainIt == _domainInterfaces.end())
+		{
+			return;
+		}
+
+		domainIt->second.erase(avbInterface);
+		emit interfaceRemoved(domain, avbInterface);
+
+		if (domainIt->second.empty())
+		{
+			_domainInterfaces.erase(domainIt);
+			emit domainRemoved(domain);
+
+			auto& count = _grandmastersCount[domain.domainNumber];
+			--count;
+			if (count == 1u)
+			{
+				emit splitChanged(domain.domainNumber, false);
+			}
+			else if (count == 0u)
+			{
+				_grandmastersCount.erase(domain.domainNumber);
+			}
+		}
+	}
+
+	void setInterface(InterfaceKey const& avbInterface, DomainKey const& domain) noexcept
+	{
+		auto const it = _interfaceDomains.find(avbInterface);
+		if (it != _interfaceDomains.end())
+		{
+			if (it->second == domain)
+			{
+				return;
+			}
+			removeInterface(avbInterface);
+		}
+
+		_interfaceDomains[avbInterface] = domain;
+		_entityInterfaces[avbInterface.entityID].insert(avbInterface.avbInterfaceIndex);
+
+		auto [domainIt, inserted] = _domainInterfaces.try_emplace(domain);
+		if (inserted)
+		{
+			emit domainAdded(domain);
+
+			auto& count = _grandmastersCount[domain.domainNumber];
+			++count;
+			if (count == 2u)
+			{
+				emit splitChanged(domain.domainNumber, true);
+			}
+		}
+
+		domainIt->second.insert(avbInterface);
+		emit interfaceAdded(domain, avbInterface);
+	}
+
+	// Slots
+	void handleControllerOffline() noexcept
+	{
+		auto interfaces = std::vector<InterfaceKey>{};
+		interfaces.reserve(_interfaceDomains.size());
+		for (auto const& interfaceKV : _interfaceDomains)
+		{
+			interfaces.push_back(interfaceKV.first);
+		}
+		for (auto const& avbInterface : interfaces)
+		{
+			removeInterface(avbInterface);
+		}
+		_entityInterfaces.clear();
+	}
+
+	void handleEntityOnline(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		auto controlledEntity = ControllerManager::getInstance().getControlledEntity(entityID);
+		if (!controlledEntity)
+		{
+			return;
+		}
+
+		// From the ADP information, so entities not supporting AEM are indexed too
+		for (auto const& [avbInterfaceIndex, information] : controlledEntity->getEntity().getInterfacesInformation())
+		{
+			if (information.gptpGrandmasterID && information.gptpDomainNumber)
+			{
+				setInterface(InterfaceKey{ entityID, avbInterfaceIndex }, DomainKey{ *information.gptpGrandmasterID, *information.gptpDomainNumber });
+			}
+		}
+	}
+
+	void handleEntityOffline(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		auto const it = _entityInterfaces.find(entityID);
+		if (it == _entityInterfaces.end())
+		{
+			return;
+		}
+
+		for (auto const avbInterfaceIndex : it->second)
+		{
+			removeInterface(InterfaceKey{ entityID, avbInterfaceIndex });
+		}
+		_entityInterfaces.erase(it);
+	}
+
+	void handleGptpChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::UniqueIdentifier const grandMasterID, std::uint8_t const grandMasterDomain) noexcept
+	{
+		setInterface(InterfaceKey{ entityID, avbInterfaceIndex }, DomainKey{ grandMasterID, grandMasterDomain });
+	}
+
+	// Private members
+	std::unordered_map<InterfaceKey, DomainKey, InterfaceKey::hash> _interfaceDomains{};
+	std::unordered_map<DomainKey, InterfaceKeys, DomainKey::hash> _domainInterfaces{};
+	std::unordered_map<std::uint8_t, size_t> _grandmastersCount{}; // Count of grandmasters (hence of groups) per domain number
+	std::unordered_map<la::avdecc::UniqueIdentifier, std::unordered_set<la::avdecc::entity::model::AvbInterfaceIndex>, la::avdecc::UniqueIdentifier::hash> _entityInterfaces{};
+};
+
+GptpDomainIndex& GptpDomainIndex::getInstance() noexcept
+{
+	static GptpDomainIndexImpl s_index{};
+
+	return s_index;
+}
+
+} // namespace gptp
+} // namespace avdecc
@@ -0,0 +1,101 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/controller/avdeccController.hpp>
+#include <QObject>
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace avdecc
+{
+namespace gptp
+{
+/** A gPTP domain as seen by an interface: its grandmaster and domain number */
+struct DomainKey
+{
+	la::avdecc::UniqueIdentifier grandmasterID{};
+	std::uint8_t domainNumber{ 0u };
+
+	bool operator==(DomainKey const& other) const noexcept
+	{
+		return grandmasterID == other.grandmasterID && domainNumber == other.domainNumber;
+	}
+
+	struct hash
+	{
+		std::size_t operator()(DomainKey const& key) const noexcept
+		{
+			return la::avdecc::UniqueIdentifier::hash{}(key.grandmasterID) ^ (std::hash<std::uint8_t>{}(key.domainNumber) << 1);
+		}
+	};
+};
+
+/** AVB interface of an entity */
+struct InterfaceKey
+{
+	la::avdecc::UniqueIdentifier entityID{};
+	la::avdecc::entity::model::AvbInterfaceIndex avbInterfaceIndex{ 0u };
+
+	bool operator==(InterfaceKey const& other) const noexcept
+	{
+		return entityID == other.entityID && avbInterfaceIndex == other.avbInterfaceIndex;
+	}
+
+	struct hash
+	{
+		std::size_t operator()(InterfaceKey const& key) const noexcept
+		{
+			return la::avdecc::UniqueIdentifier::hash{}(key.entityID) ^ (std::hash<la::avdecc::entity::model::AvbInterfaceIndex>{}(key.avbInterfaceIndex) << 1);
+		}
+	};
+};
+
+using InterfaceKeys = std::unordered_set<InterfaceKey, InterfaceKey::hash>;
+
+/**
+* @brief Index of the AVB interfaces grouped by (grandmaster, domain number), maintained incrementally from the gptpChanged events (constant time per event).
+*		 A domain number with more than one grandmaster is split: the interfaces of a same domain do not all share the same time reference.
+*/
+class GptpDomainIndex : public QObject
+{
+	Q_OBJECT
+public:
+	static GptpDomainIndex& getInstance() noexcept;
+
+	virtual std::vector<DomainKey> getDomains() const noexcept = 0;
+	virtual InterfaceKeys getInterfaces(DomainKey const& domain) const noexcept = 0;
+	virtual size_t getGrandmastersCount(std::uint8_t const domainNumber) const noexcept = 0;
+	virtual bool isSplit(std::uint8_t const domainNumber) const noexcept = 0;
+
+	Q_SIGNAL void domainAdded(avdecc::gptp::DomainKey const& domain);
+	Q_SIGNAL void domainRemoved(avdecc::gptp::DomainKey const& domain);
+	Q_SIGNAL void interfaceAdded(avdecc::gptp::DomainKey const& domain, avdecc::gptp::InterfaceKey const& avbInterface);
+	Q_SIGNAL void interfaceRemoved(avdecc::gptp::DomainKey const& domain, avdecc::gptp::InterfaceKey const& avbInterface);
+	Q_SIGNAL void splitChanged(std::uint8_t const domainNumber, bool const isSplit);
+};
+
+} // namespace gptp
+} // namespace avdecc
@@ -21,12 +21,65 @@
 #include "controllerManager.hpp"
 #include "toolkit/material/helper.hpp"
 #include <la/avdecc/utils.hpp>
+#include <array>
 #include <cctype>
+#include <cstdint>
 
 namespace avdecc
 {
 namespace helper
 {
+/**
+* Small open-addressing table of already formatted strings, keyed on the raw value they were built from.
+* Instances are thread_local so no lock is needed, and a full probe sequence simply overwrites its first slot.
+*/
+template<std::size_t Size>
+class MemoizedStrings final
+{
+	static_assert((Size & (Size - 1)) == 0, "Size must be a power of 2");
+
+public:
+	template<typename Builder>
+	QString const& get(std::uint64_t const key, Builder&& builder) noexcept
+	{
+		auto const hash = static_cast<std::size_t>((key * 0x9e3779b97f4a7c15ull) >> 32);
+		for (auto probe = std::size_t{ 0u }; probe < MaxProbes; ++probe)
+		{
+			auto& slot = _slots[(hash + probe) & (Size - 1)];
+			if (!slot.isValid)
+			{
+				return store(slot, key, builder);
+			}
+			if (slot.key == key)
+			{
+				return slot.value;
+			}
+		}
+		return store(_slots[hash & (Size - 1)], key, builder);
+	}
+
+private:
+	static constexpr std::size_t MaxProbes = 4u;
+
+	struct Slot
+	{
+		std::uint64_t key{ 0u };
+		QString value{};
+		bool isValid{ false };
+	};
+
+	template<typename Builder>
+	static QString const& store(Slot& slot, std::uint64_t const key, Builder&& builder) noexcept
+	{
+		slot.key = key;
+		slot.value = builder();
+		slot.isValid = true;
+		return slot.value;
+	}
+
+	std::array<Slot, Size> _slots{};
+};
+
 QString protocolInterfaceTypeName(la::avdecc::protocol::ProtocolInterface::Type const& protocolInterfaceType)
 {
 	switch (protocolInterfaceType)
@@ -47,7 +100,13 @@ QString protocolInterfaceTypeName(la::avdecc::protocol::ProtocolInterface::Type
 
 QString uniqueIdentifierToString(la::avdecc::UniqueIdentifier const& identifier)
 {
-	return toHexQString(identifier.getValue(), true, true);
+	static thread_local auto s_strings = MemoizedStrings<1024>{};
+	auto const value = identifier.getValue();
+	return s_strings.get(value,
+		[value]()
+		{
+			return toHexQString(value, true, true);
+		});
 }
 
 QString configurationName(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::ConfigurationNode const& node) noexcept
@@ -242,7 +301,7 @@ QString lockStateToString(la::avdecc::controller::model::LockState const& lockSt
 	}
 }
 
-QString samplingRateToString(la::avdecc::entity::model::StreamFormatInfo::SamplingRate const& samplingRate) noexcept
+static QString buildSamplingRateString(la::avdecc::entity::model::StreamFormatInfo::SamplingRate const& samplingRate) noexcept
 {
 	switch (samplingRate)
 	{
@@ -277,7 +336,17 @@ QString samplingRateToString(la::avdecc::entity::model::StreamFormatInfo::Sampli
 	}
 }
 
-QString streamFormatToString(la::avdecc::entity::model::StreamFormatInfo const& format) noexcept
+QString samplingRateToString(la::avdecc::entity::model::StreamFormatInfo::SamplingRate const& samplingRate) noexcept
+{
+	static thread_local auto s_strings = MemoizedStrings<16>{};
+	return s_strings.get(static_cast<std::uint64_t>(la::avdecc::utils::to_integral(samplingRate)),
+		[&samplingRate]()
+		{
+			return buildSamplingRateString(samplingRate);
+		});
+}
+
+static QString buildStreamFormatString(la::avdecc::entity::model::StreamFormatInfo const& format) noexcept
 {
 	QString fmtStr;
 
@@ -358,6 +427,16 @@ QString streamFormatToString(la::avdecc::entity::model::StreamFormatInfo const&
 	return fmtStr;
 }
 
+QString streamFormatToString(la::avdecc::entity::model::StreamFormatInfo const& format) noexcept
+{
+	static thread_local auto s_strings = MemoizedStrings<256>{};
+	return s_strings.get(static_cast<std::uint64_t>(format.getStreamFormat()),
+		[&format]()
+		{
+			return buildStreamFormatString(format);
+		});
+}
+
 QString clockSourceToString(la::avdecc::controller::model::ClockSourceNode const& node) noexcept
 {
 	auto const* const descriptor = node.staticModel;
@@ -372,7 +451,7 @@ inline void concatenateFlags(QString& flags, QString const& flag) noexcept
 	flags += flag;
 }
 
-QString flagsToString(la::avdecc::entity::AvbInterfaceFlags const flags) noexcept
+static QString buildFlagsString(la::avdecc::entity::AvbInterfaceFlags const flags) noexcept
 {
 	QString str;
 
@@ -389,7 +468,17 @@ QString flagsToString(la::avdecc::entity::AvbInterfaceFlags const flags) noexcep
 	return str;
 }
 
-QString flagsToString(la::avdecc::entity::AvbInfoFlags const flags) noexcept
+QString flagsToString(la::avdecc::entity::AvbInterfaceFlags const flags) noexcept
+{
+	static thread_local auto s_strings = MemoizedStrings<32>{};
+	return s_strings.get(static_cast<std::uint64_t>(flags.value()),
+		[&flags]()
+		{
+			return buildFlagsString(flags);
+		});
+}
+
+static QString buildFlagsString(la::avdecc::entity::AvbInfoFlags const flags) noexcept
 {
 	QString str;
 
@@ -406,7 +495,17 @@ QString flagsToString(la::avdecc::entity::AvbInfoFlags const flags) noexcept
 	return str;
 }
 
-QString flagsToString(la::avdecc::entity::ClockSourceFlags const flags) noexcept
+QString flagsToString(la::avdecc::entity::AvbInfoFlags const flags) noexcept
+{
+	static thread_local auto s_strings = MemoizedStrings<32>{};
+	return s_strings.get(static_cast<std::uint64_t>(flags.value()),
+		[&flags]()
+		{
+			return buildFlagsString(flags);
+		});
+}
+
+static QString buildFlagsString(la::avdecc::entity::ClockSourceFlags const flags) noexcept
 {
 	QString str;
 
@@ -421,7 +520,17 @@ QString flagsToString(la::avdecc::entity::ClockSourceFlags const flags) noexcept
 	return str;
 }
 
-QString flagsToString(la::avdecc::entity::PortFlags const flags) noexcept
+QString flagsToString(la::avdecc::entity::ClockSourceFlags const flags) noexcept
+{
+	static thread_local auto s_strings = MemoizedStrings<32>{};
+	return s_strings.get(static_cast<std::uint64_t>(flags.value()),
+		[&flags]()
+		{
+			return buildFlagsString(flags);
+		});
+}
+
+static QString buildFlagsString(la::avdecc::entity::PortFlags const flags) noexcept
 {
 	QString str;
 
@@ -438,7 +547,17 @@ QString flagsToString(la::avdecc::entity::PortFlags const flags) noexcept
 	return str;
 }
 
-QString flagsToString(la::avdecc::entity::StreamInfoFlags const flags) noexcept
+QString flagsToString(la::avdecc::entity::PortFlags const flags) noexcept
+{
+	static thread_local auto s_strings = MemoizedStrings<32>{};
+	return s_strings.get(static_cast<std::uint64_t>(flags.value()),
+		[&flags]()
+		{
+			return buildFlagsString(flags);
+		});
+}
+
+static QString buildFlagsString(la::avdecc::entity::StreamInfoFlags const flags) noexcept
 {
 	QString str;
 
@@ -476,7 +595,17 @@ QString flagsToString(la::avdecc::entity::StreamInfoFlags const flags) noexcept
 	return str;
 }
 
-QString flagsToString(la::avdecc::entity::StreamInfoFlagsEx const flags) noexcept
+QString flagsToString(la::avdecc::entity::StreamInfoFlags const flags) noexcept
+{
+	static thread_local auto s_strings = MemoizedStrings<32>{};
+	return s_strings.get(static_cast<std::uint64_t>(flags.value()),
+		[&flags]()
+		{
+			return buildFlagsString(flags);
+		});
+}
+
+static QString buildFlagsString(la::avdecc::entity::StreamInfoFlagsEx const flags) noexcept
 {
 	QString str;
 
@@ -488,7 +617,17 @@ QString flagsToString(la::avdecc::entity::StreamInfoFlagsEx const flags) noexcep
 	return str;
 }
 
-QString flagsToString(la::avdecc::entity::MilanInfoFeaturesFlags const flags) noexcept
+QString flagsToString(la::avdecc::entity::StreamInfoFlagsEx const flags) noexcept
+{
+	static thread_local auto s_strings = MemoizedStrings<32>{};
+	return s_strings.get(static_cast<std::uint64_t>(flags.value()),
+		[&flags]()
+		{
+			return buildFlagsString(flags);
+		});
+}
+
+static QString buildFlagsString(la::avdecc::entity::MilanInfoFeaturesFlags const flags) noexcept
 {
 	QString str;
 
@@ -500,6 +639,16 @@ QString flagsToString(la::avdecc::entity::MilanInfoFeaturesFlags const flags) no
 	return str;
 }
 
+QString flagsToString(la::avdecc::entity::MilanInfoFeaturesFlags const flags) noexcept
+{
+	static thread_local auto s_strings = MemoizedStrings<32>{};
+	return s_strings.get(static_cast<std::uint64_t>(flags.value()),
+		[&flags]()
+		{
+			return buildFlagsString(flags);
+		});
+}
+
 QString probingStatusToString(la::avdecc::entity::model::ProbingStatus const status) noexcept
 {
 	switch (status)
@@ -518,7 +667,7 @@ QString probingStatusToString(la::avdecc::entity::model::ProbingStatus const sta
 	}
 }
 
-QString capabilitiesToString(la::avdecc::entity::EntityCapabilities const caps) noexcept
+static QString buildCapabilitiesString(la::avdecc::entity::EntityCapabilities const caps) noexcept
 {
 	QString str;
 
@@ -554,7 +703,17 @@ QString capabilitiesToString(la::avdecc::entity::EntityCapabilities const caps)
 	return str;
 }
 
-QString capabilitiesToString(la::avdecc::entity::TalkerCapabilities const caps) noexcept
+QString capabilitiesToString(la::avdecc::entity::EntityCapabilities const caps) noexcept
+{
+	static thread_local auto s_strings = MemoizedStrings<32>{};
+	return s_strings.get(static_cast<std::uint64_t>(caps.value()),
+		[&caps]()
+		{
+			return buildCapabilitiesString(caps);
+		});
+}
+
+static QString buildCapabilitiesString(la::avdecc::entity::TalkerCapabilities const caps) noexcept
 {
 	QString str;
 
@@ -580,7 +739,17 @@ QString capabilitiesToString(la::avdecc::entity::TalkerCapabilities const caps)
 	return str;
 }
 
-QString capabilitiesToString(la::avdecc::entity::ListenerCapabilities const caps) noexcept
+QString capabilitiesToString(la::avdecc::entity::TalkerCapabilities const caps) noexcept
+{
+	static thread_local auto s_strings = MemoizedStrings<32>{};
+	return s_strings.get(static_cast<std::uint64_t>(caps.value()),
+		[&caps]()
+		{
+			return buildCapabilitiesString(caps);
+		});
+}
+
+static QString buildCapabilitiesString(la::avdecc::entity::ListenerCapabilities const caps) noexcept
 {
 	QString str;
 
@@ -606,7 +775,17 @@ QString capabilitiesToString(la::avdecc::entity::ListenerCapabilities const caps
 	return str;
 }
 
-QString capabilitiesToString(la::avdecc::entity::ControllerCapabilities const caps) noexcept
+QString capabilitiesToString(la::avdecc::entity::ListenerCapabilities const caps) noexcept
+{
+	static thread_local auto s_strings = MemoizedStrings<32>{};
+	return s_strings.get(static_cast<std::uint64_t>(caps.value()),
+		[&caps]()
+		{
+			return buildCapabilitiesString(caps);
+		});
+}
+
+static QString buildCapabilitiesString(la::avdecc::entity::ControllerCapabilities const caps) noexcept
 {
 	QString str;
 
@@ -618,6 +797,16 @@ QString capabilitiesToString(la::avdecc::entity::ControllerCapabilities const ca
 	return str;
 }
 
+QString capabilitiesToString(la::avdecc::entity::ControllerCapabilities const caps) noexcept
+{
+	static thread_local auto s_strings = MemoizedStrings<32>{};
+	return s_strings.get(static_cast<std::uint64_t>(caps.value()),
+		[&caps]()
+		{
+			return buildCapabilitiesString(caps);
+		});
+}
+
 QString clockSourceTypeToString(la::avdecc::entity::model::ClockSourceType const type) noexcept
 {
 	switch (type)
@@ -21,8 +21,15 @@
 
 #include <la/avdecc/logger.hpp>
 #include "la/avdecc/utils.hpp"
+#include "logGate.hpp"
 #include <QString>
 
+#include <array>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <variant>
+
 namespace avdecc
 {
 namespace logger
@@ -45,6 +52,136 @@ private:
 	QString _message{};
 };
 
+/** Message formatted on demand: the arguments (IDs, indexes, enum values, ...) are captured by value in a small inline buffer, and only formatted when the message is displayed or saved */
+class DeferredMessage
+{
+public:
+	static constexpr size_t MaxArguments = 4u;
+
+	/** The format must have static storage duration (string literal), with QString::arg placeholders (%1 to %4) */
+	template<typename... Ts>
+	DeferredMessage(char const* const format, Ts&&... arguments) noexcept
+		: _format{ format }
+		, _count{ static_cast<std::uint8_t>(sizeof...(Ts)) }
+	{
+		static_assert(sizeof...(Ts) <= MaxArguments, "Too many arguments for a DeferredMessage");
+		auto index = size_t{ 0u };
+		((_arguments[index++] = makeArgument(std::forward<Ts>(arguments))), ...);
+	}
+
+	QString format() const noexcept
+	{
+		auto strings = std::array<QString, MaxArguments>{};
+		for (auto i = size_t{ 0u }; i < _count; ++i)
+		{
+			strings[i] = std::visit(
+				[](auto const& value) -> QString
+				{
+					using Type = std::decay_t<decltype(value)>;
+					if constexpr (std::is_same_v<Type, la::avdecc::UniqueIdentifier>)
+					{
+						return "0x" + QString::number(value.getValue(), 16).rightJustified(16, '0').toUpper();
+					}
+					else if constexpr (std::is_same_v<Type, QString>)
+					{
+						return value;
+					}
+					else
+					{
+						return QString::number(value);
+					}
+				},
+				_arguments[i]);
+		}
+
+		// All the placeholders are replaced in a single pass, so an argument containing a placeholder is not expanded
+		auto const format = QString{ _format };
+		switch (_count)
+		{
+			case 1:
+				return format.arg(strings[0]);
+			case 2:
+				return format.arg(strings[0], strings[1]);
+			case 3:
+				return format.arg(strings[0], strings[1], strings[2]);
+			case 4:
+				return format.arg(strings[0], strings[1], strings[2], strings[3]);
+			default:
+				return format;
+		}
+	}
+
+private:
+	using Argument = std::variant<std::int64_t, std::uint64_t, double, la::avdecc::UniqueIdentifier, QString>;
+
+	template<typename T>
+	static Argument makeArgument(T&& value) noexcept
+	{
+		using Type = std::decay_t<T>;
+		if constexpr (std::is_same_v<Type, la::avdecc::UniqueIdentifier>)
+		{
+			return value;
+		}
+		else if constexpr (std::is_same_v<Type, bool>)
+		{
+			return std::int64_t{ value ? 1 : 0 };
+		}
+		else if constexpr (std::is_enum_v<Type>)
+		{
+			return makeArgument(static_cast<std::underlying_type_t<Type>>(value));
+		}
+		else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>)
+		{
+			return static_cast<std::int64_t>(value);
+		}
+		else if constexpr (std::is_integral_v<Type>)
+		{
+			return static_cast<std::uint64_t>(value);
+		}
+		else if constexpr (std::is_floating_point_v<Type>)
+		{
+			return static_cast<double>(value);
+		}
+		else if constexpr (std::is_same_v<Type, std::string>)
+		{
+			return QString::fromStdString(value);
+		}
+		else
+		{
+			return QString{ std::forward<T>(value) };
+		}
+	}
+
+	char const* _format{ nullptr };
+	std::array<Argument, MaxArguments> _arguments{};
+	std::uint8_t _count{ 0u };
+};
+
+class LogItemHiveDeferred : public la::avdecc::logger::LogItem
+{
+public:
+	template<typename... Ts>
+	LogItemHiveDeferred(char const* const format, Ts&&... arguments)
+		: LogItem(la::avdecc::logger::Layer::FirstUserLayer)
+		, _message{ format, std::forward<Ts>(arguments)... }
+	{
+	}
+
+	virtual std::string getMessage() const noexcept override
+	{
+		return _message.format().toStdString();
+	}
+
+	// Observers able to keep the arguments instead of the message (avdecc::LoggerModel) get them from here, and format later
+	DeferredMessage const& getDeferredMessage() const noexcept
+	{
+		return _message;
+	}
+
+private:
+	DeferredMessage _message;
+};
+
 /** Template to remove at compile time some of the most time-consuming log messages (Trace and Debug) - Forward arguments to the Logger */
 template<la::avdecc::logger::Level LevelValue, class LogItemType, typename... Ts>
 constexpr void log(Ts&&... params)
@@ -57,16 +194,27 @@ constexpr void log(Ts&&... params)
 	else
 #endif // !DEBUG
 	{
-		auto const item = LogItemType{ std::forward<Ts>(params)... };
-		la::avdecc::logger::Logger::getInstance().logItem(LevelValue, &item);
+		// Then at runtime, before the item is built
+		if (LogGate::getInstance().isEnabled(LevelValue, la::avdecc::logger::Layer::FirstUserLayer))
+		{
+			auto const item = LogItemType{ std::forward<Ts>(params)... };
+			la::avdecc::logger::Logger::getInstance().logItem(LevelValue, &item);
+		}
 	}
 }
 
 } // namespace logger
 } // namespace avdecc
 
-/** Preprocessor defines to remove at compile time some of the most time-consuming log messages (Trace and Debug) - Creation of the arguments */
-#define LOG_HIVE(LogLevel, Message) avdecc::logger::log<la::avdecc::logger::Level::LogLevel, avdecc::logger::LogItemHive>(Message)
+/** Preprocessor defines to remove at compile time some of the most time-consuming log messages (Trace and Debug) - Creation of the arguments, only evaluated if the runtime gate lets the message through */
+#define LOG_HIVE(LogLevel, Message) \
+	do \
+	{ \
+		if (avdecc::logger::LogGate::getInstance().isEnabled(la::avdecc::logger::Level::LogLevel, la::avdecc::logger::Layer::FirstUserLayer)) \
+		{ \
+			avdecc::logger::log<la::avdecc::logger::Level::LogLevel, avdecc::logger::LogItemHive>(Message); \
+		} \
+	} while (false)
 #ifdef DEBUG
 #	define LOG_HIVE_TRACE(Message) LOG_HIVE(Trace, Message)
 #	define LOG_HIVE_DEBUG(Message) LOG_HIVE(Debug, Message)
@@ -77,3 +225,13 @@ constexpr void log(Ts&&... params)
 #define LOG_HIVE_INFO(Message) LOG_HIVE(Info, Message)
 #define LOG_HIVE_WARN(Message) LOG_HIVE(Warn, Message)
 #define LOG_HIVE_ERROR(Message) LOG_HIVE(Error, Message)
+
+/** Same with a deferred formatting (see DeferredMessage): the cheap arguments are captured, the message is only formatted when displayed or saved */
+#define LOG_HIVE_FORMAT(LogLevel, Format, ...) \
+	do \
+	{ \
+		if (avdecc::logger::LogGate::getInstance().isEnabled(la::avdecc::logger::Level::LogLevel, la::avdecc::logger::Layer::FirstUserLayer)) \
+		{ \
+			avdecc::logger::log<la::avdecc::logger::Level::LogLevel, avdecc::logger::LogItemHiveDeferred>(Format, __VA_ARGS__); \
+		} \
+	} while (false)
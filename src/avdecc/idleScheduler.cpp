@@ -0,0 +1,241 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "idleScheduler.hpp"
+#include "controllerManager.hpp"
+
+#include <QCoreApplication>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <algorithm>
+#include <list>
+#include <optional>
+#include <utility>
+
+namespace avdecc
+{
+/** Runs a function on the worker thread, at the lowest priority */
+class IdleWorkTask final : public QRunnable
+{
+public:
+	IdleWorkTask(std::function<void()>&& work) noexcept
+		: _work{ std::move(work) }
+	{
+	}
+
+	virtual void run() override
+	{
+		QThread::currentThread()->setPriority(QThread::LowestPriority);
+		_work();
+	}
+
+private:
+	std::function<void()> _work{};
+};
+
+class IdleSchedulerImpl final : public IdleScheduler
+{
+public:
+	IdleSchedulerImpl() noexcept
+	{
+		_sliceTimer.setSingleShot(true);
+		_sliceTimer.setInterval(0);
+		connect(&_sliceTimer, &QTimer::timeout, this, &IdleSchedulerImpl::runSlice);
+
+		_worker.setMaxThreadCount(1);
+	}
+
+	~IdleSchedulerImpl() noexcept
+	{
+		_worker.clear();
+		_worker.waitForDone();
+	}
+
+	// Deleted compiler auto-generated methods
+	IdleSchedulerImpl(IdleSchedulerImpl const&) = delete;
+	IdleSchedulerImpl(IdleSchedulerImpl&&) = delete;
+	IdleSchedulerImpl& operator=(IdleSchedulerImpl const&) = delete;
+	IdleSchedulerImpl& operator=(IdleSchedulerImpl&&) = delete;
+
+private:
+	struct StepJob
+	{
+		JobID jobID{ 0u };
+		QString name{};
+		Step step{};
+	};
+
+	struct WorkJob
+	{
+		JobID jobID{ 0u };
+		QString name{};
+		Work work{};
+		CompletionHandler completionHandler{};
+	};
+
+	// IdleScheduler overrides
+	virtual JobID scheduleStep(QString const& name, Step&& step) noexcept override
+	{
+		ASSERT_QT_MAIN_THREAD;
+
+		if (auto const it = findJob(_stepJobs, name); it != _stepJobs.end())
+		{
+			return it->jobID;
+		}
+
+		auto const jobID = ++_lastJobID;
+		_stepJobs.push_back(StepJob{ jobID, name, std::move(step) });
+		if (!_sliceTimer.isActive())
+		{
+			_sliceTimer.start();
+		}
+		return jobID;
+	}
+
+	virtual JobID scheduleWork(QString const& name, Work&& work, CompletionHandler&& completionHandler) noexcept override
+	{
+		ASSERT_QT_MAIN_THREAD;
+
+		if (auto const it = findJob(_workJobs, name); it != _workJobs.end())
+		{
+			return it->jobID;
+		}
+
+		auto const jobID = ++_lastJobID;
+		_workJobs.push_back(WorkJob{ jobID, name, std::move(work), std::move(completionHandler) });
+		startNextWork();
+		return jobID;
+	}
+
+	virtual void cancel(JobID const jobID) noexcept override
+	{
+		ASSERT_QT_MAIN_THREAD;
+
+		// The step being run is only removed once it returns
+		if (_runningStepJobID && *_runningStepJobID == jobID)
+		{
+			_isRunningStepCancelled = true;
+			return;
+		}
+		if (_runningWork && _runningWork->jobID == jobID)
+		{
+			_runningWork->completionHandler = {};
+			return;
+		}
+
+		auto const isJob = [jobID](auto const& job)
+		{
+			return job.jobID == jobID;
+		};
+		_stepJobs.remove_if(isJob);
+		_workJobs.remove_if(isJob);
+	}
+
+	virtual bool isPending(QString const& name) const noexcept override
+	{
+		return findJob(_stepJobs, name) != _stepJobs.end() || findJob(_workJobs, name) != _workJobs.end() || (_runningWork && _runningWork->name == name);
+	}
+
+	// Private methods
+	template<typename Jobs>
+	static auto findJob(Jobs const& jobs, QString const& name) noexcept
+	{
+		return std::find_if(jobs.begin(), jobs.end(),
+			[&name](auto const& job)
+			{
+				return job.name == name;
+			});
+	}
+
+	/** Runs the steps of the pending jobs, in order, until the slice is over */
+	void runSlice() noexcept
+	{
+		auto const sliceEnd = std::chrono::steady_clock::now() + SliceDuration;
+		while (!_stepJobs.empty() && std::chrono::steady_clock::now() < sliceEnd)
+		{
+			// Jobs scheduled by the step are appended, the running one always stays at the front
+			_runningStepJobID = _stepJobs.front().jobID;
+			_isRunningStepCancelled = false;
+			auto const isDone = _stepJobs.front().step();
+			_runningStepJobID = std::nullopt;
+
+			if (isDone || _isRunningStepCancelled)
+			{
+				_stepJobs.pop_front();
+			}
+		}
+
+		// Let the event loop process the pending events before the next slice
+		if (!_stepJobs.empty())
+		{
+			_sliceTimer.start();
+		}
+	}
+
+	void startNextWork() noexcept
+	{
+		if (_runningWork || _workJobs.empty())
+		{
+			return;
+		}
+
+		_runningWork = std::move(_workJobs.front());
+		_workJobs.pop_front();
+
+		_worker.start(new IdleWorkTask{ [this, work = _runningWork->work]()
+			{
+				work();
+				QMetaObject::invokeMethod(this, &IdleSchedulerImpl::onWorkCompleted, Qt::QueuedConnection);
+			} });
+	}
+
+	void onWorkCompleted() noexcept
+	{
+		auto const completionHandler = std::move(_runningWork->completionHandler);
+		_runningWork = std::nullopt;
+
+		if (completionHandler)
+		{
+			completionHandler();
+		}
+		startNextWork();
+	}
+
+	// Private members
+	std::list<StepJob> _stepJobs{};
+	std::list<WorkJob> _workJobs{};
+	std::optional<JobID> _runningStepJobID{ std::nullopt };
+	bool _isRunningStepCancelled{ false };
+	std::optional<WorkJob> _runningWork{ std::nullopt };
+	JobID _lastJobID{ 0u };
+	QTimer _sliceTimer{};
+	QThreadPool _worker{}; // Declared last so it is destroyed (waiting for its task) first
+};
+
+IdleScheduler& IdleScheduler::getInstance() noexcept
+{
+	static IdleSchedulerImpl s_IdleScheduler{};
+
+	return s_IdleScheduler;
+}
+
+} // namespace avdecc
@@ -0,0 +1,68 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace avdecc
+{
+/**
+* @brief Runs low priority precomputation jobs (cache warming) without competing with the user interactions.
+*		 Main thread jobs are incremental: their step is called repeatedly from a zero timer, for at most SliceDuration
+*		 per event loop iteration, so the pending events are always processed between two slices.
+*		 Worker jobs run on a single low priority thread, their completion handler being called on the main thread.
+*		 Jobs run in scheduling order, and a job scheduled again under the same name while still pending is not duplicated.
+*/
+class IdleScheduler : public QObject
+{
+	Q_OBJECT
+public:
+	using JobID = std::uint32_t;
+
+	/** Does a small part of the job (a fraction of SliceDuration) on the main thread. Returns true once the job is done */
+	using Step = std::function<bool()>;
+	/** Does the whole job on the worker thread */
+	using Work = std::function<void()>;
+	/** Called on the main thread once the Work completed */
+	using CompletionHandler = std::function<void()>;
+
+	static constexpr auto SliceDuration = std::chrono::milliseconds{ 4 };
+
+	static IdleScheduler& getInstance() noexcept;
+
+	/** Schedules an incremental job on the main thread. Must be called from the main thread */
+	virtual JobID scheduleStep(QString const& name, Step&& step) noexcept = 0;
+	/** Schedules a job on the worker thread. Must be called from the main thread */
+	virtual JobID scheduleWork(QString const& name, Work&& work, CompletionHandler&& completionHandler = {}) noexcept = 0;
+	/** Removes a pending job (a worker job already running completes, without calling its completion handler). Must be called from the main thread */
+	virtual void cancel(JobID const jobID) noexcept = 0;
+
+	virtual bool isPending(QString const& name) const noexcept = 0;
+
+protected:
+	IdleScheduler() = default;
+};
+
+} // namespace avdecc
@@ -0,0 +1,130 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+/**
+* Histogram of latencies, using log-scale (power of 2) buckets of microseconds.
+* Adding a sample is constant time and does not allocate, so it can be done on every command.
+* This file only depends on the standard library.
+*/
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace avdecc
+{
+class LatencyHistogram
+{
+public:
+	using Duration = std::chrono::microseconds;
+	static constexpr std::size_t BucketsCount = 24; // Bucket N holds latencies in [2^N, 2^(N+1)[ usec (bucket 0 also holds 0), the last bucket holds all higher values (more than 8 sec)
+
+	/** Adds a latency sample */
+	void add(Duration const& latency) noexcept
+	{
+		auto const value = static_cast<std::uint64_t>(latency.count() > 0 ? latency.count() : 0);
+		auto index = std::size_t{ 0u };
+		for (auto v = value >> 1; v != 0u && index < (BucketsCount - 1u); v >>= 1)
+		{
+			++index;
+		}
+		++_buckets[index];
+		++_count;
+		if (latency > _max)
+		{
+			_max = latency;
+		}
+	}
+
+	/** Removes all samples */
+	void clear() noexcept
+	{
+		_buckets = {};
+		_count = 0u;
+		_max = Duration::zero();
+	}
+
+	/** Number of samples */
+	std::uint64_t count() const noexcept
+	{
+		return _count;
+	}
+
+	/** Highest latency ever added */
+	Duration max() const noexcept
+	{
+		return _max;
+	}
+
+	/** Number of samples for each bucket */
+	std::array<std::uint64_t, BucketsCount> const& buckets() const noexcept
+	{
+		return _buckets;
+	}
+
+	/** Lowest latency of the bucket at index */
+	static Duration bucketLowerBound(std::size_t const index) noexcept
+	{
+		return index == 0u ? Duration::zero() : Duration{ std::int64_t{ 1 } << index };
+	}
+
+	/** Latency immediately above the bucket at index */
+	static Duration bucketUpperBound(std::size_t const index) noexcept
+	{
+		return Duration{ std::int64_t{ 1 } << (index + 1u) };
+	}
+
+	/** Estimated latency below which the given fraction (0.0 to 1.0) of samples are, linearly interpolated inside the matching bucket */
+	Duration percentile(double const fraction) const noexcept
+	{
+		if (_count == 0u)
+		{
+			return Duration::zero();
+		}
+
+		auto const rank = std::max(1.0, std::ceil(fraction * static_cast<double>(_count)));
+		auto cumulated = std::uint64_t{ 0u };
+		for (auto index = std::size_t{ 0u }; index < BucketsCount; ++index)
+		{
+			auto const bucketCount = _buckets[index];
+			if (bucketCount != 0u && static_cast<double>(cumulated + bucketCount) >= rank)
+			{
+				auto const lower = static_cast<double>(bucketLowerBound(index).count());
+				// The last bucket has no upper bound, use the highest latency instead
+				auto const upper = static_cast<double>(index == (BucketsCount - 1u) ? _max.count() : std::min(bucketUpperBound(index), _max).count());
+				auto const position = (rank - static_cast<double>(cumulated)) / static_cast<double>(bucketCount);
+				return Duration{ static_cast<Duration::rep>(lower + (std::max(upper, lower) - lower) * position) };
+			}
+			cumulated += bucketCount;
+		}
+		return _max;
+	}
+
+private:
+	std::array<std::uint64_t, BucketsCount> _buckets{};
+	std::uint64_t _count{ 0u };
+	Duration _max{ Duration::zero() };
+};
+
+} // namespace avdecc
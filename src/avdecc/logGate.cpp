@@ -0,0 +1,69 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "logGate.hpp"
+
+namespace avdecc
+{
+namespace logger
+{
+#ifndef NDEBUG
+static constexpr auto BuildLevelMask = LogGate::AllMask;
+#else
+// In release, we don't want Trace nor Debug levels
+static constexpr auto BuildLevelMask = LogGate::AllMask & ~(LogGate::levelBit(la::avdecc::logger::Level::Trace) | LogGate::levelBit(la::avdecc::logger::Level::Debug));
+#endif
+
+LogGate::LogGate() noexcept
+{
+	setLevelMask(AllMask);
+}
+
+LogGate& LogGate::getInstance() noexcept
+{
+	static LogGate s_gate{};
+
+	return s_gate;
+}
+
+void LogGate::setLevelMask(Mask const mask) noexcept
+{
+	auto const levelMask = mask & BuildLevelMask;
+	_levelMask = levelMask;
+
+	// Lowest enabled level, the messages of the disabled levels above it are dropped by the observers
+	auto& avdeccLogger = la::avdecc::logger::Logger::getInstance();
+	for (auto const level : { la::avdecc::logger::Level::Trace, la::avdecc::logger::Level::Debug, la::avdecc::logger::Level::Info, la::avdecc::logger::Level::Warn, la::avdecc::logger::Level::Error })
+	{
+		if ((levelMask & levelBit(level)) != 0u)
+		{
+			avdeccLogger.setLevel(level);
+			return;
+		}
+	}
+	avdeccLogger.setLevel(la::avdecc::logger::Level::Error);
+}
+
+void LogGate::setLayerMask(Mask const mask) noexcept
+{
+	_layerMask = mask;
+}
+
+} // namespace logger
+} // namespace avdecc
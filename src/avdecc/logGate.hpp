@@ -0,0 +1,100 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/logger.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace avdecc
+{
+namespace logger
+{
+/**
+* @brief Runtime filter of the log messages on their level and layer, checked before a message is built so the ones nobody displays are never formatted.
+*		 Lock-free, messages being logged from any thread. la_avdecc only filtering its own messages on a minimum level, the lowest enabled level is forwarded to its Logger.
+*/
+class LogGate final
+{
+public:
+	using Mask = std::uint64_t;
+	static constexpr Mask AllMask = ~Mask{ 0u };
+
+	static LogGate& getInstance() noexcept;
+
+	// Returns the bit representing the specified layer in a layer mask (all user layers share the same bit)
+	static constexpr Mask layerBit(la::avdecc::logger::Layer const layer) noexcept
+	{
+		using Underlying = std::underlying_type_t<la::avdecc::logger::Layer>;
+		auto const value = static_cast<Underlying>(layer);
+
+		if (value >= static_cast<Underlying>(la::avdecc::logger::Layer::FirstUserLayer))
+		{
+			return UserLayersBit;
+		}
+		if (value < 0 || value >= 63)
+		{
+			return 0u;
+		}
+		return Mask{ 1u } << value;
+	}
+
+	// Returns the bit representing the specified level in a level mask
+	static constexpr Mask levelBit(la::avdecc::logger::Level const level) noexcept
+	{
+		auto const value = static_cast<std::underlying_type_t<la::avdecc::logger::Level>>(level);
+
+		if (value < 0 || value >= 64)
+		{
+			return 0u;
+		}
+		return Mask{ 1u } << value;
+	}
+
+	bool isEnabled(la::avdecc::logger::Level const level, la::avdecc::logger::Layer const layer) const noexcept
+	{
+		return (_levelMask.load(std::memory_order_relaxed) & levelBit(level)) != 0u && (_layerMask.load(std::memory_order_relaxed) & layerBit(layer)) != 0u;
+	}
+
+	// Set the levels to be logged, as a combination of levelBit() (Trace and Debug are never enabled in release builds)
+	void setLevelMask(Mask const mask) noexcept;
+
+	// Set the layers to be logged, as a combination of layerBit()
+	void setLayerMask(Mask const mask) noexcept;
+
+	// Deleted compiler auto-generated methods
+	LogGate(LogGate const&) = delete;
+	LogGate(LogGate&&) = delete;
+	LogGate& operator=(LogGate const&) = delete;
+	LogGate& operator=(LogGate&&) = delete;
+
+private:
+	static constexpr Mask UserLayersBit = Mask{ 1u } << 63;
+
+	LogGate() noexcept;
+
+	std::atomic<Mask> _levelMask{ AllMask };
+	std::atomic<Mask> _layerMask{ AllMask };
+};
+
+} // namespace logger
+} // namespace avdecc
@@ -0,0 +1,242 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+/**
+* Binary log journal, a fixed-size circular buffer of log entries meant to be memory-mapped.
+* This file only depends on the standard library, so it can be shared with the tools.
+*
+* Layout (all values little-endian):
+*  - Header (HeaderSize bytes): Magic (8 bytes), Version (u32), HeaderSize (u32), DataSize (u64), Head offset (u64), Tail offset (u64), Records count (u64)
+*  - Data (DataSize bytes): records, from Tail (oldest) to Head (next write position), wrapping at the end of the data area
+*
+* Record: RecordSize (u32, whole record), Timestamp (i64, ms since epoch), Layer (u32), Level (u32), MessageLength (u32), Message (UTF-8, not NULL terminated).
+* A RecordSize of 0 (or less than 4 remaining bytes) marks the end of the usable data area, the next record starting at offset 0.
+*/
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+
+namespace avdecc
+{
+namespace logJournal
+{
+static constexpr std::array<char, 8> Magic = { 'H', 'I', 'V', 'E', 'L', 'O', 'G', 'J' };
+static constexpr std::uint32_t Version = 1u;
+static constexpr std::size_t HeaderSize = 64u;
+static constexpr std::size_t RecordHeaderSize = 4u + 8u + 4u + 4u + 4u;
+static constexpr std::size_t DefaultDataSize = 8u * 1024u * 1024u;
+
+// Header fields offsets
+static constexpr std::size_t VersionOffset = 8u;
+static constexpr std::size_t HeaderSizeOffset = 12u;
+static constexpr std::size_t DataSizeOffset = 16u;
+static constexpr std::size_t HeadOffset = 24u;
+static constexpr std::size_t TailOffset = 32u;
+static constexpr std::size_t CountOffset = 40u;
+
+struct Entry
+{
+	std::int64_t timestamp{ 0 }; // Milliseconds since epoch
+	std::uint32_t layer{ 0u }; // Raw la::avdecc::logger::Layer
+	std::uint32_t level{ 0u }; // Raw la::avdecc::logger::Level
+	std::string message{}; // UTF-8
+};
+
+namespace details
+{
+template<typename T>
+inline void writeValue(std::uint8_t* const ptr, T const value) noexcept
+{
+	for (auto i = 0u; i < sizeof(T); ++i)
+	{
+		ptr[i] = static_cast<std::uint8_t>((static_cast<std::uint64_t>(value) >> (8u * i)) & 0xFFu);
+	}
+}
+
+template<typename T>
+inline T readValue(std::uint8_t const* const ptr) noexcept
+{
+	auto value = std::uint64_t{ 0u };
+	for (auto i = 0u; i < sizeof(T); ++i)
+	{
+		value |= static_cast<std::uint64_t>(ptr[i]) << (8u * i);
+	}
+	return static_cast<T>(value);
+}
+
+/** Returns the offset of the record starting at (or wrapping from) the specified offset */
+inline std::size_t recordOffset(std::uint8_t const* const data, std::size_t const dataSize, std::size_t const offset) noexcept
+{
+	if (dataSize - offset < 4u || readValue<std::uint32_t>(data + offset) == 0u)
+	{
+		return 0u;
+	}
+	return offset;
+}
+
+} // namespace details
+
+/** Returns true if the memory holds a valid journal header */
+inline bool isValid(std::uint8_t const* const journal, std::size_t const journalSize) noexcept
+{
+	if (journalSize < HeaderSize || std::memcmp(journal, Magic.data(), Magic.size()) != 0)
+	{
+		return false;
+	}
+	auto const dataSize = details::readValue<std::uint64_t>(journal + DataSizeOffset);
+	return details::readValue<std::uint32_t>(journal + VersionOffset) == Version && details::readValue<std::uint32_t>(journal + HeaderSizeOffset) == HeaderSize && dataSize <= journalSize - HeaderSize && details::readValue<std::uint64_t>(journal + HeadOffset) < dataSize && details::readValue<std::uint64_t>(journal + TailOffset) < dataSize;
+}
+
+/** Initializes an empty journal over the whole specified memory */
+inline void initialize(std::uint8_t* const journal, std::size_t const journalSize) noexcept
+{
+	std::memset(journal, 0, HeaderSize);
+	std::memcpy(journal, Magic.data(), Magic.size());
+	details::writeValue(journal + VersionOffset, Version);
+	details::writeValue(journal + HeaderSizeOffset, static_cast<std::uint32_t>(HeaderSize));
+	details::writeValue(journal + DataSizeOffset, static_cast<std::uint64_t>(journalSize - HeaderSize));
+}
+
+/** Appends an entry to an initialized journal, evicting the oldest records if required. The message is truncated if it cannot fit in a quarter of the data area. */
+inline void append(std::uint8_t* const journal, std::int64_t const timestamp, std::uint32_t const layer, std::uint32_t const level, std::string const& message) noexcept
+{
+	auto* const data = journal + HeaderSize;
+	auto const dataSize = static_cast<std::size_t>(details::readValue<std::uint64_t>(journal + DataSizeOffset));
+	auto head = static_cast<std::size_t>(details::readValue<std::uint64_t>(journal + HeadOffset));
+	auto tail = static_cast<std::size_t>(details::readValue<std::uint64_t>(journal + TailOffset));
+	auto count = details::readValue<std::uint64_t>(journal + CountOffset);
+
+	auto const messageLength = std::min(message.size(), dataSize / 4u - RecordHeaderSize);
+	auto const recordSize = RecordHeaderSize + messageLength;
+
+	if (count == 0u)
+	{
+		head = 0u;
+		tail = 0u;
+	}
+
+	// Evict the oldest records until there is enough room (bytes skipped at the end of the data area included)
+	auto const requiredSize = [&]()
+	{
+		return (head + recordSize > dataSize ? dataSize - head : 0u) + recordSize;
+	};
+	auto const freeSize = [&]() -> std::size_t
+	{
+		if (count == 0u)
+		{
+			return dataSize;
+		}
+		return (tail + dataSize - head) % dataSize;
+	};
+	while (count != 0u && freeSize() < requiredSize())
+	{
+		tail = details::recordOffset(data, dataSize, tail);
+		tail += details::readValue<std::uint32_t>(data + tail);
+		if (tail == dataSize)
+		{
+			tail = 0u;
+		}
+		--count;
+		if (count == 0u)
+		{
+			head = 0u;
+			tail = 0u;
+		}
+	}
+
+	// The tail is updated first, so the journal is always consistent (at worst, the record being written is lost)
+	details::writeValue(journal + TailOffset, static_cast<std::uint64_t>(tail));
+	details::writeValue(journal + CountOffset, count);
+
+	// Not enough room before the end of the data area, mark it and wrap
+	if (head + recordSize > dataSize)
+	{
+		if (dataSize - head >= 4u)
+		{
+			details::writeValue(data + head, std::uint32_t{ 0u });
+		}
+		head = 0u;
+	}
+
+	auto* const record = data + head;
+	details::writeValue(record, static_cast<std::uint32_t>(recordSize));
+	details::writeValue(record + 4u, timestamp);
+	details::writeValue(record + 12u, layer);
+	details::writeValue(record + 16u, level);
+	details::writeValue(record + 20u, static_cast<std::uint32_t>(messageLength));
+	std::memcpy(record + RecordHeaderSize, message.data(), messageLength);
+
+	head += recordSize;
+	if (head == dataSize)
+	{
+		head = 0u;
+	}
+	details::writeValue(journal + HeadOffset, static_cast<std::uint64_t>(head));
+	details::writeValue(journal + CountOffset, count + 1u);
+}
+
+/** Calls the visitor for each entry of a valid journal, from the oldest to the most recent one. Returns false if the journal is corrupted. */
+inline bool read(std::uint8_t const* const journal, std::size_t const journalSize, std::function<void(Entry const&)> const& visitor) noexcept
+{
+	if (!isValid(journal, journalSize))
+	{
+		return false;
+	}
+
+	auto const* const data = journal + HeaderSize;
+	auto const dataSize = static_cast<std::size_t>(details::readValue<std::uint64_t>(journal + DataSizeOffset));
+	auto offset = static_cast<std::size_t>(details::readValue<std::uint64_t>(journal + TailOffset));
+	auto const count = details::readValue<std::uint64_t>(journal + CountOffset);
+
+	for (auto i = std::uint64_t{ 0u }; i < count; ++i)
+	{
+		offset = details::recordOffset(data, dataSize, offset);
+		auto const* const record = data + offset;
+		auto const recordSize = static_cast<std::size_t>(details::readValue<std::uint32_t>(record));
+		auto const messageLength = static_cast<std::size_t>(details::readValue<std::uint32_t>(record + 20u));
+		if (recordSize < RecordHeaderSize || recordSize > dataSize - offset || messageLength != recordSize - RecordHeaderSize)
+		{
+			return false;
+		}
+
+		auto entry = Entry{};
+		entry.timestamp = details::readValue<std::int64_t>(record + 4u);
+		entry.layer = details::readValue<std::uint32_t>(record + 12u);
+		entry.level = details::readValue<std::uint32_t>(record + 16u);
+		entry.message.assign(reinterpret_cast<char const*>(record + RecordHeaderSize), messageLength);
+		visitor(entry);
+
+		offset += recordSize;
+		if (offset == dataSize)
+		{
+			offset = 0u;
+		}
+	}
+
+	return true;
+}
+
+} // namespace logJournal
+} // namespace avdecc
@@ -0,0 +1,145 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "logSearchIndex.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace avdecc
+{
+namespace
+{
+/** Compaction only happens when there are more stale postings than live ones (and enough of them to be worth it) */
+static constexpr std::size_t MinimumStalePostingsForCompaction = 64u * 1024u;
+
+/** Distinct sorted trigrams of an already case folded text */
+std::vector<std::uint64_t> makeTrigrams(QString const& folded) noexcept
+{
+	auto trigrams = std::vector<std::uint64_t>{};
+	if (folded.size() < LogSearchIndex::MinimumTextLength)
+	{
+		return trigrams;
+	}
+
+	trigrams.reserve(folded.size() - 2);
+	for (auto i = 0; i + 2 < folded.size(); ++i)
+	{
+		trigrams.push_back((static_cast<std::uint64_t>(folded[i].unicode()) << 32) | (static_cast<std::uint64_t>(folded[i + 1].unicode()) << 16) | static_cast<std::uint64_t>(folded[i + 2].unicode()));
+	}
+	std::sort(trigrams.begin(), trigrams.end());
+	trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+	return trigrams;
+}
+} // namespace
+
+void LogSearchIndex::add(Sequence const sequence, QString const& message) noexcept
+{
+	auto const trigrams = makeTrigrams(message.toCaseFolded());
+	for (auto const trigram : trigrams)
+	{
+		_postings[trigram].push_back(sequence);
+	}
+	_entries.emplace_back(sequence, static_cast<std::uint32_t>(trigrams.size()));
+	_livePostingsCount += trigrams.size();
+	_totalPostingsCount += trigrams.size();
+}
+
+void LogSearchIndex::removeBefore(Sequence const sequence) noexcept
+{
+	_firstSequence = std::max(_firstSequence, sequence);
+	while (!_entries.empty() && _entries.front().first < _firstSequence)
+	{
+		_livePostingsCount -= _entries.front().second;
+		_entries.pop_front();
+	}
+
+	auto const staleCount = _totalPostingsCount - _livePostingsCount;
+	if (staleCount >= MinimumStalePostingsForCompaction && staleCount > _livePostingsCount)
+	{
+		compact();
+	}
+}
+
+void LogSearchIndex::clear() noexcept
+{
+	_postings.clear();
+	_entries.clear();
+	_livePostingsCount = 0u;
+	_totalPostingsCount = 0u;
+}
+
+std::optional<std::vector<LogSearchIndex::Sequence>> LogSearchIndex::findCandidates(QString const& text) const noexcept
+{
+	auto const trigrams = makeTrigrams(text.toCaseFolded());
+	if (trigrams.empty())
+	{
+		return std::nullopt;
+	}
+
+	// Live part of the postings of each trigram, intersected starting with the shortest one
+	auto ranges = std::vector<std::pair<Postings::const_iterator, Postings::const_iterator>>{};
+	ranges.reserve(trigrams.size());
+	for (auto const trigram : trigrams)
+	{
+		auto const it = _postings.find(trigram);
+		if (it == _postings.end())
+		{
+			return std::vector<Sequence>{};
+		}
+		auto const& postings = it->second;
+		ranges.emplace_back(std::lower_bound(postings.begin(), postings.end(), _firstSequence), postings.end());
+	}
+	std::sort(ranges.begin(), ranges.end(),
+		[](auto const& lhs, auto const& rhs)
+		{
+			return std::distance(lhs.first, lhs.second) < std::distance(rhs.first, rhs.second);
+		});
+
+	auto candidates = std::vector<Sequence>{ ranges.front().first, ranges.front().second };
+	for (auto i = size_t{ 1u }; i < ranges.size() && !candidates.empty(); ++i)
+	{
+		auto intersection = std::vector<Sequence>{};
+		intersection.reserve(candidates.size());
+		std::set_intersection(candidates.begin(), candidates.end(), ranges[i].first, ranges[i].second, std::back_inserter(intersection));
+		candidates = std::move(intersection);
+	}
+	return candidates;
+}
+
+void LogSearchIndex::compact() noexcept
+{
+	for (auto it = _postings.begin(); it != _postings.end();)
+	{
+		auto& postings = it->second;
+		postings.erase(postings.begin(), std::lower_bound(postings.begin(), postings.end(), _firstSequence));
+		if (postings.empty())
+		{
+			it = _postings.erase(it);
+		}
+		else
+		{
+			postings.shrink_to_fit();
+			++it;
+		}
+	}
+	_totalPostingsCount = _livePostingsCount;
+}
+
+} // namespace avdecc
@@ -0,0 +1,75 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QString>
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace avdecc
+{
+/**
+* @brief Case insensitive trigram index over the log messages, identified by their (increasing) sequence number.
+*		 Entries are added as they are inserted in the log and forgotten as the oldest ones are evicted, stale postings being compacted in bulk.
+*		 A lookup returns the entries containing all the trigrams of the searched text, which still have to be checked (the trigrams may not be contiguous).
+*/
+class LogSearchIndex final
+{
+public:
+	using Sequence = std::uint64_t;
+
+	static constexpr int MinimumTextLength = 3; // Shorter texts have no trigram, they cannot be looked up
+
+	/** Indexes the message of an entry, sequences must be increasing */
+	void add(Sequence const sequence, QString const& message) noexcept;
+
+	/** Forgets all the entries before the specified sequence */
+	void removeBefore(Sequence const sequence) noexcept;
+
+	void clear() noexcept;
+
+	/** Returns the sorted sequences of the entries which may contain the text, std::nullopt if the text is shorter than MinimumTextLength */
+	std::optional<std::vector<Sequence>> findCandidates(QString const& text) const noexcept;
+
+	/** Returns the count of postings currently stored, including the stale ones not compacted yet */
+	std::size_t postingsCount() const noexcept
+	{
+		return _totalPostingsCount;
+	}
+
+private:
+	using Trigram = std::uint64_t;
+	using Postings = std::vector<Sequence>; // Sorted, as sequences are increasing
+
+	void compact() noexcept;
+
+	std::unordered_map<Trigram, Postings> _postings{};
+	std::deque<std::pair<Sequence, std::uint32_t>> _entries{}; // Indexed entries (sequence, count of distinct trigrams), oldest first
+	Sequence _firstSequence{ 0u }; // Postings before this sequence are stale
+	std::size_t _livePostingsCount{ 0u };
+	std::size_t _totalPostingsCount{ 0u };
+};
+
+} // namespace avdecc
@@ -18,20 +18,97 @@
 */
 
 #include "loggerModel.hpp"
+#include "logJournal.hpp"
+#include "logGate.hpp"
+#include "hiveLogItems.hpp"
+#include "logSearchIndex.hpp"
 #include "helper.hpp"
+#include "spanTrace.hpp"
+#include "memoryAccounting.hpp"
+#include "frameScheduler.hpp"
 
 #include <la/avdecc/internals/logItems.hpp>
 #include <la/avdecc/controller/internals/logItems.hpp>
 
 #include <unordered_map>
-#include <QTime>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <QDateTime>
 #include <QFile>
-#include <QTextStream>
+#include <QByteArray>
+#include <QDir>
+#include <QStandardPaths>
 
-Q_DECLARE_METATYPE(la::avdecc::logger::Layer)
-Q_DECLARE_METATYPE(la::avdecc::logger::Level)
 Q_DECLARE_METATYPE(std::string)
 
+static constexpr auto LogFlushPeriod = std::chrono::milliseconds{ 100 }; // Minimum period between two insertions of the log entries in the model
+static constexpr auto JournalFileName = "log.journal"; // Journal of the running session
+static constexpr auto PreviousJournalFileName = "log.previous.journal"; // Journal of the previous session, kept so it can be inspected after a crash
+static constexpr auto SaveChunkSize = 1024 * 1024; // Size of the chunks written (and compressed) at once when saving the log
+static constexpr auto SaveChunkEntries = size_t{ 16384u }; // Count of entries formatted (and compressed) at once by a save worker
+
+static std::uint32_t computeCrc32(QByteArray const& data) noexcept
+{
+	static auto const s_table = []()
+	{
+		auto table = std::array<std::uint32_t, 256>{};
+		for (auto i = std::uint32_t{ 0u }; i < table.size(); ++i)
+		{
+			auto c = i;
+			for (auto k = 0; k < 8; ++k)
+			{
+				c = (c & 1u) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+			}
+			table[i] = c;
+		}
+		return table;
+	}();
+
+	auto crc = std::uint32_t{ 0xFFFFFFFFu };
+	for (auto const b : data)
+	{
+		crc = s_table[(crc ^ static_cast<std::uint8_t>(b)) & 0xFFu] ^ (crc >> 8);
+	}
+	return crc ^ 0xFFFFFFFFu;
+}
+
+static void appendLittleEndian32(QByteArray& buffer, std::uint32_t const value) noexcept
+{
+	for (auto shift = 0; shift < 32; shift += 8)
+	{
+		buffer.append(static_cast<char>((value >> shift) & 0xFFu));
+	}
+}
+
+/** Returns a complete gzip member for the specified data (a gzip file being a concatenation of members, each chunk is compressed independently) */
+static QByteArray makeGzipMember(QByteArray const& data) noexcept
+{
+	// qCompress outputs a 4 bytes uncompressed size followed by a zlib stream (2 bytes header, raw deflate data, 4 bytes adler32)
+	auto const compressed = qCompress(data);
+	static constexpr auto QCompressHeaderSize = 4 + 2;
+	static constexpr auto ZlibTrailerSize = 4;
+	static constexpr char GzipHeader[] = { '\x1f', '\x8b', '\x08', '\x00', '\x00', '\x00', '\x00', '\x00', '\x00', '\xff' }; // ID1 ID2 CM(deflate) FLG MTIME(4) XFL OS(unknown)
+
+	auto member = QByteArray{};
+	member.reserve(static_cast<int>(sizeof(GzipHeader)) + compressed.size());
+	member.append(GzipHeader, static_cast<int>(sizeof(GzipHeader)));
+	member.append(compressed.constData() + QCompressHeaderSize, compressed.size() - QCompressHeaderSize - ZlibTrailerSize);
+	appendLittleEndian32(member, computeCrc32(data));
+	appendLittleEndian32(member, static_cast<std::uint32_t>(data.size()));
+	return member;
+}
+
 enum LoggerModelColumn
 {
 	Timestamp,
@@ -51,12 +128,54 @@ public:
 	LoggerModelPrivate(LoggerModel* model)
 		: q_ptr(model)
 	{
+		// Pending log entries are inserted on a frame, at a bounded rate
+		_frameClientID = FrameScheduler::getInstance().registerClient(FrameScheduler::Order::Logger,
+			[this](FrameScheduler::Clock::time_point const /*deadline*/)
+			{
+				// While inactive the entries stay pending, they are flushed at once when activated again
+				if (_isActive)
+				{
+					flushPendingEntries();
+				}
+				return true;
+			},
+			LogFlushPeriod);
+
+		openJournal();
+
 		la::avdecc::logger::Logger::getInstance().registerObserver(this);
+
+		_memoryProbe = MemoryAccounting::getInstance().registerProbe("LoggerModel",
+			[this](MemoryAccounting::Counters& counters)
+			{
+				auto pendingEntries = std::uint64_t{ 0u };
+				{
+					auto const lg = std::lock_guard{ _pendingEntriesLock };
+					pendingEntries = _pendingEntries.size();
+				}
+				counters.push_back({ "Entries", _entries.size() });
+				counters.push_back({ "PendingEntries", pendingEntries });
+				counters.push_back({ "SearchIndexPostings", _searchIndex.postingsCount() });
+			});
 	}
 
 	~LoggerModelPrivate()
 	{
+		FrameScheduler::getInstance().unregisterClient(_frameClientID);
+		MemoryAccounting::getInstance().unregisterProbe(_memoryProbe);
 		la::avdecc::logger::Logger::getInstance().unregisterObserver(this);
+
+		if (_journal)
+		{
+			_journalFile.unmap(_journal);
+		}
+
+		// Abort any save in progress
+		_abortSave = true;
+		if (_saveThread.joinable())
+		{
+			_saveThread.join();
+		}
 	}
 
 	int rowCount() const
@@ -73,22 +192,34 @@ public:
 	{
 		if (role == Qt::DisplayRole)
 		{
-			auto const& entry = _entries.at(index.row());
+			auto const& entry = _entries.at(static_cast<size_t>(index.row()));
 
 			switch (index.column())
 			{
 				case LoggerModelColumn::Timestamp:
-					return entry.timestamp;
+					return formatTimestamp(entry.timestamp);
 				case LoggerModelColumn::Layer:
 					return avdecc::helper::loggerLayerToString(entry.layer);
 				case LoggerModelColumn::Level:
 					return avdecc::helper::loggerLevelToString(entry.level);
 				case LoggerModelColumn::Message:
-					return entry.message;
+					return entry.getMessage();
 				default:
 					break;
 			}
 		}
+		else if (role == LoggerModel::LayerRole)
+		{
+			return QVariant::fromValue(_entries.at(static_cast<size_t>(index.row())).layer);
+		}
+		else if (role == LoggerModel::LevelRole)
+		{
+			return QVariant::fromValue(_entries.at(static_cast<size_t>(index.row())).level);
+		}
+		else if (role == LoggerModel::SequenceRole)
+		{
+			return static_cast<qulonglong>(_firstSequence + static_cast<quint64>(index.row()));
+		}
 
 		return {};
 	}
@@ -127,58 +258,194 @@ public:
 	{
 		Q_Q(LoggerModel);
 		q->beginResetModel();
+		{
+			// Also drop the entries not flushed yet, they were logged before the clear request
+			auto const lg = std::lock_guard{ _pendingEntriesLock };
+			_pendingEntries.clear();
+		}
+		_firstSequence += _entries.size();
 		_entries.clear();
+		_searchIndex.clear();
 		q->endResetModel();
 	}
 
-	void save(QString const& filename, LoggerModel::SaveConfiguration const& saveConfiguration) const
+	void setMaximumEntries(int const maximumEntries)
 	{
-		QFile file(filename);
-		file.open(QIODevice::WriteOnly);
-		QTextStream stream(&file);
+		auto const capacity = static_cast<size_t>(std::max(1, maximumEntries));
+		if (_entries.size() > capacity)
+		{
+			evictEntries(_entries.size() - capacity);
+		}
+		_entries.setCapacity(capacity);
+		_pendingCapacity = capacity;
+	}
 
-		for (auto const& entry : _entries)
+	int maximumEntries() const
+	{
+		return static_cast<int>(_entries.capacity());
+	}
+
+	void setActive(bool const isActive)
+	{
+		if (_isActive == isActive)
 		{
-			if (!entry.message.contains(saveConfiguration.search))
-			{
-				continue;
-			}
+			return;
+		}
+		_isActive = isActive;
+		if (_isActive)
+		{
+			flushPendingEntries();
+		}
+	}
 
-			auto const level = avdecc::helper::loggerLevelToString(entry.level);
-			if (!level.contains(saveConfiguration.level))
-			{
-				continue;
-			}
+	bool findSearchCandidates(QString const& text, LoggerModel::SearchCandidates& candidates)
+	{
+		if (text.size() < LogSearchIndex::MinimumTextLength)
+		{
+			return false;
+		}
 
-			auto const layer = avdecc::helper::loggerLayerToString(entry.layer);
-			if (!layer.contains(saveConfiguration.layer))
+		// First search, index the current entries (then kept up to date as entries are inserted and evicted)
+		if (!_isSearchIndexed)
+		{
+			for (auto row = size_t{ 0u }; row < _entries.size(); ++row)
 			{
-				continue;
+				_searchIndex.add(_firstSequence + row, _entries.at(row).getMessage());
 			}
+			_isSearchIndexed = true;
+		}
 
-			QStringList elements;
+		auto sequences = _searchIndex.findCandidates(text);
+		if (!sequences)
+		{
+			return false;
+		}
+		candidates.sequences = std::move(*sequences);
+		candidates.endSequence = _firstSequence + _entries.size();
+		return true;
+	}
 
-			elements << entry.timestamp;
-			elements << layer;
-			elements << level;
-			elements << entry.message;
+	bool save(QString const& filename, LoggerModel::SaveConfiguration const& saveConfiguration)
+	{
+		if (_isSaving)
+		{
+			return false;
+		}
+
+		// The saved entries must include the ones still pending (always the case while inactive)
+		flushPendingEntries();
 
-			stream << elements.join("\t") << "\n";
+		// The previous save thread is over (its completion has been processed), release it
+		if (_saveThread.joinable())
+		{
+			_saveThread.join();
 		}
+
+		// The worker uses an immutable snapshot, the ring buffer keeps being updated while saving
+		auto snapshot = std::vector<LogInfo>{};
+		snapshot.reserve(_entries.size());
+		for (auto row = size_t{ 0u }; row < _entries.size(); ++row)
+		{
+			snapshot.push_back(_entries.at(row));
+		}
+
+		_isSaving = true;
+		_abortSave = false;
+		_saveThread = std::thread{
+			[this, filename, saveConfiguration, snapshot = std::move(snapshot)]()
+			{
+				auto lastPercent = -1;
+				auto const result = writeEntries(filename, saveConfiguration, snapshot, _abortSave,
+					[this, &lastPercent](int const percent)
+					{
+						if (percent != lastPercent)
+						{
+							lastPercent = percent;
+							QMetaObject::invokeMethod(this,
+								[this, percent]()
+								{
+									Q_Q(LoggerModel);
+									emit q->saveProgress(percent);
+								});
+						}
+					});
+
+				QMetaObject::invokeMethod(this,
+					[this, filename, result]()
+					{
+						Q_Q(LoggerModel);
+						_isSaving = false;
+						emit q->saveCompleted(filename, result);
+					});
+			}
+		};
+
+		return true;
+	}
+
+	void cancelSave()
+	{
+		_abortSave = true;
 	}
 
 	virtual void onLogItem(la::avdecc::logger::Level const level, la::avdecc::logger::LogItem const* const item) noexcept override
 	{
-		QMetaObject::invokeMethod(this,
-			[this, layer = item->getLayer(), level, message = item->getMessage()]()
+		HIVE_TRACE_SPAN("LoggerModel::onLogItem");
+		// la_avdecc messages are only filtered on a minimum level, the gate is checked before the message is formatted
+		if (!logger::LogGate::getInstance().isEnabled(level, item->getLayer()))
+		{
+			return;
+		}
+
+		// Called from any thread: the entry (and its timestamp) is built right away, then queued until the next flush
+		auto info = LogInfo{ QDateTime::currentMSecsSinceEpoch(), item->getLayer(), level };
+		if (auto const* const deferredItem = dynamic_cast<logger::LogItemHiveDeferred const*>(item))
+		{
+			// Only keep the arguments, the message is formatted when displayed or saved
+			info.deferredMessage = deferredItem->getDeferredMessage();
+		}
+		else
+		{
+			info.message = item->getMessage();
+		}
+
+		auto isFirstPendingEntry = false;
+		{
+			auto const lg = std::lock_guard{ _pendingEntriesLock };
+
+			// Mirror the entry in the journal right away, so it survives a crash (deferred Trace and Debug entries are not worth formatting for it)
+			if (_journal)
 			{
-				Q_Q(LoggerModel);
-				auto const count = q->rowCount();
-				q->beginInsertRows({}, count, count);
-				auto const timestamp = QString("%1 - %2").arg(QDate::currentDate().toString(Qt::ISODate), QTime::currentTime().toString(Qt::ISODate));
-				_entries.push_back({ timestamp, layer, level, QString::fromStdString(message) });
-				q->endInsertRows();
-			});
+				if (!info.deferredMessage)
+				{
+					logJournal::append(_journal, info.timestamp, static_cast<std::uint32_t>(info.layer), static_cast<std::uint32_t>(info.level), info.message);
+				}
+				else if (info.level >= la::avdecc::logger::Level::Info)
+				{
+					logJournal::append(_journal, info.timestamp, static_cast<std::uint32_t>(info.layer), static_cast<std::uint32_t>(info.level), info.deferredMessage->format().toStdString());
+				}
+			}
+
+			isFirstPendingEntry = _pendingEntries.empty();
+			_pendingEntries.push_back(std::move(info));
+
+			// Bound the entries kept pending while inactive, dropping the oldest ones in bulk (the flush only keeps the most recent ones anyway)
+			auto const capacity = _pendingCapacity.load();
+			if (_pendingEntries.size() >= 2 * capacity)
+			{
+				_pendingEntries.erase(_pendingEntries.begin(), _pendingEntries.begin() + capacity);
+			}
+		}
+
+		if (isFirstPendingEntry)
+		{
+			// The flush has to be requested from the Qt Main Thread
+			QMetaObject::invokeMethod(this,
+				[this]()
+				{
+					FrameScheduler::getInstance().requestFlush(_frameClientID);
+				});
+		}
 	}
 
 private:
@@ -187,15 +454,382 @@ private:
 
 	la::avdecc::logger::Logger* _logger{ nullptr };
 
+	// Entries are kept compact, the strings displayed by the view are only built in data()
 	struct LogInfo
 	{
-		QString timestamp{};
+		qint64 timestamp{ 0 }; // Milliseconds since epoch
 		la::avdecc::logger::Layer layer{};
 		la::avdecc::logger::Level level{};
-		QString message{};
+		std::string message{}; // UTF-8, empty if deferredMessage is set
+		std::optional<logger::DeferredMessage> deferredMessage{}; // Set for LogItemHiveDeferred items, formatted on demand
+
+		QString getMessage() const noexcept
+		{
+			if (deferredMessage)
+			{
+				return deferredMessage->format();
+			}
+			return QString::fromStdString(message);
+		}
+	};
+
+	// Fixed capacity ring buffer of entries (storage only grows up to the capacity)
+	class LogInfoRingBuffer
+	{
+	public:
+		size_t size() const noexcept
+		{
+			return _count;
+		}
+
+		size_t capacity() const noexcept
+		{
+			return _capacity;
+		}
+
+		LogInfo const& at(size_t const index) const noexcept
+		{
+			return _buffer[(_first + index) % _buffer.size()];
+		}
+
+		// Must not be called when size() == capacity()
+		void push_back(LogInfo&& info) noexcept
+		{
+			if (_buffer.size() < _capacity)
+			{
+				// Still filling the storage, which is always contiguous in that case
+				_buffer.push_back(std::move(info));
+			}
+			else
+			{
+				_buffer[(_first + _count) % _buffer.size()] = std::move(info);
+			}
+			++_count;
+		}
+
+		void pop_front(size_t const count) noexcept
+		{
+			for (auto i = size_t{ 0u }; i < count; ++i)
+			{
+				// Release the message memory right away
+				auto& info = _buffer[(_first + i) % _buffer.size()];
+				std::string{}.swap(info.message);
+				info.deferredMessage.reset();
+			}
+			_first = (_first + count) % _buffer.size();
+			_count -= count;
+		}
+
+		void clear() noexcept
+		{
+			_buffer.clear();
+			_buffer.shrink_to_fit();
+			_first = 0u;
+			_count = 0u;
+		}
+
+		// Must not be called with a capacity lower than size()
+		void setCapacity(size_t const capacity) noexcept
+		{
+			auto buffer = std::vector<LogInfo>{};
+			buffer.reserve(_count);
+			for (auto i = size_t{ 0u }; i < _count; ++i)
+			{
+				buffer.push_back(std::move(_buffer[(_first + i) % _buffer.size()]));
+			}
+			_buffer = std::move(buffer);
+			_first = 0u;
+			_capacity = capacity;
+		}
+
+	private:
+		std::vector<LogInfo> _buffer{};
+		size_t _first{ 0u };
+		size_t _count{ 0u };
+		size_t _capacity{ static_cast<size_t>(LoggerModel::DefaultMaximumEntries) };
 	};
 
-	std::vector<LogInfo> _entries;
+	/** Appends the UTF-8 text as a JSON string, escaping the quotes, backslashes and control characters */
+	static void appendJsonString(QByteArray& output, QByteArray const& utf8) noexcept
+	{
+		static constexpr char HexDigits[] = "0123456789abcdef";
+
+		output.append('"');
+		for (auto const c : utf8)
+		{
+			auto const u = static_cast<unsigned char>(c);
+			if (c == '"' || c == '\\')
+			{
+				output.append('\\');
+				output.append(c);
+			}
+			else if (u < 0x20u)
+			{
+				switch (c)
+				{
+					case '\n':
+						output.append("\\n");
+						break;
+					case '\r':
+						output.append("\\r");
+						break;
+					case '\t':
+						output.append("\\t");
+						break;
+					default:
+						output.append("\\u00");
+						output.append(HexDigits[u >> 4]);
+						output.append(HexDigits[u & 0x0Fu]);
+						break;
+				}
+			}
+			else
+			{
+				output.append(c);
+			}
+		}
+		output.append('"');
+	}
+
+	/** Formats the entries matching the configuration (compressed if required). Called from the save workers, the configuration is taken by copy (the compiled filter expressions being shared). */
+	static QByteArray formatEntries(LogInfo const* const first, LogInfo const* const last, LoggerModel::SaveConfiguration const saveConfiguration) noexcept
+	{
+		auto chunk = QByteArray{};
+		chunk.reserve(SaveChunkSize);
+
+		for (auto const* entry = first; entry != last; ++entry)
+		{
+			auto const message = entry->getMessage();
+			if (!saveConfiguration.search.matches(message))
+			{
+				continue;
+			}
+
+			auto const level = avdecc::helper::loggerLevelToString(entry->level);
+			if (!saveConfiguration.level.matches(level))
+			{
+				continue;
+			}
+
+			auto const layer = avdecc::helper::loggerLayerToString(entry->layer);
+			if (!saveConfiguration.layer.matches(layer))
+			{
+				continue;
+			}
+
+			switch (saveConfiguration.format)
+			{
+				case LoggerModel::SaveFormat::Text:
+				{
+					QStringList elements;
+
+					elements << formatTimestamp(entry->timestamp);
+					elements << layer;
+					elements << level;
+					elements << message;
+
+					chunk.append(elements.join("\t").toUtf8());
+					break;
+				}
+				case LoggerModel::SaveFormat::JsonLines:
+				{
+					chunk.append("{\"timestamp\":");
+					chunk.append(QByteArray::number(entry->timestamp));
+					chunk.append(",\"time\":\"");
+					chunk.append(QDateTime::fromMSecsSinceEpoch(entry->timestamp, Qt::UTC).toString(Qt::ISODateWithMs).toLatin1());
+					chunk.append("\",\"layer\":");
+					appendJsonString(chunk, layer.toUtf8());
+					chunk.append(",\"level\":");
+					appendJsonString(chunk, level.toUtf8());
+					chunk.append(",\"message\":");
+					appendJsonString(chunk, message.toUtf8());
+					chunk.append('}');
+					break;
+				}
+				default:
+					break;
+			}
+			chunk.append('\n');
+		}
+
+		if (saveConfiguration.compress && !chunk.isEmpty())
+		{
+			return makeGzipMember(chunk);
+		}
+		return chunk;
+	}
+
+	/** Writes the entries matching the configuration to the file. Chunks of entries are formatted in parallel, then written in order. Called from the save thread, only using its parameters. */
+	static bool writeEntries(QString const& filename, LoggerModel::SaveConfiguration const& saveConfiguration, std::vector<LogInfo> const& entries, std::atomic_bool const& abort, std::function<void(int)> const& onProgress) noexcept
+	{
+		QFile file(filename);
+		if (!file.open(QIODevice::WriteOnly))
+		{
+			return false;
+		}
+
+		// Keep a bounded count of chunks in flight, so the memory used does not depend on the size of the log
+		auto const workersCount = static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency()));
+		auto const totalCount = entries.size();
+		auto pendingChunks = std::deque<std::future<QByteArray>>{};
+		auto nextEntry = size_t{ 0u };
+		auto writtenCount = size_t{ 0u };
+		auto success = true;
+
+		while (success && (nextEntry < totalCount || !pendingChunks.empty()))
+		{
+			if (abort)
+			{
+				success = false;
+				break;
+			}
+
+			while (nextEntry < totalCount && pendingChunks.size() < workersCount)
+			{
+				auto const count = std::min(SaveChunkEntries, totalCount - nextEntry);
+				auto const* const first = entries.data() + nextEntry;
+				pendingChunks.push_back(std::async(std::launch::async, &LoggerModelPrivate::formatEntries, first, first + count, saveConfiguration));
+				nextEntry += count;
+			}
+
+			auto const data = pendingChunks.front().get();
+			pendingChunks.pop_front();
+			writtenCount = std::min(writtenCount + SaveChunkEntries, totalCount);
+			success = file.write(data) == data.size();
+			onProgress(static_cast<int>(writtenCount * 100u / totalCount));
+		}
+
+		// Wait for the workers still running, they use the entries
+		for (auto& chunk : pendingChunks)
+		{
+			chunk.wait();
+		}
+
+		if (!success)
+		{
+			// Do not leave a truncated file behind
+			file.remove();
+			return false;
+		}
+
+		onProgress(100);
+		return true;
+	}
+
+	static constexpr size_t EvictionDivider = 10u; // A tenth of the capacity is evicted at once when full
+
+	static QString formatTimestamp(qint64 const timestamp)
+	{
+		auto const dateTime = QDateTime::fromMSecsSinceEpoch(timestamp);
+		return QString("%1 - %2").arg(dateTime.date().toString(Qt::ISODate), dateTime.time().toString(Qt::ISODate));
+	}
+
+	void openJournal() noexcept
+	{
+		auto const dir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+		if (!QDir{}.mkpath(dir))
+		{
+			return;
+		}
+
+		// Keep the journal of the previous session
+		auto const journalPath = dir + '/' + JournalFileName;
+		auto const previousJournalPath = dir + '/' + PreviousJournalFileName;
+		QFile::remove(previousJournalPath);
+		QFile::rename(journalPath, previousJournalPath);
+
+		auto const journalSize = static_cast<qint64>(logJournal::HeaderSize + logJournal::DefaultDataSize);
+		_journalFile.setFileName(journalPath);
+		if (!_journalFile.open(QIODevice::ReadWrite | QIODevice::Truncate) || !_journalFile.resize(journalSize))
+		{
+			return;
+		}
+
+		// Entries are written to the mapped memory, without any syscall, the OS taking care of flushing the pages to the disk
+		_journal = _journalFile.map(0, journalSize);
+		if (_journal)
+		{
+			logJournal::initialize(_journal, static_cast<std::size_t>(journalSize));
+		}
+	}
+
+	void flushPendingEntries()
+	{
+		HIVE_TRACE_SPAN("LoggerModel::flushPendingEntries");
+		auto entries = std::vector<LogInfo>{};
+		{
+			auto const lg = std::lock_guard{ _pendingEntriesLock };
+			entries.swap(_pendingEntries);
+		}
+		if (entries.empty())
+		{
+			return;
+		}
+
+		// more entries than the model can hold, only the most recent ones are kept
+		auto const capacity = _entries.capacity();
+		auto firstEntry = entries.begin();
+		if (entries.size() > capacity)
+		{
+			firstEntry += entries.size() - capacity;
+		}
+		auto const insertedCount = static_cast<size_t>(std::distance(firstEntry, entries.end()));
+
+		// make room by evicting the oldest entries in bulk
+		if (_entries.size() + insertedCount > capacity)
+		{
+			auto const requiredCount = _entries.size() + insertedCount - capacity;
+			evictEntries(std::max(requiredCount, capacity / EvictionDivider));
+		}
+
+		// insert all the entries at once
+		Q_Q(LoggerModel);
+		auto const count = q->rowCount();
+		q->beginInsertRows({}, count, count + static_cast<int>(insertedCount) - 1);
+		for (auto it = firstEntry; it != entries.end(); ++it)
+		{
+			if (_isSearchIndexed)
+			{
+				_searchIndex.add(_firstSequence + _entries.size(), it->getMessage());
+			}
+			_entries.push_back(std::move(*it));
+		}
+		q->endInsertRows();
+	}
+
+	void evictEntries(size_t const count)
+	{
+		Q_Q(LoggerModel);
+		auto const evictedCount = std::min(count, _entries.size());
+		if (evictedCount == 0u)
+		{
+			return;
+		}
+		q->beginRemoveRows({}, 0, static_cast<int>(evictedCount) - 1);
+		_entries.pop_front(evictedCount);
+		_firstSequence += evictedCount;
+		if (_isSearchIndexed)
+		{
+			_searchIndex.removeBefore(_firstSequence);
+		}
+		q->endRemoveRows();
+	}
+
+	LogInfoRingBuffer _entries{};
+	quint64 _firstSequence{ 0u }; // Sequence number of the first entry of _entries
+	LogSearchIndex _searchIndex{}; // Only maintained once a search has been made (_isSearchIndexed)
+	bool _isSearchIndexed{ false };
+	std::mutex _pendingEntriesLock{};
+	std::vector<LogInfo> _pendingEntries{}; // Entries logged since the last flush, protected by _pendingEntriesLock
+	QFile _journalFile{};
+	uchar* _journal{ nullptr }; // Mapped journal memory, protected by _pendingEntriesLock (once mapped)
+	FrameScheduler::ClientID _frameClientID{ 0u };
+	std::thread _saveThread{};
+	std::atomic_bool _abortSave{ false }; // Set to abort the save in progress
+	std::atomic<size_t> _pendingCapacity{ static_cast<size_t>(LoggerModel::DefaultMaximumEntries) }; // Copy of the entries capacity, readable from any thread
+	bool _isSaving{ false }; // Only accessed from the Qt Main Thread
+	bool _isActive{ true }; // Only accessed from the Qt Main Thread
+	MemoryAccounting::ProbeID _memoryProbe{ 0u };
 };
 
 LoggerModel::LoggerModel(QObject* parent)
@@ -245,12 +879,42 @@ void LoggerModel::clear()
 	return d->clear();
 }
 
-void LoggerModel::save(QString const& filename, SaveConfiguration const& saveConfiguration) const
+void LoggerModel::setMaximumEntries(int const maximumEntries)
+{
+	Q_D(LoggerModel);
+	d->setMaximumEntries(maximumEntries);
+}
+
+int LoggerModel::maximumEntries() const
 {
 	Q_D(const LoggerModel);
+	return d->maximumEntries();
+}
+
+void LoggerModel::setActive(bool const isActive)
+{
+	Q_D(LoggerModel);
+	d->setActive(isActive);
+}
+
+bool LoggerModel::save(QString const& filename, SaveConfiguration const& saveConfiguration)
+{
+	Q_D(LoggerModel);
 	return d->save(filename, saveConfiguration);
 }
 
+bool LoggerModel::findSearchCandidates(QString const& text, SearchCandidates& candidates)
+{
+	Q_D(LoggerModel);
+	return d->findSearchCandidates(text, candidates);
+}
+
+void LoggerModel::cancelSave()
+{
+	Q_D(LoggerModel);
+	d->cancelSave();
+}
+
 } // namespace avdecc
 
 #include "loggerModel.moc"
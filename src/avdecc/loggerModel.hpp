@@ -19,9 +19,13 @@
 
 #pragma once
 
+#include "toolkit/filterExpression.hpp"
+
 #include <QAbstractTableModel>
 #include <la/avdecc/logger.hpp>
 
+#include <vector>
+
 namespace avdecc
 {
 class LoggerModelPrivate;
@@ -29,6 +33,10 @@ class LoggerModel : public QAbstractTableModel
 {
 	Q_OBJECT
 public:
+	static constexpr auto LayerRole = Qt::UserRole + 1; // Raw la::avdecc::logger::Layer of the entry
+	static constexpr auto LevelRole = Qt::UserRole + 2; // Raw la::avdecc::logger::Level of the entry
+	static constexpr auto SequenceRole = Qt::UserRole + 3; // Sequence number of the entry (qulonglong), increasing and never reused
+
 	LoggerModel(QObject* parent = nullptr);
 	~LoggerModel();
 
@@ -40,17 +48,54 @@ public:
 
 	void clear();
 
+	static constexpr int DefaultMaximumEntries = 100000;
+
+	// Set the maximum count of entries kept by the model, oldest entries being evicted first
+	void setMaximumEntries(int const maximumEntries);
+	int maximumEntries() const;
+
+	// Suspend or resume the insertion of the logged entries (kept pending while inactive, then inserted at once)
+	void setActive(bool const isActive);
+
+	enum class SaveFormat
+	{
+		Text, // Tab separated timestamp, layer, level and message
+		JsonLines, // One JSON object per entry: {"timestamp":<ms since epoch>,"time":"<ISO 8601 UTC>","layer":"...","level":"...","message":"..."}
+	};
+
 	struct SaveConfiguration
 	{
-		QRegExp search{};
-		QRegExp level{};
-		QRegExp layer{};
+		qt::toolkit::FilterExpression search{};
+		qt::toolkit::FilterExpression level{};
+		qt::toolkit::FilterExpression layer{};
+		bool compress{ false }; // Write a gzip compressed file
+		SaveFormat format{ SaveFormat::Text };
+	};
+
+	// Asynchronously save a snapshot of the current entries, returns false if a save is already in progress
+	bool save(QString const& filename, SaveConfiguration const& saveConfiguration);
+
+	// Abort the save in progress, if any (saveCompleted will still be emitted)
+	void cancelSave();
+
+	struct SearchCandidates
+	{
+		std::vector<quint64> sequences{}; // Sorted sequences of the entries which may contain the text
+		quint64 endSequence{ 0u }; // Entries from this sequence were inserted after the lookup, they are not part of the candidates
 	};
 
-	void save(QString const& filename, SaveConfiguration const& saveConfiguration) const;
+	// Returns the entries which may contain the (case insensitive) text, looked up in a trigram index of the messages instead of scanning them.
+	// Returns false if the text is too short to be looked up. The index is built on the first call, then maintained as entries are inserted and evicted.
+	bool findSearchCandidates(QString const& text, SearchCandidates& candidates);
+
+	Q_SIGNAL void saveProgress(int const percent);
+	Q_SIGNAL void saveCompleted(QString const& filename, bool const success);
 
 private:
 	LoggerModelPrivate* const d_ptr{ nullptr };
 	Q_DECLARE_PRIVATE(LoggerModel)
 };
 } // namespace avdecc
+
+Q_DECLARE_METATYPE(la::avdecc::logger::Layer)
+Q_DECLARE_METATYPE(la::avdecc::logger::Level)
@@ -20,9 +20,17 @@
 #include "mcDomainManager.hpp"
 #include "controllerManager.hpp"
 #include "helper.hpp"
+#include "memoryAccounting.hpp"
+#include "spanTrace.hpp"
 #include <la/avdecc/internals/streamFormatInfo.hpp>
+#include <QThreadPool>
+#include <QRunnable>
 #include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
 #include <optional>
+#include <unordered_map>
 #include <unordered_set>
 #include <math.h>
 
@@ -30,6 +38,28 @@ namespace avdecc
 {
 namespace mediaClock
 {
+static constexpr size_t MaxRunningApplyCommandSets = 8; // Command sets of an apply running at the same time
+
+/** Runs a function on the domain model worker */
+class DomainModelTask final : public QRunnable
+{
+public:
+	using Work = std::function<void()>;
+
+	DomainModelTask(Work&& work) noexcept
+		: _work{ std::move(work) }
+	{
+	}
+
+	virtual void run() override
+	{
+		_work();
+	}
+
+private:
+	Work _work{};
+};
+
 // **************************************************************
 // class MCDomainManagerImpl
 // **************************************************************
@@ -46,10 +76,119 @@ namespace mediaClock
 class MCDomainManagerImpl final : public MCDomainManager
 {
 private:
+	using MediaClockMasterResult = std::pair<la::avdecc::UniqueIdentifier, McDeterminationError>;
+	using MediaClockMasterResolver = std::function<MediaClockMasterResult(la::avdecc::UniqueIdentifier const entityId, bool const searchForSecondaryMcMaster)>;
+
+	/** One link of a media clock chain: either the entity clock is provided by another entity (clockTalker), or the chain ends on this entity (master and error). */
+	struct ClockStep
+	{
+		std::optional<la::avdecc::UniqueIdentifier> clockTalker{ std::nullopt };
+		la::avdecc::UniqueIdentifier master{ la::avdecc::UniqueIdentifier::getNullUniqueIdentifier() };
+		McDeterminationError error{ McDeterminationError::UnknownEntity };
+
+		bool operator==(ClockStep const& other) const noexcept
+		{
+			return clockTalker == other.clockTalker && master == other.master && error == other.error;
+		}
+		bool operator!=(ClockStep const& other) const noexcept
+		{
+			return !operator==(other);
+		}
+	};
+	struct ClockSteps
+	{
+		ClockStep primary{};
+		ClockStep secondary{}; // Step used when searching for the secondary mc master of the entity
+	};
+	struct ResolvedMediaClockMasters
+	{
+		MediaClockMasterResult primary{ la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), McDeterminationError::UnknownEntity };
+		MediaClockMasterResult secondary{ la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), McDeterminationError::UnknownEntity };
+
+		bool operator==(ResolvedMediaClockMasters const& other) const noexcept
+		{
+			return primary == other.primary && secondary == other.secondary;
+		}
+		bool operator!=(ResolvedMediaClockMasters const& other) const noexcept
+		{
+			return !operator==(other);
+		}
+	};
+	using ClockStepsPerEntity = std::unordered_map<la::avdecc::UniqueIdentifier, ClockSteps, la::avdecc::UniqueIdentifier::hash>;
+	using ClockListenersPerEntity = std::unordered_map<la::avdecc::UniqueIdentifier, std::set<la::avdecc::UniqueIdentifier>, la::avdecc::UniqueIdentifier::hash>;
+	using ResolvedMediaClockMastersPerEntity = std::unordered_map<la::avdecc::UniqueIdentifier, ResolvedMediaClockMasters, la::avdecc::UniqueIdentifier::hash>;
+	struct ClockChainResult
+	{
+		MediaClockMasterResult result{ la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), McDeterminationError::UnknownEntity };
+		std::uint64_t generation{ 0u }; // Clock graph generation the result was computed for
+	};
+	using ClockChainResultsPerEntity = std::unordered_map<la::avdecc::UniqueIdentifier, ClockChainResult, la::avdecc::UniqueIdentifier::hash>;
+	/** Changes of the mc masters of an entity between two domain models */
+	struct MediaClockMappingDiff
+	{
+		std::vector<la::avdecc::UniqueIdentifier> removedMasters{};
+		std::vector<la::avdecc::UniqueIdentifier> addedMasters{};
+		size_t oldMasterCount{ 0u };
+		size_t newMasterCount{ 0u };
+	};
+	using MediaClockMappingDiffs = std::map<la::avdecc::UniqueIdentifier, MediaClockMappingDiff>;
+	/** Indexes of the streams used for clocking in a configuration (primary first, then its redundant streams), empty if there is none */
+	struct ClockStreamIndexes
+	{
+		std::vector<la::avdecc::entity::model::StreamIndex> outputs{};
+		std::vector<la::avdecc::entity::model::StreamIndex> inputs{};
+	};
+	using ListenerStreamKey = std::pair<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::StreamIndex>;
+	using ListenerStreamConnections = std::map<ListenerStreamKey, la::avdecc::entity::model::StreamConnectionState>;
+	using TalkerStreamConnectionsIndex = std::unordered_map<la::avdecc::UniqueIdentifier, ListenerStreamConnections, la::avdecc::UniqueIdentifier::hash>;
+	using ListenerStreamTalkersIndex = std::map<ListenerStreamKey, la::avdecc::UniqueIdentifier>;
+	using ClockStreamIndexesPerConfiguration = std::map<std::pair<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::ConfigurationIndex>, ClockStreamIndexes>;
+	/** Active clock source of a clock domain, as much as the clock chain needs */
+	struct ActiveClockSource
+	{
+		la::avdecc::entity::model::ClockSourceType type{};
+		la::avdecc::entity::model::DescriptorType locationType{};
+		la::avdecc::entity::model::DescriptorIndex locationIndex{ 0u };
+	};
+	/** Active clock source of each clock domain of an AEM entity (nullopt if unknown), so the hot paths don't have to walk the entity model */
+	struct ClockSourceTable
+	{
+		la::avdecc::entity::model::ConfigurationIndex configurationIndex{ 0u };
+		std::map<la::avdecc::entity::model::ClockDomainIndex, std::optional<ActiveClockSource>> activeClockSources{};
+	};
+	using ClockSourceTablesPerEntity = std::unordered_map<la::avdecc::UniqueIdentifier, ClockSourceTable, la::avdecc::UniqueIdentifier::hash>;
+	using SampleRatesPerEntity = std::unordered_map<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::SamplingRate, la::avdecc::UniqueIdentifier::hash>;
+	using SharedConstDomainModel = std::shared_ptr<MCEntityDomainMapping const>;
+	/** Everything the domain model worker needs, captured from the UI thread so the build doesn't access the manager nor the entity models */
+	struct DomainModelInputs
+	{
+		std::vector<la::avdecc::UniqueIdentifier> entityIds{};
+		ResolvedMediaClockMastersPerEntity resolvedMediaClockMasters{};
+		SampleRatesPerEntity sampleRates{};
+		std::vector<la::avdecc::UniqueIdentifier> changes{}; // Entities to notify once the model is published
+	};
+
 	// Private members
 	std::set<la::avdecc::UniqueIdentifier> _entities{}; // No lock required, only read/write in the UI thread
-	MCEntityDomainMapping _currentMCDomainMapping{};
-	commandChain::SequentialAsyncCommandExecuter _sequentialAcmpCommandExecuter{};
+	SharedConstDomainModel _publishedMCDomainMapping{ std::make_shared<MCEntityDomainMapping const>() }; // Latest model built by the worker, replaced as a whole (never modified) so readers can keep it without locking
+	std::uint64_t _domainModelGeneration{ 0u }; // Incremented when the controller goes offline, so the model being built for the previous controller is dropped
+	bool _isBuildingDomainModel{ false }; // A model is being built by the worker
+	bool _isDomainModelOutdated{ false }; // The clock graph changed while the worker was building, build again as soon as it is done
+	std::vector<la::avdecc::UniqueIdentifier> _unpublishedChanges{}; // Entities whose mc master changed since the last build started
+	ClockStepsPerEntity _clockSteps{}; // Clock dependency graph: the clock step of each known entity
+	ClockListenersPerEntity _clockListeners{}; // Reverse clock dependency graph: entities whose clock step points to the entity
+	ResolvedMediaClockMastersPerEntity _resolvedMediaClockMasters{}; // Memoized mc masters of each known entity
+	ClockChainResultsPerEntity _clockChainResults{}; // Path compressed result of the clock chain starting at each entity, valid for the current generation only
+	std::uint64_t _clockGraphGeneration{ 1u }; // Incremented each time a clock step changes, invalidating all _clockChainResults
+	TalkerStreamConnectionsIndex _talkerStreamConnections{}; // Talker entity -> connection state of every listener stream it feeds
+	ListenerStreamTalkersIndex _listenerStreamTalkers{}; // Listener stream -> talker entity it is indexed under in _talkerStreamConnections
+	ClockSourceTablesPerEntity _clockSourceTables{}; // Active clock sources of each online AEM entity, updated on clock source changes
+	mutable ClockStreamIndexesPerConfiguration _clockStreamIndexes{}; // Clock streams of each scanned configuration, until the entity is enumerated again or one of its stream formats changes
+	commandChain::AsyncCommandGraphExecuter _acmpCommandExecuter{};
+	std::unordered_map<la::avdecc::UniqueIdentifier, EntityApplyStatus, la::avdecc::UniqueIdentifier::hash> _applyStatuses{}; // Progress of the current apply, per entity
+	ControllerManager::ExclusiveAccessGroupPointer _applyExclusiveAccess{}; // Locks held on the configured entities until the current apply completes
+	ApplyID _lastApplyId{ 0u }; // ID given to the last applyMediaClockDomainModel call, the one _acmpCommandExecuter runs
+	QThreadPool _domainModelWorker{}; // Single thread building the domain models. Declared last so it is destroyed (waiting for its task) first
 
 public:
 	/**
@@ -63,19 +202,46 @@ public:
 		connect(&manager, &ControllerManager::entityOffline, this, &MCDomainManagerImpl::onEntityOffline);
 		connect(&manager, &ControllerManager::streamConnectionChanged, this, &MCDomainManagerImpl::onStreamConnectionChanged);
 		connect(&manager, &ControllerManager::clockSourceChanged, this, &MCDomainManagerImpl::onClockSourceChanged);
+		connect(&manager, &ControllerManager::streamFormatChanged, this, &MCDomainManagerImpl::onStreamFormatChanged);
 		connect(&manager, &ControllerManager::entityNameChanged, this, &MCDomainManagerImpl::onEntityNameChanged);
 
 		qRegisterMetaType<commandChain::CommandExecutionErrors>("CommandExecutionErrors");
 
-		connect(&_sequentialAcmpCommandExecuter, &commandChain::SequentialAsyncCommandExecuter::completed, this,
+		// bounding the entities configured at the same time keeps the count of AECP/ACMP commands in flight reasonable on large networks
+		_acmpCommandExecuter.setMaxRunningCommandSets(MaxRunningApplyCommandSets);
+
+		// models are built one at a time, in the order the clock graph changed
+		_domainModelWorker.setMaxThreadCount(1);
+
+		MemoryAccounting::getInstance().registerProbe("MCDomainManager",
+			[this](MemoryAccounting::Counters& counters)
+			{
+				auto const domainModel = getMediaClockDomainModel();
+				counters.push_back({ "Entities", _entities.size() });
+				counters.push_back({ "ClockSteps", _clockSteps.size() });
+				counters.push_back({ "ClockListeners", _clockListeners.size() });
+				counters.push_back({ "ResolvedMediaClockMasters", _resolvedMediaClockMasters.size() });
+				counters.push_back({ "ClockChainResults", _clockChainResults.size() });
+				counters.push_back({ "ClockSourceTables", _clockSourceTables.size() });
+				counters.push_back({ "ClockStreamIndexes", _clockStreamIndexes.size() });
+				counters.push_back({ "TalkerStreamConnections", _talkerStreamConnections.size() });
+				counters.push_back({ "DomainModelMappings", domainModel->getEntityMediaClockMasterMappings().size() });
+				counters.push_back({ "DomainModelDomains", domainModel->getMediaClockDomains().size() });
+				counters.push_back({ "ApplyStatuses", _applyStatuses.size() });
+			});
+
+		connect(&_acmpCommandExecuter, &commandChain::AsyncCommandGraphExecuter::completed, this,
 			[this](commandChain::CommandExecutionErrors errors)
 			{
+				_applyExclusiveAccess.reset();
+
 				ApplyInfo info;
+				info.applyId = _lastApplyId;
 				info.entityApplyErrors = errors;
 				emit applyMediaClockDomainModelFinished(info);
 			});
 
-		connect(&_sequentialAcmpCommandExecuter, &commandChain::SequentialAsyncCommandExecuter::progressUpdate, this,
+		connect(&_acmpCommandExecuter, &commandChain::AsyncCommandGraphExecuter::progressUpdate, this,
 			[this](uint32_t const completedCommands, uint32_t const totalCommands)
 			{
 				emit applyMediaClockDomainModelProgressUpdate(roundf(((float)completedCommands) / totalCommands * 100));
@@ -94,9 +260,10 @@ private:
 	*/
 	virtual std::pair<la::avdecc::UniqueIdentifier, McDeterminationError> getMediaClockMaster(la::avdecc::UniqueIdentifier const entityId) noexcept override
 	{
+		auto const domainModel = getMediaClockDomainModel();
 		auto error = McDeterminationError::NoError;
-		auto hasErrorIterator = _currentMCDomainMapping.getEntityMcErrors().find(entityId);
-		if (hasErrorIterator != _currentMCDomainMapping.getEntityMcErrors().end())
+		auto hasErrorIterator = domainModel->getEntityMcErrors().find(entityId);
+		if (hasErrorIterator != domainModel->getEntityMcErrors().end())
 		{
 			// If the entityId delivered mc errors, we only can return immediately in case the error is NOT ExternalClockSource.
 			// In case it is, we need to determine the id of the device that feeds the external clock into the domain as master id.
@@ -106,14 +273,14 @@ private:
 				error = McDeterminationError::ExternalClockSource;
 		}
 
-		auto entityMcDomainIterator = _currentMCDomainMapping.getEntityMediaClockMasterMappings().find(entityId);
-		if (entityMcDomainIterator != _currentMCDomainMapping.getEntityMediaClockMasterMappings().end())
+		auto entityMcDomainIterator = domainModel->getEntityMediaClockMasterMappings().find(entityId);
+		if (entityMcDomainIterator != domainModel->getEntityMediaClockMasterMappings().end())
 		{
 			auto const& associatedDomains = entityMcDomainIterator->second;
 			if (associatedDomains.size() > 0)
 			{
-				auto mediaClockDomainIterator = _currentMCDomainMapping.getMediaClockDomains().find(associatedDomains.at(0));
-				if (mediaClockDomainIterator != _currentMCDomainMapping.getMediaClockDomains().end())
+				auto mediaClockDomainIterator = domainModel->getMediaClockDomains().find(associatedDomains.at(0));
+				if (mediaClockDomainIterator != domainModel->getMediaClockDomains().end())
 				{
 					return std::make_pair(mediaClockDomainIterator->second.getMediaClockDomainMaster(), error);
 				}
@@ -123,7 +290,15 @@ private:
 		return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), McDeterminationError::UnknownEntity);
 	}
 
-	DomainIndex getOrCreateDomainIndexForClockMasterId(MCEntityDomainMapping::Domains& domains, la::avdecc::UniqueIdentifier const mediaClockMasterId) noexcept
+	/**
+	* Gets the latest published domain model. Only copies a shared pointer, the model itself is never modified once published.
+	*/
+	virtual SharedConstDomainModel getMediaClockDomainModel() const noexcept override
+	{
+		return std::atomic_load(&_publishedMCDomainMapping);
+	}
+
+	static DomainIndex getOrCreateDomainIndexForClockMasterId(MCEntityDomainMapping::Domains& domains, la::avdecc::UniqueIdentifier const mediaClockMasterId) noexcept
 	{
 		for (auto const& mediaClockDomainKV : domains)
 		{
@@ -171,148 +346,335 @@ private:
 	*/
 	virtual std::pair<la::avdecc::UniqueIdentifier, McDeterminationError> findMediaClockMaster(la::avdecc::UniqueIdentifier const entityID, bool searchForSecondaryMcMaster = false) noexcept
 	{
-		auto error = McDeterminationError::UnknownEntity;
-		// the map is used to keep track of the entities we already visited, to prevent running in circles
+		// the set is used to keep track of the entities we already visited, to prevent running in circles
 		std::unordered_set<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash> searchedEntityIds;
 		auto currentEntityId = entityID;
 
 		// insert the first entity in to the chain
 		searchedEntityIds.insert(currentEntityId);
-		bool keepSearching = true;
-		while (keepSearching)
+		while (true)
 		{
-			auto& manager = avdecc::ControllerManager::getInstance();
-			auto const& controlledEntity = manager.getControlledEntity(currentEntityId);
-			if (!controlledEntity)
+			auto const step = determineClockStep(currentEntityId, searchForSecondaryMcMaster && entityID == currentEntityId);
+			if (!step.clockTalker)
 			{
-				error = McDeterminationError::AnyEntityInChainOffline;
-				keepSearching = false;
-				break;
+				auto const result = std::make_pair(step.master, step.error);
+				return searchedEntityIds.size() == 1 ? result : inheritClockChainResult(result);
 			}
-			if (!controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+			if (searchedEntityIds.count(*step.clockTalker))
 			{
-				keepSearching = false;
-				error = McDeterminationError::NotSupportedNoAem;
-				break;
+				// recusion of entity clock stream connections detected
+				return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), McDeterminationError::Recursive);
 			}
+			// set the next entity to traverse
+			currentEntityId = *step.clockTalker;
+			searchedEntityIds.insert(currentEntityId);
+		}
+	}
 
-			try
+	/**
+	* Determines the next link of the media clock chain of an entity, from its active clock source.
+	* @param entityId The id of the entity.
+	* @param searchForSecondaryMcMaster Follow the clock stream connection of the entity even if it is its own mc master.
+	*/
+	ClockStep determineClockStep(la::avdecc::UniqueIdentifier const entityId, bool const searchForSecondaryMcMaster) const noexcept
+	{
+		auto const makeEndOfChain = [](la::avdecc::UniqueIdentifier const master, McDeterminationError const error)
+		{
+			return ClockStep{ std::nullopt, master, error };
+		};
+		auto const nullId = la::avdecc::UniqueIdentifier::getNullUniqueIdentifier();
+
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto const& controlledEntity = manager.getControlledEntity(entityId);
+		if (!controlledEntity)
+		{
+			return makeEndOfChain(nullId, McDeterminationError::AnyEntityInChainOffline);
+		}
+		if (!controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+		{
+			return makeEndOfChain(nullId, McDeterminationError::NotSupportedNoAem);
+		}
+
+		try
+		{
+			auto const& configNode = controlledEntity->getCurrentConfigurationNode();
+			auto const activeConfigIndex = configNode.descriptorIndex;
+
+			// for now, we only support devices that have exactly 1 clock domain.
+			if (configNode.clockDomains.size() > 1)
 			{
-				auto const& configNode = controlledEntity->getCurrentConfigurationNode();
-				auto const activeConfigIndex = configNode.descriptorIndex;
+				return makeEndOfChain(nullId, McDeterminationError::NotSupportedMultipleClockDomains);
+			}
+			else if (configNode.clockDomains.empty())
+			{
+				return makeEndOfChain(nullId, McDeterminationError::NotSupportedNoClockDomains);
+			}
 
-				// for now, we only support devices that have exactly 1 clock domain.
-				if (configNode.clockDomains.size() > 1)
-				{
-					keepSearching = false;
-					error = McDeterminationError::NotSupportedMultipleClockDomains;
+			auto const& clockDomain = configNode.clockDomains.begin()->second;
+			if (!clockDomain.dynamicModel)
+			{
+				return makeEndOfChain(nullId, McDeterminationError::UnknownEntity);
+			}
+
+			auto clockSourceIndex = clockDomain.dynamicModel->clockSourceIndex;
+			auto const& activeClockSourceNode = controlledEntity->getClockSourceNode(activeConfigIndex, clockSourceIndex);
+			if (!activeClockSourceNode.staticModel)
+			{
+				return makeEndOfChain(nullId, McDeterminationError::UnknownEntity);
+			}
+
+			switch (activeClockSourceNode.staticModel->clockSourceType)
+			{
+				case la::avdecc::entity::model::ClockSourceType::Internal:
+					if (!searchForSecondaryMcMaster)
+					{
+						return makeEndOfChain(entityId, McDeterminationError::NoError);
+					}
 					break;
-				}
-				else if (configNode.clockDomains.empty())
-				{
-					keepSearching = false;
-					error = McDeterminationError::NotSupportedNoClockDomains;
+				case la::avdecc::entity::model::ClockSourceType::External:
+					return makeEndOfChain(entityId, McDeterminationError::ExternalClockSource);
+				case la::avdecc::entity::model::ClockSourceType::InputStream:
 					break;
+				default:
+					return makeEndOfChain(nullId, McDeterminationError::NotSupportedClockSourceType);
+			}
+
+			// find the relevant clock stream index
+			std::optional<la::avdecc::entity::model::StreamIndex> clockStreamIndex = std::nullopt;
+			if (activeClockSourceNode.staticModel->clockSourceLocationType == la::avdecc::entity::model::DescriptorType::StreamInput)
+			{
+				// In the case StreamInput as clockSourceLocationType we can get the relevant index directly from the static model
+				clockStreamIndex = activeClockSourceNode.staticModel->clockSourceLocationIndex;
+			}
+			else if (activeClockSourceNode.staticModel->clockSourceType == la::avdecc::entity::model::ClockSourceType::Internal)
+			{
+				// In the case we are searching for a secondary master, we have to get the index by checking all streams if they are a CRF stream.
+				auto const& indexes = getClockStreamIndexes(entityId, configNode).inputs;
+				if (!indexes.empty())
+				{
+					clockStreamIndex = indexes.at(0);
 				}
+			}
+
+			if (!clockStreamIndex)
+			{
+				return makeEndOfChain(nullId, McDeterminationError::UnknownEntity);
+			}
+
+			auto* clockStreamDynModel = controlledEntity->getStreamInputNode(activeConfigIndex, *clockStreamIndex).dynamicModel;
+			if (!clockStreamDynModel || !clockStreamDynModel->connectionState.talkerStream.entityID)
+			{
+				// reported as ParentStreamNotConnected if this is not the first entity of the chain
+				return makeEndOfChain(nullId, McDeterminationError::StreamNotConnected);
+			}
 
-				// The first clock domain that can be used, will be used. All further clock domains are ignored.
-				for (auto const& clockDomainKV : configNode.clockDomains)
+			return ClockStep{ clockStreamDynModel->connectionState.talkerStream.entityID };
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+			return makeEndOfChain(nullId, McDeterminationError::UnknownEntity);
+		}
+	}
+
+	/**
+	* Recomputes the clock steps of an entity and updates the clock dependency graph accordingly.
+	* @return True if the clock steps of the entity changed.
+	*/
+	bool updateClockSteps(la::avdecc::UniqueIdentifier const entityId) noexcept
+	{
+		auto const removeClockListener = [this, entityId](ClockStep const& step)
+		{
+			if (step.clockTalker)
+			{
+				auto const listenersIt = _clockListeners.find(*step.clockTalker);
+				if (listenersIt != _clockListeners.end())
 				{
-					auto const& clockDomain = clockDomainKV.second;
-					if (clockDomain.dynamicModel)
+					listenersIt->second.erase(entityId);
+					if (listenersIt->second.empty())
 					{
-						auto clockSourceIndex = clockDomain.dynamicModel->clockSourceIndex;
-						auto const& activeClockSourceNode = controlledEntity->getClockSourceNode(activeConfigIndex, clockSourceIndex);
+						_clockListeners.erase(listenersIt);
+					}
+				}
+			}
+		};
 
-						if (!activeClockSourceNode.staticModel)
-						{
-							keepSearching = false;
-							return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), error);
-						}
+		auto const previousStepsIt = _clockSteps.find(entityId);
+		auto const hadSteps = previousStepsIt != _clockSteps.end();
+		auto const isKnown = _entities.count(entityId) != 0;
 
-						switch (activeClockSourceNode.staticModel->clockSourceType)
-						{
-							case la::avdecc::entity::model::ClockSourceType::Internal:
-								if (!(searchForSecondaryMcMaster && entityID == currentEntityId))
-								{
-									return std::make_pair(currentEntityId, McDeterminationError::NoError);
-								}
-								break;
-							case la::avdecc::entity::model::ClockSourceType::External:
-								return std::make_pair(currentEntityId, McDeterminationError::ExternalClockSource);
-							case la::avdecc::entity::model::ClockSourceType::InputStream:
-								break;
-							default:
-								error = McDeterminationError::NotSupportedClockSourceType;
-								keepSearching = false;
-								return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), error);
-						}
+		if (!isKnown)
+		{
+			if (!hadSteps)
+			{
+				return false;
+			}
+			removeClockListener(previousStepsIt->second.primary);
+			removeClockListener(previousStepsIt->second.secondary);
+			_clockSteps.erase(previousStepsIt);
+			++_clockGraphGeneration;
+			return true;
+		}
 
-						// find the relevant clock stream index
-						std::optional<la::avdecc::entity::model::StreamIndex> clockStreamIndex = std::nullopt;
-						if (activeClockSourceNode.staticModel->clockSourceLocationType == la::avdecc::entity::model::DescriptorType::StreamInput)
-						{
-							// In the case StreamInput as clockSourceLocationType we can get the relevant index directly from the static model
-							clockStreamIndex = activeClockSourceNode.staticModel->clockSourceLocationIndex;
-						}
-						else if (activeClockSourceNode.staticModel->clockSourceType == la::avdecc::entity::model::ClockSourceType::Internal)
-						{
-							// In the case we are searching for a secondary master, we have to get the index by checking all streams if they are a CRF stream.
-							auto indexes = findInputClockStreamIndexInConfiguration(configNode);
-							if (!indexes.empty())
-							{
-								clockStreamIndex = indexes.at(0);
-							}
-						}
+		auto steps = ClockSteps{ determineClockStep(entityId, false), determineClockStep(entityId, true) };
+		if (hadSteps)
+		{
+			if (previousStepsIt->second.primary == steps.primary && previousStepsIt->second.secondary == steps.secondary)
+			{
+				return false;
+			}
+			removeClockListener(previousStepsIt->second.primary);
+			removeClockListener(previousStepsIt->second.secondary);
+		}
 
-						if (clockStreamIndex)
-						{
-							auto* clockStreamDynModel = controlledEntity->getStreamInputNode(activeConfigIndex, *clockStreamIndex).dynamicModel;
-							if (clockStreamDynModel)
-							{
-								auto connectedTalker = clockStreamDynModel->connectionState.talkerStream.entityID;
-								if (!connectedTalker)
-								{
-									error = searchedEntityIds.size() == 1 ? McDeterminationError::StreamNotConnected : McDeterminationError::ParentStreamNotConnected;
-									keepSearching = false;
-									return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), error);
-								}
-								if (searchedEntityIds.count(connectedTalker))
-								{
-									// recusion of entity clock stream connections detected
-									return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), McDeterminationError::Recursive);
-								}
-								// set the next entity to traverse
-								currentEntityId = connectedTalker;
-								searchedEntityIds.insert(currentEntityId);
-							}
-							else
-							{
-								error = searchedEntityIds.size() == 1 ? McDeterminationError::StreamNotConnected : McDeterminationError::ParentStreamNotConnected;
-								keepSearching = false;
-								return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), error);
-							}
-						}
-						else
-						{
-							keepSearching = false;
-							return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), error);
-						}
-					}
-					else
+		for (auto const* const step : { &steps.primary, &steps.secondary })
+		{
+			if (step->clockTalker)
+			{
+				_clockListeners[*step->clockTalker].insert(entityId);
+			}
+		}
+		_clockSteps[entityId] = std::move(steps);
+		++_clockGraphGeneration;
+		return true;
+	}
+
+	/**
+	* Gets the cached clock step of an entity. Entities that are not known end the chain as offline.
+	*/
+	ClockStep getCachedClockStep(la::avdecc::UniqueIdentifier const entityId, bool const searchForSecondaryMcMaster) const noexcept
+	{
+		auto const stepsIt = _clockSteps.find(entityId);
+		if (stepsIt == _clockSteps.end())
+		{
+			return ClockStep{ std::nullopt, la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), McDeterminationError::AnyEntityInChainOffline };
+		}
+		return searchForSecondaryMcMaster ? stepsIt->second.secondary : stepsIt->second.primary;
+	}
+
+	/**
+	* Gets the given entities and all the entities getting their clock (directly or not) from one of them.
+	*/
+	std::set<la::avdecc::UniqueIdentifier> collectClockDependents(std::set<la::avdecc::UniqueIdentifier> const& entityIds) const noexcept
+	{
+		auto dependents = entityIds;
+		auto toVisit = std::vector<la::avdecc::UniqueIdentifier>{ entityIds.begin(), entityIds.end() };
+		while (!toVisit.empty())
+		{
+			auto const entityId = toVisit.back();
+			toVisit.pop_back();
+
+			auto const listenersIt = _clockListeners.find(entityId);
+			if (listenersIt != _clockListeners.end())
+			{
+				for (auto const& listenerId : listenersIt->second)
+				{
+					if (dependents.insert(listenerId).second)
 					{
-						keepSearching = false;
-						return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), error);
+						toVisit.push_back(listenerId);
 					}
 				}
 			}
-			catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		}
+		return dependents;
+	}
+
+	/**
+	* Converts the result of the chain of the clock talker of an entity into the result for that entity.
+	*/
+	static MediaClockMasterResult inheritClockChainResult(MediaClockMasterResult const& clockTalkerResult) noexcept
+	{
+		if (clockTalkerResult.second == McDeterminationError::StreamNotConnected)
+		{
+			return std::make_pair(clockTalkerResult.first, McDeterminationError::ParentStreamNotConnected);
+		}
+		return clockTalkerResult;
+	}
+
+	/**
+	* Gets the result of the clock chain starting at the given entity, from the cached clock dependency graph.
+	* The chain is only followed up to the first entity already resolved for the current generation, then the result is stored for
+	* every entity of the followed path (path compression). Loops are detected when reaching an entity of the path being followed.
+	*/
+	MediaClockMasterResult resolveClockChain(la::avdecc::UniqueIdentifier const entityId) noexcept
+	{
+		auto path = std::vector<la::avdecc::UniqueIdentifier>{}; // Entities of the followed path that get their clock from the next one
+		auto pathEntities = std::unordered_set<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash>{};
+		auto currentEntityId = entityId;
+		auto chainResult = MediaClockMasterResult{};
+
+		while (true)
+		{
+			auto const cachedIt = _clockChainResults.find(currentEntityId);
+			if (cachedIt != _clockChainResults.end() && cachedIt->second.generation == _clockGraphGeneration)
+			{
+				chainResult = cachedIt->second.result;
+				break;
+			}
+
+			auto const step = getCachedClockStep(currentEntityId, false);
+			if (!step.clockTalker)
 			{
-				keepSearching = false;
+				chainResult = std::make_pair(step.master, step.error);
+				_clockChainResults[currentEntityId] = ClockChainResult{ chainResult, _clockGraphGeneration };
 				break;
 			}
+
+			path.push_back(currentEntityId);
+			pathEntities.insert(currentEntityId);
+			if (pathEntities.count(*step.clockTalker))
+			{
+				// recusion of entity clock stream connections detected
+				chainResult = std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), McDeterminationError::Recursive);
+				break;
+			}
+			currentEntityId = *step.clockTalker;
+		}
+
+		if (path.empty())
+		{
+			return chainResult;
+		}
+
+		// every entity of the path gets its clock from the end of the chain
+		auto const inheritedResult = inheritClockChainResult(chainResult);
+		for (auto const& pathEntityId : path)
+		{
+			_clockChainResults[pathEntityId] = ClockChainResult{ inheritedResult, _clockGraphGeneration };
+		}
+		return inheritedResult;
+	}
+
+	/**
+	* Resolves the mc masters of an entity from the cached clock dependency graph.
+	*/
+	ResolvedMediaClockMasters resolveMediaClockMasters(la::avdecc::UniqueIdentifier const entityId) noexcept
+	{
+		auto resolved = ResolvedMediaClockMasters{};
+		resolved.primary = resolveClockChain(entityId);
+
+		// secondary mc master is only relevant for entities that are their own mc master
+		if (resolved.primary.first == entityId)
+		{
+			auto const step = getCachedClockStep(entityId, true);
+			if (!step.clockTalker)
+			{
+				resolved.secondary = std::make_pair(step.master, step.error);
+			}
+			else
+			{
+				auto const clockTalkerResult = resolveClockChain(*step.clockTalker);
+				// the chain looping back to the entity ends on it, as it is its own mc master
+				if (clockTalkerResult.first == entityId)
+				{
+					resolved.secondary = std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), McDeterminationError::Recursive);
+				}
+				else
+				{
+					resolved.secondary = inheritClockChainResult(clockTalkerResult);
+				}
+			}
 		}
-		return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), error);
+		return resolved;
 	}
 
 	/**
@@ -332,17 +694,144 @@ private:
 	* @return Entity to domain mappings.
 	*/
 	virtual MCEntityDomainMapping createMediaClockDomainModel() noexcept override
+	{
+		// capture the clock steps of the network once, then follow the chains of all the entities in parallel
+		auto const snapshots = captureClockSteps();
+		auto const entityIds = std::vector<la::avdecc::UniqueIdentifier>{ _entities.begin(), _entities.end() };
+		auto resolved = std::vector<std::optional<ResolvedMediaClockMasters>>(entityIds.size());
+		avdecc::ControllerManager::getInstance().foreachEntityParallel(entityIds,
+			[&snapshots, &resolved](std::size_t const index, la::avdecc::UniqueIdentifier const& entityId, la::avdecc::controller::ControlledEntity const& /*controlledEntity*/)
+			{
+				// Each index is only written by a single call
+				resolved[index] = resolveMediaClockMasters(snapshots, entityId);
+			});
+
+		auto resolvedPerEntity = ResolvedMediaClockMastersPerEntity{};
+		for (auto index = size_t{ 0u }; index < entityIds.size(); ++index)
+		{
+			auto const& entityId = entityIds[index];
+			// Entities that went offline since the capture are skipped by the workers, their snapshot is still followed
+			resolvedPerEntity.emplace(entityId, resolved[index] ? *resolved[index] : resolveMediaClockMasters(snapshots, entityId));
+		}
+
+		return buildMediaClockDomainModel(
+			entityIds,
+			[&resolvedPerEntity](la::avdecc::UniqueIdentifier const entityId, bool const searchForSecondaryMcMaster)
+			{
+				auto const& resolvedMasters = resolvedPerEntity.at(entityId);
+				return searchForSecondaryMcMaster ? resolvedMasters.secondary : resolvedMasters.primary;
+			},
+			captureSampleRates());
+	}
+
+	/**
+	* Captures the current sampling rate of all the known entities.
+	*/
+	SampleRatesPerEntity captureSampleRates() noexcept
+	{
+		auto sampleRates = SampleRatesPerEntity{};
+		for (auto const& entityId : _entities)
+		{
+			if (auto const sampleRate = getSampleRateOfEntity(entityId))
+			{
+				sampleRates.emplace(entityId, *sampleRate);
+			}
+		}
+		return sampleRates;
+	}
+
+	/**
+	* Captures the clock steps of all the known entities and of the entities their clock chains go through, so the chains can be followed without accessing the entity models.
+	*/
+	ClockStepsPerEntity captureClockSteps() const noexcept
+	{
+		auto snapshots = ClockStepsPerEntity{};
+		auto toCapture = std::vector<la::avdecc::UniqueIdentifier>{ _entities.begin(), _entities.end() };
+		while (!toCapture.empty())
+		{
+			auto const entityId = toCapture.back();
+			toCapture.pop_back();
+			if (snapshots.count(entityId) != 0)
+			{
+				continue;
+			}
+
+			auto steps = ClockSteps{ determineClockStep(entityId, false), determineClockStep(entityId, true) };
+			for (auto const* const step : { &steps.primary, &steps.secondary })
+			{
+				if (step->clockTalker && snapshots.count(*step->clockTalker) == 0)
+				{
+					toCapture.push_back(*step->clockTalker);
+				}
+			}
+			snapshots.emplace(entityId, std::move(steps));
+		}
+		return snapshots;
+	}
+
+	/**
+	* Follows the clock chain starting at the given entity through captured clock steps, the same way findMediaClockMaster does through the entity models.
+	* Only reads the snapshots, so it can be called from any thread.
+	*/
+	static MediaClockMasterResult findMediaClockMaster(ClockStepsPerEntity const& snapshots, la::avdecc::UniqueIdentifier const entityId, bool const searchForSecondaryMcMaster) noexcept
+	{
+		auto searchedEntityIds = std::unordered_set<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash>{ entityId };
+		auto currentEntityId = entityId;
+		while (true)
+		{
+			auto const stepsIt = snapshots.find(currentEntityId);
+			if (stepsIt == snapshots.end())
+			{
+				auto const result = MediaClockMasterResult{ la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), McDeterminationError::AnyEntityInChainOffline };
+				return searchedEntityIds.size() == 1 ? result : inheritClockChainResult(result);
+			}
+
+			auto const& step = searchForSecondaryMcMaster && currentEntityId == entityId ? stepsIt->second.secondary : stepsIt->second.primary;
+			if (!step.clockTalker)
+			{
+				auto const result = std::make_pair(step.master, step.error);
+				return searchedEntityIds.size() == 1 ? result : inheritClockChainResult(result);
+			}
+			if (searchedEntityIds.count(*step.clockTalker))
+			{
+				// recusion of entity clock stream connections detected
+				return std::make_pair(la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), McDeterminationError::Recursive);
+			}
+			currentEntityId = *step.clockTalker;
+			searchedEntityIds.insert(currentEntityId);
+		}
+	}
+
+	/**
+	* Resolves the mc masters of an entity from captured clock steps (secondary mc master only for the entities that are their own mc master).
+	*/
+	static ResolvedMediaClockMasters resolveMediaClockMasters(ClockStepsPerEntity const& snapshots, la::avdecc::UniqueIdentifier const entityId) noexcept
+	{
+		auto resolved = ResolvedMediaClockMasters{};
+		resolved.primary = findMediaClockMaster(snapshots, entityId, false);
+		if (resolved.primary.first == entityId)
+		{
+			resolved.secondary = findMediaClockMaster(snapshots, entityId, true);
+		}
+		return resolved;
+	}
+
+	/**
+	* Builds a media clock mapping object for the given entities, getting the mc master of each entity from the given resolver.
+	* Only reads its parameters, so it can be called from any thread.
+	*/
+	static MCEntityDomainMapping buildMediaClockDomainModel(std::vector<la::avdecc::UniqueIdentifier> const& entityIds, MediaClockMasterResolver const& resolveMediaClockMaster, SampleRatesPerEntity const& sampleRates) noexcept
 	{
 		auto mappings = MCEntityDomainMapping::Mappings{};
 		auto domains = MCEntityDomainMapping::Domains{};
 		auto errors = MCEntityDomainMapping::Errors{};
 
-		for (auto const& entityId : _entities)
+		for (auto const& entityId : entityIds)
 		{
 			std::vector<avdecc::mediaClock::DomainIndex> associatedDomains;
 
 			// get mc master if there is one.
-			auto mcMasterIdKV = findMediaClockMaster(entityId);
+			auto mcMasterIdKV = resolveMediaClockMaster(entityId, false);
 			auto const& mcMasterId = mcMasterIdKV.first;
 			auto const mcMasterError = mcMasterIdKV.second;
 			if (!mcMasterError)
@@ -366,7 +855,7 @@ private:
 			if (mcMasterId == entityId)
 			{
 				// get secondary mc master if there is one
-				auto secondaryMasterIdKV = findMediaClockMaster(entityId, true);
+				auto secondaryMasterIdKV = resolveMediaClockMaster(entityId, true);
 				auto const& secondaryMasterId = secondaryMasterIdKV.first;
 				auto const secondaryMasterError = secondaryMasterIdKV.second;
 				if (secondaryMasterId) // check if the id is valid
@@ -384,28 +873,28 @@ private:
 		// loop through all domains, then through all entities in that domain to get the domain sample rate.
 		for (auto& domainKV : domains)
 		{
-			std::set<la::avdecc::entity::model::SamplingRate> sampleRates;
+			std::set<la::avdecc::entity::model::SamplingRate> domainSampleRates;
 			for (auto const& entityIdKV : mappings)
 			{
 				for (auto const entityDomainIndex : entityIdKV.second)
 				{
 					if (domainKV.second.getDomainIndex() == entityDomainIndex)
 					{
-						auto sampleRate = getSampleRateOfEntity(entityIdKV.first);
-						if (sampleRate)
+						auto const sampleRateIt = sampleRates.find(entityIdKV.first);
+						if (sampleRateIt != sampleRates.end())
 						{
-							sampleRates.insert(*sampleRate);
+							domainSampleRates.insert(sampleRateIt->second);
 						}
 					}
 				}
 			}
-			if (sampleRates.size() > 1 || sampleRates.size() == 0)
+			if (domainSampleRates.size() > 1 || domainSampleRates.size() == 0)
 			{
 				domainKV.second.setDomainSamplingRate(la::avdecc::entity::model::SamplingRate::getNullSamplingRate());
 			}
 			else
 			{
-				domainKV.second.setDomainSamplingRate(*sampleRates.begin());
+				domainKV.second.setDomainSamplingRate(*domainSampleRates.begin());
 			}
 		}
 
@@ -417,24 +906,29 @@ private:
 	* of all entities to match the new mapping.
 	*
 	* Detailed algorithm description:
-	* No change is executed directly. All changes are stored in commands and executed using the _sequentialAcmpCommandExecuter instance.
+	* No change is executed directly. All changes are stored in commands and executed using the _acmpCommandExecuter instance.
 	* 1. All changes regarding sample rates are collected. To change the sample rate of an entity, one has to disconnect all streams of that entity first.
 	*	 Therefor all sample rate changes are executed in a sequence of disconnection every stream, changing the sample rate, then reconnecting the streams.
-	* 2. The mc stream connections that exist, that are no longer valid are removed.
+	*	 The sequences of entities that are not connected to each other run concurrently.
+	* 2. The mc masters each entity leaves and joins are computed (computeMediaClockMappingDiff). Entities whose mc masters did not change are not touched.
+	*	 Steps 3 and 4 are queued per entity, only waiting for the steps of the entities sharing one of the involved mc masters.
+	* 3. The mc stream connections that exist, that are no longer valid are removed.
 	*	 When an entity is now in the unassigned list, it's clock source is set to external.
-	* 3. All new mc stream connections needed to fullfil the new domain model are created.
+	* 4. All new mc stream connections needed to fullfil the new domain model are created.
 	*    Also the clock sources are changed according to the new model in this step. Domain masters clock source is set to internal, domain slaves to input stream.
 	*
 	* @param domains The mapping to apply.
 	*/
-	virtual void applyMediaClockDomainModel(MCEntityDomainMapping const& domains) noexcept
+	virtual ApplyID applyMediaClockDomainModel(MCEntityDomainMapping const& domains) noexcept
 	{
+		auto const applyId = ++_lastApplyId;
+
 		// change all configurations according to the given model.
 		// only apply changes
 
 		auto oldDomainModel = createMediaClockDomainModel();
 		MCEntityDomainMapping newDomainModel(domains);
-		std::vector<commandChain::AsyncParallelCommandSet*> commands;
+		_applyStatuses.clear();
 
 		// apply sample rates
 		// this is done first, because otherwise changes would be overwritten.
@@ -457,121 +951,233 @@ private:
 					auto commandsRemoveOutputStreams = removeAllStreamOutputConnections(entityId, outputStreamConnections);
 					commandsRemoveAllConnections->append(commandsRemoveOutputStreams);
 					auto commandsRemoveInputStreams = removeAllStreamInputConnections(entityId, inputStreamConnections);
-					commandsRemoveAllConnections->append(commandsRemoveInputStreams);
+					commandsRemoveAllConnections->append(entityId, commandsRemoveInputStreams);
 
-					auto* commandsSetSamplingRate = new commandChain::AsyncParallelCommandSet(adjustAudioUnitSampleRates(entityId, targetSampleRate));
+					auto* commandsSetSamplingRate = new commandChain::AsyncParallelCommandSet;
+					commandsSetSamplingRate->append(entityId, adjustAudioUnitSampleRates(entityId, targetSampleRate));
 
 					auto* commandsRestoreAllConnections = new commandChain::AsyncParallelCommandSet;
 					auto commandsRestoreOutputStreams = restoreOutputStreamConnections(entityId, outputStreamConnections);
 					commandsRestoreAllConnections->append(commandsRestoreOutputStreams);
 					auto commandsRestoreInputStreams = restoreInputStreamConnections(entityId, inputStreamConnections);
-					commandsRestoreAllConnections->append(commandsRestoreInputStreams);
+					commandsRestoreAllConnections->append(entityId, commandsRestoreInputStreams);
 
-					commands.push_back(commandsRemoveAllConnections);
-					commands.push_back(commandsSetSamplingRate);
-					commands.push_back(commandsRestoreAllConnections);
+					// the sample rate change of an entity only has to wait for the ones of the entities it is connected to
+					auto involvedEntities = commandChain::AsyncCommandGraphExecuter::Resources{ entityId };
+					for (auto const& connection : outputStreamConnections)
+					{
+						involvedEntities.insert(connection.listenerStream.entityID);
+					}
+					for (auto const& connection : inputStreamConnections)
+					{
+						involvedEntities.insert(connection.talkerStream.entityID);
+					}
+					addApplyCommandSet(entityId, commandsRemoveAllConnections, involvedEntities);
+					addApplyCommandSet(entityId, commandsSetSamplingRate, involvedEntities);
+					addApplyCommandSet(entityId, commandsRestoreAllConnections, involvedEntities);
 				}
 			}
 		}
 
-		// disconnect
-		auto* commandsRemoveOldMappingConnections = new commandChain::AsyncParallelCommandSet;
-		for (const auto& entityKV : newDomainModel.getEntityMediaClockMasterMappings())
+		// only the entities whose mc masters changed are touched, each one with its own disconnect and connect command sets
+		// so that the ones of unrelated entities are not waiting for each other
+		for (auto const& diffKV : computeMediaClockMappingDiff(oldDomainModel, newDomainModel))
 		{
-			if (!(entityKV.second.empty() && oldDomainModel.getEntityMediaClockMasterMappings().find(entityKV.first)->second.empty()))
+			auto const& entityId = diffKV.first;
+			auto const& diff = diffKV.second;
+
+			// disconnect
+			auto* commandsRemoveOldMappingConnections = new commandChain::AsyncParallelCommandSet;
+			auto disconnectResources = commandChain::AsyncCommandGraphExecuter::Resources{ entityId };
+			for (auto const& removedMasterId : diff.removedMasters)
+			{
+				disconnectResources.insert(removedMasterId);
+				if (entityId != removedMasterId)
+				{
+					// no longer existant, remove mc stream connection
+					auto commandsRemoveClockStreamConnection = removeClockStreamConnection(removedMasterId, entityId);
+					commandsRemoveOldMappingConnections->append(entityId, commandsRemoveClockStreamConnection);
+				}
+				else if (diff.newMasterCount == 1 && diff.oldMasterCount > 1)
+				{
+					// the entity is the mc master of the domain
+					// set it's clock source to internal
+					auto command = setEntityClockToCRFInputStream(entityId, 0);
+					commandsRemoveOldMappingConnections->append(entityId, command);
+				}
+			}
+
+			// if it's unassigned now set the clock source to external
+			if (diff.newMasterCount == 0)
+			{
+				auto command = setEntityClockToExternal(entityId, 0);
+				commandsRemoveOldMappingConnections->append(entityId, command);
+			}
+
+			// connect
+			auto* commandsSetupNewMappingConnections = new commandChain::AsyncParallelCommandSet;
+			auto connectResources = commandChain::AsyncCommandGraphExecuter::Resources{ entityId };
+			for (auto const& addedMasterId : diff.addedMasters)
 			{
-				// check if they are different (by checking if the mc master is the same):
-				for (auto domainIndexOld : oldDomainModel.getEntityMediaClockMasterMappings().find(entityKV.first)->second)
+				connectResources.insert(addedMasterId);
+				if (addedMasterId != entityId)
 				{
-					bool removed = true;
-					for (auto domainIndexNew : newDomainModel.getEntityMediaClockMasterMappings().find(entityKV.first)->second)
+					if (diff.newMasterCount == 1)
 					{
-						if (newDomainModel.getMediaClockDomains().find(domainIndexNew)->second.getMediaClockDomainMaster() == oldDomainModel.getMediaClockDomains().find(domainIndexOld)->second.getMediaClockDomainMaster())
-						{
-							removed = false;
-							break;
-						}
+						// set the clock source to crf input stream for clock domain at index 0
+						auto commandToExternal = setEntityClockToCRFInputStream(entityId, 0);
+						commandsSetupNewMappingConnections->append(entityId, commandToExternal);
 					}
 
-					if (removed)
+					// the entity is not the mc master
+					// create a clock channel connection.
+					auto commandsCreateConnection = createClockStreamConnection(addedMasterId, entityId);
+					commandsSetupNewMappingConnections->append(entityId, commandsCreateConnection);
+				}
+				else
+				{
+					// the added entity is the mc master of the domain
+					// set it's clock source to internal
+					auto command = setEntityClockToInternal(entityId, 0);
+					commandsSetupNewMappingConnections->append(entityId, command);
+				}
+			}
+
+			addApplyCommandSet(entityId, commandsRemoveOldMappingConnections, disconnectResources);
+			addApplyCommandSet(entityId, commandsSetupNewMappingConnections, connectResources);
+		}
+
+		for (auto const& statusKV : _applyStatuses)
+		{
+			emit applyMediaClockDomainModelEntityStatusChanged(statusKV.second);
+		}
+
+		// lock all the configured entities for the whole apply, so other controllers cannot change them halfway
+		auto lockedEntities = ControllerManager::EntityIDs{};
+		for (auto const& statusKV : _applyStatuses)
+		{
+			lockedEntities.push_back(statusKV.first);
+		}
+		ControllerManager::getInstance().requestExclusiveAccesses(lockedEntities, la::avdecc::controller::Controller::ExclusiveAccessToken::AccessType::Lock,
+			[this, applyId](ControllerManager::ExclusiveAccessGroupPointer const& group, ControllerManager::ExclusiveAccessFailures const& failures)
+			{
+				QMetaObject::invokeMethod(this,
+					[this, applyId, group, failures]()
 					{
-						if (entityKV.first != oldDomainModel.getMediaClockDomains().find(domainIndexOld)->second.getMediaClockDomainMaster())
+						if (!group)
 						{
-							// no longer existant, remove mc stream connection
-							auto commandsRemoveClockStreamConnection = removeClockStreamConnection(oldDomainModel.getMediaClockDomains().find(domainIndexOld)->second.getMediaClockDomainMaster(), entityKV.first);
-							commandsRemoveOldMappingConnections->append(commandsRemoveClockStreamConnection);
-						}
-						else
-						{
-							if (newDomainModel.getEntityMediaClockMasterMappings().find(entityKV.first)->second.size() == 1 && oldDomainModel.getEntityMediaClockMasterMappings().find(entityKV.first)->second.size() > 1)
+							_acmpCommandExecuter.clear();
+
+							ApplyInfo info;
+							info.applyId = applyId;
+							for (auto const& [entityId, status] : failures)
 							{
-								// the entity is the mc master of the domain
-								// set it's clock source to internal
-								auto command = setEntityClockToCRFInputStream(entityKV.first, 0);
-								commandsRemoveOldMappingConnections->append(command);
+								info.entityApplyErrors.emplace(entityId, commandChain::CommandErrorInfo{ commandChain::AsyncParallelCommandSet::aemCommandStatusToCommandError(status), std::nullopt, ControllerManager::AecpCommandType::LockEntity });
 							}
+							emit applyMediaClockDomainModelFinished(info);
+							return;
 						}
-					}
+
+						// execute the command graph
+						_applyExclusiveAccess = group;
+						_acmpCommandExecuter.start();
+					});
+			});
+
+		return applyId;
+	}
+
+	/**
+	* Adds a command set of the apply to the command graph, its progress and errors being reported for the given entity.
+	*/
+	void addApplyCommandSet(la::avdecc::UniqueIdentifier const entityId, commandChain::AsyncParallelCommandSet* const commandSet, commandChain::AsyncCommandGraphExecuter::Resources const& resources) noexcept
+	{
+		auto& status = _applyStatuses[entityId];
+		status.entityId = entityId;
+		status.totalCommands += static_cast<std::uint32_t>(commandSet->parallelCommandCount());
+
+		// commands may complete in the avdecc thread, these connections are then queued to the UI thread
+		connect(commandSet, &commandChain::AsyncParallelCommandSet::commandCompleted, this,
+			[this, entityId](uint32_t const /*commandIndex*/, bool const /*error*/)
+			{
+				auto& status = _applyStatuses[entityId];
+				++status.completedCommands;
+				emit applyMediaClockDomainModelEntityStatusChanged(status);
+			});
+		connect(commandSet, &commandChain::AsyncParallelCommandSet::commandSetCompleted, this,
+			[this, entityId](commandChain::CommandExecutionErrors const errors)
+			{
+				if (!errors.empty())
+				{
+					auto& status = _applyStatuses[entityId];
+					status.errors.insert(errors.begin(), errors.end());
+					emit applyMediaClockDomainModelEntityStatusChanged(status);
 				}
+			});
 
-				// if it's unassigned now set the clock source to external
-				if (newDomainModel.getEntityMediaClockMasterMappings().at(entityKV.first).empty())
+		_acmpCommandExecuter.addCommandSet(commandSet, resources);
+	}
+
+	/**
+	* Gets the mc masters of the domains an entity is assigned to, in the domains order of the entity.
+	*/
+	static std::vector<la::avdecc::UniqueIdentifier> getMediaClockMastersOfEntity(MCEntityDomainMapping& domainModel, la::avdecc::UniqueIdentifier const entityId) noexcept
+	{
+		auto masters = std::vector<la::avdecc::UniqueIdentifier>{};
+		auto const& mappings = domainModel.getEntityMediaClockMasterMappings();
+		auto const& domains = domainModel.getMediaClockDomains();
+		auto const mappingIt = mappings.find(entityId);
+		if (mappingIt != mappings.end())
+		{
+			for (auto const domainIndex : mappingIt->second)
+			{
+				auto const domainIt = domains.find(domainIndex);
+				if (domainIt != domains.end())
 				{
-					auto command = setEntityClockToExternal(entityKV.first, 0);
-					commandsRemoveOldMappingConnections->append(command);
+					masters.push_back(domainIt->second.getMediaClockDomainMaster());
 				}
 			}
 		}
-		commands.push_back(commandsRemoveOldMappingConnections);
+		return masters;
+	}
 
-		// connect
-		auto* commandsSetupNewMappingConnections = new commandChain::AsyncParallelCommandSet;
-		for (const auto& entityKV : newDomainModel.getEntityMediaClockMasterMappings())
+	/**
+	* Computes, for each entity of the new domain model, the mc masters it leaves and joins compared to the old domain model.
+	* Entities whose mc masters did not change are not part of the result.
+	*/
+	static MediaClockMappingDiffs computeMediaClockMappingDiff(MCEntityDomainMapping& oldDomainModel, MCEntityDomainMapping& newDomainModel) noexcept
+	{
+		auto diffs = MediaClockMappingDiffs{};
+		for (auto const& entityKV : newDomainModel.getEntityMediaClockMasterMappings())
 		{
-			for (auto domainIndexNew : entityKV.second)
+			auto const& entityId = entityKV.first;
+			auto const oldMasters = getMediaClockMastersOfEntity(oldDomainModel, entityId);
+			auto const newMasters = getMediaClockMastersOfEntity(newDomainModel, entityId);
+
+			auto diff = MediaClockMappingDiff{};
+			diff.oldMasterCount = oldMasters.size();
+			diff.newMasterCount = newMasters.size();
+			for (auto const& masterId : oldMasters)
+			{
+				if (std::find(newMasters.begin(), newMasters.end(), masterId) == newMasters.end())
+				{
+					diff.removedMasters.push_back(masterId);
+				}
+			}
+			for (auto const& masterId : newMasters)
 			{
-				bool added = true;
-				for (auto domainIndexOld : oldDomainModel.getEntityMediaClockMasterMappings().find(entityKV.first)->second)
+				if (std::find(oldMasters.begin(), oldMasters.end(), masterId) == oldMasters.end())
 				{
-					if (newDomainModel.getMediaClockDomains().find(domainIndexNew)->second.getMediaClockDomainMaster() == oldDomainModel.getMediaClockDomains().find(domainIndexOld)->second.getMediaClockDomainMaster())
-					{
-						added = false;
-						break;
-					}
+					diff.addedMasters.push_back(masterId);
 				}
+			}
 
-				if (added) // the entity was not in this domain before
-				{
-					if (newDomainModel.getMediaClockDomains().find(domainIndexNew)->second.getMediaClockDomainMaster() != entityKV.first)
-					{
-						if (newDomainModel.getEntityMediaClockMasterMappings().find(entityKV.first)->second.size() == 1)
-						{
-							// set the clock source to crf input stream for clock domain at index 0
-							auto commandToExternal = setEntityClockToCRFInputStream(entityKV.first, 0);
-							commandsSetupNewMappingConnections->append(commandToExternal);
-						}
-
-						// the entity is not the mc master
-						// create a clock channel connection.
-						auto commandsCreateConnection = createClockStreamConnection(newDomainModel.getMediaClockDomains().find(domainIndexNew)->second.getMediaClockDomainMaster(), entityKV.first);
-						commandsSetupNewMappingConnections->append(commandsCreateConnection);
-					}
-					else
-					{
-						// the added entity is the mc master of the domain
-						// set it's clock source to internal
-						auto command = setEntityClockToInternal(entityKV.first, 0);
-						commandsSetupNewMappingConnections->append(command);
-					}
-				}
+			if (!diff.removedMasters.empty() || !diff.addedMasters.empty())
+			{
+				diffs.emplace(entityId, std::move(diff));
 			}
 		}
-
-		commands.push_back(commandsSetupNewMappingConnections);
-		ApplyInfo info;
-		// execute the command chain
-		_sequentialAcmpCommandExecuter.setCommandChain(commands);
-		_sequentialAcmpCommandExecuter.start();
+		return diffs;
 	}
 
 	/**
@@ -853,8 +1459,8 @@ private:
 			{
 				auto const& sourceConfigNode = controlledSourceEntity->getCurrentConfigurationNode();
 				auto const& targetConfigNode = controlledTargetEntity->getCurrentConfigurationNode();
-				auto const outputClockStreamIndexes = findOutputClockStreamIndexInConfiguration(sourceConfigNode);
-				auto const inputClockStreamIndexes = findInputClockStreamIndexInConfiguration(targetConfigNode);
+				auto const outputClockStreamIndexes = getClockStreamIndexes(entityIdSource, sourceConfigNode).outputs;
+				auto const inputClockStreamIndexes = getClockStreamIndexes(entityIdTarget, targetConfigNode).inputs;
 				if (!outputClockStreamIndexes.empty() && !inputClockStreamIndexes.empty())
 				{
 					// disconnect every connection (also redundant) that are used for clocking
@@ -952,8 +1558,8 @@ private:
 			{
 				auto const& sourceConfigNode = controlledSourceEntity->getCurrentConfigurationNode();
 				auto const& targetConfigNode = controlledTargetEntity->getCurrentConfigurationNode();
-				auto const outputClockStreamIndexes = findOutputClockStreamIndexInConfiguration(sourceConfigNode);
-				auto const inputClockStreamIndexes = findInputClockStreamIndexInConfiguration(targetConfigNode);
+				auto const outputClockStreamIndexes = getClockStreamIndexes(entityIdSource, sourceConfigNode).outputs;
+				auto const inputClockStreamIndexes = getClockStreamIndexes(entityIdTarget, targetConfigNode).inputs;
 				if (!outputClockStreamIndexes.empty() && !inputClockStreamIndexes.empty())
 				{
 					// disconnect every connection (also redundant) that are used for clocking
@@ -1106,12 +1712,42 @@ private:
 	}
 
 
+	/**
+	* Gets the clock stream indexes of a configuration of an entity, the configuration being only scanned the first time.
+	* @param entityId The id of the entity.
+	* @param config The configuration node of the entity.
+	*/
+	ClockStreamIndexes const& getClockStreamIndexes(la::avdecc::UniqueIdentifier const entityId, la::avdecc::controller::model::ConfigurationNode const& config) const noexcept
+	{
+		auto const key = std::make_pair(entityId, config.descriptorIndex);
+		auto indexesIt = _clockStreamIndexes.find(key);
+		if (indexesIt == _clockStreamIndexes.end())
+		{
+			indexesIt = _clockStreamIndexes.emplace(key, ClockStreamIndexes{ findOutputClockStreamIndexInConfiguration(config), findInputClockStreamIndexInConfiguration(config) }).first;
+		}
+		return indexesIt->second;
+	}
+
+	/**
+	* Forgets the clock stream indexes of all the configurations of an entity.
+	*/
+	void invalidateClockStreamIndexes(la::avdecc::UniqueIdentifier const entityId) noexcept
+	{
+		auto const first = _clockStreamIndexes.lower_bound(std::make_pair(entityId, la::avdecc::entity::model::ConfigurationIndex{ 0u }));
+		auto last = first;
+		while (last != _clockStreamIndexes.end() && last->first.first == entityId)
+		{
+			++last;
+		}
+		_clockStreamIndexes.erase(first, last);
+	}
+
 	/**
 	* Determines the stream index (output) of the clock stream on the given configuration.
 	* @param config The configuration node to search through.
 	* @return		The index of the stream.
 	*/
-	virtual std::vector<la::avdecc::entity::model::StreamIndex> findOutputClockStreamIndexInConfiguration(la::avdecc::controller::model::ConfigurationNode const& config) const noexcept
+	static std::vector<la::avdecc::entity::model::StreamIndex> findOutputClockStreamIndexInConfiguration(la::avdecc::controller::model::ConfigurationNode const& config) noexcept
 	{
 		std::vector<la::avdecc::entity::model::StreamIndex> streamIndexes;
 		for (auto const& streamOutput : config.redundantStreamOutputs)
@@ -1164,7 +1800,7 @@ private:
 	* @param config The configuration node to search through.
 	* @return		The index of the stream.
 	*/
-	virtual std::vector<la::avdecc::entity::model::StreamIndex> findInputClockStreamIndexInConfiguration(la::avdecc::controller::model::ConfigurationNode const& config) const noexcept
+	static std::vector<la::avdecc::entity::model::StreamIndex> findInputClockStreamIndexInConfiguration(la::avdecc::controller::model::ConfigurationNode const& config) noexcept
 	{
 		std::vector<la::avdecc::entity::model::StreamIndex> streamIndexes;
 		for (auto const& streamInput : config.redundantStreamInputs)
@@ -1220,7 +1856,9 @@ private:
 		// get the mc clock connection of this entity, then check it's gptp mc id and compare it with the gptp id of the entity.
 		auto const& manager = avdecc::ControllerManager::getInstance();
 
-		auto const talkerEntity = manager.getControlledEntity(findMediaClockMaster(entityId).first);
+		// known entities are resolved from the cached clock chains, this is called when painting the views
+		auto const mediaClockMasterId = _entities.count(entityId) != 0 ? resolveClockChain(entityId).first : findMediaClockMaster(entityId).first;
+		auto const talkerEntity = manager.getControlledEntity(mediaClockMasterId);
 		auto const listenerEntity = manager.getControlledEntity(entityId);
 
 		if (talkerEntity && listenerEntity)
@@ -1253,42 +1891,21 @@ private:
 	}
 
 	/**
-	* Iterates over the list of known entities and returns all connections that originate from the given talker.
+	* Returns all connections that originate from the given talker (lookup in the stream connections index).
 	*/
-	std::vector<la::avdecc::entity::model::StreamConnectionState> getAllStreamOutputConnections(la::avdecc::UniqueIdentifier const talkerEntityId)
+	std::vector<la::avdecc::entity::model::StreamConnectionState> getAllStreamOutputConnections(la::avdecc::UniqueIdentifier const talkerEntityId) const noexcept
 	{
-		std::vector<la::avdecc::entity::model::StreamConnectionState> disconnectedStreams;
-		auto const& manager = avdecc::ControllerManager::getInstance();
-		for (auto const& potentialListenerEntityId : _entities)
+		auto connections = std::vector<la::avdecc::entity::model::StreamConnectionState>{};
+		auto const talkerIt = _talkerStreamConnections.find(talkerEntityId);
+		if (talkerIt != _talkerStreamConnections.end())
 		{
-			auto const controlledEntity = manager.getControlledEntity(potentialListenerEntityId);
-			if (controlledEntity)
+			connections.reserve(talkerIt->second.size());
+			for (auto const& listenerStreamKV : talkerIt->second)
 			{
-				if (!controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
-				{
-					continue;
-				}
-				try
-				{
-					auto const& configNode = controlledEntity->getCurrentConfigurationNode();
-					for (auto const& streamInput : configNode.streamInputs)
-					{
-						auto* streamInputDynamicModel = streamInput.second.dynamicModel;
-						if (streamInputDynamicModel)
-						{
-							if (streamInputDynamicModel->connectionState.talkerStream.entityID == talkerEntityId)
-							{
-								disconnectedStreams.push_back(streamInputDynamicModel->connectionState);
-							}
-						}
-					}
-				}
-				catch (la::avdecc::controller::ControlledEntity::Exception const&)
-				{
-				}
+				connections.push_back(listenerStreamKV.second);
 			}
 		}
-		return disconnectedStreams;
+		return connections;
 	}
 
 	/**
@@ -1631,54 +2248,330 @@ private:
 	}
 
 	/**
-	* Compares the current mc mapping state with the previous one and
-	* emits the mediaClockConnectionsUpdate to inform the views about changes.
+	* Updates the clock dependency graph for the given entities, resolves again the mc masters of the entities depending on them and
+	* has the worker build a new domain model. The mediaClockConnectionsUpdate is emitted with the entities whose mc master (or error) changed once it is published.
 	*/
-	void notifyChanges() noexcept
+	void notifyChanges(std::set<la::avdecc::UniqueIdentifier> const& changedEntities) noexcept
 	{
-		// potentially changes every other entity...
-		std::vector<la::avdecc::UniqueIdentifier> changes;
-		auto currentMCDomainMapping = createMediaClockDomainModel();
-		auto& currentMCDomains = currentMCDomainMapping.getMediaClockDomains();
-		auto& previousMCDomainMapping = _currentMCDomainMapping;
-		auto const& previousMCMasterMappings = previousMCDomainMapping.getEntityMediaClockMasterMappings();
-		auto const& previousMCDomains = previousMCDomainMapping.getMediaClockDomains();
-		auto const& previousErrors = previousMCDomainMapping.getEntityMcErrors();
-		auto const& currentErrors = currentMCDomainMapping.getEntityMcErrors();
+		HIVE_TRACE_SPAN("MCDomainManager::notifyChanges");
+		auto changedSteps = std::set<la::avdecc::UniqueIdentifier>{};
+		for (auto const& entityId : changedEntities)
+		{
+			if (updateClockSteps(entityId))
+			{
+				changedSteps.insert(entityId);
+			}
+		}
+		if (changedSteps.empty())
+		{
+			return;
+		}
 
-		for (auto const& entityDomainKV : currentMCDomainMapping.getEntityMediaClockMasterMappings())
+		// only the downstream entities of the changed steps can have a different mc master
+		std::vector<la::avdecc::UniqueIdentifier> changes;
+		for (auto const& entityId : collectClockDependents(changedSteps))
 		{
-			auto const entityId = entityDomainKV.first;
-			auto const oldDomainIndexesIterator = previousMCMasterMappings.find(entityId);
-			if (oldDomainIndexesIterator != previousMCMasterMappings.end())
+			if (_entities.count(entityId) == 0)
 			{
-				if (checkMcMasterOfEntityChanged(oldDomainIndexesIterator->second, entityDomainKV.second, previousMCDomains, currentMCDomains))
-				{
-					changes.push_back(entityId);
-				}
-				else if ((previousErrors.count(entityId) > 0 && currentErrors.count(entityId) > 0 && previousErrors.at(entityId) != currentErrors.at(entityId)) || previousErrors.count(entityId) != currentErrors.count(entityId))
-				{
-					// if the error type changed add the entity to the changes list as well.
-					changes.push_back(entityId);
-				}
+				_resolvedMediaClockMasters.erase(entityId);
+				continue;
 			}
-			else
+
+			auto resolved = resolveMediaClockMasters(entityId);
+			auto const previousIt = _resolvedMediaClockMasters.find(entityId);
+			if (previousIt == _resolvedMediaClockMasters.end())
 			{
 				// if it wasn't there before, it changed.
 				changes.push_back(entityId);
+				_resolvedMediaClockMasters.emplace(entityId, std::move(resolved));
+			}
+			else if (previousIt->second != resolved)
+			{
+				changes.push_back(entityId);
+				previousIt->second = std::move(resolved);
 			}
 		}
 
 		// Update the model
-		_currentMCDomainMapping = std::move(currentMCDomainMapping);
+		_unpublishedChanges.insert(_unpublishedChanges.end(), changes.begin(), changes.end());
+		requestDomainModelBuild();
+	}
+
+	/**
+	* Starts building a domain model from the current state on the worker, or flags the model as outdated if a build is already running.
+	*/
+	void requestDomainModelBuild() noexcept
+	{
+		if (_isBuildingDomainModel)
+		{
+			_isDomainModelOutdated = true;
+			return;
+		}
+
+		auto inputs = DomainModelInputs{};
+		inputs.entityIds.assign(_entities.begin(), _entities.end());
+		for (auto const& entityId : _entities)
+		{
+			auto const resolvedIt = _resolvedMediaClockMasters.find(entityId);
+			if (resolvedIt != _resolvedMediaClockMasters.end())
+			{
+				inputs.resolvedMediaClockMasters.emplace(entityId, resolvedIt->second);
+			}
+		}
+		inputs.sampleRates = captureSampleRates();
+		inputs.changes = std::move(_unpublishedChanges);
+		_unpublishedChanges.clear();
+
+		_isBuildingDomainModel = true;
+		_isDomainModelOutdated = false;
+		_domainModelWorker.start(new DomainModelTask{
+			[this, generation = _domainModelGeneration, inputs = std::move(inputs)]()
+			{
+				auto domainModel = std::make_shared<MCEntityDomainMapping const>(buildMediaClockDomainModel(
+					inputs.entityIds,
+					[&inputs](la::avdecc::UniqueIdentifier const entityId, bool const searchForSecondaryMcMaster)
+					{
+						auto const resolvedIt = inputs.resolvedMediaClockMasters.find(entityId);
+						if (resolvedIt == inputs.resolvedMediaClockMasters.end())
+						{
+							return MediaClockMasterResult{ la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), McDeterminationError::UnknownEntity };
+						}
+						return searchForSecondaryMcMaster ? resolvedIt->second.secondary : resolvedIt->second.primary;
+					},
+					inputs.sampleRates));
+
+				// Publish from the Qt Main Thread
+				QMetaObject::invokeMethod(this,
+					[this, generation, domainModel = std::move(domainModel), changes = inputs.changes]()
+					{
+						publishDomainModel(generation, domainModel, changes);
+					});
+			} });
+	}
+
+	/**
+	* Publishes a domain model built by the worker and notifies the view, then starts another build if the clock graph changed in the meantime.
+	*/
+	void publishDomainModel(std::uint64_t const generation, SharedConstDomainModel const& domainModel, std::vector<la::avdecc::UniqueIdentifier> const& changes) noexcept
+	{
+		_isBuildingDomainModel = false;
+
+		// Built for a previous controller
+		if (generation == _domainModelGeneration)
+		{
+			std::atomic_store(&_publishedMCDomainMapping, domainModel);
+
+			// Notify the view
+			if (!changes.empty())
+			{
+				emit mediaClockConnectionsUpdate(changes);
+			}
+		}
+
+		if (_isDomainModelOutdated)
+		{
+			requestDomainModelBuild();
+		}
+	}
+
+
+	// Stream connections index
+	/**
+	* Removes the index entry of a listener stream, if any.
+	*/
+	void removeIndexedStreamConnection(ListenerStreamKey const& listenerStream) noexcept
+	{
+		auto const listenerStreamIt = _listenerStreamTalkers.find(listenerStream);
+		if (listenerStreamIt == _listenerStreamTalkers.end())
+		{
+			return;
+		}
+
+		auto const talkerIt = _talkerStreamConnections.find(listenerStreamIt->second);
+		if (talkerIt != _talkerStreamConnections.end())
+		{
+			talkerIt->second.erase(listenerStream);
+			if (talkerIt->second.empty())
+			{
+				_talkerStreamConnections.erase(talkerIt);
+			}
+		}
+		_listenerStreamTalkers.erase(listenerStreamIt);
+	}
+
+	/**
+	* Updates the index entry of a listener stream with its new connection state.
+	*/
+	void updateIndexedStreamConnection(la::avdecc::entity::model::StreamConnectionState const& streamConnectionState) noexcept
+	{
+		auto const listenerStream = ListenerStreamKey{ streamConnectionState.listenerStream.entityID, streamConnectionState.listenerStream.streamIndex };
+		auto const& talkerEntityId = streamConnectionState.talkerStream.entityID;
+
+		removeIndexedStreamConnection(listenerStream);
+
+		_talkerStreamConnections[talkerEntityId][listenerStream] = streamConnectionState;
+		_listenerStreamTalkers.emplace(listenerStream, talkerEntityId);
+	}
+
+	/**
+	* Indexes the current connection state of all stream inputs of an entity.
+	*/
+	void indexEntityStreamInputs(la::avdecc::UniqueIdentifier const entityId) noexcept
+	{
+		auto const& manager = avdecc::ControllerManager::getInstance();
+		auto const controlledEntity = manager.getControlledEntity(entityId);
+		if (!controlledEntity || !controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+		{
+			return;
+		}
+
+		try
+		{
+			for (auto const& streamInput : controlledEntity->getCurrentConfigurationNode().streamInputs)
+			{
+				auto const* const streamInputDynamicModel = streamInput.second.dynamicModel;
+				if (streamInputDynamicModel)
+				{
+					updateIndexedStreamConnection(streamInputDynamicModel->connectionState);
+				}
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+	}
+
+	/**
+	* Removes all index entries of the stream inputs of an entity.
+	*/
+	void unindexEntityStreamInputs(la::avdecc::UniqueIdentifier const entityId) noexcept
+	{
+		auto listenerStreams = std::vector<ListenerStreamKey>{};
+		for (auto it = _listenerStreamTalkers.lower_bound({ entityId, la::avdecc::entity::model::StreamIndex{ 0u } }); it != _listenerStreamTalkers.end() && it->first.first == entityId; ++it)
+		{
+			listenerStreams.push_back(it->first);
+		}
+		for (auto const& listenerStream : listenerStreams)
+		{
+			removeIndexedStreamConnection(listenerStream);
+		}
+	}
+
+	// Clock sources table
+	/**
+	* Gets what the clock chain needs from a clock source of an entity, nullopt if the clock source is unknown.
+	*/
+	static std::optional<ActiveClockSource> getActiveClockSource(la::avdecc::controller::ControlledEntity const& controlledEntity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex) noexcept
+	{
+		try
+		{
+			auto const* const staticModel = controlledEntity.getClockSourceNode(configurationIndex, clockSourceIndex).staticModel;
+			if (staticModel)
+			{
+				return ActiveClockSource{ staticModel->clockSourceType, staticModel->clockSourceLocationType, staticModel->clockSourceLocationIndex };
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+		return std::nullopt;
+	}
+
+	/**
+	* Builds the clock source table of an entity from its current configuration.
+	*/
+	void indexEntityClockSources(la::avdecc::UniqueIdentifier const entityId) noexcept
+	{
+		_clockSourceTables.erase(entityId);
+
+		auto const& manager = avdecc::ControllerManager::getInstance();
+		auto const controlledEntity = manager.getControlledEntity(entityId);
+		if (!controlledEntity || !controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+		{
+			return;
+		}
+
+		try
+		{
+			auto const& configNode = controlledEntity->getCurrentConfigurationNode();
+			auto table = ClockSourceTable{ configNode.descriptorIndex };
+			for (auto const& [clockDomainIndex, clockDomainNode] : configNode.clockDomains)
+			{
+				auto& activeClockSource = table.activeClockSources[clockDomainIndex];
+				if (clockDomainNode.dynamicModel)
+				{
+					activeClockSource = getActiveClockSource(*controlledEntity, configNode.descriptorIndex, clockDomainNode.dynamicModel->clockSourceIndex);
+				}
+			}
+			_clockSourceTables.emplace(entityId, std::move(table));
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+	}
 
-		// Notify the view
-		if (!changes.empty())
+	/**
+	* Updates the active clock source of a clock domain in the table of an entity.
+	*/
+	void updateActiveClockSource(la::avdecc::UniqueIdentifier const entityId, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex) noexcept
+	{
+		auto const tableIt = _clockSourceTables.find(entityId);
+		if (tableIt == _clockSourceTables.end())
 		{
-			emit mediaClockConnectionsUpdate(changes);
+			return;
 		}
+
+		auto const& manager = avdecc::ControllerManager::getInstance();
+		auto const controlledEntity = manager.getControlledEntity(entityId);
+		auto& table = tableIt->second;
+		table.activeClockSources[clockDomainIndex] = controlledEntity ? getActiveClockSource(*controlledEntity, table.configurationIndex, clockSourceIndex) : std::nullopt;
 	}
 
+	/**
+	* Tells if a listener stream is the one determineClockStep follows (primary or secondary search), from the clock source table of the entity.
+	* Conservative: true whenever it cannot be told without the entity model.
+	*/
+	bool isClockStream(ListenerStreamKey const& listenerStream) const noexcept
+	{
+		auto const tableIt = _clockSourceTables.find(listenerStream.first);
+		if (tableIt == _clockSourceTables.end())
+		{
+			return true;
+		}
+
+		// Entities not having exactly one clock domain are not supported, whatever their connections
+		auto const& table = tableIt->second;
+		if (table.activeClockSources.size() != 1)
+		{
+			return false;
+		}
+
+		auto const& activeClockSource = table.activeClockSources.begin()->second;
+		if (!activeClockSource)
+		{
+			return true;
+		}
+
+		switch (activeClockSource->type)
+		{
+			case la::avdecc::entity::model::ClockSourceType::InputStream:
+				return activeClockSource->locationType == la::avdecc::entity::model::DescriptorType::StreamInput && activeClockSource->locationIndex == listenerStream.second;
+			case la::avdecc::entity::model::ClockSourceType::Internal:
+			{
+				// The secondary search follows the first clock input stream, only known once the configuration was scanned
+				auto const indexesIt = _clockStreamIndexes.find(std::make_pair(listenerStream.first, table.configurationIndex));
+				if (indexesIt == _clockStreamIndexes.end())
+				{
+					return true;
+				}
+				auto const& inputs = indexesIt->second.inputs;
+				return !inputs.empty() && inputs.front() == listenerStream.second;
+			}
+			default:
+				// External and unsupported clock sources end the chain
+				return false;
+		}
+	}
 
 	// Slots
 
@@ -1688,7 +2581,19 @@ private:
 	void onControllerOffline()
 	{
 		_entities.clear();
-		notifyChanges();
+		_clockSteps.clear();
+		_clockListeners.clear();
+		_resolvedMediaClockMasters.clear();
+		_clockChainResults.clear();
+		_clockStreamIndexes.clear();
+		_clockSourceTables.clear();
+		_talkerStreamConnections.clear();
+		_listenerStreamTalkers.clear();
+		++_clockGraphGeneration;
+		++_domainModelGeneration;
+		_isDomainModelOutdated = false;
+		_unpublishedChanges.clear();
+		std::atomic_store(&_publishedMCDomainMapping, std::make_shared<MCEntityDomainMapping const>());
 	}
 
 	/**
@@ -1696,9 +2601,12 @@ private:
 	*/
 	void onEntityOnline(la::avdecc::UniqueIdentifier const& entityId)
 	{
-		// add entity to the set
+		// add entity to the set, its model was enumerated again
 		_entities.insert(entityId);
-		notifyChanges();
+		invalidateClockStreamIndexes(entityId);
+		indexEntityClockSources(entityId);
+		indexEntityStreamInputs(entityId);
+		notifyChanges({ entityId });
 	}
 
 	/**
@@ -1708,78 +2616,49 @@ private:
 	{
 		// remove entity from the set
 		_entities.erase(entityId);
-		notifyChanges();
+		invalidateClockStreamIndexes(entityId);
+		_clockSourceTables.erase(entityId);
+		unindexEntityStreamInputs(entityId);
+		notifyChanges({ entityId });
 	}
 
 	/**
-	* Handles the change of a clock source on a stream connection. Checks if the stream is a clock stream and if so emits the mediaClockConnectionsUpdate signal.
+	* Handles the change of a stream connection. Updates the stream connections index and, if the clock chain of the listener changed, emits the mediaClockConnectionsUpdate signal for the entities depending on it.
 	*/
 	void onStreamConnectionChanged(la::avdecc::entity::model::StreamConnectionState const& streamConnectionState)
 	{
-		auto affectsMcMaster = false;
-		auto& manager = avdecc::ControllerManager::getInstance();
-		auto const& controlledEntity = manager.getControlledEntity(streamConnectionState.listenerStream.entityID);
-		if (controlledEntity)
-		{
-			if (controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
-			{
-				try
-				{
-					auto const& configNode = controlledEntity->getCurrentConfigurationNode();
-					auto const activeConfigIndex = configNode.descriptorIndex;
-
-					// find out if the stream connection is set as clock source:
-					for (auto const& clockDomainKV : configNode.clockDomains)
-					{
-						auto const& clockDomain = clockDomainKV.second;
-						if (clockDomain.dynamicModel)
-						{
-							auto const clockSourceIndex = clockDomain.dynamicModel->clockSourceIndex;
-							auto const& activeClockSourceNode = controlledEntity->getClockSourceNode(activeConfigIndex, clockSourceIndex);
+		auto const listenerStream = ListenerStreamKey{ streamConnectionState.listenerStream.entityID, streamConnectionState.listenerStream.streamIndex };
 
-							if (!activeClockSourceNode.staticModel)
-							{
-								break;
-							}
-							switch (activeClockSourceNode.staticModel->clockSourceType)
-							{
-								case la::avdecc::entity::model::ClockSourceType::Internal:
-									break;
-								case la::avdecc::entity::model::ClockSourceType::External:
-								case la::avdecc::entity::model::ClockSourceType::InputStream:
-								{
-									if (streamConnectionState.listenerStream.streamIndex == activeClockSourceNode.staticModel->clockSourceLocationIndex)
-									{
-										affectsMcMaster = true;
-									}
-									break;
-								}
-								default: // Unsupported ClockSourceType, ignore it
-									break;
-							}
-						}
-					}
-				}
-				catch (la::avdecc::controller::ControlledEntity::Exception const&)
-				{
-					// ignore
-				}
-			}
+		// Online AEM entities are the ones with a clock source table, no need to lock the entity
+		if (_entities.count(listenerStream.first) == 0 || _clockSourceTables.count(listenerStream.first) == 0)
+		{
+			return;
 		}
 
-		if (affectsMcMaster)
+		updateIndexedStreamConnection(streamConnectionState);
+
+		// only the listener clock step can be affected, and only if it's its clock stream. The graph tells which entities depend on it
+		if (isClockStream(listenerStream))
 		{
-			// potentially changes every other entity...
-			notifyChanges();
+			notifyChanges({ listenerStream.first });
 		}
 	}
 
+	/**
+	* Handles the change of a stream format. Current formats are used when no stream supports a clock format, so the clock streams of the entity have to be found again.
+	*/
+	void onStreamFormatChanged(la::avdecc::UniqueIdentifier const entityId, la::avdecc::entity::model::DescriptorType const /*descriptorType*/, la::avdecc::entity::model::StreamIndex const /*streamIndex*/, la::avdecc::entity::model::StreamFormat const /*streamFormat*/)
+	{
+		invalidateClockStreamIndexes(entityId);
+	}
+
 	/**
 	* Handles the change of a clock source on an entity and emits resulting changes via the mediaClockConnectionsUpdate signal.
 	*/
-	void onClockSourceChanged(la::avdecc::UniqueIdentifier const /*entityId*/, la::avdecc::entity::model::ClockDomainIndex const /*clockDomainIndex*/, la::avdecc::entity::model::ClockSourceIndex const /*clockSourceIndex*/)
+	void onClockSourceChanged(la::avdecc::UniqueIdentifier const entityId, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex)
 	{
-		notifyChanges();
+		updateActiveClockSource(entityId, clockDomainIndex, clockSourceIndex);
+		notifyChanges({ entityId });
 	}
 
 	/**
@@ -1788,10 +2667,11 @@ private:
 	void onEntityNameChanged(la::avdecc::UniqueIdentifier const entityId, QString const& /*entityName*/)
 	{
 		std::vector<la::avdecc::UniqueIdentifier> changedEntities;
-		auto domainIndex = _currentMCDomainMapping.findDomainIndexByMasterEntityId(entityId);
+		auto const domainModel = getMediaClockDomainModel();
+		auto domainIndex = domainModel->findDomainIndexByMasterEntityId(entityId);
 		if (domainIndex)
 		{
-			for (auto const& entityMcMappingKV : _currentMCDomainMapping.getEntityMediaClockMasterMappings())
+			for (auto const& entityMcMappingKV : domainModel->getEntityMediaClockMasterMappings())
 			{
 				if (std::find(entityMcMappingKV.second.begin(), entityMcMappingKV.second.end(), *domainIndex) != entityMcMappingKV.second.end())
 				{
@@ -1907,7 +2787,7 @@ void MCDomain::setDomainSamplingRate(la::avdecc::entity::model::SamplingRate con
 * @param mediaClockMasterId The media clock master id.
 * @return The index of the domain which mc master matches the given id.
 */
-std::optional<DomainIndex> const MCEntityDomainMapping::findDomainIndexByMasterEntityId(la::avdecc::UniqueIdentifier const mediaClockMasterId) noexcept
+std::optional<DomainIndex> const MCEntityDomainMapping::findDomainIndexByMasterEntityId(la::avdecc::UniqueIdentifier const mediaClockMasterId) const noexcept
 {
 	for (auto const& mediaClockDomainKV : _mediaClockDomains)
 	{
@@ -1928,6 +2808,15 @@ MCEntityDomainMapping::Errors& MCEntityDomainMapping::getEntityMcErrors() noexce
 	return _entityMcErrors;
 }
 
+/**
+* Gets a const reference of the entity to mc determination error map.
+* @return Const reference of the _entityMcErrors field.
+*/
+MCEntityDomainMapping::Errors const& MCEntityDomainMapping::getEntityMcErrors() const noexcept
+{
+	return _entityMcErrors;
+}
+
 /**
 * Gets a reference of the entity to media clock index map.
 * @return Reference of the _entityMediaClockMasterMappings field.
@@ -1937,6 +2826,15 @@ MCEntityDomainMapping::Mappings& MCEntityDomainMapping::getEntityMediaClockMaste
 	return _entityMediaClockMasterMappings;
 }
 
+/**
+* Gets a const reference of the entity to media clock index map.
+* @return Const reference of the _entityMediaClockMasterMappings field.
+*/
+MCEntityDomainMapping::Mappings const& MCEntityDomainMapping::getEntityMediaClockMasterMappings() const noexcept
+{
+	return _entityMediaClockMasterMappings;
+}
+
 /**
 		* Gets a reference of the media clock domain map.
 		* @return Reference of the _mediaClockDomains field.
@@ -1946,6 +2844,15 @@ MCEntityDomainMapping::Domains& MCEntityDomainMapping::getMediaClockDomains() no
 	return _mediaClockDomains;
 }
 
+/**
+* Gets a const reference of the media clock domain map.
+* @return Const reference of the _mediaClockDomains field.
+*/
+MCEntityDomainMapping::Domains const& MCEntityDomainMapping::getMediaClockDomains() const noexcept
+{
+	return _mediaClockDomains;
+}
+
 
 } // namespace mediaClock
 } // namespace avdecc
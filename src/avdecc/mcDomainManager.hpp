@@ -21,6 +21,7 @@
 
 #include <la/avdecc/controller/avdeccController.hpp>
 #include <memory>
+#include <cstdint>
 #include <optional>
 #include <QObject>
 #include <QMap>
@@ -106,11 +107,14 @@ public:
 	MCEntityDomainMapping() noexcept;
 	MCEntityDomainMapping(Mappings&& mappings, Domains&& domains, Errors&& errors) noexcept;
 
-	std::optional<DomainIndex> const findDomainIndexByMasterEntityId(la::avdecc::UniqueIdentifier mediaClockMasterId) noexcept;
+	std::optional<DomainIndex> const findDomainIndexByMasterEntityId(la::avdecc::UniqueIdentifier mediaClockMasterId) const noexcept;
 
 	Mappings& getEntityMediaClockMasterMappings() noexcept;
+	Mappings const& getEntityMediaClockMasterMappings() const noexcept;
 	Domains& getMediaClockDomains() noexcept;
+	Domains const& getMediaClockDomains() const noexcept;
 	Errors& getEntityMcErrors() noexcept;
+	Errors const& getEntityMcErrors() const noexcept;
 
 	// Defaulted compiler auto-generated methods
 	MCEntityDomainMapping(MCEntityDomainMapping const&) = default;
@@ -124,11 +128,24 @@ private:
 	Errors _entityMcErrors{};
 };
 
+/** Identifies one applyMediaClockDomainModel call, so its caller can match the applyMediaClockDomainModelFinished signal answering it */
+using ApplyID = std::uint64_t;
+
 struct ApplyInfo
 {
+	ApplyID applyId{ 0u };
 	commandChain::CommandExecutionErrors entityApplyErrors{};
 };
 
+/** Progress of the commands applying a media clock domain model on one entity */
+struct EntityApplyStatus
+{
+	la::avdecc::UniqueIdentifier entityId{};
+	std::uint32_t completedCommands{ 0u };
+	std::uint32_t totalCommands{ 0u };
+	commandChain::CommandExecutionErrors errors{}; // Errors reported so far by the command sets of the entity
+};
+
 // **************************************************************
 // class MCDomainManager
 // **************************************************************
@@ -148,7 +165,10 @@ public:
 	/* media clock management helper functions */
 	virtual std::pair<la::avdecc::UniqueIdentifier, McDeterminationError> getMediaClockMaster(la::avdecc::UniqueIdentifier const entityId) noexcept = 0;
 	virtual MCEntityDomainMapping createMediaClockDomainModel() noexcept = 0;
-	virtual void applyMediaClockDomainModel(MCEntityDomainMapping const& domains) noexcept = 0;
+	/** Latest domain model published by the background worker (never null), consistent with the last mediaClockConnectionsUpdate signal */
+	virtual std::shared_ptr<MCEntityDomainMapping const> getMediaClockDomainModel() const noexcept = 0;
+	/** Starts applying the model, applyMediaClockDomainModelFinished being emitted with the returned ID once done */
+	virtual ApplyID applyMediaClockDomainModel(MCEntityDomainMapping const& domains) noexcept = 0;
 	virtual bool checkGPTPInSync(la::avdecc::UniqueIdentifier const entityId) noexcept = 0;
 	virtual bool isMediaClockDomainManageable(la::avdecc::UniqueIdentifier const& entityId) noexcept = 0;
 
@@ -159,6 +179,8 @@ public:
 
 	Q_SIGNAL void applyMediaClockDomainModelProgressUpdate(float_t progressPercentage);
 	Q_SIGNAL void applyMediaClockDomainModelFinished(ApplyInfo);
+	/** Emitted once for each entity when the apply starts, then each time one of its commands completed */
+	Q_SIGNAL void applyMediaClockDomainModelEntityStatusChanged(avdecc::mediaClock::EntityApplyStatus const& status);
 };
 
 constexpr bool operator!(McDeterminationError const error)
@@ -0,0 +1,166 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "memoryAccounting.hpp"
+#include "hiveLogItems.hpp"
+
+#include <QStringList>
+#include <QTimer>
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
+namespace avdecc
+{
+class MemoryAccountingImpl final : public MemoryAccounting
+{
+public:
+	MemoryAccountingImpl() noexcept
+	{
+		_logTimer.setInterval(std::chrono::duration_cast<std::chrono::milliseconds>(LogPeriod).count());
+		connect(&_logTimer, &QTimer::timeout, this, &MemoryAccountingImpl::logCounters);
+	}
+
+	// Deleted compiler auto-generated methods
+	MemoryAccountingImpl(MemoryAccountingImpl const&) = delete;
+	MemoryAccountingImpl(MemoryAccountingImpl&&) = delete;
+	MemoryAccountingImpl& operator=(MemoryAccountingImpl const&) = delete;
+	MemoryAccountingImpl& operator=(MemoryAccountingImpl&&) = delete;
+
+private:
+	struct ProbeInfo
+	{
+		ProbeID probeID{ 0u };
+		QString subsystem{};
+		Probe probe{};
+	};
+
+	// MemoryAccounting overrides
+	virtual ProbeID registerProbe(QString const& subsystem, Probe&& probe) noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+		auto const probeID = ++_lastProbeID;
+		_probes.push_back(ProbeInfo{ probeID, subsystem, std::move(probe) });
+		return probeID;
+	}
+
+	virtual void unregisterProbe(ProbeID const probeID) noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+		_probes.erase(std::remove_if(_probes.begin(), _probes.end(),
+										[probeID](auto const& info)
+										{
+											return info.probeID == probeID;
+										}),
+			_probes.end());
+	}
+
+	virtual std::vector<SubsystemCounters> collect() const noexcept override
+	{
+		auto result = std::vector<SubsystemCounters>{};
+
+		auto const lg = std::lock_guard{ _lock };
+		auto counters = Counters{};
+		for (auto const& info : _probes)
+		{
+			counters.clear();
+			info.probe(counters);
+
+			auto subsystemIt = std::find_if(result.begin(), result.end(),
+				[&info](auto const& s)
+				{
+					return s.subsystem == info.subsystem;
+				});
+			if (subsystemIt == result.end())
+			{
+				result.push_back(SubsystemCounters{ info.subsystem, std::move(counters) });
+				counters = Counters{};
+				continue;
+			}
+
+			// Another instance of the same subsystem, sum the counters by name
+			for (auto& counter : counters)
+			{
+				auto& subsystemCounters = subsystemIt->counters;
+				auto counterIt = std::find_if(subsystemCounters.begin(), subsystemCounters.end(),
+					[&counter](auto const& c)
+					{
+						return c.name == counter.name;
+					});
+				if (counterIt == subsystemCounters.end())
+				{
+					subsystemCounters.push_back(std::move(counter));
+				}
+				else
+				{
+					counterIt->value += counter.value;
+				}
+			}
+		}
+
+		return result;
+	}
+
+	virtual void setPeriodicLogging(bool const enabled) noexcept override
+	{
+		if (enabled == _logTimer.isActive())
+		{
+			return;
+		}
+
+		if (enabled)
+		{
+			_logTimer.start();
+		}
+		else
+		{
+			_logTimer.stop();
+		}
+	}
+
+	// Private methods
+	void logCounters() const noexcept
+	{
+		for (auto const& [subsystem, counters] : collect())
+		{
+			auto values = QStringList{};
+			for (auto const& counter : counters)
+			{
+				values.append(QString("%1=%2").arg(counter.name).arg(counter.value));
+			}
+			LOG_HIVE_INFO(QString("Memory accounting - %1: %2").arg(subsystem).arg(values.join(", ")));
+		}
+	}
+
+	// Private members
+	mutable std::mutex _lock{};
+	std::vector<ProbeInfo> _probes{}; // In registration order
+	ProbeID _lastProbeID{ 0u };
+	QTimer _logTimer{};
+};
+
+MemoryAccounting& MemoryAccounting::getInstance() noexcept
+{
+	static MemoryAccountingImpl s_MemoryAccounting{};
+
+	return s_MemoryAccounting;
+}
+
+} // namespace avdecc
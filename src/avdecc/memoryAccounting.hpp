@@ -0,0 +1,74 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace avdecc
+{
+/** Developer instrumentation reporting the size of the containers and caches of each subsystem, so a growth over a long run is visible without a profiler */
+class MemoryAccounting : public QObject
+{
+	Q_OBJECT
+public:
+	using ProbeID = std::uint32_t;
+
+	struct Counter
+	{
+		QString name{};
+		std::uint64_t value{ 0u };
+	};
+	using Counters = std::vector<Counter>;
+
+	struct SubsystemCounters
+	{
+		QString subsystem{};
+		Counters counters{};
+	};
+
+	/** Appends the current counters of a subsystem instance. Always called from the main thread */
+	using Probe = std::function<void(Counters& counters)>;
+
+	/** Interval between two reports written to the log, when periodic logging is enabled */
+	static constexpr auto LogPeriod = std::chrono::minutes{ 10 };
+
+	static MemoryAccounting& getInstance() noexcept;
+
+	/** Registers a probe for the specified subsystem. Counters of the probes registered for the same subsystem (several instances of a view) are summed */
+	virtual ProbeID registerProbe(QString const& subsystem, Probe&& probe) noexcept = 0;
+	virtual void unregisterProbe(ProbeID const probeID) noexcept = 0;
+
+	/** Calls all the probes, in the subsystems registration order. Must be called from the main thread */
+	virtual std::vector<SubsystemCounters> collect() const noexcept = 0;
+
+	/** Starts (or stops) writing the counters to the log every LogPeriod. Must be called from the main thread */
+	virtual void setPeriodicLogging(bool const enabled) noexcept = 0;
+
+protected:
+	MemoryAccounting() = default;
+};
+
+} // namespace avdecc
@@ -0,0 +1,96 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "namePool.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace avdecc
+{
+class NamePoolImpl final : public NamePool
+{
+public:
+	NamePoolImpl() noexcept = default;
+
+private:
+	// NamePool overrides
+	virtual Handle intern(Key const& key, QString const& name) noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+
+		auto& handle = _names[key];
+		if (handle.generation == 0u || handle.name != name)
+		{
+			handle.name = name;
+			handle.generation = ++_generation;
+		}
+		return handle;
+	}
+
+	virtual Handle get(Key const& key) const noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+
+		auto const it = _names.find(key);
+		if (it == _names.end())
+		{
+			return {};
+		}
+		return it->second;
+	}
+
+	virtual bool isCurrent(Key const& key, Handle const& handle) const noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+
+		auto const it = _names.find(key);
+		return it != _names.end() && it->second.generation == handle.generation;
+	}
+
+	virtual void removeEntity(la::avdecc::UniqueIdentifier const entityID) noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+
+		for (auto it = _names.begin(); it != _names.end();)
+		{
+			if (it->first.entityID == entityID)
+			{
+				it = _names.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	mutable std::mutex _lock{};
+	std::unordered_map<Key, Handle, Key::hash> _names{};
+	std::uint64_t _generation{ 0u }; // Last generation handed out, shared by all the keys so a removed then re-added name never gets an old generation back
+};
+
+NamePool& NamePool::getInstance() noexcept
+{
+	static NamePoolImpl s_NamePool{};
+
+	return s_NamePool;
+}
+
+} // namespace avdecc
@@ -0,0 +1,113 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/controller/avdeccController.hpp>
+#include <QString>
+
+#include <cstdint>
+
+namespace avdecc
+{
+/**
+* Central store of the entity and descriptor names, shared by all the models.
+* Names are kept as implicitly shared QStrings, so every copy handed out shares the same buffer, with a generation
+* incremented each time a name changes: holders of a Handle only have to compare generations to know if they are outdated.
+* Thread-safe, names are interned from the avdecc thread and read from the UI thread.
+*/
+class NamePool
+{
+public:
+	enum class Kind : std::uint8_t
+	{
+		ObjectName = 0,
+		GroupName = 1, // Only for the Entity descriptor
+	};
+
+	struct Key
+	{
+		la::avdecc::UniqueIdentifier entityID{};
+		la::avdecc::entity::model::ConfigurationIndex configurationIndex{ 0u };
+		la::avdecc::entity::model::DescriptorType descriptorType{ la::avdecc::entity::model::DescriptorType::Entity };
+		la::avdecc::entity::model::DescriptorIndex descriptorIndex{ 0u };
+		Kind kind{ Kind::ObjectName };
+
+		bool operator==(Key const& other) const noexcept
+		{
+			return entityID == other.entityID && configurationIndex == other.configurationIndex && descriptorType == other.descriptorType && descriptorIndex == other.descriptorIndex && kind == other.kind;
+		}
+
+		struct hash
+		{
+			std::size_t operator()(Key const& key) const noexcept
+			{
+				auto const descriptor = (static_cast<std::uint64_t>(key.configurationIndex) << 40) | (static_cast<std::uint64_t>(la::avdecc::utils::to_integral(key.descriptorType)) << 24) | (static_cast<std::uint64_t>(key.descriptorIndex) << 8) | static_cast<std::uint64_t>(la::avdecc::utils::to_integral(key.kind));
+				return la::avdecc::UniqueIdentifier::hash{}(key.entityID) ^ (std::hash<std::uint64_t>{}(descriptor) << 1);
+			}
+		};
+	};
+
+	struct Handle
+	{
+		QString name{};
+		std::uint64_t generation{ 0u }; // 0 if the name is not in the pool
+	};
+
+	static Key entityNameKey(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		return Key{ entityID, 0u, la::avdecc::entity::model::DescriptorType::Entity, 0u, Kind::ObjectName };
+	}
+
+	static Key entityGroupNameKey(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		return Key{ entityID, 0u, la::avdecc::entity::model::DescriptorType::Entity, 0u, Kind::GroupName };
+	}
+
+	static Key descriptorNameKey(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex) noexcept
+	{
+		return Key{ entityID, configurationIndex, descriptorType, descriptorIndex, Kind::ObjectName };
+	}
+
+	static NamePool& getInstance() noexcept;
+
+	/** Stores the name, returning the pooled one. The generation is only incremented if the name actually changed */
+	virtual Handle intern(Key const& key, QString const& name) noexcept = 0;
+
+	/** Returns the pooled name, or an empty Handle if not known */
+	virtual Handle get(Key const& key) const noexcept = 0;
+
+	/** Returns true if the handle still holds the current name of the key */
+	virtual bool isCurrent(Key const& key, Handle const& handle) const noexcept = 0;
+
+	/** Removes all the names of an entity (when it goes offline) */
+	virtual void removeEntity(la::avdecc::UniqueIdentifier const entityID) noexcept = 0;
+
+	// Deleted compiler auto-generated methods
+	NamePool(NamePool&&) = delete;
+	NamePool(NamePool const&) = delete;
+	NamePool& operator=(NamePool const&) = delete;
+	NamePool& operator=(NamePool&&) = delete;
+
+protected:
+	NamePool() = default;
+	virtual ~NamePool() = default;
+};
+
+} // namespace avdecc
@@ -0,0 +1,319 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "networkSnapshot.hpp"
+#include "controllerManager.hpp"
+#include "helper.hpp"
+#include "hiveLogItems.hpp"
+
+#include <QStandardPaths>
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QTimer>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QtEndian>
+
+#include <functional>
+
+namespace avdecc
+{
+namespace networkSnapshot
+{
+/** Snapshots are written in the background, one at a time */
+static constexpr auto StoreMaxThreadCount = 1;
+static constexpr auto SnapshotExtension = "hns";
+
+/**
+* Snapshot file layout (little endian):
+*  - Header: magic, version, entity count, size of the strings blob
+*  - One fixed size record per entity: entityID, entityModelID, offset and size of the name, offset and size of the group name
+*  - Strings blob (UTF-8), referenced by the records
+*/
+static constexpr std::uint32_t SnapshotMagic = 0x53534e48; // "HNSS"
+static constexpr std::uint32_t SnapshotVersion = 1u;
+static constexpr auto HeaderSize = 4u * sizeof(std::uint32_t);
+static constexpr auto RecordSize = 2u * sizeof(std::uint64_t) + 4u * sizeof(std::uint32_t);
+
+class SnapshotTask final : public QRunnable
+{
+public:
+	using Work = std::function<void()>;
+
+	SnapshotTask(Work&& work) noexcept
+		: _work{ std::move(work) }
+	{
+	}
+
+	virtual void run() override
+	{
+		_work();
+	}
+
+private:
+	Work _work{};
+};
+
+class NetworkSnapshotStoreImpl final : public NetworkSnapshotStore
+{
+public:
+	NetworkSnapshotStoreImpl() noexcept
+	{
+		_pool.setMaxThreadCount(StoreMaxThreadCount);
+
+		QDir{}.mkpath(storePath());
+
+		_previewTimer.setSingleShot(true);
+		_previewTimer.setInterval(PreviewDuration);
+		connect(&_previewTimer, &QTimer::timeout, this, &NetworkSnapshotStoreImpl::expirePreview);
+
+		_saveTimer.setSingleShot(true);
+		_saveTimer.setInterval(SaveDelay);
+		connect(&_saveTimer, &QTimer::timeout, this, &NetworkSnapshotStoreImpl::save);
+
+		auto& manager = ControllerManager::getInstance();
+		connect(&manager, &ControllerManager::controllerOffline, this, &NetworkSnapshotStoreImpl::handleControllerOffline);
+		connect(&manager, &ControllerManager::entitiesOnline, this, &NetworkSnapshotStoreImpl::scheduleSave);
+		connect(&manager, &ControllerManager::entitiesOffline, this, &NetworkSnapshotStoreImpl::scheduleSave);
+		connect(&manager, &ControllerManager::entityNameChanged, this, &NetworkSnapshotStoreImpl::scheduleSave);
+		connect(&manager, &ControllerManager::entityGroupNameChanged, this, &NetworkSnapshotStoreImpl::scheduleSave);
+	}
+
+	~NetworkSnapshotStoreImpl() noexcept
+	{
+		// Pending writes don't use the ControllerManager, let them complete
+		_pool.waitForDone();
+	}
+
+private:
+	// NetworkSnapshotStore overrides
+	virtual QString storePath() const noexcept override
+	{
+		return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + '/' + QCoreApplication::applicationName() + "/NetworkSnapshots";
+	}
+
+	virtual void setCurrentInterface(QString const& interfaceID) noexcept override
+	{
+		_interfaceID = interfaceID;
+
+		auto snapshot = load(snapshotFilePath(interfaceID));
+		if (snapshot.empty())
+		{
+			return;
+		}
+
+		LOG_HIVE_DEBUG(QString("Network snapshot: previewing %1 entity(ies) of the last session on %2").arg(snapshot.size()).arg(interfaceID));
+
+		_isPreviewActive = true;
+		_previewTimer.start();
+		emit previewLoaded(snapshot);
+	}
+
+	virtual bool isPreviewActive() const noexcept override
+	{
+		return _isPreviewActive;
+	}
+
+	virtual void clear() noexcept override
+	{
+		_pool.clear();
+		_pool.waitForDone();
+
+		QDir{ storePath() }.removeRecursively();
+		QDir{}.mkpath(storePath());
+	}
+
+	// Private methods
+	QString snapshotFilePath(QString const& interfaceID) const noexcept
+	{
+		// Interface IDs are not valid file names on every platform
+		auto const name = QCryptographicHash::hash(interfaceID.toUtf8(), QCryptographicHash::Sha1).toHex();
+		return QString{ "%1/%2.%3" }.arg(storePath()).arg(QString::fromLatin1(name)).arg(SnapshotExtension);
+	}
+
+	/** Reads a snapshot through a memory mapping, an empty snapshot being returned if the file is missing or invalid */
+	static Snapshot load(QString const& filePath) noexcept
+	{
+		auto file = QFile{ filePath };
+		if (!file.open(QIODevice::ReadOnly) || file.size() < static_cast<qint64>(HeaderSize))
+		{
+			return {};
+		}
+		auto const fileSize = static_cast<size_t>(file.size());
+		auto* const data = file.map(0, file.size());
+		if (!data)
+		{
+			return {};
+		}
+
+		auto snapshot = Snapshot{};
+		auto const magic = qFromLittleEndian<std::uint32_t>(data);
+		auto const version = qFromLittleEndian<std::uint32_t>(data + 4);
+		auto const count = static_cast<size_t>(qFromLittleEndian<std::uint32_t>(data + 8));
+		auto const stringsSize = static_cast<size_t>(qFromLittleEndian<std::uint32_t>(data + 12));
+		auto const stringsOffset = HeaderSize + count * RecordSize;
+
+		if (magic == SnapshotMagic && version == SnapshotVersion && stringsOffset + stringsSize == fileSize)
+		{
+			auto const* const strings = reinterpret_cast<char const*>(data + stringsOffset);
+			auto const readString = [strings, stringsSize](uchar const* const field, QString& value)
+			{
+				auto const offset = static_cast<size_t>(qFromLittleEndian<std::uint32_t>(field));
+				auto const size = static_cast<size_t>(qFromLittleEndian<std::uint32_t>(field + 4));
+				if (offset + size > stringsSize)
+				{
+					return false;
+				}
+				value = QString::fromUtf8(strings + offset, static_cast<int>(size));
+				return true;
+			};
+
+			snapshot.reserve(count);
+			for (auto index = size_t{ 0u }; index < count; ++index)
+			{
+				auto const* const record = data + HeaderSize + index * RecordSize;
+				auto row = EntityRow{};
+				row.entityID = la::avdecc::UniqueIdentifier{ qFromLittleEndian<std::uint64_t>(record) };
+				row.entityModelID = la::avdecc::UniqueIdentifier{ qFromLittleEndian<std::uint64_t>(record + 8) };
+				if (!row.entityID || !readString(record + 16, row.name) || !readString(record + 24, row.groupName))
+				{
+					// Corrupted file, don't show anything rather than a partial network
+					snapshot.clear();
+					break;
+				}
+				snapshot.push_back(std::move(row));
+			}
+		}
+
+		file.unmap(data);
+		return snapshot;
+	}
+
+	static QByteArray serialize(Snapshot const& snapshot) noexcept
+	{
+		auto strings = QByteArray{};
+		auto records = QByteArray{ static_cast<int>(snapshot.size() * RecordSize), Qt::Uninitialized };
+		auto* record = reinterpret_cast<uchar*>(records.data());
+
+		auto const writeString = [&strings](QString const& value, uchar* const field)
+		{
+			auto const utf8 = value.toUtf8();
+			qToLittleEndian(static_cast<std::uint32_t>(strings.size()), field);
+			qToLittleEndian(static_cast<std::uint32_t>(utf8.size()), field + 4);
+			strings.append(utf8);
+		};
+
+		for (auto const& row : snapshot)
+		{
+			qToLittleEndian(row.entityID.getValue(), record);
+			qToLittleEndian(row.entityModelID.getValue(), record + 8);
+			writeString(row.name, record + 16);
+			writeString(row.groupName, record + 24);
+			record += RecordSize;
+		}
+
+		auto data = QByteArray{ static_cast<int>(HeaderSize), Qt::Uninitialized };
+		auto* const header = reinterpret_cast<uchar*>(data.data());
+		qToLittleEndian(SnapshotMagic, header);
+		qToLittleEndian(SnapshotVersion, header + 4);
+		qToLittleEndian(static_cast<std::uint32_t>(snapshot.size()), header + 8);
+		qToLittleEndian(static_cast<std::uint32_t>(strings.size()), header + 12);
+		data.append(records);
+		data.append(strings);
+		return data;
+	}
+
+	void handleControllerOffline() noexcept
+	{
+		// The entities going away with the controller are not removed from the snapshot
+		_saveTimer.stop();
+		_previewTimer.stop();
+		_isPreviewActive = false;
+		_interfaceID.clear();
+	}
+
+	void expirePreview() noexcept
+	{
+		_isPreviewActive = false;
+		emit previewExpired();
+
+		// Now that every entity had time to come back, the network can be written as it is
+		scheduleSave();
+	}
+
+	void scheduleSave() noexcept
+	{
+		// A partially enumerated network would replace the snapshot being previewed
+		if (_interfaceID.isEmpty() || _isPreviewActive)
+		{
+			return;
+		}
+		_saveTimer.start();
+	}
+
+	void save() noexcept
+	{
+		auto& manager = ControllerManager::getInstance();
+		auto snapshot = Snapshot{};
+		for (auto const& entityID : manager.getOnlineEntities())
+		{
+			if (auto const controlledEntity = manager.getControlledEntity(entityID))
+			{
+				snapshot.push_back(EntityRow{ entityID, controlledEntity->getEntity().getEntityModelID(), helper::entityName(*controlledEntity), helper::groupName(*controlledEntity) });
+			}
+		}
+
+		// Keep the last known network rather than an empty one (no cable, interface down)
+		if (snapshot.empty())
+		{
+			return;
+		}
+
+		_pool.start(new SnapshotTask{
+			[filePath = snapshotFilePath(_interfaceID), snapshot = std::move(snapshot)]()
+			{
+				// Replace atomically, so a crash never leaves a partial snapshot
+				auto file = QSaveFile{ filePath };
+				if (!file.open(QIODevice::WriteOnly) || file.write(serialize(snapshot)) < 0 || !file.commit())
+				{
+					LOG_HIVE_DEBUG(QString("Network snapshot: cannot write %1").arg(filePath));
+				}
+			} });
+	}
+
+	// Private members
+	QString _interfaceID{}; // Interface of the current controller, empty if there is none
+	bool _isPreviewActive{ false };
+	QTimer _previewTimer{};
+	QTimer _saveTimer{};
+	QThreadPool _pool{}; // Declared last so it's the first destroyed
+};
+
+NetworkSnapshotStore& NetworkSnapshotStore::getInstance() noexcept
+{
+	static NetworkSnapshotStoreImpl s_NetworkSnapshotStore{};
+
+	return s_NetworkSnapshotStore;
+}
+
+} // namespace networkSnapshot
+} // namespace avdecc
@@ -0,0 +1,78 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/controller/avdeccController.hpp>
+#include <QObject>
+#include <QString>
+
+#include <chrono>
+#include <vector>
+
+namespace avdecc
+{
+namespace networkSnapshot
+{
+/** What the entity list shows of an entity before it is enumerated again */
+struct EntityRow
+{
+	la::avdecc::UniqueIdentifier entityID{};
+	la::avdecc::UniqueIdentifier entityModelID{};
+	QString name{};
+	QString groupName{};
+};
+using Snapshot = std::vector<EntityRow>;
+
+/**
+* @brief Persists a compact snapshot of the entities last seen on each network interface, so the next session can show them right away.
+*		 The snapshot of the interface is loaded (through a memory mapping) when the controller is created and published as a preview,
+*		 its entities being considered stale until they are enumerated again. The preview expires after PreviewDuration, the entities
+*		 not confirmed by then being considered gone. The snapshot is written again in the background each time the network settles.
+*/
+class NetworkSnapshotStore : public QObject
+{
+	Q_OBJECT
+public:
+	static constexpr auto PreviewDuration = std::chrono::seconds{ 30 }; // Time given to the entities of the preview to be enumerated again
+	static constexpr auto SaveDelay = std::chrono::seconds{ 5 }; // The network has to be stable for that long before being written
+
+	static NetworkSnapshotStore& getInstance() noexcept;
+
+	/** Directory the snapshots are stored in */
+	virtual QString storePath() const noexcept = 0;
+
+	/** Sets the interface the next controller is created on, publishing the preview of its snapshot (if any) */
+	virtual void setCurrentInterface(QString const& interfaceID) noexcept = 0;
+
+	/** Returns true while the entities of the preview are waiting to be enumerated again */
+	virtual bool isPreviewActive() const noexcept = 0;
+
+	/** Removes all the stored snapshots */
+	virtual void clear() noexcept = 0;
+
+	Q_SIGNAL void previewLoaded(avdecc::networkSnapshot::Snapshot const& snapshot);
+	Q_SIGNAL void previewExpired();
+
+protected:
+	NetworkSnapshotStore() = default;
+};
+
+} // namespace networkSnapshot
+} // namespace avdecc
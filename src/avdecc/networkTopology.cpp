@@ -0,0 +1,360 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "networkTopology.hpp"
+#include "controllerManager.hpp"
+#include "helper.hpp"
+
+#include <map>
+
+namespace avdecc
+{
+namespace topology
+{
+// **************************************************************
+// class NetworkTopologyImpl
+// **************************************************************
+class NetworkTopologyImpl final : public NetworkTopology
+{
+public:
+	NetworkTopologyImpl() noexcept
+	{
+		auto& manager = ControllerManager::getInstance();
+		connect(&manager, &ControllerManager::controllerOffline, this, &NetworkTopologyImpl::handleControllerOffline);
+		connect(&manager, &ControllerManager::entityOnline, this, &NetworkTopologyImpl::handleEntityOnline);
+		connect(&manager, &ControllerManager::entityOffline, this, &NetworkTopologyImpl::handleEntityOffline);
+		connect(&manager, &ControllerManager::entityNameChanged, this, &NetworkTopologyImpl::handleEntityNameChanged);
+		connect(&manager, &ControllerManager::asPathChanged, this, &NetworkTopologyImpl::handleAsPathChanged);
+		connect(&manager, &ControllerManager::avbInterfaceInfoChanged, this, &NetworkTopologyImpl::handleAvbInterfaceInfoChanged);
+	}
+
+	// Deleted compiler auto-generated methods
+	NetworkTopologyImpl(NetworkTopologyImpl const&) = delete;
+	NetworkTopologyImpl(NetworkTopologyImpl&&) = delete;
+	NetworkTopologyImpl& operator=(NetworkTopologyImpl const&) = delete;
+	NetworkTopologyImpl& operator=(NetworkTopologyImpl&&) = delete;
+
+private:
+	using InterfaceKey = std::pair<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::AvbInterfaceIndex>;
+
+	struct Endpoint
+	{
+		NodeID clockIdentity{};
+		std::vector<NodeID> chain{}; // Systems contributed to the graph, from the grandmaster down to the interface itself
+	};
+
+	// NetworkTopology overrides
+	virtual std::vector<NodeID> getNodes() const noexcept override
+	{
+		auto nodes = std::vector<NodeID>{};
+		nodes.reserve(_nodeRefs.size());
+		for (auto const& nodeKV : _nodeRefs)
+		{
+			nodes.push_back(nodeKV.first);
+		}
+		return nodes;
+	}
+
+	virtual std::vector<Link> getLinks() const noexcept override
+	{
+		auto links = std::vector<Link>{};
+		links.reserve(_linkRefs.size());
+		for (auto const& linkKV : _linkRefs)
+		{
+			links.push_back(linkKV.first);
+		}
+		return links;
+	}
+
+	virtual std::optional<NodeInfo> getNodeInfo(NodeID const nodeID) const noexcept override
+	{
+		if (_nodeRefs.count(nodeID) == 0)
+		{
+			return std::nullopt;
+		}
+
+		auto info = NodeInfo{};
+		auto const endpointIt = _endpointsByClockIdentity.find(nodeID);
+		if (endpointIt != _endpointsByClockIdentity.end())
+		{
+			auto const& [entityID, avbInterfaceIndex] = endpointIt->second;
+			info.kind = NodeInfo::Kind::Endpoint;
+			info.entityID = entityID;
+			info.avbInterfaceIndex = avbInterfaceIndex;
+
+			auto controlledEntity = ControllerManager::getInstance().getControlledEntity(entityID);
+			info.name = controlledEntity ? helper::smartEntityName(*controlledEntity) : helper::uniqueIdentifierToString(entityID);
+			if (avbInterfaceIndex != 0u)
+			{
+				info.name += QString{ " (%1)" }.arg(avbInterfaceIndex);
+			}
+		}
+		else
+		{
+			auto const vendorName = helper::getVendorName(nodeID);
+			info.name = vendorName.isEmpty() ? helper::uniqueIdentifierToString(nodeID) : QString{ "%1\n%2" }.arg(vendorName).arg(helper::uniqueIdentifierToString(nodeID));
+		}
+		return info;
+	}
+
+	// Private methods
+	void addNodeRef(NodeID const nodeID) noexcept
+	{
+		if (++_nodeRefs[nodeID] == 1u)
+		{
+			emit nodeAdded(nodeID);
+		}
+	}
+
+	void removeNodeRef(NodeID const nodeID) noexcept
+	{
+		auto const it = _nodeRefs.find(nodeID);
+		if (it != _nodeRefs.end() && --it->second == 0u)
+		{
+			_nodeRefs.erase(it);
+			emit nodeRemoved(nodeID);
+		}
+	}
+
+	void addChain(std::vector<NodeID> const& chain) noexcept
+	{
+		for (auto index = size_t{ 0u }; index < chain.size(); ++index)
+		{
+			addNodeRef(chain[index]);
+			if (index > 0u)
+			{
+				auto const link = makeLink(chain[index - 1], chain[index]);
+				if (++_linkRefs[link] == 1u)
+				{
+					emit linkAdded(link);
+				}
+			}
+		}
+	}
+
+	void removeChain(std::vector<NodeID> const& chain) noexcept
+	{
+		// Links first, a view never sees a link to a removed node
+		for (auto index = size_t{ 1u }; index < chain.size(); ++index)
+		{
+			auto const link = makeLink(chain[index - 1], chain[index]);
+			auto const it = _linkRefs.find(link);
+			if (it != _linkRefs.end() && --it->second == 0u)
+			{
+				_linkRefs.erase(it);
+				emit linkRemoved(link);
+			}
+		}
+		for (auto const& nodeID : chain)
+		{
+			removeNodeRef(nodeID);
+		}
+	}
+
+	static std::vector<NodeID> buildChain(NodeID const clockIdentity, std::vector<NodeID> const& asPath, la::avdecc::UniqueIdentifier const grandmasterID) noexcept
+	{
+		auto chain = std::vector<NodeID>{};
+
+		// Without AS path (not supported by the entity, or not retrieved yet), the interface is at least attached to its grandmaster
+		auto const& path = asPath.empty() && grandmasterID.isValid() ? std::vector<NodeID>{ grandmasterID } : asPath;
+		for (auto const& nodeID : path)
+		{
+			if (nodeID.isValid() && (chain.empty() || chain.back() != nodeID))
+			{
+				chain.push_back(nodeID);
+			}
+		}
+		// The interface usually is the last system of its own AS path
+		if (chain.empty() || chain.back() != clockIdentity)
+		{
+			chain.push_back(clockIdentity);
+		}
+		return chain;
+	}
+
+	/** Replaces the chain contributed by an interface, only the differences being notified */
+	void updateEndpoint(InterfaceKey const& key, NodeID const clockIdentity, std::vector<NodeID> const& asPath, la::avdecc::UniqueIdentifier const grandmasterID) noexcept
+	{
+		if (!clockIdentity.isValid())
+		{
+			return;
+		}
+
+		auto& endpoint = _endpoints[key];
+		auto chain = buildChain(clockIdentity, asPath, grandmasterID);
+		if (endpoint.clockIdentity == clockIdentity && endpoint.chain == chain)
+		{
+			return;
+		}
+
+		auto const previousChain = std::move(endpoint.chain);
+		auto const previousClockIdentity = endpoint.clockIdentity;
+
+		endpoint.clockIdentity = clockIdentity;
+		endpoint.chain = std::move(chain);
+
+		auto const kindChanged = previousClockIdentity != clockIdentity;
+		if (kindChanged)
+		{
+			_endpointsByClockIdentity.erase(previousClockIdentity);
+			_endpointsByClockIdentity[clockIdentity] = key;
+		}
+
+		// Add before removing, so the systems common to both chains are never removed from the views
+		addChain(endpoint.chain);
+		removeChain(previousChain);
+
+		if (kindChanged && _nodeRefs.count(clockIdentity) > 0)
+		{
+			emit nodeChanged(clockIdentity);
+		}
+	}
+
+	void removeEndpoint(InterfaceKey const& key) noexcept
+	{
+		auto const it = _endpoints.find(key);
+		if (it == _endpoints.end())
+		{
+			return;
+		}
+
+		auto const endpoint = std::move(it->second);
+		_endpoints.erase(it);
+		_endpointsByClockIdentity.erase(endpoint.clockIdentity);
+		removeChain(endpoint.chain);
+
+		// Still known as a bridge of another path (a grandmaster entity for example)
+		if (_nodeRefs.count(endpoint.clockIdentity) > 0)
+		{
+			emit nodeChanged(endpoint.clockIdentity);
+		}
+	}
+
+	/** Refreshes an interface from the entity model */
+	void refreshEndpoint(la::avdecc::controller::ControlledEntity const& controlledEntity, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, std::optional<std::vector<NodeID>> const& asPath = std::nullopt) noexcept
+	{
+		try
+		{
+			auto const entityID = controlledEntity.getEntity().getEntityID();
+			auto const& avbInterfaceNode = controlledEntity.getAvbInterfaceNode(controlledEntity.getCurrentConfigurationNode().descriptorIndex, avbInterfaceIndex);
+			auto path = asPath.value_or(std::vector<NodeID>{});
+			auto grandmasterID = la::avdecc::UniqueIdentifier{};
+			if (avbInterfaceNode.dynamicModel)
+			{
+				if (!asPath && avbInterfaceNode.dynamicModel->asPath)
+				{
+					path = avbInterfaceNode.dynamicModel->asPath->sequence;
+				}
+				grandmasterID = avbInterfaceNode.dynamicModel->gptpGrandmasterID;
+			}
+			updateEndpoint(InterfaceKey{ entityID, avbInterfaceIndex }, avbInterfaceNode.staticModel->clockIdentity, path, grandmasterID);
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+	}
+
+	// Slots
+	void handleControllerOffline() noexcept
+	{
+		auto keys = std::vector<InterfaceKey>{};
+		for (auto const& endpointKV : _endpoints)
+		{
+			keys.push_back(endpointKV.first);
+		}
+		for (auto const& key : keys)
+		{
+			removeEndpoint(key);
+		}
+	}
+
+	void handleEntityOnline(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		auto controlledEntity = ControllerManager::getInstance().getControlledEntity(entityID);
+		if (!controlledEntity || !controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+		{
+			return;
+		}
+
+		try
+		{
+			for (auto const& avbInterfaceKV : controlledEntity->getCurrentConfigurationNode().avbInterfaces)
+			{
+				refreshEndpoint(*controlledEntity, avbInterfaceKV.first);
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+	}
+
+	void handleEntityOffline(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		auto keys = std::vector<InterfaceKey>{};
+		for (auto it = _endpoints.lower_bound(InterfaceKey{ entityID, 0u }); it != _endpoints.end() && it->first.first == entityID; ++it)
+		{
+			keys.push_back(it->first);
+		}
+		for (auto const& key : keys)
+		{
+			removeEndpoint(key);
+		}
+	}
+
+	void handleEntityNameChanged(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		for (auto it = _endpoints.lower_bound(InterfaceKey{ entityID, 0u }); it != _endpoints.end() && it->first.first == entityID; ++it)
+		{
+			emit nodeChanged(it->second.clockIdentity);
+		}
+	}
+
+	void handleAsPathChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AsPath const& asPath) noexcept
+	{
+		if (auto controlledEntity = ControllerManager::getInstance().getControlledEntity(entityID))
+		{
+			refreshEndpoint(*controlledEntity, avbInterfaceIndex, asPath.sequence);
+		}
+	}
+
+	void handleAvbInterfaceInfoChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex) noexcept
+	{
+		// A grandmaster change is only meaningful for interfaces without AS path, refreshEndpoint keeps the chain as is otherwise
+		if (auto controlledEntity = ControllerManager::getInstance().getControlledEntity(entityID))
+		{
+			refreshEndpoint(*controlledEntity, avbInterfaceIndex);
+		}
+	}
+
+	// Private members
+	std::map<InterfaceKey, Endpoint> _endpoints{};
+	std::map<NodeID, InterfaceKey> _endpointsByClockIdentity{};
+	std::map<NodeID, size_t> _nodeRefs{};
+	std::map<Link, size_t> _linkRefs{};
+};
+
+NetworkTopology& NetworkTopology::getInstance() noexcept
+{
+	static NetworkTopologyImpl s_topology{};
+
+	return s_topology;
+}
+
+} // namespace topology
+} // namespace avdecc
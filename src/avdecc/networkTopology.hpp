@@ -0,0 +1,82 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/controller/avdeccController.hpp>
+#include <QObject>
+#include <QString>
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace avdecc
+{
+namespace topology
+{
+/** Systems of the topology are identified by their gPTP clock identity */
+using NodeID = la::avdecc::UniqueIdentifier;
+
+/** Undirected link between two systems, the lowest identity first */
+using Link = std::pair<NodeID, NodeID>;
+
+struct NodeInfo
+{
+	enum class Kind
+	{
+		Bridge, // Time-aware system only known from the AS paths
+		Endpoint, // AVB interface of an entity
+	};
+
+	Kind kind{ Kind::Bridge };
+	la::avdecc::UniqueIdentifier entityID{}; // Endpoints only
+	la::avdecc::entity::model::AvbInterfaceIndex avbInterfaceIndex{ 0u }; // Endpoints only
+	QString name{};
+};
+
+/**
+* @brief Graph of the gPTP network (bridges and entity interfaces), built incrementally from the AS path of each AVB interface.
+*		 Each interface contributes the chain of systems from the grandmaster down to itself (only the grandmaster when the AS path is not available),
+*		 links and nodes being reference counted so a change only adds or removes what actually differs.
+*/
+class NetworkTopology : public QObject
+{
+	Q_OBJECT
+public:
+	static NetworkTopology& getInstance() noexcept;
+
+	virtual std::vector<NodeID> getNodes() const noexcept = 0;
+	virtual std::vector<Link> getLinks() const noexcept = 0;
+	virtual std::optional<NodeInfo> getNodeInfo(NodeID const nodeID) const noexcept = 0;
+
+	static Link makeLink(NodeID const a, NodeID const b) noexcept
+	{
+		return a < b ? Link{ a, b } : Link{ b, a };
+	}
+
+	Q_SIGNAL void nodeAdded(avdecc::topology::NodeID const nodeID);
+	Q_SIGNAL void nodeRemoved(avdecc::topology::NodeID const nodeID);
+	Q_SIGNAL void nodeChanged(avdecc::topology::NodeID const nodeID); // Name or kind changed
+	Q_SIGNAL void linkAdded(avdecc::topology::Link const& link);
+	Q_SIGNAL void linkRemoved(avdecc::topology::Link const& link);
+};
+
+} // namespace topology
+} // namespace avdecc
@@ -0,0 +1,201 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "observerTrace.hpp"
+
+namespace avdecc::observerTrace
+{
+/** Identifies a trace file */
+static constexpr char TraceMagic[8] = { 'H', 'I', 'V', 'E', 'O', 'B', 'S', 'T' };
+/** Events are written to the file by blocks of this size, so recording does not slow down the controller thread */
+static constexpr auto RecorderBufferSize = std::size_t{ 64u * 1024u };
+
+/* Event encoding: LEB128 timestamp delta (usec), type (1 byte), EntityID (8 bytes), LEB128 payload size, payload */
+static void writeVarInt(std::vector<std::uint8_t>& buffer, std::uint64_t value) noexcept
+{
+	do
+	{
+		auto byte = static_cast<std::uint8_t>(value & 0x7F);
+		value >>= 7;
+		if (value != 0u)
+		{
+			byte |= 0x80;
+		}
+		buffer.push_back(byte);
+	} while (value != 0u);
+}
+
+static std::optional<std::uint64_t> readVarInt(std::ifstream& file) noexcept
+{
+	auto value = std::uint64_t{ 0u };
+	for (auto shift = 0u; shift < 64u; shift += 7u)
+	{
+		auto const byte = file.get();
+		if (byte == std::char_traits<char>::eof())
+		{
+			return std::nullopt;
+		}
+		value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0)
+		{
+			return value;
+		}
+	}
+	return std::nullopt;
+}
+
+Recorder::~Recorder() noexcept
+{
+	stop();
+}
+
+bool Recorder::start(QString const& filePath) noexcept
+{
+	stop();
+
+	auto const lg = std::lock_guard{ _lock };
+
+	_file.open(filePath.toStdString(), std::ios::binary | std::ios::out | std::ios::trunc);
+	if (!_file.is_open())
+	{
+		return false;
+	}
+	_file.write(TraceMagic, sizeof(TraceMagic));
+	_file.write(reinterpret_cast<char const*>(&TraceVersion), sizeof(TraceVersion));
+
+	_buffer.clear();
+	_buffer.reserve(RecorderBufferSize);
+	_startTime = std::chrono::steady_clock::now();
+	_lastTimestamp = {};
+	_isRecording = true;
+
+	return true;
+}
+
+void Recorder::stop() noexcept
+{
+	auto const lg = std::lock_guard{ _lock };
+
+	if (!_isRecording)
+	{
+		return;
+	}
+	_isRecording = false;
+
+	flushBuffer();
+	_file.close();
+}
+
+void Recorder::append(EventType const type, la::avdecc::UniqueIdentifier const entityID, Payload const& payload) noexcept
+{
+	auto const lg = std::lock_guard{ _lock };
+
+	// Recording may have been stopped while the payload was built
+	if (!_isRecording)
+	{
+		return;
+	}
+
+	try
+	{
+		auto const timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _startTime);
+		writeVarInt(_buffer, static_cast<std::uint64_t>((timestamp - _lastTimestamp).count()));
+		_lastTimestamp = timestamp;
+
+		_buffer.push_back(static_cast<std::uint8_t>(type));
+
+		auto const id = entityID.getValue();
+		auto const* const idBytes = reinterpret_cast<std::uint8_t const*>(&id);
+		_buffer.insert(_buffer.end(), idBytes, idBytes + sizeof(id));
+
+		writeVarInt(_buffer, payload.size());
+		_buffer.insert(_buffer.end(), payload.begin(), payload.end());
+
+		if (_buffer.size() >= RecorderBufferSize)
+		{
+			flushBuffer();
+		}
+	}
+	catch (...)
+	{
+	}
+}
+
+void Recorder::flushBuffer() noexcept
+{
+	if (!_buffer.empty())
+	{
+		_file.write(reinterpret_cast<char const*>(_buffer.data()), static_cast<std::streamsize>(_buffer.size()));
+		_buffer.clear();
+	}
+}
+
+bool Reader::open(QString const& filePath) noexcept
+{
+	_file.open(filePath.toStdString(), std::ios::binary | std::ios::in);
+	if (!_file.is_open())
+	{
+		return false;
+	}
+
+	char magic[sizeof(TraceMagic)];
+	auto version = std::uint32_t{ 0u };
+	_file.read(magic, sizeof(magic));
+	_file.read(reinterpret_cast<char*>(&version), sizeof(version));
+	_lastTimestamp = {};
+
+	return _file.good() && std::memcmp(magic, TraceMagic, sizeof(TraceMagic)) == 0 && version == TraceVersion;
+}
+
+std::optional<Event> Reader::next() noexcept
+{
+	try
+	{
+		auto const delta = readVarInt(_file);
+		auto const type = _file.get();
+		auto id = std::uint64_t{ 0u };
+		if (!delta || type == std::char_traits<char>::eof() || type >= static_cast<int>(EventType::Count) || !_file.read(reinterpret_cast<char*>(&id), sizeof(id)))
+		{
+			return std::nullopt;
+		}
+		auto const payloadSize = readVarInt(_file);
+		if (!payloadSize)
+		{
+			return std::nullopt;
+		}
+
+		auto event = Event{};
+		_lastTimestamp += std::chrono::microseconds{ *delta };
+		event.timestamp = _lastTimestamp;
+		event.type = static_cast<EventType>(type);
+		event.entityID = la::avdecc::UniqueIdentifier{ id };
+		event.payload.resize(*payloadSize);
+		if (!_file.read(reinterpret_cast<char*>(event.payload.data()), static_cast<std::streamsize>(event.payload.size())))
+		{
+			return std::nullopt;
+		}
+		return event;
+	}
+	catch (...)
+	{
+		return std::nullopt;
+	}
+}
+
+} // namespace avdecc::observerTrace
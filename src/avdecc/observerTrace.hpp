@@ -0,0 +1,361 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/internals/entityModelTypes.hpp>
+#include <la/avdecc/internals/uniqueIdentifier.hpp>
+
+#include <QString>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+/**
+* Compact binary trace of the la::avdecc::controller::Controller::Observer callbacks received by the ControllerManager, to replay a real-world event stream later.
+* Values are stored in the native representation, a trace is only meant to be replayed by the same build on the same platform.
+*/
+namespace avdecc::observerTrace
+{
+/** Version of the trace format, increase it when EventType or the recorded arguments change */
+static constexpr auto TraceVersion = std::uint32_t{ 1u };
+
+/** Recorded observer callbacks. Never reorder, only append */
+enum class EventType : std::uint8_t
+{
+	TransportError,
+	EntityQueryError,
+	EntityOnline,
+	EntityOffline,
+	EntityCapabilitiesChanged,
+	EntityAssociationChanged,
+	GptpChanged,
+	UnsolicitedRegistrationChanged,
+	CompatibilityFlagsChanged,
+	IdentificationStarted,
+	IdentificationStopped,
+	StreamConnectionChanged,
+	StreamConnectionsChanged,
+	AcquireStateChanged,
+	LockStateChanged,
+	StreamInputFormatChanged,
+	StreamOutputFormatChanged,
+	StreamInputDynamicInfoChanged,
+	StreamOutputDynamicInfoChanged,
+	EntityNameChanged,
+	EntityGroupNameChanged,
+	ConfigurationNameChanged,
+	AudioUnitNameChanged,
+	StreamInputNameChanged,
+	StreamOutputNameChanged,
+	AvbInterfaceNameChanged,
+	ClockSourceNameChanged,
+	MemoryObjectNameChanged,
+	AudioClusterNameChanged,
+	ClockDomainNameChanged,
+	AudioUnitSamplingRateChanged,
+	ClockSourceChanged,
+	StreamInputStarted,
+	StreamOutputStarted,
+	StreamInputStopped,
+	StreamOutputStopped,
+	AvbInterfaceInfoChanged,
+	AsPathChanged,
+	AvbInterfaceLinkStatusChanged,
+	EntityCountersChanged,
+	AvbInterfaceCountersChanged,
+	ClockDomainCountersChanged,
+	StreamInputCountersChanged,
+	StreamOutputCountersChanged,
+	MemoryObjectLengthChanged,
+	StreamPortInputAudioMappingsChanged,
+	StreamPortOutputAudioMappingsChanged,
+	OperationProgress,
+	OperationCompleted,
+	AecpRetryCounterChanged,
+	AecpTimeoutCounterChanged,
+	AecpUnexpectedResponseCounterChanged,
+	AecpResponseAverageTimeChanged,
+	AemAecpUnsolicitedCounterChanged,
+	Count, // Must be the last one
+};
+
+using Payload = std::vector<std::uint8_t>;
+
+struct Event
+{
+	std::chrono::microseconds timestamp{}; // Since the start of the recording
+	EventType type{ EventType::Count };
+	la::avdecc::UniqueIdentifier entityID{};
+	Payload payload{};
+};
+
+/** Serializes the arguments of a callback */
+class PayloadWriter final
+{
+public:
+	template<typename T>
+	void write(T const& value)
+	{
+		if constexpr (std::is_same_v<T, la::avdecc::entity::model::AsPath>)
+		{
+			write(value.sequence);
+		}
+		else if constexpr (std::is_same_v<T, std::string>)
+		{
+			writeSize(value.size());
+			writeBytes(value.data(), value.size());
+		}
+		else if constexpr (IsContainer<T>::value)
+		{
+			writeSize(value.size());
+			for (auto const& element : value)
+			{
+				write(element);
+			}
+		}
+		else
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Unsupported type");
+			writeBytes(&value, sizeof(T));
+		}
+	}
+
+	template<typename First, typename Second>
+	void write(std::pair<First, Second> const& value)
+	{
+		write(value.first);
+		write(value.second);
+	}
+
+	Payload const& payload() const noexcept
+	{
+		return _payload;
+	}
+
+private:
+	template<typename T>
+	struct IsContainer : std::false_type
+	{
+	};
+	template<typename... Args>
+	struct IsContainer<std::vector<Args...>> : std::true_type
+	{
+	};
+	template<typename... Args>
+	struct IsContainer<std::set<Args...>> : std::true_type
+	{
+	};
+	template<typename... Args>
+	struct IsContainer<std::map<Args...>> : std::true_type
+	{
+	};
+
+	void writeSize(std::size_t const size)
+	{
+		auto const value = static_cast<std::uint32_t>(size);
+		writeBytes(&value, sizeof(value));
+	}
+
+	void writeBytes(void const* const data, std::size_t const size)
+	{
+		auto const* const bytes = static_cast<std::uint8_t const*>(data);
+		_payload.insert(_payload.end(), bytes, bytes + size);
+	}
+
+	Payload _payload{};
+};
+
+/** Deserializes the arguments of a callback. Once a read failed (truncated payload) isValid() returns false and all values are default constructed */
+class PayloadReader final
+{
+public:
+	explicit PayloadReader(Payload const& payload) noexcept
+		: _payload{ payload }
+	{
+	}
+
+	bool isValid() const noexcept
+	{
+		return _isValid;
+	}
+
+	template<typename T>
+	T read()
+	{
+		auto value = T{};
+		readInto(value);
+		return value;
+	}
+
+private:
+	template<typename T>
+	void readInto(T& value)
+	{
+		if constexpr (std::is_same_v<T, la::avdecc::entity::model::AsPath>)
+		{
+			readInto(value.sequence);
+		}
+		else if constexpr (std::is_same_v<T, std::string>)
+		{
+			value.resize(readSize());
+			readBytes(value.data(), value.size());
+		}
+		else
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Unsupported type");
+			readBytes(&value, sizeof(T));
+		}
+	}
+
+	template<typename T>
+	void readInto(std::vector<T>& value)
+	{
+		auto const size = readSize();
+		for (auto i = 0u; i < size && _isValid; ++i)
+		{
+			value.push_back(read<T>());
+		}
+	}
+
+	template<typename T, typename... Args>
+	void readInto(std::set<T, Args...>& value)
+	{
+		auto const size = readSize();
+		for (auto i = 0u; i < size && _isValid; ++i)
+		{
+			value.insert(read<T>());
+		}
+	}
+
+	template<typename Key, typename Value, typename... Args>
+	void readInto(std::map<Key, Value, Args...>& value)
+	{
+		auto const size = readSize();
+		for (auto i = 0u; i < size && _isValid; ++i)
+		{
+			auto key = read<Key>();
+			value[key] = read<Value>();
+		}
+	}
+
+	std::size_t readSize()
+	{
+		auto size = std::uint32_t{ 0u };
+		readBytes(&size, sizeof(size));
+		return size;
+	}
+
+	void readBytes(void* const data, std::size_t const size)
+	{
+		if (!_isValid || (_offset + size) > _payload.size())
+		{
+			_isValid = false;
+			return;
+		}
+		std::memcpy(data, _payload.data() + _offset, size);
+		_offset += size;
+	}
+
+	Payload const& _payload;
+	std::size_t _offset{ 0u };
+	bool _isValid{ true };
+};
+
+/** Records events to a trace file. Thread-safe, events being appended from the controller thread */
+class Recorder final
+{
+public:
+	Recorder() noexcept = default;
+	~Recorder() noexcept;
+
+	/** Starts a new recording to the file, stopping the previous one */
+	bool start(QString const& filePath) noexcept;
+
+	/** Stops the recording and closes the file */
+	void stop() noexcept;
+
+	bool isRecording() const noexcept
+	{
+		return _isRecording;
+	}
+
+	template<typename... Args>
+	void record(EventType const type, la::avdecc::UniqueIdentifier const entityID, Args const&... args) noexcept
+	{
+		if (!_isRecording)
+		{
+			return;
+		}
+		try
+		{
+			auto writer = PayloadWriter{};
+			(writer.write(args), ...);
+			append(type, entityID, writer.payload());
+		}
+		catch (...)
+		{
+		}
+	}
+
+	// Deleted compiler auto-generated methods
+	Recorder(Recorder const&) = delete;
+	Recorder(Recorder&&) = delete;
+	Recorder& operator=(Recorder const&) = delete;
+	Recorder& operator=(Recorder&&) = delete;
+
+private:
+	void append(EventType const type, la::avdecc::UniqueIdentifier const entityID, Payload const& payload) noexcept;
+	void flushBuffer() noexcept;
+
+	std::atomic_bool _isRecording{ false };
+	std::mutex _lock{};
+	std::ofstream _file{};
+	std::vector<std::uint8_t> _buffer{};
+	std::chrono::steady_clock::time_point _startTime{};
+	std::chrono::microseconds _lastTimestamp{};
+};
+
+/** Reads the events of a trace file, in recording order */
+class Reader final
+{
+public:
+	/** Opens the trace, returns false if the file is not a trace or was recorded with another format version */
+	bool open(QString const& filePath) noexcept;
+
+	/** Returns the next event, or nothing at the end of the trace (or if the trace is truncated) */
+	std::optional<Event> next() noexcept;
+
+private:
+	std::ifstream _file{};
+	std::chrono::microseconds _lastTimestamp{};
+};
+
+} // namespace avdecc::observerTrace
@@ -0,0 +1,616 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "routingSnapshot.hpp"
+#include "helper.hpp"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace avdecc
+{
+namespace routingSnapshot
+{
+using AsyncCommand = commandChain::AsyncParallelCommandSet::AsyncCommand;
+using AsyncCommands = std::vector<AsyncCommand>;
+
+static constexpr auto SnapshotVersion = 1;
+
+static la::avdecc::UniqueIdentifier toUniqueIdentifier(QString text, bool& ok) noexcept
+{
+	if (text.startsWith("0x", Qt::CaseInsensitive))
+	{
+		text.remove(0, 2);
+	}
+	return la::avdecc::UniqueIdentifier{ text.toULongLong(&ok, 16) };
+}
+
+static bool isAemSupported(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept
+{
+	return controlledEntity.getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported);
+}
+
+static bool isSameStream(la::avdecc::entity::model::StreamIdentification const& lhs, la::avdecc::entity::model::StreamIdentification const& rhs) noexcept
+{
+	return lhs.entityID == rhs.entityID && lhs.streamIndex == rhs.streamIndex;
+}
+
+/** Returns the mappings of lhs not found in rhs */
+static la::avdecc::entity::model::AudioMappings mappingsDifference(la::avdecc::entity::model::AudioMappings const& lhs, la::avdecc::entity::model::AudioMappings const& rhs) noexcept
+{
+	auto const toKey = [](la::avdecc::entity::model::AudioMapping const& mapping)
+	{
+		return std::make_tuple(mapping.streamIndex, mapping.streamChannel, mapping.clusterOffset, mapping.clusterChannel);
+	};
+	auto rhsKeys = std::set<decltype(toKey(std::declval<la::avdecc::entity::model::AudioMapping>()))>{};
+	for (auto const& mapping : rhs)
+	{
+		rhsKeys.insert(toKey(mapping));
+	}
+
+	auto difference = la::avdecc::entity::model::AudioMappings{};
+	for (auto const& mapping : lhs)
+	{
+		if (rhsKeys.count(toKey(mapping)) == 0)
+		{
+			difference.push_back(mapping);
+		}
+	}
+	return difference;
+}
+
+/** Commands needed to bring an entity from its live state to its snapshot state */
+struct EntityDiff
+{
+	std::vector<std::pair<la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::StreamIdentification>> disconnections{}; // Listener stream index, current talker stream
+	std::vector<std::pair<la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::StreamIdentification>> connections{}; // Listener stream index, snapshot talker stream
+	std::map<la::avdecc::entity::model::StreamPortIndex, la::avdecc::entity::model::AudioMappings> inputMappingsToRemove{};
+	std::map<la::avdecc::entity::model::StreamPortIndex, la::avdecc::entity::model::AudioMappings> inputMappingsToAdd{};
+	std::map<la::avdecc::entity::model::StreamPortIndex, la::avdecc::entity::model::AudioMappings> outputMappingsToRemove{};
+	std::map<la::avdecc::entity::model::StreamPortIndex, la::avdecc::entity::model::AudioMappings> outputMappingsToAdd{};
+	std::map<la::avdecc::entity::model::ClockDomainIndex, la::avdecc::entity::model::ClockSourceIndex> clockSources{};
+
+	bool empty() const noexcept
+	{
+		return disconnections.empty() && connections.empty() && inputMappingsToRemove.empty() && inputMappingsToAdd.empty() && outputMappingsToRemove.empty() && outputMappingsToAdd.empty() && clockSources.empty();
+	}
+};
+
+static EntityRouting captureEntity(la::avdecc::controller::ControlledEntity const& controlledEntity)
+{
+	auto routing = EntityRouting{};
+	routing.name = avdecc::helper::smartEntityName(controlledEntity);
+
+	auto const& configurationNode = controlledEntity.getCurrentConfigurationNode();
+	for (auto const& [streamIndex, streamInputNode] : configurationNode.streamInputs)
+	{
+		if (auto const* const dynamicModel = streamInputNode.dynamicModel)
+		{
+			if (dynamicModel->connectionState.state == la::avdecc::entity::model::StreamConnectionState::State::Connected)
+			{
+				routing.streamInputConnections[streamIndex] = dynamicModel->connectionState.talkerStream;
+			}
+		}
+	}
+	for (auto const& audioUnitKV : configurationNode.audioUnits)
+	{
+		for (auto const& [streamPortIndex, streamPortNode] : audioUnitKV.second.streamPortInputs)
+		{
+			if (streamPortNode.staticModel && streamPortNode.staticModel->hasDynamicAudioMap && streamPortNode.dynamicModel)
+			{
+				routing.streamPortInputMappings[streamPortIndex] = streamPortNode.dynamicModel->dynamicAudioMap;
+			}
+		}
+		for (auto const& [streamPortIndex, streamPortNode] : audioUnitKV.second.streamPortOutputs)
+		{
+			if (streamPortNode.staticModel && streamPortNode.staticModel->hasDynamicAudioMap && streamPortNode.dynamicModel)
+			{
+				routing.streamPortOutputMappings[streamPortIndex] = streamPortNode.dynamicModel->dynamicAudioMap;
+			}
+		}
+	}
+	for (auto const& [clockDomainIndex, clockDomainNode] : configurationNode.clockDomains)
+	{
+		if (auto const* const dynamicModel = clockDomainNode.dynamicModel)
+		{
+			routing.clockSources[clockDomainIndex] = dynamicModel->clockSourceIndex;
+		}
+	}
+
+	return routing;
+}
+
+/** Compares the live state of an entity with its snapshot, descriptors not (or no longer) found on the entity being ignored */
+static EntityDiff computeDiff(la::avdecc::controller::ControlledEntity const& controlledEntity, EntityRouting const& routing)
+{
+	auto const live = captureEntity(controlledEntity);
+	auto const& configurationNode = controlledEntity.getCurrentConfigurationNode();
+	auto diff = EntityDiff{};
+
+	for (auto const& streamInputKV : configurationNode.streamInputs)
+	{
+		auto const streamIndex = streamInputKV.first;
+		auto const liveIt = live.streamInputConnections.find(streamIndex);
+		auto const targetIt = routing.streamInputConnections.find(streamIndex);
+		auto const isLiveConnected = liveIt != live.streamInputConnections.end();
+		auto const isTargetConnected = targetIt != routing.streamInputConnections.end();
+
+		if (isLiveConnected && isTargetConnected && isSameStream(liveIt->second, targetIt->second))
+		{
+			continue;
+		}
+		if (isLiveConnected)
+		{
+			diff.disconnections.emplace_back(streamIndex, liveIt->second);
+		}
+		if (isTargetConnected)
+		{
+			diff.connections.emplace_back(streamIndex, targetIt->second);
+		}
+	}
+
+	auto const diffMappings = [](auto const& liveMappings, auto const& targetMappings, auto& toRemove, auto& toAdd)
+	{
+		for (auto const& [streamPortIndex, mappings] : targetMappings)
+		{
+			auto const liveIt = liveMappings.find(streamPortIndex);
+			if (liveIt == liveMappings.end())
+			{
+				continue;
+			}
+			if (auto removed = mappingsDifference(liveIt->second, mappings); !removed.empty())
+			{
+				toRemove[streamPortIndex] = std::move(removed);
+			}
+			if (auto added = mappingsDifference(mappings, liveIt->second); !added.empty())
+			{
+				toAdd[streamPortIndex] = std::move(added);
+			}
+		}
+	};
+	diffMappings(live.streamPortInputMappings, routing.streamPortInputMappings, diff.inputMappingsToRemove, diff.inputMappingsToAdd);
+	diffMappings(live.streamPortOutputMappings, routing.streamPortOutputMappings, diff.outputMappingsToRemove, diff.outputMappingsToAdd);
+
+	for (auto const& [clockDomainIndex, clockSourceIndex] : routing.clockSources)
+	{
+		auto const liveIt = live.clockSources.find(clockDomainIndex);
+		if (liveIt != live.clockSources.end() && liveIt->second != clockSourceIndex)
+		{
+			diff.clockSources[clockDomainIndex] = clockSourceIndex;
+		}
+	}
+
+	return diff;
+}
+
+Snapshot capture() noexcept
+{
+	auto snapshot = Snapshot{};
+	auto& manager = avdecc::ControllerManager::getInstance();
+	for (auto const& entityID : manager.getOnlineEntities())
+	{
+		if (auto controlledEntity = manager.getControlledEntity(entityID))
+		{
+			if (!isAemSupported(*controlledEntity))
+			{
+				continue;
+			}
+			try
+			{
+				snapshot[entityID] = captureEntity(*controlledEntity);
+			}
+			catch (la::avdecc::controller::ControlledEntity::Exception const&)
+			{
+			}
+		}
+	}
+	return snapshot;
+}
+
+QByteArray serialize(Snapshot const& snapshot) noexcept
+{
+	auto const serializeMappings = [](auto const& mappingsPerPort)
+	{
+		auto ports = QJsonArray{};
+		for (auto const& [streamPortIndex, mappings] : mappingsPerPort)
+		{
+			auto array = QJsonArray{};
+			for (auto const& mapping : mappings)
+			{
+				array.append(QJsonArray{ mapping.streamIndex, mapping.streamChannel, mapping.clusterOffset, mapping.clusterChannel });
+			}
+			ports.append(QJsonArray{ streamPortIndex, array });
+		}
+		return ports;
+	};
+
+	auto entities = QJsonArray{};
+	for (auto const& [entityID, routing] : snapshot)
+	{
+		auto connections = QJsonArray{};
+		for (auto const& [streamIndex, talkerStream] : routing.streamInputConnections)
+		{
+			connections.append(QJsonArray{ streamIndex, avdecc::helper::uniqueIdentifierToString(talkerStream.entityID), talkerStream.streamIndex });
+		}
+		auto clockSources = QJsonArray{};
+		for (auto const& [clockDomainIndex, clockSourceIndex] : routing.clockSources)
+		{
+			clockSources.append(QJsonArray{ clockDomainIndex, clockSourceIndex });
+		}
+
+		auto entity = QJsonObject{};
+		entity["id"] = avdecc::helper::uniqueIdentifierToString(entityID);
+		entity["name"] = routing.name;
+		entity["connections"] = connections;
+		entity["inputMappings"] = serializeMappings(routing.streamPortInputMappings);
+		entity["outputMappings"] = serializeMappings(routing.streamPortOutputMappings);
+		entity["clockSources"] = clockSources;
+		entities.append(entity);
+	}
+
+	auto root = QJsonObject{};
+	root["version"] = SnapshotVersion;
+	root["entities"] = entities;
+	return QJsonDocument{ root }.toJson(QJsonDocument::Compact);
+}
+
+QString deserialize(QByteArray const& data, Snapshot& snapshot) noexcept
+{
+	auto parseError = QJsonParseError{};
+	auto const document = QJsonDocument::fromJson(data, &parseError);
+	if (parseError.error != QJsonParseError::NoError)
+	{
+		return parseError.errorString();
+	}
+
+	auto const root = document.object();
+	if (root["version"].toInt() != SnapshotVersion)
+	{
+		return QString("Unsupported snapshot version %1").arg(root["version"].toInt());
+	}
+
+	auto const parseMappings = [](QJsonArray const& ports, auto& mappingsPerPort)
+	{
+		for (auto const& portValue : ports)
+		{
+			auto const port = portValue.toArray();
+			if (port.size() != 2)
+			{
+				return false;
+			}
+			auto mappings = la::avdecc::entity::model::AudioMappings{};
+			for (auto const& mappingValue : port[1].toArray())
+			{
+				auto const mapping = mappingValue.toArray();
+				if (mapping.size() != 4)
+				{
+					return false;
+				}
+				mappings.push_back(la::avdecc::entity::model::AudioMapping{ static_cast<la::avdecc::entity::model::StreamIndex>(mapping[0].toInt()), static_cast<std::uint16_t>(mapping[1].toInt()), static_cast<la::avdecc::entity::model::ClusterIndex>(mapping[2].toInt()), static_cast<std::uint16_t>(mapping[3].toInt()) });
+			}
+			mappingsPerPort[static_cast<la::avdecc::entity::model::StreamPortIndex>(port[0].toInt())] = std::move(mappings);
+		}
+		return true;
+	};
+
+	snapshot.clear();
+	for (auto const& entityValue : root["entities"].toArray())
+	{
+		auto const entity = entityValue.toObject();
+		auto ok = false;
+		auto const entityID = toUniqueIdentifier(entity["id"].toString(), ok);
+		if (!ok)
+		{
+			return QString("'%1' is not a valid EntityID").arg(entity["id"].toString());
+		}
+
+		auto routing = EntityRouting{};
+		routing.name = entity["name"].toString();
+		for (auto const& connectionValue : entity["connections"].toArray())
+		{
+			auto const connection = connectionValue.toArray();
+			if (connection.size() != 3)
+			{
+				return QString("Invalid stream connection for entity %1").arg(entity["id"].toString());
+			}
+			auto const talkerEntityID = toUniqueIdentifier(connection[1].toString(), ok);
+			if (!ok)
+			{
+				return QString("Invalid stream connection for entity %1").arg(entity["id"].toString());
+			}
+			routing.streamInputConnections[static_cast<la::avdecc::entity::model::StreamIndex>(connection[0].toInt())] = la::avdecc::entity::model::StreamIdentification{ talkerEntityID, static_cast<la::avdecc::entity::model::StreamIndex>(connection[2].toInt()) };
+		}
+		if (!parseMappings(entity["inputMappings"].toArray(), routing.streamPortInputMappings) || !parseMappings(entity["outputMappings"].toArray(), routing.streamPortOutputMappings))
+		{
+			return QString("Invalid audio mapping for entity %1").arg(entity["id"].toString());
+		}
+		for (auto const& clockSourceValue : entity["clockSources"].toArray())
+		{
+			auto const clockSource = clockSourceValue.toArray();
+			if (clockSource.size() != 2)
+			{
+				return QString("Invalid clock source for entity %1").arg(entity["id"].toString());
+			}
+			routing.clockSources[static_cast<la::avdecc::entity::model::ClockDomainIndex>(clockSource[0].toInt())] = static_cast<la::avdecc::entity::model::ClockSourceIndex>(clockSource[1].toInt());
+		}
+		snapshot[entityID] = std::move(routing);
+	}
+
+	return {};
+}
+
+// **************************************************************
+// class RoutingSnapshotManagerImpl
+// **************************************************************
+class RoutingSnapshotManagerImpl final : public RoutingSnapshotManager
+{
+public:
+	RoutingSnapshotManagerImpl() noexcept
+	{
+		connect(&_executer, &commandChain::AsyncCommandGraphExecuter::progressUpdate, this, &RoutingSnapshotManager::progressUpdate);
+		connect(&_executer, &commandChain::AsyncCommandGraphExecuter::completed, this,
+			[this](commandChain::CommandExecutionErrors const errors)
+			{
+				_exclusiveAccess.reset();
+				_recallInfo.errors = errors;
+				finishRecall();
+			});
+	}
+
+	// Deleted compiler auto-generated methods
+	RoutingSnapshotManagerImpl(RoutingSnapshotManagerImpl const&) = delete;
+	RoutingSnapshotManagerImpl(RoutingSnapshotManagerImpl&&) = delete;
+	RoutingSnapshotManagerImpl& operator=(RoutingSnapshotManagerImpl const&) = delete;
+	RoutingSnapshotManagerImpl& operator=(RoutingSnapshotManagerImpl&&) = delete;
+
+private:
+	/** Response handler completing the command, whatever the extra parameters of the AEM command result */
+	static auto makeAemResponseHandler(commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex, ControllerManager::AecpCommandType const commandType) noexcept
+	{
+		return [parentCommandSet, commandIndex, commandType](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, auto const&...)
+		{
+			auto const error = commandChain::AsyncParallelCommandSet::aemCommandStatusToCommandError(status);
+			if (error != commandChain::CommandExecutionError::NoError)
+			{
+				parentCommandSet->addErrorInfo(entityID, error, commandType);
+			}
+			parentCommandSet->invokeCommandCompleted(commandIndex, error != commandChain::CommandExecutionError::NoError);
+		};
+	}
+
+	/** Response handler completing the command, the error being reported for the listener */
+	static auto makeAcmpResponseHandler(commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex, ControllerManager::AcmpCommandType const commandType) noexcept
+	{
+		return [parentCommandSet, commandIndex, commandType](la::avdecc::UniqueIdentifier const /*talkerEntityID*/, la::avdecc::entity::model::StreamIndex const /*talkerStreamIndex*/, la::avdecc::UniqueIdentifier const listenerEntityID, la::avdecc::entity::model::StreamIndex const /*listenerStreamIndex*/, la::avdecc::entity::ControllerEntity::ControlStatus const status)
+		{
+			auto const error = commandChain::AsyncParallelCommandSet::controlStatusToCommandError(status);
+			if (error != commandChain::CommandExecutionError::NoError)
+			{
+				parentCommandSet->addErrorInfo(listenerEntityID, error, commandType);
+			}
+			parentCommandSet->invokeCommandCompleted(commandIndex, error != commandChain::CommandExecutionError::NoError);
+		};
+	}
+
+	void addCommandSet(la::avdecc::UniqueIdentifier const entityID, AsyncCommands const& commands) noexcept
+	{
+		if (commands.empty())
+		{
+			return;
+		}
+		auto* const commandSet = new commandChain::AsyncParallelCommandSet;
+		commandSet->append(entityID, commands);
+		// Same resource: the steps of an entity wait for each other, entities do not
+		_executer.addCommandSet(commandSet, commandChain::AsyncCommandGraphExecuter::Resources{ entityID });
+	}
+
+	void addEntityCommands(la::avdecc::UniqueIdentifier const entityID, EntityDiff const& diff) noexcept
+	{
+		// Disconnect and unmap
+		{
+			auto commands = AsyncCommands{};
+			for (auto const& [listenerStreamIndex, talkerStream] : diff.disconnections)
+			{
+				commands.push_back(
+					[entityID, listenerStreamIndex = listenerStreamIndex, talkerStream = talkerStream](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+					{
+						avdecc::ControllerManager::getInstance().disconnectStream(talkerStream.entityID, talkerStream.streamIndex, entityID, listenerStreamIndex, makeAcmpResponseHandler(parentCommandSet, commandIndex, ControllerManager::AcmpCommandType::DisconnectStream));
+						return true;
+					});
+			}
+			for (auto const& [streamPortIndex, mappings] : diff.inputMappingsToRemove)
+			{
+				commands.push_back(
+					[entityID, streamPortIndex = streamPortIndex, mappings = mappings](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+					{
+						avdecc::ControllerManager::getInstance().removeStreamPortInputAudioMappings(entityID, streamPortIndex, mappings, makeAemResponseHandler(parentCommandSet, commandIndex, ControllerManager::AecpCommandType::RemoveStreamPortAudioMappings));
+						return true;
+					});
+			}
+			for (auto const& [streamPortIndex, mappings] : diff.outputMappingsToRemove)
+			{
+				commands.push_back(
+					[entityID, streamPortIndex = streamPortIndex, mappings = mappings](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+					{
+						avdecc::ControllerManager::getInstance().removeStreamPortOutputAudioMappings(entityID, streamPortIndex, mappings, makeAemResponseHandler(parentCommandSet, commandIndex, ControllerManager::AecpCommandType::RemoveStreamPortAudioMappings));
+						return true;
+					});
+			}
+			addCommandSet(entityID, commands);
+		}
+
+		// Map and connect
+		{
+			auto commands = AsyncCommands{};
+			for (auto const& [streamPortIndex, mappings] : diff.inputMappingsToAdd)
+			{
+				commands.push_back(
+					[entityID, streamPortIndex = streamPortIndex, mappings = mappings](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+					{
+						avdecc::ControllerManager::getInstance().addStreamPortInputAudioMappings(entityID, streamPortIndex, mappings, makeAemResponseHandler(parentCommandSet, commandIndex, ControllerManager::AecpCommandType::AddStreamPortAudioMappings));
+						return true;
+					});
+			}
+			for (auto const& [streamPortIndex, mappings] : diff.outputMappingsToAdd)
+			{
+				commands.push_back(
+					[entityID, streamPortIndex = streamPortIndex, mappings = mappings](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+					{
+						avdecc::ControllerManager::getInstance().addStreamPortOutputAudioMappings(entityID, streamPortIndex, mappings, makeAemResponseHandler(parentCommandSet, commandIndex, ControllerManager::AecpCommandType::AddStreamPortAudioMappings));
+						return true;
+					});
+			}
+			for (auto const& [listenerStreamIndex, talkerStream] : diff.connections)
+			{
+				commands.push_back(
+					[entityID, listenerStreamIndex = listenerStreamIndex, talkerStream = talkerStream](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+					{
+						avdecc::ControllerManager::getInstance().connectStream(talkerStream.entityID, talkerStream.streamIndex, entityID, listenerStreamIndex, makeAcmpResponseHandler(parentCommandSet, commandIndex, ControllerManager::AcmpCommandType::ConnectStream));
+						return true;
+					});
+			}
+			addCommandSet(entityID, commands);
+		}
+
+		// Clock sources, last so a stream used as clock source is already connected
+		{
+			auto commands = AsyncCommands{};
+			for (auto const& [clockDomainIndex, clockSourceIndex] : diff.clockSources)
+			{
+				commands.push_back(
+					[entityID, clockDomainIndex = clockDomainIndex, clockSourceIndex = clockSourceIndex](commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+					{
+						avdecc::ControllerManager::getInstance().setClockSource(entityID, clockDomainIndex, clockSourceIndex, makeAemResponseHandler(parentCommandSet, commandIndex, ControllerManager::AecpCommandType::SetClockSource));
+						return true;
+					});
+			}
+			addCommandSet(entityID, commands);
+		}
+	}
+
+	void finishRecall() noexcept
+	{
+		_isRunning = false;
+		auto const info = std::move(_recallInfo);
+		_recallInfo = {};
+		emit finished(info);
+	}
+
+	// RoutingSnapshotManager overrides
+	virtual bool recall(Snapshot const& snapshot, size_t const maxConcurrentEntities) noexcept override
+	{
+		if (_isRunning)
+		{
+			return false;
+		}
+
+		_executer.clear();
+		_executer.setMaxRunningCommandSets(maxConcurrentEntities);
+		_recallInfo = {};
+
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto changedEntities = ControllerManager::EntityIDs{};
+		for (auto const& [entityID, routing] : snapshot)
+		{
+			auto controlledEntity = manager.getControlledEntity(entityID);
+			if (!controlledEntity || !isAemSupported(*controlledEntity))
+			{
+				_recallInfo.missingEntities.push_back(entityID);
+				continue;
+			}
+
+			try
+			{
+				auto const diff = computeDiff(*controlledEntity, routing);
+				if (diff.empty())
+				{
+					++_recallInfo.unchangedEntities;
+					continue;
+				}
+				addEntityCommands(entityID, diff);
+				changedEntities.push_back(entityID);
+			}
+			catch (la::avdecc::controller::ControlledEntity::Exception const&)
+			{
+				_recallInfo.missingEntities.push_back(entityID);
+			}
+		}
+		_recallInfo.changedEntities = changedEntities.size();
+
+		_isRunning = true;
+
+		if (changedEntities.empty())
+		{
+			finishRecall();
+			return true;
+		}
+
+		// Lock the entities that differ for the whole recall, so other controllers cannot change them halfway
+		manager.requestExclusiveAccesses(changedEntities, la::avdecc::controller::Controller::ExclusiveAccessToken::AccessType::Lock,
+			[this](ControllerManager::ExclusiveAccessGroupPointer const& group, ControllerManager::ExclusiveAccessFailures const& failures)
+			{
+				QMetaObject::invokeMethod(this,
+					[this, group, failures]()
+					{
+						if (!group)
+						{
+							_executer.clear();
+							for (auto const& [entityID, status] : failures)
+							{
+								_recallInfo.errors.emplace(entityID, commandChain::CommandErrorInfo{ commandChain::AsyncParallelCommandSet::aemCommandStatusToCommandError(status), std::nullopt, ControllerManager::AecpCommandType::LockEntity });
+							}
+							finishRecall();
+							return;
+						}
+
+						_exclusiveAccess = group;
+						_executer.start();
+					});
+			});
+
+		return true;
+	}
+
+	virtual bool isRunning() const noexcept override
+	{
+		return _isRunning;
+	}
+
+	// Private members
+	commandChain::AsyncCommandGraphExecuter _executer{};
+	ControllerManager::ExclusiveAccessGroupPointer _exclusiveAccess{}; // Locks held on the changed entities until the recall completes
+	RecallInfo _recallInfo{};
+	bool _isRunning{ false };
+};
+
+RoutingSnapshotManager& RoutingSnapshotManager::getInstance() noexcept
+{
+	static RoutingSnapshotManagerImpl s_manager{};
+
+	return s_manager;
+}
+
+} // namespace routingSnapshot
+} // namespace avdecc
@@ -0,0 +1,95 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/controller/avdeccController.hpp>
+#include <QObject>
+#include <QByteArray>
+#include <QString>
+
+#include "avdecc/controllerManager.hpp"
+#include "avdecc/commandChain.hpp"
+
+#include <cstdint>
+#include <map>
+
+namespace avdecc
+{
+namespace routingSnapshot
+{
+/**
+* Routing state of one entity, as far as a controller can restore it.
+* Channel connections are not stored as such, they are the result of the stream connections and the dynamic audio mappings.
+* Media clock domains are the result of the clock sources and the (CRF or AAF) stream connections.
+*/
+struct EntityRouting
+{
+	QString name{}; // Only used to report the entities missing when recalling
+	std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::entity::model::StreamIdentification> streamInputConnections{}; // Talker stream of each connected stream input, the other stream inputs are disconnected
+	std::map<la::avdecc::entity::model::StreamPortIndex, la::avdecc::entity::model::AudioMappings> streamPortInputMappings{}; // Stream ports with dynamic mappings only
+	std::map<la::avdecc::entity::model::StreamPortIndex, la::avdecc::entity::model::AudioMappings> streamPortOutputMappings{}; // Stream ports with dynamic mappings only
+	std::map<la::avdecc::entity::model::ClockDomainIndex, la::avdecc::entity::model::ClockSourceIndex> clockSources{};
+};
+using Snapshot = std::map<la::avdecc::UniqueIdentifier, EntityRouting>;
+
+/** Captures the routing state of all the online entities supporting AEM */
+Snapshot capture() noexcept;
+
+/** Serializes a snapshot as compact JSON */
+QByteArray serialize(Snapshot const& snapshot) noexcept;
+
+/**
+* @brief Deserializes a snapshot previously serialized with serialize().
+* @return An empty string on success, the error otherwise.
+*/
+QString deserialize(QByteArray const& data, Snapshot& snapshot) noexcept;
+
+struct RecallInfo
+{
+	size_t changedEntities{ 0u }; // Entities whose routing differed from the snapshot
+	size_t unchangedEntities{ 0u }; // Entities already matching the snapshot, not sent any command
+	ControllerManager::EntityIDs missingEntities{}; // Entities of the snapshot not currently online
+	commandChain::CommandExecutionErrors errors{};
+};
+
+/**
+* @brief Recalls routing snapshots by only applying the difference between the live state and the snapshot.
+*		 The commands of an entity are executed in three steps (disconnect and unmap, map and connect, clock sources),
+*		 while entities are processed in parallel with a bounded count of entities in progress.
+*		 Entities that differ from the snapshot are locked for the whole recall, the others are not touched at all.
+*/
+class RoutingSnapshotManager : public QObject
+{
+	Q_OBJECT
+public:
+	static constexpr size_t DefaultMaxConcurrentEntities = 16;
+
+	static RoutingSnapshotManager& getInstance() noexcept;
+
+	/** Starts recalling a snapshot, returns false if a recall is already running */
+	virtual bool recall(Snapshot const& snapshot, size_t const maxConcurrentEntities = DefaultMaxConcurrentEntities) noexcept = 0;
+	virtual bool isRunning() const noexcept = 0;
+
+	Q_SIGNAL void progressUpdate(uint32_t const completedCommands, uint32_t const totalCommands);
+	Q_SIGNAL void finished(avdecc::routingSnapshot::RecallInfo const& info);
+};
+
+} // namespace routingSnapshot
+} // namespace avdecc
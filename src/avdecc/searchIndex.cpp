@@ -0,0 +1,498 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "searchIndex.hpp"
+#include "controllerManager.hpp"
+#include "helper.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+namespace avdecc
+{
+namespace search
+{
+namespace
+{
+using DocumentID = std::uint32_t;
+using Trigram = std::uint64_t;
+
+/** A posting refers to a given version of a document slot, so postings of a removed (or reused) slot are simply skipped until the next compaction */
+struct Posting
+{
+	DocumentID documentID{ 0u };
+	std::uint32_t generation{ 0u };
+};
+
+struct DocumentKey
+{
+	la::avdecc::UniqueIdentifier entityID{};
+	Document::Kind kind{ Document::Kind::Entity };
+	std::uint16_t descriptorIndex{ 0u };
+
+	bool operator==(DocumentKey const& other) const noexcept
+	{
+		return entityID == other.entityID && kind == other.kind && descriptorIndex == other.descriptorIndex;
+	}
+
+	struct hash
+	{
+		std::size_t operator()(DocumentKey const& key) const noexcept
+		{
+			return la::avdecc::UniqueIdentifier::hash{}(key.entityID) ^ (std::hash<std::uint32_t>{}((static_cast<std::uint32_t>(key.kind) << 16) | key.descriptorIndex) << 1);
+		}
+	};
+};
+
+/** Distinct trigrams of an already case folded text */
+std::vector<Trigram> makeTrigrams(QString const& folded) noexcept
+{
+	auto trigrams = std::vector<Trigram>{};
+	if (folded.size() < 3)
+	{
+		return trigrams;
+	}
+
+	trigrams.reserve(folded.size() - 2);
+	for (auto i = 0; i + 2 < folded.size(); ++i)
+	{
+		trigrams.push_back((static_cast<Trigram>(folded[i].unicode()) << 32) | (static_cast<Trigram>(folded[i + 1].unicode()) << 16) | static_cast<Trigram>(folded[i + 2].unicode()));
+	}
+	std::sort(trigrams.begin(), trigrams.end());
+	trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+	return trigrams;
+}
+
+/** 0 for a prefix match, 1 for a match at the start of a word, 2 otherwise */
+int matchRank(QString const& folded, QString const& foldedQuery) noexcept
+{
+	auto const position = folded.indexOf(foldedQuery);
+	if (position == 0)
+	{
+		return 0;
+	}
+	if (position > 0 && !folded[position - 1].isLetterOrNumber())
+	{
+		return 1;
+	}
+	return 2;
+}
+
+} // namespace
+
+// **************************************************************
+// class SearchIndexImpl
+// **************************************************************
+class SearchIndexImpl final : public SearchIndex
+{
+public:
+	SearchIndexImpl() noexcept
+	{
+		auto& manager = ControllerManager::getInstance();
+		connect(&manager, &ControllerManager::controllerOffline, this, &SearchIndexImpl::handleControllerOffline);
+		connect(&manager, &ControllerManager::entityOnline, this, &SearchIndexImpl::handleEntityOnline);
+		connect(&manager, &ControllerManager::entityOffline, this, &SearchIndexImpl::handleEntityOffline);
+		connect(&manager, &ControllerManager::entityNameChanged, this, &SearchIndexImpl::handleEntityNameChanged);
+		connect(&manager, &ControllerManager::entityGroupNameChanged, this, &SearchIndexImpl::handleEntityGroupNameChanged);
+		connect(&manager, &ControllerManager::streamNameChanged, this, &SearchIndexImpl::handleStreamNameChanged);
+		connect(&manager, &ControllerManager::audioClusterNameChanged, this, &SearchIndexImpl::handleAudioClusterNameChanged);
+	}
+
+	// Deleted compiler auto-generated methods
+	SearchIndexImpl(SearchIndexImpl const&) = delete;
+	SearchIndexImpl(SearchIndexImpl&&) = delete;
+	SearchIndexImpl& operator=(SearchIndexImpl const&) = delete;
+	SearchIndexImpl& operator=(SearchIndexImpl&&) = delete;
+
+private:
+	struct Slot
+	{
+		Document document{};
+		QString folded{};
+		std::uint32_t generation{ 0u };
+		std::uint32_t postingsCount{ 0u };
+		bool isAlive{ false };
+	};
+
+	// SearchIndex overrides
+	virtual Documents search(QString const& query, size_t const maxResults) const noexcept override
+	{
+		auto const foldedQuery = query.trimmed().toCaseFolded();
+		if (foldedQuery.isEmpty() || maxResults == 0)
+		{
+			return {};
+		}
+
+		auto candidates = std::vector<DocumentID>{};
+
+		if (foldedQuery.size() < 3)
+		{
+			// Too short for the trigrams, prefix match on the sorted names
+			for (auto it = _sortedNames.lower_bound({ foldedQuery, DocumentID{ 0u } }); it != _sortedNames.end() && it->first.startsWith(foldedQuery) && candidates.size() < maxResults; ++it)
+			{
+				candidates.push_back(it->second);
+			}
+		}
+		else
+		{
+			// The candidates are the postings of the rarest trigram of the query, each one being checked against the whole query
+			auto const* rarestPostings = static_cast<std::vector<Posting> const*>(nullptr);
+			for (auto const trigram : makeTrigrams(foldedQuery))
+			{
+				auto const it = _postings.find(trigram);
+				if (it == _postings.end())
+				{
+					return {};
+				}
+				if (!rarestPostings || it->second.size() < rarestPostings->size())
+				{
+					rarestPostings = &it->second;
+				}
+			}
+
+			for (auto const& posting : *rarestPostings)
+			{
+				auto const& slot = _slots[posting.documentID];
+				if (slot.isAlive && slot.generation == posting.generation && slot.folded.contains(foldedQuery))
+				{
+					candidates.push_back(posting.documentID);
+				}
+			}
+		}
+
+		// Best matches first, only the returned ones being fully sorted
+		using Rank = std::tuple<int, int, int, DocumentID>;
+		auto ranks = std::vector<Rank>{};
+		ranks.reserve(candidates.size());
+		for (auto const documentID : candidates)
+		{
+			auto const& slot = _slots[documentID];
+			ranks.emplace_back(matchRank(slot.folded, foldedQuery), static_cast<int>(slot.document.kind), slot.folded.size(), documentID);
+		}
+
+		auto const count = std::min(maxResults, ranks.size());
+		std::partial_sort(ranks.begin(), ranks.begin() + count, ranks.end());
+
+		auto documents = Documents{};
+		documents.reserve(count);
+		for (auto i = size_t{ 0u }; i < count; ++i)
+		{
+			documents.push_back(_slots[std::get<3>(ranks[i])].document);
+		}
+
+		return documents;
+	}
+
+	virtual size_t getDocumentsCount() const noexcept override
+	{
+		return _keys.size();
+	}
+
+	// Private methods
+	void setDocument(Document const& document) noexcept
+	{
+		auto const key = DocumentKey{ document.entityID, document.kind, document.descriptorIndex };
+
+		if (auto const it = _keys.find(key); it != _keys.end())
+		{
+			auto const documentID = it->second;
+			if (_slots[documentID].document.text == document.text)
+			{
+				return;
+			}
+
+			auto& entityDocuments = _entityDocuments[document.entityID];
+			entityDocuments.erase(std::remove(entityDocuments.begin(), entityDocuments.end(), documentID), entityDocuments.end());
+			releaseSlot(documentID);
+		}
+
+		if (document.text.isEmpty())
+		{
+			return;
+		}
+
+		auto documentID = DocumentID{ 0u };
+		if (!_freeSlots.empty())
+		{
+			documentID = _freeSlots.back();
+			_freeSlots.pop_back();
+		}
+		else
+		{
+			documentID = static_cast<DocumentID>(_slots.size());
+			_slots.emplace_back();
+		}
+
+		auto& slot = _slots[documentID];
+		++slot.generation;
+		slot.document = document;
+		slot.folded = document.text.toCaseFolded();
+		slot.isAlive = true;
+
+		auto const trigrams = makeTrigrams(slot.folded);
+		for (auto const trigram : trigrams)
+		{
+			_postings[trigram].push_back(Posting{ documentID, slot.generation });
+		}
+		slot.postingsCount = static_cast<std::uint32_t>(trigrams.size());
+		_postingsCount += trigrams.size();
+
+		_sortedNames.emplace(slot.folded, documentID);
+		_keys[key] = documentID;
+		_entityDocuments[document.entityID].push_back(documentID);
+	}
+
+	// Releases the slot, the caller being responsible for the entity documents list
+	void releaseSlot(DocumentID const documentID) noexcept
+	{
+		auto& slot = _slots[documentID];
+
+		_keys.erase(DocumentKey{ slot.document.entityID, slot.document.kind, slot.document.descriptorIndex });
+		_sortedNames.erase({ slot.folded, documentID });
+		_stalePostingsCount += slot.postingsCount;
+
+		slot.document = {};
+		slot.folded.clear();
+		slot.postingsCount = 0u;
+		slot.isAlive = false;
+		_freeSlots.push_back(documentID);
+
+		compactPostings();
+	}
+
+	// Drops the stale postings once they outnumber the live ones, so the amortized cost of a removal stays constant
+	void compactPostings() noexcept
+	{
+		if (_stalePostingsCount * 2 <= _postingsCount)
+		{
+			return;
+		}
+
+		for (auto it = _postings.begin(); it != _postings.end();)
+		{
+			auto& postings = it->second;
+			postings.erase(std::remove_if(postings.begin(), postings.end(),
+											 [this](Posting const& posting)
+											 {
+												 auto const& slot = _slots[posting.documentID];
+												 return !slot.isAlive || slot.generation != posting.generation;
+											 }),
+				postings.end());
+
+			if (postings.empty())
+			{
+				it = _postings.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		_postingsCount -= _stalePostingsCount;
+		_stalePostingsCount = 0u;
+	}
+
+	void indexStream(la::avdecc::controller::ControlledEntity const& controlledEntity, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex) noexcept
+	{
+		auto const entityID = controlledEntity.getEntity().getEntityID();
+		if (descriptorType == la::avdecc::entity::model::DescriptorType::StreamOutput)
+		{
+			setDocument(Document{ Document::Kind::StreamOutput, entityID, streamIndex, helper::outputStreamName(controlledEntity, streamIndex) });
+		}
+		else if (descriptorType == la::avdecc::entity::model::DescriptorType::StreamInput)
+		{
+			setDocument(Document{ Document::Kind::StreamInput, entityID, streamIndex, helper::inputStreamName(controlledEntity, streamIndex) });
+		}
+	}
+
+	template<class StreamPortNodes>
+	void indexAudioClusters(la::avdecc::controller::ControlledEntity const& controlledEntity, StreamPortNodes const& streamPortNodes, std::optional<la::avdecc::entity::model::ClusterIndex> const onlyClusterIndex = std::nullopt) noexcept
+	{
+		auto const entityID = controlledEntity.getEntity().getEntityID();
+		for (auto const& streamPortKV : streamPortNodes)
+		{
+			for (auto const& [clusterIndex, clusterNode] : streamPortKV.second.audioClusters)
+			{
+				if (!onlyClusterIndex || *onlyClusterIndex == clusterIndex)
+				{
+					setDocument(Document{ Document::Kind::AudioCluster, entityID, clusterIndex, helper::objectName(&controlledEntity, clusterNode) });
+				}
+			}
+		}
+	}
+
+	// Slots
+	void handleControllerOffline() noexcept
+	{
+		_slots.clear();
+		_freeSlots.clear();
+		_postings.clear();
+		_sortedNames.clear();
+		_keys.clear();
+		_entityDocuments.clear();
+		_postingsCount = 0u;
+		_stalePostingsCount = 0u;
+	}
+
+	void handleEntityOnline(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		auto controlledEntity = ControllerManager::getInstance().getControlledEntity(entityID);
+		if (!controlledEntity)
+		{
+			return;
+		}
+
+		setDocument(Document{ Document::Kind::EntityID, entityID, 0u, helper::uniqueIdentifierToString(entityID) });
+
+		if (!controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+		{
+			return;
+		}
+
+		setDocument(Document{ Document::Kind::Entity, entityID, 0u, helper::entityName(*controlledEntity) });
+		setDocument(Document{ Document::Kind::Group, entityID, 0u, helper::groupName(*controlledEntity) });
+
+		try
+		{
+			auto const& configurationNode = controlledEntity->getCurrentConfigurationNode();
+
+			for (auto const& streamOutputKV : configurationNode.streamOutputs)
+			{
+				indexStream(*controlledEntity, la::avdecc::entity::model::DescriptorType::StreamOutput, streamOutputKV.first);
+			}
+			for (auto const& streamInputKV : configurationNode.streamInputs)
+			{
+				indexStream(*controlledEntity, la::avdecc::entity::model::DescriptorType::StreamInput, streamInputKV.first);
+			}
+			for (auto const& audioUnitKV : configurationNode.audioUnits)
+			{
+				indexAudioClusters(*controlledEntity, audioUnitKV.second.streamPortInputs);
+				indexAudioClusters(*controlledEntity, audioUnitKV.second.streamPortOutputs);
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+	}
+
+	void handleEntityOffline(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		auto const it = _entityDocuments.find(entityID);
+		if (it == _entityDocuments.end())
+		{
+			return;
+		}
+
+		auto const documentIDs = std::move(it->second);
+		_entityDocuments.erase(it);
+
+		for (auto const documentID : documentIDs)
+		{
+			releaseSlot(documentID);
+		}
+	}
+
+	void handleEntityNameChanged(la::avdecc::UniqueIdentifier const entityID, QString const& entityName) noexcept
+	{
+		if (_entityDocuments.count(entityID) != 0)
+		{
+			setDocument(Document{ Document::Kind::Entity, entityID, 0u, entityName });
+		}
+	}
+
+	void handleEntityGroupNameChanged(la::avdecc::UniqueIdentifier const entityID, QString const& entityGroupName) noexcept
+	{
+		if (_entityDocuments.count(entityID) != 0)
+		{
+			setDocument(Document{ Document::Kind::Group, entityID, 0u, entityGroupName });
+		}
+	}
+
+	void handleStreamNameChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex) noexcept
+	{
+		auto controlledEntity = ControllerManager::getInstance().getControlledEntity(entityID);
+		if (!controlledEntity || _entityDocuments.count(entityID) == 0)
+		{
+			return;
+		}
+
+		try
+		{
+			// Only the current configuration is indexed, and the displayed name falls back to the localized description when the new name is empty
+			if (controlledEntity->getCurrentConfigurationNode().descriptorIndex == configurationIndex)
+			{
+				indexStream(*controlledEntity, descriptorType, streamIndex);
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+	}
+
+	void handleAudioClusterNameChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClusterIndex const audioClusterIndex) noexcept
+	{
+		auto controlledEntity = ControllerManager::getInstance().getControlledEntity(entityID);
+		if (!controlledEntity || _entityDocuments.count(entityID) == 0)
+		{
+			return;
+		}
+
+		try
+		{
+			auto const& configurationNode = controlledEntity->getCurrentConfigurationNode();
+			if (configurationNode.descriptorIndex == configurationIndex)
+			{
+				for (auto const& audioUnitKV : configurationNode.audioUnits)
+				{
+					indexAudioClusters(*controlledEntity, audioUnitKV.second.streamPortInputs, audioClusterIndex);
+					indexAudioClusters(*controlledEntity, audioUnitKV.second.streamPortOutputs, audioClusterIndex);
+				}
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+	}
+
+	// Private members
+	std::vector<Slot> _slots{};
+	std::vector<DocumentID> _freeSlots{};
+	std::unordered_map<Trigram, std::vector<Posting>> _postings{};
+	std::set<std::pair<QString, DocumentID>> _sortedNames{}; // Case folded names, for the prefix lookups
+	std::unordered_map<DocumentKey, DocumentID, DocumentKey::hash> _keys{};
+	std::unordered_map<la::avdecc::UniqueIdentifier, std::vector<DocumentID>, la::avdecc::UniqueIdentifier::hash> _entityDocuments{};
+	size_t _postingsCount{ 0u };
+	size_t _stalePostingsCount{ 0u };
+};
+
+SearchIndex& SearchIndex::getInstance() noexcept
+{
+	static SearchIndexImpl s_index{};
+
+	return s_index;
+}
+
+} // namespace search
+} // namespace avdecc
@@ -0,0 +1,71 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/controller/avdeccController.hpp>
+#include <QObject>
+#include <QString>
+
+#include <cstdint>
+#include <vector>
+
+namespace avdecc
+{
+namespace search
+{
+/** A named object of the network that can be looked up */
+struct Document
+{
+	enum class Kind
+	{
+		Entity, // Entity name
+		EntityID, // Entity ID as displayed (0x...)
+		Group, // Entity group name
+		StreamOutput,
+		StreamInput,
+		AudioCluster,
+	};
+
+	Kind kind{ Kind::Entity };
+	la::avdecc::UniqueIdentifier entityID{};
+	std::uint16_t descriptorIndex{ 0u }; // StreamIndex or ClusterIndex, 0 for the entity level documents
+	QString text{};
+};
+
+using Documents = std::vector<Document>;
+
+/**
+* @brief Index of the names of the entities, entity groups, streams and audio clusters of the current configurations (and of the entity IDs), kept up-to-date from the name change events.
+*		 Queries of at least 3 characters are looked up in trigram posting lists (case insensitive substring match), shorter queries in the sorted names (prefix match),
+*		 so the cost of a query only depends on the number of candidates and not on the size of the network.
+*/
+class SearchIndex : public QObject
+{
+	Q_OBJECT
+public:
+	static SearchIndex& getInstance() noexcept;
+
+	/** Returns at most maxResults documents matching the query, best matches first (prefix matches, then word matches, then entity level documents) */
+	virtual Documents search(QString const& query, size_t const maxResults) const noexcept = 0;
+	virtual size_t getDocumentsCount() const noexcept = 0;
+};
+
+} // namespace search
+} // namespace avdecc
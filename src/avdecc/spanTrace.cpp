@@ -0,0 +1,165 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "spanTrace.hpp"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace avdecc::spanTrace
+{
+namespace
+{
+struct Span
+{
+	char const* name{ nullptr };
+	Clock::time_point start{};
+	Clock::duration duration{};
+};
+
+/** Ring buffer of a thread. The lock is only contended while clearing or exporting */
+struct ThreadBuffer
+{
+	std::uint32_t threadIndex{ 0u };
+	QString threadName{};
+	std::mutex lock{};
+	std::vector<Span> spans{};
+	std::size_t next{ 0u };
+};
+
+std::mutex s_buffersLock{};
+std::vector<std::shared_ptr<ThreadBuffer>> s_buffers{}; // Kept after their thread exited, so their spans can still be exported
+Clock::time_point s_origin{ Clock::now() };
+
+std::shared_ptr<ThreadBuffer> registerThread() noexcept
+{
+	auto buffer = std::make_shared<ThreadBuffer>();
+
+	auto const* const thread = QThread::currentThread();
+	auto const* const app = QCoreApplication::instance();
+	if (app && thread == app->thread())
+	{
+		buffer->threadName = "Main Thread";
+	}
+	else if (thread && !thread->objectName().isEmpty())
+	{
+		buffer->threadName = thread->objectName();
+	}
+
+	auto const lg = std::lock_guard{ s_buffersLock };
+	buffer->threadIndex = static_cast<std::uint32_t>(s_buffers.size()) + 1u;
+	if (buffer->threadName.isEmpty())
+	{
+		buffer->threadName = QString("Thread %1").arg(buffer->threadIndex);
+	}
+	s_buffers.push_back(buffer);
+	return buffer;
+}
+
+ThreadBuffer& threadBuffer() noexcept
+{
+	thread_local auto const s_threadBuffer = registerThread();
+	return *s_threadBuffer;
+}
+
+} // namespace
+
+void setEnabled(bool const enabled) noexcept
+{
+	if (enabled)
+	{
+		auto const lg = std::lock_guard{ s_buffersLock };
+		for (auto const& buffer : s_buffers)
+		{
+			auto const bufferLg = std::lock_guard{ buffer->lock };
+			buffer->spans.clear();
+			buffer->next = 0u;
+		}
+		s_origin = Clock::now();
+	}
+	s_isEnabled = enabled;
+}
+
+void recordSpan(char const* const name, Clock::time_point const start, Clock::time_point const end) noexcept
+{
+	auto& buffer = threadBuffer();
+	auto const lg = std::lock_guard{ buffer.lock };
+
+	auto const span = Span{ name, start, end - start };
+	if (buffer.spans.size() < SpansPerThread)
+	{
+		buffer.spans.push_back(span);
+	}
+	else
+	{
+		buffer.spans[buffer.next] = span;
+	}
+	buffer.next = (buffer.next + 1u) % SpansPerThread;
+}
+
+bool exportChromeTrace(QString const& filePath) noexcept
+{
+	auto const toMicroseconds = [](Clock::duration const duration)
+	{
+		return std::chrono::duration<double, std::micro>{ duration }.count();
+	};
+
+	auto events = QJsonArray{};
+	{
+		auto const lg = std::lock_guard{ s_buffersLock };
+		for (auto const& buffer : s_buffers)
+		{
+			auto const bufferLg = std::lock_guard{ buffer->lock };
+			if (buffer->spans.empty())
+			{
+				continue;
+			}
+
+			events.append(QJsonObject{ { "name", "thread_name" }, { "ph", "M" }, { "pid", 1 }, { "tid", static_cast<qint64>(buffer->threadIndex) }, { "args", QJsonObject{ { "name", buffer->threadName } } } });
+			for (auto const& span : buffer->spans)
+			{
+				// Spans started before the recording was (re)enabled
+				if (span.start < s_origin)
+				{
+					continue;
+				}
+				events.append(QJsonObject{ { "name", span.name }, { "ph", "X" }, { "pid", 1 }, { "tid", static_cast<qint64>(buffer->threadIndex) }, { "ts", toMicroseconds(span.start - s_origin) }, { "dur", toMicroseconds(span.duration) } });
+			}
+		}
+	}
+
+	auto file = QFile{ filePath };
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		return false;
+	}
+	auto const json = QJsonDocument{ QJsonObject{ { "traceEvents", events }, { "displayTimeUnit", "ms" } } }.toJson(QJsonDocument::Compact);
+	return file.write(json) == json.size();
+}
+
+} // namespace avdecc::spanTrace
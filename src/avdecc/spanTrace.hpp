@@ -0,0 +1,91 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QString>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+/**
+* Lightweight tracing of the hot paths, exported as a Chrome/Perfetto JSON trace (chrome://tracing, ui.perfetto.dev).
+* Spans are recorded in a ring buffer per thread while tracing is enabled. When disabled, a span only costs the test of an atomic flag.
+*/
+namespace avdecc::spanTrace
+{
+using Clock = std::chrono::steady_clock;
+
+/** Number of spans kept per thread, the oldest ones being overwritten */
+static constexpr auto SpansPerThread = std::size_t{ 32768u };
+
+/** Do not use directly, see isEnabled() */
+inline std::atomic_bool s_isEnabled{ false };
+
+inline bool isEnabled() noexcept
+{
+	return s_isEnabled.load(std::memory_order_relaxed);
+}
+
+/** Starts (clearing the previously recorded spans) or stops recording */
+void setEnabled(bool const enabled) noexcept;
+
+/** Records a span. The name must be a string literal (only the pointer is stored) */
+void recordSpan(char const* const name, Clock::time_point const start, Clock::time_point const end) noexcept;
+
+/** Writes the spans recorded by all the threads to a Chrome trace file */
+bool exportChromeTrace(QString const& filePath) noexcept;
+
+/** Records a span for the lifetime of the object, if tracing was enabled when it was created */
+class ScopedSpan final
+{
+public:
+	explicit ScopedSpan(char const* const name) noexcept
+		: _name{ isEnabled() ? name : nullptr }
+	{
+		if (_name)
+		{
+			_start = Clock::now();
+		}
+	}
+
+	~ScopedSpan() noexcept
+	{
+		if (_name)
+		{
+			recordSpan(_name, _start, Clock::now());
+		}
+	}
+
+	// Deleted compiler auto-generated methods
+	ScopedSpan(ScopedSpan const&) = delete;
+	ScopedSpan(ScopedSpan&&) = delete;
+	ScopedSpan& operator=(ScopedSpan const&) = delete;
+	ScopedSpan& operator=(ScopedSpan&&) = delete;
+
+private:
+	char const* const _name{ nullptr };
+	Clock::time_point _start{};
+};
+
+} // namespace avdecc::spanTrace
+
+/** Traces the enclosing scope (one per scope), the name must be a string literal */
+#define HIVE_TRACE_SPAN(name) avdecc::spanTrace::ScopedSpan const _hiveTraceSpan_{ name }
@@ -0,0 +1,350 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "stressLoad.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+namespace avdecc::stressLoad
+{
+// Grandmasters the gPTP changes alternate between
+static constexpr std::uint64_t StressGrandMasterIDs[] = { 0x001B92FFFE5A0001, 0x001B92FFFE5A0002, 0x001B92FFFE5A0003 };
+// One out of this many counters updates changes the media lock state of the stream
+static constexpr auto MediaLockTransitionPeriod = 20u;
+
+std::optional<EntityInfo> makeEntityInfo(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept
+{
+	try
+	{
+		if (!controlledEntity.getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+		{
+			return std::nullopt;
+		}
+
+		auto const& entityNode = controlledEntity.getEntityNode();
+		if (!entityNode.dynamicModel)
+		{
+			return std::nullopt;
+		}
+
+		auto const& configurationNode = controlledEntity.getConfigurationNode(entityNode.dynamicModel->currentConfiguration);
+
+		auto info = EntityInfo{};
+		info.entityID = controlledEntity.getEntity().getEntityID();
+		info.name = entityNode.dynamicModel->entityName;
+		info.streamInputsCount = static_cast<la::avdecc::entity::model::StreamIndex>(configurationNode.streamInputs.size());
+		info.streamOutputsCount = static_cast<la::avdecc::entity::model::StreamIndex>(configurationNode.streamOutputs.size());
+		info.avbInterfacesCount = static_cast<la::avdecc::entity::model::AvbInterfaceIndex>(configurationNode.avbInterfaces.size());
+
+		info.streamInputConnections.reserve(configurationNode.streamInputs.size());
+		for (auto const& [streamIndex, streamInputNode] : configurationNode.streamInputs)
+		{
+			auto state = la::avdecc::entity::model::StreamConnectionState{};
+			if (streamInputNode.dynamicModel)
+			{
+				state = streamInputNode.dynamicModel->connectionState;
+			}
+			state.listenerStream = la::avdecc::entity::model::StreamIdentification{ info.entityID, streamIndex };
+			info.streamInputConnections.push_back(state);
+		}
+
+		return info;
+	}
+	catch (...)
+	{
+		return std::nullopt;
+	}
+}
+
+Generator::Generator(Parameters const& parameters, EntityInfos&& entities) noexcept
+	: _parameters{ parameters }
+	, _random{ parameters.seed }
+{
+	_entities.reserve(entities.size());
+	for (auto& info : entities)
+	{
+		auto state = EntityState{};
+		state.streamInputCounters.resize(info.streamInputsCount);
+		state.info = std::move(info);
+		_entities.push_back(std::move(state));
+	}
+
+	if (_entities.empty())
+	{
+		return;
+	}
+
+	for (auto kind = 0; kind < static_cast<int>(Kind::Count); ++kind)
+	{
+		scheduleNext(static_cast<Kind>(kind), Timestamp{ 0 });
+	}
+}
+
+std::optional<observerTrace::Event> Generator::next() noexcept
+{
+	auto const duration = std::chrono::duration_cast<Timestamp>(_parameters.duration);
+
+	while (!_nextTimestamps.empty() || !_pendingOnlines.empty())
+	{
+		// Entities coming back online first, if due before the next change
+		auto const nextIt = std::min_element(_nextTimestamps.begin(), _nextTimestamps.end(),
+			[](auto const& lhs, auto const& rhs)
+			{
+				return lhs.second < rhs.second;
+			});
+		if (!_pendingOnlines.empty() && (nextIt == _nextTimestamps.end() || _pendingOnlines.front().first <= nextIt->second))
+		{
+			auto const [timestamp, index] = _pendingOnlines.front();
+			if (duration.count() != 0 && timestamp > duration)
+			{
+				return std::nullopt;
+			}
+			_pendingOnlines.pop_front();
+			auto& entity = _entities[index];
+			entity.isOffline = false;
+			return makeTraceEvent(timestamp, observerTrace::EventType::EntityOnline, entity.info.entityID);
+		}
+
+		auto const [kind, timestamp] = *nextIt;
+		if (duration.count() != 0 && timestamp > duration)
+		{
+			return std::nullopt;
+		}
+		scheduleNext(kind, timestamp);
+
+		// No entity may be eligible for this kind of change right now (all offline, no stream...), try the next one
+		if (auto event = makeEvent(kind, timestamp))
+		{
+			return event;
+		}
+	}
+
+	return std::nullopt;
+}
+
+std::vector<observerTrace::Event> Generator::restoringEvents() noexcept
+{
+	auto events = std::vector<observerTrace::Event>{};
+
+	for (auto const& [timestamp, index] : _pendingOnlines)
+	{
+		auto& entity = _entities[index];
+		entity.isOffline = false;
+		events.push_back(makeTraceEvent(timestamp, observerTrace::EventType::EntityOnline, entity.info.entityID));
+	}
+	_pendingOnlines.clear();
+
+	for (auto& entity : _entities)
+	{
+		if (entity.nameChangesCount % 2u != 0u)
+		{
+			entity.nameChangesCount = 0u;
+			events.push_back(makeTraceEvent(Timestamp{ 0 }, observerTrace::EventType::EntityNameChanged, entity.info.entityID, entity.info.name));
+		}
+	}
+
+	return events;
+}
+
+void Generator::scheduleNext(Kind const kind, Timestamp const from) noexcept
+{
+	auto rate = 0.0;
+	switch (kind)
+	{
+		case Kind::StreamInputCounters:
+			rate = _parameters.rates.streamInputCounters;
+			break;
+		case Kind::GptpChange:
+			rate = _parameters.rates.gptpChanges;
+			break;
+		case Kind::ConnectionToggle:
+			rate = _parameters.rates.connectionToggles;
+			break;
+		case Kind::NameChange:
+			rate = _parameters.rates.nameChanges;
+			break;
+		case Kind::OfflineOnlineCycle:
+			rate = _parameters.rates.offlineOnlineCycles;
+			break;
+		default:
+			break;
+	}
+
+	if (rate <= 0.0)
+	{
+		_nextTimestamps.erase(kind);
+		return;
+	}
+
+	// Exponentially distributed intervals, at least 1 usec so the timestamps are always increasing
+	auto const interval = std::exponential_distribution<double>{ rate }(_random);
+	_nextTimestamps[kind] = from + std::max(Timestamp{ 1 }, Timestamp{ static_cast<Timestamp::rep>(interval * 1'000'000.0) });
+}
+
+template<typename Predicate>
+Generator::EntityState* Generator::pickEntity(Predicate const& predicate) noexcept
+{
+	// Start at a random entity and take the first eligible one
+	auto const count = _entities.size();
+	auto const first = std::uniform_int_distribution<std::size_t>{ 0u, count - 1u }(_random);
+	for (auto offset = std::size_t{ 0u }; offset < count; ++offset)
+	{
+		auto& entity = _entities[(first + offset) % count];
+		if (!entity.isOffline && predicate(entity))
+		{
+			return &entity;
+		}
+	}
+	return nullptr;
+}
+
+std::optional<observerTrace::Event> Generator::makeEvent(Kind const kind, Timestamp const timestamp) noexcept
+{
+	switch (kind)
+	{
+		case Kind::StreamInputCounters:
+		{
+			auto* const entity = pickEntity(
+				[](auto const& e)
+				{
+					return e.info.streamInputsCount != 0u;
+				});
+			if (!entity)
+			{
+				return std::nullopt;
+			}
+
+			auto const streamIndex = std::uniform_int_distribution<la::avdecc::entity::model::StreamIndex>{ 0u, static_cast<la::avdecc::entity::model::StreamIndex>(entity->info.streamInputsCount - 1u) }(_random);
+			auto& state = entity->streamInputCounters[streamIndex];
+			state.framesRx += std::uniform_int_distribution<la::avdecc::entity::model::DescriptorCounter>{ 1000u, 10000u }(_random);
+			if (std::uniform_int_distribution<unsigned int>{ 0u, MediaLockTransitionPeriod - 1u }(_random) == 0u)
+			{
+				// Locked when there are more locks than unlocks
+				auto& counter = state.mediaLocked > state.mediaUnlocked ? state.mediaUnlocked : state.mediaLocked;
+				++counter;
+			}
+
+			auto counters = la::avdecc::entity::model::StreamInputCounters{};
+			counters[la::avdecc::entity::StreamInputCounterValidFlag::MediaLocked] = state.mediaLocked;
+			counters[la::avdecc::entity::StreamInputCounterValidFlag::MediaUnlocked] = state.mediaUnlocked;
+			counters[la::avdecc::entity::StreamInputCounterValidFlag::FramesRx] = state.framesRx;
+			return makeTraceEvent(timestamp, observerTrace::EventType::StreamInputCountersChanged, entity->info.entityID, streamIndex, counters);
+		}
+		case Kind::GptpChange:
+		{
+			auto* const entity = pickEntity(
+				[](auto const& e)
+				{
+					return e.info.avbInterfacesCount != 0u;
+				});
+			if (!entity)
+			{
+				return std::nullopt;
+			}
+
+			auto const avbInterfaceIndex = std::uniform_int_distribution<la::avdecc::entity::model::AvbInterfaceIndex>{ 0u, static_cast<la::avdecc::entity::model::AvbInterfaceIndex>(entity->info.avbInterfacesCount - 1u) }(_random);
+			auto const grandMasterID = la::avdecc::UniqueIdentifier{ StressGrandMasterIDs[std::uniform_int_distribution<std::size_t>{ 0u, std::size(StressGrandMasterIDs) - 1u }(_random)] };
+			auto const grandMasterDomain = std::uint8_t{ 0u };
+			return makeTraceEvent(timestamp, observerTrace::EventType::GptpChanged, entity->info.entityID, avbInterfaceIndex, grandMasterID, grandMasterDomain);
+		}
+		case Kind::ConnectionToggle:
+		{
+			auto* const listener = pickEntity(
+				[](auto const& e)
+				{
+					return e.info.streamInputsCount != 0u;
+				});
+			if (!listener)
+			{
+				return std::nullopt;
+			}
+
+			auto const streamIndex = std::uniform_int_distribution<la::avdecc::entity::model::StreamIndex>{ 0u, static_cast<la::avdecc::entity::model::StreamIndex>(listener->info.streamInputsCount - 1u) }(_random);
+			auto& state = listener->info.streamInputConnections[streamIndex];
+			if (state.state == la::avdecc::entity::model::StreamConnectionState::State::Connected)
+			{
+				state.state = la::avdecc::entity::model::StreamConnectionState::State::NotConnected;
+				state.talkerStream = la::avdecc::entity::model::StreamIdentification{};
+			}
+			else
+			{
+				auto* const talker = pickEntity(
+					[](auto const& e)
+					{
+						return e.info.streamOutputsCount != 0u;
+					});
+				if (!talker)
+				{
+					return std::nullopt;
+				}
+				auto const talkerStreamIndex = std::uniform_int_distribution<la::avdecc::entity::model::StreamIndex>{ 0u, static_cast<la::avdecc::entity::model::StreamIndex>(talker->info.streamOutputsCount - 1u) }(_random);
+				state.state = la::avdecc::entity::model::StreamConnectionState::State::Connected;
+				state.talkerStream = la::avdecc::entity::model::StreamIdentification{ talker->info.entityID, talkerStreamIndex };
+			}
+
+			auto const changedByOther = false;
+			return makeTraceEvent(timestamp, observerTrace::EventType::StreamConnectionChanged, listener->info.entityID, state, changedByOther);
+		}
+		case Kind::NameChange:
+		{
+			auto* const entity = pickEntity(
+				[](auto const&)
+				{
+					return true;
+				});
+			if (!entity)
+			{
+				return std::nullopt;
+			}
+
+			// Every other change restores the original name
+			++entity->nameChangesCount;
+			auto name = entity->info.name;
+			if (entity->nameChangesCount % 2u != 0u)
+			{
+				name = la::avdecc::entity::model::AvdeccFixedString{ entity->info.name.str() + " #" + std::to_string(entity->nameChangesCount) };
+			}
+			return makeTraceEvent(timestamp, observerTrace::EventType::EntityNameChanged, entity->info.entityID, name);
+		}
+		case Kind::OfflineOnlineCycle:
+		{
+			auto* const entity = pickEntity(
+				[](auto const&)
+				{
+					return true;
+				});
+			if (!entity)
+			{
+				return std::nullopt;
+			}
+
+			entity->isOffline = true;
+			_pendingOnlines.emplace_back(timestamp + std::chrono::duration_cast<Timestamp>(_parameters.offlineDuration), static_cast<std::size_t>(entity - _entities.data()));
+			return makeTraceEvent(timestamp, observerTrace::EventType::EntityOffline, entity->info.entityID);
+		}
+		default:
+			break;
+	}
+
+	return std::nullopt;
+}
+
+} // namespace avdecc::stressLoad
@@ -0,0 +1,141 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "observerTrace.hpp"
+
+#include <la/avdecc/controller/avdeccController.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+/**
+* Synthetic churn of the online entities, generated as observer trace events so they are fed to the ControllerManager through the same path as the controller notifications.
+* Each kind of change is a Poisson process of the configured rate, entities being picked at random. Meant for soak tests of the UI pipeline on virtual entities.
+*/
+namespace avdecc::stressLoad
+{
+/** Average count of changes per second, for the whole network. A rate of 0 disables the change */
+struct Rates
+{
+	double streamInputCounters{ 100.0 };
+	double gptpChanges{ 0.5 };
+	double connectionToggles{ 5.0 };
+	double nameChanges{ 1.0 };
+	double offlineOnlineCycles{ 0.1 };
+};
+
+struct Parameters
+{
+	Rates rates{};
+	std::chrono::seconds duration{ 0 }; // 0 to run until stopped
+	std::chrono::seconds offlineDuration{ 5 }; // Time an entity stays offline during an offline/online cycle
+	std::uint32_t seed{ 0u }; // The same parameters and entities always generate the same events
+};
+
+/** What the generator needs to know about an entity, captured once before starting */
+struct EntityInfo
+{
+	la::avdecc::UniqueIdentifier entityID{};
+	la::avdecc::entity::model::AvdeccFixedString name{};
+	la::avdecc::entity::model::StreamIndex streamInputsCount{ 0u };
+	la::avdecc::entity::model::StreamIndex streamOutputsCount{ 0u };
+	la::avdecc::entity::model::AvbInterfaceIndex avbInterfacesCount{ 0u };
+	std::vector<la::avdecc::entity::model::StreamConnectionState> streamInputConnections{}; // Current connection of each stream input
+};
+using EntityInfos = std::vector<EntityInfo>;
+
+/** Returns the information of an enumerated AEM entity, std::nullopt otherwise. Thread-safe */
+std::optional<EntityInfo> makeEntityInfo(la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept;
+
+/** Generates the events, in timestamp order. Not thread-safe, meant to be driven by the replaying thread only */
+class Generator final
+{
+public:
+	Generator(Parameters const& parameters, EntityInfos&& entities) noexcept;
+
+	/** Returns the next event, std::nullopt once the duration elapsed (never if the duration is 0) */
+	std::optional<observerTrace::Event> next() noexcept;
+
+	/** Returns the events bringing the network back to its initial state (offline entities back online, original names) */
+	std::vector<observerTrace::Event> restoringEvents() noexcept;
+
+	// Deleted compiler auto-generated methods
+	Generator(Generator const&) = delete;
+	Generator(Generator&&) = delete;
+	Generator& operator=(Generator const&) = delete;
+	Generator& operator=(Generator&&) = delete;
+
+private:
+	enum class Kind
+	{
+		StreamInputCounters,
+		GptpChange,
+		ConnectionToggle,
+		NameChange,
+		OfflineOnlineCycle,
+
+		Count
+	};
+
+	struct StreamInputCountersState
+	{
+		la::avdecc::entity::model::DescriptorCounter mediaLocked{ 1u };
+		la::avdecc::entity::model::DescriptorCounter mediaUnlocked{ 0u };
+		la::avdecc::entity::model::DescriptorCounter framesRx{ 0u };
+	};
+
+	struct EntityState
+	{
+		EntityInfo info{};
+		bool isOffline{ false };
+		std::uint32_t nameChangesCount{ 0u };
+		std::vector<StreamInputCountersState> streamInputCounters{};
+	};
+
+	using Timestamp = std::chrono::microseconds;
+
+	void scheduleNext(Kind const kind, Timestamp const from) noexcept;
+	std::optional<observerTrace::Event> makeEvent(Kind const kind, Timestamp const timestamp) noexcept;
+	template<typename Predicate>
+	EntityState* pickEntity(Predicate const& predicate) noexcept;
+
+	template<typename... Args>
+	static observerTrace::Event makeTraceEvent(Timestamp const timestamp, observerTrace::EventType const type, la::avdecc::UniqueIdentifier const entityID, Args const&... args) noexcept
+	{
+		auto writer = observerTrace::PayloadWriter{};
+		(writer.write(args), ...);
+		return observerTrace::Event{ timestamp, type, entityID, writer.payload() };
+	}
+
+	Parameters const _parameters{};
+	std::vector<EntityState> _entities{};
+	std::mt19937 _random{};
+	std::map<Kind, Timestamp> _nextTimestamps{}; // Next change of each enabled kind
+	std::deque<std::pair<Timestamp, std::size_t>> _pendingOnlines{}; // Entities (index) to bring back online, in timestamp order
+};
+
+} // namespace avdecc::stressLoad
@@ -0,0 +1,173 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "batchOperationsDialog.hpp"
+#include "avdecc/batchOperations.hpp"
+#include "avdecc/controllerManager.hpp"
+#include "avdecc/helper.hpp"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QFontDatabase>
+
+#include <algorithm>
+
+static auto constexpr DefaultScript =
+	"# Entities to apply the operations to (multiple 'select' lines add up)\n"
+	"#  select all | name <wildcard> | group <wildcard> | id <EntityID> [<EntityID>...]\n"
+	"select name *\n"
+	"\n"
+	"# Operations, executed in order for each entity\n"
+	"#  acquire | release | lock | unlock\n"
+	"#  startStreams [inputs|outputs] | stopStreams [inputs|outputs]\n"
+	"#  setName <pattern> | setGroupName <pattern>  ({n} = position, {name} = current name)\n"
+	"#  setSamplingRate <Hz>\n"
+	"startStreams\n";
+
+BatchOperationsDialog::BatchOperationsDialog(QWidget* parent)
+	: QDialog{ parent, Qt::WindowSystemMenuHint | Qt::WindowTitleHint | Qt::WindowCloseButtonHint | Qt::WindowMaximizeButtonHint }
+{
+	setWindowTitle("Batch Operations");
+	resize(720, 640);
+
+	auto& batchManager = avdecc::batchOperations::BatchOperationsManager::getInstance();
+
+	_scriptEdit.setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+	_scriptEdit.setPlainText(DefaultScript);
+
+	_maxConcurrentEntities.setRange(1, 256);
+	_maxConcurrentEntities.setValue(static_cast<int>(avdecc::batchOperations::BatchOperationsManager::DefaultMaxConcurrentEntities));
+	_maxConcurrentEntities.setPrefix("Concurrent entities: ");
+
+	_progressBar.setRange(0, 1);
+	_progressBar.setValue(0);
+
+	_errorsTreeWidget.setColumnCount(3);
+	_errorsTreeWidget.setHeaderLabels({ "Entity", "Command", "Error" });
+	_errorsTreeWidget.setRootIsDecorated(false);
+	_errorsTreeWidget.setSortingEnabled(true);
+	_errorsTreeWidget.header()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
+	_errorsTreeWidget.header()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
+
+	auto* const buttonsLayout = new QHBoxLayout;
+	buttonsLayout->addWidget(&_statusLabel, 1);
+	buttonsLayout->addWidget(&_maxConcurrentEntities);
+	buttonsLayout->addWidget(&_checkButton);
+	buttonsLayout->addWidget(&_runButton);
+
+	auto* const layout = new QVBoxLayout{ this };
+	layout->addWidget(&_scriptEdit, 2);
+	layout->addLayout(buttonsLayout);
+	layout->addWidget(&_progressBar);
+	layout->addWidget(&_errorsTreeWidget, 1);
+
+	connect(&_checkButton, &QPushButton::clicked, this, &BatchOperationsDialog::check);
+	connect(&_runButton, &QPushButton::clicked, this, &BatchOperationsDialog::run);
+
+	connect(&batchManager, &avdecc::batchOperations::BatchOperationsManager::progressUpdate, this,
+		[this](uint32_t const completedCommands, uint32_t const totalCommands)
+		{
+			_progressBar.setRange(0, static_cast<int>(std::max(totalCommands, 1u)));
+			_progressBar.setValue(static_cast<int>(completedCommands));
+		});
+	connect(&batchManager, &avdecc::batchOperations::BatchOperationsManager::finished, this, &BatchOperationsDialog::onFinished);
+
+	updateButtons();
+}
+
+void BatchOperationsDialog::check() noexcept
+{
+	auto script = avdecc::batchOperations::Script{};
+	if (auto const error = avdecc::batchOperations::parseScript(_scriptEdit.toPlainText(), script); !error.isEmpty())
+	{
+		_statusLabel.setText(error);
+		return;
+	}
+
+	auto const entityIDs = avdecc::batchOperations::BatchOperationsManager::getInstance().resolveSelection(script.selection);
+	_statusLabel.setText(QString("%1 operation(s) on %2 entity(ies)").arg(script.steps.size()).arg(entityIDs.size()));
+}
+
+void BatchOperationsDialog::run() noexcept
+{
+	auto script = avdecc::batchOperations::Script{};
+	if (auto const error = avdecc::batchOperations::parseScript(_scriptEdit.toPlainText(), script); !error.isEmpty())
+	{
+		_statusLabel.setText(error);
+		return;
+	}
+
+	auto& batchManager = avdecc::batchOperations::BatchOperationsManager::getInstance();
+	auto const entityIDs = batchManager.resolveSelection(script.selection);
+	if (entityIDs.empty())
+	{
+		_statusLabel.setText("No online entity matches the selection");
+		return;
+	}
+
+	_errorsTreeWidget.clear();
+	_progressBar.setRange(0, 1);
+	_progressBar.setValue(0);
+	_statusLabel.setText(QString("Running on %1 entity(ies)...").arg(entityIDs.size()));
+
+	batchManager.run(entityIDs, script.steps, static_cast<size_t>(_maxConcurrentEntities.value()));
+	updateButtons();
+}
+
+void BatchOperationsDialog::onFinished(avdecc::commandChain::CommandExecutionErrors const& errors) noexcept
+{
+	auto& manager = avdecc::ControllerManager::getInstance();
+
+	_errorsTreeWidget.setSortingEnabled(false);
+	for (auto const& [entityID, errorInfo] : errors)
+	{
+		auto entityName = avdecc::helper::uniqueIdentifierToString(entityID);
+		if (auto controlledEntity = manager.getControlledEntity(entityID))
+		{
+			entityName = avdecc::helper::smartEntityName(*controlledEntity);
+		}
+
+		auto commandName = QString{};
+		if (errorInfo.commandTypeAecp)
+		{
+			commandName = avdecc::ControllerManager::typeToString(*errorInfo.commandTypeAecp);
+		}
+		else if (errorInfo.commandTypeAcmp)
+		{
+			commandName = avdecc::ControllerManager::typeToString(*errorInfo.commandTypeAcmp);
+		}
+
+		auto* const item = new QTreeWidgetItem{ &_errorsTreeWidget };
+		item->setText(0, entityName);
+		item->setText(1, commandName);
+		item->setText(2, avdecc::commandChain::AsyncParallelCommandSet::errorToString(errorInfo.errorType));
+	}
+	_errorsTreeWidget.setSortingEnabled(true);
+
+	_progressBar.setValue(_progressBar.maximum());
+	_statusLabel.setText(errors.empty() ? QString("Completed successfully") : QString("Completed with %1 error(s)").arg(errors.size()));
+	updateButtons();
+}
+
+void BatchOperationsDialog::updateButtons() noexcept
+{
+	auto const isRunning = avdecc::batchOperations::BatchOperationsManager::getInstance().isRunning();
+	_runButton.setEnabled(!isRunning);
+	_maxConcurrentEntities.setEnabled(!isRunning);
+}
@@ -0,0 +1,58 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QDialog>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QProgressBar>
+#include <QLabel>
+#include <QSpinBox>
+#include <QTreeWidget>
+
+#include "avdecc/commandChain.hpp"
+
+/** Editor and runner of batch operations scripts, applied to many entities at once */
+class BatchOperationsDialog : public QDialog
+{
+	Q_OBJECT
+
+public:
+	BatchOperationsDialog(QWidget* parent = nullptr);
+
+	// Deleted compiler auto-generated methods
+	BatchOperationsDialog(BatchOperationsDialog&&) = delete;
+	BatchOperationsDialog(BatchOperationsDialog const&) = delete;
+	BatchOperationsDialog& operator=(BatchOperationsDialog const&) = delete;
+	BatchOperationsDialog& operator=(BatchOperationsDialog&&) = delete;
+
+private:
+	void check() noexcept;
+	void run() noexcept;
+	void onFinished(avdecc::commandChain::CommandExecutionErrors const& errors) noexcept;
+	void updateButtons() noexcept;
+
+	QPlainTextEdit _scriptEdit{ this };
+	QLabel _statusLabel{ this };
+	QSpinBox _maxConcurrentEntities{ this };
+	QPushButton _checkButton{ "Check", this };
+	QPushButton _runButton{ "Run", this };
+	QProgressBar _progressBar{ this };
+	QTreeWidget _errorsTreeWidget{ this };
+};
@@ -0,0 +1,193 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "connectionMatrix/batchConnection.hpp"
+#include "connectionMatrix/model.hpp"
+#include "connectionMatrix/node.hpp"
+#include "avdecc/controllerManager.hpp"
+
+#include <map>
+#include <set>
+
+namespace connectionMatrix
+{
+namespace batchConnection
+{
+size_t Plan::channelConnectionsCount() const noexcept
+{
+	auto count = size_t{ 0u };
+	for (auto const& [entities, connections] : channelConnections)
+	{
+		count += connections.size();
+	}
+	return count;
+}
+
+Plan computePlan(Model const& model, std::vector<QModelIndex> const& intersections, Action const action) noexcept
+{
+	auto plan = Plan{};
+	plan.action = action;
+
+	// Redundant summary intersections share their streams with the expanded ones, a stream is only listed once
+	auto streamConnections = std::set<StreamConnection>{};
+	auto const isChannelMode = model.mode() == Model::Mode::Channel;
+
+	for (auto const& index : intersections)
+	{
+		auto const intersectionData = model.intersectionData(index);
+		if (!intersectionData.talker || !intersectionData.listener)
+		{
+			++plan.skippedIntersections;
+			continue;
+		}
+
+		auto const talkerID = intersectionData.talker->entityID();
+		auto const listenerID = intersectionData.listener->entityID();
+
+		switch (intersectionData.type)
+		{
+			case Model::IntersectionData::Type::RedundantStream_RedundantStream:
+			case Model::IntersectionData::Type::RedundantStream_SingleStream:
+			case Model::IntersectionData::Type::SingleStream_SingleStream:
+			case Model::IntersectionData::Type::Redundant_Redundant:
+			case Model::IntersectionData::Type::Redundant_RedundantStream:
+			case Model::IntersectionData::Type::Redundant_SingleStream:
+			case Model::IntersectionData::Type::RedundantStream_RedundantStream_Forbidden:
+			{
+				// The only allowed action on a forbidden connection, is disconnecting a stream that was connected using a non-milan controller
+				auto const isForbidden = intersectionData.type == Model::IntersectionData::Type::RedundantStream_RedundantStream_Forbidden;
+				if (intersectionData.smartConnectableStreams.empty() || (isForbidden && action == Action::Connect))
+				{
+					++plan.skippedIntersections;
+					break;
+				}
+
+				for (auto const& connectableStream : intersectionData.smartConnectableStreams)
+				{
+					auto const areConnected = connectableStream.isConnected || connectableStream.isFastConnecting;
+					if (areConnected == (action == Action::Disconnect))
+					{
+						streamConnections.insert(StreamConnection{ talkerID, connectableStream.talkerStreamIndex, listenerID, connectableStream.listenerStreamIndex });
+					}
+				}
+				break;
+			}
+
+			case Model::IntersectionData::Type::SingleChannel_SingleChannel:
+			{
+				if (!isChannelMode)
+				{
+					++plan.skippedIntersections;
+					break;
+				}
+
+				auto const isConnected = intersectionData.state != Model::IntersectionData::State::NotConnected;
+				if (isConnected == (action == Action::Disconnect))
+				{
+					auto const& talkerChannelIdentification = static_cast<ChannelNode const*>(intersectionData.talker)->channelIdentification();
+					auto const& listenerChannelIdentification = static_cast<ChannelNode const*>(intersectionData.listener)->channelIdentification();
+					plan.channelConnections[EntityPair{ talkerID, listenerID }].emplace_back(talkerChannelIdentification, listenerChannelIdentification);
+				}
+				break;
+			}
+
+			default:
+				++plan.skippedIntersections;
+				break;
+		}
+	}
+
+	plan.streamConnections.assign(streamConnections.begin(), streamConnections.end());
+
+	return plan;
+}
+
+void applyStreamConnections(Plan const& plan, QObject* const context, ApplyHandler const& handler, size_t const maxConcurrentEntities) noexcept
+{
+	auto const isConnect = plan.action == Action::Connect;
+	auto const commandType = isConnect ? avdecc::ControllerManager::AcmpCommandType::ConnectStream : avdecc::ControllerManager::AcmpCommandType::DisconnectStream;
+
+	// ACMP commands are addressed to the listener, which bounds the count of commands in flight
+	auto commandsPerListener = std::map<la::avdecc::UniqueIdentifier, std::vector<avdecc::commandChain::AsyncParallelCommandSet::AsyncCommand>>{};
+	for (auto const& connection : plan.streamConnections)
+	{
+		commandsPerListener[connection.listenerID].push_back(
+			[connection, isConnect, commandType](avdecc::commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+			{
+				auto const responseHandler = [parentCommandSet, commandIndex, commandType](la::avdecc::UniqueIdentifier const /*talkerEntityID*/, la::avdecc::entity::model::StreamIndex const /*talkerStreamIndex*/, la::avdecc::UniqueIdentifier const listenerEntityID, la::avdecc::entity::model::StreamIndex const /*listenerStreamIndex*/, la::avdecc::entity::ControllerEntity::ControlStatus const status)
+				{
+					auto const error = avdecc::commandChain::AsyncParallelCommandSet::controlStatusToCommandError(status);
+					parentCommandSet->completeCommand(commandIndex, listenerEntityID, error, commandType);
+				};
+
+				auto& manager = avdecc::ControllerManager::getInstance();
+				if (isConnect)
+				{
+					manager.connectStream(connection.talkerID, connection.talkerStreamIndex, connection.listenerID, connection.listenerStreamIndex, responseHandler);
+				}
+				else
+				{
+					manager.disconnectStream(connection.talkerID, connection.talkerStreamIndex, connection.listenerID, connection.listenerStreamIndex, responseHandler);
+				}
+				return true;
+			});
+	}
+
+	// Listeners do not wait for each other, only the count of listeners in progress is bounded
+	auto* const executer = new avdecc::commandChain::AsyncCommandGraphExecuter{ context };
+	executer->setMaxRunningCommandSets(maxConcurrentEntities);
+	for (auto const& [listenerID, commands] : commandsPerListener)
+	{
+		auto* const commandSet = new avdecc::commandChain::AsyncParallelCommandSet;
+		commandSet->append(listenerID, commands);
+		executer->addCommandSet(commandSet, avdecc::commandChain::AsyncCommandGraphExecuter::Resources{ listenerID });
+	}
+
+	QObject::connect(executer, &avdecc::commandChain::AsyncCommandGraphExecuter::completed, context,
+		[executer, handler](avdecc::commandChain::CommandExecutionErrors const errors)
+		{
+			if (handler)
+			{
+				handler(errors);
+			}
+			executer->deleteLater();
+		});
+	executer->start();
+}
+
+QString errorsSummary(avdecc::commandChain::CommandExecutionErrors const& errors) noexcept
+{
+	auto failures = std::map<QString, std::pair<size_t, std::set<la::avdecc::UniqueIdentifier>>>{};
+	for (auto const& [entityID, errorInfo] : errors)
+	{
+		auto& failure = failures[avdecc::commandChain::AsyncParallelCommandSet::errorToString(errorInfo.errorType)];
+		++failure.first;
+		failure.second.insert(entityID);
+	}
+
+	auto summary = QString{};
+	for (auto const& [error, failure] : failures)
+	{
+		summary += QString("- %1 (%2 command(s) on %3 entity(ies))\n").arg(error).arg(failure.first).arg(failure.second.size());
+	}
+	return summary;
+}
+
+} // namespace batchConnection
+} // namespace connectionMatrix
@@ -0,0 +1,102 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/internals/entityModelTypes.hpp>
+#include <la/avdecc/utils.hpp>
+
+#include "avdecc/commandChain.hpp"
+#include "avdecc/channelConnectionManager.hpp"
+
+#include <QModelIndex>
+#include <QObject>
+#include <QString>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace connectionMatrix
+{
+class Model;
+
+namespace batchConnection
+{
+enum class Action
+{
+	Connect,
+	Disconnect,
+};
+
+struct StreamConnection
+{
+	la::avdecc::UniqueIdentifier talkerID{};
+	la::avdecc::entity::model::StreamIndex talkerStreamIndex{ 0u };
+	la::avdecc::UniqueIdentifier listenerID{};
+	la::avdecc::entity::model::StreamIndex listenerStreamIndex{ 0u };
+
+	bool operator<(StreamConnection const& other) const noexcept
+	{
+		return std::make_tuple(talkerID, talkerStreamIndex, listenerID, listenerStreamIndex) < std::make_tuple(other.talkerID, other.talkerStreamIndex, other.listenerID, other.listenerStreamIndex);
+	}
+};
+
+using ChannelConnection = std::pair<avdecc::ChannelIdentification, avdecc::ChannelIdentification>; // Talker, Listener
+
+using EntityPair = std::pair<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier>; // Talker, Listener
+
+struct Plan
+{
+	Action action{ Action::Connect };
+	std::vector<StreamConnection> streamConnections{}; // Streams to connect or disconnect (already in the requested state ones are not listed)
+	std::map<EntityPair, std::vector<ChannelConnection>> channelConnections{}; // Channels to connect or disconnect, grouped by talker and listener entities
+	size_t skippedIntersections{ 0u }; // Intersections with no possible action (summary ones, no stream on the same domain, ...)
+
+	bool empty() const noexcept
+	{
+		return streamConnections.empty() && channelConnections.empty();
+	}
+
+	size_t channelConnectionsCount() const noexcept;
+};
+
+/**
+* @brief Computes the connections to change so all the specified intersections are in the requested state (Qt Main Thread only).
+* @details Stream intersections use the same smart connection rules than a single click, forbidden redundant intersections can only be disconnected.
+*          Channel intersections are only considered in Channel mode.
+*/
+Plan computePlan(Model const& model, std::vector<QModelIndex> const& intersections, Action const action) noexcept;
+
+using ApplyHandler = std::function<void(avdecc::commandChain::CommandExecutionErrors const& errors)>;
+
+/**
+* @brief Sends all the stream connections of a plan as one command graph, listeners being processed in parallel with a bounded count of commands in flight.
+* @details The handler is called once all the commands completed, in the thread of the context object.
+*/
+void applyStreamConnections(Plan const& plan, QObject* const context, ApplyHandler const& handler, size_t const maxConcurrentEntities = 16) noexcept;
+
+/** Human readable summary of the errors, one line per kind of error with the count of failed commands and of entities */
+QString errorsSummary(avdecc::commandChain::CommandExecutionErrors const& errors) noexcept;
+
+} // namespace batchConnection
+} // namespace connectionMatrix
@@ -34,6 +34,7 @@ CornerWidget::CornerWidget(QWidget* parent)
 	: QWidget{ parent }
 {
 	_searchLineEdit.setPlaceholderText("Entity Filter (RegEx)");
+	_connectedOnlyCheckBox.setToolTip("Only show the entities having at least one connection");
 
 	_horizontalExpandButton.setToolTip("Expand");
 	_horizontalCollapseButton.setToolTip("Collapse");
@@ -61,6 +62,7 @@ CornerWidget::CornerWidget(QWidget* parent)
 	_buttonContainerLayout.addStretch();
 	_buttonContainerLayout.addWidget(&_button);
 	_buttonContainerLayout.addWidget(&_searchLineEdit);
+	_buttonContainerLayout.addWidget(&_connectedOnlyCheckBox);
 	_buttonContainerLayout.addStretch();
 
 	_layout.setRowStretch(0, 1);
@@ -81,6 +83,7 @@ CornerWidget::CornerWidget(QWidget* parent)
 		});
 
 	connect(&_searchLineEdit, &QLineEdit::textChanged, this, &CornerWidget::filterChanged);
+	connect(&_connectedOnlyCheckBox, &QCheckBox::toggled, this, &CornerWidget::connectedOnlyChanged);
 
 	connect(&_horizontalExpandButton, &QPushButton::clicked, this, &CornerWidget::verticalExpandClicked);
 	connect(&_horizontalCollapseButton, &QPushButton::clicked, this, &CornerWidget::verticalCollapseClicked);
@@ -130,6 +133,11 @@ QString CornerWidget::filterText() const
 	return _searchLineEdit.text();
 }
 
+bool CornerWidget::isConnectedOnly() const
+{
+	return _connectedOnlyCheckBox.isChecked();
+}
+
 void CornerWidget::paintEvent(QPaintEvent*)
 {
 	QPainter painter{ this };
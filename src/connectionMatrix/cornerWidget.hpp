@@ -26,6 +26,7 @@
 #include <QLayout>
 #include <QPushButton>
 #include <QLineEdit>
+#include <QCheckBox>
 #include <QLabel>
 
 namespace connectionMatrix
@@ -42,9 +43,11 @@ public:
 	bool isTransposed() const;
 
 	QString filterText() const;
+	bool isConnectedOnly() const;
 
 signals:
 	void filterChanged(QString const& filter);
+	void connectedOnlyChanged(bool const connectedOnly);
 
 	void horizontalExpandClicked();
 	void horizontalCollapseClicked();
@@ -65,6 +68,7 @@ private:
 	QVBoxLayout _buttonContainerLayout{ &_buttonContainer };
 	QPushButton _button{ "Show Legend", &_buttonContainer };
 	QLineEdit _searchLineEdit{ &_buttonContainer };
+	QCheckBox _connectedOnlyCheckBox{ "Connected Only", &_buttonContainer };
 
 	QHBoxLayout _horizontalLayout;
 	qt::toolkit::FlatIconButton _horizontalExpandButton{ "Material Icons", "expand_more" };
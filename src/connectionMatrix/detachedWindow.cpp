@@ -0,0 +1,52 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "connectionMatrix/detachedWindow.hpp"
+#include "connectionMatrix/view.hpp"
+
+#include <QAction>
+
+namespace connectionMatrix
+{
+DetachedWindow::DetachedWindow(View const* const sharedWith, QWidget* parent)
+	: QWidget{ parent, Qt::Window }
+	, _view{ new View{ sharedWith, this } }
+{
+	// Closed with its parent, and destroyed as soon as closed (releasing its share of the model)
+	setAttribute(Qt::WA_DeleteOnClose);
+	setWindowTitle("Connection Matrix");
+	resize(800, 600);
+
+	_layout.setContentsMargins(0, 0, 0, 0);
+	_layout.setSpacing(0);
+	_layout.addWidget(&_toolBar);
+	_layout.addWidget(_view);
+
+	auto* channelModeAction = _toolBar.addAction("Channel Mode");
+	channelModeAction->setCheckable(true);
+	channelModeAction->setChecked(_view->isChannelMode());
+	connect(channelModeAction, &QAction::toggled, _view, &View::setChannelMode);
+
+	auto* transposeAction = _toolBar.addAction("Transpose");
+	transposeAction->setCheckable(true);
+	transposeAction->setChecked(_view->isTransposed());
+	connect(transposeAction, &QAction::toggled, _view, &View::setTransposed);
+}
+
+} // namespace connectionMatrix
@@ -0,0 +1,42 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QWidget>
+#include <QToolBar>
+#include <QVBoxLayout>
+
+namespace connectionMatrix
+{
+class View;
+
+/** Top level window displaying the connection matrix in a View sharing the model of another one, with its own mode, transpose state and filter */
+class DetachedWindow final : public QWidget
+{
+public:
+	DetachedWindow(View const* const sharedWith, QWidget* parent = nullptr);
+
+private:
+	QVBoxLayout _layout{ this };
+	QToolBar _toolBar{ this };
+	View* _view{ nullptr }; // Owned by the layout
+};
+
+} // namespace connectionMatrix
@@ -0,0 +1,268 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "connectionMatrix/formatReconciliation.hpp"
+#include "connectionMatrix/streamFormatCache.hpp"
+#include "avdecc/controllerManager.hpp"
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <utility>
+
+namespace connectionMatrix
+{
+namespace formatReconciliation
+{
+using StreamKey = std::pair<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::StreamIndex>;
+
+struct StreamFormats
+{
+	streamFormatCache::FormatID formatID{ streamFormatCache::NullFormatID };
+	streamFormatCache::FormatIDs availableFormatIDs{};
+};
+
+struct Connection
+{
+	StreamKey listener{};
+	StreamFormats listenerFormats{};
+	StreamKey talker{};
+	bool isCompatible{ false };
+};
+
+template<typename StreamNodeType>
+static StreamFormats toStreamFormats(StreamNodeType const& streamNode) noexcept
+{
+	auto formats = StreamFormats{};
+	formats.formatID = streamFormatCache::intern(streamNode.dynamicModel->streamFormat);
+	for (auto const& streamFormat : streamNode.staticModel->formats)
+	{
+		formats.availableFormatIDs.push_back(streamFormatCache::intern(streamFormat));
+	}
+	return formats;
+}
+
+Plan computePlan(Strategy const strategy) noexcept
+{
+	auto plan = Plan{};
+	auto& manager = avdecc::ControllerManager::getInstance();
+
+	// Talker streams are shared by many connections, only look them up once
+	auto talkerStreams = std::map<StreamKey, std::optional<StreamFormats>>{};
+	auto const getTalkerFormats = [&manager, &talkerStreams](StreamKey const& talker) -> std::optional<StreamFormats> const&
+	{
+		auto const [it, inserted] = talkerStreams.emplace(talker, std::nullopt);
+		if (inserted)
+		{
+			try
+			{
+				if (auto controlledEntity = manager.getControlledEntity(talker.first))
+				{
+					auto const& streamOutputNode = controlledEntity->getStreamOutputNode(controlledEntity->getCurrentConfigurationNode().descriptorIndex, talker.second);
+					if (streamOutputNode.dynamicModel && streamOutputNode.staticModel)
+					{
+						it->second = toStreamFormats(streamOutputNode);
+					}
+				}
+			}
+			catch (la::avdecc::controller::ControlledEntity::Exception const&)
+			{
+			}
+		}
+		return it->second;
+	};
+
+	// All the connections of the network, the compatible ones being needed to choose a talker format that does not break them
+	auto connections = std::vector<Connection>{};
+	for (auto const& entityID : manager.getOnlineEntities())
+	{
+		auto controlledEntity = manager.getControlledEntity(entityID);
+		if (!controlledEntity || !controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+		{
+			continue;
+		}
+		try
+		{
+			for (auto const& [streamIndex, streamInputNode] : controlledEntity->getCurrentConfigurationNode().streamInputs)
+			{
+				if (!streamInputNode.dynamicModel || !streamInputNode.staticModel || streamInputNode.dynamicModel->connectionState.state != la::avdecc::entity::model::StreamConnectionState::State::Connected)
+				{
+					continue;
+				}
+				auto const& talkerStream = streamInputNode.dynamicModel->connectionState.talkerStream;
+				auto const talker = StreamKey{ talkerStream.entityID, talkerStream.streamIndex };
+				auto const& talkerFormats = getTalkerFormats(talker);
+				if (!talkerFormats)
+				{
+					continue;
+				}
+
+				auto connection = Connection{ StreamKey{ entityID, streamIndex }, toStreamFormats(streamInputNode), talker };
+				connection.isCompatible = streamFormatCache::isListenerFormatCompatibleWithTalkerFormat(connection.listenerFormats.formatID, talkerFormats->formatID);
+				if (!connection.isCompatible)
+				{
+					++plan.mismatchedConnections;
+				}
+				connections.push_back(std::move(connection));
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+	}
+
+	switch (strategy)
+	{
+		case Strategy::ListenerFromTalker:
+		{
+			for (auto const& connection : connections)
+			{
+				if (connection.isCompatible)
+				{
+					continue;
+				}
+				auto const talkerFormatID = getTalkerFormats(connection.talker)->formatID;
+				auto const& available = connection.listenerFormats.availableFormatIDs;
+
+				// The exact talker format first, then any compatible one
+				auto formatIt = std::find(available.begin(), available.end(), talkerFormatID);
+				if (formatIt == available.end())
+				{
+					formatIt = std::find_if(available.begin(), available.end(),
+						[talkerFormatID](auto const listenerFormatID)
+						{
+							return streamFormatCache::isListenerFormatCompatibleWithTalkerFormat(listenerFormatID, talkerFormatID);
+						});
+				}
+				if (formatIt == available.end())
+				{
+					++plan.unresolvedConnections;
+					continue;
+				}
+				plan.changes.push_back(FormatChange{ connection.listener.first, connection.listener.second, true, streamFormatCache::streamFormat(*formatIt) });
+			}
+			break;
+		}
+		case Strategy::TalkerFromListener:
+		{
+			auto listenersPerTalker = std::map<StreamKey, std::vector<Connection const*>>{};
+			for (auto const& connection : connections)
+			{
+				listenersPerTalker[connection.talker].push_back(&connection);
+			}
+
+			for (auto const& [talker, listeners] : listenersPerTalker)
+			{
+				auto const mismatched = static_cast<size_t>(std::count_if(listeners.begin(), listeners.end(),
+					[](auto const* const connection)
+					{
+						return !connection->isCompatible;
+					}));
+				if (mismatched == 0u)
+				{
+					continue;
+				}
+
+				// The talker format compatible with most of its listeners (the current format wins ties, then the first available one)
+				auto const& talkerFormats = *getTalkerFormats(talker);
+				auto const countCompatible = [&listeners](streamFormatCache::FormatID const talkerFormatID)
+				{
+					return static_cast<size_t>(std::count_if(listeners.begin(), listeners.end(),
+						[talkerFormatID](auto const* const connection)
+						{
+							return streamFormatCache::isListenerFormatCompatibleWithTalkerFormat(connection->listenerFormats.formatID, talkerFormatID);
+						}));
+				};
+				auto bestFormatID = talkerFormats.formatID;
+				auto bestCount = listeners.size() - mismatched;
+				for (auto const talkerFormatID : talkerFormats.availableFormatIDs)
+				{
+					if (auto const count = countCompatible(talkerFormatID); count > bestCount)
+					{
+						bestFormatID = talkerFormatID;
+						bestCount = count;
+					}
+				}
+
+				plan.unresolvedConnections += listeners.size() - bestCount;
+				if (bestFormatID != talkerFormats.formatID)
+				{
+					plan.changes.push_back(FormatChange{ talker.first, talker.second, false, streamFormatCache::streamFormat(bestFormatID) });
+				}
+			}
+			break;
+		}
+		default:
+			break;
+	}
+
+	return plan;
+}
+
+void apply(Plan const& plan, QObject* const context, ApplyHandler const& handler, size_t const maxConcurrentEntities) noexcept
+{
+	auto commandsPerEntity = std::map<la::avdecc::UniqueIdentifier, std::vector<avdecc::commandChain::AsyncParallelCommandSet::AsyncCommand>>{};
+	for (auto const& change : plan.changes)
+	{
+		commandsPerEntity[change.entityID].push_back(
+			[change](avdecc::commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+			{
+				auto const responseHandler = [parentCommandSet, commandIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status)
+				{
+					auto const error = avdecc::commandChain::AsyncParallelCommandSet::aemCommandStatusToCommandError(status);
+					parentCommandSet->completeCommand(commandIndex, entityID, error, avdecc::ControllerManager::AecpCommandType::SetStreamFormat);
+				};
+
+				auto& manager = avdecc::ControllerManager::getInstance();
+				if (change.isInput)
+				{
+					manager.setStreamInputFormat(change.entityID, change.streamIndex, change.streamFormat, responseHandler);
+				}
+				else
+				{
+					manager.setStreamOutputFormat(change.entityID, change.streamIndex, change.streamFormat, responseHandler);
+				}
+				return true;
+			});
+	}
+
+	// Entities do not wait for each other, only the count of entities in progress is bounded
+	auto* const executer = new avdecc::commandChain::AsyncCommandGraphExecuter{ context };
+	executer->setMaxRunningCommandSets(maxConcurrentEntities);
+	for (auto const& [entityID, commands] : commandsPerEntity)
+	{
+		auto* const commandSet = new avdecc::commandChain::AsyncParallelCommandSet;
+		commandSet->append(entityID, commands);
+		executer->addCommandSet(commandSet, avdecc::commandChain::AsyncCommandGraphExecuter::Resources{ entityID });
+	}
+
+	QObject::connect(executer, &avdecc::commandChain::AsyncCommandGraphExecuter::completed, context,
+		[executer, handler](avdecc::commandChain::CommandExecutionErrors const errors)
+		{
+			if (handler)
+			{
+				handler(errors);
+			}
+			executer->deleteLater();
+		});
+	executer->start();
+}
+
+} // namespace formatReconciliation
+} // namespace connectionMatrix
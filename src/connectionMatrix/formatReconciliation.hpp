@@ -0,0 +1,74 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/internals/entityModelTypes.hpp>
+#include <la/avdecc/utils.hpp>
+
+#include "avdecc/commandChain.hpp"
+
+#include <QObject>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace connectionMatrix
+{
+namespace formatReconciliation
+{
+enum class Strategy
+{
+	ListenerFromTalker, // Listeners adopt a format compatible with their talker
+	TalkerFromListener, // Talkers adopt a format compatible with all their connected listeners
+};
+
+struct FormatChange
+{
+	la::avdecc::UniqueIdentifier entityID{};
+	la::avdecc::entity::model::StreamIndex streamIndex{ 0u };
+	bool isInput{ false };
+	la::avdecc::entity::model::StreamFormat streamFormat{};
+};
+
+struct Plan
+{
+	std::vector<FormatChange> changes{};
+	size_t mismatchedConnections{ 0u }; // Connected streams whose formats are not compatible
+	size_t unresolvedConnections{ 0u }; // Mismatched connections no available format can fix
+};
+
+/**
+* @brief Computes the format changes fixing all the mismatched stream connections of the network at once (Qt Main Thread only).
+* @details Uses the stream format compatibility cache. A listener adopting its talker format prefers the exact talker format, a talker adopting
+*          its listeners format prefers a format compatible with all of them (or with most of them, the others being reported as unresolved).
+*/
+Plan computePlan(Strategy const strategy) noexcept;
+
+using ApplyHandler = std::function<void(avdecc::commandChain::CommandExecutionErrors const& errors)>;
+
+/**
+* @brief Applies all the changes of a plan as one command graph, entities being processed in parallel with a bounded count of entities in progress.
+* @details The handler is called once all the commands completed, in the thread of the context object.
+*/
+void apply(Plan const& plan, QObject* const context, ApplyHandler const& handler, size_t const maxConcurrentEntities = 16) noexcept;
+
+} // namespace formatReconciliation
+} // namespace connectionMatrix
@@ -22,11 +22,16 @@
 #include "connectionMatrix/node.hpp"
 #include "connectionMatrix/paintHelper.hpp"
 #include "avdecc/controllerManager.hpp"
+#include "avdecc/batchOperations.hpp"
+#include "avdecc/helper.hpp"
 #include "toolkit/material/color.hpp"
 #include <QPainter>
 #include <QContextMenuEvent>
 #include <QMenu>
+#include <QMessageBox>
 
+#include <map>
+#include <memory>
 #include <optional>
 
 #if ENABLE_CONNECTION_MATRIX_DEBUG
@@ -39,6 +44,53 @@
 
 namespace connectionMatrix
 {
+/** Starts or stops all the streams of one side of an entity as a single batch, and reports all the failures at once */
+static void startStopAllStreams(QWidget* const parent, la::avdecc::UniqueIdentifier const entityID, bool const start, avdecc::batchOperations::StreamsSelection const streams)
+{
+	auto& batchManager = avdecc::batchOperations::BatchOperationsManager::getInstance();
+
+	auto step = avdecc::batchOperations::Step{};
+	step.type = start ? avdecc::batchOperations::Step::Type::StartStreams : avdecc::batchOperations::Step::Type::StopStreams;
+	step.streams = streams;
+
+	// Only listen to the result of our own batch
+	auto const connection = std::make_shared<QMetaObject::Connection>();
+	*connection = QObject::connect(&batchManager, &avdecc::batchOperations::BatchOperationsManager::finished, parent,
+		[parent, connection, entityID, start](avdecc::commandChain::CommandExecutionErrors const& errors)
+		{
+			QObject::disconnect(*connection);
+			if (errors.empty())
+			{
+				return;
+			}
+
+			// Group identical failures, a device with many streams usually fails the same way for all of them
+			auto failures = std::map<QString, size_t>{};
+			for (auto const& errorInfo : errors)
+			{
+				++failures[avdecc::commandChain::AsyncParallelCommandSet::errorToString(errorInfo.second.errorType)];
+			}
+			auto message = QString{};
+			for (auto const& [error, count] : failures)
+			{
+				message += QString("- %1 (%2 stream(s))\n").arg(error).arg(count);
+			}
+
+			auto entityName = avdecc::helper::uniqueIdentifierToString(entityID);
+			if (auto controlledEntity = avdecc::ControllerManager::getInstance().getControlledEntity(entityID))
+			{
+				entityName = avdecc::helper::smartEntityName(*controlledEntity);
+			}
+			QMessageBox::information(parent, "", QString("%1 streams of %2 failed:\n\n%3").arg(start ? "Starting" : "Stopping").arg(entityName).arg(message));
+		});
+
+	if (!batchManager.run({ entityID }, { step }))
+	{
+		QObject::disconnect(*connection);
+		QMessageBox::information(parent, "", "Another batch operation is already running, please retry once it completed.");
+	}
+}
+
 HeaderView::HeaderView(Qt::Orientation orientation, QWidget* parent)
 	: QHeaderView{ orientation, parent }
 {
@@ -78,31 +130,76 @@ void HeaderView::setColor(qt::toolkit::material::color::Name const name)
 	update();
 }
 
-QVector<HeaderView::SectionState> HeaderView::saveSectionState() const
+HeaderView::State HeaderView::saveState() const
 {
-	return _sectionState;
+	return State{ _sectionState, _entityFilterIndex, _entityFilterIndexDirty };
 }
 
-void HeaderView::restoreSectionState(QVector<SectionState> const& sectionState)
+void HeaderView::restoreState(State const& state)
 {
-	if (!AVDECC_ASSERT_WITH_RET(sectionState.count() == count(), "invalid count"))
+	if (!AVDECC_ASSERT_WITH_RET(state.sectionState.count() == count(), "invalid count"))
 	{
 		_sectionState = {};
+		_entityFilterIndex.clear();
+		_entityFilterIndexDirty = true;
 		return;
 	}
 
-	_sectionState = sectionState;
+	_sectionState = state.sectionState;
+	_entityFilterIndex = state.entityFilterIndex;
+	_entityFilterIndexDirty = state.entityFilterIndexDirty;
 
-	for (auto section = 0; section < count(); ++section)
+	applySectionsVisibility(0, count() - 1);
+}
+
+void HeaderView::setFilterPattern(qt::toolkit::FilterExpression const& pattern)
+{
+	auto const previousPattern = _pattern;
+	auto const wasValidIndex = !_entityFilterIndexDirty;
+
+	_pattern = pattern;
+
+	if (!wasValidIndex)
 	{
-		updateSectionVisibility(section);
+		applyFilterPattern();
+		return;
+	}
+
+	// Type-ahead: when a plain pattern is extended, only entities currently matching can change, and the reverse when it is shortened
+	// (an empty pattern matching everything, it is the shortest of all)
+	auto const isPlainOrEmpty = [](qt::toolkit::FilterExpression const& expression)
+	{
+		return expression.isEmpty() || expression.kind() == qt::toolkit::FilterExpression::Kind::Literal;
+	};
+	auto const isIncremental = isPlainOrEmpty(previousPattern) && isPlainOrEmpty(_pattern) && (previousPattern.isEmpty() || _pattern.isEmpty() || previousPattern.caseSensitivity() == _pattern.caseSensitivity());
+	auto const previousText = previousPattern.text();
+	auto const newText = _pattern.text();
+	auto const onlyMatching = isIncremental && newText.contains(previousText, _pattern.caseSensitivity());
+	auto const onlyNotMatching = isIncremental && !onlyMatching && previousText.contains(newText, _pattern.caseSensitivity());
+
+	for (auto& info : _entityFilterIndex)
+	{
+		if ((onlyMatching && !info.matches) || (onlyNotMatching && info.matches))
+		{
+			continue;
+		}
+
+		auto const matches = matchesFilterPattern(info.name);
+		if (matches != info.matches)
+		{
+			info.matches = matches;
+			applyEntityFilter(info.node, isEntityDisplayed(info.node, matches));
+		}
 	}
 }
 
-void HeaderView::setFilterPattern(QRegExp const& pattern)
+void HeaderView::setConnectedOnly(bool const connectedOnly)
 {
-	_pattern = pattern;
-	applyFilterPattern();
+	if (connectedOnly != _connectedOnly)
+	{
+		_connectedOnly = connectedOnly;
+		applyFilterPattern();
+	}
 }
 
 void HeaderView::expandAll()
@@ -111,8 +208,6 @@ void HeaderView::expandAll()
 	{
 		_sectionState[section].expanded = true;
 		_sectionState[section].visible = true;
-
-		updateSectionVisibility(section);
 	}
 
 	applyFilterPattern();
@@ -136,8 +231,6 @@ void HeaderView::collapseAll()
 			_sectionState[section].expanded = false;
 			_sectionState[section].visible = false;
 		}
-
-		updateSectionVisibility(section);
 	}
 
 	applyFilterPattern();
@@ -193,10 +286,11 @@ void HeaderView::handleSectionInserted(QModelIndex const& /*parent*/, int first,
 {
 	auto const it = std::next(std::begin(_sectionState), first);
 	_sectionState.insert(it, last - first + 1, {});
+	_entityFilterIndexDirty = true;
 
+	auto* model = static_cast<Model*>(this->model());
 	for (auto section = first; section <= last; ++section)
 	{
-		auto* model = static_cast<Model*>(this->model());
 		auto* node = model->node(section, orientation());
 
 		if (AVDECC_ASSERT_WITH_RET(node, "Node should not be null"))
@@ -219,10 +313,12 @@ void HeaderView::handleSectionInserted(QModelIndex const& /*parent*/, int first,
 			}
 
 			_sectionState[section] = { expanded, visible };
-			updateSectionVisibility(section);
 		}
 	}
 
+	// Apply the current filter to the inserted entities only
+	applySectionsVisibility(first, last);
+
 #if ENABLE_CONNECTION_MATRIX_DEBUG
 	qDebug() << "handleSectionInserted" << _sectionState.count();
 #endif
@@ -231,6 +327,7 @@ void HeaderView::handleSectionInserted(QModelIndex const& /*parent*/, int first,
 void HeaderView::handleSectionRemoved(QModelIndex const& /*parent*/, int first, int last)
 {
 	_sectionState.remove(first, last - first + 1);
+	_entityFilterIndexDirty = true;
 
 #if ENABLE_CONNECTION_MATRIX_DEBUG
 	qDebug() << "handleSectionRemoved" << _sectionState.count();
@@ -240,6 +337,37 @@ void HeaderView::handleSectionRemoved(QModelIndex const& /*parent*/, int first,
 void HeaderView::handleModelReset()
 {
 	_sectionState.clear();
+	_entityFilterIndex.clear();
+	_entityFilterIndexDirty = true;
+}
+
+void HeaderView::handleHeaderDataChanged(Qt::Orientation orientation, int first, int last)
+{
+	if (orientation != this->orientation())
+	{
+		return;
+	}
+
+	// An entity name might have changed
+	_entityFilterIndexDirty = true;
+
+	// Entities gaining their first connection or losing their last one have to be shown or hidden
+	if (_connectedOnly)
+	{
+		auto* model = static_cast<Model*>(this->model());
+		for (auto section = first; section <= last; ++section)
+		{
+			auto* node = model->node(section, orientation);
+			if (node && node->type() == Node::Type::Entity)
+			{
+				auto const displayed = isEntityDisplayed(node, matchesFilterPattern(node->name()));
+				if (displayed == isSectionHidden(section))
+				{
+					applyEntityFilter(node, displayed);
+				}
+			}
+		}
+	}
 }
 
 void HeaderView::updateSectionVisibility(int const logicalIndex)
@@ -261,36 +389,137 @@ void HeaderView::updateSectionVisibility(int const logicalIndex)
 
 void HeaderView::applyFilterPattern()
 {
+	if (_entityFilterIndexDirty)
+	{
+		rebuildEntityFilterIndex();
+	}
+
+	for (auto& info : _entityFilterIndex)
+	{
+		info.matches = matchesFilterPattern(info.name);
+	}
+
+	applySectionsVisibility(0, count() - 1);
+}
+
+void HeaderView::applySectionsVisibility(int const first, int const last)
+{
+	if (first > last || !AVDECC_ASSERT_WITH_RET(first >= 0 && last < _sectionState.count(), "invalid range"))
+	{
+		return;
+	}
+
 	auto* model = static_cast<Model*>(this->model());
 
-	auto const showVisitor = [=](Node* node)
+	// Entities are found in the filter index in section order, when it's up-to-date
+	auto info = std::begin(_entityFilterIndex);
+	auto const infoEnd = _entityFilterIndexDirty ? info : std::end(_entityFilterIndex);
+	auto const entityDisplayed = [&](Node* node)
 	{
-		auto const section = model->section(node, orientation());
-		updateSectionVisibility(section); // Conditional update
+		auto it = info;
+		while (it != infoEnd && it->node != node)
+		{
+			++it;
+		}
+		if (it == infoEnd)
+		{
+			return isEntityDisplayed(node, matchesFilterPattern(node->name()));
+		}
+		info = it;
+		return isEntityDisplayed(node, it->matches);
 	};
 
-	auto const hideVisitor = [=](Node* node)
+	// Compute the visibility of all the sections first, children sections following their entity
+	auto hidden = std::vector<bool>(static_cast<size_t>(last - first + 1));
+	auto displayed = true;
+	if (auto* node = model->node(first, orientation()))
 	{
-		auto const section = model->section(node, orientation());
-		hideSection(section); // Hide section no matter what
-	};
+		while (auto* parent = node->parent())
+		{
+			node = parent;
+		}
+		displayed = entityDisplayed(node);
+	}
+	for (auto section = first; section <= last; ++section)
+	{
+		auto* node = model->node(section, orientation());
+		if (node && node->type() == Node::Type::Entity && section != first)
+		{
+			displayed = entityDisplayed(node);
+		}
+		hidden[section - first] = !displayed || !_sectionState[section].visible;
+	}
+
+	// Then apply it in a single pass, only touching the sections that actually change
+	auto const wasUpdatesEnabled = updatesEnabled();
+	setUpdatesEnabled(false);
+	for (auto section = first; section <= last; ++section)
+	{
+		auto const isHidden = hidden[section - first];
+		if (isSectionHidden(section) != isHidden)
+		{
+			setSectionHidden(section, isHidden);
+		}
+	}
+	setUpdatesEnabled(wasUpdatesEnabled);
+}
+
+void HeaderView::rebuildEntityFilterIndex()
+{
+	auto* model = static_cast<Model*>(this->model());
+
+	_entityFilterIndex.clear();
 
 	for (auto section = 0; section < count(); ++section)
 	{
 		auto* node = model->node(section, orientation());
-		if (node->type() == Node::Type::Entity)
+		if (node && node->type() == Node::Type::Entity)
 		{
-			auto const matches = !node->name().contains(_pattern);
+			auto const& name = node->name();
+			_entityFilterIndex.push_back(EntityFilterInfo{ node, name, matchesFilterPattern(name) });
+		}
+	}
+
+	_entityFilterIndexDirty = false;
+}
+
+bool HeaderView::matchesFilterPattern(QString const& name) const
+{
+	return _pattern.matches(name);
+}
+
+bool HeaderView::isEntityDisplayed(Node* node, bool const matches) const
+{
+	if (!matches || !_connectedOnly)
+	{
+		return matches;
+	}
+
+	auto* model = static_cast<Model*>(this->model());
+	return model->hasConnections(node, orientation());
+}
+
+void HeaderView::applyEntityFilter(Node* node, bool const matches)
+{
+	auto* model = static_cast<Model*>(this->model());
 
-			if (!matches)
+	if (matches)
+	{
+		model->accept(node,
+			[=](Node* node)
 			{
-				model->accept(node, showVisitor);
-			}
-			else
+				auto const section = model->section(node, orientation());
+				updateSectionVisibility(section); // Conditional update
+			});
+	}
+	else
+	{
+		model->accept(node,
+			[=](Node* node)
 			{
-				model->accept(node, hideVisitor);
-			}
-		}
+				auto const section = model->section(node, orientation());
+				hideSection(section); // Hide section no matter what
+			});
 	}
 }
 
@@ -322,6 +551,7 @@ void HeaderView::setModel(QAbstractItemModel* model)
 		}
 
 		connect(model, &QAbstractItemModel::modelReset, this, &HeaderView::handleModelReset);
+		connect(model, &QAbstractItemModel::headerDataChanged, this, &HeaderView::handleHeaderDataChanged);
 	}
 }
 
@@ -507,7 +737,7 @@ void HeaderView::paintSection(QPainter* painter, QRect const& rect, int logicalI
 
 	auto const elidedText = painter->fontMetrics().elidedText(node->name(), Qt::ElideMiddle, textRect.width());
 
-	if (node->isStreamNode() && !static_cast<StreamNode*>(node)->isRunning())
+	if ((node->isStreamNode() && !static_cast<StreamNode*>(node)->isRunning()) || (node->isEntityNode() && static_cast<EntityNode*>(node)->isRebooting()))
 	{
 		painter->setPen(foregroundErrorColor);
 	}
@@ -627,6 +857,46 @@ void HeaderView::contextMenuEvent(QContextMenuEvent* event)
 		{
 		}
 	}
+	else if (node->isEntityNode())
+	{
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto const entityID = node->entityID();
+		auto controlledEntity = manager.getControlledEntity(entityID);
+		if (!controlledEntity)
+		{
+			return;
+		}
+
+		// Rows are the talkers unless the matrix is transposed
+		auto const isTalker = (orientation() == Qt::Vertical) != _isTransposed;
+		auto const isAemSupported = controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported);
+		auto const isBatchRunning = avdecc::batchOperations::BatchOperationsManager::getInstance().isRunning();
+
+		QMenu menu;
+		auto* headerAction = menu.addAction("Entity: " + avdecc::helper::smartEntityName(*controlledEntity));
+		auto font = headerAction->font();
+		font.setBold(true);
+		headerAction->setFont(font);
+		headerAction->setEnabled(false);
+
+		menu.addSeparator();
+
+		auto* startAllStreamsAction = menu.addAction(isTalker ? "Start all Output Streams" : "Start all Input Streams");
+		auto* stopAllStreamsAction = menu.addAction(isTalker ? "Stop all Output Streams" : "Stop all Input Streams");
+		startAllStreamsAction->setEnabled(isAemSupported && !isBatchRunning);
+		stopAllStreamsAction->setEnabled(isAemSupported && !isBatchRunning);
+
+		// Release the controlled entity before starting a long operation (menu.exec()
+		controlledEntity.reset();
+
+		if (auto* action = menu.exec(event->globalPos()))
+		{
+			if (action == startAllStreamsAction || action == stopAllStreamsAction)
+			{
+				startStopAllStreams(this, entityID, action == startAllStreamsAction, isTalker ? avdecc::batchOperations::StreamsSelection::Outputs : avdecc::batchOperations::StreamsSelection::Inputs);
+			}
+		}
+	}
 }
 
 void HeaderView::mouseMoveEvent(QMouseEvent* event)
@@ -22,9 +22,13 @@
 #include <QHeaderView>
 #include <QVector>
 #include "toolkit/material/color.hpp"
+#include "toolkit/filterExpression.hpp"
+
+#include <vector>
 
 namespace connectionMatrix
 {
+class Node;
 class HeaderView final : public QHeaderView
 {
 public:
@@ -34,6 +38,22 @@ public:
 		bool visible{ true };
 	};
 
+	// Entity header names, to filter without walking all the sections
+	struct EntityFilterInfo
+	{
+		Node* node{ nullptr };
+		QString name{};
+		bool matches{ true };
+	};
+
+	// Complete header state, moved from one header to the other when the model is transposed
+	struct State
+	{
+		QVector<SectionState> sectionState{};
+		std::vector<EntityFilterInfo> entityFilterIndex{};
+		bool entityFilterIndexDirty{ true };
+	};
+
 	HeaderView(Qt::Orientation orientation, QWidget* parent = nullptr);
 
 	void setAlwaysShowArrowTip(bool const show);
@@ -41,15 +61,19 @@ public:
 	void setTransposed(bool const isTransposed);
 	void setColor(qt::toolkit::material::color::Name const name);
 
-	// Retrieves the current sectionState for each section
-	QVector<SectionState> saveSectionState() const;
+	// Retrieves the current sectionState for each section and the entity filter, to be restored without having to apply the filter again
+	State saveState() const;
 
-	// Applies sectionState, sectionState count must match the number of section
-	void restoreSectionState(QVector<SectionState> const& sectionState);
+	// Applies state, state sectionState count must match the number of section and the filter pattern must be the same than when it was saved
+	void restoreState(State const& state);
 
-	// Set filter regexp that applies to entity
+	// Set filter expression that applies to entity
 	// i.e the complete entity hierarchy is visible (with respect of the current collapse/expand state) if the entity name matches pattern
-	void setFilterPattern(QRegExp const& pattern);
+	// Plain text expressions (literal or prefix) are matched incrementally from the previous one when possible (type-ahead)
+	void setFilterPattern(qt::toolkit::FilterExpression const& pattern);
+
+	// Only show the entities having at least one connection (in addition to the filter pattern), updated as connections change
+	void setConnectedOnly(bool const connectedOnly);
 
 	// Expand all child nodes of each entity
 	void expandAll();
@@ -62,8 +86,14 @@ private:
 	void handleSectionInserted(QModelIndex const& parent, int first, int last);
 	void handleSectionRemoved(QModelIndex const& parent, int first, int last);
 	void handleModelReset();
+	void handleHeaderDataChanged(Qt::Orientation orientation, int first, int last);
 	void updateSectionVisibility(int const logicalIndex);
 	void applyFilterPattern();
+	void applySectionsVisibility(int const first, int const last);
+	void rebuildEntityFilterIndex();
+	bool matchesFilterPattern(QString const& name) const;
+	bool isEntityDisplayed(Node* node, bool const matches) const;
+	void applyEntityFilter(Node* node, bool const matches);
 
 	// QHeaderView overrides
 	virtual void setModel(QAbstractItemModel* model) override;
@@ -76,7 +106,10 @@ private:
 
 private:
 	QVector<SectionState> _sectionState;
-	QRegExp _pattern;
+	qt::toolkit::FilterExpression _pattern{};
+	std::vector<EntityFilterInfo> _entityFilterIndex{};
+	bool _entityFilterIndexDirty{ true };
+	bool _connectedOnly{ false };
 
 	bool _alwaysShowArrowTip{ false };
 	bool _alwaysShowArrowEnd{ false };
@@ -0,0 +1,381 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "connectionMatrix/matrixExport.hpp"
+#include "connectionMatrix/node.hpp"
+#include "connectionMatrix/paintHelper.hpp"
+#include "avdecc/spanTrace.hpp"
+
+#include <QFileInfo>
+#include <QFontMetrics>
+#include <QPageLayout>
+#include <QPainter>
+#include <QPdfWriter>
+#include <QPointer>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QStringList>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <tuple>
+#include <unordered_map>
+
+namespace connectionMatrix
+{
+namespace matrixExport
+{
+// PDF layout, in points (the writer resolution is set to 72 dpi)
+static constexpr auto PdfResolution = 72;
+static constexpr auto PdfCellSize = 12;
+static constexpr auto PdfTalkerHeaderWidth = 180;
+static constexpr auto PdfListenerHeaderHeight = 140;
+static constexpr auto PdfFooterHeight = 16;
+static constexpr auto PdfGlyphScale = 4; // Glyphs are rendered bigger than the cell, so they stay sharp when zooming the document
+
+class ExportTask final : public QRunnable
+{
+public:
+	using Work = std::function<void()>;
+
+	ExportTask(Work&& work) noexcept
+		: _work{ std::move(work) }
+	{
+	}
+
+	virtual void run() override
+	{
+		_work();
+	}
+
+private:
+	Work _work{};
+};
+
+static bool isExportedNode(Node const* const node, Model::Mode const mode) noexcept
+{
+	return node && (mode == Model::Mode::Channel ? node->isChannelNode() : node->isStreamNode());
+}
+
+static QString nodePath(Node const* const node) noexcept
+{
+	auto path = node->name();
+	for (auto const* parent = node->parent(); parent; parent = parent->parent())
+	{
+		path = parent->name() + " / " + path;
+	}
+	return path;
+}
+
+static QByteArray csvField(QString const& value) noexcept
+{
+	auto escaped = value;
+	escaped.replace('"', "\"\"");
+	return '"' + escaped.toUtf8() + '"';
+}
+
+static QString cellText(Cell const& cell) noexcept
+{
+	auto text = QString{};
+	switch (cell.state)
+	{
+		case Model::IntersectionData::State::Connected:
+			text = "Connected";
+			break;
+		case Model::IntersectionData::State::FastConnecting:
+			text = "Fast Connecting";
+			break;
+		case Model::IntersectionData::State::PartiallyConnected:
+			text = "Partially Connected";
+			break;
+		default:
+			break;
+	}
+
+	auto problems = QStringList{};
+	if (cell.flags.test(Model::IntersectionData::Flag::InterfaceDown))
+	{
+		problems << "Interface Down";
+	}
+	if (cell.flags.test(Model::IntersectionData::Flag::WrongDomain))
+	{
+		problems << "Wrong Domain";
+	}
+	if (cell.flags.test(Model::IntersectionData::Flag::WrongFormat))
+	{
+		problems << "Wrong Format";
+	}
+	if (!problems.isEmpty())
+	{
+		text += " (" + problems.join(", ") + ")";
+	}
+	return text;
+}
+
+static QString writeCsv(Snapshot const& snapshot, QString const& filePath) noexcept
+{
+	auto file = QSaveFile{ filePath };
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return file.errorString();
+	}
+
+	// One row at a time, the buffer keeping its capacity between rows
+	auto row = QByteArray{};
+	row += csvField(snapshot.mode == Model::Mode::Channel ? "Talker Channel \\ Listener Channel" : "Talker Stream \\ Listener Stream");
+	for (auto const& listenerName : snapshot.listenerNames)
+	{
+		row += ',';
+		row += csvField(listenerName);
+	}
+	row += '\n';
+	if (file.write(row) < 0)
+	{
+		return file.errorString();
+	}
+
+	auto cellIt = snapshot.cells.begin();
+	auto const talkersCount = static_cast<int>(snapshot.talkerNames.size());
+	auto const listenersCount = static_cast<int>(snapshot.listenerNames.size());
+	for (auto talker = 0; talker < talkersCount; ++talker)
+	{
+		row.clear();
+		row += csvField(snapshot.talkerNames[talker]);
+		for (auto listener = 0; listener < listenersCount; ++listener)
+		{
+			row += ',';
+			if (cellIt != snapshot.cells.end() && cellIt->talker == talker && cellIt->listener == listener)
+			{
+				row += cellText(*cellIt).toUtf8();
+				++cellIt;
+			}
+		}
+		row += '\n';
+		if (file.write(row) < 0)
+		{
+			return file.errorString();
+		}
+	}
+
+	if (!file.commit())
+	{
+		return file.errorString();
+	}
+	return {};
+}
+
+static QString writePdf(Snapshot const& snapshot, QString const& filePath) noexcept
+{
+	auto file = QSaveFile{ filePath };
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return file.errorString();
+	}
+
+	auto const talkersCount = static_cast<int>(snapshot.talkerNames.size());
+	auto const listenersCount = static_cast<int>(snapshot.listenerNames.size());
+
+	{
+		auto writer = QPdfWriter{ &file };
+		writer.setTitle(QFileInfo{ filePath }.completeBaseName());
+		writer.setResolution(PdfResolution);
+		writer.setPageLayout(QPageLayout{ QPageSize{ QPageSize::A4 }, QPageLayout::Landscape, QMarginsF{ 20, 20, 20, 20 }, QPageLayout::Point });
+
+		auto painter = QPainter{ &writer };
+		auto font = painter.font();
+		font.setPointSizeF(PdfCellSize * 0.6);
+		painter.setFont(font);
+		auto const fontMetrics = QFontMetrics{ font, &writer };
+
+		auto const columnsPerPage = std::max(1, (writer.width() - PdfTalkerHeaderWidth) / PdfCellSize);
+		auto const rowsPerPage = std::max(1, (writer.height() - PdfListenerHeaderHeight - PdfFooterHeight) / PdfCellSize);
+		auto const pageColumns = (listenersCount + columnsPerPage - 1) / columnsPerPage;
+		auto const pageRows = (talkersCount + rowsPerPage - 1) / rowsPerPage;
+
+		// The pixmaps of the view are Qt Main Thread only, the worker keeps its own glyph images (only a few type, state and flags combinations are connected)
+		auto glyphs = std::unordered_map<std::uint32_t, QImage>{};
+		auto const glyph = [&glyphs](Cell const& cell) -> QImage const&
+		{
+			auto const key = (static_cast<std::uint32_t>(cell.type) << 16) | (static_cast<std::uint32_t>(cell.state) << 8) | static_cast<std::uint32_t>(cell.flags.value());
+			auto it = glyphs.find(key);
+			if (it == glyphs.end())
+			{
+				it = glyphs.emplace(key, paintHelper::renderCapabilitiesImage(QSize{ PdfCellSize, PdfCellSize } * PdfGlyphScale, cell.type, cell.state, cell.flags)).first;
+			}
+			return it->second;
+		};
+
+		auto const gridPen = QPen{ QColor{ 0xD0D0D0 }, 0.5 };
+		auto const textPen = QPen{ Qt::black };
+
+		for (auto pageRow = 0; pageRow < pageRows; ++pageRow)
+		{
+			auto const firstTalker = pageRow * rowsPerPage;
+			auto const lastTalker = std::min(talkersCount, firstTalker + rowsPerPage); // Excluded
+
+			for (auto pageColumn = 0; pageColumn < pageColumns; ++pageColumn)
+			{
+				auto const firstListener = pageColumn * columnsPerPage;
+				auto const lastListener = std::min(listenersCount, firstListener + columnsPerPage); // Excluded
+
+				if (pageRow != 0 || pageColumn != 0)
+				{
+					writer.newPage();
+				}
+
+				auto const gridLeft = PdfTalkerHeaderWidth;
+				auto const gridTop = PdfListenerHeaderHeight;
+				auto const gridRight = gridLeft + (lastListener - firstListener) * PdfCellSize;
+				auto const gridBottom = gridTop + (lastTalker - firstTalker) * PdfCellSize;
+
+				// Listener headers, rotated
+				painter.setPen(textPen);
+				for (auto listener = firstListener; listener < lastListener; ++listener)
+				{
+					auto const x = gridLeft + (listener - firstListener) * PdfCellSize;
+					painter.save();
+					painter.translate(x, gridTop);
+					painter.rotate(-90);
+					painter.drawText(QRect{ 2, 0, PdfListenerHeaderHeight - 4, PdfCellSize }, Qt::AlignLeft | Qt::AlignVCenter, fontMetrics.elidedText(snapshot.listenerNames[listener], Qt::ElideLeft, PdfListenerHeaderHeight - 4));
+					painter.restore();
+				}
+
+				// Talker headers
+				for (auto talker = firstTalker; talker < lastTalker; ++talker)
+				{
+					auto const y = gridTop + (talker - firstTalker) * PdfCellSize;
+					painter.drawText(QRect{ 0, y, PdfTalkerHeaderWidth - 4, PdfCellSize }, Qt::AlignRight | Qt::AlignVCenter, fontMetrics.elidedText(snapshot.talkerNames[talker], Qt::ElideLeft, PdfTalkerHeaderWidth - 4));
+				}
+
+				// Grid
+				painter.setPen(gridPen);
+				for (auto x = gridLeft; x <= gridRight; x += PdfCellSize)
+				{
+					painter.drawLine(x, gridTop, x, gridBottom);
+				}
+				for (auto y = gridTop; y <= gridBottom; y += PdfCellSize)
+				{
+					painter.drawLine(gridLeft, y, gridRight, y);
+				}
+
+				// Connected intersections of the tile
+				for (auto talker = firstTalker; talker < lastTalker; ++talker)
+				{
+					auto cellIt = std::lower_bound(snapshot.cells.begin(), snapshot.cells.end(), std::make_pair(talker, firstListener),
+						[](Cell const& cell, std::pair<int, int> const& position)
+						{
+							return std::tie(cell.talker, cell.listener) < std::tie(position.first, position.second);
+						});
+					for (; cellIt != snapshot.cells.end() && cellIt->talker == talker && cellIt->listener < lastListener; ++cellIt)
+					{
+						auto const rect = QRect{ gridLeft + (cellIt->listener - firstListener) * PdfCellSize, gridTop + (talker - firstTalker) * PdfCellSize, PdfCellSize, PdfCellSize };
+						painter.drawImage(rect, glyph(*cellIt));
+					}
+				}
+
+				// Footer
+				painter.setPen(textPen);
+				painter.drawText(QRect{ 0, writer.height() - PdfFooterHeight, writer.width(), PdfFooterHeight }, Qt::AlignCenter, QString("Talkers %1-%2 of %3, Listeners %4-%5 of %6 (page %7 of %8)").arg(firstTalker + 1).arg(lastTalker).arg(talkersCount).arg(firstListener + 1).arg(lastListener).arg(listenersCount).arg(pageRow * pageColumns + pageColumn + 1).arg(pageRows * pageColumns));
+			}
+		}
+	}
+
+	if (!file.commit())
+	{
+		return file.errorString();
+	}
+	return {};
+}
+
+Format formatFromFilePath(QString const& filePath) noexcept
+{
+	return QFileInfo{ filePath }.suffix().compare("pdf", Qt::CaseInsensitive) == 0 ? Format::Pdf : Format::Csv;
+}
+
+Snapshot takeSnapshot(Model const& model) noexcept
+{
+	HIVE_TRACE_SPAN("matrixExport::takeSnapshot");
+
+	auto snapshot = Snapshot{};
+	snapshot.mode = model.mode();
+
+	auto const isTransposed = model.isTransposed();
+	auto const talkerOrientation = isTransposed ? Qt::Horizontal : Qt::Vertical;
+	auto const listenerOrientation = isTransposed ? Qt::Vertical : Qt::Horizontal;
+
+	// Exported index of each section, -1 if the section is not exported
+	auto const indexSections = [&model, &snapshot](Qt::Orientation const orientation, int const count, std::vector<QString>& names)
+	{
+		auto indexes = std::vector<int>(static_cast<size_t>(count), -1);
+		for (auto section = 0; section < count; ++section)
+		{
+			auto const* const node = model.node(section, orientation);
+			if (isExportedNode(node, snapshot.mode))
+			{
+				indexes[section] = static_cast<int>(names.size());
+				names.push_back(nodePath(node));
+			}
+		}
+		return indexes;
+	};
+	auto const talkerIndexes = indexSections(talkerOrientation, isTransposed ? model.columnCount() : model.rowCount(), snapshot.talkerNames);
+	auto const listenerIndexes = indexSections(listenerOrientation, isTransposed ? model.rowCount() : model.columnCount(), snapshot.listenerNames);
+
+	for (auto const& intersection : model.connectedIntersections())
+	{
+		auto const talker = talkerIndexes[intersection.talkerSection];
+		auto const listener = listenerIndexes[intersection.listenerSection];
+		if (talker == -1 || listener == -1)
+		{
+			continue;
+		}
+
+		auto const index = isTransposed ? model.index(intersection.listenerSection, intersection.talkerSection) : model.index(intersection.talkerSection, intersection.listenerSection);
+		auto const intersectionData = model.intersectionData(index);
+		snapshot.cells.push_back(Cell{ talker, listener, intersectionData.type, intersection.state, intersectionData.flags });
+	}
+
+	std::sort(snapshot.cells.begin(), snapshot.cells.end(),
+		[](Cell const& lhs, Cell const& rhs)
+		{
+			return std::tie(lhs.talker, lhs.listener) < std::tie(rhs.talker, rhs.listener);
+		});
+
+	return snapshot;
+}
+
+void exportToFile(Snapshot&& snapshot, Format const format, QString const& filePath, QObject* const context, CompletionHandler const& handler) noexcept
+{
+	QThreadPool::globalInstance()->start(new ExportTask{
+		[snapshot = std::move(snapshot), format, filePath, context = QPointer<QObject>{ context }, handler]()
+		{
+			auto const errorString = format == Format::Pdf ? writePdf(snapshot, filePath) : writeCsv(snapshot, filePath);
+			if (context && handler)
+			{
+				QMetaObject::invokeMethod(context,
+					[handler, errorString]()
+					{
+						handler(errorString.isEmpty(), errorString);
+					});
+			}
+		} });
+}
+
+} // namespace matrixExport
+} // namespace connectionMatrix
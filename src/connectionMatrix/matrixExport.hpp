@@ -0,0 +1,83 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "connectionMatrix/model.hpp"
+
+#include <QObject>
+#include <QString>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace connectionMatrix
+{
+namespace matrixExport
+{
+enum class Format
+{
+	Csv,
+	Pdf,
+};
+
+/** Format deduced from the file extension (CSV unless it's a .pdf file) */
+Format formatFromFilePath(QString const& filePath) noexcept;
+
+/** Connected intersection of the snapshot, talker and listener being indexes in the exported names */
+struct Cell
+{
+	int talker{ 0 };
+	int listener{ 0 };
+	Model::IntersectionData::Type type{ Model::IntersectionData::Type::None };
+	Model::IntersectionData::State state{ Model::IntersectionData::State::NotConnected };
+	Model::IntersectionData::Flags flags{};
+};
+
+struct Snapshot
+{
+	Model::Mode mode{ Model::Mode::Stream };
+	std::vector<QString> talkerNames{}; // Full path of each exported talker section ("Entity / Stream")
+	std::vector<QString> listenerNames{}; // Full path of each exported listener section
+	std::vector<Cell> cells{}; // Connected intersections only, sorted by talker then listener
+
+	bool empty() const noexcept
+	{
+		return talkerNames.empty() || listenerNames.empty();
+	}
+};
+
+/**
+* @brief Snapshots what the export needs from the model: the names of the stream sections (or channel sections in Channel mode), whatever their filter and collapse states, and the connected intersections (Qt Main Thread only).
+* @details Only the connected intersections are read from the intersection storage, so the cost is the count of sections and connections, never talkers x listeners.
+*/
+Snapshot takeSnapshot(Model const& model) noexcept;
+
+using CompletionHandler = std::function<void(bool const success, QString const& errorString)>;
+
+/**
+* @brief Writes the snapshot to the file in background: a talkers x listeners CSV table, or a paged PDF (tiles of the matrix with their headers, connected intersections using the capabilities glyphs).
+* @details Rows (CSV) and pages (PDF) are streamed to the file, the complete output is never built in memory. The file is only replaced once completely written.
+*          The handler is called in the thread of the context object, if it still exists.
+*/
+void exportToFile(Snapshot&& snapshot, Format const format, QString const& filePath, QObject* const context, CompletionHandler const& handler) noexcept;
+
+} // namespace matrixExport
+} // namespace connectionMatrix
@@ -0,0 +1,203 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "connectionMatrix/minimap.hpp"
+#include "connectionMatrix/model.hpp"
+#include "connectionMatrix/paintHelper.hpp"
+#include "avdecc/controllerManager.hpp"
+#include "avdecc/channelConnectionManager.hpp"
+#include "toolkit/material/color.hpp"
+
+#include <QTableView>
+#include <QScrollBar>
+#include <QPainter>
+#include <QMouseEvent>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+namespace color = qt::toolkit::material::color;
+
+namespace connectionMatrix
+{
+/** Size of the minimap widget */
+static constexpr auto MinimapSize = 160;
+/** Maximum size of the rendered image (in both directions), intersections are merged above it */
+static constexpr auto MaxImageSize = 1024;
+/** Connection changes are coalesced for this duration before the image is rendered again */
+static constexpr auto RebuildDelay = std::chrono::milliseconds{ 100 };
+
+// Converts a section to its coordinate in an image of size pixels representing count sections
+static int sectionToPixel(int const section, int const count, int const size)
+{
+	return static_cast<int>(static_cast<std::int64_t>(section) * size / count);
+}
+
+Minimap::Minimap(QTableView* view, Model* model, QWidget* parent)
+	: QWidget{ parent }
+	, _view{ view }
+	, _model{ model }
+{
+	setFixedSize(MinimapSize, MinimapSize);
+	setCursor(Qt::PointingHandCursor);
+
+	_rebuildTimer.setSingleShot(true);
+	_rebuildTimer.setInterval(RebuildDelay);
+	connect(&_rebuildTimer, &QTimer::timeout, this, &Minimap::rebuild);
+
+	// Sections changes
+	connect(_model, &QAbstractItemModel::modelReset, this, &Minimap::scheduleRebuild);
+	connect(_model, &QAbstractItemModel::layoutChanged, this, &Minimap::scheduleRebuild);
+	for (auto const& signal : { &QAbstractItemModel::rowsInserted, &QAbstractItemModel::rowsRemoved, &QAbstractItemModel::columnsInserted, &QAbstractItemModel::columnsRemoved })
+	{
+		connect(_model, signal, this, &Minimap::scheduleRebuild);
+	}
+
+	// Connections changes (not all of them go through a model dataChanged, intersections being lazily computed)
+	connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::streamConnectionChanged, this, &Minimap::scheduleRebuild);
+	connect(&avdecc::ChannelConnectionManager::getInstance(), &avdecc::ChannelConnectionManager::listenerClusterSpansUpdate, this, &Minimap::scheduleRebuild);
+
+	// Visible area changes
+	connect(_view->horizontalScrollBar(), &QScrollBar::valueChanged, this, qOverload<>(&QWidget::update));
+	connect(_view->verticalScrollBar(), &QScrollBar::valueChanged, this, qOverload<>(&QWidget::update));
+
+	rebuild();
+}
+
+void Minimap::scheduleRebuild()
+{
+	if (!_rebuildTimer.isActive())
+	{
+		_rebuildTimer.start();
+	}
+}
+
+void Minimap::rebuild()
+{
+	auto const rows = _model->rowCount();
+	auto const columns = _model->columnCount();
+
+	if (rows == 0 || columns == 0)
+	{
+		_image = {};
+		update();
+		return;
+	}
+
+	auto const width = std::min(columns, MaxImageSize);
+	auto const height = std::min(rows, MaxImageSize);
+	auto const isTransposed = _model->isTransposed();
+
+	_image = QImage{ width, height, QImage::Format_RGB32 };
+	_image.fill(color::value(color::Name::Gray, color::Shade::Shade100));
+
+	// Only the connected intersections are drawn, directly from the cached connections
+	for (auto const& intersection : _model->connectedIntersections())
+	{
+		auto const row = isTransposed ? intersection.listenerSection : intersection.talkerSection;
+		auto const column = isTransposed ? intersection.talkerSection : intersection.listenerSection;
+		auto const x = sectionToPixel(column, columns, width);
+		auto const y = sectionToPixel(row, rows, height);
+
+		reinterpret_cast<QRgb*>(_image.scanLine(y))[x] = paintHelper::connectionColor(intersection.state).rgb();
+	}
+
+	update();
+}
+
+QRect Minimap::imageRect() const
+{
+	if (_image.isNull())
+	{
+		return {};
+	}
+
+	// Keep the aspect ratio of the matrix, within the widget borders
+	auto const available = rect().adjusted(1, 1, -1, -1);
+	auto const size = _image.size().scaled(available.size(), Qt::KeepAspectRatio);
+	return QRect{ available.topLeft(), size };
+}
+
+void Minimap::scrollViewTo(QPoint const& pos)
+{
+	auto const target = imageRect();
+	if (!target.isValid())
+	{
+		return;
+	}
+
+	auto const rows = _model->rowCount();
+	auto const columns = _model->columnCount();
+	auto const row = std::clamp(sectionToPixel(pos.y() - target.top(), target.height(), rows), 0, rows - 1);
+	auto const column = std::clamp(sectionToPixel(pos.x() - target.left(), target.width(), columns), 0, columns - 1);
+
+	_view->scrollTo(_model->index(row, column), QAbstractItemView::PositionAtCenter);
+}
+
+void Minimap::paintEvent(QPaintEvent*)
+{
+	auto painter = QPainter{ this };
+
+	painter.fillRect(rect(), color::value(color::Name::Gray, color::Shade::Shade300));
+
+	auto const target = imageRect();
+	if (!target.isValid())
+	{
+		return;
+	}
+
+	painter.drawImage(target, _image);
+
+	// Visible area of the view
+	auto const rows = _model->rowCount();
+	auto const columns = _model->columnCount();
+	auto const* const viewport = _view->viewport();
+	auto const firstRow = std::max(0, _view->rowAt(0));
+	auto const lastRow = _view->rowAt(viewport->height() - 1) == -1 ? rows - 1 : _view->rowAt(viewport->height() - 1);
+	auto const firstColumn = std::max(0, _view->columnAt(0));
+	auto const lastColumn = _view->columnAt(viewport->width() - 1) == -1 ? columns - 1 : _view->columnAt(viewport->width() - 1);
+
+	auto const left = target.left() + sectionToPixel(firstColumn, columns, target.width());
+	auto const right = target.left() + sectionToPixel(lastColumn + 1, columns, target.width());
+	auto const top = target.top() + sectionToPixel(firstRow, rows, target.height());
+	auto const bottom = target.top() + sectionToPixel(lastRow + 1, rows, target.height());
+
+	painter.setPen(QPen{ color::value(color::Name::Red, color::Shade::Shade500), 1 });
+	painter.setBrush(Qt::NoBrush);
+	painter.drawRect(QRect{ QPoint{ left, top }, QPoint{ std::max(left, right - 1), std::max(top, bottom - 1) } });
+}
+
+void Minimap::mousePressEvent(QMouseEvent* event)
+{
+	if (event->button() == Qt::LeftButton)
+	{
+		scrollViewTo(event->pos());
+	}
+}
+
+void Minimap::mouseMoveEvent(QMouseEvent* event)
+{
+	if (event->buttons() & Qt::LeftButton)
+	{
+		scrollViewTo(event->pos());
+	}
+}
+
+} // namespace connectionMatrix
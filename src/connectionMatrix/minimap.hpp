@@ -0,0 +1,56 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QWidget>
+#include <QImage>
+#include <QTimer>
+
+class QTableView;
+
+namespace connectionMatrix
+{
+class Model;
+
+/** Overview of the whole matrix (at most one pixel per intersection) showing the connections and the visible area, clicking it scrolls the view */
+class Minimap final : public QWidget
+{
+public:
+	Minimap(QTableView* view, Model* model, QWidget* parent = nullptr);
+
+private:
+	void scheduleRebuild();
+	void rebuild();
+	QRect imageRect() const;
+	void scrollViewTo(QPoint const& pos);
+
+	// QWidget overrides
+	virtual void paintEvent(QPaintEvent* event) override;
+	virtual void mousePressEvent(QMouseEvent* event) override;
+	virtual void mouseMoveEvent(QMouseEvent* event) override;
+
+private:
+	QTableView* const _view{ nullptr };
+	Model* const _model{ nullptr };
+	QImage _image{};
+	QTimer _rebuildTimer{};
+};
+
+} // namespace connectionMatrix
@@ -19,12 +19,24 @@
 
 #include "connectionMatrix/model.hpp"
 #include "connectionMatrix/node.hpp"
+#include "connectionMatrix/nodeTemplateCache.hpp"
+#include "avdecc/spanTrace.hpp"
 #include "avdecc/controllerManager.hpp"
 #include "avdecc/channelConnectionManager.hpp"
 #include "avdecc/helper.hpp"
 #include "avdecc/hiveLogItems.hpp"
+#include "avdecc/memoryAccounting.hpp"
 #include "toolkit/helper.hpp"
+#include "frameScheduler.hpp"
+#include <algorithm>
+#include <cstdint>
 #include <deque>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #if ENABLE_CONNECTION_MATRIX_DEBUG
@@ -48,43 +60,549 @@ using Nodes = std::deque<Node*>;
 // Entity node by entity ID
 using NodeMap = std::unordered_map<la::avdecc::UniqueIdentifier, std::unique_ptr<EntityNode>, la::avdecc::UniqueIdentifier::hash>;
 
-// Entity section by entity ID
-using EntitySectionMap = std::unordered_map<la::avdecc::UniqueIdentifier, int, la::avdecc::UniqueIdentifier::hash>;
+// Connected listener streams count by entity ID
+using ConnectionCounts = std::unordered_map<la::avdecc::UniqueIdentifier, int, la::avdecc::UniqueIdentifier::hash>;
+
+/**
+* @brief Open-addressing (linear probing) hash map, for the small keys and pointer values of the node caches.
+* @details Entries are stored inline in a power of 2 sized table kept at most half full, and erase shifts the following entries back so there is no tombstone.
+*          Any insertion or erase invalidates the iterators.
+*/
+template<typename Key, typename Value, typename Hash>
+class FlatMap final
+{
+public:
+	using value_type = std::pair<Key, Value>;
+
+private:
+	struct Slot
+	{
+		value_type value{};
+		bool isUsed{ false };
+	};
+
+	template<typename SlotType, typename ValueType>
+	class BasicIterator final
+	{
+	public:
+		BasicIterator(SlotType* const slot, SlotType* const end) noexcept
+			: _slot{ slot }
+			, _end{ end }
+		{
+			skipUnused();
+		}
+
+		ValueType& operator*() const noexcept
+		{
+			return _slot->value;
+		}
+
+		ValueType* operator->() const noexcept
+		{
+			return &_slot->value;
+		}
+
+		BasicIterator& operator++() noexcept
+		{
+			++_slot;
+			skipUnused();
+			return *this;
+		}
+
+		bool operator==(BasicIterator const& other) const noexcept
+		{
+			return _slot == other._slot;
+		}
+
+		bool operator!=(BasicIterator const& other) const noexcept
+		{
+			return _slot != other._slot;
+		}
+
+	private:
+		void skipUnused() noexcept
+		{
+			while (_slot != _end && !_slot->isUsed)
+			{
+				++_slot;
+			}
+		}
+
+		SlotType* _slot{ nullptr };
+		SlotType* _end{ nullptr };
+	};
+
+public:
+	using iterator = BasicIterator<Slot, value_type>;
+	using const_iterator = BasicIterator<Slot const, value_type const>;
+
+	iterator begin() noexcept
+	{
+		return iterator{ _slots.data(), _slots.data() + _slots.size() };
+	}
+
+	iterator end() noexcept
+	{
+		return iterator{ _slots.data() + _slots.size(), _slots.data() + _slots.size() };
+	}
+
+	const_iterator begin() const noexcept
+	{
+		return const_iterator{ _slots.data(), _slots.data() + _slots.size() };
+	}
+
+	const_iterator end() const noexcept
+	{
+		return const_iterator{ _slots.data() + _slots.size(), _slots.data() + _slots.size() };
+	}
+
+	std::size_t size() const noexcept
+	{
+		return _size;
+	}
+
+	bool empty() const noexcept
+	{
+		return _size == 0u;
+	}
+
+	void clear() noexcept
+	{
+		_slots.clear();
+		_size = 0u;
+	}
+
+	iterator find(Key const& key) noexcept
+	{
+		auto const index = slotIndex(key);
+		return index != NotFound ? iteratorAt(index) : end();
+	}
+
+	const_iterator find(Key const& key) const noexcept
+	{
+		auto const index = slotIndex(key);
+		return index != NotFound ? const_iterator{ _slots.data() + index, _slots.data() + _slots.size() } : end();
+	}
+
+	std::pair<iterator, bool> insert(value_type const& value)
+	{
+		// Keep the load factor under 50% so probe sequences stay short
+		if ((_size + 1u) * 2u > _slots.size())
+		{
+			rehash(std::max(MinimumCapacity, _slots.size() * 2u));
+		}
+
+		auto const mask = _slots.size() - 1u;
+		for (auto index = Hash{}(value.first) & mask;; index = (index + 1u) & mask)
+		{
+			auto& slot = _slots[index];
+			if (!slot.isUsed)
+			{
+				slot.value = value;
+				slot.isUsed = true;
+				++_size;
+				return std::make_pair(iteratorAt(index), true);
+			}
+			if (slot.value.first == value.first)
+			{
+				return std::make_pair(iteratorAt(index), false);
+			}
+		}
+	}
+
+	std::size_t erase(Key const& key) noexcept
+	{
+		auto hole = slotIndex(key);
+		if (hole == NotFound)
+		{
+			return 0u;
+		}
+
+		// Backward shift: move back the following entries of the cluster that are allowed to live in the hole
+		auto const mask = _slots.size() - 1u;
+		for (auto index = (hole + 1u) & mask; _slots[index].isUsed; index = (index + 1u) & mask)
+		{
+			auto const home = Hash{}(_slots[index].value.first) & mask;
+			if (((index - home) & mask) >= ((index - hole) & mask))
+			{
+				_slots[hole] = std::move(_slots[index]);
+				hole = index;
+			}
+		}
+		_slots[hole] = Slot{};
+		--_size;
+		return 1u;
+	}
+
+private:
+	static constexpr std::size_t MinimumCapacity = 16u;
+	static constexpr std::size_t NotFound = ~std::size_t{ 0u };
+
+	iterator iteratorAt(std::size_t const index) noexcept
+	{
+		return iterator{ _slots.data() + index, _slots.data() + _slots.size() };
+	}
+
+	std::size_t slotIndex(Key const& key) const noexcept
+	{
+		if (_slots.empty())
+		{
+			return NotFound;
+		}
+
+		auto const mask = _slots.size() - 1u;
+		for (auto index = Hash{}(key) & mask;; index = (index + 1u) & mask)
+		{
+			auto const& slot = _slots[index];
+			if (!slot.isUsed)
+			{
+				return NotFound;
+			}
+			if (slot.value.first == key)
+			{
+				return index;
+			}
+		}
+	}
+
+	void rehash(std::size_t const capacity)
+	{
+		auto slots = std::vector<Slot>(capacity);
+		auto const mask = capacity - 1u;
+		for (auto& slot : _slots)
+		{
+			if (slot.isUsed)
+			{
+				auto index = Hash{}(slot.value.first) & mask;
+				while (slots[index].isUsed)
+				{
+					index = (index + 1u) & mask;
+				}
+				slots[index] = std::move(slot);
+			}
+		}
+		_slots = std::move(slots);
+	}
+
+	std::vector<Slot> _slots{};
+	std::size_t _size{ 0u };
+};
+
+// Mixing hash of an entity ID and a 16-bit index, packed in a single 64-bit word and finalized (entity IDs of a vendor only differ in a few bits, and indexes are small)
+inline std::size_t hashEntityIndex(la::avdecc::UniqueIdentifier const& entityID, std::uint16_t const index) noexcept
+{
+	auto value = entityID.getValue() ^ (static_cast<std::uint64_t>(index) * 0x9e3779b97f4a7c15ull);
+	value ^= value >> 30;
+	value *= 0xbf58476d1ce4e5b9ull;
+	value ^= value >> 27;
+	value *= 0x94d049bb133111ebull;
+	value ^= value >> 31;
+	return static_cast<std::size_t>(value);
+}
 
 // Unique stream identifier
 using StreamKey = std::pair<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::StreamIndex>;
 
 struct StreamKeyHash
 {
-	std::size_t operator()(StreamKey const& key) const
+	std::size_t operator()(StreamKey const& key) const noexcept
 	{
-		return la::avdecc::UniqueIdentifier::hash()(key.first) ^ std::hash<la::avdecc::entity::model::StreamIndex>()(key.second);
+		return hashEntityIndex(key.first, key.second);
 	}
 };
 
 static auto const InvalidStreamKey = StreamKey{};
 
 // StreamNode by StreamKey
-using StreamNodeMap = std::unordered_map<StreamKey, StreamNode*, StreamKeyHash>;
+using StreamNodeMap = FlatMap<StreamKey, StreamNode*, StreamKeyHash>;
 
 // Unique channel identifier
 using ChannelKey = std::pair<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::ClusterIndex>;
 
 struct ChannelKeyHash
 {
-	std::size_t operator()(ChannelKey const& key) const
+	std::size_t operator()(ChannelKey const& key) const noexcept
 	{
-		return la::avdecc::UniqueIdentifier::hash()(key.first) ^ std::hash<la::avdecc::entity::model::ClusterIndex>()(key.second);
+		return hashEntityIndex(key.first, key.second);
 	}
 };
 
 static auto const InvalidChannelKey = ChannelKey{};
 
 // ChannelNode by ChannelKey
-using ChannelNodeMap = std::unordered_map<ChannelKey, ChannelNode*, ChannelKeyHash>;
+using ChannelNodeMap = FlatMap<ChannelKey, ChannelNode*, ChannelKeyHash>;
+
+// StreamNodes by gPTP grandmaster ID (WrongDomain only depends on the grandmaster equality, the domain number is not part of the key)
+using GrandMasterStreamNodes = std::unordered_map<la::avdecc::UniqueIdentifier, std::unordered_set<StreamNode*>, la::avdecc::UniqueIdentifier::hash>;
+
+/**
+* @brief Flattened nodes of the model, ordered by entityID.
+* @details Entities are stored in a treap keyed by entityID where each item knows the section count of its subtree (order statistics),
+*          so inserting/removing an entity and converting a node to its section are O(log n), whatever the number of sections.
+*          A flat section to node vector is also maintained (patched on insert/remove), so converting a section to its node is O(1) when painting.
+*/
+class SectionIndex
+{
+public:
+	// Returns the number of sections
+	std::size_t size() const noexcept
+	{
+		return static_cast<std::size_t>(total(_root.get()));
+	}
+
+	bool empty() const noexcept
+	{
+		return !_root;
+	}
+
+	void clear() noexcept
+	{
+		_root.reset();
+		_locations.clear();
+		_sections.clear();
+	}
+
+	// Returns the first section of entityID if it's present, or the section where it would be inserted otherwise
+	int entitySection(la::avdecc::UniqueIdentifier const& entityID) const noexcept
+	{
+		auto section = 0;
+		auto const* item = _root.get();
+		while (item)
+		{
+			if (item->entityID < entityID)
+			{
+				section += total(item->left.get()) + item->count();
+				item = item->right.get();
+			}
+			else
+			{
+				item = item->left.get();
+			}
+		}
+		return section;
+	}
+
+	// Inserts the flattened nodes of an entity (the entity node being the first one)
+	void insert(Nodes const& nodes)
+	{
+		if (!AVDECC_ASSERT_WITH_RET(!nodes.empty(), "Nodes should not be empty"))
+		{
+			return;
+		}
+
+		auto const entityID = nodes.front()->entityID();
+
+		auto item = std::make_unique<Item>();
+		item->entityID = entityID;
+		item->nodes.assign(std::begin(nodes), std::end(nodes));
+		item->priority = static_cast<std::uint32_t>(_random());
+		update(item.get());
+
+		for (auto offset = 0u; offset < nodes.size(); ++offset)
+		{
+			_locations[nodes[offset]] = Location{ entityID, static_cast<int>(offset) };
+		}
+
+		auto [left, right] = split(std::move(_root), entityID, false);
+		auto const first = std::next(std::begin(_sections), total(left.get()));
+		_sections.insert(first, std::begin(nodes), std::end(nodes));
+		_root = merge(merge(std::move(left), std::move(item)), std::move(right));
+	}
+
+	// Removes all the nodes of an entity
+	void remove(la::avdecc::UniqueIdentifier const& entityID)
+	{
+		auto [left, others] = split(std::move(_root), entityID, false);
+		auto [middle, right] = split(std::move(others), entityID, true);
+
+		if (middle)
+		{
+			for (auto const* node : middle->nodes)
+			{
+				_locations.erase(node);
+			}
+			auto const first = std::next(std::begin(_sections), total(left.get()));
+			_sections.erase(first, std::next(first, total(middle.get())));
+		}
+
+		_root = merge(std::move(left), std::move(right));
+	}
+
+	// Returns the section of node, -1 if not found
+	int indexOf(Node const* const node) const noexcept
+	{
+		auto const it = _locations.find(node);
+		if (it == std::end(_locations))
+		{
+			return -1;
+		}
+		return entitySection(it->second.entityID) + it->second.offset;
+	}
+
+	// Returns the node at section, nullptr if not found
+	Node* at(std::size_t const section) const noexcept
+	{
+		if (section >= _sections.size())
+		{
+			return nullptr;
+		}
+		return _sections[section];
+	}
+
+	Node* operator[](std::size_t const section) const noexcept
+	{
+		return at(section);
+	}
+
+private:
+	struct Item
+	{
+		la::avdecc::UniqueIdentifier entityID{};
+		std::vector<Node*> nodes{};
+		std::uint32_t priority{ 0u };
+		int sum{ 0 }; // Section count of the whole subtree
+		std::unique_ptr<Item> left{};
+		std::unique_ptr<Item> right{};
+
+		int count() const noexcept
+		{
+			return static_cast<int>(nodes.size());
+		}
+	};
+	using ItemPtr = std::unique_ptr<Item>;
+
+	struct Location
+	{
+		la::avdecc::UniqueIdentifier entityID{};
+		int offset{ 0 }; // Offset of the node within its entity
+	};
+
+	static int total(Item const* const item) noexcept
+	{
+		return item ? item->sum : 0;
+	}
+
+	static void update(Item* const item) noexcept
+	{
+		item->sum = total(item->left.get()) + item->count() + total(item->right.get());
+	}
+
+	// Splits the tree in items < entityID (or <= entityID if inclusive) and the others
+	static std::pair<ItemPtr, ItemPtr> split(ItemPtr item, la::avdecc::UniqueIdentifier const& entityID, bool const inclusive) noexcept
+	{
+		if (!item)
+		{
+			return {};
+		}
+
+		auto const goesLeft = inclusive ? !(entityID < item->entityID) : (item->entityID < entityID);
+		if (goesLeft)
+		{
+			auto [left, right] = split(std::move(item->right), entityID, inclusive);
+			item->right = std::move(left);
+			update(item.get());
+			return std::make_pair(std::move(item), std::move(right));
+		}
+
+		auto [left, right] = split(std::move(item->left), entityID, inclusive);
+		item->left = std::move(right);
+		update(item.get());
+		return std::make_pair(std::move(left), std::move(item));
+	}
+
+	// Merges two trees, all items of left being ordered before the ones of right
+	static ItemPtr merge(ItemPtr left, ItemPtr right) noexcept
+	{
+		if (!left)
+		{
+			return right;
+		}
+		if (!right)
+		{
+			return left;
+		}
+
+		if (left->priority > right->priority)
+		{
+			left->right = merge(std::move(left->right), std::move(right));
+			update(left.get());
+			return left;
+		}
+
+		right->left = merge(std::move(left), std::move(right->left));
+		update(right.get());
+		return right;
+	}
+
+	ItemPtr _root{};
+	std::unordered_map<Node const*, Location> _locations{};
+	std::vector<Node*> _sections{}; // Flat section to node lookup, kept in sync with the tree
+	std::minstd_rand _random{};
+};
+
+// Compact intersection storage, only what is required to paint an intersection (talker and listener are deduced from the sections)
+struct IntersectionCell
+{
+	std::uint8_t type{ 0u };
+	std::uint8_t state{ 0u };
+	std::uint8_t flags{ 0u };
+	bool computed{ false }; // Intersection data is only computed the first time it's requested
+};
+
+// Talker major intersection cells matrix, a row is only allocated when one of its intersections is first computed (so inserting sections never costs talkers x listeners)
+using IntersectionCells = std::deque<std::deque<IntersectionCell>>;
+
+// Intersection data that is only stored for the few intersections actually using it
+struct IntersectionExtraData
+{
+	std::vector<Model::IntersectionData::SmartConnectableStream> smartConnectableStreams{};
+#if ENABLE_CONNECTION_MATRIX_HIGHLIGHT_DATA_CHANGED
+	QVariantAnimation* animation{ nullptr };
+#endif
+};
+
+// Unique intersection identifier (talker node, listener node), stable when sections are inserted or removed
+using IntersectionKey = std::pair<Node const*, Node const*>;
+
+struct IntersectionKeyHash
+{
+	std::size_t operator()(IntersectionKey const& key) const
+	{
+		return std::hash<Node const*>()(key.first) ^ (std::hash<Node const*>()(key.second) << 1);
+	}
+};
+
+// IntersectionExtraData by IntersectionKey
+using IntersectionExtraDataMap = std::unordered_map<IntersectionKey, IntersectionExtraData, IntersectionKeyHash>;
+
+// Flattened nodes and intersection cache of a mode
+struct ModeLayout
+{
+	SectionIndex talkerNodes{};
+	SectionIndex listenerNodes{};
+	IntersectionCells intersectionCells{};
+	IntersectionExtraDataMap intersectionExtraData{};
+};
 
-// Section by Node
-using NodeSectionMap = std::unordered_map<Node const*, int>;
+// Packs IntersectionData::Flags into a byte
+std::uint8_t packFlags(Model::IntersectionData::Flags const& flags)
+{
+	return static_cast<std::uint8_t>(flags.value());
+}
+
+// Unpacks IntersectionData::Flags from a byte
+Model::IntersectionData::Flags unpackFlags(std::uint8_t const value)
+{
+	auto flags = Model::IntersectionData::Flags{};
+	for (auto const flag : { Model::IntersectionData::Flag::InterfaceDown, Model::IntersectionData::Flag::WrongDomain, Model::IntersectionData::Flag::WrongFormat })
+	{
+		if ((value & la::avdecc::utils::to_integral(flag)) != 0u)
+		{
+			flags.set(flag);
+		}
+	}
+	return flags;
+}
 
 #if ENABLE_CONNECTION_MATRIX_TOOLTIP
 
@@ -193,7 +711,8 @@ QString intersectionDataToString(Model::IntersectionData const& intersectionData
 #endif
 
 // Visit node according to mode
-void accept(Node* node, Model::Mode const mode, Node::Visitor const& visitor, bool const childrenOnly = false)
+template<typename VisitorType>
+void accept(Node* node, Model::Mode const mode, VisitorType const& visitor, bool const childrenOnly = false)
 {
 	if (!AVDECC_ASSERT_WITH_RET(node, "Node should not be null"))
 	{
@@ -268,26 +787,69 @@ void removeStreamNodes(StreamNodeMap& map, Node* node)
 		});
 }
 
-// Insert channel nodes in map
-void insertChannelNodes(ChannelNodeMap& map, Node* node)
+// Insert stream nodes in grandmaster index
+void insertGrandMasterStreamNodes(GrandMasterStreamNodes& index, Node* node)
 {
-	node->accept<Node::ChannelPolicy>(
-		[&map](Node* node)
+	node->accept<Node::StreamPolicy>(
+		[&index](Node* node)
 		{
-			auto const key = makeChannelKey(node);
-			if (key != InvalidChannelKey)
-			{
-				auto const& [it, result] = map.insert(std::make_pair(key, static_cast<ChannelNode*>(node)));
-				AVDECC_ASSERT_WITH_RET(result, "Trying to insert the same key twice in the same map");
-			}
+			auto* streamNode = static_cast<StreamNode*>(node);
+			index[streamNode->grandMasterID()].insert(streamNode);
 		});
 }
 
-// Remove channel nodes from map
-void removeChannelNodes(ChannelNodeMap& map, Node* node)
+// Remove stream nodes from grandmaster index
+void removeGrandMasterStreamNodes(GrandMasterStreamNodes& index, Node* node)
 {
-	node->accept<Node::ChannelPolicy>(
-		[&map](Node* node)
+	node->accept<Node::StreamPolicy>(
+		[&index](Node* node)
+		{
+			auto* streamNode = static_cast<StreamNode*>(node);
+			auto const it = index.find(streamNode->grandMasterID());
+			if (AVDECC_ASSERT_WITH_RET(it != std::end(index) && it->second.erase(streamNode) == 1, "Trying to erase a node that is not in the index"))
+			{
+				if (it->second.empty())
+				{
+					index.erase(it);
+				}
+			}
+		});
+}
+
+// Move a stream node in grandmaster index, after its grandmaster changed from previousGrandMasterID
+void moveGrandMasterStreamNode(GrandMasterStreamNodes& index, StreamNode* node, la::avdecc::UniqueIdentifier const& previousGrandMasterID)
+{
+	if (auto const it = index.find(previousGrandMasterID); it != std::end(index))
+	{
+		it->second.erase(node);
+		if (it->second.empty())
+		{
+			index.erase(it);
+		}
+	}
+	index[node->grandMasterID()].insert(node);
+}
+
+// Insert channel nodes in map
+void insertChannelNodes(ChannelNodeMap& map, Node* node)
+{
+	node->accept<Node::ChannelPolicy>(
+		[&map](Node* node)
+		{
+			auto const key = makeChannelKey(node);
+			if (key != InvalidChannelKey)
+			{
+				auto const& [it, result] = map.insert(std::make_pair(key, static_cast<ChannelNode*>(node)));
+				AVDECC_ASSERT_WITH_RET(result, "Trying to insert the same key twice in the same map");
+			}
+		});
+}
+
+// Remove channel nodes from map
+void removeChannelNodes(ChannelNodeMap& map, Node* node)
+{
+	node->accept<Node::ChannelPolicy>(
+		[&map](Node* node)
 		{
 			auto const key = makeChannelKey(node);
 			auto const it = map.find(key);
@@ -317,96 +879,25 @@ Nodes flattenEntityNode(Node* node, Model::Mode const mode)
 	return nodes;
 }
 
-// Insert nodes in list, starting a first index
-void insertNodes(Nodes& list, Nodes const& nodes, int first)
-{
-#if ENABLE_CONNECTION_MATRIX_DEBUG
-	auto const before = list.size();
-#endif
-
-	auto const it = std::next(std::begin(list), first);
-	list.insert(it, std::begin(nodes), std::end(nodes));
-
-#if ENABLE_CONNECTION_MATRIX_DEBUG
-	auto const after = list.size();
-	qDebug() << "insertNodes" << before << ">" << after;
-#endif
-}
-
-// Removes [first, last] items from list
-void removeNodes(Nodes& list, int first, int last)
-{
-	auto const from = std::next(std::begin(list), first);
-	auto const to = std::next(std::begin(list), last);
-
-	if (!AVDECC_ASSERT_WITH_RET(from < to, "'from' should be < to 'to'"))
-	{
-		return;
-	}
-
-#if ENABLE_CONNECTION_MATRIX_DEBUG
-	auto const before = list.size();
-#endif
-
-	list.erase(from, to);
-
-#if ENABLE_CONNECTION_MATRIX_DEBUG
-	auto const after = list.size();
-	qDebug() << "removeNodes" << before << ">" << after;
-#endif
-}
-
-
-// Returns the index where entity should be inserted to keep a sorted list by entityID
-int sortedIndexForEntity(Nodes const& list, la::avdecc::UniqueIdentifier const& entityID)
+// Sorts entity nodes by entityID, the order entities are displayed in the model
+void sortByEntityID(std::vector<EntityNode*>& nodes)
 {
-	auto index = 0;
-	for (auto const* node : list)
-	{
-		if (node->entityID() > entityID)
+	std::sort(std::begin(nodes), std::end(nodes),
+		[](EntityNode const* const lhs, EntityNode const* const rhs)
 		{
-			break;
-		}
-		++index;
-	}
-	return index;
-}
-
-// Build and returns a NodeSectionMap from nodes (quick access map for nodes)
-NodeSectionMap buildNodeSectionMap(Nodes const& nodes)
-{
-	NodeSectionMap sectionMap;
-
-	for (auto section = 0u; section < nodes.size(); ++section)
-	{
-		auto* node = nodes[section];
-		sectionMap.insert(std::make_pair(node, section));
-	}
-
-	return sectionMap;
+			return lhs->entityID() < rhs->entityID();
+		});
 }
 
-// Return the index of a node contained in a NodeSectionMap
-int indexOf(NodeSectionMap const& map, Node const* const node)
+// Return the section of a node contained in a SectionIndex
+int indexOf(SectionIndex const& sections, Node const* const node)
 {
-	auto const it = map.find(node);
-	if (!AVDECC_ASSERT_WITH_RET(it != std::end(map), "Index not found"))
+	auto const section = sections.indexOf(node);
+	if (!AVDECC_ASSERT_WITH_RET(section != -1, "Index not found"))
 	{
 		return -1;
 	}
-	return it->second;
-}
-
-// Returns cluster channel name.
-// It is assumed that if channel == 0, the channel is not displayed
-QString clusterChannelName(QString const& clusterName, std::uint16_t const channel)
-{
-	if (channel > 0)
-	{
-		return QString{ "%1.%2" }.arg(clusterName).arg(channel);
-	}
-
-	return clusterName;
+	return section;
 }
 
 } // namespace priv
@@ -415,14 +906,15 @@ class ModelPrivate : public QObject
 {
 	Q_OBJECT
 public:
-	ModelPrivate(Model* q)
-		: q_ptr{ q }
+	ModelPrivate()
 	{
 		auto& controllerManager = avdecc::ControllerManager::getInstance();
 		// Common signals
 		connect(&controllerManager, &avdecc::ControllerManager::controllerOffline, this, &ModelPrivate::handleControllerOffline);
-		connect(&controllerManager, &avdecc::ControllerManager::entityOnline, this, &ModelPrivate::handleEntityOnline);
-		connect(&controllerManager, &avdecc::ControllerManager::entityOffline, this, &ModelPrivate::handleEntityOffline);
+		connect(&controllerManager, &avdecc::ControllerManager::entitiesOnline, this, &ModelPrivate::handleEntitiesOnline);
+		connect(&controllerManager, &avdecc::ControllerManager::entitiesOffline, this, &ModelPrivate::handleEntitiesOffline);
+		connect(&controllerManager, &avdecc::ControllerManager::entitiesRebooting, this, &ModelPrivate::handleEntitiesRebooting);
+		connect(&controllerManager, &avdecc::ControllerManager::entitiesRestored, this, &ModelPrivate::handleEntitiesRestored);
 		connect(&controllerManager, &avdecc::ControllerManager::gptpChanged, this, &ModelPrivate::handleGptpChanged);
 		connect(&controllerManager, &avdecc::ControllerManager::entityNameChanged, this, &ModelPrivate::handleEntityNameChanged);
 		connect(&controllerManager, &avdecc::ControllerManager::avbInterfaceLinkStatusChanged, this, &ModelPrivate::handleAvbInterfaceLinkStatusChanged);
@@ -430,8 +922,8 @@ public:
 		connect(&controllerManager, &avdecc::ControllerManager::streamRunningChanged, this, &ModelPrivate::handleStreamRunningChanged);
 		connect(&controllerManager, &avdecc::ControllerManager::streamConnectionChanged, this, &ModelPrivate::handleStreamConnectionChanged);
 		connect(&controllerManager, &avdecc::ControllerManager::streamDynamicInfoChanged, this, &ModelPrivate::handleStreamDynamicInfoChanged);
-		connect(&controllerManager, &avdecc::ControllerManager::streamInputCountersChanged, this, &ModelPrivate::handleStreamInputCountersChanged);
-		connect(&controllerManager, &avdecc::ControllerManager::streamOutputCountersChanged, this, &ModelPrivate::handleStreamOutputCountersChanged);
+		connect(&controllerManager, &avdecc::ControllerManager::streamInputMediaLockedChanged, this, &ModelPrivate::handleStreamInputMediaLockedChanged);
+		connect(&controllerManager, &avdecc::ControllerManager::streamOutputStartedChanged, this, &ModelPrivate::handleStreamOutputStartedChanged);
 		connect(&controllerManager, &avdecc::ControllerManager::streamPortAudioMappingsChanged, this, &ModelPrivate::handleStreamPortAudioMappingsChanged);
 
 		// Stream Mode specific signals
@@ -442,18 +934,73 @@ public:
 		connect(&controllerManager, &avdecc::ControllerManager::audioClusterNameChanged, this, &ModelPrivate::handleAudioClusterNameChanged);
 
 		auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
-		connect(&channelConnectionManager, &avdecc::ChannelConnectionManager::listenerChannelConnectionsUpdate, this, &ModelPrivate::handleListenerChannelConnectionsUpdate);
+		connect(&channelConnectionManager, &avdecc::ChannelConnectionManager::listenerClusterSpansUpdate, this, &ModelPrivate::handleListenerClusterSpansUpdate);
+
+		_memoryProbe = avdecc::MemoryAccounting::getInstance().registerProbe("ConnectionMatrix",
+			[this](avdecc::MemoryAccounting::Counters& counters)
+			{
+				counters.push_back({ "EntityNodes", _talkerNodeMap.size() + _listenerNodeMap.size() });
+				counters.push_back({ "StreamNodes", _talkerStreamNodeMap.size() + _listenerStreamNodeMap.size() });
+				counters.push_back({ "ChannelNodes", _talkerChannelNodeMap.size() + _listenerChannelNodeMap.size() });
+				counters.push_back({ "Sections", _talkerNodes.size() + _listenerNodes.size() + _inactiveLayout.talkerNodes.size() + _inactiveLayout.listenerNodes.size() });
+				counters.push_back({ "IntersectionCells", countIntersectionCells(_intersectionCells) + countIntersectionCells(_inactiveLayout.intersectionCells) });
+				counters.push_back({ "IntersectionExtraData", _intersectionExtraData.size() + _inactiveLayout.intersectionExtraData.size() });
+				counters.push_back({ "Animations", countAnimations(_intersectionExtraData) + countAnimations(_inactiveLayout.intersectionExtraData) });
+				counters.push_back({ "DirtyIntersections", _dirtyIntersections.size() });
+			});
+
+		// Changed intersections are merged into rectangles, so they are always notified all at once
+		_frameClientID = FrameScheduler::getInstance().registerClient(FrameScheduler::Order::ConnectionMatrix,
+			[this](FrameScheduler::Clock::time_point const /*deadline*/)
+			{
+				flushDirtyIntersections();
+				return true;
+			});
+	}
+
+	~ModelPrivate()
+	{
+		FrameScheduler::getInstance().unregisterClient(_frameClientID);
+		avdecc::MemoryAccounting::getInstance().unregisterProbe(_memoryProbe);
+	}
+
+	// Allocated cells (rows are only allocated when first used)
+	static std::uint64_t countIntersectionCells(priv::IntersectionCells const& cells) noexcept
+	{
+		auto count = std::uint64_t{ 0u };
+		for (auto const& row : cells)
+		{
+			count += row.size();
+		}
+		return count;
+	}
+
+	// Running highlight animations, always 0 when ENABLE_CONNECTION_MATRIX_HIGHLIGHT_DATA_CHANGED is disabled
+	static std::uint64_t countAnimations([[maybe_unused]] priv::IntersectionExtraDataMap const& extraData) noexcept
+	{
+		auto count = std::uint64_t{ 0u };
+#if ENABLE_CONNECTION_MATRIX_HIGHLIGHT_DATA_CHANGED
+		for (auto const& [key, data] : extraData)
+		{
+			if (data.animation)
+			{
+				++count;
+			}
+		}
+#endif
+		return count;
 	}
 
 #if ENABLE_CONNECTION_MATRIX_DEBUG
 	void dump() const
 	{
-		auto const rows = _intersectionData.size();
-		auto const columns = rows > 0 ? _intersectionData[0].size() : 0u;
+		auto const rows = _intersectionCells.size();
+		auto const columns = _listenerNodes.size();
 
 		qDebug() << "talkers" << _talkerNodes.size();
 		qDebug() << "listeners" << _listenerNodes.size();
 		qDebug() << "intersections" << rows << "x" << columns;
+		qDebug() << "intersections extra data" << _intersectionExtraData.size();
 	}
 #endif
 
@@ -465,219 +1012,535 @@ public:
 			return;
 		}
 
-		auto& intersectionData = _intersectionData[talkerSection][listenerSection];
+		auto& extraData = _intersectionExtraData[intersectionKey(talkerSection, listenerSection)];
 
-		if (!intersectionData.animation)
+		if (!extraData.animation)
 		{
-			intersectionData.animation = new QVariantAnimation{ this };
+			extraData.animation = new QVariantAnimation{ this };
 		}
 
-		intersectionData.animation->setStartValue(qt::toolkit::material::color::value(qt::toolkit::material::color::Name::Red));
-		intersectionData.animation->setEndValue(QColor{ Qt::transparent });
-		intersectionData.animation->setDuration(1000);
-		intersectionData.animation->start();
+		extraData.animation->setStartValue(qt::toolkit::material::color::value(qt::toolkit::material::color::Name::Red));
+		extraData.animation->setEndValue(QColor{ Qt::transparent });
+		extraData.animation->setDuration(1000);
+		extraData.animation->start();
 
-		connect(intersectionData.animation, &QVariantAnimation::valueChanged,
+		connect(extraData.animation, &QVariantAnimation::valueChanged,
 			[this, talkerSection, listenerSection](QVariant const& /*value*/)
 			{
-				Q_Q(Model);
-				auto const index = q->index(talkerSection, listenerSection);
-				emit q->dataChanged(index, index);
+				notifyFaces(
+					[talkerSection, listenerSection](Face const& face)
+					{
+						auto const index = createIndex(face, talkerSection, listenerSection);
+						emit face.model->dataChanged(index, index);
+					});
 			});
 	}
 #endif
 
-	// Notification wrappers
+	// Faces (models displaying this core)
 
-	void beginInsertTalkerItems(int first, int last)
+	struct Face
 	{
-		Q_Q(Model);
-
-#if ENABLE_CONNECTION_MATRIX_DEBUG
-		qDebug() << "beginInsertTalkerItems(" << first << "," << last << ")";
-#endif
+		Model* model{ nullptr };
+		Model::Mode mode{ Model::Mode::Stream };
+		bool transposed{ false };
+		bool isActive{ true };
+	};
 
-		if (!_transposed)
-		{
-			emit q->beginInsertRows({}, first, last);
-		}
-		else
-		{
-			emit q->beginInsertColumns({}, first, last);
-		}
+	void attachFace(Model* const model, Model::Mode const mode, bool const transposed)
+	{
+		_faces.push_back(Face{ model, mode, transposed, true });
 	}
 
-	void endInsertTalkerItems()
+	void detachFace(Model const* const model)
 	{
-		Q_Q(Model);
+		_faces.erase(std::remove_if(std::begin(_faces), std::end(_faces),
+									 [model](auto const& face)
+									 {
+										 return face.model == model;
+									 }),
+			std::end(_faces));
 
-		if (!_transposed)
+		// The main caches must hold a displayed layout, so the remaining faces are precisely notified
+		if (!_faces.empty() && !isModeDisplayed(_mode))
 		{
-			emit q->endInsertRows();
-		}
-		else
-		{
-			emit q->endInsertColumns();
+			_mode = _faces.front().mode;
+			_dirtyIntersections.clear();
+			swapLayouts();
 		}
+
+		updateActiveState();
 	}
 
-	void beginRemoveTalkerItems(int first, int last)
+	Face& face(Model const* const model)
 	{
-		Q_Q(Model);
+		auto const it = std::find_if(std::begin(_faces), std::end(_faces),
+			[model](auto const& face)
+			{
+				return face.model == model;
+			});
+		AVDECC_ASSERT(it != std::end(_faces), "Model is not a face of this core");
+		return *it;
+	}
 
-#if ENABLE_CONNECTION_MATRIX_DEBUG
-		qDebug() << "beginRemoveTalkerItems(" << first << "," << last << ")";
-#endif
+	Face const& face(Model const* const model) const
+	{
+		return const_cast<ModelPrivate*>(this)->face(model);
+	}
 
-		if (!_transposed)
-		{
-			emit q->beginRemoveRows({}, first, last);
-		}
-		else
-		{
-			emit q->beginRemoveColumns({}, first, last);
-		}
+	bool isModeDisplayed(Model::Mode const mode) const noexcept
+	{
+		return std::any_of(std::begin(_faces), std::end(_faces),
+			[mode](auto const& face)
+			{
+				return face.mode == mode;
+			});
 	}
 
-	void endRemoveTalkerItems()
+	bool hasInactiveModeFaces() const noexcept
 	{
-		Q_Q(Model);
+		return isModeDisplayed(inactiveMode());
+	}
 
-		if (!_transposed)
-		{
-			emit q->endRemoveRows();
-		}
-		else
+	// Changes the mode displayed by a face, the main caches being swapped with the inactive layout when this face was the last one displaying them
+	void setFaceMode(Face& face, Model::Mode const mode)
+	{
+		face.mode = mode;
+
+		if (mode != _mode && !isModeDisplayed(_mode))
 		{
-			emit q->endRemoveColumns();
+			// Both layouts are kept up-to-date, the one of the requested mode only has to be swapped in (including its already computed intersections)
+			_mode = mode;
+			_dirtyIntersections.clear();
+			swapLayouts();
 		}
 	}
 
-	void beginInsertListenerItems(int first, int last)
+	// The controller events are processed as long as at least one face is active
+	void setFaceActive(Face& face, bool const isActive)
 	{
-		Q_Q(Model);
+		face.isActive = isActive;
+		updateActiveState();
+	}
 
-#if ENABLE_CONNECTION_MATRIX_DEBUG
-		qDebug() << "beginInsertListenerItems(" << first << "," << last << ")";
-#endif
+	void updateActiveState()
+	{
+		setActive(std::any_of(std::begin(_faces), std::end(_faces),
+			[](auto const& face)
+			{
+				return face.isActive;
+			}));
+	}
 
-		if (!_transposed)
-		{
-			emit q->beginInsertColumns({}, first, last);
-		}
-		else
+	// Runs handler with the layout of the specified mode temporarily swapped in the main caches, so faces displaying the inactive mode are served by the same code
+	// Swapping the caches is not a logical change of the core, hence the const qualifier
+	template<typename Handler>
+	auto withModeLayout(Model::Mode const mode, Handler const& handler) const
+	{
+		if (mode == _mode)
 		{
-			emit q->beginInsertRows({}, first, last);
+			return handler();
 		}
+
+		auto* const self = const_cast<ModelPrivate*>(this);
+		auto const currentMode = _mode;
+		self->swapLayouts();
+		self->_mode = mode;
+		auto result = handler();
+		self->_mode = currentMode;
+		self->swapLayouts();
+		return result;
 	}
 
-	void endInsertListenerItems()
+	// Calls handler for each face displaying the main caches (which are precisely notified), the other faces being refreshed at once when the event loop is reached
+	template<typename Handler>
+	void notifyFaces(Handler const& handler)
 	{
-		Q_Q(Model);
-
-		if (!_transposed)
-		{
-			emit q->endInsertColumns();
-		}
-		else
+		for (auto const& face : _faces)
 		{
-			emit q->endInsertRows();
+			if (face.mode == _mode)
+			{
+				handler(face);
+			}
 		}
+
+		scheduleInactiveFacesUpdate();
 	}
 
-	void beginRemoveListenerItems(int first, int last)
+	// Faces displaying the inactive mode are not notified for each change, they are just entirely refreshed (intersections being lazily computed, only the displayed ones are)
+	void scheduleInactiveFacesUpdate()
 	{
-		Q_Q(Model);
-
-#if ENABLE_CONNECTION_MATRIX_DEBUG
-		qDebug() << "beginRemoveListenerItems(" << first << "," << last << ")";
-#endif
-
-		if (!_transposed)
-		{
-			emit q->beginRemoveColumns({}, first, last);
-		}
-		else
+		if (_inactiveFacesUpdateScheduled || !hasInactiveModeFaces())
 		{
-			emit q->beginRemoveRows({}, first, last);
+			return;
 		}
+
+		_inactiveFacesUpdateScheduled = true;
+		QMetaObject::invokeMethod(
+			this,
+			[this]()
+			{
+				_inactiveFacesUpdateScheduled = false;
+				for (auto const& face : _faces)
+				{
+					if (face.mode == _mode)
+					{
+						continue;
+					}
+
+					auto* const model = face.model;
+					auto const rows = model->rowCount();
+					auto const columns = model->columnCount();
+					if (rows > 0 && columns > 0)
+					{
+						emit model->dataChanged(model->index(0, 0), model->index(rows - 1, columns - 1));
+					}
+					if (rows > 0)
+					{
+						emit model->headerDataChanged(Qt::Vertical, 0, rows - 1);
+					}
+					if (columns > 0)
+					{
+						emit model->headerDataChanged(Qt::Horizontal, 0, columns - 1);
+					}
+				}
+			},
+			Qt::QueuedConnection);
 	}
 
-	void endRemoveListenerItems()
+	// Structural changes of the inactive layout reset the faces displaying it
+	void beginResetInactiveFaces()
 	{
-		Q_Q(Model);
-
-		if (!_transposed)
+		for (auto const& face : _faces)
 		{
-			emit q->endRemoveColumns();
+			if (face.mode != _mode)
+			{
+				emit face.model->beginResetModel();
+			}
 		}
-		else
+	}
+
+	void endResetInactiveFaces()
+	{
+		for (auto const& face : _faces)
 		{
-			emit q->endRemoveRows();
+			if (face.mode != _mode)
+			{
+				emit face.model->endResetModel();
+			}
 		}
 	}
 
-	enum class HeaderDirtyFlag
+	void beginResetFaces()
 	{
-		UpdateLockedState = 1u << 0, /**< Update the Stream Locked State (Stream Input only), or the summary if this is a parent node */
-		UpdateIsStreaming = 1u << 1, /**<  Update the Is Streaming State (Stream Output only), or the summary if this is a parent node */
-	};
-	using HeaderDirtyFlags = la::avdecc::utils::EnumBitfield<HeaderDirtyFlag>;
+		for (auto const& face : _faces)
+		{
+			emit face.model->beginResetModel();
+		}
+	}
 
-	enum class IntersectionDirtyFlag
+	void endResetFaces()
 	{
-		UpdateConnected = 1u << 0, /**< Update the connected status, or the summary if this is a parent node */
-		UpdateFormat = 1u << 1, /**<  Update the matching format status, or the summary if this is a parent node */
-		UpdateGptp = 1u << 2, /**< Update the matching gPTP status, or the summary if this is a parent node (WARNING: For intersection of redundant and non-redundant, the complete checks has to be done, since format compatibility is not checked if GM is not the same) */
-		UpdateLinkStatus = 1u << 3, /**< Update the link status, or the summary if this is a parent node */
-	};
-	using IntersectionDirtyFlags = la::avdecc::utils::EnumBitfield<IntersectionDirtyFlag>;
+		for (auto const& face : _faces)
+		{
+			emit face.model->endResetModel();
+		}
+	}
 
-	// Returns IntersectionDirtyFlags with all available flags set
-	static IntersectionDirtyFlags allIntersectionDirtyFlags()
+	// Marks an intersection as changed, dataChanged is emitted for all changed intersections at once on the next frame
+	void markIntersectionDirty(int const talkerSection, int const listenerSection)
 	{
-		auto flags = IntersectionDirtyFlags{};
-		flags.set(IntersectionDirtyFlag::UpdateConnected);
-		flags.set(IntersectionDirtyFlag::UpdateFormat);
-		flags.set(IntersectionDirtyFlag::UpdateGptp);
-		flags.set(IntersectionDirtyFlag::UpdateLinkStatus);
-		return flags;
+		_dirtyIntersections.emplace(talkerSection, listenerSection);
+		FrameScheduler::getInstance().requestFlush(_frameClientID);
 	}
 
-	// Determines intersection type according to talker and listener nodes
-	Model::IntersectionData::Type determineIntersectionType(Node* talker, Node* listener) const
+	// Emits dataChanged for all pending changed intersections, merged into as few rectangles as possible
+	void flushDirtyIntersections()
 	{
-		if (!AVDECC_ASSERT_WITH_RET(talker, "Invalid talker") || !AVDECC_ASSERT_WITH_RET(listener, "Invalid listener"))
-		{
-			return Model::IntersectionData::Type::None;
-		}
-
-		if (talker->entityID() == listener->entityID())
+		if (_dirtyIntersections.empty())
 		{
-			return Model::IntersectionData::Type::None;
+			return;
 		}
 
-		auto const talkerType = talker->type();
-		auto const listenerType = listener->type();
+		// Sorted by talker section then listener section (transposed for the faces that need it, once merged)
+		auto cells = std::vector<std::pair<int, int>>{ std::begin(_dirtyIntersections), std::end(_dirtyIntersections) };
+		_dirtyIntersections.clear();
 
-		if (talkerType == Node::Type::Entity && listenerType == Node::Type::Entity)
+		// Build runs of consecutive columns for each row, and extend the rectangle of the previous row when it has the exact same run
+		struct Rect
 		{
-			return Model::IntersectionData::Type::Entity_Entity;
-		}
-
-		if (talkerType == Node::Type::Entity || listenerType == Node::Type::Entity)
+			int top{ 0 };
+			int left{ 0 };
+			int bottom{ 0 };
+			int right{ 0 };
+		};
+		auto rects = std::vector<Rect>{};
+		auto previousRowRects = std::map<std::pair<int, int>, std::size_t>{};
+		auto currentRowRects = std::map<std::pair<int, int>, std::size_t>{};
+		auto const count = cells.size();
+		auto cellIndex = std::size_t{ 0u };
+		while (cellIndex < count)
 		{
-			if (talkerType == Node::Type::RedundantOutput || listenerType == Node::Type::RedundantInput)
-			{
-				return Model::IntersectionData::Type::Entity_Redundant;
-			}
+			auto const row = cells[cellIndex].first;
+			currentRowRects.clear();
 
-			if (talkerType == Node::Type::RedundantOutputStream || listenerType == Node::Type::RedundantInputStream)
+			while (cellIndex < count && cells[cellIndex].first == row)
 			{
-				return Model::IntersectionData::Type::Entity_RedundantStream;
+				auto const left = cells[cellIndex].second;
+				auto right = left;
+				++cellIndex;
+				while (cellIndex < count && cells[cellIndex].first == row && cells[cellIndex].second == right + 1)
+				{
+					++right;
+					++cellIndex;
+				}
+
+				auto const run = std::make_pair(left, right);
+				auto const previousIt = previousRowRects.find(run);
+				if (previousIt != std::end(previousRowRects) && rects[previousIt->second].bottom == row - 1)
+				{
+					rects[previousIt->second].bottom = row;
+					currentRowRects.emplace(run, previousIt->second);
+				}
+				else
+				{
+					currentRowRects.emplace(run, rects.size());
+					rects.push_back(Rect{ row, left, row, right });
+				}
 			}
 
-			if (talkerType == Node::Type::OutputStream || listenerType == Node::Type::InputStream)
+			std::swap(previousRowRects, currentRowRects);
+		}
+
+		notifyFaces(
+			[&rects](Face const& face)
+			{
+				for (auto const& rect : rects)
+				{
+					emit face.model->dataChanged(createIndex(face, rect.top, rect.left), createIndex(face, rect.bottom, rect.right));
+				}
+			});
+	}
+
+	// Notification wrappers
+
+	void beginInsertTalkerItems(int first, int last)
+	{
+		// Notify pending changes while sections are still valid
+		flushDirtyIntersections();
+
+#if ENABLE_CONNECTION_MATRIX_DEBUG
+		qDebug() << "beginInsertTalkerItems(" << first << "," << last << ")";
+#endif
+
+		notifyFaces(
+			[first, last](Face const& face)
+			{
+				if (!face.transposed)
+				{
+					emit face.model->beginInsertRows({}, first, last);
+				}
+				else
+				{
+					emit face.model->beginInsertColumns({}, first, last);
+				}
+			});
+	}
+
+	void endInsertTalkerItems()
+	{
+		notifyFaces(
+			[](Face const& face)
+			{
+				if (!face.transposed)
+				{
+					emit face.model->endInsertRows();
+				}
+				else
+				{
+					emit face.model->endInsertColumns();
+				}
+			});
+	}
+
+	void beginRemoveTalkerItems(int first, int last)
+	{
+		// Notify pending changes while sections are still valid
+		flushDirtyIntersections();
+
+#if ENABLE_CONNECTION_MATRIX_DEBUG
+		qDebug() << "beginRemoveTalkerItems(" << first << "," << last << ")";
+#endif
+
+		notifyFaces(
+			[first, last](Face const& face)
+			{
+				if (!face.transposed)
+				{
+					emit face.model->beginRemoveRows({}, first, last);
+				}
+				else
+				{
+					emit face.model->beginRemoveColumns({}, first, last);
+				}
+			});
+	}
+
+	void endRemoveTalkerItems()
+	{
+		notifyFaces(
+			[](Face const& face)
+			{
+				if (!face.transposed)
+				{
+					emit face.model->endRemoveRows();
+				}
+				else
+				{
+					emit face.model->endRemoveColumns();
+				}
+			});
+	}
+
+	void beginInsertListenerItems(int first, int last)
+	{
+		// Notify pending changes while sections are still valid
+		flushDirtyIntersections();
+
+#if ENABLE_CONNECTION_MATRIX_DEBUG
+		qDebug() << "beginInsertListenerItems(" << first << "," << last << ")";
+#endif
+
+		notifyFaces(
+			[first, last](Face const& face)
+			{
+				if (!face.transposed)
+				{
+					emit face.model->beginInsertColumns({}, first, last);
+				}
+				else
+				{
+					emit face.model->beginInsertRows({}, first, last);
+				}
+			});
+	}
+
+	void endInsertListenerItems()
+	{
+		notifyFaces(
+			[](Face const& face)
+			{
+				if (!face.transposed)
+				{
+					emit face.model->endInsertColumns();
+				}
+				else
+				{
+					emit face.model->endInsertRows();
+				}
+			});
+	}
+
+	void beginRemoveListenerItems(int first, int last)
+	{
+		// Notify pending changes while sections are still valid
+		flushDirtyIntersections();
+
+#if ENABLE_CONNECTION_MATRIX_DEBUG
+		qDebug() << "beginRemoveListenerItems(" << first << "," << last << ")";
+#endif
+
+		notifyFaces(
+			[first, last](Face const& face)
+			{
+				if (!face.transposed)
+				{
+					emit face.model->beginRemoveColumns({}, first, last);
+				}
+				else
+				{
+					emit face.model->beginRemoveRows({}, first, last);
+				}
+			});
+	}
+
+	void endRemoveListenerItems()
+	{
+		notifyFaces(
+			[](Face const& face)
+			{
+				if (!face.transposed)
+				{
+					emit face.model->endRemoveColumns();
+				}
+				else
+				{
+					emit face.model->endRemoveRows();
+				}
+			});
+	}
+
+	enum class HeaderDirtyFlag
+	{
+		UpdateLockedState = 1u << 0, /**< Update the Stream Locked State (Stream Input only), or the summary if this is a parent node */
+		UpdateIsStreaming = 1u << 1, /**<  Update the Is Streaming State (Stream Output only), or the summary if this is a parent node */
+	};
+	using HeaderDirtyFlags = la::avdecc::utils::EnumBitfield<HeaderDirtyFlag>;
+
+	enum class IntersectionDirtyFlag
+	{
+		UpdateConnected = 1u << 0, /**< Update the connected status, or the summary if this is a parent node */
+		UpdateFormat = 1u << 1, /**<  Update the matching format status, or the summary if this is a parent node */
+		UpdateGptp = 1u << 2, /**< Update the matching gPTP status, or the summary if this is a parent node (WARNING: For intersection of redundant and non-redundant, the complete checks has to be done, since format compatibility is not checked if GM is not the same) */
+		UpdateLinkStatus = 1u << 3, /**< Update the link status, or the summary if this is a parent node */
+	};
+	using IntersectionDirtyFlags = la::avdecc::utils::EnumBitfield<IntersectionDirtyFlag>;
+
+	// Returns IntersectionDirtyFlags with all available flags set
+	static IntersectionDirtyFlags allIntersectionDirtyFlags()
+	{
+		auto flags = IntersectionDirtyFlags{};
+		flags.set(IntersectionDirtyFlag::UpdateConnected);
+		flags.set(IntersectionDirtyFlag::UpdateFormat);
+		flags.set(IntersectionDirtyFlag::UpdateGptp);
+		flags.set(IntersectionDirtyFlag::UpdateLinkStatus);
+		return flags;
+	}
+
+	// Determines intersection type according to talker and listener nodes
+	Model::IntersectionData::Type determineIntersectionType(Node* talker, Node* listener) const
+	{
+		if (!AVDECC_ASSERT_WITH_RET(talker, "Invalid talker") || !AVDECC_ASSERT_WITH_RET(listener, "Invalid listener"))
+		{
+			return Model::IntersectionData::Type::None;
+		}
+
+		if (talker->entityID() == listener->entityID())
+		{
+			return Model::IntersectionData::Type::None;
+		}
+
+		auto const talkerType = talker->type();
+		auto const listenerType = listener->type();
+
+		if (talkerType == Node::Type::Entity && listenerType == Node::Type::Entity)
+		{
+			return Model::IntersectionData::Type::Entity_Entity;
+		}
+
+		if (talkerType == Node::Type::Entity || listenerType == Node::Type::Entity)
+		{
+			if (talkerType == Node::Type::RedundantOutput || listenerType == Node::Type::RedundantInput)
+			{
+				return Model::IntersectionData::Type::Entity_Redundant;
+			}
+
+			if (talkerType == Node::Type::RedundantOutputStream || listenerType == Node::Type::RedundantInputStream)
+			{
+				return Model::IntersectionData::Type::Entity_RedundantStream;
+			}
+
+			if (talkerType == Node::Type::OutputStream || listenerType == Node::Type::InputStream)
 			{
 				return Model::IntersectionData::Type::Entity_SingleStream;
 			}
@@ -776,34 +1639,8 @@ public:
 					// Nothing to do, for now
 					break;
 				case Node::Type::RedundantInput:
-				{
-					auto summaryLockedState = Node::TriState::Unknown;
-					node->accept(
-						[&summaryLockedState](Node* node)
-						{
-							AVDECC_ASSERT(node->isRedundantStreamNode(), "Should be a RedundantStreamNode");
-							auto const state = static_cast<StreamNode&>(*node).lockedState();
-							switch (state)
-							{
-								case Node::TriState::Unknown: // Don't change summary value if we don't know this state
-									break;
-								case Node::TriState::False: // Summary should display UnLock if at least one node is not Locked
-									summaryLockedState = state;
-									break;
-								case Node::TriState::True: // Summary should display Lock if all nodes are Locked
-									// Only force to False is summary is currently False. If it's True or Unknown, force to True
-									summaryLockedState = (summaryLockedState == Node::TriState::False) ? Node::TriState::False : Node::TriState::True;
-									break;
-								default:
-									AVDECC_ASSERT(false, "Unknown State");
-									break;
-							}
-						},
-						true);
-					AVDECC_ASSERT(node->isRedundantNode(), "Should be a RedundantNode");
-					static_cast<RedundantNode&>(*node).setLockedState(summaryLockedState);
+					// Summary is incrementally updated when a child computes its own state
 					break;
-				}
 				case Node::Type::InputStream:
 				case Node::Type::RedundantInputStream:
 				{
@@ -829,21 +1666,8 @@ public:
 					// Nothing to do, for now
 					break;
 				case Node::Type::RedundantOutput:
-				{
-					auto summaryStreaming = false;
-					node->accept(
-						[&summaryStreaming](Node* node)
-						{
-							AVDECC_ASSERT(node->isRedundantStreamNode(), "Should be a RedundantStreamNode");
-							auto const isStreaming = static_cast<StreamNode&>(*node).isStreaming();
-							// Summary should display as Streaming if at least one node is Streaming
-							summaryStreaming |= isStreaming;
-						},
-						true);
-					AVDECC_ASSERT(node->isRedundantNode(), "Should be a RedundantNode");
-					static_cast<RedundantNode&>(*node).setIsStreaming(summaryStreaming);
+					// Summary is incrementally updated when a child computes its own state
 					break;
-				}
 				case Node::Type::OutputStream:
 				case Node::Type::RedundantOutputStream:
 				{
@@ -864,6 +1688,7 @@ public:
 	// Updates intersection data for the given dirtyFlags
 	void computeIntersectionData(Model::IntersectionData& intersectionData, IntersectionDirtyFlags const dirtyFlags)
 	{
+		HIVE_TRACE_SPAN("connectionMatrix::computeIntersectionData");
 		try
 		{
 			auto const talkerType = intersectionData.talker->type();
@@ -927,9 +1752,7 @@ public:
 						auto const listenerGrandMasterID = listenerStreamNode->grandMasterID();
 						allCompatibleDomain &= talkerGrandMasterID == listenerGrandMasterID;
 
-						auto const talkerStreamFormat = talkerStreamNode->streamFormat();
-						auto const listenerStreamFormat = listenerStreamNode->streamFormat();
-						allCompatibleFormat &= la::avdecc::entity::model::StreamFormatInfo::isListenerFormatCompatibleWithTalkerFormat(listenerStreamFormat, talkerStreamFormat);
+						allCompatibleFormat &= streamFormatCache::isListenerFormatCompatibleWithTalkerFormat(listenerStreamNode->streamFormatID(), talkerStreamNode->streamFormatID());
 
 						intersectionData.smartConnectableStreams.push_back(Model::IntersectionData::SmartConnectableStream{ talkerStreamNode->streamIndex(), listenerStreamNode->streamIndex(), isConnectedToTalker, isFastConnectingToTalker });
 					}
@@ -1018,8 +1841,8 @@ public:
 							AVDECC_ASSERT(redundantStreamNode->isRedundantStreamNode(), "Should be a redundant node");
 							auto connectableStream = Model::IntersectionData::SmartConnectableStream{};
 							auto const* listenerStreamConnectionState = static_cast<la::avdecc::entity::model::StreamConnectionState const*>(nullptr);
-							auto talkerStreamFormat = la::avdecc::entity::model::StreamFormat{};
-							auto listenerStreamFormat = la::avdecc::entity::model::StreamFormat{};
+							auto talkerStreamFormatID = streamFormatCache::NullFormatID;
+							auto listenerStreamFormatID = streamFormatCache::NullFormatID;
 
 							// Get information based on which node is redundant
 							if (talkerType == Node::Type::RedundantOutput)
@@ -1027,16 +1850,16 @@ public:
 								connectableStream.talkerStreamIndex = redundantStreamNode->streamIndex();
 								connectableStream.listenerStreamIndex = nonRedundantStreamNode->streamIndex();
 								listenerStreamConnectionState = &nonRedundantStreamNode->streamConnectionState();
-								talkerStreamFormat = redundantStreamNode->streamFormat();
-								listenerStreamFormat = nonRedundantStreamNode->streamFormat();
+								talkerStreamFormatID = redundantStreamNode->streamFormatID();
+								listenerStreamFormatID = nonRedundantStreamNode->streamFormatID();
 							}
 							else if (listenerType == Node::Type::RedundantInput)
 							{
 								connectableStream.talkerStreamIndex = nonRedundantStreamNode->streamIndex();
 								connectableStream.listenerStreamIndex = redundantStreamNode->streamIndex();
 								listenerStreamConnectionState = &redundantStreamNode->streamConnectionState();
-								talkerStreamFormat = nonRedundantStreamNode->streamFormat();
-								listenerStreamFormat = redundantStreamNode->streamFormat();
+								talkerStreamFormatID = nonRedundantStreamNode->streamFormatID();
+								listenerStreamFormatID = redundantStreamNode->streamFormatID();
 							}
 
 							// Get Connection State
@@ -1047,7 +1870,7 @@ public:
 							fastConnecting |= connectableStream.isFastConnecting;
 
 							// Get Format Compatibility
-							isCompatibleFormat &= la::avdecc::entity::model::StreamFormatInfo::isListenerFormatCompatibleWithTalkerFormat(listenerStreamFormat, talkerStreamFormat);
+							isCompatibleFormat &= streamFormatCache::isListenerFormatCompatibleWithTalkerFormat(listenerStreamFormatID, talkerStreamFormatID);
 
 							// Get Domain Compatibility
 							auto const sameDomain = redundantStreamNode->grandMasterID() == nonRedundantStreamNode->grandMasterID();
@@ -1134,8 +1957,8 @@ public:
 						auto const* const otherStreamNode = redundantNode->childAt(streamNode->index());
 
 						// Get the indexes for the Intersection Data we'll copy data from (Which is a RedundantStream_RedundantStream node)
-						talkerSection = priv::indexOf(_talkerNodeSectionMap, otherStreamNode);
-						listenerSection = priv::indexOf(_listenerNodeSectionMap, streamNode);
+						talkerSection = priv::indexOf(_talkerNodes, otherStreamNode);
+						listenerSection = priv::indexOf(_listenerNodes, streamNode);
 					}
 					else if (listenerType == Node::Type::RedundantInput)
 					{
@@ -1146,8 +1969,8 @@ public:
 						auto const* const otherStreamNode = redundantNode->childAt(streamNode->index());
 
 						// Get the indexes for the Intersection Data we'll copy data from (Which is a RedundantStream_RedundantStream node)
-						talkerSection = priv::indexOf(_talkerNodeSectionMap, streamNode);
-						listenerSection = priv::indexOf(_listenerNodeSectionMap, otherStreamNode);
+						talkerSection = priv::indexOf(_talkerNodes, streamNode);
+						listenerSection = priv::indexOf(_listenerNodes, otherStreamNode);
 					}
 					else
 					{
@@ -1160,7 +1983,7 @@ public:
 					}
 
 					// Get the IntersectionData source node we'll copy the data from
-					auto const& sourceIntersectionData = _intersectionData[talkerSection][listenerSection];
+					auto const sourceIntersectionData = intersectionDataAt(talkerSection, listenerSection);
 					AVDECC_ASSERT(sourceIntersectionData.type == Model::IntersectionData::Type::RedundantStream_RedundantStream, "Intersection should be RedundantStream_RedundantStream");
 
 					intersectionData.state = sourceIntersectionData.state;
@@ -1335,10 +2158,7 @@ public:
 		}
 
 		// WrongFormat
-		auto const talkerStreamFormat = talkerStreamNode->streamFormat();
-		auto const listenerStreamFormat = listenerStreamNode->streamFormat();
-
-		if (la::avdecc::entity::model::StreamFormatInfo::isListenerFormatCompatibleWithTalkerFormat(listenerStreamFormat, talkerStreamFormat))
+		if (streamFormatCache::isListenerFormatCompatibleWithTalkerFormat(listenerStreamNode->streamFormatID(), talkerStreamNode->streamFormatID()))
 		{
 			flags.reset(Model::IntersectionData::Flag::WrongFormat);
 		}
@@ -1350,18 +2170,6 @@ public:
 		return flags;
 	}
 
-	// Cache update helpers
-
-	void rebuildTalkerSectionCache()
-	{
-		_talkerNodeSectionMap = priv::buildNodeSectionMap(_talkerNodes);
-	}
-
-	void rebuildListenerSectionCache()
-	{
-		_listenerNodeSectionMap = priv::buildNodeSectionMap(_listenerNodes);
-	}
-
 	// Build talker node hierarchy
 	EntityNode* buildTalkerNode(la::avdecc::controller::ControlledEntity const& controlledEntity, la::avdecc::UniqueIdentifier const& entityID, la::avdecc::controller::model::ConfigurationNode const& configurationNode)
 	{
@@ -1373,30 +2181,30 @@ public:
 			auto* entity = EntityNode::create(entityID, isMilan);
 			entity->setName(avdecc::helper::smartEntityName(controlledEntity));
 
-			auto const fillStreamOutputNode = [&controlledEntity](auto& node, auto const configurationIndex, auto const streamIndex, auto const avbInterfaceIndex, auto const& streamOutputNode, auto const& avbInterfaceNode)
+			// Static data shared with the entities of the same model
+			auto const entityTemplate = nodeTemplateCache::getTemplate(controlledEntity, configurationNode);
+
+			auto const fillStreamOutputNode = [&controlledEntity, &entityTemplate](auto& node, auto const configurationIndex, auto const streamIndex, auto const avbInterfaceIndex, auto const& streamOutputNode, auto const& avbInterfaceNode)
 			{
 				node.setName(avdecc::helper::outputStreamName(controlledEntity, streamIndex));
 				node.setStreamFormat(streamOutputNode.dynamicModel->streamFormat);
+				if (entityTemplate)
+				{
+					node.setAvailableFormats(entityTemplate->streamOutputFormats.at(streamIndex));
+				}
+				else
+				{
+					node.setAvailableFormats(streamOutputNode.staticModel->formats);
+				}
 				node.setGrandMasterID(avbInterfaceNode.dynamicModel->gptpGrandmasterID);
 				node.setGrandMasterDomain(avbInterfaceNode.dynamicModel->gptpDomainNumber);
 				node.setInterfaceLinkStatus(controlledEntity.getAvbInterfaceLinkStatus(avbInterfaceIndex));
 				node.setRunning(controlledEntity.isStreamOutputRunning(configurationIndex, streamIndex));
 				if (streamOutputNode.dynamicModel->counters)
 				{
-					auto const& counters = *streamOutputNode.dynamicModel->counters;
-					{
-						auto const it = counters.find(la::avdecc::entity::StreamOutputCounterValidFlag::StreamStart);
-						if (it != counters.end())
-						{
-							node.setStreamStartCounter(it->second);
-						}
-					}
+					if (auto const isStarted = avdecc::ControllerManager::isStreamStarted(*streamOutputNode.dynamicModel->counters))
 					{
-						auto const it = counters.find(la::avdecc::entity::StreamOutputCounterValidFlag::StreamStop);
-						if (it != counters.end())
-						{
-							node.setStreamStopCounter(it->second);
-						}
+						node.setStreamStarted(*isStarted);
 					}
 				}
 			};
@@ -1460,14 +2268,14 @@ public:
 						for (auto const& [clusterIndex, clusterNode] : streamPortNode.audioClusters)
 						{
 							auto const* const staticModel = clusterNode.staticModel;
+							auto const* const templateNames = (entityTemplate && clusterNode.dynamicModel->objectName.empty()) ? &entityTemplate->clusterChannelNames.at(clusterIndex) : nullptr;
+							auto const clusterName = templateNames ? QString{} : avdecc::helper::objectName(&controlledEntity, clusterNode);
 							for (auto channel = (uint16_t)0u; channel < staticModel->channelCount; ++channel)
 							{
 								auto channelIdentification = avdecc::ChannelIdentification{ configurationNode.descriptorIndex, clusterIndex, channel, avdecc::ChannelConnectionDirection::InputToOutput, audioUnitIndex, streamPortIndex, streamPortNode.staticModel->baseCluster };
 
 								auto* outputChannel = ChannelNode::createOutputNode(*entity, channelIdentification);
-								auto const clusterName = avdecc::helper::objectName(&controlledEntity, streamPortNode.audioClusters.at(clusterIndex));
-								auto const channelName = priv::clusterChannelName(clusterName, channel);
-								outputChannel->setName(channelName);
+								outputChannel->setName(templateNames ? (*templateNames)[channel] : nodeTemplateCache::clusterChannelName(clusterName, channel));
 							}
 						}
 					}
@@ -1501,10 +2309,21 @@ public:
 			auto* entity = EntityNode::create(entityID, isMilan);
 			entity->setName(avdecc::helper::smartEntityName(controlledEntity));
 
-			auto const fillStreamInputNode = [&controlledEntity](auto& node, auto const configurationIndex, auto const streamIndex, auto const avbInterfaceIndex, auto const& streamInputNode, auto const& avbInterfaceNode)
+			// Static data shared with the entities of the same model
+			auto const entityTemplate = nodeTemplateCache::getTemplate(controlledEntity, configurationNode);
+
+			auto const fillStreamInputNode = [&controlledEntity, &entityTemplate](auto& node, auto const configurationIndex, auto const streamIndex, auto const avbInterfaceIndex, auto const& streamInputNode, auto const& avbInterfaceNode)
 			{
 				node.setName(avdecc::helper::inputStreamName(controlledEntity, streamIndex));
 				node.setStreamFormat(streamInputNode.dynamicModel->streamFormat);
+				if (entityTemplate)
+				{
+					node.setAvailableFormats(entityTemplate->streamInputFormats.at(streamIndex));
+				}
+				else
+				{
+					node.setAvailableFormats(streamInputNode.staticModel->formats);
+				}
 				node.setGrandMasterID(avbInterfaceNode.dynamicModel->gptpGrandmasterID);
 				node.setGrandMasterDomain(avbInterfaceNode.dynamicModel->gptpDomainNumber);
 				node.setInterfaceLinkStatus(controlledEntity.getAvbInterfaceLinkStatus(avbInterfaceIndex));
@@ -1512,20 +2331,9 @@ public:
 				node.setStreamConnectionState(streamInputNode.dynamicModel->connectionState);
 				if (streamInputNode.dynamicModel->counters)
 				{
-					auto const& counters = *streamInputNode.dynamicModel->counters;
-					{
-						auto const it = counters.find(la::avdecc::entity::StreamInputCounterValidFlag::MediaLocked);
-						if (it != counters.end())
-						{
-							node.setMediaLockedCounter(it->second);
-						}
-					}
+					if (auto const isLocked = avdecc::ControllerManager::isMediaLocked(*streamInputNode.dynamicModel->counters))
 					{
-						auto const it = counters.find(la::avdecc::entity::StreamInputCounterValidFlag::MediaUnlocked);
-						if (it != counters.end())
-						{
-							node.setMediaUnlockedCounter(it->second);
-						}
+						node.setMediaLocked(*isLocked);
 					}
 				}
 				if (streamInputNode.dynamicModel->streamDynamicInfo && (*streamInputNode.dynamicModel->streamDynamicInfo).probingStatus)
@@ -1585,14 +2393,14 @@ public:
 							for (auto const& [clusterIndex, clusterNode] : streamPortNode.audioClusters)
 							{
 								auto const* const staticModel = clusterNode.staticModel;
+								auto const* const templateNames = (entityTemplate && clusterNode.dynamicModel->objectName.empty()) ? &entityTemplate->clusterChannelNames.at(clusterIndex) : nullptr;
+								auto const clusterName = templateNames ? QString{} : avdecc::helper::objectName(&controlledEntity, clusterNode);
 								for (auto channel = (uint16_t)0u; channel < staticModel->channelCount; ++channel)
 								{
 									auto channelIdentification = avdecc::ChannelIdentification{ configurationNode.descriptorIndex, clusterIndex, channel, avdecc::ChannelConnectionDirection::InputToOutput, audioUnitIndex, streamPortIndex, streamPortNode.staticModel->baseCluster };
 
 									auto* inputChannel = ChannelNode::createInputNode(*entity, channelIdentification);
-									auto const clusterName = avdecc::helper::objectName(&controlledEntity, streamPortNode.audioClusters.at(clusterIndex));
-									auto const channelName = priv::clusterChannelName(clusterName, channel);
-									inputChannel->setName(channelName);
+									inputChannel->setName(templateNames ? (*templateNames)[channel] : nodeTemplateCache::clusterChannelName(clusterName, channel));
 								}
 							}
 						}
@@ -1616,52 +2424,57 @@ public:
 		}
 	}
 
-	// Insert a talker node hierarchy in the model
-	void insertTalkerNode(EntityNode* node)
+	// Insert talker node hierarchies in the model (nodes must be sorted by entityID), entities sharing the same insertion point are inserted in a single operation
+	void insertTalkerNodes(std::vector<EntityNode*> const& nodes)
 	{
-		if (!AVDECC_ASSERT_WITH_RET(node, "Node should not be null"))
+		auto nodeIt = std::begin(nodes);
+		while (nodeIt != std::end(nodes))
 		{
-			return;
-		}
+			auto const first = _talkerNodes.entitySection((*nodeIt)->entityID());
+			auto entitiesNodes = std::vector<priv::Nodes>{};
 
-		auto const entityID = node->entityID();
+			// Group all consecutive entities that have no existing entity between them
+			for (; nodeIt != std::end(nodes) && _talkerNodes.entitySection((*nodeIt)->entityID()) == first; ++nodeIt)
+			{
+				auto entityNodes = priv::flattenEntityNode(*nodeIt, _mode);
 
-		auto const flattendedNodes = priv::flattenEntityNode(node, _mode);
-		auto const childrenCount = static_cast<int>(flattendedNodes.size()) - 1;
+				// This entity has nothing to display in this mode
+				if (entityNodes.size() <= 1)
+				{
+					continue;
+				}
 
-		// This entity has nothing to display in this mode
-		if (childrenCount <= 0)
-		{
-			return;
+				entitiesNodes.push_back(std::move(entityNodes));
+			}
+
+			if (!entitiesNodes.empty())
+			{
+				insertTalkerSections(entitiesNodes, first);
+			}
 		}
+	}
 
-		auto const first = priv::sortedIndexForEntity(_talkerNodes, entityID);
-		auto const last = first + childrenCount;
+	// Insert flattened talker nodes of consecutive entities in the model, starting at first section
+	void insertTalkerSections(std::vector<priv::Nodes> const& entitiesNodes, int const first)
+	{
+		auto count = 0;
+		for (auto const& entityNodes : entitiesNodes)
+		{
+			count += static_cast<int>(entityNodes.size());
+		}
+		auto const last = first + count - 1;
 
 		beginInsertTalkerItems(first, last);
 
-		priv::insertNodes(_talkerNodes, flattendedNodes, first);
-
-		rebuildTalkerSectionCache();
-
-		// Insert new talker rows
-		auto const it = std::next(std::begin(_intersectionData), first);
-		_intersectionData.insert(it, childrenCount + 1, {});
-
-		// Update intersection matrix (Start from the end so that children are initialized before parents)
-		for (auto talkerSection = last; talkerSection >= first; --talkerSection)
+		for (auto const& entityNodes : entitiesNodes)
 		{
-			auto& row = _intersectionData[talkerSection];
-			row.resize(_listenerNodes.size());
-
-			auto* talker = _talkerNodes[talkerSection];
-			for (auto listenerSection = _listenerNodes.size(); listenerSection > 0u; --listenerSection)
-			{
-				auto* listener = _listenerNodes[listenerSection - 1];
-				initializeIntersectionData(talker, listener, row[listenerSection - 1]);
-			}
+			_talkerNodes.insert(entityNodes);
 		}
 
+		// Insert new talker rows (Intersections are left uncomputed and rows unallocated, they will be initialized the first time they are requested)
+		auto const it = std::next(std::begin(_intersectionCells), first);
+		_intersectionCells.insert(it, count, {});
+
 #if ENABLE_CONNECTION_MATRIX_DEBUG
 		dump();
 #endif
@@ -1669,49 +2482,62 @@ public:
 		endInsertTalkerItems();
 	}
 
-	// Insert a listener node hierarchy in the model
-	void insertListenerNode(EntityNode* node)
+	// Insert listener node hierarchies in the model (nodes must be sorted by entityID), entities sharing the same insertion point are inserted in a single operation
+	void insertListenerNodes(std::vector<EntityNode*> const& nodes)
 	{
-		if (!AVDECC_ASSERT_WITH_RET(node, "Node should not be null"))
+		auto nodeIt = std::begin(nodes);
+		while (nodeIt != std::end(nodes))
 		{
-			return;
-		}
+			auto const first = _listenerNodes.entitySection((*nodeIt)->entityID());
+			auto entitiesNodes = std::vector<priv::Nodes>{};
 
-		auto const entityID = node->entityID();
+			// Group all consecutive entities that have no existing entity between them
+			for (; nodeIt != std::end(nodes) && _listenerNodes.entitySection((*nodeIt)->entityID()) == first; ++nodeIt)
+			{
+				auto entityNodes = priv::flattenEntityNode(*nodeIt, _mode);
 
-		auto const flattendedNodes = priv::flattenEntityNode(node, _mode);
-		auto const childrenCount = static_cast<int>(flattendedNodes.size()) - 1;
+				// This entity has nothing to display in this mode
+				if (entityNodes.size() <= 1)
+				{
+					continue;
+				}
 
-		// This entity has nothing to display in this mode
-		if (childrenCount <= 0)
-		{
-			return;
+				entitiesNodes.push_back(std::move(entityNodes));
+			}
+
+			if (!entitiesNodes.empty())
+			{
+				insertListenerSections(entitiesNodes, first);
+			}
 		}
+	}
 
-		auto const first = priv::sortedIndexForEntity(_listenerNodes, entityID);
-		auto const last = first + childrenCount;
+	// Insert flattened listener nodes of consecutive entities in the model, starting at first section
+	void insertListenerSections(std::vector<priv::Nodes> const& entitiesNodes, int const first)
+	{
+		auto count = 0;
+		for (auto const& entityNodes : entitiesNodes)
+		{
+			count += static_cast<int>(entityNodes.size());
+		}
+		auto const last = first + count - 1;
 
 		beginInsertListenerItems(first, last);
 
-		priv::insertNodes(_listenerNodes, flattendedNodes, first);
-
-		rebuildListenerSectionCache();
-
-		// Update intersection matrix (Start from the end so that children are initialized before parents)
-		for (auto talkerSection = _talkerNodes.size(); talkerSection > 0u; --talkerSection)
+		for (auto const& entityNodes : entitiesNodes)
 		{
-			auto& row = _intersectionData[talkerSection - 1];
-
-			// Insert new listener columns
-			auto const it = std::next(std::begin(row), first);
-			row.insert(it, childrenCount + 1, {});
+			_listenerNodes.insert(entityNodes);
+		}
 
-			auto* talker = _talkerNodes[talkerSection - 1];
-			for (auto listenerSection = last; listenerSection >= first; --listenerSection)
+		// Insert new listener columns in allocated rows (Intersections are left uncomputed, they will be initialized the first time they are requested)
+		for (auto& row : _intersectionCells)
+		{
+			if (row.empty())
 			{
-				auto* listener = _listenerNodes[listenerSection];
-				initializeIntersectionData(talker, listener, row[listenerSection]);
+				continue;
 			}
+			auto const it = std::next(std::begin(row), first);
+			row.insert(it, count, {});
 		}
 
 #if ENABLE_CONNECTION_MATRIX_DEBUG
@@ -1732,16 +2558,16 @@ public:
 			return;
 		}
 
-		auto const first = priv::indexOf(_talkerNodeSectionMap, node);
+		auto const first = priv::indexOf(_talkerNodes, node);
 		auto const last = first + childrenCount;
 
 		beginRemoveTalkerItems(first, last);
 
-		priv::removeNodes(_talkerNodes, first, last + 1 /* entity */);
+		removeIntersectionExtraData(_intersectionExtraData, flattendedNodes, true);
 
-		rebuildTalkerSectionCache();
+		_talkerNodes.remove(node->entityID());
 
-		_intersectionData.erase(std::next(std::begin(_intersectionData), first), std::next(std::begin(_intersectionData), last + 1));
+		_intersectionCells.erase(std::next(std::begin(_intersectionCells), first), std::next(std::begin(_intersectionCells), last + 1));
 
 #if ENABLE_CONNECTION_MATRIX_DEBUG
 		dump();
@@ -1761,18 +2587,22 @@ public:
 			return;
 		}
 
-		auto const first = priv::indexOf(_listenerNodeSectionMap, node);
+		auto const first = priv::indexOf(_listenerNodes, node);
 		auto const last = first + childrenCount;
 
 		beginRemoveListenerItems(first, last);
 
-		priv::removeNodes(_listenerNodes, first, last + 1 /* entity */);
+		removeIntersectionExtraData(_intersectionExtraData, flattendedNodes, false);
 
-		rebuildListenerSectionCache();
+		_listenerNodes.remove(node->entityID());
 
 		for (auto talkerSection = 0u; talkerSection < _talkerNodes.size(); ++talkerSection)
 		{
-			auto& row = _intersectionData[talkerSection];
+			auto& row = _intersectionCells[talkerSection];
+			if (row.empty())
+			{
+				continue;
+			}
 
 			row.erase(std::next(std::begin(row), first), std::next(std::begin(row), last + 1));
 		}
@@ -1806,27 +2636,94 @@ public:
 		return _listenerNodes[section];
 	}
 
+	// Returns true if the event has to be ignored because the model is inactive, the entity being resynchronized when activated again
+	bool deferWhileInactive(la::avdecc::UniqueIdentifier const entityID)
+	{
+		if (_isActive)
+		{
+			return false;
+		}
+		_dirtyEntities.insert(entityID);
+		return true;
+	}
+
+	bool deferWhileInactive(avdecc::ControllerManager::EntityIDs const& entityIDs)
+	{
+		if (_isActive)
+		{
+			return false;
+		}
+		_dirtyEntities.insert(std::begin(entityIDs), std::end(entityIDs));
+		return true;
+	}
+
+	void setActive(bool const isActive)
+	{
+		if (isActive == _isActive)
+		{
+			return;
+		}
+
+		_isActive = isActive;
+
+		if (_isActive && !_dirtyEntities.empty())
+		{
+			auto dirtyEntities = std::move(_dirtyEntities);
+			_dirtyEntities.clear();
+
+			// Rebuild the entities changed while inactive
+			resyncEntities(dirtyEntities);
+		}
+	}
+
+	// Rebuilds the entities from their current state, in one batch (the ones gone offline are just removed)
+	template<typename EntityIDsType>
+	void resyncEntities(EntityIDsType const& entityIDs)
+	{
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto onlineEntities = avdecc::ControllerManager::EntityIDs{};
+		for (auto const entityID : entityIDs)
+		{
+			handleEntityOffline(entityID);
+			if (manager.getControlledEntity(entityID))
+			{
+				onlineEntities.push_back(entityID);
+			}
+		}
+		handleEntitiesOnline(onlineEntities);
+	}
+
 	// avdecc::ControllerManager slots
 
 	void handleControllerOffline()
 	{
-		Q_Q(Model);
-
-		emit q->beginResetModel();
+		HIVE_TRACE_SPAN("connectionMatrix::handleControllerOffline");
+		beginResetFaces();
+		_dirtyIntersections.clear();
 		_talkerNodeMap.clear();
 		_listenerNodeMap.clear();
 
 		_talkerStreamNodeMap.clear();
 		_listenerStreamNodeMap.clear();
 
+		_talkerGrandMasterStreamNodes.clear();
+		_listenerGrandMasterStreamNodes.clear();
+
 		_talkerChannelNodeMap.clear();
 		_listenerChannelNodeMap.clear();
 
+		_talkerConnectionCounts.clear();
+		_listenerConnectionCounts.clear();
+
+		// Nothing left to resynchronize
+		_dirtyEntities.clear();
+
 		clearCachedData();
-		emit q->endResetModel();
+		endResetFaces();
 	}
 
-	void handleEntityOnline(la::avdecc::UniqueIdentifier const entityID)
+	// Builds the talker and listener node hierarchies of an entity and inserts them in the persistent caches (not in the model)
+	void buildEntityNodes(la::avdecc::UniqueIdentifier const entityID, std::vector<EntityNode*>& talkers, std::vector<EntityNode*>& listeners)
 	{
 		try
 		{
@@ -1852,9 +2749,10 @@ public:
 						_talkerNodeMap.insert(std::make_pair(entityID, node));
 
 						priv::insertStreamNodes(_talkerStreamNodeMap, node);
+						priv::insertGrandMasterStreamNodes(_talkerGrandMasterStreamNodes, node);
 						priv::insertChannelNodes(_talkerChannelNodeMap, node);
 
-						insertTalkerNode(node);
+						talkers.push_back(node);
 					}
 				}
 
@@ -1867,9 +2765,17 @@ public:
 						_listenerNodeMap.insert(std::make_pair(entityID, node));
 
 						priv::insertStreamNodes(_listenerStreamNodeMap, node);
+						priv::insertGrandMasterStreamNodes(_listenerGrandMasterStreamNodes, node);
 						priv::insertChannelNodes(_listenerChannelNodeMap, node);
 
-						insertListenerNode(node);
+						// Account for the connections already established
+						node->accept<Node::StreamPolicy>(
+							[this](Node* node)
+							{
+								updateConnectionCounts({}, static_cast<StreamNode*>(node)->streamConnectionState());
+							});
+
+						listeners.push_back(node);
 					}
 				}
 			}
@@ -1885,45 +2791,164 @@ public:
 		}
 	}
 
+	void handleEntitiesOnline(avdecc::ControllerManager::EntityIDs const& entityIDs)
+	{
+		HIVE_TRACE_SPAN("connectionMatrix::handleEntitiesOnline");
+		if (deferWhileInactive(entityIDs))
+		{
+			return;
+		}
+
+		auto talkers = std::vector<EntityNode*>{};
+		auto listeners = std::vector<EntityNode*>{};
+
+		for (auto const& entityID : entityIDs)
+		{
+			buildEntityNodes(entityID, talkers, listeners);
+		}
+
+		priv::sortByEntityID(talkers);
+		priv::sortByEntityID(listeners);
+
+		insertTalkerNodes(talkers);
+		insertListenerNodes(listeners);
+
+		beginResetInactiveFaces();
+		insertInactiveTalkerNodes(talkers);
+		insertInactiveListenerNodes(listeners);
+		endResetInactiveFaces();
+	}
+
+	void handleEntityOnline(la::avdecc::UniqueIdentifier const entityID)
+	{
+		HIVE_TRACE_SPAN("connectionMatrix::handleEntityOnline");
+		handleEntitiesOnline({ entityID });
+	}
+
 	void handleEntityOffline(la::avdecc::UniqueIdentifier const entityID)
 	{
+		HIVE_TRACE_SPAN("connectionMatrix::handleEntityOffline");
 		if (auto* node = talkerNodeFromEntityID(entityID))
 		{
 			removeTalker(node);
+			beginResetInactiveFaces();
+			removeInactiveTalker(node);
+			endResetInactiveFaces();
 
 			// Remove from cache
 			priv::removeStreamNodes(_talkerStreamNodeMap, node);
+			priv::removeGrandMasterStreamNodes(_talkerGrandMasterStreamNodes, node);
 			priv::removeChannelNodes(_talkerChannelNodeMap, node);
 			_talkerNodeMap.erase(entityID);
 		}
 
 		if (auto* node = listenerNodeFromEntityID(entityID))
 		{
+			// Its connections are gone (talker counts are kept when a talker goes offline though, as its listeners still reference it)
+			node->accept<Node::StreamPolicy>(
+				[this](Node* node)
+				{
+					updateConnectionCounts(static_cast<StreamNode*>(node)->streamConnectionState(), {});
+				});
+
 			removeListener(node);
+			beginResetInactiveFaces();
+			removeInactiveListener(node);
+			endResetInactiveFaces();
 
 			// Remove from cache
 			priv::removeStreamNodes(_listenerStreamNodeMap, node);
+			priv::removeGrandMasterStreamNodes(_listenerGrandMasterStreamNodes, node);
 			priv::removeChannelNodes(_listenerChannelNodeMap, node);
 			_listenerNodeMap.erase(entityID);
 		}
 	}
 
+	void handleEntitiesOffline(avdecc::ControllerManager::EntityIDs const& entityIDs)
+	{
+		HIVE_TRACE_SPAN("connectionMatrix::handleEntitiesOffline");
+		if (deferWhileInactive(entityIDs))
+		{
+			return;
+		}
+
+		for (auto const& entityID : entityIDs)
+		{
+			handleEntityOffline(entityID);
+		}
+	}
+
+	void handleEntitiesRebooting(avdecc::ControllerManager::EntityIDs const& entityIDs)
+	{
+		HIVE_TRACE_SPAN("connectionMatrix::handleEntitiesRebooting");
+		if (deferWhileInactive(entityIDs))
+		{
+			return;
+		}
+
+		// Sections are kept during the offline grace period, only their header is marked
+		for (auto const& entityID : entityIDs)
+		{
+			if (auto* node = talkerNodeFromEntityID(entityID))
+			{
+				node->setRebooting(true);
+				auto const section = talkerNodeSection(node);
+				if (section != -1)
+				{
+					notifyTalkerHeaderDataChanged(section);
+				}
+			}
+			if (auto* node = listenerNodeFromEntityID(entityID))
+			{
+				node->setRebooting(true);
+				auto const section = listenerNodeSection(node);
+				if (section != -1)
+				{
+					notifyListenerHeaderDataChanged(section);
+				}
+			}
+		}
+	}
+
+	void handleEntitiesRestored(avdecc::ControllerManager::EntityIDs const& entityIDs)
+	{
+		HIVE_TRACE_SPAN("connectionMatrix::handleEntitiesRestored");
+		if (deferWhileInactive(entityIDs))
+		{
+			return;
+		}
+
+		// The nodes of the previous enumeration are replaced, the other entities being untouched
+		resyncEntities(entityIDs);
+	}
+
 	void handleGptpChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::UniqueIdentifier const grandMasterID, std::uint8_t const grandMasterDomain)
 	{
+		HIVE_TRACE_SPAN("connectionMatrix::handleGptpChanged");
+		if (deferWhileInactive(entityID))
+		{
+			return;
+		}
+
 		// Event affecting the whole entity (all streams, Input and Output)
 		auto const dirtyFlags = IntersectionDirtyFlags{ IntersectionDirtyFlag::UpdateGptp };
 
+		// Intersections of the other mode are affected as well
+		invalidateInactiveIntersections();
+
 		if (auto* talker = talkerNodeFromEntityID(entityID))
 		{
 			talker->accept(avbInterfaceIndex,
 				[this, grandMasterID, grandMasterDomain, dirtyFlags, talker, entityID](StreamNode* node)
 				{
+					auto const previousGrandMasterID = node->grandMasterID();
 					node->setGrandMasterID(grandMasterID);
 					node->setGrandMasterDomain(grandMasterDomain);
+					priv::moveGrandMasterStreamNode(_talkerGrandMasterStreamNodes, node, previousGrandMasterID);
 
 					if (_mode == Model::Mode::Stream)
 					{
-						talkerIntersectionDataChanged(node, true, false, dirtyFlags);
+						streamGrandMasterChanged(node, true, previousGrandMasterID, dirtyFlags);
 					}
 					else
 					{
@@ -1937,12 +2962,14 @@ public:
 			listener->accept(avbInterfaceIndex,
 				[this, grandMasterID, grandMasterDomain, dirtyFlags, listener, entityID](StreamNode* node)
 				{
+					auto const previousGrandMasterID = node->grandMasterID();
 					node->setGrandMasterID(grandMasterID);
 					node->setGrandMasterDomain(grandMasterDomain);
+					priv::moveGrandMasterStreamNode(_listenerGrandMasterStreamNodes, node, previousGrandMasterID);
 
 					if (_mode == Model::Mode::Stream)
 					{
-						listenerIntersectionDataChanged(node, true, false, dirtyFlags);
+						streamGrandMasterChanged(node, false, previousGrandMasterID, dirtyFlags);
 					}
 					else
 					{
@@ -1954,6 +2981,12 @@ public:
 
 	void handleEntityNameChanged(la::avdecc::UniqueIdentifier const entityID)
 	{
+		HIVE_TRACE_SPAN("connectionMatrix::handleEntityNameChanged");
+		if (deferWhileInactive(entityID))
+		{
+			return;
+		}
+
 		// Event affecting the whole entity (but just the entity node as Talker and Listener)
 		try
 		{
@@ -1988,9 +3021,18 @@ public:
 
 	void handleAvbInterfaceLinkStatusChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::controller::ControlledEntity::InterfaceLinkStatus const linkStatus)
 	{
+		HIVE_TRACE_SPAN("connectionMatrix::handleAvbInterfaceLinkStatusChanged");
+		if (deferWhileInactive(entityID))
+		{
+			return;
+		}
+
 		// Event affecting the whole entity (all streams, Input and Output)
 		auto const dirtyFlags = IntersectionDirtyFlags{ IntersectionDirtyFlag::UpdateLinkStatus };
 
+		// Intersections of the other mode are affected as well
+		invalidateInactiveIntersections();
+
 		if (auto* talker = talkerNodeFromEntityID(entityID))
 		{
 			talker->accept(avbInterfaceIndex,
@@ -2030,9 +3072,18 @@ public:
 
 	void handleStreamFormatChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat)
 	{
+		HIVE_TRACE_SPAN("connectionMatrix::handleStreamFormatChanged");
+		if (deferWhileInactive(entityID))
+		{
+			return;
+		}
+
 		// Event affecting a single stream node (either Input or Output), but having repercussion on parent intersection "summary" nodes
 		auto const dirtyFlags = IntersectionDirtyFlags{ IntersectionDirtyFlag::UpdateFormat };
 
+		// Intersections of the other mode are affected as well
+		invalidateInactiveIntersections();
+
 		if (descriptorType == la::avdecc::entity::model::DescriptorType::StreamOutput)
 		{
 			if (auto* talker = talkerNodeFromEntityID(entityID))
@@ -2052,7 +3103,7 @@ public:
 				}
 				else
 				{
-					LOG_HIVE_ERROR(QString("connectionMatrix::Model::StreamFormatChanged: Invalid StreamOutputIndex: TalkerID=%1 StreamIndex=%2").arg(avdecc::helper::uniqueIdentifierToString(entityID)).arg(streamIndex));
+					LOG_HIVE_FORMAT(Error, "connectionMatrix::Model::StreamFormatChanged: Invalid StreamOutputIndex: TalkerID=%1 StreamIndex=%2", entityID, streamIndex);
 				}
 			}
 		}
@@ -2075,7 +3126,7 @@ public:
 				}
 				else
 				{
-					LOG_HIVE_ERROR(QString("connectionMatrix::Model::StreamFormatChanged: Invalid StreamInputIndex: ListenerID=%1 StreamIndex=%2").arg(avdecc::helper::uniqueIdentifierToString(entityID)).arg(streamIndex));
+					LOG_HIVE_FORMAT(Error, "connectionMatrix::Model::StreamFormatChanged: Invalid StreamInputIndex: ListenerID=%1 StreamIndex=%2", entityID, streamIndex);
 				}
 			}
 		}
@@ -2083,6 +3134,12 @@ public:
 
 	void handleStreamRunningChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, bool const isRunning)
 	{
+		HIVE_TRACE_SPAN("connectionMatrix::handleStreamRunningChanged");
+		if (deferWhileInactive(entityID))
+		{
+			return;
+		}
+
 		// Event affecting a single stream node (either Input or Output)
 		if (descriptorType == la::avdecc::entity::model::DescriptorType::StreamOutput)
 		{
@@ -2096,7 +3153,7 @@ public:
 			}
 			else
 			{
-				LOG_HIVE_ERROR(QString("connectionMatrix::Model::StreamRunningChanged: Invalid StreamOutputIndex: TalkerID=%1 StreamIndex=%2").arg(avdecc::helper::uniqueIdentifierToString(entityID)).arg(streamIndex));
+				LOG_HIVE_FORMAT(Error, "connectionMatrix::Model::StreamRunningChanged: Invalid StreamOutputIndex: TalkerID=%1 StreamIndex=%2", entityID, streamIndex);
 			}
 		}
 		else if (descriptorType == la::avdecc::entity::model::DescriptorType::StreamInput)
@@ -2110,22 +3167,33 @@ public:
 			}
 			else
 			{
-				LOG_HIVE_ERROR(QString("connectionMatrix::Model::StreamRunningChanged: Invalid StreamInputIndex: ListenerID=%1 StreamIndex=%2").arg(avdecc::helper::uniqueIdentifierToString(entityID)).arg(streamIndex));
+				LOG_HIVE_FORMAT(Error, "connectionMatrix::Model::StreamRunningChanged: Invalid StreamInputIndex: ListenerID=%1 StreamIndex=%2", entityID, streamIndex);
 			}
 		}
 	}
 
 	void handleStreamConnectionChanged(la::avdecc::entity::model::StreamConnectionState const& state)
 	{
+		HIVE_TRACE_SPAN("connectionMatrix::handleStreamConnectionChanged");
+		if (deferWhileInactive(state.listenerStream.entityID))
+		{
+			return;
+		}
+
 		// Event affecting a single stream intersection, but having repercussion on parent intersection "summary" nodes
 		auto const entityID = state.listenerStream.entityID;
 		auto const dirtyFlags = IntersectionDirtyFlags{ IntersectionDirtyFlag::UpdateConnected };
 
+		// Intersections of the other mode are affected as well
+		invalidateInactiveIntersections();
+
 		if (auto* listener = listenerNodeFromEntityID(entityID))
 		{
 			if (auto* node = listenerStreamNode(entityID, state.listenerStream.streamIndex))
 			{
+				auto const previousState = node->streamConnectionState();
 				node->setStreamConnectionState(state);
+				updateConnectionCounts(previousState, state);
 
 				if (_mode == Model::Mode::Stream)
 				{
@@ -2141,13 +3209,19 @@ public:
 			}
 			else
 			{
-				LOG_HIVE_ERROR(QString("connectionMatrix::Model::StreamConnectionChanged: Invalid StreamIndex: ListenerID=%1 StreamIndex=%2").arg(avdecc::helper::uniqueIdentifierToString(entityID)).arg(state.listenerStream.streamIndex));
+				LOG_HIVE_FORMAT(Error, "connectionMatrix::Model::StreamConnectionChanged: Invalid StreamIndex: ListenerID=%1 StreamIndex=%2", entityID, state.listenerStream.streamIndex);
 			}
 		}
 	}
 
 	void handleStreamNameChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const /*configurationIndex*/, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex)
 	{
+		HIVE_TRACE_SPAN("connectionMatrix::handleStreamNameChanged");
+		if (deferWhileInactive(entityID))
+		{
+			return;
+		}
+
 		// Event affecting a single stream node (either Input or Output)
 		try
 		{
@@ -2168,7 +3242,7 @@ public:
 					}
 					else
 					{
-						LOG_HIVE_ERROR(QString("connectionMatrix::Model::StreamNameChanged: Invalid StreamOutputIndex: TalkerID=%1 StreamIndex=%2").arg(avdecc::helper::uniqueIdentifierToString(entityID)).arg(streamIndex));
+						LOG_HIVE_FORMAT(Error, "connectionMatrix::Model::StreamNameChanged: Invalid StreamOutputIndex: TalkerID=%1 StreamIndex=%2", entityID, streamIndex);
 					}
 				}
 				else if (descriptorType == la::avdecc::entity::model::DescriptorType::StreamInput)
@@ -2183,7 +3257,7 @@ public:
 					}
 					else
 					{
-						LOG_HIVE_ERROR(QString("connectionMatrix::Model::StreamNameChanged: Invalid StreamInputIndex: ListenerID=%1 StreamIndex=%2").arg(avdecc::helper::uniqueIdentifierToString(entityID)).arg(streamIndex));
+						LOG_HIVE_FORMAT(Error, "connectionMatrix::Model::StreamNameChanged: Invalid StreamInputIndex: ListenerID=%1 StreamIndex=%2", entityID, streamIndex);
 					}
 				}
 			}
@@ -2197,6 +3271,12 @@ public:
 
 	void handleStreamDynamicInfoChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamDynamicInfo const& info)
 	{
+		HIVE_TRACE_SPAN("connectionMatrix::handleStreamDynamicInfoChanged");
+		if (deferWhileInactive(entityID))
+		{
+			return;
+		}
+
 		// Event affecting a single stream node (Input)
 		try
 		{
@@ -2219,7 +3299,7 @@ public:
 					}
 					else
 					{
-						LOG_HIVE_ERROR(QString("connectionMatrix::Model::StreamInfoChanged: Invalid StreamInputIndex: ListenerID=%1 StreamIndex=%2").arg(avdecc::helper::uniqueIdentifierToString(entityID)).arg(streamIndex));
+						LOG_HIVE_FORMAT(Error, "connectionMatrix::Model::StreamInfoChanged: Invalid StreamInputIndex: ListenerID=%1 StreamIndex=%2", entityID, streamIndex);
 					}
 				}
 			}
@@ -2231,107 +3311,68 @@ public:
 		}
 	}
 
-	void handleStreamInputCountersChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamInputCounters const& counters)
+	void handleStreamInputMediaLockedChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, bool const isMediaLocked)
 	{
-		// Event affecting a single stream node (Input)
-		try
+		HIVE_TRACE_SPAN("connectionMatrix::handleStreamInputMediaLockedChanged");
+		if (deferWhileInactive(entityID))
 		{
-			auto& manager = avdecc::ControllerManager::getInstance();
-			auto controlledEntity = manager.getControlledEntity(entityID);
-			if (controlledEntity)
-			{
-				if (auto* node = listenerStreamNode(entityID, streamIndex))
-				{
-					auto changed = false;
+			return;
+		}
 
-					for (auto const [flag, counter] : counters)
-					{
-						switch (flag)
-						{
-							case la::avdecc::entity::StreamInputCounterValidFlag::MediaLocked:
-								node->setMediaLockedCounter(counter);
-								changed = true;
-								break;
-							case la::avdecc::entity::StreamInputCounterValidFlag::MediaUnlocked:
-								node->setMediaUnlockedCounter(counter);
-								changed = true;
-								break;
-							default:
-								break;
-						}
-					}
+		// Event affecting a single stream node (Input), only received on lock state transitions
+		if (!listenerNodeFromEntityID(entityID))
+		{
+			return;
+		}
 
-					if (changed)
-					{
-						listenerHeaderDataChanged(node, true, HeaderDirtyFlags{ HeaderDirtyFlag::UpdateLockedState });
+		if (auto* node = listenerStreamNode(entityID, streamIndex))
+		{
+			node->setMediaLocked(isMediaLocked);
+			listenerHeaderDataChanged(node, true, HeaderDirtyFlags{ HeaderDirtyFlag::UpdateLockedState });
 #pragma message("TODO: Find affected Channels and for each, call listenerHeaderDataChanged(node, _mode == Model::Mode::Channel, false, {UpdateLockedState});")
-					}
-				}
-				else
-				{
-					LOG_HIVE_ERROR(QString("connectionMatrix::Model::StreamInputCountersChanged: Invalid StreamInputIndex: ListenerID=%1 StreamIndex=%2").arg(avdecc::helper::uniqueIdentifierToString(entityID)).arg(streamIndex));
-				}
-			}
 		}
-		catch (...)
+		else
 		{
-			// Uncaught exception
-			AVDECC_ASSERT(false, "Uncaught exception");
+			LOG_HIVE_FORMAT(Error, "connectionMatrix::Model::StreamInputMediaLockedChanged: Invalid StreamInputIndex: ListenerID=%1 StreamIndex=%2", entityID, streamIndex);
 		}
 	}
 
-	void handleStreamOutputCountersChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamOutputCounters const& counters)
+	void handleStreamOutputStartedChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, bool const isStarted)
 	{
-		// Event affecting a single stream node (Output)
-		try
+		HIVE_TRACE_SPAN("connectionMatrix::handleStreamOutputStartedChanged");
+		if (deferWhileInactive(entityID))
 		{
-			auto& manager = avdecc::ControllerManager::getInstance();
-			auto controlledEntity = manager.getControlledEntity(entityID);
-			if (controlledEntity)
-			{
-				if (auto* node = talkerStreamNode(entityID, streamIndex))
-				{
-					auto changed = false;
+			return;
+		}
 
-					for (auto const [flag, counter] : counters)
-					{
-						switch (flag)
-						{
-							case la::avdecc::entity::StreamOutputCounterValidFlag::StreamStart:
-								node->setStreamStartCounter(counter);
-								changed = true;
-								break;
-							case la::avdecc::entity::StreamOutputCounterValidFlag::StreamStop:
-								node->setStreamStopCounter(counter);
-								changed = true;
-								break;
-							default:
-								break;
-						}
-					}
+		// Event affecting a single stream node (Output), only received on streaming state transitions
+		if (!talkerNodeFromEntityID(entityID))
+		{
+			return;
+		}
 
-					if (changed)
-					{
-						// Notify view based on current mode, since we have a StreamNode here
-						talkerHeaderDataChanged(node, _mode == Model::Mode::Stream, true, HeaderDirtyFlags{ HeaderDirtyFlag::UpdateIsStreaming });
+		if (auto* node = talkerStreamNode(entityID, streamIndex))
+		{
+			node->setStreamStarted(isStarted);
+
+			// Notify view based on current mode, since we have a StreamNode here
+			talkerHeaderDataChanged(node, _mode == Model::Mode::Stream, true, HeaderDirtyFlags{ HeaderDirtyFlag::UpdateIsStreaming });
 #pragma message("TODO: Find affected Channels and for each, call talkerHeaderDataChanged(node, _mode == Model::Mode::Channel, false, {UpdateIsStreaming});")
-					}
-				}
-				else
-				{
-					LOG_HIVE_ERROR(QString("connectionMatrix::Model::StreamOutputCountersChanged: Invalid StreamOutputIndex: TalkerID=%1 StreamIndex=%2").arg(avdecc::helper::uniqueIdentifierToString(entityID)).arg(streamIndex));
-				}
-			}
 		}
-		catch (...)
+		else
 		{
-			// Uncaught exception
-			AVDECC_ASSERT(false, "Uncaught exception");
+			LOG_HIVE_FORMAT(Error, "connectionMatrix::Model::StreamOutputStartedChanged: Invalid StreamOutputIndex: TalkerID=%1 StreamIndex=%2", entityID, streamIndex);
 		}
 	}
 
 	void handleStreamPortAudioMappingsChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamPortIndex const streamPortIndex)
 	{
+		HIVE_TRACE_SPAN("connectionMatrix::handleStreamPortAudioMappingsChanged");
+		if (deferWhileInactive(entityID))
+		{
+			return;
+		}
+
 		// Event affecting multiple channel nodes (either Input or Output)
 		try
 		{
@@ -2370,6 +3411,12 @@ public:
 
 	void handleCompatibilityFlagsChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::controller::ControlledEntity::CompatibilityFlags compatibilityFlags)
 	{
+		HIVE_TRACE_SPAN("connectionMatrix::handleCompatibilityFlagsChanged");
+		if (deferWhileInactive(entityID))
+		{
+			return;
+		}
+
 		auto const isMilan = compatibilityFlags.test(la::avdecc::controller::ControlledEntity::CompatibilityFlag::Milan);
 
 		// Check if entity was Milan compatible, but isn't anymore
@@ -2412,6 +3459,12 @@ public:
 
 	void handleAudioClusterNameChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClusterIndex const audioClusterIndex, QString const& audioClusterName)
 	{
+		HIVE_TRACE_SPAN("connectionMatrix::handleAudioClusterNameChanged");
+		if (deferWhileInactive(entityID))
+		{
+			return;
+		}
+
 		try
 		{
 #pragma message("TODO: cache the current configuration in the node to avoid locking the controller from the main thread")
@@ -2431,7 +3484,7 @@ public:
 			{
 				if (auto* channelNode = talkerChannelNode(entityID, audioClusterIndex))
 				{
-					auto const channelName = priv::clusterChannelName(audioClusterName, channelNode->channelIndex());
+					auto const channelName = nodeTemplateCache::clusterChannelName(audioClusterName, channelNode->channelIndex());
 					channelNode->setName(channelName);
 
 					// Only notify the view in CBR mode, ClusterName is not displayed in SBR mode
@@ -2443,7 +3496,7 @@ public:
 			{
 				if (auto* channelNode = listenerChannelNode(entityID, audioClusterIndex))
 				{
-					auto const channelName = priv::clusterChannelName(audioClusterName, channelNode->channelIndex());
+					auto const channelName = nodeTemplateCache::clusterChannelName(audioClusterName, channelNode->channelIndex());
 					channelNode->setName(channelName);
 
 					listenerHeaderDataChanged(channelNode, false, {});
@@ -2458,18 +3511,53 @@ public:
 	}
 
 	// avdecc::ChannelConnectionManager slots
-	void handleListenerChannelConnectionsUpdate(std::set<std::pair<la::avdecc::UniqueIdentifier, avdecc::ChannelIdentification>> const& channels)
+	void handleListenerClusterSpansUpdate(avdecc::ListenerClusterSpans const& spans)
 	{
+		HIVE_TRACE_SPAN("connectionMatrix::handleListenerClusterSpansUpdate");
+		if (!_isActive)
+		{
+			for (auto const& span : spans)
+			{
+				_dirtyEntities.insert(span.entityID);
+			}
+			return;
+		}
+
+		// Intersections of the other mode are affected as well
+		invalidateInactiveIntersections();
+
+		if (_mode != Model::Mode::Channel)
+		{
+			return;
+		}
+
 		auto const dirtyFlags = IntersectionDirtyFlags{ IntersectionDirtyFlag::UpdateConnected };
 
-		for (auto const& [entityID, channelInfo] : channels)
+		// Update the channel nodes of all the spans first, then their parents level by level so each parent is only computed once, after all its children
+		auto nodes = std::vector<Node*>{};
+		for (auto const& span : spans)
 		{
-			auto* listenerNode = listenerChannelNode(entityID, channelInfo.clusterIndex);
+			for (auto clusterIndex = static_cast<std::uint32_t>(span.firstCluster); clusterIndex <= span.lastCluster; ++clusterIndex)
+			{
+				if (auto* listenerNode = listenerChannelNode(span.entityID, static_cast<la::avdecc::entity::model::ClusterIndex>(clusterIndex)))
+				{
+					nodes.push_back(listenerNode);
+				}
+			}
+		}
 
-			if (_mode == Model::Mode::Channel)
+		while (!nodes.empty())
+		{
+			auto parents = std::vector<Node*>{};
+			for (auto* const node : nodes)
 			{
-				listenerIntersectionDataChanged(listenerNode, true, false, dirtyFlags);
+				listenerIntersectionDataChanged(node, false, false, dirtyFlags);
+				if (auto* parent = node->parent(); parent && std::find(parents.begin(), parents.end(), parent) == parents.end())
+				{
+					parents.push_back(parent);
+				}
 			}
+			nodes = std::move(parents);
 		}
 	}
 
@@ -2482,15 +3570,14 @@ private:
 			auto const clusterOffset = talker->getStreamPortOutputClusterOffset(streamPortIndex);
 
 			// One stream can have multiple Channels
-			for (auto const& mapping : audioUnitMappings)
+			auto const [first, last] = avdecc::audioMappingKeys::streamRange(audioUnitMappings, node->streamIndex());
+			for (auto it = first; it != last; ++it)
 			{
-				if (mapping.streamIndex == node->streamIndex())
+				auto const mappingClusterOffset = avdecc::audioMappingKeys::clusterOffset(*it);
+				if (auto* channelNode = talkerChannelNode(entityID, clusterOffset + mappingClusterOffset))
 				{
-					if (auto* channelNode = talkerChannelNode(entityID, clusterOffset + mapping.clusterOffset))
-					{
-						talkerIntersectionDataChanged(channelNode, true, false, dirtyFlags);
-						qDebug() << "updateTalkerIntersectionChannels: Update Channel #" << (clusterOffset + mapping.clusterOffset);
-					}
+					talkerIntersectionDataChanged(channelNode, true, false, dirtyFlags);
+					qDebug() << "updateTalkerIntersectionChannels: Update Channel #" << (clusterOffset + mappingClusterOffset);
 				}
 			}
 		}
@@ -2504,15 +3591,14 @@ private:
 			auto const clusterOffset = listener->getStreamPortInputClusterOffset(streamPortIndex);
 
 			// One stream can have multiple Channels
-			for (auto const& mapping : audioUnitMappings)
+			auto const [first, last] = avdecc::audioMappingKeys::streamRange(audioUnitMappings, node->streamIndex());
+			for (auto it = first; it != last; ++it)
 			{
-				if (mapping.streamIndex == node->streamIndex())
+				auto const mappingClusterOffset = avdecc::audioMappingKeys::clusterOffset(*it);
+				if (auto* channelNode = listenerChannelNode(entityID, clusterOffset + mappingClusterOffset))
 				{
-					if (auto* channelNode = listenerChannelNode(entityID, clusterOffset + mapping.clusterOffset))
-					{
-						listenerIntersectionDataChanged(channelNode, true, false, dirtyFlags);
-						qDebug() << "updateListenerIntersectionChannels: Update Channel #" << (clusterOffset + mapping.clusterOffset);
-					}
+					listenerIntersectionDataChanged(channelNode, true, false, dirtyFlags);
+					qDebug() << "updateListenerIntersectionChannels: Update Channel #" << (clusterOffset + mappingClusterOffset);
 				}
 			}
 		}
@@ -2521,13 +3607,20 @@ private:
 	// Returns talker section for node
 	int talkerNodeSection(Node* const node) const
 	{
-		return priv::indexOf(_talkerNodeSectionMap, node);
+		return priv::indexOf(_talkerNodes, node);
 	}
 
 	// Returns listener section for node
 	int listenerNodeSection(Node* const node) const
 	{
-		return priv::indexOf(_listenerNodeSectionMap, node);
+		return priv::indexOf(_listenerNodes, node);
+	}
+
+	// Returns true if the entity has at least one connected stream, as a talker or as a listener
+	bool hasConnections(la::avdecc::UniqueIdentifier const& entityID, bool const isTalker) const
+	{
+		auto const& counts = isTalker ? _talkerConnectionCounts : _listenerConnectionCounts;
+		return counts.count(entityID) != 0;
 	}
 
 	// Returns talker EntityNode for a given entityID
@@ -2624,39 +3717,163 @@ private:
 		return it->second;
 	}
 
-private:
-	// Returns intersection model index for talkerSection and listenerSection (automatically transposed if required)
-	QModelIndex createIndex(int const talkerSection, int const listenerSection) const
+	// Gathers the connected leaf intersections from the cached connection states (listener streams in Stream mode, channel connections in Channel mode), without computing any intersection
+	Model::ConnectedIntersections connectedIntersections() const
 	{
-		Q_Q(const Model);
+		auto intersections = Model::ConnectedIntersections{};
 
-		if (!_transposed)
-		{
-			return q->createIndex(talkerSection, listenerSection);
-		}
-		else
+		if (_mode == Model::Mode::Stream)
 		{
-			return q->createIndex(listenerSection, talkerSection);
-		}
-	}
+			for (auto const& [key, listenerStreamNode] : _listenerStreamNodeMap)
+			{
+				auto const& connectionState = listenerStreamNode->streamConnectionState();
+				auto state = Model::IntersectionData::State::NotConnected;
+				switch (connectionState.state)
+				{
+					case la::avdecc::entity::model::StreamConnectionState::State::Connected:
+						state = Model::IntersectionData::State::Connected;
+						break;
+					case la::avdecc::entity::model::StreamConnectionState::State::FastConnecting:
+						state = Model::IntersectionData::State::FastConnecting;
+						break;
+					default:
+						continue;
+				}
 
-	// Recomputes (according to dirtyFlags) intersection data for talkerSection and listenerSection and notifies that it has changed
+				auto const talkerIt = _talkerStreamNodeMap.find(std::make_pair(connectionState.talkerStream.entityID, connectionState.talkerStream.streamIndex));
+				if (talkerIt == std::end(_talkerStreamNodeMap))
+				{
+					continue;
+				}
+
+				auto const talkerSection = _talkerNodes.indexOf(talkerIt->second);
+				auto const listenerSection = _listenerNodes.indexOf(listenerStreamNode);
+				if (talkerSection != -1 && listenerSection != -1)
+				{
+					intersections.push_back(Model::ConnectedIntersection{ talkerSection, listenerSection, state });
+				}
+			}
+		}
+		else
+		{
+			auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
+
+			for (auto const& [key, talkerChannelNode] : _talkerChannelNodeMap)
+			{
+				auto const talkerSection = _talkerNodes.indexOf(talkerChannelNode);
+				if (talkerSection == -1)
+				{
+					continue;
+				}
+
+				auto const connections = channelConnectionManager.getChannelConnections(talkerChannelNode->entityID(), talkerChannelNode->channelIdentification());
+				if (!connections)
+				{
+					continue;
+				}
+
+				for (auto const& target : connections->targets)
+				{
+					for (auto const& [clusterIndex, clusterChannel] : target.targetClusterChannels)
+					{
+						auto const listenerIt = _listenerChannelNodeMap.find(std::make_pair(target.targetEntityId, clusterIndex));
+						if (listenerIt == std::end(_listenerChannelNodeMap))
+						{
+							continue;
+						}
+
+						auto const listenerSection = _listenerNodes.indexOf(listenerIt->second);
+						if (listenerSection != -1)
+						{
+							intersections.push_back(Model::ConnectedIntersection{ talkerSection, listenerSection, Model::IntersectionData::State::Connected });
+						}
+					}
+				}
+			}
+		}
+
+		return intersections;
+	}
+
+private:
+
+	// Recomputes (according to dirtyFlags) intersection data for talkerSection and listenerSection and marks it as changed
 	void intersectionDataChanged(int const talkerSection, int const listenerSection, IntersectionDirtyFlags const dirtyFlags)
 	{
-		Q_Q(Model);
+		// Never requested yet, it will be computed with up-to-date values when it is
+		if (!isIntersectionComputed(talkerSection, listenerSection))
+		{
+			return;
+		}
 
-		auto& data = _intersectionData[talkerSection][listenerSection];
+		auto data = loadIntersectionData(talkerSection, listenerSection);
 
 		computeIntersectionData(data, dirtyFlags);
 
-		auto const index = createIndex(talkerSection, listenerSection);
-		emit q->dataChanged(index, index);
+		storeIntersectionData(talkerSection, listenerSection, data);
+
+		markIntersectionDirty(talkerSection, listenerSection);
 
 #if ENABLE_CONNECTION_MATRIX_HIGHLIGHT_DATA_CHANGED
 		highlightIntersection(talkerSection, listenerSection);
 #endif
 	}
 
+	// Recomputes the intersections of a stream node whose grandmaster changed from previousGrandMasterID (and the ones of its parents), only against the counterpart streams (and their parents) whose grandmaster equality actually changed
+	void streamGrandMasterChanged(StreamNode* const node, bool const isTalker, la::avdecc::UniqueIdentifier const& previousGrandMasterID, IntersectionDirtyFlags const dirtyFlags)
+	{
+		auto const& grandMasterID = node->grandMasterID();
+		if (grandMasterID == previousGrandMasterID)
+		{
+			return;
+		}
+
+		auto const& nodeSections = isTalker ? _talkerNodes : _listenerNodes;
+		auto const& counterpartSections = isTalker ? _listenerNodes : _talkerNodes;
+		auto const& counterpartIndex = isTalker ? _listenerGrandMasterStreamNodes : _talkerGrandMasterStreamNodes;
+
+		// Sections of the node and its parents
+		auto sections = std::vector<int>{};
+		for (Node const* n = node; n != nullptr; n = n->parent())
+		{
+			if (auto const section = nodeSections.indexOf(n); section != -1)
+			{
+				sections.push_back(section);
+			}
+		}
+
+		// Counterparts sharing either the previous or the new grandmaster (all the others were, and still are, in a different domain)
+		auto intersections = std::set<std::pair<int, int>>{};
+		for (auto const& id : { previousGrandMasterID, grandMasterID })
+		{
+			auto const it = counterpartIndex.find(id);
+			if (it == std::end(counterpartIndex))
+			{
+				continue;
+			}
+			for (auto const* counterpart : it->second)
+			{
+				for (Node const* c = counterpart; c != nullptr; c = c->parent())
+				{
+					auto const counterpartSection = counterpartSections.indexOf(c);
+					if (counterpartSection == -1)
+					{
+						continue;
+					}
+					for (auto const section : sections)
+					{
+						intersections.insert(isTalker ? std::make_pair(section, counterpartSection) : std::make_pair(counterpartSection, section));
+					}
+				}
+			}
+		}
+
+		for (auto const& [talkerSection, listenerSection] : intersections)
+		{
+			intersectionDataChanged(talkerSection, listenerSection, dirtyFlags);
+		}
+	}
+
 	// Recomputes talker intersection data, possibily recomputing its parent and/or children according to desired dirtyFlags
 	// Children are updated first, then the node, then the parents
 	void talkerIntersectionDataChanged(Node* talker, bool const andParents, bool const andChildren, IntersectionDirtyFlags const dirtyFlags)
@@ -2748,8 +3965,6 @@ private:
 		// Notifies that talker header data has changed
 		if (notifyView)
 		{
-			Q_Q(Model);
-
 			// Update the node header
 			auto section = talkerNodeSection(talker);
 
@@ -2757,7 +3972,7 @@ private:
 			qDebug() << "talkerHeaderDataChanged(" << section << ")";
 #endif
 
-			emit q->headerDataChanged(talkerOrientation(), section, section);
+			notifyTalkerHeaderDataChanged(section);
 		}
 
 		// Finally, recursively update the parents
@@ -2772,160 +3987,523 @@ private:
 		}
 	}
 
-	// Recomputes listener header data, possibily recomputing its parent according to desired dirtyFlags
-	// The node is updated first, then the parents
-	void listenerHeaderDataChanged(Node* const listener, bool const notifyView, bool const andParents, HeaderDirtyFlags const dirtyFlags)
+	// Recomputes listener header data, possibily recomputing its parent according to desired dirtyFlags
+	// The node is updated first, then the parents
+	void listenerHeaderDataChanged(Node* const listener, bool const notifyView, bool const andParents, HeaderDirtyFlags const dirtyFlags)
+	{
+		// Compute header flags
+		if (!dirtyFlags.empty())
+		{
+			computeHeaderData(listener, dirtyFlags);
+		}
+
+		if (notifyView)
+		{
+			// Update the node header
+			auto section = listenerNodeSection(listener);
+
+#if ENABLE_CONNECTION_MATRIX_DEBUG
+			qDebug() << "listenerHeaderDataChanged(" << section << ")";
+#endif
+
+			notifyListenerHeaderDataChanged(section);
+		}
+
+		// Finally, recursively update the parents
+		if (andParents)
+		{
+			auto* node = listener;
+			while (auto* parent = node->parent())
+			{
+				listenerHeaderDataChanged(parent, notifyView, andParents, dirtyFlags);
+				node = parent;
+			}
+		}
+	}
+
+	template<class NodeType>
+	void listenerHeaderDataChanged(NodeType* const listener, bool const andParents, HeaderDirtyFlags const dirtyFlags)
+	{
+		// Notifies that listener header data has changed
+		auto notifyView = false;
+
+		// Always notify the view, EntityNode is available in CBR and SBR modes
+		if constexpr (std::is_same_v<NodeType, EntityNode>)
+		{
+			notifyView = true;
+		}
+
+		// In SBR mode, only notify view if we have a StreamNode
+		if (_mode == Model::Mode::Stream)
+		{
+			if constexpr (std::is_same_v<NodeType, StreamNode>)
+			{
+				notifyView = true;
+			}
+		}
+
+		// In CBR mode, only notify view if we have a ChannelNode
+		if (_mode == Model::Mode::Channel)
+		{
+			if constexpr (std::is_same_v<NodeType, ChannelNode>)
+			{
+				notifyView = true;
+			}
+		}
+
+		listenerHeaderDataChanged(listener, notifyView, andParents, dirtyFlags);
+	}
+
+	// Returns intersection model index of a face for talkerSection and listenerSection (automatically transposed if required)
+	static QModelIndex createIndex(Face const& face, int const talkerSection, int const listenerSection)
+	{
+		if (!face.transposed)
+		{
+			return face.model->createIndex(talkerSection, listenerSection);
+		}
+		else
+		{
+			return face.model->createIndex(listenerSection, talkerSection);
+		}
+	}
+
+	// Returns talker header orientation of a face
+	static Qt::Orientation talkerOrientation(Face const& face)
+	{
+		return !face.transposed ? Qt::Vertical : Qt::Horizontal;
+	}
+
+	// Returns listener header orientation of a face
+	static Qt::Orientation listenerOrientation(Face const& face)
+	{
+		return !face.transposed ? Qt::Horizontal : Qt::Vertical;
+	}
+
+	// Notifies the faces that the header of a talker section changed
+	void notifyTalkerHeaderDataChanged(int const section)
+	{
+		notifyFaces(
+			[section](Face const& face)
+			{
+				emit face.model->headerDataChanged(talkerOrientation(face), section, section);
+			});
+	}
+
+	// Notifies the faces that the header of a listener section changed
+	void notifyListenerHeaderDataChanged(int const section)
+	{
+		notifyFaces(
+			[section](Face const& face)
+			{
+				emit face.model->headerDataChanged(listenerOrientation(face), section, section);
+			});
+	}
+
+	// Returns the number of talker sections
+	int talkerSectionCount() const
+	{
+		return static_cast<int>(_talkerNodes.size());
+	}
+
+	// Returns the number of listener sections
+	int listenerSectionCount() const
+	{
+		return static_cast<int>(_listenerNodes.size());
+	}
+
+	// Extract talker section from index of a face
+	static int talkerIndex(Face const& face, QModelIndex const& index)
+	{
+		return !face.transposed ? index.row() : index.column();
+	}
+
+	// Extract listener section from index of a face
+	static int listenerIndex(Face const& face, QModelIndex const& index)
+	{
+		return !face.transposed ? index.column() : index.row();
+	}
+
+	// Returns true if section is a valid talker section, i.e. within [0, talkerSectionCount[
+	bool isValidTalkerSection(int section) const
+	{
+		return section >= 0 && section < talkerSectionCount();
+	}
+
+	// Returns true if section is a valid listener section, i.e. within [0, listenerSectionCount[
+	bool isValidListenerSection(int section) const
+	{
+		return section >= 0 && section < listenerSectionCount();
+	}
+
+	// Returns talker header data for sections (Qt::DisplayRole) at section
+	QString talkerHeaderData(int section) const
+	{
+		if (!isValidTalkerSection(section))
+		{
+			return {};
+		}
+
+		return _talkerNodes[section]->name();
+	}
+
+	// Returns listener header data for sections (Qt::DisplayRole) at section
+	QString listenerHeaderData(int section) const
+	{
+		if (!isValidListenerSection(section))
+		{
+			return {};
+		}
+
+		return _listenerNodes[section]->name();
+	}
+
+	void clearCachedData()
+	{
+		_talkerNodes.clear();
+		_listenerNodes.clear();
+		_intersectionCells.clear();
+		clearIntersectionExtraData(_intersectionExtraData);
+
+		_inactiveLayout.talkerNodes.clear();
+		_inactiveLayout.listenerNodes.clear();
+		_inactiveLayout.intersectionCells.clear();
+		clearIntersectionExtraData(_inactiveLayout.intersectionExtraData);
+	}
+
+	// Connection counts helpers
+
+	static bool isStreamConnected(la::avdecc::entity::model::StreamConnectionState const& state) noexcept
+	{
+		return state.state == la::avdecc::entity::model::StreamConnectionState::State::Connected || state.state == la::avdecc::entity::model::StreamConnectionState::State::FastConnecting;
+	}
+
+	// Updates the connection counts of the talker and listener entities when a listener stream goes from previousState to state
+	void updateConnectionCounts(la::avdecc::entity::model::StreamConnectionState const& previousState, la::avdecc::entity::model::StreamConnectionState const& state)
+	{
+		auto const wasConnected = isStreamConnected(previousState);
+		auto const isConnected = isStreamConnected(state);
+		auto const isSameTalker = previousState.talkerStream.entityID == state.talkerStream.entityID;
+
+		if (wasConnected && (!isConnected || !isSameTalker))
+		{
+			updateConnectionCount(true, previousState.talkerStream.entityID, -1);
+		}
+		if (isConnected && (!wasConnected || !isSameTalker))
+		{
+			updateConnectionCount(true, state.talkerStream.entityID, 1);
+		}
+		if (wasConnected != isConnected)
+		{
+			updateConnectionCount(false, state.listenerStream.entityID, isConnected ? 1 : -1);
+		}
+	}
+
+	void updateConnectionCount(bool const isTalker, la::avdecc::UniqueIdentifier const& entityID, int const delta)
+	{
+		auto& counts = isTalker ? _talkerConnectionCounts : _listenerConnectionCounts;
+		auto const it = counts.find(entityID);
+		auto const previousCount = it != std::end(counts) ? it->second : 0;
+		auto const count = previousCount + delta;
+
+		if (count > 0)
+		{
+			counts[entityID] = count;
+		}
+		else if (it != std::end(counts))
+		{
+			counts.erase(it);
+		}
+
+		// The entity gained its first connection or lost its last one, notify its header so it can be filtered again
+		if ((previousCount > 0) != (count > 0))
+		{
+			if (isTalker)
+			{
+				if (auto* node = talkerNodeFromEntityID(entityID))
+				{
+					auto const section = talkerNodeSection(node);
+					if (section != -1)
+					{
+						notifyTalkerHeaderDataChanged(section);
+					}
+				}
+			}
+			else
+			{
+				if (auto* node = listenerNodeFromEntityID(entityID))
+				{
+					auto const section = listenerNodeSection(node);
+					if (section != -1)
+					{
+						notifyListenerHeaderDataChanged(section);
+					}
+				}
+			}
+		}
+	}
+
+	// Intersection storage helpers
+
+	priv::IntersectionKey intersectionKey(int const talkerSection, int const listenerSection) const
+	{
+		return std::make_pair(_talkerNodes[talkerSection], _listenerNodes[listenerSection]);
+	}
+
+	bool isIntersectionComputed(int const talkerSection, int const listenerSection) const
+	{
+		auto const& row = _intersectionCells[talkerSection];
+		return !row.empty() && row[listenerSection].computed;
+	}
+
+	// Returns intersection data, fully computing it first if it's the first time it's requested
+	Model::IntersectionData intersectionDataAt(int const talkerSection, int const listenerSection)
+	{
+		if (!isIntersectionComputed(talkerSection, listenerSection))
+		{
+			auto intersectionData = Model::IntersectionData{};
+			initializeIntersectionData(_talkerNodes[talkerSection], _listenerNodes[listenerSection], intersectionData);
+			storeIntersectionData(talkerSection, listenerSection, intersectionData);
+			return intersectionData;
+		}
+
+		return loadIntersectionData(talkerSection, listenerSection);
+	}
+
+	// Rebuilds the complete intersection data from the compact storage
+	Model::IntersectionData loadIntersectionData(int const talkerSection, int const listenerSection) const
 	{
-		// Compute header flags
-		if (!dirtyFlags.empty())
+		auto intersectionData = Model::IntersectionData{};
+
+		auto const& cell = _intersectionCells[talkerSection][listenerSection];
+		intersectionData.talker = _talkerNodes[talkerSection];
+		intersectionData.listener = _listenerNodes[listenerSection];
+		intersectionData.type = static_cast<Model::IntersectionData::Type>(cell.type);
+		intersectionData.state = static_cast<Model::IntersectionData::State>(cell.state);
+		intersectionData.flags = priv::unpackFlags(cell.flags);
+
+		auto const it = _intersectionExtraData.find(intersectionKey(talkerSection, listenerSection));
+		if (it != _intersectionExtraData.end())
 		{
-			computeHeaderData(listener, dirtyFlags);
+			intersectionData.smartConnectableStreams = it->second.smartConnectableStreams;
+#if ENABLE_CONNECTION_MATRIX_HIGHLIGHT_DATA_CHANGED
+			intersectionData.animation = it->second.animation;
+#endif
 		}
 
-		if (notifyView)
-		{
-			Q_Q(Model);
+		return intersectionData;
+	}
 
-			// Update the node header
-			auto section = listenerNodeSection(listener);
+	// Saves intersection data in the compact storage (extra data is only kept if not empty)
+	void storeIntersectionData(int const talkerSection, int const listenerSection, Model::IntersectionData const& intersectionData)
+	{
+		auto& row = _intersectionCells[talkerSection];
+		if (row.empty())
+		{
+			row.resize(_listenerNodes.size());
+		}
 
-#if ENABLE_CONNECTION_MATRIX_DEBUG
-			qDebug() << "listenerHeaderDataChanged(" << section << ")";
-#endif
+		auto& cell = row[listenerSection];
+		cell.computed = true;
+		cell.type = static_cast<std::uint8_t>(la::avdecc::utils::to_integral(intersectionData.type));
+		cell.state = static_cast<std::uint8_t>(la::avdecc::utils::to_integral(intersectionData.state));
+		cell.flags = priv::packFlags(intersectionData.flags);
 
-			emit q->headerDataChanged(listenerOrientation(), section, section);
+		auto const key = intersectionKey(talkerSection, listenerSection);
+		if (!intersectionData.smartConnectableStreams.empty())
+		{
+			_intersectionExtraData[key].smartConnectableStreams = intersectionData.smartConnectableStreams;
 		}
-
-		// Finally, recursively update the parents
-		if (andParents)
+		else
 		{
-			auto* node = listener;
-			while (auto* parent = node->parent())
+			auto const it = _intersectionExtraData.find(key);
+			if (it != _intersectionExtraData.end())
 			{
-				listenerHeaderDataChanged(parent, notifyView, andParents, dirtyFlags);
-				node = parent;
+				it->second.smartConnectableStreams.clear();
+#if ENABLE_CONNECTION_MATRIX_HIGHLIGHT_DATA_CHANGED
+				if (!it->second.animation)
+#endif
+				{
+					_intersectionExtraData.erase(it);
+				}
 			}
 		}
 	}
 
-	template<class NodeType>
-	void listenerHeaderDataChanged(NodeType* const listener, bool const andParents, HeaderDirtyFlags const dirtyFlags)
+	// Removes the extra data of all intersections involving one of the nodes
+	static void removeIntersectionExtraData(priv::IntersectionExtraDataMap& intersectionExtraData, priv::Nodes const& nodes, bool const isTalker)
 	{
-		// Notifies that listener header data has changed
-		auto notifyView = false;
+		auto const removedNodes = std::unordered_set<Node const*>{ std::begin(nodes), std::end(nodes) };
 
-		// Always notify the view, EntityNode is available in CBR and SBR modes
-		if constexpr (std::is_same_v<NodeType, EntityNode>)
-		{
-			notifyView = true;
-		}
-
-		// In SBR mode, only notify view if we have a StreamNode
-		if (_mode == Model::Mode::Stream)
+		for (auto it = intersectionExtraData.begin(); it != intersectionExtraData.end();)
 		{
-			if constexpr (std::is_same_v<NodeType, StreamNode>)
+			auto const* const node = isTalker ? it->first.first : it->first.second;
+			if (removedNodes.count(node) != 0)
 			{
-				notifyView = true;
+#if ENABLE_CONNECTION_MATRIX_HIGHLIGHT_DATA_CHANGED
+				delete it->second.animation;
+#endif
+				it = intersectionExtraData.erase(it);
 			}
-		}
-
-		// In CBR mode, only notify view if we have a ChannelNode
-		if (_mode == Model::Mode::Channel)
-		{
-			if constexpr (std::is_same_v<NodeType, ChannelNode>)
+			else
 			{
-				notifyView = true;
+				++it;
 			}
 		}
-
-		listenerHeaderDataChanged(listener, notifyView, andParents, dirtyFlags);
 	}
 
-	// Returns talker header orientation
-	Qt::Orientation talkerOrientation() const
+	// Removes the extra data of all intersections
+	static void clearIntersectionExtraData(priv::IntersectionExtraDataMap& intersectionExtraData)
 	{
-		return !_transposed ? Qt::Vertical : Qt::Horizontal;
+#if ENABLE_CONNECTION_MATRIX_HIGHLIGHT_DATA_CHANGED
+		for (auto const& [key, extraData] : intersectionExtraData)
+		{
+			delete extraData.animation;
+		}
+#endif
+		intersectionExtraData.clear();
 	}
 
-	// Returns listener header orientation
-	Qt::Orientation listenerOrientation() const
-	{
-		return !_transposed ? Qt::Horizontal : Qt::Vertical;
-	}
+	// Inactive mode layout helpers
 
-	// Returns the number of talker sections
-	int talkerSectionCount() const
+	Model::Mode inactiveMode() const noexcept
 	{
-		return static_cast<int>(_talkerNodes.size());
+		return _mode == Model::Mode::Stream ? Model::Mode::Channel : Model::Mode::Stream;
 	}
 
-	// Returns the number of listener sections
-	int listenerSectionCount() const
+	// Insert talker node hierarchies in the inactive mode layout (no model notification)
+	void insertInactiveTalkerNodes(std::vector<EntityNode*> const& nodes)
 	{
-		return static_cast<int>(_listenerNodes.size());
-	}
+		auto& layout = _inactiveLayout;
+		for (auto* node : nodes)
+		{
+			auto const entityNodes = priv::flattenEntityNode(node, inactiveMode());
 
-	// Extract talker section from index
-	int talkerIndex(QModelIndex const& index) const
-	{
-		return !_transposed ? index.row() : index.column();
-	}
+			// This entity has nothing to display in this mode
+			if (entityNodes.size() <= 1)
+			{
+				continue;
+			}
 
-	// Extract listener section from index
-	int listenerIndex(QModelIndex const& index) const
-	{
-		return !_transposed ? index.column() : index.row();
+			auto const first = layout.talkerNodes.entitySection(node->entityID());
+			layout.talkerNodes.insert(entityNodes);
+			layout.intersectionCells.insert(std::next(std::begin(layout.intersectionCells), first), entityNodes.size(), {});
+		}
 	}
 
-	// Returns true if section is a valid talker section, i.e. within [0, talkerSectionCount[
-	bool isValidTalkerSection(int section) const
+	// Insert listener node hierarchies in the inactive mode layout (no model notification)
+	void insertInactiveListenerNodes(std::vector<EntityNode*> const& nodes)
 	{
-		return section >= 0 && section < talkerSectionCount();
+		auto& layout = _inactiveLayout;
+		for (auto* node : nodes)
+		{
+			auto const entityNodes = priv::flattenEntityNode(node, inactiveMode());
+
+			// This entity has nothing to display in this mode
+			if (entityNodes.size() <= 1)
+			{
+				continue;
+			}
+
+			auto const first = layout.listenerNodes.entitySection(node->entityID());
+			layout.listenerNodes.insert(entityNodes);
+			for (auto& row : layout.intersectionCells)
+			{
+				if (!row.empty())
+				{
+					row.insert(std::next(std::begin(row), first), entityNodes.size(), {});
+				}
+			}
+		}
 	}
 
-	// Returns true if section is a valid listener section, i.e. within [0, listenerSectionCount[
-	bool isValidListenerSection(int section) const
+	// Remove complete talker node hierarchy from the inactive mode layout (no model notification)
+	void removeInactiveTalker(EntityNode* node)
 	{
-		return section >= 0 && section < listenerSectionCount();
+		auto& layout = _inactiveLayout;
+		auto const flattendedNodes = priv::flattenEntityNode(node, inactiveMode());
+
+		if (flattendedNodes.size() <= 1)
+		{
+			return;
+		}
+
+		auto const first = priv::indexOf(layout.talkerNodes, node);
+		if (first == -1)
+		{
+			return;
+		}
+
+		removeIntersectionExtraData(layout.intersectionExtraData, flattendedNodes, true);
+		layout.talkerNodes.remove(node->entityID());
+		auto const it = std::next(std::begin(layout.intersectionCells), first);
+		layout.intersectionCells.erase(it, std::next(it, flattendedNodes.size()));
 	}
 
-	// Returns talker header data for sections (Qt::DisplayRole) at section
-	QString talkerHeaderData(int section) const
+	// Remove complete listener node hierarchy from the inactive mode layout (no model notification)
+	void removeInactiveListener(EntityNode* node)
 	{
-		if (!isValidTalkerSection(section))
+		auto& layout = _inactiveLayout;
+		auto const flattendedNodes = priv::flattenEntityNode(node, inactiveMode());
+
+		if (flattendedNodes.size() <= 1)
 		{
-			return {};
+			return;
 		}
 
-		return _talkerNodes[section]->name();
+		auto const first = priv::indexOf(layout.listenerNodes, node);
+		if (first == -1)
+		{
+			return;
+		}
+
+		removeIntersectionExtraData(layout.intersectionExtraData, flattendedNodes, false);
+		layout.listenerNodes.remove(node->entityID());
+		for (auto& row : layout.intersectionCells)
+		{
+			if (!row.empty())
+			{
+				auto const it = std::next(std::begin(row), first);
+				row.erase(it, std::next(it, flattendedNodes.size()));
+			}
+		}
 	}
 
-	// Returns listener header data for sections (Qt::DisplayRole) at section
-	QString listenerHeaderData(int section) const
+	// Forgets the computed intersections of the inactive mode, they will be recomputed the first time they are requested after a mode switch
+	void invalidateInactiveIntersections()
 	{
-		if (!isValidListenerSection(section))
+		for (auto& row : _inactiveLayout.intersectionCells)
 		{
-			return {};
+			row.clear();
 		}
+		clearIntersectionExtraData(_inactiveLayout.intersectionExtraData);
 
-		return _listenerNodes[section]->name();
+		// Faces displaying the inactive mode compute them again when refreshed
+		scheduleInactiveFacesUpdate();
 	}
 
-	void clearCachedData()
+	// Exchanges the current layout with the inactive mode one
+	void swapLayouts() noexcept
 	{
-		_talkerNodes.clear();
-		_listenerNodes.clear();
-		_talkerNodeSectionMap.clear();
-		_listenerNodeSectionMap.clear();
-		_intersectionData.clear();
+		using std::swap;
+		swap(_talkerNodes, _inactiveLayout.talkerNodes);
+		swap(_listenerNodes, _inactiveLayout.listenerNodes);
+		swap(_intersectionCells, _inactiveLayout.intersectionCells);
+		swap(_intersectionExtraData, _inactiveLayout.intersectionExtraData);
 	}
 
 private:
-	Model* const q_ptr{ nullptr };
-	Q_DECLARE_PUBLIC(Model);
+	friend class Model;
 
+	// Views facing models sharing this core (the first one is the model that created it)
+	std::vector<Face> _faces;
+
+	// Mode of the layout kept in the main caches, always displayed by at least one face
 	Model::Mode _mode{ Model::Mode::Stream };
-	bool _transposed{ false };
+	bool _inactiveFacesUpdateScheduled{ false };
+
+	// Controller events are not processed while inactive, only the changed entities are recorded to be resynchronized when activated again
+	bool _isActive{ true };
+	std::unordered_set<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash> _dirtyEntities;
 
 	// EntityNode per entityID (persistent)
 	priv::NodeMap _talkerNodeMap;
@@ -2935,56 +4513,82 @@ private:
 	priv::StreamNodeMap _talkerStreamNodeMap;
 	priv::StreamNodeMap _listenerStreamNodeMap;
 
+	// Stream nodes by grandmaster ID
+	priv::GrandMasterStreamNodes _talkerGrandMasterStreamNodes;
+	priv::GrandMasterStreamNodes _listenerGrandMasterStreamNodes;
+
 	// Channel nodes by ChannelKey
 	priv::ChannelNodeMap _talkerChannelNodeMap;
 	priv::ChannelNodeMap _listenerChannelNodeMap;
 
-	// Flattened nodes (cache)
-	priv::Nodes _talkerNodes;
-	priv::Nodes _listenerNodes;
+	// Connected listener streams count per entity, only entities having some are present (persistent)
+	priv::ConnectionCounts _talkerConnectionCounts;
+	priv::ConnectionCounts _listenerConnectionCounts;
+
+	// Flattened nodes, with section quick access (cache)
+	priv::SectionIndex _talkerNodes;
+	priv::SectionIndex _listenerNodes;
+
+	// Talker major intersection matrix (cache)
+	priv::IntersectionCells _intersectionCells;
+
+	// Intersection extra data, only for intersections having some (cache)
+	priv::IntersectionExtraDataMap _intersectionExtraData;
 
-	// Node section quick access map (cache)
-	priv::NodeSectionMap _talkerNodeSectionMap;
-	priv::NodeSectionMap _listenerNodeSectionMap;
+	// Same caches for the mode not currently displayed, kept up-to-date so switching mode doesn't rebuild anything
+	priv::ModeLayout _inactiveLayout;
 
-	// Talker major intersection data matrix (cache)
-	std::deque<std::deque<Model::IntersectionData>> _intersectionData;
+	// Changed intersections not notified yet (talkerSection, listenerSection)
+	std::set<std::pair<int, int>> _dirtyIntersections;
+	FrameScheduler::ClientID _frameClientID{ 0u };
+
+	avdecc::MemoryAccounting::ProbeID _memoryProbe{ 0u };
 };
 
 Model::Model(QObject* parent)
 	: QAbstractTableModel{ parent }
-	, d_ptr{ new ModelPrivate{ this } }
+	, d_ptr{ new ModelPrivate{} }
+{
+	Q_D(Model);
+	d->attachFace(this, Mode::Stream, false);
+}
+
+Model::Model(Model const* const sharedWith, QObject* parent)
+	: QAbstractTableModel{ parent }
+	, d_ptr{ sharedWith->d_ptr }
 {
+	Q_D(Model);
+	d->attachFace(this, d->face(sharedWith).mode, false);
 }
 
-Model::~Model() = default;
+Model::~Model()
+{
+	Q_D(Model);
+	d->detachFace(this);
+}
 
 int Model::rowCount(QModelIndex const&) const
 {
 	Q_D(const Model);
+	auto const& face = d->face(this);
 
-	if (!d->_transposed)
-	{
-		return d->talkerSectionCount();
-	}
-	else
-	{
-		return d->listenerSectionCount();
-	}
+	return d->withModeLayout(face.mode,
+		[d, &face]()
+		{
+			return !face.transposed ? d->talkerSectionCount() : d->listenerSectionCount();
+		});
 }
 
 int Model::columnCount(QModelIndex const&) const
 {
 	Q_D(const Model);
+	auto const& face = d->face(this);
 
-	if (!d->_transposed)
-	{
-		return d->listenerSectionCount();
-	}
-	else
-	{
-		return d->talkerSectionCount();
-	}
+	return d->withModeLayout(face.mode,
+		[d, &face]()
+		{
+			return !face.transposed ? d->listenerSectionCount() : d->talkerSectionCount();
+		});
 }
 
 QVariant Model::data(QModelIndex const& index, int role) const
@@ -3017,28 +4621,20 @@ QVariant Model::headerData(int section, Qt::Orientation orientation, int role) c
 
 	if (role == Qt::DisplayRole)
 	{
-		if (!d->_transposed)
-		{
-			if (orientation == Qt::Vertical)
-			{
-				return d->talkerHeaderData(section);
-			}
-			else
-			{
-				return d->listenerHeaderData(section);
-			}
-		}
-		else
-		{
-			if (orientation == Qt::Vertical)
-			{
-				return d->listenerHeaderData(section);
-			}
-			else
+		auto const& face = d->face(this);
+
+		return d->withModeLayout(face.mode,
+			[d, &face, section, orientation]()
 			{
-				return d->talkerHeaderData(section);
-			}
-		}
+				if (orientation == ModelPrivate::talkerOrientation(face))
+				{
+					return d->talkerHeaderData(section);
+				}
+				else
+				{
+					return d->listenerHeaderData(section);
+				}
+			});
 	}
 
 	return {};
@@ -3047,117 +4643,94 @@ QVariant Model::headerData(int section, Qt::Orientation orientation, int role) c
 Node* Model::node(int section, Qt::Orientation orientation) const
 {
 	Q_D(const Model);
+	auto const& face = d->face(this);
 
-	if (!d->_transposed)
-	{
-		if (orientation == Qt::Vertical)
-		{
-			return d->talkerNode(section);
-		}
-		else
-		{
-			return d->listenerNode(section);
-		}
-	}
-	else
-	{
-		if (orientation == Qt::Vertical)
-		{
-			return d->listenerNode(section);
-		}
-		else
+	return d->withModeLayout(face.mode,
+		[d, &face, section, orientation]()
 		{
-			return d->talkerNode(section);
-		}
-	}
+			if (orientation == ModelPrivate::talkerOrientation(face))
+			{
+				return d->talkerNode(section);
+			}
+			else
+			{
+				return d->listenerNode(section);
+			}
+		});
 }
 
 
 int Model::section(Node* node, Qt::Orientation orientation) const
 {
 	Q_D(const Model);
+	auto const& face = d->face(this);
 
-	if (!d->_transposed)
-	{
-		if (orientation == Qt::Vertical)
-		{
-			return priv::indexOf(d->_talkerNodeSectionMap, node);
-		}
-		else
-		{
-			return priv::indexOf(d->_listenerNodeSectionMap, node);
-		}
-	}
-	else
-	{
-		if (orientation == Qt::Vertical)
-		{
-			return priv::indexOf(d->_listenerNodeSectionMap, node);
-		}
-		else
+	return d->withModeLayout(face.mode,
+		[d, &face, node, orientation]()
 		{
-			return priv::indexOf(d->_talkerNodeSectionMap, node);
-		}
-	}
+			if (orientation == ModelPrivate::talkerOrientation(face))
+			{
+				return priv::indexOf(d->_talkerNodes, node);
+			}
+			else
+			{
+				return priv::indexOf(d->_listenerNodes, node);
+			}
+		});
 }
 
-Model::IntersectionData const& Model::intersectionData(QModelIndex const& index) const
+Model::IntersectionData Model::intersectionData(QModelIndex const& index) const
 {
 	Q_D(const Model);
+	auto const& face = d->face(this);
 
-	auto const talkerSection = d->talkerIndex(index);
-	auto const listenerSection = d->listenerIndex(index);
+	auto const talkerSection = ModelPrivate::talkerIndex(face, index);
+	auto const listenerSection = ModelPrivate::listenerIndex(face, index);
 
-	if (!AVDECC_ASSERT_WITH_RET(d->isValidTalkerSection(talkerSection), "invalid talker section") || !AVDECC_ASSERT_WITH_RET(d->isValidListenerSection(listenerSection), "invalid listener section"))
-	{
-		static auto const s_dummyData = Model::IntersectionData{};
-		return s_dummyData;
-	}
+	return d->withModeLayout(face.mode,
+		[d, talkerSection, listenerSection]()
+		{
+			if (!AVDECC_ASSERT_WITH_RET(d->isValidTalkerSection(talkerSection), "invalid talker section") || !AVDECC_ASSERT_WITH_RET(d->isValidListenerSection(listenerSection), "invalid listener section"))
+			{
+				return IntersectionData{};
+			}
 
-	return d->_intersectionData[talkerSection][listenerSection];
+			// Intersection data is lazily computed, which is not a logical change of the model
+			return const_cast<ModelPrivate*>(d)->intersectionDataAt(talkerSection, listenerSection);
+		});
 }
 
 void Model::setMode(Mode const mode)
 {
 	Q_D(Model);
+	auto& face = d->face(this);
 
-	if (mode != d->_mode)
+	if (mode != face.mode)
 	{
 		emit beginResetModel();
-
-		d->_mode = mode;
-		d->clearCachedData();
-
+		d->setFaceMode(face, mode);
 		emit endResetModel();
-
-		// Rebuild the cache data for all known entities
-
-		for (auto const& [entityID, entityNode] : d->_talkerNodeMap)
-		{
-			d->insertTalkerNode(entityNode.get());
-		}
-
-		for (auto const& [entityID, entityNode] : d->_listenerNodeMap)
-		{
-			d->insertListenerNode(entityNode.get());
-		}
 	}
 }
 
 Model::Mode Model::mode() const
 {
 	Q_D(const Model);
-	return d->_mode;
+	return d->face(this).mode;
 }
 
 void Model::setTransposed(bool const transposed)
 {
 	Q_D(Model);
+	auto& face = d->face(this);
 
-	if (transposed != d->_transposed)
+	if (transposed != face.transposed)
 	{
+		// Pending changes are notified with the previous orientation, before the reset
+		d->flushDirtyIntersections();
+
 		emit beginResetModel();
-		d->_transposed = transposed;
+		face.transposed = transposed;
 		emit endResetModel();
 	}
 }
@@ -3165,7 +4738,19 @@ void Model::setTransposed(bool const transposed)
 bool Model::isTransposed() const
 {
 	Q_D(const Model);
-	return d->_transposed;
+	return d->face(this).transposed;
+}
+
+void Model::setActive(bool const isActive)
+{
+	Q_D(Model);
+	d->setFaceActive(d->face(this), isActive);
+}
+
+bool Model::isActive() const
+{
+	Q_D(const Model);
+	return d->face(this).isActive;
 }
 
 void Model::forceRefreshHeaders()
@@ -3174,10 +4759,33 @@ void Model::forceRefreshHeaders()
 	emit headerDataChanged(Qt::Vertical, 0, rowCount());
 }
 
+Model::ConnectedIntersections Model::connectedIntersections() const
+{
+	Q_D(const Model);
+
+	return d->withModeLayout(d->face(this).mode,
+		[d]()
+		{
+			return d->connectedIntersections();
+		});
+}
+
+bool Model::hasConnections(Node* node, Qt::Orientation orientation) const
+{
+	Q_D(const Model);
+
+	if (!node)
+	{
+		return false;
+	}
+
+	return d->hasConnections(node->entityID(), orientation == ModelPrivate::talkerOrientation(d->face(this)));
+}
+
 void Model::accept(Node* node, Visitor const& visitor, bool const childrenOnly) const
 {
 	Q_D(const Model);
-	priv::accept(node, d->_mode, visitor, childrenOnly);
+	priv::accept(node, d->face(this).mode, visitor, childrenOnly);
 }
 
 } // namespace connectionMatrix
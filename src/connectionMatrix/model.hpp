@@ -25,6 +25,7 @@
 #define ENABLE_CONNECTION_MATRIX_TOOLTIP 1
 
 #include <QAbstractTableModel>
+#include <QSharedPointer>
 #include <la/avdecc/utils.hpp>
 #include <la/avdecc/internals/entityModel.hpp>
 
@@ -134,7 +135,20 @@ public:
 #endif
 	};
 
+	// Connected intersection, sections are the talker and listener ones (whatever the transpose state)
+	struct ConnectedIntersection
+	{
+		int talkerSection{ -1 };
+		int listenerSection{ -1 };
+		IntersectionData::State state{ IntersectionData::State::Connected };
+	};
+	using ConnectedIntersections = std::vector<ConnectedIntersection>;
+
 	Model(QObject* parent = nullptr);
+
+	// Creates a model sharing the nodes and the computed intersections of another one (so they are only computed once), with its own mode (initially the same) and transpose state
+	Model(Model const* const sharedWith, QObject* parent = nullptr);
+
 	virtual ~Model();
 
 	virtual int rowCount(QModelIndex const& parent = {}) const override;
@@ -148,10 +162,10 @@ public:
 	// Returns section for the given node and orientation, -1 otherwise
 	int section(Node* node, Qt::Orientation orientation) const;
 
-	// Returns intersection data for the given index
-	IntersectionData const& intersectionData(QModelIndex const& index) const;
+	// Returns intersection data for the given index (built from the compact internal storage, hence returned by value)
+	IntersectionData intersectionData(QModelIndex const& index) const;
 
-	// Set the model mode
+	// Set the model mode (models sharing the same nodes can display different modes)
 	void setMode(Mode const mode);
 
 	// Returns the mode of the model
@@ -163,15 +177,27 @@ public:
 	// Returns the transpose state of the model
 	bool isTransposed() const;
 
+	// Suspend or resume the processing of the controller events (default true), the entities changed in the meantime being resynchronized when activated again
+	void setActive(bool const isActive);
+
+	// Returns the activity state of the model
+	bool isActive() const;
+
 	// Force a refresh of the headers
 	void forceRefreshHeaders();
 
+	// Returns all the connected streams (or channels in Channel mode) intersections, gathered from the cached connections so it's cheap even for a huge matrix
+	ConnectedIntersections connectedIntersections() const;
+
+	// Returns true if the entity of the given node has at least one connected stream (as a talker or a listener according to orientation), from per entity counts so it doesn't depend on the mode
+	bool hasConnections(Node* node, Qt::Orientation orientation) const;
+
 	// Visitor pattern that performs a hierarchy traversal according with respect of the current mode
 	using Visitor = std::function<void(Node*)>;
 	void accept(Node* node, Visitor const& visitor, bool const childrenOnly = false) const;
 
 private:
-	QScopedPointer<ModelPrivate> d_ptr;
+	QSharedPointer<ModelPrivate> d_ptr;
 	Q_DECLARE_PRIVATE(Model);
 };
 
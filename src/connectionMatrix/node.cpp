@@ -132,9 +132,9 @@ int Node::index() const
 
 int Node::indexOf(Node const* child) const
 {
-	auto const predicate = [child](auto const& item)
+	auto const predicate = [child](auto const* item)
 	{
-		return item.get() == child;
+		return item == child;
 	};
 	auto const it = std::find_if(std::begin(_children), std::end(_children), predicate);
 	if (!AVDECC_ASSERT_WITH_RET(it != std::end(_children), "not found"))
@@ -152,7 +152,7 @@ Node* Node::childAt(int index)
 		return nullptr;
 	}
 
-	return _children.at(index).get();
+	return _children.at(index);
 }
 
 Node const* Node::childAt(int index) const
@@ -162,7 +162,7 @@ Node const* Node::childAt(int index) const
 		return nullptr;
 	}
 
-	return _children.at(index).get();
+	return _children.at(index);
 }
 
 int Node::childrenCount() const
@@ -174,12 +174,37 @@ Node::Node(Type const type, la::avdecc::UniqueIdentifier const& entityID, Node*
 	: _type{ type }
 	, _entityID{ entityID }
 	, _parent{ parent }
-	, _name{ avdecc::helper::uniqueIdentifierToString(entityID) }
 {
 	if (_parent)
 	{
-		_parent->_children.emplace_back(this);
+		// Children are always named when created, only entities need a default name
+		_parent->_children.push_back(this);
+		entityNode()->_arenaNodes.push_back(this);
 	}
+	else
+	{
+		_name = avdecc::helper::uniqueIdentifierToString(entityID);
+	}
+}
+
+void* Node::operator new(std::size_t size)
+{
+	return ::operator new(size);
+}
+
+void* Node::operator new(std::size_t size, EntityNode& entity)
+{
+	return entity._arena.allocate(size);
+}
+
+void Node::operator delete(void* ptr) noexcept
+{
+	::operator delete(ptr);
+}
+
+void Node::operator delete(void* /*ptr*/, EntityNode& /*entity*/) noexcept
+{
+	// Only called if the constructor throws, the memory is released with the arena
 }
 
 void Node::setName(QString const& name)
@@ -192,20 +217,38 @@ EntityNode* EntityNode::create(la::avdecc::UniqueIdentifier const& entityID, boo
 	return new EntityNode{ entityID, isMilan };
 }
 
-void EntityNode::accept(la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, AvbInterfaceIndexVisitor const& visitor) const
+EntityNode::~EntityNode()
 {
-	Node::accept(
-		[&avbInterfaceIndex, &visitor](Node* node)
-		{
-			if (node->isStreamNode())
-			{
-				auto* streamNode = static_cast<StreamNode*>(node);
-				if (streamNode->avbInterfaceIndex() == avbInterfaceIndex || avbInterfaceIndex == la::avdecc::entity::Entity::GlobalAvbInterfaceIndex)
-				{
-					visitor(streamNode);
-				}
-			}
-		});
+	// Arena nodes are never deleted individually, destroy them (children first) before the arena is released
+	for (auto it = _arenaNodes.rbegin(); it != _arenaNodes.rend(); ++it)
+	{
+		(*it)->~Node();
+	}
+}
+
+void* EntityNode::Arena::allocate(std::size_t const size)
+{
+	static constexpr auto Alignment = alignof(std::max_align_t);
+	auto const alignedSize = (size + Alignment - 1u) & ~(Alignment - 1u);
+
+	// Oversized nodes get a block of their own, the current one is kept for the next allocations
+	if (alignedSize > BlockSize)
+	{
+		auto block = std::make_unique<std::byte[]>(alignedSize);
+		auto* const ptr = block.get();
+		_blocks.insert(_blocks.empty() ? _blocks.end() : std::prev(_blocks.end()), std::move(block));
+		return ptr;
+	}
+
+	if (_used + alignedSize > BlockSize)
+	{
+		_blocks.push_back(std::make_unique<std::byte[]>(BlockSize));
+		_used = 0u;
+	}
+
+	auto* const ptr = _blocks.back().get() + _used;
+	_used += alignedSize;
+	return ptr;
 }
 
 EntityNode::EntityNode(la::avdecc::UniqueIdentifier const& entityID, bool const isMilan)
@@ -226,12 +269,17 @@ void EntityNode::setStreamPortOutputClusterOffset(la::avdecc::entity::model::Str
 
 void EntityNode::setInputAudioMappings(la::avdecc::entity::model::StreamPortIndex const streamPortInputIndex, la::avdecc::entity::model::AudioMappings const& mappings) noexcept
 {
-	_inputMappings[streamPortInputIndex] = mappings;
+	_inputMappings[streamPortInputIndex] = avdecc::audioMappingKeys::fromMappings(mappings);
 }
 
 void EntityNode::setOutputAudioMappings(la::avdecc::entity::model::StreamPortIndex const streamPortOutputIndex, la::avdecc::entity::model::AudioMappings const& mappings) noexcept
 {
-	_outputMappings[streamPortOutputIndex] = mappings;
+	_outputMappings[streamPortOutputIndex] = avdecc::audioMappingKeys::fromMappings(mappings);
+}
+
+void EntityNode::setRebooting(bool const isRebooting) noexcept
+{
+	_isRebooting = isRebooting;
 }
 
 bool EntityNode::isMilan() const noexcept
@@ -239,6 +287,11 @@ bool EntityNode::isMilan() const noexcept
 	return _isMilan;
 }
 
+bool EntityNode::isRebooting() const noexcept
+{
+	return _isRebooting;
+}
+
 la::avdecc::entity::model::ClusterIndex EntityNode::getStreamPortInputClusterOffset(la::avdecc::entity::model::StreamPortIndex const streamPortIndex) const
 {
 	if (auto const it = _streamPortInputClusterOffset.find(streamPortIndex); it != _streamPortInputClusterOffset.end())
@@ -257,7 +310,7 @@ la::avdecc::entity::model::ClusterIndex EntityNode::getStreamPortOutputClusterOf
 	throw std::invalid_argument("Invalid StreamPortIndex");
 }
 
-la::avdecc::entity::model::AudioMappings const& EntityNode::getInputAudioMappings(la::avdecc::entity::model::StreamPortIndex const streamPortInputIndex) const
+avdecc::audioMappingKeys::Keys const& EntityNode::getInputAudioMappings(la::avdecc::entity::model::StreamPortIndex const streamPortInputIndex) const
 {
 	if (auto const it = _inputMappings.find(streamPortInputIndex); it != _inputMappings.end())
 	{
@@ -266,7 +319,7 @@ la::avdecc::entity::model::AudioMappings const& EntityNode::getInputAudioMapping
 	throw std::invalid_argument("Invalid StreamPortIndex");
 }
 
-la::avdecc::entity::model::AudioMappings const& EntityNode::getOutputAudioMappings(la::avdecc::entity::model::StreamPortIndex const streamPortOutputIndex) const
+avdecc::audioMappingKeys::Keys const& EntityNode::getOutputAudioMappings(la::avdecc::entity::model::StreamPortIndex const streamPortOutputIndex) const
 {
 	if (auto const it = _outputMappings.find(streamPortOutputIndex); it != _outputMappings.end())
 	{
@@ -275,24 +328,24 @@ la::avdecc::entity::model::AudioMappings const& EntityNode::getOutputAudioMappin
 	throw std::invalid_argument("Invalid StreamPortIndex");
 }
 
-std::unordered_map<la::avdecc::entity::model::StreamPortIndex, la::avdecc::entity::model::AudioMappings> EntityNode::getInputAudioMappings() const noexcept
+EntityNode::StreamPortAudioMappingKeys const& EntityNode::getInputAudioMappings() const noexcept
 {
 	return _inputMappings;
 }
 
-std::unordered_map<la::avdecc::entity::model::StreamPortIndex, la::avdecc::entity::model::AudioMappings> EntityNode::getOutputAudioMappings() const noexcept
+EntityNode::StreamPortAudioMappingKeys const& EntityNode::getOutputAudioMappings() const noexcept
 {
 	return _outputMappings;
 }
 
 RedundantNode* RedundantNode::createOutputNode(EntityNode& parent, la::avdecc::controller::model::VirtualIndex const redundantIndex)
 {
-	return new RedundantNode{ Type::RedundantOutput, parent, redundantIndex };
+	return new (parent) RedundantNode{ Type::RedundantOutput, parent, redundantIndex };
 }
 
 RedundantNode* RedundantNode::createInputNode(EntityNode& parent, la::avdecc::controller::model::VirtualIndex const redundantIndex)
 {
-	return new RedundantNode{ Type::RedundantInput, parent, redundantIndex };
+	return new (parent) RedundantNode{ Type::RedundantInput, parent, redundantIndex };
 }
 
 la::avdecc::controller::model::VirtualIndex const& RedundantNode::redundantIndex() const
@@ -310,14 +363,63 @@ bool RedundantNode::isStreaming() const
 	return _isStreaming;
 }
 
-void RedundantNode::setLockedState(TriState const lockedState) noexcept
+void RedundantNode::childLockedStateChanged(TriState const previousLockedState, TriState const lockedState) noexcept
 {
-	_lockedState = lockedState;
+	// Unknown states are not counted, they don't change the summary value
+	switch (previousLockedState)
+	{
+		case TriState::True:
+			AVDECC_ASSERT(_lockedChildrenCount > 0u, "Children count underflow");
+			--_lockedChildrenCount;
+			break;
+		case TriState::False:
+			AVDECC_ASSERT(_unlockedChildrenCount > 0u, "Children count underflow");
+			--_unlockedChildrenCount;
+			break;
+		default:
+			break;
+	}
+	switch (lockedState)
+	{
+		case TriState::True:
+			++_lockedChildrenCount;
+			break;
+		case TriState::False:
+			++_unlockedChildrenCount;
+			break;
+		default:
+			break;
+	}
+
+	// Summary should display UnLock if at least one node is not Locked, Lock if all known nodes are Locked
+	if (_unlockedChildrenCount != 0u)
+	{
+		_lockedState = TriState::False;
+	}
+	else if (_lockedChildrenCount != 0u)
+	{
+		_lockedState = TriState::True;
+	}
+	else
+	{
+		_lockedState = TriState::Unknown;
+	}
 }
 
-void RedundantNode::setIsStreaming(bool const isStreaming) noexcept
+void RedundantNode::childIsStreamingChanged(bool const isStreaming) noexcept
 {
-	_isStreaming = isStreaming;
+	if (isStreaming)
+	{
+		++_streamingChildrenCount;
+	}
+	else
+	{
+		AVDECC_ASSERT(_streamingChildrenCount > 0u, "Children count underflow");
+		--_streamingChildrenCount;
+	}
+
+	// Summary should display as Streaming if at least one node is Streaming
+	_isStreaming = _streamingChildrenCount != 0u;
 }
 
 RedundantNode::RedundantNode(Type const type, EntityNode& parent, la::avdecc::controller::model::VirtualIndex const redundantIndex)
@@ -328,22 +430,22 @@ RedundantNode::RedundantNode(Type const type, EntityNode& parent, la::avdecc::co
 
 StreamNode* StreamNode::createRedundantOutputNode(RedundantNode& parent, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex)
 {
-	return new StreamNode{ Type::RedundantOutputStream, parent, streamIndex, avbInterfaceIndex };
+	return new (*parent.entityNode()) StreamNode{ Type::RedundantOutputStream, parent, streamIndex, avbInterfaceIndex };
 }
 
 StreamNode* StreamNode::createRedundantInputNode(RedundantNode& parent, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex)
 {
-	return new StreamNode{ Type::RedundantInputStream, parent, streamIndex, avbInterfaceIndex };
+	return new (*parent.entityNode()) StreamNode{ Type::RedundantInputStream, parent, streamIndex, avbInterfaceIndex };
 }
 
 StreamNode* StreamNode::createOutputNode(EntityNode& parent, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex)
 {
-	return new StreamNode{ Type::OutputStream, parent, streamIndex, avbInterfaceIndex };
+	return new (parent) StreamNode{ Type::OutputStream, parent, streamIndex, avbInterfaceIndex };
 }
 
 StreamNode* StreamNode::createInputNode(EntityNode& parent, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex)
 {
-	return new StreamNode{ Type::InputStream, parent, streamIndex, avbInterfaceIndex };
+	return new (parent) StreamNode{ Type::InputStream, parent, streamIndex, avbInterfaceIndex };
 }
 
 la::avdecc::entity::model::StreamIndex const& StreamNode::streamIndex() const
@@ -361,6 +463,18 @@ la::avdecc::entity::model::StreamFormat const& StreamNode::streamFormat() const
 	return _streamFormat;
 }
 
+streamFormatCache::FormatID StreamNode::streamFormatID() const
+{
+	return _streamFormatID;
+}
+
+streamFormatCache::FormatIDs const& StreamNode::availableFormatIDs() const
+{
+	static auto const s_noFormatIDs = streamFormatCache::FormatIDs{};
+
+	return _availableFormatIDs ? *_availableFormatIDs : s_noFormatIDs;
+}
+
 la::avdecc::UniqueIdentifier const& StreamNode::grandMasterID() const
 {
 	return _grandMasterID;
@@ -406,6 +520,17 @@ StreamNode::StreamNode(Type const type, Node& parent, la::avdecc::entity::model:
 void StreamNode::setStreamFormat(la::avdecc::entity::model::StreamFormat const streamFormat)
 {
 	_streamFormat = streamFormat;
+	_streamFormatID = streamFormatCache::intern(streamFormat);
+}
+
+void StreamNode::setAvailableFormats(la::avdecc::entity::model::StreamFormats const& streamFormats)
+{
+	_availableFormatIDs = streamFormatCache::internAll(streamFormats);
+}
+
+void StreamNode::setAvailableFormats(streamFormatCache::SharedFormatIDs const& availableFormatIDs)
+{
+	_availableFormatIDs = availableFormatIDs;
 }
 
 void StreamNode::setGrandMasterID(la::avdecc::UniqueIdentifier const grandMasterID)
@@ -439,24 +564,14 @@ bool StreamNode::setProbingStatus(la::avdecc::entity::model::ProbingStatus const
 	return false;
 }
 
-void StreamNode::setMediaLockedCounter(la::avdecc::entity::model::DescriptorCounter const value)
+void StreamNode::setMediaLocked(bool const isMediaLocked)
 {
-	_mediaLockedCounter = value;
+	_isMediaLocked = isMediaLocked;
 }
 
-void StreamNode::setMediaUnlockedCounter(la::avdecc::entity::model::DescriptorCounter const value)
+void StreamNode::setStreamStarted(bool const isStarted)
 {
-	_mediaUnlockedCounter = value;
-}
-
-void StreamNode::setStreamStartCounter(la::avdecc::entity::model::DescriptorCounter const value)
-{
-	_streamStartCounter = value;
-}
-
-void StreamNode::setStreamStopCounter(la::avdecc::entity::model::DescriptorCounter const value)
-{
-	_streamStopCounter = value;
+	_isStreamStarted = isStarted;
 }
 
 void StreamNode::setStreamConnectionState(la::avdecc::entity::model::StreamConnectionState const& streamConnectionState)
@@ -466,54 +581,58 @@ void StreamNode::setStreamConnectionState(la::avdecc::entity::model::StreamConne
 
 void StreamNode::computeLockedState() noexcept
 {
+	auto lockedState = TriState::Unknown;
+
 	// Only if connected
 	if (_streamConnectionState.state == la::avdecc::entity::model::StreamConnectionState::State::Connected)
 	{
 		// If we have ProbingStatus it must be Completed
 		if (!_probingStatus || (*_probingStatus == la::avdecc::entity::model::ProbingStatus::Completed))
 		{
-			// Only if both counters have a valid value
-			if (_mediaLockedCounter && _mediaUnlockedCounter)
+			// Only if the counters have a valid value
+			if (_isMediaLocked)
 			{
-				if (*_mediaLockedCounter == (*_mediaUnlockedCounter + 1))
-				{
-					_lockedState = TriState::True;
-					return;
-				}
-				_lockedState = TriState::False;
-				return;
+				lockedState = *_isMediaLocked ? TriState::True : TriState::False;
 			}
 		}
 	}
 
-	_lockedState = TriState::Unknown;
-	return;
+	if (lockedState != _lockedState)
+	{
+		auto const previousLockedState = _lockedState;
+		_lockedState = lockedState;
+
+		if (isRedundantStreamNode())
+		{
+			static_cast<RedundantNode*>(_parent)->childLockedStateChanged(previousLockedState, lockedState);
+		}
+	}
 }
 
 void StreamNode::computeIsStreaming() noexcept
 {
-	// Only if both counters have a valid value
-	if (_streamStartCounter && _streamStopCounter)
+	// Only if the counters have a valid value
+	auto const isStreaming = _isStreamStarted.value_or(false);
+
+	if (isStreaming != _isStreaming)
 	{
-		if (*_streamStartCounter == (*_streamStopCounter + 1))
+		_isStreaming = isStreaming;
+
+		if (isRedundantStreamNode())
 		{
-			_isStreaming = true;
-			return;
+			static_cast<RedundantNode*>(_parent)->childIsStreamingChanged(isStreaming);
 		}
 	}
-
-	_isStreaming = false;
-	return;
 }
 
 ChannelNode* ChannelNode::createOutputNode(EntityNode& parent, avdecc::ChannelIdentification const& channelIdentification)
 {
-	return new ChannelNode{ Type::OutputChannel, parent, channelIdentification };
+	return new (parent) ChannelNode{ Type::OutputChannel, parent, channelIdentification };
 }
 
 ChannelNode* ChannelNode::createInputNode(EntityNode& parent, avdecc::ChannelIdentification const& channelIdentification)
 {
-	return new ChannelNode{ Type::InputChannel, parent, channelIdentification };
+	return new (parent) ChannelNode{ Type::InputChannel, parent, channelIdentification };
 }
 
 avdecc::ChannelIdentification const& ChannelNode::channelIdentification() const
@@ -21,8 +21,14 @@
 
 #include "avdecc/helper.hpp"
 #include "avdecc/channelConnectionManager.hpp"
+#include "avdecc/audioMappingKeys.hpp"
+#include "connectionMatrix/streamFormatCache.hpp"
 
 #include <optional>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
 
 namespace connectionMatrix
 {
@@ -33,7 +39,7 @@ class Node
 	friend class ModelPrivate;
 
 public:
-	enum class Type
+	enum class Type : std::uint8_t
 	{
 		None,
 
@@ -60,6 +66,12 @@ public:
 
 	virtual ~Node() = default;
 
+	// Entities are individually heap allocated, all the other nodes from the arena of their EntityNode
+	static void* operator new(std::size_t size);
+	static void* operator new(std::size_t size, EntityNode& entity);
+	static void operator delete(void* ptr) noexcept;
+	static void operator delete(void* ptr, EntityNode& entity) noexcept;
+
 	// Returns node type
 	Type type() const;
 
@@ -144,11 +156,11 @@ public:
 		static bool shouldVisit(Node const* const node) noexcept;
 	};
 
-	// Visitor pattern
+	// Visitor pattern, any callable taking a Node* can be used so hot traversals get the visitor inlined (Visitor being the type-erased form)
 	using Visitor = std::function<void(Node*)>;
 
-	template<typename Policy = CompleteHierarchyPolicy>
-	void accept(Visitor const& visitor, bool const childrenOnly = false) const
+	template<typename Policy = CompleteHierarchyPolicy, typename VisitorType = Visitor>
+	void accept(VisitorType const& visitor, bool const childrenOnly = false) const
 	{
 		if (!childrenOnly)
 		{
@@ -158,9 +170,9 @@ public:
 			}
 		}
 
-		for (auto const& child : _children)
+		for (auto const* child : _children)
 		{
-			child->accept<Policy>(visitor, false);
+			child->accept<Policy, VisitorType>(visitor, false);
 		}
 	}
 
@@ -170,7 +182,7 @@ protected:
 	void setName(QString const& name);
 
 protected:
-	// Node type
+	// Node type (kept first, with the parent, for the traversals)
 	Type const _type;
 
 	// Associated entity ID
@@ -182,8 +194,8 @@ protected:
 	// Node name
 	QString _name;
 
-	// Holds the children
-	std::vector<std::unique_ptr<Node>> _children;
+	// Children nodes, owned by the arena of the EntityNode
+	std::vector<Node*> _children;
 };
 
 class EntityNode : public Node
@@ -195,29 +207,57 @@ public:
 
 	// Visitor pattern that is called on every stream node that matches avbInterfaceIndex
 	using AvbInterfaceIndexVisitor = std::function<void(class StreamNode*)>;
-	void accept(la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, AvbInterfaceIndexVisitor const& visitor) const;
+	template<typename VisitorType = AvbInterfaceIndexVisitor>
+	void accept(la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, VisitorType const& visitor) const;
 
 	bool isMilan() const noexcept;
+
+	// Returns true if the entity went offline but is kept during the offline grace period
+	bool isRebooting() const noexcept;
+
 	la::avdecc::entity::model::ClusterIndex getStreamPortInputClusterOffset(la::avdecc::entity::model::StreamPortIndex const streamPortIndex) const;
 	la::avdecc::entity::model::ClusterIndex getStreamPortOutputClusterOffset(la::avdecc::entity::model::StreamPortIndex const streamPortIndex) const;
-	la::avdecc::entity::model::AudioMappings const& getInputAudioMappings(la::avdecc::entity::model::StreamPortIndex const streamPortInputIndex) const;
-	la::avdecc::entity::model::AudioMappings const& getOutputAudioMappings(la::avdecc::entity::model::StreamPortIndex const streamPortOutputIndex) const;
-	std::unordered_map<la::avdecc::entity::model::StreamPortIndex, la::avdecc::entity::model::AudioMappings> getInputAudioMappings() const noexcept;
-	std::unordered_map<la::avdecc::entity::model::StreamPortIndex, la::avdecc::entity::model::AudioMappings> getOutputAudioMappings() const noexcept;
+	// Mappings of the stream ports as sorted packed keys, the mappings of a stream being found with avdecc::audioMappingKeys::streamRange
+	using StreamPortAudioMappingKeys = std::unordered_map<la::avdecc::entity::model::StreamPortIndex, avdecc::audioMappingKeys::Keys>;
+	avdecc::audioMappingKeys::Keys const& getInputAudioMappings(la::avdecc::entity::model::StreamPortIndex const streamPortInputIndex) const;
+	avdecc::audioMappingKeys::Keys const& getOutputAudioMappings(la::avdecc::entity::model::StreamPortIndex const streamPortOutputIndex) const;
+	StreamPortAudioMappingKeys const& getInputAudioMappings() const noexcept;
+	StreamPortAudioMappingKeys const& getOutputAudioMappings() const noexcept;
+
+	virtual ~EntityNode();
 
 protected:
+	friend class Node;
+
+	// Monotonic arena the whole hierarchy of the entity is allocated from, released at once when the entity is destroyed
+	class Arena
+	{
+	public:
+		void* allocate(std::size_t const size);
+
+	private:
+		static constexpr std::size_t BlockSize = 16u * 1024u;
+
+		std::vector<std::unique_ptr<std::byte[]>> _blocks{};
+		std::size_t _used{ BlockSize };
+	};
+
 	EntityNode(la::avdecc::UniqueIdentifier const& entityID, bool const isMilan);
 	void setStreamPortInputClusterOffset(la::avdecc::entity::model::StreamPortIndex const streamPortIndex, la::avdecc::entity::model::ClusterIndex const clusterOffset) noexcept;
 	void setStreamPortOutputClusterOffset(la::avdecc::entity::model::StreamPortIndex const streamPortIndex, la::avdecc::entity::model::ClusterIndex const clusterOffset) noexcept;
 	void setInputAudioMappings(la::avdecc::entity::model::StreamPortIndex const streamPortInputIndex, la::avdecc::entity::model::AudioMappings const& mappings) noexcept;
 	void setOutputAudioMappings(la::avdecc::entity::model::StreamPortIndex const streamPortOutputIndex, la::avdecc::entity::model::AudioMappings const& mappings) noexcept;
+	void setRebooting(bool const isRebooting) noexcept;
 
 protected:
+	Arena _arena{};
+	std::vector<Node*> _arenaNodes{}; // In construction order
 	bool _isMilan{ false };
+	bool _isRebooting{ false };
 	std::unordered_map<la::avdecc::entity::model::StreamPortIndex, la::avdecc::entity::model::ClusterIndex> _streamPortInputClusterOffset{};
 	std::unordered_map<la::avdecc::entity::model::StreamPortIndex, la::avdecc::entity::model::ClusterIndex> _streamPortOutputClusterOffset{};
-	std::unordered_map<la::avdecc::entity::model::StreamPortIndex, la::avdecc::entity::model::AudioMappings> _inputMappings{};
-	std::unordered_map<la::avdecc::entity::model::StreamPortIndex, la::avdecc::entity::model::AudioMappings> _outputMappings{};
+	StreamPortAudioMappingKeys _inputMappings{};
+	StreamPortAudioMappingKeys _outputMappings{};
 };
 
 class RedundantNode : public Node
@@ -238,13 +278,17 @@ public:
 protected:
 	RedundantNode(Type const type, EntityNode& parent, la::avdecc::controller::model::VirtualIndex const redundantIndex);
 
-	void setLockedState(TriState const lockedState) noexcept; // StreamInput only
-	void setIsStreaming(bool const isStreaming) noexcept; // StreamOutput only
+	// Summary states are aggregated incrementally, each child reporting its own state changes
+	void childLockedStateChanged(TriState const previousLockedState, TriState const lockedState) noexcept; // StreamInput only
+	void childIsStreamingChanged(bool const isStreaming) noexcept; // StreamOutput only
 
 protected:
 	la::avdecc::controller::model::VirtualIndex const _redundantIndex;
 	Node::TriState _lockedState{ Node::TriState::Unknown }; // StreamInput only
 	bool _isStreaming{ false }; // StreamOutput only
+	std::size_t _lockedChildrenCount{ 0u }; // StreamInput only
+	std::size_t _unlockedChildrenCount{ 0u }; // StreamInput only
+	std::size_t _streamingChildrenCount{ 0u }; // StreamOutput only
 };
 
 class StreamNode : public Node
@@ -264,6 +308,8 @@ public:
 
 	// Cached data from the controller
 	la::avdecc::entity::model::StreamFormat const& streamFormat() const;
+	streamFormatCache::FormatID streamFormatID() const;
+	streamFormatCache::FormatIDs const& availableFormatIDs() const; // All the formats supported by the stream (from the entity model)
 	la::avdecc::UniqueIdentifier const& grandMasterID() const;
 	std::uint8_t const& grandMasterDomain() const;
 	la::avdecc::controller::ControlledEntity::InterfaceLinkStatus const& interfaceLinkStatus() const;
@@ -276,15 +322,15 @@ protected:
 	StreamNode(Type const type, Node& parent, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex);
 
 	void setStreamFormat(la::avdecc::entity::model::StreamFormat const streamFormat);
+	void setAvailableFormats(la::avdecc::entity::model::StreamFormats const& streamFormats);
+	void setAvailableFormats(streamFormatCache::SharedFormatIDs const& availableFormatIDs);
 	void setGrandMasterID(la::avdecc::UniqueIdentifier const grandMasterID);
 	void setGrandMasterDomain(std::uint8_t const grandMasterDomain);
 	void setInterfaceLinkStatus(la::avdecc::controller::ControlledEntity::InterfaceLinkStatus const interfaceLinkStatus);
 	void setRunning(bool isRunning);
 	bool setProbingStatus(la::avdecc::entity::model::ProbingStatus const probingStatus); // StreamInput only
-	void setMediaLockedCounter(la::avdecc::entity::model::DescriptorCounter const value); // StreamInput only
-	void setMediaUnlockedCounter(la::avdecc::entity::model::DescriptorCounter const value); // StreamInput only
-	void setStreamStartCounter(la::avdecc::entity::model::DescriptorCounter const value); // StreamOutput only
-	void setStreamStopCounter(la::avdecc::entity::model::DescriptorCounter const value); // StreamOutput only
+	void setMediaLocked(bool const isMediaLocked); // StreamInput only
+	void setStreamStarted(bool const isStarted); // StreamOutput only
 	void setStreamConnectionState(la::avdecc::entity::model::StreamConnectionState const& streamConnectionState);
 	void computeLockedState() noexcept;
 	void computeIsStreaming() noexcept;
@@ -293,15 +339,15 @@ protected:
 	la::avdecc::entity::model::StreamIndex const _streamIndex;
 	la::avdecc::entity::model::AvbInterfaceIndex const _avbInterfaceIndex;
 	la::avdecc::entity::model::StreamFormat _streamFormat{ la::avdecc::entity::model::StreamFormat::getNullStreamFormat() };
+	streamFormatCache::FormatID _streamFormatID{ streamFormatCache::NullFormatID };
+	streamFormatCache::SharedFormatIDs _availableFormatIDs{};
 	la::avdecc::UniqueIdentifier _grandMasterID;
 	std::uint8_t _grandMasterDomain;
 	la::avdecc::controller::ControlledEntity::InterfaceLinkStatus _interfaceLinkStatus{ la::avdecc::controller::ControlledEntity::InterfaceLinkStatus::Unknown };
 	bool _isRunning{ true };
 	std::optional<la::avdecc::entity::model::ProbingStatus> _probingStatus{ std::nullopt }; // StreamInput only
-	std::optional<la::avdecc::entity::model::DescriptorCounter> _mediaLockedCounter{ std::nullopt }; // StreamInput only
-	std::optional<la::avdecc::entity::model::DescriptorCounter> _mediaUnlockedCounter{ std::nullopt }; // StreamInput only
-	std::optional<la::avdecc::entity::model::DescriptorCounter> _streamStartCounter{ std::nullopt }; // StreamOutput only
-	std::optional<la::avdecc::entity::model::DescriptorCounter> _streamStopCounter{ std::nullopt }; // StreamOutput only
+	std::optional<bool> _isMediaLocked{ std::nullopt }; // StreamInput only (from the counters)
+	std::optional<bool> _isStreamStarted{ std::nullopt }; // StreamOutput only (from the counters)
 	la::avdecc::entity::model::StreamConnectionState _streamConnectionState{};
 	Node::TriState _lockedState{ Node::TriState::Unknown }; // StreamInput only
 	bool _isStreaming{ false }; // StreamOutput only
@@ -328,4 +374,18 @@ protected:
 	avdecc::ChannelIdentification const _channelIdentification;
 };
 
+template<typename VisitorType>
+void EntityNode::accept(la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, VisitorType const& visitor) const
+{
+	Node::accept<StreamPolicy>(
+		[&avbInterfaceIndex, &visitor](Node* node)
+		{
+			auto* streamNode = static_cast<StreamNode*>(node);
+			if (streamNode->avbInterfaceIndex() == avbInterfaceIndex || avbInterfaceIndex == la::avdecc::entity::Entity::GlobalAvbInterfaceIndex)
+			{
+				visitor(streamNode);
+			}
+		});
+}
+
 } // namespace connectionMatrix
@@ -0,0 +1,115 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "connectionMatrix/nodeTemplateCache.hpp"
+#include "avdecc/controllerManager.hpp"
+
+#include <map>
+#include <utility>
+
+namespace connectionMatrix
+{
+namespace nodeTemplateCache
+{
+static std::map<std::pair<std::uint64_t, la::avdecc::entity::model::ConfigurationIndex>, SharedEntityTemplate> s_templates{}; // Keyed by EntityModelID and ConfigurationIndex
+
+template<class ClusterNodes>
+static void addClusterChannelNames(EntityTemplate& entityTemplate, la::avdecc::controller::ControlledEntity const& controlledEntity, ClusterNodes const& clusterNodes)
+{
+	for (auto const& [clusterIndex, clusterNode] : clusterNodes)
+	{
+		auto const clusterName = QString{ controlledEntity.getLocalizedString(clusterNode.staticModel->localizedDescription).data() };
+		auto& names = entityTemplate.clusterChannelNames[clusterIndex];
+		names.reserve(clusterNode.staticModel->channelCount);
+		for (auto channel = std::uint16_t{ 0u }; channel < clusterNode.staticModel->channelCount; ++channel)
+		{
+			names.push_back(clusterChannelName(clusterName, channel));
+		}
+	}
+}
+
+static SharedEntityTemplate buildTemplate(la::avdecc::controller::ControlledEntity const& controlledEntity, la::avdecc::controller::model::ConfigurationNode const& configurationNode)
+{
+	auto entityTemplate = std::make_shared<EntityTemplate>();
+
+	for (auto const& [streamIndex, streamNode] : configurationNode.streamOutputs)
+	{
+		entityTemplate->streamOutputFormats[streamIndex] = streamFormatCache::internAll(streamNode.staticModel->formats);
+	}
+	for (auto const& [streamIndex, streamNode] : configurationNode.streamInputs)
+	{
+		entityTemplate->streamInputFormats[streamIndex] = streamFormatCache::internAll(streamNode.staticModel->formats);
+	}
+
+	for (auto const& audioUnitKV : configurationNode.audioUnits)
+	{
+		auto const& audioUnitNode = audioUnitKV.second;
+		for (auto const& streamPortKV : audioUnitNode.streamPortOutputs)
+		{
+			addClusterChannelNames(*entityTemplate, controlledEntity, streamPortKV.second.audioClusters);
+		}
+		for (auto const& streamPortKV : audioUnitNode.streamPortInputs)
+		{
+			addClusterChannelNames(*entityTemplate, controlledEntity, streamPortKV.second.audioClusters);
+		}
+	}
+
+	return entityTemplate;
+}
+
+SharedEntityTemplate getTemplate(la::avdecc::controller::ControlledEntity const& controlledEntity, la::avdecc::controller::model::ConfigurationNode const& configurationNode) noexcept
+{
+	ASSERT_QT_MAIN_THREAD;
+
+	auto const entityModelID = controlledEntity.getEntity().getEntityModelID();
+	if (!entityModelID)
+	{
+		return nullptr;
+	}
+
+	auto& entityTemplate = s_templates[{ entityModelID.getValue(), configurationNode.descriptorIndex }];
+	if (!entityTemplate)
+	{
+		try
+		{
+			entityTemplate = buildTemplate(controlledEntity, configurationNode);
+		}
+		catch (...)
+		{
+			// Incomplete model, don't share it (the entity will be built without template)
+			s_templates.erase({ entityModelID.getValue(), configurationNode.descriptorIndex });
+			return nullptr;
+		}
+	}
+	return entityTemplate;
+}
+
+QString clusterChannelName(QString const& clusterName, std::uint16_t const channel) noexcept
+{
+	// It is assumed that if channel == 0, the channel is not displayed
+	if (channel > 0)
+	{
+		return QString{ "%1.%2" }.arg(clusterName).arg(channel);
+	}
+
+	return clusterName;
+}
+
+} // namespace nodeTemplateCache
+} // namespace connectionMatrix
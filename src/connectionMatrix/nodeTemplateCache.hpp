@@ -0,0 +1,52 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "connectionMatrix/streamFormatCache.hpp"
+
+#include <la/avdecc/controller/avdeccController.hpp>
+#include <QString>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace connectionMatrix
+{
+namespace nodeTemplateCache
+{
+/** Static part of the nodes of an entity configuration, shared by all the entities with the same EntityModelID */
+struct EntityTemplate
+{
+	std::unordered_map<la::avdecc::entity::model::StreamIndex, streamFormatCache::SharedFormatIDs> streamOutputFormats{};
+	std::unordered_map<la::avdecc::entity::model::StreamIndex, streamFormatCache::SharedFormatIDs> streamInputFormats{};
+	std::unordered_map<la::avdecc::entity::model::ClusterIndex, std::vector<QString>> clusterChannelNames{}; // From the localized description, only valid when the cluster has no dynamic name
+};
+
+using SharedEntityTemplate = std::shared_ptr<EntityTemplate const>;
+
+// Returns the template of the configuration, built the first time its EntityModelID is seen, nullptr if the entity has no EntityModelID (Qt Main Thread only)
+SharedEntityTemplate getTemplate(la::avdecc::controller::ControlledEntity const& controlledEntity, la::avdecc::controller::model::ConfigurationNode const& configurationNode) noexcept;
+// Returns the name of a channel of a cluster (the cluster name alone for channel 0)
+QString clusterChannelName(QString const& clusterName, std::uint16_t const channel) noexcept;
+
+} // namespace nodeTemplateCache
+} // namespace connectionMatrix
@@ -20,6 +20,11 @@
 #include "connectionMatrix/paintHelper.hpp"
 #include "toolkit/material/color.hpp"
 
+#include <QPixmap>
+
+#include <cstdint>
+#include <unordered_map>
+
 namespace color = qt::toolkit::material::color;
 
 namespace connectionMatrix
@@ -193,7 +198,7 @@ QPainterPath buildHeaderArrowPath(QRect const& rect, Qt::Orientation const orien
 	return path;
 }
 
-void drawCapabilities(QPainter* painter, QRect const& rect, Model::IntersectionData::Type const type, Model::IntersectionData::State const state, Model::IntersectionData::Flags const& flags)
+static void renderCapabilities(QPainter* painter, QRect const& rect, Model::IntersectionData::Type const type, Model::IntersectionData::State const state, Model::IntersectionData::Flags const& flags)
 {
 	painter->setRenderHint(QPainter::Antialiasing);
 	painter->setRenderHint(QPainter::HighQualityAntialiasing);
@@ -256,5 +261,76 @@ void drawCapabilities(QPainter* painter, QRect const& rect, Model::IntersectionD
 	}
 }
 
+// Pre-rendered capabilities glyphs, only accessed from the Qt Main Thread (painting)
+static std::unordered_map<std::uint64_t, QPixmap> s_capabilitiesAtlas{};
+static constexpr auto MaxCapabilitiesAtlasSize = std::size_t{ 1024u };
+
+static inline std::uint64_t makeCapabilitiesKey(QSize const& size, qreal const devicePixelRatio, Model::IntersectionData::Type const type, Model::IntersectionData::State const state, Model::IntersectionData::Flags const& flags)
+{
+	auto const width = static_cast<std::uint64_t>(size.width()) & 0xFFFF;
+	auto const height = static_cast<std::uint64_t>(size.height()) & 0xFFFF;
+	auto const ratio = static_cast<std::uint64_t>(qRound(devicePixelRatio * 100)) & 0xFFFF;
+	auto const typeValue = static_cast<std::uint64_t>(la::avdecc::utils::to_integral(type)) & 0xFF;
+	auto const stateValue = static_cast<std::uint64_t>(la::avdecc::utils::to_integral(state)) & 0xF;
+	auto const flagsValue = static_cast<std::uint64_t>(flags.value()) & 0xF;
+
+	return (width << 48) | (height << 32) | (ratio << 16) | (typeValue << 8) | (stateValue << 4) | flagsValue;
+}
+
+void drawCapabilities(QPainter* painter, QRect const& rect, Model::IntersectionData::Type const type, Model::IntersectionData::State const state, Model::IntersectionData::Flags const& flags)
+{
+	if (rect.isEmpty())
+	{
+		return;
+	}
+
+	auto const devicePixelRatio = painter->device() ? painter->device()->devicePixelRatioF() : qreal{ 1.0 };
+	auto const key = makeCapabilitiesKey(rect.size(), devicePixelRatio, type, state, flags);
+
+	auto it = s_capabilitiesAtlas.find(key);
+	if (it == std::end(s_capabilitiesAtlas))
+	{
+		// Different sizes are only expected when zooming or changing screens, just start over if the atlas grows too much
+		if (s_capabilitiesAtlas.size() >= MaxCapabilitiesAtlasSize)
+		{
+			s_capabilitiesAtlas.clear();
+		}
+
+		auto pixmap = QPixmap{ rect.size() * devicePixelRatio };
+		pixmap.setDevicePixelRatio(devicePixelRatio);
+		pixmap.fill(Qt::transparent);
+		{
+			auto pixmapPainter = QPainter{ &pixmap };
+			renderCapabilities(&pixmapPainter, QRect{ QPoint{ 0, 0 }, rect.size() }, type, state, flags);
+		}
+
+		it = s_capabilitiesAtlas.emplace(key, std::move(pixmap)).first;
+	}
+
+	painter->drawPixmap(rect.topLeft(), it->second);
+}
+
+QImage renderCapabilitiesImage(QSize const& size, Model::IntersectionData::Type const type, Model::IntersectionData::State const state, Model::IntersectionData::Flags const& flags)
+{
+	auto image = QImage{ size, QImage::Format_ARGB32_Premultiplied };
+	image.fill(Qt::transparent);
+	if (!size.isEmpty())
+	{
+		auto imagePainter = QPainter{ &image };
+		renderCapabilities(&imagePainter, QRect{ QPoint{ 0, 0 }, size }, type, state, flags);
+	}
+	return image;
+}
+
+void clearCapabilitiesCache()
+{
+	s_capabilitiesAtlas.clear();
+}
+
+QColor connectionColor(Model::IntersectionData::State const state, Model::IntersectionData::Flags const& flags)
+{
+	return getConnectionBrushColor(state, flags, false);
+}
+
 } // namespace paintHelper
 } // namespace connectionMatrix
@@ -21,6 +21,8 @@
 
 #include "connectionMatrix/model.hpp"
 
+#include <QColor>
+#include <QImage>
 #include <QRect>
 #include <QPainter>
 #include <QPainterPath>
@@ -30,7 +32,14 @@ namespace connectionMatrix
 namespace paintHelper
 {
 QPainterPath buildHeaderArrowPath(QRect const& rect, Qt::Orientation const orientation, bool const isTransposed, bool const alwaysShowArrowTip, bool const alwaysShowArrowEnd, int const arrowOffset, int const arrowSize, int const width);
+// Draws the capabilities glyph, using a pre-rendered pixmap for each (type, state, flags, size, device pixel ratio) combination
 void drawCapabilities(QPainter* painter, QRect const& rect, Model::IntersectionData::Type const type, Model::IntersectionData::State const state, Model::IntersectionData::Flags const& flags);
+// Renders a capabilities glyph in a new image, without using the pre-rendered pixmaps (can be called from any thread)
+QImage renderCapabilitiesImage(QSize const& size, Model::IntersectionData::Type const type, Model::IntersectionData::State const state, Model::IntersectionData::Flags const& flags);
+// Clears all pre-rendered capabilities glyphs (render them again next time they are drawn)
+void clearCapabilitiesCache();
+// Returns the color of a connection glyph
+QColor connectionColor(Model::IntersectionData::State const state, Model::IntersectionData::Flags const& flags = {});
 
 } // namespace paintHelper
 } // namespace connectionMatrix
@@ -0,0 +1,159 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "connectionMatrix/streamFormatCache.hpp"
+#include "avdecc/controllerManager.hpp"
+#include "avdecc/idleScheduler.hpp"
+
+#include <la/avdecc/internals/streamFormatInfo.hpp>
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+namespace connectionMatrix
+{
+namespace streamFormatCache
+{
+/** Compatibility of a listener format with all the talker formats, 2 bits per talker format ID */
+struct CompatibilityRow
+{
+	std::vector<std::uint64_t> computed{};
+	std::vector<std::uint64_t> compatible{};
+};
+
+static std::vector<la::avdecc::entity::model::StreamFormat> s_formats{ la::avdecc::entity::model::StreamFormat::getNullStreamFormat() };
+static std::unordered_map<std::uint64_t, FormatID> s_formatIDs{ { la::avdecc::entity::model::StreamFormat::getNullStreamFormat().getValue(), NullFormatID } };
+static std::vector<CompatibilityRow> s_compatibility{}; // Indexed by listener FormatID
+static std::pair<FormatID, FormatID> s_warmupCursor{ NullFormatID, NullFormatID }; // Next (listener, talker) pair to precompute
+
+static constexpr auto WarmupPairsPerStep = 64u;
+
+/** Precomputes the compatibility of a few format pairs, returns true once all the interned formats are done */
+static bool warmupCompatibility() noexcept
+{
+	auto const formatsCount = static_cast<FormatID>(s_formats.size());
+	auto& [listenerFormatID, talkerFormatID] = s_warmupCursor;
+	for (auto count = 0u; count < WarmupPairsPerStep; ++count)
+	{
+		if (listenerFormatID >= formatsCount)
+		{
+			return true;
+		}
+		isListenerFormatCompatibleWithTalkerFormat(listenerFormatID, talkerFormatID);
+		if (++talkerFormatID >= formatsCount)
+		{
+			talkerFormatID = NullFormatID;
+			++listenerFormatID;
+		}
+	}
+	return listenerFormatID >= formatsCount;
+}
+
+FormatID intern(la::avdecc::entity::model::StreamFormat const streamFormat) noexcept
+{
+	ASSERT_QT_MAIN_THREAD;
+
+	auto const [it, inserted] = s_formatIDs.emplace(streamFormat.getValue(), static_cast<FormatID>(s_formats.size()));
+	if (inserted)
+	{
+		s_formats.push_back(streamFormat);
+
+		// The new format has to be checked against all the others, restart the precomputation from the beginning (already computed pairs are cheap to skip)
+		s_warmupCursor = { NullFormatID, NullFormatID };
+		avdecc::IdleScheduler::getInstance().scheduleStep("Stream format compatibility", &warmupCompatibility);
+	}
+	return it->second;
+}
+
+SharedFormatIDs internAll(la::avdecc::entity::model::StreamFormats const& streamFormats) noexcept
+{
+	auto formatIDs = FormatIDs{};
+	formatIDs.reserve(streamFormats.size());
+	for (auto const& streamFormat : streamFormats)
+	{
+		formatIDs.push_back(intern(streamFormat));
+	}
+	return std::make_shared<FormatIDs const>(std::move(formatIDs));
+}
+
+la::avdecc::entity::model::StreamFormat streamFormat(FormatID const formatID) noexcept
+{
+	if (formatID < s_formats.size())
+	{
+		return s_formats[formatID];
+	}
+	return la::avdecc::entity::model::StreamFormat::getNullStreamFormat();
+}
+
+bool isListenerFormatCompatibleWithTalkerFormat(FormatID const listenerFormatID, FormatID const talkerFormatID) noexcept
+{
+	ASSERT_QT_MAIN_THREAD;
+
+	if (listenerFormatID >= s_formats.size() || talkerFormatID >= s_formats.size())
+	{
+		return false;
+	}
+
+	if (listenerFormatID >= s_compatibility.size())
+	{
+		s_compatibility.resize(listenerFormatID + 1u);
+	}
+
+	auto& row = s_compatibility[listenerFormatID];
+	auto const word = talkerFormatID / 64u;
+	auto const bit = std::uint64_t{ 1u } << (talkerFormatID % 64u);
+	if (word >= row.computed.size())
+	{
+		row.computed.resize(word + 1u, 0u);
+		row.compatible.resize(word + 1u, 0u);
+	}
+
+	if ((row.computed[word] & bit) == 0u)
+	{
+		row.computed[word] |= bit;
+		if (la::avdecc::entity::model::StreamFormatInfo::isListenerFormatCompatibleWithTalkerFormat(s_formats[listenerFormatID], s_formats[talkerFormatID]))
+		{
+			row.compatible[word] |= bit;
+		}
+	}
+
+	return (row.compatible[word] & bit) != 0u;
+}
+
+bool hasCompatibleListenerFormat(FormatIDs const& listenerFormatIDs, FormatID const talkerFormatID) noexcept
+{
+	return std::any_of(std::begin(listenerFormatIDs), std::end(listenerFormatIDs),
+		[talkerFormatID](auto const listenerFormatID)
+		{
+			return isListenerFormatCompatibleWithTalkerFormat(listenerFormatID, talkerFormatID);
+		});
+}
+
+bool hasCompatibleTalkerFormat(FormatID const listenerFormatID, FormatIDs const& talkerFormatIDs) noexcept
+{
+	return std::any_of(std::begin(talkerFormatIDs), std::end(talkerFormatIDs),
+		[listenerFormatID](auto const talkerFormatID)
+		{
+			return isListenerFormatCompatibleWithTalkerFormat(listenerFormatID, talkerFormatID);
+		});
+}
+
+} // namespace streamFormatCache
+} // namespace connectionMatrix
@@ -0,0 +1,53 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/internals/entityModelTypes.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace connectionMatrix
+{
+namespace streamFormatCache
+{
+/** Small ID of an interned StreamFormat (only valid during the application lifetime, 0 being the null StreamFormat) */
+using FormatID = std::uint32_t;
+using FormatIDs = std::vector<FormatID>;
+using SharedFormatIDs = std::shared_ptr<FormatIDs const>; // Shared by all the streams with the same static formats list
+
+static constexpr auto NullFormatID = FormatID{ 0u };
+
+// Returns the ID of a StreamFormat, interning it the first time it is seen (Qt Main Thread only)
+FormatID intern(la::avdecc::entity::model::StreamFormat const streamFormat) noexcept;
+// Returns the IDs of all the StreamFormats, interning them if needed (Qt Main Thread only)
+SharedFormatIDs internAll(la::avdecc::entity::model::StreamFormats const& streamFormats) noexcept;
+// Returns the StreamFormat of an ID returned by intern
+la::avdecc::entity::model::StreamFormat streamFormat(FormatID const formatID) noexcept;
+// Returns true if the listener format is compatible with the talker format. Computed once per pair, then a bit test
+bool isListenerFormatCompatibleWithTalkerFormat(FormatID const listenerFormatID, FormatID const talkerFormatID) noexcept;
+// Returns true if one of the listener available formats is compatible with the talker format
+bool hasCompatibleListenerFormat(FormatIDs const& listenerFormatIDs, FormatID const talkerFormatID) noexcept;
+// Returns true if the listener format is compatible with one of the talker available formats
+bool hasCompatibleTalkerFormat(FormatID const listenerFormatID, FormatIDs const& talkerFormatIDs) noexcept;
+
+} // namespace streamFormatCache
+} // namespace connectionMatrix
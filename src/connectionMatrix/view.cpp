@@ -23,25 +23,130 @@
 #include "connectionMatrix/headerView.hpp"
 #include "connectionMatrix/itemDelegate.hpp"
 #include "connectionMatrix/cornerWidget.hpp"
+#include "connectionMatrix/minimap.hpp"
+#include "connectionMatrix/paintHelper.hpp"
+#include "connectionMatrix/matrixExport.hpp"
 #include "avdecc/controllerManager.hpp"
+#include "avdecc/bandwidthAccounting.hpp"
 #include "avdecc/helper.hpp"
 #include "avdecc/hiveLogItems.hpp"
 
 #include <QMouseEvent>
+#include <QPaintEvent>
+#include <QScrollBar>
 #include <QMessageBox>
 #include <QMenu>
 #include <QApplication>
+#include <QRubberBand>
+
+#include <algorithm>
+#include <map>
+#include <optional>
 
 namespace connectionMatrix
 {
+/** Size (in pixels, both directions) of a render cache tile */
+static constexpr auto TileSize = 256;
+/** Maximum number of cached tiles, the cache is cleared when reached (a full screen of a 4K display is about 150 tiles) */
+static constexpr auto MaxTiles = std::size_t{ 256u };
+/** Distance between the minimap and the viewport borders */
+static constexpr auto MinimapMargin = 8;
+
+static std::uint64_t makeTileKey(int const tileColumn, int const tileRow)
+{
+	return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(tileRow)) << 32) | static_cast<std::uint32_t>(tileColumn);
+}
+
+// Calls visitor(logicalIndex, position, size) for each visible section of header intersecting [start, start + length[ (in header content coordinates)
+template<typename Visitor>
+static void forEachSection(QHeaderView const* const header, int const start, int const length, Visitor&& visitor)
+{
+	auto visualIndex = header->visualIndexAt(start - header->offset());
+	if (visualIndex == -1)
+	{
+		return;
+	}
+
+	for (; visualIndex < header->count(); ++visualIndex)
+	{
+		auto const logicalIndex = header->logicalIndex(visualIndex);
+		if (header->isSectionHidden(logicalIndex))
+		{
+			continue;
+		}
+
+		auto const position = header->sectionPosition(logicalIndex);
+		if (position >= start + length)
+		{
+			break;
+		}
+
+		visitor(logicalIndex, position, header->sectionSize(logicalIndex));
+	}
+}
+
+// Returns the [begin, end[ span (in header content coordinates) covered by the visible sections between first and last
+static std::optional<std::pair<int, int>> sectionsSpan(QHeaderView const* const header, int first, int last)
+{
+	while (first <= last && header->isSectionHidden(first))
+	{
+		++first;
+	}
+	while (last >= first && header->isSectionHidden(last))
+	{
+		--last;
+	}
+
+	if (first > last)
+	{
+		return std::nullopt;
+	}
+
+	return std::make_pair(header->sectionPosition(first), header->sectionPosition(last) + header->sectionSize(last));
+}
+
+static QString channelConnectResultToString(avdecc::ChannelConnectionManager::ChannelConnectResult const result)
+{
+	switch (result)
+	{
+		case avdecc::ChannelConnectionManager::ChannelConnectResult::RemovalOfListenerDynamicMappingsNecessary:
+			return "Removal of the unused listener mappings necessary";
+		case avdecc::ChannelConnectionManager::ChannelConnectResult::NeedsTalkerMappingAdjustment:
+			return "Talker mappings adjustment refused";
+		case avdecc::ChannelConnectionManager::ChannelConnectResult::Impossible:
+			return "All compatible streams already occupied";
+		case avdecc::ChannelConnectionManager::ChannelConnectResult::Unsupported:
+			return "Unsupported device";
+		default:
+			return "Unknown error";
+	}
+}
+
 View::View(QWidget* parent)
+	: View{ std::make_unique<Model>(), true, parent }
+{
+}
+
+View::View(View const* const sharedWith, QWidget* parent)
+	: View{ std::make_unique<Model>(sharedWith->_model.get()), false, parent }
+{
+	// Start with the same mode and orientation as the other view
+	setTransposed(sharedWith->isTransposed());
+}
+
+View::View(std::unique_ptr<Model>&& model, bool const followModeSettings, QWidget* parent)
 	: QTableView{ parent }
-	, _model{ std::make_unique<Model>() }
+	, _model{ std::move(model) }
+	, _followModeSettings{ followModeSettings }
 	, _horizontalHeaderView{ std::make_unique<HeaderView>(Qt::Horizontal, this) }
 	, _verticalHeaderView{ std::make_unique<HeaderView>(Qt::Vertical, this) }
 	, _itemDelegate{ std::make_unique<ItemDelegate>(this) }
 	, _cornerWidget{ std::make_unique<CornerWidget>(this) }
+	, _minimap{ std::make_unique<Minimap>(this, _model.get(), this) }
+	, _rubberBand{ std::make_unique<QRubberBand>(QRubberBand::Rectangle, viewport()) }
 {
+	// The model only processes the controller events while the view is shown
+	_model->setActive(false);
 	setModel(_model.get());
 	setHorizontalHeader(_horizontalHeaderView.get());
 	setVerticalHeader(_verticalHeaderView.get());
@@ -55,8 +160,15 @@ View::View(QWidget* parent)
 	setCornerButtonEnabled(false);
 	stackUnder(_cornerWidget.get());
 
-	// Apply filter when needed
-	connect(_cornerWidget.get(), &CornerWidget::filterChanged, this, &View::onFilterChanged);
+	// Apply filter when needed, once the typing paused
+	connect(_cornerWidget.get(), &CornerWidget::filterChanged, &_filterDebouncer, &qt::toolkit::FilterExpressionDebouncer::setPattern);
+	connect(&_filterDebouncer, &qt::toolkit::FilterExpressionDebouncer::expressionChanged, this, &View::applyFilterPattern);
+	connect(_cornerWidget.get(), &CornerWidget::connectedOnlyChanged, this,
+		[this](bool const connectedOnly)
+		{
+			_verticalHeaderView->setConnectedOnly(connectedOnly);
+			_horizontalHeaderView->setConnectedOnly(connectedOnly);
+		});
 
 	connect(_cornerWidget.get(), &CornerWidget::horizontalExpandClicked, _horizontalHeaderView.get(), &HeaderView::expandAll);
 	connect(_cornerWidget.get(), &CornerWidget::horizontalCollapseClicked, _horizontalHeaderView.get(), &HeaderView::collapseAll);
@@ -73,6 +185,28 @@ View::View(QWidget* parent)
 	connect(_verticalHeaderView.get(), &QHeaderView::geometriesChanged, this, updateCornerWidgetGeometry);
 	connect(_horizontalHeaderView.get(), &QHeaderView::geometriesChanged, this, updateCornerWidgetGeometry);
 
+	// Invalidate the render cache when intersections change, or when they move
+	connect(_model.get(), &QAbstractItemModel::dataChanged, this, &View::invalidateTiles);
+
+	// Bandwidth warnings are drawn over the cached tiles, only a repaint is needed
+	connect(&avdecc::bandwidth::BandwidthAccountingManager::getInstance(), &avdecc::bandwidth::BandwidthAccountingManager::oversubscriptionChanged, viewport(),
+		[this]()
+		{
+			viewport()->update();
+		});
+	connect(_model.get(), &QAbstractItemModel::modelReset, this, &View::clearTiles);
+	connect(_model.get(), &QAbstractItemModel::layoutChanged, this, &View::clearTiles);
+	for (auto const& signal : { &QAbstractItemModel::rowsInserted, &QAbstractItemModel::rowsRemoved, &QAbstractItemModel::columnsInserted, &QAbstractItemModel::columnsRemoved })
+	{
+		connect(_model.get(), signal, this, &View::clearTiles);
+	}
+	for (auto* header : { _verticalHeaderView.get(), _horizontalHeaderView.get() })
+	{
+		// Hiding or showing a section (filter, collapse) resizes it
+		connect(header, &QHeaderView::sectionResized, this, &View::clearTiles);
+		connect(header, &QHeaderView::sectionCountChanged, this, &View::clearTiles);
+	}
+
 	// Handle click on the table
 	connect(this, &QTableView::clicked, this, &View::onIntersectionClicked);
 
@@ -84,8 +218,11 @@ View::View(QWidget* parent)
 	auto& settings = settings::SettingsManager::getInstance();
 	settings.registerSettingObserver(settings::ConnectionMatrix_AlwaysShowArrowTip.name, this);
 	settings.registerSettingObserver(settings::ConnectionMatrix_AlwaysShowArrowEnd.name, this);
-	settings.registerSettingObserver(settings::ConnectionMatrix_Transpose.name, this);
-	settings.registerSettingObserver(settings::ConnectionMatrix_ChannelMode.name, this);
+	if (_followModeSettings)
+	{
+		settings.registerSettingObserver(settings::ConnectionMatrix_Transpose.name, this);
+		settings.registerSettingObserver(settings::ConnectionMatrix_ChannelMode.name, this);
+	}
 	settings.registerSettingObserver(settings::General_ThemeColorIndex.name, this);
 
 	// react on connection completed signals to show error messages.
@@ -99,11 +236,148 @@ View::~View()
 	auto& settings = settings::SettingsManager::getInstance();
 	settings.unregisterSettingObserver(settings::ConnectionMatrix_AlwaysShowArrowTip.name, this);
 	settings.unregisterSettingObserver(settings::ConnectionMatrix_AlwaysShowArrowEnd.name, this);
-	settings.unregisterSettingObserver(settings::ConnectionMatrix_Transpose.name, this);
-	settings.unregisterSettingObserver(settings::ConnectionMatrix_ChannelMode.name, this);
+	if (_followModeSettings)
+	{
+		settings.unregisterSettingObserver(settings::ConnectionMatrix_Transpose.name, this);
+		settings.unregisterSettingObserver(settings::ConnectionMatrix_ChannelMode.name, this);
+	}
 	settings.unregisterSettingObserver(settings::General_ThemeColorIndex.name, this);
 }
 
+void View::setChannelMode(bool const channelMode)
+{
+	_model->setMode(channelMode ? Model::Mode::Channel : Model::Mode::Stream);
+
+	forceFilter();
+}
+
+bool View::isChannelMode() const
+{
+	return _model->mode() == Model::Mode::Channel;
+}
+
+void View::setTransposed(bool const transposed)
+{
+	if (transposed == _model->isTransposed())
+	{
+		return;
+	}
+
+	// Intersections are kept by the model, and the headers exchange their state (including the filter result) so nothing has to be computed again
+	auto const verticalState = _verticalHeaderView->saveState();
+	auto const horizontalState = _horizontalHeaderView->saveState();
+	auto const verticalScrollValue = verticalScrollBar()->value();
+	auto const horizontalScrollValue = horizontalScrollBar()->value();
+
+	_model->setTransposed(transposed);
+	_cornerWidget->setTransposed(transposed);
+	_verticalHeaderView->setTransposed(transposed);
+	_horizontalHeaderView->setTransposed(transposed);
+
+	_verticalHeaderView->restoreState(horizontalState);
+	_horizontalHeaderView->restoreState(verticalState);
+
+	// Keep the same intersections in the top left corner
+	updateGeometries();
+	verticalScrollBar()->setValue(horizontalScrollValue);
+	horizontalScrollBar()->setValue(verticalScrollValue);
+}
+
+bool View::isTransposed() const
+{
+	return _model->isTransposed();
+}
+
+bool View::focusEntity(la::avdecc::UniqueIdentifier const& entityID)
+{
+	auto const talkerOrientation = _model->isTransposed() ? Qt::Horizontal : Qt::Vertical;
+	return focusSection(talkerOrientation, entityID,
+		[](Node* node)
+		{
+			return node->isEntityNode();
+		});
+}
+
+bool View::focusStream(la::avdecc::UniqueIdentifier const& entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex)
+{
+	auto const isTalker = descriptorType == la::avdecc::entity::model::DescriptorType::StreamOutput;
+	auto const orientation = isTalker != _model->isTransposed() ? Qt::Vertical : Qt::Horizontal;
+
+	// In Channel mode there is no stream section, the entity one is used
+	auto const focused = focusSection(orientation, entityID,
+		[streamIndex](Node* node)
+		{
+			return node->isStreamNode() && static_cast<StreamNode*>(node)->streamIndex() == streamIndex;
+		});
+
+	return focused
+				 || focusSection(orientation, entityID,
+					 [](Node* node)
+					 {
+						 return node->isEntityNode();
+					 });
+}
+
+void View::exportMatrix(QString const& filePath)
+{
+	auto snapshot = matrixExport::takeSnapshot(*_model);
+	if (snapshot.empty())
+	{
+		QMessageBox::information(this, "", "There is nothing to export.");
+		return;
+	}
+
+	matrixExport::exportToFile(std::move(snapshot), matrixExport::formatFromFilePath(filePath), filePath, this,
+		[this, filePath](bool const success, QString const& errorString)
+		{
+			if (success)
+			{
+				QMessageBox::information(this, "", "Export successfully completed:\n" + filePath);
+			}
+			else
+			{
+				QMessageBox::warning(this, "", QString("Export failed:\n%1").arg(errorString));
+			}
+		});
+}
+
+bool View::focusSection(Qt::Orientation const orientation, la::avdecc::UniqueIdentifier const& entityID, std::function<bool(Node*)> const& predicate)
+{
+	auto* const header = orientation == Qt::Vertical ? verticalHeader() : horizontalHeader();
+
+	for (auto section = 0; section < header->count(); ++section)
+	{
+		auto* node = _model->node(section, orientation);
+		if (!node || node->entityID() != entityID || !predicate(node))
+		{
+			continue;
+		}
+
+		// A collapsed node is focused through its closest visible ancestor
+		auto focusedSection = section;
+		while (focusedSection != -1 && header->isSectionHidden(focusedSection) && node->parent())
+		{
+			node = node->parent();
+			focusedSection = _model->section(node, orientation);
+		}
+		if (focusedSection == -1 || header->isSectionHidden(focusedSection))
+		{
+			return false;
+		}
+
+		// Keep the other axis where it is
+		auto const index = orientation == Qt::Vertical ? _model->index(focusedSection, std::max(0, columnAt(0))) : _model->index(std::max(0, rowAt(0)), focusedSection);
+		if (index.isValid())
+		{
+			scrollTo(index, QAbstractItemView::PositionAtCenter);
+			selectionModel()->select(index, QItemSelectionModel::ClearAndSelect | (orientation == Qt::Vertical ? QItemSelectionModel::Rows : QItemSelectionModel::Columns));
+		}
+		return true;
+	}
+
+	return false;
+}
+
 void View::onIntersectionClicked(QModelIndex const& index)
 {
 	auto const& intersectionData = _model->intersectionData(index);
@@ -200,7 +474,7 @@ void View::onIntersectionClicked(QModelIndex const& index)
 					}
 					else
 					{
-						LOG_HIVE_TRACE(QString("connectionMatrix::View::onClicked: Neither connecting nor disconnecting: doConnect=%1 doDisconnect=%2 areConnected=%3").arg(doConnect).arg(doDisconnect).arg(areConnected));
+						LOG_HIVE_FORMAT(Trace, "connectionMatrix::View::onClicked: Neither connecting nor disconnecting: doConnect=%1 doDisconnect=%2 areConnected=%3", doConnect, doDisconnect, areConnected);
 					}
 				}
 			}
@@ -398,31 +672,54 @@ void View::onCustomContextMenuRequested(QPoint const& pos)
 
 		if ((talkerNodeType == Node::Type::OutputStream && listenerNodeType == Node::Type::InputStream) || (talkerNodeType == Node::Type::RedundantOutputStream && listenerNodeType == Node::Type::RedundantInputStream))
 		{
-#pragma message("TODO: Call haveCompatibleFormats(talker, listener)")
-			if (intersectionData.flags.test(Model::IntersectionData::Flag::WrongFormat))
+			auto const talkerID = intersectionData.talker->entityID();
+			auto const listenerID = intersectionData.listener->entityID();
+
+			auto const* const talkerStreamNode = static_cast<StreamNode*>(intersectionData.talker);
+			auto const* const listenerStreamNode = static_cast<StreamNode*>(intersectionData.listener);
+			auto const talkerStreamIndex = talkerStreamNode->streamIndex();
+			auto const listenerStreamIndex = listenerStreamNode->streamIndex();
+
+			auto const isWrongFormat = intersectionData.flags.test(Model::IntersectionData::Flag::WrongFormat);
+			auto& auditor = avdecc::ConnectionAuditor::getInstance();
+			auto const finding = auditor.getFinding({ talkerID, talkerStreamIndex }, { listenerID, listenerStreamIndex });
+
+			if (isWrongFormat || finding)
 			{
 				QMenu menu;
 
-				auto* matchTalkerAction = menu.addAction("Match formats using Talker");
-				auto* matchListenerAction = menu.addAction("Match formats using Listener");
-				menu.addSeparator();
-				menu.addAction("Cancel");
-
-#pragma message("TODO: setEnabled() based on format compatibility -> If talker can be set from listener, and vice versa.")
-				matchTalkerAction->setEnabled(true);
-				matchListenerAction->setEnabled(true);
+				QAction* matchTalkerAction{ nullptr };
+				QAction* matchListenerAction{ nullptr };
+				QAction* matchAllTalkersAction{ nullptr };
+				QAction* matchAllListenersAction{ nullptr };
+				if (isWrongFormat)
+				{
+					matchTalkerAction = menu.addAction("Match formats using Talker");
+					matchListenerAction = menu.addAction("Match formats using Listener");
+					menu.addSeparator();
+					matchAllTalkersAction = menu.addAction("Match all mismatched formats using Talkers");
+					matchAllListenersAction = menu.addAction("Match all mismatched formats using Listeners");
+					menu.addSeparator();
+
+					// Only enable the actions if the other side supports a compatible format
+					matchTalkerAction->setEnabled(streamFormatCache::hasCompatibleListenerFormat(listenerStreamNode->availableFormatIDs(), talkerStreamNode->streamFormatID()));
+					matchListenerAction->setEnabled(streamFormatCache::hasCompatibleTalkerFormat(listenerStreamNode->streamFormatID(), talkerStreamNode->availableFormatIDs()));
+				}
 
-				auto const talkerID = intersectionData.talker->entityID();
-				auto const listenerID = intersectionData.listener->entityID();
+				QAction* repairAction{ nullptr };
+				QAction* repairAllAction{ nullptr };
+				auto const allFindings = auditor.getFindings();
+				if (finding)
+				{
+					repairAction = menu.addAction(QString("Repair connection state (%1)").arg(avdecc::ConnectionAuditor::findingTypeToString(finding->type)));
+					repairAllAction = menu.addAction(QString("Repair all connection state mismatches (%1)").arg(allFindings.size()));
+					menu.addSeparator();
+				}
 
-				auto const* const talkerStreamNode = static_cast<StreamNode*>(intersectionData.talker);
-				auto const* const listenerStreamNode = static_cast<StreamNode*>(intersectionData.listener);
+				menu.addAction("Cancel");
 
 				if (auto* action = menu.exec(viewport()->mapToGlobal(pos)))
 				{
-					auto const talkerStreamIndex = talkerStreamNode->streamIndex();
-					auto const listenerStreamIndex = listenerStreamNode->streamIndex();
-
 					if (action == matchTalkerAction)
 					{
 						auto& manager = avdecc::ControllerManager::getInstance();
@@ -433,6 +730,18 @@ void View::onCustomContextMenuRequested(QPoint const& pos)
 						auto& manager = avdecc::ControllerManager::getInstance();
 						manager.setStreamOutputFormat(talkerID, talkerStreamIndex, listenerStreamNode->streamFormat());
 					}
+					else if (action == matchAllTalkersAction || action == matchAllListenersAction)
+					{
+						reconcileAllFormats(action == matchAllTalkersAction ? formatReconciliation::Strategy::ListenerFromTalker : formatReconciliation::Strategy::TalkerFromListener);
+					}
+					else if (action == repairAction)
+					{
+						repairConnectionStates({ *finding });
+					}
+					else if (action == repairAllAction)
+					{
+						repairConnectionStates(allFindings);
+					}
 				}
 			}
 		}
@@ -446,12 +755,234 @@ void View::onCustomContextMenuRequested(QPoint const& pos)
 	}
 }
 
-void View::onFilterChanged(QString const& filter)
+void View::reconcileAllFormats(formatReconciliation::Strategy const strategy)
+{
+	auto const plan = formatReconciliation::computePlan(strategy);
+	if (plan.changes.empty())
+	{
+		QMessageBox::information(this, "", QString("None of the %1 mismatched connection(s) can be fixed by changing the %2 formats.").arg(plan.mismatchedConnections).arg(strategy == formatReconciliation::Strategy::ListenerFromTalker ? "listener" : "talker"));
+		return;
+	}
+
+	auto question = QString("%1 mismatched connection(s), %2 stream format(s) to change.").arg(plan.mismatchedConnections).arg(plan.changes.size());
+	if (plan.unresolvedConnections != 0u)
+	{
+		question += QString("\n%1 connection(s) will remain mismatched, no compatible format being available.").arg(plan.unresolvedConnections);
+	}
+	question += "\n\nApply all the changes?";
+	if (QMessageBox::question(this, "", question) != QMessageBox::Yes)
+	{
+		return;
+	}
+
+	formatReconciliation::apply(plan, this,
+		[this](avdecc::commandChain::CommandExecutionErrors const& errors)
+		{
+			if (errors.empty())
+			{
+				return;
+			}
+
+			auto failures = std::map<QString, size_t>{};
+			for (auto const& errorInfo : errors)
+			{
+				++failures[avdecc::commandChain::AsyncParallelCommandSet::errorToString(errorInfo.second.errorType)];
+			}
+			auto message = QString{};
+			for (auto const& [error, count] : failures)
+			{
+				message += QString("- %1 (%2 stream(s))\n").arg(error).arg(count);
+			}
+			QMessageBox::warning(this, "", QString("Changing %1 stream format(s) failed:\n\n%2").arg(errors.size()).arg(message));
+		});
+}
+
+void View::repairConnectionStates(avdecc::ConnectionAuditor::Findings const& findings)
+{
+	avdecc::ConnectionAuditor::getInstance().repair(findings, this,
+		[this, count = findings.size()](avdecc::commandChain::CommandExecutionErrors const& errors)
+		{
+			if (!errors.empty())
+			{
+				QMessageBox::warning(this, "", QString("Repairing %1 of %2 connection state(s) failed:\n\n%3").arg(errors.size()).arg(count).arg(batchConnection::errorsSummary(errors)));
+			}
+		});
+}
+
+std::vector<QModelIndex> View::visibleIntersections(QModelIndex const& first, QModelIndex const& last) const
+{
+	auto intersections = std::vector<QModelIndex>{};
+
+	auto const top = std::min(first.row(), last.row());
+	auto const bottom = std::max(first.row(), last.row());
+	auto const left = std::min(first.column(), last.column());
+	auto const right = std::max(first.column(), last.column());
+
+	// Collapsed and filtered out sections are not part of the selection
+	for (auto row = top; row <= bottom; ++row)
+	{
+		if (verticalHeader()->isSectionHidden(row))
+		{
+			continue;
+		}
+		for (auto column = left; column <= right; ++column)
+		{
+			if (!horizontalHeader()->isSectionHidden(column))
+			{
+				intersections.push_back(_model->index(row, column));
+			}
+		}
+	}
+
+	return intersections;
+}
+
+void View::onRubberBandReleased(QPoint const& pos)
 {
-	applyFilterPattern(QRegExp{ filter });
+	auto const last = indexAt(pos);
+	if (!_rubberBandOrigin.isValid() || !last.isValid())
+	{
+		return;
+	}
+
+	auto const intersections = visibleIntersections(_rubberBandOrigin, last);
+	auto const connectPlan = batchConnection::computePlan(*_model, intersections, batchConnection::Action::Connect);
+	auto const disconnectPlan = batchConnection::computePlan(*_model, intersections, batchConnection::Action::Disconnect);
+
+	auto const describe = [](batchConnection::Plan const& plan)
+	{
+		auto description = QStringList{};
+		if (!plan.streamConnections.empty())
+		{
+			description << QString("%1 stream(s)").arg(plan.streamConnections.size());
+		}
+		if (!plan.channelConnections.empty())
+		{
+			description << QString("%1 channel(s)").arg(plan.channelConnectionsCount());
+		}
+		return description.isEmpty() ? QString{ "nothing to change" } : description.join(", ");
+	};
+
+	QMenu menu;
+
+	auto* connectAction = menu.addAction(QString("Connect All (%1)").arg(describe(connectPlan)));
+	auto* disconnectAction = menu.addAction(QString("Disconnect All (%1)").arg(describe(disconnectPlan)));
+	menu.addSeparator();
+	menu.addAction("Cancel");
+
+	connectAction->setEnabled(!connectPlan.empty());
+	disconnectAction->setEnabled(!disconnectPlan.empty());
+
+	if (auto* action = menu.exec(viewport()->mapToGlobal(pos)))
+	{
+		if (action == connectAction)
+		{
+			applyBatchConnection(connectPlan);
+		}
+		else if (action == disconnectAction)
+		{
+			applyBatchConnection(disconnectPlan);
+		}
+	}
 }
 
-void View::applyFilterPattern(QRegExp const& pattern)
+void View::applyBatchConnection(batchConnection::Plan const& plan)
+{
+	auto const isConnect = plan.action == batchConnection::Action::Connect;
+
+	// All the stream commands are sent as one pipelined batch, errors being reported once everything completed
+	if (!plan.streamConnections.empty())
+	{
+		auto const count = plan.streamConnections.size();
+		batchConnection::applyStreamConnections(plan, this,
+			[this, count, isConnect](avdecc::commandChain::CommandExecutionErrors const& errors)
+			{
+				if (errors.empty())
+				{
+					return;
+				}
+				QMessageBox::warning(this, "", QString("%1 %2 of %3 stream(s) failed:\n\n%4").arg(isConnect ? "Connecting" : "Disconnecting").arg(errors.size()).arg(count).arg(batchConnection::errorsSummary(errors)));
+			});
+	}
+
+	if (plan.channelConnections.empty())
+	{
+		return;
+	}
+
+	auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
+	auto failures = std::map<QString, size_t>{};
+
+	if (isConnect)
+	{
+		auto const createConnections = [this, &channelConnectionManager, &failures](batchConnection::EntityPair const& entities, std::vector<batchConnection::ChannelConnection> const& connections, bool const allowTalkerMappingChanges)
+		{
+			auto const result = channelConnectionManager.createChannelConnections(entities.first, entities.second, connections, allowTalkerMappingChanges, true);
+			if (result == avdecc::ChannelConnectionManager::ChannelConnectResult::NoError)
+			{
+				// The commands errors are reported by createChannelConnectionsFinished, once per call
+				++_pendingBatchChannelConnections;
+			}
+			else if (result != avdecc::ChannelConnectionManager::ChannelConnectResult::NeedsTalkerMappingAdjustment || allowTalkerMappingChanges)
+			{
+				failures[channelConnectResultToString(result)] += connections.size();
+			}
+			return result;
+		};
+
+		// Entity pairs requiring talker mapping changes are only asked for once, for the whole batch
+		auto needingTalkerAdjustment = std::vector<std::pair<batchConnection::EntityPair, std::vector<batchConnection::ChannelConnection>>>{};
+		for (auto const& [entities, connections] : plan.channelConnections)
+		{
+			if (createConnections(entities, connections, false) == avdecc::ChannelConnectionManager::ChannelConnectResult::NeedsTalkerMappingAdjustment)
+			{
+				needingTalkerAdjustment.emplace_back(entities, connections);
+			}
+		}
+
+		if (!needingTalkerAdjustment.empty())
+		{
+			auto const result = QMessageBox::question(this, "", QString("To make %1 of the connections it is necessary to temporarily disconnect streams which might lead to audio interruptions! Continue?").arg(needingTalkerAdjustment.size()));
+			for (auto const& [entities, connections] : needingTalkerAdjustment)
+			{
+				if (result == QMessageBox::StandardButton::Yes)
+				{
+					createConnections(entities, connections, true);
+				}
+				else
+				{
+					failures[channelConnectResultToString(avdecc::ChannelConnectionManager::ChannelConnectResult::NeedsTalkerMappingAdjustment)] += connections.size();
+				}
+			}
+		}
+	}
+	else
+	{
+		for (auto const& [entities, connections] : plan.channelConnections)
+		{
+			for (auto const& [talkerChannelIdentification, listenerChannelIdentification] : connections)
+			{
+				auto const result = channelConnectionManager.removeChannelConnection(entities.first, *talkerChannelIdentification.audioUnitIndex, *talkerChannelIdentification.streamPortIndex, talkerChannelIdentification.clusterIndex, *talkerChannelIdentification.baseCluster, talkerChannelIdentification.clusterChannel, entities.second, *listenerChannelIdentification.audioUnitIndex, *listenerChannelIdentification.streamPortIndex, listenerChannelIdentification.clusterIndex, *listenerChannelIdentification.baseCluster, listenerChannelIdentification.clusterChannel);
+				if (result != avdecc::ChannelConnectionManager::ChannelDisconnectResult::NoError && result != avdecc::ChannelConnectionManager::ChannelDisconnectResult::NonExistent)
+				{
+					++failures[result == avdecc::ChannelConnectionManager::ChannelDisconnectResult::Unsupported ? "Unsupported device" : "Unknown error"];
+				}
+			}
+		}
+	}
+
+	if (!failures.empty())
+	{
+		auto message = QString{};
+		for (auto const& [error, count] : failures)
+		{
+			message += QString("- %1 (%2 channel(s))\n").arg(error).arg(count);
+		}
+		QMessageBox::information(this, "", QString("%1 some of the %2 channel(s) is not possible:\n\n%3").arg(isConnect ? "Connecting" : "Disconnecting").arg(plan.channelConnectionsCount()).arg(message));
+	}
+}
+
+void View::applyFilterPattern(qt::toolkit::FilterExpression const& pattern)
 {
 	_verticalHeaderView->setFilterPattern(pattern);
 	_horizontalHeaderView->setFilterPattern(pattern);
@@ -459,16 +990,328 @@ void View::applyFilterPattern(QRegExp const& pattern)
 
 void View::forceFilter()
 {
-	applyFilterPattern(QRegExp{ _cornerWidget->filterText() });
+	applyFilterPattern(qt::toolkit::FilterExpression::compile(_cornerWidget->filterText(), Qt::CaseSensitive));
+}
+
+QPixmap const& View::tile(int const tileColumn, int const tileRow)
+{
+	auto const key = makeTileKey(tileColumn, tileRow);
+	auto it = _tiles.find(key);
+
+	// Not rendered yet, or for another screen
+	if (it == std::end(_tiles) || it->second.devicePixelRatioF() != devicePixelRatioF())
+	{
+		if (it == std::end(_tiles) && _tiles.size() >= MaxTiles)
+		{
+			_tiles.clear();
+		}
+		it = _tiles.insert_or_assign(key, renderTile(tileColumn, tileRow)).first;
+	}
+
+	return it->second;
+}
+
+QPixmap View::renderTile(int const tileColumn, int const tileRow) const
+{
+	auto const left = tileColumn * TileSize;
+	auto const top = tileRow * TileSize;
+	auto const width = std::min(TileSize, horizontalHeader()->length() - left);
+	auto const height = std::min(TileSize, verticalHeader()->length() - top);
+	auto const ratio = devicePixelRatioF();
+
+	auto pixmap = QPixmap{ QSize{ width, height } * ratio };
+	pixmap.setDevicePixelRatio(ratio);
+	pixmap.fill(viewport()->palette().color(viewport()->backgroundRole()));
+
+	auto painter = QPainter{ &pixmap };
+	auto option = viewOptions();
+	auto const gridSize = showGrid() ? 1 : 0;
+	auto const gridColor = QColor::fromRgba(static_cast<QRgb>(style()->styleHint(QStyle::SH_Table_GridLineColor, &option, this)));
+	auto const gridPen = QPen{ gridColor, 0, gridStyle() };
+
+	// Same cells and grid geometry than QTableView
+	forEachSection(verticalHeader(), top, height,
+		[&](int const row, int const rowPosition, int const rowSize)
+		{
+			forEachSection(horizontalHeader(), left, width,
+				[&](int const column, int const columnPosition, int const columnSize)
+				{
+					option.rect = QRect{ columnPosition - left, rowPosition - top, columnSize - gridSize, rowSize - gridSize };
+					itemDelegate()->paint(&painter, option, model()->index(row, column));
+
+					if (gridSize != 0)
+					{
+						auto const x = columnPosition - left + columnSize - 1;
+						painter.setPen(gridPen);
+						painter.drawLine(x, rowPosition - top, x, rowPosition - top + rowSize - 1);
+					}
+				});
+
+			if (gridSize != 0)
+			{
+				auto const y = rowPosition - top + rowSize - 1;
+				painter.setPen(gridPen);
+				painter.drawLine(0, y, width - 1, y);
+			}
+		});
+
+	return pixmap;
+}
+
+void View::paintHighlightedIntersections(QPainter& painter, QRect const& dirtyRect) const
+{
+	auto const selection = selectionModel()->selection();
+	if (selection.isEmpty())
+	{
+		return;
+	}
+
+	auto const horizontalOffset = horizontalHeader()->offset();
+	auto const verticalOffset = verticalHeader()->offset();
+	auto option = viewOptions();
+	option.state |= QStyle::State_Selected;
+	auto const gridSize = showGrid() ? 1 : 0;
+
+	for (auto const& range : selection)
+	{
+		forEachSection(verticalHeader(), dirtyRect.top() + verticalOffset, dirtyRect.height(),
+			[&](int const row, int const rowPosition, int const rowSize)
+			{
+				if (row < range.top() || row > range.bottom())
+				{
+					return;
+				}
+
+				forEachSection(horizontalHeader(), dirtyRect.left() + horizontalOffset, dirtyRect.width(),
+					[&](int const column, int const columnPosition, int const columnSize)
+					{
+						if (column < range.left() || column > range.right())
+						{
+							return;
+						}
+
+						option.rect = QRect{ columnPosition - horizontalOffset, rowPosition - verticalOffset, columnSize - gridSize, rowSize - gridSize };
+						itemDelegate()->paint(&painter, option, model()->index(row, column));
+					});
+			});
+	}
+}
+
+void View::paintOversubscribedIntersections(QPainter& painter, QRect const& dirtyRect) const
+{
+	auto const& bandwidthManager = avdecc::bandwidth::BandwidthAccountingManager::getInstance();
+	if (!bandwidthManager.hasOversubscription())
+	{
+		return;
+	}
+
+	auto const horizontalOffset = horizontalHeader()->offset();
+	auto const verticalOffset = verticalHeader()->offset();
+	auto const gridSize = showGrid() ? 1 : 0;
+	auto const isTransposed = _model->isTransposed();
+	auto const* const talkerHeader = isTransposed ? horizontalHeader() : verticalHeader();
+	auto const talkerOrientation = isTransposed ? Qt::Horizontal : Qt::Vertical;
+
+	auto const warningColor = QColor{ 0xFF, 0x98, 0x00 };
+	auto fillColor = warningColor;
+	fillColor.setAlpha(80);
+
+	painter.save();
+	painter.setPen(QPen{ warningColor, 2 });
+	painter.setBrush(fillColor);
+
+	// Only talker streams reserve bandwidth, check them first so the (few) oversubscribed ones are the only intersections visited
+	auto const talkerStart = isTransposed ? dirtyRect.left() + horizontalOffset : dirtyRect.top() + verticalOffset;
+	auto const talkerLength = isTransposed ? dirtyRect.width() : dirtyRect.height();
+	forEachSection(talkerHeader, talkerStart, talkerLength,
+		[&](int const talkerSection, int const talkerPosition, int const talkerSize)
+		{
+			auto* const talker = _model->node(talkerSection, talkerOrientation);
+			if (!talker || (talker->type() != Node::Type::OutputStream && talker->type() != Node::Type::RedundantOutputStream))
+			{
+				return;
+			}
+
+			auto const* const streamNode = static_cast<StreamNode const*>(talker);
+			if (!bandwidthManager.isStreamOversubscribed(streamNode->entityID(), streamNode->streamIndex()))
+			{
+				return;
+			}
+
+			auto const* const listenerHeader = isTransposed ? verticalHeader() : horizontalHeader();
+			auto const listenerStart = isTransposed ? dirtyRect.top() + verticalOffset : dirtyRect.left() + horizontalOffset;
+			auto const listenerLength = isTransposed ? dirtyRect.height() : dirtyRect.width();
+			forEachSection(listenerHeader, listenerStart, listenerLength,
+				[&](int const listenerSection, int const listenerPosition, int const listenerSize)
+				{
+					auto const row = isTransposed ? listenerSection : talkerSection;
+					auto const column = isTransposed ? talkerSection : listenerSection;
+					if (_model->intersectionData(_model->index(row, column)).state == Model::IntersectionData::State::NotConnected)
+					{
+						return;
+					}
+
+					auto const rowPosition = isTransposed ? listenerPosition : talkerPosition;
+					auto const rowSize = isTransposed ? listenerSize : talkerSize;
+					auto const columnPosition = isTransposed ? talkerPosition : listenerPosition;
+					auto const columnSize = isTransposed ? talkerSize : listenerSize;
+					painter.drawRect(QRect{ columnPosition - horizontalOffset, rowPosition - verticalOffset, columnSize - gridSize, rowSize - gridSize }.adjusted(1, 1, -1, -1));
+				});
+		});
+
+	painter.restore();
+}
+
+void View::invalidateTiles(QModelIndex const& topLeft, QModelIndex const& bottomRight)
+{
+	auto const rows = sectionsSpan(verticalHeader(), topLeft.row(), bottomRight.row());
+	auto const columns = sectionsSpan(horizontalHeader(), topLeft.column(), bottomRight.column());
+
+	// Only hidden intersections changed
+	if (!rows || !columns)
+	{
+		return;
+	}
+
+	for (auto tileRow = rows->first / TileSize; tileRow <= (rows->second - 1) / TileSize; ++tileRow)
+	{
+		for (auto tileColumn = columns->first / TileSize; tileColumn <= (columns->second - 1) / TileSize; ++tileColumn)
+		{
+			_tiles.erase(makeTileKey(tileColumn, tileRow));
+		}
+	}
+}
+
+void View::clearTiles()
+{
+	_tiles.clear();
+}
+
+void View::paintEvent(QPaintEvent* event)
+{
+	// Right to left layouts use the default per intersection painting
+	if (isRightToLeft())
+	{
+		QTableView::paintEvent(event);
+		return;
+	}
+
+	auto const horizontalOffset = horizontalHeader()->offset();
+	auto const verticalOffset = verticalHeader()->offset();
+	auto const contentRect = QRect{ 0, 0, horizontalHeader()->length(), verticalHeader()->length() };
+
+	auto painter = QPainter{ viewport() };
+
+	for (auto const& dirtyRect : event->region())
+	{
+		// Dirty area in content coordinates
+		auto const dirtyContentRect = dirtyRect.translated(horizontalOffset, verticalOffset).intersected(contentRect);
+		if (dirtyContentRect.isEmpty())
+		{
+			continue;
+		}
+
+		for (auto tileRow = dirtyContentRect.top() / TileSize; tileRow <= dirtyContentRect.bottom() / TileSize; ++tileRow)
+		{
+			for (auto tileColumn = dirtyContentRect.left() / TileSize; tileColumn <= dirtyContentRect.right() / TileSize; ++tileColumn)
+			{
+				painter.drawPixmap(tileColumn * TileSize - horizontalOffset, tileRow * TileSize - verticalOffset, tile(tileColumn, tileRow));
+			}
+		}
+
+		// Hover highlight is drawn over the cache (so it never has to be invalidated for it)
+		paintHighlightedIntersections(painter, dirtyRect);
+
+		// Same for the bandwidth warnings, which depend on the whole network and not on the intersection itself
+		paintOversubscribedIntersections(painter, dirtyRect);
+	}
+}
+
+void View::updateGeometries()
+{
+	QTableView::updateGeometries();
+
+	// The minimap is only useful when the matrix doesn't fit in the viewport, it's displayed in the bottom right corner
+	auto const viewportGeometry = viewport()->geometry();
+	auto const isClipped = horizontalScrollBar()->maximum() > 0 || verticalScrollBar()->maximum() > 0;
+	auto const fits = viewportGeometry.width() > 2 * _minimap->width() && viewportGeometry.height() > 2 * _minimap->height();
+
+	_minimap->move(viewportGeometry.right() - _minimap->width() - MinimapMargin + 1, viewportGeometry.bottom() - _minimap->height() - MinimapMargin + 1);
+	_minimap->setVisible(isClipped && fits);
+	_minimap->raise();
+}
+
+void View::mousePressEvent(QMouseEvent* event)
+{
+	if (event->button() == Qt::LeftButton)
+	{
+		_rubberBandOrigin = indexAt(event->pos());
+		_rubberBandPressPos = event->pos();
+		_isRubberBandActive = false;
+	}
+	QTableView::mousePressEvent(event);
 }
 
 void View::mouseMoveEvent(QMouseEvent* event)
 {
 	auto const index = indexAt(event->pos());
+
+	// Dragging from an intersection selects a block of intersections
+	if (event->buttons().testFlag(Qt::LeftButton) && _rubberBandOrigin.isValid())
+	{
+		if (!_isRubberBandActive && (event->pos() - _rubberBandPressPos).manhattanLength() >= QApplication::startDragDistance())
+		{
+			_isRubberBandActive = true;
+			_rubberBand->show();
+		}
+
+		if (_isRubberBandActive)
+		{
+			if (index.isValid())
+			{
+				selectionModel()->select(QItemSelection{ _rubberBandOrigin, index }, QItemSelectionModel::ClearAndSelect);
+				_rubberBand->setGeometry(visualRect(_rubberBandOrigin).united(visualRect(index)));
+			}
+			event->accept();
+			return;
+		}
+	}
+
 	selectionModel()->select(index, QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows | QItemSelectionModel::Columns);
 	QTableView::mouseMoveEvent(event);
 }
 
+void View::mouseReleaseEvent(QMouseEvent* event)
+{
+	if (event->button() == Qt::LeftButton && _isRubberBandActive)
+	{
+		// Not a click on the intersection the drag started from
+		_isRubberBandActive = false;
+		_rubberBand->hide();
+		onRubberBandReleased(event->pos());
+		_rubberBandOrigin = QPersistentModelIndex{};
+		selectionModel()->clearSelection();
+		event->accept();
+		return;
+	}
+
+	_rubberBandOrigin = QPersistentModelIndex{};
+	QTableView::mouseReleaseEvent(event);
+}
+
+void View::showEvent(QShowEvent* event)
+{
+	// Resynchronize the entities changed while hidden before being painted
+	_model->setActive(true);
+	QTableView::showEvent(event);
+}
+
+void View::hideEvent(QHideEvent* event)
+{
+	QTableView::hideEvent(event);
+	_model->setActive(false);
+}
+
 void View::onSettingChanged(settings::SettingsManager::Setting const& name, QVariant const& value) noexcept
 {
 	if (name == settings::ConnectionMatrix_AlwaysShowArrowTip.name)
@@ -491,29 +1334,11 @@ void View::onSettingChanged(settings::SettingsManager::Setting const& name, QVar
 	}
 	else if (name == settings::ConnectionMatrix_Transpose.name)
 	{
-		auto const transposed = value.toBool();
-
-		auto const verticalSectionState = _verticalHeaderView->saveSectionState();
-		auto const horizontalSectionState = _horizontalHeaderView->saveSectionState();
-
-		_model->setTransposed(transposed);
-		_cornerWidget->setTransposed(transposed);
-		_verticalHeaderView->setTransposed(transposed);
-		_horizontalHeaderView->setTransposed(transposed);
-
-		_verticalHeaderView->restoreSectionState(horizontalSectionState);
-		_horizontalHeaderView->restoreSectionState(verticalSectionState);
-
-		forceFilter();
+		setTransposed(value.toBool());
 	}
 	else if (name == settings::ConnectionMatrix_ChannelMode.name)
 	{
-		auto const channelMode = value.toBool();
-		auto const mode = channelMode ? Model::Mode::Channel : Model::Mode::Stream;
-
-		_model->setMode(mode);
-
-		forceFilter();
+		setChannelMode(value.toBool());
 	}
 	else if (name == settings::General_ThemeColorIndex.name)
 	{
@@ -523,6 +1348,11 @@ void View::onSettingChanged(settings::SettingsManager::Setting const& name, QVar
 		_verticalHeaderView->setColor(colorName);
 		_horizontalHeaderView->setColor(colorName);
 
+		// Glyphs have to be rendered again with the new theme
+		paintHelper::clearCapabilitiesCache();
+		clearTiles();
+		viewport()->update();
+
 		// Manually force a model refresh of the headers
 		_model->forceRefreshHeaders();
 	}
@@ -530,6 +1360,19 @@ void View::onSettingChanged(settings::SettingsManager::Setting const& name, QVar
 
 void View::handleCreateChannelConnectionsFinished(avdecc::CreateConnectionsInfo const& info)
 {
+	// Connections of a batch are reported at once, when the last one finished
+	if (_pendingBatchChannelConnections != 0u)
+	{
+		--_pendingBatchChannelConnections;
+		_batchChannelConnectionErrors.insert(info.connectionCreationErrors.begin(), info.connectionCreationErrors.end());
+		if (_pendingBatchChannelConnections == 0u && !_batchChannelConnectionErrors.empty())
+		{
+			QMessageBox::information(qobject_cast<QWidget*>(this), "Error while applying", QString("Error(s) occured while connecting the channels:\n\n%1").arg(batchConnection::errorsSummary(_batchChannelConnectionErrors)));
+			_batchChannelConnectionErrors.clear();
+		}
+		return;
+	}
+
 	std::unordered_set<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash> iteratedEntityIds;
 	for (auto it = info.connectionCreationErrors.begin(), end = info.connectionCreationErrors.end(); it != end; it++) // upper_bound not supported on mac (to iterate over unique keys)
 	{
@@ -20,15 +20,31 @@
 #pragma once
 
 #include <QTableView>
+#include <QPixmap>
 #include "settingsManager/settings.hpp"
 #include "avdecc/channelConnectionManager.hpp"
+#include "avdecc/connectionAudit.hpp"
+#include "connectionMatrix/formatReconciliation.hpp"
+#include "connectionMatrix/batchConnection.hpp"
+#include "toolkit/filterExpression.hpp"
+
+#include <QPersistentModelIndex>
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+class QRubberBand;
 
 namespace connectionMatrix
 {
 class Model;
+class Node;
 class HeaderView;
 class ItemDelegate;
 class CornerWidget;
+class Minimap;
 
 class View final : public QTableView, private settings::SettingsManager::Observer
 {
@@ -40,17 +56,59 @@ class View final : public QTableView, private settings::SettingsManager::Observe
 
 public:
 	View(QWidget* parent = nullptr);
+
+	// Creates a view sharing the model of another view (nodes and intersections are only computed once), with its own mode, transpose state and filter, not following the matrix mode and transpose settings
+	View(View const* const sharedWith, QWidget* parent = nullptr);
+
 	virtual ~View();
 
+	// Switch between Stream and Channel modes
+	void setChannelMode(bool const channelMode);
+	bool isChannelMode() const;
+
+	// Exchange the talkers and listeners axes, keeping the headers state and the intersections in the top left corner
+	void setTransposed(bool const transposed);
+	bool isTransposed() const;
+
+	// Scroll to the talker section of the entity and highlight it, returns false if it's not displayed
+	bool focusEntity(la::avdecc::UniqueIdentifier const& entityID);
+
+	// Scroll to the section of the stream (or of its entity if collapsed, or in Channel mode) and highlight it, returns false if it's not displayed
+	bool focusStream(la::avdecc::UniqueIdentifier const& entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex);
+
+	// Export the whole matrix in the current mode (whatever the filter and collapse states) to a CSV or paged PDF file, written in background
+	void exportMatrix(QString const& filePath);
+
 private:
+	View(std::unique_ptr<Model>&& model, bool const followModeSettings, QWidget* parent);
+
+	bool focusSection(Qt::Orientation const orientation, la::avdecc::UniqueIdentifier const& entityID, std::function<bool(Node*)> const& predicate);
 	void onIntersectionClicked(QModelIndex const& index);
 	void onCustomContextMenuRequested(QPoint const& pos);
-	void onFilterChanged(QString const& filter);
-	void applyFilterPattern(QRegExp const& pattern);
+	void reconcileAllFormats(formatReconciliation::Strategy const strategy);
+	void repairConnectionStates(avdecc::ConnectionAuditor::Findings const& findings);
+	void onRubberBandReleased(QPoint const& pos);
+	void applyBatchConnection(batchConnection::Plan const& plan);
+	std::vector<QModelIndex> visibleIntersections(QModelIndex const& first, QModelIndex const& last) const;
+	void applyFilterPattern(qt::toolkit::FilterExpression const& pattern);
 	void forceFilter();
 
+	// Render cache: the intersections are rendered by tiles of TileSize x TileSize pixels, only the highlighted ones are painted over the cached tiles
+	QPixmap const& tile(int const tileColumn, int const tileRow);
+	QPixmap renderTile(int const tileColumn, int const tileRow) const;
+	void paintHighlightedIntersections(QPainter& painter, QRect const& dirtyRect) const;
+	void paintOversubscribedIntersections(QPainter& painter, QRect const& dirtyRect) const;
+	void invalidateTiles(QModelIndex const& topLeft, QModelIndex const& bottomRight);
+	void clearTiles();
+
 	// QTableView overrides
+	virtual void paintEvent(QPaintEvent* event) override;
+	virtual void updateGeometries() override;
+	virtual void mousePressEvent(QMouseEvent* event) override;
 	virtual void mouseMoveEvent(QMouseEvent* event) override;
+	virtual void mouseReleaseEvent(QMouseEvent* event) override;
+	virtual void showEvent(QShowEvent* event) override;
+	virtual void hideEvent(QHideEvent* event) override;
 
 	// settings::SettingsManager::Observer overrides
 	virtual void onSettingChanged(settings::SettingsManager::Setting const& name, QVariant const& value) noexcept override;
@@ -60,10 +118,24 @@ private:
 
 private:
 	std::unique_ptr<Model> _model;
+	bool const _followModeSettings{ true };
 	std::unique_ptr<HeaderView> _horizontalHeaderView;
 	std::unique_ptr<HeaderView> _verticalHeaderView;
 	std::unique_ptr<ItemDelegate> _itemDelegate;
 	std::unique_ptr<CornerWidget> _cornerWidget;
+	std::unique_ptr<Minimap> _minimap;
+	std::unordered_map<std::uint64_t, QPixmap> _tiles{};
+	qt::toolkit::FilterExpressionDebouncer _filterDebouncer{ nullptr, qt::toolkit::FilterExpressionDebouncer::DefaultInterval, Qt::CaseSensitive };
+
+	// Rubber band selection of intersections, started by dragging from an intersection
+	std::unique_ptr<QRubberBand> _rubberBand;
+	QPersistentModelIndex _rubberBandOrigin{};
+	QPoint _rubberBandPressPos{};
+	bool _isRubberBandActive{ false };
+
+	// Channel connections of a batch still in progress, their errors are reported at once
+	size_t _pendingBatchChannelConnections{ 0u };
+	avdecc::commandChain::CommandExecutionErrors _batchChannelConnectionErrors{};
 };
 
 } // namespace connectionMatrix
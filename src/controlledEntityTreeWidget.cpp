@@ -30,7 +30,10 @@
 #include <QHeaderView>
 #include <QMenu>
 
+#include <functional>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace priv
 {
@@ -44,10 +47,8 @@ void useBoldFont(QTreeWidgetItem* item, bool const bold)
 } // namespace priv
 
 // Base node item
-class NodeItem : public QObject, public QTreeWidgetItem
+class NodeItem : public QTreeWidgetItem
 {
-	using QObject::parent;
-
 public:
 	bool isVirtual() const noexcept
 	{
@@ -221,6 +222,54 @@ public:
 		connect(&controllerManager, &avdecc::ControllerManager::entityOffline, this, &ControlledEntityTreeWidgetPrivate::entityOffline);
 		connect(&controllerManager, &avdecc::ControllerManager::streamInputErrorCounterChanged, this, &ControlledEntityTreeWidgetPrivate::streamInputErrorCounterChanged);
 		connect(&controllerManager, &avdecc::ControllerManager::statisticsErrorCounterChanged, this, &ControlledEntityTreeWidgetPrivate::statisticsErrorCounterChanged);
+		connect(&controllerManager, &avdecc::ControllerManager::clockSourceChanged, this, &ControlledEntityTreeWidgetPrivate::clockSourceChanged);
+
+		// All name changes are dispatched to the item matching the descriptor (if it has been created)
+		connect(&controllerManager, &avdecc::ControllerManager::entityNameChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, QString const& /*entityName*/)
+			{
+				updateItemName(entityID, la::avdecc::entity::model::ConfigurationIndex{ 0u }, la::avdecc::entity::model::DescriptorType::Entity, la::avdecc::entity::model::DescriptorIndex{ 0u });
+			});
+		connect(&controllerManager, &avdecc::ControllerManager::configurationNameChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, QString const& /*configurationName*/)
+			{
+				updateItemName(entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::Configuration, configurationIndex);
+			});
+		connect(&controllerManager, &avdecc::ControllerManager::audioUnitNameChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, QString const& /*audioUnitName*/)
+			{
+				updateItemName(entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::AudioUnit, audioUnitIndex);
+			});
+		connect(&controllerManager, &avdecc::ControllerManager::streamNameChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, QString const& /*streamName*/)
+			{
+				updateItemName(entityID, configurationIndex, descriptorType, streamIndex);
+			});
+		connect(&controllerManager, &avdecc::ControllerManager::avbInterfaceNameChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, QString const& /*avbInterfaceName*/)
+			{
+				updateItemName(entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::AvbInterface, avbInterfaceIndex);
+			});
+		connect(&controllerManager, &avdecc::ControllerManager::clockSourceNameChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex, QString const& /*clockSourceName*/)
+			{
+				updateItemName(entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::ClockSource, clockSourceIndex);
+			});
+		connect(&controllerManager, &avdecc::ControllerManager::memoryObjectNameChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, QString const& /*memoryObjectName*/)
+			{
+				updateItemName(entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::MemoryObject, memoryObjectIndex);
+			});
+		connect(&controllerManager, &avdecc::ControllerManager::audioClusterNameChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClusterIndex const audioClusterIndex, QString const& /*audioClusterName*/)
+			{
+				updateItemName(entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::AudioCluster, audioClusterIndex);
+			});
+		connect(&controllerManager, &avdecc::ControllerManager::clockDomainNameChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, QString const& /*clockDomainName*/)
+			{
+				updateItemName(entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::ClockDomain, clockDomainIndex);
+			});
 
 		// Configure settings observers
 		auto& settings = settings::SettingsManager::getInstance();
@@ -259,6 +308,10 @@ public:
 		{
 			Q_Q(ControlledEntityTreeWidget);
 			q->clearSelection();
+
+			// The model nodes referenced by the pending items are no longer valid
+			_pendingChildren.clear();
+			_pendingNodeParents.clear();
 		}
 	}
 
@@ -288,6 +341,92 @@ public:
 		}
 	}
 
+	Q_SLOT void clockSourceChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex)
+	{
+		if (entityID != _controlledEntityID)
+		{
+			return;
+		}
+
+		// Only update the clock sources already created, the others will get the current state when created
+		if (auto* clockDomainItem = findItem({ _currentConfigurationIndex, la::avdecc::entity::model::DescriptorType::ClockDomain, clockDomainIndex }))
+		{
+			for (auto i = 0; i < clockDomainItem->childCount(); ++i)
+			{
+				auto* item = static_cast<NodeItem*>(clockDomainItem->child(i));
+				priv::useBoldFont(item, item->descriptorIndex() == clockSourceIndex);
+			}
+		}
+	}
+
+	void updateItemName(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex)
+	{
+		if (entityID != _controlledEntityID)
+		{
+			return;
+		}
+
+		// Items not created yet will get the new name when created
+		auto* item = findItem({ configurationIndex, descriptorType, descriptorIndex });
+		if (!item)
+		{
+			return;
+		}
+
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto controlledEntity = manager.getControlledEntity(entityID);
+		if (!controlledEntity)
+		{
+			return;
+		}
+
+		auto const anyNode = item->data(0, la::avdecc::utils::to_integral(EntityInspector::RoleInfo::NodeType)).value<AnyNode>().getNode();
+		switch (descriptorType)
+		{
+			case la::avdecc::entity::model::DescriptorType::Entity:
+				item->setData(0, Qt::DisplayRole, genEntityName(*std::any_cast<la::avdecc::controller::model::EntityNode const*>(anyNode)));
+				break;
+			case la::avdecc::entity::model::DescriptorType::Configuration:
+				item->setData(0, Qt::DisplayRole, genConfigurationName(controlledEntity.get(), *std::any_cast<la::avdecc::controller::model::ConfigurationNode const*>(anyNode)));
+				break;
+			case la::avdecc::entity::model::DescriptorType::AudioUnit:
+				updateName<la::avdecc::controller::model::AudioUnitNode>(item, anyNode, controlledEntity.get(), configurationIndex);
+				break;
+			case la::avdecc::entity::model::DescriptorType::StreamInput:
+				updateName<la::avdecc::controller::model::StreamInputNode>(item, anyNode, controlledEntity.get(), configurationIndex);
+				break;
+			case la::avdecc::entity::model::DescriptorType::StreamOutput:
+				updateName<la::avdecc::controller::model::StreamOutputNode>(item, anyNode, controlledEntity.get(), configurationIndex);
+				break;
+			case la::avdecc::entity::model::DescriptorType::AvbInterface:
+				updateName<la::avdecc::controller::model::AvbInterfaceNode>(item, anyNode, controlledEntity.get(), configurationIndex);
+				break;
+			case la::avdecc::entity::model::DescriptorType::ClockSource:
+				updateName<la::avdecc::controller::model::ClockSourceNode>(item, anyNode, controlledEntity.get(), configurationIndex);
+				break;
+			case la::avdecc::entity::model::DescriptorType::MemoryObject:
+				updateName<la::avdecc::controller::model::MemoryObjectNode>(item, anyNode, controlledEntity.get(), configurationIndex);
+				break;
+			case la::avdecc::entity::model::DescriptorType::AudioCluster:
+				updateName<la::avdecc::controller::model::AudioClusterNode>(item, anyNode, controlledEntity.get(), configurationIndex);
+				break;
+			case la::avdecc::entity::model::DescriptorType::ClockDomain:
+				updateName<la::avdecc::controller::model::ClockDomainNode>(item, anyNode, controlledEntity.get(), configurationIndex);
+				break;
+			default:
+				break;
+		}
+	}
+
+	void itemExpanded(QTreeWidgetItem* item)
+	{
+		// Children are only created the first time their parent is expanded
+		if (!_pendingChildren.empty())
+		{
+			populateChildren(findNodeIdentifier(static_cast<NodeItem const*>(item)));
+		}
+	}
+
 	void saveUserTreeWidgetState()
 	{
 		// Build expanded state
@@ -324,13 +463,13 @@ public:
 			auto const& userTreeWidgetState = it->second;
 			for (auto const& id : userTreeWidgetState.expandedNodes)
 			{
-				if (auto* nodeItem = findItem(id))
+				if (auto* nodeItem = ensureItem(id))
 				{
 					nodeItem->setExpanded(true);
 				}
 			}
 
-			if (auto* selectedItem = findItem(userTreeWidgetState.currentNode))
+			if (auto* selectedItem = ensureItem(userTreeWidgetState.currentNode))
 			{
 				auto const index = q->indexFromItem(selectedItem);
 				q->setCurrentIndex(index);
@@ -352,6 +491,8 @@ public:
 
 		q->clear();
 		_identifierToNodeItem.clear();
+		_pendingChildren.clear();
+		_pendingNodeParents.clear();
 
 		if (!_controlledEntityID)
 		{
@@ -398,6 +539,29 @@ public:
 		return it != std::end(_identifierToNodeItem) ? it->second : nullptr;
 	}
 
+	/** Returns the item for the given node identifier, creating it (and its parents) if it was not created yet */
+	NodeItem* ensureItem(NodeIdentifier const& nodeIdentifier)
+	{
+		if (auto* item = findItem(nodeIdentifier))
+		{
+			return item;
+		}
+
+		auto const it = _pendingNodeParents.find(nodeIdentifier);
+		if (it == std::end(_pendingNodeParents))
+		{
+			return nullptr;
+		}
+
+		auto const parentIdentifier = it->second;
+		if (ensureItem(parentIdentifier))
+		{
+			populateChildren(parentIdentifier);
+		}
+
+		return findItem(nodeIdentifier);
+	}
+
 	NodeIdentifier findNodeIdentifier(NodeItem const* item) const
 	{
 		auto const it = std::find_if(std::begin(_identifierToNodeItem), std::end(_identifierToNodeItem),
@@ -512,6 +676,21 @@ private:
 		}
 	}
 
+	using NodeItemCreator = std::function<void(la::avdecc::controller::ControlledEntity const* const controlledEntity)>;
+
+	template<typename ParentNodeType, typename NodeType>
+	NodeIdentifier makeParentIdentifier(la::avdecc::entity::model::ConfigurationIndex const configurationIndex, ParentNodeType const* parent) const noexcept
+	{
+		auto parentConfigurationIndex = configurationIndex;
+		// Special case for ConfigurationNode, which parent uses ConfigurationIndex 0
+		if constexpr (std::is_same_v<la::avdecc::controller::model::ConfigurationNode, NodeType>)
+		{
+			parentConfigurationIndex = la::avdecc::entity::model::ConfigurationIndex{ 0u };
+		}
+
+		return makeIdentifier(parentConfigurationIndex, parent);
+	}
+
 	template<typename ParentNodeType, typename NodeType>
 	NodeItem* addItem(la::avdecc::entity::model::ConfigurationIndex const configurationIndex, ParentNodeType const* parent, NodeType const* node, QString const& name) noexcept
 	{
@@ -522,38 +701,39 @@ private:
 			isActiveConfiguration = true;
 		}
 
-		auto parentConfigurationIndex = configurationIndex;
-		// Special case for ConfigurationNode, which parent uses ConfigurationIndex 0
-		if constexpr (std::is_same_v<la::avdecc::controller::model::ConfigurationNode, NodeType>)
-		{
-			parentConfigurationIndex = la::avdecc::entity::model::ConfigurationIndex{ 0u };
-		}
-
 		NodeItem* item = nullptr;
 
 		if constexpr (std::is_base_of_v<la::avdecc::controller::model::EntityModelNode, NodeType>)
 		{
 			item = new EntityModelNodeItem{ static_cast<la::avdecc::controller::model::EntityModelNode const*>(node), name };
-			_identifierToNodeItem.insert({ makeIdentifier(configurationIndex, node), item });
 		}
 		else if constexpr (std::is_base_of_v<la::avdecc::controller::model::VirtualNode, NodeType>)
 		{
 			item = new VirtualNodeItem{ static_cast<la::avdecc::controller::model::VirtualNode const*>(node), name };
-			_identifierToNodeItem.insert({ makeIdentifier(configurationIndex, node), item });
 		}
 		else
 		{
 			AVDECC_ASSERT(false, "if constexpr not handled");
 		}
 
+		auto const identifier = makeIdentifier(configurationIndex, node);
+		_identifierToNodeItem.insert({ identifier, item });
+		_pendingNodeParents.erase(identifier);
+
 		// Store the node inside the item
 		auto const anyNode = AnyNode(node);
 		item->setData(0, la::avdecc::utils::to_integral(EntityInspector::RoleInfo::NodeType), QVariant::fromValue(anyNode));
 		item->setData(0, la::avdecc::utils::to_integral(EntityInspector::RoleInfo::IsActiveConfiguration), isActiveConfiguration);
 
+		// Children already known but not created yet, show the expand indicator anyway
+		if (_pendingChildren.count(identifier) != 0)
+		{
+			item->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
+		}
+
 		if (parent)
 		{
-			auto* parentItem = findItem(makeIdentifier(parentConfigurationIndex, parent));
+			auto* parentItem = findItem(makeParentIdentifier<ParentNodeType, NodeType>(configurationIndex, parent));
 			assert(parentItem);
 			parentItem->addChild(item);
 		}
@@ -566,65 +746,76 @@ private:
 		return item;
 	}
 
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::EntityNode const& node) noexcept override
+	/** Creates the item right away if its parent is expanded (or virtual), otherwise delays its creation until the parent is expanded */
+	template<typename ParentNodeType, typename NodeType>
+	void addOrDeferItem(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, ParentNodeType const* parent, NodeType const* node, NodeItemCreator&& creator) noexcept
 	{
-		_currentConfigurationIndex = node.dynamicModel->currentConfiguration;
+		auto const parentIdentifier = makeParentIdentifier<ParentNodeType, NodeType>(configurationIndex, parent);
+		auto* parentItem = findItem(parentIdentifier);
 
-		auto genName = [type = node.descriptorType](QString const& name)
+		// Children of a virtual node are always created with it, as its error state is computed from them
+		if (parentItem && (parentItem->isExpanded() || parentItem->isVirtual()))
 		{
-			return QString("%1: %2").arg(avdecc::helper::descriptorTypeToString(type), name);
-		};
-		// Use Index 0 as ConfigurationIndex for the Entity Descriptor
-		auto* item = addItem<la::avdecc::controller::model::Node const*>(la::avdecc::entity::model::ConfigurationIndex{ 0u }, nullptr, &node, genName(node.dynamicModel->entityName.data()));
+			creator(controlledEntity);
+			return;
+		}
 
-		auto& manager = avdecc::ControllerManager::getInstance();
-		auto const errorCounters = manager.getStatisticsCounters(_controlledEntityID);
-		item->setHasError(!errorCounters.empty());
+		_pendingChildren[parentIdentifier].push_back(std::move(creator));
+		_pendingNodeParents.insert({ makeIdentifier(configurationIndex, node), parentIdentifier });
 
-		connect(&manager, &avdecc::ControllerManager::entityNameChanged, item,
-			[genName, item](la::avdecc::UniqueIdentifier const /*entityID*/, QString const& entityName)
-			{
-				auto name = genName(entityName);
-				item->setData(0, Qt::DisplayRole, name);
-			});
-
-		Q_Q(ControlledEntityTreeWidget);
-		q->setItemExpanded(item, true);
+		if (parentItem)
+		{
+			parentItem->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
+		}
 	}
 
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::EntityNode const* const parent, la::avdecc::controller::model::ConfigurationNode const& node) noexcept override
+	void populateChildren(NodeIdentifier const& parentIdentifier)
 	{
-		auto genName = [type = node.descriptorType, index = node.descriptorIndex](QString const& name)
+		if (_pendingChildren.count(parentIdentifier) == 0)
 		{
-			return QString("%1.%2: %3").arg(avdecc::helper::descriptorTypeToString(type), QString::number(index), name);
-		};
-		auto* item = addItem(node.descriptorIndex, parent, &node, genName(avdecc::helper::configurationName(controlledEntity, node)));
+			return;
+		}
 
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::configurationNameChanged, item,
-			[this, genName, item, node](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, QString const& /*configurationName*/)
-			{
-				if (entityID == _controlledEntityID && configurationIndex == node.descriptorIndex)
-				{
-					auto& manager = avdecc::ControllerManager::getInstance();
-					auto controlledEntity = manager.getControlledEntity(entityID);
+		auto& manager = avdecc::ControllerManager::getInstance();
+		if (auto controlledEntity = manager.getControlledEntity(_controlledEntityID))
+		{
+			populateChildren(controlledEntity.get(), parentIdentifier);
+		}
+	}
 
-					if (controlledEntity)
-					{
-						auto name = genName(avdecc::helper::configurationName(controlledEntity.get(), node));
-						item->setData(0, Qt::DisplayRole, name);
-					}
-				}
-			});
+	void populateChildren(la::avdecc::controller::ControlledEntity const* const controlledEntity, NodeIdentifier const& parentIdentifier)
+	{
+		auto const it = _pendingChildren.find(parentIdentifier);
+		if (it == std::end(_pendingChildren))
+		{
+			return;
+		}
 
-		if (node.dynamicModel->isActiveConfiguration)
+		// Creators may defer other items, move them out of the map first
+		auto const creators = std::move(it->second);
+		_pendingChildren.erase(it);
+
+		for (auto const& creator : creators)
 		{
-			priv::useBoldFont(item, true);
+			creator(controlledEntity);
+		}
 
-			Q_Q(ControlledEntityTreeWidget);
-			q->setItemExpanded(item, true);
+		if (auto* parentItem = findItem(parentIdentifier))
+		{
+			parentItem->setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicatorWhenChildless);
 		}
 	}
 
+	QString genEntityName(la::avdecc::controller::model::EntityNode const& node) const
+	{
+		return QString("%1: %2").arg(avdecc::helper::descriptorTypeToString(node.descriptorType), node.dynamicModel->entityName.data());
+	}
+
+	QString genConfigurationName(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::ConfigurationNode const& node) const
+	{
+		return QString("%1.%2: %3").arg(avdecc::helper::descriptorTypeToString(node.descriptorType), QString::number(node.descriptorIndex), avdecc::helper::configurationName(controlledEntity, node));
+	}
+
 	template<class Node>
 	QString genName(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, Node const& node)
 	{
@@ -637,49 +828,70 @@ private:
 
 		return QString("%1.%2: %3").arg(avdecc::helper::descriptorTypeToString(node.descriptorType), QString::number(node.descriptorIndex), objName);
 	}
+
 	template<class Node>
-	void updateName(NodeItem* item, Node const& node, la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex)
+	void updateName(NodeItem* item, std::any const& anyNode, la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex)
 	{
-		if (entityID == _controlledEntityID && descriptorType == node.descriptorType && descriptorIndex == node.descriptorIndex)
+		// Filter configuration, we currently expand nodes only for current configuration
+		if (configurationIndex == controlledEntity->getEntityNode().dynamicModel->currentConfiguration)
 		{
-			auto& manager = avdecc::ControllerManager::getInstance();
-			auto controlledEntity = manager.getControlledEntity(entityID);
+			auto const* node = std::any_cast<Node const*>(anyNode);
+			item->setData(0, Qt::DisplayRole, genName(controlledEntity, configurationIndex, *node));
+		}
+	}
+
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::EntityNode const& node) noexcept override
+	{
+		_currentConfigurationIndex = node.dynamicModel->currentConfiguration;
+
+		// Use Index 0 as ConfigurationIndex for the Entity Descriptor
+		auto* item = addItem<la::avdecc::controller::model::Node const*>(la::avdecc::entity::model::ConfigurationIndex{ 0u }, nullptr, &node, genEntityName(node));
+
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto const errorCounters = manager.getStatisticsCounters(_controlledEntityID);
+		item->setHasError(!errorCounters.empty());
 
-			// Filter configuration, we currently expand nodes only for current configuration
-			if (controlledEntity && configurationIndex == controlledEntity->getEntityNode().dynamicModel->currentConfiguration)
+		Q_Q(ControlledEntityTreeWidget);
+		q->setItemExpanded(item, true);
+	}
+
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::EntityNode const* const parent, la::avdecc::controller::model::ConfigurationNode const& node) noexcept override
+	{
+		addOrDeferItem(controlledEntity, node.descriptorIndex, parent, &node,
+			[this, parent, &node](la::avdecc::controller::ControlledEntity const* const controlledEntity)
 			{
-				auto name = genName(controlledEntity.get(), configurationIndex, node);
-				item->setData(0, Qt::DisplayRole, name);
-			}
-		}
+				auto* item = addItem(node.descriptorIndex, parent, &node, genConfigurationName(controlledEntity, node));
+
+				if (node.dynamicModel->isActiveConfiguration)
+				{
+					priv::useBoldFont(item, true);
+
+					Q_Q(ControlledEntityTreeWidget);
+					q->setItemExpanded(item, true);
+				}
+			});
 	}
 
 	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::ConfigurationNode const* const parent, la::avdecc::controller::model::AudioUnitNode const& node) noexcept override
 	{
-		auto const name = genName(controlledEntity, parent->descriptorIndex, node);
-		auto* item = addItem(parent->descriptorIndex, parent, &node, name);
-
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::audioUnitNameChanged, item,
-			[this, item, node](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, QString const& /*audioUnitName*/)
+		addOrDeferItem(controlledEntity, parent->descriptorIndex, parent, &node,
+			[this, parent, &node](la::avdecc::controller::ControlledEntity const* const controlledEntity)
 			{
-				updateName(item, node, entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::AudioUnit, audioUnitIndex);
+				addItem(parent->descriptorIndex, parent, &node, genName(controlledEntity, parent->descriptorIndex, node));
 			});
 	}
 
 	template<typename ParentNodeType>
 	void processStreamInputNode(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, ParentNodeType const* const parent, la::avdecc::controller::model::StreamInputNode const& node) noexcept
 	{
-		auto const name = genName(controlledEntity, configurationIndex, node);
-		auto* item = addItem(configurationIndex, parent, &node, name);
-
-		auto& manager = avdecc::ControllerManager::getInstance();
-		auto const errorCounters = manager.getStreamInputErrorCounters(_controlledEntityID, node.descriptorIndex);
-		item->setHasError(!errorCounters.empty());
-
-		connect(&manager, &avdecc::ControllerManager::streamNameChanged, item,
-			[this, item, node](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, QString const& /*streamName*/)
+		addOrDeferItem(controlledEntity, configurationIndex, parent, &node,
+			[this, configurationIndex, parent, &node](la::avdecc::controller::ControlledEntity const* const controlledEntity)
 			{
-				updateName(item, node, entityID, configurationIndex, descriptorType, streamIndex);
+				auto* item = addItem(configurationIndex, parent, &node, genName(controlledEntity, configurationIndex, node));
+
+				auto& manager = avdecc::ControllerManager::getInstance();
+				auto const errorCounters = manager.getStreamInputErrorCounters(_controlledEntityID, node.descriptorIndex);
+				item->setHasError(!errorCounters.empty());
 			});
 	}
 
@@ -695,13 +907,10 @@ private:
 	template<typename ParentNodeType>
 	void processStreamOutputNode(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, ParentNodeType const* const parent, la::avdecc::controller::model::StreamOutputNode const& node) noexcept
 	{
-		auto const name = genName(controlledEntity, configurationIndex, node);
-		auto* item = addItem(configurationIndex, parent, &node, name);
-
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::streamNameChanged, item,
-			[this, item, node](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, QString const& /*streamName*/)
+		addOrDeferItem(controlledEntity, configurationIndex, parent, &node,
+			[this, configurationIndex, parent, &node](la::avdecc::controller::ControlledEntity const* const controlledEntity)
 			{
-				updateName(item, node, entityID, configurationIndex, descriptorType, streamIndex);
+				addItem(configurationIndex, parent, &node, genName(controlledEntity, configurationIndex, node));
 			});
 	}
 
@@ -716,108 +925,108 @@ private:
 
 	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::ConfigurationNode const* const parent, la::avdecc::controller::model::AvbInterfaceNode const& node) noexcept override
 	{
-		auto const name = genName(controlledEntity, parent->descriptorIndex, node);
-		auto* item = addItem(parent->descriptorIndex, parent, &node, name);
-
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::avbInterfaceNameChanged, item,
-			[this, item, node](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, QString const& /*avbInterfaceName*/)
+		addOrDeferItem(controlledEntity, parent->descriptorIndex, parent, &node,
+			[this, parent, &node](la::avdecc::controller::ControlledEntity const* const controlledEntity)
 			{
-				updateName(item, node, entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::AvbInterface, avbInterfaceIndex);
+				addItem(parent->descriptorIndex, parent, &node, genName(controlledEntity, parent->descriptorIndex, node));
 			});
 	}
 
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::ConfigurationNode const* const parent, la::avdecc::controller::model::LocaleNode const& node) noexcept override
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::ConfigurationNode const* const parent, la::avdecc::controller::model::LocaleNode const& node) noexcept override
 	{
-		auto const name = QString("%1.%2: %3").arg(avdecc::helper::descriptorTypeToString(node.descriptorType), QString::number(node.descriptorIndex), node.staticModel->localeID.data());
-		addItem(parent->descriptorIndex, parent, &node, name);
+		addOrDeferItem(controlledEntity, parent->descriptorIndex, parent, &node,
+			[this, parent, &node](la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/)
+			{
+				auto const name = QString("%1.%2: %3").arg(avdecc::helper::descriptorTypeToString(node.descriptorType), QString::number(node.descriptorIndex), node.staticModel->localeID.data());
+				addItem(parent->descriptorIndex, parent, &node, name);
+			});
 	}
 
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::ConfigurationNode const* const grandParent, la::avdecc::controller::model::LocaleNode const* const parent, la::avdecc::controller::model::StringsNode const& node) noexcept override
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::ConfigurationNode const* const grandParent, la::avdecc::controller::model::LocaleNode const* const parent, la::avdecc::controller::model::StringsNode const& node) noexcept override
 	{
-		auto const name = QString("%1.%2").arg(avdecc::helper::descriptorTypeToString(node.descriptorType), QString::number(node.descriptorIndex));
-		addItem(grandParent->descriptorIndex, parent, &node, name);
+		addOrDeferItem(controlledEntity, grandParent->descriptorIndex, parent, &node,
+			[this, grandParent, parent, &node](la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/)
+			{
+				auto const name = QString("%1.%2").arg(avdecc::helper::descriptorTypeToString(node.descriptorType), QString::number(node.descriptorIndex));
+				addItem(grandParent->descriptorIndex, parent, &node, name);
+			});
 	}
 
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::ConfigurationNode const* const grandParent, la::avdecc::controller::model::AudioUnitNode const* const parent, la::avdecc::controller::model::StreamPortNode const& node) noexcept override
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::ConfigurationNode const* const grandParent, la::avdecc::controller::model::AudioUnitNode const* const parent, la::avdecc::controller::model::StreamPortNode const& node) noexcept override
 	{
-		auto const name = QString("%1.%2").arg(avdecc::helper::descriptorTypeToString(node.descriptorType), QString::number(node.descriptorIndex));
-		addItem(grandParent->descriptorIndex, parent, &node, name);
+		addOrDeferItem(controlledEntity, grandParent->descriptorIndex, parent, &node,
+			[this, grandParent, parent, &node](la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/)
+			{
+				auto const name = QString("%1.%2").arg(avdecc::helper::descriptorTypeToString(node.descriptorType), QString::number(node.descriptorIndex));
+				addItem(grandParent->descriptorIndex, parent, &node, name);
+			});
 	}
 
 	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::ConfigurationNode const* const grandGrandParent, la::avdecc::controller::model::AudioUnitNode const* const /*grandParent*/, la::avdecc::controller::model::StreamPortNode const* const parent, la::avdecc::controller::model::AudioClusterNode const& node) noexcept override
 	{
-		auto const name = genName(controlledEntity, grandGrandParent->descriptorIndex, node);
-		auto* item = addItem(grandGrandParent->descriptorIndex, parent, &node, name);
-
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::audioClusterNameChanged, item,
-			[this, item, node](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClusterIndex const audioClusterIndex, QString const& /*audioClusterName*/)
+		addOrDeferItem(controlledEntity, grandGrandParent->descriptorIndex, parent, &node,
+			[this, grandGrandParent, parent, &node](la::avdecc::controller::ControlledEntity const* const controlledEntity)
 			{
-				updateName(item, node, entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::AudioCluster, audioClusterIndex);
+				addItem(grandGrandParent->descriptorIndex, parent, &node, genName(controlledEntity, grandGrandParent->descriptorIndex, node));
 			});
 	}
 
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::ConfigurationNode const* const grandGrandParent, la::avdecc::controller::model::AudioUnitNode const* const /*grandParent*/, la::avdecc::controller::model::StreamPortNode const* const parent, la::avdecc::controller::model::AudioMapNode const& node) noexcept override
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::ConfigurationNode const* const grandGrandParent, la::avdecc::controller::model::AudioUnitNode const* const /*grandParent*/, la::avdecc::controller::model::StreamPortNode const* const parent, la::avdecc::controller::model::AudioMapNode const& node) noexcept override
 	{
-		auto const name = QString("%1.%2").arg(avdecc::helper::descriptorTypeToString(node.descriptorType), QString::number(node.descriptorIndex));
-		addItem(grandGrandParent->descriptorIndex, parent, &node, name);
+		addOrDeferItem(controlledEntity, grandGrandParent->descriptorIndex, parent, &node,
+			[this, grandGrandParent, parent, &node](la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/)
+			{
+				auto const name = QString("%1.%2").arg(avdecc::helper::descriptorTypeToString(node.descriptorType), QString::number(node.descriptorIndex));
+				addItem(grandGrandParent->descriptorIndex, parent, &node, name);
+			});
 	}
 
 	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::ConfigurationNode const* const parent, la::avdecc::controller::model::ClockDomainNode const& node) noexcept override
 	{
-		auto const name = genName(controlledEntity, parent->descriptorIndex, node);
-		auto* item = addItem(parent->descriptorIndex, parent, &node, name);
-
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::clockDomainNameChanged, item,
-			[this, item, node](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, QString const& /*clockDomainName*/)
+		addOrDeferItem(controlledEntity, parent->descriptorIndex, parent, &node,
+			[this, parent, &node](la::avdecc::controller::ControlledEntity const* const controlledEntity)
 			{
-				updateName(item, node, entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::ClockDomain, clockDomainIndex);
+				addItem(parent->descriptorIndex, parent, &node, genName(controlledEntity, parent->descriptorIndex, node));
 			});
 	}
 
 	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::ConfigurationNode const* const grandParent, la::avdecc::controller::model::ClockDomainNode const* const parent, la::avdecc::controller::model::ClockSourceNode const& node) noexcept override
 	{
-		auto const name = genName(controlledEntity, grandParent->descriptorIndex, node);
-		auto* item = addItem(grandParent->descriptorIndex, parent, &node, name);
-		auto const isCurrentConfiguration = grandParent->descriptorIndex == controlledEntity->getEntityNode().dynamicModel->currentConfiguration;
-
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::clockSourceNameChanged, item,
-			[this, item, node](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex, QString const& /*clockSourceName*/)
+		addOrDeferItem(controlledEntity, grandParent->descriptorIndex, parent, &node,
+			[this, grandParent, parent, &node](la::avdecc::controller::ControlledEntity const* const controlledEntity)
 			{
-				updateName(item, node, entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::ClockSource, clockSourceIndex);
-			});
+				auto* item = addItem(grandParent->descriptorIndex, parent, &node, genName(controlledEntity, grandParent->descriptorIndex, node));
 
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::clockSourceChanged, item,
-			[this, item, node, parentIndex = parent->descriptorIndex, isCurrentConfiguration](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex)
-			{
-				if (isCurrentConfiguration && entityID == _controlledEntityID && clockDomainIndex == parentIndex)
+				// Current clock source changes are handled by clockSourceChanged
+				auto const isCurrentConfiguration = grandParent->descriptorIndex == controlledEntity->getEntityNode().dynamicModel->currentConfiguration;
+				if (isCurrentConfiguration)
 				{
-					priv::useBoldFont(item, node.descriptorIndex == clockSourceIndex);
+					auto const isCurrentClockSource = (node.descriptorIndex == parent->dynamicModel->clockSourceIndex);
+					priv::useBoldFont(item, isCurrentClockSource);
 				}
 			});
-
-		if (isCurrentConfiguration)
-		{
-			auto const isCurrentClockSource = (node.descriptorIndex == parent->dynamicModel->clockSourceIndex);
-			priv::useBoldFont(item, isCurrentClockSource);
-		}
 	}
 
 	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::ConfigurationNode const* const parent, la::avdecc::controller::model::MemoryObjectNode const& node) noexcept override
 	{
-		auto const name = genName(controlledEntity, parent->descriptorIndex, node);
-		auto* item = addItem(parent->descriptorIndex, parent, &node, name);
-
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::memoryObjectNameChanged, item,
-			[this, item, node](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, QString const& /*memoryObjectName*/)
+		addOrDeferItem(controlledEntity, parent->descriptorIndex, parent, &node,
+			[this, parent, &node](la::avdecc::controller::ControlledEntity const* const controlledEntity)
 			{
-				updateName(item, node, entityID, configurationIndex, la::avdecc::entity::model::DescriptorType::MemoryObject, memoryObjectIndex);
+				addItem(parent->descriptorIndex, parent, &node, genName(controlledEntity, parent->descriptorIndex, node));
 			});
 	}
 
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::ConfigurationNode const* const parent, la::avdecc::controller::model::RedundantStreamNode const& node) noexcept override
+	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::ConfigurationNode const* const parent, la::avdecc::controller::model::RedundantStreamNode const& node) noexcept override
 	{
-		auto const name = QString("REDUNDANT_%1.%2").arg(avdecc::helper::descriptorTypeToString(node.descriptorType), QString::number(node.virtualIndex));
-		addItem(parent->descriptorIndex, parent, &node, name);
+		addOrDeferItem(controlledEntity, parent->descriptorIndex, parent, &node,
+			[this, parent, &node](la::avdecc::controller::ControlledEntity const* const controlledEntity)
+			{
+				auto const name = QString("REDUNDANT_%1.%2").arg(avdecc::helper::descriptorTypeToString(node.descriptorType), QString::number(node.virtualIndex));
+				addItem(parent->descriptorIndex, parent, &node, name);
+
+				// Create the redundant streams right away, in case they were delayed
+				populateChildren(controlledEntity, makeIdentifier(parent->descriptorIndex, &node));
+			});
 	}
 
 	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::ConfigurationNode const* const grandParent, la::avdecc::controller::model::RedundantStreamNode const* const parent, la::avdecc::controller::model::StreamInputNode const& node) noexcept override
@@ -841,6 +1050,10 @@ private:
 	// Quick access node item by node identifier
 	std::unordered_map<NodeIdentifier, NodeItem*, NodeIdentifier::hash> _identifierToNodeItem;
 
+	// Items not created yet, by parent node identifier (created when the parent is expanded)
+	std::unordered_map<NodeIdentifier, std::vector<NodeItemCreator>, NodeIdentifier::hash> _pendingChildren{};
+	std::unordered_map<NodeIdentifier, NodeIdentifier, NodeIdentifier::hash> _pendingNodeParents{};
+
 	struct UserTreeWidgetState
 	{
 		NodeIdentifier currentNode{};
@@ -867,6 +1080,13 @@ ControlledEntityTreeWidget::ControlledEntityTreeWidget(QWidget* parent)
 			Q_D(ControlledEntityTreeWidget);
 			d->customContextMenuRequested(pos);
 		});
+
+	connect(this, &QTreeWidget::itemExpanded, this,
+		[this](QTreeWidgetItem* item)
+		{
+			Q_D(ControlledEntityTreeWidget);
+			d->itemExpanded(item);
+		});
 }
 
 ControlledEntityTreeWidget::~ControlledEntityTreeWidget()
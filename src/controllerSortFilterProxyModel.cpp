@@ -0,0 +1,552 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "controllerSortFilterProxyModel.hpp"
+
+#include <algorithm>
+
+// Columns the filter text is built from
+static bool isFilterColumn(int const column) noexcept
+{
+	switch (static_cast<avdecc::ControllerModel::Column>(column))
+	{
+		case avdecc::ControllerModel::Column::Compatibility:
+		case avdecc::ControllerModel::Column::EntityID:
+		case avdecc::ControllerModel::Column::Name:
+		case avdecc::ControllerModel::Column::Group:
+		case avdecc::ControllerModel::Column::GrandmasterID:
+		case avdecc::ControllerModel::Column::GptpDomain:
+			return true;
+		default:
+			return false;
+	}
+}
+
+ControllerSortFilterProxyModel::ControllerSortFilterProxyModel(QObject* parent)
+	: QAbstractProxyModel{ parent }
+{
+}
+
+void ControllerSortFilterProxyModel::setFilterText(QString const& filter) noexcept
+{
+	auto const folded = filter.trimmed().toCaseFolded();
+	if (folded == _filter)
+	{
+		return;
+	}
+
+	_filter = folded;
+
+	changeLayout(
+		[this]()
+		{
+			rebuildProxyRows();
+		});
+}
+
+la::avdecc::UniqueIdentifier ControllerSortFilterProxyModel::controlledEntityID(QModelIndex const& index) const
+{
+	if (!_controllerModel)
+	{
+		return la::avdecc::UniqueIdentifier{};
+	}
+	return _controllerModel->controlledEntityID(mapToSource(index));
+}
+
+QModelIndex ControllerSortFilterProxyModel::controlledEntityIndex(la::avdecc::UniqueIdentifier const& entityID) const
+{
+	if (!_controllerModel)
+	{
+		return {};
+	}
+	return mapFromSource(_controllerModel->controlledEntityIndex(entityID));
+}
+
+void ControllerSortFilterProxyModel::setSourceModel(QAbstractItemModel* sourceModel)
+{
+	beginResetModel();
+
+	for (auto const& connection : _sourceConnections)
+	{
+		disconnect(connection);
+	}
+	_sourceConnections.clear();
+
+	QAbstractProxyModel::setSourceModel(sourceModel);
+	_controllerModel = qobject_cast<avdecc::ControllerModel*>(sourceModel);
+
+	if (_controllerModel)
+	{
+		_sourceConnections.push_back(connect(_controllerModel, &QAbstractItemModel::dataChanged, this, &ControllerSortFilterProxyModel::handleDataChanged));
+		_sourceConnections.push_back(connect(_controllerModel, &QAbstractItemModel::rowsAboutToBeRemoved, this, &ControllerSortFilterProxyModel::handleRowsAboutToBeRemoved));
+		_sourceConnections.push_back(connect(_controllerModel, &QAbstractItemModel::rowsRemoved, this, &ControllerSortFilterProxyModel::handleRowsRemoved));
+		_sourceConnections.push_back(connect(_controllerModel, &QAbstractItemModel::rowsInserted, this, &ControllerSortFilterProxyModel::handleRowsInserted));
+		_sourceConnections.push_back(connect(_controllerModel, &QAbstractItemModel::modelAboutToBeReset, this, &ControllerSortFilterProxyModel::handleModelAboutToBeReset));
+		_sourceConnections.push_back(connect(_controllerModel, &QAbstractItemModel::modelReset, this, &ControllerSortFilterProxyModel::handleModelReset));
+		// The source model never moves its rows, a layout change is handled as a reset
+		_sourceConnections.push_back(connect(_controllerModel, &QAbstractItemModel::layoutAboutToBeChanged, this, &ControllerSortFilterProxyModel::handleModelAboutToBeReset));
+		_sourceConnections.push_back(connect(_controllerModel, &QAbstractItemModel::layoutChanged, this, &ControllerSortFilterProxyModel::handleModelReset));
+	}
+
+	_rows.clear();
+	if (_controllerModel)
+	{
+		_rows.resize(static_cast<size_t>(_controllerModel->rowCount()));
+		for (auto row = 0; row < static_cast<int>(_rows.size()); ++row)
+		{
+			updateRowData(row, true, true);
+		}
+	}
+	rebuildProxyRows();
+
+	endResetModel();
+}
+
+QModelIndex ControllerSortFilterProxyModel::mapToSource(QModelIndex const& proxyIndex) const
+{
+	if (!_controllerModel || !proxyIndex.isValid() || proxyIndex.row() >= static_cast<int>(_proxyToSource.size()))
+	{
+		return {};
+	}
+	return _controllerModel->index(_proxyToSource[proxyIndex.row()], proxyIndex.column());
+}
+
+QModelIndex ControllerSortFilterProxyModel::mapFromSource(QModelIndex const& sourceIndex) const
+{
+	if (!sourceIndex.isValid() || sourceIndex.row() >= static_cast<int>(_sourceToProxy.size()))
+	{
+		return {};
+	}
+
+	auto const proxyRow = _sourceToProxy[sourceIndex.row()];
+	if (proxyRow == -1)
+	{
+		return {};
+	}
+	return createIndex(proxyRow, sourceIndex.column());
+}
+
+QModelIndex ControllerSortFilterProxyModel::index(int row, int column, QModelIndex const& parent) const
+{
+	if (parent.isValid() || row < 0 || row >= rowCount() || column < 0 || column >= columnCount())
+	{
+		return {};
+	}
+	return createIndex(row, column);
+}
+
+QModelIndex ControllerSortFilterProxyModel::parent(QModelIndex const& /*child*/) const
+{
+	return {};
+}
+
+int ControllerSortFilterProxyModel::rowCount(QModelIndex const& parent) const
+{
+	if (parent.isValid())
+	{
+		return 0;
+	}
+	return static_cast<int>(_proxyToSource.size());
+}
+
+int ControllerSortFilterProxyModel::columnCount(QModelIndex const& parent) const
+{
+	if (parent.isValid() || !_controllerModel)
+	{
+		return 0;
+	}
+	return _controllerModel->columnCount();
+}
+
+QVariant ControllerSortFilterProxyModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	if (!_controllerModel)
+	{
+		return {};
+	}
+
+	// Columns are not remapped
+	if (orientation == Qt::Horizontal)
+	{
+		return _controllerModel->headerData(section, orientation, role);
+	}
+
+	if (section < 0 || section >= rowCount())
+	{
+		return {};
+	}
+	return _controllerModel->headerData(_proxyToSource[section], orientation, role);
+}
+
+void ControllerSortFilterProxyModel::sort(int column, Qt::SortOrder order)
+{
+	if (column == _sortColumn && order == _sortOrder)
+	{
+		return;
+	}
+
+	// Without sort column, the source order is kept whatever the order
+	if (column == -1 && _sortColumn == -1)
+	{
+		_sortOrder = order;
+		return;
+	}
+
+	auto const isSameColumn = column == _sortColumn;
+	_sortColumn = column;
+	_sortOrder = order;
+
+	changeLayout(
+		[this, isSameColumn]()
+		{
+			if (isSameColumn)
+			{
+				// Only the order changed, the order being strict the rows are simply reversed
+				std::reverse(_proxyToSource.begin(), _proxyToSource.end());
+				updateSourceToProxy(0, rowCount() - 1);
+				return;
+			}
+
+			// The keys are only computed for the sort column
+			for (auto row = 0; row < static_cast<int>(_rows.size()); ++row)
+			{
+				updateRowData(row, true, false);
+			}
+			rebuildProxyRows();
+		});
+}
+
+bool ControllerSortFilterProxyModel::lessThan(int const leftSourceRow, int const rightSourceRow) const noexcept
+{
+	if (_sortColumn != -1)
+	{
+		auto const& leftKey = _rows[leftSourceRow].sortKey;
+		auto const& rightKey = _rows[rightSourceRow].sortKey;
+		if (!(leftKey == rightKey))
+		{
+			return _sortOrder == Qt::AscendingOrder ? leftKey < rightKey : rightKey < leftKey;
+		}
+	}
+
+	// Same key, keep the source order (the reverse of it when descending, so the order is always strict)
+	return _sortOrder == Qt::AscendingOrder || _sortColumn == -1 ? leftSourceRow < rightSourceRow : rightSourceRow < leftSourceRow;
+}
+
+bool ControllerSortFilterProxyModel::isAccepted(int const sourceRow) const noexcept
+{
+	return _filter.isEmpty() || _rows[sourceRow].filterText.contains(_filter);
+}
+
+void ControllerSortFilterProxyModel::updateRowData(int const sourceRow, bool const updateSortKey, bool const updateFilterText) noexcept
+{
+	auto& rowData = _rows[sourceRow];
+	if (updateSortKey)
+	{
+		rowData.sortKey = _sortColumn != -1 ? _controllerModel->sortKey(sourceRow, static_cast<avdecc::ControllerModel::Column>(_sortColumn)) : avdecc::ControllerModel::SortKey{};
+	}
+	if (updateFilterText)
+	{
+		rowData.filterText = _controllerModel->filterText(sourceRow);
+	}
+}
+
+void ControllerSortFilterProxyModel::rebuildProxyRows() noexcept
+{
+	_proxyToSource.clear();
+	for (auto row = 0; row < static_cast<int>(_rows.size()); ++row)
+	{
+		if (isAccepted(row))
+		{
+			_proxyToSource.push_back(row);
+		}
+	}
+
+	std::sort(_proxyToSource.begin(), _proxyToSource.end(),
+		[this](int const lhs, int const rhs)
+		{
+			return lessThan(lhs, rhs);
+		});
+
+	_sourceToProxy.assign(_rows.size(), -1);
+	updateSourceToProxy(0, rowCount() - 1);
+}
+
+void ControllerSortFilterProxyModel::updateSourceToProxy(int const firstProxyRow, int const lastProxyRow) noexcept
+{
+	for (auto proxyRow = firstProxyRow; proxyRow <= lastProxyRow; ++proxyRow)
+	{
+		_sourceToProxy[_proxyToSource[proxyRow]] = proxyRow;
+	}
+}
+
+void ControllerSortFilterProxyModel::changeLayout(std::function<void()> const& change) noexcept
+{
+	emit layoutAboutToBeChanged();
+
+	// The source rows don't change during a layout change of the proxy, they are used to follow the persistent indexes (selection, current index)
+	auto const persistentIndexes = persistentIndexList();
+	auto sourceIndexes = QModelIndexList{};
+	sourceIndexes.reserve(persistentIndexes.size());
+	for (auto const& index : persistentIndexes)
+	{
+		sourceIndexes.push_back(mapToSource(index));
+	}
+
+	change();
+
+	auto newIndexes = QModelIndexList{};
+	newIndexes.reserve(sourceIndexes.size());
+	for (auto const& sourceIndex : sourceIndexes)
+	{
+		newIndexes.push_back(mapFromSource(sourceIndex));
+	}
+	changePersistentIndexList(persistentIndexes, newIndexes);
+
+	emit layoutChanged();
+}
+
+void ControllerSortFilterProxyModel::insertProxyRow(int const sourceRow) noexcept
+{
+	auto const it = std::lower_bound(_proxyToSource.begin(), _proxyToSource.end(), sourceRow,
+		[this](int const element, int const value)
+		{
+			return lessThan(element, value);
+		});
+	auto const proxyRow = static_cast<int>(std::distance(_proxyToSource.begin(), it));
+
+	beginInsertRows({}, proxyRow, proxyRow);
+	_proxyToSource.insert(it, sourceRow);
+	updateSourceToProxy(proxyRow, rowCount() - 1);
+	endInsertRows();
+}
+
+void ControllerSortFilterProxyModel::removeProxyRow(int const proxyRow) noexcept
+{
+	beginRemoveRows({}, proxyRow, proxyRow);
+	_sourceToProxy[_proxyToSource[proxyRow]] = -1;
+	_proxyToSource.erase(_proxyToSource.begin() + proxyRow);
+	updateSourceToProxy(proxyRow, rowCount() - 1);
+	endRemoveRows();
+}
+
+void ControllerSortFilterProxyModel::updateProxyRow(int const sourceRow) noexcept
+{
+	auto const proxyRow = _sourceToProxy[sourceRow];
+	auto const isRowAccepted = isAccepted(sourceRow);
+
+	if (proxyRow == -1)
+	{
+		if (isRowAccepted)
+		{
+			insertProxyRow(sourceRow);
+		}
+		return;
+	}
+
+	if (!isRowAccepted)
+	{
+		removeProxyRow(proxyRow);
+		return;
+	}
+
+	// Still accepted, only move it if it's no longer between its neighbours
+	auto const lastProxyRow = rowCount() - 1;
+	if (proxyRow > 0 && !lessThan(_proxyToSource[proxyRow - 1], sourceRow))
+	{
+		// Moving up, its new place is before the current one
+		auto const it = std::lower_bound(_proxyToSource.begin(), _proxyToSource.begin() + proxyRow, sourceRow,
+			[this](int const element, int const value)
+			{
+				return lessThan(element, value);
+			});
+		auto const newProxyRow = static_cast<int>(std::distance(_proxyToSource.begin(), it));
+
+		beginMoveRows({}, proxyRow, proxyRow, {}, newProxyRow);
+		std::rotate(_proxyToSource.begin() + newProxyRow, _proxyToSource.begin() + proxyRow, _proxyToSource.begin() + proxyRow + 1);
+		updateSourceToProxy(newProxyRow, proxyRow);
+		endMoveRows();
+	}
+	else if (proxyRow < lastProxyRow && !lessThan(sourceRow, _proxyToSource[proxyRow + 1]))
+	{
+		// Moving down, its new place is after the current one
+		auto const it = std::lower_bound(_proxyToSource.begin() + proxyRow + 1, _proxyToSource.end(), sourceRow,
+			[this](int const element, int const value)
+			{
+				return lessThan(element, value);
+			});
+		auto const destinationRow = static_cast<int>(std::distance(_proxyToSource.begin(), it)); // Row before which it's moved, in the current layout
+
+		beginMoveRows({}, proxyRow, proxyRow, {}, destinationRow);
+		std::rotate(_proxyToSource.begin() + proxyRow, _proxyToSource.begin() + proxyRow + 1, _proxyToSource.begin() + destinationRow);
+		updateSourceToProxy(proxyRow, destinationRow - 1);
+		endMoveRows();
+	}
+}
+
+void ControllerSortFilterProxyModel::handleDataChanged(QModelIndex const& topLeft, QModelIndex const& bottomRight, QVector<int> const& roles) noexcept
+{
+	auto const left = topLeft.column();
+	auto const right = bottomRight.column();
+
+	auto const isSortKeyChanged = _sortColumn >= left && _sortColumn <= right;
+	auto isFilterTextChanged = false;
+	for (auto column = left; column <= right && !isFilterTextChanged; ++column)
+	{
+		isFilterTextChanged = isFilterColumn(column);
+	}
+
+	for (auto sourceRow = topLeft.row(); sourceRow <= bottomRight.row(); ++sourceRow)
+	{
+		if (isSortKeyChanged || isFilterTextChanged)
+		{
+			updateRowData(sourceRow, isSortKeyChanged, isFilterTextChanged);
+			updateProxyRow(sourceRow);
+		}
+
+		if (auto const proxyRow = _sourceToProxy[sourceRow]; proxyRow != -1)
+		{
+			emit dataChanged(createIndex(proxyRow, left), createIndex(proxyRow, right), roles);
+		}
+	}
+}
+
+void ControllerSortFilterProxyModel::handleRowsAboutToBeRemoved(QModelIndex const& /*parent*/, int first, int last) noexcept
+{
+	auto proxyRows = std::vector<int>{};
+	for (auto sourceRow = first; sourceRow <= last; ++sourceRow)
+	{
+		if (auto const proxyRow = _sourceToProxy[sourceRow]; proxyRow != -1)
+		{
+			proxyRows.push_back(proxyRow);
+		}
+	}
+
+	// Remove contiguous proxy rows in a single operation, from the last one so removing a range doesn't shift the remaining ones
+	std::sort(proxyRows.begin(), proxyRows.end(), std::greater<int>{});
+	auto rowIt = proxyRows.begin();
+	while (rowIt != proxyRows.end())
+	{
+		auto const lastProxyRow = *rowIt;
+		auto firstProxyRow = lastProxyRow;
+		++rowIt;
+		while (rowIt != proxyRows.end() && *rowIt == firstProxyRow - 1)
+		{
+			firstProxyRow = *rowIt;
+			++rowIt;
+		}
+
+		beginRemoveRows({}, firstProxyRow, lastProxyRow);
+		for (auto proxyRow = firstProxyRow; proxyRow <= lastProxyRow; ++proxyRow)
+		{
+			_sourceToProxy[_proxyToSource[proxyRow]] = -1;
+		}
+		_proxyToSource.erase(_proxyToSource.begin() + firstProxyRow, _proxyToSource.begin() + lastProxyRow + 1);
+		updateSourceToProxy(firstProxyRow, rowCount() - 1);
+		endRemoveRows();
+	}
+}
+
+void ControllerSortFilterProxyModel::handleRowsRemoved(QModelIndex const& /*parent*/, int first, int last) noexcept
+{
+	auto const count = last - first + 1;
+
+	_rows.erase(_rows.begin() + first, _rows.begin() + last + 1);
+	_sourceToProxy.erase(_sourceToProxy.begin() + first, _sourceToProxy.begin() + last + 1);
+
+	for (auto& sourceRow : _proxyToSource)
+	{
+		if (sourceRow > last)
+		{
+			sourceRow -= count;
+		}
+	}
+}
+
+void ControllerSortFilterProxyModel::handleRowsInserted(QModelIndex const& /*parent*/, int first, int last) noexcept
+{
+	auto const count = last - first + 1;
+
+	for (auto& sourceRow : _proxyToSource)
+	{
+		if (sourceRow >= first)
+		{
+			sourceRow += count;
+		}
+	}
+	_rows.insert(_rows.begin() + first, static_cast<size_t>(count), RowData{});
+	_sourceToProxy.insert(_sourceToProxy.begin() + first, static_cast<size_t>(count), -1);
+
+	auto acceptedRows = std::vector<int>{};
+	for (auto sourceRow = first; sourceRow <= last; ++sourceRow)
+	{
+		updateRowData(sourceRow, true, true);
+		if (isAccepted(sourceRow))
+		{
+			acceptedRows.push_back(sourceRow);
+		}
+	}
+
+	if (acceptedRows.size() == 1u)
+	{
+		insertProxyRow(acceptedRows.front());
+		return;
+	}
+
+	if (acceptedRows.empty())
+	{
+		return;
+	}
+
+	// A batch of rows (entities discovered at once) is appended, then merged in a single layout change instead of one insertion each
+	auto const firstProxyRow = rowCount();
+	beginInsertRows({}, firstProxyRow, firstProxyRow + static_cast<int>(acceptedRows.size()) - 1);
+	_proxyToSource.insert(_proxyToSource.end(), acceptedRows.begin(), acceptedRows.end());
+	updateSourceToProxy(firstProxyRow, rowCount() - 1);
+	endInsertRows();
+
+	changeLayout(
+		[this, firstProxyRow]()
+		{
+			auto const compare = [this](int const lhs, int const rhs)
+			{
+				return lessThan(lhs, rhs);
+			};
+			std::sort(_proxyToSource.begin() + firstProxyRow, _proxyToSource.end(), compare);
+			std::inplace_merge(_proxyToSource.begin(), _proxyToSource.begin() + firstProxyRow, _proxyToSource.end(), compare);
+			updateSourceToProxy(0, rowCount() - 1);
+		});
+}
+
+void ControllerSortFilterProxyModel::handleModelAboutToBeReset() noexcept
+{
+	beginResetModel();
+}
+
+void ControllerSortFilterProxyModel::handleModelReset() noexcept
+{
+	_rows.clear();
+	_rows.resize(static_cast<size_t>(_controllerModel->rowCount()));
+	for (auto row = 0; row < static_cast<int>(_rows.size()); ++row)
+	{
+		updateRowData(row, true, true);
+	}
+	rebuildProxyRows();
+
+	endResetModel();
+}
@@ -0,0 +1,91 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "avdecc/controllerModel.hpp"
+
+#include <QAbstractProxyModel>
+#include <QMetaObject>
+#include <QString>
+
+#include <functional>
+#include <vector>
+
+// Model that sorts and filters an underlying avdecc::ControllerModel from the raw sort keys and filter texts of its rows (cached, so data() is never called).
+// A changed row is moved to its new place with a binary search, only a change of sort column or a batch of new rows re-sorting the whole list.
+class ControllerSortFilterProxyModel : public QAbstractProxyModel
+{
+	Q_OBJECT
+public:
+	ControllerSortFilterProxyModel(QObject* parent = nullptr);
+
+	// Set the (case insensitive) filter, matched against the entity ID, name, group, compatibility and gPTP information of the entities
+	void setFilterText(QString const& filter) noexcept;
+
+	// Helpers, from and to proxy indexes
+	la::avdecc::UniqueIdentifier controlledEntityID(QModelIndex const& index) const;
+	QModelIndex controlledEntityIndex(la::avdecc::UniqueIdentifier const& entityID) const;
+
+	// QAbstractProxyModel overrides
+	virtual void setSourceModel(QAbstractItemModel* sourceModel) override;
+	virtual QModelIndex mapToSource(QModelIndex const& proxyIndex) const override;
+	virtual QModelIndex mapFromSource(QModelIndex const& sourceIndex) const override;
+	virtual QModelIndex index(int row, int column, QModelIndex const& parent = {}) const override;
+	virtual QModelIndex parent(QModelIndex const& child) const override;
+	virtual int rowCount(QModelIndex const& parent = {}) const override;
+	virtual int columnCount(QModelIndex const& parent = {}) const override;
+	virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+	virtual void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+private:
+	struct RowData
+	{
+		avdecc::ControllerModel::SortKey sortKey{};
+		QString filterText{};
+	};
+
+	bool lessThan(int const leftSourceRow, int const rightSourceRow) const noexcept;
+	bool isAccepted(int const sourceRow) const noexcept;
+	void updateRowData(int const sourceRow, bool const updateSortKey, bool const updateFilterText) noexcept;
+	void rebuildProxyRows() noexcept;
+	void updateSourceToProxy(int const firstProxyRow, int const lastProxyRow) noexcept;
+	void changeLayout(std::function<void()> const& change) noexcept;
+	void insertProxyRow(int const sourceRow) noexcept;
+	void removeProxyRow(int const proxyRow) noexcept;
+	void updateProxyRow(int const sourceRow) noexcept;
+
+	// Source model slots
+	void handleDataChanged(QModelIndex const& topLeft, QModelIndex const& bottomRight, QVector<int> const& roles) noexcept;
+	void handleRowsAboutToBeRemoved(QModelIndex const& parent, int first, int last) noexcept;
+	void handleRowsRemoved(QModelIndex const& parent, int first, int last) noexcept;
+	void handleRowsInserted(QModelIndex const& parent, int first, int last) noexcept;
+	void handleModelAboutToBeReset() noexcept;
+	void handleModelReset() noexcept;
+
+private:
+	avdecc::ControllerModel* _controllerModel{ nullptr };
+	std::vector<QMetaObject::Connection> _sourceConnections{};
+	std::vector<RowData> _rows{}; // Indexed by source row
+	std::vector<int> _proxyToSource{};
+	std::vector<int> _sourceToProxy{}; // -1 for the rows filtered out
+	int _sortColumn{ -1 }; // -1 to keep the source order
+	Qt::SortOrder _sortOrder{ Qt::AscendingOrder };
+	QString _filter{}; // Case folded
+};
@@ -18,6 +18,7 @@
 */
 
 #include "avbInterfaceCountersTreeWidgetItem.hpp"
+#include "avdecc/entitySubscriptions.hpp"
 
 #include <QMenu>
 
@@ -55,27 +56,15 @@ AvbInterfaceCountersTreeWidgetItem::AvbInterfaceCountersTreeWidgetItem(la::avdec
 	updateCounters(counters);
 
 	// Listen for AvbInterfaceCountersChanged
-	connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::avbInterfaceCountersChanged, this,
-		[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, la::avdecc::entity::model::AvbInterfaceCounters const& counters)
+	avdecc::EntitySubscriptions::getInstance().avbInterfaceCountersChanged().subscribe(this, avdecc::EntitySubscriptions::makeKey(_entityID, la::avdecc::entity::model::DescriptorType::AvbInterface, _avbInterfaceIndex),
+		[this](la::avdecc::entity::model::AvbInterfaceCounters const& counters)
 		{
-			if (entityID == _entityID && avbInterfaceIndex == _avbInterfaceIndex)
-			{
-				updateCounters(counters);
-			}
+			updateCounters(counters);
 		});
 }
 
 void AvbInterfaceCountersTreeWidgetItem::updateCounters(la::avdecc::entity::model::AvbInterfaceCounters const& counters)
 {
-	for (auto const counterKV : counters)
-	{
-		auto const counterFlag = counterKV.first;
-		if (auto const it = _counters.find(counterFlag); it != _counters.end())
-		{
-			auto* widget = it->second;
-			AVDECC_ASSERT(widget != nullptr, "If widget is found in the map, it should not be nullptr");
-			widget->setText(1, QString::number(counterKV.second));
-			widget->setHidden(false);
-		}
-	}
+	_latestCounters = counters;
+	_refreshThrottle.requestRefresh();
 }
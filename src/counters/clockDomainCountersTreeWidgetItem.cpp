@@ -18,6 +18,7 @@
 */
 
 #include "clockDomainCountersTreeWidgetItem.hpp"
+#include "avdecc/entitySubscriptions.hpp"
 
 #include <QMenu>
 
@@ -51,27 +52,15 @@ ClockDomainCountersTreeWidgetItem::ClockDomainCountersTreeWidgetItem(la::avdecc:
 	updateCounters(counters);
 
 	// Listen for ClockDomainCountersChanged
-	connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::clockDomainCountersChanged, this,
-		[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, la::avdecc::entity::model::ClockDomainCounters const& counters)
+	avdecc::EntitySubscriptions::getInstance().clockDomainCountersChanged().subscribe(this, avdecc::EntitySubscriptions::makeKey(_entityID, la::avdecc::entity::model::DescriptorType::ClockDomain, _clockDomainIndex),
+		[this](la::avdecc::entity::model::ClockDomainCounters const& counters)
 		{
-			if (entityID == _entityID && clockDomainIndex == _clockDomainIndex)
-			{
-				updateCounters(counters);
-			}
+			updateCounters(counters);
 		});
 }
 
 void ClockDomainCountersTreeWidgetItem::updateCounters(la::avdecc::entity::model::ClockDomainCounters const& counters)
 {
-	for (auto const counterKV : counters)
-	{
-		auto const counterFlag = counterKV.first;
-		if (auto const it = _counters.find(counterFlag); it != _counters.end())
-		{
-			auto* widget = it->second;
-			AVDECC_ASSERT(widget != nullptr, "If widget is found in the map, it should not be nullptr");
-			widget->setText(1, QString::number(counterKV.second));
-			widget->setHidden(false);
-		}
-	}
+	_latestCounters = counters;
+	_refreshThrottle.requestRefresh();
 }
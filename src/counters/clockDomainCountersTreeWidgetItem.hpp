@@ -23,6 +23,7 @@
 
 #include "avdecc/helper.hpp"
 #include "avdecc/controllerManager.hpp"
+#include "countersRefreshThrottle.hpp"
 
 #include <QObject>
 #include <QTreeWidgetItem>
@@ -43,4 +44,10 @@ private:
 
 	// Counters
 	std::map<la::avdecc::entity::ClockDomainCounterValidFlag, QTreeWidgetItem*> _counters{};
+	la::avdecc::entity::model::ClockDomainCounters _latestCounters{}; // Latest received values
+	la::avdecc::entity::model::ClockDomainCounters _renderedCounters{}; // Values currently displayed
+	CountersRefreshThrottle _refreshThrottle{ [this]()
+		{
+			renderChangedCounters(_latestCounters, _counters, _renderedCounters);
+		} };
 };
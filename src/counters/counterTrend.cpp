@@ -0,0 +1,49 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "counterTrend.hpp"
+
+#include <algorithm>
+
+static constexpr auto SparklineBucketDuration = std::chrono::milliseconds{ 1000 };
+static constexpr auto SparklineBucketsCount = std::size_t{ 10u };
+
+QString counterTrendText(avdecc::CounterHistory const& history) noexcept
+{
+	static auto const s_bars = QString::fromUtf8(u8"▁▂▃▄▅▆▇█"); // Block elements, from lowest to full
+
+	auto const now = avdecc::CounterHistory::Clock::now();
+	auto const buckets = history.incrementsPerBucket(now, SparklineBucketDuration, SparklineBucketsCount);
+	auto const maxIncrement = *std::max_element(buckets.begin(), buckets.end());
+	if (maxIncrement == 0u)
+	{
+		return {};
+	}
+
+	// Lowest bar for buckets without any increment, other ones scaled to the highest increment
+	auto sparkline = QString{};
+	for (auto const increment : buckets)
+	{
+		auto const level = increment == 0u ? 0 : 1 + static_cast<int>((increment * static_cast<std::uint64_t>(s_bars.size() - 1) - 1u) / maxIncrement);
+		sparkline += s_bars[level];
+	}
+
+	auto const rate = history.ratePerSecond(now, SparklineBucketDuration * static_cast<int>(SparklineBucketsCount));
+	return QString("%1/s %2").arg(rate, 0, 'f', rate < 10.0 ? 1 : 0).arg(sparkline);
+}
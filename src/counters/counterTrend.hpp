@@ -0,0 +1,32 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "avdecc/counterHistory.hpp"
+
+#include <QString>
+
+#include <chrono>
+
+/** Period of time between two refreshes of the trend of a counter (so it decays even when the counter does not change anymore) */
+static constexpr auto CounterTrendRefreshPeriod = std::chrono::milliseconds{ 1000 };
+
+/** Returns the rate (per second) and a sparkline of the recent increments of a counter (eg. "2.5/s ▁▃█▁"), or an empty string if the counter did not change recently */
+QString counterTrendText(avdecc::CounterHistory const& history) noexcept;
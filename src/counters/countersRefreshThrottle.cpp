@@ -0,0 +1,79 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "countersRefreshThrottle.hpp"
+
+#include <algorithm>
+
+static settings::SettingsManager::Handle<int> refreshPeriodHandle() noexcept
+{
+	static auto const s_handle = settings::SettingsManager::getInstance().getHandle<int>(settings::General_CountersRefreshPeriod);
+	return s_handle;
+}
+
+CountersRefreshThrottle::CountersRefreshThrottle(Renderer&& renderer)
+	: _renderer{ std::move(renderer) }
+{
+	_refreshTimer.setSingleShot(true);
+	connect(&_refreshTimer, &QTimer::timeout, this,
+		[this]()
+		{
+			if (_refreshPending)
+			{
+				_refreshPending = false;
+				_renderer();
+				// Start a new period, so values received meanwhile are coalesced as well
+				_refreshTimer.start();
+			}
+		});
+
+	// Get the refresh period
+	auto& settings = settings::SettingsManager::getInstance();
+	settings.registerSettingObserver(refreshPeriodHandle(), this);
+}
+
+CountersRefreshThrottle::~CountersRefreshThrottle() noexcept
+{
+	auto& settings = settings::SettingsManager::getInstance();
+	settings.unregisterSettingObserver(refreshPeriodHandle(), this);
+}
+
+void CountersRefreshThrottle::requestRefresh() noexcept
+{
+	// Already rendered during the current period, wait for it to elapse
+	if (_refreshTimer.isActive())
+	{
+		_refreshPending = true;
+		return;
+	}
+
+	_renderer();
+	if (_refreshTimer.interval() > 0)
+	{
+		_refreshTimer.start();
+	}
+}
+
+void CountersRefreshThrottle::onSettingChanged(settings::SettingsManager::Setting const& name, QVariant const& value) noexcept
+{
+	if (name == settings::General_CountersRefreshPeriod.name)
+	{
+		_refreshTimer.setInterval(std::max(0, value.toInt()));
+	}
+}
@@ -0,0 +1,78 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "settingsManager/settings.hpp"
+
+#include <la/avdecc/utils.hpp>
+
+#include <QObject>
+#include <QTimer>
+#include <QTreeWidgetItem>
+
+#include <functional>
+#include <map>
+
+/** Rate limiter for the counters items: the first refresh request is rendered right away, following ones are coalesced and rendered (with the latest values) at most once per General_CountersRefreshPeriod */
+class CountersRefreshThrottle final : public QObject, private settings::SettingsManager::Observer
+{
+public:
+	using Renderer = std::function<void()>;
+
+	CountersRefreshThrottle(Renderer&& renderer);
+	virtual ~CountersRefreshThrottle() noexcept;
+
+	/** Requests a render of the latest values, either right now or when the current refresh period elapses */
+	void requestRefresh() noexcept;
+
+private:
+	// settings::SettingsManager::Observer overrides
+	virtual void onSettingChanged(settings::SettingsManager::Setting const& name, QVariant const& value) noexcept override;
+
+	Renderer _renderer{};
+	QTimer _refreshTimer{};
+	bool _refreshPending{ false };
+};
+
+/** Updates the value column of the counters that changed since the last render, showing the row the first time a value is received */
+template<typename CounterFlag, typename Counters>
+void renderChangedCounters(Counters const& counters, std::map<CounterFlag, QTreeWidgetItem*> const& widgets, Counters& renderedCounters) noexcept
+{
+	for (auto const& [flag, value] : counters)
+	{
+		if (auto const it = widgets.find(flag); it != widgets.end())
+		{
+			auto const renderedIt = renderedCounters.find(flag);
+			if (renderedIt != renderedCounters.end() && renderedIt->second == value)
+			{
+				continue;
+			}
+
+			auto* widget = it->second;
+			AVDECC_ASSERT(widget != nullptr, "If widget is found in the map, it should not be nullptr");
+			widget->setText(1, QString::number(value));
+			if (renderedIt == renderedCounters.end())
+			{
+				widget->setHidden(false);
+			}
+			renderedCounters[flag] = value;
+		}
+	}
+}
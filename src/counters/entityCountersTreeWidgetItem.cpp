@@ -18,6 +18,7 @@
 */
 
 #include "entityCountersTreeWidgetItem.hpp"
+#include "avdecc/entitySubscriptions.hpp"
 
 #include <QMenu>
 
@@ -48,27 +49,15 @@ EntityCountersTreeWidgetItem::EntityCountersTreeWidgetItem(la::avdecc::UniqueIde
 	updateCounters(counters);
 
 	// Listen for EntityCountersChanged
-	connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::entityCountersChanged, this,
-		[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::EntityCounters const& counters)
+	avdecc::EntitySubscriptions::getInstance().entityCountersChanged().subscribe(this, avdecc::EntitySubscriptions::makeKey(_entityID),
+		[this](la::avdecc::entity::model::EntityCounters const& counters)
 		{
-			if (entityID == _entityID)
-			{
-				updateCounters(counters);
-			}
+			updateCounters(counters);
 		});
 }
 
 void EntityCountersTreeWidgetItem::updateCounters(la::avdecc::entity::model::EntityCounters const& counters)
 {
-	for (auto const counterKV : counters)
-	{
-		auto const counterFlag = counterKV.first;
-		if (auto const it = _counters.find(counterFlag); it != _counters.end())
-		{
-			auto* widget = it->second;
-			AVDECC_ASSERT(widget != nullptr, "If widget is found in the map, it should not be nullptr");
-			widget->setText(1, QString::number(counterKV.second));
-			widget->setHidden(false);
-		}
-	}
+	_latestCounters = counters;
+	_refreshThrottle.requestRefresh();
 }
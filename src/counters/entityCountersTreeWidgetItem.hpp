@@ -23,6 +23,7 @@
 
 #include "avdecc/helper.hpp"
 #include "avdecc/controllerManager.hpp"
+#include "countersRefreshThrottle.hpp"
 
 #include <QObject>
 #include <QTreeWidgetItem>
@@ -42,4 +43,10 @@ private:
 
 	// Counters
 	std::map<la::avdecc::entity::EntityCounterValidFlag, QTreeWidgetItem*> _counters{};
+	la::avdecc::entity::model::EntityCounters _latestCounters{}; // Latest received values
+	la::avdecc::entity::model::EntityCounters _renderedCounters{}; // Values currently displayed
+	CountersRefreshThrottle _refreshThrottle{ [this]()
+		{
+			renderChangedCounters(_latestCounters, _counters, _renderedCounters);
+		} };
 };
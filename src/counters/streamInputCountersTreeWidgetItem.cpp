@@ -18,6 +18,7 @@
 */
 
 #include "streamInputCountersTreeWidgetItem.hpp"
+#include "avdecc/entitySubscriptions.hpp"
 
 #include <map>
 #include <QMenu>
@@ -66,24 +67,29 @@ StreamInputCountersTreeWidgetItem::StreamInputCountersTreeWidgetItem(la::avdecc:
 	_errorCounters = manager.getStreamInputErrorCounters(_entityID, _streamIndex);
 	updateCounters(counters);
 
+	// Refresh the trend of the counters even if they don't change
+	_trendTimer.setInterval(CounterTrendRefreshPeriod);
+	connect(&_trendTimer, &QTimer::timeout, this,
+		[this]()
+		{
+			_refreshThrottle.requestRefresh();
+		});
+	_trendTimer.start();
+
 	// Listen for StreamInputCountersChanged
-	connect(&manager, &avdecc::ControllerManager::streamInputCountersChanged, this,
-		[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamInputCounters const& counters)
+	auto& subscriptions = avdecc::EntitySubscriptions::getInstance();
+	auto const key = avdecc::EntitySubscriptions::makeKey(_entityID, la::avdecc::entity::model::DescriptorType::StreamInput, _streamIndex);
+	subscriptions.streamInputCountersChanged().subscribe(this, key,
+		[this](la::avdecc::entity::model::StreamInputCounters const& counters)
 		{
-			if (entityID == _entityID && streamIndex == _streamIndex)
-			{
-				updateCounters(counters);
-			}
+			updateCounters(counters);
 		});
 
-	connect(&manager, &avdecc::ControllerManager::streamInputErrorCounterChanged, this,
-		[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, avdecc::ControllerManager::StreamInputErrorCounters const& errorCounters)
+	subscriptions.streamInputErrorCounterChanged().subscribe(this, key,
+		[this](avdecc::ControllerManager::StreamInputErrorCounters const& errorCounters)
 		{
-			if (entityID == _entityID && streamIndex == _streamIndex)
-			{
-				_errorCounters = errorCounters;
-				updateCounters(_counters);
-			}
+			_errorCounters = errorCounters;
+			updateCounters(_counters);
 		});
 
 	connect(&manager, &avdecc::ControllerManager::streamConnectionChanged, this,
@@ -100,6 +106,12 @@ StreamInputCountersTreeWidgetItem::StreamInputCountersTreeWidgetItem(la::avdecc:
 void StreamInputCountersTreeWidgetItem::updateCounters(la::avdecc::entity::model::StreamInputCounters const& counters)
 {
 	_counters = counters;
+	_refreshThrottle.requestRefresh();
+}
+
+void StreamInputCountersTreeWidgetItem::renderCounters() noexcept
+{
+	auto const history = avdecc::ControllerManager::getInstance().getStreamInputCountersHistory(_entityID, _streamIndex);
 
 	for (auto const [flag, value] : _counters)
 	{
@@ -111,20 +123,42 @@ void StreamInputCountersTreeWidgetItem::updateCounters(la::avdecc::entity::model
 			auto color = QColor{ _isConnected ? Qt::black : Qt::gray };
 			auto text = QString::number(value);
 
-			auto const errorCounterIt = _errorCounters.find(flag);
-			if (errorCounterIt != _errorCounters.end())
+			if (_errorCounters.hasError(flag))
 			{
 				color = QColor{ Qt::red };
-				text += QString(" (+%1)").arg(errorCounterIt->second);
+				text += QString(" (+%1)").arg(_errorCounters.getErrorCount(flag));
+			}
+
+			if (auto const historyIt = history.find(flag); historyIt != history.end())
+			{
+				if (auto const trend = counterTrendText(historyIt->second); !trend.isEmpty())
+				{
+					text += "  " + trend;
+				}
+			}
+
+			// Only update the row if what it displays changed
+			auto const renderedIt = _renderedCounters.find(flag);
+			if (renderedIt == _renderedCounters.end())
+			{
+				widget->setHidden(false);
+			}
+			else if (renderedIt->second.text == text && renderedIt->second.color == color)
+			{
+				continue;
 			}
 
 			widget->setForeground(0, color);
 			widget->setForeground(1, color);
-
 			widget->setText(1, text);
-			widget->setHidden(false);
+
+			_renderedCounters[flag] = RenderedCounter{ text, color };
 		}
 	}
 
-	setText(0, _isConnected ? "Counters" : "Counters (Frozen)");
+	if (_renderedIsConnected != _isConnected)
+	{
+		setText(0, _isConnected ? "Counters" : "Counters (Frozen)");
+		_renderedIsConnected = _isConnected;
+	}
 }
@@ -24,8 +24,11 @@
 #include "avdecc/helper.hpp"
 #include "avdecc/controllerManager.hpp"
 #include "nodeTreeWidget.hpp"
+#include "countersRefreshThrottle.hpp"
+#include "counterTrend.hpp"
 
 #include <map>
+#include <optional>
 
 #include <QObject>
 #include <QTreeWidgetItem>
@@ -33,6 +36,8 @@
 #include <QLabel>
 #include <QHBoxLayout>
 #include <QListWidget>
+#include <QColor>
+#include <QTimer>
 
 class StreamInputCounterTreeWidgetItem : public QTreeWidgetItem
 {
@@ -66,6 +71,13 @@ public:
 
 private:
 	void updateCounters(la::avdecc::entity::model::StreamInputCounters const& counters);
+	void renderCounters() noexcept;
+
+	struct RenderedCounter
+	{
+		QString text{};
+		QColor color{};
+	};
 
 	la::avdecc::UniqueIdentifier const _entityID{};
 	la::avdecc::entity::model::StreamIndex const _streamIndex{ 0u };
@@ -75,4 +87,11 @@ private:
 	std::map<la::avdecc::entity::StreamInputCounterValidFlag, StreamInputCounterTreeWidgetItem*> _counterWidgets{};
 	la::avdecc::entity::model::StreamInputCounters _counters{};
 	avdecc::ControllerManager::StreamInputErrorCounters _errorCounters{};
+	std::map<la::avdecc::entity::StreamInputCounterValidFlag, RenderedCounter> _renderedCounters{}; // Text and color currently displayed
+	std::optional<bool> _renderedIsConnected{}; // Connection state currently displayed in the header
+	CountersRefreshThrottle _refreshThrottle{ [this]()
+		{
+			renderCounters();
+		} };
+	QTimer _trendTimer{}; // Periodically refresh the counters trend (rate and sparkline)
 };
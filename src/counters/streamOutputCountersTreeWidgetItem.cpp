@@ -18,6 +18,7 @@
 */
 
 #include "streamOutputCountersTreeWidgetItem.hpp"
+#include "avdecc/entitySubscriptions.hpp"
 
 #include <map>
 
@@ -49,27 +50,15 @@ StreamOutputCountersTreeWidgetItem::StreamOutputCountersTreeWidgetItem(la::avdec
 	updateCounters(counters);
 
 	// Listen for StreamOutputCountersChanged
-	connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::streamOutputCountersChanged, this,
-		[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamOutputCounters const& counters)
+	avdecc::EntitySubscriptions::getInstance().streamOutputCountersChanged().subscribe(this, avdecc::EntitySubscriptions::makeKey(_entityID, la::avdecc::entity::model::DescriptorType::StreamOutput, _streamIndex),
+		[this](la::avdecc::entity::model::StreamOutputCounters const& counters)
 		{
-			if (entityID == _entityID && streamIndex == _streamIndex)
-			{
-				updateCounters(counters);
-			}
+			updateCounters(counters);
 		});
 }
 
 void StreamOutputCountersTreeWidgetItem::updateCounters(la::avdecc::entity::model::StreamOutputCounters const& counters)
 {
-	for (auto const counterKV : counters)
-	{
-		auto const counterFlag = counterKV.first;
-		if (auto const it = _counters.find(counterFlag); it != _counters.end())
-		{
-			auto* widget = it->second;
-			AVDECC_ASSERT(widget != nullptr, "If widget is found in the map, it should not be nullptr");
-			widget->setText(1, QString::number(counterKV.second));
-			widget->setHidden(false);
-		}
-	}
+	_latestCounters = counters;
+	_refreshThrottle.requestRefresh();
 }
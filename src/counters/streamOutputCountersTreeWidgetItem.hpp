@@ -23,6 +23,7 @@
 
 #include "avdecc/helper.hpp"
 #include "avdecc/controllerManager.hpp"
+#include "countersRefreshThrottle.hpp"
 
 #include <map>
 
@@ -46,4 +47,10 @@ private:
 
 	// Counters
 	std::map<la::avdecc::entity::StreamOutputCounterValidFlag, QTreeWidgetItem*> _counters{};
+	la::avdecc::entity::model::StreamOutputCounters _latestCounters{}; // Latest received values
+	la::avdecc::entity::model::StreamOutputCounters _renderedCounters{}; // Values currently displayed
+	CountersRefreshThrottle _refreshThrottle{ [this]()
+		{
+			renderChangedCounters(_latestCounters, _counters, _renderedCounters);
+		} };
 };
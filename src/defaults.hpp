@@ -34,6 +34,7 @@ struct AdvancedView
 	static constexpr int ColumnWidth_GPTPDomain = 80;
 	static constexpr int ColumnWidth_InterfaceIndex = 90;
 	static constexpr int ColumnWidth_Firmware = 160;
+	static constexpr int ColumnWidth_Bandwidth = 120;
 };
 
 } // namespace ui
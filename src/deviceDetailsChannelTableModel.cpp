@@ -25,6 +25,8 @@
 #include <QLayout>
 #include <QPainter>
 
+#include <algorithm>
+
 #include <la/avdecc/avdecc.hpp>
 #include <la/avdecc/controller/avdeccController.hpp>
 
@@ -177,6 +179,9 @@ public:
 	void resetChangedData();
 
 	TableRowEntry const& tableDataAtRow(int row) const;
+	void updateRenderCache(TableRowEntry const& node) const;
+	void updateRow(int const row, std::shared_ptr<avdecc::TargetConnectionInformations> const& connectionInformation);
+	void notifyChangedRows();
 
 	void channelConnectionsUpdate(la::avdecc::UniqueIdentifier const& entityId);
 	void channelConnectionsUpdate(std::set<std::pair<la::avdecc::UniqueIdentifier, avdecc::ChannelIdentification>> channels);
@@ -191,6 +196,9 @@ private:
 	using AudioClusterNodes = std::vector<TableRowEntry>;
 	AudioClusterNodes _nodes{};
 
+	std::uint64_t _refreshGeneration{ 1u }; // Generation of the refresh being gathered, notified to the views at the end of the current event batch
+	bool _isRefreshNotificationScheduled{ false };
+
 	QMap<la::avdecc::entity::model::DescriptorIndex, QMap<DeviceDetailsChannelTableModelColumn, QVariant>*> _hasChangesMap;
 };
 
@@ -235,11 +243,253 @@ void DeviceDetailsChannelTableModelPrivate::removeAllNodes()
 }
 
 /**
-* Gets the model data at a specific row index.
+* Gets the model data at a specific row index, with its render data up-to-date.
 */
 TableRowEntry const& DeviceDetailsChannelTableModelPrivate::tableDataAtRow(int row) const
 {
-	return _nodes.at(row);
+	auto const& node = _nodes.at(row);
+	if (!node.isRenderCacheValid)
+	{
+		updateRenderCache(node);
+	}
+	return node;
+}
+
+/**
+* Computes the connection lines and statuses of a row, as painted by the delegates.
+*/
+void DeviceDetailsChannelTableModelPrivate::updateRenderCache(TableRowEntry const& node) const
+{
+	node.connectionLines.clear();
+	node.connectionStatuses.clear();
+	node.isRenderCacheValid = true;
+
+	try
+	{
+		int innerRow = 0;
+		auto const& connectionInfo = node.connectionInformation;
+		for (auto const& connection : connectionInfo->targets)
+		{
+			for (auto const& clusterKV : connection.targetClusterChannels)
+			{
+				auto const& targetEntityId = connection.targetEntityId;
+				auto const& manager = avdecc::ControllerManager::getInstance();
+				auto controlledEntity = manager.getControlledEntity(targetEntityId);
+				if (!controlledEntity)
+				{
+					continue;
+				}
+				auto const& entityNode = controlledEntity->getEntityNode();
+				if (entityNode.dynamicModel)
+				{
+					auto const& configurationNode = controlledEntity->getConfigurationNode(entityNode.dynamicModel->currentConfiguration);
+					QString clusterName;
+					if (connectionInfo->sourceClusterChannelInfo->direction == avdecc::ChannelConnectionDirection::OutputToInput)
+					{
+						clusterName = avdecc::helper::objectName(controlledEntity.get(), (configurationNode.audioUnits.at(connection.targetAudioUnitIndex).streamPortInputs.at(connection.targetStreamPortIndex).audioClusters.at(clusterKV.first + connection.targetBaseCluster)));
+					}
+					else
+					{
+						clusterName = avdecc::helper::objectName(controlledEntity.get(), (configurationNode.audioUnits.at(connection.targetAudioUnitIndex).streamPortOutputs.at(connection.targetStreamPortIndex).audioClusters.at(clusterKV.first + connection.targetBaseCluster)));
+					}
+
+					if (connection.isSourceRedundant && connection.isTargetRedundant)
+					{
+						node.connectionLines.append(QString(clusterName).append(": ").append(avdecc::helper::smartEntityName(*controlledEntity.get())).append(" (Prim)"));
+
+						auto const& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
+						std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::controller::model::StreamNode const*> redundantOutputs;
+						std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::controller::model::StreamNode const*> redundantInputs;
+						if (connectionInfo->sourceClusterChannelInfo->direction == avdecc::ChannelConnectionDirection::OutputToInput)
+						{
+							redundantOutputs = channelConnectionManager.getRedundantStreamOutputsForPrimary(connectionInfo->sourceEntityId, connection.sourceStreamIndex);
+							redundantInputs = channelConnectionManager.getRedundantStreamInputsForPrimary(connection.targetEntityId, connection.targetStreamIndex);
+						}
+						else
+						{
+							redundantOutputs = channelConnectionManager.getRedundantStreamInputsForPrimary(connectionInfo->sourceEntityId, connection.sourceStreamIndex);
+							redundantInputs = channelConnectionManager.getRedundantStreamOutputsForPrimary(connection.targetEntityId, connection.targetStreamIndex);
+						}
+						auto itOutputs = redundantOutputs.begin();
+						auto itInputs = redundantInputs.begin();
+
+						if (itOutputs != redundantOutputs.end() && itInputs != redundantInputs.end())
+						{
+							// skip primary
+							itOutputs++;
+							itInputs++;
+						}
+
+						while (itOutputs != redundantOutputs.end() && itInputs != redundantInputs.end())
+						{
+							node.connectionLines.append(QString(clusterName).append(": ").append(avdecc::helper::smartEntityName(*controlledEntity.get())).append(" (Sec)"));
+
+							itOutputs++;
+							itInputs++;
+						}
+					}
+					else
+					{
+						node.connectionLines.append(QString(clusterName).append(": ").append(avdecc::helper::smartEntityName(*controlledEntity.get())));
+					}
+				}
+				innerRow++;
+			}
+		}
+	}
+	catch (...)
+	{
+		node.connectionLines.clear();
+	}
+
+	try
+	{
+		auto const& connectionInfo = node.connectionInformation;
+		for (auto const& connection : connectionInfo->targets)
+		{
+			std::vector<DeviceDetailsChannelTableModel::ConnectionStatus> connectionStatesTmp;
+			auto talkerEntityId = la::avdecc::UniqueIdentifier::getNullUniqueIdentifier();
+			auto listenerEntityId = la::avdecc::UniqueIdentifier::getNullUniqueIdentifier();
+			auto talkerStreamIndex = la::avdecc::entity::model::StreamIndex{};
+			auto listenerStreamIndex = la::avdecc::entity::model::StreamIndex{};
+
+			if (connectionInfo->sourceClusterChannelInfo->direction == avdecc::ChannelConnectionDirection::OutputToInput)
+			{
+				talkerEntityId = connectionInfo->sourceEntityId;
+				listenerEntityId = connection.targetEntityId;
+				talkerStreamIndex = connection.sourceStreamIndex;
+				listenerStreamIndex = connection.targetStreamIndex;
+			}
+			else
+			{
+				talkerEntityId = connection.targetEntityId;
+				listenerEntityId = connectionInfo->sourceEntityId;
+				talkerStreamIndex = connection.targetStreamIndex;
+				listenerStreamIndex = connection.sourceStreamIndex;
+			}
+
+			auto const& manager = avdecc::ControllerManager::getInstance();
+			auto talkerEntity = manager.getControlledEntity(talkerEntityId);
+			auto listenerEntity = manager.getControlledEntity(listenerEntityId);
+
+			if (!talkerEntity || !listenerEntity)
+			{
+				continue;
+			}
+			auto const& talkerEntityNode = talkerEntity->getEntityNode();
+			auto const& listenerEntityNode = listenerEntity->getEntityNode();
+
+			if (talkerEntityNode.dynamicModel && listenerEntityNode.dynamicModel)
+			{
+				{
+					auto status = calculateConnectionStatus(talkerEntityId, talkerStreamIndex, listenerEntityId, listenerStreamIndex);
+
+					connectionStatesTmp.push_back(status);
+				}
+
+				if (connection.isSourceRedundant && connection.isTargetRedundant)
+				{
+					auto const& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
+
+					auto redundantOutputs = channelConnectionManager.getRedundantStreamOutputsForPrimary(talkerEntityId, talkerStreamIndex);
+					auto redundantInputs = channelConnectionManager.getRedundantStreamInputsForPrimary(listenerEntityId, listenerStreamIndex);
+
+					auto itOutputs = redundantOutputs.begin();
+					auto itInputs = redundantInputs.begin();
+
+					if (itOutputs != redundantOutputs.end() && itInputs != redundantInputs.end())
+					{
+						// skip primary
+						itOutputs++;
+						itInputs++;
+					}
+					while (itOutputs != redundantOutputs.end() && itInputs != redundantInputs.end())
+					{
+						auto status = calculateConnectionStatus(talkerEntityId, itOutputs->first, listenerEntityId, itInputs->first);
+						connectionStatesTmp.push_back(status);
+
+						itOutputs++;
+						itInputs++;
+					}
+				}
+
+				// add the states for each cluster channel
+				for (uint32_t i = 0; i < connection.targetClusterChannels.size(); i++)
+				{
+					node.connectionStatuses.insert(node.connectionStatuses.end(), connectionStatesTmp.begin(), connectionStatesTmp.end());
+				}
+			}
+		}
+	}
+	catch (...)
+	{
+		node.connectionStatuses.clear();
+	}
+}
+
+/**
+* Sets the new connections of a row, invalidating its cached data only when something displayed changed.
+* The views are notified of the changed rows once the current event batch is processed.
+*/
+void DeviceDetailsChannelTableModelPrivate::updateRow(int const row, std::shared_ptr<avdecc::TargetConnectionInformations> const& connectionInformation)
+{
+	auto& node = _nodes.at(row);
+	node.connectionInformation = connectionInformation;
+
+	// never painted yet, it will be computed when first needed
+	if (!node.isRenderCacheValid)
+	{
+		return;
+	}
+
+	auto const previousLines = std::move(node.connectionLines);
+	auto const previousStatuses = std::move(node.connectionStatuses);
+	updateRenderCache(node);
+
+	if (node.connectionLines == previousLines && node.connectionStatuses == previousStatuses)
+	{
+		return;
+	}
+
+	node.changedGeneration = _refreshGeneration;
+	if (!_isRefreshNotificationScheduled)
+	{
+		_isRefreshNotificationScheduled = true;
+		QMetaObject::invokeMethod(this, &DeviceDetailsChannelTableModelPrivate::notifyChangedRows, Qt::QueuedConnection);
+	}
+}
+
+/**
+* Notifies the views of the rows changed during the current refresh generation, one span per run of consecutive rows.
+*/
+void DeviceDetailsChannelTableModelPrivate::notifyChangedRows()
+{
+	Q_Q(DeviceDetailsChannelTableModel);
+
+	auto constexpr firstColumn = static_cast<int>(DeviceDetailsChannelTableModelColumn::ConnectionStatus);
+	auto constexpr lastColumn = static_cast<int>(DeviceDetailsChannelTableModelColumn::Connection);
+
+	auto const generation = _refreshGeneration;
+	++_refreshGeneration;
+	_isRefreshNotificationScheduled = false;
+
+	auto const count = static_cast<int>(_nodes.size());
+	auto row = 0;
+	while (row < count)
+	{
+		if (_nodes[row].changedGeneration != generation)
+		{
+			++row;
+			continue;
+		}
+
+		auto const first = row;
+		while (row < count && _nodes[row].changedGeneration == generation)
+		{
+			++row;
+		}
+		emit q->dataChanged(q->index(first, firstColumn, QModelIndex()), q->index(row - 1, lastColumn, QModelIndex()), { Qt::DisplayRole });
+	}
 }
 
 /**
@@ -268,31 +518,18 @@ void DeviceDetailsChannelTableModelPrivate::resetChangedData()
 */
 void DeviceDetailsChannelTableModelPrivate::channelConnectionsUpdate(la::avdecc::UniqueIdentifier const& entityId)
 {
-	Q_Q(DeviceDetailsChannelTableModel);
-	int row = 0;
-	for (auto& node : _nodes)
+	auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
+	for (auto row = 0; row < static_cast<int>(_nodes.size()); ++row)
 	{
-		auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
-		if (node.connectionInformation->sourceClusterChannelInfo->direction == avdecc::ChannelConnectionDirection::OutputToInput)
+		auto const& connectionInformation = _nodes[row].connectionInformation;
+		if (connectionInformation->sourceClusterChannelInfo->direction == avdecc::ChannelConnectionDirection::OutputToInput)
 		{
-			node.connectionInformation = channelConnectionManager.getChannelConnections(node.connectionInformation->sourceEntityId, *node.connectionInformation->sourceClusterChannelInfo);
-			auto begin = q->index(0, static_cast<int>(DeviceDetailsChannelTableModelColumn::Connection), QModelIndex());
-			auto end = q->index(static_cast<int>(_nodes.size()), static_cast<int>(DeviceDetailsChannelTableModelColumn::ConnectionStatus), QModelIndex());
-			q->dataChanged(begin, end, QVector<int>(Qt::DisplayRole));
+			updateRow(row, channelConnectionManager.getChannelConnections(connectionInformation->sourceEntityId, *connectionInformation->sourceClusterChannelInfo));
 		}
-		else
+		else if (connectionInformation->sourceEntityId == entityId)
 		{
-			if (node.connectionInformation->sourceEntityId == entityId)
-			{
-				node.connectionInformation = channelConnectionManager.getChannelConnectionsReverse(node.connectionInformation->sourceEntityId, *node.connectionInformation->sourceClusterChannelInfo);
-				auto indexConnection = q->index(row, static_cast<int>(DeviceDetailsChannelTableModelColumn::Connection), QModelIndex());
-				q->dataChanged(indexConnection, indexConnection, QVector<int>(Qt::DisplayRole));
-				auto indexConnectionStatus = q->index(row, static_cast<int>(DeviceDetailsChannelTableModelColumn::ConnectionStatus), QModelIndex());
-				q->dataChanged(indexConnectionStatus, indexConnectionStatus, QVector<int>(Qt::DisplayRole));
-			}
+			updateRow(row, channelConnectionManager.getChannelConnectionsReverse(connectionInformation->sourceEntityId, *connectionInformation->sourceClusterChannelInfo));
 		}
-
-		row++;
 	}
 }
 
@@ -301,34 +538,20 @@ void DeviceDetailsChannelTableModelPrivate::channelConnectionsUpdate(la::avdecc:
 */
 void DeviceDetailsChannelTableModelPrivate::channelConnectionsUpdate(std::set<std::pair<la::avdecc::UniqueIdentifier, avdecc::ChannelIdentification>> channels)
 {
-	Q_Q(DeviceDetailsChannelTableModel);
-	int row = 0;
-	for (auto& node : _nodes)
+	auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
+	for (auto row = 0; row < static_cast<int>(_nodes.size()); ++row)
 	{
-		auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
-		if (node.connectionInformation->sourceClusterChannelInfo->direction == avdecc::ChannelConnectionDirection::OutputToInput)
+		auto const& connectionInformation = _nodes[row].connectionInformation;
+		if (connectionInformation->sourceClusterChannelInfo->direction == avdecc::ChannelConnectionDirection::OutputToInput)
 		{
 			// in the case of the talker we can't know which channels have to be updated without getting the changes from the ChannelConnectionManager
-			// therefor all talkers are updated for now. To improve on this talker connections would need to be cached in the ChannelConnectionManager like the listenerChannelConnections are cached.
-			node.connectionInformation = channelConnectionManager.getChannelConnections(node.connectionInformation->sourceEntityId, *node.connectionInformation->sourceClusterChannelInfo);
-			auto indexConnection = q->index(row, static_cast<int>(DeviceDetailsChannelTableModelColumn::Connection), QModelIndex());
-			q->dataChanged(indexConnection, indexConnection, QVector<int>(Qt::DisplayRole));
-			auto indexConnectionStatus = q->index(row, static_cast<int>(DeviceDetailsChannelTableModelColumn::ConnectionStatus), QModelIndex());
-			q->dataChanged(indexConnectionStatus, indexConnectionStatus, QVector<int>(Qt::DisplayRole));
+			// therefor all talkers are updated for now, only the rows which display something different being repainted.
+			updateRow(row, channelConnectionManager.getChannelConnections(connectionInformation->sourceEntityId, *connectionInformation->sourceClusterChannelInfo));
 		}
-		else
+		else if (channels.find(std::make_pair(connectionInformation->sourceEntityId, *connectionInformation->sourceClusterChannelInfo)) != channels.end())
 		{
-			if (channels.find(std::make_pair(node.connectionInformation->sourceEntityId, *node.connectionInformation->sourceClusterChannelInfo)) != channels.end())
-			{
-				node.connectionInformation = channelConnectionManager.getChannelConnectionsReverse(node.connectionInformation->sourceEntityId, *node.connectionInformation->sourceClusterChannelInfo);
-				auto indexConnection = q->index(row, static_cast<int>(DeviceDetailsChannelTableModelColumn::Connection), QModelIndex());
-				q->dataChanged(indexConnection, indexConnection, QVector<int>(Qt::DisplayRole));
-				auto indexConnectionStatus = q->index(row, static_cast<int>(DeviceDetailsChannelTableModelColumn::ConnectionStatus), QModelIndex());
-				q->dataChanged(indexConnectionStatus, indexConnectionStatus, QVector<int>(Qt::DisplayRole));
-			}
+			updateRow(row, channelConnectionManager.getChannelConnectionsReverse(connectionInformation->sourceEntityId, *connectionInformation->sourceClusterChannelInfo));
 		}
-
-		row++;
 	}
 }
 
@@ -349,6 +572,18 @@ void DeviceDetailsChannelTableModelPrivate::updateAudioClusterName(la::avdecc::U
 				q->dataChanged(indexConnectionStatus, indexConnectionStatus, QVector<int>(Qt::DisplayRole));
 			}
 		}
+
+		// the cached connection lines display the cluster names of the targets
+		auto const& targets = node.connectionInformation->targets;
+		auto const isTargetEntity = std::any_of(targets.begin(), targets.end(),
+			[entityID](auto const& target)
+			{
+				return target.targetEntityId == entityID;
+			});
+		if (isTargetEntity)
+		{
+			updateRow(row, node.connectionInformation);
+		}
 		row++;
 	}
 }
@@ -442,85 +677,13 @@ QVariant DeviceDetailsChannelTableModelPrivate::data(QModelIndex const& index, i
 		{
 			if (role == Qt::DisplayRole)
 			{
-				try
-				{
-					QVariantList connectionLines;
-					int innerRow = 0;
-					auto const& connectionInfo = _nodes.at(index.row()).connectionInformation;
-					for (auto const& connection : connectionInfo->targets)
-					{
-						for (auto const& clusterKV : connection->targetClusterChannels)
-						{
-							auto const& targetEntityId = connection->targetEntityId;
-							auto const& manager = avdecc::ControllerManager::getInstance();
-							auto controlledEntity = manager.getControlledEntity(targetEntityId);
-							if (!controlledEntity)
-							{
-								continue;
-							}
-							auto const& entityNode = controlledEntity->getEntityNode();
-							if (entityNode.dynamicModel)
-							{
-								auto const& configurationNode = controlledEntity->getConfigurationNode(entityNode.dynamicModel->currentConfiguration);
-								QString clusterName;
-								if (connectionInfo->sourceClusterChannelInfo->direction == avdecc::ChannelConnectionDirection::OutputToInput)
-								{
-									clusterName = avdecc::helper::objectName(controlledEntity.get(), (configurationNode.audioUnits.at(connection->targetAudioUnitIndex).streamPortInputs.at(connection->targetStreamPortIndex).audioClusters.at(clusterKV.first + connection->targetBaseCluster)));
-								}
-								else
-								{
-									clusterName = avdecc::helper::objectName(controlledEntity.get(), (configurationNode.audioUnits.at(connection->targetAudioUnitIndex).streamPortOutputs.at(connection->targetStreamPortIndex).audioClusters.at(clusterKV.first + connection->targetBaseCluster)));
-								}
-
-								if (connection->isSourceRedundant && connection->isTargetRedundant)
-								{
-									connectionLines.append(QString(clusterName).append(": ").append(avdecc::helper::smartEntityName(*controlledEntity.get())).append(" (Prim)"));
-
-									auto const& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
-									std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::controller::model::StreamNode const*> redundantOutputs;
-									std::map<la::avdecc::entity::model::StreamIndex, la::avdecc::controller::model::StreamNode const*> redundantInputs;
-									if (connectionInfo->sourceClusterChannelInfo->direction == avdecc::ChannelConnectionDirection::OutputToInput)
-									{
-										redundantOutputs = channelConnectionManager.getRedundantStreamOutputsForPrimary(connectionInfo->sourceEntityId, connection->sourceStreamIndex);
-										redundantInputs = channelConnectionManager.getRedundantStreamInputsForPrimary(connection->targetEntityId, connection->targetStreamIndex);
-									}
-									else
-									{
-										redundantOutputs = channelConnectionManager.getRedundantStreamInputsForPrimary(connectionInfo->sourceEntityId, connection->sourceStreamIndex);
-										redundantInputs = channelConnectionManager.getRedundantStreamOutputsForPrimary(connection->targetEntityId, connection->targetStreamIndex);
-									}
-									auto itOutputs = redundantOutputs.begin();
-									auto itInputs = redundantInputs.begin();
-
-									if (itOutputs != redundantOutputs.end() && itInputs != redundantInputs.end())
-									{
-										// skip primary
-										itOutputs++;
-										itInputs++;
-									}
-
-									while (itOutputs != redundantOutputs.end() && itInputs != redundantInputs.end())
-									{
-										connectionLines.append(QString(clusterName).append(": ").append(avdecc::helper::smartEntityName(*controlledEntity.get())).append(" (Sec)"));
-
-										itOutputs++;
-										itInputs++;
-									}
-								}
-								else
-								{
-									connectionLines.append(QString(clusterName).append(": ").append(avdecc::helper::smartEntityName(*controlledEntity.get())));
-								}
-							}
-							innerRow++;
-						}
-					}
-					return connectionLines;
-				}
-				catch (...)
+				auto const& node = tableDataAtRow(index.row());
+				auto connectionLines = QVariantList{};
+				for (auto const& line : node.connectionLines)
 				{
-					return {};
+					connectionLines.append(line);
 				}
+				return connectionLines;
 			}
 			break;
 		}
@@ -528,91 +691,13 @@ QVariant DeviceDetailsChannelTableModelPrivate::data(QModelIndex const& index, i
 		{
 			if (role == Qt::DisplayRole)
 			{
-				try
-				{
-					QVariantList connectionStates;
-					auto const& connectionInfo = _nodes.at(index.row()).connectionInformation;
-					for (auto const& connection : connectionInfo->targets)
-					{
-						QVariantList connectionStatesTmp;
-						auto talkerEntityId = la::avdecc::UniqueIdentifier::getNullUniqueIdentifier();
-						auto listenerEntityId = la::avdecc::UniqueIdentifier::getNullUniqueIdentifier();
-						auto talkerStreamIndex = la::avdecc::entity::model::StreamIndex{};
-						auto listenerStreamIndex = la::avdecc::entity::model::StreamIndex{};
-
-						if (connectionInfo->sourceClusterChannelInfo->direction == avdecc::ChannelConnectionDirection::OutputToInput)
-						{
-							talkerEntityId = connectionInfo->sourceEntityId;
-							listenerEntityId = connection->targetEntityId;
-							talkerStreamIndex = connection->sourceStreamIndex;
-							listenerStreamIndex = connection->targetStreamIndex;
-						}
-						else
-						{
-							talkerEntityId = connection->targetEntityId;
-							listenerEntityId = connectionInfo->sourceEntityId;
-							talkerStreamIndex = connection->targetStreamIndex;
-							listenerStreamIndex = connection->sourceStreamIndex;
-						}
-
-						auto const& manager = avdecc::ControllerManager::getInstance();
-						auto talkerEntity = manager.getControlledEntity(talkerEntityId);
-						auto listenerEntity = manager.getControlledEntity(listenerEntityId);
-
-						if (!talkerEntity || !listenerEntity)
-						{
-							continue;
-						}
-						auto const& talkerEntityNode = talkerEntity->getEntityNode();
-						auto const& listenerEntityNode = listenerEntity->getEntityNode();
-
-						if (talkerEntityNode.dynamicModel && listenerEntityNode.dynamicModel)
-						{
-							{
-								auto status = calculateConnectionStatus(talkerEntityId, talkerStreamIndex, listenerEntityId, listenerStreamIndex);
-
-								connectionStatesTmp.append(QVariant::fromValue(status));
-							}
-
-							if (connection->isSourceRedundant && connection->isTargetRedundant)
-							{
-								auto const& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
-
-								auto redundantOutputs = channelConnectionManager.getRedundantStreamOutputsForPrimary(talkerEntityId, talkerStreamIndex);
-								auto redundantInputs = channelConnectionManager.getRedundantStreamInputsForPrimary(listenerEntityId, listenerStreamIndex);
-
-								auto itOutputs = redundantOutputs.begin();
-								auto itInputs = redundantInputs.begin();
-
-								if (itOutputs != redundantOutputs.end() && itInputs != redundantInputs.end())
-								{
-									// skip primary
-									itOutputs++;
-									itInputs++;
-								}
-								while (itOutputs != redundantOutputs.end() && itInputs != redundantInputs.end())
-								{
-									auto status = calculateConnectionStatus(talkerEntityId, itOutputs->first, listenerEntityId, itInputs->first);
-									connectionStatesTmp.append(QVariant::fromValue(status));
-
-									itOutputs++;
-									itInputs++;
-								}
-							}
-
-							// add the states for each cluster channel
-							for (uint32_t i = 0; i < connection->targetClusterChannels.size(); i++)
-							{
-								connectionStates << connectionStatesTmp;
-							}
-						}
-					}
-					return connectionStates;
-				}
-				catch (...)
+				auto const& node = tableDataAtRow(index.row());
+				auto connectionStates = QVariantList{};
+				for (auto const& status : node.connectionStatuses)
 				{
-					return {};
+					connectionStates.append(QVariant::fromValue(status));
 				}
+				return connectionStates;
 			}
 			break;
 		}
@@ -869,7 +954,7 @@ TableRowEntry const& DeviceDetailsChannelTableModel::tableDataAtRow(int row) con
 void ConnectionStateItemDelegate::paint(QPainter* painter, QStyleOptionViewItem const& option, QModelIndex const& index) const
 {
 	auto const* const model = static_cast<DeviceDetailsChannelTableModel const*>(index.model());
-	auto modelData = model->data(index).toList(); // data returns a list of DeviceDetailsChannelTableModel::ConnectionStatus to decide which connection icon to render.
+	auto const& connectionStatuses = model->tableDataAtRow(index.row()).connectionStatuses; // cached list of DeviceDetailsChannelTableModel::ConnectionStatus to decide which connection icon to render.
 
 	QFontMetrics fm(option.fontMetrics);
 	int fontPixelHeight = fm.height();
@@ -884,10 +969,8 @@ void ConnectionStateItemDelegate::paint(QPainter* painter, QStyleOptionViewItem
 	}
 
 	int margin = ConnectionStateItemDelegate::Margin;
-	for (auto const& connection : modelData)
+	for (auto const& status : connectionStatuses)
 	{
-		DeviceDetailsChannelTableModel::ConnectionStatus status = connection.value<DeviceDetailsChannelTableModel::ConnectionStatus>();
-
 		QRect iconDrawRect(option.rect.left() + (option.rect.width() - circleDiameter) / 2.0f, option.rect.top() + margin + innerRow * (fontPixelHeight + margin), circleDiameter, circleDiameter);
 
 		connectionMatrix::paintHelper::drawCapabilities(painter, iconDrawRect, status.type, status.state, status.flags);
@@ -905,11 +988,11 @@ QSize ConnectionStateItemDelegate::sizeHint(QStyleOptionViewItem const& option,
 	QFontMetrics fm(option.fontMetrics);
 	int fontPixelHeight = fm.height();
 	auto const* const model = static_cast<DeviceDetailsChannelTableModel const*>(index.model());
-	auto modelData = model->data(index).toList();
+	auto const& row = model->tableDataAtRow(index.row());
 
 	int margin = ConnectionStateItemDelegate::Margin;
 	int totalHeight = margin;
-	totalHeight += (fontPixelHeight + margin) * modelData.size();
+	totalHeight += (fontPixelHeight + margin) * static_cast<int>(row.connectionStatuses.size());
 	return QSize(40, totalHeight);
 }
 
@@ -924,7 +1007,7 @@ QSize ConnectionStateItemDelegate::sizeHint(QStyleOptionViewItem const& option,
 void ConnectionInfoItemDelegate::paint(QPainter* painter, QStyleOptionViewItem const& option, QModelIndex const& index) const
 {
 	auto const* const model = static_cast<DeviceDetailsChannelTableModel const*>(index.model());
-	auto modelData = model->data(index).toList(); // data returns a string list to display for connection info
+	auto const& connectionLines = model->tableDataAtRow(index.row()).connectionLines; // cached string list to display for connection info
 
 	QFontMetrics fm(option.fontMetrics);
 	int fontPixelHeight = fm.height();
@@ -937,10 +1020,8 @@ void ConnectionInfoItemDelegate::paint(QPainter* painter, QStyleOptionViewItem c
 	}
 
 	int margin = ConnectionStateItemDelegate::Margin;
-	for (auto const& connection : modelData)
+	for (auto const& line : connectionLines)
 	{
-		QString line = connection.toString();
-
 		QRect textDrawRect(option.rect.left() + margin / 2, option.rect.top() + margin + innerRow * (fontPixelHeight + margin), option.rect.width(), fontPixelHeight);
 		painter->drawText(textDrawRect, line);
 
@@ -957,11 +1038,11 @@ QSize ConnectionInfoItemDelegate::sizeHint(QStyleOptionViewItem const& option, Q
 	QFontMetrics fm(option.fontMetrics);
 	int fontPixelHeight = fm.height();
 	auto const* const model = static_cast<DeviceDetailsChannelTableModel const*>(index.model());
-	auto modelData = model->data(index).toList();
+	auto const& row = model->tableDataAtRow(index.row());
 
 	int margin = ConnectionStateItemDelegate::Margin;
 	int totalHeight = margin;
-	totalHeight += (fontPixelHeight + margin) * modelData.size();
+	totalHeight += (fontPixelHeight + margin) * row.connectionLines.size();
 	return QSize(350, totalHeight);
 }
 
@@ -24,6 +24,9 @@
 #include <QStyledItemDelegate>
 #include <QTableView>
 
+#include <cstdint>
+#include <vector>
+
 #include "avdecc/controllerManager.hpp"
 #include "avdecc/channelConnectionManager.hpp"
 #include "connectionMatrix/paintHelper.hpp"
@@ -47,26 +50,7 @@ enum class DeviceDetailsChannelTableModelColumn
 
 };
 
-//**************************************************************
-//class TableRowEntry
-//**************************************************************
-/**
-* @brief	Helper struct. Holds all data needed to to display a table row.
-* [@author  Marius Erlen]
-* [@date    2018-10-11]
-*/
-struct TableRowEntry
-{
-	/**
-	* Constructor.
-	*/
-	TableRowEntry(std::shared_ptr<avdecc::TargetConnectionInformations> connectionInformation)
-	{
-		this->connectionInformation = connectionInformation;
-	}
-
-	std::shared_ptr<avdecc::TargetConnectionInformations> connectionInformation;
-};
+struct TableRowEntry;
 
 //**************************************************************
 //class ConnectionStateItemDelegate
@@ -134,6 +118,11 @@ public:
 		connectionMatrix::Model::IntersectionData::Type type{ connectionMatrix::Model::IntersectionData::Type::None };
 		connectionMatrix::Model::IntersectionData::State state{ connectionMatrix::Model::IntersectionData::State::NotConnected };
 		connectionMatrix::Model::IntersectionData::Flags flags{};
+
+		bool operator==(ConnectionStatus const& other) const noexcept
+		{
+			return type == other.type && state == other.state && flags == other.flags;
+		}
 	};
 
 	virtual int rowCount(QModelIndex const& parent = QModelIndex()) const override;
@@ -164,4 +153,35 @@ private:
 	friend class ConnectionInfoItemDelegate;
 };
 
+//**************************************************************
+//class TableRowEntry
+//**************************************************************
+/**
+* @brief	Helper struct. Holds all data needed to to display a table row.
+* [@author  Marius Erlen]
+* [@date    2018-10-11]
+*
+* The connection statuses and lines painted by the delegates are computed once, and only computed again
+* when the connections of the row are updated.
+* Rows whose painted connections changed are stamped with the refresh generation of the model, the views
+* being notified once per run of consecutive changed rows when the refresh completes.
+*/
+struct TableRowEntry
+{
+	/**
+	* Constructor.
+	*/
+	TableRowEntry(std::shared_ptr<avdecc::TargetConnectionInformations> connectionInformation)
+	{
+		this->connectionInformation = connectionInformation;
+	}
+
+	std::shared_ptr<avdecc::TargetConnectionInformations> connectionInformation;
+
+	mutable bool isRenderCacheValid{ false }; // connectionStatuses and connectionLines are up-to-date with connectionInformation
+	mutable std::vector<DeviceDetailsChannelTableModel::ConnectionStatus> connectionStatuses{}; // One per painted line of the ConnectionStatus column
+	mutable QStringList connectionLines{}; // Painted lines of the Connection column
+	std::uint64_t changedGeneration{ 0u }; // Refresh generation in which connectionStatuses or connectionLines last changed
+};
+
 Q_DECLARE_METATYPE(DeviceDetailsChannelTableModel::ConnectionStatus)
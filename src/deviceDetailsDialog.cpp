@@ -23,6 +23,7 @@
 #include <QLayout>
 #include <QStringListModel>
 #include <QMessageBox>
+#include <QProgressDialog>
 
 #include <la/avdecc/avdecc.hpp>
 #include <la/avdecc/controller/avdeccController.hpp>
@@ -32,6 +33,21 @@
 #include "internals/config.hpp"
 #include "avdecc/helper.hpp"
 #include "avdecc/channelConnectionManager.hpp"
+#include "avdecc/commandChain.hpp"
+
+/** Completes the command of the apply graph once the device answered */
+static auto makeApplyResponseHandler(avdecc::commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex, avdecc::ControllerManager::AecpCommandType const commandType) noexcept
+{
+	return [parentCommandSet, commandIndex, commandType](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status)
+	{
+		auto const error = avdecc::commandChain::AsyncParallelCommandSet::aemCommandStatusToCommandError(status);
+		if (error != avdecc::commandChain::CommandExecutionError::NoError)
+		{
+			parentCommandSet->addErrorInfo(entityID, error, commandType);
+		}
+		parentCommandSet->invokeCommandCompleted(commandIndex, error != avdecc::commandChain::CommandExecutionError::NoError);
+	};
+}
 
 // **************************************************************
 // class DeviceDetailsDialogImpl
@@ -41,11 +57,11 @@
 * [@author  Marius Erlen]
 * [@date    2018-09-21]
 *
-* Implements the EntityModelVisitor to get informed about every node in the given entity.
-* Holds the state of the changes until the apply button is pressed, then uses the avdecc::ControllerManager class to
-* write the changes to the device.
+* Each tab is only filled the first time it is shown, from a snapshot of the current configuration taken when the entity is loaded.
+* Holds the state of the changes until the apply button is pressed, then writes all of them to the device
+* in a single command graph.
 */
-class DeviceDetailsDialogImpl final : private Ui::DeviceDetailsDialog, public QObject, public la::avdecc::controller::model::EntityModelVisitor
+class DeviceDetailsDialogImpl final : private Ui::DeviceDetailsDialog, public QObject
 {
 private:
 	::DeviceDetailsDialog* _dialog;
@@ -53,14 +69,20 @@ private:
 	std::optional<la::avdecc::entity::model::DescriptorIndex> _activeConfigurationIndex = std::nullopt, _previousConfigurationIndex = std::nullopt;
 	std::optional<uint32_t> _userSelectedLatency = std::nullopt;
 	QMap<QWidget*, bool> _hasChangesMap;
-	bool _applyRequested = false;
-	int _expectedChanges = 0;
-	int _gottenChanges = 0;
 	bool _hasChangesByUser = false;
+	avdecc::commandChain::AsyncCommandGraphExecuter _applyExecuter{};
+	QProgressDialog* _applyProgressDialog{ nullptr };
 
 	DeviceDetailsChannelTableModel _deviceDetailsChannelTableModelReceive;
 	DeviceDetailsChannelTableModel _deviceDetailsChannelTableModelTransmit;
 
+	std::optional<la::avdecc::controller::model::ConfigurationNode> _configurationNode{ std::nullopt }; // Snapshot of the current configuration, shared by all the tabs
+	bool _receiveTabLoaded{ false };
+	bool _transmitTabLoaded{ false };
+	bool _latencyTabLoaded{ false };
+	bool _channelSignalsConnected{ false };
+	bool _latencySignalsConnected{ false };
+
 public:
 	/**
 	* Constructor.
@@ -108,22 +130,21 @@ public:
 		connect(pushButtonApplyChanges, &QPushButton::clicked, this, &DeviceDetailsDialogImpl::applyChanges);
 		connect(pushButtonRevertChanges, &QPushButton::clicked, this, &DeviceDetailsDialogImpl::revertChanges);
 
+		// tabs are loaded the first time they are shown
+		connect(tabWidget, &QTabWidget::currentChanged, this, &DeviceDetailsDialogImpl::loadTab);
+
 		auto& manager = avdecc::ControllerManager::getInstance();
-		auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
 
 		connect(&manager, &avdecc::ControllerManager::entityOffline, this, &DeviceDetailsDialogImpl::entityOffline);
-		connect(&manager, &avdecc::ControllerManager::endAecpCommand, this, &DeviceDetailsDialogImpl::onEndAecpCommand);
-		connect(&manager, &avdecc::ControllerManager::gptpChanged, this, &DeviceDetailsDialogImpl::gptpChanged);
-		connect(&manager, &avdecc::ControllerManager::streamRunningChanged, this, &DeviceDetailsDialogImpl::streamRunningChanged);
-		connect(&manager, &avdecc::ControllerManager::streamConnectionsChanged, this, &DeviceDetailsDialogImpl::streamConnectionsChanged);
-		connect(&manager, &avdecc::ControllerManager::streamPortAudioMappingsChanged, this, &DeviceDetailsDialogImpl::streamPortAudioMappingsChanged);
-		connect(&manager, &avdecc::ControllerManager::streamDynamicInfoChanged, this, &DeviceDetailsDialogImpl::streamDynamicInfoChanged);
-		connect(&channelConnectionManager, &avdecc::ChannelConnectionManager::listenerChannelConnectionsUpdate, this, &DeviceDetailsDialogImpl::listenerChannelConnectionsUpdate);
+
+		// the apply graph reports its progress and completion in the UI thread
+		qRegisterMetaType<avdecc::commandChain::CommandExecutionErrors>("CommandExecutionErrors");
+		connect(&_applyExecuter, &avdecc::commandChain::AsyncCommandGraphExecuter::progressUpdate, this, &DeviceDetailsDialogImpl::applyProgressUpdate, Qt::QueuedConnection);
+		connect(&_applyExecuter, &avdecc::commandChain::AsyncCommandGraphExecuter::completed, this, &DeviceDetailsDialogImpl::applyCompleted, Qt::QueuedConnection);
 
 		// register for changes, to update the data live in the dialog, except the user edited it already:
 		connect(&manager, &avdecc::ControllerManager::entityNameChanged, this, &DeviceDetailsDialogImpl::entityNameChanged);
 		connect(&manager, &avdecc::ControllerManager::entityGroupNameChanged, this, &DeviceDetailsDialogImpl::entityGroupNameChanged);
-		connect(&manager, &avdecc::ControllerManager::audioClusterNameChanged, this, &DeviceDetailsDialogImpl::audioClusterNameChanged);
 	}
 
 	/**
@@ -190,47 +211,162 @@ public:
 			{
 				const QSignalBlocker blocker(comboBoxConfiguration);
 				comboBoxConfiguration->clear();
+				for (auto const& configurationKV : controlledEntity->getEntityNode().configurations)
+				{
+					comboBoxConfiguration->addItem(avdecc::helper::configurationName(controlledEntity.get(), configurationKV.second), configurationKV.first);
+
+					if (configurationKV.second.dynamicModel->isActiveConfiguration && !_activeConfigurationIndex)
+					{
+						_activeConfigurationIndex = configurationKV.first;
+					}
+				}
+			}
+			if (_activeConfigurationIndex)
+			{
+				comboBoxConfiguration->setCurrentIndex(*_activeConfigurationIndex);
 			}
 
-			if (controlledEntity)
+			// all the tabs are loaded from this snapshot, the channel tables being only filled when shown
+			_configurationNode = std::move(configurationNode);
+			_receiveTabLoaded = false;
+			_transmitTabLoaded = false;
+			_latencyTabLoaded = false;
+
+			auto pureListener = (!_configurationNode->streamInputs.empty() && _configurationNode->streamOutputs.empty());
+			auto pureTalker = (_configurationNode->streamInputs.empty() && !_configurationNode->streamOutputs.empty());
+
+			auto tabCnt = tabWidget->count();
+			for (auto i = 0; i < tabCnt; ++i)
 			{
-				// invokes various visit methods.
-				controlledEntity->accept(this, false);
-				if (_activeConfigurationIndex)
+				QWidget* w = tabWidget->widget(i);
+				if (!w)
+					continue;
+
+				if (pureListener && (w == tabLatency || w == tabTransmit))
+				{
+					tabWidget->removeTab(i);
+					i--;
+				}
+				else if (pureTalker && w == tabReceive)
 				{
-					comboBoxConfiguration->setCurrentIndex(*_activeConfigurationIndex);
+					tabWidget->removeTab(i);
+					i--;
 				}
+			}
 
-				auto pureListener = (!configurationNode.streamInputs.empty() && configurationNode.streamOutputs.empty());
-				auto pureTalker = (configurationNode.streamInputs.empty() && !configurationNode.streamOutputs.empty());
+			loadTab(tabWidget->currentIndex());
+		}
+	}
 
-				auto tabCnt = tabWidget->count();
-				for (auto i = 0; i < tabCnt; ++i)
-				{
-					QWidget* w = tabWidget->widget(i);
-					if (!w)
-						continue;
+	/**
+	* Fills the given tab, if not already done for the loaded entity.
+	* @param index Index of the tab in the tab widget.
+	*/
+	void loadTab(int const index)
+	{
+		if (!_configurationNode)
+		{
+			return;
+		}
 
-					if (pureListener && (w->objectName() == "tabLatency" || w->objectName() == "tabTransmit"))
-					{
-						tabWidget->removeTab(i);
-						i--;
-					}
-					else if (pureTalker && w->objectName() == "tabReceive")
-					{
-						tabWidget->removeTab(i);
-						i--;
-					}
-				}
+		// the dynamic models of the snapshot belong to the entity, keep it locked while reading them
+		auto controlledEntity = avdecc::ControllerManager::getInstance().getControlledEntity(_entityID);
+		if (!controlledEntity)
+		{
+			return;
+		}
 
-				if (!pureListener)
+		auto const* const tab = tabWidget->widget(index);
+		if (tab == tabReceive && !_receiveTabLoaded)
+		{
+			_receiveTabLoaded = true;
+			connectChannelSignals();
+			loadChannelTable(avdecc::ChannelConnectionDirection::InputToOutput);
+			tableViewReceive->resizeColumnsToContents();
+			tableViewReceive->resizeRowsToContents();
+		}
+		else if (tab == tabTransmit && !_transmitTabLoaded)
+		{
+			_transmitTabLoaded = true;
+			connectChannelSignals();
+			loadChannelTable(avdecc::ChannelConnectionDirection::OutputToInput);
+			tableViewTransmit->resizeColumnsToContents();
+			tableViewTransmit->resizeRowsToContents();
+		}
+		else if (tab == tabLatency && !_latencyTabLoaded)
+		{
+			_latencyTabLoaded = true;
+			if (!_latencySignalsConnected)
+			{
+				_latencySignalsConnected = true;
+				connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::streamDynamicInfoChanged, this, &DeviceDetailsDialogImpl::streamDynamicInfoChanged);
+			}
+			loadLatencyData();
+		}
+	}
+
+	/**
+	* Adds a row for every channel of the input (or output) stream ports of the snapshot, to the matching table.
+	*/
+	void loadChannelTable(avdecc::ChannelConnectionDirection const direction)
+	{
+		auto const isReceive = direction == avdecc::ChannelConnectionDirection::InputToOutput;
+		auto& tableModel = isReceive ? _deviceDetailsChannelTableModelReceive : _deviceDetailsChannelTableModelTransmit;
+		auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
+
+		for (auto const& audioUnitKV : _configurationNode->audioUnits)
+		{
+			auto const& streamPorts = isReceive ? audioUnitKV.second.streamPortInputs : audioUnitKV.second.streamPortOutputs;
+			for (auto const& streamPortKV : streamPorts)
+			{
+				for (auto const& audioClusterKV : streamPortKV.second.audioClusters)
 				{
-					loadLatencyData();
+					for (std::uint16_t channelIndex = 0u; channelIndex < audioClusterKV.second.staticModel->channelCount; channelIndex++)
+					{
+						auto sourceChannelIdentification = avdecc::ChannelIdentification{ _configurationNode->descriptorIndex, audioClusterKV.first, channelIndex, direction, audioUnitKV.first, streamPortKV.first, streamPortKV.second.staticModel->baseCluster };
+						auto connectionInformation = isReceive ? channelConnectionManager.getChannelConnectionsReverse(_entityID, sourceChannelIdentification) : channelConnectionManager.getChannelConnections(_entityID, sourceChannelIdentification);
+
+						tableModel.addNode(connectionInformation);
+					}
 				}
 			}
+		}
+	}
+
+	/**
+	* Registers to the changes displayed in the channel tables, once one of them has been loaded.
+	*/
+	void connectChannelSignals()
+	{
+		if (_channelSignalsConnected)
+		{
+			return;
+		}
+		_channelSignalsConnected = true;
+
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
 
+		connect(&manager, &avdecc::ControllerManager::gptpChanged, this, &DeviceDetailsDialogImpl::gptpChanged);
+		connect(&manager, &avdecc::ControllerManager::streamRunningChanged, this, &DeviceDetailsDialogImpl::streamRunningChanged);
+		connect(&manager, &avdecc::ControllerManager::streamConnectionsChanged, this, &DeviceDetailsDialogImpl::streamConnectionsChanged);
+		connect(&manager, &avdecc::ControllerManager::streamPortAudioMappingsChanged, this, &DeviceDetailsDialogImpl::streamPortAudioMappingsChanged);
+		connect(&manager, &avdecc::ControllerManager::audioClusterNameChanged, this, &DeviceDetailsDialogImpl::audioClusterNameChanged);
+		connect(&channelConnectionManager, &avdecc::ChannelConnectionManager::listenerChannelConnectionsUpdate, this, &DeviceDetailsDialogImpl::listenerChannelConnectionsUpdate);
+	}
+
+	/**
+	* Resizes the channel tables which have been loaded, after their content changed.
+	*/
+	void resizeChannelTables()
+	{
+		if (_receiveTabLoaded)
+		{
 			tableViewReceive->resizeColumnsToContents();
 			tableViewReceive->resizeRowsToContents();
+		}
+		if (_transmitTabLoaded)
+		{
 			tableViewTransmit->resizeColumnsToContents();
 			tableViewTransmit->resizeRowsToContents();
 		}
@@ -238,68 +374,72 @@ public:
 
 	/**
 	* Invoked when the apply button is clicked.
-	* Writes all data via the avdecc::ControllerManager. The avdecc::ControllerManager::endAecpCommand signal is used
-	* to determine the state of the requested commands.
+	* All the changes are sent as a single command set, the device being queried at most AsyncParallelCommandSet::DefaultMaxInFlightCommandsPerEntity
+	* commands at a time. The dialog is re-enabled when all of them completed.
 	*/
 	void applyChanges()
 	{
 		_hasChangesByUser = false;
 		updateButtonStates();
-		_applyRequested = true;
-		_expectedChanges = 0;
-		_gottenChanges = 0;
 
-		auto& manager = avdecc::ControllerManager::getInstance();
+		auto const entityID = _entityID;
+		auto* const commandSet = new avdecc::commandChain::AsyncParallelCommandSet{};
 
 		// set all data
 		if (_hasChangesMap.contains(lineEditDeviceName) && _hasChangesMap[lineEditDeviceName])
 		{
-			manager.setEntityName(_entityID, lineEditDeviceName->text());
-			_expectedChanges++;
+			auto const name = lineEditDeviceName->text();
+			commandSet->append(entityID,
+				[entityID, name](avdecc::commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+				{
+					avdecc::ControllerManager::getInstance().setEntityName(entityID, name, makeApplyResponseHandler(parentCommandSet, commandIndex, avdecc::ControllerManager::AecpCommandType::SetEntityName));
+					return true;
+				});
 		}
 		if (_hasChangesMap.contains(lineEditGroupName) && _hasChangesMap[lineEditGroupName])
 		{
-			manager.setEntityGroupName(_entityID, lineEditGroupName->text());
-			_expectedChanges++;
-		}
-
-		//iterate over the changes and write them via avdecc
-		QMap<la::avdecc::entity::model::DescriptorIndex, QMap<DeviceDetailsChannelTableModelColumn, QVariant>*> changesReceive = _deviceDetailsChannelTableModelReceive.getChanges();
-		for (auto e : changesReceive.keys())
-		{
-			auto rxChanges = changesReceive.value(e);
-			for (auto f : rxChanges->keys())
-			{
-				if (f == DeviceDetailsChannelTableModelColumn::ChannelName)
+			auto const name = lineEditGroupName->text();
+			commandSet->append(entityID,
+				[entityID, name](avdecc::commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
 				{
-					manager.setAudioClusterName(_entityID, *_activeConfigurationIndex, e, rxChanges->value(f).toString());
-					_expectedChanges++;
-				}
-			}
+					avdecc::ControllerManager::getInstance().setEntityGroupName(entityID, name, makeApplyResponseHandler(parentCommandSet, commandIndex, avdecc::ControllerManager::AecpCommandType::SetEntityGroupName));
+					return true;
+				});
 		}
 
-		QMap<la::avdecc::entity::model::DescriptorIndex, QMap<DeviceDetailsChannelTableModelColumn, QVariant>*> changesTransmit = _deviceDetailsChannelTableModelTransmit.getChanges();
-		for (auto e : changesTransmit.keys())
+		//iterate over the changes of both tables and write them via avdecc
+		if (_activeConfigurationIndex)
 		{
-			auto txChanges = changesTransmit.value(e);
-			for (auto f : txChanges->keys())
+			auto const configurationIndex = *_activeConfigurationIndex;
+			for (auto const* const tableModel : { &_deviceDetailsChannelTableModelReceive, &_deviceDetailsChannelTableModelTransmit })
 			{
-				if (f == DeviceDetailsChannelTableModelColumn::ChannelName)
+				auto const changes = tableModel->getChanges();
+				for (auto const clusterIndex : changes.keys())
 				{
-					manager.setAudioClusterName(_entityID, *_activeConfigurationIndex, e, txChanges->value(f).toString());
-					_expectedChanges++;
+					auto const* const clusterChanges = changes.value(clusterIndex);
+					if (!clusterChanges->contains(DeviceDetailsChannelTableModelColumn::ChannelName))
+					{
+						continue;
+					}
+					auto const name = clusterChanges->value(DeviceDetailsChannelTableModelColumn::ChannelName).toString();
+					commandSet->append(entityID,
+						[entityID, configurationIndex, clusterIndex, name](avdecc::commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+						{
+							avdecc::ControllerManager::getInstance().setAudioClusterName(entityID, configurationIndex, clusterIndex, name, makeApplyResponseHandler(parentCommandSet, commandIndex, avdecc::ControllerManager::AecpCommandType::SetAudioClusterName));
+							return true;
+						});
 				}
 			}
 		}
 
 		// apply the new stream info (latency)
-		if (_userSelectedLatency)
+		if (_userSelectedLatency && _configurationNode)
 		{
+			auto& manager = avdecc::ControllerManager::getInstance();
 			auto const controlledEntity = manager.getControlledEntity(_entityID);
 			if (controlledEntity)
 			{
-				auto configurationNode = controlledEntity->getCurrentConfigurationNode();
-				for (auto const& streamOutput : configurationNode.streamOutputs)
+				for (auto const& streamOutput : _configurationNode->streamOutputs)
 				{
 					auto const streamFormatInfo = la::avdecc::entity::model::StreamFormatInfo::create(streamOutput.second.dynamicModel->streamFormat);
 					auto const streamType = streamFormatInfo->getType();
@@ -316,162 +456,94 @@ public:
 						streamInfo.msrpAccumulatedLatency = *_userSelectedLatency;
 
 						// TODO: All streams have to be stopped for this to work. So this needs a state machine / task sequence.
-						// TODO: needs update of library:
-						manager.setStreamOutputInfo(_entityID, streamOutput.first, streamInfo);
+						auto const streamIndex = streamOutput.first;
+						commandSet->append(entityID,
+							[entityID, streamIndex, streamInfo](avdecc::commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+							{
+								avdecc::ControllerManager::getInstance().setStreamOutputInfo(entityID, streamIndex, streamInfo, makeApplyResponseHandler(parentCommandSet, commandIndex, avdecc::ControllerManager::AecpCommandType::SetStreamInfo));
+								return true;
+							});
 					}
 				}
 			}
 		}
 
-		// applying the new configuration shall be done as the last step, as it may change everything displayed.
-		// TODO: All streams have to be stopped for this to function. So this needs a state machine / task sequence.
-		if (_previousConfigurationIndex != _activeConfigurationIndex)
-		{
-			manager.setConfiguration(_entityID, *_activeConfigurationIndex); // this needs a handler to make it sequential.
-			_expectedChanges++;
-		}
-	}
+		_applyExecuter.addCommandSet(commandSet, { entityID });
 
-	/**
-	* Invoked when the cancel button is clicked. Reverts all changes in the dialog.
-	*/
-	void revertChanges()
-	{
-		_hasChangesByUser = false;
-		updateButtonStates();
-		_activeConfigurationIndex = std::nullopt;
-		_userSelectedLatency = std::nullopt;
+		_applyProgressDialog = new QProgressDialog("Applying changes...", {}, 0, static_cast<int>(commandSet->parallelCommandCount()), _dialog);
+		_applyProgressDialog->setAttribute(Qt::WA_DeleteOnClose);
+		_applyProgressDialog->setWindowModality(Qt::WindowModal);
+		_applyProgressDialog->setMinimumDuration(500);
+		_applyProgressDialog->setValue(0);
+		tabWidget->setEnabled(false);
 
-		_deviceDetailsChannelTableModelTransmit.resetChangedData();
-		_deviceDetailsChannelTableModelTransmit.removeAllNodes();
-		_deviceDetailsChannelTableModelReceive.resetChangedData();
-		_deviceDetailsChannelTableModelReceive.removeAllNodes();
-
-		// read out actual data again
-		loadCurrentControlledEntity(_entityID, false);
+		_applyExecuter.start();
 	}
 
-
-	/**
-	* Ignored.
-	*/
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::EntityNode const& /*node*/) noexcept override {}
-
 	/**
-	* Get every configuration. Set the active configuration if it wasn't set before already.
+	* Invoked each time one of the commands of the apply completed.
 	*/
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::EntityNode const* const /*parent*/, la::avdecc::controller::model::ConfigurationNode const& node) noexcept override
+	void applyProgressUpdate(uint32_t const completedCommands, uint32_t const totalCommands)
 	{
-		QSignalBlocker const blocker(comboBoxConfiguration);
-		comboBoxConfiguration->addItem(avdecc::helper::configurationName(controlledEntity, node), node.descriptorIndex);
-
-		// relevant Node:
-		if (node.dynamicModel->isActiveConfiguration && !_activeConfigurationIndex)
+		if (_applyProgressDialog)
 		{
-			_activeConfigurationIndex = node.descriptorIndex;
+			_applyProgressDialog->setMaximum(static_cast<int>(totalCommands));
+			_applyProgressDialog->setValue(static_cast<int>(completedCommands));
 		}
 	}
 
 	/**
-	* Add every transmit and receive node into the table.
+	* Invoked once all the commands of the apply completed. Reports the errors and reads out the current state of the device.
 	*/
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::ConfigurationNode const* const /*parent*/, la::avdecc::controller::model::AudioUnitNode const& node) noexcept override
+	void applyCompleted(avdecc::commandChain::CommandExecutionErrors const errors)
 	{
-		if (!controlledEntity)
+		if (_applyProgressDialog)
 		{
-			return;
+			_applyProgressDialog->close();
+			_applyProgressDialog = nullptr;
 		}
-		auto audioUnitIndex = node.descriptorIndex;
+		tabWidget->setEnabled(true);
 
-		auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
-		for (auto const& streamPortInputKV : node.streamPortInputs)
+		// applying the new configuration shall be done as the last step, as it may change everything displayed.
+		// TODO: All streams have to be stopped for this to function. So this needs a state machine / task sequence.
+		if (_activeConfigurationIndex && _previousConfigurationIndex != _activeConfigurationIndex)
 		{
-			for (auto const& inputAudioClusterKV : streamPortInputKV.second.audioClusters)
-			{
-				for (std::uint16_t channelIndex = 0u; channelIndex < inputAudioClusterKV.second.staticModel->channelCount; channelIndex++)
-				{
-					auto sourceChannelIdentification = avdecc::ChannelIdentification{ *_previousConfigurationIndex, inputAudioClusterKV.first, channelIndex, avdecc::ChannelConnectionDirection::InputToOutput, audioUnitIndex, streamPortInputKV.first, streamPortInputKV.second.staticModel->baseCluster };
-					auto connectionInformation = channelConnectionManager.getChannelConnectionsReverse(_entityID, sourceChannelIdentification);
-
-					_deviceDetailsChannelTableModelReceive.addNode(connectionInformation);
-				}
-			}
+			avdecc::ControllerManager::getInstance().setConfiguration(_entityID, *_activeConfigurationIndex);
 		}
 
-		for (auto const& streamPortOutputKV : node.streamPortOutputs)
+		if (!errors.empty())
 		{
-			for (auto const& outputAudioClusterKV : streamPortOutputKV.second.audioClusters)
+			auto text = QString{};
+			for (auto const& errorKV : errors)
 			{
-				for (std::uint16_t channelIndex = 0u; channelIndex < outputAudioClusterKV.second.staticModel->channelCount; channelIndex++)
-				{
-					auto sourceChannelIdentification = avdecc::ChannelIdentification{ *_previousConfigurationIndex, outputAudioClusterKV.first, channelIndex, avdecc::ChannelConnectionDirection::OutputToInput, audioUnitIndex, streamPortOutputKV.first, streamPortOutputKV.second.staticModel->baseCluster };
-					auto connectionInformation = channelConnectionManager.getChannelConnections(_entityID, sourceChannelIdentification);
-
-					_deviceDetailsChannelTableModelTransmit.addNode(connectionInformation);
-				}
+				auto const& errorInfo = errorKV.second;
+				auto const command = errorInfo.commandTypeAecp ? avdecc::ControllerManager::typeToString(*errorInfo.commandTypeAecp) : QString{};
+				text += QString("%1: %2\n").arg(command).arg(avdecc::commandChain::AsyncParallelCommandSet::errorToString(errorInfo.errorType));
 			}
+			QMessageBox::warning(_dialog, "Error while applying", QString("%1 change(s) could not be applied:\n\n%2").arg(errors.size()).arg(text));
 		}
-	}
-
-	/**
-	* Ignored.
-	*/
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::ConfigurationNode const* const /*parent*/, la::avdecc::controller::model::StreamInputNode const& /*node*/) noexcept override {}
-
-	/**
-	* Ignored.
-	*/
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::ConfigurationNode const* const /*parent*/, la::avdecc::controller::model::StreamOutputNode const& /*node*/) noexcept override {}
-
-	/**
-	* Ignored.
-	*/
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::ConfigurationNode const* const /*parent*/, la::avdecc::controller::model::AvbInterfaceNode const& /*node*/) noexcept override {}
-
-	/**
-	* Ignored.
-	*/
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::ConfigurationNode const* const /*parent*/, la::avdecc::controller::model::ClockSourceNode const& /*node*/) noexcept override {}
-
-	/**
-	* Ignored.
-	*/
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::ConfigurationNode const* const /*parent*/, la::avdecc::controller::model::LocaleNode const& /*node*/) noexcept override {}
-
-	/**
-	* Ignored.
-	*/
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::ConfigurationNode const* const /*grandParent*/, la::avdecc::controller::model::LocaleNode const* const /*parent*/, la::avdecc::controller::model::StringsNode const& /*node*/) noexcept override {}
-
-	/**
-	* Ignored.
-	*/
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::ConfigurationNode const* const /*grandParent*/, la::avdecc::controller::model::AudioUnitNode const* const /*parent*/, la::avdecc::controller::model::StreamPortNode const& /*node*/) noexcept override {}
-
-	/**
-	* Ignored.
-	*/
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::ConfigurationNode const* const /*grandGrandParent*/, la::avdecc::controller::model::AudioUnitNode const* const /*grandParent*/, la::avdecc::controller::model::StreamPortNode const* const /*parent*/, la::avdecc::controller::model::AudioClusterNode const& /*node*/) noexcept override {}
 
-	/**
-	* Ignored.
-	*/
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::ConfigurationNode const* const /*grandGrandParent*/, la::avdecc::controller::model::AudioUnitNode const* const /*grandParent*/, la::avdecc::controller::model::StreamPortNode const* const /*parent*/, la::avdecc::controller::model::AudioMapNode const& /*node*/) noexcept override {}
+		revertChanges(); // read out current state after apply.
+	}
 
 	/**
-	* Ignored.
+	* Invoked when the cancel button is clicked. Reverts all changes in the dialog.
 	*/
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::ConfigurationNode const* const /*parent*/, la::avdecc::controller::model::ClockDomainNode const& /*node*/) noexcept override {}
+	void revertChanges()
+	{
+		_hasChangesByUser = false;
+		updateButtonStates();
+		_activeConfigurationIndex = std::nullopt;
+		_userSelectedLatency = std::nullopt;
 
-	/**
-	* Ignored.
-	*/
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::ConfigurationNode const* const /*parent*/, la::avdecc::controller::model::RedundantStreamNode const& /*node*/) noexcept override {}
+		_deviceDetailsChannelTableModelTransmit.resetChangedData();
+		_deviceDetailsChannelTableModelTransmit.removeAllNodes();
+		_deviceDetailsChannelTableModelReceive.resetChangedData();
+		_deviceDetailsChannelTableModelReceive.removeAllNodes();
 
-	/**
-	* Ignored.
-	*/
-	virtual void visit(la::avdecc::controller::ControlledEntity const* const /*controlledEntity*/, la::avdecc::controller::model::ConfigurationNode const* const /*parent*/, la::avdecc::controller::model::MemoryObjectNode const& /*node*/) noexcept override {}
+		// read out actual data again
+		loadCurrentControlledEntity(_entityID, false);
+	}
 
 
 	// Slots
@@ -545,38 +617,6 @@ public:
 		}
 	}
 
-	/**
-	* Invoked after a command has been exectued. We use it to detect if all data that was changed has been written.
-	* @param entityID		The id of the entity the command was executed on.
-	* @param cmdType		The executed command type.
-	* @param commandStatus  The status of the command.
-	*/
-	void onEndAecpCommand(la::avdecc::UniqueIdentifier const entityID, avdecc::ControllerManager::AecpCommandType cmdType, la::avdecc::entity::ControllerEntity::AemCommandStatus const /*commandStatus*/)
-	{
-		// TODO propably show message when a command failed.
-		if (entityID == _entityID)
-		{
-			auto& manager = avdecc::ControllerManager::getInstance();
-			auto controlledEntity = manager.getControlledEntity(entityID);
-
-			switch (cmdType)
-			{
-				case avdecc::ControllerManager::AecpCommandType::SetEntityName:
-				case avdecc::ControllerManager::AecpCommandType::SetEntityGroupName:
-				case avdecc::ControllerManager::AecpCommandType::SetAudioClusterName:
-					_gottenChanges++;
-					break;
-				default:
-					break;
-			}
-		}
-		if (_applyRequested && _gottenChanges >= _expectedChanges)
-		{
-			_applyRequested = false;
-			revertChanges(); // read out current state after apply.
-		}
-	}
-
 	/**
 	* Updates the receive table model on changes.
 	* @param channels  All channels of the devices that have changed (listener side only)
@@ -585,10 +625,7 @@ public:
 	{
 		_deviceDetailsChannelTableModelReceive.channelConnectionsUpdate(channels);
 
-		tableViewReceive->resizeColumnsToContents();
-		tableViewReceive->resizeRowsToContents();
-		tableViewTransmit->resizeColumnsToContents();
-		tableViewTransmit->resizeRowsToContents();
+		resizeChannelTables();
 	}
 
 	/**
@@ -599,10 +636,7 @@ public:
 		_deviceDetailsChannelTableModelReceive.channelConnectionsUpdate(entityID);
 		_deviceDetailsChannelTableModelTransmit.channelConnectionsUpdate(entityID);
 
-		tableViewReceive->resizeColumnsToContents();
-		tableViewReceive->resizeRowsToContents();
-		tableViewTransmit->resizeColumnsToContents();
-		tableViewTransmit->resizeRowsToContents();
+		resizeChannelTables();
 	}
 
 	/**
@@ -613,18 +647,15 @@ public:
 		_deviceDetailsChannelTableModelReceive.channelConnectionsUpdate(entityID);
 		_deviceDetailsChannelTableModelTransmit.channelConnectionsUpdate(entityID);
 
-		tableViewReceive->resizeColumnsToContents();
-		tableViewReceive->resizeRowsToContents();
-		tableViewTransmit->resizeColumnsToContents();
-		tableViewTransmit->resizeRowsToContents();
+		resizeChannelTables();
 	}
 
 	/**
 	* Updates the latency tab data.
 	*/
-	void streamDynamicInfoChanged(la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const /*streamIndex*/, la::avdecc::entity::model::StreamDynamicInfo const /*streamDynamicInfo*/)
+	void streamDynamicInfoChanged(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const /*streamIndex*/, la::avdecc::entity::model::StreamDynamicInfo const& /*streamDynamicInfo*/)
 	{
-		if (descriptorType == la::avdecc::entity::model::DescriptorType::StreamOutput)
+		if (_latencyTabLoaded && _entityID == entityID && descriptorType == la::avdecc::entity::model::DescriptorType::StreamOutput)
 		{
 			// update latency tab.
 			loadLatencyData();
@@ -640,20 +671,14 @@ public:
 		{
 			_deviceDetailsChannelTableModelTransmit.channelConnectionsUpdate(entityID);
 
-			tableViewReceive->resizeColumnsToContents();
-			tableViewReceive->resizeRowsToContents();
-			tableViewTransmit->resizeColumnsToContents();
-			tableViewTransmit->resizeRowsToContents();
+			resizeChannelTables();
 		}
 
 		if (descriptorType == la::avdecc::entity::model::DescriptorType::StreamPortInput)
 		{
 			_deviceDetailsChannelTableModelTransmit.channelConnectionsUpdate(entityID);
 
-			tableViewReceive->resizeColumnsToContents();
-			tableViewReceive->resizeRowsToContents();
-			tableViewTransmit->resizeColumnsToContents();
-			tableViewTransmit->resizeRowsToContents();
+			resizeChannelTables();
 		}
 	}
 
@@ -664,10 +689,7 @@ public:
 	{
 		_deviceDetailsChannelTableModelTransmit.channelConnectionsUpdate(streamIdentification.entityID);
 
-		tableViewReceive->resizeColumnsToContents();
-		tableViewReceive->resizeRowsToContents();
-		tableViewTransmit->resizeColumnsToContents();
-		tableViewTransmit->resizeRowsToContents();
+		resizeChannelTables();
 	}
 
 	/**
@@ -757,17 +779,9 @@ private:
 	{
 		auto& manager = avdecc::ControllerManager::getInstance();
 		auto controlledEntity = manager.getControlledEntity(_entityID);
-		if (controlledEntity)
+		if (controlledEntity && _configurationNode)
 		{
-			la::avdecc::controller::model::ConfigurationNode configurationNode;
-			try
-			{
-				configurationNode = controlledEntity->getCurrentConfigurationNode();
-			}
-			catch (la::avdecc::controller::ControlledEntity::Exception const&)
-			{
-				return;
-			}
+			auto const& configurationNode = *_configurationNode;
 			// latency tab data
 			auto latency = decltype(la::avdecc::entity::model::StreamDynamicInfo::msrpAccumulatedLatency){ std::nullopt };
 			for (auto const& streamOutput : configurationNode.streamOutputs)
@@ -0,0 +1,180 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "dispatchProfiler.hpp"
+#include "avdecc/controllerManager.hpp"
+
+#include <QMetaMethod>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+/** Counts the emissions of a single signal. One instance per signal, so the counting slot doesn't have to know its sender (QObject::sender() is not valid for direct calls from another thread) */
+class SignalCounter : public QObject
+{
+	Q_OBJECT
+public:
+	SignalCounter(QString const& name) noexcept
+		: _name{ name }
+	{
+	}
+
+	Q_SLOT void count() noexcept
+	{
+		++_count;
+	}
+
+	QString const& name() const noexcept
+	{
+		return _name;
+	}
+
+	std::uint64_t value() const noexcept
+	{
+		return _count;
+	}
+
+	void clear() noexcept
+	{
+		_count = 0u;
+	}
+
+private:
+	QString const _name{};
+	std::atomic<std::uint64_t> _count{ 0u };
+};
+
+class DispatchProfilerImpl final : public DispatchProfiler
+{
+public:
+	DispatchProfilerImpl() noexcept = default;
+
+	// Deleted compiler auto-generated methods
+	DispatchProfilerImpl(DispatchProfilerImpl const&) = delete;
+	DispatchProfilerImpl(DispatchProfilerImpl&&) = delete;
+	DispatchProfilerImpl& operator=(DispatchProfilerImpl const&) = delete;
+	DispatchProfilerImpl& operator=(DispatchProfilerImpl&&) = delete;
+
+private:
+	// DispatchProfiler overrides
+	virtual void setEnabled(bool const enabled) noexcept override
+	{
+		if (enabled == _enabled)
+		{
+			return;
+		}
+
+		if (enabled)
+		{
+			// Count all the signals declared by ControllerManager (not the ones inherited from QObject), whatever the thread they are emitted from
+			auto& manager = avdecc::ControllerManager::getInstance();
+			auto const& metaObject = avdecc::ControllerManager::staticMetaObject;
+			auto const countSlot = SignalCounter::staticMetaObject.method(SignalCounter::staticMetaObject.indexOfSlot("count()"));
+			for (auto index = metaObject.methodOffset(); index < metaObject.methodCount(); ++index)
+			{
+				auto const method = metaObject.method(index);
+				if (method.methodType() == QMetaMethod::Signal)
+				{
+					auto counter = std::make_unique<SignalCounter>(QString::fromLatin1(method.name()));
+					_connections.push_back(connect(&manager, method, counter.get(), countSlot, Qt::DirectConnection));
+					_signalCounters.push_back(std::move(counter));
+				}
+			}
+		}
+		else
+		{
+			for (auto const& connection : _connections)
+			{
+				disconnect(connection);
+			}
+			_connections.clear();
+			_signalCounters.clear();
+		}
+
+		_enabled = enabled;
+	}
+
+	virtual bool isEnabled() const noexcept override
+	{
+		return _enabled;
+	}
+
+	virtual void addQueuedCall(char const* const receiverClassName, Duration const& duration) noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+		auto& statistics = _receivers[receiverClassName];
+		++statistics.callsCount;
+		statistics.totalTime += duration;
+		statistics.maxTime = std::max(statistics.maxTime, duration);
+	}
+
+	virtual std::vector<SignalStatistics> getSignalStatistics() const noexcept override
+	{
+		auto result = std::vector<SignalStatistics>{};
+		result.reserve(_signalCounters.size());
+		for (auto const& counter : _signalCounters)
+		{
+			result.push_back(SignalStatistics{ counter->name(), counter->value() });
+		}
+		return result;
+	}
+
+	virtual std::vector<ReceiverStatistics> getReceiverStatistics() const noexcept override
+	{
+		auto const lg = std::lock_guard{ _lock };
+		auto result = std::vector<ReceiverStatistics>{};
+		result.reserve(_receivers.size());
+		for (auto const& [className, statistics] : _receivers)
+		{
+			auto receiver = statistics;
+			receiver.className = className ? QString::fromLatin1(className) : QString{ "<unknown>" };
+			result.push_back(std::move(receiver));
+		}
+		return result;
+	}
+
+	virtual void clearStatistics() noexcept override
+	{
+		for (auto& counter : _signalCounters)
+		{
+			counter->clear();
+		}
+		auto const lg = std::lock_guard{ _lock };
+		_receivers.clear();
+	}
+
+	// Private members
+	std::atomic_bool _enabled{ false };
+	std::vector<std::unique_ptr<SignalCounter>> _signalCounters{};
+	std::vector<QMetaObject::Connection> _connections{};
+	mutable std::mutex _lock{};
+	std::unordered_map<char const*, ReceiverStatistics> _receivers{}; // Keyed by the (static) class name of the receiver
+};
+
+DispatchProfiler& DispatchProfiler::getInstance() noexcept
+{
+	static DispatchProfilerImpl s_DispatchProfiler{};
+
+	return s_DispatchProfiler;
+}
+
+#include "dispatchProfiler.moc"
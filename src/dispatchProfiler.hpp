@@ -0,0 +1,65 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/** Developer instrumentation counting the ControllerManager signal emissions and timing the queued slot calls executed by the main thread, per receiver class */
+class DispatchProfiler : public QObject
+{
+	Q_OBJECT
+public:
+	using Duration = std::chrono::nanoseconds;
+
+	struct SignalStatistics
+	{
+		QString name{};
+		std::uint64_t emissionsCount{ 0u };
+	};
+
+	struct ReceiverStatistics
+	{
+		QString className{};
+		std::uint64_t callsCount{ 0u };
+		Duration totalTime{ Duration::zero() };
+		Duration maxTime{ Duration::zero() };
+	};
+
+	static DispatchProfiler& getInstance() noexcept;
+
+	/** Starts (or stops) collecting statistics. Must be called from the main thread, after the ControllerManager is created */
+	virtual void setEnabled(bool const enabled) noexcept = 0;
+	virtual bool isEnabled() const noexcept = 0;
+
+	/** Records the dispatch of a queued slot call (called by the application for every MetaCall event, when enabled) */
+	virtual void addQueuedCall(char const* const receiverClassName, Duration const& duration) noexcept = 0;
+
+	virtual std::vector<SignalStatistics> getSignalStatistics() const noexcept = 0;
+	virtual std::vector<ReceiverStatistics> getReceiverStatistics() const noexcept = 0;
+	virtual void clearStatistics() noexcept = 0;
+
+protected:
+	DispatchProfiler() = default;
+};
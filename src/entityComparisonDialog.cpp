@@ -0,0 +1,617 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "entityComparisonDialog.hpp"
+#include "avdecc/controllerManager.hpp"
+#include "avdecc/entitySubscriptions.hpp"
+#include "avdecc/helper.hpp"
+#include "counters/countersRefreshThrottle.hpp"
+#include "toolkit/material/color.hpp"
+
+#include <la/avdecc/internals/streamFormatInfo.hpp>
+
+#include <QAbstractTableModel>
+#include <QHeaderView>
+#include <QTimer>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <set>
+
+namespace color = qt::toolkit::material::color;
+
+class EntityComparisonModel final : public QAbstractTableModel
+{
+public:
+	EntityComparisonModel(std::vector<la::avdecc::UniqueIdentifier> const& entityIDs, QObject* parent = nullptr)
+		: QAbstractTableModel{ parent }
+	{
+		auto& manager = avdecc::ControllerManager::getInstance();
+		for (auto const& entityID : entityIDs)
+		{
+			auto column = Column{};
+			column.entityID = entityID;
+			if (auto const controlledEntity = manager.getControlledEntity(entityID))
+			{
+				column.name = avdecc::helper::smartEntityName(*controlledEntity);
+			}
+			else
+			{
+				column.name = avdecc::helper::uniqueIdentifierToString(entityID);
+			}
+			_columns.push_back(std::move(column));
+		}
+
+		// The fields are the ones of the reference entity (comparing identical devices is the point)
+		if (!entityIDs.empty())
+		{
+			buildFields(entityIDs.front());
+		}
+
+		_fillTimer.setSingleShot(true);
+		_fillTimer.setInterval(0);
+		connect(&_fillTimer, &QTimer::timeout, this, &EntityComparisonModel::fillPendingColumns);
+
+		// Entities coming back online have a new model, read them again
+		connect(&manager, &avdecc::ControllerManager::entityOnline, this, &EntityComparisonModel::invalidateEntity);
+		connect(&manager, &avdecc::ControllerManager::entityOffline, this, &EntityComparisonModel::invalidateEntity);
+
+		// Changes without an EntitySubscriptions dispatcher
+		connect(&manager, &avdecc::ControllerManager::gptpChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID)
+			{
+				invalidateEntity(entityID);
+			});
+		connect(&manager, &avdecc::ControllerManager::clockSourceChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID)
+			{
+				invalidateEntity(entityID);
+			});
+	}
+
+	/** Count of fields with at least one displayed entity different from the reference one */
+	int differencesCount() const noexcept
+	{
+		auto count = 0;
+		for (auto row = 0; row < static_cast<int>(_fields.size()); ++row)
+		{
+			for (auto column = 1; column < static_cast<int>(_columns.size()); ++column)
+			{
+				if (isDifferent(row, column))
+				{
+					++count;
+					break;
+				}
+			}
+		}
+		return count;
+	}
+
+	int filledColumnsCount() const noexcept
+	{
+		return static_cast<int>(std::count_if(_columns.begin(), _columns.end(),
+			[](auto const& column)
+			{
+				return column.isFilled;
+			}));
+	}
+
+	// QAbstractTableModel overrides
+	virtual int rowCount(QModelIndex const& parent = {}) const override
+	{
+		return parent.isValid() ? 0 : static_cast<int>(_fields.size());
+	}
+
+	virtual int columnCount(QModelIndex const& parent = {}) const override
+	{
+		return parent.isValid() ? 0 : static_cast<int>(_columns.size());
+	}
+
+	virtual QVariant data(QModelIndex const& index, int role = Qt::DisplayRole) const override
+	{
+		auto const row = index.row();
+		auto const column = index.column();
+		if (!index.isValid() || row >= static_cast<int>(_fields.size()) || column >= static_cast<int>(_columns.size()))
+		{
+			return {};
+		}
+
+		// The view only asks for the data of the visible cells, that's when a column is read from its entity
+		auto const& columnData = _columns[column];
+		if (!columnData.isFilled)
+		{
+			requestFill(column);
+			return {};
+		}
+
+		switch (role)
+		{
+			case Qt::DisplayRole:
+			{
+				auto const& value = columnData.values[row];
+				return value ? *value : QString{ "-" };
+			}
+			case Qt::BackgroundRole:
+				if (isDifferent(row, column))
+				{
+					return QColor{ color::value(color::Name::Amber, color::Shade::Shade200) };
+				}
+				break;
+			default:
+				break;
+		}
+		return {};
+	}
+
+	virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override
+	{
+		if (role != Qt::DisplayRole)
+		{
+			return {};
+		}
+		if (orientation == Qt::Horizontal)
+		{
+			return section < static_cast<int>(_columns.size()) ? _columns[section].name : QVariant{};
+		}
+		return section < static_cast<int>(_fields.size()) ? _fields[section].label : QVariant{};
+	}
+
+private:
+	enum class FieldKind
+	{
+		EntityName,
+		GroupName,
+		FirmwareVersion,
+		SerialNumber,
+		Configuration,
+		StreamFormat,
+		MacAddress,
+		GrandmasterID,
+		GptpDomainNumber,
+		ClockSource,
+		Counter,
+	};
+
+	struct Field
+	{
+		FieldKind kind{ FieldKind::EntityName };
+		la::avdecc::entity::model::DescriptorType descriptorType{ la::avdecc::entity::model::DescriptorType::Entity };
+		la::avdecc::entity::model::DescriptorIndex descriptorIndex{ 0u };
+		std::uint32_t counterFlag{ 0u }; // Counter fields only
+		QString label{};
+	};
+
+	struct Column
+	{
+		la::avdecc::UniqueIdentifier entityID{};
+		QString name{};
+		bool isFilled{ false };
+		std::vector<std::optional<QString>> values{}; // Per field, nullopt if the entity doesn't have it
+		std::unique_ptr<QObject> subscriptions{}; // Receiver of the subscriptions of the entity, destroying it unsubscribes
+	};
+
+	template<typename Flag>
+	static QString counterName(Flag const flag, std::map<Flag, QString> const& names) noexcept
+	{
+		auto const it = names.find(flag);
+		return it != names.end() ? it->second : QString("Counter %1").arg(avdecc::helper::toHexQString(la::avdecc::utils::to_integral(flag), true, true));
+	}
+
+	static QString counterName(la::avdecc::entity::model::DescriptorType const descriptorType, std::uint32_t const flag) noexcept
+	{
+		static auto const s_entityNames = std::map<la::avdecc::entity::EntityCounterValidFlag, QString>{};
+		static auto const s_avbInterfaceNames = std::map<la::avdecc::entity::AvbInterfaceCounterValidFlag, QString>{
+			{ la::avdecc::entity::AvbInterfaceCounterValidFlag::LinkUp, "Link Up" },
+			{ la::avdecc::entity::AvbInterfaceCounterValidFlag::LinkDown, "Link Down" },
+			{ la::avdecc::entity::AvbInterfaceCounterValidFlag::FramesTx, "Frames TX" },
+			{ la::avdecc::entity::AvbInterfaceCounterValidFlag::FramesRx, "Frames RX" },
+			{ la::avdecc::entity::AvbInterfaceCounterValidFlag::RxCrcError, "RX CRC Error" },
+			{ la::avdecc::entity::AvbInterfaceCounterValidFlag::GptpGmChanged, "Grandmaster Changed" },
+		};
+		static auto const s_clockDomainNames = std::map<la::avdecc::entity::ClockDomainCounterValidFlag, QString>{
+			{ la::avdecc::entity::ClockDomainCounterValidFlag::Locked, "Locked" },
+			{ la::avdecc::entity::ClockDomainCounterValidFlag::Unlocked, "Unlocked" },
+		};
+		static auto const s_streamInputNames = std::map<la::avdecc::entity::StreamInputCounterValidFlag, QString>{
+			{ la::avdecc::entity::StreamInputCounterValidFlag::MediaLocked, "Media Locked" },
+			{ la::avdecc::entity::StreamInputCounterValidFlag::MediaUnlocked, "Media Unlocked" },
+			{ la::avdecc::entity::StreamInputCounterValidFlag::StreamInterrupted, "Stream Interrupted" },
+			{ la::avdecc::entity::StreamInputCounterValidFlag::SeqNumMismatch, "Seq Num Mismatch" },
+			{ la::avdecc::entity::StreamInputCounterValidFlag::MediaReset, "Media Reset" },
+			{ la::avdecc::entity::StreamInputCounterValidFlag::TimestampUncertain, "Timestamp Uncertain" },
+			{ la::avdecc::entity::StreamInputCounterValidFlag::TimestampValid, "Timestamp Valid" },
+			{ la::avdecc::entity::StreamInputCounterValidFlag::TimestampNotValid, "Timestamp Not Valid" },
+			{ la::avdecc::entity::StreamInputCounterValidFlag::UnsupportedFormat, "Unsupported Format" },
+			{ la::avdecc::entity::StreamInputCounterValidFlag::LateTimestamp, "Late Timestamp" },
+			{ la::avdecc::entity::StreamInputCounterValidFlag::EarlyTimestamp, "Early Timestamp" },
+			{ la::avdecc::entity::StreamInputCounterValidFlag::FramesRx, "Frames RX" },
+			{ la::avdecc::entity::StreamInputCounterValidFlag::FramesTx, "Frames TX" },
+		};
+		static auto const s_streamOutputNames = std::map<la::avdecc::entity::StreamOutputCounterValidFlag, QString>{
+			{ la::avdecc::entity::StreamOutputCounterValidFlag::StreamStart, "Stream Start" },
+			{ la::avdecc::entity::StreamOutputCounterValidFlag::StreamStop, "Stream Stop" },
+			{ la::avdecc::entity::StreamOutputCounterValidFlag::MediaReset, "Media Reset" },
+			{ la::avdecc::entity::StreamOutputCounterValidFlag::TimestampUncertain, "Timestamp Uncertain" },
+			{ la::avdecc::entity::StreamOutputCounterValidFlag::FramesTx, "Frames TX" },
+		};
+
+		switch (descriptorType)
+		{
+			case la::avdecc::entity::model::DescriptorType::Entity:
+				return counterName(static_cast<la::avdecc::entity::EntityCounterValidFlag>(flag), s_entityNames);
+			case la::avdecc::entity::model::DescriptorType::AvbInterface:
+				return counterName(static_cast<la::avdecc::entity::AvbInterfaceCounterValidFlag>(flag), s_avbInterfaceNames);
+			case la::avdecc::entity::model::DescriptorType::ClockDomain:
+				return counterName(static_cast<la::avdecc::entity::ClockDomainCounterValidFlag>(flag), s_clockDomainNames);
+			case la::avdecc::entity::model::DescriptorType::StreamInput:
+				return counterName(static_cast<la::avdecc::entity::StreamInputCounterValidFlag>(flag), s_streamInputNames);
+			case la::avdecc::entity::model::DescriptorType::StreamOutput:
+				return counterName(static_cast<la::avdecc::entity::StreamOutputCounterValidFlag>(flag), s_streamOutputNames);
+			default:
+				return {};
+		}
+	}
+
+	template<typename Counters>
+	static std::optional<QString> counterValue(std::optional<Counters> const& counters, std::uint32_t const flag) noexcept
+	{
+		if (counters)
+		{
+			auto const it = counters->find(static_cast<typename Counters::key_type>(flag));
+			if (it != counters->end())
+			{
+				return QString::number(it->second);
+			}
+		}
+		return std::nullopt;
+	}
+
+	template<typename Counters>
+	void addCounterFields(std::optional<Counters> const& counters, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, QString const& prefix) noexcept
+	{
+		if (counters)
+		{
+			for (auto const& counterKV : *counters)
+			{
+				auto const flag = static_cast<std::uint32_t>(la::avdecc::utils::to_integral(counterKV.first));
+				_fields.push_back(Field{ FieldKind::Counter, descriptorType, descriptorIndex, flag, QString("%1 - %2").arg(prefix).arg(counterName(descriptorType, flag)) });
+			}
+		}
+	}
+
+	void buildFields(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		using la::avdecc::entity::model::DescriptorType;
+
+		auto const controlledEntity = avdecc::ControllerManager::getInstance().getControlledEntity(entityID);
+		if (!controlledEntity || !controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+		{
+			_fields.push_back(Field{ FieldKind::EntityName, DescriptorType::Entity, 0u, 0u, "Entity Name" });
+			return;
+		}
+
+		_fields.push_back(Field{ FieldKind::EntityName, DescriptorType::Entity, 0u, 0u, "Entity Name" });
+		_fields.push_back(Field{ FieldKind::GroupName, DescriptorType::Entity, 0u, 0u, "Group Name" });
+		_fields.push_back(Field{ FieldKind::FirmwareVersion, DescriptorType::Entity, 0u, 0u, "Firmware Version" });
+		_fields.push_back(Field{ FieldKind::SerialNumber, DescriptorType::Entity, 0u, 0u, "Serial Number" });
+		_fields.push_back(Field{ FieldKind::Configuration, DescriptorType::Configuration, 0u, 0u, "Current Configuration" });
+
+		try
+		{
+			auto const& entityNode = controlledEntity->getEntityNode();
+			addCounterFields(entityNode.dynamicModel->counters, DescriptorType::Entity, 0u, "Entity");
+
+			auto const& configurationNode = controlledEntity->getCurrentConfigurationNode();
+			for (auto const& [avbInterfaceIndex, avbInterfaceNode] : configurationNode.avbInterfaces)
+			{
+				auto const prefix = QString("AVB Interface %1").arg(avbInterfaceIndex);
+				_fields.push_back(Field{ FieldKind::MacAddress, DescriptorType::AvbInterface, avbInterfaceIndex, 0u, prefix + " - MAC Address" });
+				_fields.push_back(Field{ FieldKind::GrandmasterID, DescriptorType::AvbInterface, avbInterfaceIndex, 0u, prefix + " - Grandmaster ID" });
+				_fields.push_back(Field{ FieldKind::GptpDomainNumber, DescriptorType::AvbInterface, avbInterfaceIndex, 0u, prefix + " - gPTP Domain" });
+				addCounterFields(avbInterfaceNode.dynamicModel->counters, DescriptorType::AvbInterface, avbInterfaceIndex, prefix);
+			}
+			for (auto const& [clockDomainIndex, clockDomainNode] : configurationNode.clockDomains)
+			{
+				auto const prefix = QString("Clock Domain %1").arg(clockDomainIndex);
+				_fields.push_back(Field{ FieldKind::ClockSource, DescriptorType::ClockDomain, clockDomainIndex, 0u, prefix + " - Clock Source" });
+				addCounterFields(clockDomainNode.dynamicModel->counters, DescriptorType::ClockDomain, clockDomainIndex, prefix);
+			}
+			for (auto const& [streamIndex, streamInputNode] : configurationNode.streamInputs)
+			{
+				auto const prefix = avdecc::helper::inputStreamName(*controlledEntity, streamIndex);
+				_fields.push_back(Field{ FieldKind::StreamFormat, DescriptorType::StreamInput, streamIndex, 0u, prefix + " - Format" });
+				addCounterFields(streamInputNode.dynamicModel->counters, DescriptorType::StreamInput, streamIndex, prefix);
+			}
+			for (auto const& [streamIndex, streamOutputNode] : configurationNode.streamOutputs)
+			{
+				auto const prefix = avdecc::helper::outputStreamName(*controlledEntity, streamIndex);
+				_fields.push_back(Field{ FieldKind::StreamFormat, DescriptorType::StreamOutput, streamIndex, 0u, prefix + " - Format" });
+				addCounterFields(streamOutputNode.dynamicModel->counters, DescriptorType::StreamOutput, streamIndex, prefix);
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+	}
+
+	static std::optional<QString> readField(la::avdecc::controller::ControlledEntity const& controlledEntity, Field const& field) noexcept
+	{
+		using la::avdecc::entity::model::DescriptorType;
+
+		try
+		{
+			switch (field.kind)
+			{
+				case FieldKind::EntityName:
+					return avdecc::helper::entityName(controlledEntity);
+				case FieldKind::GroupName:
+					return avdecc::helper::groupName(controlledEntity);
+				case FieldKind::FirmwareVersion:
+					return QString{ controlledEntity.getEntityNode().dynamicModel->firmwareVersion.data() };
+				case FieldKind::SerialNumber:
+					return QString{ controlledEntity.getEntityNode().dynamicModel->serialNumber.data() };
+				case FieldKind::Configuration:
+					return avdecc::helper::configurationName(&controlledEntity, controlledEntity.getCurrentConfigurationNode());
+				default:
+					break;
+			}
+
+			auto const configurationIndex = controlledEntity.getCurrentConfigurationNode().descriptorIndex;
+			switch (field.kind)
+			{
+				case FieldKind::StreamFormat:
+				{
+					auto const streamFormat = field.descriptorType == DescriptorType::StreamInput ? controlledEntity.getStreamInputNode(configurationIndex, field.descriptorIndex).dynamicModel->streamFormat : controlledEntity.getStreamOutputNode(configurationIndex, field.descriptorIndex).dynamicModel->streamFormat;
+					return avdecc::helper::streamFormatToString(*la::avdecc::entity::model::StreamFormatInfo::create(streamFormat));
+				}
+				case FieldKind::MacAddress:
+					return QString::fromStdString(la::avdecc::networkInterface::macAddressToString(controlledEntity.getAvbInterfaceNode(configurationIndex, field.descriptorIndex).staticModel->macAddress, true));
+				case FieldKind::GrandmasterID:
+					return avdecc::helper::uniqueIdentifierToString(controlledEntity.getAvbInterfaceNode(configurationIndex, field.descriptorIndex).dynamicModel->gptpGrandmasterID);
+				case FieldKind::GptpDomainNumber:
+					return QString::number(controlledEntity.getAvbInterfaceNode(configurationIndex, field.descriptorIndex).dynamicModel->gptpDomainNumber);
+				case FieldKind::ClockSource:
+				{
+					auto const clockSourceIndex = controlledEntity.getClockDomainNode(configurationIndex, field.descriptorIndex).dynamicModel->clockSourceIndex;
+					auto const& clockSourceNode = controlledEntity.getClockSourceNode(configurationIndex, clockSourceIndex);
+					return QString("%1: '%2' (%3)").arg(clockSourceIndex).arg(avdecc::helper::objectName(&controlledEntity, clockSourceNode)).arg(avdecc::helper::clockSourceToString(clockSourceNode));
+				}
+				case FieldKind::Counter:
+					switch (field.descriptorType)
+					{
+						case DescriptorType::Entity:
+							return counterValue(controlledEntity.getEntityNode().dynamicModel->counters, field.counterFlag);
+						case DescriptorType::AvbInterface:
+							return counterValue(controlledEntity.getAvbInterfaceNode(configurationIndex, field.descriptorIndex).dynamicModel->counters, field.counterFlag);
+						case DescriptorType::ClockDomain:
+							return counterValue(controlledEntity.getClockDomainNode(configurationIndex, field.descriptorIndex).dynamicModel->counters, field.counterFlag);
+						case DescriptorType::StreamInput:
+							return counterValue(controlledEntity.getStreamInputNode(configurationIndex, field.descriptorIndex).dynamicModel->counters, field.counterFlag);
+						case DescriptorType::StreamOutput:
+							return counterValue(controlledEntity.getStreamOutputNode(configurationIndex, field.descriptorIndex).dynamicModel->counters, field.counterFlag);
+						default:
+							break;
+					}
+					break;
+				default:
+					break;
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+			// The entity doesn't have this descriptor
+		}
+		return std::nullopt;
+	}
+
+	bool isDifferent(int const row, int const column) const noexcept
+	{
+		auto const& reference = _columns.front();
+		auto const& other = _columns[column];
+		return column != 0 && reference.isFilled && other.isFilled && reference.values[row] != other.values[row];
+	}
+
+	void requestFill(int const column) const noexcept
+	{
+		// The reference column is always needed to highlight the differences
+		_pendingColumns.insert(0);
+		_pendingColumns.insert(column);
+		_fillTimer.start();
+	}
+
+	void readColumn(Column& column) noexcept
+	{
+		column.values.assign(_fields.size(), std::nullopt);
+		if (auto const controlledEntity = avdecc::ControllerManager::getInstance().getControlledEntity(column.entityID))
+		{
+			for (auto row = size_t{ 0u }; row < _fields.size(); ++row)
+			{
+				column.values[row] = readField(*controlledEntity, _fields[row]);
+			}
+		}
+		column.isFilled = true;
+	}
+
+	/** Subscribes to the notifications changing the fields of the column, each one only marks the column for the next coalesced refresh */
+	void subscribe(int const columnIndex) noexcept
+	{
+		using la::avdecc::entity::model::DescriptorType;
+
+		auto& column = _columns[columnIndex];
+		column.subscriptions = std::make_unique<QObject>();
+		auto* const receiver = column.subscriptions.get();
+		auto const entityID = column.entityID;
+		auto const markStale = [this, columnIndex](auto const&...)
+		{
+			_staleColumns.insert(columnIndex);
+			_refreshThrottle.requestRefresh();
+		};
+
+		auto& subscriptions = avdecc::EntitySubscriptions::getInstance();
+		auto const entityKey = avdecc::EntitySubscriptions::makeKey(entityID);
+		subscriptions.entityNameChanged().subscribe(receiver, entityKey, markStale);
+		subscriptions.entityGroupNameChanged().subscribe(receiver, entityKey, markStale);
+		subscriptions.entityCountersChanged().subscribe(receiver, entityKey, markStale);
+
+		// One subscription per descriptor having fields
+		auto descriptors = std::set<std::pair<DescriptorType, la::avdecc::entity::model::DescriptorIndex>>{};
+		for (auto const& field : _fields)
+		{
+			descriptors.emplace(field.descriptorType, field.descriptorIndex);
+		}
+		for (auto const& [descriptorType, descriptorIndex] : descriptors)
+		{
+			auto const key = avdecc::EntitySubscriptions::makeKey(entityID, descriptorType, descriptorIndex);
+			switch (descriptorType)
+			{
+				case DescriptorType::AvbInterface:
+					subscriptions.avbInterfaceCountersChanged().subscribe(receiver, key, markStale);
+					break;
+				case DescriptorType::ClockDomain:
+					subscriptions.clockDomainCountersChanged().subscribe(receiver, key, markStale);
+					break;
+				case DescriptorType::StreamInput:
+					subscriptions.streamFormatChanged().subscribe(receiver, key, markStale);
+					subscriptions.streamInputCountersChanged().subscribe(receiver, key, markStale);
+					break;
+				case DescriptorType::StreamOutput:
+					subscriptions.streamFormatChanged().subscribe(receiver, key, markStale);
+					subscriptions.streamOutputCountersChanged().subscribe(receiver, key, markStale);
+					break;
+				default:
+					break;
+			}
+		}
+	}
+
+	void fillPendingColumns() noexcept
+	{
+		auto const columns = std::move(_pendingColumns);
+		_pendingColumns.clear();
+
+		auto isReferenceChanged = false;
+		for (auto const columnIndex : columns)
+		{
+			auto& column = _columns[columnIndex];
+			if (column.isFilled)
+			{
+				continue;
+			}
+			readColumn(column);
+			subscribe(columnIndex);
+			isReferenceChanged |= columnIndex == 0;
+		}
+		notifyColumnsChanged(columns, isReferenceChanged);
+	}
+
+	void refreshStaleColumns() noexcept
+	{
+		auto const columns = std::move(_staleColumns);
+		_staleColumns.clear();
+
+		auto isReferenceChanged = false;
+		for (auto const columnIndex : columns)
+		{
+			auto& column = _columns[columnIndex];
+			if (column.isFilled)
+			{
+				readColumn(column);
+				isReferenceChanged |= columnIndex == 0;
+			}
+		}
+		notifyColumnsChanged(columns, isReferenceChanged);
+	}
+
+	void notifyColumnsChanged(std::set<int> const& columns, bool const isReferenceChanged) noexcept
+	{
+		auto const lastRow = static_cast<int>(_fields.size()) - 1;
+		if (lastRow < 0 || columns.empty())
+		{
+			return;
+		}
+
+		// The highlighting of all the columns depends on the reference one
+		if (isReferenceChanged)
+		{
+			emit dataChanged(index(0, 0), index(lastRow, static_cast<int>(_columns.size()) - 1));
+			return;
+		}
+		for (auto const columnIndex : columns)
+		{
+			emit dataChanged(index(0, columnIndex), index(lastRow, columnIndex));
+		}
+	}
+
+	void invalidateEntity(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		for (auto columnIndex = 0; columnIndex < static_cast<int>(_columns.size()); ++columnIndex)
+		{
+			auto& column = _columns[columnIndex];
+			if (column.entityID == entityID && column.isFilled)
+			{
+				_staleColumns.insert(columnIndex);
+				_refreshThrottle.requestRefresh();
+			}
+		}
+	}
+
+	std::vector<Field> _fields{};
+	std::vector<Column> _columns{};
+	mutable std::set<int> _pendingColumns{}; // Columns displayed for the first time, read on the next event loop iteration
+	mutable QTimer _fillTimer{};
+	std::set<int> _staleColumns{}; // Columns whose entity notified a change since the last refresh
+	CountersRefreshThrottle _refreshThrottle{ [this]()
+		{
+			refreshStaleColumns();
+		} };
+};
+
+EntityComparisonDialog::EntityComparisonDialog(std::vector<la::avdecc::UniqueIdentifier> const& entityIDs, QWidget* parent)
+	: QDialog{ parent, Qt::WindowSystemMenuHint | Qt::WindowTitleHint | Qt::WindowCloseButtonHint | Qt::WindowMaximizeButtonHint }
+	, _model{ std::make_unique<EntityComparisonModel>(entityIDs) }
+{
+	setWindowTitle(QString("Compare %1 Entities").arg(entityIDs.size()));
+	resize(1000, 640);
+
+	_tableView.setModel(_model.get());
+	_tableView.setSelectionMode(QAbstractItemView::ContiguousSelection);
+	_tableView.setWordWrap(false);
+	_tableView.horizontalHeader()->setDefaultSectionSize(160);
+	_tableView.verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+
+	auto* const layout = new QVBoxLayout{ this };
+	layout->addWidget(&_tableView, 1);
+	layout->addWidget(&_statusLabel);
+
+	connect(_model.get(), &QAbstractItemModel::dataChanged, this, &EntityComparisonDialog::updateStatus);
+	updateStatus();
+}
+
+EntityComparisonDialog::~EntityComparisonDialog()
+{
+	// The view must not access the model while it's destroyed
+	_tableView.setModel(nullptr);
+}
+
+void EntityComparisonDialog::updateStatus() noexcept
+{
+	_statusLabel.setText(QString("%1 field(s) differ from the first entity (%2 of %3 entities read, the others are read when displayed)").arg(_model->differencesCount()).arg(_model->filledColumnsCount()).arg(_model->columnCount()));
+}
@@ -0,0 +1,58 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/controller/avdeccController.hpp>
+
+#include <QDialog>
+#include <QLabel>
+#include <QTableView>
+
+#include <memory>
+#include <vector>
+
+class EntityComparisonModel;
+
+/**
+* @brief Side by side comparison of the same descriptor fields (entity info, stream formats, AVB interfaces, clock domains and counters) on several entities.
+*		 Rows are the fields of the first entity, columns the entities. A column is only read from its entity when it's first displayed, then refreshed (coalesced) when its entity notifies a change.
+*		 Values different from the first entity are highlighted.
+*/
+class EntityComparisonDialog : public QDialog
+{
+	Q_OBJECT
+
+public:
+	EntityComparisonDialog(std::vector<la::avdecc::UniqueIdentifier> const& entityIDs, QWidget* parent = nullptr);
+	~EntityComparisonDialog();
+
+	// Deleted compiler auto-generated methods
+	EntityComparisonDialog(EntityComparisonDialog&&) = delete;
+	EntityComparisonDialog(EntityComparisonDialog const&) = delete;
+	EntityComparisonDialog& operator=(EntityComparisonDialog const&) = delete;
+	EntityComparisonDialog& operator=(EntityComparisonDialog&&) = delete;
+
+private:
+	void updateStatus() noexcept;
+
+	std::unique_ptr<EntityComparisonModel> _model;
+	QTableView _tableView{ this };
+	QLabel _statusLabel{ this };
+};
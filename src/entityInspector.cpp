@@ -22,6 +22,7 @@
 #include "avdecc/helper.hpp"
 
 #include <QHeaderView>
+#include <QTreeWidgetItemIterator>
 
 Q_DECLARE_METATYPE(la::avdecc::UniqueIdentifier)
 
@@ -61,6 +62,28 @@ EntityInspector::EntityInspector(QWidget* parent)
 	connect(&controllerManager, &avdecc::ControllerManager::entityOnline, this, &EntityInspector::entityOnline);
 	connect(&controllerManager, &avdecc::ControllerManager::entityOffline, this, &EntityInspector::entityOffline);
 	connect(&controllerManager, &avdecc::ControllerManager::entityNameChanged, this, &EntityInspector::entityNameChanged);
+
+	_memoryProbe = avdecc::MemoryAccounting::getInstance().registerProbe("EntityInspector",
+		[this](avdecc::MemoryAccounting::Counters& counters)
+		{
+			auto const countItems = [](QTreeWidget* const tree)
+			{
+				auto count = std::uint64_t{ 0u };
+				for (auto it = QTreeWidgetItemIterator{ tree }; *it; ++it)
+				{
+					++count;
+				}
+				return count;
+			};
+			counters.push_back({ "Inspectors", 1u });
+			counters.push_back({ "TreeItems", countItems(&_controlledEntityTreeWiget) + countItems(&_nodeTreeWiget) });
+			counters.push_back({ "Widgets", static_cast<std::uint64_t>(findChildren<QWidget*>().size()) });
+		});
+}
+
+EntityInspector::~EntityInspector()
+{
+	avdecc::MemoryAccounting::getInstance().unregisterProbe(_memoryProbe);
 }
 
 void EntityInspector::setControlledEntityID(la::avdecc::UniqueIdentifier const entityID)
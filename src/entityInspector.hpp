@@ -22,6 +22,7 @@
 #include "controlledEntityTreeWidget.hpp"
 #include "nodeTreeWidget.hpp"
 #include "errorItemDelegate.hpp"
+#include "avdecc/memoryAccounting.hpp"
 
 #include <QSplitter>
 #include <QLayout>
@@ -38,6 +39,7 @@ public:
 	};
 
 	EntityInspector(QWidget* parent = nullptr);
+	~EntityInspector();
 
 	void setControlledEntityID(la::avdecc::UniqueIdentifier const entityID);
 	la::avdecc::UniqueIdentifier controlledEntityID() const;
@@ -61,4 +63,5 @@ private:
 	ControlledEntityTreeWidget _controlledEntityTreeWiget{ this };
 	NodeTreeWidget _nodeTreeWiget{ this };
 	ErrorItemDelegate _itemDelegate{ this };
+	avdecc::MemoryAccounting::ProbeID _memoryProbe{ 0u };
 };
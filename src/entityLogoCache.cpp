@@ -19,6 +19,8 @@
 
 #include "entityLogoCache.hpp"
 #include "avdecc/helper.hpp"
+#include "avdecc/memoryAccounting.hpp"
+#include "avdecc/spanTrace.hpp"
 
 #include <QStandardPaths>
 #include <QFileInfo>
@@ -26,89 +28,160 @@
 #include <QApplication>
 #include <QtGlobal>
 #include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QSet>
+#include <QCache>
+#include <QPixmap>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <unordered_set>
 
 inline uint qHash(EntityLogoCache::Type const type, uint seed = 0)
 {
 	return qHash(static_cast<int>(type), seed);
 }
 
+/** Runs some image work (disk I/O, decoding) in a worker thread, then the completion handler in the receiver's thread */
+class ImageTask final : public QRunnable
+{
+public:
+	using Work = std::function<QImage()>;
+	using Completion = std::function<void(QImage const& image)>;
+
+	ImageTask(QObject* const receiver, Work&& work, Completion&& completion) noexcept
+		: _receiver{ receiver }
+		, _work{ std::move(work) }
+		, _completion{ std::move(completion) }
+	{
+	}
+
+	virtual void run() override
+	{
+		auto image = _work();
+		QMetaObject::invokeMethod(_receiver,
+			[completion = std::move(_completion), image = std::move(image)]()
+			{
+				completion(image);
+			});
+	}
+
+private:
+	QObject* const _receiver{ nullptr };
+	Work _work{};
+	Completion _completion{};
+};
+
 class EntityLogoCacheImpl : public EntityLogoCache
 {
 public:
+	EntityLogoCacheImpl() noexcept
+	{
+		// Logos are not urgent, don't use too many threads for them
+		_threadPool.setMaxThreadCount(2);
+
+		_cache.setMaxCost(DefaultMemoryBudget);
+
+		// Downloads are only started once the entity is fully enumerated, and cancelled when it goes offline
+		auto& manager = avdecc::ControllerManager::getInstance();
+		connect(&manager, &avdecc::ControllerManager::entityOnline, this, &EntityLogoCacheImpl::handleEntityOnline);
+		connect(&manager, &avdecc::ControllerManager::entityOffline, this, &EntityLogoCacheImpl::handleEntityOffline);
+		connect(&manager, &avdecc::ControllerManager::controllerOffline, this, &EntityLogoCacheImpl::handleControllerOffline);
+
+		avdecc::MemoryAccounting::getInstance().registerProbe("EntityLogoCache",
+			[this](avdecc::MemoryAccounting::Counters& counters)
+			{
+				counters.push_back({ "CacheBytes", static_cast<std::uint64_t>(_cache.totalCost()) });
+				counters.push_back({ "CachedImages", static_cast<std::uint64_t>(_cache.count()) });
+				counters.push_back({ "PendingLoads", static_cast<std::uint64_t>(_pendingLoads.size()) });
+				counters.push_back({ "PendingDownloads", static_cast<std::uint64_t>(_pendingDownloads.size()) });
+				counters.push_back({ "DownloadQueue", _downloadQueue.size() });
+				counters.push_back({ "KeyUsers", static_cast<std::uint64_t>(_keyUsers.size()) });
+			});
+	}
+
 	virtual QImage getImage(la::avdecc::UniqueIdentifier const entityID, Type const type, bool const downloadIfNotInCache) noexcept override
 	{
 		Q_ASSERT_X(QThread::currentThread() == qApp->thread(), "EntityLogoCache", "getImage must be called in the GUI thread.");
 
 		auto const key{ makeKey(entityID) };
 
-		// Check if we have something in the memory cache for this key (entityID-entityModelID)
-		auto imagesIt = _cache.find(key);
-		if (imagesIt != _cache.end())
-		{
-			// Check if we have the specified image type in the memory cache
-			auto imageIt = imagesIt->find(type);
-			if (imageIt != imagesIt->end())
-			{
-				// Return the cached image (might be an empty QImage if the download is in progress)
-				return imageIt.value();
-			}
-		}
+		// Remember this entity uses the image, it has to be notified when it changes
+		_keyUsers[key].insert(entityID.getValue());
+
+		return getImage(entityID, key, type, downloadIfNotInCache);
+	}
+
+	virtual QPixmap getThumbnail(la::avdecc::UniqueIdentifier const entityID, Type const type, QSize const& size, qreal const devicePixelRatio, bool const downloadIfNotInCache) noexcept override
+	{
+		Q_ASSERT_X(QThread::currentThread() == qApp->thread(), "EntityLogoCache", "getThumbnail must be called in the GUI thread.");
 
-		QImage image;
+		auto const key{ makeKey(entityID) };
+		_keyUsers[key].insert(entityID.getValue());
 
-		// Try to load from the disk
-		QFileInfo fileInfo{ imagePath(entityID, type) };
-		if (fileInfo.exists())
+		// Check if we already have a thumbnail for this size (in device pixels)
+		auto const thumbnailKey = CacheKey{ key, type, (QSizeF{ size } * devicePixelRatio).toSize() };
+		if (auto const* const item = _cache.object(thumbnailKey))
 		{
-			// Found the image on the disk, add it to the memory cache
-			image = QImage{ fileInfo.filePath() };
-			_cache[key][type] = image;
+			return item->thumbnail;
 		}
-		else if (downloadIfNotInCache)
+
+		auto const image = getImage(entityID, key, type, downloadIfNotInCache);
+		if (image.isNull() || thumbnailKey.size.isEmpty())
 		{
-			// Add a temporary empty QImage in the memory cache so we won't start another download while this one is pending
-			_cache[key][type] = image;
-			downloadImage(entityID, type);
+			return {};
 		}
 
-		return image;
+		// Scale it once for all
+		auto thumbnail = QPixmap::fromImage(image.scaled(thumbnailKey.size, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+		thumbnail.setDevicePixelRatio(devicePixelRatio);
+
+		_cache.insert(thumbnailKey, new CacheItem{ {}, thumbnail }, thumbnail.width() * thumbnail.height() * thumbnail.depth() / 8);
+
+		return thumbnail;
 	}
 
 	virtual bool isImageInCache(la::avdecc::UniqueIdentifier const entityID, Type const type) const noexcept override
 	{
 		Q_ASSERT_X(QThread::currentThread() == qApp->thread(), "EntityLogoCache", "isImageInCache must be called in the GUI thread.");
 
+		// Either a real image, or one being loaded (or downloaded)
 		auto const key{ makeKey(entityID) };
-		auto imagesIt = _cache.find(key);
-		if (imagesIt != _cache.end())
-		{
-			// Check if we have the specified image type in the memory cache
-			auto imageIt = imagesIt->find(type);
-			if (imageIt != imagesIt->end())
-			{
-				// The image has been found in the memory cache (either a real one, or a temporary one)
-				return true;
-			}
-		}
+		return _cache.contains(CacheKey{ key, type, {} }) || isPending(key, type);
+	}
 
-		return false;
+	virtual void setMemoryBudget(int const bytes) noexcept override
+	{
+		Q_ASSERT_X(QThread::currentThread() == qApp->thread(), "EntityLogoCache", "setMemoryBudget must be called in the GUI thread.");
+
+		_cache.setMaxCost(bytes);
 	}
 
 	virtual void clear() noexcept override
 	{
 		Q_ASSERT_X(QThread::currentThread() == qApp->thread(), "EntityLogoCache", "clear must be called in the GUI thread.");
 
+		// Results of loads and downloads still in progress will be ignored
+		++_generation;
+
 		QDir dir(imageDir());
 		dir.removeRecursively();
 
-		auto const keys{ _cache.keys() };
 		_cache.clear();
+		_pendingLoads.clear();
+		_pendingDownloads.clear();
+		_downloadQueue.clear();
 
+		auto const keys{ _keyUsers.keys() };
 		for (auto const& key : keys)
 		{
-			emit imageChanged(la::avdecc::UniqueIdentifier{ key.first }, Type::Entity);
-			emit imageChanged(la::avdecc::UniqueIdentifier{ key.first }, Type::Manufacturer);
+			notifyImageChanged(key, Type::Entity);
+			notifyImageChanged(key, Type::Manufacturer);
 		}
+		_keyUsers.clear();
 	}
 
 private:
@@ -128,24 +201,170 @@ private:
 
 	using Key = QPair<la::avdecc::UniqueIdentifier::value_type, la::avdecc::UniqueIdentifier::value_type>;
 
+	struct CacheKey
+	{
+		Key key{};
+		Type type{ Type::None };
+		QSize size{}; // Size of the thumbnail (in device pixels), invalid for the full size image
+
+		bool operator==(CacheKey const& other) const noexcept
+		{
+			return key == other.key && type == other.type && size == other.size;
+		}
+
+		friend uint qHash(CacheKey const& cacheKey, uint seed = 0) noexcept
+		{
+			return qHash(cacheKey.key, seed) ^ qHash(cacheKey.type, seed) ^ qHash(qMakePair(cacheKey.size.width(), cacheKey.size.height()), seed);
+		}
+	};
+
+	struct DownloadRequest
+	{
+		la::avdecc::UniqueIdentifier entityID{}; // Entity the image is downloaded from
+		Key key{};
+		Type type{ Type::None };
+	};
+
+	static constexpr auto MaxConcurrentDownloads = 2; // Limit the AA traffic, so it doesn't compete too much with the enumeration of entities
+
+	struct CacheItem
+	{
+		QImage image{}; // Full size image
+		QPixmap thumbnail{}; // Scaled image, ready to be painted
+	};
+
 	Key makeKey(la::avdecc::UniqueIdentifier const entityID) const noexcept
 	{
-		auto& manager = avdecc::ControllerManager::getInstance();
-		auto controlledEntity = manager.getControlledEntity(entityID);
-		if (controlledEntity)
+		// Called for each painted logo, read the summary instead of locking the entity
+		if (auto const summary = avdecc::ControllerManager::getInstance().getEntitySummary(entityID))
 		{
-			auto const entityModelID = controlledEntity->getEntity().getEntityModelID();
+			auto const entityModelID = summary->entityModelID;
+
+			// Logos are part of the entity model, share them across all entities of the same model
+			if (entityModelID)
+			{
+				return qMakePair(la::avdecc::UniqueIdentifier::value_type{ 0u }, entityModelID.getValue());
+			}
+
+			// No entity model to share with, use an entity specific key
 			return qMakePair(entityID.getValue(), entityModelID.getValue());
 		}
 		return {};
 	}
 
+	QImage getImage(la::avdecc::UniqueIdentifier const entityID, Key const& key, Type const type, bool const downloadIfNotInCache) noexcept
+	{
+		// Check if we have the image in the memory cache
+		if (auto const* const item = _cache.object(CacheKey{ key, type, {} }))
+		{
+			return item->image;
+		}
+
+		// Still loading from the disk, remember the download request in case it's not found there
+		if (isPending(key, type))
+		{
+			if (downloadIfNotInCache)
+			{
+				auto pendingIt = _pendingLoads.find(key);
+				if (pendingIt != _pendingLoads.end() && pendingIt->contains(type))
+				{
+					(*pendingIt)[type] = true;
+				}
+			}
+
+			// Images requested the most recently are the ones currently displayed, download them first
+			prioritizeDownload(key, type);
+
+			// Return an empty image while the loading or download is in progress
+			return {};
+		}
+
+		// Try to load from the disk, in background (the pending load prevents starting another one in the meantime)
+		_pendingLoads[key][type] = downloadIfNotInCache;
+
+		auto const generation = _generation.load();
+		_threadPool.start(new ImageTask{ this,
+			[filePath = imagePath(entityID, type)]()
+			{
+				HIVE_TRACE_SPAN("EntityLogoCache::loadImage");
+				auto image = QImage{};
+				if (QFileInfo::exists(filePath))
+				{
+					image.load(filePath);
+				}
+				return image;
+			},
+			[this, entityID, key, type, generation](QImage const& image)
+			{
+				if (generation != _generation)
+				{
+					return;
+				}
+
+				auto downloadIfNotFound = false;
+				auto pendingIt = _pendingLoads.find(key);
+				if (pendingIt != _pendingLoads.end())
+				{
+					downloadIfNotFound = pendingIt->take(type);
+					if (pendingIt->isEmpty())
+					{
+						_pendingLoads.erase(pendingIt);
+					}
+				}
+
+				if (!image.isNull())
+				{
+					// Found the image on the disk, add it to the memory cache
+					insertImage(key, type, image);
+					notifyImageChanged(key, type);
+				}
+				else if (downloadIfNotFound)
+				{
+					requestDownload(entityID, key, type);
+				}
+			} });
+
+		return {};
+	}
+
+	bool isPending(Key const& key, Type const type) const noexcept
+	{
+		auto const loadsIt = _pendingLoads.constFind(key);
+		if (loadsIt != _pendingLoads.constEnd() && loadsIt->contains(type))
+		{
+			return true;
+		}
+		auto const downloadsIt = _pendingDownloads.constFind(key);
+		return downloadsIt != _pendingDownloads.constEnd() && downloadsIt->contains(type);
+	}
+
+	void insertImage(Key const& key, Type const type, QImage const& image) noexcept
+	{
+		_cache.insert(CacheKey{ key, type, {} }, new CacheItem{ image, {} }, image.bytesPerLine() * image.height());
+	}
+
 	QString fileName(la::avdecc::UniqueIdentifier const entityID, Type const type) const noexcept
 	{
 		auto const key{ makeKey(entityID) };
+		if (key.first == 0u)
+		{
+			return QString{ typeToString(type) + '-' + avdecc::helper::uniqueIdentifierToString(la::avdecc::UniqueIdentifier{ key.second }) };
+		}
 		return QString{ typeToString(type) + '-' + avdecc::helper::uniqueIdentifierToString(la::avdecc::UniqueIdentifier{ key.first }) + '-' + avdecc::helper::uniqueIdentifierToString(la::avdecc::UniqueIdentifier{ key.second }) };
 	}
 
+	void notifyImageChanged(Key const& key, Type const type) noexcept
+	{
+		auto const usersIt = _keyUsers.constFind(key);
+		if (usersIt != _keyUsers.constEnd())
+		{
+			for (auto const entityID : *usersIt)
+			{
+				emit imageChanged(la::avdecc::UniqueIdentifier{ entityID }, type);
+			}
+		}
+	}
+
 	QString imageDir() const noexcept
 	{
 		return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + '/' + QCoreApplication::applicationName();
@@ -156,14 +375,138 @@ private:
 		return imageDir() + '/' + fileName(entityID, type) + ".png";
 	}
 
-	void downloadImage(la::avdecc::UniqueIdentifier const entityID, Type const type) noexcept
+	void requestDownload(la::avdecc::UniqueIdentifier const entityID, Key const& key, Type const type) noexcept
+	{
+		// The pending download prevents queuing another one while this one is in progress
+		if (isPending(key, type))
+		{
+			return;
+		}
+		_pendingDownloads[key].insert(type);
+		_downloadQueue.push_back(DownloadRequest{ entityID, key, type });
+
+		scheduleDownloads();
+	}
+
+	void prioritizeDownload(Key const& key, Type const type) noexcept
+	{
+		auto const it = std::find_if(_downloadQueue.begin(), _downloadQueue.end(),
+			[&key, type](auto const& request)
+			{
+				return request.key == key && request.type == type;
+			});
+		if (it != _downloadQueue.end() && it != _downloadQueue.begin())
+		{
+			_downloadQueue.splice(_downloadQueue.begin(), _downloadQueue, it);
+		}
+	}
+
+	void removePendingDownload(Key const& key, Type const type) noexcept
+	{
+		auto downloadsIt = _pendingDownloads.find(key);
+		if (downloadsIt != _pendingDownloads.end())
+		{
+			downloadsIt->remove(type);
+			if (downloadsIt->isEmpty())
+			{
+				_pendingDownloads.erase(downloadsIt);
+			}
+		}
+	}
+
+	void scheduleDownloads() noexcept
+	{
+		while (_activeDownloadsCount < MaxConcurrentDownloads)
+		{
+			// Get the first request for an entity that completed its enumeration
+			auto const it = std::find_if(_downloadQueue.begin(), _downloadQueue.end(),
+				[this](auto const& request)
+				{
+					return _onlineEntities.count(request.entityID) != 0;
+				});
+			if (it == _downloadQueue.end())
+			{
+				break;
+			}
+
+			auto const request = *it;
+			_downloadQueue.erase(it);
+
+			if (downloadImage(request.entityID, request.key, request.type))
+			{
+				++_activeDownloadsCount;
+			}
+			else
+			{
+				removePendingDownload(request.key, request.type);
+			}
+		}
+	}
+
+	void handleEntityOnline(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		_onlineEntities.insert(entityID);
+		scheduleDownloads();
+	}
+
+	void handleEntityOffline(la::avdecc::UniqueIdentifier const entityID) noexcept
+	{
+		_onlineEntities.erase(entityID);
+
+		// Cancel the queued downloads for this entity, unless another entity (of the same model) can be used instead
+		for (auto it = _downloadQueue.begin(); it != _downloadQueue.end();)
+		{
+			auto& request = *it;
+			if (request.entityID != entityID)
+			{
+				++it;
+				continue;
+			}
+
+			auto const usersIt = _keyUsers.constFind(request.key);
+			if (usersIt != _keyUsers.constEnd())
+			{
+				auto const userIt = std::find_if(usersIt->begin(), usersIt->end(),
+					[this, entityID](auto const userID)
+					{
+						auto const id = la::avdecc::UniqueIdentifier{ userID };
+						return id != entityID && _onlineEntities.count(id) != 0;
+					});
+				if (userIt != usersIt->end())
+				{
+					request.entityID = la::avdecc::UniqueIdentifier{ *userIt };
+					++it;
+					continue;
+				}
+			}
+
+			removePendingDownload(request.key, request.type);
+			it = _downloadQueue.erase(it);
+		}
+
+		scheduleDownloads();
+	}
+
+	void handleControllerOffline() noexcept
+	{
+		_onlineEntities.clear();
+
+		// Cancel all queued downloads (the ones in progress will complete with an error)
+		for (auto const& request : _downloadQueue)
+		{
+			removePendingDownload(request.key, request.type);
+		}
+		_downloadQueue.clear();
+	}
+
+	bool downloadImage(la::avdecc::UniqueIdentifier const entityID, Key const& key, Type const type) noexcept
 	{
 		auto& manager = avdecc::ControllerManager::getInstance();
 		auto controlledEntity = manager.getControlledEntity(entityID);
 
 		if (!controlledEntity)
 		{
-			return;
+			return false;
 		}
 
 		try
@@ -178,39 +521,59 @@ private:
 				if ((type == Type::Entity && model->memoryObjectType == la::avdecc::entity::model::MemoryObjectType::PngEntity) || (type == Type::Manufacturer && model->memoryObjectType == la::avdecc::entity::model::MemoryObjectType::PngManufacturer))
 				{
 					auto const& dynamicModel{ obj.dynamicModel };
-					manager.readDeviceMemory(entityID, model->startAddress, dynamicModel->length, nullptr,
-						[this, entityID, type](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AaCommandStatus const status, la::avdecc::controller::Controller::DeviceMemoryBuffer const& memoryBuffer)
+					manager.readDeviceMemoryChunked(entityID, model->startAddress, dynamicModel->length, avdecc::ControllerManager::DefaultDeviceMemoryReadWindow, nullptr,
+						[this, type, key, filePath = imagePath(entityID, type), generation = _generation.load()](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AaCommandStatus const status, la::avdecc::controller::Controller::DeviceMemoryBuffer const& memoryBuffer)
 						{
-							auto image = QImage::fromData(memoryBuffer.data(), static_cast<int>(memoryBuffer.size()));
+							auto const onImageDownloaded = [this, key, type, generation](QImage const& image)
+							{
+								// Release the download slot, even if the cache has been cleared in the meantime
+								--_activeDownloadsCount;
+
+								if (generation == _generation)
+								{
+									removePendingDownload(key, type);
 
-							// Be sure to run this code in the UI thread so we don't have to lock the cache
-							QMetaObject::invokeMethod(this,
-								[this, entityID, type, status, image = std::move(image)]()
+									// Save the image to the cache (nothing to do in case of error, the pending download has been removed)
+									if (!image.isNull())
+									{
+										insertImage(key, type, image);
+										notifyImageChanged(key, type);
+									}
+								}
+
+								scheduleDownloads();
+							};
+
+							if (!status)
+							{
+								QMetaObject::invokeMethod(this,
+									[onImageDownloaded]()
+									{
+										onImageDownloaded({});
+									});
+								return;
+							}
+
+							// Decode and save the image to the disk in background, then update the cache in the UI thread so we don't have to lock it
+							_threadPool.start(new ImageTask{ this,
+								[this, filePath, generation, data = QByteArray{ reinterpret_cast<char const*>(memoryBuffer.data()), static_cast<int>(memoryBuffer.size()) }]()
 								{
-									auto const key = makeKey(entityID);
-									if (!!status && !image.isNull())
+									auto const image = QImage::fromData(data);
+									if (!image.isNull() && generation == _generation)
 									{
-										QFileInfo fileInfo{ imagePath(entityID, type) };
+										QFileInfo fileInfo{ filePath };
 
 										// Make sure this directory exists & save the image to the disk
 										QDir().mkpath(fileInfo.absoluteDir().absolutePath());
 										image.save(fileInfo.filePath());
-
-										// Save the image to the cache
-										_cache[key][type] = image;
-										emit imageChanged(entityID, type);
 									}
-									else
-									{
-										// Error downloading the image, remove the temporary one from the cache
-										auto imagesIt = _cache.find(key);
-										if (imagesIt != _cache.end())
-										{
-											imagesIt->remove(type);
-										}
-									}
-								});
+									return image;
+								},
+								onImageDownloaded });
 						});
+
+					// Only download the first matching memory object
+					return true;
 				}
 			}
 		}
@@ -218,11 +581,21 @@ private:
 		{
 			AVDECC_ASSERT(false, "Failed to find logo descriptor information in AEM");
 		}
+
+		return false;
 	}
 
 private:
-	using CacheData = QHash<Type, QImage>;
-	QHash<Key, CacheData> _cache;
+	using PendingLoads = QHash<Type, bool>; // Whether the image should be downloaded if not found on the disk
+	QCache<CacheKey, CacheItem> _cache; // Images and thumbnails, the cost being their size in bytes
+	QHash<Key, PendingLoads> _pendingLoads;
+	QHash<Key, QSet<Type>> _pendingDownloads; // Downloads either queued or in progress
+	std::list<DownloadRequest> _downloadQueue{}; // Queued downloads, by priority
+	std::unordered_set<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash> _onlineEntities{}; // Entities that completed their enumeration
+	int _activeDownloadsCount{ 0 };
+	QHash<Key, QSet<la::avdecc::UniqueIdentifier::value_type>> _keyUsers; // Entities that requested the images of a key
+	std::atomic_int _generation{ 0 }; // Incremented each time the cache is cleared
+	QThreadPool _threadPool{};
 };
 
 EntityLogoCache& EntityLogoCache::getInstance() noexcept
@@ -21,6 +21,8 @@
 
 #include <QObject>
 #include <QImage>
+#include <QPixmap>
+#include <QSize>
 #include <QHash>
 
 #include "avdecc/controllerManager.hpp"
@@ -36,11 +38,18 @@ public:
 		Manufacturer
 	};
 
+	static constexpr int DefaultMemoryBudget = 32 * 1024 * 1024; // In bytes
+
 	static EntityLogoCache& getInstance() noexcept;
 
 	virtual QImage getImage(la::avdecc::UniqueIdentifier const entityID, Type const type, bool const downloadIfNotInCache = false) noexcept = 0;
+	// Returns the image scaled to fit the specified size (for the specified device pixel ratio), ready to be painted. Null pixmap if the image is not available (yet)
+	virtual QPixmap getThumbnail(la::avdecc::UniqueIdentifier const entityID, Type const type, QSize const& size, qreal const devicePixelRatio, bool const downloadIfNotInCache = false) noexcept = 0;
 	virtual bool isImageInCache(la::avdecc::UniqueIdentifier const entityID, Type const type) const noexcept = 0;
 
+	// Set the memory budget of the images and thumbnails kept in memory, the least recently used ones being discarded first
+	virtual void setMemoryBudget(int const bytes) noexcept = 0;
+
 	virtual void clear() noexcept = 0;
 
 	Q_SIGNAL void imageChanged(la::avdecc::UniqueIdentifier const entityID, EntityLogoCache::Type const type);
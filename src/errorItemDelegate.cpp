@@ -22,19 +22,25 @@
 
 #include <QPainter>
 
+static settings::SettingsManager::Handle<int> themeColorIndexHandle() noexcept
+{
+	static auto const s_handle = settings::SettingsManager::getInstance().getHandle<int>(settings::General_ThemeColorIndex);
+	return s_handle;
+}
+
 ErrorItemDelegate::ErrorItemDelegate(QObject* parent) noexcept
 	: QStyledItemDelegate(parent)
 {
 	// Configure settings observers
 	auto& settings = settings::SettingsManager::getInstance();
-	settings.registerSettingObserver(settings::General_ThemeColorIndex.name, this);
+	settings.registerSettingObserver(themeColorIndexHandle(), this);
 }
 
 ErrorItemDelegate::~ErrorItemDelegate() noexcept
 {
 	// Remove settings observers
 	auto& settings = settings::SettingsManager::getInstance();
-	settings.unregisterSettingObserver(settings::General_ThemeColorIndex.name, this);
+	settings.unregisterSettingObserver(themeColorIndexHandle(), this);
 }
 
 void ErrorItemDelegate::paint(QPainter* painter, QStyleOptionViewItem const& option, QModelIndex const& index) const
@@ -21,6 +21,7 @@
 #include "ui_firmwareUploadDialog.h"
 #include "avdecc/controllerManager.hpp"
 #include "avdecc/helper.hpp"
+#include "settingsManager/settings.hpp"
 #include <la/avdecc/utils.hpp>
 
 #include <QLabel>
@@ -31,10 +32,26 @@
 #include <QByteArray>
 #include <QMessageBox>
 #include <QCloseEvent>
+#include <QtEndian>
+#include <QPointer>
+#include <QCoreApplication>
+#include <QRunnable>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
+
+static constexpr auto MaxUploadAttempts = 3;
+static constexpr auto ThroughputRefreshPeriod = std::chrono::milliseconds{ 1000 };
+static constexpr auto ThroughputSmoothingFactor = 0.3; // Weight of the last sample in the measured throughput
 
 enum class UpdateState
 {
 	Waiting = 0,
+	Queued,
+	WaitingForEntity,
 	StartUpload,
 	Uploading,
 	StartStore,
@@ -84,10 +101,102 @@ private:
 	QProgressBar _progressBar;
 };
 
-FirmwareUploadDialog::FirmwareUploadDialog(la::avdecc::controller::Controller::DeviceMemoryBuffer&& firmwareData, QString const& name, std::vector<EntityInfo> entitiesToUpdate, QWidget* parent)
+static QString throughputToString(double const bytesPerSecond)
+{
+	if (bytesPerSecond >= 1024.0 * 1024.0)
+	{
+		return QString("%1 MiB/s").arg(bytesPerSecond / (1024.0 * 1024.0), 0, 'f', 1);
+	}
+	return QString("%1 KiB/s").arg(bytesPerSecond / 1024.0, 0, 'f', 1);
+}
+
+static QString durationToString(std::chrono::seconds const duration)
+{
+	auto const totalSeconds = duration.count();
+	auto const hours = totalSeconds / 3600;
+	auto const minutes = (totalSeconds / 60) % 60;
+	auto const seconds = totalSeconds % 60;
+
+	if (hours > 0)
+	{
+		return QString("%1:%2:%3").arg(hours).arg(minutes, 2, 10, QChar{ '0' }).arg(seconds, 2, 10, QChar{ '0' });
+	}
+	return QString("%1:%2").arg(minutes, 2, 10, QChar{ '0' }).arg(seconds, 2, 10, QChar{ '0' });
+}
+
+static std::chrono::seconds remainingDuration(std::uint64_t const remainingBytes, double const bytesPerSecond)
+{
+	return std::chrono::seconds{ static_cast<std::chrono::seconds::rep>(static_cast<double>(remainingBytes) / bytesPerSecond) };
+}
+
+/** CRC-32 (IEEE 802.3, reflected) using the slicing-by-8 tables: 8 bytes are folded per iteration with independent lookups, instead of 1 byte per dependent lookup */
+static std::uint32_t crc32(std::uint8_t const* data, std::uint64_t length) noexcept
+{
+	using Tables = std::array<std::array<std::uint32_t, 256>, 8>;
+	static auto const s_tables = []()
+	{
+		auto tables = Tables{};
+		for (auto i = std::uint32_t{ 0u }; i < 256u; ++i)
+		{
+			auto crc = i;
+			for (auto bit = 0; bit < 8; ++bit)
+			{
+				crc = (crc >> 1) ^ ((crc & 1u) ? 0xEDB88320u : 0u);
+			}
+			tables[0][i] = crc;
+		}
+		for (auto i = 0u; i < 256u; ++i)
+		{
+			for (auto slice = 1u; slice < 8u; ++slice)
+			{
+				tables[slice][i] = (tables[slice - 1][i] >> 8) ^ tables[0][tables[slice - 1][i] & 0xFFu];
+			}
+		}
+		return tables;
+	}();
+
+	auto crc = 0xFFFFFFFFu;
+	while (length >= 8u)
+	{
+		auto const low = qFromLittleEndian<std::uint32_t>(data) ^ crc;
+		auto const high = qFromLittleEndian<std::uint32_t>(data + 4);
+		crc = s_tables[7][low & 0xFFu] ^ s_tables[6][(low >> 8) & 0xFFu] ^ s_tables[5][(low >> 16) & 0xFFu] ^ s_tables[4][low >> 24] ^ s_tables[3][high & 0xFFu] ^ s_tables[2][(high >> 8) & 0xFFu] ^ s_tables[1][(high >> 16) & 0xFFu] ^ s_tables[0][high >> 24];
+		data += 8;
+		length -= 8u;
+	}
+	while (length-- > 0u)
+	{
+		crc = (crc >> 8) ^ s_tables[0][(crc ^ *data++) & 0xFFu];
+	}
+	return ~crc;
+}
+
+class ChecksumTask final : public QRunnable
+{
+public:
+	using Handler = std::function<void(std::uint32_t const checksum)>;
+
+	ChecksumTask(avdecc::ControllerManager::SharedMemoryImage const& image, Handler&& handler)
+		: _image{ image }
+		, _handler{ std::move(handler) }
+	{
+	}
+
+	// QRunnable overrides
+	virtual void run() override
+	{
+		_handler(crc32(_image.data, _image.size));
+	}
+
+private:
+	avdecc::ControllerManager::SharedMemoryImage const _image{};
+	Handler _handler{};
+};
+
+FirmwareUploadDialog::FirmwareUploadDialog(avdecc::ControllerManager::SharedMemoryImage const& firmwareImage, QString const& name, std::vector<EntityInfo> entitiesToUpdate, QWidget* parent)
 	: QDialog(parent, Qt::WindowSystemMenuHint | Qt::WindowTitleHint | Qt::WindowCloseButtonHint)
 	, _ui(new Ui::FirmwareUploadDialog)
-	, _firmwareData(firmwareData)
+	, _firmwareImage(firmwareImage)
 {
 	_ui->setupUi(this);
 
@@ -103,8 +212,58 @@ FirmwareUploadDialog::FirmwareUploadDialog(la::avdecc::controller::Controller::D
 		scheduleUpload(entityInfos);
 	}
 
+	// Throughput measurement
+	_throughputTimer.setInterval(ThroughputRefreshPeriod);
+	connect(&_throughputTimer, &QTimer::timeout, this, &FirmwareUploadDialog::updateThroughput);
+
 	// Connect signals
 	auto& manager = avdecc::ControllerManager::getInstance();
+	connect(&manager, &avdecc::ControllerManager::entityOffline, this,
+		[this](la::avdecc::UniqueIdentifier const entityID)
+		{
+			_offlineEntities.insert(entityID);
+
+			// Ongoing uploads are suspended until the entity comes back (the pending results of the current attempt will be ignored)
+			for (auto row = 0; row < _ui->listWidget->count(); ++row)
+			{
+				auto* item = _ui->listWidget->item(row);
+				auto* widget = static_cast<UploadWidget*>(_ui->listWidget->itemWidget(item));
+
+				auto const eID = item->data(la::avdecc::utils::to_integral(ItemRole::EntityID)).value<la::avdecc::UniqueIdentifier>();
+				auto const state = item->data(la::avdecc::utils::to_integral(ItemRole::UpdateState)).value<UpdateState>();
+				if (entityID == eID && (state == UpdateState::StartUpload || state == UpdateState::Uploading || state == UpdateState::StartStore))
+				{
+					auto const entityName = item->data(la::avdecc::utils::to_integral(ItemRole::EntityName)).toString();
+					widget->setText(QString("%1: Waiting for the entity to come back online").arg(entityName));
+					widget->setProgress(0);
+					item->setData(la::avdecc::utils::to_integral(ItemRole::UpdateState), QVariant::fromValue(UpdateState::WaitingForEntity));
+				}
+			}
+
+			scheduleUploads();
+		});
+	connect(&manager, &avdecc::ControllerManager::entityOnline, this,
+		[this](la::avdecc::UniqueIdentifier const entityID, std::chrono::milliseconds const /*enumerationTime*/)
+		{
+			_offlineEntities.erase(entityID);
+
+			for (auto row = 0; row < _ui->listWidget->count(); ++row)
+			{
+				auto* item = _ui->listWidget->item(row);
+				auto* widget = static_cast<UploadWidget*>(_ui->listWidget->itemWidget(item));
+
+				auto const eID = item->data(la::avdecc::utils::to_integral(ItemRole::EntityID)).value<la::avdecc::UniqueIdentifier>();
+				auto const state = item->data(la::avdecc::utils::to_integral(ItemRole::UpdateState)).value<UpdateState>();
+				if (entityID == eID && state == UpdateState::WaitingForEntity)
+				{
+					auto const entityName = item->data(la::avdecc::utils::to_integral(ItemRole::EntityName)).toString();
+					widget->setText(QString("%1: Waiting to start").arg(entityName));
+					item->setData(la::avdecc::utils::to_integral(ItemRole::UpdateState), QVariant::fromValue(UpdateState::Queued));
+				}
+			}
+
+			scheduleUploads();
+		});
 	connect(&manager, &avdecc::ControllerManager::operationProgress, this,
 		[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::DescriptorIndex const descriptorIndex, la::avdecc::entity::model::OperationID const operationID, float const percentComplete)
 		{
@@ -162,6 +321,76 @@ FirmwareUploadDialog::~FirmwareUploadDialog()
 	delete _ui;
 }
 
+avdecc::ControllerManager::SharedMemoryImage FirmwareUploadDialog::readFirmwareFile(QFile& file) noexcept
+{
+	// Mapping of the file, kept as long as an upload references the image
+	struct MappedFile
+	{
+		MappedFile(QString const& fileName)
+			: file{ fileName }
+		{
+		}
+		~MappedFile()
+		{
+			if (data != nullptr)
+			{
+				file.unmap(data);
+			}
+		}
+		QFile file;
+		uchar* data{ nullptr };
+	};
+
+	auto const fileSize = file.size();
+	if (fileSize <= 0)
+	{
+		return {};
+	}
+
+	// Map the file through its own handle (the caller's one is closed once the image is loaded), the pages being backed by the file and not counting as an image in memory
+	try
+	{
+		auto mappedFile = std::make_shared<MappedFile>(file.fileName());
+		if (mappedFile->file.open(QIODevice::ReadOnly) && mappedFile->file.size() == fileSize)
+		{
+			mappedFile->data = mappedFile->file.map(0, fileSize);
+			if (mappedFile->data != nullptr)
+			{
+				auto const* const data = mappedFile->data;
+				return { std::move(mappedFile), data, static_cast<std::uint64_t>(fileSize) };
+			}
+		}
+	}
+	catch (...)
+	{
+	}
+
+	// Mapping not supported for this file, read it in place
+	try
+	{
+		auto buffer = std::make_shared<la::avdecc::controller::Controller::DeviceMemoryBuffer>();
+		buffer->resize(static_cast<size_t>(fileSize));
+		auto* data = reinterpret_cast<char*>(buffer->data());
+		auto remaining = fileSize;
+		while (remaining > 0)
+		{
+			auto const readSize = file.read(data, remaining);
+			if (readSize <= 0)
+			{
+				return {};
+			}
+			data += readSize;
+			remaining -= readSize;
+		}
+		auto const* const bufferData = buffer->data();
+		return { std::move(buffer), bufferData, static_cast<std::uint64_t>(fileSize) };
+	}
+	catch (...)
+	{
+		return {};
+	}
+}
+
 bool FirmwareUploadDialog::areAllDone() const noexcept
 {
 	auto const [total, failed, succeed] = getCounts();
@@ -180,6 +409,8 @@ void FirmwareUploadDialog::checkAllDone() noexcept
 	{
 		_ui->startPushButton->setEnabled(false);
 		_ui->abortPushButton->setEnabled(false);
+		_throughputTimer.stop();
+		_ui->statusLabel->setText(checksumText());
 
 		if (failed == 0)
 		{
@@ -288,119 +519,360 @@ void FirmwareUploadDialog::reject()
 	}
 }
 
-void FirmwareUploadDialog::on_startPushButton_clicked()
+void FirmwareUploadDialog::scheduleUploads() noexcept
 {
-	_ui->startPushButton->setEnabled(false);
-	_ui->abortPushButton->setEnabled(true);
-
-	auto& manager = avdecc::ControllerManager::getInstance();
-
+	auto inFlightCount = size_t{ 0u };
 	for (auto row = 0; row < _ui->listWidget->count(); ++row)
+	{
+		auto const state = _ui->listWidget->item(row)->data(la::avdecc::utils::to_integral(ItemRole::UpdateState)).value<UpdateState>();
+		if (state == UpdateState::StartUpload || state == UpdateState::Uploading)
+		{
+			++inFlightCount;
+		}
+	}
+
+	for (auto row = 0; row < _ui->listWidget->count() && inFlightCount < _maxParallelUploads; ++row)
 	{
 		auto* item = _ui->listWidget->item(row);
-		auto* widget = static_cast<UploadWidget*>(_ui->listWidget->itemWidget(item));
 
 		auto const entityID = item->data(la::avdecc::utils::to_integral(ItemRole::EntityID)).value<la::avdecc::UniqueIdentifier>();
-		auto const descriptorIndex = item->data(la::avdecc::utils::to_integral(ItemRole::DescriptorIndex)).value<la::avdecc::entity::model::DescriptorIndex>();
-		auto const entityName = item->data(la::avdecc::utils::to_integral(ItemRole::EntityName)).toString();
-
-		widget->setText(QString("%1: Uploading").arg(entityName));
-		widget->setProgress(0);
-		item->setData(la::avdecc::utils::to_integral(ItemRole::UpdateState), QVariant::fromValue(UpdateState::StartUpload));
+		auto const state = item->data(la::avdecc::utils::to_integral(ItemRole::UpdateState)).value<UpdateState>();
+		if (state != UpdateState::Queued || _offlineEntities.count(entityID) != 0)
+		{
+			continue;
+		}
 
-		// Query an OperationID to start the upload
-		manager.startUploadMemoryObjectOperation(entityID, descriptorIndex, _firmwareData.size(),
-			[this, item, widget, entityName, descriptorIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, la::avdecc::entity::model::OperationID const operationID)
+		// With a bandwidth limit, only start another upload if the measured throughput of the running ones leaves room for it
+		if (_maxUploadBandwidth != 0u && inFlightCount != 0u)
+		{
+			auto const uploadThroughput = _measuredThroughput / static_cast<double>(inFlightCount);
+			if (uploadThroughput <= 0.0 || (_measuredThroughput + uploadThroughput) > static_cast<double>(_maxUploadBandwidth))
 			{
-				// Handle the result of startUploadMemoryObjectOperation
-				QMetaObject::invokeMethod(widget,
-					[this, item, widget, status, operationID, entityID, descriptorIndex, entityName]()
+				break;
+			}
+			startUpload(item);
+			// Wait for the next throughput measurement before starting another one
+			break;
+		}
+
+		startUpload(item);
+		++inFlightCount;
+	}
+}
+
+void FirmwareUploadDialog::startUpload(QListWidgetItem* const item) noexcept
+{
+	auto* widget = static_cast<UploadWidget*>(_ui->listWidget->itemWidget(item));
+
+	auto const entityID = item->data(la::avdecc::utils::to_integral(ItemRole::EntityID)).value<la::avdecc::UniqueIdentifier>();
+	auto const descriptorIndex = item->data(la::avdecc::utils::to_integral(ItemRole::DescriptorIndex)).value<la::avdecc::entity::model::DescriptorIndex>();
+	auto const entityName = item->data(la::avdecc::utils::to_integral(ItemRole::EntityName)).toString();
+	auto const attempt = item->data(la::avdecc::utils::to_integral(ItemRole::Attempt)).toInt() + 1;
+
+	widget->setText(QString("%1: Uploading").arg(entityName));
+	widget->setProgress(0);
+	item->setData(la::avdecc::utils::to_integral(ItemRole::Attempt), attempt);
+	item->setData(la::avdecc::utils::to_integral(ItemRole::UploadedBytes), QVariant::fromValue(qulonglong{ 0u }));
+	item->setData(la::avdecc::utils::to_integral(ItemRole::UploadStartTime), QVariant::fromValue(_elapsedTimer.elapsed()));
+	item->setData(la::avdecc::utils::to_integral(ItemRole::UpdateState), QVariant::fromValue(UpdateState::StartUpload));
+
+	// Results of a previous attempt (or received after the entity went offline) are ignored
+	auto const isCurrentStep = [item, attempt](UpdateState const expectedState)
+	{
+		return item->data(la::avdecc::utils::to_integral(ItemRole::Attempt)).toInt() == attempt && item->data(la::avdecc::utils::to_integral(ItemRole::UpdateState)).value<UpdateState>() == expectedState;
+	};
+
+	// Query an OperationID to start the upload
+	auto& manager = avdecc::ControllerManager::getInstance();
+	manager.startUploadMemoryObjectOperation(entityID, descriptorIndex, _firmwareImage.size,
+		[this, item, widget, entityName, descriptorIndex, attempt, isCurrentStep](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, la::avdecc::entity::model::OperationID const operationID)
+		{
+			// Handle the result of startUploadMemoryObjectOperation
+			QMetaObject::invokeMethod(widget,
+				[this, item, widget, status, operationID, entityID, descriptorIndex, entityName, attempt, isCurrentStep]()
+				{
+					if (!isCurrentStep(UpdateState::StartUpload))
 					{
-						// Failed to startUploadMemoryObjectOperation
-						if (!status)
-						{
-							widget->setText(QString("%1: Upload failed: %2").arg(entityName).arg(QString::fromStdString(la::avdecc::entity::ControllerEntity::statusToString(status))));
-							item->setData(la::avdecc::utils::to_integral(ItemRole::UpdateState), QVariant::fromValue(UpdateState::Failed));
-							checkAllDone();
-						}
-						// Succeeded
-						else
+						return;
+					}
+
+					// Failed to startUploadMemoryObjectOperation
+					if (!status)
+					{
+						uploadFailed(item, QString("Upload failed: %1").arg(QString::fromStdString(la::avdecc::entity::ControllerEntity::statusToString(status))));
+						return;
+					}
+
+					auto const memoryObjectAddress = item->data(la::avdecc::utils::to_integral(ItemRole::MemoryObjectAddress)).value<std::uint64_t>();
+					item->setData(la::avdecc::utils::to_integral(ItemRole::OperationID), QVariant::fromValue(operationID));
+					item->setData(la::avdecc::utils::to_integral(ItemRole::UpdateState), QVariant::fromValue(UpdateState::Uploading));
+
+					// Write the firmware to the MemoryObject, each upload reading its chunks from the shared image
+					auto& manager = avdecc::ControllerManager::getInstance();
+					manager.writeDeviceMemoryChunked(entityID, memoryObjectAddress, _firmwareImage, avdecc::ControllerManager::DefaultDeviceMemoryWriteWindow,
+						[this, widget, item, attempt, isCurrentStep](la::avdecc::controller::ControlledEntity const* const /*entity*/, float const percentComplete)
 						{
-							auto const memoryObjectAddress = item->data(la::avdecc::utils::to_integral(ItemRole::MemoryObjectAddress)).value<std::uint64_t>();
-							item->setData(la::avdecc::utils::to_integral(ItemRole::OperationID), QVariant::fromValue(operationID));
-							item->setData(la::avdecc::utils::to_integral(ItemRole::UpdateState), QVariant::fromValue(UpdateState::Uploading));
-
-							// Write the firmware to the MemoryObject
-							auto& manager = avdecc::ControllerManager::getInstance();
-							manager.writeDeviceMemory(entityID, memoryObjectAddress, _firmwareData,
-								[widget, this, item](la::avdecc::controller::ControlledEntity const* const /*entity*/, float const percentComplete)
+							// Upload progress
+							QMetaObject::invokeMethod(widget,
+								[this, widget, item, percentComplete, isCurrentStep]()
 								{
-									// Upload progress
-									QMetaObject::invokeMethod(widget,
-										[this, widget, percentComplete]()
-										{
-											widget->setProgress(static_cast<int>(percentComplete));
-										},
-										Qt::QueuedConnection);
-
-									// Not the cleanest code, we directly access item's data in another thread without locking (should be fine though)
-									return item->data(la::avdecc::utils::to_integral(ItemRole::UpdateState)).value<UpdateState>() == UpdateState::Failed;
+									if (!isCurrentStep(UpdateState::Uploading))
+									{
+										return;
+									}
+
+									auto const uploadedBytes = static_cast<std::uint64_t>(static_cast<double>(_firmwareImage.size) * std::max(0.0f, std::min(100.0f, percentComplete)) / 100.0);
+									auto const previousUploadedBytes = item->data(la::avdecc::utils::to_integral(ItemRole::UploadedBytes)).value<qulonglong>();
+									if (uploadedBytes > previousUploadedBytes)
+									{
+										_totalUploadedBytes += uploadedBytes - previousUploadedBytes;
+										item->setData(la::avdecc::utils::to_integral(ItemRole::UploadedBytes), QVariant::fromValue(qulonglong{ uploadedBytes }));
+									}
+									widget->setProgress(static_cast<int>(percentComplete));
 								},
-								[widget, this, entityName, item, entityID, descriptorIndex](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AaCommandStatus const status)
+								Qt::QueuedConnection);
+
+							// Not the cleanest code, we directly access item's data in another thread without locking (should be fine though)
+							// Abort if the upload was cancelled, or if the entity went offline (the upload will be started again)
+							return item->data(la::avdecc::utils::to_integral(ItemRole::Attempt)).toInt() != attempt || item->data(la::avdecc::utils::to_integral(ItemRole::UpdateState)).value<UpdateState>() != UpdateState::Uploading;
+						},
+						[this, widget, entityName, item, entityID, descriptorIndex, isCurrentStep](la::avdecc::controller::ControlledEntity const* const /*entity*/, la::avdecc::entity::ControllerEntity::AaCommandStatus const status)
+						{
+							// Upload complete
+							QMetaObject::invokeMethod(widget,
+								[this, item, widget, status, entityID, descriptorIndex, entityName, isCurrentStep]()
 								{
-									// Upload complete
-									QMetaObject::invokeMethod(widget,
-										[this, item, widget, status, entityID, descriptorIndex, entityName]()
+									if (!isCurrentStep(UpdateState::Uploading))
+									{
+										return;
+									}
+
+									// Failed to upload
+									if (!status)
+									{
+										uploadFailed(item, QString("Upload Failed: %1").arg(QString::fromStdString(la::avdecc::entity::ControllerEntity::statusToString(status))));
+										return;
+									}
+
+									widget->setText(QString("%1: Storing").arg(entityName));
+									widget->setProgress(0);
+									item->setData(la::avdecc::utils::to_integral(ItemRole::UpdateState), QVariant::fromValue(UpdateState::StartStore));
+
+									// The upload slot is free, storing does not use the network
+									scheduleUploads();
+
+									// Query an OperationID to store the firmware and reboot
+									auto& manager = avdecc::ControllerManager::getInstance();
+									manager.startStoreAndRebootMemoryObjectOperation(entityID, descriptorIndex,
+										[this, item, widget, isCurrentStep](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, la::avdecc::entity::model::OperationID const operationID)
 										{
-											// Failed to upload
-											if (!status)
-											{
-												widget->setText(QString("%1: Upload Failed: %2").arg(entityName).arg(QString::fromStdString(la::avdecc::entity::ControllerEntity::statusToString(status))));
-												item->setData(la::avdecc::utils::to_integral(ItemRole::UpdateState), QVariant::fromValue(UpdateState::Failed));
-												checkAllDone();
-											}
-											// Succeeded
-											else
-											{
-												widget->setText(QString("%1: Storing").arg(entityName));
-												widget->setProgress(0);
-												item->setData(la::avdecc::utils::to_integral(ItemRole::UpdateState), QVariant::fromValue(UpdateState::StartStore));
-
-												// Query an OperationID to store the firmware and reboot
-												auto& manager = avdecc::ControllerManager::getInstance();
-												manager.startStoreAndRebootMemoryObjectOperation(entityID, descriptorIndex,
-													[this, item, widget, entityName](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status, la::avdecc::entity::model::OperationID const operationID)
+											// Handle the result of startStoreAndRebootMemoryObjectOperation
+											QMetaObject::invokeMethod(widget,
+												[this, item, status, operationID, isCurrentStep]()
+												{
+													if (!isCurrentStep(UpdateState::StartStore))
 													{
-														// Handle the result of startStoreAndRebootMemoryObjectOperation
-														QMetaObject::invokeMethod(widget,
-															[this, item, widget, status, entityID, operationID, entityName]()
-															{
-																// Failed to startStoreAndRebootMemoryObjectOperation
-																if (!status)
-																{
-																	widget->setText(QString("%1: Upload failed: %2").arg(entityName).arg(QString::fromStdString(la::avdecc::entity::ControllerEntity::statusToString(status))));
-																	item->setData(la::avdecc::utils::to_integral(ItemRole::UpdateState), QVariant::fromValue(UpdateState::Failed));
-																	checkAllDone();
-																}
-																// Succeeded
-																else
-																{
-																	// Store the OperationID, and wait for operationProgress and operationCompleted QT signals
-																	item->setData(la::avdecc::utils::to_integral(ItemRole::OperationID), QVariant::fromValue(operationID));
-																	item->setData(la::avdecc::utils::to_integral(ItemRole::UpdateState), QVariant::fromValue(UpdateState::Storing));
-																}
-															},
-															Qt::QueuedConnection);
-													});
-											}
-										},
-										Qt::QueuedConnection);
-								});
-						}
-					},
-					Qt::QueuedConnection);
-			});
+														return;
+													}
+
+													// Failed to startStoreAndRebootMemoryObjectOperation
+													if (!status)
+													{
+														uploadFailed(item, QString("Upload failed: %1").arg(QString::fromStdString(la::avdecc::entity::ControllerEntity::statusToString(status))));
+														return;
+													}
+
+													// Store the OperationID, and wait for operationProgress and operationCompleted QT signals
+													item->setData(la::avdecc::utils::to_integral(ItemRole::OperationID), QVariant::fromValue(operationID));
+													item->setData(la::avdecc::utils::to_integral(ItemRole::UpdateState), QVariant::fromValue(UpdateState::Storing));
+												},
+												Qt::QueuedConnection);
+										});
+								},
+								Qt::QueuedConnection);
+						});
+				},
+				Qt::QueuedConnection);
+		});
+}
+
+void FirmwareUploadDialog::uploadFailed(QListWidgetItem* const item, QString const& reason) noexcept
+{
+	auto* widget = static_cast<UploadWidget*>(_ui->listWidget->itemWidget(item));
+
+	auto const entityID = item->data(la::avdecc::utils::to_integral(ItemRole::EntityID)).value<la::avdecc::UniqueIdentifier>();
+	auto const entityName = item->data(la::avdecc::utils::to_integral(ItemRole::EntityName)).toString();
+
+	// The entity went offline during the command, wait for it to come back (not counted as a failed attempt)
+	if (_offlineEntities.count(entityID) != 0)
+	{
+		widget->setText(QString("%1: Waiting for the entity to come back online").arg(entityName));
+		widget->setProgress(0);
+		item->setData(la::avdecc::utils::to_integral(ItemRole::UpdateState), QVariant::fromValue(UpdateState::WaitingForEntity));
+	}
+	else
+	{
+		auto const failedAttempts = item->data(la::avdecc::utils::to_integral(ItemRole::FailedAttempts)).toInt() + 1;
+		item->setData(la::avdecc::utils::to_integral(ItemRole::FailedAttempts), failedAttempts);
+
+		// Retry later
+		if (failedAttempts < MaxUploadAttempts)
+		{
+			widget->setText(QString("%1: %2 (will retry, attempt %3 of %4)").arg(entityName).arg(reason).arg(failedAttempts + 1).arg(MaxUploadAttempts));
+			widget->setProgress(0);
+			item->setData(la::avdecc::utils::to_integral(ItemRole::UpdateState), QVariant::fromValue(UpdateState::Queued));
+		}
+		else
+		{
+			widget->setText(QString("%1: %2").arg(entityName).arg(reason));
+			item->setData(la::avdecc::utils::to_integral(ItemRole::UpdateState), QVariant::fromValue(UpdateState::Failed));
+			checkAllDone();
+		}
 	}
+
+	scheduleUploads();
+}
+
+void FirmwareUploadDialog::updateThroughput() noexcept
+{
+	auto const now = _elapsedTimer.elapsed();
+	auto const sampleDuration = now - _lastSampleTime;
+	if (sampleDuration <= 0)
+	{
+		return;
+	}
+
+	// Smooth the measured throughput, so the ETA doesn't jump around
+	auto const sampleThroughput = static_cast<double>(_totalUploadedBytes - _lastSampleUploadedBytes) * 1000.0 / static_cast<double>(sampleDuration);
+	_measuredThroughput = _measuredThroughput == 0.0 ? sampleThroughput : (ThroughputSmoothingFactor * sampleThroughput + (1.0 - ThroughputSmoothingFactor) * _measuredThroughput);
+	_lastSampleUploadedBytes = _totalUploadedBytes;
+	_lastSampleTime = now;
+
+	auto const firmwareSize = _firmwareImage.size;
+	auto remainingBytes = std::uint64_t{ 0u };
+	auto uploadingCount = 0;
+	auto queuedCount = 0;
+
+	for (auto row = 0; row < _ui->listWidget->count(); ++row)
+	{
+		auto* item = _ui->listWidget->item(row);
+		auto* widget = static_cast<UploadWidget*>(_ui->listWidget->itemWidget(item));
+
+		auto const state = item->data(la::avdecc::utils::to_integral(ItemRole::UpdateState)).value<UpdateState>();
+		switch (state)
+		{
+			case UpdateState::Queued:
+			case UpdateState::WaitingForEntity:
+				remainingBytes += firmwareSize;
+				++queuedCount;
+				break;
+			case UpdateState::StartUpload:
+				remainingBytes += firmwareSize;
+				++uploadingCount;
+				break;
+			case UpdateState::Uploading:
+			{
+				auto const uploadedBytes = std::min(firmwareSize, static_cast<std::uint64_t>(item->data(la::avdecc::utils::to_integral(ItemRole::UploadedBytes)).value<qulonglong>()));
+				auto const uploadDuration = now - item->data(la::avdecc::utils::to_integral(ItemRole::UploadStartTime)).value<qint64>();
+				remainingBytes += firmwareSize - uploadedBytes;
+				++uploadingCount;
+
+				// Per entity ETA, from the throughput of its own upload
+				if (uploadedBytes > 0u && uploadDuration > 0)
+				{
+					auto const entityName = item->data(la::avdecc::utils::to_integral(ItemRole::EntityName)).toString();
+					auto const uploadThroughput = static_cast<double>(uploadedBytes) * 1000.0 / static_cast<double>(uploadDuration);
+					widget->setText(QString("%1: Uploading (%2, %3 remaining)").arg(entityName).arg(throughputToString(uploadThroughput)).arg(durationToString(remainingDuration(firmwareSize - uploadedBytes, uploadThroughput))));
+				}
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	// Global ETA, from the throughput of all uploads (not including the time needed by the entities to store the firmware)
+	if (uploadingCount == 0 && queuedCount == 0)
+	{
+		_ui->statusLabel->setText(checksumText());
+	}
+	else
+	{
+		auto const eta = _measuredThroughput > 0.0 ? durationToString(remainingDuration(remainingBytes, _measuredThroughput)) : QString("Unknown");
+		_ui->statusLabel->setText(QString("Uploading to %1 entities, %2 waiting - %3 - Remaining upload time: %4 - %5").arg(uploadingCount).arg(queuedCount).arg(throughputToString(_measuredThroughput)).arg(eta).arg(checksumText()));
+	}
+
+	scheduleUploads();
+}
+
+void FirmwareUploadDialog::on_startPushButton_clicked()
+{
+	_ui->startPushButton->setEnabled(false);
+	_ui->abortPushButton->setEnabled(true);
+
+	// Scheduler configuration
+	auto& settings = settings::SettingsManager::getInstance();
+	_maxParallelUploads = static_cast<size_t>(std::max(1, settings.getValue(settings::Controller_FirmwareMaxParallelUploads.name).toInt()));
+	_maxUploadBandwidth = static_cast<std::uint64_t>(std::max(0, settings.getValue(settings::Controller_FirmwareMaxUploadBandwidth.name).toInt())) * 1024u;
+
+	for (auto row = 0; row < _ui->listWidget->count(); ++row)
+	{
+		auto* item = _ui->listWidget->item(row);
+		item->setData(la::avdecc::utils::to_integral(ItemRole::Attempt), 0);
+		item->setData(la::avdecc::utils::to_integral(ItemRole::FailedAttempts), 0);
+		item->setData(la::avdecc::utils::to_integral(ItemRole::UpdateState), QVariant::fromValue(UpdateState::Queued));
+	}
+
+	_totalUploadedBytes = 0u;
+	_lastSampleUploadedBytes = 0u;
+	_lastSampleTime = 0;
+	_measuredThroughput = 0.0;
+	_elapsedTimer.start();
+	_throughputTimer.start();
+
+	scheduleUploads();
+
+	// The first chunks are already being sent while the image is checksummed
+	computeChecksum();
+}
+
+void FirmwareUploadDialog::computeChecksum() noexcept
+{
+	if (_firmwareChecksum || _isComputingChecksum)
+	{
+		return;
+	}
+	_isComputingChecksum = true;
+
+	QThreadPool::globalInstance()->start(new ChecksumTask{ _firmwareImage,
+		[dialog = QPointer<FirmwareUploadDialog>{ this }](std::uint32_t const checksum)
+		{
+			// The dialog may be destroyed at any time, the pointer is only checked back in the main thread (through the application, which outlives it)
+			QMetaObject::invokeMethod(qApp,
+				[dialog, checksum]()
+				{
+					if (!dialog)
+					{
+						return;
+					}
+					dialog->_firmwareChecksum = checksum;
+					dialog->_isComputingChecksum = false;
+					if (!dialog->_throughputTimer.isActive())
+					{
+						dialog->_ui->statusLabel->setText(dialog->checksumText());
+					}
+				},
+				Qt::QueuedConnection);
+		} });
+}
+
+QString FirmwareUploadDialog::checksumText() const noexcept
+{
+	if (_firmwareChecksum)
+	{
+		return QString("CRC-32: %1").arg(avdecc::helper::toHexQString(*_firmwareChecksum, true, true));
+	}
+	return QString("CRC-32: Computing...");
 }
 
 void FirmwareUploadDialog::on_abortPushButton_clicked()
@@ -416,13 +888,25 @@ void FirmwareUploadDialog::on_abortPushButton_clicked()
 		auto const descriptorIndex = item->data(la::avdecc::utils::to_integral(ItemRole::DescriptorIndex)).value<la::avdecc::entity::model::DescriptorIndex>();
 		auto const entityName = item->data(la::avdecc::utils::to_integral(ItemRole::EntityName)).toString();
 		auto const operationID = item->data(la::avdecc::utils::to_integral(ItemRole::OperationID)).value<la::avdecc::entity::model::OperationID>();
+		auto const state = item->data(la::avdecc::utils::to_integral(ItemRole::UpdateState)).value<UpdateState>();
+
+		// Already done
+		if (state == UpdateState::Complete || state == UpdateState::Failed)
+		{
+			continue;
+		}
 
 		widget->setText(QString("%1: Aborted").arg(entityName));
 		item->setData(la::avdecc::utils::to_integral(ItemRole::UpdateState), QVariant::fromValue(UpdateState::Failed));
-		manager.abortOperation(entityID, la::avdecc::entity::model::DescriptorType::MemoryObject, descriptorIndex, operationID,
-			[](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const /*status*/)
-			{
-			});
+
+		// Only the started operations have to be aborted on the entity
+		if (state == UpdateState::StartUpload || state == UpdateState::Uploading || state == UpdateState::StartStore || state == UpdateState::Storing)
+		{
+			manager.abortOperation(entityID, la::avdecc::entity::model::DescriptorType::MemoryObject, descriptorIndex, operationID,
+				[](la::avdecc::UniqueIdentifier const /*entityID*/, la::avdecc::entity::ControllerEntity::AemCommandStatus const /*status*/)
+				{
+				});
+		}
 	}
 	checkAllDone();
 }
@@ -19,14 +19,23 @@
 
 #pragma once
 
+#include "avdecc/controllerManager.hpp"
+
 #include <la/avdecc/avdecc.hpp>
 #include <la/avdecc/controller/avdeccController.hpp>
 
 #include <vector>
+#include <optional>
 #include <tuple>
+#include <unordered_set>
 
 #include <QDialog>
 #include <QString>
+#include <QFile>
+#include <QTimer>
+#include <QElapsedTimer>
+
+class QListWidgetItem;
 
 namespace Ui
 {
@@ -39,9 +48,12 @@ class FirmwareUploadDialog : public QDialog
 
 public:
 	using EntityInfo = std::tuple<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::DescriptorIndex, std::uint64_t>;
-	explicit FirmwareUploadDialog(la::avdecc::controller::Controller::DeviceMemoryBuffer&& firmwareData, QString const& name, std::vector<EntityInfo> entitiesToUpdate, QWidget* parent = nullptr);
+	explicit FirmwareUploadDialog(avdecc::ControllerManager::SharedMemoryImage const& firmwareImage, QString const& name, std::vector<EntityInfo> entitiesToUpdate, QWidget* parent = nullptr);
 	~FirmwareUploadDialog();
 
+	/** Loads an opened firmware file as a read-only image shared by all the uploads (backed by a mapping of the file when possible, read once in memory otherwise). Returns an empty image on failure. */
+	static avdecc::ControllerManager::SharedMemoryImage readFirmwareFile(QFile& file) noexcept;
+
 private:
 	enum class ItemRole
 	{
@@ -51,12 +63,22 @@ private:
 		EntityName,
 		OperationID,
 		UpdateState,
+		Attempt, // Incremented each time the upload is started, to discard the results of a previous attempt
+		FailedAttempts,
+		UploadedBytes,
+		UploadStartTime, // Time of the start of the current attempt (in msec since the start of the scheduler)
 	};
 
 	bool areAllDone() const noexcept;
 	void checkAllDone() noexcept;
 	std::tuple<size_t, size_t, size_t> getCounts() const noexcept;
 	void scheduleUpload(EntityInfo const& entityInfo) noexcept;
+	void scheduleUploads() noexcept;
+	void startUpload(QListWidgetItem* const item) noexcept;
+	void uploadFailed(QListWidgetItem* const item, QString const& reason) noexcept;
+	void updateThroughput() noexcept;
+	void computeChecksum() noexcept;
+	QString checksumText() const noexcept;
 	virtual void closeEvent(QCloseEvent* event) override;
 	virtual void reject() override;
 
@@ -65,5 +87,16 @@ private:
 
 private:
 	Ui::FirmwareUploadDialog* _ui{ nullptr };
-	la::avdecc::controller::Controller::DeviceMemoryBuffer _firmwareData{};
+	avdecc::ControllerManager::SharedMemoryImage _firmwareImage{};
+	std::optional<std::uint32_t> _firmwareChecksum{}; // CRC-32 of the image, computed in the background when the uploads start
+	bool _isComputingChecksum{ false };
+	std::unordered_set<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash> _offlineEntities{};
+	QTimer _throughputTimer{};
+	QElapsedTimer _elapsedTimer{};
+	size_t _maxParallelUploads{ 1u };
+	std::uint64_t _maxUploadBandwidth{ 0u }; // In bytes per second, 0 meaning unlimited
+	std::uint64_t _totalUploadedBytes{ 0u }; // Sent by all the uploads (including the failed attempts)
+	std::uint64_t _lastSampleUploadedBytes{ 0u };
+	qint64 _lastSampleTime{ 0 };
+	double _measuredThroughput{ 0.0 }; // In bytes per second, smoothed over the last samples
 };
@@ -0,0 +1,184 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "frameScheduler.hpp"
+#include "avdecc/spanTrace.hpp"
+
+#include <QGuiApplication>
+#include <QScreen>
+#include <QTimer>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+static constexpr auto DefaultRefreshRate = 60.0; // When the refresh rate of the screen is unknown
+
+class FrameSchedulerImpl final : public FrameScheduler
+{
+public:
+	FrameSchedulerImpl() noexcept
+	{
+		_frameTimer.setTimerType(Qt::PreciseTimer);
+		connect(&_frameTimer, &QTimer::timeout, this, &FrameSchedulerImpl::runFrame);
+	}
+
+	// Deleted compiler auto-generated methods
+	FrameSchedulerImpl(FrameSchedulerImpl const&) = delete;
+	FrameSchedulerImpl(FrameSchedulerImpl&&) = delete;
+	FrameSchedulerImpl& operator=(FrameSchedulerImpl const&) = delete;
+	FrameSchedulerImpl& operator=(FrameSchedulerImpl&&) = delete;
+
+private:
+	struct Client
+	{
+		Order order{ Order::ControllerModel };
+		Flush flush{};
+		Clock::duration minimumPeriod{};
+		Clock::time_point lastFlushTime{};
+		bool isDirty{ false };
+	};
+
+	// FrameScheduler overrides
+	virtual ClientID registerClient(Order const order, Flush&& flush, std::chrono::milliseconds const minimumPeriod) noexcept override
+	{
+		auto const clientID = ++_lastClientID;
+		_clients.emplace(clientID, Client{ order, std::move(flush), minimumPeriod });
+
+		// Keep the clients sorted by order, then by registration
+		auto const it = std::upper_bound(_orderedClients.begin(), _orderedClients.end(), order,
+			[this](Order const clientOrder, ClientID const otherClientID)
+			{
+				return clientOrder < _clients.at(otherClientID).order;
+			});
+		_orderedClients.insert(it, clientID);
+
+		return clientID;
+	}
+
+	virtual void unregisterClient(ClientID const clientID) noexcept override
+	{
+		_clients.erase(clientID);
+		_orderedClients.erase(std::remove(_orderedClients.begin(), _orderedClients.end(), clientID), _orderedClients.end());
+	}
+
+	virtual void requestFlush(ClientID const clientID) noexcept override
+	{
+		auto const it = _clients.find(clientID);
+		if (it == _clients.end())
+		{
+			return;
+		}
+
+		it->second.isDirty = true;
+		if (!_frameTimer.isActive())
+		{
+			// Frames are only paced while a client is dirty, following the refresh rate of the screen at that time
+			_frameTimer.setInterval(framePeriod());
+			_frameTimer.start();
+		}
+	}
+
+	// Private methods
+	static int framePeriod() noexcept
+	{
+		auto refreshRate = DefaultRefreshRate;
+		if (auto const* const screen = QGuiApplication::primaryScreen())
+		{
+			if (screen->refreshRate() > 1.0)
+			{
+				refreshRate = screen->refreshRate();
+			}
+		}
+		return std::max(1, static_cast<int>(1000.0 / refreshRate));
+	}
+
+	void runFrame() noexcept
+	{
+		HIVE_TRACE_SPAN("FrameScheduler::runFrame");
+
+		auto const frameStart = Clock::now();
+		auto const deadline = frameStart + FrameBudget;
+
+		// Resume with the first client not flushed during the previous frame, wrapping around (a client can register or unregister during a flush)
+		auto const orderedClients = _orderedClients;
+		auto const count = orderedClients.size();
+		auto const firstPosition = std::min(_resumePosition, count);
+		_resumePosition = 0u;
+		for (auto offset = size_t{ 0u }; offset < count; ++offset)
+		{
+			auto const position = (firstPosition + offset) % count;
+			auto const it = _clients.find(orderedClients[position]);
+			if (it == _clients.end() || !it->second.isDirty)
+			{
+				continue;
+			}
+
+			auto& client = it->second;
+			if (frameStart - client.lastFlushTime < client.minimumPeriod)
+			{
+				continue;
+			}
+
+			// Budget spent, carry the remaining clients over
+			if (Clock::now() >= deadline)
+			{
+				_resumePosition = position;
+				break;
+			}
+
+			client.isDirty = false;
+			client.lastFlushTime = frameStart;
+			auto const isFlushed = client.flush(deadline);
+
+			// The client might have unregistered during its flush
+			if (auto const flushedIt = _clients.find(orderedClients[position]); !isFlushed && flushedIt != _clients.end())
+			{
+				flushedIt->second.isDirty = true;
+				_resumePosition = position;
+				break;
+			}
+		}
+
+		// Stop pacing once all the clients are flushed (a flush may also have requested another one)
+		auto const isDirtyClientLeft = std::any_of(_clients.begin(), _clients.end(),
+			[](auto const& clientKV)
+			{
+				return clientKV.second.isDirty;
+			});
+		if (!isDirtyClientLeft)
+		{
+			_frameTimer.stop();
+		}
+	}
+
+	// Private members
+	std::map<ClientID, Client> _clients{};
+	std::vector<ClientID> _orderedClients{}; // Sorted by order, then by registration
+	ClientID _lastClientID{ 0u };
+	size_t _resumePosition{ 0u }; // Position in _orderedClients of the first client to flush on the next frame
+	QTimer _frameTimer{};
+};
+
+FrameScheduler& FrameScheduler::getInstance() noexcept
+{
+	static FrameSchedulerImpl s_scheduler{};
+
+	return s_scheduler;
+}
@@ -0,0 +1,68 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QObject>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+/**
+* @brief Paces the notifications of the models (dataChanged, rows insertion) on the display refresh, so the cost of the UI updates is bounded whatever the network activity.
+*		 Clients accumulate their changes and request a flush: on each frame, the dirty clients are flushed in their Order until the FrameBudget is spent.
+*		 A client not reached in a frame (or flushing partially, its Flush returning false) is carried over, the next frame resuming with it.
+*/
+class FrameScheduler : public QObject
+{
+	Q_OBJECT
+public:
+	using Clock = std::chrono::steady_clock;
+	using ClientID = std::uint32_t;
+
+	/** Notifies the changes accumulated by a client, stopping once deadline is reached. Returns true if all the changes were notified, false if some are left for the next frame */
+	using Flush = std::function<bool(Clock::time_point const deadline)>;
+
+	/** Order in which the clients are flushed during a frame */
+	enum class Order
+	{
+		ControllerModel = 0,
+		ConnectionMatrix,
+		DeviceDetails,
+		MediaClock,
+		Counters,
+		Logger,
+	};
+
+	/** Time given to the flushes of a single frame */
+	static constexpr auto FrameBudget = std::chrono::milliseconds{ 6 };
+
+	static FrameScheduler& getInstance() noexcept;
+
+	/** Registers a client, flushed at most once per frame (and at most once per minimumPeriod if not zero). Must be called from the main thread */
+	virtual ClientID registerClient(Order const order, Flush&& flush, std::chrono::milliseconds const minimumPeriod = std::chrono::milliseconds{ 0 }) noexcept = 0;
+	/** Unregisters a client, its pending flush being dropped. Must be called from the main thread */
+	virtual void unregisterClient(ClientID const clientID) noexcept = 0;
+	/** Requests the client to be flushed on the next frame, requests being merged until then. Must be called from the main thread */
+	virtual void requestFlush(ClientID const clientID) noexcept = 0;
+
+protected:
+	FrameScheduler() = default;
+};
@@ -0,0 +1,198 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "gptpDomainsDialog.hpp"
+#include "avdecc/controllerManager.hpp"
+#include "avdecc/helper.hpp"
+#include "toolkit/material/color.hpp"
+
+#include <QVBoxLayout>
+#include <QHeaderView>
+
+#include <set>
+
+enum class Column
+{
+	Name,
+	Identifier,
+	Interfaces,
+	Count,
+};
+
+GptpDomainsDialog::GptpDomainsDialog(QWidget* parent)
+	: QDialog{ parent, Qt::WindowSystemMenuHint | Qt::WindowTitleHint | Qt::WindowCloseButtonHint | Qt::WindowMaximizeButtonHint }
+{
+	setWindowTitle("gPTP Domains");
+	resize(720, 560);
+
+	_treeWidget.setColumnCount(static_cast<int>(Column::Count));
+	_treeWidget.setHeaderLabels({ "Domain / Entity", "Grandmaster / Interface", "Interfaces" });
+	_treeWidget.setSortingEnabled(true);
+	_treeWidget.sortByColumn(static_cast<int>(Column::Name), Qt::AscendingOrder);
+	_treeWidget.header()->setSectionResizeMode(static_cast<int>(Column::Name), QHeaderView::ResizeToContents);
+
+	auto* const layout = new QVBoxLayout{ this };
+	layout->addWidget(&_treeWidget, 1);
+	layout->addWidget(&_statusLabel);
+
+	// Current index, then follow its changes
+	auto& index = avdecc::gptp::GptpDomainIndex::getInstance();
+	for (auto const& domain : index.getDomains())
+	{
+		addDomain(domain);
+		for (auto const& avbInterface : index.getInterfaces(domain))
+		{
+			addInterface(domain, avbInterface);
+		}
+	}
+
+	connect(&index, &avdecc::gptp::GptpDomainIndex::domainAdded, this, &GptpDomainsDialog::addDomain);
+	connect(&index, &avdecc::gptp::GptpDomainIndex::domainRemoved, this, &GptpDomainsDialog::removeDomain);
+	connect(&index, &avdecc::gptp::GptpDomainIndex::interfaceAdded, this, &GptpDomainsDialog::addInterface);
+	connect(&index, &avdecc::gptp::GptpDomainIndex::interfaceRemoved, this, &GptpDomainsDialog::removeInterface);
+	connect(&index, &avdecc::gptp::GptpDomainIndex::splitChanged, this, &GptpDomainsDialog::updateSplitState);
+
+	updateStatus();
+}
+
+void GptpDomainsDialog::addDomain(avdecc::gptp::DomainKey const& domain) noexcept
+{
+	if (_domainItems.count(domain) > 0)
+	{
+		return;
+	}
+
+	auto* const item = new QTreeWidgetItem{ &_treeWidget };
+	item->setText(static_cast<int>(Column::Name), QString{ "Domain %1" }.arg(domain.domainNumber));
+	auto const vendorName = avdecc::helper::getVendorName(domain.grandmasterID);
+	auto const grandmaster = avdecc::helper::uniqueIdentifierToString(domain.grandmasterID);
+	item->setText(static_cast<int>(Column::Identifier), vendorName.isEmpty() ? grandmaster : QString{ "%1 (%2)" }.arg(grandmaster).arg(vendorName));
+	item->setExpanded(true);
+	_domainItems.emplace(domain, item);
+
+	// A new grandmaster for a domain number may split it
+	updateSplitState(domain.domainNumber);
+	updateStatus();
+}
+
+void GptpDomainsDialog::removeDomain(avdecc::gptp::DomainKey const& domain) noexcept
+{
+	auto const it = _domainItems.find(domain);
+	if (it == _domainItems.end())
+	{
+		return;
+	}
+
+	// Interfaces are removed before their domain, only the group item is left
+	delete it->second;
+	_domainItems.erase(it);
+
+	updateSplitState(domain.domainNumber);
+	updateStatus();
+}
+
+void GptpDomainsDialog::addInterface(avdecc::gptp::DomainKey const& domain, avdecc::gptp::InterfaceKey const& avbInterface) noexcept
+{
+	auto const domainIt = _domainItems.find(domain);
+	if (domainIt == _domainItems.end())
+	{
+		return;
+	}
+
+	auto name = avdecc::helper::uniqueIdentifierToString(avbInterface.entityID);
+	if (auto controlledEntity = avdecc::ControllerManager::getInstance().getControlledEntity(avbInterface.entityID))
+	{
+		name = avdecc::helper::smartEntityName(*controlledEntity);
+	}
+
+	auto* const item = new QTreeWidgetItem{ domainIt->second };
+	item->setText(static_cast<int>(Column::Name), name);
+	item->setText(static_cast<int>(Column::Identifier), QString{ "Interface %1" }.arg(avbInterface.avbInterfaceIndex));
+	item->setToolTip(static_cast<int>(Column::Name), avdecc::helper::uniqueIdentifierToString(avbInterface.entityID));
+	_interfaceItems[avbInterface] = item;
+
+	updateDomainItem(domain);
+}
+
+void GptpDomainsDialog::removeInterface(avdecc::gptp::DomainKey const& domain, avdecc::gptp::InterfaceKey const& avbInterface) noexcept
+{
+	auto const it = _interfaceItems.find(avbInterface);
+	if (it == _interfaceItems.end())
+	{
+		return;
+	}
+
+	delete it->second;
+	_interfaceItems.erase(it);
+
+	updateDomainItem(domain);
+}
+
+void GptpDomainsDialog::updateDomainItem(avdecc::gptp::DomainKey const& domain) noexcept
+{
+	auto const it = _domainItems.find(domain);
+	if (it != _domainItems.end())
+	{
+		it->second->setData(static_cast<int>(Column::Interfaces), Qt::DisplayRole, it->second->childCount());
+	}
+}
+
+void GptpDomainsDialog::updateSplitState(std::uint8_t const domainNumber) noexcept
+{
+	auto const& index = avdecc::gptp::GptpDomainIndex::getInstance();
+	auto const isSplit = index.isSplit(domainNumber);
+	auto const toolTip = isSplit ? QString{ "Domain %1 is split between %2 grandmasters" }.arg(domainNumber).arg(index.getGrandmastersCount(domainNumber)) : QString{};
+	auto const color = isSplit ? qt::toolkit::material::color::foregroundErrorColorValue(qt::toolkit::material::color::DefaultColor, qt::toolkit::material::color::DefaultShade) : QColor{};
+
+	for (auto const& [domain, item] : _domainItems)
+	{
+		if (domain.domainNumber != domainNumber)
+		{
+			continue;
+		}
+
+		auto font = item->font(static_cast<int>(Column::Name));
+		font.setBold(isSplit);
+		for (auto column = 0; column < static_cast<int>(Column::Count); ++column)
+		{
+			item->setFont(column, font);
+			item->setForeground(column, isSplit ? QBrush{ color } : QBrush{});
+			item->setToolTip(column, toolTip);
+		}
+	}
+
+	updateStatus();
+}
+
+void GptpDomainsDialog::updateStatus() noexcept
+{
+	auto domainNumbers = std::set<std::uint8_t>{};
+	auto splitDomains = std::set<std::uint8_t>{};
+	auto const& index = avdecc::gptp::GptpDomainIndex::getInstance();
+	for (auto const& domainKV : _domainItems)
+	{
+		auto const domainNumber = domainKV.first.domainNumber;
+		domainNumbers.insert(domainNumber);
+		if (index.isSplit(domainNumber))
+		{
+			splitDomains.insert(domainNumber);
+		}
+	}
+
+	_statusLabel.setText(QString{ "%1 domain(s), %2 grandmaster(s), %3 split domain(s)" }.arg(domainNumbers.size()).arg(_domainItems.size()).arg(splitDomains.size()));
+}
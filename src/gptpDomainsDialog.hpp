@@ -0,0 +1,57 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QDialog>
+#include <QLabel>
+#include <QTreeWidget>
+
+#include "avdecc/gptpDomainIndex.hpp"
+
+#include <unordered_map>
+
+/** Overview of the AVB interfaces grouped by gPTP grandmaster and domain, split domains (several grandmasters for a domain number) being highlighted */
+class GptpDomainsDialog : public QDialog
+{
+	Q_OBJECT
+
+public:
+	GptpDomainsDialog(QWidget* parent = nullptr);
+
+	// Deleted compiler auto-generated methods
+	GptpDomainsDialog(GptpDomainsDialog&&) = delete;
+	GptpDomainsDialog(GptpDomainsDialog const&) = delete;
+	GptpDomainsDialog& operator=(GptpDomainsDialog const&) = delete;
+	GptpDomainsDialog& operator=(GptpDomainsDialog&&) = delete;
+
+private:
+	void addDomain(avdecc::gptp::DomainKey const& domain) noexcept;
+	void removeDomain(avdecc::gptp::DomainKey const& domain) noexcept;
+	void addInterface(avdecc::gptp::DomainKey const& domain, avdecc::gptp::InterfaceKey const& avbInterface) noexcept;
+	void removeInterface(avdecc::gptp::DomainKey const& domain, avdecc::gptp::InterfaceKey const& avbInterface) noexcept;
+	void updateDomainItem(avdecc::gptp::DomainKey const& domain) noexcept;
+	void updateSplitState(std::uint8_t const domainNumber) noexcept;
+	void updateStatus() noexcept;
+
+	QTreeWidget _treeWidget{ this };
+	QLabel _statusLabel{ this };
+
+	std::unordered_map<avdecc::gptp::DomainKey, QTreeWidgetItem*, avdecc::gptp::DomainKey::hash> _domainItems{};
+	std::unordered_map<avdecc::gptp::InterfaceKey, QTreeWidgetItem*, avdecc::gptp::InterfaceKey::hash> _interfaceItems{};
+};
@@ -27,6 +27,14 @@ void ImageItemDelegate::paint(QPainter* painter, QStyleOptionViewItem const& opt
 	QStyledItemDelegate::paint(painter, option, index);
 
 	auto const userData{ index.data(ImageRole) };
+
+	// Pixmaps are usually pre-scaled thumbnails, draw them directly
+	if (userData.userType() == QMetaType::QPixmap)
+	{
+		painterHelper::drawCentered(painter, option.rect, userData.value<QPixmap>());
+		return;
+	}
+
 	if (!userData.canConvert<QImage>())
 	{
 		return;
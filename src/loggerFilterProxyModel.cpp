@@ -0,0 +1,120 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "loggerFilterProxyModel.hpp"
+#include "avdecc/logGate.hpp"
+
+#include <algorithm>
+
+LoggerFilterProxyModel::LoggerFilterProxyModel(QObject* parent)
+	: QSortFilterProxyModel{ parent }
+{
+}
+
+LoggerFilterProxyModel::Mask LoggerFilterProxyModel::layerBit(la::avdecc::logger::Layer const layer) noexcept
+{
+	// Same bits than the log gate, so a mask can drive both
+	return avdecc::logger::LogGate::layerBit(layer);
+}
+
+LoggerFilterProxyModel::Mask LoggerFilterProxyModel::levelBit(la::avdecc::logger::Level const level) noexcept
+{
+	return avdecc::logger::LogGate::levelBit(level);
+}
+
+void LoggerFilterProxyModel::setLayerMask(Mask const mask) noexcept
+{
+	if (mask != _layerMask)
+	{
+		_layerMask = mask;
+		invalidateFilter();
+	}
+}
+
+void LoggerFilterProxyModel::setLevelMask(Mask const mask) noexcept
+{
+	if (mask != _levelMask)
+	{
+		_levelMask = mask;
+		invalidateFilter();
+	}
+}
+
+void LoggerFilterProxyModel::setSearchExpression(qt::toolkit::FilterExpression const& expression) noexcept
+{
+	if (expression == _searchExpression)
+	{
+		return;
+	}
+
+	_searchExpression = expression;
+
+	// Plain text lookup in the index, so the rows which cannot match are rejected without reading their message (a prefix is first looked up as plain text)
+	_searchCandidates.reset();
+	if (_searchExpression.isPlainText())
+	{
+		if (auto* const loggerModel = qobject_cast<avdecc::LoggerModel*>(sourceModel()))
+		{
+			auto candidates = avdecc::LoggerModel::SearchCandidates{};
+			if (loggerModel->findSearchCandidates(_searchExpression.text(), candidates))
+			{
+				_searchCandidates = std::move(candidates);
+			}
+		}
+	}
+
+	invalidateFilter();
+}
+
+bool LoggerFilterProxyModel::filterAcceptsRow(int sourceRow, QModelIndex const& sourceParent) const
+{
+	auto const* const model = sourceModel();
+
+	// Cheap tests first, on the raw enum values
+	auto const layer = model->index(sourceRow, 0, sourceParent).data(avdecc::LoggerModel::LayerRole).value<la::avdecc::logger::Layer>();
+	if ((_layerMask & layerBit(layer)) == 0u)
+	{
+		return false;
+	}
+
+	auto const level = model->index(sourceRow, 0, sourceParent).data(avdecc::LoggerModel::LevelRole).value<la::avdecc::logger::Level>();
+	if ((_levelMask & levelBit(level)) == 0u)
+	{
+		return false;
+	}
+
+	// Then the message search
+	if (_searchExpression.isEmpty())
+	{
+		return true;
+	}
+
+	if (_searchCandidates)
+	{
+		// Rows inserted after the lookup are not part of the candidates, they are checked directly
+		auto const sequence = static_cast<quint64>(model->index(sourceRow, 0, sourceParent).data(avdecc::LoggerModel::SequenceRole).toULongLong());
+		if (sequence < _searchCandidates->endSequence && !std::binary_search(_searchCandidates->sequences.begin(), _searchCandidates->sequences.end(), sequence))
+		{
+			return false;
+		}
+	}
+
+	auto const message = model->index(sourceRow, 3, sourceParent).data().toString();
+	return _searchExpression.matches(message);
+}
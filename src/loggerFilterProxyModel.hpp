@@ -0,0 +1,65 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "avdecc/loggerModel.hpp"
+#include "toolkit/filterExpression.hpp"
+
+#include <la/avdecc/logger.hpp>
+
+#include <QSortFilterProxyModel>
+#include <QString>
+
+#include <optional>
+
+// Model that filters an underlying avdecc::LoggerModel on layer, level and message, in a single pass
+class LoggerFilterProxyModel : public QSortFilterProxyModel
+{
+public:
+	using Mask = quint64;
+	static constexpr Mask AllMask = ~Mask{ 0u };
+
+	LoggerFilterProxyModel(QObject* parent = nullptr);
+
+	// Returns the bit representing the specified layer in a layer mask (all user layers share the same bit)
+	static Mask layerBit(la::avdecc::logger::Layer const layer) noexcept;
+
+	// Returns the bit representing the specified level in a level mask
+	static Mask levelBit(la::avdecc::logger::Level const level) noexcept;
+
+	// Set the layers to be displayed, as a combination of layerBit()
+	void setLayerMask(Mask const mask) noexcept;
+
+	// Set the levels to be displayed, as a combination of levelBit()
+	void setLevelMask(Mask const mask) noexcept;
+
+	// Set the (case insensitive) message search expression.
+	// Plain text expressions (literal or prefix) are first looked up in the search index of the avdecc::LoggerModel, only the candidate messages being checked.
+	void setSearchExpression(qt::toolkit::FilterExpression const& expression) noexcept;
+
+private:
+	virtual bool filterAcceptsRow(int sourceRow, QModelIndex const& sourceParent) const override;
+
+private:
+	Mask _layerMask{ AllMask };
+	Mask _levelMask{ AllMask };
+	qt::toolkit::FilterExpression _searchExpression{};
+	std::optional<avdecc::LoggerModel::SearchCandidates> _searchCandidates{};
+};
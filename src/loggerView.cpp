@@ -19,12 +19,16 @@
 
 #include "loggerView.hpp"
 #include "avdecc/helper.hpp"
+#include "avdecc/logGate.hpp"
 
 #include <QScrollBar>
+#include <QHeaderView>
+#include <QTimer>
 #include <QFileDialog>
 #include <QStandardPaths>
 #include <QShortcut>
 #include <QMessageBox>
+#include <QProgressDialog>
 
 class AutoScrollBar : public QScrollBar
 {
@@ -39,20 +43,47 @@ public:
 	{
 		_bufferedMaximum = maximum();
 
+		// Following the end is applied at most once per frame, whatever the count of range changes in between
+		_scrollTimer.setSingleShot(true);
+		_scrollTimer.setInterval(ScrollPeriod);
+		connect(&_scrollTimer, &QTimer::timeout, this,
+			[this]()
+			{
+				_isScrollPending = false;
+				setValue(maximum());
+			});
+
 		connect(this, &QScrollBar::rangeChanged, this,
 			[this](int, int max)
 			{
-				if (value() == _bufferedMaximum)
+				// Still following the end if it was at the previous maximum, or if a scroll is already pending
+				if (_isScrollPending || value() == _bufferedMaximum)
 				{
-					setValue(max);
+					_isScrollPending = true;
+					if (!_scrollTimer.isActive())
+					{
+						_scrollTimer.start();
+					}
 				}
 
 				_bufferedMaximum = max;
 			});
+
+		// The user moving the slider away from the end cancels the pending scroll
+		connect(this, &QScrollBar::sliderPressed, this,
+			[this]()
+			{
+				_isScrollPending = false;
+				_scrollTimer.stop();
+			});
 	}
 
 private:
+	static constexpr auto ScrollPeriod = 16; // Milliseconds, about one frame
+
+	QTimer _scrollTimer{};
 	int _bufferedMaximum{ 0 };
+	bool _isScrollPending{ false };
 };
 
 const std::vector<la::avdecc::logger::Layer> loggerLayers{
@@ -79,19 +110,24 @@ LoggerView::LoggerView(QWidget* parent)
 {
 	setupUi(this);
 
-	auto* logger = &la::avdecc::logger::Logger::getInstance();
-
-#ifndef NDEBUG
-	logger->setLevel(la::avdecc::logger::Level::Trace);
-#else
-	logger->setLevel(la::avdecc::logger::Level::Info);
-#endif
+	// The selected levels and layers gate the messages at their source (the la_avdecc Logger level being set accordingly)
+	auto& logGate = avdecc::logger::LogGate::getInstance();
+	logGate.setLevelMask(avdecc::logger::LogGate::AllMask);
+	logGate.setLayerMask(avdecc::logger::LogGate::AllMask);
 
+	// The model only inserts the logged entries while the view is shown
+	_loggerModel.setActive(false);
 	tableView->setModel(&_loggerModel);
 	tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
 	tableView->setSelectionMode(QAbstractItemView::SingleSelection);
 	tableView->setVerticalScrollBar(new AutoScrollBar{ Qt::Vertical, this });
 
+	// Single line entries: fixed uniform row heights, so inserting rows never measures their content
+	tableView->setWordWrap(false);
+	auto* const verticalHeader = tableView->verticalHeader();
+	verticalHeader->setSectionResizeMode(QHeaderView::Fixed);
+	verticalHeader->setDefaultSectionSize(fontMetrics().height() + 4);
+
 	_dynamicHeaderView.setHighlightSections(false);
 	_dynamicHeaderView.setStretchLastSection(true);
 	_dynamicHeaderView.setMandatorySection(3);
@@ -102,10 +138,8 @@ LoggerView::LoggerView(QWidget* parent)
 	tableView->setColumnWidth(1, 120);
 	tableView->setColumnWidth(2, 90);
 
-	_layerFilterProxyModel.setSourceModel(&_loggerModel);
-	_levelFilterProxyModel.setSourceModel(&_layerFilterProxyModel);
-	_searchFilterProxyModel.setSourceModel(&_levelFilterProxyModel);
-	tableView->setModel(&_searchFilterProxyModel);
+	_filterProxyModel.setSourceModel(&_loggerModel);
+	tableView->setModel(&_filterProxyModel);
 
 	connect(actionClear, &QAction::triggered, this,
 		[this]
@@ -119,9 +153,9 @@ LoggerView::LoggerView(QWidget* parent)
 	connect(actionSave, &QAction::triggered, this,
 		[this]()
 		{
-			auto search = QRegExp{ searchLineEdit->text() };
-			auto level = _levelFilterProxyModel.filterRegExp();
-			auto layer = _layerFilterProxyModel.filterRegExp();
+			auto search = qt::toolkit::FilterExpression::compile(searchLineEdit->text());
+			auto level = filterMenuExpression(_levelFilterMenu);
+			auto layer = filterMenuExpression(_layerFilterMenu);
 
 			// Check if a filter is applied
 			if (!search.isEmpty() || !level.isEmpty() || !layer.isEmpty())
@@ -134,25 +168,48 @@ LoggerView::LoggerView(QWidget* parent)
 				}
 			}
 
-			// Make sure all our RegExp are CaseInsensitive
-			search.setCaseSensitivity(Qt::CaseInsensitive);
-			level.setCaseSensitivity(Qt::CaseInsensitive);
-			layer.setCaseSensitivity(Qt::CaseInsensitive);
-
-			auto const filename = QFileDialog::getSaveFileName(this, "Save As...", QString("%1/%2.txt").arg(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)).arg(qAppName()), "*.txt");
+			auto const filename = QFileDialog::getSaveFileName(this, "Save As...", QString("%1/%2.txt").arg(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)).arg(qAppName()), "Text files (*.txt);;Compressed text files (*.txt.gz);;JSON lines files (*.jsonl);;Compressed JSON lines files (*.jsonl.gz)");
 			if (!filename.isEmpty())
 			{
-				_loggerModel.save(filename, { search, level, layer });
+				auto const compress = filename.endsWith(".gz", Qt::CaseInsensitive);
+				auto const isJsonLines = filename.endsWith(".jsonl", Qt::CaseInsensitive) || filename.endsWith(".jsonl.gz", Qt::CaseInsensitive);
+				auto const format = isJsonLines ? avdecc::LoggerModel::SaveFormat::JsonLines : avdecc::LoggerModel::SaveFormat::Text;
+				if (!_loggerModel.save(filename, { search, level, layer, compress, format }))
+				{
+					QMessageBox::warning(this, {}, "The log is already being saved, please wait for the current save to complete.");
+					return;
+				}
+
+				// The log is saved in background, display its progress
+				auto* progressDialog = new QProgressDialog{ "Saving log...", "Cancel", 0, 100, this };
+				progressDialog->setAutoClose(false);
+				progressDialog->setMinimumDuration(500);
+				progressDialog->setValue(0);
+
+				connect(progressDialog, &QProgressDialog::canceled, &_loggerModel, &avdecc::LoggerModel::cancelSave);
+				connect(&_loggerModel, &avdecc::LoggerModel::saveProgress, progressDialog, &QProgressDialog::setValue);
+				connect(&_loggerModel, &avdecc::LoggerModel::saveCompleted, progressDialog,
+					[this, progressDialog](QString const& filename, bool const success)
+					{
+						auto const wasCanceled = progressDialog->wasCanceled();
+						progressDialog->deleteLater();
+
+						if (!success && !wasCanceled)
+						{
+							QMessageBox::warning(this, {}, QString("Failed to save the log to %1").arg(filename));
+						}
+					});
 			}
 		});
 
+	// The search is applied once the typing paused, or immediately when requested
+	connect(searchLineEdit, &QLineEdit::textChanged, &_searchDebouncer, &qt::toolkit::FilterExpressionDebouncer::setPattern);
+	connect(&_searchDebouncer, &qt::toolkit::FilterExpressionDebouncer::expressionChanged, &_filterProxyModel, &LoggerFilterProxyModel::setSearchExpression);
 	connect(actionSearch, &QAction::triggered, this,
 		[this]()
 		{
-			auto const pattern = searchLineEdit->text();
-			_searchFilterProxyModel.setFilterKeyColumn(3);
-			_searchFilterProxyModel.setFilterRegExp(pattern);
-			_searchFilterProxyModel.setFilterCaseSensitivity(Qt::CaseInsensitive);
+			_searchDebouncer.setPattern(searchLineEdit->text());
+			_searchDebouncer.flush();
 		});
 
 	auto* searchShortcut = new QShortcut{ QKeySequence::Replace, this };
@@ -175,11 +232,24 @@ qt::toolkit::DynamicHeaderView* LoggerView::header() const
 	return const_cast<qt::toolkit::DynamicHeaderView*>(&_dynamicHeaderView);
 }
 
+void LoggerView::showEvent(QShowEvent* event)
+{
+	QWidget::showEvent(event);
+	_loggerModel.setActive(true);
+}
+
+void LoggerView::hideEvent(QHideEvent* event)
+{
+	QWidget::hideEvent(event);
+	_loggerModel.setActive(false);
+}
+
 void LoggerView::createLayerFilterButton()
 {
 	for (auto const& layer : loggerLayers)
 	{
 		auto* action = _layerFilterMenu.addAction(avdecc::helper::loggerLayerToString(layer));
+		action->setData(QVariant::fromValue(LoggerFilterProxyModel::layerBit(layer)));
 		action->setCheckable(true);
 		action->setChecked(true);
 	}
@@ -193,39 +263,12 @@ void LoggerView::createLayerFilterButton()
 	connect(&_layerFilterMenu, &QMenu::triggered, this,
 		[this](QAction* action)
 		{
-			// All & None are non checkable
-			if (!action->isCheckable())
-			{
-				auto const checked = action->text() == "All";
-
-				QSignalBlocker lock(&_layerFilterMenu);
-				for (auto* a : _layerFilterMenu.actions())
-				{
-					if (a->isCheckable())
-					{
-						a->setChecked(checked);
-					}
-				}
-			}
-
-			QStringList layerList;
-			for (auto* a : _layerFilterMenu.actions())
-			{
-				if (a->isCheckable() && a->isChecked())
-				{
-					layerList << a->text();
-				}
-			}
-
-			if (layerList.empty())
-			{
-				// Invalid filter
-				layerList << "---";
-			}
+			updateFilterMenu(_layerFilterMenu, action);
 
 			// Update the filter
-			_layerFilterProxyModel.setFilterKeyColumn(1);
-			_layerFilterProxyModel.setFilterRegExp(layerList.join('|'));
+			auto const mask = filterMenuMask(_layerFilterMenu);
+			_filterProxyModel.setLayerMask(mask);
+			avdecc::logger::LogGate::getInstance().setLayerMask(mask);
 		});
 }
 
@@ -234,6 +277,7 @@ void LoggerView::createLevelFilterButton()
 	for (auto const& level : loggerLevels)
 	{
 		auto* action = _levelFilterMenu.addAction(avdecc::helper::loggerLevelToString(level));
+		action->setData(QVariant::fromValue(LoggerFilterProxyModel::levelBit(level)));
 		action->setCheckable(true);
 		action->setChecked(true);
 	}
@@ -247,38 +291,76 @@ void LoggerView::createLevelFilterButton()
 	connect(&_levelFilterMenu, &QMenu::triggered, this,
 		[this](QAction* action)
 		{
-			// All & None are non checkable
-			if (!action->isCheckable())
-			{
-				auto const checked = action->text() == "All";
+			updateFilterMenu(_levelFilterMenu, action);
 
-				QSignalBlocker lock(&_levelFilterMenu);
-				for (auto* a : _levelFilterMenu.actions())
-				{
-					if (a->isCheckable())
-					{
-						a->setChecked(checked);
-					}
-				}
-			}
+			// Update the filter
+			auto const mask = filterMenuMask(_levelFilterMenu);
+			_filterProxyModel.setLevelMask(mask);
+			avdecc::logger::LogGate::getInstance().setLevelMask(mask);
+		});
+}
 
-			QStringList levelList;
-			for (auto* a : _levelFilterMenu.actions())
+void LoggerView::updateFilterMenu(qt::toolkit::TickableMenu& menu, QAction* const triggeredAction) noexcept
+{
+	// All & None are non checkable
+	if (!triggeredAction->isCheckable())
+	{
+		auto const checked = triggeredAction->text() == "All";
+
+		QSignalBlocker lock(&menu);
+		for (auto* a : menu.actions())
+		{
+			if (a->isCheckable())
 			{
-				if (a->isCheckable() && a->isChecked())
-				{
-					levelList << a->text();
-				}
+				a->setChecked(checked);
 			}
+		}
+	}
+}
 
-			if (levelList.empty())
+LoggerFilterProxyModel::Mask LoggerView::filterMenuMask(qt::toolkit::TickableMenu const& menu) noexcept
+{
+	auto mask = LoggerFilterProxyModel::Mask{ 0u };
+	for (auto* a : menu.actions())
+	{
+		if (a->isCheckable() && a->isChecked())
+		{
+			mask |= a->data().value<LoggerFilterProxyModel::Mask>();
+		}
+	}
+	return mask;
+}
+
+qt::toolkit::FilterExpression LoggerView::filterMenuExpression(qt::toolkit::TickableMenu const& menu) noexcept
+{
+	QStringList list;
+	auto allChecked = true;
+	for (auto* a : menu.actions())
+	{
+		if (a->isCheckable())
+		{
+			if (a->isChecked())
+			{
+				list << a->text();
+			}
+			else
 			{
-				// Invalid filter
-				levelList << "---";
+				allChecked = false;
 			}
+		}
+	}
 
-			// Update the filter
-			_levelFilterProxyModel.setFilterKeyColumn(2);
-			_levelFilterProxyModel.setFilterRegExp(levelList.join('|'));
-		});
+	// No filter
+	if (allChecked)
+	{
+		return {};
+	}
+
+	if (list.empty())
+	{
+		// Invalid filter
+		list << "---";
+	}
+
+	return qt::toolkit::FilterExpression::anyOf(list);
 }
@@ -21,10 +21,10 @@
 
 #include "ui_loggerView.h"
 #include "avdecc/loggerModel.hpp"
+#include "loggerFilterProxyModel.hpp"
 #include "toolkit/dynamicHeaderView.hpp"
 #include "toolkit/tickableMenu.hpp"
-
-#include <QSortFilterProxyModel>
+#include "toolkit/filterExpression.hpp"
 
 class LoggerView : public QWidget, private Ui::LoggerView
 {
@@ -34,15 +34,21 @@ public:
 	qt::toolkit::DynamicHeaderView* header() const;
 
 private:
+	// QWidget overrides
+	virtual void showEvent(QShowEvent* event) override;
+	virtual void hideEvent(QHideEvent* event) override;
+
 	void createLayerFilterButton();
 	void createLevelFilterButton();
+	static void updateFilterMenu(qt::toolkit::TickableMenu& menu, QAction* const triggeredAction) noexcept;
+	static LoggerFilterProxyModel::Mask filterMenuMask(qt::toolkit::TickableMenu const& menu) noexcept;
+	static qt::toolkit::FilterExpression filterMenuExpression(qt::toolkit::TickableMenu const& menu) noexcept;
 
 private:
 	avdecc::LoggerModel _loggerModel{ this };
-	QSortFilterProxyModel _layerFilterProxyModel{ this };
-	QSortFilterProxyModel _levelFilterProxyModel{ this };
-	QSortFilterProxyModel _searchFilterProxyModel{ this };
+	LoggerFilterProxyModel _filterProxyModel{ this };
 	qt::toolkit::DynamicHeaderView _dynamicHeaderView{ Qt::Horizontal, this };
 	qt::toolkit::TickableMenu _layerFilterMenu{ this };
 	qt::toolkit::TickableMenu _levelFilterMenu{ this };
+	qt::toolkit::FilterExpressionDebouncer _searchDebouncer{ this };
 };
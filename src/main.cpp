@@ -27,23 +27,23 @@
 #include <QFile>
 #include <QSplashScreen>
 #include <QDesktopWidget>
+#include <QCommandLineParser>
 
 #include <iostream>
 #include <chrono>
+#include <memory>
 
 #include "mainWindow.hpp"
-#include "sparkleHelper/sparkleHelper.hpp"
+#include "startupProfiler.hpp"
+#include "styleSheetCache.hpp"
+#include "mainThreadWatchdog.hpp"
+#include "dispatchProfiler.hpp"
 #include "avdecc/controllerManager.hpp"
+#include "avdecc/hiveLogItems.hpp"
 #include "internals/config.hpp"
 #include "settingsManager/settings.hpp"
 #include "profiles/profileSelectionDialog.hpp"
 
-#ifdef DEBUG
-#	define SPLASH_DELAY 0
-#else // !DEBUG
-#	define SPLASH_DELAY 1250
-#endif // DEBUG
-
 static QtMessageHandler previousHandler = nullptr;
 static void qtMessageHandler(QtMsgType msgType, QMessageLogContext const& logContext, QString const& message)
 {
@@ -74,6 +74,29 @@ void setupBugReporter()
 void setupBugReporter() {}
 #endif
 
+/** Application hooking the dispatch of queued slot calls, for the DispatchProfiler */
+class HiveApplication final : public QApplication
+{
+public:
+	using QApplication::QApplication;
+
+	virtual bool notify(QObject* receiver, QEvent* event) override
+	{
+		auto& profiler = DispatchProfiler::getInstance();
+		if (!profiler.isEnabled() || event->type() != QEvent::MetaCall)
+		{
+			return QApplication::notify(receiver, event);
+		}
+
+		// Get the class name now, the receiver might be destroyed by the slot
+		auto const* const className = receiver->metaObject()->className();
+		auto const start = std::chrono::steady_clock::now();
+		auto const result = QApplication::notify(receiver, event);
+		profiler.addQueuedCall(className, std::chrono::steady_clock::now() - start);
+		return result;
+	}
+};
+
 int main(int argc, char* argv[])
 {
 	// Setup Bug Reporter
@@ -93,7 +116,22 @@ int main(int argc, char* argv[])
 	QCoreApplication::setApplicationVersion(hive::internals::versionString);
 
 	// Create the Qt Application
-	QApplication app(argc, argv);
+	HiveApplication app(argc, argv);
+
+	// Startup phases are measured from here
+	auto& startupProfiler = StartupProfiler::getInstance();
+
+	// Parse command line, ignoring unknown options (some platforms add their own)
+	{
+		auto parser = QCommandLineParser{};
+		auto const startupReportOption = QCommandLineOption{ "startup-report", "Write the startup and enumeration timings as JSON to <file>.", "file" };
+		parser.addOption(startupReportOption);
+		parser.parse(app.arguments());
+		if (parser.isSet(startupReportOption))
+		{
+			startupProfiler.setReportFile(parser.value(startupReportOption));
+		}
+	}
 
 	// Runtime sanity check on Avdecc Library compilation options
 	{
@@ -124,6 +162,7 @@ int main(int argc, char* argv[])
 #endif
 
 	// Register settings (creating default value if none was saved before)
+	auto settingsPhase = std::make_unique<StartupProfiler::ScopedPhase>("settings");
 	auto& settings = settings::SettingsManager::getInstance();
 
 	// General
@@ -132,6 +171,7 @@ int main(int argc, char* argv[])
 	settings.registerSetting(settings::General_AutomaticCheckForUpdates);
 	settings.registerSetting(settings::General_CheckForBetaVersions);
 	settings.registerSetting(settings::General_ThemeColorIndex);
+	settings.registerSetting(settings::General_CountersRefreshPeriod);
 
 	// Connection matrix
 	settings.registerSetting(settings::ConnectionMatrix_Transpose);
@@ -147,8 +187,17 @@ int main(int argc, char* argv[])
 	// Controller
 	settings.registerSetting(settings::Controller_AemCacheEnabled);
 	settings.registerSetting(settings::Controller_FullStaticModelEnabled);
+	settings.registerSetting(settings::Controller_FirmwareMaxParallelUploads);
+	settings.registerSetting(settings::Controller_FirmwareMaxUploadBandwidth);
+	settings.registerSetting(settings::Controller_OfflineGracePeriod);
+	settings.registerSetting(settings::Controller_VisibilityDrivenNotifications);
+	settings.registerSetting(settings::Controller_WatchedEntities);
+	settings.registerSetting(settings::Controller_SharedAemCachePath);
+
+	settingsPhase.reset();
 
 	// Load fonts
+	auto fontsPhase = std::make_unique<StartupProfiler::ScopedPhase>("fonts");
 	if (QFontDatabase::addApplicationFont(":/MaterialIcons-Regular.ttf") == -1) // From https://material.io/icons/
 	{
 		QMessageBox::critical(nullptr, "", "Failed to load font resource.\n\nCannot continue!");
@@ -160,6 +209,8 @@ int main(int argc, char* argv[])
 		return 1;
 	}
 
+	fontsPhase.reset();
+
 	// Read saved profile
 	auto const userProfile = settings.getValue(settings::UserProfile.name).value<profiles::ProfileType>();
 
@@ -187,35 +238,30 @@ int main(int argc, char* argv[])
 	splash.show();
 	app.processEvents();
 
-	/* Load everything we need */
-	std::chrono::time_point<std::chrono::system_clock> start{ std::chrono::system_clock::now() };
-
-	// Initialize Sparkle
+	// Apply the theme stylesheet before the widgets are created, so they are polished once (the main window applying the same stylesheet is a no-op)
 	{
-		QFile signatureFile(":/dsa_pub.pem");
-		if (signatureFile.open(QIODevice::ReadOnly))
-		{
-			auto content = QString(signatureFile.readAll());
-			Sparkle::getInstance().init(content.toStdString());
-		}
+		auto const phase = StartupProfiler::ScopedPhase{ "styleSheet" };
+		styleSheetCache::apply(settings.getValue(settings::General_ThemeColorIndex.name).toInt());
 	}
 
-	// Load main window
+	// Load main window. Only what is needed to display the entity list is done here, the updater being initialized once the window is shown
+	auto mainWindowPhase = std::make_unique<StartupProfiler::ScopedPhase>("mainWindow");
 	auto window = MainWindow{};
-	//window.show(); // This forces the creation of the window // Don't try to show it, it blinks sometimes (and window.hide() seems to create the window too)
-	window.hide(); // Immediately hides it (even though it was not actually shown since processEvents was not called)
+	mainWindowPhase.reset();
 
-	/* Loading done - Keep the splashscreen displayed until specified delay */
-	do
+	// Show the main window as soon as it's ready, so discovered entities are visible right away
 	{
-		app.processEvents();
-		// Wait a little bit so we don't burn the CPU
-		std::this_thread::sleep_for(std::chrono::milliseconds(10));
-	} while (splash.isVisible() && std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start).count() <= SPLASH_DELAY);
+		auto const phase = StartupProfiler::ScopedPhase{ "firstShow" };
+		window.show();
+		splash.finish(&window);
+	}
+	startupProfiler.addMilestone("mainWindowShown");
 
-	/* Ok, kill the splashscreen and show the main window */
-	splash.close();
-	window.show();
+	LOG_HIVE_INFO(QString("Startup completed in %1ms (%2)").arg(startupProfiler.elapsed()).arg(startupProfiler.summary()));
+
+	// Watch for main thread stalls, only once started so the startup itself is not reported
+	auto& mainThreadWatchdog = MainThreadWatchdog::getInstance();
+	mainThreadWatchdog.start();
 
 	auto retValue = int{ 0u };
 #ifndef BUGREPORTER_CATCH_EXCEPTIONS
@@ -235,6 +281,8 @@ int main(int argc, char* argv[])
 	}
 #endif // !BUGREPORTER_CATCH_EXCEPTIONS
 
+	mainThreadWatchdog.stop();
+
 	// Destroy the controller before leaving main (so it's properly cleaned before all static variables are destroyed in a random order)
 	avdecc::ControllerManager::getInstance().destroyController();
 
@@ -0,0 +1,358 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mainThreadWatchdog.hpp"
+#include "avdecc/hiveLogItems.hpp"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QEvent>
+#include <QFile>
+#include <QMetaEnum>
+#include <QStandardPaths>
+#include <QTextStream>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Stack samples are taken with BugTrap on windows (snapshot of all threads), and with backtrace() on the main thread (from a signal handler) where available
+#if defined(Q_OS_WIN32) && defined(HAVE_BUGTRAP)
+#	define STACK_SAMPLE_BUGTRAP
+#	include <Windows.h>
+#	include "BugTrap.h"
+#elif defined(Q_OS_UNIX) && __has_include(<execinfo.h>)
+#	define STACK_SAMPLE_BACKTRACE
+#	include <execinfo.h>
+#	include <csignal>
+#	include <cstdlib> // free
+#	include <pthread.h>
+#endif
+
+static constexpr auto StallReportsFolder = "stalls";
+static constexpr auto StackSampleTimeout = std::chrono::milliseconds{ 500 }; // Time given to the main thread to take its own stack sample
+
+#if defined(STACK_SAMPLE_BACKTRACE)
+static constexpr auto StackSampleSignal = SIGUSR2;
+static constexpr auto MaxStackFrames = 64;
+static void* s_stackFrames[MaxStackFrames];
+static std::atomic<int> s_stackFramesCount{ -1 };
+
+// backtrace() is not listed as async-signal-safe by POSIX: glibc's only unsafe step is the lazy loading of the unwinder on first call (done beforehand, see enableStackSampling).
+// Sampling is thus a developer diagnostic only, never enabled for standard users
+static void stackSampleSignalHandler(int /*signal*/)
+{
+	s_stackFramesCount = backtrace(s_stackFrames, MaxStackFrames);
+}
+#endif // STACK_SAMPLE_BACKTRACE
+
+class MainThreadWatchdogImpl final : public MainThreadWatchdog
+{
+public:
+	MainThreadWatchdogImpl() noexcept = default;
+
+	~MainThreadWatchdogImpl() noexcept
+	{
+		stop();
+	}
+
+	// Deleted compiler auto-generated methods
+	MainThreadWatchdogImpl(MainThreadWatchdogImpl const&) = delete;
+	MainThreadWatchdogImpl(MainThreadWatchdogImpl&&) = delete;
+	MainThreadWatchdogImpl& operator=(MainThreadWatchdogImpl const&) = delete;
+	MainThreadWatchdogImpl& operator=(MainThreadWatchdogImpl&&) = delete;
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	// MainThreadWatchdog overrides
+	virtual void start() noexcept override
+	{
+		if (_thread.joinable())
+		{
+			return;
+		}
+
+		_shouldStop = false;
+		_thread = std::thread{ &MainThreadWatchdogImpl::run, this };
+	}
+
+	virtual void stop() noexcept override
+	{
+		if (!_thread.joinable())
+		{
+			return;
+		}
+
+		{
+			auto const lg = std::lock_guard{ _stopLock };
+			_shouldStop = true;
+		}
+		_stopCondition.notify_all();
+		_thread.join();
+	}
+
+	virtual void setStallDiagnosticsEnabled(bool const enabled) noexcept override
+	{
+		if (enabled == _stallDiagnosticsEnabled)
+		{
+			return;
+		}
+
+		if (enabled)
+		{
+#if defined(STACK_SAMPLE_BACKTRACE)
+			enableStackSampling();
+#endif // STACK_SAMPLE_BACKTRACE
+			// Track the event being dispatched by the main thread, so it can be reported if it stalls
+			qApp->installEventFilter(this);
+		}
+		else if (qApp)
+		{
+			qApp->removeEventFilter(this);
+		}
+		_stallDiagnosticsEnabled = enabled;
+	}
+
+	virtual Statistics getStatistics() const noexcept override
+	{
+		auto const lg = std::lock_guard{ _statisticsLock };
+		return _statistics;
+	}
+
+	virtual void clearStatistics() noexcept override
+	{
+		auto const lg = std::lock_guard{ _statisticsLock };
+		_statistics = Statistics{};
+	}
+
+	// QObject overrides
+	virtual bool eventFilter(QObject* watched, QEvent* event) override
+	{
+		// Only record static data, this is called for every single event of the main thread
+		_dispatchedClassName = watched->metaObject()->className();
+		_dispatchedEventType = static_cast<int>(event->type());
+		return false;
+	}
+
+	// Private methods
+	void run() noexcept
+	{
+		auto pingPending = std::make_shared<std::atomic_bool>(false);
+		auto pingTime = Clock::time_point{};
+		auto stallReported = false;
+
+		auto lock = std::unique_lock{ _stopLock };
+		while (!_shouldStop)
+		{
+			auto const now = Clock::now();
+			if (!*pingPending)
+			{
+				pingTime = now;
+				stallReported = false;
+				*pingPending = true;
+				QMetaObject::invokeMethod(this,
+					[this, pingPending, pingTime]()
+					{
+						handlePing(Clock::now() - pingTime);
+						*pingPending = false;
+					});
+			}
+			else if (!stallReported && (now - pingTime) >= StallThreshold)
+			{
+				// The main thread is still blocked, sample it now (the duration of the stall is only known once it's processing events again)
+				stallReported = true;
+				lock.unlock();
+				reportStall(std::chrono::duration_cast<std::chrono::milliseconds>(now - pingTime));
+				lock.lock();
+			}
+
+			_stopCondition.wait_for(lock, PingInterval,
+				[this]()
+				{
+					return _shouldStop;
+				});
+		}
+	}
+
+	void handlePing(Clock::duration const& latency) noexcept
+	{
+		auto const stallDuration = std::chrono::duration_cast<std::chrono::milliseconds>(latency);
+		auto isStall = false;
+		{
+			auto const lg = std::lock_guard{ _statisticsLock };
+			_statistics.latencies.add(std::chrono::duration_cast<avdecc::LatencyHistogram::Duration>(latency));
+			if (stallDuration >= StallThreshold)
+			{
+				isStall = true;
+				++_statistics.stallsCount;
+				_statistics.longestStall = std::max(_statistics.longestStall, stallDuration);
+			}
+		}
+
+		if (isStall)
+		{
+			LOG_HIVE_WARN(QString("Main thread was blocked for %1 msec").arg(stallDuration.count()));
+		}
+	}
+
+	QString dispatchedEventDescription() const noexcept
+	{
+		auto const eventType = _dispatchedEventType.load();
+		auto const* const className = _dispatchedClassName.load();
+
+		auto const* const eventName = QMetaEnum::fromType<QEvent::Type>().valueToKey(eventType);
+		auto const eventString = eventName ? QString{ eventName } : QString::number(eventType);
+
+		// Queued signals and QMetaObject::invokeMethod calls are delivered as MetaCall events to the object owning the slot
+		if (eventType == QEvent::MetaCall)
+		{
+			return QString("queued slot call on %1").arg(className ? className : "<unknown>");
+		}
+		return QString("%1 event on %2").arg(eventString).arg(className ? className : "<unknown>");
+	}
+
+	void reportStall(std::chrono::milliseconds const& duration) noexcept
+	{
+		if (!_stallDiagnosticsEnabled)
+		{
+			LOG_HIVE_WARN(QString("Main thread blocked for more than %1 msec").arg(duration.count()));
+			return;
+		}
+
+		auto const dispatchedEvent = dispatchedEventDescription();
+
+		auto const dirPath = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + '/' + StallReportsFolder;
+		auto const baseFilePath = QString("%1/stall_%2").arg(dirPath).arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"));
+		auto reportFilePath = QString{};
+		if (QDir{}.mkpath(dirPath))
+		{
+			reportFilePath = writeStackSample(baseFilePath, duration, dispatchedEvent);
+		}
+
+		LOG_HIVE_WARN(QString("Main thread blocked for more than %1 msec, while processing %2%3").arg(duration.count()).arg(dispatchedEvent).arg(reportFilePath.isEmpty() ? QString{} : QString(" (stack sample saved to %1)").arg(reportFilePath)));
+
+		if (!reportFilePath.isEmpty())
+		{
+			auto const lg = std::lock_guard{ _statisticsLock };
+			_statistics.lastStallReport = reportFilePath;
+		}
+	}
+
+#if defined(STACK_SAMPLE_BACKTRACE)
+	void enableStackSampling() noexcept
+	{
+		_mainThread = pthread_self();
+		struct sigaction action{};
+		action.sa_handler = &stackSampleSignalHandler;
+		action.sa_flags = SA_RESTART;
+		sigemptyset(&action.sa_mask);
+		sigaction(StackSampleSignal, &action, nullptr);
+
+		// First call of backtrace() may allocate (loading the unwinder), do it now instead of in the signal handler
+		void* frame{ nullptr };
+		backtrace(&frame, 1);
+	}
+#endif // STACK_SAMPLE_BACKTRACE
+
+	/** Takes a stack sample of the main thread and writes the report. Returns the path of the report, or an empty string if no sample could be taken */
+	QString writeStackSample(QString const& baseFilePath, std::chrono::milliseconds const& duration, QString const& dispatchedEvent) noexcept
+	{
+#if defined(STACK_SAMPLE_BUGTRAP)
+		(void)duration;
+		(void)dispatchedEvent;
+		// BugTrap saves a snapshot of the whole process, including the stack of all threads
+		auto const filePath = baseFilePath + ".zip";
+		auto const nativePath = QDir::toNativeSeparators(filePath);
+#	ifdef UNICODE
+		auto const snapshotSaved = BT_SaveSnapshot(nativePath.toStdWString().c_str());
+#	else // !UNICODE
+		auto const snapshotSaved = BT_SaveSnapshot(nativePath.toLocal8Bit().constData());
+#	endif // UNICODE
+		return snapshotSaved ? filePath : QString{};
+
+#elif defined(STACK_SAMPLE_BACKTRACE)
+		// backtrace() only walks the stack of the calling thread, ask the main thread to take its own sample
+		s_stackFramesCount = -1;
+		if (pthread_kill(_mainThread, StackSampleSignal) != 0)
+		{
+			return {};
+		}
+		auto const timeout = Clock::now() + StackSampleTimeout;
+		while (s_stackFramesCount < 0 && Clock::now() < timeout)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+		}
+		auto const framesCount = s_stackFramesCount.load();
+		if (framesCount <= 0)
+		{
+			return {};
+		}
+
+		auto const filePath = baseFilePath + ".txt";
+		auto file = QFile{ filePath };
+		if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+		{
+			return {};
+		}
+		auto stream = QTextStream{ &file };
+		stream << "Main thread blocked for more than " << duration.count() << " msec, while processing " << dispatchedEvent << "\n\n";
+		if (auto* const symbols = backtrace_symbols(s_stackFrames, framesCount))
+		{
+			for (auto frame = 0; frame < framesCount; ++frame)
+			{
+				stream << symbols[frame] << "\n";
+			}
+			std::free(symbols);
+		}
+		return filePath;
+
+#else // Not supported on this platform
+		(void)baseFilePath;
+		(void)duration;
+		(void)dispatchedEvent;
+		return {};
+#endif
+	}
+
+	// Private members
+	std::thread _thread{};
+	std::mutex _stopLock{};
+	std::condition_variable _stopCondition{};
+	bool _shouldStop{ false };
+	mutable std::mutex _statisticsLock{};
+	Statistics _statistics{};
+	std::atomic<char const*> _dispatchedClassName{ nullptr };
+	std::atomic<int> _dispatchedEventType{ 0 };
+	std::atomic_bool _stallDiagnosticsEnabled{ false };
+#if defined(STACK_SAMPLE_BACKTRACE)
+	pthread_t _mainThread{};
+#endif // STACK_SAMPLE_BACKTRACE
+};
+
+MainThreadWatchdog& MainThreadWatchdog::getInstance() noexcept
+{
+	static MainThreadWatchdogImpl s_MainThreadWatchdog{};
+
+	return s_MainThreadWatchdog;
+}
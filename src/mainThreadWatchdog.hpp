@@ -0,0 +1,64 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "avdecc/latencyHistogram.hpp"
+
+#include <QObject>
+#include <QString>
+
+#include <chrono>
+#include <cstdint>
+
+/** Watches the main thread from a dedicated thread: measures the latency of its event loop and reports every stall (with a stack sample and the event being dispatched when the stall diagnostics are enabled) */
+class MainThreadWatchdog : public QObject
+{
+	Q_OBJECT
+public:
+	struct Statistics
+	{
+		avdecc::LatencyHistogram latencies{}; // Time taken by the event loop to process a ping
+		std::uint64_t stallsCount{ 0u };
+		std::chrono::milliseconds longestStall{ 0 };
+		QString lastStallReport{}; // Path of the last stall report, empty if none was written
+	};
+
+	/** Interval between two pings of the main thread event loop */
+	static constexpr auto PingInterval = std::chrono::milliseconds{ 100 };
+	/** Ping latency above which the main thread is considered stalled */
+	static constexpr auto StallThreshold = std::chrono::milliseconds{ 1000 };
+
+	static MainThreadWatchdog& getInstance() noexcept;
+
+	/** Starts watching the main thread. Must be called from the main thread, once the application is created */
+	virtual void start() noexcept = 0;
+
+	/** Stops the watchdog thread */
+	virtual void stop() noexcept = 0;
+
+	/** Enables the stall diagnostics (event being dispatched and stack sample of the main thread), a developer tool that costs an event filter on every event of the main thread. Must be called from the main thread */
+	virtual void setStallDiagnosticsEnabled(bool const enabled) noexcept = 0;
+
+	virtual Statistics getStatistics() const noexcept = 0;
+	virtual void clearStatistics() noexcept = 0;
+
+protected:
+	MainThreadWatchdog() = default;
+};
@@ -22,6 +22,7 @@
 #include <QtWidgets>
 #include <QMessageBox>
 #include <QFile>
+#include <QTextStream>
 #include <QTextBrowser>
 #include <QDateTime>
 #include <QAbstractListModel>
@@ -36,11 +37,22 @@
 
 #include "avdecc/helper.hpp"
 #include "avdecc/hiveLogItems.hpp"
+#include "avdecc/batchOperations.hpp"
 #include "avdecc/channelConnectionManager.hpp"
+#include "avdecc/connectionAudit.hpp"
 #include "avdecc/controllerModel.hpp"
 #include "avdecc/controllerManager.hpp"
+#include "avdecc/entityModelStore.hpp"
+#include "avdecc/spanTrace.hpp"
+#include "avdecc/networkSnapshot.hpp"
+#include "avdecc/gptpDomainIndex.hpp"
 #include "avdecc/mcDomainManager.hpp"
+#include "avdecc/memoryAccounting.hpp"
+#include "avdecc/networkTopology.hpp"
+#include "avdecc/routingSnapshot.hpp"
+#include "avdecc/searchIndex.hpp"
 #include "mediaClock/mediaClockManagementDialog.hpp"
+#include "connectionMatrix/detachedWindow.hpp"
 #include "internals/config.hpp"
 #include "profiles/profiles.hpp"
 #include "settingsManager/settings.hpp"
@@ -49,8 +61,9 @@
 #include "toolkit/flatIconButton.hpp"
 #include "toolkit/dynamicHeaderView.hpp"
 #include "toolkit/material/color.hpp"
-#include "toolkit/material/colorPalette.hpp"
+#include "toolkit/filterExpression.hpp"
 #include "activeNetworkInterfaceModel.hpp"
+#include "controllerSortFilterProxyModel.hpp"
 #include "aboutDialog.hpp"
 #include "deviceDetailsDialog.hpp"
 #include "entityLogoCache.hpp"
@@ -59,13 +72,32 @@
 #include "nodeVisitor.hpp"
 #include "settingsDialog.hpp"
 #include "multiFirmwareUpdateDialog.hpp"
+#include "batchOperationsDialog.hpp"
+#include "stressLoadDialog.hpp"
+#include "networkTopologyDialog.hpp"
+#include "gptpDomainsDialog.hpp"
+#include "entityComparisonDialog.hpp"
+#include "quickSearchDialog.hpp"
+#include "statistics/networkStatisticsDialog.hpp"
+#include "statistics/mainThreadLatencyDialog.hpp"
+#include "statistics/dispatchProfilerDialog.hpp"
+#include "statistics/memoryAccountingDialog.hpp"
+#include "startupProfiler.hpp"
+#include "styleSheetCache.hpp"
+#include "dispatchProfiler.hpp"
+#include "mainThreadWatchdog.hpp"
 #include "defaults.hpp"
 #include "windowsNpfHelper.hpp"
 
 #include <la/avdecc/networkInterfaceHelper.hpp>
 
+#include <map>
 #include <mutex>
 #include <memory>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <tuple>
 
 extern "C"
 {
@@ -102,6 +134,19 @@ public:
 	MainWindowImpl& operator=(MainWindowImpl const&) = delete;
 	MainWindowImpl& operator=(MainWindowImpl&&) = delete;
 
+	~MainWindowImpl() noexcept
+	{
+		// Wait for a pending export, it uses the ControllerManager
+		if (_exportThread.joinable())
+		{
+			_exportThread.join();
+		}
+		if (_npfStatusThread.joinable())
+		{
+			_npfStatusThread.join();
+		}
+	}
+
 	// Private Structs
 	struct Defaults
 	{
@@ -123,10 +168,12 @@ public:
 		bool controllerTableView_AssociationID_Visible{ true };
 		bool controllerTableView_MediaClockMasterID_Visible{ true };
 		bool controllerTableView_MediaClockMasterName_Visible{ true };
+		bool controllerTableView_ReservedBandwidth_Visible{ true };
 	};
 
 	// Private Slots
 	Q_SLOT void currentControllerChanged();
+	Q_SLOT void reloadController();
 	Q_SLOT void currentControlledEntityChanged(QModelIndex const& index);
 
 	// Private methods
@@ -138,13 +185,28 @@ public:
 	void createViewMenu();
 	void createToolbars();
 	void createControllerView();
+	void updateControllerImageSizes();
 	void checkNpfStatus();
+#ifdef _WIN32
+	void handleNpfStatus(npf::Status const npfStatus);
+#endif // _WIN32
+	void whenNetworkInterfacesEnumerated(std::function<void()> const& handler);
+	void selectSavedNetworkInterface();
 	void loadSettings();
 	void connectSignals();
 	void showChangeLog(QString const title, QString const versionString);
-	void updateStyleSheet(qt::toolkit::material::color::Name const colorName, QString const& filename);
+	void updateStyleSheet(int const themeColorIndex, QString const& filename);
+	void updateLowPowerMode();
+	void updateVisibleEntities();
+	void showBulkEntityMenu(QPoint const& pos, avdecc::ControllerManager::EntityIDs const& entityIDs);
+	void runBulkEntityOperation(avdecc::ControllerManager::EntityIDs const& entityIDs, avdecc::batchOperations::Step::Type const type, QString const& operationName);
 	static QString generateDumpSourceString() noexcept;
 
+	using ExportResult = std::tuple<la::avdecc::jsonSerializer::SerializationError, std::string>;
+	using ExportFunction = std::function<ExportResult()>;
+	using ExportCompletionHandler = std::function<void(ExportResult const& result)>;
+	void exportInBackground(QString const& filename, ExportFunction const& exportFunction, ExportCompletionHandler const& completionHandler) noexcept;
+
 	// settings::SettingsManager::Observer overrides
 	virtual void onSettingChanged(settings::SettingsManager::Setting const& name, QVariant const& value) noexcept override;
 
@@ -160,11 +222,22 @@ public:
 	QLabel _controllerEntityIDLabel{ _parent };
 	qt::toolkit::DynamicHeaderView _controllerDynamicHeaderView{ Qt::Horizontal, _parent };
 	avdecc::ControllerModel* _controllerModel{ nullptr };
+	ControllerSortFilterProxyModel _controllerProxyModel{ _parent };
+	QLineEdit _entityFilterLineEdit{ _parent };
+	qt::toolkit::FilterExpressionDebouncer _entityFilterDebouncer{};
 	bool _shown{ false };
+	bool _isLowPowerMode{ false };
+	QTimer _visibleEntitiesTimer{}; // Debounces the visible rows changes of the entity list
+	std::thread _exportThread{};
+	bool _isExporting{ false };
+	std::thread _npfStatusThread{}; // Probes the WinPcap service status, once
+	NetworkTopologyDialog* _networkTopologyDialog{ nullptr }; // Kept once opened, so is its layout
 };
 
 void MainWindowImpl::setupAdvancedView(Defaults const& defaults)
 {
+	auto const phase = StartupProfiler::ScopedPhase{ "setupAdvancedView" };
+
 	// Create "view" sub-menu
 	createViewMenu();
 
@@ -187,6 +260,7 @@ void MainWindowImpl::setupAdvancedView(Defaults const& defaults)
 	controllerTableView->setColumnHidden(la::avdecc::utils::to_integral(avdecc::ControllerModel::Column::AssociationID), !defaults.controllerTableView_AssociationID_Visible);
 	controllerTableView->setColumnHidden(la::avdecc::utils::to_integral(avdecc::ControllerModel::Column::MediaClockMasterID), !defaults.controllerTableView_MediaClockMasterID_Visible);
 	controllerTableView->setColumnHidden(la::avdecc::utils::to_integral(avdecc::ControllerModel::Column::MediaClockMasterName), !defaults.controllerTableView_MediaClockMasterName_Visible);
+	controllerTableView->setColumnHidden(la::avdecc::utils::to_integral(avdecc::ControllerModel::Column::ReservedBandwidth), !defaults.controllerTableView_ReservedBandwidth_Visible);
 
 	controllerTableView->setColumnWidth(la::avdecc::utils::to_integral(avdecc::ControllerModel::Column::EntityLogo), defaults::ui::AdvancedView::ColumnWidth_Logo);
 	controllerTableView->setColumnWidth(la::avdecc::utils::to_integral(avdecc::ControllerModel::Column::Compatibility), defaults::ui::AdvancedView::ColumnWidth_Compatibility);
@@ -201,6 +275,7 @@ void MainWindowImpl::setupAdvancedView(Defaults const& defaults)
 	controllerTableView->setColumnWidth(la::avdecc::utils::to_integral(avdecc::ControllerModel::Column::AssociationID), defaults::ui::AdvancedView::ColumnWidth_UniqueIdentifier);
 	controllerTableView->setColumnWidth(la::avdecc::utils::to_integral(avdecc::ControllerModel::Column::MediaClockMasterID), defaults::ui::AdvancedView::ColumnWidth_UniqueIdentifier);
 	controllerTableView->setColumnWidth(la::avdecc::utils::to_integral(avdecc::ControllerModel::Column::MediaClockMasterName), defaults::ui::AdvancedView::ColumnWidth_Name);
+	controllerTableView->setColumnWidth(la::avdecc::utils::to_integral(avdecc::ControllerModel::Column::ReservedBandwidth), defaults::ui::AdvancedView::ColumnWidth_Bandwidth);
 
 	controllerToolBar->setVisible(defaults.mainWindow_Toolbar_Visible);
 	entityInspectorDockWidget->setVisible(defaults.mainWindow_Inspector_Visible);
@@ -218,6 +293,21 @@ void MainWindowImpl::setupAdvancedView(Defaults const& defaults)
 
 	// Create channel connection manager instance
 	avdecc::ChannelConnectionManager::getInstance();
+
+	// Create the persistent entity model store instance
+	avdecc::EntityModelStore::getInstance();
+
+	// Create the network topology instance, so it follows the AS paths from the first discovered entity
+	avdecc::topology::NetworkTopology::getInstance();
+
+	// Create the gPTP domain index instance, it's only maintained from the gPTP changes
+	avdecc::gptp::GptpDomainIndex::getInstance();
+
+	// Create the search index instance, so the names of the first discovered entities are indexed
+	avdecc::search::SearchIndex::getInstance();
+
+	// Create the connection auditor instance, so the connections of the first discovered entities are audited
+	avdecc::ConnectionAuditor::getInstance();
 }
 
 void MainWindowImpl::setupStandardProfile()
@@ -228,6 +318,16 @@ void MainWindowImpl::setupStandardProfile()
 void MainWindowImpl::setupDeveloperProfile()
 {
 	setupAdvancedView(Defaults{});
+
+	// Developer only tools
+	actionMainThreadLatency->setVisible(true);
+	actionSignalDispatchProfiler->setVisible(true);
+	DispatchProfiler::getInstance().setEnabled(true);
+	MainThreadWatchdog::getInstance().setStallDiagnosticsEnabled(true);
+	actionMemoryAccounting->setVisible(true);
+	actionRecordHotPathTrace->setVisible(true);
+	actionStressLoad->setVisible(true);
+	avdecc::MemoryAccounting::getInstance().setPeriodicLogging(true);
 }
 
 void MainWindowImpl::setupProfile()
@@ -254,6 +354,12 @@ void MainWindowImpl::setupProfile()
 
 void MainWindowImpl::currentControllerChanged()
 {
+	// The saved interface is selected once the interfaces are enumerated (the combo box selecting the first inserted one in the meantime)
+	if (!_activeNetworkInterfaceModel.isEnumerationCompleted())
+	{
+		return;
+	}
+
 	auto& settings = settings::SettingsManager::getInstance();
 
 	auto const protocolType = settings.getValue(settings::Network_ProtocolType.name).value<la::avdecc::protocol::ProtocolInterface::Type>();
@@ -278,6 +384,9 @@ void MainWindowImpl::currentControllerChanged()
 
 	settings.setValue(settings::InterfaceID, interfaceID);
 
+	// Show the entities last seen on this interface until they are enumerated again
+	avdecc::networkSnapshot::NetworkSnapshotStore::getInstance().setCurrentInterface(interfaceID);
+
 	try
 	{
 		// Create a new Controller
@@ -286,25 +395,56 @@ void MainWindowImpl::currentControllerChanged()
 #else // !DEBUG
 		auto const progID = std::uint16_t{ PROG_ID };
 #endif // DEBUG
-		manager.createController(protocolType, interfaceID, progID, la::avdecc::entity::model::makeEntityModelID(VENDOR_ID, DEVICE_ID, MODEL_ID), "en");
+		{
+			auto const phase = StartupProfiler::ScopedPhase{ "createController" };
+			auto const secondaryInterfaceIDs = settings.getValue(settings::SecondaryInterfaceIDs).toStringList();
+			manager.createController(protocolType, interfaceID, progID, la::avdecc::entity::model::makeEntityModelID(VENDOR_ID, DEVICE_ID, MODEL_ID), "en", secondaryInterfaceIDs);
+		}
+		_controllerEntityIDLabel.setText(avdecc::helper::uniqueIdentifierToString(manager.getControllerEID()));
+	}
+	catch (la::avdecc::controller::Controller::Exception const& e)
+	{
+		LOG_HIVE_WARN(e.what());
+	}
+}
+
+void MainWindowImpl::reloadController()
+{
+	auto& manager = avdecc::ControllerManager::getInstance();
+
+	// No controller yet (or it failed to be created): create it from scratch
+	if (!manager.getControllerEID())
+	{
+		currentControllerChanged();
+		return;
+	}
+
+	// Same interface: only re-create the protocol interface, the entities being reconciled in place when they come back
+	try
+	{
+		manager.reloadController();
 		_controllerEntityIDLabel.setText(avdecc::helper::uniqueIdentifierToString(manager.getControllerEID()));
 	}
 	catch (la::avdecc::controller::Controller::Exception const& e)
 	{
 		LOG_HIVE_WARN(e.what());
+		_controllerEntityIDLabel.clear();
 	}
 }
 
 void MainWindowImpl::currentControlledEntityChanged(QModelIndex const& index)
 {
+	auto& manager = avdecc::ControllerManager::getInstance();
+
 	if (!index.isValid())
 	{
+		manager.setSelectedEntity(la::avdecc::UniqueIdentifier{});
 		entityInspector->setControlledEntityID(la::avdecc::UniqueIdentifier{});
 		return;
 	}
 
-	auto& manager = avdecc::ControllerManager::getInstance();
-	auto const entityID = _controllerModel->controlledEntityID(index);
+	auto const entityID = _controllerProxyModel.controlledEntityID(index);
+	manager.setSelectedEntity(entityID);
 	auto controlledEntity = manager.getControlledEntity(entityID);
 
 	if (controlledEntity)
@@ -330,6 +470,15 @@ void MainWindowImpl::createViewMenu()
 	auto* actionGroup = new QActionGroup{ this };
 	actionGroup->addAction(actionStreamModeRouting);
 	actionGroup->addAction(actionChannelModeRouting);
+
+	// Additional connection matrix windows, sharing the model of the main one
+	auto* newMatrixWindowAction = menuView->addAction("New Connection Matrix Window");
+	connect(newMatrixWindowAction, &QAction::triggered, this,
+		[this]()
+		{
+			auto* window = new connectionMatrix::DetachedWindow{ routingTableView, _parent };
+			window->show();
+		});
 	menuView->addSeparator();
 
 	// Toolbars visibility toggle
@@ -368,6 +517,20 @@ void MainWindowImpl::createToolbars()
 		controllerToolBar->addSeparator();
 		controllerToolBar->addWidget(controllerEntityIDLabel);
 		controllerToolBar->addWidget(&_controllerEntityIDLabel);
+
+		_entityFilterLineEdit.setPlaceholderText("Filter entities");
+		_entityFilterLineEdit.setToolTip("Filter the entities on their ID, name, group, compatibility or gPTP information");
+		_entityFilterLineEdit.setClearButtonEnabled(true);
+		_entityFilterLineEdit.setMaximumWidth(240);
+		controllerToolBar->addSeparator();
+		controllerToolBar->addWidget(&_entityFilterLineEdit);
+		// The entity list is filtered once the typing paused
+		connect(&_entityFilterLineEdit, &QLineEdit::textChanged, &_entityFilterDebouncer, &qt::toolkit::FilterExpressionDebouncer::setPattern);
+		connect(&_entityFilterDebouncer, &qt::toolkit::FilterExpressionDebouncer::expressionChanged, &_controllerProxyModel,
+			[this](qt::toolkit::FilterExpression const& expression)
+			{
+				_controllerProxyModel.setFilterText(expression.pattern());
+			});
 	}
 
 	// Utilities Toolbar
@@ -400,15 +563,20 @@ void MainWindowImpl::createToolbars()
 
 void MainWindowImpl::createControllerView()
 {
-	controllerTableView->setModel(_controllerModel);
+	auto const phase = StartupProfiler::ScopedPhase{ "createControllerView" };
+
+	_controllerProxyModel.setSourceModel(_controllerModel);
+	controllerTableView->setModel(&_controllerProxyModel);
 	controllerTableView->setSelectionBehavior(QAbstractItemView::SelectRows);
-	controllerTableView->setSelectionMode(QAbstractItemView::SingleSelection);
+	controllerTableView->setSelectionMode(QAbstractItemView::ExtendedSelection);
 	controllerTableView->setContextMenuPolicy(Qt::CustomContextMenu);
 	controllerTableView->setFocusPolicy(Qt::ClickFocus);
 
 	// Disable row resizing
 	controllerTableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
 
+	updateControllerImageSizes();
+
 	// The table view does not take ownership on the item delegate
 	auto* imageItemDelegate{ new ImageItemDelegate{ _parent } };
 	controllerTableView->setItemDelegateForColumn(la::avdecc::utils::to_integral(avdecc::ControllerModel::Column::EntityLogo), imageItemDelegate);
@@ -423,6 +591,19 @@ void MainWindowImpl::createControllerView()
 	_controllerDynamicHeaderView.setHighlightSections(false);
 	_controllerDynamicHeaderView.setMandatorySection(la::avdecc::utils::to_integral(avdecc::ControllerModel::Column::EntityID));
 	controllerTableView->setHorizontalHeader(&_controllerDynamicHeaderView);
+
+	// Sorted by the proxy, in discovery order until a column is clicked
+	_controllerDynamicHeaderView.setSortIndicator(-1, Qt::AscendingOrder);
+	controllerTableView->setSortingEnabled(true);
+}
+
+void MainWindowImpl::updateControllerImageSizes()
+{
+	// Entity logos and status icons are painted in a square of the row height
+	auto const rowHeight = controllerTableView->verticalHeader()->defaultSectionSize();
+	auto const devicePixelRatio = controllerTableView->devicePixelRatioF();
+	_controllerModel->setEntityLogoSize({ rowHeight, rowHeight }, devicePixelRatio);
+	_controllerModel->setStatusIconSize({ rowHeight, rowHeight }, devicePixelRatio);
 }
 
 void MainWindowImpl::checkNpfStatus()
@@ -432,57 +613,108 @@ void MainWindowImpl::checkNpfStatus()
 	std::call_once(once,
 		[this]()
 		{
-			auto const npfStatus = npf::getStatus();
-			switch (npfStatus)
-			{
-				case npf::Status::NotInstalled:
-					QMessageBox::warning(_parent, "", "The WinPcap library is required for Hive to communicate with AVB Entities on the network.\nIt looks like you uninstalled it, or didn't choose to install it when running Hive installation.\n\nYou need to rerun the installer and follow the instructions to install WinPcap.");
-					break;
-				case npf::Status::NotStarted:
+			// Querying the service manager can take a while, do not block the UI: probe on a worker thread then come back to show the dialogs
+			_npfStatusThread = std::thread{
+				[this]()
 				{
-					auto choice = QMessageBox::warning(_parent, "", "The WinPcap library must be started for Hive to communicate with AVB Entities on the network.\n\nDo you want to start WinPcap now?", QMessageBox::StandardButton::Yes, QMessageBox::StandardButton::No);
-					if (choice == QMessageBox::StandardButton::Yes)
-					{
-						npf::startService();
-						choice = QMessageBox::question(_parent, "", "Do you want to configure the library to automatically start when Windows boots (recommended)?", QMessageBox::StandardButton::Yes, QMessageBox::StandardButton::No);
-						if (choice == QMessageBox::StandardButton::Yes)
+					auto const npfStatus = npf::getStatus();
+					QMetaObject::invokeMethod(this,
+						[this, npfStatus]()
 						{
-							npf::setServiceAutoStart();
-						}
-						// Postpone Controller Refresh
-						QTimer::singleShot(0,
-							[this]()
-							{
-								currentControllerChanged();
-							});
-					}
-					break;
+							handleNpfStatus(npfStatus);
+						});
 				}
-				default:
-					break;
-			}
+			};
 		});
 #endif // _WIN32
 }
 
-void MainWindowImpl::loadSettings()
+#ifdef _WIN32
+void MainWindowImpl::handleNpfStatus(npf::Status const npfStatus)
 {
-	auto& settings = settings::SettingsManager::getInstance();
+	switch (npfStatus)
+	{
+		case npf::Status::NotInstalled:
+			QMessageBox::warning(_parent, "", "The WinPcap library is required for Hive to communicate with AVB Entities on the network.\nIt looks like you uninstalled it, or didn't choose to install it when running Hive installation.\n\nYou need to rerun the installer and follow the instructions to install WinPcap.");
+			break;
+		case npf::Status::NotStarted:
+		{
+			auto choice = QMessageBox::warning(_parent, "", "The WinPcap library must be started for Hive to communicate with AVB Entities on the network.\n\nDo you want to start WinPcap now?", QMessageBox::StandardButton::Yes, QMessageBox::StandardButton::No);
+			if (choice == QMessageBox::StandardButton::Yes)
+			{
+				npf::startService();
+				choice = QMessageBox::question(_parent, "", "Do you want to configure the library to automatically start when Windows boots (recommended)?", QMessageBox::StandardButton::Yes, QMessageBox::StandardButton::No);
+				if (choice == QMessageBox::StandardButton::Yes)
+				{
+					npf::setServiceAutoStart();
+				}
+				// Postpone Controller Refresh
+				QTimer::singleShot(0,
+					[this]()
+					{
+						currentControllerChanged();
+					});
+			}
+			break;
+		}
+		default:
+			break;
+	}
+}
+#endif // _WIN32
 
-	LOG_HIVE_DEBUG("Settings location: " + settings.getFilePath());
+void MainWindowImpl::whenNetworkInterfacesEnumerated(std::function<void()> const& handler)
+{
+	if (_activeNetworkInterfaceModel.isEnumerationCompleted())
+	{
+		handler();
+		return;
+	}
+
+	// Single shot connection
+	auto connection = std::make_shared<QMetaObject::Connection>();
+	*connection = connect(&_activeNetworkInterfaceModel, &ActiveNetworkInterfaceModel::enumerationCompleted, this,
+		[connection, handler]()
+		{
+			disconnect(*connection);
+			handler();
+		});
+}
+
+void MainWindowImpl::selectSavedNetworkInterface()
+{
+	auto& settings = settings::SettingsManager::getInstance();
 
 	auto const networkInterfaceId = settings.getValue(settings::InterfaceID).toString();
 	auto const networkInterfaceIndex = _interfaceComboBox.findData(networkInterfaceId);
 
+	auto const previousIndex = _interfaceComboBox.currentIndex();
+
 	// Select the interface from the settings, if present and active
-	if (networkInterfaceIndex >= 0 && _activeNetworkInterfaceModel.isEnabled(networkInterfaceId))
-	{
-		_interfaceComboBox.setCurrentIndex(networkInterfaceIndex);
-	}
-	else
+	auto const index = (networkInterfaceIndex >= 0 && _activeNetworkInterfaceModel.isEnabled(networkInterfaceId)) ? networkInterfaceIndex : -1;
+	_interfaceComboBox.setCurrentIndex(index);
+
+	// Changing the index refreshes the controller, otherwise do it now (changes being ignored until the enumeration completed)
+	if (index == previousIndex)
 	{
-		_interfaceComboBox.setCurrentIndex(-1);
+		currentControllerChanged();
 	}
+}
+
+void MainWindowImpl::loadSettings()
+{
+	auto const phase = StartupProfiler::ScopedPhase{ "loadSettings" };
+
+	auto& settings = settings::SettingsManager::getInstance();
+
+	LOG_HIVE_DEBUG("Settings location: " + settings.getFilePath());
+
+	// The interfaces are enumerated on a worker thread, the saved one is selected once they are known (refreshing the controller)
+	whenNetworkInterfacesEnumerated(
+		[this]()
+		{
+			selectSavedNetworkInterface();
+		});
 
 	// Check if currently saved ProtocolInterface is supported
 	auto protocolType = settings.getValue(settings::Network_ProtocolType.name).value<la::avdecc::protocol::ProtocolInterface::Type>();
@@ -527,6 +759,24 @@ void MainWindowImpl::loadSettings()
 	settings.registerSettingObserver(settings::General_CheckForBetaVersions.name, this);
 }
 
+static auto constexpr JsonFilterName = "JSON Files (*.json)";
+
+/** Returns true if the file should be serialized using the binary (MessagePack) format, JSON being only used for .json files */
+static inline bool isBinarySerializationFile(QString const& filePath) noexcept
+{
+	return QFileInfo{ filePath }.suffix().compare("json", Qt::CaseInsensitive) != 0;
+}
+
+/** Builds the filters of a save dialog, the binary format being the default one unless Shift is pressed */
+static inline QString serializationFilters(QString const& binaryFilterName) noexcept
+{
+	if (QApplication::keyboardModifiers().testFlag(Qt::ShiftModifier))
+	{
+		return QString{ "%1;;%2" }.arg(JsonFilterName).arg(binaryFilterName);
+	}
+	return QString{ "%1;;%2" }.arg(binaryFilterName).arg(JsonFilterName);
+}
+
 static inline bool isValidEntityModelID(la::avdecc::UniqueIdentifier const entityModelID) noexcept
 {
 	if (entityModelID)
@@ -550,10 +800,197 @@ static inline bool isEntityModelComplete(la::avdecc::UniqueIdentifier const enti
 	return true;
 }
 
+void MainWindowImpl::updateLowPowerMode()
+{
+	// Nothing is displayed while minimized or hidden by the system: the entity list only keeps its data up-to-date and is refreshed at once when restored.
+	// The other views (connection matrix, logger) are suspended by their own hide event, which is also sent when the window is minimized
+	auto const applicationState = qApp->applicationState();
+	auto const isLowPowerMode = _parent->isMinimized() || applicationState == Qt::ApplicationHidden || applicationState == Qt::ApplicationSuspended;
+
+	if (isLowPowerMode != _isLowPowerMode)
+	{
+		_isLowPowerMode = isLowPowerMode;
+		_controllerModel->setActive(!isLowPowerMode);
+		updateVisibleEntities();
+		LOG_HIVE_DEBUG(QString("Low power mode %1").arg(isLowPowerMode ? "enabled" : "disabled"));
+	}
+}
+
+void MainWindowImpl::updateVisibleEntities()
+{
+	auto entityIDs = avdecc::ControllerManager::EntityIDs{};
+
+	if (!_isLowPowerMode)
+	{
+		auto const rowCount = _controllerProxyModel.rowCount();
+		auto const firstRow = controllerTableView->rowAt(0);
+		if (firstRow >= 0)
+		{
+			auto lastRow = controllerTableView->rowAt(controllerTableView->viewport()->height() - 1);
+			if (lastRow < 0)
+			{
+				lastRow = rowCount - 1;
+			}
+			entityIDs.reserve(static_cast<size_t>(lastRow - firstRow + 1));
+			for (auto row = firstRow; row <= lastRow; ++row)
+			{
+				entityIDs.push_back(_controllerProxyModel.controlledEntityID(_controllerProxyModel.index(row, 0)));
+			}
+		}
+	}
+
+	avdecc::ControllerManager::getInstance().setVisibleEntities(entityIDs);
+}
+
+void MainWindowImpl::showBulkEntityMenu(QPoint const& pos, avdecc::ControllerManager::EntityIDs const& entityIDs)
+{
+	auto const isBatchRunning = avdecc::batchOperations::BatchOperationsManager::getInstance().isRunning();
+	auto const count = static_cast<int>(entityIDs.size());
+
+	QMenu menu;
+	auto* headerAction = menu.addAction(QString("%1 Entities Selected").arg(count));
+	auto font = headerAction->font();
+	font.setBold(true);
+	headerAction->setFont(font);
+	headerAction->setEnabled(false);
+	menu.addSeparator();
+
+	auto* acquireAction = menu.addAction("Acquire All");
+	auto* releaseAction = menu.addAction("Release All");
+	auto* lockAction = menu.addAction("Lock All");
+	auto* unlockAction = menu.addAction("Unlock All");
+	for (auto* action : { acquireAction, releaseAction, lockAction, unlockAction })
+	{
+		action->setEnabled(!isBatchRunning);
+	}
+
+	menu.addSeparator();
+
+	auto* compareAction = menu.addAction("Compare Entities...");
+
+	menu.addSeparator();
+
+	// Cancel
+	menu.addAction("Cancel");
+
+	if (auto* action = menu.exec(controllerTableView->viewport()->mapToGlobal(pos)))
+	{
+		if (action == compareAction)
+		{
+			EntityComparisonDialog dialog{ entityIDs, _parent };
+			dialog.exec();
+		}
+		else if (action == acquireAction)
+		{
+			runBulkEntityOperation(entityIDs, avdecc::batchOperations::Step::Type::Acquire, "Acquire");
+		}
+		else if (action == releaseAction)
+		{
+			runBulkEntityOperation(entityIDs, avdecc::batchOperations::Step::Type::Release, "Release");
+		}
+		else if (action == lockAction)
+		{
+			runBulkEntityOperation(entityIDs, avdecc::batchOperations::Step::Type::Lock, "Lock");
+		}
+		else if (action == unlockAction)
+		{
+			runBulkEntityOperation(entityIDs, avdecc::batchOperations::Step::Type::Unlock, "Unlock");
+		}
+	}
+}
+
+void MainWindowImpl::runBulkEntityOperation(avdecc::ControllerManager::EntityIDs const& entityIDs, avdecc::batchOperations::Step::Type const type, QString const& operationName)
+{
+	auto& manager = avdecc::ControllerManager::getInstance();
+	auto& batchManager = avdecc::batchOperations::BatchOperationsManager::getInstance();
+	auto const isAcquireOperation = type == avdecc::batchOperations::Step::Type::Acquire || type == avdecc::batchOperations::Step::Type::Release;
+
+	// Milan devices do not support Acquire, leave them out instead of reporting them all as failures
+	auto targetIDs = avdecc::ControllerManager::EntityIDs{};
+	auto skippedCount = size_t{ 0u };
+	for (auto const& entityID : entityIDs)
+	{
+		auto controlledEntity = manager.getControlledEntity(entityID);
+		if (!controlledEntity || !controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+		{
+			continue;
+		}
+		if (isAcquireOperation && controlledEntity->getCompatibilityFlags().test(la::avdecc::controller::ControlledEntity::CompatibilityFlag::Milan))
+		{
+			++skippedCount;
+			continue;
+		}
+		targetIDs.push_back(entityID);
+	}
+
+	if (targetIDs.empty())
+	{
+		QMessageBox::information(_parent, "", QString("%1 is not supported by any of the selected entities.").arg(operationName));
+		return;
+	}
+
+	// Only listen to the result of our own batch
+	auto const connection = std::make_shared<QMetaObject::Connection>();
+	*connection = connect(&batchManager, &avdecc::batchOperations::BatchOperationsManager::finished, this,
+		[this, connection, operationName, targetCount = targetIDs.size(), skippedCount](avdecc::commandChain::CommandExecutionErrors const& errors)
+		{
+			disconnect(*connection);
+
+			auto message = QString("%1 succeeded on %2 of %3 entities.").arg(operationName).arg(targetCount - errors.size()).arg(targetCount);
+			if (skippedCount > 0)
+			{
+				message += QString("\n%1 Milan entities skipped (Acquire not supported).").arg(skippedCount);
+			}
+
+			if (errors.empty())
+			{
+				LOG_HIVE_INFO(message);
+				return;
+			}
+
+			// Group the failures by error, a locked device does not prevent the others from being processed
+			auto failures = std::map<QString, QStringList>{};
+			for (auto const& [entityID, errorInfo] : errors)
+			{
+				auto entityName = avdecc::helper::uniqueIdentifierToString(entityID);
+				if (auto controlledEntity = avdecc::ControllerManager::getInstance().getControlledEntity(entityID))
+				{
+					entityName = avdecc::helper::smartEntityName(*controlledEntity);
+				}
+				failures[avdecc::commandChain::AsyncParallelCommandSet::errorToString(errorInfo.errorType)].append(entityName);
+			}
+
+			static constexpr auto MaxListedEntities = 10;
+			message += "\n\nFailures:\n";
+			for (auto& [error, entityNames] : failures)
+			{
+				entityNames.sort();
+				auto listed = QStringList{ entityNames.mid(0, MaxListedEntities) }.join(", ");
+				if (entityNames.size() > MaxListedEntities)
+				{
+					listed += QString(" and %1 more").arg(entityNames.size() - MaxListedEntities);
+				}
+				message += QString("- %1 (%2 entities): %3\n").arg(error).arg(entityNames.size()).arg(listed);
+			}
+
+			QMessageBox::warning(_parent, "", message);
+		});
+
+	auto step = avdecc::batchOperations::Step{};
+	step.type = type;
+	if (!batchManager.run(targetIDs, { step }))
+	{
+		disconnect(*connection);
+		QMessageBox::information(_parent, "", "Another batch operation is already running, please retry once it completed.");
+	}
+}
+
 void MainWindowImpl::connectSignals()
 {
+	connect(qApp, &QGuiApplication::applicationStateChanged, this, &MainWindowImpl::updateLowPowerMode);
+
 	connect(&_interfaceComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindowImpl::currentControllerChanged);
-	connect(&_refreshControllerButton, &QPushButton::clicked, this, &MainWindowImpl::currentControllerChanged);
+	connect(&_refreshControllerButton, &QPushButton::clicked, this, &MainWindowImpl::reloadController);
 
 	connect(&_openMcmdDialogButton, &QPushButton::clicked, actionMediaClockManagement, &QAction::trigger);
 	connect(&_openMultiFirmwareUpdateDialogButton, &QPushButton::clicked, actionDeviceFirmwareUpdate, &QAction::trigger);
@@ -572,6 +1009,22 @@ void MainWindowImpl::connectSignals()
 		});
 
 	connect(controllerTableView->selectionModel(), &QItemSelectionModel::currentChanged, this, &MainWindowImpl::currentControlledEntityChanged);
+
+	// Visible rows of the entity list, for the visibility-driven notifications
+	_visibleEntitiesTimer.setSingleShot(true);
+	_visibleEntitiesTimer.setInterval(100);
+	connect(&_visibleEntitiesTimer, &QTimer::timeout, this, &MainWindowImpl::updateVisibleEntities);
+	auto const scheduleVisibleEntitiesUpdate = [this]()
+	{
+		_visibleEntitiesTimer.start();
+	};
+	connect(controllerTableView->verticalScrollBar(), &QScrollBar::valueChanged, this, scheduleVisibleEntitiesUpdate);
+	connect(controllerTableView->verticalScrollBar(), &QScrollBar::rangeChanged, this, scheduleVisibleEntitiesUpdate);
+	connect(&_controllerProxyModel, &QAbstractItemModel::rowsInserted, this, scheduleVisibleEntitiesUpdate);
+	connect(&_controllerProxyModel, &QAbstractItemModel::rowsRemoved, this, scheduleVisibleEntitiesUpdate);
+	connect(&_controllerProxyModel, &QAbstractItemModel::rowsMoved, this, scheduleVisibleEntitiesUpdate);
+	connect(&_controllerProxyModel, &QAbstractItemModel::modelReset, this, scheduleVisibleEntitiesUpdate);
+	connect(&_controllerProxyModel, &QAbstractItemModel::layoutChanged, this, scheduleVisibleEntitiesUpdate);
 	connect(&_controllerDynamicHeaderView, &qt::toolkit::DynamicHeaderView::sectionChanged, this,
 		[this]()
 		{
@@ -583,7 +1036,7 @@ void MainWindowImpl::connectSignals()
 		[this](QModelIndex const& index)
 		{
 			auto& manager = avdecc::ControllerManager::getInstance();
-			auto const entityID = _controllerModel->controlledEntityID(index);
+			auto const entityID = _controllerProxyModel.controlledEntityID(index);
 			auto controlledEntity = manager.getControlledEntity(entityID);
 
 			if (controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
@@ -600,8 +1053,25 @@ void MainWindowImpl::connectSignals()
 		{
 			auto const index = controllerTableView->indexAt(pos);
 
+			// Right-clicking a row of a multiple selection applies to all the selected entities
+			auto* const selectionModel = controllerTableView->selectionModel();
+			if (index.isValid() && selectionModel->isRowSelected(index.row(), index.parent()))
+			{
+				auto const selectedRows = selectionModel->selectedRows();
+				if (selectedRows.size() > 1)
+				{
+					auto entityIDs = avdecc::ControllerManager::EntityIDs{};
+					for (auto const& selectedIndex : selectedRows)
+					{
+						entityIDs.push_back(_controllerProxyModel.controlledEntityID(selectedIndex));
+					}
+					showBulkEntityMenu(pos, entityIDs);
+					return;
+				}
+			}
+
 			auto& manager = avdecc::ControllerManager::getInstance();
-			auto const entityID = _controllerModel->controlledEntityID(index);
+			auto const entityID = _controllerProxyModel.controlledEntityID(index);
 			auto controlledEntity = manager.getControlledEntity(entityID);
 
 			if (controlledEntity)
@@ -618,6 +1088,7 @@ void MainWindowImpl::connectSignals()
 				auto* inspect{ static_cast<QAction*>(nullptr) };
 				auto* getLogo{ static_cast<QAction*>(nullptr) };
 				auto* clearErrorFlags{ static_cast<QAction*>(nullptr) };
+				auto* watchCounters{ static_cast<QAction*>(nullptr) };
 				auto* dumpFullEntity{ static_cast<QAction*>(nullptr) };
 				auto* dumpEntityModel{ static_cast<QAction*>(nullptr) };
 
@@ -687,6 +1158,13 @@ void MainWindowImpl::connectSignals()
 					{
 						clearErrorFlags = menu.addAction("Acknowledge Counters Errors");
 					}
+					{
+						auto const& settings = settings::SettingsManager::getInstance();
+						watchCounters = menu.addAction("Always Refresh Counters");
+						watchCounters->setCheckable(true);
+						watchCounters->setChecked(settings.getValue(settings::Controller_WatchedEntities.name).toStringList().contains(avdecc::helper::uniqueIdentifierToString(entityID)));
+						watchCounters->setEnabled(settings.getValue(settings::Controller_VisibilityDrivenNotifications.name).toBool());
+					}
 				}
 
 				menu.addSeparator();
@@ -748,6 +1226,21 @@ void MainWindowImpl::connectSignals()
 						manager.clearAllStreamInputCounterValidFlags(entityID);
 						manager.clearAllStatisticsCounterValidFlags(entityID);
 					}
+					else if (action == watchCounters)
+					{
+						auto& settings = settings::SettingsManager::getInstance();
+						auto watchedEntities = settings.getValue(settings::Controller_WatchedEntities.name).toStringList();
+						auto const entityIDString = avdecc::helper::uniqueIdentifierToString(entityID);
+						if (action->isChecked())
+						{
+							watchedEntities.append(entityIDString);
+						}
+						else
+						{
+							watchedEntities.removeAll(entityIDString);
+						}
+						settings.setValue(settings::Controller_WatchedEntities.name, watchedEntities);
+					}
 					else if (action == dumpFullEntity || action == dumpEntityModel)
 					{
 						auto baseFileName = QString{};
@@ -773,9 +1266,9 @@ void MainWindowImpl::connectSignals()
 							binaryFilterName = "AVDECC Entity Model Files (*.aem)";
 							baseFileName = QString("%1/EntityModel_%2").arg(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)).arg(avdecc::helper::uniqueIdentifierToString(entityModelID));
 						}
-						auto const dumpFile = [this, &entityID, &manager, isFullEntity = (action == dumpFullEntity)](auto const& baseFileName, auto const& binaryFilterName, auto const isBinary)
+						auto const dumpFile = [this, entityID, isFullEntity = (action == dumpFullEntity)](auto const& baseFileName, auto const& binaryFilterName)
 						{
-							auto const filename = QFileDialog::getSaveFileName(_parent, "Save As...", baseFileName, binaryFilterName);
+							auto const filename = QFileDialog::getSaveFileName(_parent, "Save As...", baseFileName, serializationFilters(binaryFilterName));
 							if (!filename.isEmpty())
 							{
 								auto flags = la::avdecc::entity::model::jsonSerializer::Flags{};
@@ -787,48 +1280,64 @@ void MainWindowImpl::connectSignals()
 								{
 									flags = la::avdecc::entity::model::jsonSerializer::Flags{ la::avdecc::entity::model::jsonSerializer::Flag::ProcessStaticModel };
 								}
-								if (isBinary)
+								if (isBinarySerializationFile(filename))
 								{
 									flags.set(la::avdecc::entity::model::jsonSerializer::Flag::BinaryFormat);
 								}
-								auto [error, message] = manager.serializeControlledEntityAsJson(entityID, filename, flags, generateDumpSourceString());
-								if (!error)
-								{
-									QMessageBox::information(_parent, "", "Export successfully completed:\n" + filename);
-								}
-								else
+								auto const serializeEntity = [entityID, filename, dumpSource = generateDumpSourceString()](la::avdecc::entity::model::jsonSerializer::Flags const flags)
 								{
-									if (error == la::avdecc::jsonSerializer::SerializationError::InvalidDescriptorIndex && isFullEntity)
+									auto& manager = avdecc::ControllerManager::getInstance();
+									return manager.serializeControlledEntityAsJson(entityID, filename, flags, dumpSource);
+								};
+								exportInBackground(
+									filename,
+									[serializeEntity, flags]()
 									{
-										auto const choice = QMessageBox::question(_parent, "", QString("EntityID %1 model is not fully IEEE1722.1 compliant.\n%2\n\nDo you want to export anyway?").arg(avdecc::helper::uniqueIdentifierToString(entityID)).arg(message.c_str()), QMessageBox::StandardButton::Yes, QMessageBox::StandardButton::No);
-										if (choice == QMessageBox::StandardButton::Yes)
+										return serializeEntity(flags);
+									},
+									[this, entityID, filename, flags, isFullEntity, serializeEntity](ExportResult const& result)
+									{
+										auto const& [error, message] = result;
+										if (!error)
+										{
+											QMessageBox::information(_parent, "", "Export successfully completed:\n" + filename);
+											return;
+										}
+
+										if (error == la::avdecc::jsonSerializer::SerializationError::InvalidDescriptorIndex && isFullEntity)
 										{
-											flags.set(la::avdecc::entity::model::jsonSerializer::Flag::IgnoreAEMSanityChecks);
-											auto const result = manager.serializeControlledEntityAsJson(entityID, filename, flags, generateDumpSourceString());
-											error = std::get<0>(result);
-											message = std::get<1>(result);
-											if (!error)
+											auto const choice = QMessageBox::question(_parent, "", QString("EntityID %1 model is not fully IEEE1722.1 compliant.\n%2\n\nDo you want to export anyway?").arg(avdecc::helper::uniqueIdentifierToString(entityID)).arg(message.c_str()), QMessageBox::StandardButton::Yes, QMessageBox::StandardButton::No);
+											if (choice == QMessageBox::StandardButton::Yes)
 											{
-												QMessageBox::information(_parent, "", "Export completed but with warnings:\n" + filename);
+												auto relaxedFlags = flags;
+												relaxedFlags.set(la::avdecc::entity::model::jsonSerializer::Flag::IgnoreAEMSanityChecks);
+												exportInBackground(
+													filename,
+													[serializeEntity, relaxedFlags]()
+													{
+														return serializeEntity(relaxedFlags);
+													},
+													[this, entityID, filename](ExportResult const& result)
+													{
+														auto const& [error, message] = result;
+														if (!error)
+														{
+															QMessageBox::information(_parent, "", "Export completed but with warnings:\n" + filename);
+														}
+														else
+														{
+															QMessageBox::warning(_parent, "", QString("Export of EntityID %1 failed:\n%2").arg(avdecc::helper::uniqueIdentifierToString(entityID)).arg(message.c_str()));
+														}
+													});
+												return;
 											}
-											// Fallthrough to warning message
 										}
-									}
-									if (!!error)
-									{
+
 										QMessageBox::warning(_parent, "", QString("Export of EntityID %1 failed:\n%2").arg(avdecc::helper::uniqueIdentifierToString(entityID)).arg(message.c_str()));
-									}
-								}
+									});
 							}
 						};
-						if (QApplication::keyboardModifiers().testFlag(Qt::ShiftModifier))
-						{
-							dumpFile(baseFileName, "JSON Files (*.json)", false);
-						}
-						else
-						{
-							dumpFile(baseFileName, binaryFilterName, true);
-						}
+						dumpFile(baseFileName, binaryFilterName);
 					}
 				}
 			}
@@ -876,34 +1385,172 @@ void MainWindowImpl::connectSignals()
 
 	//
 
-	connect(actionExportFullNetworkState, &QAction::triggered, this,
+	connect(actionSaveRoutingSnapshot, &QAction::triggered, this,
 		[this]()
 		{
-			auto filterName = QString{};
-			auto flags = la::avdecc::entity::model::jsonSerializer::Flags{ la::avdecc::entity::model::jsonSerializer::Flag::ProcessADP, la::avdecc::entity::model::jsonSerializer::Flag::ProcessCompatibility, la::avdecc::entity::model::jsonSerializer::Flag::ProcessDynamicModel, la::avdecc::entity::model::jsonSerializer::Flag::ProcessMilan, la::avdecc::entity::model::jsonSerializer::Flag::ProcessState, la::avdecc::entity::model::jsonSerializer::Flag::ProcessStaticModel, la::avdecc::entity::model::jsonSerializer::Flag::ProcessStatistics };
-			if (QApplication::keyboardModifiers().testFlag(Qt::ShiftModifier))
+			auto const filename = QFileDialog::getSaveFileName(_parent, "Save As...", QString("%1/Routing_%2").arg(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)).arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss")), "Hive Routing Snapshot Files (*.hrs)");
+			if (filename.isEmpty())
 			{
-				filterName = "JSON Files (*.json)";
+				return;
 			}
-			else
-			{
-				filterName = "AVDECC Network State Files (*.ans)";
-				flags.set(la::avdecc::entity::model::jsonSerializer::Flag::BinaryFormat);
-			}
-			auto const filename = QFileDialog::getSaveFileName(_parent, "Save As...", QString("%1/FullDump_%2").arg(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)).arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss")), filterName);
-			if (!filename.isEmpty())
+
+			auto const snapshot = avdecc::routingSnapshot::capture();
+			auto file = QFile{ filename };
+			if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(avdecc::routingSnapshot::serialize(snapshot)) < 0)
 			{
-				auto& manager = avdecc::ControllerManager::getInstance();
-				auto [error, message] = manager.serializeAllControlledEntitiesAsJson(filename, flags, generateDumpSourceString());
-				if (!error)
-				{
-					QMessageBox::information(_parent, "", "Export successfully completed:\n" + filename);
-				}
-				else
-				{
-					QMessageBox::warning(_parent, "", QString("Export failed:\n%1").arg(message.c_str()));
-				}
+				QMessageBox::warning(_parent, "", QString("Export failed:\n%1").arg(file.errorString()));
+				return;
 			}
+			QMessageBox::information(_parent, "", QString("Routing of %1 entities saved:\n%2").arg(snapshot.size()).arg(filename));
+		});
+
+	connect(actionRecallRoutingSnapshot, &QAction::triggered, this,
+		[this]()
+		{
+			auto& snapshotManager = avdecc::routingSnapshot::RoutingSnapshotManager::getInstance();
+			if (snapshotManager.isRunning())
+			{
+				QMessageBox::information(_parent, "", "A routing snapshot is already being recalled, please retry once it completed.");
+				return;
+			}
+
+			auto const filename = QFileDialog::getOpenFileName(_parent, "Open Routing Snapshot", QStandardPaths::writableLocation(QStandardPaths::DesktopLocation), "Hive Routing Snapshot Files (*.hrs)");
+			if (filename.isEmpty())
+			{
+				return;
+			}
+
+			auto file = QFile{ filename };
+			if (!file.open(QIODevice::ReadOnly))
+			{
+				QMessageBox::warning(_parent, "", QString("Failed to open %1:\n%2").arg(filename).arg(file.errorString()));
+				return;
+			}
+			auto snapshot = avdecc::routingSnapshot::Snapshot{};
+			if (auto const error = avdecc::routingSnapshot::deserialize(file.readAll(), snapshot); !error.isEmpty())
+			{
+				QMessageBox::warning(_parent, "", QString("Invalid routing snapshot %1:\n%2").arg(filename).arg(error));
+				return;
+			}
+
+			// Only listen to the result of our own recall
+			auto const connection = std::make_shared<QMetaObject::Connection>();
+			*connection = connect(&snapshotManager, &avdecc::routingSnapshot::RoutingSnapshotManager::finished, this,
+				[this, connection, snapshot](avdecc::routingSnapshot::RecallInfo const& info)
+				{
+					disconnect(*connection);
+
+					auto message = QString("Routing snapshot recalled: %1 entities changed, %2 already matching.").arg(info.changedEntities).arg(info.unchangedEntities);
+					if (!info.missingEntities.empty())
+					{
+						auto names = QStringList{};
+						for (auto const& entityID : info.missingEntities)
+						{
+							auto const it = snapshot.find(entityID);
+							names.append(it != snapshot.end() && !it->second.name.isEmpty() ? it->second.name : avdecc::helper::uniqueIdentifierToString(entityID));
+						}
+						message += QString("\n\n%1 entities of the snapshot are offline: %2").arg(names.size()).arg(names.join(", "));
+					}
+					if (!info.errors.empty())
+					{
+						auto failures = std::map<QString, size_t>{};
+						for (auto const& errorInfo : info.errors)
+						{
+							++failures[avdecc::commandChain::AsyncParallelCommandSet::errorToString(errorInfo.second.errorType)];
+						}
+						message += "\n\nFailures:\n";
+						for (auto const& [error, count] : failures)
+						{
+							message += QString("- %1 (%2 command(s))\n").arg(error).arg(count);
+						}
+						QMessageBox::warning(_parent, "", message);
+						return;
+					}
+					QMessageBox::information(_parent, "", message);
+				});
+
+			snapshotManager.recall(snapshot);
+		});
+
+	connect(actionExportFullNetworkState, &QAction::triggered, this,
+		[this]()
+		{
+			auto flags = la::avdecc::entity::model::jsonSerializer::Flags{ la::avdecc::entity::model::jsonSerializer::Flag::ProcessADP, la::avdecc::entity::model::jsonSerializer::Flag::ProcessCompatibility, la::avdecc::entity::model::jsonSerializer::Flag::ProcessDynamicModel, la::avdecc::entity::model::jsonSerializer::Flag::ProcessMilan, la::avdecc::entity::model::jsonSerializer::Flag::ProcessState, la::avdecc::entity::model::jsonSerializer::Flag::ProcessStaticModel, la::avdecc::entity::model::jsonSerializer::Flag::ProcessStatistics };
+			auto const filename = QFileDialog::getSaveFileName(_parent, "Save As...", QString("%1/FullDump_%2").arg(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)).arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss")), serializationFilters("AVDECC Network State Files (*.ans)"));
+			if (!filename.isEmpty())
+			{
+				// Snapshots are written as MessagePack unless explicitly saved as JSON
+				if (isBinarySerializationFile(filename))
+				{
+					flags.set(la::avdecc::entity::model::jsonSerializer::Flag::BinaryFormat);
+				}
+				exportInBackground(filename,
+					[filename, flags, dumpSource = generateDumpSourceString()]()
+					{
+						auto& manager = avdecc::ControllerManager::getInstance();
+						return manager.serializeAllControlledEntitiesAsJson(filename, flags, dumpSource);
+					},
+					[this, filename](ExportResult const& result)
+					{
+						auto const& [error, message] = result;
+						if (!error)
+						{
+							QMessageBox::information(_parent, "", "Export successfully completed:\n" + filename);
+						}
+						else
+						{
+							QMessageBox::warning(_parent, "", QString("Export failed:\n%1").arg(message.c_str()));
+						}
+					});
+			}
+		});
+
+	connect(actionExportConnectionMatrix, &QAction::triggered, this,
+		[this]()
+		{
+			auto const filename = QFileDialog::getSaveFileName(_parent, "Save As...", QString("%1/ConnectionMatrix_%2").arg(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)).arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss")), "CSV Files (*.csv);;PDF Files (*.pdf)");
+			if (!filename.isEmpty())
+			{
+				routingTableView->exportMatrix(filename);
+			}
+		});
+
+	connect(actionExportEnumerationTimelines, &QAction::triggered, this,
+		[this]()
+		{
+			auto const filename = QFileDialog::getSaveFileName(_parent, "Save As...", QString("%1/EnumerationTimelines_%2").arg(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)).arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss")), "CSV Files (*.csv)");
+			if (filename.isEmpty())
+			{
+				return;
+			}
+
+			auto file = QFile{ filename };
+			if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+			{
+				QMessageBox::warning(_parent, "", QString("Export failed:\n%1").arg(file.errorString()));
+				return;
+			}
+
+			auto& manager = avdecc::ControllerManager::getInstance();
+			auto stream = QTextStream{ &file };
+			stream << "EntityID,EntityModelID,Name,DiscoveredAt (ms),OnlineAt (ms),EnumerationTime (ms),QueryErrors,AecpRetries,AecpTimeouts,AecpUnexpectedResponses,AecpAverageResponseTime (ms),AemCache,FullStaticModel,Restored\n";
+			for (auto const& [entityID, timeline] : manager.getEnumerationTimelines())
+			{
+				auto name = QString{};
+				if (auto const controlledEntity = manager.getControlledEntity(entityID))
+				{
+					name = avdecc::helper::smartEntityName(*controlledEntity);
+					name.replace('"', "\"\"");
+				}
+				stream << avdecc::helper::uniqueIdentifierToString(entityID) << ',' << avdecc::helper::uniqueIdentifierToString(timeline.entityModelID) << ",\"" << name << "\"," << timeline.discoveredAt.count() << ',' << timeline.onlineAt.count() << ',' << timeline.enumerationTime.count() << ',' << timeline.queryErrors << ',' << timeline.aecpRetries << ',' << timeline.aecpTimeouts << ',' << timeline.aecpUnexpectedResponses << ',' << timeline.aecpResponseAverageTime.count() << ',' << (timeline.aemCacheEnabled ? 1 : 0) << ',' << (timeline.fullStaticModelEnabled ? 1 : 0) << ',' << (timeline.restored ? 1 : 0) << '\n';
+			}
+
+			if (stream.status() != QTextStream::Ok)
+			{
+				QMessageBox::warning(_parent, "", "Export failed:\n" + filename);
+				return;
+			}
+			QMessageBox::information(_parent, "", "Export successfully completed:\n" + filename);
 		});
 
 	//
@@ -929,6 +1576,204 @@ void MainWindowImpl::connectSignals()
 			dialog.exec();
 		});
 
+	connect(actionNetworkStatistics, &QAction::triggered, this,
+		[this]()
+		{
+			NetworkStatisticsDialog dialog{ _parent };
+			dialog.exec();
+		});
+
+	connect(actionNetworkTopology, &QAction::triggered, this,
+		[this]()
+		{
+			if (!_networkTopologyDialog)
+			{
+				_networkTopologyDialog = new NetworkTopologyDialog{ _parent };
+			}
+			_networkTopologyDialog->show();
+			_networkTopologyDialog->raise();
+			_networkTopologyDialog->activateWindow();
+		});
+
+	connect(actionGptpDomains, &QAction::triggered, this,
+		[this]()
+		{
+			GptpDomainsDialog dialog{ _parent };
+			dialog.exec();
+		});
+
+	connect(actionBatchOperations, &QAction::triggered, this,
+		[this]()
+		{
+			BatchOperationsDialog dialog{ _parent };
+			dialog.exec();
+		});
+
+	// Secondary interfaces are listed when the menu is shown, so it always matches the current interfaces
+	connect(menuSecondaryInterfaces, &QMenu::aboutToShow, this,
+		[this]()
+		{
+			menuSecondaryInterfaces->clear();
+
+			auto const currentInterfaceID = _interfaceComboBox.currentData().toString();
+			auto const secondaryInterfaceIDs = settings::SettingsManager::getInstance().getValue(settings::SecondaryInterfaceIDs).toStringList();
+			for (auto row = 0; row < _activeNetworkInterfaceModel.rowCount(); ++row)
+			{
+				auto const index = _activeNetworkInterfaceModel.index(row, 0);
+				auto const interfaceID = index.data(Qt::UserRole).toString();
+				if (interfaceID.isEmpty() || interfaceID == currentInterfaceID)
+				{
+					continue;
+				}
+
+				auto* action = menuSecondaryInterfaces->addAction(index.data(Qt::DisplayRole).toString());
+				action->setCheckable(true);
+				action->setChecked(secondaryInterfaceIDs.contains(interfaceID));
+				connect(action, &QAction::toggled, this,
+					[this, interfaceID](bool const checked)
+					{
+						auto& settings = settings::SettingsManager::getInstance();
+						auto interfaceIDs = settings.getValue(settings::SecondaryInterfaceIDs).toStringList();
+						interfaceIDs.removeAll(interfaceID);
+						if (checked)
+						{
+							interfaceIDs.append(interfaceID);
+						}
+						settings.setValue(settings::SecondaryInterfaceIDs, interfaceIDs);
+
+						// Recreate the controllers
+						currentControllerChanged();
+					});
+			}
+
+			if (menuSecondaryInterfaces->isEmpty())
+			{
+				menuSecondaryInterfaces->addAction("No other interface")->setEnabled(false);
+			}
+		});
+
+	connect(actionMainThreadLatency, &QAction::triggered, this,
+		[this]()
+		{
+			MainThreadLatencyDialog dialog{ _parent };
+			dialog.exec();
+		});
+
+	connect(actionSignalDispatchProfiler, &QAction::triggered, this,
+		[this]()
+		{
+			DispatchProfilerDialog dialog{ _parent };
+			dialog.exec();
+		});
+
+	connect(actionMemoryAccounting, &QAction::triggered, this,
+		[this]()
+		{
+			MemoryAccountingDialog dialog{ _parent };
+			dialog.exec();
+		});
+
+	connect(actionRecordHotPathTrace, &QAction::triggered, this,
+		[this](bool const checked)
+		{
+			if (checked)
+			{
+				avdecc::spanTrace::setEnabled(true);
+				return;
+			}
+
+			avdecc::spanTrace::setEnabled(false);
+			auto const filename = QFileDialog::getSaveFileName(_parent, "Save As...", QString("%1/HotPathTrace_%2").arg(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)).arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss")), "Chrome Trace Files (*.json)");
+			if (!filename.isEmpty() && !avdecc::spanTrace::exportChromeTrace(filename))
+			{
+				QMessageBox::warning(_parent, "", "Failed to export the trace to:\n" + filename);
+			}
+		});
+
+	connect(actionRecordControllerEvents, &QAction::triggered, this,
+		[this](bool const checked)
+		{
+			auto& manager = avdecc::ControllerManager::getInstance();
+			if (!checked)
+			{
+				manager.stopObserverTraceRecording();
+				return;
+			}
+
+			auto const filename = QFileDialog::getSaveFileName(_parent, "Save As...", QString("%1/ControllerEvents_%2").arg(QStandardPaths::writableLocation(QStandardPaths::DesktopLocation)).arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss")), "Controller Events Files (*.hoet)");
+			if (filename.isEmpty() || !manager.startObserverTraceRecording(filename))
+			{
+				if (!filename.isEmpty())
+				{
+					QMessageBox::warning(_parent, "", "Failed to start recording to:\n" + filename);
+				}
+				actionRecordControllerEvents->setChecked(false);
+			}
+		});
+
+	connect(actionReplayControllerEvents, &QAction::triggered, this,
+		[this]()
+		{
+			auto const filename = QFileDialog::getOpenFileName(_parent, "Open Controller Events File", QStandardPaths::writableLocation(QStandardPaths::DesktopLocation), "Controller Events Files (*.hoet)");
+			if (filename.isEmpty())
+			{
+				return;
+			}
+
+			// Events are replayed on the current controller, the matching (virtual) entities should already be loaded
+			auto const answer = QMessageBox::question(_parent, "", "Replay with the original timing?\n\nSelect 'No' to replay as fast as possible.", QMessageBox::Yes | QMessageBox::No | QMessageBox::Cancel);
+			if (answer == QMessageBox::Cancel)
+			{
+				return;
+			}
+
+			if (!avdecc::ControllerManager::getInstance().startObserverTraceReplay(filename, answer == QMessageBox::Yes))
+			{
+				QMessageBox::warning(_parent, "", "Failed to replay controller events from:\n" + filename);
+			}
+		});
+
+	connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::observerTraceReplayFinished, this,
+		[this](int const replayedCount, int const skippedCount)
+		{
+			LOG_HIVE_INFO(QString("Controller events replay finished: %1 replayed, %2 skipped").arg(replayedCount).arg(skippedCount));
+		});
+
+	connect(actionStressLoad, &QAction::triggered, this,
+		[this](bool const checked)
+		{
+			auto& manager = avdecc::ControllerManager::getInstance();
+			if (!checked)
+			{
+				manager.stopStressLoad();
+				return;
+			}
+
+			// The action is only checked while the load is running
+			actionStressLoad->setChecked(false);
+
+			auto dialog = StressLoadDialog{ _parent };
+			if (dialog.exec() != QDialog::Accepted)
+			{
+				return;
+			}
+
+			if (!manager.startStressLoad(dialog.parameters()))
+			{
+				QMessageBox::warning(_parent, "", "Failed to start the stress load, no entity to drive.");
+				return;
+			}
+			actionStressLoad->setChecked(true);
+			LOG_HIVE_INFO("Stress load started");
+		});
+
+	connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::stressLoadFinished, this,
+		[this](int const generatedCount, int const skippedCount)
+		{
+			actionStressLoad->setChecked(false);
+			LOG_HIVE_INFO(QString("Stress load finished: %1 events generated, %2 skipped").arg(generatedCount).arg(skippedCount));
+		});
+
 	//
 
 	connect(actionAbout, &QAction::triggered, this,
@@ -979,6 +1824,43 @@ void MainWindowImpl::connectSignals()
 			action->setChecked(true);
 		});
 
+	auto* quickSearch = new QShortcut{ QKeySequence{ "Ctrl+K" }, _parent };
+	connect(quickSearch, &QShortcut::activated, this,
+		[this]()
+		{
+			QuickSearchDialog dialog{ _parent };
+			connect(&dialog, &QuickSearchDialog::documentActivated, this,
+				[this](avdecc::search::Document const& document)
+				{
+					// Selecting the entity row also shows it in the inspector (the entity list filter is cleared if it hides it)
+					auto index = _controllerProxyModel.controlledEntityIndex(document.entityID);
+					if (!index.isValid() && !_entityFilterLineEdit.text().isEmpty())
+					{
+						_entityFilterLineEdit.clear();
+						index = _controllerProxyModel.controlledEntityIndex(document.entityID);
+					}
+					if (index.isValid())
+					{
+						controllerTableView->setCurrentIndex(index);
+						controllerTableView->scrollTo(index);
+					}
+
+					if (document.kind == avdecc::search::Document::Kind::StreamOutput)
+					{
+						routingTableView->focusStream(document.entityID, la::avdecc::entity::model::DescriptorType::StreamOutput, document.descriptorIndex);
+					}
+					else if (document.kind == avdecc::search::Document::Kind::StreamInput)
+					{
+						routingTableView->focusStream(document.entityID, la::avdecc::entity::model::DescriptorType::StreamInput, document.descriptorIndex);
+					}
+					else
+					{
+						routingTableView->focusEntity(document.entityID);
+					}
+				});
+			dialog.exec();
+		});
+
 #ifdef DEBUG
 	auto* reloadStyleSheet = new QShortcut{ QKeySequence{ "F5" }, _parent };
 	connect(reloadStyleSheet, &QShortcut::activated, _parent,
@@ -986,8 +1868,7 @@ void MainWindowImpl::connectSignals()
 		{
 			auto& settings = settings::SettingsManager::getInstance();
 			auto const themeColorIndex = settings.getValue(settings::General_ThemeColorIndex.name).toInt();
-			auto const colorName = qt::toolkit::material::color::Palette::name(themeColorIndex);
-			updateStyleSheet(colorName, QString{ RESOURCES_ROOT_DIR } + "/style.qss");
+			updateStyleSheet(themeColorIndex, QString{ RESOURCES_ROOT_DIR } + "/style.qss");
 			LOG_HIVE_DEBUG("StyleSheet reloaded");
 		});
 #endif
@@ -1087,23 +1968,49 @@ void MainWindow::showEvent(QShowEvent* event)
 			_pImpl->_shown = true;
 			auto& settings = settings::SettingsManager::getInstance();
 
-			// Start Sparkle
+			// The window has a native handle once shown, pre-scaled images have to follow the device pixel ratio of its screen
+			if (auto* const window = windowHandle())
 			{
-				Sparkle::getInstance().start();
+				connect(window, &QWindow::screenChanged, _pImpl,
+					[this](QScreen*)
+					{
+						_pImpl->updateControllerImageSizes();
+					});
 			}
-			// Check if we have a network interface selected
-			{
-				auto const interfaceID = _pImpl->_interfaceComboBox.currentData().toString();
-				if (interfaceID.isEmpty())
+
+			// Initialize and start Sparkle once the window is displayed, it's not needed to show the entities
+			QTimer::singleShot(0,
+				[this]()
 				{
-					// Postpone the dialog creation
-					QTimer::singleShot(0,
-						[this]()
-						{
-							QMessageBox::warning(this, "", "No Network Interface selected.\nPlease choose one in the Toolbar.");
-						});
-				}
-			}
+					QFile signatureFile(":/dsa_pub.pem");
+					if (signatureFile.open(QIODevice::ReadOnly))
+					{
+						auto content = QString(signatureFile.readAll());
+						Sparkle::getInstance().init(content.toStdString());
+					}
+
+					// Settings observers were registered before Sparkle was initialized, apply them again
+					auto& settings = settings::SettingsManager::getInstance();
+					_pImpl->onSettingChanged(settings::General_CheckForBetaVersions.name, settings.getValue(settings::General_CheckForBetaVersions.name));
+					_pImpl->onSettingChanged(settings::General_AutomaticCheckForUpdates.name, settings.getValue(settings::General_AutomaticCheckForUpdates.name));
+
+					Sparkle::getInstance().start();
+				});
+			// Check if we have a network interface selected (once the interfaces are known, the window being shown without waiting for them)
+			_pImpl->whenNetworkInterfacesEnumerated(
+				[this]()
+				{
+					auto const interfaceID = _pImpl->_interfaceComboBox.currentData().toString();
+					if (interfaceID.isEmpty())
+					{
+						// Postpone the dialog creation
+						QTimer::singleShot(0,
+							[this]()
+							{
+								QMessageBox::warning(this, "", "No Network Interface selected.\nPlease choose one in the Toolbar.");
+							});
+					}
+				});
 #ifdef _WIN32
 			// Check for WinPcap
 			{
@@ -1138,6 +2045,16 @@ void MainWindow::showEvent(QShowEvent* event)
 		});
 }
 
+void MainWindow::changeEvent(QEvent* event)
+{
+	QMainWindow::changeEvent(event);
+
+	if (event->type() == QEvent::WindowStateChange)
+	{
+		_pImpl->updateLowPowerMode();
+	}
+}
+
 void MainWindow::closeEvent(QCloseEvent* event)
 {
 	auto& settings = settings::SettingsManager::getInstance();
@@ -1166,7 +2083,7 @@ void MainWindow::dragEnterEvent(QDragEnterEvent* event)
 	{
 		auto const f = QFileInfo{ u.fileName() };
 		auto const ext = f.suffix();
-		if (ext == "ave" /* || ext == "ans"*/)
+		if (ext == "ave" || ext == "json" /* || ext == "ans"*/)
 		{
 			event->acceptProposedAction();
 			return;
@@ -1176,60 +2093,7 @@ void MainWindow::dragEnterEvent(QDragEnterEvent* event)
 
 void MainWindow::dropEvent(QDropEvent* event)
 {
-	auto& manager = avdecc::ControllerManager::getInstance();
-
-	auto const loadEntity = [&manager](auto const& filePath, auto const flags)
-	{
-		auto const [error, message] = manager.loadVirtualEntityFromJson(filePath, flags);
-		auto msg = QString{};
-		if (!!error)
-		{
-			switch (error)
-			{
-				case la::avdecc::jsonSerializer::DeserializationError::AccessDenied:
-					msg = "Access Denied";
-					break;
-				case la::avdecc::jsonSerializer::DeserializationError::FileReadError:
-					msg = "Error Reading File";
-					break;
-				case la::avdecc::jsonSerializer::DeserializationError::UnsupportedDumpVersion:
-					msg = "Unsupported Dump Version";
-					break;
-				case la::avdecc::jsonSerializer::DeserializationError::ParseError:
-					msg = QString("Parse Error: %1").arg(message.c_str());
-					break;
-				case la::avdecc::jsonSerializer::DeserializationError::MissingKey:
-					msg = QString("Missing Key: %1").arg(message.c_str());
-					break;
-				case la::avdecc::jsonSerializer::DeserializationError::InvalidKey:
-					msg = QString("Invalid Key: %1").arg(message.c_str());
-					break;
-				case la::avdecc::jsonSerializer::DeserializationError::InvalidValue:
-					msg = QString("Invalid Value: %1").arg(message.c_str());
-					break;
-				case la::avdecc::jsonSerializer::DeserializationError::OtherError:
-					msg = message.c_str();
-					break;
-				case la::avdecc::jsonSerializer::DeserializationError::DuplicateEntityID:
-					msg = QString("An Entity already exists with the same EntityID: %1").arg(message.c_str());
-					break;
-				case la::avdecc::jsonSerializer::DeserializationError::NotCompliant:
-					msg = message.c_str();
-					break;
-				case la::avdecc::jsonSerializer::DeserializationError::NotSupported:
-					msg = "Virtual Entity Loading not supported by this version of the AVDECC library";
-					break;
-				case la::avdecc::jsonSerializer::DeserializationError::InternalError:
-					msg = QString("Internal Error: %1").arg(message.c_str());
-					break;
-				default:
-					AVDECC_ASSERT(false, "Unknown Error");
-					msg = "Unknown Error";
-					break;
-			}
-		}
-		return std::make_tuple(error, msg);
-	};
+	auto filePaths = QStringList{};
 
 	for (auto const& u : event->mimeData()->urls())
 	{
@@ -1238,53 +2102,145 @@ void MainWindow::dropEvent(QDropEvent* event)
 		auto const ext = fi.suffix();
 
 		// AVDECC Virtual Entity
-		if (ext == "ave")
+		if (ext == "ave" || ext == "json")
+		{
+			filePaths << f;
+		}
+
+		// AVDECC Network State
+		//else if (ext == "ans")
+		//{
+		//}
+	}
+
+	if (filePaths.isEmpty())
+	{
+		return;
+	}
+
+	auto const errorToString = [](la::avdecc::jsonSerializer::DeserializationError const error, std::string const& message)
+	{
+		auto msg = QString{};
+		switch (error)
+		{
+			case la::avdecc::jsonSerializer::DeserializationError::AccessDenied:
+				msg = "Access Denied";
+				break;
+			case la::avdecc::jsonSerializer::DeserializationError::FileReadError:
+				msg = "Error Reading File";
+				break;
+			case la::avdecc::jsonSerializer::DeserializationError::UnsupportedDumpVersion:
+				msg = "Unsupported Dump Version";
+				break;
+			case la::avdecc::jsonSerializer::DeserializationError::ParseError:
+				msg = QString("Parse Error: %1").arg(message.c_str());
+				break;
+			case la::avdecc::jsonSerializer::DeserializationError::MissingKey:
+				msg = QString("Missing Key: %1").arg(message.c_str());
+				break;
+			case la::avdecc::jsonSerializer::DeserializationError::InvalidKey:
+				msg = QString("Invalid Key: %1").arg(message.c_str());
+				break;
+			case la::avdecc::jsonSerializer::DeserializationError::InvalidValue:
+				msg = QString("Invalid Value: %1").arg(message.c_str());
+				break;
+			case la::avdecc::jsonSerializer::DeserializationError::OtherError:
+				msg = message.c_str();
+				break;
+			case la::avdecc::jsonSerializer::DeserializationError::DuplicateEntityID:
+				msg = QString("An Entity already exists with the same EntityID: %1").arg(message.c_str());
+				break;
+			case la::avdecc::jsonSerializer::DeserializationError::NotCompliant:
+				msg = message.c_str();
+				break;
+			case la::avdecc::jsonSerializer::DeserializationError::NotSupported:
+				msg = "Virtual Entity Loading not supported by this version of the AVDECC library";
+				break;
+			case la::avdecc::jsonSerializer::DeserializationError::InternalError:
+				msg = QString("Internal Error: %1").arg(message.c_str());
+				break;
+			default:
+				AVDECC_ASSERT(false, "Unknown Error");
+				msg = "Unknown Error";
+				break;
+		}
+		return msg;
+	};
+
+	auto const reportErrors = [this, errorToString](std::vector<avdecc::ControllerManager::LoadVirtualEntityResult> const& results)
+	{
+		auto errors = QStringList{};
+		for (auto const& [filePath, error, message] : results)
 		{
-			auto flags = la::avdecc::entity::model::jsonSerializer::Flags{ la::avdecc::entity::model::jsonSerializer::Flag::ProcessADP, la::avdecc::entity::model::jsonSerializer::Flag::ProcessCompatibility, la::avdecc::entity::model::jsonSerializer::Flag::ProcessDynamicModel, la::avdecc::entity::model::jsonSerializer::Flag::ProcessMilan, la::avdecc::entity::model::jsonSerializer::Flag::ProcessState, la::avdecc::entity::model::jsonSerializer::Flag::ProcessStaticModel, la::avdecc::entity::model::jsonSerializer::Flag::ProcessStatistics };
-			flags.set(la::avdecc::entity::model::jsonSerializer::Flag::BinaryFormat);
-			auto [error, message] = loadEntity(u.toLocalFile(), flags);
 			if (!!error)
 			{
+				errors << QString("Error loading JSON file '%1':\n%2").arg(filePath).arg(errorToString(error, message));
+			}
+		}
+		if (!errors.isEmpty())
+		{
+			QMessageBox::warning(this, "Failed to load JSON entity", errors.join("\n\n"));
+		}
+	};
+
+	// All files are loaded in parallel (the binary format being selected from the file extension), and reported at once
+	auto const flags = la::avdecc::entity::model::jsonSerializer::Flags{ la::avdecc::entity::model::jsonSerializer::Flag::ProcessADP, la::avdecc::entity::model::jsonSerializer::Flag::ProcessCompatibility, la::avdecc::entity::model::jsonSerializer::Flag::ProcessDynamicModel, la::avdecc::entity::model::jsonSerializer::Flag::ProcessMilan, la::avdecc::entity::model::jsonSerializer::Flag::ProcessState, la::avdecc::entity::model::jsonSerializer::Flag::ProcessStaticModel, la::avdecc::entity::model::jsonSerializer::Flag::ProcessStatistics };
+	auto& manager = avdecc::ControllerManager::getInstance();
+	manager.loadVirtualEntitiesFromFiles(filePaths, flags,
+		[this, flags, reportErrors](std::vector<avdecc::ControllerManager::LoadVirtualEntityResult> const& results)
+		{
+			auto failedResults = std::vector<avdecc::ControllerManager::LoadVirtualEntityResult>{};
+			auto notCompliantFilePaths = QStringList{};
+			for (auto const& result : results)
+			{
+				auto const error = std::get<1>(result);
 				if (error == la::avdecc::jsonSerializer::DeserializationError::NotCompliant)
 				{
-					auto const choice = QMessageBox::question(this, "", "Entity model is not fully IEEE1722.1 compliant.\n\nDo you want to import anyway?", QMessageBox::StandardButton::Yes, QMessageBox::StandardButton::No);
-					if (choice == QMessageBox::StandardButton::Yes)
-					{
-						flags.set(la::avdecc::entity::model::jsonSerializer::Flag::IgnoreAEMSanityChecks);
-						auto const result = loadEntity(u.toLocalFile(), flags);
-						error = std::get<0>(result);
-						message = std::get<1>(result);
-						// Fallthrough to warning message
-					}
+					notCompliantFilePaths << std::get<0>(result);
 				}
-				if (!!error)
+				else if (!!error)
 				{
-					QMessageBox::warning(this, "Failed to load JSON entity", QString("Error loading JSON file '%1':\n%2").arg(f).arg(message));
+					failedResults.push_back(result);
 				}
 			}
-		}
 
-		// AVDECC Network State
-		//else if (ext == "ans")
-		//{
-		//}
-	}
-}
+			if (!notCompliantFilePaths.isEmpty())
+			{
+				auto const question = notCompliantFilePaths.size() == 1 ? QString("Entity model is not fully IEEE1722.1 compliant.\n\nDo you want to import anyway?") : QString("%1 entity models are not fully IEEE1722.1 compliant.\n\nDo you want to import them anyway?").arg(notCompliantFilePaths.size());
+				auto const choice = QMessageBox::question(this, "", question, QMessageBox::StandardButton::Yes, QMessageBox::StandardButton::No);
+				if (choice == QMessageBox::StandardButton::Yes)
+				{
+					auto relaxedFlags = flags;
+					relaxedFlags.set(la::avdecc::entity::model::jsonSerializer::Flag::IgnoreAEMSanityChecks);
+					auto& manager = avdecc::ControllerManager::getInstance();
+					manager.loadVirtualEntitiesFromFiles(notCompliantFilePaths, relaxedFlags,
+						[failedResults, reportErrors](std::vector<avdecc::ControllerManager::LoadVirtualEntityResult> const& relaxedResults)
+						{
+							auto allResults = failedResults;
+							allResults.insert(allResults.end(), relaxedResults.begin(), relaxedResults.end());
+							reportErrors(allResults);
+						});
+					return;
+				}
 
-void MainWindowImpl::updateStyleSheet(qt::toolkit::material::color::Name const colorName, QString const& filename)
-{
-	auto const baseBackgroundColor = qt::toolkit::material::color::value(colorName);
-	auto const baseForegroundColor = QColor{ qt::toolkit::material::color::luminance(colorName) == qt::toolkit::material::color::Luminance::Dark ? Qt::white : Qt::black };
-	auto const connectionMatrixBackgroundColor = qt::toolkit::material::color::value(colorName, qt::toolkit::material::color::Shade::Shade100);
+				// Report the refused ones too
+				for (auto const& result : results)
+				{
+					if (std::get<1>(result) == la::avdecc::jsonSerializer::DeserializationError::NotCompliant)
+					{
+						failedResults.push_back(result);
+					}
+				}
+			}
 
-	// Load and apply the stylesheet
-	auto styleFile = QFile{ filename };
-	if (styleFile.open(QFile::ReadOnly))
-	{
-		auto const styleSheet = QString{ styleFile.readAll() }.arg(baseBackgroundColor.name()).arg(baseForegroundColor.name()).arg(connectionMatrixBackgroundColor.name());
+			reportErrors(failedResults);
+		});
+}
 
-		qApp->setStyleSheet(styleSheet);
-	}
+void MainWindowImpl::updateStyleSheet(int const themeColorIndex, QString const& filename)
+{
+	// Already applied before the widgets were created (startup), only theme changes actually repolish them
+	styleSheetCache::apply(themeColorIndex, filename);
 }
 
 QString MainWindowImpl::generateDumpSourceString() noexcept
@@ -1294,6 +2250,59 @@ QString MainWindowImpl::generateDumpSourceString() noexcept
 	return s_DumpSource;
 }
 
+void MainWindowImpl::exportInBackground(QString const& filename, ExportFunction const& exportFunction, ExportCompletionHandler const& completionHandler) noexcept
+{
+	if (_isExporting)
+	{
+		QMessageBox::warning(_parent, "", "An export is already in progress, please wait for it to complete.");
+		return;
+	}
+
+	// The previous export is over (its completion has been processed), release its thread
+	if (_exportThread.joinable())
+	{
+		_exportThread.join();
+	}
+
+	// Only shown if the export takes some time
+	auto* progressDialog = new QProgressDialog{ QString("Exporting %1...").arg(QFileInfo{ filename }.fileName()), "Cancel", 0, 0, _parent };
+	progressDialog->setWindowModality(Qt::WindowModal);
+	progressDialog->setMinimumDuration(500);
+	progressDialog->setValue(0);
+
+	// The serialization itself cannot be interrupted, cancelling releases the UI right away and the file is discarded once written
+	auto const cancelled = std::make_shared<std::atomic_bool>(false);
+	connect(progressDialog, &QProgressDialog::canceled, progressDialog,
+		[cancelled]()
+		{
+			*cancelled = true;
+		});
+
+	_isExporting = true;
+	_exportThread = std::thread{
+		[this, filename, exportFunction, completionHandler, cancelled, progressDialog]()
+		{
+			auto const result = exportFunction();
+
+			QMetaObject::invokeMethod(this,
+				[this, filename, completionHandler, cancelled, progressDialog, result]()
+				{
+					_isExporting = false;
+					progressDialog->hide();
+					progressDialog->deleteLater();
+
+					if (*cancelled)
+					{
+						QFile::remove(filename);
+						return;
+					}
+
+					completionHandler(result);
+				});
+		}
+	};
+}
+
 void MainWindowImpl::onSettingChanged(settings::SettingsManager::Setting const& name, QVariant const& value) noexcept
 {
 	if (name == settings::Network_ProtocolType.name)
@@ -1309,8 +2318,7 @@ void MainWindowImpl::onSettingChanged(settings::SettingsManager::Setting const&
 	}
 	else if (name == settings::General_ThemeColorIndex.name)
 	{
-		auto const colorName = qt::toolkit::material::color::Palette::name(value.toInt());
-		updateStyleSheet(colorName, ":/style.qss");
+		updateStyleSheet(value.toInt(), ":/style.qss");
 	}
 	else if (name == settings::General_AutomaticCheckForUpdates.name)
 	{
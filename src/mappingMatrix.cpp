@@ -0,0 +1,319 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mappingMatrix.hpp"
+#include "toolkit/graph/type.hpp"
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <QHelpEvent>
+#include <QScrollBar>
+#include <QToolTip>
+
+#include <algorithm>
+
+namespace mappingMatrix
+{
+static constexpr auto CellSize = 20;
+static constexpr auto HeaderPadding = 6;
+
+MappingGrid::MappingGrid(Outputs const& outputs, Inputs const& inputs, Connections const& connections, QWidget* parent)
+	: QAbstractScrollArea{ parent }
+{
+	// Flattens the sockets of the nodes, returning the index of the first slot of each node
+	auto const flatten = [](Nodes const& nodes, Slots& slots)
+	{
+		auto firstSlotOfNode = std::vector<size_t>{};
+		firstSlotOfNode.reserve(nodes.size());
+		for (auto nodeIndex = size_t{ 0u }; nodeIndex < nodes.size(); ++nodeIndex)
+		{
+			auto const& node = nodes[nodeIndex];
+			auto const nodeName = QString::fromStdString(node.name);
+			firstSlotOfNode.push_back(slots.size());
+			for (auto socketIndex = size_t{ 0u }; socketIndex < node.sockets.size(); ++socketIndex)
+			{
+				slots.push_back(Slot{ SlotID{ nodeIndex, socketIndex }, QString("%1: %2").arg(nodeName).arg(QString::fromStdString(node.sockets[socketIndex])), socketIndex == 0u });
+			}
+		}
+		return firstSlotOfNode;
+	};
+
+	auto const firstRowOfNode = flatten(outputs, _rows);
+	auto const firstColumnOfNode = flatten(inputs, _columns);
+
+	// Compact storage of the connections, an input accepting a single connection
+	_columnConnection.assign(_columns.size(), -1);
+	auto const toFlatIndex = [](std::vector<size_t> const& firstSlotOfNode, Slots const& slots, SlotID const& slotID) -> std::optional<int>
+	{
+		if (slotID.first < firstSlotOfNode.size())
+		{
+			auto const index = firstSlotOfNode[slotID.first] + slotID.second;
+			if (index < slots.size() && slots[index].slotID == slotID)
+			{
+				return static_cast<int>(index);
+			}
+		}
+		return {};
+	};
+	for (auto const& [outputSlot, inputSlot] : connections)
+	{
+		auto const row = toFlatIndex(firstRowOfNode, _rows, outputSlot);
+		auto const column = toFlatIndex(firstColumnOfNode, _columns, inputSlot);
+		if (row && column)
+		{
+			_columnConnection[*column] = *row;
+		}
+	}
+
+	// Headers size, computed once
+	auto const fm = fontMetrics();
+	for (auto const& row : _rows)
+	{
+		_rowHeaderWidth = std::max(_rowHeaderWidth, fm.width(row.label));
+	}
+	for (auto const& column : _columns)
+	{
+		_columnHeaderHeight = std::max(_columnHeaderHeight, fm.width(column.label));
+	}
+	_rowHeaderWidth += HeaderPadding * 2;
+	_columnHeaderHeight += HeaderPadding * 2;
+
+	viewport()->setMouseTracking(true);
+	horizontalScrollBar()->setSingleStep(CellSize);
+	verticalScrollBar()->setSingleStep(CellSize);
+
+	// Default size showing as many cells as possible, up to a reasonable window
+	resize(std::min(_rowHeaderWidth + static_cast<int>(_columns.size()) * CellSize, 1200) + 2 * frameWidth(), std::min(_columnHeaderHeight + static_cast<int>(_rows.size()) * CellSize, 800) + 2 * frameWidth());
+
+	updateScrollBars();
+}
+
+Connections MappingGrid::connections() const
+{
+	auto connections = Connections{};
+
+	for (auto column = size_t{ 0u }; column < _columnConnection.size(); ++column)
+	{
+		auto const row = _columnConnection[column];
+		if (row != -1)
+		{
+			connections.emplace_back(_rows[row].slotID, _columns[column].slotID);
+		}
+	}
+
+	return connections;
+}
+
+void MappingGrid::paintEvent(QPaintEvent* event)
+{
+	auto painter = QPainter{ viewport() };
+	auto const& dirtyRect = event->rect();
+	auto const scrollX = horizontalScrollBar()->value();
+	auto const scrollY = verticalScrollBar()->value();
+	auto const rowsCount = static_cast<int>(_rows.size());
+	auto const columnsCount = static_cast<int>(_columns.size());
+
+	painter.fillRect(dirtyRect, palette().color(QPalette::Base));
+
+	// Only the visible cells are considered
+	auto const firstRow = std::max(0, (dirtyRect.top() - _columnHeaderHeight + scrollY) / CellSize);
+	auto const lastRow = std::min(rowsCount - 1, (dirtyRect.bottom() - _columnHeaderHeight + scrollY) / CellSize);
+	auto const firstColumn = std::max(0, (dirtyRect.left() - _rowHeaderWidth + scrollX) / CellSize);
+	auto const lastColumn = std::min(columnsCount - 1, (dirtyRect.right() - _rowHeaderWidth + scrollX) / CellSize);
+
+	auto const cellRect = [this, scrollX, scrollY](int const row, int const column)
+	{
+		return QRect{ _rowHeaderWidth + column * CellSize - scrollX, _columnHeaderHeight + row * CellSize - scrollY, CellSize, CellSize };
+	};
+
+	// Cells
+	auto const gridColor = palette().color(QPalette::Mid);
+	auto const hoverColor = palette().color(QPalette::AlternateBase);
+	for (auto row = firstRow; row <= lastRow; ++row)
+	{
+		for (auto column = firstColumn; column <= lastColumn; ++column)
+		{
+			auto const rect = cellRect(row, column);
+
+			if (_hoveredCell && (_hoveredCell->first == row || _hoveredCell->second == column))
+			{
+				painter.fillRect(rect, hoverColor);
+			}
+
+			painter.setPen(gridColor);
+			painter.setBrush(Qt::NoBrush);
+			painter.drawRect(rect.adjusted(0, 0, -1, -1));
+
+			if (_columnConnection[column] == row)
+			{
+				painter.setPen(Qt::NoPen);
+				painter.setBrush(graph::InputSocketColor);
+				painter.drawEllipse(rect.adjusted(4, 4, -4, -4));
+			}
+		}
+	}
+
+	// Nodes separators
+	painter.setPen(QPen{ graph::NodeItemColor, 2 });
+	for (auto row = firstRow; row <= lastRow; ++row)
+	{
+		if (_rows[row].isFirstOfNode)
+		{
+			auto const y = cellRect(row, 0).top();
+			painter.drawLine(0, y, viewport()->width(), y);
+		}
+	}
+	for (auto column = firstColumn; column <= lastColumn; ++column)
+	{
+		if (_columns[column].isFirstOfNode)
+		{
+			auto const x = cellRect(0, column).left();
+			painter.drawLine(x, 0, x, viewport()->height());
+		}
+	}
+
+	// Headers, painted over the cells so they don't scroll away
+	auto const headerColor = palette().color(QPalette::Window);
+	auto const textColor = palette().color(QPalette::WindowText);
+
+	painter.fillRect(QRect{ 0, _columnHeaderHeight, _rowHeaderWidth, viewport()->height() }, headerColor);
+	for (auto row = firstRow; row <= lastRow; ++row)
+	{
+		auto const rect = QRect{ HeaderPadding, cellRect(row, 0).top(), _rowHeaderWidth - HeaderPadding * 2, CellSize };
+		painter.setPen(_hoveredCell && _hoveredCell->first == row ? graph::OutputSocketColor : textColor);
+		painter.drawText(rect, Qt::AlignVCenter | Qt::AlignRight, _rows[row].label);
+	}
+
+	painter.fillRect(QRect{ _rowHeaderWidth, 0, viewport()->width(), _columnHeaderHeight }, headerColor);
+	painter.save();
+	painter.rotate(-90);
+	for (auto column = firstColumn; column <= lastColumn; ++column)
+	{
+		// Rotated coordinates: x goes up, y goes right
+		auto const rect = QRect{ -_columnHeaderHeight + HeaderPadding, cellRect(0, column).left(), _columnHeaderHeight - HeaderPadding * 2, CellSize };
+		painter.setPen(_hoveredCell && _hoveredCell->second == column ? graph::InputSocketColor : textColor);
+		painter.drawText(rect, Qt::AlignVCenter | Qt::AlignLeft, _columns[column].label);
+	}
+	painter.restore();
+
+	painter.fillRect(QRect{ 0, 0, _rowHeaderWidth, _columnHeaderHeight }, headerColor);
+}
+
+void MappingGrid::resizeEvent(QResizeEvent* event)
+{
+	QAbstractScrollArea::resizeEvent(event);
+	updateScrollBars();
+}
+
+void MappingGrid::mousePressEvent(QMouseEvent* event)
+{
+	if (event->button() == Qt::LeftButton)
+	{
+		if (auto const cell = cellAt(event->pos()))
+		{
+			auto const [row, column] = *cell;
+			auto& connectedRow = _columnConnection[column];
+
+			// Toggle the connection, replacing the one already connected to the input
+			connectedRow = connectedRow == row ? -1 : row;
+
+			viewport()->update();
+			return;
+		}
+	}
+
+	QAbstractScrollArea::mousePressEvent(event);
+}
+
+void MappingGrid::mouseMoveEvent(QMouseEvent* event)
+{
+	setHoveredCell(cellAt(event->pos()));
+
+	QAbstractScrollArea::mouseMoveEvent(event);
+}
+
+void MappingGrid::leaveEvent(QEvent* event)
+{
+	setHoveredCell({});
+
+	QAbstractScrollArea::leaveEvent(event);
+}
+
+bool MappingGrid::viewportEvent(QEvent* event)
+{
+	if (event->type() == QEvent::ToolTip)
+	{
+		auto* helpEvent = static_cast<QHelpEvent*>(event);
+		if (auto const cell = cellAt(helpEvent->pos()))
+		{
+			QToolTip::showText(helpEvent->globalPos(), QString("%1 -> %2").arg(_rows[cell->first].label).arg(_columns[cell->second].label), viewport());
+		}
+		else
+		{
+			QToolTip::hideText();
+			event->ignore();
+		}
+		return true;
+	}
+
+	return QAbstractScrollArea::viewportEvent(event);
+}
+
+void MappingGrid::updateScrollBars()
+{
+	auto const viewportSize = viewport()->size();
+	auto const contentWidth = _rowHeaderWidth + static_cast<int>(_columns.size()) * CellSize;
+	auto const contentHeight = _columnHeaderHeight + static_cast<int>(_rows.size()) * CellSize;
+
+	horizontalScrollBar()->setPageStep(viewportSize.width());
+	horizontalScrollBar()->setRange(0, std::max(0, contentWidth - viewportSize.width()));
+	verticalScrollBar()->setPageStep(viewportSize.height());
+	verticalScrollBar()->setRange(0, std::max(0, contentHeight - viewportSize.height()));
+}
+
+std::optional<MappingGrid::Cell> MappingGrid::cellAt(QPoint const& pos) const
+{
+	auto const x = pos.x() - _rowHeaderWidth;
+	auto const y = pos.y() - _columnHeaderHeight;
+	if (x < 0 || y < 0)
+	{
+		return {};
+	}
+
+	auto const column = (x + horizontalScrollBar()->value()) / CellSize;
+	auto const row = (y + verticalScrollBar()->value()) / CellSize;
+	if (row >= static_cast<int>(_rows.size()) || column >= static_cast<int>(_columns.size()))
+	{
+		return {};
+	}
+
+	return Cell{ row, column };
+}
+
+void MappingGrid::setHoveredCell(std::optional<Cell> const& cell)
+{
+	if (cell != _hoveredCell)
+	{
+		_hoveredCell = cell;
+		viewport()->update();
+	}
+}
+
+} // namespace mappingMatrix
@@ -22,10 +22,12 @@
 #include <QPushButton>
 #include <QDialog>
 #include <QGridLayout>
+#include <QAbstractScrollArea>
 
 #include <utility>
 #include <vector>
 #include <string>
+#include <optional>
 #include "toolkit/graph/view.hpp"
 #include "toolkit/graph/node.hpp"
 #include "toolkit/graph/inputSocket.hpp"
@@ -175,22 +177,92 @@ private:
 	Connections _connections;
 };
 
+/*
+	Lightweight alternative to MappingMatrix, for nodes with a lot of sockets.
+	Outputs sockets are the rows, inputs sockets the columns, a connection being a filled cell:
+
+	              Input Node 0  Input Node 1
+	              S0  S1  S2    S0  S1
+	Out 0: S0   | X |   |   || |   |
+	Out 0: S1   |   | X |   || |   |
+	Out 1: S0   |   |   |   || | X |
+
+	No item is created per socket or connection: only the visible cells are painted, and hit testing is computed from the cell size.
+	As with MappingMatrix, an input socket accepts a single connection.
+*/
+class MappingGrid : public QAbstractScrollArea
+{
+public:
+	MappingGrid(Outputs const& outputs, Inputs const& inputs, Connections const& connections, QWidget* parent = nullptr);
+
+	Connections connections() const;
+
+private:
+	struct Slot
+	{
+		SlotID slotID{};
+		QString label{};
+		bool isFirstOfNode{ false };
+	};
+	using Slots = std::vector<Slot>;
+	using Cell = std::pair<int, int>; // Pair of "Row", "Column"
+
+	// QAbstractScrollArea overrides
+	virtual void paintEvent(QPaintEvent* event) override;
+	virtual void resizeEvent(QResizeEvent* event) override;
+	virtual void mousePressEvent(QMouseEvent* event) override;
+	virtual void mouseMoveEvent(QMouseEvent* event) override;
+	virtual void leaveEvent(QEvent* event) override;
+	virtual bool viewportEvent(QEvent* event) override;
+
+	void updateScrollBars();
+	std::optional<Cell> cellAt(QPoint const& pos) const;
+	void setHoveredCell(std::optional<Cell> const& cell);
+
+	Slots _rows{}; // One per output socket
+	Slots _columns{}; // One per input socket
+	std::vector<int> _columnConnection{}; // Row connected to each column, -1 if not connected
+	int _rowHeaderWidth{ 0 };
+	int _columnHeaderHeight{ 0 };
+	std::optional<Cell> _hoveredCell{};
+};
+
 class MappingMatrixDialog : public QDialog
 {
 public:
+	static constexpr auto MappingGridSocketsThreshold = size_t{ 64u }; // Above this number of sockets (outputs or inputs), the MappingGrid is used instead of the MappingMatrix
+
 	MappingMatrixDialog(QString const& title, Outputs const& outputs, Inputs const& inputs, Connections const& connections, QWidget* parent = nullptr)
 #ifdef Q_OS_WIN32
 		: QDialog(parent, Qt::Dialog | Qt::WindowSystemMenuHint | Qt::WindowTitleHint | Qt::WindowCloseButtonHint) // Because Qt::Tool is ugly on windows and '?' needs to be hidden (currently not supported)
 #else
 		: QDialog(parent, Qt::Tool | Qt::WindowSystemMenuHint | Qt::WindowTitleHint | Qt::WindowCloseButtonHint)
 #endif
-		, _mappingMatrix{ outputs, inputs, connections, this }
 	{
 		setWindowTitle(title);
 
 		auto* layout = new QGridLayout{ this };
 
-		layout->addWidget(&_mappingMatrix, 0, 0, 1, 2);
+		auto const countSockets = [](Nodes const& nodes)
+		{
+			auto count = size_t{ 0u };
+			for (auto const& node : nodes)
+			{
+				count += node.sockets.size();
+			}
+			return count;
+		};
+
+		if (countSockets(outputs) > MappingGridSocketsThreshold || countSockets(inputs) > MappingGridSocketsThreshold)
+		{
+			_mappingGrid = new MappingGrid{ outputs, inputs, connections, this };
+			layout->addWidget(_mappingGrid, 0, 0, 1, 2);
+		}
+		else
+		{
+			_mappingMatrix = new MappingMatrix{ outputs, inputs, connections, this };
+			layout->addWidget(_mappingMatrix, 0, 0, 1, 2);
+		}
 		layout->addWidget(&_applyButton, 1, 0);
 		layout->addWidget(&_cancelButton, 1, 1);
 
@@ -198,13 +270,18 @@ public:
 		connect(&_cancelButton, &QPushButton::clicked, this, &QDialog::reject);
 	}
 
-	Connections const& connections() const
+	Connections connections() const
 	{
-		return _mappingMatrix.connections();
+		if (_mappingGrid)
+		{
+			return _mappingGrid->connections();
+		}
+		return _mappingMatrix->connections();
 	}
 
 private:
-	MappingMatrix _mappingMatrix;
+	MappingMatrix* _mappingMatrix{ nullptr };
+	MappingGrid* _mappingGrid{ nullptr };
 	QPushButton _applyButton{ "Apply", this };
 	QPushButton _cancelButton{ "Cancel", this };
 };
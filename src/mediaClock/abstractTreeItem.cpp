@@ -106,6 +106,28 @@ bool AbstractTreeItem::removeChildAt(int row)
 	return false;
 }
 
+/**
+* Inserts an item at the row, this item becoming its parent.
+*/
+void AbstractTreeItem::insertChild(int row, AbstractTreeItem* item)
+{
+	item->m_parentItem = this;
+	m_childItems.insert(row, item);
+}
+
+/**
+* Removes the child at the row without deleting it.
+* @return Null or the removed item, the caller taking ownership.
+*/
+AbstractTreeItem* AbstractTreeItem::takeChildAt(int row)
+{
+	if (m_childItems.size() <= row)
+	{
+		return nullptr;
+	}
+	return m_childItems.takeAt(row);
+}
+
 /**
 * Gets the child item model at a row.
 * @return Null or the AbstractTreeItem pointer.
@@ -55,6 +55,8 @@ public:
 	virtual AbstractTreeItem* parentItem();
 	virtual int indexOf(AbstractTreeItem* child) const;
 	virtual bool removeChildAt(int row);
+	virtual void insertChild(int row, AbstractTreeItem* item);
+	virtual AbstractTreeItem* takeChildAt(int row);
 	virtual AbstractTreeItem* childAt(int row);
 	virtual TreeItemType type() const = 0;
 
@@ -34,6 +34,15 @@ DomainTreeItem::DomainTreeItem(avdecc::mediaClock::MCDomain const& data, Abstrac
 	m_sampleRateSet = false;
 }
 
+/**
+* Replaces the domain object, as if the item was just created.
+*/
+void DomainTreeItem::setDomain(avdecc::mediaClock::MCDomain const& data)
+{
+	m_itemData = data;
+	m_sampleRateSet = false;
+}
+
 /**
 * Gets the domain object.
 */
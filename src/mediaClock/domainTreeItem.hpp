@@ -42,6 +42,7 @@ public:
 	explicit DomainTreeItem(avdecc::mediaClock::MCDomain const& data, AbstractTreeItem* parentItem = 0);
 
 	virtual avdecc::mediaClock::MCDomain& domain();
+	void setDomain(avdecc::mediaClock::MCDomain const& data);
 	QList<QPair<std::optional<la::avdecc::entity::model::SamplingRate>, QString>> sampleRates() const;
 	QPair<std::optional<la::avdecc::entity::model::SamplingRate>, QString> domainSamplingRate() const;
 	void setDomainSamplingRate(la::avdecc::entity::model::SamplingRate sampleRate);
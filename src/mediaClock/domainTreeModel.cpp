@@ -30,6 +30,10 @@
 #include <QJsonArray>
 #include <QToolTip>
 
+#include <algorithm>
+#include <map>
+#include <set>
+
 #include "mediaClock/domainTreeModel.hpp"
 #include "avdecc/mcDomainManager.hpp"
 #include "mediaClock/domainTreeDomainNameDelegate.hpp"
@@ -127,35 +131,146 @@ DomainTreeModelPrivate::~DomainTreeModelPrivate()
 
 /**
 * Sets the data this model operates on.
+* The tree is updated in place (rows inserted, removed or moved to another domain) instead of being rebuilt, so views keep their expansion state, selection and editors.
 * @param domains The model.
 */
 void DomainTreeModelPrivate::setMediaClockDomainModel(avdecc::mediaClock::MCEntityDomainMapping const& domains)
 {
 	Q_Q(DomainTreeModel);
-	q->beginResetModel();
-	delete _rootItem; // delete all items in the tree.
-	_rootItem = new RootTreeItem();
-	q->endResetModel();
-
 	auto domainModel = domains;
+	auto const& newDomains = domainModel.getMediaClockDomains();
+	auto const lastColumn = static_cast<int>(DomainTreeModelColumn::MediaClockMaster);
 
-	for (auto& domainKV : domainModel.getMediaClockDomains())
+	// entities each domain has to list
+	auto wantedEntities = std::map<avdecc::mediaClock::DomainIndex, std::set<la::avdecc::UniqueIdentifier>>{};
+	for (auto const& entityDomainKV : domainModel.getEntityMediaClockMasterMappings())
 	{
-		_rootItem->appendChild(new DomainTreeItem(domainKV.second, _rootItem));
+		for (auto const domainIndex : entityDomainKV.second)
+		{
+			if (newDomains.count(domainIndex) != 0)
+			{
+				wantedEntities[domainIndex].insert(entityDomainKV.first);
+			}
+		}
 	}
 
-	auto const childCount = _rootItem->childCount();
-	for (auto& entityDomainKV : domainModel.getEntityMediaClockMasterMappings())
+	// update the domains that are kept, new ones are appended sorted by index
+	auto addedDomains = std::set<avdecc::mediaClock::DomainIndex>{};
+	for (auto const& domainKV : newDomains)
 	{
-		for (auto i = 0; i < childCount; ++i)
+		auto* domainTreeItem = _rootItem->findDomainWithIndex(domainKV.first);
+		if (!domainTreeItem)
+		{
+			addedDomains.insert(domainKV.first);
+			continue;
+		}
+
+		auto& domain = domainTreeItem->domain();
+		if (domain.getMediaClockDomainMaster() != domainKV.second.getMediaClockDomainMaster() || domain.getDomainSamplingRate() != domainKV.second.getDomainSamplingRate())
+		{
+			domainTreeItem->setDomain(domainKV.second);
+
+			// the entity rows display the mc master of their domain
+			auto const row = domainTreeItem->row();
+			auto const domainModelIndex = index(row, 0, QModelIndex());
+			emit q->dataChanged(domainModelIndex, index(row, lastColumn, QModelIndex()));
+			if (domainTreeItem->childCount() > 0)
+			{
+				emit q->dataChanged(index(0, 0, domainModelIndex), index(domainTreeItem->childCount() - 1, lastColumn, domainModelIndex));
+			}
+		}
+	}
+	if (!addedDomains.empty())
+	{
+		auto const firstRow = _rootItem->childCount();
+		q->beginInsertRows(QModelIndex(), firstRow, firstRow + static_cast<int>(addedDomains.size()) - 1);
+		for (auto const domainIndex : addedDomains)
+		{
+			_rootItem->appendChild(new DomainTreeItem(newDomains.at(domainIndex), _rootItem));
+		}
+		q->endInsertRows();
+	}
+
+	// entities each domain lists but does not have yet
+	auto missingEntities = wantedEntities;
+	auto const domainCount = _rootItem->childCount();
+	for (auto domainRow = 0; domainRow < domainCount; ++domainRow)
+	{
+		auto* domainTreeItem = static_cast<DomainTreeItem*>(_rootItem->childAt(domainRow));
+		auto& missing = missingEntities[domainTreeItem->domain().getDomainIndex()];
+		for (auto entityRow = 0; entityRow < domainTreeItem->childCount(); ++entityRow)
+		{
+			missing.erase(static_cast<EntityTreeItem*>(domainTreeItem->childAt(entityRow))->entityId());
+		}
+	}
+
+	// entities no longer listed in a domain are moved to a domain missing them (the view keeps the state of the row), or removed
+	for (auto domainRow = 0; domainRow < domainCount; ++domainRow)
+	{
+		auto* domainTreeItem = static_cast<DomainTreeItem*>(_rootItem->childAt(domainRow));
+		auto const& wanted = wantedEntities[domainTreeItem->domain().getDomainIndex()];
+		auto kept = std::set<la::avdecc::UniqueIdentifier>{};
+		auto const domainModelIndex = index(domainRow, 0, QModelIndex());
+
+		for (auto entityRow = domainTreeItem->childCount() - 1; entityRow >= 0; --entityRow)
 		{
-			auto* domainTreeItem = ((DomainTreeItem*)_rootItem->child(i));
-			if (std::find(entityDomainKV.second.begin(), entityDomainKV.second.end(), domainTreeItem->domain().getDomainIndex()) != entityDomainKV.second.end())
+			auto const entityId = static_cast<EntityTreeItem*>(domainTreeItem->childAt(entityRow))->entityId();
+			if (wanted.count(entityId) != 0 && kept.insert(entityId).second)
 			{
-				domainTreeItem->appendChild(new EntityTreeItem(entityDomainKV.first, domainTreeItem));
+				continue;
+			}
+
+			auto const destinationIt = std::find_if(missingEntities.begin(), missingEntities.end(),
+				[&entityId](auto const& missingKV)
+				{
+					return missingKV.second.count(entityId) != 0;
+				});
+			if (destinationIt != missingEntities.end())
+			{
+				destinationIt->second.erase(entityId);
+				auto* destinationTreeItem = _rootItem->findDomainWithIndex(destinationIt->first);
+				auto const destinationRow = destinationTreeItem->childCount();
+				q->beginMoveRows(domainModelIndex, entityRow, entityRow, index(destinationTreeItem->row(), 0, QModelIndex()), destinationRow);
+				destinationTreeItem->insertChild(destinationRow, domainTreeItem->takeChildAt(entityRow));
+				q->endMoveRows();
+			}
+			else
+			{
+				q->beginRemoveRows(domainModelIndex, entityRow, entityRow);
+				domainTreeItem->removeChildAt(entityRow);
+				q->endRemoveRows();
 			}
 		}
 	}
+
+	// entities new to a domain
+	for (auto const& missingKV : missingEntities)
+	{
+		if (missingKV.second.empty())
+		{
+			continue;
+		}
+		auto* domainTreeItem = _rootItem->findDomainWithIndex(missingKV.first);
+		auto const firstRow = domainTreeItem->childCount();
+		q->beginInsertRows(index(domainTreeItem->row(), 0, QModelIndex()), firstRow, firstRow + static_cast<int>(missingKV.second.size()) - 1);
+		for (auto const& entityId : missingKV.second)
+		{
+			domainTreeItem->appendChild(new EntityTreeItem(entityId, domainTreeItem));
+		}
+		q->endInsertRows();
+	}
+
+	// domains no longer existing
+	for (auto domainRow = _rootItem->childCount() - 1; domainRow >= 0; --domainRow)
+	{
+		auto* domainTreeItem = static_cast<DomainTreeItem*>(_rootItem->childAt(domainRow));
+		if (newDomains.count(domainTreeItem->domain().getDomainIndex()) == 0)
+		{
+			q->beginRemoveRows(QModelIndex(), domainRow, domainRow);
+			_rootItem->removeChildAt(domainRow);
+			q->endRemoveRows();
+		}
+	}
 }
 
 /**
@@ -23,6 +23,7 @@
 #include <QMenu>
 #include <QMessageBox>
 #include <QProgressDialog>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "ui_mediaClockManagementDialog.h"
@@ -35,6 +36,7 @@
 #include "mediaClock/mediaClockManagementDialog.hpp"
 #include "mediaClock/domainTreeModel.hpp"
 #include "mediaClock/unassignedListModel.hpp"
+#include "mediaClock/sampleRateChange.hpp"
 #include "entityLogoCache.hpp"
 
 class MediaClockManagementDialogImpl final : private Ui::MediaClockManagementDialog, public QObject
@@ -53,11 +55,12 @@ public:
 		setupUi(parent);
 
 		auto& mediaClockManager = avdecc::mediaClock::MCDomainManager::getInstance();
-		auto domains = mediaClockManager.createMediaClockDomainModel();
+		auto const domains = mediaClockManager.getMediaClockDomainModel();
 
 		connect(&mediaClockManager, &avdecc::mediaClock::MCDomainManager::mediaClockConnectionsUpdate, this, &MediaClockManagementDialogImpl::mediaClockConnectionsUpdate);
 		connect(&mediaClockManager, &avdecc::mediaClock::MCDomainManager::applyMediaClockDomainModelFinished, this, &MediaClockManagementDialogImpl::applyMediaClockDomainModelFinished);
 		connect(&mediaClockManager, &avdecc::mediaClock::MCDomainManager::applyMediaClockDomainModelProgressUpdate, this, &MediaClockManagementDialogImpl::applyMediaClockDomainModelProgressUpdate);
+		connect(&mediaClockManager, &avdecc::mediaClock::MCDomainManager::applyMediaClockDomainModelEntityStatusChanged, this, &MediaClockManagementDialogImpl::applyMediaClockDomainModelEntityStatusChanged);
 
 
 		auto& controllerManager = avdecc::ControllerManager::getInstance();
@@ -75,7 +78,7 @@ public:
 		connect(treeViewMediaClockDomains->selectionModel(), &QItemSelectionModel::currentChanged, &_domainTreeModel, &DomainTreeModel::handleClick);
 		connect(treeViewMediaClockDomains->selectionModel(), &QItemSelectionModel::currentColumnChanged, &_domainTreeModel, &DomainTreeModel::handleClick);
 		connect(treeViewMediaClockDomains->selectionModel(), &QItemSelectionModel::currentRowChanged, &_domainTreeModel, &DomainTreeModel::handleClick);
-		_domainTreeModel.setMediaClockDomainModel(domains);
+		_domainTreeModel.setMediaClockDomainModel(*domains);
 		expandAllDomains();
 
 		treeViewMediaClockDomains->resizeColumnToContents((int)DomainTreeModelColumn::Domain);
@@ -86,7 +89,7 @@ public:
 		listView_UnassignedEntities->setContextMenuPolicy(Qt::CustomContextMenu);
 		connect(listView_UnassignedEntities, &QListView::customContextMenuRequested, this, &MediaClockManagementDialogImpl::onCustomContextMenuRequested);
 
-		_unassignedListModel.setMediaClockDomainModel(domains);
+		_unassignedListModel.setMediaClockDomainModel(*domains);
 
 		connect(button_AssignToDomain, &QPushButton::clicked, this, &MediaClockManagementDialogImpl::button_AssignToDomainClicked);
 		connect(button_RemoveAssignment, &QPushButton::clicked, this, &MediaClockManagementDialogImpl::button_RemoveAssignmentClicked);
@@ -105,6 +108,19 @@ public:
 		connect(&_domainTreeModel, &DomainTreeModel::deselectAll, this, &MediaClockManagementDialogImpl::removeMcDomainTreeViewSelections);
 		connect(&_domainTreeModel, &DomainTreeModel::expandDomain, this, &MediaClockManagementDialogImpl::expandDomain);
 
+		// the domain tree is updated in place, only the domains that appear have to be expanded
+		connect(&_domainTreeModel, &DomainTreeModel::rowsInserted, this,
+			[this](QModelIndex const& parent, int first, int last)
+			{
+				if (!parent.isValid())
+				{
+					for (auto row = first; row <= last; ++row)
+					{
+						treeViewMediaClockDomains->expand(_domainTreeModel.index(row, 0));
+					}
+				}
+			});
+
 		// drag&drop support
 		listView_UnassignedEntities->setDragEnabled(true);
 		listView_UnassignedEntities->setDropIndicatorShown(true);
@@ -143,12 +159,11 @@ public:
 	{
 		// read out again:
 		auto& mediaClockManager = avdecc::mediaClock::MCDomainManager::getInstance();
-		auto domains = mediaClockManager.createMediaClockDomainModel();
+		auto const domains = mediaClockManager.getMediaClockDomainModel();
 
 		// setup the models:
-		_unassignedListModel.setMediaClockDomainModel(domains);
-		_domainTreeModel.setMediaClockDomainModel(domains);
-		expandAllDomains();
+		_unassignedListModel.setMediaClockDomainModel(*domains);
+		_domainTreeModel.setMediaClockDomainModel(*domains);
 		resizeMCTreeViewColumns();
 	}
 
@@ -311,12 +326,35 @@ public:
 			mediaClockMappings.getEntityMediaClockMasterMappings().emplace(unassignedEntity, std::vector<avdecc::mediaClock::DomainIndex>());
 		}
 
+		_applyStatuses.clear();
 		_progressDialog = new QProgressDialog("Executing commands...", "Abort apply", 0, 100, qobject_cast<QWidget*>(this));
 		_progressDialog->setMinimumWidth(350);
 		_progressDialog->setWindowModality(Qt::WindowModal);
 		_progressDialog->setMinimumDuration(500);
-		auto& mediaClockManager = avdecc::mediaClock::MCDomainManager::getInstance();
-		mediaClockManager.applyMediaClockDomainModel(mediaClockMappings);
+
+		// domain sampling rate changes are first applied to all the entities at once (master first), without disconnecting their streams.
+		// the entities that refused it are still at their previous rate, and are changed one by one by the media clock manager
+		auto const samplingRatePlans = mediaClock::sampleRateChange::computePlans(mediaClockMappings);
+		if (samplingRatePlans.empty())
+		{
+			avdecc::mediaClock::MCDomainManager::getInstance().applyMediaClockDomainModel(mediaClockMappings);
+			return;
+		}
+
+		_progressDialog->setLabelText("Changing the sampling rate of the domains...");
+		mediaClock::sampleRateChange::apply(samplingRatePlans, this,
+			[this, mediaClockMappings](avdecc::commandChain::CommandExecutionErrors const& errors)
+			{
+				// sampling rate failures are retried by the media clock manager, only the stream format ones are reported
+				for (auto const& [entityId, errorInfo] : errors)
+				{
+					if (errorInfo.commandTypeAecp && *errorInfo.commandTypeAecp == avdecc::ControllerManager::AecpCommandType::SetStreamFormat)
+					{
+						_samplingRateChangeErrors.emplace(entityId, errorInfo);
+					}
+				}
+				avdecc::mediaClock::MCDomainManager::getInstance().applyMediaClockDomainModel(mediaClockMappings);
+			});
 	}
 
 	/**
@@ -418,6 +456,50 @@ public:
 		_progressDialog->setValue(static_cast<int>(progress));
 	}
 
+	/**
+	* Shows how many entities are done, and the last error, while the configuration is being applied.
+	*/
+	void applyMediaClockDomainModelEntityStatusChanged(avdecc::mediaClock::EntityApplyStatus const& status)
+	{
+		auto& previousStatus = _applyStatuses[status.entityId];
+		auto const hasNewErrors = status.errors.size() > previousStatus.errors.size();
+		previousStatus = status;
+
+		if (hasNewErrors)
+		{
+			auto entityName = avdecc::helper::toHexQString(status.entityId.getValue());
+			if (auto controlledEntity = avdecc::ControllerManager::getInstance().getControlledEntity(status.entityId))
+			{
+				entityName = avdecc::helper::smartEntityName(*controlledEntity);
+			}
+			_lastApplyError = QString("%1: %2").arg(entityName).arg(avdecc::commandChain::AsyncParallelCommandSet::errorToString(status.errors.begin()->second.errorType));
+		}
+
+		auto completedEntities = 0;
+		auto failedEntities = 0;
+		for (auto const& statusKV : _applyStatuses)
+		{
+			if (statusKV.second.completedCommands >= statusKV.second.totalCommands)
+			{
+				++completedEntities;
+			}
+			if (!statusKV.second.errors.empty())
+			{
+				++failedEntities;
+			}
+		}
+
+		auto text = QString("Executing commands...\n%1/%2 entities done, %3 with errors").arg(completedEntities).arg(_applyStatuses.size()).arg(failedEntities);
+		if (!_lastApplyError.isEmpty())
+		{
+			text += "\nLast error: " + _lastApplyError;
+		}
+		if (_progressDialog)
+		{
+			_progressDialog->setLabelText(text);
+		}
+	}
+
 	/*
 	* Display any error that occurs
 	*/
@@ -427,7 +509,11 @@ public:
 		_progressDialog->close();
 		refreshModels();
 
+		applyInfo.entityApplyErrors.insert(_samplingRateChangeErrors.begin(), _samplingRateChangeErrors.end());
+		_samplingRateChangeErrors.clear();
+
 		std::unordered_set<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier::hash> iteratedEntityIds;
+		QString allErrors;
 		for (auto it = applyInfo.entityApplyErrors.begin(), end = applyInfo.entityApplyErrors.end(); it != end; it++) // upper_bound not supported on mac (to iterate over unique keys)
 		{
 			if (iteratedEntityIds.find(it->first) == iteratedEntityIds.end())
@@ -477,6 +563,9 @@ public:
 						case avdecc::ControllerManager::AecpCommandType::SetSamplingRate:
 							errors += "Setting the sampling rate failed. ";
 							break;
+						case avdecc::ControllerManager::AecpCommandType::SetStreamFormat:
+							errors += "Setting the stream format failed. ";
+							break;
 						default:
 							break;
 					}
@@ -513,8 +602,16 @@ public:
 				}
 				errors += "\n";
 			}
-			QMessageBox::information(qobject_cast<QWidget*>(this), "Error while applying", QString("Error(s) occured on %1 while applying the configuration:\n\n%2").arg(entityName).arg(errors));
+			allErrors += QString("%1:\n%2\n").arg(entityName).arg(errors);
+		}
+
+		// a single report for all the entities, instead of one message per entity
+		if (!allErrors.isEmpty())
+		{
+			QMessageBox::information(qobject_cast<QWidget*>(this), "Error while applying", QString("Error(s) occured while applying the configuration:\n\n%1").arg(allErrors));
 		}
+		_applyStatuses.clear();
+		_lastApplyError.clear();
 	}
 
 	/**
@@ -565,6 +662,9 @@ private:
 	bool _hasChanges;
 
 	QProgressDialog* _progressDialog;
+	std::unordered_map<la::avdecc::UniqueIdentifier, avdecc::mediaClock::EntityApplyStatus, la::avdecc::UniqueIdentifier::hash> _applyStatuses{}; // Progress of the current apply, per entity
+	QString _lastApplyError{};
+	avdecc::commandChain::CommandExecutionErrors _samplingRateChangeErrors{}; // Stream format errors of the domain sampling rate change, reported with the ones of the apply
 };
 
 /**
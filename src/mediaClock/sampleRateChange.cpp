@@ -0,0 +1,423 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mediaClock/sampleRateChange.hpp"
+#include "connectionMatrix/streamFormatCache.hpp"
+#include "avdecc/controllerManager.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <optional>
+#include <utility>
+
+namespace mediaClock
+{
+namespace sampleRateChange
+{
+using StreamKey = std::pair<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::StreamIndex>;
+using FormatChange = connectionMatrix::formatReconciliation::FormatChange;
+namespace streamFormatCache = connectionMatrix::streamFormatCache;
+
+static std::uint32_t samplingRateToHz(la::avdecc::entity::model::StreamFormatInfo::SamplingRate const samplingRate) noexcept
+{
+	switch (samplingRate)
+	{
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::Hz_500:
+			return 500u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_8:
+			return 8000u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_16:
+			return 16000u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_24:
+			return 24000u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_32:
+			return 32000u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_44_1:
+			return 44100u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_48:
+			return 48000u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_88_2:
+			return 88200u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_96:
+			return 96000u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_176_4:
+			return 176400u;
+		case la::avdecc::entity::model::StreamFormatInfo::SamplingRate::kHz_192:
+			return 192000u;
+		default:
+			return 0u;
+	}
+}
+
+static std::uint32_t samplingRateToHz(la::avdecc::entity::model::SamplingRate const samplingRate) noexcept
+{
+	return static_cast<std::uint32_t>(std::lround(samplingRate.getNominalSampleRate()));
+}
+
+/** Audio stream format that has to follow the sampling rate of its entity (clock reference streams keep their own rate) */
+static bool isAudioFormatAtOtherRate(la::avdecc::entity::model::StreamFormat const streamFormat, std::uint32_t const samplingRateHz) noexcept
+{
+	auto const formatInfo = la::avdecc::entity::model::StreamFormatInfo::create(streamFormat);
+	if (!formatInfo)
+	{
+		return false;
+	}
+	switch (formatInfo->getType())
+	{
+		case la::avdecc::entity::model::StreamFormatInfo::Type::IEC_61883_6:
+		case la::avdecc::entity::model::StreamFormatInfo::Type::AAF:
+			return samplingRateToHz(formatInfo->getSamplingRate()) != samplingRateHz;
+		default:
+			return false;
+	}
+}
+
+/**
+* Finds the format of a stream at the specified sampling rate, with the same type and channels count as the current one.
+* Formats compatible with the talker format (if specified) come first, then the ones with the same sample format.
+*/
+template<typename StreamNodeType>
+static std::optional<streamFormatCache::FormatID> findFormatAtRate(StreamNodeType const& streamNode, std::uint32_t const samplingRateHz, std::optional<streamFormatCache::FormatID> const talkerFormatID) noexcept
+{
+	auto const currentInfo = la::avdecc::entity::model::StreamFormatInfo::create(streamNode.dynamicModel->streamFormat);
+	auto const channelsCount = currentInfo->getChannelsCount();
+
+	auto bestFormatID = std::optional<streamFormatCache::FormatID>{};
+	auto bestScore = 0;
+	for (auto const& availableFormat : streamNode.staticModel->formats)
+	{
+		auto const formatInfo = la::avdecc::entity::model::StreamFormatInfo::create(availableFormat);
+		if (!formatInfo || formatInfo->getType() != currentInfo->getType() || samplingRateToHz(formatInfo->getSamplingRate()) != samplingRateHz)
+		{
+			continue;
+		}
+
+		auto streamFormat = availableFormat;
+		if (formatInfo->isUpToChannelsCount())
+		{
+			if (formatInfo->getChannelsCount() < channelsCount)
+			{
+				continue;
+			}
+			streamFormat = formatInfo->getAdaptedStreamFormat(channelsCount);
+		}
+		else if (formatInfo->getChannelsCount() != channelsCount)
+		{
+			continue;
+		}
+
+		auto const formatID = streamFormatCache::intern(streamFormat);
+		auto score = 1;
+		if (formatInfo->getSampleFormat() == currentInfo->getSampleFormat())
+		{
+			score += 1;
+		}
+		if (talkerFormatID && streamFormatCache::isListenerFormatCompatibleWithTalkerFormat(formatID, *talkerFormatID))
+		{
+			score += 2;
+		}
+		if (score > bestScore)
+		{
+			bestFormatID = formatID;
+			bestScore = score;
+		}
+	}
+	return bestFormatID;
+}
+
+std::vector<Plan> computePlans(avdecc::mediaClock::MCEntityDomainMapping const& domains) noexcept
+{
+	auto& manager = avdecc::ControllerManager::getInstance();
+
+	// An entity follows the sampling rate of the first domain it is assigned to
+	auto entitiesPerDomain = std::map<avdecc::mediaClock::DomainIndex, std::vector<la::avdecc::UniqueIdentifier>>{};
+	for (auto const& [entityID, domainIndexes] : domains.getEntityMediaClockMasterMappings())
+	{
+		if (!domainIndexes.empty())
+		{
+			entitiesPerDomain[domainIndexes.front()].push_back(entityID);
+		}
+	}
+
+	auto plans = std::vector<Plan>{};
+	auto samplingRatePerEntity = std::map<la::avdecc::UniqueIdentifier, std::uint32_t>{};
+	for (auto const& [domainIndex, entities] : entitiesPerDomain)
+	{
+		auto const domainIt = domains.getMediaClockDomains().find(domainIndex);
+		if (domainIt == domains.getMediaClockDomains().end() || !domainIt->second.getDomainSamplingRate())
+		{
+			continue;
+		}
+
+		auto plan = Plan{ domainIt->second.getDomainSamplingRate(), domainIt->second.getMediaClockDomainMaster() };
+		auto const samplingRateHz = samplingRateToHz(plan.samplingRate);
+		for (auto const& entityID : entities)
+		{
+			auto controlledEntity = manager.getControlledEntity(entityID);
+			if (!controlledEntity || !controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+			{
+				continue;
+			}
+			try
+			{
+				auto change = EntityChange{ entityID };
+				for (auto const& [audioUnitIndex, audioUnitNode] : controlledEntity->getCurrentConfigurationNode().audioUnits)
+				{
+					if (audioUnitNode.dynamicModel && audioUnitNode.dynamicModel->currentSamplingRate != plan.samplingRate)
+					{
+						change.audioUnits.push_back(audioUnitIndex);
+					}
+				}
+				if (change.audioUnits.empty())
+				{
+					continue;
+				}
+				samplingRatePerEntity[entityID] = samplingRateHz;
+
+				// The media clock master is changed first, keep it first
+				if (entityID == plan.mediaClockMaster)
+				{
+					plan.entities.insert(plan.entities.begin(), std::move(change));
+				}
+				else
+				{
+					plan.entities.push_back(std::move(change));
+				}
+			}
+			catch (la::avdecc::controller::ControlledEntity::Exception const&)
+			{
+			}
+		}
+
+		if (!plan.entities.empty())
+		{
+			plans.push_back(std::move(plan));
+		}
+	}
+
+	// Talker formats first, so the listeners can choose a format compatible with the new format of their talker
+	auto talkerFormats = std::map<StreamKey, streamFormatCache::FormatID>{};
+	for (auto& plan : plans)
+	{
+		auto const samplingRateHz = samplingRateToHz(plan.samplingRate);
+		for (auto& change : plan.entities)
+		{
+			try
+			{
+				auto controlledEntity = manager.getControlledEntity(change.entityID);
+				if (!controlledEntity)
+				{
+					continue;
+				}
+				for (auto const& [streamIndex, streamOutputNode] : controlledEntity->getCurrentConfigurationNode().streamOutputs)
+				{
+					if (!streamOutputNode.dynamicModel || !streamOutputNode.staticModel || !isAudioFormatAtOtherRate(streamOutputNode.dynamicModel->streamFormat, samplingRateHz))
+					{
+						continue;
+					}
+					if (auto const formatID = findFormatAtRate(streamOutputNode, samplingRateHz, std::nullopt))
+					{
+						talkerFormats[StreamKey{ change.entityID, streamIndex }] = *formatID;
+						change.formatChanges.push_back(FormatChange{ change.entityID, streamIndex, false, streamFormatCache::streamFormat(*formatID) });
+					}
+					else
+					{
+						++plan.unresolvedStreams;
+					}
+				}
+			}
+			catch (la::avdecc::controller::ControlledEntity::Exception const&)
+			{
+			}
+		}
+	}
+
+	// Format of a talker stream once the plans are applied
+	auto const getTalkerFormat = [&manager, &talkerFormats](StreamKey const& talker) -> std::optional<streamFormatCache::FormatID>
+	{
+		if (auto const it = talkerFormats.find(talker); it != talkerFormats.end())
+		{
+			return it->second;
+		}
+		try
+		{
+			if (auto controlledEntity = manager.getControlledEntity(talker.first))
+			{
+				auto const& streamOutputNode = controlledEntity->getStreamOutputNode(controlledEntity->getCurrentConfigurationNode().descriptorIndex, talker.second);
+				if (streamOutputNode.dynamicModel)
+				{
+					return streamFormatCache::intern(streamOutputNode.dynamicModel->streamFormat);
+				}
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+		return std::nullopt;
+	};
+
+	for (auto& plan : plans)
+	{
+		auto const samplingRateHz = samplingRateToHz(plan.samplingRate);
+		for (auto& change : plan.entities)
+		{
+			try
+			{
+				auto controlledEntity = manager.getControlledEntity(change.entityID);
+				if (!controlledEntity)
+				{
+					continue;
+				}
+				for (auto const& [streamIndex, streamInputNode] : controlledEntity->getCurrentConfigurationNode().streamInputs)
+				{
+					if (!streamInputNode.dynamicModel || !streamInputNode.staticModel || !isAudioFormatAtOtherRate(streamInputNode.dynamicModel->streamFormat, samplingRateHz))
+					{
+						continue;
+					}
+					auto talkerFormatID = std::optional<streamFormatCache::FormatID>{};
+					auto const& connectionState = streamInputNode.dynamicModel->connectionState;
+					if (connectionState.state == la::avdecc::entity::model::StreamConnectionState::State::Connected)
+					{
+						talkerFormatID = getTalkerFormat(StreamKey{ connectionState.talkerStream.entityID, connectionState.talkerStream.streamIndex });
+					}
+					if (auto const formatID = findFormatAtRate(streamInputNode, samplingRateHz, talkerFormatID))
+					{
+						change.formatChanges.push_back(FormatChange{ change.entityID, streamIndex, true, streamFormatCache::streamFormat(*formatID) });
+					}
+					else
+					{
+						++plan.unresolvedStreams;
+					}
+				}
+			}
+			catch (la::avdecc::controller::ControlledEntity::Exception const&)
+			{
+			}
+		}
+	}
+
+	return plans;
+}
+
+static avdecc::commandChain::AsyncParallelCommandSet::AsyncCommand makeSetSamplingRateCommand(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, la::avdecc::entity::model::SamplingRate const samplingRate) noexcept
+{
+	return [entityID, audioUnitIndex, samplingRate](avdecc::commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+	{
+		auto const responseHandler = [parentCommandSet, commandIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status)
+		{
+			auto const error = avdecc::commandChain::AsyncParallelCommandSet::aemCommandStatusToCommandError(status);
+			parentCommandSet->completeCommand(commandIndex, entityID, error, avdecc::ControllerManager::AecpCommandType::SetSamplingRate);
+		};
+		avdecc::ControllerManager::getInstance().setAudioUnitSamplingRate(entityID, audioUnitIndex, samplingRate, responseHandler);
+		return true;
+	};
+}
+
+static avdecc::commandChain::AsyncParallelCommandSet::AsyncCommand makeSetStreamFormatCommand(FormatChange const& change) noexcept
+{
+	return [change](avdecc::commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+	{
+		auto const responseHandler = [parentCommandSet, commandIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status)
+		{
+			auto const error = avdecc::commandChain::AsyncParallelCommandSet::aemCommandStatusToCommandError(status);
+			parentCommandSet->completeCommand(commandIndex, entityID, error, avdecc::ControllerManager::AecpCommandType::SetStreamFormat);
+		};
+
+		auto& manager = avdecc::ControllerManager::getInstance();
+		if (change.isInput)
+		{
+			manager.setStreamInputFormat(change.entityID, change.streamIndex, change.streamFormat, responseHandler);
+		}
+		else
+		{
+			manager.setStreamOutputFormat(change.entityID, change.streamIndex, change.streamFormat, responseHandler);
+		}
+		return true;
+	};
+}
+
+void apply(std::vector<Plan> const& plans, QObject* const context, ApplyHandler const& handler, size_t const maxConcurrentEntities) noexcept
+{
+	auto* const executer = new avdecc::commandChain::AsyncCommandGraphExecuter{ context };
+	executer->setMaxRunningCommandSets(maxConcurrentEntities);
+
+	// The media clock masters of all the domains first, in a single barrier so the other entities are only waiting for them
+	auto* const mastersCommandSet = new avdecc::commandChain::AsyncParallelCommandSet;
+	for (auto const& plan : plans)
+	{
+		auto const& change = plan.entities.front();
+		if (change.entityID == plan.mediaClockMaster)
+		{
+			for (auto const audioUnitIndex : change.audioUnits)
+			{
+				mastersCommandSet->append(change.entityID, makeSetSamplingRateCommand(change.entityID, audioUnitIndex, plan.samplingRate));
+			}
+		}
+	}
+	if (mastersCommandSet->parallelCommandCount() != 0u)
+	{
+		executer->addCommandSet(mastersCommandSet);
+	}
+	else
+	{
+		delete mastersCommandSet;
+	}
+
+	// Then each entity on its own: sampling rate, then stream formats at the new rate
+	for (auto const& plan : plans)
+	{
+		for (auto const& change : plan.entities)
+		{
+			auto const resources = avdecc::commandChain::AsyncCommandGraphExecuter::Resources{ change.entityID };
+			if (change.entityID != plan.mediaClockMaster && !change.audioUnits.empty())
+			{
+				auto* const samplingRateCommandSet = new avdecc::commandChain::AsyncParallelCommandSet;
+				for (auto const audioUnitIndex : change.audioUnits)
+				{
+					samplingRateCommandSet->append(change.entityID, makeSetSamplingRateCommand(change.entityID, audioUnitIndex, plan.samplingRate));
+				}
+				executer->addCommandSet(samplingRateCommandSet, resources);
+			}
+			if (!change.formatChanges.empty())
+			{
+				auto* const formatsCommandSet = new avdecc::commandChain::AsyncParallelCommandSet;
+				for (auto const& formatChange : change.formatChanges)
+				{
+					formatsCommandSet->append(change.entityID, makeSetStreamFormatCommand(formatChange));
+				}
+				executer->addCommandSet(formatsCommandSet, resources);
+			}
+		}
+	}
+
+	QObject::connect(executer, &avdecc::commandChain::AsyncCommandGraphExecuter::completed, context,
+		[executer, handler](avdecc::commandChain::CommandExecutionErrors const errors)
+		{
+			if (handler)
+			{
+				handler(errors);
+			}
+			executer->deleteLater();
+		});
+	executer->start();
+}
+
+} // namespace sampleRateChange
+} // namespace mediaClock
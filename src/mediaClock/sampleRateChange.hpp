@@ -0,0 +1,72 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/internals/entityModelTypes.hpp>
+#include <la/avdecc/utils.hpp>
+
+#include "avdecc/commandChain.hpp"
+#include "avdecc/mcDomainManager.hpp"
+#include "connectionMatrix/formatReconciliation.hpp"
+
+#include <QObject>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace mediaClock
+{
+namespace sampleRateChange
+{
+struct EntityChange
+{
+	la::avdecc::UniqueIdentifier entityID{};
+	std::vector<la::avdecc::entity::model::AudioUnitIndex> audioUnits{}; // Audio units not running at the domain sampling rate
+	std::vector<connectionMatrix::formatReconciliation::FormatChange> formatChanges{}; // Audio streams adopting a format at the domain sampling rate
+};
+
+struct Plan
+{
+	la::avdecc::entity::model::SamplingRate samplingRate{};
+	la::avdecc::UniqueIdentifier mediaClockMaster{};
+	std::vector<EntityChange> entities{}; // Media clock master first, if it has something to change
+	size_t unresolvedStreams{ 0u }; // Streams without any available format at the domain sampling rate
+};
+
+/**
+* @brief Computes the sampling rate and stream format changes of all the entities of the domains whose sampling rate differs from the one of their entities (Qt Main Thread only).
+* @details An entity belongs to the first domain it is assigned to. Stream formats are chosen with the stream format compatibility cache: the same type,
+*          sample format and channels count at the domain sampling rate, listeners preferring a format compatible with the new format of their talker.
+*          Clock reference streams are left untouched.
+*/
+std::vector<Plan> computePlans(avdecc::mediaClock::MCEntityDomainMapping const& domains) noexcept;
+
+using ApplyHandler = std::function<void(avdecc::commandChain::CommandExecutionErrors const& errors)>;
+
+/**
+* @brief Applies the plans as one command graph: the sampling rate of all the media clock masters is changed first, then all the other entities
+*        are processed in parallel (sampling rate then stream formats), with a bounded count of entities in progress.
+* @details The handler is called once all the commands completed, in the thread of the context object.
+*/
+void apply(std::vector<Plan> const& plans, QObject* const context, ApplyHandler const& handler, size_t const maxConcurrentEntities = 16) noexcept;
+
+} // namespace sampleRateChange
+} // namespace mediaClock
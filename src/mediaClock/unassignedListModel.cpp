@@ -29,6 +29,8 @@
 #include "avdecc/mcDomainManager.hpp"
 #include "avdecc/helper.hpp"
 
+#include <set>
+
 // **************************************************************
 // class UnassignedListModelPrivate
 // **************************************************************
@@ -89,26 +91,59 @@ UnassignedListModelPrivate::~UnassignedListModelPrivate() {}
 
 /**
 * Sets the data this model operates on.
+* Only the entities that became assigned or unassigned are removed or inserted, so views keep their selection.
 * @param domains The model.
 */
 void UnassignedListModelPrivate::setMediaClockDomainModel(avdecc::mediaClock::MCEntityDomainMapping const& domains)
 {
 	Q_Q(UnassignedListModel);
-	q->beginResetModel();
-	_entities.clear();
-
 	auto domainsLocal = domains;
 
-	// code for list model
+	auto unassignedEntities = std::set<la::avdecc::UniqueIdentifier>{};
 	for (auto const& entityDomainKV : domainsLocal.getEntityMediaClockMasterMappings())
 	{
 		if (entityDomainKV.second.empty() && avdecc::mediaClock::MCDomainManager::getInstance().isMediaClockDomainManageable(entityDomainKV.first))
 		{
 			// empty means unassigned with the exception of entities that cannot be managed by MCMD in the first place
-			_entities.append(entityDomainKV.first);
+			unassignedEntities.insert(entityDomainKV.first);
+		}
+	}
+
+	// remove the entities no longer unassigned, contiguous rows at once
+	for (auto lastRow = _entities.size() - 1; lastRow >= 0; --lastRow)
+	{
+		if (unassignedEntities.erase(_entities.at(lastRow)) != 0)
+		{
+			continue;
+		}
+		auto firstRow = lastRow;
+		while (firstRow > 0 && unassignedEntities.count(_entities.at(firstRow - 1)) == 0)
+		{
+			--firstRow;
+		}
+		q->beginRemoveRows(QModelIndex(), firstRow, lastRow);
+		_entities.erase(_entities.begin() + firstRow, _entities.begin() + lastRow + 1);
+		q->endRemoveRows();
+		lastRow = firstRow;
+	}
+
+	// names may have changed for the kept ones
+	if (!_entities.isEmpty())
+	{
+		emit q->dataChanged(q->index(0), q->index(_entities.size() - 1));
+	}
+
+	// the remaining ones are new
+	if (!unassignedEntities.empty())
+	{
+		auto const firstRow = _entities.size();
+		q->beginInsertRows(QModelIndex(), firstRow, firstRow + static_cast<int>(unassignedEntities.size()) - 1);
+		for (auto const& entityId : unassignedEntities)
+		{
+			_entities.append(entityId);
 		}
+		q->endInsertRows();
 	}
-	q->endResetModel();
 }
 
 /**
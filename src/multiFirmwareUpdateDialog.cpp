@@ -32,6 +32,7 @@
 #include <QMessageBox>
 #include <QFile>
 #include <QFileDialog>
+#include <QMenu>
 
 #include <la/avdecc/utils.hpp>
 #include "avdecc/controllerManager.hpp"
@@ -39,6 +40,14 @@
 #include "firmwareUploadDialog.hpp"
 #include "defaults.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <utility>
+
 Q_DECLARE_METATYPE(la::avdecc::UniqueIdentifier)
 
 class ModelPrivate;
@@ -63,7 +72,17 @@ public:
 	virtual QVariant data(QModelIndex const& index, int role = Qt::DisplayRole) const override;
 	virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
 
+	/** Firmware image memory object of an entity, shared by all the entities of the same entity model */
+	struct FirmwareImage
+	{
+		la::avdecc::entity::model::MemoryObjectIndex descriptorIndex{ 0u };
+		std::uint64_t startAddress{ 0u };
+		std::uint64_t maximumLength{ 0u };
+	};
+
 	la::avdecc::UniqueIdentifier controlledEntityID(QModelIndex const& index) const;
+	QString modelName(QModelIndex const& index) const;
+	std::optional<FirmwareImage> firmwareImage(QModelIndex const& index) const;
 
 private:
 	QScopedPointer<ModelPrivate> const d_ptr;
@@ -158,49 +177,20 @@ private:
 
 		q->beginResetModel();
 		_entities.clear();
+		_entityRowMap.clear();
 		q->endResetModel();
 	}
 
 	void handleEntityOnline(la::avdecc::UniqueIdentifier const& entityID)
 	{
-		try
+		auto& manager = avdecc::ControllerManager::getInstance();
+		if (auto controlledEntity = manager.getControlledEntity(entityID))
 		{
-			auto& manager = avdecc::ControllerManager::getInstance();
-			auto controlledEntity = manager.getControlledEntity(entityID);
-			if (controlledEntity && controlledEntity->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+			if (auto data = makeEntityData(entityID, *controlledEntity))
 			{
-				auto const& entityNode = controlledEntity->getEntityNode();
-				if (entityNode.dynamicModel)
-				{
-					auto const configurationIndex = entityNode.dynamicModel->currentConfiguration;
-					auto const& configurationNode = controlledEntity->getConfigurationNode(configurationIndex);
-					for (auto const& [memoryObjectIndex, memoryObjectNode] : configurationNode.memoryObjects)
-					{
-						if (memoryObjectNode.staticModel->memoryObjectType == la::avdecc::entity::model::MemoryObjectType::FirmwareImage)
-						{
-							Q_Q(Model);
-
-							// Insert at the end
-							auto const row = rowCount();
-							emit q->beginInsertRows({}, row, row);
-
-							_entities.push_back(EntityData{ entityID, avdecc::helper::smartEntityName(*controlledEntity), entityNode.dynamicModel->firmwareVersion.data() });
-
-							// Update the cache
-							rebuildEntityRowMap();
-
-							emit q->endInsertRows();
-
-							return;
-						}
-					}
-				}
+				insertEntities({ std::move(*data) });
 			}
 		}
-		catch (...)
-		{
-			// Ignore exceptions
-		}
 	}
 
 	void handleEntityOffline(la::avdecc::UniqueIdentifier const& entityID)
@@ -210,12 +200,13 @@ private:
 			Q_Q(Model);
 			emit q->beginRemoveRows({}, *row, *row);
 
-			// Remove the entity from the model
+			// Remove the entity from the model (and the cache)
 			auto const it = std::next(std::begin(_entities), *row);
+			_entityRowMap.erase(it->entityID);
 			_entities.erase(it);
 
-			// Update the cache
-			rebuildEntityRowMap();
+			// Update the cache, only the rows after the removed one have moved
+			updateEntityRowMap(*row);
 
 			emit q->endRemoveRows();
 		}
@@ -232,15 +223,13 @@ private:
 		}
 	}
 
-	// Build the entityID to row map
-	void rebuildEntityRowMap()
+	// Update the entityID to row map, starting at the specified row (rows before it didn't move)
+	void updateEntityRowMap(int const fromRow)
 	{
-		_entityRowMap.clear();
-
-		for (auto row = 0; row < rowCount(); ++row)
+		for (auto row = fromRow; row < rowCount(); ++row)
 		{
 			auto const& data = _entities[row];
-			_entityRowMap.emplace(std::make_pair(data.entityID, row));
+			_entityRowMap[data.entityID] = row;
 		}
 	}
 
@@ -265,6 +254,26 @@ private:
 		return la::avdecc::UniqueIdentifier{};
 	}
 
+	QString modelName(QModelIndex const& index) const
+	{
+		auto const row = index.row();
+		if (row >= 0 && row < rowCount())
+		{
+			return _entities[row].modelName;
+		}
+		return {};
+	}
+
+	std::optional<Model::FirmwareImage> firmwareImage(QModelIndex const& index) const
+	{
+		auto const row = index.row();
+		if (row >= 0 && row < rowCount())
+		{
+			return _entities[row].firmwareImage;
+		}
+		return std::nullopt;
+	}
+
 
 private:
 	Model* const q_ptr{ nullptr };
@@ -275,10 +284,129 @@ private:
 		la::avdecc::UniqueIdentifier entityID{};
 		QString name{};
 		QString firmwareVersion{};
+		QString modelName{};
+		Model::FirmwareImage firmwareImage{};
 	};
 
 	using Entities = std::vector<EntityData>;
 	using EntityRowMap = std::unordered_map<la::avdecc::UniqueIdentifier, int, la::avdecc::UniqueIdentifier::hash>;
+	using FirmwareImageKey = std::pair<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::ConfigurationIndex>;
+	using FirmwareImageCache = std::map<FirmwareImageKey, std::optional<Model::FirmwareImage>>;
+
+	/** Scans the memory objects of the configuration for the first firmware image */
+	static std::optional<Model::FirmwareImage> findFirmwareImage(la::avdecc::controller::model::ConfigurationNode const& configurationNode) noexcept
+	{
+		for (auto const& [memoryObjectIndex, memoryObjectNode] : configurationNode.memoryObjects)
+		{
+			auto const* const model = memoryObjectNode.staticModel;
+			if (model->memoryObjectType == la::avdecc::entity::model::MemoryObjectType::FirmwareImage)
+			{
+				return Model::FirmwareImage{ memoryObjectNode.descriptorIndex, model->startAddress, model->maximumLength };
+			}
+		}
+		return std::nullopt;
+	}
+
+	/** Returns the firmware image of the entity, only scanning the memory objects once per entity model. Thread-safe */
+	std::optional<Model::FirmwareImage> getFirmwareImage(la::avdecc::controller::ControlledEntity const& controlledEntity, la::avdecc::entity::model::ConfigurationIndex const configurationIndex)
+	{
+		auto const entityModelID = controlledEntity.getEntity().getEntityModelID();
+
+		// Entities without an entity model ID cannot share their static model, always scan them
+		if (!entityModelID)
+		{
+			return findFirmwareImage(controlledEntity.getConfigurationNode(configurationIndex));
+		}
+
+		auto const key = FirmwareImageKey{ entityModelID, configurationIndex };
+		{
+			auto const lg = std::lock_guard{ _firmwareImageCacheLock };
+			if (auto const it = _firmwareImageCache.find(key); it != _firmwareImageCache.end())
+			{
+				return it->second;
+			}
+		}
+
+		// Scan outside the lock, concurrent scans of the same model will produce the same result
+		auto firmwareImage = findFirmwareImage(controlledEntity.getConfigurationNode(configurationIndex));
+
+		auto const lg = std::lock_guard{ _firmwareImageCacheLock };
+		_firmwareImageCache.emplace(key, firmwareImage);
+		return firmwareImage;
+	}
+
+	/** Returns the data of the entity if its firmware can be updated. Thread-safe */
+	std::optional<EntityData> makeEntityData(la::avdecc::UniqueIdentifier const& entityID, la::avdecc::controller::ControlledEntity const& controlledEntity) noexcept
+	{
+		try
+		{
+			if (controlledEntity.getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+			{
+				auto const& entityNode = controlledEntity.getEntityNode();
+				if (entityNode.dynamicModel)
+				{
+					if (auto const firmwareImage = getFirmwareImage(controlledEntity, entityNode.dynamicModel->currentConfiguration))
+					{
+						auto modelName = QString{};
+						if (entityNode.staticModel)
+						{
+							modelName = controlledEntity.getLocalizedString(entityNode.staticModel->modelNameString).data();
+						}
+						return EntityData{ entityID, avdecc::helper::smartEntityName(controlledEntity), entityNode.dynamicModel->firmwareVersion.data(), std::move(modelName), *firmwareImage };
+					}
+				}
+			}
+		}
+		catch (...)
+		{
+			// Ignore exceptions
+		}
+		return std::nullopt;
+	}
+
+	// Insert the entities at the end, in a single operation
+	void insertEntities(Entities&& entities)
+	{
+		if (entities.empty())
+		{
+			return;
+		}
+
+		Q_Q(Model);
+
+		auto const first = rowCount();
+		emit q->beginInsertRows({}, first, first + static_cast<int>(entities.size()) - 1);
+
+		std::move(entities.begin(), entities.end(), std::back_inserter(_entities));
+
+		// Update the cache (only the new rows)
+		updateEntityRowMap(first);
+
+		emit q->endInsertRows();
+	}
+
+public:
+	// Scan all the online entities in parallel (called once, to initialize the model)
+	void loadOnlineEntities()
+	{
+		auto entities = Entities{};
+		avdecc::ControllerManager::getInstance().mapReduceEntities(
+			[this](la::avdecc::UniqueIdentifier const& entityID, la::avdecc::controller::ControlledEntity const& controlledEntity)
+			{
+				return makeEntityData(entityID, controlledEntity);
+			},
+			[&entities, this](la::avdecc::UniqueIdentifier const& entityID, std::optional<EntityData>&& data)
+			{
+				// Might have been inserted by an entityOnline notification in the meantime
+				if (data && _entityRowMap.count(entityID) == 0)
+				{
+					entities.push_back(std::move(*data));
+				}
+			});
+		insertEntities(std::move(entities));
+	}
+
+private:
 
 	QModelIndex createIndex(int const row, Model::Column const column) const
 	{
@@ -298,6 +426,8 @@ private:
 
 	Entities _entities{};
 	EntityRowMap _entityRowMap{};
+	std::mutex _firmwareImageCacheLock{};
+	FirmwareImageCache _firmwareImageCache{};
 };
 
 Model::Model(QObject* parent)
@@ -305,13 +435,8 @@ Model::Model(QObject* parent)
 	, d_ptr{ new ModelPrivate{ this } }
 {
 	// Initialize the model for each existing entity
-	auto& manager = avdecc::ControllerManager::getInstance();
-	manager.foreachEntity(
-		[this](la::avdecc::UniqueIdentifier const& entityID, la::avdecc::controller::ControlledEntity const&)
-		{
-			Q_D(Model);
-			d->handleEntityOnline(entityID);
-		});
+	Q_D(Model);
+	d->loadOnlineEntities();
 }
 
 Model::~Model() = default;
@@ -346,6 +471,18 @@ la::avdecc::UniqueIdentifier Model::controlledEntityID(QModelIndex const& index)
 	return d->controlledEntityID(index);
 }
 
+QString Model::modelName(QModelIndex const& index) const
+{
+	Q_D(const Model);
+	return d->modelName(index);
+}
+
+std::optional<Model::FirmwareImage> Model::firmwareImage(QModelIndex const& index) const
+{
+	Q_D(const Model);
+	return d->firmwareImage(index);
+}
+
 /***********************************************/
 
 MultiFirmwareUpdateDialog::MultiFirmwareUpdateDialog(QWidget* parent)
@@ -374,6 +511,35 @@ MultiFirmwareUpdateDialog::MultiFirmwareUpdateDialog(QWidget* parent)
 
 	connect(_ui->controllerTableView->selectionModel(), &QItemSelectionModel::selectionChanged, this, &MultiFirmwareUpdateDialog::onItemSelectionChanged);
 	connect(_ui->buttonContinue, &QPushButton::clicked, this, &MultiFirmwareUpdateDialog::handleContinueButtonClicked);
+
+	// Context menu to select all the entities of the same model, so they can be updated as a single group
+	_ui->controllerTableView->setContextMenuPolicy(Qt::CustomContextMenu);
+	connect(_ui->controllerTableView, &QTableView::customContextMenuRequested, this,
+		[this](QPoint const& pos)
+		{
+			auto const index = _ui->controllerTableView->indexAt(pos);
+			auto const modelName = _model->modelName(index);
+			if (!index.isValid() || modelName.isEmpty())
+			{
+				return;
+			}
+
+			QMenu menu;
+			auto* const selectModelAction = menu.addAction("Select All Entities of Model \"" + modelName + "\"");
+			if (menu.exec(_ui->controllerTableView->viewport()->mapToGlobal(pos)) == selectModelAction)
+			{
+				auto selection = QItemSelection{};
+				for (auto row = 0; row < _model->rowCount(); ++row)
+				{
+					auto const rowIndex = _model->index(row, 0);
+					if (_model->modelName(rowIndex) == modelName)
+					{
+						selection.select(rowIndex, rowIndex);
+					}
+				}
+				_ui->controllerTableView->selectionModel()->select(selection, QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows);
+			}
+		});
 }
 
 MultiFirmwareUpdateDialog::~MultiFirmwareUpdateDialog()
@@ -396,29 +562,24 @@ void MultiFirmwareUpdateDialog::onItemSelectionChanged(QItemSelection const&, QI
 		return;
 	}
 
-	auto& manager = avdecc::ControllerManager::getInstance();
-
 	// Check that all selected entities have the same model name
 	QString modelName;
 	for (auto const& rowIndex : selectedRows)
 	{
-		auto const entityID = _model->controlledEntityID(rowIndex);
-		auto const controlledEntity = manager.getControlledEntity(entityID);
-		auto const& entityNode = controlledEntity->getEntityNode();
-
-		if (entityNode.staticModel)
+		auto const rowModelName = _model->modelName(rowIndex);
+		if (rowModelName.isEmpty())
 		{
-			auto const rowModelName = controlledEntity->getLocalizedString(entityNode.staticModel->modelNameString).data();
+			continue;
+		}
 
-			if (modelName.isEmpty())
-			{
-				modelName = rowModelName;
-			}
-			else if (modelName != rowModelName)
-			{
-				_ui->buttonContinue->setEnabled(false);
-				return;
-			}
+		if (modelName.isEmpty())
+		{
+			modelName = rowModelName;
+		}
+		else if (modelName != rowModelName)
+		{
+			_ui->buttonContinue->setEnabled(false);
+			return;
 		}
 	}
 
@@ -442,58 +603,47 @@ void MultiFirmwareUpdateDialog::startFirmwareUpdate()
 		return;
 	}
 
-	// Determine the maximum length (TODO, cache in the model?)
-	auto& manager = avdecc::ControllerManager::getInstance();
-	auto maximumLength = 0;
+	// Determine the maximum length, using the firmware images scanned by the model (once per entity model)
+	auto maximumLength = std::uint64_t{ 0u };
 
 	auto firmwareUpdateEntityInfos = std::vector<FirmwareUploadDialog::EntityInfo>{};
 
 	auto const& selectedRows = _ui->controllerTableView->selectionModel()->selectedRows();
 	for (auto const& index : selectedRows)
 	{
-		auto const entityID = _model->controlledEntityID(index);
-		auto const controlledEntity = manager.getControlledEntity(entityID);
-		if (controlledEntity)
+		if (auto const firmwareImage = _model->firmwareImage(index))
 		{
-			auto const& entityNode = controlledEntity->getEntityNode();
-			if (entityNode.dynamicModel)
+			// The whole group must be able to store the image, keep the smallest non-zero length
+			if (firmwareImage->maximumLength != 0 && (maximumLength == 0 || firmwareImage->maximumLength < maximumLength))
 			{
-				auto const configurationIndex = entityNode.dynamicModel->currentConfiguration;
-				auto const& configurationNode = controlledEntity->getConfigurationNode(configurationIndex);
-				for (auto const& [memoryObjectIndex, memoryObjectNode] : configurationNode.memoryObjects)
-				{
-					if (memoryObjectNode.staticModel->memoryObjectType == la::avdecc::entity::model::MemoryObjectType::FirmwareImage)
-					{
-						if (maximumLength == 0)
-						{
-							// Pick first entity's max length, all following entities should have the same.
-							maximumLength = memoryObjectNode.staticModel->maximumLength;
-						}
-
-						auto const* const model = memoryObjectNode.staticModel;
-						firmwareUpdateEntityInfos.emplace_back(entityID, memoryObjectNode.descriptorIndex, model->startAddress);
-						break;
-					}
-				}
+				maximumLength = firmwareImage->maximumLength;
 			}
+
+			firmwareUpdateEntityInfos.emplace_back(_model->controlledEntityID(index), firmwareImage->descriptorIndex, firmwareImage->startAddress);
 		}
 	}
 
-	// Read all data
-	auto firmwareFileData = file.readAll();
-
 	// Check length
-	if (maximumLength != 0 && firmwareFileData.size() > maximumLength)
+	if (maximumLength != 0 && static_cast<std::uint64_t>(file.size()) > maximumLength)
 	{
 		QMessageBox::critical(this, "", "The firmware file is not compatible with selected devices.");
 		return;
 	}
 
+	// Load the firmware image
+	auto const firmwareImage = FirmwareUploadDialog::readFirmwareFile(file);
+	if (firmwareImage.size == 0u)
+	{
+		QMessageBox::critical(this, "", "Failed to load firmware file.");
+		return;
+	}
+	file.close();
+
 	// Close this dialog once a compatible file has been selected
 	close();
 
-	// Start firmware upload dialog
-	auto dialog = FirmwareUploadDialog{ { firmwareFileData.constData(), static_cast<size_t>(firmwareFileData.count()) }, QFileInfo(fileName).fileName(), firmwareUpdateEntityInfos, this };
+	// Start firmware upload dialog (a single read-only image is shared by all the entities of the group)
+	auto dialog = FirmwareUploadDialog{ firmwareImage, QFileInfo(fileName).fileName(), firmwareUpdateEntityInfos, this };
 	dialog.exec();
 }
 
@@ -22,6 +22,8 @@
 #include "avdecc/helper.hpp"
 #include "errorItemDelegate.hpp"
 
+#include <mutex>
+#include <thread>
 #include <vector>
 
 class NetworkInterfaceModelPrivate : public QObject, private la::avdecc::networkInterface::NetworkInterfaceObserver
@@ -30,9 +32,54 @@ public:
 	NetworkInterfaceModelPrivate(NetworkInterfaceModel* q)
 		: q_ptr{ q }
 	{
+		// Registering enumerates the interfaces (notified right away), which can take a while: do it on a worker thread
+		_enumerationThread = std::thread{
+			[this]()
+			{
+				la::avdecc::networkInterface::registerObserver(this);
+
+				// All the existing interfaces have been notified, insert them at once
+				QMetaObject::invokeMethod(this,
+					[this]()
+					{
+						Q_Q(NetworkInterfaceModel);
+						flushPendingInterfaces();
+						_isEnumerationCompleted = true;
+						emit q->enumerationCompleted();
+					});
+			}
+		};
+	}
+
+	~NetworkInterfaceModelPrivate()
+	{
+		if (_enumerationThread.joinable())
+		{
+			_enumerationThread.join();
+		}
 	}
 
 private:
+	// Inserts the added interfaces not inserted yet, in a single batch. Must be called before processing any other change, so they stay ordered.
+	void flushPendingInterfaces() noexcept
+	{
+		auto interfaces = std::vector<Data>{};
+		{
+			auto const lg = std::lock_guard{ _pendingInterfacesLock };
+			interfaces.swap(_pendingInterfaces);
+		}
+		if (interfaces.empty())
+		{
+			return;
+		}
+
+		Q_Q(NetworkInterfaceModel);
+		auto const count = q->rowCount();
+		emit q->beginInsertRows({}, count, count + static_cast<int>(interfaces.size()) - 1);
+		_interfaces.insert(_interfaces.end(), std::make_move_iterator(interfaces.begin()), std::make_move_iterator(interfaces.end()));
+		emit q->endInsertRows();
+	}
+
 	QModelIndex indexOf(std::string const& id) const noexcept
 	{
 		Q_Q(const NetworkInterfaceModel);
@@ -52,20 +99,29 @@ private:
 	// la::avdecc::networkInterface::NetworkInterfaceObserver overrides
 	void onInterfaceAdded(la::avdecc::networkInterface::Interface const& intfc) noexcept
 	{
-		QMetaObject::invokeMethod(this,
-			[this, intfc = intfc]()
-			{
-				Q_Q(NetworkInterfaceModel);
+		// Only use non-virtual, enabled, Ethernet interfaces
+		if (intfc.isVirtual)
+		{
+			return;
+		}
+
+		// Queued until the next flush, a single insertion being posted for consecutive additions
+		auto isFirstPendingInterface = false;
+		{
+			auto const lg = std::lock_guard{ _pendingInterfacesLock };
+			isFirstPendingInterface = _pendingInterfaces.empty();
+			_pendingInterfaces.push_back(Data{ intfc.id, intfc.alias, intfc.isEnabled, intfc.isConnected, intfc.type });
+		}
 
-				// Only use non-virtual, enabled, Ethernet interfaces
-				if (!intfc.isVirtual)
+		if (isFirstPendingInterface)
+		{
+			QMetaObject::invokeMethod(this,
+				[this]()
 				{
-					auto const count = q->rowCount();
-					emit q->beginInsertRows({}, count, count);
-					_interfaces.push_back(Data{ intfc.id, intfc.alias, intfc.isEnabled, intfc.isConnected, intfc.type });
-					emit q->endInsertRows();
-				}
-			});
+					flushPendingInterfaces();
+				},
+				Qt::QueuedConnection);
+		}
 	}
 	void onInterfaceRemoved(la::avdecc::networkInterface::Interface const& intfc) noexcept
 	{
@@ -73,6 +129,7 @@ private:
 			[this, id = intfc.id]()
 			{
 				Q_Q(NetworkInterfaceModel);
+				flushPendingInterfaces();
 
 				// Search the element
 				auto const index = indexOf(id);
@@ -92,6 +149,7 @@ private:
 			[this, id = intfc.id, isEnabled]()
 			{
 				Q_Q(NetworkInterfaceModel);
+				flushPendingInterfaces();
 
 				// Search the element
 				auto const index = indexOf(id);
@@ -111,6 +169,7 @@ private:
 			[this, id = intfc.id, isConnected]()
 			{
 				Q_Q(NetworkInterfaceModel);
+				flushPendingInterfaces();
 
 				// Search the element
 				auto const index = indexOf(id);
@@ -139,6 +198,10 @@ private:
 
 	// Private Members
 	std::vector<Data> _interfaces{};
+	std::mutex _pendingInterfacesLock{};
+	std::vector<Data> _pendingInterfaces{}; // Added interfaces not inserted yet, protected by _pendingInterfacesLock
+	bool _isEnumerationCompleted{ false };
+	std::thread _enumerationThread{};
 	DECLARE_AVDECC_OBSERVER_GUARD(NetworkInterfaceModelPrivate);
 };
 
@@ -146,7 +209,6 @@ NetworkInterfaceModel::NetworkInterfaceModel(QObject* parent)
 	: QAbstractListModel{ parent }
 	, d_ptr{ new NetworkInterfaceModelPrivate{ this } }
 {
-	la::avdecc::networkInterface::registerObserver(d_ptr.get());
 }
 
 NetworkInterfaceModel::~NetworkInterfaceModel() = default;
@@ -167,6 +229,12 @@ bool NetworkInterfaceModel::isEnabled(QString const& id) const noexcept
 	return it->isEnabled;
 }
 
+bool NetworkInterfaceModel::isEnumerationCompleted() const noexcept
+{
+	Q_D(const NetworkInterfaceModel);
+	return d->_isEnumerationCompleted;
+}
+
 la::avdecc::networkInterface::Interface::Type NetworkInterfaceModel::interfaceType(QModelIndex const& index) const noexcept
 {
 	Q_D(const NetworkInterfaceModel);
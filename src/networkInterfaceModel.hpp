@@ -23,18 +23,24 @@
 #include <QScopedPointer>
 #include <la/avdecc/networkInterfaceHelper.hpp>
 
-// Model for Network Interfaces
+// Model for Network Interfaces, the initial list being enumerated on a worker thread then inserted at once
 class NetworkInterfaceModelPrivate;
 class NetworkInterfaceModel final : public QAbstractListModel
 {
+	Q_OBJECT
 public:
 	NetworkInterfaceModel(QObject* parent = nullptr);
 	virtual ~NetworkInterfaceModel();
 
 	bool isEnabled(QString const& id) const noexcept;
 
+	// Returns true once the initial list of interfaces has been inserted
+	bool isEnumerationCompleted() const noexcept;
+
 	la::avdecc::networkInterface::Interface::Type interfaceType(QModelIndex const& index) const noexcept;
 
+	Q_SIGNAL void enumerationCompleted();
+
 private:
 	// QAbstractListModel overrides
 	virtual int rowCount(QModelIndex const& parent = {}) const override;
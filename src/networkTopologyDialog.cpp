@@ -0,0 +1,422 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "networkTopologyDialog.hpp"
+#include "avdecc/helper.hpp"
+#include "toolkit/graph/hub.hpp"
+#include "toolkit/graph/linkSet.hpp"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+static constexpr qreal Pi = 3.14159265358979323846;
+static constexpr qreal LinkLength = 140.0;
+static constexpr qreal RepulsionRadius = 3 * LinkLength;
+static constexpr int LocalIterations = 40; // Relaxation around the changed systems
+static constexpr int FullIterations = 200; // First layout, or explicit relayout
+static constexpr auto LayoutDelay = std::chrono::milliseconds{ 100 }; // Changes are coalesced, a network enumeration produces bursts of them
+
+static graph::HubItem::Kind toHubKind(avdecc::topology::NodeInfo::Kind const kind) noexcept
+{
+	return kind == avdecc::topology::NodeInfo::Kind::Endpoint ? graph::HubItem::Kind::Endpoint : graph::HubItem::Kind::Bridge;
+}
+
+NetworkTopologyDialog::NetworkTopologyDialog(QWidget* parent)
+	: QDialog{ parent, Qt::WindowSystemMenuHint | Qt::WindowTitleHint | Qt::WindowCloseButtonHint | Qt::WindowMaximizeButtonHint }
+{
+	setWindowTitle("Network Topology");
+	resize(960, 720);
+
+	_view.setScene(&_scene);
+	_view.setZoomEnabled(true);
+
+	_linkSet = new graph::LinkSetItem;
+	_scene.addItem(_linkSet);
+
+	_layoutTimer.setSingleShot(true);
+	_layoutTimer.setInterval(LayoutDelay);
+
+	auto* const buttonsLayout = new QHBoxLayout;
+	buttonsLayout->addWidget(&_statusLabel, 1);
+	buttonsLayout->addWidget(&_relayoutButton);
+	buttonsLayout->addWidget(&_fitButton);
+
+	auto* const layout = new QVBoxLayout{ this };
+	layout->addWidget(&_view, 1);
+	layout->addLayout(buttonsLayout);
+
+	connect(&_layoutTimer, &QTimer::timeout, this,
+		[this]()
+		{
+			placeNewNodes();
+
+			// Only the changed systems and their direct neighbours move, the rest of the layout is kept as is
+			auto movableNodes = _changedNodes;
+			for (auto const& nodeID : _changedNodes)
+			{
+				auto const it = _neighbours.find(nodeID);
+				if (it != _neighbours.end())
+				{
+					movableNodes.insert(it->second.begin(), it->second.end());
+				}
+			}
+			_changedNodes.clear();
+			relax(movableNodes, _fitPending ? FullIterations : LocalIterations);
+			updateStatus();
+
+			if (_fitPending && !_hubs.empty())
+			{
+				_fitPending = false;
+				_view.fitInView(_scene.itemsBoundingRect(), Qt::KeepAspectRatio);
+			}
+		});
+
+	connect(&_relayoutButton, &QPushButton::clicked, this,
+		[this]()
+		{
+			auto allNodes = NodeIDs{};
+			for (auto const& hubKV : _hubs)
+			{
+				allNodes.insert(hubKV.first);
+			}
+			relax(allNodes, FullIterations);
+		});
+
+	connect(&_fitButton, &QPushButton::clicked, this,
+		[this]()
+		{
+			_view.fitInView(_scene.itemsBoundingRect(), Qt::KeepAspectRatio);
+		});
+
+	// Current topology, then follow its changes
+	auto& topology = avdecc::topology::NetworkTopology::getInstance();
+	for (auto const& nodeID : topology.getNodes())
+	{
+		addNode(nodeID);
+	}
+	for (auto const& link : topology.getLinks())
+	{
+		addLink(link);
+	}
+
+	connect(&topology, &avdecc::topology::NetworkTopology::nodeAdded, this, &NetworkTopologyDialog::addNode);
+	connect(&topology, &avdecc::topology::NetworkTopology::nodeRemoved, this, &NetworkTopologyDialog::removeNode);
+	connect(&topology, &avdecc::topology::NetworkTopology::nodeChanged, this, &NetworkTopologyDialog::updateNode);
+	connect(&topology, &avdecc::topology::NetworkTopology::linkAdded, this, &NetworkTopologyDialog::addLink);
+	connect(&topology, &avdecc::topology::NetworkTopology::linkRemoved, this, &NetworkTopologyDialog::removeLink);
+
+	updateStatus();
+}
+
+void NetworkTopologyDialog::addNode(NodeID const nodeID) noexcept
+{
+	auto const info = avdecc::topology::NetworkTopology::getInstance().getNodeInfo(nodeID);
+	if (!info || _hubs.count(nodeID) > 0)
+	{
+		return;
+	}
+
+	auto* const hub = new graph::HubItem{ toHubKind(info->kind), info->name };
+	hub->setToolTip(QString{ "Clock Identity: %1" }.arg(avdecc::helper::uniqueIdentifierToString(nodeID)));
+	hub->setLinkSet(_linkSet);
+	// Hidden until placed next to its neighbours
+	hub->setVisible(false);
+	_scene.addItem(hub);
+
+	_hubs.emplace(nodeID, hub);
+	_unplacedNodes.insert(nodeID);
+	scheduleLayout(nodeID);
+}
+
+void NetworkTopologyDialog::removeNode(NodeID const nodeID) noexcept
+{
+	auto const it = _hubs.find(nodeID);
+	if (it == _hubs.end())
+	{
+		return;
+	}
+
+	auto* const hub = it->second;
+	_hubs.erase(it);
+	_linkSet->removeHub(hub);
+	delete hub;
+
+	_neighbours.erase(nodeID);
+	_unplacedNodes.erase(nodeID);
+	_changedNodes.erase(nodeID);
+
+	// Refreshes the status
+	if (!_layoutTimer.isActive())
+	{
+		_layoutTimer.start();
+	}
+}
+
+void NetworkTopologyDialog::updateNode(NodeID const nodeID) noexcept
+{
+	auto const it = _hubs.find(nodeID);
+	if (it == _hubs.end())
+	{
+		return;
+	}
+
+	if (auto const info = avdecc::topology::NetworkTopology::getInstance().getNodeInfo(nodeID))
+	{
+		it->second->setKind(toHubKind(info->kind));
+		it->second->setText(info->name);
+		updateStatus();
+	}
+}
+
+void NetworkTopologyDialog::addLink(avdecc::topology::Link const& link) noexcept
+{
+	auto const firstIt = _hubs.find(link.first);
+	auto const secondIt = _hubs.find(link.second);
+	if (firstIt == _hubs.end() || secondIt == _hubs.end())
+	{
+		return;
+	}
+
+	_linkSet->addLink(firstIt->second, secondIt->second);
+	_neighbours[link.first].insert(link.second);
+	_neighbours[link.second].insert(link.first);
+	scheduleLayout(link.first);
+	scheduleLayout(link.second);
+}
+
+void NetworkTopologyDialog::removeLink(avdecc::topology::Link const& link) noexcept
+{
+	auto const firstIt = _hubs.find(link.first);
+	auto const secondIt = _hubs.find(link.second);
+	if (firstIt != _hubs.end() && secondIt != _hubs.end())
+	{
+		_linkSet->removeLink(firstIt->second, secondIt->second);
+	}
+
+	_neighbours[link.first].erase(link.second);
+	_neighbours[link.second].erase(link.first);
+	scheduleLayout(link.first);
+	scheduleLayout(link.second);
+}
+
+void NetworkTopologyDialog::scheduleLayout(NodeID const nodeID) noexcept
+{
+	if (_hubs.count(nodeID) == 0)
+	{
+		return;
+	}
+
+	_changedNodes.insert(nodeID);
+	if (!_layoutTimer.isActive())
+	{
+		_layoutTimer.start();
+	}
+}
+
+void NetworkTopologyDialog::placeNewNodes() noexcept
+{
+	auto isPlaced = [this](NodeID const nodeID)
+	{
+		return _unplacedNodes.count(nodeID) == 0;
+	};
+
+	while (!_unplacedNodes.empty())
+	{
+		// Grow from the placed systems, so a new chain extends its existing part
+		auto progressed = false;
+		for (auto it = _unplacedNodes.begin(); it != _unplacedNodes.end();)
+		{
+			auto const nodeID = *it;
+			auto centroid = QPointF{};
+			auto placedNeighbours = 0;
+			for (auto const& neighbourID : _neighbours[nodeID])
+			{
+				if (isPlaced(neighbourID))
+				{
+					centroid += _hubs.at(neighbourID)->pos();
+					++placedNeighbours;
+				}
+			}
+
+			if (placedNeighbours == 0)
+			{
+				++it;
+				continue;
+			}
+
+			// Deterministic direction, so successive opening of the dialog give the same layout
+			auto const angle = static_cast<qreal>(nodeID.getValue() % 360u) * Pi / 180.0;
+			auto* const hub = _hubs.at(nodeID);
+			hub->setPos(centroid / placedNeighbours + QPointF{ std::cos(angle), std::sin(angle) } * LinkLength);
+			hub->setVisible(true);
+			it = _unplacedNodes.erase(it);
+			progressed = true;
+		}
+
+		// A new component (no placed neighbour at all), start it next to what is already displayed
+		if (!progressed)
+		{
+			auto const nodeID = *_unplacedNodes.begin();
+			auto bounds = QRectF{};
+			for (auto const& [id, hub] : _hubs)
+			{
+				if (isPlaced(id))
+				{
+					bounds |= QRectF{ hub->pos(), QSizeF{ 1, 1 } };
+				}
+			}
+			auto* const hub = _hubs.at(nodeID);
+			hub->setPos(bounds.isNull() ? QPointF{} : QPointF{ bounds.right() + 2 * LinkLength, bounds.center().y() });
+			hub->setVisible(true);
+			_unplacedNodes.erase(nodeID);
+		}
+	}
+}
+
+void NetworkTopologyDialog::relax(NodeIDs const& movableNodes, int const iterations) noexcept
+{
+	if (movableNodes.empty())
+	{
+		return;
+	}
+
+	// Repulsion is only computed between close systems, found through a grid of RepulsionRadius cells
+	auto const cellCoordinate = [](qreal const value)
+	{
+		return static_cast<std::int32_t>(std::floor(value / RepulsionRadius));
+	};
+	auto const cellKey = [](std::int32_t const x, std::int32_t const y)
+	{
+		return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+	};
+
+	for (auto iteration = 0; iteration < iterations; ++iteration)
+	{
+		auto grid = std::unordered_map<std::uint64_t, std::vector<graph::HubItem*>>{};
+		for (auto const& hubKV : _hubs)
+		{
+			auto const pos = hubKV.second->pos();
+			grid[cellKey(cellCoordinate(pos.x()), cellCoordinate(pos.y()))].push_back(hubKV.second);
+		}
+
+		// Maximum displacement decreases over the iterations so the layout settles
+		auto const temperature = LinkLength * 0.5 * (1.0 - static_cast<qreal>(iteration) / iterations) + 1.0;
+
+		for (auto const& nodeID : movableNodes)
+		{
+			auto const hubIt = _hubs.find(nodeID);
+			if (hubIt == _hubs.end())
+			{
+				continue;
+			}
+			auto* const hub = hubIt->second;
+			auto const pos = hub->pos();
+			auto force = QPointF{};
+
+			auto const cellX = cellCoordinate(pos.x());
+			auto const cellY = cellCoordinate(pos.y());
+			for (auto dx = -1; dx <= 1; ++dx)
+			{
+				for (auto dy = -1; dy <= 1; ++dy)
+				{
+					auto const cellIt = grid.find(cellKey(cellX + dx, cellY + dy));
+					if (cellIt == grid.end())
+					{
+						continue;
+					}
+					for (auto const* const other : cellIt->second)
+					{
+						if (other == hub)
+						{
+							continue;
+						}
+						auto delta = pos - other->pos();
+						auto distance = std::hypot(delta.x(), delta.y());
+						if (distance < 1.0)
+						{
+							// Overlapping systems, push apart in a direction specific to each
+							auto const angle = static_cast<qreal>(nodeID.getValue() % 360u) * Pi / 180.0;
+							delta = QPointF{ std::cos(angle), std::sin(angle) };
+							distance = 1.0;
+						}
+						if (distance < RepulsionRadius)
+						{
+							force += delta / distance * (LinkLength * LinkLength / distance);
+						}
+					}
+				}
+			}
+
+			auto const neighboursIt = _neighbours.find(nodeID);
+			if (neighboursIt != _neighbours.end())
+			{
+				for (auto const& neighbourID : neighboursIt->second)
+				{
+					auto const neighbourIt = _hubs.find(neighbourID);
+					if (neighbourIt == _hubs.end())
+					{
+						continue;
+					}
+					auto const delta = neighbourIt->second->pos() - pos;
+					auto const distance = std::hypot(delta.x(), delta.y());
+					if (distance > 0.0)
+					{
+						force += delta / distance * (distance * distance / LinkLength);
+					}
+				}
+			}
+
+			auto const length = std::hypot(force.x(), force.y());
+			if (length > temperature)
+			{
+				force *= temperature / length;
+			}
+			hub->setPos(pos + force);
+		}
+	}
+}
+
+void NetworkTopologyDialog::updateStatus() noexcept
+{
+	auto bridges = size_t{ 0u };
+	auto endpoints = size_t{ 0u };
+	for (auto const& hubKV : _hubs)
+	{
+		if (hubKV.second->kind() == graph::HubItem::Kind::Endpoint)
+		{
+			++endpoints;
+		}
+		else
+		{
+			++bridges;
+		}
+	}
+
+	auto links = size_t{ 0u };
+	for (auto const& neighboursKV : _neighbours)
+	{
+		links += neighboursKV.second.size();
+	}
+
+	_statusLabel.setText(QString{ "%1 bridge(s), %2 endpoint(s), %3 link(s)" }.arg(bridges).arg(endpoints).arg(links / 2));
+}
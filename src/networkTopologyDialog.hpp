@@ -0,0 +1,83 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <QDialog>
+#include <QGraphicsScene>
+#include <QPushButton>
+#include <QLabel>
+#include <QTimer>
+
+#include "avdecc/networkTopology.hpp"
+#include "toolkit/graph/view.hpp"
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace graph
+{
+class HubItem;
+class LinkSetItem;
+} // namespace graph
+
+/**
+* Overview of the gPTP network topology (bridges and entity interfaces) built from the AS paths.
+* The layout is kept as long as the dialog lives, changes only relaxing the positions around the systems that changed.
+*/
+class NetworkTopologyDialog : public QDialog
+{
+	Q_OBJECT
+
+public:
+	NetworkTopologyDialog(QWidget* parent = nullptr);
+
+	// Deleted compiler auto-generated methods
+	NetworkTopologyDialog(NetworkTopologyDialog&&) = delete;
+	NetworkTopologyDialog(NetworkTopologyDialog const&) = delete;
+	NetworkTopologyDialog& operator=(NetworkTopologyDialog const&) = delete;
+	NetworkTopologyDialog& operator=(NetworkTopologyDialog&&) = delete;
+
+private:
+	using NodeID = avdecc::topology::NodeID;
+	using NodeIDs = std::unordered_set<NodeID, la::avdecc::UniqueIdentifier::hash>;
+
+	void addNode(NodeID const nodeID) noexcept;
+	void removeNode(NodeID const nodeID) noexcept;
+	void updateNode(NodeID const nodeID) noexcept;
+	void addLink(avdecc::topology::Link const& link) noexcept;
+	void removeLink(avdecc::topology::Link const& link) noexcept;
+	void scheduleLayout(NodeID const nodeID) noexcept;
+	void placeNewNodes() noexcept;
+	void relax(NodeIDs const& movableNodes, int const iterations) noexcept;
+	void updateStatus() noexcept;
+
+	QGraphicsScene _scene{ this };
+	graph::GraphicsView _view{ this };
+	QLabel _statusLabel{ this };
+	QPushButton _relayoutButton{ "Relayout", this };
+	QPushButton _fitButton{ "Fit", this };
+	QTimer _layoutTimer{ this };
+
+	graph::LinkSetItem* _linkSet{ nullptr }; // Owned by the scene
+	std::unordered_map<NodeID, graph::HubItem*, la::avdecc::UniqueIdentifier::hash> _hubs{}; // Owned by the scene
+	std::unordered_map<NodeID, NodeIDs, la::avdecc::UniqueIdentifier::hash> _neighbours{};
+	NodeIDs _unplacedNodes{};
+	NodeIDs _changedNodes{}; // Nodes (added, or whose links changed) around which the layout has to be relaxed
+	bool _fitPending{ true };
+};
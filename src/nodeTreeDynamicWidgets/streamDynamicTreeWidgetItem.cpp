@@ -18,6 +18,7 @@
 */
 
 #include "streamDynamicTreeWidgetItem.hpp"
+#include "avdecc/entitySubscriptions.hpp"
 #include "streamFormatComboBox.hpp"
 #include "talkerStreamConnectionWidget.hpp"
 #include "nodeTreeWidget.hpp"
@@ -68,11 +69,12 @@ StreamDynamicTreeWidgetItem::StreamDynamicTreeWidgetItem(la::avdecc::UniqueIdent
 		});
 
 	// Listen for changes
-	connect(&manager, &avdecc::ControllerManager::streamFormatChanged, formatComboBox,
-		[this, formatComboBox](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat)
+	auto& subscriptions = avdecc::EntitySubscriptions::getInstance();
+	auto const streamKey = avdecc::EntitySubscriptions::makeKey(_entityID, _streamType, _streamIndex);
+	subscriptions.streamFormatChanged().subscribe(formatComboBox, streamKey,
+		[formatComboBox](la::avdecc::entity::model::StreamFormat const& streamFormat)
 		{
-			if (entityID == _entityID && descriptorType == _streamType && streamIndex == _streamIndex)
-				formatComboBox->setCurrentStreamFormat(streamFormat);
+			formatComboBox->setCurrentStreamFormat(streamFormat);
 		});
 
 	//
@@ -119,29 +121,20 @@ StreamDynamicTreeWidgetItem::StreamDynamicTreeWidgetItem(la::avdecc::UniqueIdent
 		}
 
 		// Listen for events
-		connect(&manager, &avdecc::ControllerManager::streamFormatChanged, this,
-			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamFormat const streamFormat)
+		subscriptions.streamFormatChanged().subscribe(this, streamKey,
+			[this](la::avdecc::entity::model::StreamFormat const& streamFormat)
 			{
-				if (entityID == _entityID && descriptorType == _streamType && streamIndex == _streamIndex)
-				{
-					updateStreamFormat(streamFormat);
-				}
+				updateStreamFormat(streamFormat);
 			});
-		connect(&manager, &avdecc::ControllerManager::streamRunningChanged, this,
-			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, bool const isRunning)
+		subscriptions.streamRunningChanged().subscribe(this, streamKey,
+			[this](bool const& isRunning)
 			{
-				if (entityID == _entityID && descriptorType == _streamType && streamIndex == _streamIndex)
-				{
-					updateStreamIsRunning(isRunning);
-				}
+				updateStreamIsRunning(isRunning);
 			});
-		connect(&manager, &avdecc::ControllerManager::streamDynamicInfoChanged, this,
-			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, la::avdecc::entity::model::StreamDynamicInfo const& info)
+		subscriptions.streamDynamicInfoChanged().subscribe(this, streamKey,
+			[this](la::avdecc::entity::model::StreamDynamicInfo const& info)
 			{
-				if (entityID == _entityID && descriptorType == _streamType && streamIndex == _streamIndex)
-				{
-					updateStreamDynamicInfo(info);
-				}
+				updateStreamDynamicInfo(info);
 			});
 	}
 
@@ -176,13 +169,10 @@ StreamDynamicTreeWidgetItem::StreamDynamicTreeWidgetItem(la::avdecc::UniqueIdent
 		updateConnections(outputDynamicModel->connections);
 
 		// Listen for Connections changed signal
-		connect(&manager, &avdecc::ControllerManager::streamConnectionsChanged, this,
-			[this](la::avdecc::entity::model::StreamIdentification const& stream, la::avdecc::entity::model::StreamConnections const& connections)
+		subscriptions.streamConnectionsChanged().subscribe(this, avdecc::EntitySubscriptions::makeKey(_entityID, la::avdecc::entity::model::DescriptorType::StreamOutput, _streamIndex),
+			[this](la::avdecc::entity::model::StreamConnections const& connections)
 			{
-				if (stream.entityID == _entityID && stream.streamIndex == _streamIndex)
-				{
-					updateConnections(connections);
-				}
+				updateConnections(connections);
 			});
 	}
 }
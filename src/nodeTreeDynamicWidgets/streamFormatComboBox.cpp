@@ -22,8 +22,46 @@
 
 #include <QInputDialog>
 
+#include <map>
+
 Q_DECLARE_METATYPE(la::avdecc::entity::model::StreamFormat)
 
+/** Gets the formatted list of the stream formats, the same model being shared by all the combo boxes listing the same formats as long as one of them exists */
+static std::shared_ptr<QStandardItemModel> getStreamFormatsModel(StreamFormatComboBox::StreamFormats const& streamFormats)
+{
+	static auto s_models = std::map<StreamFormatComboBox::StreamFormats, std::weak_ptr<QStandardItemModel>>{};
+
+	auto& cachedModel = s_models[streamFormats];
+	if (auto model = cachedModel.lock())
+	{
+		return model;
+	}
+
+	// Forget the lists no combo box uses anymore
+	for (auto it = s_models.begin(); it != s_models.end();)
+	{
+		if (it->second.expired() && &it->second != &cachedModel)
+		{
+			it = s_models.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	auto model = std::make_shared<QStandardItemModel>();
+	for (auto const& streamFormat : streamFormats)
+	{
+		auto const streamFormatInfo = la::avdecc::entity::model::StreamFormatInfo::create(streamFormat);
+		auto* const item = new QStandardItem{ avdecc::helper::streamFormatToString(*streamFormatInfo) };
+		item->setData(QVariant::fromValue(streamFormat), Qt::UserRole);
+		model->appendRow(item);
+	}
+	cachedModel = model;
+	return model;
+}
+
 StreamFormatComboBox::StreamFormatComboBox(la::avdecc::UniqueIdentifier const entityID, QWidget* parent)
 	: AecpCommandComboBox(entityID, avdecc::ControllerManager::AecpCommandType::SetStreamFormat, parent)
 {
@@ -53,19 +91,20 @@ StreamFormatComboBox::StreamFormatComboBox(la::avdecc::UniqueIdentifier const en
 		});
 }
 
-void StreamFormatComboBox::setStreamFormats(StreamFormats const& streamFormats)
+StreamFormatComboBox::~StreamFormatComboBox()
 {
-	QSignalBlocker lock(this); // Block internal signals so clear and addItem do not trigger "currentIndexChanged"
+	// The shared model might be destroyed with us, the combo box must not notify the change of its items
+	blockSignals(true);
+}
 
-	clear();
+void StreamFormatComboBox::setStreamFormats(StreamFormats const& streamFormats)
+{
+	QSignalBlocker lock(this); // Block internal signals so setModel does not trigger "currentIndexChanged"
 
 	_streamFormats = streamFormats;
+	_streamFormatsModel = getStreamFormatsModel(_streamFormats);
 
-	for (auto const& streamFormat : _streamFormats)
-	{
-		auto const streamFormatInfo = la::avdecc::entity::model::StreamFormatInfo::create(streamFormat);
-		addItem(avdecc::helper::streamFormatToString(*streamFormatInfo), QVariant::fromValue(streamFormat));
-	}
+	setModel(_streamFormatsModel.get());
 }
 
 void StreamFormatComboBox::setCurrentStreamFormat(StreamFormat const& streamFormat)
@@ -75,29 +114,36 @@ void StreamFormatComboBox::setCurrentStreamFormat(StreamFormat const& streamForm
 	auto const streamFormatInfo = la::avdecc::entity::model::StreamFormatInfo::create(streamFormat);
 	auto const streamFormatString = avdecc::helper::streamFormatToString(*streamFormatInfo);
 
-	// The format is not present in the list?
-	if (_streamFormats.count(_previousFormat) == 0)
+	if (_streamFormats.count(streamFormat) != 0)
 	{
-		auto const index = findData(QVariant::fromValue(_previousFormat));
-
-		if (index != -1)
+		// Back to the shared list (the model of the previous custom format, owned by this combo box, is deleted by setModel)
+		if (_streamFormatsModel && model() != _streamFormatsModel.get())
 		{
-			removeItem(index);
+			setModel(_streamFormatsModel.get());
 		}
 	}
-
-	// We try to add a custom format
-	if (_streamFormats.count(streamFormat) == 0)
+	else
 	{
-		addItem(streamFormatString, QVariant::fromValue(streamFormat));
-
-		auto const index = findData(QVariant::fromValue(streamFormat));
+		// We try to add a custom format, to a copy of the shared list
+		auto* const customModel = new QStandardItemModel{ this };
+		if (_streamFormatsModel)
+		{
+			for (auto row = 0; row < _streamFormatsModel->rowCount(); ++row)
+			{
+				customModel->appendRow(_streamFormatsModel->item(row)->clone());
+			}
+		}
 
 		QFont font;
 		font.setBold(true);
 		font.setItalic(true);
 
-		setItemData(index, font, Qt::FontRole);
+		auto* const item = new QStandardItem{ streamFormatString };
+		item->setData(QVariant::fromValue(streamFormat), Qt::UserRole);
+		item->setData(font, Qt::FontRole);
+		customModel->appendRow(item);
+
+		setModel(customModel);
 	}
 
 	_previousFormat = streamFormat;
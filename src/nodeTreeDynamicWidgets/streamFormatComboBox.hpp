@@ -22,6 +22,10 @@
 #include "aecpCommandComboBox.hpp"
 #include <la/avdecc/controller/internals/avdeccControlledEntity.hpp>
 
+#include <QStandardItemModel>
+
+#include <memory>
+
 class StreamFormatComboBox final : public AecpCommandComboBox
 {
 	Q_OBJECT
@@ -30,6 +34,7 @@ public:
 	using StreamFormats = std::set<StreamFormat>;
 
 	StreamFormatComboBox(la::avdecc::UniqueIdentifier const entityID, QWidget* parent = nullptr);
+	~StreamFormatComboBox();
 
 	void setStreamFormats(StreamFormats const& streamFormats);
 	void setCurrentStreamFormat(StreamFormat const& streamFormat);
@@ -38,5 +43,6 @@ public:
 
 private:
 	StreamFormats _streamFormats{};
+	std::shared_ptr<QStandardItemModel> _streamFormatsModel{}; // Shared with the other combo boxes listing the same formats
 	StreamFormat _previousFormat{ 0 };
 };
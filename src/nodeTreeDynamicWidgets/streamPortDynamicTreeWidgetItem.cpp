@@ -22,12 +22,18 @@
 #endif // ENABLE_AVDECC_FEATURE_REDUNDANCY
 
 #include "streamPortDynamicTreeWidgetItem.hpp"
+#include "avdecc/entitySubscriptions.hpp"
 #include "mappingMatrix.hpp"
+#include "avdecc/commandChain.hpp"
 #include <vector>
 #include <utility>
 #include <cstdint>
+#include <algorithm>
+#include <iterator>
+#include <tuple>
 #include <QPushButton>
 #include <QMessageBox>
+#include <QAbstractListModel>
 
 /* ************************************************************ */
 /* Internal types and functions                                 */
@@ -39,7 +45,9 @@ struct NodeMapping
 };
 using NodeMappings = std::vector<NodeMapping>;
 using HashType = std::uint64_t;
-using HashedConnectionsList = std::set<HashType>;
+using HashedConnectionsList = std::vector<HashType>; // Sorted, without duplicates
+
+static constexpr auto MaxAudioMappingsPerCommand = size_t{ 63u }; // (524 bytes of AECP payload - 12 bytes of AEM header - 8 bytes of ADD/REMOVE_AUDIO_MAPPINGS header) / 8 bytes per mapping
 
 std::pair<NodeMappings, mappingMatrix::Nodes> buildClusterMappings(la::avdecc::controller::ControlledEntity const* const controlledEntity, la::avdecc::controller::model::StreamPortNode const& streamPortNode)
 {
@@ -210,22 +218,22 @@ HashedConnectionsList hashConnectionsList(mappingMatrix::Connections const& conn
 {
 	HashedConnectionsList list;
 
+	list.reserve(connections.size());
 	for (auto const& c : connections)
 	{
-		list.insert(makeHash(c));
+		list.push_back(makeHash(c));
 	}
+	std::sort(list.begin(), list.end());
+	list.erase(std::unique(list.begin(), list.end()), list.end());
 
 	return list;
 }
 
 HashedConnectionsList substractList(HashedConnectionsList const& a, HashedConnectionsList const& b)
 {
-	HashedConnectionsList sub{ a };
+	HashedConnectionsList sub;
 
-	for (auto const& v : b)
-	{
-		sub.erase(v);
-	}
+	std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(sub));
 
 	return sub;
 }
@@ -289,52 +297,193 @@ la::avdecc::entity::model::AudioMappings convertList(NodeMappings const& streamM
 	return mappings;
 };
 
+/** Splits the mappings in chunks small enough to fit in a single ADD/REMOVE_AUDIO_MAPPINGS command */
+std::vector<la::avdecc::entity::model::AudioMappings> splitMappings(la::avdecc::entity::model::AudioMappings const& mappings)
+{
+	std::vector<la::avdecc::entity::model::AudioMappings> chunks;
+
+	for (auto it = mappings.begin(); it != mappings.end();)
+	{
+		auto const chunkSize = std::min(MaxAudioMappingsPerCommand, static_cast<size_t>(std::distance(it, mappings.end())));
+		chunks.emplace_back(it, it + chunkSize);
+		it += chunkSize;
+	}
+
+	return chunks;
+}
+
+template<la::avdecc::entity::model::DescriptorType StreamPortType, bool IsAdd>
+avdecc::commandChain::AsyncParallelCommandSet::AsyncCommand makeMappingsCommand(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamPortIndex const streamPortIndex, la::avdecc::entity::model::AudioMappings const& mappings)
+{
+	return [=](avdecc::commandChain::AsyncParallelCommandSet* const parentCommandSet, uint32_t const commandIndex) -> bool
+	{
+		auto const commandType = IsAdd ? avdecc::ControllerManager::AecpCommandType::AddStreamPortAudioMappings : avdecc::ControllerManager::AecpCommandType::RemoveStreamPortAudioMappings;
+		auto responseHandler = [parentCommandSet, commandIndex, commandType](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::ControllerEntity::AemCommandStatus const status)
+		{
+			auto const error = avdecc::commandChain::AsyncParallelCommandSet::aemCommandStatusToCommandError(status);
+			if (error != avdecc::commandChain::CommandExecutionError::NoError)
+			{
+				parentCommandSet->addErrorInfo(entityID, error, commandType);
+			}
+			parentCommandSet->invokeCommandCompleted(commandIndex, error != avdecc::commandChain::CommandExecutionError::NoError);
+		};
+
+		auto& manager = avdecc::ControllerManager::getInstance();
+		if constexpr (StreamPortType == la::avdecc::entity::model::DescriptorType::StreamPortInput)
+		{
+			if constexpr (IsAdd)
+			{
+				manager.addStreamPortInputAudioMappings(entityID, streamPortIndex, mappings, responseHandler);
+			}
+			else
+			{
+				manager.removeStreamPortInputAudioMappings(entityID, streamPortIndex, mappings, responseHandler);
+			}
+		}
+		else if constexpr (StreamPortType == la::avdecc::entity::model::DescriptorType::StreamPortOutput)
+		{
+			if constexpr (IsAdd)
+			{
+				manager.addStreamPortOutputAudioMappings(entityID, streamPortIndex, mappings, responseHandler);
+			}
+			else
+			{
+				manager.removeStreamPortOutputAudioMappings(entityID, streamPortIndex, mappings, responseHandler);
+			}
+		}
+		return true;
+	};
+}
+
 template<la::avdecc::entity::model::DescriptorType StreamPortType>
 void processNewConnections(la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::StreamPortIndex const streamPortIndex, NodeMappings const& streamMappings, NodeMappings const& clusterMappings, mappingMatrix::Connections const& oldConn, mappingMatrix::Connections const& newConn)
 {
-	// Build lists of mappings to add/remove
+	// Build lists of mappings to add/remove (sorted lists, so the difference is computed in a single pass)
 	auto const oldConnections = hashConnectionsList(oldConn);
 	auto const newConnections = hashConnectionsList(newConn);
 
-	la::avdecc::entity::model::AudioMappings toRemove{};
-	la::avdecc::entity::model::AudioMappings toAdd{};
+	auto const toRemove = convertList<StreamPortType>(streamMappings, clusterMappings, substractList(oldConnections, newConnections));
+	auto const toAdd = convertList<StreamPortType>(streamMappings, clusterMappings, substractList(newConnections, oldConnections));
 
-	if constexpr (StreamPortType == la::avdecc::entity::model::DescriptorType::StreamPortInput)
-	{
-		toRemove = convertList<la::avdecc::entity::model::DescriptorType::StreamPortInput>(streamMappings, clusterMappings, substractList(oldConnections, newConnections));
-		toAdd = convertList<la::avdecc::entity::model::DescriptorType::StreamPortInput>(streamMappings, clusterMappings, substractList(newConnections, oldConnections));
-	}
-	else if constexpr (StreamPortType == la::avdecc::entity::model::DescriptorType::StreamPortOutput)
+	if (toRemove.empty() && toAdd.empty())
 	{
-		toRemove = convertList<la::avdecc::entity::model::DescriptorType::StreamPortOutput>(streamMappings, clusterMappings, substractList(oldConnections, newConnections));
-		toAdd = convertList<la::avdecc::entity::model::DescriptorType::StreamPortOutput>(streamMappings, clusterMappings, substractList(newConnections, oldConnections));
+		return;
 	}
 
-	// Remove and Add the mappings
-	auto& manager = avdecc::ControllerManager::getInstance();
+	// Remove then Add the mappings, each step being split in as few commands as possible, sent in parallel to the entity
+	auto commandSets = std::vector<avdecc::commandChain::AsyncParallelCommandSet*>{};
 	if (!toRemove.empty())
 	{
-		if constexpr (StreamPortType == la::avdecc::entity::model::DescriptorType::StreamPortInput)
+		auto* removeCommands = new avdecc::commandChain::AsyncParallelCommandSet;
+		for (auto const& chunk : splitMappings(toRemove))
 		{
-			manager.removeStreamPortInputAudioMappings(entityID, streamPortIndex, toRemove);
+			removeCommands->append(entityID, makeMappingsCommand<StreamPortType, false>(entityID, streamPortIndex, chunk));
 		}
-		else if constexpr (StreamPortType == la::avdecc::entity::model::DescriptorType::StreamPortOutput)
+		commandSets.push_back(removeCommands);
+	}
+	if (!toAdd.empty())
+	{
+		auto* addCommands = new avdecc::commandChain::AsyncParallelCommandSet;
+		for (auto const& chunk : splitMappings(toAdd))
 		{
-			manager.removeStreamPortOutputAudioMappings(entityID, streamPortIndex, toRemove);
+			addCommands->append(entityID, makeMappingsCommand<StreamPortType, true>(entityID, streamPortIndex, chunk));
 		}
+		commandSets.push_back(addCommands);
 	}
-	if (!toAdd.empty())
+
+	// The executer deletes itself once all the commands completed (errors are already reported by the ControllerManager)
+	auto* executer = new avdecc::commandChain::SequentialAsyncCommandExecuter;
+	QObject::connect(executer, &avdecc::commandChain::SequentialAsyncCommandExecuter::completed, executer, &QObject::deleteLater);
+	executer->setCommandChain(commandSets);
+	executer->start();
+}
+
+/* ************************************************************ */
+/* AudioMappingsListModel                                       */
+/* ************************************************************ */
+/** Sorted list of the dynamic mappings of a stream port, updated with the rows actually added or removed. The text of a row is only built when displayed */
+class AudioMappingsListModel final : public QAbstractListModel
+{
+public:
+	using QAbstractListModel::QAbstractListModel;
+
+	void setMappings(la::avdecc::entity::model::AudioMappings mappings)
 	{
-		if constexpr (StreamPortType == la::avdecc::entity::model::DescriptorType::StreamPortInput)
+		auto const isSame = [](auto const& lhs, auto const& rhs)
+		{
+			return !isLess(lhs, rhs) && !isLess(rhs, lhs);
+		};
+		std::sort(mappings.begin(), mappings.end(), &isLess);
+		mappings.erase(std::unique(mappings.begin(), mappings.end(), isSame), mappings.end());
+
+		// Merge both sorted lists, removing and inserting consecutive rows at once
+		auto row = size_t{ 0u };
+		auto newIt = mappings.begin();
+		while (row < _mappings.size() || newIt != mappings.end())
 		{
-			manager.addStreamPortInputAudioMappings(entityID, streamPortIndex, toAdd);
+			auto removeCount = size_t{ 0u };
+			while (row + removeCount < _mappings.size() && (newIt == mappings.end() || isLess(_mappings[row + removeCount], *newIt)))
+			{
+				++removeCount;
+			}
+			if (removeCount != 0u)
+			{
+				beginRemoveRows({}, static_cast<int>(row), static_cast<int>(row + removeCount - 1u));
+				_mappings.erase(_mappings.begin() + row, _mappings.begin() + row + removeCount);
+				endRemoveRows();
+				continue;
+			}
+
+			auto insertEnd = newIt;
+			while (insertEnd != mappings.end() && (row == _mappings.size() || isLess(*insertEnd, _mappings[row])))
+			{
+				++insertEnd;
+			}
+			if (insertEnd != newIt)
+			{
+				auto const insertCount = static_cast<size_t>(std::distance(newIt, insertEnd));
+				beginInsertRows({}, static_cast<int>(row), static_cast<int>(row + insertCount - 1u));
+				_mappings.insert(_mappings.begin() + row, newIt, insertEnd);
+				endInsertRows();
+				row += insertCount;
+				newIt = insertEnd;
+				continue;
+			}
+
+			// Same mapping in both lists
+			++row;
+			++newIt;
 		}
-		else if constexpr (StreamPortType == la::avdecc::entity::model::DescriptorType::StreamPortOutput)
+	}
+
+	// QAbstractListModel overrides
+	virtual int rowCount(QModelIndex const& parent = {}) const override
+	{
+		if (parent.isValid())
 		{
-			manager.addStreamPortOutputAudioMappings(entityID, streamPortIndex, toAdd);
+			return 0;
 		}
+		return static_cast<int>(_mappings.size());
+	}
+
+	virtual QVariant data(QModelIndex const& index, int role) const override
+	{
+		if (role == Qt::DisplayRole && index.isValid() && static_cast<size_t>(index.row()) < _mappings.size())
+		{
+			auto const& mapping = _mappings[index.row()];
+			return QString("%1.%2 > %3.%4").arg(mapping.streamIndex).arg(mapping.streamChannel).arg(mapping.clusterOffset).arg(mapping.clusterChannel);
+		}
+		return {};
 	}
-}
+
+private:
+	static bool isLess(la::avdecc::entity::model::AudioMapping const& lhs, la::avdecc::entity::model::AudioMapping const& rhs) noexcept
+	{
+		return std::tie(lhs.streamIndex, lhs.streamChannel, lhs.clusterOffset, lhs.clusterChannel) < std::tie(rhs.streamIndex, rhs.streamChannel, rhs.clusterOffset, rhs.clusterChannel);
+	}
+
+	la::avdecc::entity::model::AudioMappings _mappings{}; // Sorted, without duplicates
+};
 
 /* ************************************************************ */
 /* StreamPortDynamicTreeWidgetItem                              */
@@ -356,9 +505,12 @@ StreamPortDynamicTreeWidgetItem::StreamPortDynamicTreeWidgetItem(la::avdecc::Uni
 
 		auto* mappingsItem = new QTreeWidgetItem(this);
 		mappingsItem->setText(0, "Dynamic Mappings");
-		_mappingsList = new QListWidget;
-		_mappingsList->setSelectionMode(QAbstractItemView::NoSelection);
-		parent->setItemWidget(mappingsItem, 1, _mappingsList);
+		auto* mappingsView = new QListView;
+		mappingsView->setSelectionMode(QAbstractItemView::NoSelection);
+		mappingsView->setUniformItemSizes(true);
+		_mappingsModel = new AudioMappingsListModel(mappingsView);
+		mappingsView->setModel(_mappingsModel);
+		parent->setItemWidget(mappingsItem, 1, mappingsView);
 
 		// Update info right now
 		updateMappings();
@@ -370,14 +522,11 @@ StreamPortDynamicTreeWidgetItem::StreamPortDynamicTreeWidgetItem(la::avdecc::Uni
 		parent->setItemWidget(clearMappings, 1, clearMappingsButton);
 
 		// Listen for streamPortAudioMappingsChanged
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::streamPortAudioMappingsChanged, this,
-			[this](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamPortIndex const streamPortIndex)
+		avdecc::EntitySubscriptions::getInstance().streamPortAudioMappingsChanged().subscribe(this, avdecc::EntitySubscriptions::makeKey(_entityID, _streamPortType, _streamPortIndex),
+			[this]()
 			{
-				if (entityID == _entityID && descriptorType == _streamPortType && streamPortIndex == _streamPortIndex)
-				{
-					// Update mappings
-					updateMappings();
-				}
+				// Update mappings
+				updateMappings();
 			});
 
 		// TODO: Listen for entity offline events and close the popup window
@@ -580,7 +729,7 @@ void StreamPortDynamicTreeWidgetItem::updateMappings()
 {
 	constexpr auto showRedundantMappings = true;
 
-	_mappingsList->clear();
+	auto mappings = la::avdecc::entity::model::AudioMappings{};
 
 	try
 	{
@@ -589,7 +738,6 @@ void StreamPortDynamicTreeWidgetItem::updateMappings()
 		if (controlledEntity)
 		{
 			auto& entity = *controlledEntity;
-			auto mappings = la::avdecc::entity::model::AudioMappings{};
 
 			if (_streamPortType == la::avdecc::entity::model::DescriptorType::StreamPortInput)
 			{
@@ -613,16 +761,12 @@ void StreamPortDynamicTreeWidgetItem::updateMappings()
 					mappings = entity.getStreamPortOutputNonRedundantAudioMappings(_streamPortIndex);
 				}
 			}
-
-			for (auto const& mapping : mappings)
-			{
-				_mappingsList->addItem(QString("%1.%2 > %3.%4").arg(mapping.streamIndex).arg(mapping.streamChannel).arg(mapping.clusterOffset).arg(mapping.clusterChannel));
-			}
 		}
 	}
 	catch (...)
 	{
+		mappings.clear();
 	}
 
-	_mappingsList->sortItems();
+	_mappingsModel->setMappings(std::move(mappings));
 }
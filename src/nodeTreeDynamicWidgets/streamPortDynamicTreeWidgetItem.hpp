@@ -29,7 +29,9 @@
 #include <QPushButton>
 #include <QLabel>
 #include <QHBoxLayout>
-#include <QListWidget>
+#include <QListView>
+
+class AudioMappingsListModel;
 
 class StreamPortDynamicTreeWidgetItem : public QObject, public QTreeWidgetItem
 {
@@ -44,5 +46,5 @@ private:
 	la::avdecc::UniqueIdentifier const _entityID{};
 	la::avdecc::entity::model::DescriptorType const _streamPortType{ la::avdecc::entity::model::DescriptorType::Entity };
 	la::avdecc::entity::model::StreamPortIndex const _streamPortIndex{ 0u };
-	QListWidget* _mappingsList{ nullptr };
+	AudioMappingsListModel* _mappingsModel{ nullptr };
 };
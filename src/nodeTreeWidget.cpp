@@ -22,9 +22,9 @@
 #include <la/avdecc/controller/internals/avdeccControlledEntity.hpp>
 #include <la/avdecc/logger.hpp>
 #include "avdecc/controllerManager.hpp"
+#include "avdecc/entitySubscriptions.hpp"
 #include "avdecc/hiveLogItems.hpp"
 #include "avdecc/helper.hpp"
-#include "toolkit/textEntry.hpp"
 #include "toolkit/comboBox.hpp"
 #include "nodeTreeDynamicWidgets/audioUnitDynamicTreeWidgetItem.hpp"
 #include "nodeTreeDynamicWidgets/avbInterfaceDynamicTreeWidgetItem.hpp"
@@ -42,10 +42,11 @@
 #include "aecpCommandComboBox.hpp"
 
 #include <vector>
+#include <list>
+#include <functional>
 #include <utility>
 #include <algorithm>
 
-#include <QListWidget>
 #include <QHeaderView>
 #include <QFileDialog>
 #include <QPushButton>
@@ -55,6 +56,9 @@
 
 Q_DECLARE_METATYPE(la::avdecc::UniqueIdentifier)
 
+// Maximum number of descriptors of the current entity for which the items are kept (hidden) when not displayed
+static constexpr auto MaxCachedNodes = size_t{ 64u };
+
 class Label : public QWidget
 {
 	Q_OBJECT
@@ -115,6 +119,45 @@ private:
 	QImage _image;
 };
 
+/** A text item (value in column 1), optionally edited through the view's item delegate (so the editor only exists while editing) */
+class TextTreeWidgetItem : public QObject, public QTreeWidgetItem
+{
+public:
+	using EditedHandler = std::function<void(QString const& text)>;
+
+	TextTreeWidgetItem(QTreeWidgetItem* const parent, QString const& name, QString const& value, EditedHandler&& onEdited = {})
+		: QTreeWidgetItem{ parent }
+		, _onEdited{ std::move(onEdited) }
+	{
+		setText(0, name);
+		setText(1, value);
+
+		if (_onEdited)
+		{
+			setFlags(flags() | Qt::ItemIsEditable);
+		}
+	}
+
+	virtual void setData(int column, int role, QVariant const& value) override
+	{
+		// Values entered by the user are only sent, the displayed value being updated when the entity notifies the change
+		if (column == 1 && role == Qt::EditRole)
+		{
+			auto const text = value.toString();
+			if (_onEdited && text != QTreeWidgetItem::text(1))
+			{
+				_onEdited(text);
+			}
+			return;
+		}
+
+		QTreeWidgetItem::setData(column, role, value);
+	}
+
+private:
+	EditedHandler _onEdited{};
+};
+
 class NodeTreeWidgetPrivate : public QObject, public NodeVisitor
 {
 	Q_OBJECT
@@ -175,7 +218,17 @@ public:
 	{
 		Q_Q(NodeTreeWidget);
 
-		q->clear();
+		// Items are only kept for the entity being displayed (the nodes are no longer valid once it goes offline)
+		if (entityID != _controlledEntityID)
+		{
+			q->clear();
+			_cachedNodes.clear();
+			_uncachedItems.clear();
+		}
+		else
+		{
+			hideDisplayedItems();
+		}
 
 		_controlledEntityID = entityID;
 
@@ -184,10 +237,52 @@ public:
 
 		if (controlledEntity && node.getNode().has_value())
 		{
+			auto const* const baseNode = node.getBaseNode();
+
+			// Already built for this node, simply show the items again (they are kept up-to-date while hidden)
+			auto const it = std::find_if(std::begin(_cachedNodes), std::end(_cachedNodes),
+				[baseNode, isActiveConfiguration](auto const& cachedNode)
+				{
+					return cachedNode.node == baseNode && cachedNode.isActiveConfiguration == isActiveConfiguration;
+				});
+			if (it != std::end(_cachedNodes))
+			{
+				_cachedNodes.splice(std::begin(_cachedNodes), _cachedNodes, it);
+				for (auto* item : _cachedNodes.front().items)
+				{
+					item->setHidden(false);
+				}
+				return;
+			}
+
+			auto const firstItemIndex = q->topLevelItemCount();
+
 			NodeVisitor::accept(this, controlledEntity.get(), isActiveConfiguration, node);
-		}
 
-		q->expandAll();
+			auto items = std::vector<QTreeWidgetItem*>{};
+			for (auto index = firstItemIndex; index < q->topLevelItemCount(); ++index)
+			{
+				auto* item = q->topLevelItem(index);
+				expandRecursively(item);
+				items.push_back(item);
+			}
+
+			if (isCacheable(baseNode->descriptorType))
+			{
+				_cachedNodes.push_front(CachedNode{ baseNode, isActiveConfiguration, std::move(items) });
+
+				// Too many nodes kept, destroy the least recently displayed one
+				if (_cachedNodes.size() > MaxCachedNodes)
+				{
+					qDeleteAll(_cachedNodes.back().items);
+					_cachedNodes.pop_back();
+				}
+			}
+			else
+			{
+				_uncachedItems = std::move(items);
+			}
+		}
 	}
 
 private:
@@ -301,7 +396,7 @@ private:
 		if (node.dynamicModel->counters && !node.dynamicModel->counters->empty())
 		{
 			auto* countersItem = new EntityCountersTreeWidgetItem(_controlledEntityID, *node.dynamicModel->counters, q);
-			countersItem->setText(0, "Counters");
+			setCountersItemTitle(countersItem, controlledEntity);
 		}
 
 		// Statistics
@@ -372,7 +467,7 @@ private:
 		if (isActiveConfiguration && node.descriptorType == la::avdecc::entity::model::DescriptorType::StreamInput && node.dynamicModel->counters && !node.dynamicModel->counters->empty())
 		{
 			auto* countersItem = new StreamInputCountersTreeWidgetItem(_controlledEntityID, node.descriptorIndex, node.dynamicModel->connectionState.state == la::avdecc::entity::model::StreamConnectionState::State::Connected, *node.dynamicModel->counters, q);
-			countersItem->setText(0, "Counters");
+			setCountersItemTitle(countersItem, controlledEntity);
 		}
 	}
 
@@ -405,7 +500,7 @@ private:
 		if (isActiveConfiguration && node.descriptorType == la::avdecc::entity::model::DescriptorType::StreamOutput && node.dynamicModel->counters && !node.dynamicModel->counters->empty())
 		{
 			auto* countersItem = new StreamOutputCountersTreeWidgetItem(_controlledEntityID, node.descriptorIndex, *node.dynamicModel->counters, q);
-			countersItem->setText(0, "Counters");
+			setCountersItemTitle(countersItem, controlledEntity);
 		}
 	}
 
@@ -450,7 +545,7 @@ private:
 		if (isActiveConfiguration && node.dynamicModel->counters && !node.dynamicModel->counters->empty())
 		{
 			auto* countersItem = new AvbInterfaceCountersTreeWidgetItem(_controlledEntityID, node.descriptorIndex, *node.dynamicModel->counters, q);
-			countersItem->setText(0, "Counters");
+			setCountersItemTitle(countersItem, controlledEntity);
 		}
 	}
 
@@ -591,14 +686,13 @@ private:
 
 			auto* mappingsIndexItem = new QTreeWidgetItem(descriptorItem);
 			mappingsIndexItem->setText(0, "Mappings");
+			mappingsIndexItem->setText(1, QString::number(model->mappings.size()));
 
-			auto* listWidget = new QListWidget;
-
-			q->setItemWidget(mappingsIndexItem, 1, listWidget);
-
+			// One row per mapping, instead of an embedded list widget
 			for (auto const& mapping : model->mappings)
 			{
-				listWidget->addItem(QString("%1.%2 > %3.%4").arg(mapping.streamIndex).arg(mapping.streamChannel).arg(mapping.clusterOffset).arg(mapping.clusterChannel));
+				auto* mappingItem = new QTreeWidgetItem(mappingsIndexItem);
+				mappingItem->setText(1, QString("%1.%2 > %3.%4").arg(mapping.streamIndex).arg(mapping.streamChannel).arg(mapping.clusterOffset).arg(mapping.clusterChannel));
 			}
 		}
 	}
@@ -683,7 +777,7 @@ private:
 		if (isActiveConfiguration && node.dynamicModel->counters && !node.dynamicModel->counters->empty())
 		{
 			auto* countersItem = new ClockDomainCountersTreeWidgetItem(_controlledEntityID, node.descriptorIndex, *node.dynamicModel->counters, q);
-			countersItem->setText(0, "Counters");
+			setCountersItemTitle(countersItem, controlledEntity);
 		}
 	}
 
@@ -728,6 +822,43 @@ private:
 	}
 
 private:
+	/** Returns true if all the information displayed for this kind of descriptor is kept up-to-date, so its items can be reused */
+	static bool isCacheable(la::avdecc::entity::model::DescriptorType const descriptorType) noexcept
+	{
+		switch (descriptorType)
+		{
+			// Discovery information and clock source flags are only read when the items are created
+			case la::avdecc::entity::model::DescriptorType::Entity:
+			case la::avdecc::entity::model::DescriptorType::ClockSource:
+				return false;
+			default:
+				return true;
+		}
+	}
+
+	static void expandRecursively(QTreeWidgetItem* const item)
+	{
+		item->setExpanded(true);
+		for (auto childIndex = 0; childIndex < item->childCount(); ++childIndex)
+		{
+			expandRecursively(item->child(childIndex));
+		}
+	}
+
+	void hideDisplayedItems()
+	{
+		qDeleteAll(_uncachedItems);
+		_uncachedItems.clear();
+
+		if (!_cachedNodes.empty())
+		{
+			for (auto* item : _cachedNodes.front().items)
+			{
+				item->setHidden(true);
+			}
+		}
+	}
+
 	QTreeWidgetItem* createIdItem(la::avdecc::controller::model::EntityModelNode const* node)
 	{
 		Q_Q(NodeTreeWidget);
@@ -761,7 +892,7 @@ private:
 			auto const updateAcquireLabel = [this, acquireLabel](la::avdecc::UniqueIdentifier const entityID, la::avdecc::controller::model::AcquireState const acquireState, la::avdecc::UniqueIdentifier const owningEntity)
 			{
 				if (entityID == _controlledEntityID)
-					acquireLabel->setText(avdecc::helper::acquireStateToString(acquireState, owningEntity));
+					acquireLabel->setText(1, avdecc::helper::acquireStateToString(acquireState, owningEntity));
 			};
 
 			// Update text now
@@ -777,7 +908,7 @@ private:
 			auto const updateLockLabel = [this, lockLabel](la::avdecc::UniqueIdentifier const entityID, la::avdecc::controller::model::LockState const lockState, la::avdecc::UniqueIdentifier const lockingEntity)
 			{
 				if (entityID == _controlledEntityID)
-					lockLabel->setText(avdecc::helper::lockStateToString(lockState, lockingEntity));
+					lockLabel->setText(1, avdecc::helper::lockStateToString(lockState, lockingEntity));
 			};
 
 			// Update text now
@@ -790,6 +921,41 @@ private:
 		return accessItem;
 	}
 
+	/** Counters are only refreshed by unsolicited notifications, their values are the ones retrieved during the enumeration when the entity is not subscribed */
+	template<class CountersItem>
+	void setCountersItemTitle(CountersItem* const countersItem, la::avdecc::controller::ControlledEntity const* const controlledEntity) noexcept
+	{
+		updateCountersItemTitle(countersItem, controlledEntity->isSubscribedToUnsolicitedNotifications());
+
+		// Listen for changes
+		auto& controllerManager = avdecc::ControllerManager::getInstance();
+		connect(&controllerManager, &avdecc::ControllerManager::unsolicitedRegistrationChanged, countersItem,
+			[countersItem, controlledEntityID = _controlledEntityID](la::avdecc::UniqueIdentifier const entityID)
+			{
+				if (entityID == controlledEntityID)
+				{
+					if (auto const controlledEntity = avdecc::ControllerManager::getInstance().getControlledEntity(entityID))
+					{
+						updateCountersItemTitle(countersItem, controlledEntity->isSubscribedToUnsolicitedNotifications());
+					}
+				}
+			});
+	}
+
+	static void updateCountersItemTitle(QTreeWidgetItem* const countersItem, bool const isSubscribed) noexcept
+	{
+		if (isSubscribed)
+		{
+			countersItem->setText(0, "Counters");
+			countersItem->setToolTip(0, {});
+		}
+		else
+		{
+			countersItem->setText(0, "Counters (Not Refreshed)");
+			countersItem->setToolTip(0, "Entity not registered for unsolicited notifications, values retrieved during the enumeration");
+		}
+	}
+
 	void createDiscoveryInfo(la::avdecc::entity::Entity const& entity)
 	{
 #pragma message("TODO: And listen for changes to dynamically update the info")
@@ -886,55 +1052,31 @@ private:
 	}
 
 	/** A changing (readonly) text item */
-	QLabel* addChangingTextItem(QTreeWidgetItem* const treeWidgetItem, QString itemName)
+	TextTreeWidgetItem* addChangingTextItem(QTreeWidgetItem* const treeWidgetItem, QString itemName)
 	{
-		Q_Q(NodeTreeWidget);
-
-		auto* item = new QTreeWidgetItem(treeWidgetItem);
-		item->setText(0, std::move(itemName));
-
-		auto* label = new QLabel;
-		q->setItemWidget(item, 1, label);
-
-		return label;
+		return new TextTreeWidgetItem(treeWidgetItem, itemName, {});
 	}
 
-	/** An editable text entry item */
+	/** An editable text item (edited through the view's item delegate) */
 	void addEditableTextItem(QTreeWidgetItem* const treeWidgetItem, QString itemName, QString itemValue, avdecc::ControllerManager::AecpCommandType commandType, std::any const& customData)
 	{
-		Q_Q(NodeTreeWidget);
-
-		auto* item = new QTreeWidgetItem(treeWidgetItem);
-		item->setText(0, itemName);
-
-		auto* textEntry = new qt::toolkit::TextEntry(itemValue);
-
-		q->setItemWidget(item, 1, textEntry);
-
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::beginAecpCommand, textEntry,
-			[this, commandType, textEntry](la::avdecc::UniqueIdentifier const entityID, avdecc::ControllerManager::AecpCommandType cmdType)
-			{
-				if (entityID == _controlledEntityID && cmdType == commandType)
-					textEntry->setEnabled(false);
-			});
-
-		connect(textEntry, &qt::toolkit::TextEntry::returnPressed, textEntry,
-			[this, textEntry, commandType, customData]()
+		auto* textItem = new TextTreeWidgetItem(treeWidgetItem, itemName, itemValue,
+			[this, commandType, customData](QString const& text)
 			{
 				// Send changes
 				switch (commandType)
 				{
 					case avdecc::ControllerManager::AecpCommandType::SetEntityName:
-						avdecc::ControllerManager::getInstance().setEntityName(_controlledEntityID, textEntry->text());
+						avdecc::ControllerManager::getInstance().setEntityName(_controlledEntityID, text);
 						break;
 					case avdecc::ControllerManager::AecpCommandType::SetEntityGroupName:
-						avdecc::ControllerManager::getInstance().setEntityGroupName(_controlledEntityID, textEntry->text());
+						avdecc::ControllerManager::getInstance().setEntityGroupName(_controlledEntityID, text);
 						break;
 					case avdecc::ControllerManager::AecpCommandType::SetConfigurationName:
 						try
 						{
 							auto const configIndex = std::any_cast<la::avdecc::entity::model::ConfigurationIndex>(customData);
-							avdecc::ControllerManager::getInstance().setConfigurationName(_controlledEntityID, configIndex, textEntry->text());
+							avdecc::ControllerManager::getInstance().setConfigurationName(_controlledEntityID, configIndex, text);
 						}
 						catch (...)
 						{
@@ -946,7 +1088,7 @@ private:
 							auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::AudioUnitIndex>>(customData);
 							auto const configIndex = std::get<0>(customTuple);
 							auto const audioUnitIndex = std::get<1>(customTuple);
-							avdecc::ControllerManager::getInstance().setAudioUnitName(_controlledEntityID, configIndex, audioUnitIndex, textEntry->text());
+							avdecc::ControllerManager::getInstance().setAudioUnitName(_controlledEntityID, configIndex, audioUnitIndex, text);
 						}
 						catch (...)
 						{
@@ -960,9 +1102,9 @@ private:
 							auto const streamType = std::get<1>(customTuple);
 							auto const streamIndex = std::get<2>(customTuple);
 							if (streamType == la::avdecc::entity::model::DescriptorType::StreamInput)
-								avdecc::ControllerManager::getInstance().setStreamInputName(_controlledEntityID, configIndex, streamIndex, textEntry->text());
+								avdecc::ControllerManager::getInstance().setStreamInputName(_controlledEntityID, configIndex, streamIndex, text);
 							else if (streamType == la::avdecc::entity::model::DescriptorType::StreamOutput)
-								avdecc::ControllerManager::getInstance().setStreamOutputName(_controlledEntityID, configIndex, streamIndex, textEntry->text());
+								avdecc::ControllerManager::getInstance().setStreamOutputName(_controlledEntityID, configIndex, streamIndex, text);
 						}
 						catch (...)
 						{
@@ -974,7 +1116,7 @@ private:
 							auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::AvbInterfaceIndex>>(customData);
 							auto const configIndex = std::get<0>(customTuple);
 							auto const avbInterfaceIndex = std::get<1>(customTuple);
-							avdecc::ControllerManager::getInstance().setAvbInterfaceName(_controlledEntityID, configIndex, avbInterfaceIndex, textEntry->text());
+							avdecc::ControllerManager::getInstance().setAvbInterfaceName(_controlledEntityID, configIndex, avbInterfaceIndex, text);
 						}
 						catch (...)
 						{
@@ -986,7 +1128,7 @@ private:
 							auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::ClockSourceIndex>>(customData);
 							auto const configIndex = std::get<0>(customTuple);
 							auto const clockSourceIndex = std::get<1>(customTuple);
-							avdecc::ControllerManager::getInstance().setClockSourceName(_controlledEntityID, configIndex, clockSourceIndex, textEntry->text());
+							avdecc::ControllerManager::getInstance().setClockSourceName(_controlledEntityID, configIndex, clockSourceIndex, text);
 						}
 						catch (...)
 						{
@@ -998,7 +1140,7 @@ private:
 							auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::MemoryObjectIndex>>(customData);
 							auto const configIndex = std::get<0>(customTuple);
 							auto const memoryObjectIndex = std::get<1>(customTuple);
-							avdecc::ControllerManager::getInstance().setMemoryObjectName(_controlledEntityID, configIndex, memoryObjectIndex, textEntry->text());
+							avdecc::ControllerManager::getInstance().setMemoryObjectName(_controlledEntityID, configIndex, memoryObjectIndex, text);
 						}
 						catch (...)
 						{
@@ -1010,7 +1152,7 @@ private:
 							auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::ClusterIndex>>(customData);
 							auto const configIndex = std::get<0>(customTuple);
 							auto const audioClusterIndex = std::get<1>(customTuple);
-							avdecc::ControllerManager::getInstance().setAudioClusterName(_controlledEntityID, configIndex, audioClusterIndex, textEntry->text());
+							avdecc::ControllerManager::getInstance().setAudioClusterName(_controlledEntityID, configIndex, audioClusterIndex, text);
 						}
 						catch (...)
 						{
@@ -1022,7 +1164,7 @@ private:
 							auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::ClockDomainIndex>>(customData);
 							auto const configIndex = std::get<0>(customTuple);
 							auto const clockDomainIndex = std::get<1>(customTuple);
-							avdecc::ControllerManager::getInstance().setClockDomainName(_controlledEntityID, configIndex, clockDomainIndex, textEntry->text());
+							avdecc::ControllerManager::getInstance().setClockDomainName(_controlledEntityID, configIndex, clockDomainIndex, text);
 						}
 						catch (...)
 						{
@@ -1033,11 +1175,18 @@ private:
 				}
 			});
 
-		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::endAecpCommand, textEntry,
-			[this, commandType, textEntry](la::avdecc::UniqueIdentifier const entityID, avdecc::ControllerManager::AecpCommandType cmdType, la::avdecc::entity::ControllerEntity::AemCommandStatus const /*status*/)
+		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::beginAecpCommand, textItem,
+			[this, commandType, textItem](la::avdecc::UniqueIdentifier const entityID, avdecc::ControllerManager::AecpCommandType cmdType)
+			{
+				if (entityID == _controlledEntityID && cmdType == commandType)
+					textItem->setDisabled(true);
+			});
+
+		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::endAecpCommand, textItem,
+			[this, commandType, textItem](la::avdecc::UniqueIdentifier const entityID, avdecc::ControllerManager::AecpCommandType cmdType, la::avdecc::entity::ControllerEntity::AemCommandStatus const /*status*/)
 			{
 				if (entityID == _controlledEntityID && cmdType == commandType)
-					textEntry->setEnabled(true);
+					textItem->setDisabled(false);
 			});
 
 		// Listen for changes
@@ -1046,29 +1195,27 @@ private:
 			switch (commandType)
 			{
 				case avdecc::ControllerManager::AecpCommandType::SetEntityName:
-					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::entityNameChanged, textEntry,
-						[this, textEntry](la::avdecc::UniqueIdentifier const entityID, QString const& entityName)
+					avdecc::EntitySubscriptions::getInstance().entityNameChanged().subscribe(textItem, avdecc::EntitySubscriptions::makeKey(_controlledEntityID),
+						[textItem](QString const& entityName)
 						{
-							if (entityID == _controlledEntityID)
-								textEntry->setText(entityName);
+							textItem->setText(1, entityName);
 						});
 					break;
 				case avdecc::ControllerManager::AecpCommandType::SetEntityGroupName:
-					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::entityGroupNameChanged, textEntry,
-						[this, textEntry](la::avdecc::UniqueIdentifier const entityID, QString const& entityGroupName)
+					avdecc::EntitySubscriptions::getInstance().entityGroupNameChanged().subscribe(textItem, avdecc::EntitySubscriptions::makeKey(_controlledEntityID),
+						[textItem](QString const& entityGroupName)
 						{
-							if (entityID == _controlledEntityID)
-								textEntry->setText(entityGroupName);
+							textItem->setText(1, entityGroupName);
 						});
 					break;
 				case avdecc::ControllerManager::AecpCommandType::SetConfigurationName:
 				{
 					auto const configIndex = std::any_cast<la::avdecc::entity::model::ConfigurationIndex>(customData);
-					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::configurationNameChanged, textEntry,
-						[this, textEntry, configIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, QString const& configurationName)
+					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::configurationNameChanged, textItem,
+						[this, textItem, configIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, QString const& configurationName)
 						{
 							if (entityID == _controlledEntityID && configurationIndex == configIndex)
-								textEntry->setText(configurationName);
+								textItem->setText(1, configurationName);
 						});
 					break;
 				}
@@ -1077,11 +1224,11 @@ private:
 					auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::AudioUnitIndex>>(customData);
 					auto const configIndex = std::get<0>(customTuple);
 					auto const audioUnitIndex = std::get<1>(customTuple);
-					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::audioUnitNameChanged, textEntry,
-						[this, textEntry, configIndex, auIndex = audioUnitIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, QString const& audioUnitName)
+					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::audioUnitNameChanged, textItem,
+						[this, textItem, configIndex, auIndex = audioUnitIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AudioUnitIndex const audioUnitIndex, QString const& audioUnitName)
 						{
 							if (entityID == _controlledEntityID && configurationIndex == configIndex && audioUnitIndex == auIndex)
-								textEntry->setText(audioUnitName);
+								textItem->setText(1, audioUnitName);
 						});
 					break;
 				}
@@ -1091,11 +1238,11 @@ private:
 					auto const configIndex = std::get<0>(customTuple);
 					auto const streamType = std::get<1>(customTuple);
 					auto const streamIndex = std::get<2>(customTuple);
-					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::streamNameChanged, textEntry,
-						[this, textEntry, configIndex, streamType, strIndex = streamIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, QString const& streamName)
+					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::streamNameChanged, textItem,
+						[this, textItem, configIndex, streamType, strIndex = streamIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::DescriptorType const descriptorType, la::avdecc::entity::model::StreamIndex const streamIndex, QString const& streamName)
 						{
 							if (entityID == _controlledEntityID && configurationIndex == configIndex && descriptorType == streamType && streamIndex == strIndex)
-								textEntry->setText(streamName);
+								textItem->setText(1, streamName);
 						});
 					break;
 				}
@@ -1104,11 +1251,11 @@ private:
 					auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::AvbInterfaceIndex>>(customData);
 					auto const configIndex = std::get<0>(customTuple);
 					auto const avbInterfaceIndex = std::get<1>(customTuple);
-					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::avbInterfaceNameChanged, textEntry,
-						[this, textEntry, configIndex, aiIndex = avbInterfaceIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, QString const& avbInterfaceName)
+					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::avbInterfaceNameChanged, textItem,
+						[this, textItem, configIndex, aiIndex = avbInterfaceIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::AvbInterfaceIndex const avbInterfaceIndex, QString const& avbInterfaceName)
 						{
 							if (entityID == _controlledEntityID && configurationIndex == configIndex && avbInterfaceIndex == aiIndex)
-								textEntry->setText(avbInterfaceName);
+								textItem->setText(1, avbInterfaceName);
 						});
 					break;
 				}
@@ -1117,11 +1264,11 @@ private:
 					auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::ClockSourceIndex>>(customData);
 					auto const configIndex = std::get<0>(customTuple);
 					auto const clockSourceIndex = std::get<1>(customTuple);
-					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::clockSourceNameChanged, textEntry,
-						[this, textEntry, configIndex, csIndex = clockSourceIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex, QString const& clockSourceName)
+					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::clockSourceNameChanged, textItem,
+						[this, textItem, configIndex, csIndex = clockSourceIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockSourceIndex const clockSourceIndex, QString const& clockSourceName)
 						{
 							if (entityID == _controlledEntityID && configurationIndex == configIndex && clockSourceIndex == csIndex)
-								textEntry->setText(clockSourceName);
+								textItem->setText(1, clockSourceName);
 						});
 					break;
 				}
@@ -1130,11 +1277,11 @@ private:
 					auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::MemoryObjectIndex>>(customData);
 					auto const configIndex = std::get<0>(customTuple);
 					auto const memoryObjectIndex = std::get<1>(customTuple);
-					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::memoryObjectNameChanged, textEntry,
-						[this, textEntry, configIndex, moIndex = memoryObjectIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, QString const& memoryObjectName)
+					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::memoryObjectNameChanged, textItem,
+						[this, textItem, configIndex, moIndex = memoryObjectIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::MemoryObjectIndex const memoryObjectIndex, QString const& memoryObjectName)
 						{
 							if (entityID == _controlledEntityID && configurationIndex == configIndex && memoryObjectIndex == moIndex)
-								textEntry->setText(memoryObjectName);
+								textItem->setText(1, memoryObjectName);
 						});
 					break;
 				}
@@ -1143,11 +1290,11 @@ private:
 					auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::ClusterIndex>>(customData);
 					auto const configIndex = std::get<0>(customTuple);
 					auto const audioClusterIndex = std::get<1>(customTuple);
-					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::audioClusterNameChanged, textEntry,
-						[this, textEntry, configIndex, acIndex = audioClusterIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClusterIndex const audioClusterIndex, QString const& audioClusterName)
+					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::audioClusterNameChanged, textItem,
+						[this, textItem, configIndex, acIndex = audioClusterIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClusterIndex const audioClusterIndex, QString const& audioClusterName)
 						{
 							if (entityID == _controlledEntityID && configurationIndex == configIndex && audioClusterIndex == acIndex)
-								textEntry->setText(audioClusterName);
+								textItem->setText(1, audioClusterName);
 						});
 					break;
 				}
@@ -1156,11 +1303,11 @@ private:
 					auto const customTuple = std::any_cast<std::tuple<la::avdecc::entity::model::ConfigurationIndex, la::avdecc::entity::model::ClockDomainIndex>>(customData);
 					auto const configIndex = std::get<0>(customTuple);
 					auto const clockDomainIndex = std::get<1>(customTuple);
-					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::clockDomainNameChanged, textEntry,
-						[this, textEntry, configIndex, cdIndex = clockDomainIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, QString const& clockDomainName)
+					connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::clockDomainNameChanged, textItem,
+						[this, textItem, configIndex, cdIndex = clockDomainIndex](la::avdecc::UniqueIdentifier const entityID, la::avdecc::entity::model::ConfigurationIndex const configurationIndex, la::avdecc::entity::model::ClockDomainIndex const clockDomainIndex, QString const& clockDomainName)
 						{
 							if (entityID == _controlledEntityID && configurationIndex == configIndex && clockDomainIndex == cdIndex)
-								textEntry->setText(clockDomainName);
+								textItem->setText(1, clockDomainName);
 						});
 					break;
 				}
@@ -1242,18 +1389,24 @@ private:
 							return;
 						}
 
-						// Read all data
-						auto data = file.readAll();
-
 						// Check length
-						if (maximumLength != 0 && data.size() > maximumLength)
+						if (maximumLength != 0 && static_cast<std::uint64_t>(file.size()) > maximumLength)
 						{
 							QMessageBox::critical(q_ptr, "", "firmware image file is too large for this entity");
 							return;
 						}
 
+						// Load the firmware image
+						auto const image = FirmwareUploadDialog::readFirmwareFile(file);
+						if (image.size == 0u)
+						{
+							QMessageBox::critical(q_ptr, "", "Failed to load firmware file");
+							return;
+						}
+						file.close();
+
 						// Start firmware upload dialog
-						FirmwareUploadDialog dialog{ { data.constData(), static_cast<size_t>(data.count()) }, QFileInfo(fileName).fileName(), { { _controlledEntityID, descriptorIndex, baseAddress } }, q_ptr };
+						FirmwareUploadDialog dialog{ image, QFileInfo(fileName).fileName(), { { _controlledEntityID, descriptorIndex, baseAddress } }, q_ptr };
 						dialog.exec();
 					}
 				});
@@ -1266,6 +1419,15 @@ private:
 	Q_DECLARE_PUBLIC(NodeTreeWidget);
 
 	la::avdecc::UniqueIdentifier _controlledEntityID{};
+
+	struct CachedNode
+	{
+		la::avdecc::controller::model::Node const* node{ nullptr };
+		bool isActiveConfiguration{ false };
+		std::vector<QTreeWidgetItem*> items{}; // Top level items (owned by the tree)
+	};
+	std::list<CachedNode> _cachedNodes{}; // Most recently displayed first
+	std::vector<QTreeWidgetItem*> _uncachedItems{}; // Top level items of the displayed node, if not cached
 };
 
 NodeTreeWidget::NodeTreeWidget(QWidget* parent)
@@ -1277,6 +1439,12 @@ NodeTreeWidget::NodeTreeWidget(QWidget* parent)
 	header()->resizeSection(0, 200);
 }
 
+bool NodeTreeWidget::edit(QModelIndex const& index, EditTrigger trigger, QEvent* event)
+{
+	// Only the value column is editable, whichever column of the row has been activated
+	return QTreeWidget::edit(index.sibling(index.row(), 1), trigger, event);
+}
+
 NodeTreeWidget::~NodeTreeWidget()
 {
 	delete d_ptr;
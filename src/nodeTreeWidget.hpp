@@ -39,6 +39,9 @@ public:
 
 	void setNode(la::avdecc::UniqueIdentifier const entityID, bool const isActiveConfiguration, AnyNode const& node);
 
+protected:
+	virtual bool edit(QModelIndex const& index, EditTrigger trigger, QEvent* event) override;
+
 private:
 	NodeTreeWidgetPrivate* d_ptr{ nullptr };
 	Q_DECLARE_PRIVATE(NodeTreeWidget)
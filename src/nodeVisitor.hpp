@@ -39,6 +39,7 @@ public:
 	template<class Node, typename = std::enable_if_t<std::is_base_of<la::avdecc::controller::model::Node, Node>::value>>
 	explicit AnyNode(Node const* const node) noexcept
 		: _node(node)
+		, _baseNode(node)
 	{
 	}
 
@@ -47,6 +48,11 @@ public:
 		return _node;
 	}
 
+	la::avdecc::controller::model::Node const* getBaseNode() const noexcept
+	{
+		return _baseNode;
+	}
+
 	// Defaulted compiler auto-generated methods
 	AnyNode(AnyNode&&) = default;
 	AnyNode(AnyNode const&) = default;
@@ -55,6 +61,7 @@ public:
 
 private:
 	std::any _node{};
+	la::avdecc::controller::model::Node const* _baseNode{ nullptr };
 };
 
 Q_DECLARE_METATYPE(AnyNode)
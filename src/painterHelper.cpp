@@ -34,8 +34,11 @@ void drawCentered(QPainter* painter, QRect const& rect, QPixmap const& pixmap)
 	}
 
 	auto const devicePixelRatio = painter->device()->devicePixelRatioF();
+	auto const targetSize = (QSizeF{ rect.size() } * devicePixelRatio).toSize();
 
-	auto scaledPixmap = pixmap.scaled(rect.width() * devicePixelRatio, rect.height() * devicePixelRatio, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+	// Only scale the pixmap if it's not already fitting the rect
+	auto const isFitting = pixmap.devicePixelRatio() == devicePixelRatio && pixmap.width() <= targetSize.width() && pixmap.height() <= targetSize.height() && (pixmap.width() == targetSize.width() || pixmap.height() == targetSize.height());
+	auto scaledPixmap = isFitting ? pixmap : pixmap.scaled(targetSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
 	scaledPixmap.setDevicePixelRatio(devicePixelRatio);
 
 	auto const x = rect.x() + (rect.width() - scaledPixmap.width() / devicePixelRatio) / 2;
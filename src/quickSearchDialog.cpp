@@ -0,0 +1,134 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "quickSearchDialog.hpp"
+#include "avdecc/controllerManager.hpp"
+#include "avdecc/helper.hpp"
+
+#include <QCoreApplication>
+#include <QKeyEvent>
+#include <QVBoxLayout>
+
+static constexpr size_t MaxResults = 50u;
+
+static QString kindName(avdecc::search::Document::Kind const kind) noexcept
+{
+	switch (kind)
+	{
+		case avdecc::search::Document::Kind::Entity:
+			return "Entity";
+		case avdecc::search::Document::Kind::EntityID:
+			return "Entity ID";
+		case avdecc::search::Document::Kind::Group:
+			return "Group";
+		case avdecc::search::Document::Kind::StreamOutput:
+			return "Output Stream";
+		case avdecc::search::Document::Kind::StreamInput:
+			return "Input Stream";
+		case avdecc::search::Document::Kind::AudioCluster:
+			return "Audio Cluster";
+		default:
+			AVDECC_ASSERT(false, "Unhandled kind");
+			return {};
+	}
+}
+
+QuickSearchDialog::QuickSearchDialog(QWidget* parent)
+	: QDialog{ parent, Qt::Popup }
+{
+	resize(560, 360);
+
+	_queryLineEdit.setPlaceholderText("Entity, group, stream, cluster or entity ID");
+	_queryLineEdit.setClearButtonEnabled(true);
+	_resultsListWidget.setFocusPolicy(Qt::NoFocus);
+	_resultsListWidget.setUniformItemSizes(true);
+
+	auto* const layout = new QVBoxLayout{ this };
+	layout->addWidget(&_queryLineEdit);
+	layout->addWidget(&_resultsListWidget, 1);
+
+	connect(&_queryLineEdit, &QLineEdit::textChanged, this, &QuickSearchDialog::updateResults);
+	connect(&_queryLineEdit, &QLineEdit::returnPressed, this, &QuickSearchDialog::activateCurrent);
+	connect(&_resultsListWidget, &QListWidget::itemActivated, this, &QuickSearchDialog::activateCurrent);
+
+	// Centered in the upper part of the parent window
+	if (parent)
+	{
+		auto const parentGeometry = parent->window()->geometry();
+		move(parentGeometry.center().x() - width() / 2, parentGeometry.top() + parentGeometry.height() / 6);
+	}
+
+	_queryLineEdit.setFocus();
+}
+
+void QuickSearchDialog::updateResults(QString const& query) noexcept
+{
+	_results = avdecc::search::SearchIndex::getInstance().search(query, MaxResults);
+
+	auto& manager = avdecc::ControllerManager::getInstance();
+
+	_resultsListWidget.clear();
+	for (auto const& document : _results)
+	{
+		auto text = QString{ "%1 - %2" }.arg(document.text).arg(kindName(document.kind));
+
+		// The entity level documents are explicit enough, the other ones are shown with their entity
+		if (document.kind != avdecc::search::Document::Kind::Entity && document.kind != avdecc::search::Document::Kind::EntityID)
+		{
+			if (auto controlledEntity = manager.getControlledEntity(document.entityID))
+			{
+				text += QString{ " (%1)" }.arg(avdecc::helper::smartEntityName(*controlledEntity));
+			}
+		}
+
+		_resultsListWidget.addItem(text);
+	}
+
+	_resultsListWidget.setCurrentRow(_results.empty() ? -1 : 0);
+}
+
+void QuickSearchDialog::activateCurrent() noexcept
+{
+	auto const row = _resultsListWidget.currentRow();
+	if (row < 0 || row >= static_cast<int>(_results.size()))
+	{
+		return;
+	}
+
+	emit documentActivated(_results[row]);
+	accept();
+}
+
+void QuickSearchDialog::keyPressEvent(QKeyEvent* event)
+{
+	// The line edit keeps the focus, the navigation keys are forwarded to the results
+	switch (event->key())
+	{
+		case Qt::Key_Up:
+		case Qt::Key_Down:
+		case Qt::Key_PageUp:
+		case Qt::Key_PageDown:
+			QCoreApplication::sendEvent(&_resultsListWidget, event);
+			return;
+		default:
+			break;
+	}
+
+	QDialog::keyPressEvent(event);
+}
@@ -0,0 +1,54 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QDialog>
+#include <QLineEdit>
+#include <QListWidget>
+
+#include "avdecc/searchIndex.hpp"
+
+/** Jump box over the global search index, the activated document being sent through documentActivated before the dialog closes */
+class QuickSearchDialog : public QDialog
+{
+	Q_OBJECT
+
+public:
+	QuickSearchDialog(QWidget* parent = nullptr);
+
+	// Deleted compiler auto-generated methods
+	QuickSearchDialog(QuickSearchDialog&&) = delete;
+	QuickSearchDialog(QuickSearchDialog const&) = delete;
+	QuickSearchDialog& operator=(QuickSearchDialog const&) = delete;
+	QuickSearchDialog& operator=(QuickSearchDialog&&) = delete;
+
+	Q_SIGNAL void documentActivated(avdecc::search::Document const& document);
+
+private:
+	void updateResults(QString const& query) noexcept;
+	void activateCurrent() noexcept;
+
+	// QDialog overrides
+	virtual void keyPressEvent(QKeyEvent* event) override;
+
+	QLineEdit _queryLineEdit{ this };
+	QListWidget _resultsListWidget{ this };
+	avdecc::search::Documents _results{};
+};
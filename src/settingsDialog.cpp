@@ -69,6 +69,12 @@ private:
 			themeColorComboBox->setModelColumn(_themeColorModel.index(qt::toolkit::material::color::DefaultShade));
 			themeColorComboBox->setCurrentIndex(settings.getValue(settings::General_ThemeColorIndex.name).toInt());
 		}
+
+		// Counters Refresh Period
+		{
+			auto const lock = QSignalBlocker{ countersRefreshPeriodSpinBox };
+			countersRefreshPeriodSpinBox->setValue(settings.getValue(settings::General_CountersRefreshPeriod.name).toInt());
+		}
 	}
 
 	void loadConnectionMatrixSettings()
@@ -118,6 +124,36 @@ private:
 			auto const lock = QSignalBlocker{ fullAEMEnumerationCheckBox };
 			fullAEMEnumerationCheckBox->setChecked(settings.getValue(settings::Controller_FullStaticModelEnabled.name).toBool());
 		}
+
+		// Firmware Max Parallel Uploads
+		{
+			auto const lock = QSignalBlocker{ firmwareMaxParallelUploadsSpinBox };
+			firmwareMaxParallelUploadsSpinBox->setValue(settings.getValue(settings::Controller_FirmwareMaxParallelUploads.name).toInt());
+		}
+
+		// Firmware Max Upload Bandwidth
+		{
+			auto const lock = QSignalBlocker{ firmwareMaxUploadBandwidthSpinBox };
+			firmwareMaxUploadBandwidthSpinBox->setValue(settings.getValue(settings::Controller_FirmwareMaxUploadBandwidth.name).toInt());
+		}
+
+		// Offline Grace Period
+		{
+			auto const lock = QSignalBlocker{ offlineGracePeriodSpinBox };
+			offlineGracePeriodSpinBox->setValue(settings.getValue(settings::Controller_OfflineGracePeriod.name).toInt());
+		}
+
+		// Visibility-Driven Notifications
+		{
+			auto const lock = QSignalBlocker{ visibilityDrivenNotificationsCheckBox };
+			visibilityDrivenNotificationsCheckBox->setChecked(settings.getValue(settings::Controller_VisibilityDrivenNotifications.name).toBool());
+		}
+
+		// Shared AEM Cache
+		{
+			auto const lock = QSignalBlocker{ sharedAEMCachePathLineEdit };
+			sharedAEMCachePathLineEdit->setText(settings.getValue(settings::Controller_SharedAemCachePath.name).toString());
+		}
 	}
 
 	void loadNetworkSettings()
@@ -212,6 +248,12 @@ void SettingsDialog::on_themeColorComboBox_currentIndexChanged(int index)
 	settings.setValue(settings::General_ThemeColorIndex.name, index);
 }
 
+void SettingsDialog::on_countersRefreshPeriodSpinBox_valueChanged(int value)
+{
+	auto& settings = settings::SettingsManager::getInstance();
+	settings.setValue(settings::General_CountersRefreshPeriod.name, value);
+}
+
 void SettingsDialog::on_transposeConnectionMatrixCheckBox_toggled(bool checked)
 {
 	auto& settings = settings::SettingsManager::getInstance();
@@ -242,6 +284,36 @@ void SettingsDialog::on_fullAEMEnumerationCheckBox_toggled(bool checked)
 	settings.setValue(settings::Controller_FullStaticModelEnabled.name, checked);
 }
 
+void SettingsDialog::on_firmwareMaxParallelUploadsSpinBox_valueChanged(int value)
+{
+	auto& settings = settings::SettingsManager::getInstance();
+	settings.setValue(settings::Controller_FirmwareMaxParallelUploads.name, value);
+}
+
+void SettingsDialog::on_firmwareMaxUploadBandwidthSpinBox_valueChanged(int value)
+{
+	auto& settings = settings::SettingsManager::getInstance();
+	settings.setValue(settings::Controller_FirmwareMaxUploadBandwidth.name, value);
+}
+
+void SettingsDialog::on_offlineGracePeriodSpinBox_valueChanged(int value)
+{
+	auto& settings = settings::SettingsManager::getInstance();
+	settings.setValue(settings::Controller_OfflineGracePeriod.name, value);
+}
+
+void SettingsDialog::on_visibilityDrivenNotificationsCheckBox_toggled(bool checked)
+{
+	auto& settings = settings::SettingsManager::getInstance();
+	settings.setValue(settings::Controller_VisibilityDrivenNotifications.name, checked);
+}
+
+void SettingsDialog::on_sharedAEMCachePathLineEdit_editingFinished()
+{
+	auto& settings = settings::SettingsManager::getInstance();
+	settings.setValue(settings::Controller_SharedAemCachePath.name, sharedAEMCachePathLineEdit->text().trimmed());
+}
+
 void SettingsDialog::on_protocolComboBox_currentIndexChanged(int /*index*/)
 {
 	auto& settings = settings::SettingsManager::getInstance();
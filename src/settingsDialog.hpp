@@ -42,6 +42,7 @@ private:
 	Q_SLOT void on_automaticCheckForUpdatesCheckBox_toggled(bool checked);
 	Q_SLOT void on_checkForBetaVersionsCheckBox_toggled(bool checked);
 	Q_SLOT void on_themeColorComboBox_currentIndexChanged(int index);
+	Q_SLOT void on_countersRefreshPeriodSpinBox_valueChanged(int value);
 
 	// Connection Matrix
 	Q_SLOT void on_transposeConnectionMatrixCheckBox_toggled(bool checked);
@@ -51,6 +52,11 @@ private:
 	// Controller
 	Q_SLOT void on_enableAEMCacheCheckBox_toggled(bool checked);
 	Q_SLOT void on_fullAEMEnumerationCheckBox_toggled(bool checked);
+	Q_SLOT void on_firmwareMaxParallelUploadsSpinBox_valueChanged(int value);
+	Q_SLOT void on_firmwareMaxUploadBandwidthSpinBox_valueChanged(int value);
+	Q_SLOT void on_offlineGracePeriodSpinBox_valueChanged(int value);
+	Q_SLOT void on_visibilityDrivenNotificationsCheckBox_toggled(bool checked);
+	Q_SLOT void on_sharedAEMCachePathLineEdit_editingFinished();
 
 	// Network
 	Q_SLOT void on_protocolComboBox_currentIndexChanged(int index);
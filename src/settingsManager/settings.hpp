@@ -25,6 +25,8 @@
 #include <la/avdecc/internals/protocolInterface.hpp>
 #include <la/avdecc/utils.hpp>
 
+#include <QStringList>
+
 namespace settings
 {
 // Settings with a default initial value
@@ -36,6 +38,7 @@ static SettingsManager::SettingDefault General_AutomaticPNGDownloadEnabled = { "
 static SettingsManager::SettingDefault General_AutomaticCheckForUpdates = { "avdecc/general/enableAutomaticCheckForUpdates", true };
 static SettingsManager::SettingDefault General_CheckForBetaVersions = { "avdecc/general/enableCheckForBetaVersions", false };
 static SettingsManager::SettingDefault General_ThemeColorIndex = { "avdecc/general/themeColorIndex", qt::toolkit::material::color::Palette::index(qt::toolkit::material::color::DefaultColor) };
+static SettingsManager::SettingDefault General_CountersRefreshPeriod = { "avdecc/general/countersRefreshPeriod", 250 }; // Minimum delay (in msec) between two refreshes of the counters display
 
 // Connection matrix settings
 static SettingsManager::SettingDefault ConnectionMatrix_Transpose = { "avdecc/connectionMatrix/transpose", false };
@@ -51,9 +54,16 @@ static SettingsManager::SettingDefault Network_InterfaceTypeWiFi = { "avdecc/net
 // Controller settings
 static SettingsManager::SettingDefault Controller_AemCacheEnabled = { "avdecc/controller/enableAemCache", false };
 static SettingsManager::SettingDefault Controller_FullStaticModelEnabled = { "avdecc/controller/fullStaticModel", false };
+static SettingsManager::SettingDefault Controller_FirmwareMaxParallelUploads = { "avdecc/controller/firmwareMaxParallelUploads", 4 }; // Maximum number of firmware images uploaded at the same time
+static SettingsManager::SettingDefault Controller_FirmwareMaxUploadBandwidth = { "avdecc/controller/firmwareMaxUploadBandwidth", 0 }; // Maximum bandwidth (in KiB/s) used by firmware uploads, 0 meaning unlimited
+static SettingsManager::SettingDefault Controller_OfflineGracePeriod = { "avdecc/controller/offlineGracePeriod", 0 }; // Seconds an offline entity is kept (as rebooting) before being removed from the views, 0 meaning removed right away
+static SettingsManager::SettingDefault Controller_VisibilityDrivenNotifications = { "avdecc/controller/visibilityDrivenNotifications", false }; // Counters of the entities which are not visible, selected or watched are only refreshed every few seconds
+static SettingsManager::SettingDefault Controller_WatchedEntities = { "avdecc/controller/watchedEntities", QStringList{} }; // EntityIDs (hex strings) always considered of interest by the visibility-driven notifications
+static SettingsManager::SettingDefault Controller_SharedAemCachePath = { "avdecc/controller/sharedAemCachePath", "" }; // Directory (local or on a network share) the stored entity models are exchanged through with other Hive instances, empty to disable
 
 // Settings with no default initial value (no need to register with the SettingsManager) - Not allowed to call registerSettingObserver for those
 static SettingsManager::Setting InterfaceID = { "interfaceID" };
+static SettingsManager::Setting SecondaryInterfaceIDs = { "secondaryInterfaceIDs" }; // Additional interfaces, a controller is created on each of them (QStringList)
 static SettingsManager::Setting ControllerDynamicHeaderViewState = { "controllerDynamicHeaderView/state" };
 static SettingsManager::Setting LoggerDynamicHeaderViewState = { "loggerDynamicHeaderView/state" };
 static SettingsManager::Setting EntityInspectorState = { "entityInspector/state" };
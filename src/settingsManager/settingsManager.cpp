@@ -21,7 +21,15 @@
 #include <la/avdecc/utils.hpp>
 #include <QSettings>
 #include <QHash>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QCoreApplication>
 #include <unordered_map>
+#include <deque>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <utility>
 
 struct QStringHash
 {
@@ -33,69 +41,166 @@ struct QStringHash
 
 namespace settings
 {
+/** Changed values are written to disk once no other change happened for this delay */
+static constexpr auto FlushDebounceDelay = 500; // In msec
+/** Changed values are written to disk at most this delay after the first change, even if changes keep coming */
+static constexpr auto FlushMaxDelay = 5000; // In msec
+
 class SettingsManagerImpl : public SettingsManager
 {
-private:
-	virtual void registerSetting(SettingDefault const& setting) noexcept override
+public:
+	SettingsManagerImpl() noexcept
 	{
-		if (!_settings.contains(setting.name))
+		_flushTimer.setSingleShot(true);
+		QObject::connect(&_flushTimer, &QTimer::timeout,
+			[this]()
+			{
+				flush(true);
+			});
+
+		// Make sure everything is written while the application is still alive
+		if (auto* const app = QCoreApplication::instance())
 		{
-			_settings.setValue(setting.name, setting.initialValue);
+			QObject::connect(app, &QCoreApplication::aboutToQuit,
+				[this]()
+				{
+					flush(false);
+				});
 		}
 	}
 
-	virtual void setValue(Setting const& name, QVariant const& value, Observer const* const dontNotifyObserver) noexcept override
+	~SettingsManagerImpl() noexcept
 	{
-		_settings.setValue(name, value);
+		flush(false);
+	}
 
-		// Notify observers
-		auto const observersIt = _observers.find(name);
-		if (observersIt != _observers.end())
+private:
+	using Values = std::vector<std::pair<Setting, QVariant>>;
+
+	virtual void registerSetting(SettingDefault const& setting) noexcept override
+	{
+		auto const alreadyKnown = contains(setting.name);
+		auto const index = indexOf(setting.name);
+		if (!alreadyKnown)
 		{
-			observersIt->second.notifyObservers<Observer>(
-				[dontNotifyObserver, &name, &value](Observer* const obs)
-				{
-					if (obs != dontNotifyObserver)
-					{
-						obs->onSettingChanged(name, value);
-					}
-				});
+			storeValue(index, setting.initialValue);
 		}
 	}
 
+	virtual void setValue(Setting const& name, QVariant const& value, Observer const* const dontNotifyObserver) noexcept override
+	{
+		setIndexedValue(indexOf(name), value, dontNotifyObserver);
+	}
+
 	virtual QVariant getValue(Setting const& name) const noexcept override
 	{
+		if (auto const it = _indexes.find(name); it != _indexes.end())
+		{
+			return _values[it->second];
+		}
 		return _settings.value(name);
 	}
 
 	virtual void registerSettingObserver(Setting const& name, Observer* const observer, bool const triggerFirstNotification) noexcept override
 	{
-		if (AVDECC_ASSERT_WITH_RET(_settings.contains(name), "registerSettingObserver not allowed for a Setting without initial Value"))
+		if (AVDECC_ASSERT_WITH_RET(contains(name), "registerSettingObserver not allowed for a Setting without initial Value"))
 		{
-			auto& observers = _observers[name];
-			try
+			registerIndexedSettingObserver(indexOf(name), observer, triggerFirstNotification);
+		}
+	}
+
+	virtual void unregisterSettingObserver(Setting const& name, Observer* const observer) noexcept override
+	{
+		if (auto const it = _indexes.find(name); it != _indexes.end())
+		{
+			unregisterIndexedSettingObserver(it->second, observer);
+		}
+	}
+
+	virtual void triggerSettingObserver(Setting const& name, Observer* const observer) noexcept override
+	{
+		if (AVDECC_ASSERT_WITH_RET(contains(name), "triggerSettingObserver not allowed for a Setting without initial Value"))
+		{
+			if (auto const it = _indexes.find(name); it != _indexes.end())
 			{
-				observers.registerObserver(observer);
-				if (triggerFirstNotification)
+				auto const index = it->second;
+				if (_observers[index].isObserverRegistered(observer))
 				{
-					auto const value = _settings.value(name);
-					la::avdecc::utils::invokeProtectedMethod(&Observer::onSettingChanged, observer, name, value);
+					la::avdecc::utils::invokeProtectedMethod(&Observer::onSettingChanged, observer, _names[index], _values[index]);
 				}
 			}
-			catch (...)
+		}
+	}
+
+	virtual QString getFilePath() const noexcept override
+	{
+		return _settings.fileName();
+	}
+
+	virtual SettingIndex getSettingIndex(Setting const& name) noexcept override
+	{
+		return indexOf(name);
+	}
+
+	virtual QVariant const& getIndexedValue(SettingIndex const index) const noexcept override
+	{
+		static auto const s_invalidValue = QVariant{};
+
+		if (!AVDECC_ASSERT_WITH_RET(index < _values.size(), "Invalid setting handle"))
+		{
+			return s_invalidValue;
+		}
+		return _values[index];
+	}
+
+	virtual void setIndexedValue(SettingIndex const index, QVariant const& value, Observer const* const dontNotifyObserver) noexcept override
+	{
+		if (!AVDECC_ASSERT_WITH_RET(index < _values.size(), "Invalid setting handle"))
+		{
+			return;
+		}
+
+		storeValue(index, value);
+
+		// Notify observers
+		auto const& name = _names[index];
+		_observers[index].notifyObservers<Observer>(
+			[dontNotifyObserver, &name, &value](Observer* const obs)
 			{
+				if (obs != dontNotifyObserver)
+				{
+					obs->onSettingChanged(name, value);
+				}
+			});
+	}
+
+	virtual void registerIndexedSettingObserver(SettingIndex const index, Observer* const observer, bool const triggerFirstNotification) noexcept override
+	{
+		if (!AVDECC_ASSERT_WITH_RET(index < _values.size(), "Invalid setting handle"))
+		{
+			return;
+		}
+
+		try
+		{
+			_observers[index].registerObserver(observer);
+			if (triggerFirstNotification)
+			{
+				la::avdecc::utils::invokeProtectedMethod(&Observer::onSettingChanged, observer, _names[index], _values[index]);
 			}
 		}
+		catch (...)
+		{
+		}
 	}
 
-	virtual void unregisterSettingObserver(Setting const& name, Observer* const observer) noexcept override
+	virtual void unregisterIndexedSettingObserver(SettingIndex const index, Observer* const observer) noexcept override
 	{
-		auto const observersIt = _observers.find(name);
-		if (observersIt != _observers.end())
+		if (index < _values.size())
 		{
 			try
 			{
-				observersIt->second.unregisterObserver(observer);
+				_observers[index].unregisterObserver(observer);
 			}
 			catch (...)
 			{
@@ -103,29 +208,112 @@ private:
 		}
 	}
 
-	virtual void triggerSettingObserver(Setting const& name, Observer* const observer) noexcept override
+	// Private methods
+	bool contains(Setting const& name) const noexcept
 	{
-		if (AVDECC_ASSERT_WITH_RET(_settings.contains(name), "triggerSettingObserver not allowed for a Setting without initial Value"))
+		if (auto const it = _indexes.find(name); it != _indexes.end())
 		{
-			auto const observersIt = _observers.find(name);
-			if (observersIt != _observers.end())
-			{
-				if (observersIt->second.isObserverRegistered(observer))
-				{
-					la::avdecc::utils::invokeProtectedMethod(&Observer::onSettingChanged, observer, name, _settings.value(name));
-				}
-			}
+			return _values[it->second].isValid();
 		}
+		return _settings.contains(name);
 	}
 
-	virtual QString getFilePath() const noexcept override
+	/** Returns the index of the setting, allocating it (and caching its stored value) the first time the setting is used */
+	SettingIndex indexOf(Setting const& name) noexcept
 	{
-		return _settings.fileName();
+		if (auto const it = _indexes.find(name); it != _indexes.end())
+		{
+			return it->second;
+		}
+
+		auto const index = static_cast<SettingIndex>(_values.size());
+		_indexes.emplace(name, index);
+		_names.push_back(name);
+		_values.push_back(_settings.value(name));
+		_dirtyFlags.push_back(false);
+		_observers.emplace_back();
+		return index;
+	}
+
+	/** Keeps the value in memory, it will be written to disk by the next flush */
+	void storeValue(SettingIndex const index, QVariant const& value) noexcept
+	{
+		_values[index] = value;
+		if (!_dirtyFlags[index])
+		{
+			_dirtyFlags[index] = true;
+			_dirty.push_back(index);
+		}
+
+		if (!_dirtyTimer.isValid())
+		{
+			_dirtyTimer.start();
+		}
+		auto const remaining = FlushMaxDelay - static_cast<int>(_dirtyTimer.elapsed());
+		_flushTimer.start(std::max(0, std::min(FlushDebounceDelay, remaining)));
+	}
+
+	/** Writes the changed values, in background if allowed (QSettings being reentrant, the worker uses its own instance) or synchronously */
+	void flush(bool const inBackground) noexcept
+	{
+		_flushTimer.stop();
+
+		// Wait for the previous flush, they must be applied in order
+		if (_flushThread.joinable())
+		{
+			_flushThread.join();
+		}
+
+		if (_dirty.empty())
+		{
+			return;
+		}
+
+		auto values = Values{};
+		values.reserve(_dirty.size());
+		for (auto const index : _dirty)
+		{
+			values.emplace_back(_names[index], _values[index]);
+			_dirtyFlags[index] = false;
+		}
+		_dirty.clear();
+		_dirtyTimer.invalidate();
+
+		if (inBackground)
+		{
+			_flushThread = std::thread{
+				[values = std::move(values)]()
+				{
+					auto settings = QSettings{};
+					for (auto const& [name, value] : values)
+					{
+						settings.setValue(name, value);
+					}
+					settings.sync();
+				}
+			};
+		}
+		else
+		{
+			for (auto const& [name, value] : values)
+			{
+				_settings.setValue(name, value);
+			}
+			_settings.sync();
+		}
 	}
 
 	// Private Members
 	QSettings _settings{};
-	std::unordered_map<QString, Subject, QStringHash> _observers{};
+	std::unordered_map<Setting, SettingIndex, QStringHash> _indexes{}; // Only used to resolve names, handles directly index the arrays below
+	std::vector<Setting> _names{};
+	std::vector<QVariant> _values{}; // Cached value of each known setting, authoritative over _settings
+	std::vector<bool> _dirtyFlags{};
+	std::deque<Subject> _observers{}; // Subjects are not movable, a deque keeps them in place while growing
+	std::vector<SettingIndex> _dirty{}; // Values not written to disk yet
+	QElapsedTimer _dirtyTimer{}; // Since the oldest unwritten change
+	QTimer _flushTimer{};
+	std::thread _flushThread{};
 };
 
 SettingsManager& SettingsManager::getInstance() noexcept
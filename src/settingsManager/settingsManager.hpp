@@ -23,6 +23,8 @@
 #include <QVariant>
 #include <la/avdecc/utils.hpp>
 
+#include <cstdint>
+
 namespace settings
 {
 class SettingsManager
@@ -44,6 +46,21 @@ public:
 		virtual void onSettingChanged(settings::SettingsManager::Setting const& name, QVariant const& value) noexcept = 0;
 	};
 
+	using SettingIndex = std::uint32_t;
+	static constexpr SettingIndex InvalidSettingIndex = ~SettingIndex{ 0u };
+
+	/** Typed handle to a setting, resolved once by getHandle then reading and notifying without any name lookup */
+	template<typename T>
+	struct Handle
+	{
+		SettingIndex index{ InvalidSettingIndex };
+
+		constexpr bool isValid() const noexcept
+		{
+			return index != InvalidSettingIndex;
+		}
+	};
+
 	static SettingsManager& getInstance() noexcept;
 
 	virtual void registerSetting(SettingDefault const& setting) noexcept = 0;
@@ -57,8 +74,45 @@ public:
 
 	virtual QString getFilePath() const noexcept = 0;
 
+	/** Returns the handle of the setting, to be kept by frequent readers and observers */
+	template<typename T>
+	Handle<T> getHandle(SettingDefault const& setting) noexcept
+	{
+		return Handle<T>{ getSettingIndex(setting.name) };
+	}
+
+	template<typename T>
+	T getValue(Handle<T> const handle) const noexcept
+	{
+		return getIndexedValue(handle.index).template value<T>();
+	}
+
+	template<typename T>
+	void setValue(Handle<T> const handle, T const& value, Observer const* const dontNotifyObserver = nullptr) noexcept
+	{
+		setIndexedValue(handle.index, QVariant::fromValue(value), dontNotifyObserver);
+	}
+
+	template<typename T>
+	void registerSettingObserver(Handle<T> const handle, Observer* const observer, bool const triggerFirstNotification = true) noexcept
+	{
+		registerIndexedSettingObserver(handle.index, observer, triggerFirstNotification);
+	}
+
+	template<typename T>
+	void unregisterSettingObserver(Handle<T> const handle, Observer* const observer) noexcept
+	{
+		unregisterIndexedSettingObserver(handle.index, observer);
+	}
+
 protected:
 	SettingsManager() = default;
+
+	virtual SettingIndex getSettingIndex(Setting const& name) noexcept = 0;
+	virtual QVariant const& getIndexedValue(SettingIndex const index) const noexcept = 0;
+	virtual void setIndexedValue(SettingIndex const index, QVariant const& value, Observer const* const dontNotifyObserver) noexcept = 0;
+	virtual void registerIndexedSettingObserver(SettingIndex const index, Observer* const observer, bool const triggerFirstNotification) noexcept = 0;
+	virtual void unregisterIndexedSettingObserver(SettingIndex const index, Observer* const observer) noexcept = 0;
 };
 
 } // namespace settings
@@ -0,0 +1,220 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "startupProfiler.hpp"
+#include "avdecc/controllerManager.hpp"
+#include "avdecc/hiveLogItems.hpp"
+#include "internals/config.hpp"
+
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QStringList>
+#include <QSysInfo>
+
+#include <vector>
+#include <algorithm>
+
+StartupProfiler::ScopedPhase::ScopedPhase(QString const& name) noexcept
+	: _name{ name }
+	, _start{ StartupProfiler::getInstance().elapsed() }
+{
+}
+
+StartupProfiler::ScopedPhase::~ScopedPhase() noexcept
+{
+	StartupProfiler::getInstance().addPhase(_name, _start);
+}
+
+class StartupProfilerImpl final : public StartupProfiler
+{
+public:
+	StartupProfilerImpl() noexcept
+	{
+		_timer.start();
+
+		auto& manager = avdecc::ControllerManager::getInstance();
+		connect(&manager, &avdecc::ControllerManager::entityOnline, this, &StartupProfilerImpl::handleEntityOnline);
+
+		_enumerationTimer.setSingleShot(true);
+		connect(&_enumerationTimer, &QTimer::timeout, this, &StartupProfilerImpl::completeReport);
+	}
+
+private:
+	struct Phase
+	{
+		QString name{};
+		qint64 start{ 0 };
+		qint64 duration{ 0 };
+	};
+
+	struct Milestone
+	{
+		QString name{};
+		qint64 time{ 0 };
+	};
+
+	// StartupProfiler overrides
+	virtual void setReportFile(QString const& filePath) noexcept override
+	{
+		_reportFile = filePath;
+
+		// Make sure the report is written even if no entity is found on the network
+		if (!_reportFile.isEmpty() && !_completed)
+		{
+			_enumerationTimer.start(EnumerationTimeout);
+		}
+	}
+
+	virtual qint64 elapsed() const noexcept override
+	{
+		return _timer.elapsed();
+	}
+
+	virtual void addPhase(QString const& name, qint64 const startTime) noexcept override
+	{
+		if (!_completed)
+		{
+			_phases.push_back(Phase{ name, startTime, elapsed() - startTime });
+		}
+	}
+
+	virtual void addMilestone(QString const& name) noexcept override
+	{
+		if (_completed)
+		{
+			return;
+		}
+		auto const it = std::find_if(_milestones.begin(), _milestones.end(),
+			[&name](auto const& milestone)
+			{
+				return milestone.name == name;
+			});
+		if (it == _milestones.end())
+		{
+			_milestones.push_back(Milestone{ name, elapsed() });
+		}
+	}
+
+	virtual QString summary() const noexcept override
+	{
+		auto list = QStringList{};
+		for (auto const& phase : _phases)
+		{
+			list << QString("%1: %2ms").arg(phase.name).arg(phase.duration);
+		}
+		for (auto const& milestone : _milestones)
+		{
+			list << QString("%1 at %2ms").arg(milestone.name).arg(milestone.time);
+		}
+		return list.join(", ");
+	}
+
+	// Private methods
+	void handleEntityOnline(la::avdecc::UniqueIdentifier const /*entityID*/, std::chrono::milliseconds const enumerationTime) noexcept
+	{
+		if (_completed)
+		{
+			return;
+		}
+
+		addMilestone("firstEntityOnline");
+		_lastEntityOnline = elapsed();
+		++_entitiesCount;
+		_maxEnumerationTime = std::max(_maxEnumerationTime, static_cast<qint64>(enumerationTime.count()));
+
+		// The network is considered enumerated when no new entity came online for a while
+		_enumerationTimer.start(EnumerationQuietPeriod);
+	}
+
+	void completeReport() noexcept
+	{
+		if (_completed)
+		{
+			return;
+		}
+
+		if (_entitiesCount != 0u)
+		{
+			_milestones.push_back(Milestone{ "allEntitiesEnumerated", _lastEntityOnline });
+		}
+		_completed = true;
+
+		LOG_HIVE_INFO(QString("Startup profile: %1").arg(summary()));
+
+		if (!_reportFile.isEmpty())
+		{
+			writeReport();
+		}
+	}
+
+	void writeReport() const noexcept
+	{
+		auto phases = QJsonArray{};
+		for (auto const& phase : _phases)
+		{
+			phases.append(QJsonObject{ { "name", phase.name }, { "start_ms", phase.start }, { "duration_ms", phase.duration } });
+		}
+
+		auto milestones = QJsonObject{};
+		for (auto const& milestone : _milestones)
+		{
+			milestones.insert(milestone.name, milestone.time);
+		}
+
+		auto const report = QJsonObject{
+			{ "hive_version", hive::internals::versionString },
+			{ "platform", QSysInfo::prettyProductName() },
+			{ "phases", phases },
+			{ "milestones_ms", milestones },
+			{ "entities_count", static_cast<qint64>(_entitiesCount) },
+			{ "max_entity_enumeration_ms", _maxEnumerationTime },
+		};
+
+		auto file = QFile{ _reportFile };
+		if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		{
+			LOG_HIVE_WARN(QString("Cannot write startup report to %1: %2").arg(_reportFile).arg(file.errorString()));
+			return;
+		}
+		file.write(QJsonDocument{ report }.toJson());
+		LOG_HIVE_INFO(QString("Startup report written to %1").arg(_reportFile));
+	}
+
+	// Private members
+	QElapsedTimer _timer{};
+	QTimer _enumerationTimer{};
+	QString _reportFile{};
+	std::vector<Phase> _phases{};
+	std::vector<Milestone> _milestones{};
+	qint64 _lastEntityOnline{ 0 };
+	qint64 _maxEnumerationTime{ 0 };
+	size_t _entitiesCount{ 0u };
+	bool _completed{ false };
+};
+
+StartupProfiler& StartupProfiler::getInstance() noexcept
+{
+	static StartupProfilerImpl s_StartupProfiler{};
+
+	return s_StartupProfiler;
+}
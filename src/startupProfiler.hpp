@@ -0,0 +1,73 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+
+/** Records the duration of the startup phases and the enumeration milestones, optionally writing them as a JSON report */
+class StartupProfiler : public QObject
+{
+	Q_OBJECT
+public:
+	/** Measures a phase for the lifetime of the object. Phases can be nested */
+	class ScopedPhase final
+	{
+	public:
+		explicit ScopedPhase(QString const& name) noexcept;
+		~ScopedPhase() noexcept;
+
+		// Deleted compiler auto-generated methods
+		ScopedPhase(ScopedPhase const&) = delete;
+		ScopedPhase(ScopedPhase&&) = delete;
+		ScopedPhase& operator=(ScopedPhase const&) = delete;
+		ScopedPhase& operator=(ScopedPhase&&) = delete;
+
+	private:
+		QString _name{};
+		qint64 _start{ 0 };
+	};
+
+	/** Time without any new entity online after which the network is considered fully enumerated */
+	static constexpr int EnumerationQuietPeriod = 5000; // In msec
+	/** Time after which the report is written even if no entity came online */
+	static constexpr int EnumerationTimeout = 60000; // In msec
+
+	/** Time reference of the profiler is its first access, it should be done as early as possible in main() */
+	static StartupProfiler& getInstance() noexcept;
+
+	/** Writes the JSON report to the specified file once enumeration is done. Must be called before the controller is created */
+	virtual void setReportFile(QString const& filePath) noexcept = 0;
+
+	/** Milliseconds elapsed since the profiler was created */
+	virtual qint64 elapsed() const noexcept = 0;
+
+	/** Records a phase which started at startTime (obtained from elapsed()). Ignored once the report is complete */
+	virtual void addPhase(QString const& name, qint64 const startTime) noexcept = 0;
+
+	/** Records a point in time. Only the first occurrence of a milestone is kept */
+	virtual void addMilestone(QString const& name) noexcept = 0;
+
+	/** Single line summary of the recorded phases, for the log */
+	virtual QString summary() const noexcept = 0;
+
+protected:
+	StartupProfiler() = default;
+};
@@ -0,0 +1,127 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "dispatchProfilerDialog.hpp"
+#include "dispatchProfiler.hpp"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+
+#include <chrono>
+
+static constexpr auto RefreshPeriod = std::chrono::milliseconds{ 1000 };
+
+/** Item displaying a number, so the tables are sorted numerically */
+template<typename Type>
+static QTableWidgetItem* makeNumericItem(Type const value) noexcept
+{
+	auto* const item = new QTableWidgetItem;
+	item->setData(Qt::DisplayRole, value);
+	item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+	return item;
+}
+
+static double toMilliseconds(DispatchProfiler::Duration const& duration) noexcept
+{
+	return std::chrono::duration<double, std::milli>{ duration }.count();
+}
+
+static void setupTable(QTableWidget& table, QStringList const& headers, int const sortColumn) noexcept
+{
+	table.setColumnCount(headers.size());
+	table.setHorizontalHeaderLabels(headers);
+	table.setEditTriggers(QAbstractItemView::NoEditTriggers);
+	table.setSelectionBehavior(QAbstractItemView::SelectRows);
+	table.setSelectionMode(QAbstractItemView::SingleSelection);
+	table.verticalHeader()->setVisible(false);
+	table.horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+	table.setSortingEnabled(true);
+	table.sortByColumn(sortColumn, Qt::DescendingOrder);
+}
+
+/** Fills the table keeping the current sort, which would otherwise be applied while items are being inserted */
+template<typename Statistics, typename FillRow>
+static void fillTable(QTableWidget& table, std::vector<Statistics> const& statistics, FillRow&& fillRow) noexcept
+{
+	table.setSortingEnabled(false);
+	table.setRowCount(static_cast<int>(statistics.size()));
+	auto row = 0;
+	for (auto const& s : statistics)
+	{
+		fillRow(row, s);
+		++row;
+	}
+	table.setSortingEnabled(true);
+}
+
+DispatchProfilerDialog::DispatchProfilerDialog(QWidget* parent)
+	: QDialog{ parent, Qt::WindowSystemMenuHint | Qt::WindowTitleHint | Qt::WindowCloseButtonHint | Qt::WindowMaximizeButtonHint }
+{
+	setWindowTitle("Signal Dispatch Profiler");
+	resize(720, 560);
+
+	setupTable(_receiversTable, { "Receiver", "Queued Calls", "Total (msec)", "Average (msec)", "Max (msec)" }, 2);
+	setupTable(_signalsTable, { "ControllerManager Signal", "Emissions" }, 1);
+	_tabWidget.addTab(&_receiversTable, "Receivers");
+	_tabWidget.addTab(&_signalsTable, "Signals");
+
+	auto* const buttonsLayout = new QHBoxLayout;
+	buttonsLayout->addStretch();
+	buttonsLayout->addWidget(&_clearButton);
+
+	auto* const layout = new QVBoxLayout{ this };
+	layout->addWidget(&_tabWidget);
+	layout->addLayout(buttonsLayout);
+
+	connect(&_clearButton, &QPushButton::clicked, this,
+		[this]()
+		{
+			DispatchProfiler::getInstance().clearStatistics();
+			refresh();
+		});
+
+	connect(&_refreshTimer, &QTimer::timeout, this, &DispatchProfilerDialog::refresh);
+	_refreshTimer.start(RefreshPeriod.count());
+
+	refresh();
+}
+
+void DispatchProfilerDialog::refresh() noexcept
+{
+	auto const& profiler = DispatchProfiler::getInstance();
+
+	fillTable(_receiversTable, profiler.getReceiverStatistics(),
+		[this](int const row, DispatchProfiler::ReceiverStatistics const& statistics)
+		{
+			auto const average = statistics.callsCount != 0u ? statistics.totalTime / statistics.callsCount : DispatchProfiler::Duration::zero();
+			_receiversTable.setItem(row, 0, new QTableWidgetItem{ statistics.className });
+			_receiversTable.setItem(row, 1, makeNumericItem(static_cast<qulonglong>(statistics.callsCount)));
+			_receiversTable.setItem(row, 2, makeNumericItem(toMilliseconds(statistics.totalTime)));
+			_receiversTable.setItem(row, 3, makeNumericItem(toMilliseconds(average)));
+			_receiversTable.setItem(row, 4, makeNumericItem(toMilliseconds(statistics.maxTime)));
+		});
+
+	fillTable(_signalsTable, profiler.getSignalStatistics(),
+		[this](int const row, DispatchProfiler::SignalStatistics const& statistics)
+		{
+			_signalsTable.setItem(row, 0, new QTableWidgetItem{ statistics.name });
+			_signalsTable.setItem(row, 1, makeNumericItem(static_cast<qulonglong>(statistics.emissionsCount)));
+		});
+}
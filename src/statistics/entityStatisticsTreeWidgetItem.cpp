@@ -18,9 +18,39 @@
 */
 
 #include "entityStatisticsTreeWidgetItem.hpp"
+#include "avdecc/entitySubscriptions.hpp"
 
 #include <QMenu>
 
+/** Formats a latency in msec, with a 0.1 msec resolution */
+static QString latencyToString(avdecc::LatencyHistogram::Duration const& latency) noexcept
+{
+	return QString::number(static_cast<double>(latency.count()) / 1000.0, 'f', 1);
+}
+
+/** Sets the percentiles of the histogram as the value of the item, and the non-empty buckets as its tooltip */
+static void setLatencyHistogram(QTreeWidgetItem& item, avdecc::LatencyHistogram const& histogram) noexcept
+{
+	auto const text = QString("p50 %1 / p95 %2 / p99 %3 / max %4 msec (%5)").arg(latencyToString(histogram.percentile(0.50))).arg(latencyToString(histogram.percentile(0.95))).arg(latencyToString(histogram.percentile(0.99))).arg(latencyToString(histogram.max())).arg(histogram.count());
+	item.setText(1, text);
+
+	auto tooltip = QString{};
+	auto const& buckets = histogram.buckets();
+	for (auto index = std::size_t{ 0u }; index < buckets.size(); ++index)
+	{
+		if (buckets[index] != 0u)
+		{
+			if (!tooltip.isEmpty())
+			{
+				tooltip += "\n";
+			}
+			auto const isLastBucket = index == (buckets.size() - 1u);
+			tooltip += QString("%1 - %2 msec: %3").arg(latencyToString(avdecc::LatencyHistogram::bucketLowerBound(index))).arg(isLastBucket ? QString{ "..." } : latencyToString(avdecc::LatencyHistogram::bucketUpperBound(index))).arg(buckets[index]);
+		}
+	}
+	item.setToolTip(1, tooltip);
+}
+
 EntityStatisticsTreeWidgetItem::EntityStatisticsTreeWidgetItem(la::avdecc::UniqueIdentifier const entityID, std::uint64_t const aecpRetryCounter, std::uint64_t const aecpTimeoutCounter, std::uint64_t const aecpUnexpectedResponseCounter, std::chrono::milliseconds const& aecpResponseAverageTime, std::uint64_t const aemAecpUnsolicitedCounter, std::chrono::milliseconds const& enumerationTime, QTreeWidget* parent)
 	: QTreeWidgetItem(parent)
 	, _entityID(entityID)
@@ -32,6 +62,7 @@ EntityStatisticsTreeWidgetItem::EntityStatisticsTreeWidgetItem(la::avdecc::Uniqu
 	_aecpResponseAverageTimeItem.setText(0, "AECP Average Response Time");
 	_aemAecpUnsolicitedCounterItem.setText(0, "AEM Unsolicited Responses");
 	_enumerationTimeItem.setText(0, "Enumeration Time");
+	_aecpCommandLatenciesItem.setText(0, "AECP Response Time");
 
 	// Update statistics right now
 	auto& manager = avdecc::ControllerManager::getInstance();
@@ -42,59 +73,53 @@ EntityStatisticsTreeWidgetItem::EntityStatisticsTreeWidgetItem(la::avdecc::Uniqu
 	updateAecpResponseAverageTime(aecpResponseAverageTime);
 	updateAemAecpUnsolicitedCounter(aemAecpUnsolicitedCounter);
 	_enumerationTimeItem.setText(1, QString::number(enumerationTime.count()) + " msec");
+	setEnumerationTimeline();
+	updateAecpCommandLatencies();
 
 	// Listen for signals
-	connect(&manager, &avdecc::ControllerManager::aecpRetryCounterChanged, this,
-		[this](la::avdecc::UniqueIdentifier const entityID, std::uint64_t const value)
+	auto& subscriptions = avdecc::EntitySubscriptions::getInstance();
+	auto const key = avdecc::EntitySubscriptions::makeKey(_entityID);
+	subscriptions.aecpRetryCounterChanged().subscribe(this, key,
+		[this](std::uint64_t const& value)
 		{
-			if (entityID == _entityID)
-			{
-				updateAecpRetryCounter(value);
-			}
+			updateAecpRetryCounter(value);
 		});
-	connect(&manager, &avdecc::ControllerManager::aecpTimeoutCounterChanged, this,
-		[this](la::avdecc::UniqueIdentifier const entityID, std::uint64_t const value)
+	subscriptions.aecpTimeoutCounterChanged().subscribe(this, key,
+		[this](std::uint64_t const& value)
 		{
-			if (entityID == _entityID)
-			{
-				updateAecpTimeoutCounter(value);
-			}
+			updateAecpTimeoutCounter(value);
 		});
-	connect(&manager, &avdecc::ControllerManager::aecpUnexpectedResponseCounterChanged, this,
-		[this](la::avdecc::UniqueIdentifier const entityID, std::uint64_t const value)
+	subscriptions.aecpUnexpectedResponseCounterChanged().subscribe(this, key,
+		[this](std::uint64_t const& value)
 		{
-			if (entityID == _entityID)
-			{
-				updateAecpUnexpectedResponseCounter(value);
-			}
+			updateAecpUnexpectedResponseCounter(value);
 		});
-	connect(&manager, &avdecc::ControllerManager::aecpResponseAverageTimeChanged, this,
-		[this](la::avdecc::UniqueIdentifier const entityID, std::chrono::milliseconds const& value)
+	subscriptions.aecpResponseAverageTimeChanged().subscribe(this, key,
+		[this](std::chrono::milliseconds const& value)
 		{
-			if (entityID == _entityID)
-			{
-				updateAecpResponseAverageTime(value);
-			}
+			updateAecpResponseAverageTime(value);
 		});
-	connect(&manager, &avdecc::ControllerManager::aemAecpUnsolicitedCounterChanged, this,
-		[this](la::avdecc::UniqueIdentifier const entityID, std::uint64_t const value)
+	subscriptions.aemAecpUnsolicitedCounterChanged().subscribe(this, key,
+		[this](std::uint64_t const& value)
 		{
-			if (entityID == _entityID)
-			{
-				updateAemAecpUnsolicitedCounter(value);
-			}
+			updateAemAecpUnsolicitedCounter(value);
 		});
-	connect(&manager, &avdecc::ControllerManager::statisticsErrorCounterChanged, this,
-		[this](la::avdecc::UniqueIdentifier const entityID, avdecc::ControllerManager::StatisticsErrorCounters const& errorCounters)
+	subscriptions.statisticsErrorCounterChanged().subscribe(this, key,
+		[this](avdecc::ControllerManager::StatisticsErrorCounters const& errorCounters)
 		{
-			if (entityID == _entityID)
-			{
-				_errorCounters = errorCounters;
-				updateAecpRetryCounter(_counters[avdecc::ControllerManager::StatisticsErrorCounterFlag::AecpRetries]);
-				updateAecpTimeoutCounter(_counters[avdecc::ControllerManager::StatisticsErrorCounterFlag::AecpTimeouts]);
-				updateAecpUnexpectedResponseCounter(_counters[avdecc::ControllerManager::StatisticsErrorCounterFlag::AecpUnexpectedResponses]);
-			}
+			_errorCounters = errorCounters;
+			updateErrorCounters();
+		});
+
+	// Refresh the trend of the counters even if they don't change, and the commands latency (which is not notified)
+	_refreshTimer.setInterval(CounterTrendRefreshPeriod);
+	connect(&_refreshTimer, &QTimer::timeout, this,
+		[this]()
+		{
+			updateErrorCounters();
+			updateAecpCommandLatencies();
 		});
+	_refreshTimer.start();
 }
 
 void EntityStatisticsTreeWidgetItem::setWidgetTextAndColor(EntityStatisticTreeWidgetItem& widget, std::uint64_t const value, avdecc::ControllerManager::StatisticsErrorCounterFlag const flag) noexcept
@@ -109,6 +134,15 @@ void EntityStatisticsTreeWidgetItem::setWidgetTextAndColor(EntityStatisticTreeWi
 		text += QString(" (+%1)").arg(errorCounterIt->second);
 	}
 
+	auto const history = avdecc::ControllerManager::getInstance().getStatisticsCountersHistory(_entityID);
+	if (auto const historyIt = history.find(flag); historyIt != history.end())
+	{
+		if (auto const trend = counterTrendText(historyIt->second); !trend.isEmpty())
+		{
+			text += "  " + trend;
+		}
+	}
+
 	widget.setForeground(0, color);
 	widget.setForeground(1, color);
 
@@ -134,6 +168,62 @@ void EntityStatisticsTreeWidgetItem::updateAecpUnexpectedResponseCounter(std::ui
 	setWidgetTextAndColor(_aecpUnexpectedResponseCounterItem, value, avdecc::ControllerManager::StatisticsErrorCounterFlag::AecpUnexpectedResponses);
 }
 
+void EntityStatisticsTreeWidgetItem::updateErrorCounters() noexcept
+{
+	updateAecpRetryCounter(_counters[avdecc::ControllerManager::StatisticsErrorCounterFlag::AecpRetries]);
+	updateAecpTimeoutCounter(_counters[avdecc::ControllerManager::StatisticsErrorCounterFlag::AecpTimeouts]);
+	updateAecpUnexpectedResponseCounter(_counters[avdecc::ControllerManager::StatisticsErrorCounterFlag::AecpUnexpectedResponses]);
+}
+
+void EntityStatisticsTreeWidgetItem::setEnumerationTimeline() noexcept
+{
+	auto const timeline = avdecc::ControllerManager::getInstance().getEnumerationTimeline(_entityID);
+	if (!timeline)
+	{
+		return;
+	}
+
+	auto const addItem = [this](QString const& name, QString const& value)
+	{
+		auto* item = new QTreeWidgetItem(&_enumerationTimeItem);
+		item->setText(0, name);
+		item->setText(1, value);
+	};
+
+	addItem("Discovered After", QString::number(timeline->discoveredAt.count()) + " msec");
+	addItem("Online After", QString::number(timeline->onlineAt.count()) + " msec");
+	addItem("Query Errors", QString::number(timeline->queryErrors));
+	addItem("AECP Retries", QString::number(timeline->aecpRetries));
+	addItem("AECP Timeouts", QString::number(timeline->aecpTimeouts));
+	addItem("AECP Average Response Time", QString::number(timeline->aecpResponseAverageTime.count()) + " msec");
+	addItem("AEM Cache", timeline->aemCacheEnabled ? "Enabled" : "Disabled");
+	addItem("Full Static Model", timeline->fullStaticModelEnabled ? "Enabled" : "Disabled");
+	addItem("Restored After Reboot", timeline->restored ? "Yes" : "No");
+}
+
+void EntityStatisticsTreeWidgetItem::updateAecpCommandLatencies() noexcept
+{
+	auto const latencies = avdecc::ControllerManager::getInstance().getAecpCommandLatencies(_entityID);
+
+	setLatencyHistogram(_aecpCommandLatenciesItem, latencies.allCommands);
+
+	for (auto const& [commandType, histogram] : latencies.perCommandType)
+	{
+		auto* item = static_cast<QTreeWidgetItem*>(nullptr);
+		if (auto const it = _aecpCommandLatencyItems.find(commandType); it != _aecpCommandLatencyItems.end())
+		{
+			item = it->second;
+		}
+		else
+		{
+			item = new QTreeWidgetItem(&_aecpCommandLatenciesItem);
+			item->setText(0, avdecc::ControllerManager::typeToString(commandType));
+			_aecpCommandLatencyItems[commandType] = item;
+		}
+		setLatencyHistogram(*item, histogram);
+	}
+}
+
 void EntityStatisticsTreeWidgetItem::updateAecpResponseAverageTime(std::chrono::milliseconds const& value) noexcept
 {
 	_aecpResponseAverageTimeItem.setText(1, QString::number(value.count()) + " msec");
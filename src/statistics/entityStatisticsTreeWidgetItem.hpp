@@ -24,14 +24,17 @@
 #include "avdecc/helper.hpp"
 #include "avdecc/controllerManager.hpp"
 #include "nodeTreeWidget.hpp"
+#include "counters/counterTrend.hpp"
 
 #include <chrono>
+#include <map>
 
 #include <QObject>
 #include <QTreeWidgetItem>
 #include <QPushButton>
 #include <QLabel>
 #include <QHBoxLayout>
+#include <QTimer>
 
 class EntityStatisticTreeWidgetItem : public QTreeWidgetItem
 {
@@ -67,6 +70,9 @@ private:
 	void updateAecpUnexpectedResponseCounter(std::uint64_t const value) noexcept;
 	void updateAecpResponseAverageTime(std::chrono::milliseconds const& value) noexcept;
 	void updateAemAecpUnsolicitedCounter(std::uint64_t const value) noexcept;
+	void updateErrorCounters() noexcept;
+	void updateAecpCommandLatencies() noexcept;
+	void setEnumerationTimeline() noexcept;
 
 	la::avdecc::UniqueIdentifier const _entityID{};
 
@@ -77,6 +83,9 @@ private:
 	QTreeWidgetItem _aecpResponseAverageTimeItem{ this };
 	QTreeWidgetItem _aemAecpUnsolicitedCounterItem{ this };
 	QTreeWidgetItem _enumerationTimeItem{ this };
+	QTreeWidgetItem _aecpCommandLatenciesItem{ this };
+	std::map<avdecc::ControllerManager::AecpCommandType, QTreeWidgetItem*> _aecpCommandLatencyItems{}; // Created the first time a command of that type completes
 	avdecc::ControllerManager::StatisticsErrorCounters _counters{};
 	avdecc::ControllerManager::StatisticsErrorCounters _errorCounters{};
+	QTimer _refreshTimer{}; // Periodically refresh the counters trend (rate and sparkline) and the AECP commands latency
 };
@@ -0,0 +1,103 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "mainThreadLatencyDialog.hpp"
+#include "mainThreadWatchdog.hpp"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+
+#include <chrono>
+
+static constexpr auto RefreshPeriod = std::chrono::milliseconds{ 1000 };
+
+/** Formats a latency in msec, with a 0.1 msec resolution */
+static QString latencyToString(avdecc::LatencyHistogram::Duration const& latency) noexcept
+{
+	return QString::number(static_cast<double>(latency.count()) / 1000.0, 'f', 1);
+}
+
+MainThreadLatencyDialog::MainThreadLatencyDialog(QWidget* parent)
+	: QDialog{ parent, Qt::WindowSystemMenuHint | Qt::WindowTitleHint | Qt::WindowCloseButtonHint | Qt::WindowMaximizeButtonHint }
+{
+	setWindowTitle("Main Thread Latency");
+	resize(480, 560);
+
+	_treeWidget.setColumnCount(2);
+	_treeWidget.setHeaderLabels({ "Latency", "Value" });
+	_treeWidget.setRootIsDecorated(false);
+	_treeWidget.header()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
+
+	auto* const buttonsLayout = new QHBoxLayout;
+	buttonsLayout->addStretch();
+	buttonsLayout->addWidget(&_clearButton);
+
+	auto* const layout = new QVBoxLayout{ this };
+	layout->addWidget(&_treeWidget);
+	layout->addLayout(buttonsLayout);
+
+	connect(&_clearButton, &QPushButton::clicked, this,
+		[this]()
+		{
+			MainThreadWatchdog::getInstance().clearStatistics();
+			refresh();
+		});
+
+	connect(&_refreshTimer, &QTimer::timeout, this, &MainThreadLatencyDialog::refresh);
+	_refreshTimer.start(RefreshPeriod.count());
+
+	refresh();
+}
+
+void MainThreadLatencyDialog::refresh() noexcept
+{
+	auto const statistics = MainThreadWatchdog::getInstance().getStatistics();
+	auto const& histogram = statistics.latencies;
+
+	_treeWidget.clear();
+
+	auto const addRow = [this](QString const& name, QString const& value)
+	{
+		auto* const item = new QTreeWidgetItem{ &_treeWidget };
+		item->setText(0, name);
+		item->setText(1, value);
+	};
+
+	addRow("Samples", QString::number(histogram.count()));
+	addRow("p50 / p95 / p99 / max", QString("%1 / %2 / %3 / %4 msec").arg(latencyToString(histogram.percentile(0.50))).arg(latencyToString(histogram.percentile(0.95))).arg(latencyToString(histogram.percentile(0.99))).arg(latencyToString(histogram.max())));
+	addRow("Stalls", QString("%1 (more than %2 msec)").arg(statistics.stallsCount).arg(MainThreadWatchdog::StallThreshold.count()));
+	addRow("Longest Stall", QString("%1 msec").arg(statistics.longestStall.count()));
+	if (!statistics.lastStallReport.isEmpty())
+	{
+		addRow("Last Stall Report", statistics.lastStallReport);
+	}
+
+	// One row per non-empty bucket
+	auto const& buckets = histogram.buckets();
+	for (auto index = std::size_t{ 0u }; index < buckets.size(); ++index)
+	{
+		if (buckets[index] != 0u)
+		{
+			auto const isLastBucket = index == (buckets.size() - 1u);
+			auto const percent = 100.0 * static_cast<double>(buckets[index]) / static_cast<double>(histogram.count());
+			addRow(QString("%1 - %2 msec").arg(latencyToString(avdecc::LatencyHistogram::bucketLowerBound(index))).arg(isLastBucket ? QString{ "..." } : latencyToString(avdecc::LatencyHistogram::bucketUpperBound(index))), QString("%1 (%2%)").arg(buckets[index]).arg(QString::number(percent, 'f', 1)));
+		}
+	}
+}
@@ -0,0 +1,47 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QDialog>
+#include <QTreeWidget>
+#include <QPushButton>
+#include <QTimer>
+
+/** Latency histogram of the main thread event loop and stalls detected by the MainThreadWatchdog */
+class MainThreadLatencyDialog : public QDialog
+{
+	Q_OBJECT
+
+public:
+	MainThreadLatencyDialog(QWidget* parent = nullptr);
+
+	// Deleted compiler auto-generated methods
+	MainThreadLatencyDialog(MainThreadLatencyDialog&&) = delete;
+	MainThreadLatencyDialog(MainThreadLatencyDialog const&) = delete;
+	MainThreadLatencyDialog& operator=(MainThreadLatencyDialog const&) = delete;
+	MainThreadLatencyDialog& operator=(MainThreadLatencyDialog&&) = delete;
+
+private:
+	void refresh() noexcept;
+
+	QTreeWidget _treeWidget{ this };
+	QPushButton _clearButton{ "Clear", this };
+	QTimer _refreshTimer{ this };
+};
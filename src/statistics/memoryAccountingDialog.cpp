@@ -0,0 +1,115 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "memoryAccountingDialog.hpp"
+#include "avdecc/memoryAccounting.hpp"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+
+#include <chrono>
+
+static constexpr auto RefreshPeriod = std::chrono::milliseconds{ 1000 };
+
+/** Item displaying a number, so the table is sorted numerically */
+template<typename Type>
+static QTableWidgetItem* makeNumericItem(Type const value) noexcept
+{
+	auto* const item = new QTableWidgetItem;
+	item->setData(Qt::DisplayRole, value);
+	item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+	return item;
+}
+
+MemoryAccountingDialog::MemoryAccountingDialog(QWidget* parent)
+	: QDialog{ parent, Qt::WindowSystemMenuHint | Qt::WindowTitleHint | Qt::WindowCloseButtonHint | Qt::WindowMaximizeButtonHint }
+{
+	setWindowTitle("Memory Accounting");
+	resize(640, 560);
+
+	auto const headers = QStringList{ "Subsystem", "Counter", "Value", "Change" };
+	_countersTable.setColumnCount(headers.size());
+	_countersTable.setHorizontalHeaderLabels(headers);
+	_countersTable.setEditTriggers(QAbstractItemView::NoEditTriggers);
+	_countersTable.setSelectionBehavior(QAbstractItemView::SelectRows);
+	_countersTable.setSelectionMode(QAbstractItemView::SingleSelection);
+	_countersTable.verticalHeader()->setVisible(false);
+	_countersTable.horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
+
+	auto* const buttonsLayout = new QHBoxLayout;
+	buttonsLayout->addStretch();
+	buttonsLayout->addWidget(&_resetBaselineButton);
+
+	auto* const layout = new QVBoxLayout{ this };
+	layout->addWidget(&_countersTable);
+	layout->addLayout(buttonsLayout);
+
+	connect(&_resetBaselineButton, &QPushButton::clicked, this,
+		[this]()
+		{
+			_resetBaseline = true;
+			refresh();
+		});
+
+	connect(&_refreshTimer, &QTimer::timeout, this, &MemoryAccountingDialog::refresh);
+	_refreshTimer.start(RefreshPeriod.count());
+
+	refresh();
+}
+
+void MemoryAccountingDialog::refresh() noexcept
+{
+	auto const subsystems = avdecc::MemoryAccounting::getInstance().collect();
+
+	if (_resetBaseline)
+	{
+		_baseline.clear();
+	}
+
+	auto rowCount = 0;
+	for (auto const& s : subsystems)
+	{
+		rowCount += static_cast<int>(s.counters.size());
+	}
+	_countersTable.setRowCount(rowCount);
+
+	// Rows are kept in the subsystems registration order, so counters of the same subsystem stay together
+	auto row = 0;
+	for (auto const& [subsystem, counters] : subsystems)
+	{
+		for (auto const& counter : counters)
+		{
+			auto const key = subsystem + "/" + counter.name;
+			if (_resetBaseline || !_baseline.contains(key))
+			{
+				_baseline.insert(key, counter.value);
+			}
+			auto const change = static_cast<qlonglong>(counter.value) - static_cast<qlonglong>(_baseline.value(key));
+
+			_countersTable.setItem(row, 0, new QTableWidgetItem{ subsystem });
+			_countersTable.setItem(row, 1, new QTableWidgetItem{ counter.name });
+			_countersTable.setItem(row, 2, makeNumericItem(static_cast<qulonglong>(counter.value)));
+			_countersTable.setItem(row, 3, makeNumericItem(change));
+			++row;
+		}
+	}
+
+	_resetBaseline = false;
+}
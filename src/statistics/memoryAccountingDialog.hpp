@@ -0,0 +1,52 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QDialog>
+#include <QHash>
+#include <QTableWidget>
+#include <QPushButton>
+#include <QTimer>
+
+#include <cstdint>
+
+/** Table of the MemoryAccounting counters of all the subsystems, with their change since the dialog was opened (or the baseline was reset) */
+class MemoryAccountingDialog : public QDialog
+{
+	Q_OBJECT
+
+public:
+	MemoryAccountingDialog(QWidget* parent = nullptr);
+
+	// Deleted compiler auto-generated methods
+	MemoryAccountingDialog(MemoryAccountingDialog&&) = delete;
+	MemoryAccountingDialog(MemoryAccountingDialog const&) = delete;
+	MemoryAccountingDialog& operator=(MemoryAccountingDialog const&) = delete;
+	MemoryAccountingDialog& operator=(MemoryAccountingDialog&&) = delete;
+
+private:
+	void refresh() noexcept;
+
+	QTableWidget _countersTable{ this };
+	QPushButton _resetBaselineButton{ "Reset Baseline", this };
+	QTimer _refreshTimer{ this };
+	QHash<QString, std::uint64_t> _baseline{}; // Value of each counter ("subsystem/counter") when the baseline was taken
+	bool _resetBaseline{ true };
+};
@@ -0,0 +1,525 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "networkStatisticsDialog.hpp"
+#include "ui_networkStatisticsDialog.h"
+
+#include <QHeaderView>
+#include <QTimer>
+
+#include <la/avdecc/utils.hpp>
+#include "avdecc/controllerManager.hpp"
+#include "avdecc/helper.hpp"
+#include "defaults.hpp"
+
+#include <chrono>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+static constexpr auto StatisticsRefreshPeriod = std::chrono::milliseconds{ 1000 }; // Rate at which the table is refreshed, whatever the rate of the statistics changes
+static constexpr auto StatisticsRateWindow = std::chrono::milliseconds{ 10000 }; // Window over which the rates are computed
+
+class NetworkStatisticsModelPrivate;
+class NetworkStatisticsModel : public QAbstractTableModel
+{
+	Q_OBJECT
+public:
+	enum class Column
+	{
+		EntityID,
+		Name,
+		AecpRetries,
+		AecpRetriesRate,
+		AecpTimeouts,
+		AecpTimeoutsRate,
+		AecpUnexpectedResponses,
+		AemAecpUnsolicitedResponses,
+		ResponseTimeP50,
+		ResponseTimeP95,
+		ResponseTimeP99,
+
+		Count
+	};
+
+	static constexpr auto SortRole = Qt::UserRole; // Raw value of the cell, used to sort the table
+
+	NetworkStatisticsModel(QObject* parent = nullptr);
+	virtual ~NetworkStatisticsModel();
+
+	virtual int rowCount(QModelIndex const& parent = {}) const override;
+	virtual int columnCount(QModelIndex const& parent = {}) const override;
+	virtual QVariant data(QModelIndex const& index, int role = Qt::DisplayRole) const override;
+	virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+	QScopedPointer<NetworkStatisticsModelPrivate> const d_ptr;
+	Q_DECLARE_PRIVATE(NetworkStatisticsModel)
+};
+
+/***********************************************/
+
+class NetworkStatisticsModelPrivate : public QObject
+{
+	Q_OBJECT
+public:
+	NetworkStatisticsModelPrivate(NetworkStatisticsModel* model)
+		: q_ptr{ model }
+	{
+		// Connect avdecc::ControllerManager signals (all statistics signals are delivered through the coalescing event bus, so they are already rate limited)
+		auto& manager = avdecc::ControllerManager::getInstance();
+		connect(&manager, &avdecc::ControllerManager::controllerOffline, this, &NetworkStatisticsModelPrivate::handleControllerOffline);
+		connect(&manager, &avdecc::ControllerManager::entityOnline, this, &NetworkStatisticsModelPrivate::handleEntityOnline);
+		connect(&manager, &avdecc::ControllerManager::entityOffline, this, &NetworkStatisticsModelPrivate::handleEntityOffline);
+		connect(&manager, &avdecc::ControllerManager::entityNameChanged, this, &NetworkStatisticsModelPrivate::handleEntityNameChanged);
+		connect(&manager, &avdecc::ControllerManager::aecpRetryCounterChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, std::uint64_t const value)
+			{
+				if (auto* data = entityData(entityID))
+				{
+					data->aecpRetries = value;
+				}
+			});
+		connect(&manager, &avdecc::ControllerManager::aecpTimeoutCounterChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, std::uint64_t const value)
+			{
+				if (auto* data = entityData(entityID))
+				{
+					data->aecpTimeouts = value;
+				}
+			});
+		connect(&manager, &avdecc::ControllerManager::aecpUnexpectedResponseCounterChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, std::uint64_t const value)
+			{
+				if (auto* data = entityData(entityID))
+				{
+					data->aecpUnexpectedResponses = value;
+				}
+			});
+		connect(&manager, &avdecc::ControllerManager::aemAecpUnsolicitedCounterChanged, this,
+			[this](la::avdecc::UniqueIdentifier const entityID, std::uint64_t const value)
+			{
+				if (auto* data = entityData(entityID))
+				{
+					data->aemAecpUnsolicitedResponses = value;
+				}
+			});
+
+		// Values are only refreshed (and the views notified) at a fixed rate
+		_refreshTimer.setInterval(StatisticsRefreshPeriod);
+		connect(&_refreshTimer, &QTimer::timeout, this, &NetworkStatisticsModelPrivate::refreshStatistics);
+		_refreshTimer.start();
+	}
+
+	int rowCount() const
+	{
+		return static_cast<int>(_entities.size());
+	}
+
+	int columnCount() const
+	{
+		return la::avdecc::utils::to_integral(NetworkStatisticsModel::Column::Count);
+	}
+
+	QVariant data(QModelIndex const& index, int role) const
+	{
+		auto const row = index.row();
+		if (row < 0 || row >= rowCount())
+		{
+			return {};
+		}
+
+		auto const& data = _entities[row];
+		auto const column = static_cast<NetworkStatisticsModel::Column>(index.column());
+
+		if (role == Qt::DisplayRole)
+		{
+			switch (column)
+			{
+				case NetworkStatisticsModel::Column::EntityID:
+					return avdecc::helper::uniqueIdentifierToString(data.entityID);
+				case NetworkStatisticsModel::Column::Name:
+					return data.name;
+				case NetworkStatisticsModel::Column::AecpRetries:
+					return QString::number(data.aecpRetries);
+				case NetworkStatisticsModel::Column::AecpRetriesRate:
+					return rateToString(data.aecpRetriesRate);
+				case NetworkStatisticsModel::Column::AecpTimeouts:
+					return QString::number(data.aecpTimeouts);
+				case NetworkStatisticsModel::Column::AecpTimeoutsRate:
+					return rateToString(data.aecpTimeoutsRate);
+				case NetworkStatisticsModel::Column::AecpUnexpectedResponses:
+					return QString::number(data.aecpUnexpectedResponses);
+				case NetworkStatisticsModel::Column::AemAecpUnsolicitedResponses:
+					return QString::number(data.aemAecpUnsolicitedResponses);
+				case NetworkStatisticsModel::Column::ResponseTimeP50:
+					return latencyToString(data.responseTimeP50, data.responseTimeCount);
+				case NetworkStatisticsModel::Column::ResponseTimeP95:
+					return latencyToString(data.responseTimeP95, data.responseTimeCount);
+				case NetworkStatisticsModel::Column::ResponseTimeP99:
+					return latencyToString(data.responseTimeP99, data.responseTimeCount);
+				default:
+					break;
+			}
+		}
+		else if (role == NetworkStatisticsModel::SortRole)
+		{
+			switch (column)
+			{
+				case NetworkStatisticsModel::Column::EntityID:
+					return static_cast<qulonglong>(data.entityID.getValue());
+				case NetworkStatisticsModel::Column::Name:
+					return data.name;
+				case NetworkStatisticsModel::Column::AecpRetries:
+					return static_cast<qulonglong>(data.aecpRetries);
+				case NetworkStatisticsModel::Column::AecpRetriesRate:
+					return data.aecpRetriesRate;
+				case NetworkStatisticsModel::Column::AecpTimeouts:
+					return static_cast<qulonglong>(data.aecpTimeouts);
+				case NetworkStatisticsModel::Column::AecpTimeoutsRate:
+					return data.aecpTimeoutsRate;
+				case NetworkStatisticsModel::Column::AecpUnexpectedResponses:
+					return static_cast<qulonglong>(data.aecpUnexpectedResponses);
+				case NetworkStatisticsModel::Column::AemAecpUnsolicitedResponses:
+					return static_cast<qulonglong>(data.aemAecpUnsolicitedResponses);
+				case NetworkStatisticsModel::Column::ResponseTimeP50:
+					return static_cast<qlonglong>(data.responseTimeP50.count());
+				case NetworkStatisticsModel::Column::ResponseTimeP95:
+					return static_cast<qlonglong>(data.responseTimeP95.count());
+				case NetworkStatisticsModel::Column::ResponseTimeP99:
+					return static_cast<qlonglong>(data.responseTimeP99.count());
+				default:
+					break;
+			}
+		}
+		else if (role == Qt::TextAlignmentRole)
+		{
+			if (column != NetworkStatisticsModel::Column::EntityID && column != NetworkStatisticsModel::Column::Name)
+			{
+				return static_cast<int>(Qt::AlignRight | Qt::AlignVCenter);
+			}
+		}
+
+		return {};
+	}
+
+	QVariant headerData(int section, Qt::Orientation orientation, int role) const
+	{
+		if (orientation == Qt::Horizontal)
+		{
+			if (role == Qt::DisplayRole)
+			{
+				switch (static_cast<NetworkStatisticsModel::Column>(section))
+				{
+					case NetworkStatisticsModel::Column::EntityID:
+						return "Entity ID";
+					case NetworkStatisticsModel::Column::Name:
+						return "Name";
+					case NetworkStatisticsModel::Column::AecpRetries:
+						return "AECP Retries";
+					case NetworkStatisticsModel::Column::AecpRetriesRate:
+						return "Retries/s";
+					case NetworkStatisticsModel::Column::AecpTimeouts:
+						return "AECP Timeouts";
+					case NetworkStatisticsModel::Column::AecpTimeoutsRate:
+						return "Timeouts/s";
+					case NetworkStatisticsModel::Column::AecpUnexpectedResponses:
+						return "Unexpected Responses";
+					case NetworkStatisticsModel::Column::AemAecpUnsolicitedResponses:
+						return "Unsolicited Responses";
+					case NetworkStatisticsModel::Column::ResponseTimeP50:
+						return "Response p50 (msec)";
+					case NetworkStatisticsModel::Column::ResponseTimeP95:
+						return "Response p95 (msec)";
+					case NetworkStatisticsModel::Column::ResponseTimeP99:
+						return "Response p99 (msec)";
+					default:
+						break;
+				}
+			}
+		}
+
+		return {};
+	}
+
+private:
+	struct EntityData
+	{
+		la::avdecc::UniqueIdentifier entityID{};
+		QString name{};
+		std::uint64_t aecpRetries{ 0u };
+		double aecpRetriesRate{ 0.0 };
+		std::uint64_t aecpTimeouts{ 0u };
+		double aecpTimeoutsRate{ 0.0 };
+		std::uint64_t aecpUnexpectedResponses{ 0u };
+		std::uint64_t aemAecpUnsolicitedResponses{ 0u };
+		std::uint64_t responseTimeCount{ 0u };
+		avdecc::LatencyHistogram::Duration responseTimeP50{};
+		avdecc::LatencyHistogram::Duration responseTimeP95{};
+		avdecc::LatencyHistogram::Duration responseTimeP99{};
+	};
+
+	using Entities = std::vector<EntityData>;
+	using EntityRowMap = std::unordered_map<la::avdecc::UniqueIdentifier, int, la::avdecc::UniqueIdentifier::hash>;
+
+	static QString rateToString(double const rate)
+	{
+		return QString::number(rate, 'f', 2);
+	}
+
+	static QString latencyToString(avdecc::LatencyHistogram::Duration const& latency, std::uint64_t const count)
+	{
+		if (count == 0u)
+		{
+			return "-";
+		}
+		return QString::number(static_cast<double>(latency.count()) / 1000.0, 'f', 1);
+	}
+
+	// avdecc::ControllerManager
+
+	void handleControllerOffline()
+	{
+		Q_Q(NetworkStatisticsModel);
+
+		q->beginResetModel();
+		_entities.clear();
+		_entityRowMap.clear();
+		q->endResetModel();
+	}
+
+	void handleEntityOnline(la::avdecc::UniqueIdentifier const& entityID)
+	{
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto controlledEntity = manager.getControlledEntity(entityID);
+		if (!controlledEntity || _entityRowMap.count(entityID) != 0)
+		{
+			return;
+		}
+
+		Q_Q(NetworkStatisticsModel);
+
+		// Insert at the end
+		auto const row = rowCount();
+		emit q->beginInsertRows({}, row, row);
+
+		auto data = EntityData{ entityID, avdecc::helper::smartEntityName(*controlledEntity) };
+		data.aecpRetries = controlledEntity->getAecpRetryCounter();
+		data.aecpTimeouts = controlledEntity->getAecpTimeoutCounter();
+		data.aecpUnexpectedResponses = controlledEntity->getAecpUnexpectedResponseCounter();
+		data.aemAecpUnsolicitedResponses = controlledEntity->getAemAecpUnsolicitedCounter();
+		computeStatistics(data);
+		_entities.push_back(std::move(data));
+
+		// Update the cache (only the new row)
+		updateEntityRowMap(row);
+
+		emit q->endInsertRows();
+	}
+
+	void handleEntityOffline(la::avdecc::UniqueIdentifier const& entityID)
+	{
+		if (auto const row = entityRow(entityID))
+		{
+			Q_Q(NetworkStatisticsModel);
+			emit q->beginRemoveRows({}, *row, *row);
+
+			// Remove the entity from the model (and the cache)
+			auto const it = std::next(std::begin(_entities), *row);
+			_entityRowMap.erase(it->entityID);
+			_entities.erase(it);
+
+			// Update the cache, only the rows after the removed one have moved
+			updateEntityRowMap(*row);
+
+			emit q->endRemoveRows();
+		}
+	}
+
+	void handleEntityNameChanged(la::avdecc::UniqueIdentifier const& entityID, QString const& entityName)
+	{
+		if (auto* data = entityData(entityID))
+		{
+			data->name = entityName;
+		}
+	}
+
+	// Computes the values derived from the ControllerManager history and histograms
+	void computeStatistics(EntityData& data) const
+	{
+		auto& manager = avdecc::ControllerManager::getInstance();
+		auto const now = avdecc::CounterHistory::Clock::now();
+
+		auto const histories = manager.getStatisticsCountersHistory(data.entityID);
+		auto const rate = [&histories, &now](auto const flag)
+		{
+			if (auto const it = histories.find(flag); it != histories.end())
+			{
+				return it->second.ratePerSecond(now, StatisticsRateWindow);
+			}
+			return 0.0;
+		};
+		data.aecpRetriesRate = rate(avdecc::ControllerManager::StatisticsErrorCounterFlag::AecpRetries);
+		data.aecpTimeoutsRate = rate(avdecc::ControllerManager::StatisticsErrorCounterFlag::AecpTimeouts);
+
+		auto const latencies = manager.getAecpCommandLatencies(data.entityID);
+		data.responseTimeCount = latencies.allCommands.count();
+		data.responseTimeP50 = latencies.allCommands.percentile(0.50);
+		data.responseTimeP95 = latencies.allCommands.percentile(0.95);
+		data.responseTimeP99 = latencies.allCommands.percentile(0.99);
+	}
+
+	// Refreshes all rows and notifies the views once for the whole table
+	void refreshStatistics()
+	{
+		if (_entities.empty())
+		{
+			return;
+		}
+
+		for (auto& data : _entities)
+		{
+			computeStatistics(data);
+		}
+
+		Q_Q(NetworkStatisticsModel);
+		emit q->dataChanged(createIndex(0, NetworkStatisticsModel::Column::Name), createIndex(rowCount() - 1, static_cast<NetworkStatisticsModel::Column>(columnCount() - 1)), { Qt::DisplayRole, NetworkStatisticsModel::SortRole });
+	}
+
+	// Update the entityID to row map, starting at the specified row (rows before it didn't move)
+	void updateEntityRowMap(int const fromRow)
+	{
+		for (auto row = fromRow; row < rowCount(); ++row)
+		{
+			auto const& data = _entities[row];
+			_entityRowMap[data.entityID] = row;
+		}
+	}
+
+	// Returns the entity row if found in the model
+	std::optional<int> entityRow(la::avdecc::UniqueIdentifier const& entityID) const
+	{
+		auto const it = _entityRowMap.find(entityID);
+		if (it != std::end(_entityRowMap))
+		{
+			return it->second;
+		}
+		return {};
+	}
+
+	// Returns the entity data if found in the model
+	EntityData* entityData(la::avdecc::UniqueIdentifier const& entityID)
+	{
+		if (auto const row = entityRow(entityID))
+		{
+			return &_entities[*row];
+		}
+		return nullptr;
+	}
+
+	QModelIndex createIndex(int const row, NetworkStatisticsModel::Column const column) const
+	{
+		Q_Q(const NetworkStatisticsModel);
+		return q->createIndex(row, la::avdecc::utils::to_integral(column));
+	}
+
+private:
+	NetworkStatisticsModel* const q_ptr{ nullptr };
+	Q_DECLARE_PUBLIC(NetworkStatisticsModel);
+
+	Entities _entities{};
+	EntityRowMap _entityRowMap{};
+	QTimer _refreshTimer{};
+};
+
+NetworkStatisticsModel::NetworkStatisticsModel(QObject* parent)
+	: QAbstractTableModel{ parent }
+	, d_ptr{ new NetworkStatisticsModelPrivate{ this } }
+{
+	// Initialize the model for each existing entity
+	auto& manager = avdecc::ControllerManager::getInstance();
+	manager.foreachEntity(
+		[this](la::avdecc::UniqueIdentifier const& entityID, la::avdecc::controller::ControlledEntity const&)
+		{
+			Q_D(NetworkStatisticsModel);
+			d->handleEntityOnline(entityID);
+		});
+}
+
+NetworkStatisticsModel::~NetworkStatisticsModel() = default;
+
+int NetworkStatisticsModel::rowCount(QModelIndex const&) const
+{
+	Q_D(const NetworkStatisticsModel);
+	return d->rowCount();
+}
+
+int NetworkStatisticsModel::columnCount(QModelIndex const&) const
+{
+	Q_D(const NetworkStatisticsModel);
+	return d->columnCount();
+}
+
+QVariant NetworkStatisticsModel::data(QModelIndex const& index, int role) const
+{
+	Q_D(const NetworkStatisticsModel);
+	return d->data(index, role);
+}
+
+QVariant NetworkStatisticsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+	Q_D(const NetworkStatisticsModel);
+	return d->headerData(section, orientation, role);
+}
+
+/***********************************************/
+
+NetworkStatisticsDialog::NetworkStatisticsDialog(QWidget* parent)
+	: QDialog{ parent, Qt::WindowSystemMenuHint | Qt::WindowTitleHint | Qt::WindowCloseButtonHint | Qt::WindowMaximizeButtonHint }
+	, _ui{ new Ui::NetworkStatisticsDialog }
+	, _model{ new NetworkStatisticsModel{ this } }
+{
+	_ui->setupUi(this);
+
+	setWindowTitle("Network Statistics");
+
+	_proxyModel.setSourceModel(_model);
+	_proxyModel.setSortRole(NetworkStatisticsModel::SortRole);
+	_proxyModel.setDynamicSortFilter(true);
+
+	auto* const view = _ui->statisticsTableView;
+	view->setModel(&_proxyModel);
+	view->setSortingEnabled(true);
+	view->sortByColumn(la::avdecc::utils::to_integral(NetworkStatisticsModel::Column::AecpTimeoutsRate), Qt::DescendingOrder);
+	view->setSelectionBehavior(QAbstractItemView::SelectRows);
+	view->setSelectionMode(QAbstractItemView::SingleSelection);
+	view->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+	view->verticalHeader()->setVisible(false);
+	view->horizontalHeader()->setStretchLastSection(true);
+
+	view->setColumnWidth(la::avdecc::utils::to_integral(NetworkStatisticsModel::Column::EntityID), defaults::ui::AdvancedView::ColumnWidth_UniqueIdentifier);
+	view->setColumnWidth(la::avdecc::utils::to_integral(NetworkStatisticsModel::Column::Name), defaults::ui::AdvancedView::ColumnWidth_Name);
+}
+
+NetworkStatisticsDialog::~NetworkStatisticsDialog()
+{
+	delete _ui;
+}
+
+#include "networkStatisticsDialog.moc"
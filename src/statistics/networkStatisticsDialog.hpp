@@ -0,0 +1,51 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QDialog>
+#include <QSortFilterProxyModel>
+
+namespace Ui
+{
+class NetworkStatisticsDialog;
+}
+
+class NetworkStatisticsModel;
+
+/** Statistics of all the entities on the network, in a sortable table */
+class NetworkStatisticsDialog : public QDialog
+{
+	Q_OBJECT
+
+public:
+	NetworkStatisticsDialog(QWidget* parent = nullptr);
+	~NetworkStatisticsDialog();
+
+	// Deleted compiler auto-generated methods
+	NetworkStatisticsDialog(NetworkStatisticsDialog&&) = delete;
+	NetworkStatisticsDialog(NetworkStatisticsDialog const&) = delete;
+	NetworkStatisticsDialog& operator=(NetworkStatisticsDialog const&) = delete;
+	NetworkStatisticsDialog& operator=(NetworkStatisticsDialog&&) = delete;
+
+private:
+	Ui::NetworkStatisticsDialog* _ui{ nullptr };
+	NetworkStatisticsModel* _model{ nullptr };
+	QSortFilterProxyModel _proxyModel{ this };
+};
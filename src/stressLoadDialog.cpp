@@ -0,0 +1,86 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "stressLoadDialog.hpp"
+
+#include <QFormLayout>
+
+#include <chrono>
+#include <limits>
+
+StressLoadDialog::StressLoadDialog(QWidget* parent)
+	: QDialog{ parent, Qt::WindowSystemMenuHint | Qt::WindowTitleHint | Qt::WindowCloseButtonHint }
+{
+	setWindowTitle("Stress Load");
+
+	auto const defaults = avdecc::stressLoad::Parameters{};
+
+	auto const setupRate = [](QDoubleSpinBox& spinBox, double const value)
+	{
+		spinBox.setRange(0.0, 10000.0);
+		spinBox.setDecimals(2);
+		spinBox.setSuffix(" /sec");
+		spinBox.setValue(value);
+	};
+	setupRate(_streamInputCounters, defaults.rates.streamInputCounters);
+	setupRate(_gptpChanges, defaults.rates.gptpChanges);
+	setupRate(_connectionToggles, defaults.rates.connectionToggles);
+	setupRate(_nameChanges, defaults.rates.nameChanges);
+	setupRate(_offlineOnlineCycles, defaults.rates.offlineOnlineCycles);
+
+	_offlineDuration.setRange(1, 3600);
+	_offlineDuration.setSuffix(" sec");
+	_offlineDuration.setValue(static_cast<int>(defaults.offlineDuration.count()));
+
+	_duration.setRange(0, 7 * 24 * 60);
+	_duration.setSuffix(" min");
+	_duration.setSpecialValueText("Until stopped");
+	_duration.setValue(static_cast<int>(std::chrono::duration_cast<std::chrono::minutes>(defaults.duration).count()));
+
+	_seed.setRange(0, std::numeric_limits<int>::max());
+	_seed.setValue(static_cast<int>(defaults.seed));
+
+	auto* const layout = new QFormLayout{ this };
+	layout->addRow("Stream input counters:", &_streamInputCounters);
+	layout->addRow("gPTP changes:", &_gptpChanges);
+	layout->addRow("Connection toggles:", &_connectionToggles);
+	layout->addRow("Name changes:", &_nameChanges);
+	layout->addRow("Offline/online cycles:", &_offlineOnlineCycles);
+	layout->addRow("Offline duration:", &_offlineDuration);
+	layout->addRow("Duration:", &_duration);
+	layout->addRow("Seed:", &_seed);
+	layout->addRow(&_buttons);
+
+	connect(&_buttons, &QDialogButtonBox::accepted, this, &QDialog::accept);
+	connect(&_buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+}
+
+avdecc::stressLoad::Parameters StressLoadDialog::parameters() const noexcept
+{
+	auto parameters = avdecc::stressLoad::Parameters{};
+	parameters.rates.streamInputCounters = _streamInputCounters.value();
+	parameters.rates.gptpChanges = _gptpChanges.value();
+	parameters.rates.connectionToggles = _connectionToggles.value();
+	parameters.rates.nameChanges = _nameChanges.value();
+	parameters.rates.offlineOnlineCycles = _offlineOnlineCycles.value();
+	parameters.offlineDuration = std::chrono::seconds{ _offlineDuration.value() };
+	parameters.duration = std::chrono::minutes{ _duration.value() };
+	parameters.seed = static_cast<std::uint32_t>(_seed.value());
+	return parameters;
+}
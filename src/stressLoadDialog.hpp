@@ -0,0 +1,55 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QDialog>
+#include <QDoubleSpinBox>
+#include <QSpinBox>
+#include <QDialogButtonBox>
+
+#include "avdecc/stressLoad.hpp"
+
+/** Rates and duration of a stress load, to drive the online (virtual) entities through a synthetic churn */
+class StressLoadDialog : public QDialog
+{
+	Q_OBJECT
+
+public:
+	StressLoadDialog(QWidget* parent = nullptr);
+
+	avdecc::stressLoad::Parameters parameters() const noexcept;
+
+	// Deleted compiler auto-generated methods
+	StressLoadDialog(StressLoadDialog&&) = delete;
+	StressLoadDialog(StressLoadDialog const&) = delete;
+	StressLoadDialog& operator=(StressLoadDialog const&) = delete;
+	StressLoadDialog& operator=(StressLoadDialog&&) = delete;
+
+private:
+	QDoubleSpinBox _streamInputCounters{ this };
+	QDoubleSpinBox _gptpChanges{ this };
+	QDoubleSpinBox _connectionToggles{ this };
+	QDoubleSpinBox _nameChanges{ this };
+	QDoubleSpinBox _offlineOnlineCycles{ this };
+	QSpinBox _offlineDuration{ this };
+	QSpinBox _duration{ this };
+	QSpinBox _seed{ this };
+	QDialogButtonBox _buttons{ QDialogButtonBox::Ok | QDialogButtonBox::Cancel, this };
+};
@@ -0,0 +1,102 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "styleSheetCache.hpp"
+#include "toolkit/material/color.hpp"
+#include "toolkit/material/colorPalette.hpp"
+
+#include <QApplication>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QStandardPaths>
+
+namespace styleSheetCache
+{
+namespace
+{
+QString substitute(int const themeColorIndex, QByteArray const& source) noexcept
+{
+	auto const colorName = qt::toolkit::material::color::Palette::name(themeColorIndex);
+	auto const baseBackgroundColor = qt::toolkit::material::color::value(colorName);
+	auto const baseForegroundColor = QColor{ qt::toolkit::material::color::luminance(colorName) == qt::toolkit::material::color::Luminance::Dark ? Qt::white : Qt::black };
+	auto const connectionMatrixBackgroundColor = qt::toolkit::material::color::value(colorName, qt::toolkit::material::color::Shade::Shade100);
+
+	return QString{ source }.arg(baseBackgroundColor.name()).arg(baseForegroundColor.name()).arg(connectionMatrixBackgroundColor.name());
+}
+
+QString cacheFilePath(int const themeColorIndex, QByteArray const& source) noexcept
+{
+	// Keyed by the source content, so a modified stylesheet is never read from a stale cache
+	auto const sourceHash = QCryptographicHash::hash(source, QCryptographicHash::Sha1).toHex();
+	return QString{ "%1/styleSheets/%2-%3.qss" }.arg(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).arg(QString{ sourceHash }).arg(themeColorIndex);
+}
+} // namespace
+
+QString get(int const themeColorIndex, QString const& filename) noexcept
+{
+	auto sourceFile = QFile{ filename };
+	if (!sourceFile.open(QFile::ReadOnly))
+	{
+		return {};
+	}
+	auto const source = sourceFile.readAll();
+
+	// Memory cache
+	static auto s_styleSheets = QHash<QString, QString>{};
+	auto const cachePath = cacheFilePath(themeColorIndex, source);
+	if (auto const it = s_styleSheets.constFind(cachePath); it != s_styleSheets.constEnd())
+	{
+		return *it;
+	}
+
+	// Disk cache
+	auto styleSheet = QString{};
+	auto cacheFile = QFile{ cachePath };
+	if (cacheFile.open(QFile::ReadOnly))
+	{
+		styleSheet = QString::fromUtf8(cacheFile.readAll());
+	}
+	else
+	{
+		styleSheet = substitute(themeColorIndex, source);
+		if (QDir{}.mkpath(QFileInfo{ cachePath }.absolutePath()) && cacheFile.open(QFile::WriteOnly | QFile::Truncate))
+		{
+			cacheFile.write(styleSheet.toUtf8());
+		}
+	}
+
+	s_styleSheets.insert(cachePath, styleSheet);
+	return styleSheet;
+}
+
+void apply(int const themeColorIndex, QString const& filename) noexcept
+{
+	auto const styleSheet = get(themeColorIndex, filename);
+
+	// Setting the same stylesheet would still repolish all the widgets
+	if (!styleSheet.isEmpty() && styleSheet != qApp->styleSheet())
+	{
+		qApp->setStyleSheet(styleSheet);
+	}
+}
+
+} // namespace styleSheetCache
@@ -0,0 +1,37 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QString>
+
+/**
+* Application stylesheet, substituted with the colors of a theme (General_ThemeColorIndex).
+* The substituted stylesheets are kept in memory and in a disk cache (keyed by the source content), and only applied when they differ from the current one,
+* as applying a stylesheet repolishes every widget.
+*/
+namespace styleSheetCache
+{
+/** Returns the stylesheet of the theme, substituted from the source file (from the caches, unless the source changed) */
+QString get(int const themeColorIndex, QString const& filename = ":/style.qss") noexcept;
+
+/** Applies the stylesheet of the theme application-wide, if not already applied. Should be called before creating the widgets, so they are only polished once. */
+void apply(int const themeColorIndex, QString const& filename = ":/style.qss") noexcept;
+
+} // namespace styleSheetCache
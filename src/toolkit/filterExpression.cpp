@@ -0,0 +1,237 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "toolkit/filterExpression.hpp"
+
+#include <QRegularExpression>
+
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace qt
+{
+namespace toolkit
+{
+/** Maximum number of cached expressions, the cache is cleared when reached (a few views times the patterns typed in a session) */
+static constexpr auto MaxCachedExpressions = std::size_t{ 256u };
+
+struct FilterExpression::Compiled
+{
+	Kind kind{ Kind::Empty };
+	QString pattern{};
+	Qt::CaseSensitivity caseSensitivity{ Qt::CaseInsensitive };
+	QString text{};
+	QRegularExpression regularExpression{};
+};
+
+static bool hasRegularExpressionSyntax(QString const& text) noexcept
+{
+	static auto const s_metaCharacters = QString{ "\\^$.|?*+()[]{}" };
+
+	for (auto const c : text)
+	{
+		if (s_metaCharacters.contains(c))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+static std::shared_ptr<FilterExpression::Compiled const> makeCompiled(QString const& pattern, Qt::CaseSensitivity const caseSensitivity) noexcept
+{
+	auto compiled = std::make_shared<FilterExpression::Compiled>();
+	compiled->pattern = pattern;
+	compiled->caseSensitivity = caseSensitivity;
+
+	if (pattern.isEmpty())
+	{
+		compiled->kind = FilterExpression::Kind::Empty;
+	}
+	else if (!hasRegularExpressionSyntax(pattern))
+	{
+		compiled->kind = FilterExpression::Kind::Literal;
+		compiled->text = pattern;
+	}
+	else if (pattern.size() > 1 && pattern.startsWith('^') && !hasRegularExpressionSyntax(pattern.mid(1)))
+	{
+		compiled->kind = FilterExpression::Kind::Prefix;
+		compiled->text = pattern.mid(1);
+	}
+	else
+	{
+		auto const options = caseSensitivity == Qt::CaseInsensitive ? QRegularExpression::CaseInsensitiveOption : QRegularExpression::NoPatternOption;
+		compiled->regularExpression = QRegularExpression{ pattern, options };
+		if (compiled->regularExpression.isValid())
+		{
+			compiled->kind = FilterExpression::Kind::RegularExpression;
+			// Compile (and JIT) now rather than on the first match, which may happen in a worker thread
+			compiled->regularExpression.optimize();
+		}
+		else
+		{
+			compiled->kind = FilterExpression::Kind::Invalid;
+		}
+	}
+
+	return compiled;
+}
+
+FilterExpression FilterExpression::compile(QString const& pattern, Qt::CaseSensitivity const caseSensitivity) noexcept
+{
+	if (pattern.isEmpty())
+	{
+		return FilterExpression{};
+	}
+
+	struct KeyHash
+	{
+		std::size_t operator()(std::pair<QString, Qt::CaseSensitivity> const& key) const noexcept
+		{
+			return static_cast<std::size_t>(qHash(key.first)) ^ static_cast<std::size_t>(key.second);
+		}
+	};
+	static auto s_mutex = std::mutex{};
+	static auto s_cache = std::unordered_map<std::pair<QString, Qt::CaseSensitivity>, std::shared_ptr<Compiled const>, KeyHash>{};
+
+	auto const key = std::make_pair(pattern, caseSensitivity);
+	auto const lg = std::lock_guard{ s_mutex };
+
+	if (auto const it = s_cache.find(key); it != s_cache.end())
+	{
+		return FilterExpression{ it->second };
+	}
+
+	if (s_cache.size() >= MaxCachedExpressions)
+	{
+		s_cache.clear();
+	}
+
+	auto compiled = makeCompiled(pattern, caseSensitivity);
+	s_cache.emplace(key, compiled);
+	return FilterExpression{ compiled };
+}
+
+FilterExpression FilterExpression::anyOf(QStringList const& texts, Qt::CaseSensitivity const caseSensitivity) noexcept
+{
+	if (texts.isEmpty())
+	{
+		return FilterExpression{};
+	}
+
+	auto escaped = QStringList{};
+	for (auto const& text : texts)
+	{
+		escaped << QRegularExpression::escape(text);
+	}
+	return compile("^(" + escaped.join('|') + ")$", caseSensitivity);
+}
+
+FilterExpression::FilterExpression() noexcept
+{
+	// All the empty expressions share the same compiled form
+	static auto const s_empty = makeCompiled({}, Qt::CaseInsensitive);
+	_compiled = s_empty;
+}
+
+FilterExpression::FilterExpression(std::shared_ptr<Compiled const> const& compiled) noexcept
+	: _compiled{ compiled }
+{
+}
+
+FilterExpression::Kind FilterExpression::kind() const noexcept
+{
+	return _compiled->kind;
+}
+
+QString const& FilterExpression::pattern() const noexcept
+{
+	return _compiled->pattern;
+}
+
+Qt::CaseSensitivity FilterExpression::caseSensitivity() const noexcept
+{
+	return _compiled->caseSensitivity;
+}
+
+QString const& FilterExpression::text() const noexcept
+{
+	return _compiled->text;
+}
+
+bool FilterExpression::matches(QString const& text) const noexcept
+{
+	switch (_compiled->kind)
+	{
+		case Kind::Empty:
+			return true;
+		case Kind::Literal:
+			return text.contains(_compiled->text, _compiled->caseSensitivity);
+		case Kind::Prefix:
+			return text.startsWith(_compiled->text, _compiled->caseSensitivity);
+		case Kind::RegularExpression:
+			return _compiled->regularExpression.match(text).hasMatch();
+		default:
+			return false;
+	}
+}
+
+bool FilterExpression::operator==(FilterExpression const& other) const noexcept
+{
+	return _compiled == other._compiled || (_compiled->pattern == other._compiled->pattern && _compiled->caseSensitivity == other._compiled->caseSensitivity);
+}
+
+FilterExpressionDebouncer::FilterExpressionDebouncer(QObject* parent, std::chrono::milliseconds const interval, Qt::CaseSensitivity const caseSensitivity)
+	: QObject{ parent }
+	, _caseSensitivity{ caseSensitivity }
+{
+	_timer.setSingleShot(true);
+	_timer.setInterval(interval);
+	connect(&_timer, &QTimer::timeout, this, &FilterExpressionDebouncer::flush);
+}
+
+void FilterExpressionDebouncer::setPattern(QString const& pattern) noexcept
+{
+	_pendingPattern = pattern;
+	_hasPendingPattern = true;
+
+	// Restarted on each keystroke
+	_timer.start();
+}
+
+void FilterExpressionDebouncer::flush() noexcept
+{
+	_timer.stop();
+	if (!_hasPendingPattern)
+	{
+		return;
+	}
+	_hasPendingPattern = false;
+
+	auto expression = FilterExpression::compile(_pendingPattern, _caseSensitivity);
+	if (expression != _expression)
+	{
+		_expression = std::move(expression);
+		emit expressionChanged(_expression);
+	}
+}
+
+} // namespace toolkit
+} // namespace qt
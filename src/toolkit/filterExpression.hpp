@@ -0,0 +1,133 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+#include <chrono>
+#include <memory>
+
+namespace qt
+{
+namespace toolkit
+{
+/**
+* @brief Filter pattern typed by the user, classified and compiled once.
+* @details A pattern without any regular expression syntax is a Literal (matched with QString::contains), the same text preceded by '^' is a Prefix
+*          (matched with QString::startsWith), anything else is compiled as a QRegularExpression (JIT optimized). Compiled expressions are cached
+*          per pattern, so typing back a previous pattern or applying the same filter to several views does not compile it again.
+*          An invalid regular expression matches nothing. Copies share the compiled form, matching is thread-safe.
+*/
+class FilterExpression final
+{
+public:
+	enum class Kind
+	{
+		Empty, // Matches everything
+		Literal,
+		Prefix,
+		RegularExpression,
+		Invalid, // Matches nothing
+	};
+
+	/** Returns the (cached) expression for the pattern */
+	static FilterExpression compile(QString const& pattern, Qt::CaseSensitivity const caseSensitivity = Qt::CaseInsensitive) noexcept;
+
+	/** Returns an expression matching any of the texts exactly (escaped as needed), Empty if texts is empty */
+	static FilterExpression anyOf(QStringList const& texts, Qt::CaseSensitivity const caseSensitivity = Qt::CaseInsensitive) noexcept;
+
+	/** Empty expression */
+	FilterExpression() noexcept;
+
+	Kind kind() const noexcept;
+	QString const& pattern() const noexcept;
+	Qt::CaseSensitivity caseSensitivity() const noexcept;
+
+	/** Text matched by a Literal or Prefix expression (without the '^'), empty otherwise */
+	QString const& text() const noexcept;
+
+	bool isEmpty() const noexcept
+	{
+		return kind() == Kind::Empty;
+	}
+
+	/** True for the kinds matched without a regular expression engine (Literal and Prefix) */
+	bool isPlainText() const noexcept
+	{
+		return kind() == Kind::Literal || kind() == Kind::Prefix;
+	}
+
+	bool matches(QString const& text) const noexcept;
+
+	bool operator==(FilterExpression const& other) const noexcept;
+	bool operator!=(FilterExpression const& other) const noexcept
+	{
+		return !operator==(other);
+	}
+
+	// Defaulted compiler auto-generated methods
+	FilterExpression(FilterExpression&&) = default;
+	FilterExpression(FilterExpression const&) = default;
+	FilterExpression& operator=(FilterExpression const&) = default;
+	FilterExpression& operator=(FilterExpression&&) = default;
+
+	struct Compiled;
+
+private:
+	explicit FilterExpression(std::shared_ptr<Compiled const> const& compiled) noexcept;
+
+	std::shared_ptr<Compiled const> _compiled{};
+};
+
+/**
+* @brief Compiles the patterns typed by the user once the typing paused, so a filter is not applied on each keystroke.
+* @details expressionChanged is only emitted when the resulting expression differs from the previous one. flush() applies the pending pattern immediately.
+*/
+class FilterExpressionDebouncer : public QObject
+{
+	Q_OBJECT
+public:
+	static constexpr auto DefaultInterval = std::chrono::milliseconds{ 150 };
+
+	FilterExpressionDebouncer(QObject* parent = nullptr, std::chrono::milliseconds const interval = DefaultInterval, Qt::CaseSensitivity const caseSensitivity = Qt::CaseInsensitive);
+
+	void setPattern(QString const& pattern) noexcept;
+	void flush() noexcept;
+
+	FilterExpression const& expression() const noexcept
+	{
+		return _expression;
+	}
+
+	Q_SIGNAL void expressionChanged(qt::toolkit::FilterExpression const& expression);
+
+private:
+	QTimer _timer{};
+	QString _pendingPattern{};
+	bool _hasPendingPattern{ false };
+	Qt::CaseSensitivity const _caseSensitivity{ Qt::CaseInsensitive };
+	FilterExpression _expression{};
+};
+
+} // namespace toolkit
+} // namespace qt
@@ -0,0 +1,131 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "hub.hpp"
+#include "linkSet.hpp"
+#include "type.hpp"
+
+#include <QPainter>
+
+namespace graph
+{
+float const HUB_PADDING = 6.f;
+
+HubItem::HubItem(Kind const kind, QString const& text, QGraphicsItem* parent)
+	: QGraphicsItem(parent)
+	, _kind(kind)
+	, _text(text)
+{
+	setFlag(QGraphicsItem::ItemIsMovable);
+	setFlag(QGraphicsItem::ItemIsSelectable);
+	setFlag(QGraphicsItem::ItemSendsGeometryChanges);
+
+	// Text layout is the expensive part, only redo it when the hub itself changes
+	setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+
+	updateGeometry();
+}
+
+int HubItem::type() const
+{
+	return ItemType::Hub;
+}
+
+void HubItem::setKind(Kind const kind)
+{
+	if (kind != _kind)
+	{
+		_kind = kind;
+		update();
+	}
+}
+
+HubItem::Kind HubItem::kind() const
+{
+	return _kind;
+}
+
+void HubItem::setText(QString const& text)
+{
+	if (text != _text)
+	{
+		_text = text;
+		updateGeometry();
+	}
+}
+
+QString const& HubItem::text() const
+{
+	return _text;
+}
+
+void HubItem::setLinkSet(LinkSetItem* linkSet)
+{
+	_linkSet = linkSet;
+}
+
+QRectF HubItem::boundingRect() const
+{
+	return _rect;
+}
+
+void HubItem::paint(QPainter* painter, QStyleOptionGraphicsItem const* /*option*/, QWidget* /*widget*/)
+{
+	auto const color = _kind == Kind::Endpoint ? HubEndpointColor : NodeItemColor;
+
+	painter->setPen(isSelected() ? QPen{ TextColor, 2 } : QPen{ Qt::NoPen });
+	painter->setBrush(color);
+
+	// Bridges are boxes, endpoints are pills
+	auto const radius = _kind == Kind::Endpoint ? _rect.height() / 2 : 3.0;
+	painter->drawRoundedRect(_rect.adjusted(1, 1, -1, -1), radius, radius);
+
+	painter->setPen(TextColor);
+	painter->drawText(_rect, Qt::AlignHCenter | Qt::AlignVCenter, _text);
+}
+
+QVariant HubItem::itemChange(GraphicsItemChange change, QVariant const& value)
+{
+	if (change == QGraphicsItem::ItemSelectedChange)
+	{
+		setZValue(value.toBool() ? 1 : 0);
+	}
+
+	if (change == QGraphicsItem::ItemPositionHasChanged && _linkSet)
+	{
+		_linkSet->updateGeometry();
+	}
+
+	return QGraphicsItem::itemChange(change, value);
+}
+
+void HubItem::updateGeometry()
+{
+	prepareGeometryChange();
+
+	QFont font;
+	QFontMetrics fm(font);
+	auto const textRect = fm.boundingRect(QRect{}, Qt::AlignHCenter | Qt::AlignVCenter, _text);
+
+	auto const width = textRect.width() + HUB_PADDING * 4;
+	auto const height = textRect.height() + HUB_PADDING * 2;
+	_rect = QRectF{ -width / 2, -height / 2, width, height };
+}
+
+} // namespace graph
@@ -0,0 +1,65 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QGraphicsItem>
+
+namespace graph
+{
+class LinkSetItem;
+
+/** Compact node without any socket, linked to other hubs through a LinkSetItem. Positioned by its center. */
+class HubItem : public QGraphicsItem
+{
+public:
+	enum class Kind
+	{
+		Bridge,
+		Endpoint,
+	};
+
+	HubItem(Kind const kind, QString const& text, QGraphicsItem* parent = nullptr);
+
+	virtual int type() const override;
+
+	void setKind(Kind const kind);
+	Kind kind() const;
+
+	void setText(QString const& text);
+	QString const& text() const;
+
+	// The link set is notified each time the hub moves
+	void setLinkSet(LinkSetItem* linkSet);
+
+	virtual QRectF boundingRect() const override;
+
+private:
+	virtual void paint(QPainter* painter, QStyleOptionGraphicsItem const* option, QWidget* widget) override;
+	virtual QVariant itemChange(GraphicsItemChange change, QVariant const& value) override;
+	void updateGeometry();
+
+private:
+	Kind _kind{ Kind::Bridge };
+	QString _text{};
+	QRectF _rect{};
+	LinkSetItem* _linkSet{ nullptr };
+};
+
+} // namespace graph
@@ -0,0 +1,128 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "linkSet.hpp"
+#include "hub.hpp"
+#include "type.hpp"
+
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QVector>
+
+namespace graph
+{
+LinkSetItem::LinkSetItem(QGraphicsItem* parent)
+	: QGraphicsItem(parent)
+{
+	setZValue(-1);
+
+	// Only the links crossing the exposed area are painted
+	setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
+int LinkSetItem::type() const
+{
+	return ItemType::LinkSet;
+}
+
+LinkSetItem::Link LinkSetItem::makeLink(HubItem* a, HubItem* b)
+{
+	return a < b ? Link{ a, b } : Link{ b, a };
+}
+
+void LinkSetItem::addLink(HubItem* a, HubItem* b)
+{
+	if (_links.insert(makeLink(a, b)).second)
+	{
+		updateGeometry();
+	}
+}
+
+void LinkSetItem::removeLink(HubItem* a, HubItem* b)
+{
+	if (_links.erase(makeLink(a, b)) > 0)
+	{
+		updateGeometry();
+	}
+}
+
+void LinkSetItem::removeHub(HubItem* hub)
+{
+	auto removed = false;
+	for (auto it = _links.begin(); it != _links.end();)
+	{
+		if (it->first == hub || it->second == hub)
+		{
+			it = _links.erase(it);
+			removed = true;
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	if (removed)
+	{
+		updateGeometry();
+	}
+}
+
+void LinkSetItem::updateGeometry()
+{
+	// Bounds are computed lazily, a layout pass moves many hubs at once
+	prepareGeometryChange();
+	_boundsDirty = true;
+}
+
+QRectF LinkSetItem::boundingRect() const
+{
+	if (_boundsDirty)
+	{
+		_bounds = QRectF{};
+		for (auto const& [a, b] : _links)
+		{
+			_bounds |= QRectF{ a->pos(), b->pos() }.normalized();
+		}
+		_bounds.adjust(-2, -2, 2, 2);
+		_boundsDirty = false;
+	}
+	return _bounds;
+}
+
+void LinkSetItem::paint(QPainter* painter, QStyleOptionGraphicsItem const* option, QWidget* /*widget*/)
+{
+	auto const& exposedRect = option->exposedRect;
+
+	auto lines = QVector<QLineF>{};
+	lines.reserve(static_cast<int>(_links.size()));
+	for (auto const& [a, b] : _links)
+	{
+		auto const line = QLineF{ a->pos(), b->pos() };
+		if (exposedRect.intersects(QRectF{ line.p1(), line.p2() }.normalized().adjusted(-1, -1, 1, 1)))
+		{
+			lines.append(line);
+		}
+	}
+
+	painter->setPen(QPen{ LinkColor, 2 });
+	painter->drawLines(lines);
+}
+
+} // namespace graph
@@ -0,0 +1,61 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QGraphicsItem>
+
+#include <set>
+#include <utility>
+
+namespace graph
+{
+class HubItem;
+
+/** All the links between hubs, painted by a single item so large graphs don't need one item per link */
+class LinkSetItem : public QGraphicsItem
+{
+public:
+	LinkSetItem(QGraphicsItem* parent = nullptr);
+
+	virtual int type() const override;
+
+	void addLink(HubItem* a, HubItem* b);
+	void removeLink(HubItem* a, HubItem* b);
+	// Removes all the links of a hub
+	void removeHub(HubItem* hub);
+
+	// To be called when a hub moved
+	void updateGeometry();
+
+	virtual QRectF boundingRect() const override;
+
+private:
+	virtual void paint(QPainter* painter, QStyleOptionGraphicsItem const* option, QWidget* widget) override;
+
+private:
+	using Link = std::pair<HubItem*, HubItem*>;
+	static Link makeLink(HubItem* a, HubItem* b);
+
+	std::set<Link> _links{};
+	mutable QRectF _bounds{};
+	mutable bool _boundsDirty{ true };
+};
+
+} // namespace graph
@@ -29,11 +29,15 @@ enum ItemType
 	Input,
 	Output,
 	Connection,
+	Hub,
+	LinkSet,
 };
 
 const QColor TextColor{ "#FFFFFF" };
 const QColor NodeItemColor{ "#3C3C3C" };
 const QColor InputSocketColor{ "#2196F3" };
 const QColor OutputSocketColor{ "#4CAF50" };
+const QColor HubEndpointColor{ "#1976D2" };
+const QColor LinkColor{ "#9E9E9E" };
 
 } // namespace graph
@@ -24,6 +24,7 @@
 #include "type.hpp"
 
 #include <QMouseEvent>
+#include <QWheelEvent>
 
 namespace graph
 {
@@ -38,6 +39,11 @@ GraphicsView::GraphicsView(QWidget* parent)
 	setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing | QPainter::HighQualityAntialiasing | QPainter::SmoothPixmapTransform);
 }
 
+void GraphicsView::setZoomEnabled(bool const enabled)
+{
+	_zoomEnabled = enabled;
+}
+
 void GraphicsView::mousePressEvent(QMouseEvent* event)
 {
 	auto* item = socketAt(event->pos());
@@ -241,6 +247,19 @@ void GraphicsView::mouseReleaseEvent(QMouseEvent* event)
 	QGraphicsView::mouseReleaseEvent(event);
 }
 
+void GraphicsView::wheelEvent(QWheelEvent* event)
+{
+	if (_zoomEnabled && event->angleDelta().y() != 0)
+	{
+		auto const factor = event->angleDelta().y() > 0 ? 1.15 : 1.0 / 1.15;
+		scale(factor, factor);
+		event->accept();
+		return;
+	}
+
+	QGraphicsView::wheelEvent(event);
+}
+
 bool GraphicsView::acceptableConnection(SocketItem* item) const
 {
 	if (!item || !_connectionDragEvent)
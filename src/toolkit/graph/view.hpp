@@ -49,6 +49,9 @@ class GraphicsView : public QGraphicsView
 public:
 	GraphicsView(QWidget* parent = nullptr);
 
+	// Mouse wheel zooms the view instead of scrolling it (default false)
+	void setZoomEnabled(bool const enabled);
+
 	Q_SIGNAL void connectionCreated(ConnectionItem* connection);
 	Q_SIGNAL void connectionDeleted(ConnectionItem* connection);
 
@@ -56,6 +59,7 @@ private:
 	virtual void mousePressEvent(QMouseEvent* event) override;
 	virtual void mouseMoveEvent(QMouseEvent* event) override;
 	virtual void mouseReleaseEvent(QMouseEvent* event) override;
+	virtual void wheelEvent(QWheelEvent* event) override;
 
 private:
 	bool acceptableConnection(SocketItem* item) const;
@@ -63,6 +67,7 @@ private:
 
 private:
 	std::unique_ptr<ConnectionDragEvent> _connectionDragEvent{};
+	bool _zoomEnabled{ false };
 };
 
 } // namespace graph
@@ -21,7 +21,9 @@
 
 #include <la/avdecc/utils.hpp>
 
-#include <unordered_map>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
 
 namespace qt
 {
@@ -31,529 +33,380 @@ namespace material
 {
 namespace color
 {
+static constexpr auto NameCount = static_cast<std::size_t>(Name::NameCount);
+static constexpr auto ShadeCount = static_cast<std::size_t>(Shade::ShadeCount);
+
 struct ColorData
 {
-	QColor value; // The actual color value
+	QRgb value; // The actual color value
 	Luminance luminance; // The associated luminance
 };
 
-using ShadeMap = std::unordered_map<Shade, ColorData>;
-using ColorMap = std::unordered_map<Name, ShadeMap>;
+// Indexed by Name then Shade, so a lookup is a single array access
+static constexpr std::array<std::array<ColorData, ShadeCount>, NameCount> s_colors = { {
+	// Red
+	{ {
+		{ 0xFFEBEE, Luminance::Light }, // Shade50
+		{ 0xFFCDD2, Luminance::Light }, // Shade100
+		{ 0xEF9A9A, Luminance::Light }, // Shade200
+		{ 0xE57373, Luminance::Light }, // Shade300
+		{ 0xEF5350, Luminance::Dark }, // Shade400
+		{ 0xF44336, Luminance::Dark }, // Shade500
+		{ 0xE53935, Luminance::Dark }, // Shade600
+		{ 0xD32F2F, Luminance::Dark }, // Shade700
+		{ 0xC62828, Luminance::Dark }, // Shade800
+		{ 0xB71C1C, Luminance::Dark }, // Shade900
+		{ 0xFF8A80, Luminance::Light }, // ShadeA100
+		{ 0xFF5252, Luminance::Dark }, // ShadeA200
+		{ 0xFF1744, Luminance::Dark }, // ShadeA400
+		{ 0xD50000, Luminance::Dark }, // ShadeA700
+	} },
+	// Pink
+	{ {
+		{ 0xFCE4EC, Luminance::Light }, // Shade50
+		{ 0xF8BBD0, Luminance::Light }, // Shade100
+		{ 0xF48FB1, Luminance::Light }, // Shade200
+		{ 0xF06292, Luminance::Light }, // Shade300
+		{ 0xEC407A, Luminance::Dark }, // Shade400
+		{ 0xE91E63, Luminance::Dark }, // Shade500
+		{ 0xD81B60, Luminance::Dark }, // Shade600
+		{ 0xC2185B, Luminance::Dark }, // Shade700
+		{ 0xAD1457, Luminance::Dark }, // Shade800
+		{ 0x880E4F, Luminance::Dark }, // Shade900
+		{ 0xFF80AB, Luminance::Light }, // ShadeA100
+		{ 0xFF4081, Luminance::Dark }, // ShadeA200
+		{ 0xF50057, Luminance::Dark }, // ShadeA400
+		{ 0xC51162, Luminance::Dark }, // ShadeA700
+	} },
+	// Purple
+	{ {
+		{ 0xF3E5F5, Luminance::Light }, // Shade50
+		{ 0xE1BEE7, Luminance::Light }, // Shade100
+		{ 0xCE93D8, Luminance::Light }, // Shade200
+		{ 0xBA68C8, Luminance::Dark }, // Shade300
+		{ 0xAB47BC, Luminance::Dark }, // Shade400
+		{ 0x9C27B0, Luminance::Dark }, // Shade500
+		{ 0x8E24AA, Luminance::Dark }, // Shade600
+		{ 0x7B1FA2, Luminance::Dark }, // Shade700
+		{ 0x6A1B9A, Luminance::Dark }, // Shade800
+		{ 0x4A148C, Luminance::Dark }, // Shade900
+		{ 0xEA80FC, Luminance::Light }, // ShadeA100
+		{ 0xE040FB, Luminance::Dark }, // ShadeA200
+		{ 0xD500F9, Luminance::Dark }, // ShadeA400
+		{ 0xAA00FF, Luminance::Dark }, // ShadeA700
+	} },
+	// DeepPurple
+	{ {
+		{ 0xEDE7F6, Luminance::Light }, // Shade50
+		{ 0xD1C4E9, Luminance::Light }, // Shade100
+		{ 0xB39DDB, Luminance::Light }, // Shade200
+		{ 0x9575CD, Luminance::Dark }, // Shade300
+		{ 0x7E57C2, Luminance::Dark }, // Shade400
+		{ 0x673AB7, Luminance::Dark }, // Shade500
+		{ 0x5E35B1, Luminance::Dark }, // Shade600
+		{ 0x512DA8, Luminance::Dark }, // Shade700
+		{ 0x4527A0, Luminance::Dark }, // Shade800
+		{ 0x311B92, Luminance::Dark }, // Shade900
+		{ 0xB388FF, Luminance::Light }, // ShadeA100
+		{ 0x7C4DFF, Luminance::Dark }, // ShadeA200
+		{ 0x651FFF, Luminance::Dark }, // ShadeA400
+		{ 0x6200EA, Luminance::Dark }, // ShadeA700
+	} },
+	// Indigo
+	{ {
+		{ 0xE8EAF6, Luminance::Light }, // Shade50
+		{ 0xC5CAE9, Luminance::Light }, // Shade100
+		{ 0x9FA8DA, Luminance::Light }, // Shade200
+		{ 0x7986CB, Luminance::Dark }, // Shade300
+		{ 0x5C6BC0, Luminance::Dark }, // Shade400
+		{ 0x3F51B5, Luminance::Dark }, // Shade500
+		{ 0x3949AB, Luminance::Dark }, // Shade600
+		{ 0x303F9F, Luminance::Dark }, // Shade700
+		{ 0x283593, Luminance::Dark }, // Shade800
+		{ 0x1A237E, Luminance::Dark }, // Shade900
+		{ 0x8C9EFF, Luminance::Light }, // ShadeA100
+		{ 0x536DFE, Luminance::Dark }, // ShadeA200
+		{ 0x3D5AFE, Luminance::Dark }, // ShadeA400
+		{ 0x304FFE, Luminance::Dark }, // ShadeA700
+	} },
+	// Blue
+	{ {
+		{ 0xE3F2FD, Luminance::Light }, // Shade50
+		{ 0xBBDEFB, Luminance::Light }, // Shade100
+		{ 0x90CAF9, Luminance::Light }, // Shade200
+		{ 0x64B5F6, Luminance::Light }, // Shade300
+		{ 0x42A5F5, Luminance::Light }, // Shade400
+		{ 0x2196F3, Luminance::Light }, // Shade500
+		{ 0x1E88E5, Luminance::Dark }, // Shade600
+		{ 0x1976D2, Luminance::Dark }, // Shade700
+		{ 0x1565C0, Luminance::Dark }, // Shade800
+		{ 0x0D47A1, Luminance::Dark }, // Shade900
+		{ 0x82B1FF, Luminance::Light }, // ShadeA100
+		{ 0x448AFF, Luminance::Dark }, // ShadeA200
+		{ 0x2979FF, Luminance::Dark }, // ShadeA400
+		{ 0x2962FF, Luminance::Dark }, // ShadeA700
+	} },
+	// LightBlue
+	{ {
+		{ 0xE1F5FE, Luminance::Light }, // Shade50
+		{ 0xB3E5FC, Luminance::Light }, // Shade100
+		{ 0x81D4FA, Luminance::Light }, // Shade200
+		{ 0x4FC3F7, Luminance::Light }, // Shade300
+		{ 0x29B6F6, Luminance::Light }, // Shade400
+		{ 0x03A9F4, Luminance::Light }, // Shade500
+		{ 0x039BE5, Luminance::Light }, // Shade600
+		{ 0x0288D1, Luminance::Dark }, // Shade700
+		{ 0x0277BD, Luminance::Dark }, // Shade800
+		{ 0x01579B, Luminance::Dark }, // Shade900
+		{ 0x80D8FF, Luminance::Light }, // ShadeA100
+		{ 0x40C4FF, Luminance::Light }, // ShadeA200
+		{ 0x00B0FF, Luminance::Light }, // ShadeA400
+		{ 0x0091EA, Luminance::Dark }, // ShadeA700
+	} },
+	// Cyan
+	{ {
+		{ 0xE0F7FA, Luminance::Light }, // Shade50
+		{ 0xB2EBF2, Luminance::Light }, // Shade100
+		{ 0x80DEEA, Luminance::Light }, // Shade200
+		{ 0x4DD0E1, Luminance::Light }, // Shade300
+		{ 0x26C6DA, Luminance::Light }, // Shade400
+		{ 0x00BCD4, Luminance::Light }, // Shade500
+		{ 0x00ACC1, Luminance::Light }, // Shade600
+		{ 0x0097A7, Luminance::Dark }, // Shade700
+		{ 0x00838F, Luminance::Dark }, // Shade800
+		{ 0x006064, Luminance::Dark }, // Shade900
+		{ 0x84FFFF, Luminance::Light }, // ShadeA100
+		{ 0x18FFFF, Luminance::Light }, // ShadeA200
+		{ 0x00E5FF, Luminance::Light }, // ShadeA400
+		{ 0x00B8D4, Luminance::Light }, // ShadeA700
+	} },
+	// Teal
+	{ {
+		{ 0xE0F2F1, Luminance::Light }, // Shade50
+		{ 0xB2DFDB, Luminance::Light }, // Shade100
+		{ 0x80CBC4, Luminance::Light }, // Shade200
+		{ 0x4DB6AC, Luminance::Light }, // Shade300
+		{ 0x26A69A, Luminance::Light }, // Shade400
+		{ 0x009688, Luminance::Dark }, // Shade500
+		{ 0x00897B, Luminance::Dark }, // Shade600
+		{ 0x00796B, Luminance::Dark }, // Shade700
+		{ 0x00695C, Luminance::Dark }, // Shade800
+		{ 0x004D40, Luminance::Dark }, // Shade900
+		{ 0xA7FFEB, Luminance::Light }, // ShadeA100
+		{ 0x64FFDA, Luminance::Light }, // ShadeA200
+		{ 0x1DE9B6, Luminance::Light }, // ShadeA400
+		{ 0x00BFA5, Luminance::Light }, // ShadeA700
+	} },
+	// Green
+	{ {
+		{ 0xE8F5E9, Luminance::Light }, // Shade50
+		{ 0xC8E6C9, Luminance::Light }, // Shade100
+		{ 0xA5D6A7, Luminance::Light }, // Shade200
+		{ 0x81C784, Luminance::Light }, // Shade300
+		{ 0x66BB6A, Luminance::Light }, // Shade400
+		{ 0x4CAF50, Luminance::Light }, // Shade500
+		{ 0x43A047, Luminance::Dark }, // Shade600
+		{ 0x388E3C, Luminance::Dark }, // Shade700
+		{ 0x2E7D32, Luminance::Dark }, // Shade800
+		{ 0x1B5E20, Luminance::Dark }, // Shade900
+		{ 0xB9F6CA, Luminance::Light }, // ShadeA100
+		{ 0x69F0AE, Luminance::Light }, // ShadeA200
+		{ 0x00E676, Luminance::Light }, // ShadeA400
+		{ 0x00C853, Luminance::Light }, // ShadeA700
+	} },
+	// LightGreen
+	{ {
+		{ 0xF1F8E9, Luminance::Light }, // Shade50
+		{ 0xDCEDC8, Luminance::Light }, // Shade100
+		{ 0xC5E1A5, Luminance::Light }, // Shade200
+		{ 0xAED581, Luminance::Light }, // Shade300
+		{ 0x9CCC65, Luminance::Light }, // Shade400
+		{ 0x8BC34A, Luminance::Light }, // Shade500
+		{ 0x7CB342, Luminance::Light }, // Shade600
+		{ 0x689F38, Luminance::Light }, // Shade700
+		{ 0x558B2F, Luminance::Dark }, // Shade800
+		{ 0xC33691E, Luminance::Dark }, // Shade900
+		{ 0xCCFF90, Luminance::Light }, // ShadeA100
+		{ 0xB2FF59, Luminance::Light }, // ShadeA200
+		{ 0x76FF03, Luminance::Light }, // ShadeA400
+		{ 0x64DD17, Luminance::Light }, // ShadeA700
+	} },
+	// Lime
+	{ {
+		{ 0xF9FBE7, Luminance::Light }, // Shade50
+		{ 0xF0F4C3, Luminance::Light }, // Shade100
+		{ 0xE6EE9C, Luminance::Light }, // Shade200
+		{ 0xDCE775, Luminance::Light }, // Shade300
+		{ 0xD4E157, Luminance::Light }, // Shade400
+		{ 0xCDDC39, Luminance::Light }, // Shade500
+		{ 0xC0CA33, Luminance::Light }, // Shade600
+		{ 0xAFB42B, Luminance::Light }, // Shade700
+		{ 0x9E9D24, Luminance::Light }, // Shade800
+		{ 0x827717, Luminance::Dark }, // Shade900
+		{ 0xF4FF81, Luminance::Light }, // ShadeA100
+		{ 0xEEFF41, Luminance::Light }, // ShadeA200
+		{ 0xC6FF00, Luminance::Light }, // ShadeA400
+		{ 0xAEEA00, Luminance::Light }, // ShadeA700
+	} },
+	// Yellow
+	{ {
+		{ 0xFFFDE7, Luminance::Light }, // Shade50
+		{ 0xFFF9C4, Luminance::Light }, // Shade100
+		{ 0xFFF59D, Luminance::Light }, // Shade200
+		{ 0xFFF176, Luminance::Light }, // Shade300
+		{ 0xFFEE58, Luminance::Light }, // Shade400
+		{ 0xFFEB3B, Luminance::Light }, // Shade500
+		{ 0xFDD835, Luminance::Light }, // Shade600
+		{ 0xFBC02D, Luminance::Light }, // Shade700
+		{ 0xF9A825, Luminance::Light }, // Shade800
+		{ 0xF57F17, Luminance::Light }, // Shade900
+		{ 0xFFFF8D, Luminance::Light }, // ShadeA100
+		{ 0xFFFF00, Luminance::Light }, // ShadeA200
+		{ 0xFFEA00, Luminance::Light }, // ShadeA400
+		{ 0xFFD600, Luminance::Light }, // ShadeA700
+	} },
+	// Amber
+	{ {
+		{ 0xFFF8E1, Luminance::Light }, // Shade50
+		{ 0xFFECB3, Luminance::Light }, // Shade100
+		{ 0xFFE082, Luminance::Light }, // Shade200
+		{ 0xFFD54F, Luminance::Light }, // Shade300
+		{ 0xFFCA28, Luminance::Light }, // Shade400
+		{ 0xFFC107, Luminance::Light }, // Shade500
+		{ 0xFFB300, Luminance::Light }, // Shade600
+		{ 0xFFA000, Luminance::Light }, // Shade700
+		{ 0xFF8F00, Luminance::Light }, // Shade800
+		{ 0xFF6F00, Luminance::Light }, // Shade900
+		{ 0xFFE57F, Luminance::Light }, // ShadeA100
+		{ 0xFFD740, Luminance::Light }, // ShadeA200
+		{ 0xFFC400, Luminance::Light }, // ShadeA400
+		{ 0xFFAB00, Luminance::Light }, // ShadeA700
+	} },
+	// Orange
+	{ {
+		{ 0xFFF3E0, Luminance::Light }, // Shade50
+		{ 0xFFE0B2, Luminance::Light }, // Shade100
+		{ 0xFFCC80, Luminance::Light }, // Shade200
+		{ 0xFFB74D, Luminance::Light }, // Shade300
+		{ 0xFFA726, Luminance::Light }, // Shade400
+		{ 0xFF9800, Luminance::Light }, // Shade500
+		{ 0xFB8C00, Luminance::Light }, // Shade600
+		{ 0xF57C00, Luminance::Light }, // Shade700
+		{ 0xEF6C00, Luminance::Light }, // Shade800
+		{ 0xE65100, Luminance::Dark }, // Shade900
+		{ 0xFFD180, Luminance::Light }, // ShadeA100
+		{ 0xFFAB40, Luminance::Light }, // ShadeA200
+		{ 0xFF9100, Luminance::Light }, // ShadeA400
+		{ 0xFF6D00, Luminance::Light }, // ShadeA700
+	} },
+	// DeepOrange
+	{ {
+		{ 0xFBE9E7, Luminance::Light }, // Shade50
+		{ 0xFFCCBC, Luminance::Light }, // Shade100
+		{ 0xFFAB91, Luminance::Light }, // Shade200
+		{ 0xFF8A65, Luminance::Light }, // Shade300
+		{ 0xFF7043, Luminance::Light }, // Shade400
+		{ 0xFF5722, Luminance::Light }, // Shade500
+		{ 0xF4511E, Luminance::Dark }, // Shade600
+		{ 0xE64A19, Luminance::Dark }, // Shade700
+		{ 0xD84315, Luminance::Dark }, // Shade800
+		{ 0xBF360C, Luminance::Dark }, // Shade900
+		{ 0xFF9E80, Luminance::Light }, // ShadeA100
+		{ 0xFF6E40, Luminance::Light }, // ShadeA200
+		{ 0xFF3D00, Luminance::Dark }, // ShadeA400
+		{ 0xDD2C00, Luminance::Dark }, // ShadeA700
+	} },
+	// Brown
+	{ {
+		{ 0xEFEBE9, Luminance::Light }, // Shade50
+		{ 0xD7CCC8, Luminance::Light }, // Shade100
+		{ 0xBCAAA4, Luminance::Light }, // Shade200
+		{ 0xA1887F, Luminance::Dark }, // Shade300
+		{ 0x8D6E63, Luminance::Dark }, // Shade400
+		{ 0x795548, Luminance::Dark }, // Shade500
+		{ 0x6D4C41, Luminance::Dark }, // Shade600
+		{ 0x5D4037, Luminance::Dark }, // Shade700
+		{ 0x4E342E, Luminance::Dark }, // Shade800
+		{ 0x3E2723, Luminance::Dark }, // Shade900
+		{ 0xA1887F, Luminance::Dark }, // ShadeA100
+		{ 0x795548, Luminance::Dark }, // ShadeA200
+		{ 0x5D4037, Luminance::Dark }, // ShadeA400
+		{ 0x3E2723, Luminance::Dark }, // ShadeA700
+	} },
+	// Gray
+	{ {
+		{ 0xFAFAFA, Luminance::Light }, // Shade50
+		{ 0xF5F5F5, Luminance::Light }, // Shade100
+		{ 0xEEEEEE, Luminance::Light }, // Shade200
+		{ 0xE0E0E0, Luminance::Light }, // Shade300
+		{ 0xBDBDBD, Luminance::Light }, // Shade400
+		{ 0x9E9E9E, Luminance::Light }, // Shade500
+		{ 0x757575, Luminance::Dark }, // Shade600
+		{ 0x616161, Luminance::Dark }, // Shade700
+		{ 0x424242, Luminance::Dark }, // Shade800
+		{ 0x212121, Luminance::Dark }, // Shade900
+		{ 0xE0E0E0, Luminance::Light }, // ShadeA100
+		{ 0x9E9E9E, Luminance::Light }, // ShadeA200
+		{ 0x616161, Luminance::Dark }, // ShadeA400
+		{ 0x212121, Luminance::Dark }, // ShadeA700
+	} },
+	// BlueGray
+	{ {
+		{ 0xECEFF1, Luminance::Light }, // Shade50
+		{ 0xCFD8DC, Luminance::Light }, // Shade100
+		{ 0xB0BEC5, Luminance::Light }, // Shade200
+		{ 0x90A4AE, Luminance::Light }, // Shade300
+		{ 0x78909C, Luminance::Dark }, // Shade400
+		{ 0x607D8B, Luminance::Dark }, // Shade500
+		{ 0x546E7A, Luminance::Dark }, // Shade600
+		{ 0x455A64, Luminance::Dark }, // Shade700
+		{ 0x37474F, Luminance::Dark }, // Shade800
+		{ 0x263238, Luminance::Dark }, // Shade900
+		{ 0x90A4AE, Luminance::Light }, // ShadeA100
+		{ 0x607D8B, Luminance::Dark }, // ShadeA200
+		{ 0x455A64, Luminance::Dark }, // ShadeA400
+		{ 0x263238, Luminance::Dark }, // ShadeA700
+	} },
+} };
 
-static const ColorMap g_colorMap = {
-	{ Name::Red,
-		{
-			{ Shade::Shade50, { 0xFFEBEE, Luminance::Light } },
-			{ Shade::Shade100, { 0xFFCDD2, Luminance::Light } },
-			{ Shade::Shade200, { 0xEF9A9A, Luminance::Light } },
-			{ Shade::Shade300, { 0xE57373, Luminance::Light } },
-			{ Shade::Shade400, { 0xEF5350, Luminance::Dark } },
-			{ Shade::Shade500, { 0xF44336, Luminance::Dark } },
-			{ Shade::Shade600, { 0xE53935, Luminance::Dark } },
-			{ Shade::Shade700, { 0xD32F2F, Luminance::Dark } },
-			{ Shade::Shade800, { 0xC62828, Luminance::Dark } },
-			{ Shade::Shade900, { 0xB71C1C, Luminance::Dark } },
-			{ Shade::ShadeA100, { 0xFF8A80, Luminance::Light } },
-			{ Shade::ShadeA200, { 0xFF5252, Luminance::Dark } },
-			{ Shade::ShadeA400, { 0xFF1744, Luminance::Dark } },
-			{ Shade::ShadeA700, { 0xD50000, Luminance::Dark } },
-		} },
-	{ Name::Pink,
-		{
-			{ Shade::Shade50, { 0xFCE4EC, Luminance::Light } },
-			{ Shade::Shade100, { 0xF8BBD0, Luminance::Light } },
-			{ Shade::Shade200, { 0xF48FB1, Luminance::Light } },
-			{ Shade::Shade300, { 0xF06292, Luminance::Light } },
-			{ Shade::Shade400, { 0xEC407A, Luminance::Dark } },
-			{ Shade::Shade500, { 0xE91E63, Luminance::Dark } },
-			{ Shade::Shade600, { 0xD81B60, Luminance::Dark } },
-			{ Shade::Shade700, { 0xC2185B, Luminance::Dark } },
-			{ Shade::Shade800, { 0xAD1457, Luminance::Dark } },
-			{ Shade::Shade900, { 0x880E4F, Luminance::Dark } },
-			{ Shade::ShadeA100, { 0xFF80AB, Luminance::Light } },
-			{ Shade::ShadeA200, { 0xFF4081, Luminance::Dark } },
-			{ Shade::ShadeA400, { 0xF50057, Luminance::Dark } },
-			{ Shade::ShadeA700, { 0xC51162, Luminance::Dark } },
-		} },
-	{ Name::Purple,
-		{
-			{ Shade::Shade50, { 0xF3E5F5, Luminance::Light } },
-			{ Shade::Shade100, { 0xE1BEE7, Luminance::Light } },
-			{ Shade::Shade200, { 0xCE93D8, Luminance::Light } },
-			{ Shade::Shade300, { 0xBA68C8, Luminance::Dark } },
-			{ Shade::Shade400, { 0xAB47BC, Luminance::Dark } },
-			{ Shade::Shade500, { 0x9C27B0, Luminance::Dark } },
-			{ Shade::Shade600, { 0x8E24AA, Luminance::Dark } },
-			{ Shade::Shade700, { 0x7B1FA2, Luminance::Dark } },
-			{ Shade::Shade800, { 0x6A1B9A, Luminance::Dark } },
-			{ Shade::Shade900, { 0x4A148C, Luminance::Dark } },
-			{ Shade::ShadeA100, { 0xEA80FC, Luminance::Light } },
-			{ Shade::ShadeA200, { 0xE040FB, Luminance::Dark } },
-			{ Shade::ShadeA400, { 0xD500F9, Luminance::Dark } },
-			{ Shade::ShadeA700, { 0xAA00FF, Luminance::Dark } },
-		} },
-	{ Name::DeepPurple,
-		{
-			{ Shade::Shade50, { 0xEDE7F6, Luminance::Light } },
-			{ Shade::Shade100, { 0xD1C4E9, Luminance::Light } },
-			{ Shade::Shade200, { 0xB39DDB, Luminance::Light } },
-			{ Shade::Shade300, { 0x9575CD, Luminance::Dark } },
-			{ Shade::Shade400, { 0x7E57C2, Luminance::Dark } },
-			{ Shade::Shade500, { 0x673AB7, Luminance::Dark } },
-			{ Shade::Shade600, { 0x5E35B1, Luminance::Dark } },
-			{ Shade::Shade700, { 0x512DA8, Luminance::Dark } },
-			{ Shade::Shade800, { 0x4527A0, Luminance::Dark } },
-			{ Shade::Shade900, { 0x311B92, Luminance::Dark } },
-			{ Shade::ShadeA100, { 0xB388FF, Luminance::Light } },
-			{ Shade::ShadeA200, { 0x7C4DFF, Luminance::Dark } },
-			{ Shade::ShadeA400, { 0x651FFF, Luminance::Dark } },
-			{ Shade::ShadeA700, { 0x6200EA, Luminance::Dark } },
-		} },
-	{ Name::Indigo,
-		{
-			{ Shade::Shade50, { 0xE8EAF6, Luminance::Light } },
-			{ Shade::Shade100, { 0xC5CAE9, Luminance::Light } },
-			{ Shade::Shade200, { 0x9FA8DA, Luminance::Light } },
-			{ Shade::Shade300, { 0x7986CB, Luminance::Dark } },
-			{ Shade::Shade400, { 0x5C6BC0, Luminance::Dark } },
-			{ Shade::Shade500, { 0x3F51B5, Luminance::Dark } },
-			{ Shade::Shade600, { 0x3949AB, Luminance::Dark } },
-			{ Shade::Shade700, { 0x303F9F, Luminance::Dark } },
-			{ Shade::Shade800, { 0x283593, Luminance::Dark } },
-			{ Shade::Shade900, { 0x1A237E, Luminance::Dark } },
-			{ Shade::ShadeA100, { 0x8C9EFF, Luminance::Light } },
-			{ Shade::ShadeA200, { 0x536DFE, Luminance::Dark } },
-			{ Shade::ShadeA400, { 0x3D5AFE, Luminance::Dark } },
-			{ Shade::ShadeA700, { 0x304FFE, Luminance::Dark } },
-		} },
-	{ Name::Blue,
-		{
-			{ Shade::Shade50, { 0xE3F2FD, Luminance::Light } },
-			{ Shade::Shade100, { 0xBBDEFB, Luminance::Light } },
-			{ Shade::Shade200, { 0x90CAF9, Luminance::Light } },
-			{ Shade::Shade300, { 0x64B5F6, Luminance::Light } },
-			{ Shade::Shade400, { 0x42A5F5, Luminance::Light } },
-			{ Shade::Shade500, { 0x2196F3, Luminance::Light } },
-			{ Shade::Shade600, { 0x1E88E5, Luminance::Dark } },
-			{ Shade::Shade700, { 0x1976D2, Luminance::Dark } },
-			{ Shade::Shade800, { 0x1565C0, Luminance::Dark } },
-			{ Shade::Shade900, { 0x0D47A1, Luminance::Dark } },
-			{ Shade::ShadeA100, { 0x82B1FF, Luminance::Light } },
-			{ Shade::ShadeA200, { 0x448AFF, Luminance::Dark } },
-			{ Shade::ShadeA400, { 0x2979FF, Luminance::Dark } },
-			{ Shade::ShadeA700, { 0x2962FF, Luminance::Dark } },
-		} },
-	{ Name::LightBlue,
-		{
-			{ Shade::Shade50, { 0xE1F5FE, Luminance::Light } },
-			{ Shade::Shade100, { 0xB3E5FC, Luminance::Light } },
-			{ Shade::Shade200, { 0x81D4FA, Luminance::Light } },
-			{ Shade::Shade300, { 0x4FC3F7, Luminance::Light } },
-			{ Shade::Shade400, { 0x29B6F6, Luminance::Light } },
-			{ Shade::Shade500, { 0x03A9F4, Luminance::Light } },
-			{ Shade::Shade600, { 0x039BE5, Luminance::Light } },
-			{ Shade::Shade700, { 0x0288D1, Luminance::Dark } },
-			{ Shade::Shade800, { 0x0277BD, Luminance::Dark } },
-			{ Shade::Shade900, { 0x01579B, Luminance::Dark } },
-			{ Shade::ShadeA100, { 0x80D8FF, Luminance::Light } },
-			{ Shade::ShadeA200, { 0x40C4FF, Luminance::Light } },
-			{ Shade::ShadeA400, { 0x00B0FF, Luminance::Light } },
-			{ Shade::ShadeA700, { 0x0091EA, Luminance::Dark } },
-		} },
-	{ Name::Cyan,
-		{
-			{ Shade::Shade50, { 0xE0F7FA, Luminance::Light } },
-			{ Shade::Shade100, { 0xB2EBF2, Luminance::Light } },
-			{ Shade::Shade200, { 0x80DEEA, Luminance::Light } },
-			{ Shade::Shade300, { 0x4DD0E1, Luminance::Light } },
-			{ Shade::Shade400, { 0x26C6DA, Luminance::Light } },
-			{ Shade::Shade500, { 0x00BCD4, Luminance::Light } },
-			{ Shade::Shade600, { 0x00ACC1, Luminance::Light } },
-			{ Shade::Shade700, { 0x0097A7, Luminance::Dark } },
-			{ Shade::Shade800, { 0x00838F, Luminance::Dark } },
-			{ Shade::Shade900, { 0x006064, Luminance::Dark } },
-			{ Shade::ShadeA100, { 0x84FFFF, Luminance::Light } },
-			{ Shade::ShadeA200, { 0x18FFFF, Luminance::Light } },
-			{ Shade::ShadeA400, { 0x00E5FF, Luminance::Light } },
-			{ Shade::ShadeA700, { 0x00B8D4, Luminance::Light } },
-		} },
-	{ Name::Teal,
-		{
-			{ Shade::Shade50, { 0xE0F2F1, Luminance::Light } },
-			{ Shade::Shade100, { 0xB2DFDB, Luminance::Light } },
-			{ Shade::Shade200, { 0x80CBC4, Luminance::Light } },
-			{ Shade::Shade300, { 0x4DB6AC, Luminance::Light } },
-			{ Shade::Shade400, { 0x26A69A, Luminance::Light } },
-			{ Shade::Shade500, { 0x009688, Luminance::Dark } },
-			{ Shade::Shade600, { 0x00897B, Luminance::Dark } },
-			{ Shade::Shade700, { 0x00796B, Luminance::Dark } },
-			{ Shade::Shade800, { 0x00695C, Luminance::Dark } },
-			{ Shade::Shade900, { 0x004D40, Luminance::Dark } },
-			{ Shade::ShadeA100, { 0xA7FFEB, Luminance::Light } },
-			{ Shade::ShadeA200, { 0x64FFDA, Luminance::Light } },
-			{ Shade::ShadeA400, { 0x1DE9B6, Luminance::Light } },
-			{ Shade::ShadeA700, { 0x00BFA5, Luminance::Light } },
-		} },
-	{ Name::Green,
-		{
-			{ Shade::Shade50, { 0xE8F5E9, Luminance::Light } },
-			{ Shade::Shade100, { 0xC8E6C9, Luminance::Light } },
-			{ Shade::Shade200, { 0xA5D6A7, Luminance::Light } },
-			{ Shade::Shade300, { 0x81C784, Luminance::Light } },
-			{ Shade::Shade400, { 0x66BB6A, Luminance::Light } },
-			{ Shade::Shade500, { 0x4CAF50, Luminance::Light } },
-			{ Shade::Shade600, { 0x43A047, Luminance::Dark } },
-			{ Shade::Shade700, { 0x388E3C, Luminance::Dark } },
-			{ Shade::Shade800, { 0x2E7D32, Luminance::Dark } },
-			{ Shade::Shade900, { 0x1B5E20, Luminance::Dark } },
-			{ Shade::ShadeA100, { 0xB9F6CA, Luminance::Light } },
-			{ Shade::ShadeA200, { 0x69F0AE, Luminance::Light } },
-			{ Shade::ShadeA400, { 0x00E676, Luminance::Light } },
-			{ Shade::ShadeA700, { 0x00C853, Luminance::Light } },
-		} },
-	{ Name::LightGreen,
-		{
-			{ Shade::Shade50, { 0xF1F8E9, Luminance::Light } },
-			{ Shade::Shade100, { 0xDCEDC8, Luminance::Light } },
-			{ Shade::Shade200, { 0xC5E1A5, Luminance::Light } },
-			{ Shade::Shade300, { 0xAED581, Luminance::Light } },
-			{ Shade::Shade400, { 0x9CCC65, Luminance::Light } },
-			{ Shade::Shade500, { 0x8BC34A, Luminance::Light } },
-			{ Shade::Shade600, { 0x7CB342, Luminance::Light } },
-			{ Shade::Shade700, { 0x689F38, Luminance::Light } },
-			{ Shade::Shade800, { 0x558B2F, Luminance::Dark } },
-			{ Shade::Shade900, { 0xC33691E, Luminance::Dark } },
-			{ Shade::ShadeA100, { 0xCCFF90, Luminance::Light } },
-			{ Shade::ShadeA200, { 0xB2FF59, Luminance::Light } },
-			{ Shade::ShadeA400, { 0x76FF03, Luminance::Light } },
-			{ Shade::ShadeA700, { 0x64DD17, Luminance::Light } },
-		} },
-	{ Name::Lime,
-		{
-			{ Shade::Shade50, { 0xF9FBE7, Luminance::Light } },
-			{ Shade::Shade100, { 0xF0F4C3, Luminance::Light } },
-			{ Shade::Shade200, { 0xE6EE9C, Luminance::Light } },
-			{ Shade::Shade300, { 0xDCE775, Luminance::Light } },
-			{ Shade::Shade400, { 0xD4E157, Luminance::Light } },
-			{ Shade::Shade500, { 0xCDDC39, Luminance::Light } },
-			{ Shade::Shade600, { 0xC0CA33, Luminance::Light } },
-			{ Shade::Shade700, { 0xAFB42B, Luminance::Light } },
-			{ Shade::Shade800, { 0x9E9D24, Luminance::Light } },
-			{ Shade::Shade900, { 0x827717, Luminance::Dark } },
-			{ Shade::ShadeA100, { 0xF4FF81, Luminance::Light } },
-			{ Shade::ShadeA200, { 0xEEFF41, Luminance::Light } },
-			{ Shade::ShadeA400, { 0xC6FF00, Luminance::Light } },
-			{ Shade::ShadeA700, { 0xAEEA00, Luminance::Light } },
-		} },
-	{ Name::Yellow,
-		{
-			{ Shade::Shade50, { 0xFFFDE7, Luminance::Light } },
-			{ Shade::Shade100, { 0xFFF9C4, Luminance::Light } },
-			{ Shade::Shade200, { 0xFFF59D, Luminance::Light } },
-			{ Shade::Shade300, { 0xFFF176, Luminance::Light } },
-			{ Shade::Shade400, { 0xFFEE58, Luminance::Light } },
-			{ Shade::Shade500, { 0xFFEB3B, Luminance::Light } },
-			{ Shade::Shade600, { 0xFDD835, Luminance::Light } },
-			{ Shade::Shade700, { 0xFBC02D, Luminance::Light } },
-			{ Shade::Shade800, { 0xF9A825, Luminance::Light } },
-			{ Shade::Shade900, { 0xF57F17, Luminance::Light } },
-			{ Shade::ShadeA100, { 0xFFFF8D, Luminance::Light } },
-			{ Shade::ShadeA200, { 0xFFFF00, Luminance::Light } },
-			{ Shade::ShadeA400, { 0xFFEA00, Luminance::Light } },
-			{ Shade::ShadeA700, { 0xFFD600, Luminance::Light } },
-		} },
-	{ Name::Amber,
-		{
-			{ Shade::Shade50, { 0xFFF8E1, Luminance::Light } },
-			{ Shade::Shade100, { 0xFFECB3, Luminance::Light } },
-			{ Shade::Shade200, { 0xFFE082, Luminance::Light } },
-			{ Shade::Shade300, { 0xFFD54F, Luminance::Light } },
-			{ Shade::Shade400, { 0xFFCA28, Luminance::Light } },
-			{ Shade::Shade500, { 0xFFC107, Luminance::Light } },
-			{ Shade::Shade600, { 0xFFB300, Luminance::Light } },
-			{ Shade::Shade700, { 0xFFA000, Luminance::Light } },
-			{ Shade::Shade800, { 0xFF8F00, Luminance::Light } },
-			{ Shade::Shade900, { 0xFF6F00, Luminance::Light } },
-			{ Shade::ShadeA100, { 0xFFE57F, Luminance::Light } },
-			{ Shade::ShadeA200, { 0xFFD740, Luminance::Light } },
-			{ Shade::ShadeA400, { 0xFFC400, Luminance::Light } },
-			{ Shade::ShadeA700, { 0xFFAB00, Luminance::Light } },
-		} },
-	{ Name::Orange,
-		{
-			{ Shade::Shade50, { 0xFFF3E0, Luminance::Light } },
-			{ Shade::Shade100, { 0xFFE0B2, Luminance::Light } },
-			{ Shade::Shade200, { 0xFFCC80, Luminance::Light } },
-			{ Shade::Shade300, { 0xFFB74D, Luminance::Light } },
-			{ Shade::Shade400, { 0xFFA726, Luminance::Light } },
-			{ Shade::Shade500, { 0xFF9800, Luminance::Light } },
-			{ Shade::Shade600, { 0xFB8C00, Luminance::Light } },
-			{ Shade::Shade700, { 0xF57C00, Luminance::Light } },
-			{ Shade::Shade800, { 0xEF6C00, Luminance::Light } },
-			{ Shade::Shade900, { 0xE65100, Luminance::Dark } },
-			{ Shade::ShadeA100, { 0xFFD180, Luminance::Light } },
-			{ Shade::ShadeA200, { 0xFFAB40, Luminance::Light } },
-			{ Shade::ShadeA400, { 0xFF9100, Luminance::Light } },
-			{ Shade::ShadeA700, { 0xFF6D00, Luminance::Light } },
-		} },
-	{ Name::DeepOrange,
-		{
-			{ Shade::Shade50, { 0xFBE9E7, Luminance::Light } },
-			{ Shade::Shade100, { 0xFFCCBC, Luminance::Light } },
-			{ Shade::Shade200, { 0xFFAB91, Luminance::Light } },
-			{ Shade::Shade300, { 0xFF8A65, Luminance::Light } },
-			{ Shade::Shade400, { 0xFF7043, Luminance::Light } },
-			{ Shade::Shade500, { 0xFF5722, Luminance::Light } },
-			{ Shade::Shade600, { 0xF4511E, Luminance::Dark } },
-			{ Shade::Shade700, { 0xE64A19, Luminance::Dark } },
-			{ Shade::Shade800, { 0xD84315, Luminance::Dark } },
-			{ Shade::Shade900, { 0xBF360C, Luminance::Dark } },
-			{ Shade::ShadeA100, { 0xFF9E80, Luminance::Light } },
-			{ Shade::ShadeA200, { 0xFF6E40, Luminance::Light } },
-			{ Shade::ShadeA400, { 0xFF3D00, Luminance::Dark } },
-			{ Shade::ShadeA700, { 0xDD2C00, Luminance::Dark } },
-		} },
-	{ Name::Brown,
-		{
-			{ Shade::Shade50, { 0xEFEBE9, Luminance::Light } },
-			{ Shade::Shade100, { 0xD7CCC8, Luminance::Light } },
-			{ Shade::Shade200, { 0xBCAAA4, Luminance::Light } },
-			{ Shade::Shade300, { 0xA1887F, Luminance::Dark } },
-			{ Shade::Shade400, { 0x8D6E63, Luminance::Dark } },
-			{ Shade::Shade500, { 0x795548, Luminance::Dark } },
-			{ Shade::Shade600, { 0x6D4C41, Luminance::Dark } },
-			{ Shade::Shade700, { 0x5D4037, Luminance::Dark } },
-			{ Shade::Shade800, { 0x4E342E, Luminance::Dark } },
-			{ Shade::Shade900, { 0x3E2723, Luminance::Dark } },
-			//
-			{ Shade::ShadeA100, { 0xA1887F, Luminance::Dark } },
-			{ Shade::ShadeA200, { 0x795548, Luminance::Dark } },
-			{ Shade::ShadeA400, { 0x5D4037, Luminance::Dark } },
-			{ Shade::ShadeA700, { 0x3E2723, Luminance::Dark } },
-		} },
-	{ Name::Gray,
-		{
-			{ Shade::Shade50, { 0xFAFAFA, Luminance::Light } },
-			{ Shade::Shade100, { 0xF5F5F5, Luminance::Light } },
-			{ Shade::Shade200, { 0xEEEEEE, Luminance::Light } },
-			{ Shade::Shade300, { 0xE0E0E0, Luminance::Light } },
-			{ Shade::Shade400, { 0xBDBDBD, Luminance::Light } },
-			{ Shade::Shade500, { 0x9E9E9E, Luminance::Light } },
-			{ Shade::Shade600, { 0x757575, Luminance::Dark } },
-			{ Shade::Shade700, { 0x616161, Luminance::Dark } },
-			{ Shade::Shade800, { 0x424242, Luminance::Dark } },
-			{ Shade::Shade900, { 0x212121, Luminance::Dark } },
-			//
-			{ Shade::ShadeA100, { 0xE0E0E0, Luminance::Light } },
-			{ Shade::ShadeA200, { 0x9E9E9E, Luminance::Light } },
-			{ Shade::ShadeA400, { 0x616161, Luminance::Dark } },
-			{ Shade::ShadeA700, { 0x212121, Luminance::Dark } },
-		} },
-	{ Name::BlueGray,
-		{
-			{ Shade::Shade50, { 0xECEFF1, Luminance::Light } },
-			{ Shade::Shade100, { 0xCFD8DC, Luminance::Light } },
-			{ Shade::Shade200, { 0xB0BEC5, Luminance::Light } },
-			{ Shade::Shade300, { 0x90A4AE, Luminance::Light } },
-			{ Shade::Shade400, { 0x78909C, Luminance::Dark } },
-			{ Shade::Shade500, { 0x607D8B, Luminance::Dark } },
-			{ Shade::Shade600, { 0x546E7A, Luminance::Dark } },
-			{ Shade::Shade700, { 0x455A64, Luminance::Dark } },
-			{ Shade::Shade800, { 0x37474F, Luminance::Dark } },
-			{ Shade::Shade900, { 0x263238, Luminance::Dark } },
-			//
-			{ Shade::ShadeA100, { 0x90A4AE, Luminance::Light } },
-			{ Shade::ShadeA200, { 0x607D8B, Luminance::Dark } },
-			{ Shade::ShadeA400, { 0x455A64, Luminance::Dark } },
-			{ Shade::ShadeA700, { 0x263238, Luminance::Dark } },
-		} },
-};
+static constexpr auto NoErrorColor = QRgb{ 0xFFFFFFFF }; // Use the default error color (Red A700)
 
-static const std::unordered_map<Name, std::unordered_map<Shade, QColor>> g_errorMap = {
-	{ Name::Red,
-		{
-			{ Shade::Shade50, 0x000000 },
-			{ Shade::Shade100, 0x000000 },
-			{ Shade::Shade200, 0x000000 },
-			{ Shade::Shade300, 0x000000 },
-			{ Shade::Shade400, 0x000000 },
-			{ Shade::Shade500, 0x000000 },
-			{ Shade::Shade600, 0x000000 },
-			{ Shade::Shade700, 0x000000 },
-			{ Shade::Shade800, 0x000000 },
-			{ Shade::Shade900, 0x000000 },
-			{ Shade::ShadeA100, 0x000000 },
-			{ Shade::ShadeA200, 0x000000 },
-			{ Shade::ShadeA400, 0x000000 },
-			{ Shade::ShadeA700, 0x000000 },
-		} },
-	{ Name::Pink,
-		{
-			{ Shade::Shade50, 0x000000 },
-			{ Shade::Shade100, 0x000000 },
-			{ Shade::Shade200, 0x000000 },
-			{ Shade::Shade300, 0x000000 },
-			{ Shade::Shade400, 0x000000 },
-			{ Shade::Shade500, 0x000000 },
-			{ Shade::Shade600, 0x000000 },
-			{ Shade::Shade700, 0x000000 },
-			{ Shade::Shade800, 0x000000 },
-			{ Shade::Shade900, 0x000000 },
-			{ Shade::ShadeA100, 0x000000 },
-			{ Shade::ShadeA200, 0x000000 },
-			{ Shade::ShadeA400, 0x000000 },
-			{ Shade::ShadeA700, 0x000000 },
-		} },
-	{ Name::Purple,
-		{
-			{ Shade::Shade300, 0xEF5350 },
-			{ Shade::Shade500, 0xEF5350 },
-			{ Shade::Shade600, 0xEF5350 },
-			{ Shade::Shade900, 0xEF5350 },
-		} },
-	{ Name::DeepPurple,
-		{
-			{ Shade::Shade300, 0xEF5350 },
-			{ Shade::Shade500, 0xEF5350 },
-			{ Shade::Shade600, 0xEF5350 },
-			{ Shade::Shade900, 0xEF5350 },
-		} },
-	{ Name::Indigo,
-		{
-			{ Shade::Shade300, 0xEF5350 },
-			{ Shade::Shade500, 0xEF5350 },
-			{ Shade::Shade600, 0xEF5350 },
-			{ Shade::Shade900, 0xEF5350 },
-		} },
-	//{ Name::Blue,
-	//	{
-	//		{ Shade::Shade300, 0xD50000 },
-	//		{ Shade::Shade500, 0xD50000 },
-	//		{ Shade::Shade600, 0xD50000 },
-	//		{ Shade::Shade900, 0xD50000 },
-	//	} },
-	//{ Name::LightBlue,
-	//	{
-	//		{ Shade::Shade300, 0xD50000 },
-	//		{ Shade::Shade500, 0xD50000 },
-	//		{ Shade::Shade600, 0xD50000 },
-	//		{ Shade::Shade900, 0xD50000 },
-	//	} },
-	//{ Name::Cyan,
-	//	{
-	//		{ Shade::Shade300, 0xD50000 },
-	//		{ Shade::Shade500, 0xD50000 },
-	//		{ Shade::Shade600, 0xD50000 },
-	//		{ Shade::Shade900, 0xD50000 },
-	//	} },
-	{ Name::Teal,
-		{
-			{ Shade::Shade300, 0xEF5350 },
-			{ Shade::Shade500, 0xEF5350 },
-			{ Shade::Shade600, 0xEF5350 },
-			{ Shade::Shade900, 0xEF5350 },
-		} },
-	//{ Name::Green,
-	//	{
-	//		{ Shade::Shade300, 0xD50000 },
-	//		{ Shade::Shade500, 0xD50000 },
-	//		{ Shade::Shade600, 0xD50000 },
-	//		{ Shade::Shade900, 0xD50000 },
-	//	} },
-	//{ Name::LightGreen,
-	//	{
-	//		{ Shade::Shade300, 0xD50000 },
-	//		{ Shade::Shade500, 0xD50000 },
-	//		{ Shade::Shade600, 0xD50000 },
-	//		{ Shade::Shade900, 0xD50000 },
-	//	} },
-	//{ Name::Lime,
-	//	{
-	//		{ Shade::Shade300, 0xD50000 },
-	//		{ Shade::Shade500, 0xD50000 },
-	//		{ Shade::Shade600, 0xD50000 },
-	//		{ Shade::Shade900, 0xD50000 },
-	//	} },
-	//{ Name::Yellow,
-	//	{
-	//		{ Shade::Shade300, 0xD50000 },
-	//		{ Shade::Shade500, 0xD50000 },
-	//		{ Shade::Shade600, 0xD50000 },
-	//		{ Shade::Shade900, 0xD50000 },
-	//	} },
-	//{ Name::Amber,
-	//	{
-	//		{ Shade::Shade300, 0xD50000 },
-	//		{ Shade::Shade500, 0xD50000 },
-	//		{ Shade::Shade600, 0xD50000 },
-	//		{ Shade::Shade900, 0xD50000 },
-	//	} },
-	//{ Name::Orange,
-	//	{
-	//		{ Shade::Shade300, 0xD50000 },
-	//		{ Shade::Shade500, 0xD50000 },
-	//		{ Shade::Shade600, 0xD50000 },
-	//		{ Shade::Shade900, 0xD50000 },
-	//	} },
-	{ Name::DeepOrange,
-		{
-			{ Shade::Shade50, 0x000000 },
-			{ Shade::Shade100, 0x000000 },
-			{ Shade::Shade200, 0x000000 },
-			{ Shade::Shade300, 0x000000 },
-			{ Shade::Shade400, 0x000000 },
-			{ Shade::Shade500, 0x000000 },
-			{ Shade::Shade600, 0x000000 },
-			{ Shade::Shade700, 0x000000 },
-			{ Shade::Shade800, 0x000000 },
-			{ Shade::Shade900, 0x000000 },
-			{ Shade::ShadeA100, 0x000000 },
-			{ Shade::ShadeA200, 0x000000 },
-			{ Shade::ShadeA400, 0x000000 },
-			{ Shade::ShadeA700, 0x000000 },
-		} },
-	{ Name::Brown,
-		{
-			{ Shade::Shade300, 0xEF5350 },
-			{ Shade::Shade500, 0xEF5350 },
-			{ Shade::Shade600, 0xEF5350 },
-			{ Shade::Shade900, 0xEF5350 },
-		} },
-	{ Name::Gray,
-		{
-			{ Shade::Shade300, 0xFF5252 },
-			{ Shade::Shade500, 0xFF5252 },
-			{ Shade::Shade600, 0xFF5252 },
-			{ Shade::Shade900, 0xFF5252 },
-		} },
-	{ Name::BlueGray,
-		{
-			{ Shade::Shade300, 0xFF5252 },
-			{ Shade::Shade500, 0xFF5252 },
-			{ Shade::Shade600, 0xFF5252 },
-			{ Shade::Shade900, 0xFF5252 },
-		} },
-};
+// Indexed by Name then Shade
+static constexpr std::array<std::array<QRgb, ShadeCount>, NameCount> s_errorColors = { {
+	{ { 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000 } }, // Red
+	{ { 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000 } }, // Pink
+	{ { NoErrorColor, NoErrorColor, NoErrorColor, 0xEF5350, NoErrorColor, 0xEF5350, 0xEF5350, NoErrorColor, NoErrorColor, 0xEF5350, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor } }, // Purple
+	{ { NoErrorColor, NoErrorColor, NoErrorColor, 0xEF5350, NoErrorColor, 0xEF5350, 0xEF5350, NoErrorColor, NoErrorColor, 0xEF5350, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor } }, // DeepPurple
+	{ { NoErrorColor, NoErrorColor, NoErrorColor, 0xEF5350, NoErrorColor, 0xEF5350, 0xEF5350, NoErrorColor, NoErrorColor, 0xEF5350, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor } }, // Indigo
+	{ { NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor } }, // Blue
+	{ { NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor } }, // LightBlue
+	{ { NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor } }, // Cyan
+	{ { NoErrorColor, NoErrorColor, NoErrorColor, 0xEF5350, NoErrorColor, 0xEF5350, 0xEF5350, NoErrorColor, NoErrorColor, 0xEF5350, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor } }, // Teal
+	{ { NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor } }, // Green
+	{ { NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor } }, // LightGreen
+	{ { NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor } }, // Lime
+	{ { NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor } }, // Yellow
+	{ { NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor } }, // Amber
+	{ { NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor } }, // Orange
+	{ { 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000, 0x000000 } }, // DeepOrange
+	{ { NoErrorColor, NoErrorColor, NoErrorColor, 0xEF5350, NoErrorColor, 0xEF5350, 0xEF5350, NoErrorColor, NoErrorColor, 0xEF5350, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor } }, // Brown
+	{ { NoErrorColor, NoErrorColor, NoErrorColor, 0xFF5252, NoErrorColor, 0xFF5252, 0xFF5252, NoErrorColor, NoErrorColor, 0xFF5252, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor } }, // Gray
+	{ { NoErrorColor, NoErrorColor, NoErrorColor, 0xFF5252, NoErrorColor, 0xFF5252, 0xFF5252, NoErrorColor, NoErrorColor, 0xFF5252, NoErrorColor, NoErrorColor, NoErrorColor, NoErrorColor } }, // BlueGray
+} };
 
-static ShadeMap const& shadeMap(Name const name)
+static ColorData const& colorData(Name const name, Shade const shade)
 {
-	auto const it = g_colorMap.find(name);
-	if (it == std::end(g_colorMap))
+	auto const nameIndex = static_cast<std::size_t>(name);
+	if (nameIndex >= NameCount)
 	{
 		throw std::invalid_argument("Unknown Name");
 	}
-	return it->second;
-}
-
-static ColorData const& colorData(Name const name, Shade const shade)
-{
-	auto const& map = shadeMap(name);
-	auto const jt = map.find(shade);
-	if (jt == std::end(map))
+	auto const shadeIndex = static_cast<std::size_t>(shade);
+	if (shadeIndex >= ShadeCount)
 	{
 		throw std::invalid_argument("Invalid Shade");
 	}
-	return jt->second;
+	return s_colors[nameIndex][shadeIndex];
 }
 
 QColor complementary(QColor const& baseColor)
@@ -590,18 +443,17 @@ QColor foregroundComplementaryValue(Name const name, Shade const shade)
 
 QColor foregroundErrorColorValue(Name const name, Shade const shade)
 {
-	auto errorColor = value(Name::Red, qt::toolkit::material::color::Shade::ShadeA700);
-
-	if (auto const nameMapIt = g_errorMap.find(name); nameMapIt != g_errorMap.end())
+	auto const nameIndex = static_cast<std::size_t>(name);
+	auto const shadeIndex = static_cast<std::size_t>(shade);
+	if (nameIndex < NameCount && shadeIndex < ShadeCount)
 	{
-		auto const& map = nameMapIt->second;
-		if (auto const shadeMapIt = map.find(shade); shadeMapIt != map.end())
+		if (auto const errorColor = s_errorColors[nameIndex][shadeIndex]; errorColor != NoErrorColor)
 		{
-			errorColor = shadeMapIt->second;
+			return QColor{ errorColor };
 		}
 	}
 
-	return errorColor;
+	return value(Name::Red, qt::toolkit::material::color::Shade::ShadeA700);
 }
 
 Luminance luminance(Name const name, Shade const shade)
@@ -609,33 +461,36 @@ Luminance luminance(Name const name, Shade const shade)
 	return colorData(name, shade).luminance;
 }
 
-QBrush buildBrush(Name const name, Shade const shade) noexcept
+ShadeBrushes const& brushes(Name const name) noexcept
 {
-	auto const& shades = shadeMap(name);
-	auto const it = shades.find(shade);
-	if (it != std::end(shades))
+	// Built once, the table of a name being valid for the lifetime of the application
+	static auto const s_brushes = []()
 	{
-		return QBrush{ it->second.value };
-	}
+		auto brushes = std::array<ShadeBrushes, NameCount + 1>{};
+		for (auto nameIndex = std::size_t{ 0u }; nameIndex < NameCount; ++nameIndex)
+		{
+			for (auto shadeIndex = std::size_t{ 0u }; shadeIndex < ShadeCount; ++shadeIndex)
+			{
+				brushes[nameIndex][shadeIndex] = QBrush{ QColor{ s_colors[nameIndex][shadeIndex].value } };
+			}
+		}
+		// Last table used for invalid names
+		brushes[NameCount].fill(QBrush{ Qt::darkGray, Qt::BDiagPattern });
+		return brushes;
+	}();
 
-	return QBrush{ Qt::darkGray, Qt::BDiagPattern };
+	auto const nameIndex = static_cast<std::size_t>(name);
+	return s_brushes[nameIndex < NameCount ? nameIndex : NameCount];
 }
 
 QBrush brush(Name const name, Shade const shade) noexcept
 {
-	using Shades = std::unordered_map<Shade, QBrush>;
-	using Colors = std::unordered_map<Name, Shades>;
-
-	static Colors s_colors;
-
-	auto& shades = s_colors[name];
-	auto const it = shades.find(shade);
-	if (it == std::end(shades))
+	auto const shadeIndex = static_cast<std::size_t>(shade);
+	if (shadeIndex >= ShadeCount)
 	{
-		shades[shade] = buildBrush(name, shade);
+		return QBrush{ Qt::darkGray, Qt::BDiagPattern };
 	}
-
-	return shades[shade];
+	return brushes(name)[shadeIndex];
 }
 
 } // namespace color
@@ -22,6 +22,9 @@
 #include <QColor>
 #include <QBrush>
 
+#include <array>
+#include <cstddef>
+
 namespace qt
 {
 namespace toolkit
@@ -120,6 +123,11 @@ Luminance luminance(Name const name, Shade const shade = DefaultShade);
 // Return a brush that represents a given name + shade
 QBrush brush(Name const name, Shade const shade = DefaultShade) noexcept;
 
+// Precomputed brushes of all the shades of a given name, indexed by Shade and valid for the lifetime of the application
+// Theme dependent painting can keep a pointer to the table of the current theme, a theme change only swapping that pointer
+using ShadeBrushes = std::array<QBrush, static_cast<std::size_t>(Shade::ShadeCount)>;
+ShadeBrushes const& brushes(Name const name) noexcept;
+
 } // namespace color
 } // namespace material
 } // namespace toolkit
@@ -20,14 +20,23 @@
 #include "settingsManager/settings.hpp"
 #include "internals/config.hpp"
 #include "updater.hpp"
+#include "avdecc/controllerManager.hpp"
 #include <QByteArray>
 #include <QNetworkAccessManager>
+#include <QNetworkDiskCache>
 #include <QNetworkRequest>
 #include <QNetworkReply>
+#include <QStandardPaths>
+#include <QTimer>
 #include <atomic>
+#include <functional>
+#include <chrono>
 #include <optional>
 #include <cstdint>
 
+static constexpr auto AutomaticCheckDelay = std::chrono::seconds{ 15 }; // Delay of the automatic check after the controller is online, so it never competes with the startup and the initial enumeration
+static constexpr auto RequestTimeout = std::chrono::seconds{ 10 }; // Requests still running after this delay are aborted (offline or slow networks)
+
 static QString BaseUrlPath{ "http://www.kikisoft.com/Hive" };
 #if defined(Q_OS_WIN)
 static QString VersionUrlPath{ BaseUrlPath + "/windows/LatestVersion-windows.txt" };
@@ -105,39 +114,45 @@ class UpdaterImpl final : public Updater, private settings::SettingsManager::Obs
 public:
 	UpdaterImpl() noexcept
 	{
-		// Connect signals
-		connect(&_webCtrlRelease, &QNetworkAccessManager::finished, this,
-			[this](QNetworkReply* const reply)
+		// Keep the appcasts in a local cache: they are revalidated with conditional requests (ETag / If-Modified-Since), an unchanged file being served from the cache
+		auto* const cache = new QNetworkDiskCache{ this };
+		cache->setCacheDirectory(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/updater");
+		_webCtrl.setCache(cache);
+
+		// Abort the requests taking too long, so no socket is kept open on a network without internet access
+		_requestTimeoutTimer.setSingleShot(true);
+		_requestTimeoutTimer.setInterval(static_cast<int>(std::chrono::milliseconds{ RequestTimeout }.count()));
+		connect(&_requestTimeoutTimer, &QTimer::timeout, this,
+			[this]()
 			{
-				if (reply->error() == QNetworkReply::NoError)
+				for (auto* const reply : { _releaseReply, _betaReply })
 				{
-					_newReleaseVersionString = QString(reply->readAll()).trimmed();
-					if (_checkBetaVersion)
-					{
-						QNetworkRequest request{ QUrl{ BetaVersionUrlPath } };
-						_webCtrlBeta.get(request);
-					}
-					else
+					if (reply)
 					{
-						compareVersions();
+						reply->abort();
 					}
 				}
-				else
+			});
+
+		// The automatic check is deferred until the enumeration started, and then some
+		_automaticCheckTimer.setSingleShot(true);
+		_automaticCheckTimer.setInterval(static_cast<int>(std::chrono::milliseconds{ AutomaticCheckDelay }.count()));
+		connect(&_automaticCheckTimer, &QTimer::timeout, this,
+			[this]()
+			{
+				if (_automaticCheckNewVersion)
 				{
-					emit checkFailed(reply->errorString());
+					checkForNewVersion();
 				}
-				reply->deleteLater();
 			});
-
-		connect(&_webCtrlBeta, &QNetworkAccessManager::finished, this,
-			[this](QNetworkReply* const reply)
+		connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::controllerOnline, this,
+			[this]()
 			{
-				if (reply->error() == QNetworkReply::NoError)
+				if (!_isAutomaticCheckDone)
 				{
-					_newBetaVersionString = QString(reply->readAll()).trimmed();
+					_isAutomaticCheckDone = true;
+					_automaticCheckTimer.start();
 				}
-				compareVersions();
-				reply->deleteLater();
 			});
 
 		// Register to settings::SettingsManager
@@ -185,10 +200,36 @@ private:
 			_checkBetaVersion = settings.getValue(settings::General_CheckForBetaVersions.name).toBool();
 			_newReleaseVersionString = "";
 			_newBetaVersionString = "";
-
-			QNetworkRequest request{ QUrl{ VersionUrlPath } };
+			_releaseError.clear();
 			_checkInProgress = true;
-			_webCtrlRelease.get(request);
+
+			// Both appcasts are requested in parallel
+			_releaseReply = get(VersionUrlPath,
+				[this](QNetworkReply* const reply)
+				{
+					if (reply->error() == QNetworkReply::NoError)
+					{
+						_newReleaseVersionString = QString(reply->readAll()).trimmed();
+					}
+					else
+					{
+						_releaseError = reply->errorString();
+					}
+					_releaseReply = nullptr;
+				});
+			if (_checkBetaVersion)
+			{
+				_betaReply = get(BetaVersionUrlPath,
+					[this](QNetworkReply* const reply)
+					{
+						if (reply->error() == QNetworkReply::NoError)
+						{
+							_newBetaVersionString = QString(reply->readAll()).trimmed();
+						}
+						_betaReply = nullptr;
+					});
+			}
+			_requestTimeoutTimer.start();
 		}
 	}
 
@@ -198,6 +239,35 @@ private:
 	}
 
 	// Private methods
+	/** Sends a GET request (revalidating the cached copy, if any), the handler being called when it finished. Versions are compared once all the requests finished. */
+	QNetworkReply* get(QString const& url, std::function<void(QNetworkReply*)> const& handler) noexcept
+	{
+		auto request = QNetworkRequest{ QUrl{ url } };
+		request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferNetwork);
+		auto* const reply = _webCtrl.get(request);
+		connect(reply, &QNetworkReply::finished, this,
+			[this, reply, handler]()
+			{
+				handler(reply);
+				reply->deleteLater();
+
+				if (!_releaseReply && !_betaReply)
+				{
+					_requestTimeoutTimer.stop();
+					if (_releaseError.isEmpty())
+					{
+						compareVersions();
+					}
+					else
+					{
+						_checkInProgress = false;
+						emit checkFailed(_releaseError);
+					}
+				}
+			});
+		return reply;
+	}
+
 	void compareVersions() noexcept
 	{
 		try
@@ -227,8 +297,13 @@ private:
 
 	// Private members
 	std::atomic_bool _checkInProgress{ false };
-	QNetworkAccessManager _webCtrlRelease{};
-	QNetworkAccessManager _webCtrlBeta{};
+	QNetworkAccessManager _webCtrl{};
+	QNetworkReply* _releaseReply{ nullptr }; // Release appcast request in progress
+	QNetworkReply* _betaReply{ nullptr }; // Beta appcast request in progress
+	QString _releaseError{};
+	QTimer _requestTimeoutTimer{};
+	QTimer _automaticCheckTimer{};
+	bool _isAutomaticCheckDone{ false }; // The automatic check is only deferred for the first controller of the session
 	bool _automaticCheckNewVersion{ false };
 	bool _checkBetaVersion{ false };
 	QString _newReleaseVersionString{};
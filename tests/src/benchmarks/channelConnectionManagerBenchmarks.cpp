@@ -0,0 +1,163 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "benchmark.hpp"
+#include "virtualNetworkFixture.hpp"
+#include "channelConnectionsOracle.hpp"
+#include "avdecc/controllerManager.hpp"
+#include "avdecc/channelConnectionManager.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+/** The reference network: 300 entities, about 20k channels */
+static networkGenerator::NetworkParameters const s_networkParameters{};
+
+class ChannelConnectionManagerBenchmark : public benchmarkSupport::VirtualNetworkFixture<s_networkParameters>
+{
+protected:
+	/** Output channel of the (single) talker stream port, clusters being numbered from the base cluster of the port */
+	static avdecc::ChannelIdentification talkerChannel(la::avdecc::entity::model::ClusterIndex const clusterOffset) noexcept
+	{
+		auto const baseCluster = static_cast<la::avdecc::entity::model::ClusterIndex>(s_networkParameters.streamInputsCount * s_networkParameters.clustersPerStream);
+		return avdecc::ChannelIdentification{ 0u, static_cast<la::avdecc::entity::model::ClusterIndex>(baseCluster + clusterOffset), 0u, avdecc::ChannelConnectionDirection::OutputToInput, la::avdecc::entity::model::AudioUnitIndex{ 0u }, la::avdecc::entity::model::StreamPortIndex{ 0u }, baseCluster };
+	}
+
+	static avdecc::ChannelIdentification listenerChannel(la::avdecc::entity::model::ClusterIndex const clusterOffset) noexcept
+	{
+		return avdecc::ChannelIdentification{ 0u, clusterOffset, 0u, avdecc::ChannelConnectionDirection::InputToOutput, la::avdecc::entity::model::AudioUnitIndex{ 0u }, la::avdecc::entity::model::StreamPortIndex{ 0u }, la::avdecc::entity::model::ClusterIndex{ 0u } };
+	}
+
+	static la::avdecc::entity::model::ClusterIndex talkerClustersCount() noexcept
+	{
+		return static_cast<la::avdecc::entity::model::ClusterIndex>(s_networkParameters.streamOutputsCount * s_networkParameters.clustersPerStream);
+	}
+};
+
+TEST_F(ChannelConnectionManagerBenchmark, GetChannelConnections)
+{
+	auto& manager = avdecc::ChannelConnectionManager::getInstance();
+
+	// First pass fills the cache, second pass only hits it
+	for (auto const* const pass : { "cold", "warm" })
+	{
+		benchmarkSupport::measure(std::string{ "ChannelConnectionManager.GetChannelConnections(all talker channels, " } + pass + ")", 1u,
+			[this, &manager](std::size_t const)
+			{
+				for (auto const& entityID : _entityIDs)
+				{
+					for (auto cluster = la::avdecc::entity::model::ClusterIndex{ 0u }; cluster < talkerClustersCount(); ++cluster)
+					{
+						manager.getChannelConnections(entityID, talkerChannel(cluster));
+					}
+				}
+			});
+	}
+
+	// The oracle being slow, only a subset of the talkers is checked
+	auto mismatches = std::size_t{ 0u };
+	auto connectedCount = std::size_t{ 0u };
+	for (auto index = 0u; index < _entityIDs.size(); index += 10u)
+	{
+		auto const& entityID = _entityIDs[index];
+		for (auto cluster = la::avdecc::entity::model::ClusterIndex{ 0u }; cluster < talkerClustersCount(); ++cluster)
+		{
+			auto const channel = talkerChannel(cluster);
+			auto const connections = manager.getChannelConnections(entityID, channel);
+			ASSERT_TRUE(!!connections);
+			auto const optimized = channelConnectionsOracle::toConnectedChannels(*connections);
+			auto const reference = channelConnectionsOracle::referenceChannelConnections(entityID, channel, _entityIDs);
+			connectedCount += reference.size();
+			if (optimized != reference)
+			{
+				++mismatches;
+			}
+		}
+	}
+	EXPECT_EQ(0u, mismatches);
+	EXPECT_GT(connectedCount, 0u);
+}
+
+TEST_F(ChannelConnectionManagerBenchmark, GetAllChannelConnectionsBetweenDevices)
+{
+	auto& manager = avdecc::ChannelConnectionManager::getInstance();
+
+	// Only pairs of entities with at least one connected stream
+	auto pairs = std::vector<std::pair<la::avdecc::UniqueIdentifier, la::avdecc::UniqueIdentifier>>{};
+	for (auto const& talkerID : _entityIDs)
+	{
+		for (auto const& listenerID : channelConnectionsOracle::connectedListeners(talkerID, _entityIDs))
+		{
+			pairs.emplace_back(talkerID, listenerID);
+		}
+	}
+	ASSERT_FALSE(pairs.empty());
+
+	benchmarkSupport::measure("ChannelConnectionManager.GetAllChannelConnectionsBetweenDevices(" + std::to_string(pairs.size()) + " connected pairs)", 3u,
+		[&manager, &pairs](std::size_t const)
+		{
+			for (auto const& [talkerID, listenerID] : pairs)
+			{
+				manager.getAllChannelConnectionsBetweenDevices(talkerID, la::avdecc::entity::model::StreamPortIndex{ 0u }, listenerID);
+			}
+		});
+
+	auto mismatches = std::size_t{ 0u };
+	for (auto const& [talkerID, listenerID] : pairs)
+	{
+		auto const connections = manager.getAllChannelConnectionsBetweenDevices(talkerID, la::avdecc::entity::model::StreamPortIndex{ 0u }, listenerID);
+		ASSERT_TRUE(!!connections);
+		if (channelConnectionsOracle::toConnectedChannels(*connections) != channelConnectionsOracle::referenceAllChannelConnectionsBetweenDevices(talkerID, la::avdecc::entity::model::StreamPortIndex{ 0u }, listenerID))
+		{
+			++mismatches;
+		}
+	}
+	EXPECT_EQ(0u, mismatches);
+}
+
+TEST_F(ChannelConnectionManagerBenchmark, CheckChannelConnections)
+{
+	auto& manager = avdecc::ChannelConnectionManager::getInstance();
+
+	// Plan the connection of all the channels of a talker stream to the first listener stream, between neighbour entities
+	auto connections = std::vector<std::pair<avdecc::ChannelIdentification, avdecc::ChannelIdentification>>{};
+	for (auto channel = la::avdecc::entity::model::ClusterIndex{ 0u }; channel < s_networkParameters.clustersPerStream; ++channel)
+	{
+		connections.emplace_back(talkerChannel(channel), listenerChannel(channel));
+	}
+
+	for (auto const allowChanges : { false, true })
+	{
+		benchmarkSupport::measure(std::string{ "ChannelConnectionManager.CheckChannelConnections(" } + std::to_string(_entityIDs.size()) + " pairs, " + (allowChanges ? "allowing" : "without") + " mapping changes)", 1u,
+			[this, &manager, &connections, allowChanges](std::size_t const)
+			{
+				for (auto index = 0u; index < _entityIDs.size(); ++index)
+				{
+					manager.checkChannelConnections(_entityIDs[index], _entityIDs[(index + 1u) % _entityIDs.size()], connections, allowChanges, allowChanges);
+				}
+			});
+	}
+}
+
+} // namespace
@@ -0,0 +1,179 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "benchmark.hpp"
+#include "virtualNetworkFixture.hpp"
+#include "connectionMatrix/model.hpp"
+#include "avdecc/controllerManager.hpp"
+#include "avdecc/channelConnectionManager.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+
+namespace
+{
+/** The reference network: 300 entities, about 20k channels */
+static networkGenerator::NetworkParameters const s_networkParameters{};
+
+class ConnectionMatrixBenchmark : public benchmarkSupport::VirtualNetworkFixture<s_networkParameters>
+{
+protected:
+	virtual void SetUp() override
+	{
+		ASSERT_NO_FATAL_FAILURE(VirtualNetworkFixture::SetUp());
+
+		// The model is created after the entities went online, as a newly opened matrix would
+		_model = std::make_unique<connectionMatrix::Model>();
+		emit avdecc::ControllerManager::getInstance().entitiesOnline(_entityIDs);
+		benchmarkSupport::processPendingEvents();
+	}
+
+	virtual void TearDown() override
+	{
+		_model.reset();
+		benchmarkSupport::processPendingEvents();
+	}
+
+	/** Visits all the intersections of the model */
+	std::size_t visitIntersections() const
+	{
+		auto count = std::size_t{ 0u };
+		auto const rows = _model->rowCount();
+		auto const columns = _model->columnCount();
+		for (auto row = 0; row < rows; ++row)
+		{
+			for (auto column = 0; column < columns; ++column)
+			{
+				auto const data = _model->intersectionData(_model->index(row, column));
+				if (data.type != connectionMatrix::Model::IntersectionData::Type::None)
+				{
+					++count;
+				}
+			}
+		}
+		return count;
+	}
+
+	std::unique_ptr<connectionMatrix::Model> _model{};
+};
+
+TEST_F(ConnectionMatrixBenchmark, BulkEntitiesOfflineOnline)
+{
+	auto& manager = avdecc::ControllerManager::getInstance();
+
+	benchmarkSupport::measure("ConnectionMatrix.EntitiesOffline+EntitiesOnline", 5u,
+		[this, &manager](std::size_t const)
+		{
+			emit manager.entitiesOffline(_entityIDs);
+			emit manager.entitiesOnline(_entityIDs);
+		});
+
+	EXPECT_GT(_model->rowCount(), 0);
+}
+
+TEST_F(ConnectionMatrixBenchmark, SetModeChannel)
+{
+	benchmarkSupport::measure("ConnectionMatrix.SetMode(Channel+Stream)", 5u,
+		[this](std::size_t const)
+		{
+			_model->setMode(connectionMatrix::Model::Mode::Channel);
+			_model->setMode(connectionMatrix::Model::Mode::Stream);
+		});
+}
+
+TEST_F(ConnectionMatrixBenchmark, SetTransposed)
+{
+	for (auto const mode : { connectionMatrix::Model::Mode::Stream, connectionMatrix::Model::Mode::Channel })
+	{
+		_model->setMode(mode);
+		benchmarkSupport::measure(std::string{ "ConnectionMatrix.SetTransposed(" } + (mode == connectionMatrix::Model::Mode::Stream ? "Stream" : "Channel") + ")", 10u,
+			[this](std::size_t const iteration)
+			{
+				_model->setTransposed(iteration % 2u == 0u);
+			});
+	}
+}
+
+TEST_F(ConnectionMatrixBenchmark, StreamConnectionChangedStorm)
+{
+	auto& manager = avdecc::ControllerManager::getInstance();
+	auto const& entities = s_network->entities();
+
+	// Every listener stream is connected then disconnected, as a venue reload would do
+	benchmarkSupport::measure("ConnectionMatrix.StreamConnectionChanged(all listener streams)", 2u,
+		[&manager, &entities](std::size_t const iteration)
+		{
+			for (auto listenerIndex = 0u; listenerIndex < entities.size(); ++listenerIndex)
+			{
+				auto const& listener = entities[listenerIndex];
+				auto const& talker = entities[(listenerIndex + 1u) % entities.size()];
+				auto const streamsCount = static_cast<la::avdecc::entity::model::StreamIndex>(s_networkParameters.streamInputsCount * (listener.isRedundant ? 2u : 1u));
+				for (auto streamIndex = la::avdecc::entity::model::StreamIndex{ 0u }; streamIndex < streamsCount; ++streamIndex)
+				{
+					auto state = la::avdecc::entity::model::StreamConnectionState{};
+					state.listenerStream = la::avdecc::entity::model::StreamIdentification{ listener.entityID, streamIndex };
+					state.talkerStream = la::avdecc::entity::model::StreamIdentification{ talker.entityID, streamIndex };
+					state.state = iteration % 2u == 0u ? la::avdecc::entity::model::StreamConnectionState::State::Connected : la::avdecc::entity::model::StreamConnectionState::State::NotConnected;
+					emit manager.streamConnectionChanged(state);
+				}
+			}
+		});
+}
+
+TEST_F(ConnectionMatrixBenchmark, ListenerChannelConnectionsUpdate)
+{
+	_model->setMode(connectionMatrix::Model::Mode::Channel);
+
+	// All the listener channels of the network
+	auto channels = std::set<std::pair<la::avdecc::UniqueIdentifier, avdecc::ChannelIdentification>>{};
+	auto const clustersCount = static_cast<la::avdecc::entity::model::ClusterIndex>(s_networkParameters.streamInputsCount * s_networkParameters.clustersPerStream);
+	for (auto const& entity : s_network->entities())
+	{
+		for (auto cluster = la::avdecc::entity::model::ClusterIndex{ 0u }; cluster < clustersCount; ++cluster)
+		{
+			channels.emplace(entity.entityID, avdecc::ChannelIdentification{ 0u, cluster, 0u, avdecc::ChannelConnectionDirection::InputToOutput, la::avdecc::entity::model::AudioUnitIndex{ 0u }, la::avdecc::entity::model::StreamPortIndex{ 0u }, la::avdecc::entity::model::ClusterIndex{ 0u } });
+		}
+	}
+
+	auto& channelConnectionManager = avdecc::ChannelConnectionManager::getInstance();
+	benchmarkSupport::measure("ConnectionMatrix.ListenerChannelConnectionsUpdate(all listener channels)", 5u,
+		[&channelConnectionManager, &channels](std::size_t const)
+		{
+			emit channelConnectionManager.listenerChannelConnectionsUpdate(channels);
+		});
+}
+
+TEST_F(ConnectionMatrixBenchmark, IntersectionDataLookup)
+{
+	for (auto const mode : { connectionMatrix::Model::Mode::Stream, connectionMatrix::Model::Mode::Channel })
+	{
+		_model->setMode(mode);
+		auto count = std::size_t{ 0u };
+		benchmarkSupport::measure(std::string{ "ConnectionMatrix.IntersectionData(" } + (mode == connectionMatrix::Model::Mode::Stream ? "Stream" : "Channel") + ", all cells)", 3u,
+			[this, &count](std::size_t const)
+			{
+				count = visitIntersections();
+			});
+		EXPECT_GT(count, 0u);
+	}
+}
+
+} // namespace
@@ -0,0 +1,238 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "benchmark.hpp"
+#include "virtualNetworkFixture.hpp"
+#include "entityLogoCache.hpp"
+#include "connectionMatrix/model.hpp"
+#include "avdecc/controllerManager.hpp"
+#include "avdecc/controllerModel.hpp"
+#include "avdecc/latencyHistogram.hpp"
+#include "avdecc/mcDomainManager.hpp"
+#include "avdecc/memoryAccounting.hpp"
+#include "avdecc/observerTrace.hpp"
+
+#include <gtest/gtest.h>
+
+#include <QAbstractEventDispatcher>
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace
+{
+/** Large network with few streams, so the per entity bookkeeping dominates the cost of a cycle */
+static networkGenerator::NetworkParameters const s_networkParameters{ 2000u, 2u, 2u, 0.0f, 2u, 1.0f, 0.5f, 0u };
+/** Offline/online cycles applied to the whole network */
+static constexpr auto ChurnCycles = std::size_t{ 10u };
+/** First cycles not taken into account for the memory reference, the caches being filled during these */
+static constexpr auto WarmUpCycles = std::size_t{ 2u };
+/** Maximum duration of a single offline or online wave */
+static constexpr auto WaveTimeout = std::chrono::seconds{ 60 };
+
+/** Counters of all the subsystems, indexed by "Subsystem.Counter" */
+using MemoryCounters = std::map<std::string, std::uint64_t>;
+
+MemoryCounters collectMemoryCounters() noexcept
+{
+	auto counters = MemoryCounters{};
+	for (auto const& subsystem : avdecc::MemoryAccounting::getInstance().collect())
+	{
+		for (auto const& counter : subsystem.counters)
+		{
+			counters[(subsystem.subsystem + "." + counter.name).toStdString()] += counter.value;
+		}
+	}
+	return counters;
+}
+
+/**
+* Drives the entities offline and online again through the observer trace replay (the same path as a real device leaving and joining the network),
+* with every manager singleton and the main models attached, to measure the per entity cost and detect what is not released when an entity goes offline.
+*/
+class EntityChurnBenchmark : public benchmarkSupport::VirtualNetworkFixture<s_networkParameters>
+{
+public:
+	static void SetUpTestCase()
+	{
+		// Create the remaining managers before any entity goes online, like the application does (ChannelConnectionManager is created by main)
+		avdecc::mediaClock::MCDomainManager::getInstance();
+		EntityLogoCache::getInstance();
+
+		VirtualNetworkFixture::SetUpTestCase();
+	}
+
+protected:
+	virtual void SetUp() override
+	{
+		ASSERT_NO_FATAL_FAILURE(VirtualNetworkFixture::SetUp());
+		ASSERT_TRUE(_traceDirectory.isValid());
+
+		_controllerModel = std::make_unique<avdecc::ControllerModel>();
+		_matrixModel = std::make_unique<connectionMatrix::Model>();
+		benchmarkSupport::processPendingEvents();
+
+		// One trace per wave, replayed as fast as possible
+		ASSERT_TRUE(writeTrace(offlineTracePath(), avdecc::observerTrace::EventType::EntityOffline));
+		ASSERT_TRUE(writeTrace(onlineTracePath(), avdecc::observerTrace::EventType::EntityOnline));
+
+		connectReplayFinished();
+	}
+
+	virtual void TearDown() override
+	{
+		QObject::disconnect(_replayFinishedConnection);
+		_matrixModel.reset();
+		_controllerModel.reset();
+		benchmarkSupport::processPendingEvents();
+	}
+
+	QString offlineTracePath() const
+	{
+		return _traceDirectory.filePath("offline.trace");
+	}
+
+	QString onlineTracePath() const
+	{
+		return _traceDirectory.filePath("online.trace");
+	}
+
+	bool writeTrace(QString const& filePath, avdecc::observerTrace::EventType const type) const
+	{
+		auto recorder = avdecc::observerTrace::Recorder{};
+		if (!recorder.start(filePath))
+		{
+			return false;
+		}
+		for (auto const& entity : s_network->entities())
+		{
+			recorder.record(type, entity.entityID);
+		}
+		recorder.stop();
+		return true;
+	}
+
+	void connectReplayFinished()
+	{
+		_replayFinishedConnection = QObject::connect(&avdecc::ControllerManager::getInstance(), &avdecc::ControllerManager::observerTraceReplayFinished, &avdecc::ControllerManager::getInstance(),
+			[this](int const /*replayedCount*/, int const /*skippedCount*/)
+			{
+				_replayFinished = true;
+			});
+	}
+
+	/** Replays the trace and processes events until the controller model holds the expected rows, returning the duration of the wave. Each event loop pass doing some work is added to the histogram */
+	std::chrono::nanoseconds runWave(QString const& tracePath, int const expectedRowCount)
+	{
+		_replayFinished = false;
+		auto* const dispatcher = QAbstractEventDispatcher::instance();
+		auto const start = std::chrono::steady_clock::now();
+
+		EXPECT_TRUE(avdecc::ControllerManager::getInstance().startObserverTraceReplay(tracePath, false));
+
+		while (!(_replayFinished && _controllerModel->rowCount() == expectedRowCount) && std::chrono::steady_clock::now() - start < WaveTimeout)
+		{
+			auto const passStart = std::chrono::steady_clock::now();
+			if (dispatcher->processEvents(QEventLoop::AllEvents))
+			{
+				_eventLoopPasses.add(std::chrono::duration_cast<avdecc::LatencyHistogram::Duration>(std::chrono::steady_clock::now() - passStart));
+			}
+		}
+		// Let the deferred notifications (frame scheduler, throttled refreshes) settle, outside of the measurement
+		auto const duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+		benchmarkSupport::processPendingEvents();
+
+		EXPECT_EQ(expectedRowCount, _controllerModel->rowCount());
+		return duration;
+	}
+
+	QTemporaryDir _traceDirectory{};
+	std::unique_ptr<avdecc::ControllerModel> _controllerModel{};
+	std::unique_ptr<connectionMatrix::Model> _matrixModel{};
+	QMetaObject::Connection _replayFinishedConnection{};
+	bool _replayFinished{ false };
+	avdecc::LatencyHistogram _eventLoopPasses{};
+};
+
+TEST_F(EntityChurnBenchmark, OfflineOnlineCycles)
+{
+	auto const entitiesCount = static_cast<int>(s_network->entities().size());
+	ASSERT_EQ(entitiesCount, _controllerModel->rowCount());
+
+	auto offline = benchmarkSupport::Measurement{};
+	offline.name = "Gui.EntityChurn.Offline(per entity)";
+	auto online = benchmarkSupport::Measurement{};
+	online.name = "Gui.EntityChurn.Online(per entity)";
+
+	auto const peakBefore = benchmarkSupport::peakMemoryUsage();
+	auto afterWarmUp = MemoryCounters{};
+
+	for (auto cycle = std::size_t{ 0u }; cycle < ChurnCycles; ++cycle)
+	{
+		offline.total += runWave(offlineTracePath(), 0);
+		online.total += runWave(onlineTracePath(), entitiesCount);
+		offline.iterations += static_cast<std::size_t>(entitiesCount);
+		online.iterations += static_cast<std::size_t>(entitiesCount);
+
+		if (cycle + 1u == WarmUpCycles)
+		{
+			afterWarmUp = collectMemoryCounters();
+		}
+	}
+
+	offline.peakMemory = online.peakMemory = benchmarkSupport::peakMemoryUsage();
+	offline.peakMemoryGrowth = online.peakMemoryGrowth = offline.peakMemory - std::min(offline.peakMemory, peakBefore);
+	benchmarkSupport::report(offline);
+	benchmarkSupport::report(online);
+
+	// Distribution of the GUI thread time: a long pass is a visible freeze
+	auto passes = benchmarkSupport::Measurement{};
+	passes.name = "Gui.EntityChurn.EventLoopPass";
+	passes.iterations = static_cast<std::size_t>(_eventLoopPasses.count());
+	passes.total = offline.total + online.total;
+	passes.peakMemory = offline.peakMemory;
+	passes.values = {
+		{ "p50_ms", _eventLoopPasses.percentile(0.50).count() / 1000.0 },
+		{ "p90_ms", _eventLoopPasses.percentile(0.90).count() / 1000.0 },
+		{ "p99_ms", _eventLoopPasses.percentile(0.99).count() / 1000.0 },
+		{ "max_ms", _eventLoopPasses.max().count() / 1000.0 },
+	};
+	benchmarkSupport::report(passes);
+
+	// The containers must not grow once the caches are warm: every cycle brings the network back to the same state
+	auto const finalCounters = collectMemoryCounters();
+	auto memory = benchmarkSupport::Measurement{};
+	memory.name = "Gui.EntityChurn.Memory";
+	memory.iterations = ChurnCycles - WarmUpCycles;
+	memory.peakMemory = offline.peakMemory;
+	for (auto const& [name, value] : finalCounters)
+	{
+		auto const reference = afterWarmUp[name];
+		memory.values.emplace_back(name + ".afterWarmUp", static_cast<double>(reference));
+		memory.values.emplace_back(name + ".final", static_cast<double>(value));
+		EXPECT_LE(value, reference) << name << " grew over " << (ChurnCycles - WarmUpCycles) << " offline/online cycles";
+	}
+	benchmarkSupport::report(memory);
+}
+
+} // namespace
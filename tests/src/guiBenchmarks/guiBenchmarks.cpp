@@ -0,0 +1,298 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "benchmark.hpp"
+#include "virtualNetworkFixture.hpp"
+#include "controlledEntityTreeWidget.hpp"
+#include "nodeTreeWidget.hpp"
+#include "nodeVisitor.hpp"
+#include "connectionMatrix/view.hpp"
+#include "avdecc/controllerManager.hpp"
+#include "avdecc/controllerModel.hpp"
+#include "avdecc/hiveLogItems.hpp"
+#include "avdecc/loggerModel.hpp"
+#include "avdecc/stressLoad.hpp"
+
+#include <gtest/gtest.h>
+
+#include <QImage>
+#include <QTableView>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+/** The reference network: 300 entities, about 20k channels */
+static networkGenerator::NetworkParameters const s_networkParameters{};
+/** Viewport every widget is rendered into, the size of a typical maximized panel */
+static QSize const s_viewport{ 1280, 800 };
+/** Frames rendered per paint measurement */
+static constexpr auto PaintIterations = std::size_t{ 20u };
+/** Duration of the synthetic churn applied to the whole GUI */
+static constexpr auto StressLoadDuration = std::chrono::seconds{ 10 };
+/** Environment variable specifying an observer trace to replay on the synthetic network (the trace must have been recorded on a network with the same entity IDs) */
+static auto constexpr TraceEnvironmentVariable = "HIVE_BENCHMARK_TRACE";
+
+class GuiBenchmark : public benchmarkSupport::VirtualNetworkFixture<s_networkParameters>
+{
+protected:
+	virtual void SetUp() override
+	{
+		ASSERT_NO_FATAL_FAILURE(VirtualNetworkFixture::SetUp());
+
+		// The widgets are created after the entities went online, as newly opened views would
+		_controllerModel = std::make_unique<avdecc::ControllerModel>();
+		_controllerView = std::make_unique<QTableView>();
+		_controllerView->setModel(_controllerModel.get());
+
+		_loggerModel = std::make_unique<avdecc::LoggerModel>();
+		_loggerView = std::make_unique<QTableView>();
+		_loggerView->setModel(_loggerModel.get());
+
+		_matrixView = std::make_unique<connectionMatrix::View>();
+		_entityTreeWidget = std::make_unique<ControlledEntityTreeWidget>();
+		_nodeTreeWidget = std::make_unique<NodeTreeWidget>();
+
+		emit avdecc::ControllerManager::getInstance().entitiesOnline(_entityIDs);
+		benchmarkSupport::processPendingEvents();
+
+		// Inspect the first stream input of the first entity, the one receiving counters updates in the benchmarks
+		auto const entityID = _entityIDs.front();
+		_entityTreeWidget->setControlledEntityID(entityID);
+		if (auto controlledEntity = avdecc::ControllerManager::getInstance().getControlledEntity(entityID))
+		{
+			auto const& entityNode = controlledEntity->getEntityNode();
+			auto const& streamNode = controlledEntity->getStreamInputNode(entityNode.dynamicModel->currentConfiguration, la::avdecc::entity::model::StreamIndex{ 0u });
+			_nodeTreeWidget->setNode(entityID, true, AnyNode{ &streamNode });
+		}
+
+		for (auto* widget : widgets())
+		{
+			widget->resize(s_viewport);
+			widget->show();
+		}
+		benchmarkSupport::processPendingEvents();
+	}
+
+	virtual void TearDown() override
+	{
+		_nodeTreeWidget.reset();
+		_entityTreeWidget.reset();
+		_matrixView.reset();
+		_loggerView.reset();
+		_loggerModel.reset();
+		_controllerView.reset();
+		_controllerModel.reset();
+		benchmarkSupport::processPendingEvents();
+	}
+
+	std::vector<QWidget*> widgets() const
+	{
+		return { _controllerView.get(), _loggerView.get(), _matrixView.get(), _entityTreeWidget.get(), _nodeTreeWidget.get() };
+	}
+
+	/** Renders all the widgets once, as a frame of the main window would */
+	void renderFrame()
+	{
+		auto image = QImage{ s_viewport, QImage::Format_ARGB32_Premultiplied };
+		for (auto* widget : widgets())
+		{
+			widget->render(&image);
+		}
+	}
+
+	/** Processes events and renders frames until the predicate returns true, reporting the frame time */
+	void measureFramesUntil(std::string const& name, std::function<bool()> const& predicate, std::chrono::milliseconds const timeout)
+	{
+		auto measurement = benchmarkSupport::Measurement{};
+		measurement.name = name;
+
+		auto const peakBefore = benchmarkSupport::peakMemoryUsage();
+		auto const start = std::chrono::steady_clock::now();
+
+		while (!predicate() && std::chrono::steady_clock::now() - start < timeout)
+		{
+			benchmarkSupport::processPendingEvents();
+			renderFrame();
+			++measurement.iterations;
+		}
+
+		measurement.total = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+		measurement.peakMemory = benchmarkSupport::peakMemoryUsage();
+		measurement.peakMemoryGrowth = measurement.peakMemory - std::min(measurement.peakMemory, peakBefore);
+		benchmarkSupport::report(measurement);
+	}
+
+	std::unique_ptr<avdecc::ControllerModel> _controllerModel{};
+	std::unique_ptr<QTableView> _controllerView{};
+	std::unique_ptr<avdecc::LoggerModel> _loggerModel{};
+	std::unique_ptr<QTableView> _loggerView{};
+	std::unique_ptr<connectionMatrix::View> _matrixView{};
+	std::unique_ptr<ControlledEntityTreeWidget> _entityTreeWidget{};
+	std::unique_ptr<NodeTreeWidget> _nodeTreeWidget{};
+};
+
+TEST_F(GuiBenchmark, ControllerModelEntityNameChanged)
+{
+	auto& manager = avdecc::ControllerManager::getInstance();
+
+	benchmarkSupport::measure("Gui.ControllerModel.EntityNameChanged(per event)", _entityIDs.size(),
+		[this, &manager](std::size_t const iteration)
+		{
+			emit manager.entityNameChanged(_entityIDs[iteration], QString("Renamed %1").arg(iteration));
+		});
+	benchmarkSupport::measurePaint("Gui.ControllerModel.Paint", *_controllerView, s_viewport, PaintIterations);
+}
+
+TEST_F(GuiBenchmark, LoggerModelEntries)
+{
+	static constexpr auto EntriesPerBatch = 1000;
+
+	// Entries are inserted by the model at a bounded rate, so each batch is measured up to its insertion
+	benchmarkSupport::measure("Gui.LoggerModel.LogEntries(per batch of 1000)", 10u,
+		[this](std::size_t const iteration)
+		{
+			auto const rowCount = _loggerModel->rowCount();
+			for (auto entry = 0; entry < EntriesPerBatch; ++entry)
+			{
+				LOG_HIVE_INFO(QString("Benchmark batch %1 entry %2").arg(iteration).arg(entry));
+			}
+			benchmarkSupport::processEventsUntil(
+				[this, rowCount]()
+				{
+					return _loggerModel->rowCount() != rowCount;
+				},
+				std::chrono::seconds{ 1 });
+		});
+	benchmarkSupport::measurePaint("Gui.LoggerModel.Paint", *_loggerView, s_viewport, PaintIterations);
+}
+
+TEST_F(GuiBenchmark, ConnectionMatrixStreamConnectionChanged)
+{
+	auto& manager = avdecc::ControllerManager::getInstance();
+	auto const& entities = s_network->entities();
+
+	benchmarkSupport::measure("Gui.ConnectionMatrix.StreamConnectionChanged(per event)", entities.size() * 2u,
+		[&manager, &entities](std::size_t const iteration)
+		{
+			auto const listenerIndex = iteration % entities.size();
+			auto state = la::avdecc::entity::model::StreamConnectionState{};
+			state.listenerStream = la::avdecc::entity::model::StreamIdentification{ entities[listenerIndex].entityID, la::avdecc::entity::model::StreamIndex{ 0u } };
+			state.talkerStream = la::avdecc::entity::model::StreamIdentification{ entities[(listenerIndex + 1u) % entities.size()].entityID, la::avdecc::entity::model::StreamIndex{ 0u } };
+			state.state = iteration < entities.size() ? la::avdecc::entity::model::StreamConnectionState::State::Connected : la::avdecc::entity::model::StreamConnectionState::State::NotConnected;
+			emit manager.streamConnectionChanged(state);
+		});
+	benchmarkSupport::measurePaint("Gui.ConnectionMatrix.Paint", *_matrixView, s_viewport, PaintIterations);
+}
+
+TEST_F(GuiBenchmark, ControlledEntityTreeWidgetSelection)
+{
+	benchmarkSupport::measure("Gui.ControlledEntityTreeWidget.SetControlledEntityID(per entity)", _entityIDs.size(),
+		[this](std::size_t const iteration)
+		{
+			_entityTreeWidget->setControlledEntityID(_entityIDs[iteration]);
+		});
+	benchmarkSupport::measurePaint("Gui.ControlledEntityTreeWidget.Paint", *_entityTreeWidget, s_viewport, PaintIterations);
+}
+
+TEST_F(GuiBenchmark, NodeTreeWidgetStreamInputCounters)
+{
+	auto& manager = avdecc::ControllerManager::getInstance();
+	auto const entityID = _entityIDs.front();
+
+	benchmarkSupport::measure("Gui.NodeTreeWidget.StreamInputCountersChanged(per event)", 1000u,
+		[&manager, entityID](std::size_t const iteration)
+		{
+			auto counters = la::avdecc::entity::model::StreamInputCounters{};
+			counters[la::avdecc::entity::StreamInputCounterValidFlag::MediaLocked] = static_cast<la::avdecc::entity::model::DescriptorCounter>(iteration / 2u);
+			counters[la::avdecc::entity::StreamInputCounterValidFlag::FramesRx] = static_cast<la::avdecc::entity::model::DescriptorCounter>(iteration * 100u);
+			emit manager.streamInputCountersChanged(entityID, la::avdecc::entity::model::StreamIndex{ 0u }, counters);
+		});
+	benchmarkSupport::measurePaint("Gui.NodeTreeWidget.Paint", *_nodeTreeWidget, s_viewport, PaintIterations);
+}
+
+TEST_F(GuiBenchmark, StressLoadFrames)
+{
+	auto& manager = avdecc::ControllerManager::getInstance();
+
+	auto isFinished = false;
+	auto const connection = QObject::connect(&manager, &avdecc::ControllerManager::stressLoadFinished,
+		[&isFinished](int const, int const)
+		{
+			isFinished = true;
+		});
+
+	auto parameters = avdecc::stressLoad::Parameters{};
+	parameters.duration = StressLoadDuration;
+	ASSERT_TRUE(manager.startStressLoad(parameters));
+
+	measureFramesUntil(
+		"Gui.StressLoad.Frame(all widgets)",
+		[&isFinished]()
+		{
+			return isFinished;
+		},
+		StressLoadDuration + std::chrono::seconds{ 30 });
+
+	QObject::disconnect(connection);
+	manager.stopStressLoad();
+	EXPECT_TRUE(isFinished);
+}
+
+TEST_F(GuiBenchmark, TraceReplayFrames)
+{
+	auto const tracePath = qEnvironmentVariable(TraceEnvironmentVariable);
+	if (tracePath.isEmpty())
+	{
+		std::cout << "[ BENCHMARK ] No trace to replay (set " << TraceEnvironmentVariable << ")" << std::endl;
+		return;
+	}
+
+	auto& manager = avdecc::ControllerManager::getInstance();
+
+	auto isFinished = false;
+	auto const connection = QObject::connect(&manager, &avdecc::ControllerManager::observerTraceReplayFinished,
+		[&isFinished](int const replayedCount, int const skippedCount)
+		{
+			isFinished = true;
+			std::cout << "[ BENCHMARK ] Trace replayed: " << replayedCount << " event(s), " << skippedCount << " skipped" << std::endl;
+		});
+
+	// Replayed as fast as possible, the frame time then reflects the worst case
+	ASSERT_TRUE(manager.startObserverTraceReplay(tracePath, false));
+
+	measureFramesUntil(
+		"Gui.TraceReplay.Frame(all widgets)",
+		[&isFinished]()
+		{
+			return isFinished;
+		},
+		std::chrono::minutes{ 10 });
+
+	QObject::disconnect(connection);
+	manager.stopObserverTraceReplay();
+	EXPECT_TRUE(isFinished);
+}
+
+} // namespace
@@ -0,0 +1,64 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "benchmark.hpp"
+#include "avdecc/channelConnectionManager.hpp"
+
+#include <gtest/gtest.h>
+#include <la/avdecc/utils.hpp>
+
+#include <QApplication>
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		// Widgets are rendered offscreen, so the benchmarks can run on a headless machine (unless another platform is explicitly requested)
+		if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+		{
+			qputenv("QT_QPA_PLATFORM", "offscreen");
+		}
+
+		// Benchmarks drive the Qt widgets, which require a widgets application (and its event loop)
+		QApplication app(argc, argv);
+
+		// Initialize GoogleTest framework
+		::testing::InitGoogleTest(&argc, argv);
+		auto const resultsFilePath = benchmarkSupport::takeResultsOption(argc, argv);
+
+		// Disable ASSERTS so the settings do not have to be registered
+		la::avdecc::utils::disableAssert();
+
+		// Create the managers before any entity goes online, like the application does, so they index the whole network
+		avdecc::ChannelConnectionManager::getInstance();
+
+		// Run all benchmarks
+		auto const result = RUN_ALL_TESTS();
+
+		if (!resultsFilePath.isEmpty() && !benchmarkSupport::writeResults(resultsFilePath))
+		{
+			return 1;
+		}
+		return result;
+	}
+	catch (...)
+	{
+		return 1;
+	}
+}
@@ -0,0 +1,299 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "benchmark.hpp"
+#include "avdecc/controllerManager.hpp"
+#include "internals/config.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QImage>
+#include <QThread>
+#include <QWidget>
+
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+#if defined(_WIN32)
+#	include <Windows.h>
+#	include <Psapi.h>
+#else // !_WIN32
+#	include <sys/resource.h>
+#endif // _WIN32
+
+namespace benchmarkSupport
+{
+/** Name of the virtual network interface the synthetic entities are loaded on */
+static auto constexpr VirtualInterfaceName = "BenchmarkNetwork";
+/** Maximum time to wait for all the generated entities to go online */
+static constexpr auto LoadTimeout = std::chrono::minutes{ 5 };
+/** Command line option specifying the JSON results file */
+static auto constexpr ResultsOption = "--results=";
+
+static std::vector<Measurement>& measurements() noexcept
+{
+	static auto s_measurements = std::vector<Measurement>{};
+	return s_measurements;
+}
+
+static double toMilliseconds(std::chrono::nanoseconds const duration) noexcept
+{
+	return static_cast<double>(duration.count()) / 1000000.0;
+}
+
+std::size_t peakMemoryUsage() noexcept
+{
+#if defined(_WIN32)
+	auto counters = PROCESS_MEMORY_COUNTERS{};
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+	{
+		return static_cast<std::size_t>(counters.PeakWorkingSetSize);
+	}
+	return 0u;
+#else // !_WIN32
+	auto usage = rusage{};
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+	{
+		return 0u;
+	}
+#	if defined(__APPLE__)
+	return static_cast<std::size_t>(usage.ru_maxrss); // In bytes
+#	else // !__APPLE__
+	return static_cast<std::size_t>(usage.ru_maxrss) * 1024u; // In kilobytes
+#	endif // __APPLE__
+#endif // _WIN32
+}
+
+bool processEventsUntil(std::function<bool()> const& predicate, std::chrono::milliseconds const timeout) noexcept
+{
+	auto timer = QElapsedTimer{};
+	timer.start();
+
+	while (!predicate())
+	{
+		if (timer.elapsed() >= timeout.count())
+		{
+			return false;
+		}
+		QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+		QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+		QThread::yieldCurrentThread();
+	}
+	return true;
+}
+
+void processPendingEvents() noexcept
+{
+	QCoreApplication::sendPostedEvents();
+	QCoreApplication::processEvents(QEventLoop::AllEvents);
+	QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+}
+
+Measurement measure(std::string const& name, std::size_t const iterations, std::function<void(std::size_t const iteration)> const& function) noexcept
+{
+	auto measurement = Measurement{};
+	measurement.name = name;
+	measurement.iterations = iterations;
+
+	auto const peakBefore = peakMemoryUsage();
+	auto const start = std::chrono::steady_clock::now();
+
+	for (auto iteration = 0u; iteration < iterations; ++iteration)
+	{
+		function(iteration);
+		processPendingEvents();
+	}
+
+	measurement.total = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+	measurement.peakMemory = peakMemoryUsage();
+	measurement.peakMemoryGrowth = measurement.peakMemory - std::min(measurement.peakMemory, peakBefore);
+
+	report(measurement);
+	return measurement;
+}
+
+Measurement measurePaint(std::string const& name, QWidget& widget, QSize const& viewport, std::size_t const iterations) noexcept
+{
+	widget.resize(viewport);
+	widget.show();
+	processPendingEvents();
+
+	auto image = QImage{ viewport, QImage::Format_ARGB32_Premultiplied };
+
+	auto measurement = Measurement{};
+	measurement.name = name;
+	measurement.iterations = iterations;
+
+	auto const peakBefore = peakMemoryUsage();
+	auto const start = std::chrono::steady_clock::now();
+
+	for (auto iteration = 0u; iteration < iterations; ++iteration)
+	{
+		// Pending layout and update requests are part of a frame
+		processPendingEvents();
+		widget.render(&image);
+	}
+
+	measurement.total = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+	measurement.peakMemory = peakMemoryUsage();
+	measurement.peakMemoryGrowth = measurement.peakMemory - std::min(measurement.peakMemory, peakBefore);
+
+	report(measurement);
+	return measurement;
+}
+
+void report(Measurement const& measurement) noexcept
+{
+	measurements().push_back(measurement);
+
+	std::cout << "[ BENCHMARK ] " << measurement.name << ": " << measurement.iterations << " iteration(s), total " << std::fixed << std::setprecision(3) << toMilliseconds(measurement.total) << " ms, average " << toMilliseconds(measurement.average()) << " ms, peak memory " << (measurement.peakMemory / 1024u) << " KiB (+" << (measurement.peakMemoryGrowth / 1024u) << " KiB)" << std::endl;
+	for (auto const& [name, value] : measurement.values)
+	{
+		std::cout << "[ BENCHMARK ]   " << name << ": " << value << std::endl;
+	}
+}
+
+std::vector<Measurement> const& reportedMeasurements() noexcept
+{
+	return measurements();
+}
+
+bool writeResults(QString const& filePath) noexcept
+{
+	try
+	{
+		auto results = nlohmann::json::array();
+		for (auto const& measurement : measurements())
+		{
+			auto result = nlohmann::json{
+				{ "name", measurement.name },
+				{ "iterations", measurement.iterations },
+				{ "total_ms", toMilliseconds(measurement.total) },
+				{ "average_ms", toMilliseconds(measurement.average()) },
+				{ "peak_memory", measurement.peakMemory },
+				{ "peak_memory_growth", measurement.peakMemoryGrowth },
+			};
+			if (!measurement.values.empty())
+			{
+				auto values = nlohmann::json::object();
+				for (auto const& [name, value] : measurement.values)
+				{
+					values[name] = value;
+				}
+				result["values"] = std::move(values);
+			}
+			results.push_back(std::move(result));
+		}
+
+		auto const document = nlohmann::json{ { "version", hive::internals::versionString.toStdString() }, { "measurements", results } };
+
+		auto file = QFile{ filePath };
+		if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+		{
+			return false;
+		}
+		auto const content = document.dump(2);
+		return file.write(content.c_str(), static_cast<qint64>(content.size())) == static_cast<qint64>(content.size());
+	}
+	catch (...)
+	{
+		return false;
+	}
+}
+
+QString takeResultsOption(int& argc, char* argv[]) noexcept
+{
+	auto filePath = QString{};
+	auto const optionLength = std::strlen(ResultsOption);
+
+	auto kept = 1;
+	for (auto index = 1; index < argc; ++index)
+	{
+		if (std::strncmp(argv[index], ResultsOption, optionLength) == 0)
+		{
+			filePath = QString::fromLocal8Bit(argv[index] + optionLength);
+		}
+		else
+		{
+			argv[kept++] = argv[index];
+		}
+	}
+	argc = kept;
+
+	return filePath;
+}
+
+VirtualNetwork::VirtualNetwork(networkGenerator::NetworkParameters const& parameters) noexcept
+	: _parameters{ parameters }
+	, _entities{ networkGenerator::generateNetwork(parameters) }
+{
+	if (!_directory.isValid() || _entities.empty())
+	{
+		return;
+	}
+
+	auto& manager = avdecc::ControllerManager::getInstance();
+	try
+	{
+		manager.createController(la::avdecc::protocol::ProtocolInterface::Type::Virtual, VirtualInterfaceName, 0u, la::avdecc::UniqueIdentifier::getNullUniqueIdentifier(), "en");
+	}
+	catch (...)
+	{
+		return;
+	}
+
+	auto onlineCount = std::size_t{ 0u };
+	auto const connection = QObject::connect(&manager, &avdecc::ControllerManager::entitiesOnline,
+		[&onlineCount](avdecc::ControllerManager::EntityIDs const& entityIDs)
+		{
+			onlineCount += entityIDs.size();
+		});
+
+	auto const start = std::chrono::steady_clock::now();
+	auto const filePaths = networkGenerator::writeNetwork(_entities, _directory.path());
+	auto const loadedCount = networkGenerator::loadNetwork(filePaths);
+	auto const allOnline = processEventsUntil(
+		[this, &onlineCount]()
+		{
+			return onlineCount >= _entities.size();
+		},
+		LoadTimeout);
+	_isLoaded = loadedCount == _entities.size() && allOnline;
+	_loadDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+	QObject::disconnect(connection);
+
+	if (!_isLoaded)
+	{
+		std::cout << "Failed to load the synthetic network: " << loadedCount << "/" << _entities.size() << " entities loaded, " << onlineCount << " online" << std::endl;
+	}
+}
+
+VirtualNetwork::~VirtualNetwork() noexcept
+{
+	avdecc::ControllerManager::getInstance().destroyController();
+	processPendingEvents();
+}
+
+} // namespace benchmarkSupport
@@ -0,0 +1,125 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "networkGenerator.hpp"
+
+#include <QSize>
+#include <QString>
+#include <QTemporaryDir>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+class QWidget;
+
+namespace benchmarkSupport
+{
+/** Result of a timed operation */
+struct Measurement
+{
+	std::string name{};
+	std::size_t iterations{ 0u };
+	std::chrono::nanoseconds total{};
+	std::size_t peakMemory{ 0u }; // Peak resident memory of the process after the measurement (in bytes)
+	std::size_t peakMemoryGrowth{ 0u }; // Growth of the peak resident memory during the measurement (in bytes)
+	std::vector<std::pair<std::string, double>> values{}; // Additional named values (distribution percentiles, counters), reported as is
+
+	std::chrono::nanoseconds average() const noexcept
+	{
+		return iterations != 0u ? total / iterations : std::chrono::nanoseconds{};
+	}
+};
+
+/** Peak resident memory of the process since it started (in bytes), 0 if not supported on the platform */
+std::size_t peakMemoryUsage() noexcept;
+
+/** Processes the Qt events until the predicate returns true or the timeout expires. Returns the last predicate result */
+bool processEventsUntil(std::function<bool()> const& predicate, std::chrono::milliseconds const timeout) noexcept;
+
+/** Processes all the pending Qt events, including the deferred ones */
+void processPendingEvents() noexcept;
+
+/** Calls the function iterations times (processing pending Qt events after each call, as part of the measurement) and prints the result */
+Measurement measure(std::string const& name, std::size_t const iterations, std::function<void(std::size_t const iteration)> const& function) noexcept;
+
+/** Renders the widget (resized to the viewport) iterations times into an offscreen image, processing pending Qt events before each frame as part of the measurement, and prints the result */
+Measurement measurePaint(std::string const& name, QWidget& widget, QSize const& viewport, std::size_t const iterations) noexcept;
+
+/** Prints a measurement in a stable format, so results can be compared between two builds, and keeps it for writeResults */
+void report(Measurement const& measurement) noexcept;
+
+/** All the measurements reported so far, in order */
+std::vector<Measurement> const& reportedMeasurements() noexcept;
+
+/** Writes all the measurements reported so far as a JSON file, to be compared between two builds by a script. Returns false if the file cannot be written */
+bool writeResults(QString const& filePath) noexcept;
+
+/** Removes the "--results=<file>" option from the command line (to be called after the test framework parsed its own options). Returns the file path, empty if not specified */
+QString takeResultsOption(int& argc, char* argv[]) noexcept;
+
+/** Synthetic network loaded in the avdecc::ControllerManager, using a Virtual ProtocolInterface. The controller is destroyed with the network */
+class VirtualNetwork final
+{
+public:
+	explicit VirtualNetwork(networkGenerator::NetworkParameters const& parameters) noexcept;
+	~VirtualNetwork() noexcept;
+
+	/** True if all the generated entities were loaded and went online */
+	bool isLoaded() const noexcept
+	{
+		return _isLoaded;
+	}
+
+	networkGenerator::NetworkParameters const& parameters() const noexcept
+	{
+		return _parameters;
+	}
+
+	networkGenerator::GeneratedEntities const& entities() const noexcept
+	{
+		return _entities;
+	}
+
+	/** Time it took to load the whole network, up to the last entity going online */
+	std::chrono::milliseconds loadDuration() const noexcept
+	{
+		return _loadDuration;
+	}
+
+	// Deleted compiler auto-generated methods
+	VirtualNetwork(VirtualNetwork const&) = delete;
+	VirtualNetwork(VirtualNetwork&&) = delete;
+	VirtualNetwork& operator=(VirtualNetwork const&) = delete;
+	VirtualNetwork& operator=(VirtualNetwork&&) = delete;
+
+private:
+	networkGenerator::NetworkParameters _parameters{};
+	networkGenerator::GeneratedEntities _entities{};
+	QTemporaryDir _directory{};
+	std::chrono::milliseconds _loadDuration{};
+	bool _isLoaded{ false };
+};
+
+} // namespace benchmarkSupport
@@ -0,0 +1,194 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "channelConnectionsOracle.hpp"
+#include "avdecc/controllerManager.hpp"
+
+#include <la/avdecc/controller/internals/avdeccControlledEntity.hpp>
+
+namespace channelConnectionsOracle
+{
+using StreamChannel = std::pair<la::avdecc::entity::model::StreamIndex, std::uint16_t>;
+
+/** Dynamic and static mappings of a talker stream port */
+static la::avdecc::entity::model::AudioMappings talkerMappings(la::avdecc::controller::ControlledEntity const& talker, la::avdecc::entity::model::StreamPortIndex const streamPortIndex)
+{
+	auto mappings = la::avdecc::entity::model::AudioMappings{};
+	auto const& streamPortNode = talker.getStreamPortOutputNode(talker.getCurrentConfigurationNode().descriptorIndex, streamPortIndex);
+	if (streamPortNode.dynamicModel)
+	{
+		mappings = streamPortNode.dynamicModel->dynamicAudioMap;
+	}
+	for (auto const& audioMap : streamPortNode.audioMaps)
+	{
+		mappings.insert(mappings.end(), audioMap.second.staticModel->mappings.begin(), audioMap.second.staticModel->mappings.end());
+	}
+	return mappings;
+}
+
+/** Adds the listener channels reached by the talker stream channels, considering all the listener streams (primary and secondary) connected to the talker */
+static void addListenerChannels(la::avdecc::UniqueIdentifier const talkerEntityID, std::set<StreamChannel> const& talkerStreamChannels, la::avdecc::UniqueIdentifier const listenerEntityID, ConnectedChannels& result)
+{
+	auto const listener = avdecc::ControllerManager::getInstance().getControlledEntity(listenerEntityID);
+	if (!listener || !listener->getEntity().getEntityCapabilities().test(la::avdecc::entity::EntityCapability::AemSupported))
+	{
+		return;
+	}
+
+	auto const& configurationNode = listener->getCurrentConfigurationNode();
+	for (auto const& [streamIndex, streamInputNode] : configurationNode.streamInputs)
+	{
+		if (!streamInputNode.dynamicModel)
+		{
+			continue;
+		}
+		auto const& connectionState = streamInputNode.dynamicModel->connectionState;
+		if (connectionState.state != la::avdecc::entity::model::StreamConnectionState::State::Connected || connectionState.talkerStream.entityID != talkerEntityID)
+		{
+			continue;
+		}
+
+		for (auto const& [audioUnitIndex, audioUnitNode] : configurationNode.audioUnits)
+		{
+			for (auto const& [streamPortIndex, streamPortInputNode] : audioUnitNode.streamPortInputs)
+			{
+				if (!streamPortInputNode.dynamicModel)
+				{
+					continue;
+				}
+				auto const baseCluster = streamPortInputNode.staticModel ? streamPortInputNode.staticModel->baseCluster : la::avdecc::entity::model::ClusterIndex{ 0u };
+				for (auto const& mapping : streamPortInputNode.dynamicModel->dynamicAudioMap)
+				{
+					if (mapping.streamIndex == streamIndex && talkerStreamChannels.count({ connectionState.talkerStream.streamIndex, mapping.streamChannel }) != 0)
+					{
+						result.emplace(listenerEntityID, audioUnitIndex, streamPortIndex, baseCluster, mapping.clusterOffset, mapping.clusterChannel, mapping.streamChannel);
+					}
+				}
+			}
+		}
+	}
+}
+
+ConnectedChannels referenceChannelConnections(la::avdecc::UniqueIdentifier const talkerEntityID, avdecc::ChannelIdentification const& talkerChannel, std::vector<la::avdecc::UniqueIdentifier> const& entityIDs) noexcept
+{
+	auto result = ConnectedChannels{};
+
+	try
+	{
+		auto const talker = avdecc::ControllerManager::getInstance().getControlledEntity(talkerEntityID);
+		if (!talker || !talkerChannel.streamPortIndex || !talkerChannel.baseCluster)
+		{
+			return result;
+		}
+
+		auto talkerStreamChannels = std::set<StreamChannel>{};
+		for (auto const& mapping : talkerMappings(*talker, *talkerChannel.streamPortIndex))
+		{
+			if (mapping.clusterOffset == talkerChannel.clusterIndex - *talkerChannel.baseCluster && mapping.clusterChannel == talkerChannel.clusterChannel)
+			{
+				talkerStreamChannels.emplace(mapping.streamIndex, mapping.streamChannel);
+			}
+		}
+
+		for (auto const& entityID : entityIDs)
+		{
+			addListenerChannels(talkerEntityID, talkerStreamChannels, entityID, result);
+		}
+	}
+	catch (la::avdecc::controller::ControlledEntity::Exception const&)
+	{
+		result.clear();
+	}
+
+	return result;
+}
+
+ConnectedChannels referenceAllChannelConnectionsBetweenDevices(la::avdecc::UniqueIdentifier const talkerEntityID, la::avdecc::entity::model::StreamPortIndex const streamPortIndex, la::avdecc::UniqueIdentifier const listenerEntityID) noexcept
+{
+	auto result = ConnectedChannels{};
+
+	try
+	{
+		auto const talker = avdecc::ControllerManager::getInstance().getControlledEntity(talkerEntityID);
+		if (!talker)
+		{
+			return result;
+		}
+
+		auto talkerStreamChannels = std::set<StreamChannel>{};
+		for (auto const& mapping : talkerMappings(*talker, streamPortIndex))
+		{
+			talkerStreamChannels.emplace(mapping.streamIndex, mapping.streamChannel);
+		}
+
+		addListenerChannels(talkerEntityID, talkerStreamChannels, listenerEntityID, result);
+	}
+	catch (la::avdecc::controller::ControlledEntity::Exception const&)
+	{
+		result.clear();
+	}
+
+	return result;
+}
+
+std::set<la::avdecc::UniqueIdentifier> connectedListeners(la::avdecc::UniqueIdentifier const talkerEntityID, std::vector<la::avdecc::UniqueIdentifier> const& entityIDs) noexcept
+{
+	auto result = std::set<la::avdecc::UniqueIdentifier>{};
+	auto const& manager = avdecc::ControllerManager::getInstance();
+
+	for (auto const& entityID : entityIDs)
+	{
+		try
+		{
+			auto const listener = manager.getControlledEntity(entityID);
+			if (!listener)
+			{
+				continue;
+			}
+			for (auto const& [streamIndex, streamInputNode] : listener->getCurrentConfigurationNode().streamInputs)
+			{
+				if (streamInputNode.dynamicModel && streamInputNode.dynamicModel->connectionState.state == la::avdecc::entity::model::StreamConnectionState::State::Connected && streamInputNode.dynamicModel->connectionState.talkerStream.entityID == talkerEntityID)
+				{
+					result.insert(entityID);
+					break;
+				}
+			}
+		}
+		catch (la::avdecc::controller::ControlledEntity::Exception const&)
+		{
+		}
+	}
+
+	return result;
+}
+
+ConnectedChannels toConnectedChannels(avdecc::TargetConnectionInformations const& informations) noexcept
+{
+	auto result = ConnectedChannels{};
+	for (auto const& target : informations.targets)
+	{
+		for (auto const& [clusterOffset, clusterChannel] : target.targetClusterChannels)
+		{
+			result.emplace(target.targetEntityId, target.targetAudioUnitIndex, target.targetStreamPortIndex, target.targetBaseCluster, clusterOffset, clusterChannel, target.streamChannel);
+		}
+	}
+	return result;
+}
+
+} // namespace channelConnectionsOracle
@@ -0,0 +1,53 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "avdecc/channelConnectionManager.hpp"
+
+#include <la/avdecc/internals/uniqueIdentifier.hpp>
+
+#include <cstdint>
+#include <set>
+#include <tuple>
+#include <vector>
+
+/**
+* Slow but simple reference implementation of the ChannelConnectionManager lookups, used as an oracle for the optimized (indexed and cached) implementation.
+* It only relies on the ControlledEntities, scanning all stream inputs of all entities for each request.
+*/
+namespace channelConnectionsOracle
+{
+/** A listener channel reached from a talker channel: (ListenerID, AudioUnitIndex, StreamPortIndex, BaseCluster, ClusterOffset, ClusterChannel, StreamChannel) */
+using ConnectedChannel = std::tuple<la::avdecc::UniqueIdentifier, la::avdecc::entity::model::AudioUnitIndex, la::avdecc::entity::model::StreamPortIndex, la::avdecc::entity::model::ClusterIndex, la::avdecc::entity::model::ClusterIndex, std::uint16_t, std::uint16_t>;
+using ConnectedChannels = std::set<ConnectedChannel>;
+
+/** Listener channels connected to the specified talker channel (which must have its audioUnitIndex, streamPortIndex and baseCluster set) */
+ConnectedChannels referenceChannelConnections(la::avdecc::UniqueIdentifier const talkerEntityID, avdecc::ChannelIdentification const& talkerChannel, std::vector<la::avdecc::UniqueIdentifier> const& entityIDs) noexcept;
+
+/** Listener channels of the listener entity connected to any channel of the talker stream port */
+ConnectedChannels referenceAllChannelConnectionsBetweenDevices(la::avdecc::UniqueIdentifier const talkerEntityID, la::avdecc::entity::model::StreamPortIndex const streamPortIndex, la::avdecc::UniqueIdentifier const listenerEntityID) noexcept;
+
+/** Listener entities with at least one stream input connected to the talker */
+std::set<la::avdecc::UniqueIdentifier> connectedListeners(la::avdecc::UniqueIdentifier const talkerEntityID, std::vector<la::avdecc::UniqueIdentifier> const& entityIDs) noexcept;
+
+/** Projection of the result of the optimized implementation, to be compared with the reference one */
+ConnectedChannels toConnectedChannels(avdecc::TargetConnectionInformations const& informations) noexcept;
+
+} // namespace channelConnectionsOracle
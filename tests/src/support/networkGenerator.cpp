@@ -0,0 +1,307 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "networkGenerator.hpp"
+#include "avdecc/controllerManager.hpp"
+
+#include <QDir>
+
+#include <algorithm>
+#include <cstdio> // snprintf
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace networkGenerator
+{
+/** Version of the library's entity dump format the documents are generated for */
+static constexpr auto DumpVersion = 1u;
+/** Base EntityID of the generated entities, the entity index being added to it */
+static constexpr auto EntityIDBase = std::uint64_t{ 0x001B92FFFE000000 };
+/** Base EntityModelID of the generated entities, entities with the same stream configuration share the same model */
+static constexpr auto EntityModelIDBase = std::uint64_t{ 0x001B92FFFD000000 };
+/** IEC 61883-6 AM824, 48kHz, 8 channels */
+static constexpr auto StreamFormat = std::uint64_t{ 0x00A0020840000800 };
+
+/** Keys of the library's entity dump (JSON) format */
+namespace key
+{
+static constexpr auto DumpVersion = "dump_version";
+static constexpr auto ADPInformation = "adp_information";
+static constexpr auto CommonInformation = "common_information";
+static constexpr auto InterfacesInformation = "interfaces_information";
+static constexpr auto EntityModel = "entity_model";
+static constexpr auto EntityState = "entity_state";
+static constexpr auto Static = "static";
+static constexpr auto Dynamic = "dynamic";
+static constexpr auto DescriptorIndex = "descriptor_index";
+static constexpr auto Configurations = "configurations";
+static constexpr auto AudioUnits = "audio_units";
+static constexpr auto StreamInputs = "stream_inputs";
+static constexpr auto StreamOutputs = "stream_outputs";
+static constexpr auto RedundantStreamInputs = "redundant_stream_inputs";
+static constexpr auto RedundantStreamOutputs = "redundant_stream_outputs";
+static constexpr auto AvbInterfaces = "avb_interfaces";
+static constexpr auto ClockSources = "clock_sources";
+static constexpr auto ClockDomains = "clock_domains";
+static constexpr auto StreamPortInputs = "stream_port_inputs";
+static constexpr auto StreamPortOutputs = "stream_port_outputs";
+static constexpr auto AudioClusters = "audio_clusters";
+static constexpr auto DynamicAudioMap = "dynamic_audio_map";
+static constexpr auto ConnectionInfo = "connection_info";
+} // namespace key
+
+static std::string toHexString(std::uint64_t const value) noexcept
+{
+	return la::avdecc::utils::toHexString(value, true, true);
+}
+
+/** Locally administered MAC address, unique for each entity interface */
+static std::string makeMacAddress(std::uint32_t const entityIndex, std::uint32_t const interfaceIndex) noexcept
+{
+	char mac[18];
+	std::snprintf(mac, sizeof(mac), "02:%02x:%02x:%02x:%02x:%02x", (entityIndex >> 24) & 0xFF, (entityIndex >> 16) & 0xFF, (entityIndex >> 8) & 0xFF, entityIndex & 0xFF, interfaceIndex & 0xFF);
+	return mac;
+}
+
+static nlohmann::json makeNamedDescriptor(std::uint16_t const index, std::string const& name, nlohmann::json staticModel = nlohmann::json::object(), nlohmann::json dynamicModel = nlohmann::json::object())
+{
+	staticModel["localized_description"] = "(0,0)";
+	dynamicModel["object_name"] = name;
+	return nlohmann::json{ { key::DescriptorIndex, index }, { key::Static, std::move(staticModel) }, { key::Dynamic, std::move(dynamicModel) } };
+}
+
+/** Streams of one direction: a simple stream per requested stream, or a pair of streams (one per AVB interface) plus a redundant stream descriptor */
+static void makeStreams(nlohmann::json& configuration, std::uint16_t const count, bool const isRedundant, bool const isInput)
+{
+	auto streams = nlohmann::json::array();
+	auto redundantStreams = nlohmann::json::array();
+	auto const streamsPerLogicalStream = isRedundant ? 2u : 1u;
+	auto const prefix = std::string{ isInput ? "Input " : "Output " };
+
+	for (auto logical = std::uint16_t{ 0u }; logical < count; ++logical)
+	{
+		auto redundants = nlohmann::json::array();
+		for (auto sub = 0u; sub < streamsPerLogicalStream; ++sub)
+		{
+			auto const index = static_cast<std::uint16_t>(logical * streamsPerLogicalStream + sub);
+			auto staticModel = nlohmann::json{ { "avb_interface_index", sub }, { "clock_domain_index", 0 }, { "formats", nlohmann::json::array({ toHexString(StreamFormat) }) } };
+			if (isRedundant)
+			{
+				staticModel["redundant_streams"] = nlohmann::json::array({ logical * streamsPerLogicalStream + (1u - sub) });
+			}
+			auto dynamicModel = nlohmann::json{ { "stream_format", toHexString(StreamFormat) } };
+			if (isInput)
+			{
+				dynamicModel[key::ConnectionInfo] = nlohmann::json{ { "state", "not_connected" } };
+			}
+			streams.push_back(makeNamedDescriptor(index, prefix + std::to_string(logical) + (isRedundant ? (sub == 0u ? " Primary" : " Secondary") : ""), std::move(staticModel), std::move(dynamicModel)));
+			redundants.push_back(index);
+		}
+		if (isRedundant)
+		{
+			redundantStreams.push_back(makeNamedDescriptor(logical, prefix + std::to_string(logical), nlohmann::json{ { "redundant_streams", std::move(redundants) } }));
+		}
+	}
+
+	configuration[isInput ? key::StreamInputs : key::StreamOutputs] = std::move(streams);
+	if (isRedundant)
+	{
+		configuration[isInput ? key::RedundantStreamInputs : key::RedundantStreamOutputs] = std::move(redundantStreams);
+	}
+}
+
+/** Builds the dump of a single entity, without any connection (connections depend on the whole network) */
+static GeneratedEntity makeEntity(std::uint32_t const entityIndex, bool const isRedundant, NetworkParameters const& parameters, std::mt19937& random)
+{
+	auto entity = GeneratedEntity{};
+	entity.entityID = la::avdecc::UniqueIdentifier{ EntityIDBase + entityIndex };
+	entity.entityModelID = la::avdecc::UniqueIdentifier{ EntityModelIDBase + (isRedundant ? 1u : 0u) };
+	entity.isRedundant = isRedundant;
+
+	auto const interfacesCount = isRedundant ? 2u : 1u;
+	auto const inputClusters = static_cast<std::uint16_t>(parameters.streamInputsCount * parameters.clustersPerStream);
+	auto const outputClusters = static_cast<std::uint16_t>(parameters.streamOutputsCount * parameters.clustersPerStream);
+
+	// ADP
+	auto interfaces = nlohmann::json::array();
+	for (auto i = 0u; i < interfacesCount; ++i)
+	{
+		interfaces.push_back(nlohmann::json{ { "avb_interface_index", i }, { "mac_address", makeMacAddress(entityIndex, i) }, { "valid_time", 31 }, { "available_index", 0 }, { "gptp_grandmaster_id", toHexString(0x001B92FFFF000000 + i) }, { "gptp_domain_number", 0 } });
+	}
+	auto adp = nlohmann::json{
+		{ key::CommonInformation, { { "entity_id", toHexString(entity.entityID.getValue()) }, { "entity_model_id", toHexString(entity.entityModelID.getValue()) }, { "entity_capabilities", { "AEM_SUPPORTED", "CLASS_A_SUPPORTED", "GPTP_SUPPORTED" } }, { "talker_stream_sources", parameters.streamOutputsCount * interfacesCount }, { "talker_capabilities", { "IMPLEMENTED", "AUDIO_SOURCE" } }, { "listener_stream_sinks", parameters.streamInputsCount * interfacesCount }, { "listener_capabilities", { "IMPLEMENTED", "AUDIO_SINK" } }, { "controller_capabilities", nlohmann::json::array() } } },
+		{ key::InterfacesInformation, std::move(interfaces) },
+	};
+
+	// Configuration
+	auto configuration = makeNamedDescriptor(0u, "Default", nlohmann::json::object());
+	makeStreams(configuration, parameters.streamInputsCount, isRedundant, true);
+	makeStreams(configuration, parameters.streamOutputsCount, isRedundant, false);
+
+	auto avbInterfaces = nlohmann::json::array();
+	for (auto i = 0u; i < interfacesCount; ++i)
+	{
+		avbInterfaces.push_back(makeNamedDescriptor(static_cast<std::uint16_t>(i), "Interface " + std::to_string(i)));
+	}
+	configuration[key::AvbInterfaces] = std::move(avbInterfaces);
+	configuration[key::ClockSources] = nlohmann::json::array({ makeNamedDescriptor(0u, "Internal", nlohmann::json{ { "clock_source_type", "INTERNAL" } }) });
+	configuration[key::ClockDomains] = nlohmann::json::array({ makeNamedDescriptor(0u, "Domain", nlohmann::json{ { "clock_sources", nlohmann::json::array({ 0 }) } }, nlohmann::json{ { "clock_source_index", 0 } }) });
+
+	// Audio clusters: inputs clusters first, then outputs clusters. Each cluster is a single channel
+	auto clusters = nlohmann::json::array();
+	for (auto i = std::uint16_t{ 0u }; i < inputClusters + outputClusters; ++i)
+	{
+		clusters.push_back(makeNamedDescriptor(i, (i < inputClusters ? "In " : "Out ") + std::to_string(i < inputClusters ? i : i - inputClusters), nlohmann::json{ { "channel_count", 1 }, { "format", "MBLA" } }));
+	}
+	configuration[key::AudioClusters] = std::move(clusters);
+
+	// Dynamic mappings (on the primary stream of redundant pairs): talker clusters are all mapped, listener clusters depend on mappingDensity
+	auto const makeMappings = [&parameters, &random, interfacesCount](std::uint16_t const streamsCount, bool const isInput)
+	{
+		auto distribution = std::bernoulli_distribution{ isInput ? static_cast<double>(std::clamp(parameters.mappingDensity, 0.0f, 1.0f)) : 1.0 };
+		auto mappings = nlohmann::json::array();
+		for (auto stream = std::uint16_t{ 0u }; stream < streamsCount; ++stream)
+		{
+			for (auto channel = std::uint16_t{ 0u }; channel < parameters.clustersPerStream; ++channel)
+			{
+				if (distribution(random))
+				{
+					mappings.push_back(nlohmann::json{ { "stream_index", stream * interfacesCount }, { "stream_channel", channel }, { "cluster_offset", stream * parameters.clustersPerStream + channel }, { "cluster_channel", 0 } });
+				}
+			}
+		}
+		return mappings;
+	};
+	auto audioUnit = makeNamedDescriptor(0u, "Audio Unit", nlohmann::json{ { "clock_domain_index", 0 }, { "sampling_rates", nlohmann::json::array({ 48000 }) } }, nlohmann::json{ { "current_sampling_rate", 48000 } });
+	audioUnit[key::StreamPortInputs] = nlohmann::json::array({ makeNamedDescriptor(0u, "Stream Port In", nlohmann::json{ { "clock_domain_index", 0 }, { "number_of_clusters", inputClusters }, { "base_cluster", 0 } }, nlohmann::json{ { key::DynamicAudioMap, makeMappings(parameters.streamInputsCount, true) } }) });
+	audioUnit[key::StreamPortOutputs] = nlohmann::json::array({ makeNamedDescriptor(0u, "Stream Port Out", nlohmann::json{ { "clock_domain_index", 0 }, { "number_of_clusters", outputClusters }, { "base_cluster", inputClusters } }, nlohmann::json{ { key::DynamicAudioMap, makeMappings(parameters.streamOutputsCount, false) } }) });
+	configuration[key::AudioUnits] = nlohmann::json::array({ std::move(audioUnit) });
+
+	auto entityModel = nlohmann::json{
+		{ key::Static, { { "vendor_name_string", 0 }, { "model_name_string", 0 } } },
+		{ key::Dynamic, { { "entity_name", "Synthetic " + std::to_string(entityIndex) }, { "group_name", "" }, { "firmware_version", "1.0" }, { "serial_number", std::to_string(entityIndex) }, { "current_configuration", 0 } } },
+		{ key::Configurations, nlohmann::json::array({ std::move(configuration) }) },
+	};
+
+	entity.dump = nlohmann::json{
+		{ key::DumpVersion, DumpVersion },
+		{ key::ADPInformation, std::move(adp) },
+		{ key::EntityModel, std::move(entityModel) },
+		{ key::EntityState, { { "acquire_state", "NOT_ACQUIRED" }, { "lock_state", "NOT_LOCKED" } } },
+	};
+	return entity;
+}
+
+GeneratedEntities generateNetwork(NetworkParameters const& parameters) noexcept
+{
+	auto entities = GeneratedEntities{};
+
+	try
+	{
+		auto random = std::mt19937{ parameters.seed };
+		auto isRedundantDistribution = std::bernoulli_distribution{ static_cast<double>(std::clamp(parameters.redundantEntitiesRatio, 0.0f, 1.0f)) };
+
+		entities.reserve(parameters.entitiesCount);
+		for (auto index = 0u; index < parameters.entitiesCount; ++index)
+		{
+			entities.push_back(makeEntity(index, isRedundantDistribution(random), parameters, random));
+		}
+
+		// Connections: a listener stream is connected to a random stream of another entity, redundant listeners only being connected to redundant talkers (primary to primary, secondary to secondary)
+		auto isConnectedDistribution = std::bernoulli_distribution{ static_cast<double>(std::clamp(parameters.connectionDensity, 0.0f, 1.0f)) };
+		if (entities.size() > 1 && parameters.streamOutputsCount > 0)
+		{
+			auto talkerDistribution = std::uniform_int_distribution<size_t>{ 0u, entities.size() - 1u };
+			auto streamDistribution = std::uniform_int_distribution<std::uint16_t>{ 0u, static_cast<std::uint16_t>(parameters.streamOutputsCount - 1u) };
+
+			for (auto& listener : entities)
+			{
+				auto& streamInputs = listener.dump[key::EntityModel][key::Configurations][0][key::StreamInputs];
+				auto const streamsPerLogicalStream = listener.isRedundant ? 2u : 1u;
+				for (auto logical = 0u; logical < parameters.streamInputsCount; ++logical)
+				{
+					if (!isConnectedDistribution(random))
+					{
+						continue;
+					}
+					auto const& talker = entities[talkerDistribution(random)];
+					if (&talker == &listener || talker.isRedundant != listener.isRedundant)
+					{
+						continue;
+					}
+					auto const talkerLogicalStream = streamDistribution(random);
+					for (auto sub = 0u; sub < streamsPerLogicalStream; ++sub)
+					{
+						streamInputs[logical * streamsPerLogicalStream + sub][key::Dynamic][key::ConnectionInfo] = nlohmann::json{ { "state", "connected" }, { "talker_stream", { { "entity_id", toHexString(talker.entityID.getValue()) }, { "stream_index", talkerLogicalStream * streamsPerLogicalStream + sub } } } };
+					}
+				}
+			}
+		}
+	}
+	catch (...)
+	{
+		entities.clear();
+	}
+
+	return entities;
+}
+
+std::size_t channelsCount(NetworkParameters const& parameters) noexcept
+{
+	return static_cast<std::size_t>(parameters.entitiesCount) * (parameters.streamInputsCount + parameters.streamOutputsCount) * parameters.clustersPerStream;
+}
+
+QStringList writeNetwork(GeneratedEntities const& entities, QString const& directory) noexcept
+{
+	auto filePaths = QStringList{};
+
+	for (auto const& entity : entities)
+	{
+		auto const filePath = QDir{ directory }.filePath(QString::fromStdString(toHexString(entity.entityID.getValue())) + ".json");
+		auto ofs = std::ofstream{ filePath.toStdString(), std::ios::binary | std::ios::out | std::ios::trunc };
+		if (ofs.is_open())
+		{
+			ofs << entity.dump.dump();
+			filePaths << filePath;
+		}
+	}
+
+	return filePaths;
+}
+
+std::size_t loadNetwork(QStringList const& filePaths) noexcept
+{
+	// Generated models only contain what the Connection Matrix needs, so they are not required to pass the AEM sanity checks
+	auto const flags = la::avdecc::entity::model::jsonSerializer::Flags{ la::avdecc::entity::model::jsonSerializer::Flag::ProcessADP, la::avdecc::entity::model::jsonSerializer::Flag::ProcessDynamicModel, la::avdecc::entity::model::jsonSerializer::Flag::ProcessState, la::avdecc::entity::model::jsonSerializer::Flag::ProcessStaticModel, la::avdecc::entity::model::jsonSerializer::Flag::IgnoreAEMSanityChecks };
+	auto& manager = avdecc::ControllerManager::getInstance();
+
+	auto loadedCount = std::size_t{ 0u };
+	for (auto const& filePath : filePaths)
+	{
+		auto const [error, message] = manager.loadVirtualEntityFromJson(filePath, flags);
+		if (!error)
+		{
+			++loadedCount;
+		}
+	}
+	return loadedCount;
+}
+
+} // namespace networkGenerator
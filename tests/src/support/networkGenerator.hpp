@@ -0,0 +1,70 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <la/avdecc/utils.hpp>
+#include <la/avdecc/internals/uniqueIdentifier.hpp>
+#include <nlohmann/json.hpp>
+
+#include <QString>
+#include <QStringList>
+
+#include <cstdint>
+#include <vector>
+
+namespace networkGenerator
+{
+/** Description of the network to generate. The same parameters (including seed) always generate the same network */
+struct NetworkParameters
+{
+	std::uint32_t entitiesCount{ 300u };
+	std::uint16_t streamInputsCount{ 4u }; // Per entity
+	std::uint16_t streamOutputsCount{ 4u }; // Per entity
+	float redundantEntitiesRatio{ 0.0f }; // Ratio of entities whose streams are all redundant pairs (0.0 to 1.0)
+	std::uint16_t clustersPerStream{ 8u }; // Audio clusters per stream port, a cluster being a channel in the Connection Matrix
+	float mappingDensity{ 1.0f }; // Ratio of the listener clusters having a dynamic mapping (0.0 to 1.0)
+	float connectionDensity{ 0.5f }; // Ratio of the listener streams connected to a talker stream (0.0 to 1.0)
+	std::uint32_t seed{ 0u };
+};
+
+/** A generated entity: its identifiers and its virtual entity dump */
+struct GeneratedEntity
+{
+	la::avdecc::UniqueIdentifier entityID{};
+	la::avdecc::UniqueIdentifier entityModelID{};
+	bool isRedundant{ false };
+	nlohmann::json dump{};
+};
+
+using GeneratedEntities = std::vector<GeneratedEntity>;
+
+/** Generates a synthetic network of virtual entities (as they would be dumped by the library), to be loaded without requiring real hardware */
+GeneratedEntities generateNetwork(NetworkParameters const& parameters) noexcept;
+
+/** Total number of channels (talker and listener clusters) of a network generated with the specified parameters */
+std::size_t channelsCount(NetworkParameters const& parameters) noexcept;
+
+/** Writes each entity as a virtual entity file (*.json) in the specified directory (which must exist). Returns the written file paths */
+QStringList writeNetwork(GeneratedEntities const& entities, QString const& directory) noexcept;
+
+/** Loads the specified virtual entity files into the avdecc::ControllerManager (its controller must be created with a Virtual ProtocolInterface). Returns the number of successfully loaded entities */
+std::size_t loadNetwork(QStringList const& filePaths) noexcept;
+
+} // namespace networkGenerator
@@ -0,0 +1,69 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "benchmark.hpp"
+
+#include <la/avdecc/internals/uniqueIdentifier.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace benchmarkSupport
+{
+/**
+* Test fixture loading a VirtualNetwork generated from Parameters once for all the tests of the test case.
+* Derived fixtures can hide SetUpTestCase (calling this one) to create what must exist before the entities go online.
+*/
+template<networkGenerator::NetworkParameters const& Parameters>
+class VirtualNetworkFixture : public ::testing::Test
+{
+public:
+	static void SetUpTestCase()
+	{
+		s_network = std::make_unique<VirtualNetwork>(Parameters);
+		std::cout << "[ BENCHMARK ] Synthetic network: " << Parameters.entitiesCount << " entities, " << networkGenerator::channelsCount(Parameters) << " channels, loaded in " << s_network->loadDuration().count() << " ms" << std::endl;
+	}
+
+	static void TearDownTestCase()
+	{
+		s_network.reset();
+	}
+
+protected:
+	/** Derived fixtures should call it with ASSERT_NO_FATAL_FAILURE */
+	virtual void SetUp() override
+	{
+		ASSERT_TRUE(s_network && s_network->isLoaded());
+
+		for (auto const& entity : s_network->entities())
+		{
+			_entityIDs.push_back(entity.entityID);
+		}
+	}
+
+	static inline std::unique_ptr<VirtualNetwork> s_network{};
+	std::vector<la::avdecc::UniqueIdentifier> _entityIDs{};
+};
+
+} // namespace benchmarkSupport
@@ -0,0 +1,214 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdlib> // atoi
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace converter
+{
+/** Result of a single file conversion. Code is the process exit code (0 on success) */
+struct Result
+{
+	int code{ 0 };
+	std::string message{};
+};
+
+/** Converts inputFile to outputFile, using the streaming (SAX) mode if requested */
+using ConvertFunction = std::function<Result(std::string const& inputFile, std::string const& outputFile, bool const streaming)>;
+
+struct Options
+{
+	bool streaming{ false }; // Convert without building the whole document in memory
+	bool batch{ false }; // Input and output are directories
+	unsigned int jobs{ 0u }; // Maximum parallel conversions in batch mode (0 = one per core)
+	std::string outputExtension{}; // Extension of the converted files in batch mode
+	std::string input{};
+	std::string output{};
+};
+
+inline bool parseOptions(int argc, char* argv[], Options& options) noexcept
+{
+	auto positional = std::vector<std::string>{};
+	for (auto i = 1; i < argc; ++i)
+	{
+		auto const arg = std::string{ argv[i] };
+		if (arg == "-s")
+		{
+			options.streaming = true;
+		}
+		else if (arg == "-d")
+		{
+			options.batch = true;
+		}
+		else if (arg == "-j" && (i + 1) < argc)
+		{
+			options.jobs = static_cast<unsigned int>(std::max(0, std::atoi(argv[++i])));
+		}
+		else if (arg == "-e" && (i + 1) < argc)
+		{
+			options.outputExtension = argv[++i];
+			if (!options.outputExtension.empty() && options.outputExtension.front() != '.')
+			{
+				options.outputExtension.insert(0, ".");
+			}
+		}
+		else
+		{
+			positional.push_back(arg);
+		}
+	}
+
+	if (positional.size() != 2)
+	{
+		return false;
+	}
+	options.input = positional[0];
+	options.output = positional[1];
+	return true;
+}
+
+inline void printUsage(std::string const& inputFileFilter, std::string const& outputFileFilter) noexcept
+{
+	std::cout << "Missing parameters" << std::endl;
+	std::cout << "Usage: [-s] <Input File (" << inputFileFilter << ")> <Output File (" << outputFileFilter << ")>" << std::endl;
+	std::cout << "       [-s] [-j <Jobs>] [-e <Output Extension>] -d <Input Directory> <Output Directory>" << std::endl;
+	std::cout << "  -s  Streaming conversion, without loading the whole file in memory" << std::endl;
+	std::cout << "  -d  Convert all matching files of the input directory (recursively), in parallel" << std::endl;
+	std::cout << "  -j  Maximum number of parallel conversions (defaults to the number of cores)" << std::endl;
+	std::cout << "  -e  Extension of the converted files in directory mode" << std::endl;
+}
+
+/** Runs the conversion of a single file, or of a whole directory tree when options.batch is set. Returns the process exit code */
+inline int run(Options const& options, std::vector<std::string> const& inputExtensions, ConvertFunction const& convert) noexcept
+{
+	if (!options.batch)
+	{
+		auto const result = convert(options.input, options.output, options.streaming);
+		std::cout << result.message << std::endl;
+		return result.code;
+	}
+
+	namespace fs = std::filesystem;
+
+	auto const inputRoot = fs::path{ options.input };
+	auto const outputRoot = fs::path{ options.output };
+
+	// Collect the files to convert first, so the workers only have to pop from a list
+	auto files = std::vector<fs::path>{};
+	try
+	{
+		for (auto const& entry : fs::recursive_directory_iterator{ inputRoot })
+		{
+			if (entry.is_regular_file())
+			{
+				auto const ext = entry.path().extension().string();
+				if (std::find(inputExtensions.begin(), inputExtensions.end(), ext) != inputExtensions.end())
+				{
+					files.push_back(entry.path());
+				}
+			}
+		}
+	}
+	catch (fs::filesystem_error const& e)
+	{
+		std::cout << "Cannot read input directory '" << options.input << "': " << e.what() << std::endl;
+		return 1;
+	}
+
+	auto const jobs = std::max(1u, std::min(options.jobs != 0u ? options.jobs : std::thread::hardware_concurrency(), static_cast<unsigned int>(files.size())));
+	auto nextFile = std::atomic<size_t>{ 0u };
+	auto failedCount = std::atomic<size_t>{ 0u };
+	auto worstCode = std::atomic<int>{ 0 };
+	auto outputLock = std::mutex{};
+
+	auto const worker = [&]()
+	{
+		for (auto index = nextFile++; index < files.size(); index = nextFile++)
+		{
+			auto const& inputFile = files[index];
+			auto outputFile = outputRoot / fs::relative(inputFile, inputRoot);
+			outputFile.replace_extension(options.outputExtension);
+
+			auto result = Result{};
+			try
+			{
+				fs::create_directories(outputFile.parent_path());
+				result = convert(inputFile.string(), outputFile.string(), options.streaming);
+			}
+			catch (fs::filesystem_error const& e)
+			{
+				result = Result{ 3, std::string{ "Cannot create output directory: " } + e.what() };
+			}
+
+			if (result.code != 0)
+			{
+				++failedCount;
+				auto previous = worstCode.load();
+				while (previous < result.code && !worstCode.compare_exchange_weak(previous, result.code))
+				{
+				}
+				auto const lg = std::lock_guard{ outputLock };
+				std::cout << inputFile.string() << ": " << result.message << std::endl;
+			}
+		}
+	};
+
+	auto threads = std::vector<std::thread>{};
+	for (auto i = 1u; i < jobs; ++i)
+	{
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (auto& t : threads)
+	{
+		t.join();
+	}
+
+	std::cout << "Converted " << (files.size() - failedCount) << "/" << files.size() << " files" << std::endl;
+
+	return worstCode;
+}
+
+/** Converts any nlohmann::json exception to a conversion result */
+template<typename Function>
+inline Result catchJsonExceptions(std::string const& inputFile, Function&& function) noexcept
+{
+	try
+	{
+		return function();
+	}
+	catch (nlohmann::json::exception const& e)
+	{
+		return Result{ 2, "Cannot parse input file '" + inputFile + "': " + e.what() };
+	}
+}
+
+} // namespace converter
@@ -17,66 +17,306 @@
 * along with Hive.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include "converterCommon.hpp"
+
 #include <nlohmann/json.hpp>
 
 #include <iostream>
 #include <fstream>
 #include <string>
-#include <cstring> // strerror
+#include <vector>
+#include <cstdint>
+#include <cstring> // strerror, memcpy
 #include <cerrno> // errno
 
 using json = nlohmann::json;
 
-int main(int argc, char* argv[])
+/** SAX handler directly writing MessagePack to the output stream. Containers are written with a 32-bit size placeholder which is patched when the container ends, so memory usage only depends on the nesting depth */
+class MsgPackWriter final
 {
-	if (argc != 3)
+public:
+	explicit MsgPackWriter(std::ostream& os) noexcept
+		: _os{ os }
 	{
-		std::cout << "Missing parameters" << std::endl << "Usage: <Input File (*.json)> <Output File (*.ave;*.aem;*.ans)>" << std::endl;
-		return 1;
 	}
 
-	auto const* const inputFile = argv[1];
-	auto const* const outputFile = argv[2];
+	std::string const& errorMessage() const noexcept
+	{
+		return _errorMessage;
+	}
 
-	// Try to open the input file
-	auto ifs = std::ifstream{ inputFile, std::ios::binary | std::ios::in };
+	bool null()
+	{
+		beginValue();
+		writeByte(0xc0);
+		return good();
+	}
 
-	// Failed to open file for reading
-	if (!ifs.is_open())
+	bool boolean(bool val)
 	{
-		std::cout << "Cannot open input file '" << std::string{ inputFile } << "': " << std::strerror(errno) << std::endl;
-		return 1;
+		beginValue();
+		writeByte(val ? 0xc3 : 0xc2);
+		return good();
 	}
 
-	auto object = json{};
-	try
+	bool number_integer(json::number_integer_t val)
+	{
+		if (val >= 0)
+		{
+			return number_unsigned(static_cast<json::number_unsigned_t>(val));
+		}
+		beginValue();
+		if (val >= -32)
+		{
+			writeByte(static_cast<std::uint8_t>(static_cast<std::int8_t>(val)));
+		}
+		else if (val >= INT8_MIN)
+		{
+			writeByte(0xd0);
+			writeBigEndian(static_cast<std::int8_t>(val));
+		}
+		else if (val >= INT16_MIN)
+		{
+			writeByte(0xd1);
+			writeBigEndian(static_cast<std::int16_t>(val));
+		}
+		else if (val >= INT32_MIN)
+		{
+			writeByte(0xd2);
+			writeBigEndian(static_cast<std::int32_t>(val));
+		}
+		else
+		{
+			writeByte(0xd3);
+			writeBigEndian(static_cast<std::int64_t>(val));
+		}
+		return good();
+	}
+
+	bool number_unsigned(json::number_unsigned_t val)
+	{
+		beginValue();
+		if (val < 128u)
+		{
+			writeByte(static_cast<std::uint8_t>(val));
+		}
+		else if (val <= UINT8_MAX)
+		{
+			writeByte(0xcc);
+			writeBigEndian(static_cast<std::uint8_t>(val));
+		}
+		else if (val <= UINT16_MAX)
+		{
+			writeByte(0xcd);
+			writeBigEndian(static_cast<std::uint16_t>(val));
+		}
+		else if (val <= UINT32_MAX)
+		{
+			writeByte(0xce);
+			writeBigEndian(static_cast<std::uint32_t>(val));
+		}
+		else
+		{
+			writeByte(0xcf);
+			writeBigEndian(static_cast<std::uint64_t>(val));
+		}
+		return good();
+	}
+
+	bool number_float(json::number_float_t val, json::string_t const& /*s*/)
+	{
+		beginValue();
+		auto bits = std::uint64_t{};
+		auto const d = static_cast<double>(val);
+		std::memcpy(&bits, &d, sizeof(bits));
+		writeByte(0xcb);
+		writeBigEndian(bits);
+		return good();
+	}
+
+	bool string(json::string_t& val)
+	{
+		beginValue();
+		writeString(val);
+		return good();
+	}
+
+#if NLOHMANN_JSON_VERSION_MAJOR > 3 || (NLOHMANN_JSON_VERSION_MAJOR == 3 && NLOHMANN_JSON_VERSION_MINOR >= 8)
+	bool binary(json::binary_t& val)
+	{
+		beginValue();
+		auto const size = val.size();
+		if (size <= UINT8_MAX)
+		{
+			writeByte(0xc4);
+			writeBigEndian(static_cast<std::uint8_t>(size));
+		}
+		else if (size <= UINT16_MAX)
+		{
+			writeByte(0xc5);
+			writeBigEndian(static_cast<std::uint16_t>(size));
+		}
+		else
+		{
+			writeByte(0xc6);
+			writeBigEndian(static_cast<std::uint32_t>(size));
+		}
+		_os.write(reinterpret_cast<char const*>(val.data()), static_cast<std::streamsize>(size));
+		return good();
+	}
+#endif
+
+	bool start_object(std::size_t /*elements*/)
+	{
+		return startContainer(0xdf);
+	}
+
+	bool key(json::string_t& val)
+	{
+		++_containers.back().count;
+		writeString(val);
+		return good();
+	}
+
+	bool end_object()
+	{
+		return endContainer();
+	}
+
+	bool start_array(std::size_t /*elements*/)
+	{
+		return startContainer(0xdd);
+	}
+
+	bool end_array()
+	{
+		return endContainer();
+	}
+
+	bool parse_error(std::size_t /*position*/, std::string const& /*last_token*/, json::exception const& ex)
 	{
-		ifs >> object;
+		_errorMessage = ex.what();
+		return false;
 	}
-	catch (json::type_error const& e)
+
+private:
+	struct Container
 	{
-		std::cout << "Cannot parse input file '" << std::string{ inputFile } << "': " << e.what() << std::endl;
-		return 2;
+		std::ostream::pos_type sizePosition{};
+		std::uint32_t count{ 0u };
+		bool isArray{ false };
+	};
+
+	void beginValue() noexcept
+	{
+		// Object entries are counted by their key
+		if (!_containers.empty() && _containers.back().isArray)
+		{
+			++_containers.back().count;
+		}
 	}
-	catch (json::parse_error const& e)
+
+	bool startContainer(std::uint8_t const marker)
 	{
-		std::cout << "Cannot parse input file '" << std::string{ inputFile } << "': " << e.what() << std::endl;
-		return 2;
+		beginValue();
+		writeByte(marker);
+		_containers.push_back(Container{ _os.tellp(), 0u, marker == 0xdd });
+		writeBigEndian(std::uint32_t{ 0u });
+		return good();
 	}
-	catch (json::out_of_range const& e)
+
+	bool endContainer()
 	{
-		std::cout << "Cannot parse input file '" << std::string{ inputFile } << "': " << e.what() << std::endl;
-		return 2;
+		auto const container = _containers.back();
+		_containers.pop_back();
+
+		auto const endPosition = _os.tellp();
+		_os.seekp(container.sizePosition);
+		writeBigEndian(container.count);
+		_os.seekp(endPosition);
+		return good();
 	}
-	catch (json::other_error const& e)
+
+	void writeString(json::string_t const& val)
 	{
-		std::cout << "Cannot parse input file '" << std::string{ inputFile } << "': " << e.what() << std::endl;
-		return 2;
+		auto const size = val.size();
+		if (size <= 31u)
+		{
+			writeByte(static_cast<std::uint8_t>(0xa0 | size));
+		}
+		else if (size <= UINT8_MAX)
+		{
+			writeByte(0xd9);
+			writeBigEndian(static_cast<std::uint8_t>(size));
+		}
+		else if (size <= UINT16_MAX)
+		{
+			writeByte(0xda);
+			writeBigEndian(static_cast<std::uint16_t>(size));
+		}
+		else
+		{
+			writeByte(0xdb);
+			writeBigEndian(static_cast<std::uint32_t>(size));
+		}
+		_os.write(val.data(), static_cast<std::streamsize>(size));
 	}
-	catch (json::exception const& e)
+
+	void writeByte(std::uint8_t const byte)
 	{
-		std::cout << "Cannot parse input file '" << std::string{ inputFile } << "': " << e.what() << std::endl;
-		return 2;
+		_os.put(static_cast<char>(byte));
+	}
+
+	template<typename T>
+	void writeBigEndian(T const value)
+	{
+		char bytes[sizeof(T)];
+		for (auto i = 0u; i < sizeof(T); ++i)
+		{
+			bytes[i] = static_cast<char>((static_cast<std::uint64_t>(value) >> (8u * (sizeof(T) - 1u - i))) & 0xffu);
+		}
+		_os.write(bytes, sizeof(T));
+	}
+
+	bool good()
+	{
+		if (!_os.good())
+		{
+			_errorMessage = "Write error";
+			return false;
+		}
+		return true;
+	}
+
+	std::ostream& _os;
+	std::vector<Container> _containers{};
+	std::string _errorMessage{};
+};
+
+static converter::Result convertFile(std::string const& inputFile, std::string const& outputFile, bool const streaming) noexcept
+{
+	// Try to open the input file
+	auto ifs = std::ifstream{ inputFile, std::ios::binary | std::ios::in };
+
+	// Failed to open file for reading
+	if (!ifs.is_open())
+	{
+		return converter::Result{ 1, "Cannot open input file '" + inputFile + "': " + std::strerror(errno) };
+	}
+
+	auto object = json{};
+	if (!streaming)
+	{
+		auto const result = converter::catchJsonExceptions(inputFile,
+			[&ifs, &object]()
+			{
+				ifs >> object;
+				return converter::Result{};
+			});
+		if (result.code != 0)
+		{
+			return result;
+		}
 	}
 
 	// Try to open the output file
@@ -85,14 +325,44 @@ int main(int argc, char* argv[])
 	// Failed to open file to writting
 	if (!ofs.is_open())
 	{
-		std::cout << "Cannot open output file '" << std::string{ outputFile } << "': " << std::strerror(errno) << std::endl;
-		return 3;
+		return converter::Result{ 3, "Cannot open output file '" + outputFile + "': " + std::strerror(errno) };
+	}
+
+	if (streaming)
+	{
+		auto writer = MsgPackWriter{ ofs };
+		auto const result = converter::catchJsonExceptions(inputFile,
+			[&ifs, &writer, &inputFile]()
+			{
+				if (!json::sax_parse(ifs, &writer))
+				{
+					return converter::Result{ 2, "Cannot convert input file '" + inputFile + "': " + writer.errorMessage() };
+				}
+				return converter::Result{};
+			});
+		if (result.code != 0)
+		{
+			return result;
+		}
+	}
+	else
+	{
+		auto const binary = json::to_msgpack(object);
+		ofs.write(reinterpret_cast<char const*>(binary.data()), binary.size() * sizeof(decltype(binary)::value_type));
 	}
 
-	auto const binary = json::to_msgpack(object);
-	ofs.write(reinterpret_cast<char const*>(binary.data()), binary.size() * sizeof(decltype(binary)::value_type));
+	return converter::Result{ 0, "Successfully converted file" };
+}
 
-	std::cout << "Successfully converted file" << std::endl;
+int main(int argc, char* argv[])
+{
+	auto options = converter::Options{};
+	options.outputExtension = ".ans";
+	if (!converter::parseOptions(argc, argv, options))
+	{
+		converter::printUsage("*.json", "*.ave;*.aem;*.ans");
+		return 1;
+	}
 
-	return 0;
+	return converter::run(options, { ".json" }, convertFile);
 }
@@ -0,0 +1,134 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "avdecc/logJournal.hpp"
+
+#include <la/avdecc/logger.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <ctime>
+#include <cstring> // strerror
+#include <cerrno> // errno
+#include <iomanip> // put_time
+
+static std::string layerToString(std::uint32_t const layer)
+{
+	switch (static_cast<la::avdecc::logger::Layer>(layer))
+	{
+		case la::avdecc::logger::Layer::Generic:
+			return "Generic";
+		case la::avdecc::logger::Layer::Serialization:
+			return "Serialization";
+		case la::avdecc::logger::Layer::ProtocolInterface:
+			return "Protocol Interface";
+		case la::avdecc::logger::Layer::AemPayload:
+			return "AemPayload";
+		case la::avdecc::logger::Layer::ControllerEntity:
+			return "Controller Entity";
+		case la::avdecc::logger::Layer::ControllerStateMachine:
+			return "Controller State Machine";
+		case la::avdecc::logger::Layer::Controller:
+			return "Controller";
+		case la::avdecc::logger::Layer::JsonSerializer:
+			return "Json Serializer";
+		case la::avdecc::logger::Layer::FirstUserLayer:
+			return "Hive";
+		default:
+			return "Layer " + std::to_string(layer);
+	}
+}
+
+static std::string levelToString(std::uint32_t const level)
+{
+	switch (static_cast<la::avdecc::logger::Level>(level))
+	{
+		case la::avdecc::logger::Level::Trace:
+			return "Trace";
+		case la::avdecc::logger::Level::Debug:
+			return "Debug";
+		case la::avdecc::logger::Level::Info:
+			return "Info";
+		case la::avdecc::logger::Level::Warn:
+			return "Warning";
+		case la::avdecc::logger::Level::Error:
+			return "Error";
+		case la::avdecc::logger::Level::None:
+			return "None";
+		default:
+			return "Level " + std::to_string(level);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc != 3)
+	{
+		std::cout << "Missing parameters" << std::endl << "Usage: <Input File (*.journal)> <Output File (*.txt)>" << std::endl;
+		return 1;
+	}
+
+	auto const* const inputFile = argv[1];
+	auto const* const outputFile = argv[2];
+
+	// Try to open the input file
+	auto ifs = std::ifstream{ inputFile, std::ios::binary | std::ios::in };
+
+	// Failed to open file for reading
+	if (!ifs.is_open())
+	{
+		std::cout << "Cannot open input file '" << std::string{ inputFile } << "': " << std::strerror(errno) << std::endl;
+		return 1;
+	}
+
+	auto const journal = std::vector<std::uint8_t>{ std::istreambuf_iterator<char>{ ifs }, std::istreambuf_iterator<char>{} };
+
+	// Try to open the output file
+	auto ofs = std::ofstream{ outputFile, std::ios::binary | std::ios::out };
+
+	// Failed to open file to writting
+	if (!ofs.is_open())
+	{
+		std::cout << "Cannot open output file '" << std::string{ outputFile } << "': " << std::strerror(errno) << std::endl;
+		return 3;
+	}
+
+	auto count = size_t{ 0u };
+	auto const result = avdecc::logJournal::read(journal.data(), journal.size(),
+		[&ofs, &count](avdecc::logJournal::Entry const& entry)
+		{
+			// Same format than the one used by Hive when saving the log
+			auto const time = static_cast<std::time_t>(entry.timestamp / 1000);
+			ofs << std::put_time(std::localtime(&time), "%Y-%m-%d - %H:%M:%S") << "\t" << layerToString(entry.layer) << "\t" << levelToString(entry.level) << "\t" << entry.message << "\n";
+			++count;
+		});
+
+	if (!result)
+	{
+		std::cout << "Cannot parse input file '" << std::string{ inputFile } << "': Invalid or corrupted journal (" << count << " entries converted)" << std::endl;
+		return 2;
+	}
+
+	std::cout << "Successfully converted file (" << count << " entries)" << std::endl;
+
+	return 0;
+}
@@ -17,67 +17,195 @@
 * along with Hive.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include "converterCommon.hpp"
+
 #include <nlohmann/json.hpp>
 
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
 #include <cstring> // strerror
 #include <cerrno> // errno
 #include <iomanip> // setw
 
 using json = nlohmann::json;
 
-int main(int argc, char* argv[])
+/** SAX handler directly writing indented JSON text to the output stream, the same way json::dump(4) would. Only scalar values are converted through a json object */
+class JsonWriter final
 {
-	if (argc != 3)
+public:
+	explicit JsonWriter(std::ostream& os) noexcept
+		: _os{ os }
 	{
-		std::cout << "Missing parameters" << std::endl << "Usage: <Input File (*.ave;*.aem;*.ans)> <Output File (*.json)>" << std::endl;
-		return 1;
 	}
 
-	auto const* const inputFile = argv[1];
-	auto const* const outputFile = argv[2];
+	std::string const& errorMessage() const noexcept
+	{
+		return _errorMessage;
+	}
 
-	// Try to open the input file
-	auto ifs = std::ifstream{ inputFile, std::ios::binary | std::ios::in };
+	bool null()
+	{
+		return writeScalar(json{});
+	}
 
-	// Failed to open file for reading
-	if (!ifs.is_open())
+	bool boolean(bool val)
 	{
-		std::cout << "Cannot open input file '" << std::string{ inputFile } << "': " << std::strerror(errno) << std::endl;
-		return 1;
+		return writeScalar(json(val));
 	}
 
-	auto object = json{};
-	try
+	bool number_integer(json::number_integer_t val)
+	{
+		return writeScalar(json(val));
+	}
+
+	bool number_unsigned(json::number_unsigned_t val)
+	{
+		return writeScalar(json(val));
+	}
+
+	bool number_float(json::number_float_t val, json::string_t const& /*s*/)
+	{
+		return writeScalar(json(val));
+	}
+
+	bool string(json::string_t& val)
+	{
+		return writeScalar(json(std::move(val)));
+	}
+
+#if NLOHMANN_JSON_VERSION_MAJOR > 3 || (NLOHMANN_JSON_VERSION_MAJOR == 3 && NLOHMANN_JSON_VERSION_MINOR >= 8)
+	bool binary(json::binary_t& val)
+	{
+		return writeScalar(json::binary(std::move(val)));
+	}
+#endif
+
+	bool start_object(std::size_t /*elements*/)
+	{
+		return startContainer('{', false);
+	}
+
+	bool key(json::string_t& val)
 	{
-		object = json::from_msgpack(ifs);
+		writeSeparator();
+		_os << json(std::move(val)).dump() << ": ";
+		return good();
 	}
-	catch (json::type_error const& e)
+
+	bool end_object()
 	{
-		std::cout << "Cannot parse input file '" << std::string{ inputFile } << "': " << e.what() << std::endl;
-		return 2;
+		return endContainer('}');
 	}
-	catch (json::parse_error const& e)
+
+	bool start_array(std::size_t /*elements*/)
 	{
-		std::cout << "Cannot parse input file '" << std::string{ inputFile } << "': " << e.what() << std::endl;
-		return 2;
+		return startContainer('[', true);
 	}
-	catch (json::out_of_range const& e)
+
+	bool end_array()
 	{
-		std::cout << "Cannot parse input file '" << std::string{ inputFile } << "': " << e.what() << std::endl;
-		return 2;
+		return endContainer(']');
 	}
-	catch (json::other_error const& e)
+
+	bool parse_error(std::size_t /*position*/, std::string const& /*last_token*/, json::exception const& ex)
 	{
-		std::cout << "Cannot parse input file '" << std::string{ inputFile } << "': " << e.what() << std::endl;
-		return 2;
+		_errorMessage = ex.what();
+		return false;
 	}
-	catch (json::exception const& e)
+
+private:
+	static constexpr auto IndentSize = 4u;
+
+	struct Container
 	{
-		std::cout << "Cannot parse input file '" << std::string{ inputFile } << "': " << e.what() << std::endl;
-		return 2;
+		std::size_t count{ 0u };
+		bool isArray{ false };
+	};
+
+	void writeSeparator()
+	{
+		auto& container = _containers.back();
+		_os << (container.count != 0u ? ",\n" : "\n") << std::string(_containers.size() * IndentSize, ' ');
+		++container.count;
+	}
+
+	void beginValue()
+	{
+		// Object values are already prefixed by their key
+		if (!_containers.empty() && _containers.back().isArray)
+		{
+			writeSeparator();
+		}
+	}
+
+	bool writeScalar(json const& value)
+	{
+		beginValue();
+		_os << value.dump();
+		return good();
+	}
+
+	bool startContainer(char const marker, bool const isArray)
+	{
+		beginValue();
+		_os << marker;
+		_containers.push_back(Container{ 0u, isArray });
+		return good();
+	}
+
+	bool endContainer(char const marker)
+	{
+		auto const container = _containers.back();
+		_containers.pop_back();
+		if (container.count != 0u)
+		{
+			_os << '\n' << std::string(_containers.size() * IndentSize, ' ');
+		}
+		_os << marker;
+		return good();
+	}
+
+	bool good()
+	{
+		if (!_os.good())
+		{
+			_errorMessage = "Write error";
+			return false;
+		}
+		return true;
+	}
+
+	std::ostream& _os;
+	std::vector<Container> _containers{};
+	std::string _errorMessage{};
+};
+
+static converter::Result convertFile(std::string const& inputFile, std::string const& outputFile, bool const streaming) noexcept
+{
+	// Try to open the input file
+	auto ifs = std::ifstream{ inputFile, std::ios::binary | std::ios::in };
+
+	// Failed to open file for reading
+	if (!ifs.is_open())
+	{
+		return converter::Result{ 1, "Cannot open input file '" + inputFile + "': " + std::strerror(errno) };
+	}
+
+	auto object = json{};
+	if (!streaming)
+	{
+		auto const result = converter::catchJsonExceptions(inputFile,
+			[&ifs, &object]()
+			{
+				object = json::from_msgpack(ifs);
+				return converter::Result{};
+			});
+		if (result.code != 0)
+		{
+			return result;
+		}
 	}
 
 	// Try to open the output file
@@ -86,13 +214,44 @@ int main(int argc, char* argv[])
 	// Failed to open file to writting
 	if (!ofs.is_open())
 	{
-		std::cout << "Cannot open output file '" << std::string{ outputFile } << "': " << std::strerror(errno) << std::endl;
-		return 3;
+		return converter::Result{ 3, "Cannot open output file '" + outputFile + "': " + std::strerror(errno) };
 	}
 
-	ofs << std::setw(4) << object << std::endl;
+	if (streaming)
+	{
+		auto writer = JsonWriter{ ofs };
+		auto const result = converter::catchJsonExceptions(inputFile,
+			[&ifs, &writer, &inputFile]()
+			{
+				if (!json::sax_parse(ifs, &writer, json::input_format_t::msgpack))
+				{
+					return converter::Result{ 2, "Cannot convert input file '" + inputFile + "': " + writer.errorMessage() };
+				}
+				return converter::Result{};
+			});
+		if (result.code != 0)
+		{
+			return result;
+		}
+		ofs << std::endl;
+	}
+	else
+	{
+		ofs << std::setw(4) << object << std::endl;
+	}
 
-	std::cout << "Successfully converted file" << std::endl;
+	return converter::Result{ 0, "Successfully converted file" };
+}
+
+int main(int argc, char* argv[])
+{
+	auto options = converter::Options{};
+	options.outputExtension = ".json";
+	if (!converter::parseOptions(argc, argv, options))
+	{
+		converter::printUsage("*.ave;*.aem;*.ans", "*.json");
+		return 1;
+	}
 
-	return 0;
+	return converter::run(options, { ".ave", ".aem", ".ans" }, convertFile);
 }
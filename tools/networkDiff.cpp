@@ -0,0 +1,446 @@
+/*
+* Copyright (C) 2017-2019, Emilien Vallot, Christophe Calmejane and other contributors
+
+* This file is part of Hive.
+
+* Hive is free software: you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+
+* Hive is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+
+* You should have received a copy of the GNU Lesser General Public License
+* along with Hive.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "converterCommon.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <unordered_map>
+#include <optional>
+#include <functional>
+#include <cstring> // strerror
+#include <cerrno> // errno
+
+using json = nlohmann::json;
+
+/** Key used to match entities between two dumps, instead of their position in the dump */
+static auto constexpr EntityIDKey = "entity_id";
+/** Depth at which EntityIDKey is searched in an array element */
+static auto constexpr EntityIDSearchDepth = 3u;
+
+/** Categories of differences we want to be able to filter on, matched against the keys of the path */
+static std::vector<std::pair<std::string, std::string>> const s_categories = {
+	{ "name", "name" },
+	{ "format", "format" },
+	{ "mapping", "mapping" },
+	{ "connection", "connect" },
+	{ "clock", "clock" },
+};
+
+struct Options
+{
+	std::set<std::string> ignoredKeys{}; // Keys (at any depth) which are not compared
+	std::set<std::string> categories{}; // Only report differences of these categories (empty = all)
+	bool summary{ false }; // Only print per-entity difference counts
+	std::string leftFile{};
+	std::string rightFile{};
+};
+
+/** Subtree hashes of a document, computed in a single bottom-up pass so every node is only hashed once */
+class SubtreeHashes final
+{
+public:
+	explicit SubtreeHashes(json const& root, std::set<std::string> const& ignoredKeys)
+		: _ignoredKeys{ ignoredKeys }
+	{
+		compute(root);
+	}
+
+	std::size_t operator[](json const& node) const noexcept
+	{
+		auto const it = _hashes.find(&node);
+		return it != _hashes.end() ? it->second : 0u;
+	}
+
+private:
+	static std::size_t combine(std::size_t const seed, std::size_t const value) noexcept
+	{
+		return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+	}
+
+	std::size_t compute(json const& node)
+	{
+		auto hash = static_cast<std::size_t>(node.type());
+		switch (node.type())
+		{
+			case json::value_t::object:
+				for (auto const& [key, value] : node.items())
+				{
+					if (_ignoredKeys.count(key) == 0)
+					{
+						hash = combine(hash, std::hash<std::string>{}(key));
+						hash = combine(hash, compute(value));
+					}
+				}
+				break;
+			case json::value_t::array:
+				for (auto const& value : node)
+				{
+					hash = combine(hash, compute(value));
+				}
+				break;
+			default:
+				hash = combine(hash, std::hash<json>{}(node));
+				break;
+		}
+		_hashes[&node] = hash;
+		return hash;
+	}
+
+	std::set<std::string> const& _ignoredKeys;
+	std::unordered_map<json const*, std::size_t> _hashes{};
+};
+
+class NetworkDiff final
+{
+public:
+	NetworkDiff(json const& left, json const& right, Options const& options)
+		: _options{ options }
+		, _leftHashes{ left, options.ignoredKeys }
+		, _rightHashes{ right, options.ignoredKeys }
+	{
+		compare(left, right, "");
+	}
+
+	std::size_t differencesCount() const noexcept
+	{
+		return _differencesCount;
+	}
+
+	std::map<std::string, std::size_t> const& differencesPerEntity() const noexcept
+	{
+		return _differencesPerEntity;
+	}
+
+private:
+	static std::optional<std::string> findEntityID(json const& node, unsigned int const depth) noexcept
+	{
+		if (!node.is_object())
+		{
+			return std::nullopt;
+		}
+		if (auto const it = node.find(EntityIDKey); it != node.end())
+		{
+			return it->is_string() ? it->get<std::string>() : it->dump();
+		}
+		if (depth > 1u)
+		{
+			for (auto const& value : node)
+			{
+				if (auto const id = findEntityID(value, depth - 1u))
+				{
+					return id;
+				}
+			}
+		}
+		return std::nullopt;
+	}
+
+	/** Returns the elements of an array keyed by their EntityID, or nothing if they cannot all be identified */
+	static std::optional<std::map<std::string, json const*>> keyByEntityID(json const& array) noexcept
+	{
+		auto result = std::map<std::string, json const*>{};
+		for (auto const& element : array)
+		{
+			auto const id = findEntityID(element, EntityIDSearchDepth);
+			if (!id || !result.emplace(*id, &element).second)
+			{
+				return std::nullopt;
+			}
+		}
+		return result;
+	}
+
+	static std::string summarize(json const& node) noexcept
+	{
+		switch (node.type())
+		{
+			case json::value_t::object:
+				return "{...} (" + std::to_string(node.size()) + " keys)";
+			case json::value_t::array:
+				return "[...] (" + std::to_string(node.size()) + " elements)";
+			default:
+				return node.dump();
+		}
+	}
+
+	bool isReported(std::string const& path) const noexcept
+	{
+		if (_options.categories.empty())
+		{
+			return true;
+		}
+		for (auto const& [category, pattern] : s_categories)
+		{
+			if (_options.categories.count(category) != 0 && path.find(pattern) != std::string::npos)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void report(std::string const& path, std::string const& what) noexcept
+	{
+		if (!isReported(path))
+		{
+			return;
+		}
+		++_differencesCount;
+		++_differencesPerEntity[_currentEntity];
+		if (!_options.summary)
+		{
+			std::cout << (path.empty() ? "/" : path) << ": " << what << std::endl;
+		}
+	}
+
+	void compare(json const& left, json const& right, std::string const& path) noexcept
+	{
+		// Identical subtrees are skipped without a deep compare
+		if (_leftHashes[left] == _rightHashes[right])
+		{
+			return;
+		}
+
+		if (left.type() != right.type())
+		{
+			report(path, summarize(left) + " -> " + summarize(right));
+			return;
+		}
+
+		if (left.is_object())
+		{
+			for (auto const& [key, value] : left.items())
+			{
+				if (_options.ignoredKeys.count(key) != 0)
+				{
+					continue;
+				}
+				auto const childPath = path + "/" + key;
+				if (auto const it = right.find(key); it != right.end())
+				{
+					compare(value, *it, childPath);
+				}
+				else
+				{
+					report(childPath, "removed");
+				}
+			}
+			for (auto const& [key, value] : right.items())
+			{
+				if (_options.ignoredKeys.count(key) == 0 && left.find(key) == left.end())
+				{
+					report(path + "/" + key, "added " + summarize(value));
+				}
+			}
+		}
+		else if (left.is_array())
+		{
+			// Entities are matched by EntityID, so a different discovery order is not reported
+			auto const leftEntities = keyByEntityID(left);
+			auto const rightEntities = keyByEntityID(right);
+			if (leftEntities && rightEntities && !left.empty() && !right.empty())
+			{
+				compareEntities(*leftEntities, *rightEntities, path);
+			}
+			else
+			{
+				auto const common = std::min(left.size(), right.size());
+				for (auto i = 0u; i < common; ++i)
+				{
+					compare(left[i], right[i], path + "/" + std::to_string(i));
+				}
+				for (auto i = common; i < left.size(); ++i)
+				{
+					report(path + "/" + std::to_string(i), "removed");
+				}
+				for (auto i = common; i < right.size(); ++i)
+				{
+					report(path + "/" + std::to_string(i), "added " + summarize(right[i]));
+				}
+			}
+		}
+		else
+		{
+			report(path, left.dump() + " -> " + right.dump());
+		}
+	}
+
+	void compareEntities(std::map<std::string, json const*> const& left, std::map<std::string, json const*> const& right, std::string const& path) noexcept
+	{
+		auto const previousEntity = _currentEntity;
+		for (auto const& [id, entity] : left)
+		{
+			_currentEntity = id;
+			auto const childPath = path + "/" + id;
+			if (auto const it = right.find(id); it != right.end())
+			{
+				compare(*entity, *it->second, childPath);
+			}
+			else
+			{
+				report(childPath, "entity removed");
+			}
+		}
+		for (auto const& [id, entity] : right)
+		{
+			if (left.count(id) == 0)
+			{
+				_currentEntity = id;
+				report(path + "/" + id, "entity added");
+			}
+		}
+		_currentEntity = previousEntity;
+	}
+
+	Options const& _options;
+	SubtreeHashes _leftHashes;
+	SubtreeHashes _rightHashes;
+	std::string _currentEntity{};
+	std::size_t _differencesCount{ 0u };
+	std::map<std::string, std::size_t> _differencesPerEntity{};
+};
+
+static converter::Result loadDump(std::string const& file, json& object) noexcept
+{
+	auto ifs = std::ifstream{ file, std::ios::binary | std::ios::in };
+
+	// Failed to open file for reading
+	if (!ifs.is_open())
+	{
+		return converter::Result{ 2, "Cannot open input file '" + file + "': " + std::strerror(errno) };
+	}
+
+	// Files are serialized as JSON or MessagePack depending on their extension
+	auto const isJson = file.size() >= 5 && file.compare(file.size() - 5, 5, ".json") == 0;
+	auto result = converter::catchJsonExceptions(file,
+		[&ifs, &object, isJson]()
+		{
+			if (isJson)
+			{
+				ifs >> object;
+			}
+			else
+			{
+				object = json::from_msgpack(ifs);
+			}
+			return converter::Result{};
+		});
+	if (result.code != 0)
+	{
+		result.code = 2;
+	}
+	return result;
+}
+
+static bool parseOptions(int argc, char* argv[], Options& options) noexcept
+{
+	auto positional = std::vector<std::string>{};
+	for (auto i = 1; i < argc; ++i)
+	{
+		auto const arg = std::string{ argv[i] };
+		if (arg == "-i" && (i + 1) < argc)
+		{
+			options.ignoredKeys.insert(argv[++i]);
+		}
+		else if (arg == "-c" && (i + 1) < argc)
+		{
+			auto const category = std::string{ argv[++i] };
+			auto const it = std::find_if(s_categories.begin(), s_categories.end(),
+				[&category](auto const& c)
+				{
+					return c.first == category;
+				});
+			if (it == s_categories.end())
+			{
+				return false;
+			}
+			options.categories.insert(category);
+		}
+		else if (arg == "-s")
+		{
+			options.summary = true;
+		}
+		else
+		{
+			positional.push_back(arg);
+		}
+	}
+
+	if (positional.size() != 2)
+	{
+		return false;
+	}
+	options.leftFile = positional[0];
+	options.rightFile = positional[1];
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	auto options = Options{};
+	if (!parseOptions(argc, argv, options))
+	{
+		std::cout << "Missing parameters" << std::endl;
+		std::cout << "Usage: [-s] [-i <Ignored Key>]... [-c <Category>]... <Reference Dump (*.ans;*.ave;*.json)> <Compared Dump (*.ans;*.ave;*.json)>" << std::endl;
+		std::cout << "  -s  Only print the number of differences per entity" << std::endl;
+		std::cout << "  -i  Do not compare this key, at any depth (eg. statistics)" << std::endl;
+		std::cout << "  -c  Only report differences of a category: name, format, mapping, connection, clock" << std::endl;
+		std::cout << "Returns 0 if both dumps are identical, 1 if they differ" << std::endl;
+		return 2;
+	}
+
+	auto left = json{};
+	auto right = json{};
+	for (auto const& [file, object] : { std::make_pair(&options.leftFile, &left), std::make_pair(&options.rightFile, &right) })
+	{
+		auto const result = loadDump(*file, *object);
+		if (result.code != 0)
+		{
+			std::cout << result.message << std::endl;
+			return result.code;
+		}
+	}
+
+	auto const diff = NetworkDiff{ left, right, options };
+
+	if (options.summary)
+	{
+		for (auto const& [entity, count] : diff.differencesPerEntity())
+		{
+			std::cout << (entity.empty() ? "<network>" : entity) << ": " << count << " difference(s)" << std::endl;
+		}
+	}
+
+	if (diff.differencesCount() == 0)
+	{
+		std::cout << "Dumps are identical" << std::endl;
+		return 0;
+	}
+
+	std::cout << diff.differencesCount() << " difference(s) found" << std::endl;
+	return 1;
+}